@@ -0,0 +1,67 @@
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "eminline.h"
+#include "attotime.h"
+static void BM_attotime_add(benchmark::State& state) {
+	attotime total = attotime::zero;
+	attotime const step = attotime::from_hz(XTAL(3'579'545));
+	while (state.KeepRunning()) {
+		total += step;
+		benchmark::DoNotOptimize(total);
+	}
+}
+BENCHMARK(BM_attotime_add);
+
+static void BM_attotime_subtract_compare(benchmark::State& state) {
+	attotime const base = attotime::from_seconds(10);
+	attotime expire = base + attotime::from_usec(250);
+	attotime const step = attotime::from_nsec(70);
+	while (state.KeepRunning()) {
+		attotime const delta = expire - base;
+		benchmark::DoNotOptimize(delta < attotime::from_usec(500));
+		expire += step;
+	}
+}
+BENCHMARK(BM_attotime_subtract_compare);
+
+static void BM_attotime_multiply(benchmark::State& state) {
+	attotime const period = attotime::from_hz(60);
+	u32 factor = 1;
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(period * factor);
+		factor = (factor & 0xffff) + 3;
+	}
+}
+BENCHMARK(BM_attotime_multiply);
+
+static void BM_attotime_divide(benchmark::State& state) {
+	attotime const frame = attotime::from_hz(59.94);
+	u32 divisor = 1;
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(frame / divisor);
+		divisor = (divisor & 0x3ff) + 7;
+	}
+}
+BENCHMARK(BM_attotime_divide);
+
+static void BM_attotime_to_cycles(benchmark::State& state) {
+	u32 const clock = 12'000'000;
+	attotime elapsed = attotime::from_usec(1);
+	attotime const step = attotime::from_nsec(13);
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(elapsed.as_ticks(clock));
+		benchmark::DoNotOptimize(attotime::from_ticks(u64(elapsed.attoseconds() & 0xffff), clock));
+		elapsed += step;
+	}
+}
+BENCHMARK(BM_attotime_to_cycles);
+
+static void BM_attotime_as_double(benchmark::State& state) {
+	attotime value = attotime::from_seconds(3);
+	attotime const step = attotime::from_nsec(1);
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(value.as_double());
+		value += step;
+	}
+}
+BENCHMARK(BM_attotime_as_double);
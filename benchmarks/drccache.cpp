@@ -0,0 +1,41 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+#include "cpu/drccache.h"
+static void BM_drc_cache_alloc_dealloc(benchmark::State& state) {
+	drc_cache cache(16 * 1024 * 1024);
+	size_t const bytes = state.range_x();
+	while (state.KeepRunning()) {
+		void *const memory = cache.alloc(bytes);
+		benchmark::DoNotOptimize(memory);
+		cache.dealloc(memory, bytes);
+	}
+}
+BENCHMARK(BM_drc_cache_alloc_dealloc)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+
+static void BM_drc_cache_alloc_flush(benchmark::State& state) {
+	drc_cache cache(16 * 1024 * 1024);
+	int const count = state.range_x();
+	while (state.KeepRunning()) {
+		for (int i = 0; i < count; i++)
+			benchmark::DoNotOptimize(cache.alloc_temporary(64));
+		cache.flush();
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_drc_cache_alloc_flush)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_drc_cache_codegen(benchmark::State& state) {
+	drc_cache cache(16 * 1024 * 1024);
+	size_t const bytes = state.range_x();
+	while (state.KeepRunning()) {
+		drccodeptr *const top = cache.begin_codegen(bytes);
+		if (!top) {
+			cache.flush();
+			continue;
+		}
+		*top += bytes;
+		benchmark::DoNotOptimize(cache.end_codegen());
+	}
+	state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_drc_cache_codegen)->Arg(256)->Arg(4096);
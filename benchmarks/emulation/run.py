@@ -0,0 +1,90 @@
+#!/usr/bin/python3
+##
+## license:BSD-3-Clause
+## copyright-holders:agent
+
+# Run the emulation benchmark suite and collect the per-workload reports
+#
+# Each workload runs with -bench (no video, no sound, unthrottled) for a
+# fixed number of emulated seconds, optionally starting from a saved state
+# and playing back recorded inputs so that every revision runs the same code
+# paths.  The reports written with -benchreport are gathered into a single
+# JSON document for comparing revisions.
+#
+# With --baseline, each workload is also compared against the report of the
+# same name in the baseline directory (for example the reports saved with
+# --save from a known good revision).  The emulator fails the workload if the
+# run, or any sampling interval, takes longer than the baseline by more than
+# the threshold.
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+def run_workload(mame, workload, extra, workdir, args):
+    report = os.path.join(workdir, workload['name'] + '.json')
+    command = [mame, workload['system'], '-bench', str(workload['seconds']), '-benchreport', report]
+    interval = workload.get('interval', args.interval)
+    if interval:
+        command += ['-benchinterval', str(interval)]
+    if args.baseline:
+        baseline = os.path.join(args.baseline, workload['name'] + '.json')
+        if os.path.exists(baseline):
+            command += ['-benchbaseline', baseline, '-benchthreshold', str(args.threshold)]
+    if workload.get('state'):
+        command += ['-state', workload['state']]
+    if workload.get('playback'):
+        command += ['-playback', workload['playback']]
+    command += workload.get('options', [])
+    command += extra
+    result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+    if result.returncode != 0 or not os.path.exists(report):
+        return { 'name': workload['name'], 'error': result.stderr.strip() or ('exit status %d' % result.returncode) }
+    if args.save:
+        os.makedirs(args.save, exist_ok=True)
+        shutil.copyfile(report, os.path.join(args.save, workload['name'] + '.json'))
+    with open(report) as f:
+        data = json.load(f)
+    data['name'] = workload['name']
+    return data
+
+
+if __name__ == '__main__':
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description='Run the emulation benchmark suite.')
+    parser.add_argument('mame', help='emulator executable to benchmark')
+    parser.add_argument('--suite', default=os.path.join(here, 'suite.json'), help='suite definition')
+    parser.add_argument('--only', action='append', help='run only the named workload (may be repeated)')
+    parser.add_argument('--output', help='write results here rather than to standard output')
+    parser.add_argument('--interval', type=float, help='emulated seconds between timing samples')
+    parser.add_argument('--baseline', help='directory of reports to compare against')
+    parser.add_argument('--threshold', type=float, default=10.0, help='percentage slower than the baseline allowed (default 10)')
+    parser.add_argument('--save', help='directory to save the individual reports in, for use as a baseline')
+    parser.add_argument('extra', nargs=argparse.REMAINDER, help='additional emulator options, e.g. -rompath')
+    args = parser.parse_args()
+    if args.extra[:1] == ['--']:
+        args.extra = args.extra[1:]
+
+    with open(args.suite) as f:
+        suite = json.load(f)
+
+    results = []
+    with tempfile.TemporaryDirectory() as workdir:
+        for workload in suite['workloads']:
+            if args.only and workload['name'] not in args.only:
+                continue
+            sys.stderr.write('%s...\n' % workload['name'])
+            results.append(run_workload(args.mame, workload, args.extra, workdir, args))
+
+    text = json.dumps({ 'results': results }, indent=2)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text + '\n')
+    else:
+        sys.stdout.write(text + '\n')
+    sys.exit(1 if any('error' in r for r in results) else 0)
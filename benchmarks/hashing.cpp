@@ -0,0 +1,24 @@
+#include "benchmark/benchmark_api.h"
+#include "hashing.h"
+#include <vector>
+static void BM_crc32_creator(benchmark::State& state) {
+	std::vector<uint8_t> const data(state.range_x(), 0x5a);
+	while (state.KeepRunning()) {
+		util::crc32_creator crc;
+		crc.append(data.data(), data.size());
+		benchmark::DoNotOptimize(crc.finish());
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_crc32_creator)->Arg(64)->Arg(4096)->Arg(1024 * 1024);
+
+static void BM_sha1_creator(benchmark::State& state) {
+	std::vector<uint8_t> const data(state.range_x(), 0x5a);
+	while (state.KeepRunning()) {
+		util::sha1_creator sha1;
+		sha1.append(data.data(), data.size());
+		benchmark::DoNotOptimize(sha1.finish());
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_sha1_creator)->Arg(64)->Arg(4096)->Arg(1024 * 1024);
@@ -71,6 +71,9 @@ uint8_t nscsi_harddisk_device::scsi_get_data(int id, int pos)
 				LOG("HD READ ERROR !\n");
 				memset(block, 0, sizeof(block));
 			}
+			// fetch the next block while the initiator takes this one
+			if(cur_lba + 1 < lba + blocks)
+				image->read_ahead(cur_lba + 1);
 		}
 		data = block[pos % bytes_per_sector];
 	}
@@ -0,0 +1,3815 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    drcbearm64.cpp
+
+    64-bit AArch64 back-end for the universal machine language.
+
+****************************************************************************
+
+    Future improvements/changes:
+
+    * Use ADRP for far memory operands instead of materializing the full
+        64-bit address
+
+    * Keep more UML registers in host registers
+
+    * Avoid reloading immediates that are already in a temporary register
+
+****************************************************************************
+
+    -------------------------
+    ABI/conventions (AAPCS64)
+    -------------------------
+
+    Registers:
+        x0-x7   - parameters/results, volatile
+        x8      - indirect result, volatile
+        x9-x15  - volatile
+        x16-x17 - intra-procedure-call scratch, volatile
+        x18     - platform register, never touched
+        x19-x28 - non-volatile
+        x29     - frame pointer
+        x30     - link register
+        sp      - stack pointer, 16-byte aligned
+        v0-v7   - parameters/results, volatile
+        v8-v15  - low 64 bits non-volatile
+        v16-v31 - volatile
+
+    ---------------
+    Register usage
+    ---------------
+
+        x0-x3   - parameters to C helpers
+        x9-x13  - temporaries
+        x16     - scratch for flags and indirect calls
+        x17     - scratch for address materialization
+        x19-x27 - UML integer registers I0-I8
+        x28     - base pointer (near cache)
+        d8-d15  - UML float registers F0-F7
+        v16-v17 - float temporaries
+
+    -------------
+    Flag mapping
+    -------------
+
+    The UML Z, S and V flags map directly onto the host Z, N and V
+    flags.  The host C flag holds the inverse of the UML carry after a
+    subtract, so it is used directly for subtract/compare results and
+    inverted after additions to keep the invariant that host C is the
+    complement of UML C.  The UML U flag (unordered) is only produced
+    by FCMP and lives in the host V flag, which FCMP sets for unordered
+    results.
+
+    -------------
+    Code handles
+    -------------
+
+    Code handles are entered with a branch-and-link.  The handle prolog
+    pushes the link register, keeping the stack 16-byte aligned, and
+    RET pops it again.  Hash table entry points are entered with the
+    stack pointer at hashstacksave; the nocode handler simply returns to
+    the HASHJMP that called it, which then performs the exception.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcbearm64.h"
+
+#include "debug/debugcpu.h"
+#include "emuopts.h"
+
+#include <cstddef>
+
+
+namespace drc {
+
+using namespace uml;
+
+using namespace asmjit;
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// map UML parameter types to bitmasks for validation
+const uint32_t PTYPE_M    = 1 << parameter::PTYPE_MEMORY;
+const uint32_t PTYPE_I    = 1 << parameter::PTYPE_IMMEDIATE;
+const uint32_t PTYPE_R    = 1 << parameter::PTYPE_INT_REGISTER;
+const uint32_t PTYPE_F    = 1 << parameter::PTYPE_FLOAT_REGISTER;
+
+// combinations of types
+const uint32_t PTYPE_MR   = PTYPE_M | PTYPE_R;
+const uint32_t PTYPE_MRI  = PTYPE_M | PTYPE_R | PTYPE_I;
+const uint32_t PTYPE_MF   = PTYPE_M | PTYPE_F;
+
+// host register assignments
+const uint32_t REG_PARAM1   = 0;
+const uint32_t REG_PARAM2   = 1;
+const uint32_t REG_PARAM3   = 2;
+const uint32_t REG_PARAM4   = 3;
+
+const uint32_t TEMP_REG1    = 9;
+const uint32_t TEMP_REG2    = 10;
+const uint32_t TEMP_REG3    = 11;
+const uint32_t TEMP_REG4    = 12;
+const uint32_t TEMP_REG5    = 13;
+
+const uint32_t SCRATCH_REG1 = 16;
+const uint32_t SCRATCH_REG2 = 17;
+
+const uint32_t BASE_REG     = 28;
+
+const uint32_t TEMPF_REG1   = 16;
+const uint32_t TEMPF_REG2   = 17;
+
+// host NZCV flag bits
+const uint32_t NZCV_N       = 1 << 31;
+const uint32_t NZCV_Z       = 1 << 30;
+const uint32_t NZCV_C       = 1 << 29;
+const uint32_t NZCV_V       = 1 << 28;
+
+// stack frame used by the entry point
+const int32_t ENTRY_FRAME_SIZE = 160;
+
+// frame pushed by code handle prologs
+const int32_t HANDLE_FRAME_SIZE = 16;
+
+
+
+//**************************************************************************
+//  MACROS
+//**************************************************************************
+
+#define ARM_CONDITION(condition)        (condition_map[condition - uml::COND_Z])
+#define ARM_NOT_CONDITION(condition)    a64::negateCond(condition_map[condition - uml::COND_Z])
+
+#define assert_no_condition(inst)       assert((inst).condition() == uml::COND_ALWAYS)
+#define assert_any_condition(inst)      assert((inst).condition() == uml::COND_ALWAYS || ((inst).condition() >= uml::COND_Z && (inst).condition() < uml::COND_MAX))
+#define assert_no_flags(inst)           assert((inst).flags() == 0)
+#define assert_flags(inst, valid)       assert(((inst).flags() & ~(valid)) == 0)
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+drcbe_arm64::opcode_generate_func drcbe_arm64::s_opcode_table[OP_MAX];
+
+// register mapping tables
+static const uint32_t int_register_map[REG_I_COUNT] =
+{
+	19, 20, 21, 22, 23, 24, 25, 26, 27, 0
+};
+
+static const uint32_t float_register_map[REG_F_COUNT] =
+{
+	8, 9, 10, 11, 12, 13, 14, 15, 0, 0
+};
+
+// condition mapping table
+static const a64::CondCode condition_map[uml::COND_MAX - uml::COND_Z] =
+{
+	a64::CondCode::kEQ,     // COND_Z = 0x80,    requires Z
+	a64::CondCode::kNE,     // COND_NZ,          requires Z
+	a64::CondCode::kMI,     // COND_S,           requires S
+	a64::CondCode::kPL,     // COND_NS,          requires S
+	a64::CondCode::kLO,     // COND_C,           requires C (host carry is inverted)
+	a64::CondCode::kHS,     // COND_NC,          requires C (host carry is inverted)
+	a64::CondCode::kVS,     // COND_V,           requires V
+	a64::CondCode::kVC,     // COND_NV,          requires V
+	a64::CondCode::kVS,     // COND_U,           requires U (held in host V)
+	a64::CondCode::kVC,     // COND_NU,          requires U (held in host V)
+	a64::CondCode::kHI,     // COND_A,           requires CZ
+	a64::CondCode::kLS,     // COND_BE,          requires CZ
+	a64::CondCode::kGT,     // COND_G,           requires SVZ
+	a64::CondCode::kLE,     // COND_LE,          requires SVZ
+	a64::CondCode::kLT,     // COND_L,           requires SV
+	a64::CondCode::kGE,     // COND_GE,          requires SV
+};
+
+// FPCR rounding mode field values for each UML rounding mode
+static const uint8_t fprnd_map[4] =
+{
+	3,  // ROUND_TRUNC,   truncate (RZ)
+	0,  // ROUND_ROUND,   round to nearest (RN)
+	1,  // ROUND_CEIL,    round up (RP)
+	2   // ROUND_FLOOR    round down (RM)
+};
+
+
+
+//**************************************************************************
+//  TABLES
+//**************************************************************************
+
+const drcbe_arm64::opcode_table_entry drcbe_arm64::s_opcode_table_source[] =
+{
+	// Compile-time opcodes
+	{ uml::OP_HANDLE,  &drcbe_arm64::op_handle },   // HANDLE  handle
+	{ uml::OP_HASH,    &drcbe_arm64::op_hash },     // HASH    mode,pc
+	{ uml::OP_LABEL,   &drcbe_arm64::op_label },    // LABEL   imm
+	{ uml::OP_COMMENT, &drcbe_arm64::op_comment },  // COMMENT string
+	{ uml::OP_MAPVAR,  &drcbe_arm64::op_mapvar },   // MAPVAR  mapvar,value
+
+	// Control Flow Operations
+	{ uml::OP_NOP,     &drcbe_arm64::op_nop },      // NOP
+	{ uml::OP_DEBUG,   &drcbe_arm64::op_debug },    // DEBUG   pc
+	{ uml::OP_EXIT,    &drcbe_arm64::op_exit },     // EXIT    src1[,c]
+	{ uml::OP_HASHJMP, &drcbe_arm64::op_hashjmp },  // HASHJMP mode,pc,handle
+	{ uml::OP_JMP,     &drcbe_arm64::op_jmp },      // JMP     imm[,c]
+	{ uml::OP_EXH,     &drcbe_arm64::op_exh },      // EXH     handle,param[,c]
+	{ uml::OP_CALLH,   &drcbe_arm64::op_callh },    // CALLH   handle[,c]
+	{ uml::OP_RET,     &drcbe_arm64::op_ret },      // RET     [c]
+	{ uml::OP_CALLC,   &drcbe_arm64::op_callc },    // CALLC   func,ptr[,c]
+	{ uml::OP_RECOVER, &drcbe_arm64::op_recover },  // RECOVER dst,mapvar
+
+	// Internal Register Operations
+	{ uml::OP_SETFMOD, &drcbe_arm64::op_setfmod },  // SETFMOD src
+	{ uml::OP_GETFMOD, &drcbe_arm64::op_getfmod },  // GETFMOD dst
+	{ uml::OP_GETEXP,  &drcbe_arm64::op_getexp },   // GETEXP  dst
+	{ uml::OP_GETFLGS, &drcbe_arm64::op_getflgs },  // GETFLGS dst[,f]
+	{ uml::OP_SAVE,    &drcbe_arm64::op_save },     // SAVE    dst
+	{ uml::OP_RESTORE, &drcbe_arm64::op_restore },  // RESTORE dst
+
+	// Integer Operations
+	{ uml::OP_LOAD,    &drcbe_arm64::op_load },     // LOAD    dst,base,index,size
+	{ uml::OP_LOADS,   &drcbe_arm64::op_loads },    // LOADS   dst,base,index,size
+	{ uml::OP_STORE,   &drcbe_arm64::op_store },    // STORE   base,index,src,size
+	{ uml::OP_READ,    &drcbe_arm64::op_read },     // READ    dst,src1,spacesize
+	{ uml::OP_READM,   &drcbe_arm64::op_readm },    // READM   dst,src1,mask,spacesize
+	{ uml::OP_WRITE,   &drcbe_arm64::op_write },    // WRITE   dst,src1,spacesize
+	{ uml::OP_WRITEM,  &drcbe_arm64::op_writem },   // WRITEM  dst,src1,spacesize
+	{ uml::OP_CARRY,   &drcbe_arm64::op_carry },    // CARRY   src,bitnum
+	{ uml::OP_SET,     &drcbe_arm64::op_set },      // SET     dst,c
+	{ uml::OP_MOV,     &drcbe_arm64::op_mov },      // MOV     dst,src[,c]
+	{ uml::OP_SEXT,    &drcbe_arm64::op_sext },     // SEXT    dst,src
+	{ uml::OP_ROLAND,  &drcbe_arm64::op_roland },   // ROLAND  dst,src1,src2,src3
+	{ uml::OP_ROLINS,  &drcbe_arm64::op_rolins },   // ROLINS  dst,src1,src2,src3
+	{ uml::OP_ADD,     &drcbe_arm64::op_add },      // ADD     dst,src1,src2[,f]
+	{ uml::OP_ADDC,    &drcbe_arm64::op_addc },     // ADDC    dst,src1,src2[,f]
+	{ uml::OP_SUB,     &drcbe_arm64::op_sub },      // SUB     dst,src1,src2[,f]
+	{ uml::OP_SUBB,    &drcbe_arm64::op_subc },     // SUBB    dst,src1,src2[,f]
+	{ uml::OP_CMP,     &drcbe_arm64::op_cmp },      // CMP     src1,src2[,f]
+	{ uml::OP_MULU,    &drcbe_arm64::op_mulu },     // MULU    dst,edst,src1,src2[,f]
+	{ uml::OP_MULS,    &drcbe_arm64::op_muls },     // MULS    dst,edst,src1,src2[,f]
+	{ uml::OP_DIVU,    &drcbe_arm64::op_divu },     // DIVU    dst,edst,src1,src2[,f]
+	{ uml::OP_DIVS,    &drcbe_arm64::op_divs },     // DIVS    dst,edst,src1,src2[,f]
+	{ uml::OP_AND,     &drcbe_arm64::op_and },      // AND     dst,src1,src2[,f]
+	{ uml::OP_TEST,    &drcbe_arm64::op_test },     // TEST    src1,src2[,f]
+	{ uml::OP_OR,      &drcbe_arm64::op_or },       // OR      dst,src1,src2[,f]
+	{ uml::OP_XOR,     &drcbe_arm64::op_xor },      // XOR     dst,src1,src2[,f]
+	{ uml::OP_LZCNT,   &drcbe_arm64::op_lzcnt },    // LZCNT   dst,src[,f]
+	{ uml::OP_TZCNT,   &drcbe_arm64::op_tzcnt },    // TZCNT   dst,src[,f]
+	{ uml::OP_BSWAP,   &drcbe_arm64::op_bswap },    // BSWAP   dst,src
+	{ uml::OP_SHL,     &drcbe_arm64::op_shift<uml::OP_SHL> },   // SHL     dst,src,count[,f]
+	{ uml::OP_SHR,     &drcbe_arm64::op_shift<uml::OP_SHR> },   // SHR     dst,src,count[,f]
+	{ uml::OP_SAR,     &drcbe_arm64::op_shift<uml::OP_SAR> },   // SAR     dst,src,count[,f]
+	{ uml::OP_ROL,     &drcbe_arm64::op_shift<uml::OP_ROL> },   // ROL     dst,src,count[,f]
+	{ uml::OP_ROLC,    &drcbe_arm64::op_rotc<uml::OP_ROLC> },   // ROLC    dst,src,count[,f]
+	{ uml::OP_ROR,     &drcbe_arm64::op_shift<uml::OP_ROR> },   // ROR     dst,src,count[,f]
+	{ uml::OP_RORC,    &drcbe_arm64::op_rotc<uml::OP_RORC> },   // RORC    dst,src,count[,f]
+
+	// Floating Point Operations
+	{ uml::OP_FLOAD,   &drcbe_arm64::op_fload },    // FLOAD   dst,base,index
+	{ uml::OP_FSTORE,  &drcbe_arm64::op_fstore },   // FSTORE  base,index,src
+	{ uml::OP_FREAD,   &drcbe_arm64::op_fread },    // FREAD   dst,space,src1
+	{ uml::OP_FWRITE,  &drcbe_arm64::op_fwrite },   // FWRITE  space,dst,src1
+	{ uml::OP_FMOV,    &drcbe_arm64::op_fmov },     // FMOV    dst,src1[,c]
+	{ uml::OP_FTOINT,  &drcbe_arm64::op_ftoint },   // FTOINT  dst,src1,size,round
+	{ uml::OP_FFRINT,  &drcbe_arm64::op_ffrint },   // FFRINT  dst,src1,size
+	{ uml::OP_FFRFLT,  &drcbe_arm64::op_ffrflt },   // FFRFLT  dst,src1,size
+	{ uml::OP_FRNDS,   &drcbe_arm64::op_frnds },    // FRNDS   dst,src1
+	{ uml::OP_FADD,    &drcbe_arm64::op_float_alu<a64::Inst::kIdFadd_v> },  // FADD    dst,src1,src2
+	{ uml::OP_FSUB,    &drcbe_arm64::op_float_alu<a64::Inst::kIdFsub_v> },  // FSUB    dst,src1,src2
+	{ uml::OP_FCMP,    &drcbe_arm64::op_fcmp },     // FCMP    src1,src2
+	{ uml::OP_FMUL,    &drcbe_arm64::op_float_alu<a64::Inst::kIdFmul_v> },  // FMUL    dst,src1,src2
+	{ uml::OP_FDIV,    &drcbe_arm64::op_float_alu<a64::Inst::kIdFdiv_v> },  // FDIV    dst,src1,src2
+	{ uml::OP_FNEG,    &drcbe_arm64::op_float_alu2<a64::Inst::kIdFneg_v> }, // FNEG    dst,src1
+	{ uml::OP_FABS,    &drcbe_arm64::op_float_alu2<a64::Inst::kIdFabs_v> }, // FABS    dst,src1
+	{ uml::OP_FSQRT,   &drcbe_arm64::op_float_alu2<a64::Inst::kIdFsqrt_v> },// FSQRT   dst,src1
+	{ uml::OP_FRECIP,  &drcbe_arm64::op_frecip },   // FRECIP  dst,src1
+	{ uml::OP_FRSQRT,  &drcbe_arm64::op_frsqrt },   // FRSQRT  dst,src1
+	{ uml::OP_FCOPYI,  &drcbe_arm64::op_fcopyi },   // FCOPYI  dst,src
+	{ uml::OP_ICOPYF,  &drcbe_arm64::op_icopyf }    // ICOPYF  dst,src
+};
+
+namespace {
+
+class ThrowableErrorHandler : public ErrorHandler
+{
+public:
+	void handleError(Error err, const char *message, BaseEmitter *origin) override
+	{
+		throw emu_fatalerror("asmjit error %d: %s", err, message);
+	}
+};
+
+// condition codes are passed to CSEL/CSET as immediates
+inline Imm cond_imm(a64::CondCode cond)
+{
+	return Imm(uint32_t(cond));
+}
+
+// true if the value can be encoded as an ADD/SUB immediate
+inline bool is_valid_immediate_addsub(uint64_t val)
+{
+	return (val < 4096) || (!(val & 0xfff) && (val < (1 << 24)));
+}
+
+// true if the value can be encoded as a logical (AND/ORR/EOR) immediate
+inline bool is_valid_immediate_logical(uint64_t val, uint32_t bytes)
+{
+	return a64::Utils::isLogicalImm(val, bytes * 8);
+}
+
+// if the value is a contiguous run of set bits, return its position and width
+inline bool is_contiguous_mask(uint64_t val, uint32_t bytes, uint32_t &lsb, uint32_t &width)
+{
+	if (bytes == 4)
+		val = uint32_t(val);
+	if (val == 0)
+		return false;
+	lsb = population_count_64((val & -val) - 1);
+	const uint64_t shifted = val >> lsb;
+	if (shifted & (shifted + 1))
+		return false;
+	width = population_count_64(shifted);
+	return true;
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  be_parameter - convert a full parameter
+//  into a reduced set
+//-------------------------------------------------
+
+drcbe_arm64::be_parameter::be_parameter(drcbe_arm64 &drcbe, const parameter &param, uint32_t allowed)
+{
+	int regnum;
+
+	switch (param.type())
+	{
+		// immediates pass through
+		case parameter::PTYPE_IMMEDIATE:
+			assert(allowed & PTYPE_I);
+			*this = param.immediate();
+			break;
+
+		// memory passes through
+		case parameter::PTYPE_MEMORY:
+			assert(allowed & PTYPE_M);
+			*this = make_memory(param.memory());
+			break;
+
+		// if a register maps to a register, keep it as a register; otherwise map it to memory
+		case parameter::PTYPE_INT_REGISTER:
+			assert(allowed & PTYPE_R);
+			assert(allowed & PTYPE_M);
+			regnum = int_register_map[param.ireg() - REG_I0];
+			if (regnum != 0)
+				*this = make_ireg(regnum);
+			else
+				*this = make_memory(&drcbe.m_state.r[param.ireg() - REG_I0]);
+			break;
+
+		// if a register maps to a register, keep it as a register; otherwise map it to memory
+		case parameter::PTYPE_FLOAT_REGISTER:
+			assert(allowed & PTYPE_F);
+			assert(allowed & PTYPE_M);
+			regnum = float_register_map[param.freg() - REG_F0];
+			if (regnum != 0)
+				*this = make_freg(regnum);
+			else
+				*this = make_memory(&drcbe.m_state.f[param.freg() - REG_F0]);
+			break;
+
+		// everything else is unexpected
+		default:
+			fatalerror("Unexpected parameter type\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  select_register - select a register to use,
+//  preferring the parameter's own register
+//-------------------------------------------------
+
+inline a64::Gp drcbe_arm64::be_parameter::select_register(a64::Gp const &defreg, uint32_t size) const
+{
+	if (m_type == PTYPE_INT_REGISTER)
+		return (size == 4) ? a64::Gp(a64::w(m_value)) : a64::Gp(a64::x(m_value));
+	return (size == 4) ? a64::Gp(defreg.w()) : a64::Gp(defreg.x());
+}
+
+inline a64::Vec drcbe_arm64::be_parameter::select_register(a64::Vec const &defreg, uint32_t size) const
+{
+	if (m_type == PTYPE_FLOAT_REGISTER)
+		return (size == 4) ? a64::Vec(a64::s(m_value)) : a64::Vec(a64::d(m_value));
+	return (size == 4) ? a64::Vec(defreg.s()) : a64::Vec(defreg.d());
+}
+
+
+//-------------------------------------------------
+//  get_mem_absolute - return a memory operand
+//  addressing the given pointer, relative to the
+//  base register where possible
+//-------------------------------------------------
+
+inline a64::Mem drcbe_arm64::get_mem_absolute(a64::Assembler &a, const void *ptr, uint32_t size) const
+{
+	const a64::Gp base = a64::x(BASE_REG);
+	const a64::Gp scratch = a64::x(SCRATCH_REG2);
+	const int64_t offset = reinterpret_cast<const uint8_t *>(ptr) - m_baseptr;
+
+	// unscaled signed 9-bit offset or scaled unsigned 12-bit offset
+	if ((offset >= -256 && offset <= 255) || (offset >= 0 && !(offset & (size - 1)) && (offset / size) < 4096))
+		return a64::ptr(base, int32_t(offset));
+
+	// add the upper bits to the base and use the low 12 bits as an offset
+	if (offset >= 0 && offset < (1 << 24) && !(offset & (size - 1)))
+	{
+		a.add(scratch, base, offset & ~0xfff);
+		return a64::ptr(scratch, int32_t(offset & 0xfff));
+	}
+
+	// otherwise materialize the full address
+	a.mov(scratch, uintptr_t(ptr));
+	return a64::ptr(scratch);
+}
+
+
+//-------------------------------------------------
+//  get_imm_relative - load an address into a
+//  register as cheaply as possible
+//-------------------------------------------------
+
+inline void drcbe_arm64::get_imm_relative(a64::Assembler &a, a64::Gp const &reg, uint64_t ptr) const
+{
+	const int64_t baseoffs = int64_t(ptr) - int64_t(uintptr_t(m_baseptr));
+	const int64_t pcoffs = int64_t(ptr) - int64_t(a.code()->baseAddress() + a.offset());
+
+	if (baseoffs >= 0 && baseoffs < 4096)
+		a.add(reg.x(), a64::x(BASE_REG), baseoffs);
+	else if (baseoffs < 0 && baseoffs > -4096)
+		a.sub(reg.x(), a64::x(BASE_REG), -baseoffs);
+	else if (pcoffs >= -(1 << 20) && pcoffs < (1 << 20))
+		a.adr(reg.x(), imm(ptr));
+	else
+		a.mov(reg.x(), ptr);
+}
+
+
+//-------------------------------------------------
+//  call_arm_addr - generate a call either
+//  directly or via a register
+//-------------------------------------------------
+
+inline void drcbe_arm64::call_arm_addr(a64::Assembler &a, const void *offs) const
+{
+	const uint64_t target = uintptr_t(offs);
+	const int64_t delta = int64_t(target) - int64_t(a.code()->baseAddress() + a.offset());
+
+	if (delta >= -(int64_t(1) << 27) && delta < (int64_t(1) << 27))
+	{
+		a.bl(imm(target));                                                              // bl    target
+	}
+	else
+	{
+		a.mov(a64::x(SCRATCH_REG1), target);                                            // mov   x16,target
+		a.blr(a64::x(SCRATCH_REG1));                                                    // blr   x16
+	}
+}
+
+
+//-------------------------------------------------
+//  call_ptr - generate a call through a pointer
+//  held in memory
+//-------------------------------------------------
+
+inline void drcbe_arm64::call_ptr(a64::Assembler &a, void *const *target) const
+{
+	a.ldr(a64::x(SCRATCH_REG1), get_mem_absolute(a, target, 8));                        // ldr   x16,[target]
+	a.blr(a64::x(SCRATCH_REG1));                                                        // blr   x16
+}
+
+
+//-------------------------------------------------
+//  call_handle - generate a call to a code
+//  handle, directly if it is already resolved
+//-------------------------------------------------
+
+inline void drcbe_arm64::call_handle(a64::Assembler &a, uml::code_handle const &handle) const
+{
+	drccodeptr *const targetptr = const_cast<uml::code_handle &>(handle).codeptr_addr();
+	if (*targetptr != nullptr)
+		call_arm_addr(a, *targetptr);                                                   // bl    *targetptr
+	else
+		call_ptr(a, reinterpret_cast<void *const *>(targetptr));                        // blr   [targetptr]
+}
+
+
+//-------------------------------------------------
+//  invert_carry - complement the host carry flag
+//-------------------------------------------------
+
+inline void drcbe_arm64::invert_carry(a64::Assembler &a) const
+{
+	const a64::Gp scratch = a64::x(SCRATCH_REG1);
+
+	a.mrs(scratch, a64::Predicate::SysReg::kNZCV);                                      // mrs   x16,nzcv
+	a.eor(scratch, scratch, NZCV_C);                                                    // eor   x16,x16,#C
+	a.msr(a64::Predicate::SysReg::kNZCV, scratch);                                      // msr   nzcv,x16
+}
+
+
+//-------------------------------------------------
+//  set_carry_from_reg - set the UML carry flag
+//  from bit 0 of a register, preserving the
+//  other flags
+//-------------------------------------------------
+
+inline void drcbe_arm64::set_carry_from_reg(a64::Assembler &a, a64::Gp const &bit) const
+{
+	const a64::Gp scratch = a64::x(SCRATCH_REG1);
+
+	a.eor(bit.x(), bit.x(), 1);                                                         // eor   bit,bit,#1
+	a.mrs(scratch, a64::Predicate::SysReg::kNZCV);                                      // mrs   x16,nzcv
+	a.bfi(scratch, bit.x(), 29, 1);                                                     // bfi   x16,bit,#29,#1
+	a.msr(a64::Predicate::SysReg::kNZCV, scratch);                                      // msr   nzcv,x16
+}
+
+
+//-------------------------------------------------
+//  set_flags_from_uml - set the host flags from
+//  UML flags held in a register
+//-------------------------------------------------
+
+inline void drcbe_arm64::set_flags_from_uml(a64::Assembler &a, a64::Gp const &flags) const
+{
+	const a64::Gp scratch = a64::x(SCRATCH_REG1);
+
+	get_imm_relative(a, scratch, uintptr_t(&m_near.flagsunmap[0]));                     // add   x16,base,flagsunmap
+	a.ldr(scratch.w(), a64::ptr(scratch, flags.x(), arm::lsl(2)));                       // ldr   w16,[x16,flags,lsl #2]
+	a.msr(a64::Predicate::SysReg::kNZCV, scratch);                                      // msr   nzcv,x16
+}
+
+
+//-------------------------------------------------
+//  get_uml_flags - convert the host flags into
+//  UML flags in a register
+//-------------------------------------------------
+
+inline void drcbe_arm64::get_uml_flags(a64::Assembler &a, a64::Gp const &dst) const
+{
+	const a64::Gp scratch = a64::x(SCRATCH_REG1);
+	const a64::Gp table = a64::x(SCRATCH_REG2);
+
+	a.mrs(scratch, a64::Predicate::SysReg::kNZCV);                                      // mrs   x16,nzcv
+	a.lsr(scratch, scratch, 28);                                                        // lsr   x16,x16,#28
+	get_imm_relative(a, table, uintptr_t(&m_near.flagsmap[0]));                         // add   x17,base,flagsmap
+	a.ldrb(dst.w(), a64::ptr(table, scratch));                                          // ldrb  dst,[x17,x16]
+}
+
+
+//-------------------------------------------------
+//  set_rounding_mode - set the FPCR rounding mode
+//  field from a register holding an FPCR RMode
+//  value
+//-------------------------------------------------
+
+inline void drcbe_arm64::set_rounding_mode(a64::Assembler &a, a64::Gp const &mode) const
+{
+	const a64::Gp scratch = a64::x(SCRATCH_REG1);
+
+	a.mrs(scratch, a64::Predicate::SysReg::kFPCR);                                      // mrs   x16,fpcr
+	a.bfi(scratch, mode.x(), 22, 2);                                                    // bfi   x16,mode,#22,#2
+	a.msr(a64::Predicate::SysReg::kFPCR, scratch);                                      // msr   fpcr,x16
+}
+
+
+
+//**************************************************************************
+//  BACKEND CALLBACKS
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcbe_arm64 - constructor
+//-------------------------------------------------
+
+drcbe_arm64::drcbe_arm64(drcuml_state &drcuml, device_t &device, drc_cache &cache, uint32_t flags, int modes, int addrbits, int ignorebits)
+	: drcbe_interface(drcuml, cache, device)
+	, m_hash(cache, modes, addrbits, ignorebits)
+	, m_map(cache, 0xaaaaaaaa5555)
+	, m_log_asmjit(nullptr)
+	, m_baseptr(cache.near())
+	, m_entry(nullptr)
+	, m_exit(nullptr)
+	, m_nocode(nullptr)
+	, m_near(*(near_state *)cache.alloc_near(sizeof(m_near)))
+{
+	// build up necessary arrays
+	memcpy(m_near.fpmode, fprnd_map, sizeof(m_near.fpmode));
+
+	// get pointers to C functions we need to call
+	using debugger_hook_func = void (*)(device_debug *, offs_t);
+	static const debugger_hook_func debugger_inst_hook = [] (device_debug *dbg, offs_t pc) { dbg->instruction_hook(pc); };
+	m_near.debug_cpu_instruction_hook = (void *)debugger_inst_hook;
+	m_near.drcmap_get_value = (void *)&drc_map_variables::static_get_value;
+
+	// build the flags map (host NZCV >> 28 to UML flags)
+	for (int entry = 0; entry < std::size(m_near.flagsmap); entry++)
+	{
+		uint8_t flags = 0;
+		if (!(entry & 0x2)) flags |= FLAG_C;
+		if (entry & 0x1) flags |= FLAG_V | FLAG_U;
+		if (entry & 0x4) flags |= FLAG_Z;
+		if (entry & 0x8) flags |= FLAG_S;
+		m_near.flagsmap[entry] = flags;
+	}
+	for (int entry = 0; entry < std::size(m_near.flagsunmap); entry++)
+	{
+		uint32_t flags = 0;
+		if (!(entry & FLAG_C)) flags |= NZCV_C;
+		if (entry & (FLAG_V | FLAG_U)) flags |= NZCV_V;
+		if (entry & FLAG_Z) flags |= NZCV_Z;
+		if (entry & FLAG_S) flags |= NZCV_N;
+		m_near.flagsunmap[entry] = flags;
+	}
+
+	// build the opcode table (static but it doesn't hurt to regenerate it)
+	for (auto & elem : s_opcode_table_source)
+		s_opcode_table[elem.opcode] = elem.func;
+
+	// create the log
+	if (device.machine().options().drc_log_native())
+		m_log_asmjit = fopen(std::string("drcbearm64_asmjit_").append(device.shortname()).append(".asm").c_str(), "w");
+}
+
+
+//-------------------------------------------------
+//  ~drcbe_arm64 - destructor
+//-------------------------------------------------
+
+drcbe_arm64::~drcbe_arm64()
+{
+	if (m_log_asmjit)
+		fclose(m_log_asmjit);
+}
+
+size_t drcbe_arm64::emit(CodeHolder &ch)
+{
+	Error err;
+
+	size_t const alignment = ch.baseAddress() - uint64_t(m_cache.top());
+	size_t const code_size = ch.codeSize();
+
+	// test if enough room remains in drc cache
+	drccodeptr *cachetop = m_cache.begin_codegen(alignment + code_size);
+	if (cachetop == nullptr)
+		return 0;
+
+	err = ch.copyFlattenedData(drccodeptr(ch.baseAddress()), code_size, CopySectionFlags::kPadTargetBuffer);
+	if (err)
+		throw emu_fatalerror("asmjit::CodeHolder::copyFlattenedData() error %d", err);
+
+	// update the drc cache and end codegen (this also flushes the instruction cache)
+	*cachetop += alignment + code_size;
+	m_cache.end_codegen();
+
+	return code_size;
+}
+
+//-------------------------------------------------
+//  reset - reset back-end specific state
+//-------------------------------------------------
+
+void drcbe_arm64::reset()
+{
+	// generate a little bit of glue code to set up the environment
+	drccodeptr dst = (drccodeptr)m_cache.top();
+
+	CodeHolder ch;
+	ch.init(Environment::host(), uint64_t(dst));
+	ThrowableErrorHandler e;
+	ch.setErrorHandler(&e);
+
+	FileLogger logger(m_log_asmjit);
+	if (logger.file())
+	{
+		logger.setFlags(FormatFlags::kHexOffsets | FormatFlags::kHexImms | FormatFlags::kMachineCode);
+		logger.setIndentation(FormatIndentationGroup::kCode, 4);
+		ch.setLogger(&logger);
+	}
+
+	a64::Assembler a(&ch);
+	if (logger.file())
+		a.addDiagnosticOptions(DiagnosticOptions::kValidateIntermediate);
+
+	// generate an entry point
+	m_entry = (arm64_entry_point_func)dst;
+	a.bind(a.newNamedLabel("entry_point"));
+
+	a.stp(a64::x29, a64::x30, a64::ptr_pre(a64::sp, -ENTRY_FRAME_SIZE));                // stp   x29,x30,[sp,#-160]!
+	a.mov(a64::x29, a64::sp);                                                           // mov   x29,sp
+	for (int regnum = 19; regnum < 29; regnum += 2)
+		a.stp(a64::x(regnum), a64::x(regnum + 1), a64::ptr(a64::sp, 16 + (regnum - 19) * 8));
+																						// stp   x19-x28
+	for (int regnum = 8; regnum < 16; regnum += 2)
+		a.stp(a64::d(regnum), a64::d(regnum + 1), a64::ptr(a64::sp, 96 + (regnum - 8) * 8));
+																						// stp   d8-d15
+
+	a.mov(a64::x(BASE_REG), a64::x(REG_PARAM1));                                        // mov   base,param1
+	a.mrs(a64::x(SCRATCH_REG1), a64::Predicate::SysReg::kFPCR);                         // mrs   x16,fpcr
+	a.str(a64::x(SCRATCH_REG1), get_mem_absolute(a, &m_near.fpcr, 8));                  // str   x16,[fpcr]
+	a.mov(a64::x(SCRATCH_REG1), a64::sp);                                               // mov   x16,sp
+	a.str(a64::x(SCRATCH_REG1), get_mem_absolute(a, &m_near.hashstacksave, 8));         // str   x16,[hashstacksave]
+	a.str(a64::x(SCRATCH_REG1), get_mem_absolute(a, &m_near.stacksave, 8));             // str   x16,[stacksave]
+	a.br(a64::x(REG_PARAM2));                                                           // br    param2
+
+	// generate an exit point
+	m_exit = dst + a.offset();
+	a.bind(a.newNamedLabel("exit_point"));
+	a.ldr(a64::x(SCRATCH_REG1), get_mem_absolute(a, &m_near.fpcr, 8));                  // ldr   x16,[fpcr]
+	a.msr(a64::Predicate::SysReg::kFPCR, a64::x(SCRATCH_REG1));                         // msr   fpcr,x16
+	a.ldr(a64::x(SCRATCH_REG1), get_mem_absolute(a, &m_near.hashstacksave, 8));         // ldr   x16,[hashstacksave]
+	a.mov(a64::sp, a64::x(SCRATCH_REG1));                                               // mov   sp,x16
+	for (int regnum = 8; regnum < 16; regnum += 2)
+		a.ldp(a64::d(regnum), a64::d(regnum + 1), a64::ptr(a64::sp, 96 + (regnum - 8) * 8));
+																						// ldp   d8-d15
+	for (int regnum = 19; regnum < 29; regnum += 2)
+		a.ldp(a64::x(regnum), a64::x(regnum + 1), a64::ptr(a64::sp, 16 + (regnum - 19) * 8));
+																						// ldp   x19-x28
+	a.ldp(a64::x29, a64::x30, a64::ptr_post(a64::sp, ENTRY_FRAME_SIZE));                // ldp   x29,x30,[sp],#160
+	a.ret(a64::x30);                                                                    // ret
+
+	// generate a no code point
+	m_nocode = dst + a.offset();
+	a.bind(a.newNamedLabel("nocode_point"));
+	a.ret(a64::x30);                                                                    // ret
+
+	// emit the generated code
+	emit(ch);
+
+	// reset our hash tables
+	m_hash.reset();
+	m_hash.set_default_codeptr(m_nocode);
+}
+
+
+//-------------------------------------------------
+//  execute - execute a block of code referenced
+//  by the given handle
+//-------------------------------------------------
+
+int drcbe_arm64::execute(code_handle &entry)
+{
+	// call our entry point which will jump to the destination
+	m_cache.codegen_complete();
+	return (*m_entry)(m_baseptr, (drccodeptr)entry.codeptr());
+}
+
+
+//-------------------------------------------------
+//  generate - generate code
+//-------------------------------------------------
+
+void drcbe_arm64::generate(drcuml_block &block, const instruction *instlist, uint32_t numinst)
+{
+	// tell all of our utility objects that a block is beginning
+	m_hash.block_begin(block, instlist, numinst);
+	m_map.block_begin(block);
+
+	// compute the base by aligning the cache top to a cache line (assumed to be 64 bytes)
+	drccodeptr dst = (drccodeptr)(uint64_t(m_cache.top() + 63) & ~63);
+
+	CodeHolder ch;
+	ch.init(Environment::host(), uint64_t(dst));
+	ThrowableErrorHandler e;
+	ch.setErrorHandler(&e);
+
+	FileLogger logger(m_log_asmjit);
+	if (logger.file())
+	{
+		logger.setFlags(FormatFlags::kHexOffsets | FormatFlags::kHexImms | FormatFlags::kMachineCode);
+		logger.setIndentation(FormatIndentationGroup::kCode, 4);
+		ch.setLogger(&logger);
+	}
+
+	a64::Assembler a(&ch);
+	if (logger.file())
+		a.addDiagnosticOptions(DiagnosticOptions::kValidateIntermediate);
+
+	// generate code
+	for (int inum = 0; inum < numinst; inum++)
+	{
+		const instruction &inst = instlist[inum];
+		assert(inst.opcode() < std::size(s_opcode_table));
+
+		// must remain in scope until output
+		std::string dasm;
+
+		// add a comment
+		if (logger.file())
+		{
+			dasm = inst.disasm(&m_drcuml);
+			a.setInlineComment(dasm.c_str());
+		}
+
+		// generate code
+		(this->*s_opcode_table[inst.opcode()])(a, inst);
+	}
+
+	// emit the generated code
+	if (!emit(ch))
+		block.abort();
+
+	// tell all of our utility objects that the block is finished
+	m_hash.block_end(block);
+	m_map.block_end(block);
+}
+
+
+//-------------------------------------------------
+//  hash_exists - return true if the given mode/pc
+//  exists in the hash table
+//-------------------------------------------------
+
+bool drcbe_arm64::hash_exists(uint32_t mode, uint32_t pc)
+{
+	return m_hash.code_exists(mode, pc);
+}
+
+
+//-------------------------------------------------
+//  get_info - return information about the
+//  back-end implementation
+//-------------------------------------------------
+
+void drcbe_arm64::get_info(drcbe_info &info)
+{
+	for (info.direct_iregs = 0; info.direct_iregs < REG_I_COUNT; info.direct_iregs++)
+		if (int_register_map[info.direct_iregs] == 0)
+			break;
+	for (info.direct_fregs = 0; info.direct_fregs < REG_F_COUNT; info.direct_fregs++)
+		if (float_register_map[info.direct_fregs] == 0)
+			break;
+}
+
+
+
+/***************************************************************************
+    PARAMETER HELPERS
+***************************************************************************/
+
+//-------------------------------------------------
+//  mov_reg_param - move a parameter into a
+//  register
+//-------------------------------------------------
+
+void drcbe_arm64::mov_reg_param(a64::Assembler &a, uint32_t regsize, a64::Gp const &reg, be_parameter const &param) const
+{
+	const a64::Gp dst = (regsize == 4) ? a64::Gp(reg.w()) : a64::Gp(reg.x());
+
+	if (param.is_immediate())
+	{
+		if (regsize == 4)
+			a.mov(dst, uint32_t(param.immediate()));                                    // mov   reg,param
+		else
+			a.mov(dst, param.immediate());                                              // mov   reg,param
+	}
+	else if (param.is_int_register())
+	{
+		const a64::Gp src = param.select_register(reg, regsize);
+		if (src.id() != dst.id())
+			a.mov(dst, src);                                                            // mov   reg,param
+	}
+	else if (param.is_memory())
+	{
+		a.ldr(dst, get_mem_absolute(a, param.memory(), regsize));                       // ldr   reg,[param]
+	}
+	else
+	{
+		throw emu_fatalerror("drcbe_arm64::mov_reg_param: unexpected parameter type %d", param.type());
+	}
+}
+
+
+//-------------------------------------------------
+//  mov_param_reg - move a register into a
+//  parameter
+//-------------------------------------------------
+
+void drcbe_arm64::mov_param_reg(a64::Assembler &a, uint32_t regsize, be_parameter const &param, a64::Gp const &reg) const
+{
+	const a64::Gp src = (regsize == 4) ? a64::Gp(reg.w()) : a64::Gp(reg.x());
+
+	if (param.is_int_register())
+	{
+		const a64::Gp dst = param.select_register(reg, regsize);
+		if (src.id() != dst.id())
+			a.mov(dst, src);                                                            // mov   param,reg
+	}
+	else if (param.is_memory())
+	{
+		a.str(src, get_mem_absolute(a, param.memory(), regsize));                       // str   reg,[param]
+	}
+	else
+	{
+		throw emu_fatalerror("drcbe_arm64::mov_param_reg: unexpected parameter type %d", param.type());
+	}
+}
+
+
+//-------------------------------------------------
+//  mov_float_reg_param - move a float parameter
+//  into a register
+//-------------------------------------------------
+
+void drcbe_arm64::mov_float_reg_param(a64::Assembler &a, uint32_t regsize, a64::Vec const &reg, be_parameter const &param) const
+{
+	const a64::Vec dst = (regsize == 4) ? a64::Vec(reg.s()) : a64::Vec(reg.d());
+
+	if (param.is_float_register())
+	{
+		const a64::Vec src = param.select_register(reg, regsize);
+		if (src.id() != dst.id())
+			a.fmov(dst, src);                                                           // fmov  reg,param
+	}
+	else if (param.is_memory())
+	{
+		a.ldr(dst, get_mem_absolute(a, param.memory(), regsize));                       // ldr   reg,[param]
+	}
+	else
+	{
+		throw emu_fatalerror("drcbe_arm64::mov_float_reg_param: unexpected parameter type %d", param.type());
+	}
+}
+
+
+//-------------------------------------------------
+//  mov_float_param_reg - move a register into a
+//  float parameter
+//-------------------------------------------------
+
+void drcbe_arm64::mov_float_param_reg(a64::Assembler &a, uint32_t regsize, be_parameter const &param, a64::Vec const &reg) const
+{
+	const a64::Vec src = (regsize == 4) ? a64::Vec(reg.s()) : a64::Vec(reg.d());
+
+	if (param.is_float_register())
+	{
+		const a64::Vec dst = param.select_register(reg, regsize);
+		if (src.id() != dst.id())
+			a.fmov(dst, src);                                                           // fmov  param,reg
+	}
+	else if (param.is_memory())
+	{
+		a.str(src, get_mem_absolute(a, param.memory(), regsize));                       // str   reg,[param]
+	}
+	else
+	{
+		throw emu_fatalerror("drcbe_arm64::mov_float_param_reg: unexpected parameter type %d", param.type());
+	}
+}
+
+
+//-------------------------------------------------
+//  load_int_operand - return a register holding
+//  the given parameter, loading it into the
+//  default register if necessary
+//-------------------------------------------------
+
+a64::Gp drcbe_arm64::load_int_operand(a64::Assembler &a, uint32_t regsize, be_parameter const &param, a64::Gp const &defreg) const
+{
+	if (param.is_int_register())
+		return param.select_register(defreg, regsize);
+
+	mov_reg_param(a, regsize, defreg, param);
+	return (regsize == 4) ? a64::Gp(defreg.w()) : a64::Gp(defreg.x());
+}
+
+
+//-------------------------------------------------
+//  load_float_operand - return a register holding
+//  the given float parameter, loading it into the
+//  default register if necessary
+//-------------------------------------------------
+
+a64::Vec drcbe_arm64::load_float_operand(a64::Assembler &a, uint32_t regsize, be_parameter const &param, a64::Vec const &defreg) const
+{
+	if (param.is_float_register())
+		return param.select_register(defreg, regsize);
+
+	mov_float_reg_param(a, regsize, defreg, param);
+	return (regsize == 4) ? a64::Vec(defreg.s()) : a64::Vec(defreg.d());
+}
+
+
+
+/***************************************************************************
+    COMPILE-TIME OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_handle - process a HANDLE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_handle(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_code_handle());
+
+	// make a label for documentation
+	Label handle = a.newNamedLabel(inst.param(0).handle().string());
+	a.bind(handle);
+
+	// emit a jump around the stack adjust in case code falls through here
+	Label skip = a.newLabel();
+	a.b(skip);                                                                          // b     skip
+
+	// register the current pointer for the handle
+	inst.param(0).handle().set_codeptr(drccodeptr(a.code()->baseAddress() + a.offset()));
+
+	// by default, the handle points to prolog code that saves the return address
+	a.str(a64::x30, a64::ptr_pre(a64::sp, -HANDLE_FRAME_SIZE));                         // str   x30,[sp,#-16]!
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_hash - process a HASH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_hash(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 2);
+	assert(inst.param(0).is_immediate());
+	assert(inst.param(1).is_immediate());
+
+	// register the current pointer for the mode/PC
+	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), drccodeptr(a.code()->baseAddress() + a.offset()));
+}
+
+
+//-------------------------------------------------
+//  op_label - process a LABEL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_label(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_code_label());
+
+	std::string labelName = util::string_format("PC$%x", inst.param(0).label());
+	Label label = a.labelByName(labelName.c_str());
+	if (!label.isValid())
+		label = a.newNamedLabel(labelName.c_str());
+
+	// register the current pointer for the label
+	a.bind(label);
+}
+
+
+//-------------------------------------------------
+//  op_comment - process a COMMENT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_comment(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_string());
+
+	// do nothing
+}
+
+
+//-------------------------------------------------
+//  op_mapvar - process a MAPVAR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mapvar(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 2);
+	assert(inst.param(0).is_mapvar());
+	assert(inst.param(1).is_immediate());
+
+	// set the value of the specified mapvar
+	m_map.set_value(drccodeptr(a.code()->baseAddress() + a.offset()), inst.param(0).mapvar(), inst.param(1).immediate());
+}
+
+
+
+/***************************************************************************
+    CONTROL FLOW OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_nop - process a NOP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_nop(a64::Assembler &a, const instruction &inst)
+{
+	// nothing
+}
+
+
+//-------------------------------------------------
+//  op_debug - process a DEBUG opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_debug(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	if ((m_device.machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		// normalize parameters
+		be_parameter pcp(*this, inst.param(0), PTYPE_MRI);
+
+		// test and branch
+		const a64::Gp temp = a64::w(TEMP_REG1);
+		a.ldr(temp, get_mem_absolute(a, &m_device.machine().debug_flags, 4));          // ldr   w9,[debug_flags]
+		Label skip = a.newLabel();
+		a.tbz(temp, 1, skip);                                                           // tbz   w9,#DEBUG_FLAG_CALL_HOOK,skip
+		static_assert(DEBUG_FLAG_CALL_HOOK == (1 << 1), "DEBUG_FLAG_CALL_HOOK bit changed");
+
+		// call the hook
+		a.mov(a64::x(REG_PARAM1), uintptr_t(m_device.debug()));                         // mov   param1,device.debug
+		mov_reg_param(a, 4, a64::w(REG_PARAM2), pcp);                                   // mov   param2,pcp
+		call_ptr(a, &m_near.debug_cpu_instruction_hook);                                // blr   debug_cpu_instruction_hook
+
+		a.bind(skip);
+	}
+}
+
+
+//-------------------------------------------------
+//  op_exit - process an EXIT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_exit(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter retp(*this, inst.param(0), PTYPE_MRI);
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.b(ARM_NOT_CONDITION(inst.condition()), skip);                                 // b.!cc skip
+
+	// load the parameter into w0 and branch to the exit point
+	mov_reg_param(a, 4, a64::w(REG_PARAM1), retp);                                      // mov   w0,retp
+	const int64_t delta = int64_t(uintptr_t(m_exit)) - int64_t(a.code()->baseAddress() + a.offset());
+	if (delta >= -(int64_t(1) << 27) && delta < (int64_t(1) << 27))
+	{
+		a.b(imm(m_exit));                                                               // b     exit
+	}
+	else
+	{
+		a.mov(a64::x(SCRATCH_REG1), uintptr_t(m_exit));                                 // mov   x16,exit
+		a.br(a64::x(SCRATCH_REG1));                                                     // br    x16
+	}
+
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.bind(skip);                                                               // skip:
+}
+
+
+//-------------------------------------------------
+//  op_hashjmp - process a HASHJMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_hashjmp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter modep(*this, inst.param(0), PTYPE_MRI);
+	be_parameter pcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &exp = inst.param(2);
+	assert(exp.is_code_handle());
+
+	const a64::Gp target = a64::x(SCRATCH_REG1);
+	const a64::Gp table = a64::x(TEMP_REG1);
+	const a64::Gp pcreg = a64::x(TEMP_REG2);
+	const a64::Gp index = a64::x(TEMP_REG3);
+
+	// reset the stack pointer to the base so we end up at the right spot after our call below
+	a.ldr(target, get_mem_absolute(a, &m_near.hashstacksave, 8));                       // ldr   x16,[hashstacksave]
+	a.mov(a64::sp, target);                                                             // mov   sp,x16
+
+	// load the PC into a register if it isn't fixed
+	if (!pcp.is_immediate())
+		mov_reg_param(a, 4, pcreg, pcp);                                                // mov   w10,pcp
+
+	// fixed mode cases
+	if (modep.is_immediate() && m_hash.is_mode_populated(modep.immediate()))
+	{
+		// a straight immediate jump is direct
+		if (pcp.is_immediate())
+		{
+			uint32_t l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
+			uint32_t l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
+			a.ldr(target, get_mem_absolute(a, &m_hash.base()[modep.immediate()][l1val][l2val], 8));
+																						// ldr   x16,hash[modep][l1val][l2val]
+			a.blr(target);                                                              // blr   x16
+		}
+
+		// a fixed mode but variable PC
+		else
+		{
+			get_imm_relative(a, table, uintptr_t(&m_hash.base()[modep.immediate()][0])); // mov   x9,hash[modep]
+			if (m_hash.l1bits() != 0)
+			{
+				a.ubfx(index, pcreg, m_hash.l1shift(), m_hash.l1bits());                // ubfx  x11,x10,l1shift,l1bits
+				a.ldr(table, a64::ptr(table, index, arm::lsl(3)));                      // ldr   x9,[x9,x11,lsl #3]
+			}
+			else
+			{
+				a.ldr(table, a64::ptr(table));                                          // ldr   x9,[x9]
+			}
+			a.ubfx(index, pcreg, m_hash.l2shift(), m_hash.l2bits());                    // ubfx  x11,x10,l2shift,l2bits
+			a.ldr(target, a64::ptr(table, index, arm::lsl(3)));                         // ldr   x16,[x9,x11,lsl #3]
+			a.blr(target);                                                              // blr   x16
+		}
+	}
+	else
+	{
+		// variable mode
+		const a64::Gp modereg = modep.select_register(a64::x(TEMP_REG4), 4);
+		mov_reg_param(a, 4, modereg, modep);                                            // mov   w12,modep
+		get_imm_relative(a, table, uintptr_t(m_hash.base()));                           // mov   x9,hash
+		a.ldr(table, a64::ptr(table, modereg.x(), arm::lsl(3)));                        // ldr   x9,[x9,x12,lsl #3]
+
+		// fixed PC
+		if (pcp.is_immediate())
+		{
+			uint32_t l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
+			uint32_t l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
+			a.ldr(table, a64::ptr(table, l1val * 8));                                   // ldr   x9,[x9,l1val*8]
+			a.ldr(target, a64::ptr(table, l2val * 8));                                  // ldr   x16,[x9,l2val*8]
+			a.blr(target);                                                              // blr   x16
+		}
+
+		// variable PC
+		else
+		{
+			if (m_hash.l1bits() != 0)
+			{
+				a.ubfx(index, pcreg, m_hash.l1shift(), m_hash.l1bits());                // ubfx  x11,x10,l1shift,l1bits
+				a.ldr(table, a64::ptr(table, index, arm::lsl(3)));                      // ldr   x9,[x9,x11,lsl #3]
+			}
+			else
+			{
+				a.ldr(table, a64::ptr(table));                                          // ldr   x9,[x9]
+			}
+			a.ubfx(index, pcreg, m_hash.l2shift(), m_hash.l2bits());                    // ubfx  x11,x10,l2shift,l2bits
+			a.ldr(target, a64::ptr(table, index, arm::lsl(3)));                         // ldr   x16,[x9,x11,lsl #3]
+			a.blr(target);                                                              // blr   x16
+		}
+	}
+
+	// in all cases, if there is no code, we return here to generate the exception
+	const a64::Gp exptemp = a64::w(TEMP_REG1);
+	mov_reg_param(a, 4, exptemp, pcp);                                                  // mov   w9,pcp
+	a.str(exptemp, get_mem_absolute(a, &m_state.exp, 4));                               // str   w9,[exp]
+	call_handle(a, exp.handle());                                                       // bl    exp
+}
+
+
+//-------------------------------------------------
+//  op_jmp - process a JMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_jmp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &labelp = inst.param(0);
+	assert(labelp.is_code_label());
+
+	std::string labelName = util::string_format("PC$%x", labelp.label());
+	Label jmptarget = a.labelByName(labelName.c_str());
+	if (!jmptarget.isValid())
+		jmptarget = a.newNamedLabel(labelName.c_str());
+
+	if (inst.condition() == uml::COND_ALWAYS)
+		a.b(jmptarget);                                                                 // b     target
+	else
+		a.b(ARM_CONDITION(inst.condition()), jmptarget);                                // b.cc  target
+}
+
+
+//-------------------------------------------------
+//  op_exh - process an EXH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_exh(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+	be_parameter exp(*this, inst.param(1), PTYPE_MRI);
+
+	// perform the exception processing
+	Label no_exception = a.newLabel();
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.b(ARM_NOT_CONDITION(inst.condition()), no_exception);                         // b.!cc no_exception
+
+	const a64::Gp exptemp = exp.select_register(a64::w(TEMP_REG1), 4);
+	mov_reg_param(a, 4, exptemp, exp);                                                  // mov   w9,exp
+	a.str(exptemp, get_mem_absolute(a, &m_state.exp, 4));                               // str   w9,[exp]
+	call_handle(a, handp.handle());                                                     // bl    handle
+
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.bind(no_exception);
+}
+
+
+//-------------------------------------------------
+//  op_callh - process a CALLH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_callh(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.b(ARM_NOT_CONDITION(inst.condition()), skip);                                 // b.!cc skip
+
+	// jump through the handle; directly if a normal jump
+	call_handle(a, handp.handle());                                                     // bl    handle
+
+	// resolve the conditional link
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.bind(skip);                                                               // skip:
+}
+
+
+//-------------------------------------------------
+//  op_ret - process a RET opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ret(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 0);
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.b(ARM_NOT_CONDITION(inst.condition()), skip);                                 // b.!cc skip
+
+	// return
+	a.ldr(a64::x30, a64::ptr_post(a64::sp, HANDLE_FRAME_SIZE));                         // ldr   x30,[sp],#16
+	a.ret(a64::x30);                                                                    // ret
+
+	// resolve the conditional link
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.bind(skip);                                                               // skip:
+}
+
+
+//-------------------------------------------------
+//  op_callc - process a CALLC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_callc(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &funcp = inst.param(0);
+	assert(funcp.is_c_function());
+	be_parameter paramp(*this, inst.param(1), PTYPE_M);
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.b(ARM_NOT_CONDITION(inst.condition()), skip);                                 // b.!cc skip
+
+	// perform the call
+	get_imm_relative(a, a64::x(REG_PARAM1), uintptr_t(paramp.memory()));               // mov   param1,paramp
+	call_arm_addr(a, (const void *)(uintptr_t)funcp.cfunc());                           // bl    funcp
+
+	// resolve the conditional link
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.bind(skip);                                                               // skip:
+}
+
+
+//-------------------------------------------------
+//  op_recover - process a RECOVER opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_recover(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// call the recovery code
+	const a64::Gp temp = a64::x(TEMP_REG1);
+	a.ldr(temp, get_mem_absolute(a, &m_near.stacksave, 8));                             // ldr   x9,[stacksave]
+	a.ldr(temp, a64::ptr(temp, -HANDLE_FRAME_SIZE));                                    // ldur  x9,[x9,#-16]
+	a.sub(a64::x(REG_PARAM2), temp, 1);                                                 // sub   param2,x9,#1
+	get_imm_relative(a, a64::x(REG_PARAM1), uintptr_t(&m_map));                         // mov   param1,m_map
+	a.mov(a64::w(REG_PARAM3), inst.param(1).mapvar());                                  // mov   param3,param[1].value
+	call_ptr(a, &m_near.drcmap_get_value);                                              // blr   drcmap_get_value
+	mov_param_reg(a, 4, dstp, a64::w(REG_PARAM1));                                      // mov   dstp,w0
+}
+
+
+
+
+/***************************************************************************
+    INTERNAL REGISTER OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_setfmod - process a SETFMOD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_setfmod(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_MRI);
+
+	const a64::Gp temp = a64::w(TEMP_REG1);
+
+	// immediate case
+	if (srcp.is_immediate())
+	{
+		int value = srcp.immediate() & 3;
+		a.mov(temp, value);                                                             // mov   w9,srcp
+		a.strb(temp, get_mem_absolute(a, &m_state.fmod, 1));                            // strb  w9,[fmod]
+		a.mov(temp, fprnd_map[value]);                                                  // mov   w9,fpmode[srcp]
+	}
+
+	// register/memory case
+	else
+	{
+		mov_reg_param(a, 4, temp, srcp);                                                // mov   w9,srcp
+		a.and_(temp, temp, 3);                                                          // and   w9,w9,#3
+		a.strb(temp, get_mem_absolute(a, &m_state.fmod, 1));                            // strb  w9,[fmod]
+		get_imm_relative(a, a64::x(SCRATCH_REG2), uintptr_t(&m_near.fpmode[0]));       // add   x17,base,fpmode
+		a.ldrb(temp, a64::ptr(a64::x(SCRATCH_REG2), temp.x()));                         // ldrb  w9,[x17,x9]
+	}
+
+	set_rounding_mode(a, temp);
+}
+
+
+//-------------------------------------------------
+//  op_getfmod - process a GETFMOD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getfmod(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// fetch the current mode and store to the destination
+	const a64::Gp dstreg = dstp.select_register(a64::w(TEMP_REG1), 4);
+	a.ldrb(dstreg, get_mem_absolute(a, &m_state.fmod, 1));                              // ldrb  dstreg,[fmod]
+	mov_param_reg(a, 4, dstp, dstreg);                                                  // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_getexp - process a GETEXP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getexp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// fetch the exception parameter and store to the destination
+	const a64::Gp dstreg = dstp.select_register(a64::w(TEMP_REG1), 4);
+	a.ldr(dstreg, get_mem_absolute(a, &m_state.exp, 4));                                // ldr   dstreg,[exp]
+	mov_param_reg(a, 4, dstp, dstreg);                                                  // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_getflgs - process a GETFLGS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getflgs(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter maskp(*this, inst.param(1), PTYPE_I);
+
+	// pick a target register for the general case
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), 8);
+	const uint32_t mask = maskp.immediate() & (FLAG_C | FLAG_V | FLAG_Z | FLAG_S | FLAG_U);
+
+	// convert the host flags and mask off unwanted bits
+	get_uml_flags(a, dstreg);                                                           // ldrb  dstreg,flagsmap[nzcv]
+	if (mask != (FLAG_C | FLAG_V | FLAG_Z | FLAG_S | FLAG_U))
+		a.and_(dstreg.w(), dstreg.w(), mask);                                           // and   dstreg,dstreg,mask
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_save - process a SAVE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_save(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_M);
+
+	const a64::Gp state = a64::x(TEMP_REG1);
+	const a64::Gp temp = a64::x(TEMP_REG2);
+
+	// copy live state to the destination
+	get_imm_relative(a, state, uintptr_t(dstp.memory()));                               // mov   x9,dstp
+
+	// copy flags
+	get_uml_flags(a, temp);                                                             // ldrb  w10,flagsmap[nzcv]
+	a.strb(temp.w(), a64::ptr(state, offsetof(drcuml_machine_state, flags)));           // strb  w10,state->flags
+
+	// copy fmod and exp
+	a.ldrb(temp.w(), get_mem_absolute(a, &m_state.fmod, 1));                            // ldrb  w10,[fmod]
+	a.strb(temp.w(), a64::ptr(state, offsetof(drcuml_machine_state, fmod)));            // strb  w10,state->fmod
+	a.ldr(temp.w(), get_mem_absolute(a, &m_state.exp, 4));                              // ldr   w10,[exp]
+	a.str(temp.w(), a64::ptr(state, offsetof(drcuml_machine_state, exp)));              // str   w10,state->exp
+
+	// copy integer registers
+	int regoffs = offsetof(drcuml_machine_state, r);
+	for (int regnum = 0; regnum < std::size(m_state.r); regnum++)
+	{
+		if (int_register_map[regnum] != 0)
+			a.str(a64::x(int_register_map[regnum]), a64::ptr(state, regoffs + 8 * regnum));
+		else
+		{
+			a.ldr(temp, get_mem_absolute(a, &m_state.r[regnum].d, 8));
+			a.str(temp, a64::ptr(state, regoffs + 8 * regnum));
+		}
+	}
+
+	// copy FP registers
+	regoffs = offsetof(drcuml_machine_state, f);
+	for (int regnum = 0; regnum < std::size(m_state.f); regnum++)
+	{
+		if (float_register_map[regnum] != 0)
+			a.str(a64::d(float_register_map[regnum]), a64::ptr(state, regoffs + 8 * regnum));
+		else
+		{
+			a.ldr(temp, get_mem_absolute(a, &m_state.f[regnum].d, 8));
+			a.str(temp, a64::ptr(state, regoffs + 8 * regnum));
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  op_restore - process a RESTORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_restore(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_M);
+
+	const a64::Gp state = a64::x(TEMP_REG1);
+	const a64::Gp temp = a64::x(TEMP_REG2);
+
+	// copy live state from the source
+	get_imm_relative(a, state, uintptr_t(srcp.memory()));                               // mov   x9,srcp
+
+	// copy integer registers
+	int regoffs = offsetof(drcuml_machine_state, r);
+	for (int regnum = 0; regnum < std::size(m_state.r); regnum++)
+	{
+		if (int_register_map[regnum] != 0)
+			a.ldr(a64::x(int_register_map[regnum]), a64::ptr(state, regoffs + 8 * regnum));
+		else
+		{
+			a.ldr(temp, a64::ptr(state, regoffs + 8 * regnum));
+			a.str(temp, get_mem_absolute(a, &m_state.r[regnum].d, 8));
+		}
+	}
+
+	// copy FP registers
+	regoffs = offsetof(drcuml_machine_state, f);
+	for (int regnum = 0; regnum < std::size(m_state.f); regnum++)
+	{
+		if (float_register_map[regnum] != 0)
+			a.ldr(a64::d(float_register_map[regnum]), a64::ptr(state, regoffs + 8 * regnum));
+		else
+		{
+			a.ldr(temp, a64::ptr(state, regoffs + 8 * regnum));
+			a.str(temp, get_mem_absolute(a, &m_state.f[regnum].d, 8));
+		}
+	}
+
+	// copy fmod and exp
+	a.ldrb(temp.w(), a64::ptr(state, offsetof(drcuml_machine_state, fmod)));            // ldrb  w10,state->fmod
+	a.and_(temp.w(), temp.w(), 3);                                                      // and   w10,w10,#3
+	a.strb(temp.w(), get_mem_absolute(a, &m_state.fmod, 1));                            // strb  w10,[fmod]
+	get_imm_relative(a, a64::x(SCRATCH_REG2), uintptr_t(&m_near.fpmode[0]));           // add   x17,base,fpmode
+	a.ldrb(temp.w(), a64::ptr(a64::x(SCRATCH_REG2), temp));                             // ldrb  w10,[x17,x10]
+	set_rounding_mode(a, temp);                                                         // fpcr.rmode = w10
+	a.ldr(temp.w(), a64::ptr(state, offsetof(drcuml_machine_state, exp)));              // ldr   w10,state->exp
+	a.str(temp.w(), get_mem_absolute(a, &m_state.exp, 4));                              // str   w10,[exp]
+
+	// copy flags
+	a.ldrb(temp.w(), a64::ptr(state, offsetof(drcuml_machine_state, flags)));           // ldrb  w10,state->flags
+	set_flags_from_uml(a, temp);                                                        // nzcv = flagsunmap[w10]
+}
+
+
+
+/***************************************************************************
+    INTEGER OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_load - process a LOAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_load(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	const int size = scalesizep.size();
+	const int scale = scalesizep.scale();
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG2), inst.size());
+	const a64::Gp loadreg = (size == SIZE_QWORD) ? a64::Gp(dstreg.x()) : a64::Gp(dstreg.w());
+
+	// compute the address
+	a64::Mem mem;
+	if (indp.is_immediate())
+	{
+		mem = get_mem_absolute(a, (uint8_t *)basep.memory() + (int32_t(indp.immediate()) << scale), 1 << size);
+	}
+	else
+	{
+		const a64::Gp base = a64::x(TEMP_REG1);
+		const a64::Gp indreg = load_int_operand(a, 4, indp, a64::w(TEMP_REG3));
+		get_imm_relative(a, base, uintptr_t(basep.memory()));                           // mov   x9,basep
+		if (scale == size || scale == 0)
+		{
+			mem = a64::ptr(base, indreg.w(), arm::sxtw(scale));                         // [x9,indreg,sxtw #scale]
+		}
+		else
+		{
+			a.add(base, base, indreg.x(), arm::sxtw(scale));                            // add   x9,x9,indreg,sxtw #scale
+			mem = a64::ptr(base);
+		}
+	}
+
+	// load the value
+	if (size == SIZE_BYTE)
+		a.ldrb(loadreg.w(), mem);                                                       // ldrb  dstreg,[mem]
+	else if (size == SIZE_WORD)
+		a.ldrh(loadreg.w(), mem);                                                       // ldrh  dstreg,[mem]
+	else
+		a.ldr(loadreg, mem);                                                            // ldr   dstreg,[mem]
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_loads - process a LOADS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_loads(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	const int size = scalesizep.size();
+	const int scale = scalesizep.scale();
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG2), inst.size());
+
+	// compute the address
+	a64::Mem mem;
+	if (indp.is_immediate())
+	{
+		mem = get_mem_absolute(a, (uint8_t *)basep.memory() + (int32_t(indp.immediate()) << scale), 1 << size);
+	}
+	else
+	{
+		const a64::Gp base = a64::x(TEMP_REG1);
+		const a64::Gp indreg = load_int_operand(a, 4, indp, a64::w(TEMP_REG3));
+		get_imm_relative(a, base, uintptr_t(basep.memory()));                           // mov   x9,basep
+		if (scale == size || scale == 0)
+		{
+			mem = a64::ptr(base, indreg.w(), arm::sxtw(scale));                         // [x9,indreg,sxtw #scale]
+		}
+		else
+		{
+			a.add(base, base, indreg.x(), arm::sxtw(scale));                            // add   x9,x9,indreg,sxtw #scale
+			mem = a64::ptr(base);
+		}
+	}
+
+	// load the value with sign extension
+	if (size == SIZE_BYTE)
+		a.ldrsb(dstreg, mem);                                                           // ldrsb dstreg,[mem]
+	else if (size == SIZE_WORD)
+		a.ldrsh(dstreg, mem);                                                           // ldrsh dstreg,[mem]
+	else if (size == SIZE_DWORD && inst.size() == 8)
+		a.ldrsw(dstreg, mem);                                                           // ldrsw dstreg,[mem]
+	else
+		a.ldr(dstreg, mem);                                                             // ldr   dstreg,[mem]
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_store - process a STORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_store(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	const int size = scalesizep.size();
+	const int scale = scalesizep.scale();
+
+	// get the source into a register (zero can come straight from the zero register)
+	a64::Gp srcreg;
+	if (srcp.is_immediate_value(0))
+		srcreg = (size == SIZE_QWORD) ? a64::Gp(a64::xzr) : a64::Gp(a64::wzr);
+	else
+		srcreg = load_int_operand(a, (size == SIZE_QWORD) ? 8 : 4, srcp, a64::x(TEMP_REG2));
+
+	// compute the address
+	a64::Mem mem;
+	if (indp.is_immediate())
+	{
+		mem = get_mem_absolute(a, (uint8_t *)basep.memory() + (int32_t(indp.immediate()) << scale), 1 << size);
+	}
+	else
+	{
+		const a64::Gp base = a64::x(TEMP_REG1);
+		const a64::Gp indreg = load_int_operand(a, 4, indp, a64::w(TEMP_REG3));
+		get_imm_relative(a, base, uintptr_t(basep.memory()));                           // mov   x9,basep
+		if (scale == size || scale == 0)
+		{
+			mem = a64::ptr(base, indreg.w(), arm::sxtw(scale));                         // [x9,indreg,sxtw #scale]
+		}
+		else
+		{
+			a.add(base, base, indreg.x(), arm::sxtw(scale));                            // add   x9,x9,indreg,sxtw #scale
+			mem = a64::ptr(base);
+		}
+	}
+
+	// store the value
+	if (size == SIZE_BYTE)
+		a.strb(srcreg.w(), mem);                                                        // strb  srcreg,[mem]
+	else if (size == SIZE_WORD)
+		a.strh(srcreg.w(), mem);                                                        // strh  srcreg,[mem]
+	else
+		a.str(srcreg, mem);                                                             // str   srcreg,[mem]
+}
+
+
+
+//-------------------------------------------------
+//  op_read - process a READ opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_read(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(2);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the read handler
+	auto const &accessors = m_accessors[spacesizep.space()];
+	const a64::Gp result = a64::x(REG_PARAM1);
+	a.mov(a64::x(REG_PARAM1), uintptr_t(m_space[spacesizep.space()]));                  // mov   param1,space
+	mov_reg_param(a, 4, a64::w(REG_PARAM2), addrp);                                     // mov   param2,addrp
+	if (spacesizep.size() == SIZE_BYTE)
+	{
+		call_arm_addr(a, (const void *)accessors.read_byte);                            // bl    read_byte
+		a.uxtb(result.w(), result.w());                                                 // uxtb  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_WORD)
+	{
+		call_arm_addr(a, (const void *)accessors.read_word);                            // bl    read_word
+		a.uxth(result.w(), result.w());                                                 // uxth  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_DWORD)
+	{
+		call_arm_addr(a, (const void *)accessors.read_dword);                           // bl    read_dword
+		if (inst.size() == 8)
+			a.mov(result.w(), result.w());                                              // mov   w0,w0
+	}
+	else if (spacesizep.size() == SIZE_QWORD)
+	{
+		call_arm_addr(a, (const void *)accessors.read_qword);                           // bl    read_qword
+	}
+
+	// store result
+	mov_param_reg(a, inst.size(), dstp, result);                                        // mov   dstp,x0
+}
+
+
+//-------------------------------------------------
+//  op_readm - process a READM opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_readm(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(3);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the read handler
+	auto const &accessors = m_accessors[spacesizep.space()];
+	const a64::Gp result = a64::x(REG_PARAM1);
+	a.mov(a64::x(REG_PARAM1), uintptr_t(m_space[spacesizep.space()]));                  // mov   param1,space
+	mov_reg_param(a, 4, a64::w(REG_PARAM2), addrp);                                     // mov   param2,addrp
+	mov_reg_param(a, (spacesizep.size() == SIZE_QWORD) ? 8 : 4, a64::x(REG_PARAM3), maskp);
+																						// mov   param3,maskp
+	if (spacesizep.size() == SIZE_WORD)
+	{
+		call_arm_addr(a, (const void *)accessors.read_word_masked);                     // bl    read_word_masked
+		a.uxth(result.w(), result.w());                                                 // uxth  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_DWORD)
+	{
+		call_arm_addr(a, (const void *)accessors.read_dword_masked);                    // bl    read_dword_masked
+		if (inst.size() == 8)
+			a.mov(result.w(), result.w());                                              // mov   w0,w0
+	}
+	else if (spacesizep.size() == SIZE_QWORD)
+	{
+		call_arm_addr(a, (const void *)accessors.read_qword_masked);                    // bl    read_qword_masked
+	}
+
+	// store result
+	mov_param_reg(a, inst.size(), dstp, result);                                        // mov   dstp,x0
+}
+
+
+//-------------------------------------------------
+//  op_write - process a WRITE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_write(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(2);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the write handler
+	auto const &accessors = m_accessors[spacesizep.space()];
+	a.mov(a64::x(REG_PARAM1), uintptr_t(m_space[spacesizep.space()]));                  // mov   param1,space
+	mov_reg_param(a, 4, a64::w(REG_PARAM2), addrp);                                     // mov   param2,addrp
+	mov_reg_param(a, (spacesizep.size() == SIZE_QWORD) ? 8 : 4, a64::x(REG_PARAM3), srcp);
+																						// mov   param3,srcp
+	if (spacesizep.size() == SIZE_BYTE)
+		call_arm_addr(a, (const void *)accessors.write_byte);                           // bl    write_byte
+	else if (spacesizep.size() == SIZE_WORD)
+		call_arm_addr(a, (const void *)accessors.write_word);                           // bl    write_word
+	else if (spacesizep.size() == SIZE_DWORD)
+		call_arm_addr(a, (const void *)accessors.write_dword);                          // bl    write_dword
+	else if (spacesizep.size() == SIZE_QWORD)
+		call_arm_addr(a, (const void *)accessors.write_qword);                          // bl    write_qword
+}
+
+
+//-------------------------------------------------
+//  op_writem - process a WRITEM opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_writem(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(3);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the write handler
+	auto const &accessors = m_accessors[spacesizep.space()];
+	const uint32_t regsize = (spacesizep.size() == SIZE_QWORD) ? 8 : 4;
+	a.mov(a64::x(REG_PARAM1), uintptr_t(m_space[spacesizep.space()]));                  // mov   param1,space
+	mov_reg_param(a, 4, a64::w(REG_PARAM2), addrp);                                     // mov   param2,addrp
+	mov_reg_param(a, regsize, a64::x(REG_PARAM3), srcp);                                // mov   param3,srcp
+	mov_reg_param(a, regsize, a64::x(REG_PARAM4), maskp);                               // mov   param4,maskp
+	if (spacesizep.size() == SIZE_WORD)
+		call_arm_addr(a, (const void *)accessors.write_word_masked);                    // bl    write_word_masked
+	else if (spacesizep.size() == SIZE_DWORD)
+		call_arm_addr(a, (const void *)accessors.write_dword_masked);                   // bl    write_dword_masked
+	else if (spacesizep.size() == SIZE_QWORD)
+		call_arm_addr(a, (const void *)accessors.write_qword_masked);                   // bl    write_qword_masked
+}
+
+
+//-------------------------------------------------
+//  op_carry - process a CARRY opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_carry(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter bitp(*this, inst.param(1), PTYPE_MRI);
+
+	const a64::Gp bit = a64::x(TEMP_REG1);
+	const uint32_t bitmask = inst.size() * 8 - 1;
+
+	// immediate source: the carry is known
+	if (srcp.is_immediate() && bitp.is_immediate())
+	{
+		a.mov(bit, BIT(srcp.immediate(), bitp.immediate() & bitmask));                  // mov   x9,bit
+	}
+	else
+	{
+		const a64::Gp src = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG2));
+		if (bitp.is_immediate())
+		{
+			a.ubfx(bit, src.x(), bitp.immediate() & bitmask, 1);                        // ubfx  x9,src,bitp,#1
+		}
+		else
+		{
+			const a64::Gp shift = a64::x(TEMP_REG3);
+			mov_reg_param(a, 4, shift, bitp);                                           // mov   w11,bitp
+			a.and_(shift, shift, bitmask);                                              // and   x11,x11,#bitmask
+			a.lsrv(bit, src.x(), shift);                                                // lsr   x9,src,x11
+			a.and_(bit, bit, 1);                                                        // and   x9,x9,#1
+		}
+	}
+
+	set_carry_from_reg(a, bit);                                                         // carry = x9
+}
+
+
+//-------------------------------------------------
+//  op_set - process a SET opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_set(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// pick a target register for the general case
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+
+	// set to 1 or 0
+	if (inst.condition() == uml::COND_ALWAYS)
+		a.mov(dstreg, 1);                                                               // mov   dstreg,#1
+	else
+		a.cset(dstreg, cond_imm(ARM_CONDITION(inst.condition())));                      // cset  dstreg,cc
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_mov - process a MOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mov(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+
+	// conditional moves into a register can use CSEL
+	if (inst.condition() != uml::COND_ALWAYS && dstp.is_int_register())
+	{
+		const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+		a64::Gp srcreg;
+		if (srcp.is_immediate_value(0))
+			srcreg = (inst.size() == 4) ? a64::Gp(a64::wzr) : a64::Gp(a64::xzr);
+		else
+			srcreg = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG2));
+		a.csel(dstreg, srcreg, dstreg, cond_imm(ARM_CONDITION(inst.condition())));      // csel  dstreg,srcreg,dstreg,cc
+		return;
+	}
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.b(ARM_NOT_CONDITION(inst.condition()), skip);                                 // b.!cc skip
+
+	if (dstp.is_int_register())
+	{
+		mov_reg_param(a, inst.size(), dstp.select_register(a64::x(TEMP_REG1), inst.size()), srcp);
+																						// mov   dstp,srcp
+	}
+	else if (srcp.is_immediate_value(0))
+	{
+		a.str((inst.size() == 4) ? a64::Gp(a64::wzr) : a64::Gp(a64::xzr), get_mem_absolute(a, dstp.memory(), inst.size()));
+																						// str   zr,[dstp]
+	}
+	else
+	{
+		const a64::Gp srcreg = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG1));
+		mov_param_reg(a, inst.size(), dstp, srcreg);                                    // mov   dstp,srcp
+	}
+
+	// resolve the jump
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.bind(skip);                                                               // skip:
+}
+
+
+//-------------------------------------------------
+//  op_sext - process a SEXT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sext(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter sizep(*this, inst.param(2), PTYPE_I);
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp srcreg = load_int_operand(a, (sizep.immediate() == SIZE_QWORD) ? 8 : 4, srcp, a64::x(TEMP_REG2));
+
+	// sign-extend into the destination
+	if (sizep.immediate() == SIZE_BYTE)
+		a.sxtb(dstreg, srcreg.w());                                                     // sxtb  dstreg,srcreg
+	else if (sizep.immediate() == SIZE_WORD)
+		a.sxth(dstreg, srcreg.w());                                                     // sxth  dstreg,srcreg
+	else if (sizep.immediate() == SIZE_DWORD && inst.size() == 8)
+		a.sxtw(dstreg, srcreg.w());                                                     // sxtw  dstreg,srcreg
+	else if (srcreg.id() != dstreg.id())
+		a.mov(dstreg, (inst.size() == 4) ? a64::Gp(srcreg.w()) : a64::Gp(srcreg.x()));  // mov   dstreg,srcreg
+
+	// set the flags
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+
+//-------------------------------------------------
+//  op_roland - process an ROLAND opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_roland(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(3), PTYPE_MRI);
+
+	const uint32_t bits = inst.size() * 8;
+	const uint64_t sizemask = (inst.size() == 4) ? 0xffffffffU : 0xffffffffffffffffU;
+
+	// rotate into a temporary if the destination is needed as the mask
+	const a64::Gp dstreg = (dstp == maskp) ? ((inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG1)) : a64::Gp(a64::x(TEMP_REG1))) : dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp srcreg = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG2));
+
+	// immediate shift and low mask can be a single bit field extract
+	if (shiftp.is_immediate() && maskp.is_immediate())
+	{
+		const uint32_t shift = shiftp.immediate() & (bits - 1);
+		const uint64_t mask = maskp.immediate() & sizemask;
+		uint32_t lsb, width;
+		if (shift != 0 && is_contiguous_mask(mask, inst.size(), lsb, width) && lsb == 0 && width <= shift)
+		{
+			a.ubfx(dstreg, srcreg, bits - shift, width);                                // ubfx  dstreg,srcreg,#(bits-shift),#width
+			if (inst.flags())
+				a.tst(dstreg, dstreg);                                                  // tst   dstreg,dstreg
+			mov_param_reg(a, inst.size(), dstp, dstreg);                                // mov   dstp,dstreg
+			return;
+		}
+	}
+
+	// load a register mask before rotating in case it aliases the source
+	a64::Gp maskreg;
+	if (!maskp.is_immediate())
+		maskreg = load_int_operand(a, inst.size(), maskp, a64::x(TEMP_REG3));
+
+	// rotate left by the shift amount
+	if (shiftp.is_immediate())
+	{
+		const uint32_t shift = shiftp.immediate() & (bits - 1);
+		if (shift != 0)
+			a.ror(dstreg, srcreg, bits - shift);                                        // ror   dstreg,srcreg,#(bits-shift)
+		else if (dstreg.id() != srcreg.id())
+			a.mov(dstreg, srcreg);                                                      // mov   dstreg,srcreg
+	}
+	else
+	{
+		const a64::Gp shiftreg = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG4)) : a64::Gp(a64::x(TEMP_REG4));
+		mov_reg_param(a, inst.size(), shiftreg, shiftp);                                // mov   shiftreg,shiftp
+		a.neg(shiftreg, shiftreg);                                                      // neg   shiftreg,shiftreg
+		a.rorv(dstreg, srcreg, shiftreg);                                               // ror   dstreg,srcreg,shiftreg
+	}
+
+	// apply the mask
+	if (maskp.is_immediate())
+	{
+		const uint64_t mask = maskp.immediate() & sizemask;
+		if (mask == sizemask)
+		{
+			if (inst.flags())
+				a.tst(dstreg, dstreg);                                                  // tst   dstreg,dstreg
+		}
+		else if (mask == 0)
+		{
+			if (inst.flags())
+				a.ands(dstreg, dstreg, (inst.size() == 4) ? a64::Gp(a64::wzr) : a64::Gp(a64::xzr));
+			else
+				a.mov(dstreg, 0);                                                       // mov   dstreg,#0
+		}
+		else if (is_valid_immediate_logical(mask, inst.size()))
+		{
+			if (inst.flags())
+				a.ands(dstreg, dstreg, mask);                                           // ands  dstreg,dstreg,#mask
+			else
+				a.and_(dstreg, dstreg, mask);                                           // and   dstreg,dstreg,#mask
+		}
+		else
+		{
+			maskreg = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG3)) : a64::Gp(a64::x(TEMP_REG3));
+			a.mov(maskreg, mask);                                                       // mov   maskreg,#mask
+			if (inst.flags())
+				a.ands(dstreg, dstreg, maskreg);                                        // ands  dstreg,dstreg,maskreg
+			else
+				a.and_(dstreg, dstreg, maskreg);                                        // and   dstreg,dstreg,maskreg
+		}
+	}
+	else
+	{
+		if (inst.flags())
+			a.ands(dstreg, dstreg, maskreg);                                            // ands  dstreg,dstreg,maskreg
+		else
+			a.and_(dstreg, dstreg, maskreg);                                            // and   dstreg,dstreg,maskreg
+	}
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_rolins - process an ROLINS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rolins(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(3), PTYPE_MRI);
+
+	const uint32_t bits = inst.size() * 8;
+	const uint64_t sizemask = (inst.size() == 4) ? 0xffffffffU : 0xffffffffffffffffU;
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp rotreg = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG2)) : a64::Gp(a64::x(TEMP_REG2));
+	const a64::Gp srcreg = load_int_operand(a, inst.size(), srcp, rotreg);
+
+	// immediate shift and contiguous mask is a single bit field insert
+	if (shiftp.is_immediate() && maskp.is_immediate())
+	{
+		const uint32_t shift = shiftp.immediate() & (bits - 1);
+		const uint64_t mask = maskp.immediate() & sizemask;
+		uint32_t lsb, width;
+		if (is_contiguous_mask(mask, inst.size(), lsb, width) && width < bits)
+		{
+			// rotate so the bits to insert end up at the bottom
+			const uint32_t rot = (bits - shift + lsb) & (bits - 1);
+			a64::Gp insreg = srcreg;
+			if (rot != 0)
+			{
+				a.ror(rotreg, srcreg, rot);                                             // ror   rotreg,srcreg,#rot
+				insreg = rotreg;
+			}
+			mov_reg_param(a, inst.size(), dstreg, dstp);                                // mov   dstreg,dstp
+			a.bfi(dstreg, insreg, lsb, width);                                          // bfi   dstreg,insreg,#lsb,#width
+			if (inst.flags())
+				a.tst(dstreg, dstreg);                                                  // tst   dstreg,dstreg
+			mov_param_reg(a, inst.size(), dstp, dstreg);                                // mov   dstp,dstreg
+			return;
+		}
+	}
+
+	// rotate left by the shift amount
+	if (shiftp.is_immediate())
+	{
+		const uint32_t shift = shiftp.immediate() & (bits - 1);
+		if (shift != 0)
+			a.ror(rotreg, srcreg, bits - shift);                                        // ror   rotreg,srcreg,#(bits-shift)
+		else if (rotreg.id() != srcreg.id())
+			a.mov(rotreg, srcreg);                                                      // mov   rotreg,srcreg
+	}
+	else
+	{
+		const a64::Gp shiftreg = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG4)) : a64::Gp(a64::x(TEMP_REG4));
+		mov_reg_param(a, inst.size(), shiftreg, shiftp);                                // mov   shiftreg,shiftp
+		a.neg(shiftreg, shiftreg);                                                      // neg   shiftreg,shiftreg
+		a.rorv(rotreg, srcreg, shiftreg);                                               // ror   rotreg,srcreg,shiftreg
+	}
+
+	// get the mask and the destination
+	const a64::Gp maskreg = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG3)) : a64::Gp(a64::x(TEMP_REG3));
+	mov_reg_param(a, inst.size(), maskreg, maskp);                                      // mov   maskreg,maskp
+	mov_reg_param(a, inst.size(), dstreg, dstp);                                        // mov   dstreg,dstp
+
+	// combine
+	a.and_(rotreg, rotreg, maskreg);                                                    // and   rotreg,rotreg,maskreg
+	a.bic(dstreg, dstreg, maskreg);                                                     // bic   dstreg,dstreg,maskreg
+	a.orr(dstreg, dstreg, rotreg);                                                      // orr   dstreg,dstreg,rotreg
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_add - process a ADD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_add(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+
+	// put any immediate in the second operand
+	if (src1p.is_immediate() && !src2p.is_immediate())
+		std::swap(src1p, src2p);
+
+	const uint64_t sizemask = (inst.size() == 4) ? 0xffffffffU : 0xffffffffffffffffU;
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp src1reg = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+
+	if (src2p.is_immediate() && is_valid_immediate_addsub(src2p.immediate() & sizemask))
+	{
+		if (inst.flags())
+			a.adds(dstreg, src1reg, src2p.immediate() & sizemask);                      // adds  dstreg,src1,src2
+		else
+			a.add(dstreg, src1reg, src2p.immediate() & sizemask);                       // add   dstreg,src1,src2
+	}
+	else if (src2p.is_immediate() && !inst.flags() && is_valid_immediate_addsub(-src2p.immediate() & sizemask))
+	{
+		a.sub(dstreg, src1reg, -src2p.immediate() & sizemask);                          // sub   dstreg,src1,-src2
+	}
+	else
+	{
+		const a64::Gp src2reg = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+		if (inst.flags())
+			a.adds(dstreg, src1reg, src2reg);                                           // adds  dstreg,src1,src2
+		else
+			a.add(dstreg, src1reg, src2reg);                                            // add   dstreg,src1,src2
+	}
+
+	// the host carry is the inverse of the UML carry
+	if (inst.flags() & FLAG_C)
+		invert_carry(a);
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_addc - process a ADDC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_addc(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp src1reg = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+	const a64::Gp src2reg = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+
+	// ADC consumes the host carry, which is inverted relative to UML
+	invert_carry(a);
+	if (inst.flags())
+		a.adcs(dstreg, src1reg, src2reg);                                               // adcs  dstreg,src1,src2
+	else
+		a.adc(dstreg, src1reg, src2reg);                                                // adc   dstreg,src1,src2
+
+	// restore the inverted carry convention (or the original carry if no flags were requested)
+	if (!inst.flags() || (inst.flags() & FLAG_C))
+		invert_carry(a);
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_sub - process a SUB opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sub(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+
+	const uint64_t sizemask = (inst.size() == 4) ? 0xffffffffU : 0xffffffffffffffffU;
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+
+	// subtracting from zero is a negate
+	if (src1p.is_immediate_value(0) && !src2p.is_immediate())
+	{
+		const a64::Gp src2reg = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+		if (inst.flags())
+			a.negs(dstreg, src2reg);                                                    // negs  dstreg,src2
+		else
+			a.neg(dstreg, src2reg);                                                     // neg   dstreg,src2
+		mov_param_reg(a, inst.size(), dstp, dstreg);                                    // mov   dstp,dstreg
+		return;
+	}
+
+	const a64::Gp src1reg = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+
+	if (src2p.is_immediate() && is_valid_immediate_addsub(src2p.immediate() & sizemask))
+	{
+		if (inst.flags())
+			a.subs(dstreg, src1reg, src2p.immediate() & sizemask);                      // subs  dstreg,src1,src2
+		else
+			a.sub(dstreg, src1reg, src2p.immediate() & sizemask);                       // sub   dstreg,src1,src2
+	}
+	else if (src2p.is_immediate() && !inst.flags() && is_valid_immediate_addsub(-src2p.immediate() & sizemask))
+	{
+		a.add(dstreg, src1reg, -src2p.immediate() & sizemask);                          // add   dstreg,src1,-src2
+	}
+	else
+	{
+		const a64::Gp src2reg = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+		if (inst.flags())
+			a.subs(dstreg, src1reg, src2reg);                                           // subs  dstreg,src1,src2
+		else
+			a.sub(dstreg, src1reg, src2reg);                                            // sub   dstreg,src1,src2
+	}
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_subc - process a SUBC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_subc(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp src1reg = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+	const a64::Gp src2reg = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+
+	// SBC subtracts the inverse of the host carry, which is exactly the UML borrow
+	if (inst.flags())
+		a.sbcs(dstreg, src1reg, src2reg);                                               // sbcs  dstreg,src1,src2
+	else
+		a.sbc(dstreg, src1reg, src2reg);                                                // sbc   dstreg,src1,src2
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_cmp - process a CMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_cmp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MRI);
+
+	// skip if pointless
+	if (inst.flags() == 0)
+		return;
+
+	const uint64_t sizemask = (inst.size() == 4) ? 0xffffffffU : 0xffffffffffffffffU;
+	const a64::Gp src1reg = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG1));
+
+	if (src2p.is_immediate() && is_valid_immediate_addsub(src2p.immediate() & sizemask))
+	{
+		a.cmp(src1reg, src2p.immediate() & sizemask);                                   // cmp   src1,src2
+	}
+	else
+	{
+		const a64::Gp src2reg = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG2));
+		a.cmp(src1reg, src2reg);                                                        // cmp   src1,src2
+	}
+}
+
+
+
+//-------------------------------------------------
+//  op_mulu - process a MULU opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mulu(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	const bool compute_hi = (dstp != edstp);
+
+	const a64::Gp lo = a64::x(TEMP_REG4);
+	const a64::Gp hi = a64::x(TEMP_REG5);
+	const a64::Gp ovf = a64::x(TEMP_REG1);
+	const a64::Gp src1 = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+	const a64::Gp src2 = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+
+	if (inst.size() == 4)
+	{
+		// 32x32 multiply gives a 64-bit product
+		a.umull(lo, src1.w(), src2.w());                                                // umull x12,src1,src2
+		if (compute_hi || inst.flags())
+			a.lsr(hi, lo, 32);                                                          // lsr   x13,x12,#32
+
+		if (inst.flags())
+		{
+			a.cmp(hi, 0);                                                               // cmp   x13,#0
+			a.cset(ovf, cond_imm(a64::CondCode::kNE));                                  // cset  x9,ne
+			a.tst(lo, lo);                                                              // tst   x12,x12
+		}
+	}
+	else
+	{
+		a.mul(lo, src1, src2);                                                          // mul   x12,src1,src2
+		if (compute_hi || inst.flags())
+			a.umulh(hi, src1, src2);                                                    // umulh x13,src1,src2
+
+		if (inst.flags())
+		{
+			a.cmp(hi, 0);                                                               // cmp   x13,#0
+			a.cset(ovf, cond_imm(a64::CondCode::kNE));                                  // cset  x9,ne
+			a.orr(a64::x(TEMP_REG2), lo, hi);                                           // orr   x10,x12,x13
+			a.tst(a64::x(TEMP_REG2), a64::x(TEMP_REG2));                                // tst   x10,x10
+		}
+	}
+
+	// merge the overflow flag (and the sign of the high half for 64-bit products)
+	if (inst.flags())
+	{
+		const a64::Gp scratch = a64::x(SCRATCH_REG1);
+		a.mrs(scratch, a64::Predicate::SysReg::kNZCV);                                  // mrs   x16,nzcv
+		if (inst.size() == 8)
+		{
+			a.lsr(a64::x(TEMP_REG2), hi, 63);                                           // lsr   x10,x13,#63
+			a.bfi(scratch, a64::x(TEMP_REG2), 31, 1);                                   // bfi   x16,x10,#31,#1
+		}
+		a.bfi(scratch, ovf, 28, 1);                                                     // bfi   x16,x9,#28,#1
+		a.msr(a64::Predicate::SysReg::kNZCV, scratch);                                  // msr   nzcv,x16
+	}
+
+	// store the high half first so the low half wins if they alias
+	if (compute_hi)
+		mov_param_reg(a, inst.size(), edstp, hi);                                       // mov   edstp,x13
+	mov_param_reg(a, inst.size(), dstp, lo);                                            // mov   dstp,x12
+}
+
+
+//-------------------------------------------------
+//  op_muls - process a MULS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_muls(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	const bool compute_hi = (dstp != edstp);
+
+	const a64::Gp lo = a64::x(TEMP_REG4);
+	const a64::Gp hi = a64::x(TEMP_REG5);
+	const a64::Gp ovf = a64::x(TEMP_REG1);
+	const a64::Gp src1 = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+	const a64::Gp src2 = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+
+	if (inst.size() == 4)
+	{
+		// 32x32 multiply gives a 64-bit product
+		a.smull(lo, src1.w(), src2.w());                                                // smull x12,src1,src2
+		if (compute_hi)
+			a.lsr(hi, lo, 32);                                                          // lsr   x13,x12,#32
+
+		if (inst.flags())
+		{
+			a.cmp(lo, lo.w(), arm::sxtw(0));                                            // cmp   x12,w12,sxtw
+			a.cset(ovf, cond_imm(a64::CondCode::kNE));                                  // cset  x9,ne
+			a.tst(lo.w(), lo.w());                                                      // tst   w12,w12
+		}
+	}
+	else
+	{
+		a.mul(lo, src1, src2);                                                          // mul   x12,src1,src2
+		if (compute_hi || inst.flags())
+			a.smulh(hi, src1, src2);                                                    // smulh x13,src1,src2
+
+		if (inst.flags())
+		{
+			a.asr(a64::x(TEMP_REG2), lo, 63);                                           // asr   x10,x12,#63
+			a.cmp(hi, a64::x(TEMP_REG2));                                               // cmp   x13,x10
+			a.cset(ovf, cond_imm(a64::CondCode::kNE));                                  // cset  x9,ne
+			a.orr(a64::x(TEMP_REG2), lo, hi);                                           // orr   x10,x12,x13
+			a.tst(a64::x(TEMP_REG2), a64::x(TEMP_REG2));                                // tst   x10,x10
+		}
+	}
+
+	// merge the overflow flag (and the sign of the high half for 64-bit products)
+	if (inst.flags())
+	{
+		const a64::Gp scratch = a64::x(SCRATCH_REG1);
+		a.mrs(scratch, a64::Predicate::SysReg::kNZCV);                                  // mrs   x16,nzcv
+		if (inst.size() == 8)
+		{
+			a.lsr(a64::x(TEMP_REG2), hi, 63);                                           // lsr   x10,x13,#63
+			a.bfi(scratch, a64::x(TEMP_REG2), 31, 1);                                   // bfi   x16,x10,#31,#1
+		}
+		a.bfi(scratch, ovf, 28, 1);                                                     // bfi   x16,x9,#28,#1
+		a.msr(a64::Predicate::SysReg::kNZCV, scratch);                                  // msr   nzcv,x16
+	}
+
+	// store the high half first so the low half wins if they alias
+	if (compute_hi)
+		mov_param_reg(a, inst.size(), edstp, hi);                                       // mov   edstp,x13
+	mov_param_reg(a, inst.size(), dstp, lo);                                            // mov   dstp,x12
+}
+
+
+//-------------------------------------------------
+//  op_divu - process a DIVU opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_divu(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	const bool compute_rem = (dstp != edstp);
+
+	const a64::Gp src1 = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+	const a64::Gp src2 = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+	const a64::Gp quo = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG4)) : a64::Gp(a64::x(TEMP_REG4));
+	const a64::Gp rem = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG5)) : a64::Gp(a64::x(TEMP_REG5));
+
+	// divide by zero leaves the destinations untouched and sets V
+	Label skip_zero = a.newLabel();
+	Label skip = a.newLabel();
+	a.cbnz(src2, skip_zero);                                                            // cbnz  src2,skip_zero
+	if (inst.flags())
+	{
+		a.mov(a64::x(SCRATCH_REG1), m_near.flagsunmap[FLAG_V]);                         // mov   x16,flagsunmap[V]
+		a.msr(a64::Predicate::SysReg::kNZCV, a64::x(SCRATCH_REG1));                     // msr   nzcv,x16
+	}
+	a.b(skip);                                                                          // b     skip
+	a.bind(skip_zero);                                                              // skip_zero:
+
+	a.udiv(quo, src1, src2);                                                            // udiv  quo,src1,src2
+	if (compute_rem)
+	{
+		a.msub(rem, quo, src2, src1);                                                   // msub  rem,quo,src2,src1
+		mov_param_reg(a, inst.size(), edstp, rem);                                      // mov   edstp,rem
+	}
+	mov_param_reg(a, inst.size(), dstp, quo);                                           // mov   dstp,quo
+	if (inst.flags())
+		a.tst(quo, quo);                                                                // tst   quo,quo
+
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_divs - process a DIVS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_divs(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	const bool compute_rem = (dstp != edstp);
+
+	const a64::Gp src1 = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+	const a64::Gp src2 = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+	const a64::Gp quo = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG4)) : a64::Gp(a64::x(TEMP_REG4));
+	const a64::Gp rem = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG5)) : a64::Gp(a64::x(TEMP_REG5));
+
+	// divide by zero leaves the destinations untouched and sets V
+	Label skip_zero = a.newLabel();
+	Label skip = a.newLabel();
+	a.cbnz(src2, skip_zero);                                                            // cbnz  src2,skip_zero
+	if (inst.flags())
+	{
+		a.mov(a64::x(SCRATCH_REG1), m_near.flagsunmap[FLAG_V]);                         // mov   x16,flagsunmap[V]
+		a.msr(a64::Predicate::SysReg::kNZCV, a64::x(SCRATCH_REG1));                     // msr   nzcv,x16
+	}
+	a.b(skip);                                                                          // b     skip
+	a.bind(skip_zero);                                                              // skip_zero:
+
+	a.sdiv(quo, src1, src2);                                                            // sdiv  quo,src1,src2
+	if (compute_rem)
+	{
+		a.msub(rem, quo, src2, src1);                                                   // msub  rem,quo,src2,src1
+		mov_param_reg(a, inst.size(), edstp, rem);                                      // mov   edstp,rem
+	}
+	mov_param_reg(a, inst.size(), dstp, quo);                                           // mov   dstp,quo
+	if (inst.flags())
+		a.tst(quo, quo);                                                                // tst   quo,quo
+
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  logical_op - generate an AND/ORR/EOR with the
+//  second operand as an immediate or register
+//-------------------------------------------------
+
+void drcbe_arm64::logical_op(a64::Assembler &a, const instruction &inst, a64::Inst::Id opcode)
+{
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+
+	// put any immediate in the second operand
+	if (src1p.is_immediate() && !src2p.is_immediate())
+		std::swap(src1p, src2p);
+
+	const uint64_t sizemask = (inst.size() == 4) ? 0xffffffffU : 0xffffffffffffffffU;
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp src1reg = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG2));
+
+	if (src2p.is_immediate() && is_valid_immediate_logical(src2p.immediate() & sizemask, inst.size()))
+	{
+		a.emit(opcode, dstreg, src1reg, Imm(src2p.immediate() & sizemask));             // op    dstreg,src1,src2
+	}
+	else
+	{
+		const a64::Gp src2reg = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG3));
+		a.emit(opcode, dstreg, src1reg, src2reg);                                       // op    dstreg,src1,src2
+	}
+
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_and - process a AND opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_and(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	logical_op(a, inst, a64::Inst::kIdAnd);
+}
+
+
+//-------------------------------------------------
+//  op_test - process a TEST opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_test(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MRI);
+
+	// put any immediate in the second operand
+	if (src1p.is_immediate() && !src2p.is_immediate())
+		std::swap(src1p, src2p);
+
+	const uint64_t sizemask = (inst.size() == 4) ? 0xffffffffU : 0xffffffffffffffffU;
+	const a64::Gp src1reg = load_int_operand(a, inst.size(), src1p, a64::x(TEMP_REG1));
+
+	if (src2p.is_immediate() && is_valid_immediate_logical(src2p.immediate() & sizemask, inst.size()))
+	{
+		a.tst(src1reg, src2p.immediate() & sizemask);                                   // tst   src1,src2
+	}
+	else
+	{
+		const a64::Gp src2reg = load_int_operand(a, inst.size(), src2p, a64::x(TEMP_REG2));
+		a.tst(src1reg, src2reg);                                                        // tst   src1,src2
+	}
+}
+
+
+//-------------------------------------------------
+//  op_or - process a OR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_or(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	logical_op(a, inst, a64::Inst::kIdOrr);
+}
+
+
+//-------------------------------------------------
+//  op_xor - process a XOR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_xor(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	logical_op(a, inst, a64::Inst::kIdEor);
+}
+
+
+//-------------------------------------------------
+//  op_lzcnt - process a LZCNT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_lzcnt(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp srcreg = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG2));
+
+	a.clz(dstreg, srcreg);                                                              // clz   dstreg,srcreg
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_tzcnt - process a TZCNT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_tzcnt(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp srcreg = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG2));
+
+	// Z is set when the source is zero (the count equals the operand width)
+	if (inst.flags())
+		a.tst(srcreg, srcreg);                                                          // tst   srcreg,srcreg
+	a.rbit(dstreg, srcreg);                                                             // rbit  dstreg,srcreg
+	a.clz(dstreg, dstreg);                                                              // clz   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_bswap - process a BSWAP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_bswap(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp srcreg = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG2));
+
+	a.rev(dstreg, srcreg);                                                              // rev   dstreg,srcreg
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_shift - process a SHL/SHR/SAR/ROL/ROR
+//  opcode
+//-------------------------------------------------
+
+template <uml::opcode_t Opcode>
+void drcbe_arm64::op_shift(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+
+	const uint32_t bits = inst.size() * 8;
+	const bool is_left = (Opcode == uml::OP_SHL) || (Opcode == uml::OP_ROL);
+	const auto sized = [&inst] (uint32_t regnum) { return (inst.size() == 4) ? a64::Gp(a64::w(regnum)) : a64::Gp(a64::x(regnum)); };
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp srcreg = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG2));
+	const a64::Gp carry = sized(TEMP_REG3);
+
+	if (shiftp.is_immediate())
+	{
+		const uint32_t shift = shiftp.immediate() & (bits - 1);
+
+		// a zero shift leaves the flags alone
+		if (shift == 0)
+		{
+			if (dstreg.id() != srcreg.id())
+				a.mov(dstreg, srcreg);                                                  // mov   dstreg,srcreg
+			mov_param_reg(a, inst.size(), dstp, dstreg);                                // mov   dstp,dstreg
+			return;
+		}
+
+		// extract the last bit shifted out before the source is overwritten
+		if (inst.flags() & FLAG_C)
+			a.ubfx(carry, srcreg, is_left ? (bits - shift) : (shift - 1), 1);           // ubfx  carry,srcreg,#bit,#1
+
+		switch (Opcode)
+		{
+			case uml::OP_SHL: a.lsl(dstreg, srcreg, shift); break;                      // lsl   dstreg,srcreg,#shift
+			case uml::OP_SHR: a.lsr(dstreg, srcreg, shift); break;                      // lsr   dstreg,srcreg,#shift
+			case uml::OP_SAR: a.asr(dstreg, srcreg, shift); break;                      // asr   dstreg,srcreg,#shift
+			case uml::OP_ROL: a.ror(dstreg, srcreg, bits - shift); break;               // ror   dstreg,srcreg,#(bits-shift)
+			case uml::OP_ROR: a.ror(dstreg, srcreg, shift); break;                      // ror   dstreg,srcreg,#shift
+			default: throw emu_fatalerror("drcbe_arm64::op_shift: unexpected opcode %d", Opcode);
+		}
+
+		if (inst.flags())
+		{
+			a.tst(dstreg, dstreg);                                                      // tst   dstreg,dstreg
+			if (inst.flags() & FLAG_C)
+				set_carry_from_reg(a, carry);                                           // carry = carry
+		}
+	}
+	else
+	{
+		const a64::Gp shift = sized(TEMP_REG4);
+		const a64::Gp temp = sized(TEMP_REG5);
+
+		mov_reg_param(a, inst.size(), shift, shiftp);                                   // mov   shift,shiftp
+		a.and_(shift, shift, bits - 1);                                                 // and   shift,shift,#(bits-1)
+
+		// extract the last bit shifted out before the source is overwritten
+		if (inst.flags() & FLAG_C)
+		{
+			if (is_left)
+				a.neg(temp, shift);                                                     // neg   temp,shift
+			else
+				a.sub(temp, shift, 1);                                                  // sub   temp,shift,#1
+			a.lsrv(carry, srcreg, temp);                                                // lsr   carry,srcreg,temp
+		}
+
+		switch (Opcode)
+		{
+			case uml::OP_SHL: a.lslv(dstreg, srcreg, shift); break;                     // lsl   dstreg,srcreg,shift
+			case uml::OP_SHR: a.lsrv(dstreg, srcreg, shift); break;                     // lsr   dstreg,srcreg,shift
+			case uml::OP_SAR: a.asrv(dstreg, srcreg, shift); break;                     // asr   dstreg,srcreg,shift
+			case uml::OP_ROL:
+				a.neg(temp, shift);                                                     // neg   temp,shift
+				a.rorv(dstreg, srcreg, temp);                                           // ror   dstreg,srcreg,temp
+				break;
+			case uml::OP_ROR: a.rorv(dstreg, srcreg, shift); break;                     // ror   dstreg,srcreg,shift
+			default: throw emu_fatalerror("drcbe_arm64::op_shift: unexpected opcode %d", Opcode);
+		}
+
+		// a zero shift leaves the flags alone
+		if (inst.flags())
+		{
+			Label skip = a.newLabel();
+			a.cbz(shift, skip);                                                         // cbz   shift,skip
+			a.tst(dstreg, dstreg);                                                      // tst   dstreg,dstreg
+			if (inst.flags() & FLAG_C)
+			{
+				a.and_(carry, carry, 1);                                                // and   carry,carry,#1
+				set_carry_from_reg(a, carry);                                           // carry = carry
+			}
+			a.bind(skip);                                                           // skip:
+		}
+	}
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_rotc - process a ROLC/RORC opcode
+//-------------------------------------------------
+
+template <uml::opcode_t Opcode>
+void drcbe_arm64::op_rotc(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+
+	const uint32_t bits = inst.size() * 8;
+	const auto sized = [&inst] (uint32_t regnum) { return (inst.size() == 4) ? a64::Gp(a64::w(regnum)) : a64::Gp(a64::x(regnum)); };
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+	const a64::Gp srcreg = load_int_operand(a, inst.size(), srcp, a64::x(TEMP_REG2));
+	const a64::Gp carry = sized(TEMP_REG3);
+	const a64::Gp temp = sized(TEMP_REG5);
+
+	// fetch the incoming UML carry (host carry clear)
+	a.cset(carry, cond_imm(a64::CondCode::kLO));                                        // cset  carry,lo
+
+	if (shiftp.is_immediate())
+	{
+		const uint32_t shift = shiftp.immediate() & (bits - 1);
+		if (shift == 0)
+		{
+			if (dstreg.id() != srcreg.id())
+				a.mov(dstreg, srcreg);                                                  // mov   dstreg,srcreg
+		}
+		else if (Opcode == uml::OP_ROLC)
+		{
+			// result = (src << n) | (c << (n - 1)) | (src >> (bits + 1 - n))
+			a.lsl(temp, srcreg, shift);                                                 // lsl   temp,srcreg,#n
+			a.orr(temp, temp, carry, arm::lsl(shift - 1));                              // orr   temp,temp,carry,lsl #(n-1)
+			if (shift > 1)
+				a.orr(temp, temp, srcreg, arm::lsr(bits + 1 - shift));                  // orr   temp,temp,srcreg,lsr #(bits+1-n)
+			a.ubfx(carry, srcreg, bits - shift, 1);                                     // ubfx  carry,srcreg,#(bits-n),#1
+			a.mov(dstreg, temp);                                                        // mov   dstreg,temp
+		}
+		else
+		{
+			// result = (src >> n) | (c << (bits - n)) | (src << (bits + 1 - n))
+			a.lsr(temp, srcreg, shift);                                                 // lsr   temp,srcreg,#n
+			a.orr(temp, temp, carry, arm::lsl(bits - shift));                           // orr   temp,temp,carry,lsl #(bits-n)
+			if (shift > 1)
+				a.orr(temp, temp, srcreg, arm::lsl(bits + 1 - shift));                  // orr   temp,temp,srcreg,lsl #(bits+1-n)
+			a.ubfx(carry, srcreg, shift - 1, 1);                                        // ubfx  carry,srcreg,#(n-1),#1
+			a.mov(dstreg, temp);                                                        // mov   dstreg,temp
+		}
+	}
+	else
+	{
+		const a64::Gp shift = sized(TEMP_REG4);
+		mov_reg_param(a, inst.size(), shift, shiftp);                                   // mov   shift,shiftp
+		a.and_(shift, shift, bits - 1);                                                 // and   shift,shift,#(bits-1)
+		if (dstreg.id() != srcreg.id())
+			a.mov(dstreg, srcreg);                                                      // mov   dstreg,srcreg
+
+		// rotate one bit at a time through the carry
+		Label loop = a.newLabel();
+		Label done = a.newLabel();
+		a.cbz(shift, done);                                                             // cbz   shift,done
+		a.bind(loop);                                                               // loop:
+		if (Opcode == uml::OP_ROLC)
+		{
+			a.lsr(temp, dstreg, bits - 1);                                              // lsr   temp,dstreg,#(bits-1)
+			a.orr(dstreg, carry, dstreg, arm::lsl(1));                                  // orr   dstreg,carry,dstreg,lsl #1
+		}
+		else
+		{
+			a.and_(temp, dstreg, 1);                                                    // and   temp,dstreg,#1
+			a.extr(dstreg, carry, dstreg, 1);                                           // extr  dstreg,carry,dstreg,#1
+		}
+		a.mov(carry, temp);                                                             // mov   carry,temp
+		a.sub(shift, shift, 1);                                                         // sub   shift,shift,#1
+		a.cbnz(shift, loop);                                                            // cbnz  shift,loop
+		a.bind(done);                                                               // done:
+	}
+
+	// the outgoing carry is kept even when the other flags aren't wanted
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+	set_carry_from_reg(a, carry);                                                       // carry = carry
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+
+
+/***************************************************************************
+    FLOATING POINT OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_fload - process a FLOAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fload(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const int scale = (inst.size() == 4) ? 2 : 3;
+
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+
+	// compute the address
+	a64::Mem mem;
+	if (indp.is_immediate())
+	{
+		mem = get_mem_absolute(a, (uint8_t *)basep.memory() + (int32_t(indp.immediate()) << scale), inst.size());
+	}
+	else
+	{
+		const a64::Gp base = a64::x(TEMP_REG1);
+		const a64::Gp indreg = load_int_operand(a, 4, indp, a64::w(TEMP_REG3));
+		get_imm_relative(a, base, uintptr_t(basep.memory()));                           // mov   x9,basep
+		mem = a64::ptr(base, indreg.w(), arm::sxtw(scale));                             // [x9,indreg,sxtw #scale]
+	}
+
+	a.ldr(dstreg, mem);                                                                 // ldr   dstreg,[mem]
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_fstore - process a FSTORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fstore(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_MF);
+	const int scale = (inst.size() == 4) ? 2 : 3;
+
+	const a64::Vec srcreg = load_float_operand(a, inst.size(), srcp, a64::d(TEMPF_REG1));
+
+	// compute the address
+	a64::Mem mem;
+	if (indp.is_immediate())
+	{
+		mem = get_mem_absolute(a, (uint8_t *)basep.memory() + (int32_t(indp.immediate()) << scale), inst.size());
+	}
+	else
+	{
+		const a64::Gp base = a64::x(TEMP_REG1);
+		const a64::Gp indreg = load_int_operand(a, 4, indp, a64::w(TEMP_REG3));
+		get_imm_relative(a, base, uintptr_t(basep.memory()));                           // mov   x9,basep
+		mem = a64::ptr(base, indreg.w(), arm::sxtw(scale));                             // [x9,indreg,sxtw #scale]
+	}
+
+	a.str(srcreg, mem);                                                                 // str   srcreg,[mem]
+}
+
+
+//-------------------------------------------------
+//  op_fread - process a FREAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fread(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacep = inst.param(2);
+	assert(spacep.is_size_space());
+	assert((1 << spacep.size()) == inst.size());
+
+	// set up a call to the read handler
+	auto const &accessors = m_accessors[spacep.space()];
+	a.mov(a64::x(REG_PARAM1), uintptr_t(m_space[spacep.space()]));                      // mov   param1,space
+	mov_reg_param(a, 4, a64::w(REG_PARAM2), addrp);                                     // mov   param2,addrp
+	if (inst.size() == 4)
+		call_arm_addr(a, (const void *)accessors.read_dword);                           // bl    read_dword
+	else
+		call_arm_addr(a, (const void *)accessors.read_qword);                           // bl    read_qword
+
+	// move the result into the destination
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+	if (inst.size() == 4)
+		a.fmov(dstreg, a64::w(REG_PARAM1));                                             // fmov  dstreg,w0
+	else
+		a.fmov(dstreg, a64::x(REG_PARAM1));                                             // fmov  dstreg,x0
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_fwrite - process a FWRITE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fwrite(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &spacep = inst.param(2);
+	assert(spacep.is_size_space());
+	assert((1 << spacep.size()) == inst.size());
+
+	// set up a call to the write handler
+	auto const &accessors = m_accessors[spacep.space()];
+	a.mov(a64::x(REG_PARAM1), uintptr_t(m_space[spacep.space()]));                      // mov   param1,space
+	mov_reg_param(a, 4, a64::w(REG_PARAM2), addrp);                                     // mov   param2,addrp
+	if (srcp.is_memory())
+	{
+		mov_reg_param(a, inst.size(), a64::x(REG_PARAM3), srcp);                        // ldr   param3,[srcp]
+	}
+	else
+	{
+		const a64::Vec srcreg = load_float_operand(a, inst.size(), srcp, a64::d(TEMPF_REG1));
+		if (inst.size() == 4)
+			a.fmov(a64::w(REG_PARAM3), srcreg);                                         // fmov  w2,srcreg
+		else
+			a.fmov(a64::x(REG_PARAM3), srcreg);                                         // fmov  x2,srcreg
+	}
+
+	if (inst.size() == 4)
+		call_arm_addr(a, (const void *)accessors.write_dword);                          // bl    write_dword
+	else
+		call_arm_addr(a, (const void *)accessors.write_qword);                          // bl    write_qword
+}
+
+
+//-------------------------------------------------
+//  op_fmov - process a FMOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fmov(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// conditional moves into a register can use FCSEL
+	if (inst.condition() != uml::COND_ALWAYS && dstp.is_float_register())
+	{
+		const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+		const a64::Vec srcreg = load_float_operand(a, inst.size(), srcp, a64::d(TEMPF_REG2));
+		a.fcsel(dstreg, srcreg, dstreg, cond_imm(ARM_CONDITION(inst.condition())));     // fcsel dstreg,srcreg,dstreg,cc
+		return;
+	}
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.b(ARM_NOT_CONDITION(inst.condition()), skip);                                 // b.!cc skip
+
+	// memory to memory moves don't need to go through the FPU
+	if (dstp.is_memory() && srcp.is_memory())
+	{
+		const a64::Gp temp = (inst.size() == 4) ? a64::Gp(a64::w(TEMP_REG1)) : a64::Gp(a64::x(TEMP_REG1));
+		a.ldr(temp, get_mem_absolute(a, srcp.memory(), inst.size()));                  // ldr   temp,[srcp]
+		a.str(temp, get_mem_absolute(a, dstp.memory(), inst.size()));                  // str   temp,[dstp]
+	}
+	else
+	{
+		const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+		mov_float_reg_param(a, inst.size(), dstreg, srcp);                              // fmov  dstreg,srcp
+		mov_float_param_reg(a, inst.size(), dstp, dstreg);                              // fmov  dstp,dstreg
+	}
+
+	// resolve the jump
+	if (inst.condition() != uml::COND_ALWAYS)
+		a.bind(skip);                                                               // skip:
+}
+
+
+//-------------------------------------------------
+//  op_ftoint - process a FTOINT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ftoint(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	const parameter &roundp = inst.param(3);
+	assert(roundp.is_rounding());
+	const uint32_t dstsize = (sizep.size() == SIZE_QWORD) ? 8 : 4;
+
+	const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), dstsize);
+	const a64::Vec srcreg = load_float_operand(a, inst.size(), srcp, a64::d(TEMPF_REG1));
+
+	// each explicit rounding mode has a matching conversion
+	switch (roundp.rounding())
+	{
+		case ROUND_TRUNC:
+			a.fcvtzs(dstreg, srcreg);                                                   // fcvtzs dstreg,srcreg
+			break;
+
+		case ROUND_ROUND:
+			a.fcvtns(dstreg, srcreg);                                                   // fcvtns dstreg,srcreg
+			break;
+
+		case ROUND_CEIL:
+			a.fcvtps(dstreg, srcreg);                                                   // fcvtps dstreg,srcreg
+			break;
+
+		case ROUND_FLOOR:
+			a.fcvtms(dstreg, srcreg);                                                   // fcvtms dstreg,srcreg
+			break;
+
+		case ROUND_DEFAULT:
+		default:
+		{
+			// round using FPCR, then the conversion is exact
+			const a64::Vec temp = (inst.size() == 4) ? a64::Vec(a64::s(TEMPF_REG2)) : a64::Vec(a64::d(TEMPF_REG2));
+			a.frinti(temp, srcreg);                                                     // frinti temp,srcreg
+			a.fcvtzs(dstreg, temp);                                                     // fcvtzs dstreg,temp
+			break;
+		}
+	}
+
+	mov_param_reg(a, dstsize, dstp, dstreg);                                            // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_ffrint - process a FFRINT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ffrint(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	const uint32_t srcsize = (sizep.size() == SIZE_QWORD) ? 8 : 4;
+
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+	const a64::Gp srcreg = load_int_operand(a, srcsize, srcp, a64::x(TEMP_REG1));
+
+	a.scvtf(dstreg, srcreg);                                                            // scvtf dstreg,srcreg
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_ffrflt - process a FFRFLT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ffrflt(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	const uint32_t srcsize = (sizep.size() == SIZE_QWORD) ? 8 : 4;
+
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+	const a64::Vec srcreg = load_float_operand(a, srcsize, srcp, a64::d(TEMPF_REG2));
+
+	if (srcsize != inst.size())
+		a.fcvt(dstreg, srcreg);                                                         // fcvt  dstreg,srcreg
+	else if (dstreg.id() != srcreg.id())
+		a.fmov(dstreg, srcreg);                                                         // fmov  dstreg,srcreg
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_frnds - process a FRNDS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frnds(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), 8);
+	const a64::Vec srcreg = load_float_operand(a, 8, srcp, a64::d(TEMPF_REG2));
+
+	// round to single precision and back
+	a.fcvt(a64::s(TEMPF_REG2), srcreg);                                                 // fcvt  s17,srcreg
+	a.fcvt(dstreg, a64::s(TEMPF_REG2));                                                 // fcvt  dstreg,s17
+	mov_float_param_reg(a, 8, dstp, dstreg);                                            // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_float_alu - process a three-operand
+//  floating point opcode
+//-------------------------------------------------
+
+template <a64::Inst::Id Opcode>
+void drcbe_arm64::op_float_alu(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MF);
+
+	const a64::Vec src1reg = load_float_operand(a, inst.size(), src1p, a64::d(TEMPF_REG1));
+	const a64::Vec src2reg = load_float_operand(a, inst.size(), src2p, a64::d(TEMPF_REG2));
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+
+	a.emit(Opcode, dstreg, src1reg, src2reg);                                           // op    dstreg,src1reg,src2reg
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_fcmp - process a FCMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fcmp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_U);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MF);
+
+	const a64::Vec src1reg = load_float_operand(a, inst.size(), src1p, a64::d(TEMPF_REG1));
+	const a64::Vec src2reg = load_float_operand(a, inst.size(), src2p, a64::d(TEMPF_REG2));
+
+	// FCMP leaves C clear for less than and V set for unordered, which is
+	// exactly the inverted carry/unordered convention used for UML flags
+	a.fcmp(src1reg, src2reg);                                                           // fcmp  src1reg,src2reg
+}
+
+
+//-------------------------------------------------
+//  op_float_alu2 - process a two-operand
+//  floating point opcode
+//-------------------------------------------------
+
+template <a64::Inst::Id Opcode>
+void drcbe_arm64::op_float_alu2(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	const a64::Vec srcreg = load_float_operand(a, inst.size(), srcp, a64::d(TEMPF_REG1));
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+
+	a.emit(Opcode, dstreg, srcreg);                                                     // op    dstreg,srcreg
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_frecip - process a FRECIP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frecip(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	const a64::Vec one = (inst.size() == 4) ? a64::Vec(a64::s(TEMPF_REG2)) : a64::Vec(a64::d(TEMPF_REG2));
+	const a64::Vec srcreg = load_float_operand(a, inst.size(), srcp, a64::d(TEMPF_REG1));
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+
+	a.fmov(one, 1.0);                                                                   // fmov  one,#1.0
+	a.fdiv(dstreg, one, srcreg);                                                        // fdiv  dstreg,one,srcreg
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_frsqrt - process a FRSQRT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frsqrt(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	const a64::Vec temp = (inst.size() == 4) ? a64::Vec(a64::s(TEMPF_REG1)) : a64::Vec(a64::d(TEMPF_REG1));
+	const a64::Vec one = (inst.size() == 4) ? a64::Vec(a64::s(TEMPF_REG2)) : a64::Vec(a64::d(TEMPF_REG2));
+	const a64::Vec srcreg = load_float_operand(a, inst.size(), srcp, a64::d(TEMPF_REG1));
+	const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+
+	// FRSQRTE is only an estimate, so compute it exactly
+	a.fsqrt(temp, srcreg);                                                              // fsqrt temp,srcreg
+	a.fmov(one, 1.0);                                                                   // fmov  one,#1.0
+	a.fdiv(dstreg, one, temp);                                                          // fdiv  dstreg,one,temp
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_fcopyi - process a FCOPYI opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fcopyi(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MR);
+
+	if (srcp.is_memory())
+	{
+		// load the bits straight into the destination
+		const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+		mov_float_reg_param(a, inst.size(), dstreg, srcp);                              // ldr   dstreg,[srcp]
+		mov_float_param_reg(a, inst.size(), dstp, dstreg);                              // fmov  dstp,dstreg
+	}
+	else if (dstp.is_memory())
+	{
+		// store the bits straight into memory
+		mov_param_reg(a, inst.size(), dstp, srcp.select_register(a64::x(TEMP_REG1), inst.size()));
+																						// str   srcp,[dstp]
+	}
+	else
+	{
+		const a64::Vec dstreg = dstp.select_register(a64::d(TEMPF_REG1), inst.size());
+		a.fmov(dstreg, srcp.select_register(a64::x(TEMP_REG1), inst.size()));           // fmov  dstreg,srcp
+	}
+}
+
+
+//-------------------------------------------------
+//  op_icopyf - process a ICOPYF opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_icopyf(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	if (srcp.is_memory())
+	{
+		// load the bits straight into the destination
+		const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+		mov_reg_param(a, inst.size(), dstreg, srcp);                                    // ldr   dstreg,[srcp]
+		mov_param_reg(a, inst.size(), dstp, dstreg);                                    // mov   dstp,dstreg
+	}
+	else if (dstp.is_memory())
+	{
+		// store the bits straight into memory
+		mov_float_param_reg(a, inst.size(), dstp, srcp.select_register(a64::d(TEMPF_REG1), inst.size()));
+																						// str   srcp,[dstp]
+	}
+	else
+	{
+		const a64::Gp dstreg = dstp.select_register(a64::x(TEMP_REG1), inst.size());
+		a.fmov(dstreg, srcp.select_register(a64::d(TEMPF_REG1), inst.size()));          // fmov  dstreg,srcp
+	}
+}
+
+} // namespace drc
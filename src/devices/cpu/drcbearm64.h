@@ -0,0 +1,258 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    drcbearm64.h
+
+    64-bit AArch64 back-end for the universal machine language.
+
+***************************************************************************/
+#ifndef MAME_CPU_DRCBEARM64_H
+#define MAME_CPU_DRCBEARM64_H
+
+#pragma once
+
+#include "drcuml.h"
+#include "drcbeut.h"
+
+#include "asmjit/src/asmjit/asmjit.h"
+#include "asmjit/src/asmjit/a64.h"
+
+#include <vector>
+
+
+namespace drc {
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class drcbe_arm64 : public drcbe_interface
+{
+	typedef uint32_t (*arm64_entry_point_func)(uint8_t *basevalue, drccodeptr entry);
+
+public:
+	// construction/destruction
+	drcbe_arm64(drcuml_state &drcuml, device_t &device, drc_cache &cache, uint32_t flags, int modes, int addrbits, int ignorebits);
+	virtual ~drcbe_arm64();
+
+	// required overrides
+	virtual void reset() override;
+	virtual int execute(uml::code_handle &entry) override;
+	virtual void generate(drcuml_block &block, const uml::instruction *instlist, uint32_t numinst) override;
+	virtual bool hash_exists(uint32_t mode, uint32_t pc) override;
+	virtual void get_info(drcbe_info &info) override;
+	virtual bool logging() const override { return m_log_asmjit != nullptr; }
+
+private:
+	// a be_parameter is similar to a uml::parameter but maps to native registers/memory
+	class be_parameter
+	{
+	public:
+		static int const REG_MAX = 32;
+
+		// parameter types
+		enum be_parameter_type
+		{
+			PTYPE_NONE = 0,                     // invalid
+			PTYPE_IMMEDIATE,                    // immediate; value = sign-extended to 64 bits
+			PTYPE_INT_REGISTER,                 // integer register; value = 0-REG_MAX
+			PTYPE_FLOAT_REGISTER,               // floating point register; value = 0-REG_MAX
+			PTYPE_MEMORY,                       // memory; value = pointer to memory
+			PTYPE_MAX
+		};
+
+		// represents the value of a parameter
+		typedef uint64_t be_parameter_value;
+
+		// construction
+		be_parameter() : m_type(PTYPE_NONE), m_value(0) { }
+		be_parameter(be_parameter const &param) : m_type(param.m_type), m_value(param.m_value) { }
+		be_parameter(uint64_t val) : m_type(PTYPE_IMMEDIATE), m_value(val) { }
+		be_parameter(drcbe_arm64 &drcbe, const uml::parameter &param, uint32_t allowed);
+
+		be_parameter &operator=(be_parameter const &param) = default;
+
+		// creators for types that don't safely default
+		static inline be_parameter make_ireg(int regnum) { assert(regnum >= 0 && regnum < REG_MAX); return be_parameter(PTYPE_INT_REGISTER, regnum); }
+		static inline be_parameter make_freg(int regnum) { assert(regnum >= 0 && regnum < REG_MAX); return be_parameter(PTYPE_FLOAT_REGISTER, regnum); }
+		static inline be_parameter make_memory(void *base) { return be_parameter(PTYPE_MEMORY, reinterpret_cast<be_parameter_value>(base)); }
+		static inline be_parameter make_memory(const void *base) { return be_parameter(PTYPE_MEMORY, reinterpret_cast<be_parameter_value>(const_cast<void *>(base))); }
+
+		// operators
+		bool operator==(be_parameter const &rhs) const { return (m_type == rhs.m_type && m_value == rhs.m_value); }
+		bool operator!=(be_parameter const &rhs) const { return (m_type != rhs.m_type || m_value != rhs.m_value); }
+
+		// getters
+		be_parameter_type type() const { return m_type; }
+		uint64_t immediate() const { assert(m_type == PTYPE_IMMEDIATE); return m_value; }
+		uint32_t ireg() const { assert(m_type == PTYPE_INT_REGISTER); assert(m_value < REG_MAX); return m_value; }
+		uint32_t freg() const { assert(m_type == PTYPE_FLOAT_REGISTER); assert(m_value < REG_MAX); return m_value; }
+		void *memory() const { assert(m_type == PTYPE_MEMORY); return reinterpret_cast<void *>(m_value); }
+
+		// type queries
+		bool is_immediate() const { return (m_type == PTYPE_IMMEDIATE); }
+		bool is_int_register() const { return (m_type == PTYPE_INT_REGISTER); }
+		bool is_float_register() const { return (m_type == PTYPE_FLOAT_REGISTER); }
+		bool is_memory() const { return (m_type == PTYPE_MEMORY); }
+
+		// other queries
+		bool is_immediate_value(uint64_t value) const { return (m_type == PTYPE_IMMEDIATE && m_value == value); }
+
+		// helpers
+		asmjit::a64::Gp select_register(asmjit::a64::Gp const &defreg, uint32_t size) const;
+		asmjit::a64::Vec select_register(asmjit::a64::Vec const &defreg, uint32_t size) const;
+
+	private:
+		// private constructor
+		be_parameter(be_parameter_type type, be_parameter_value value) : m_type(type), m_value(value) { }
+
+		// internals
+		be_parameter_type   m_type;             // parameter type
+		be_parameter_value  m_value;            // parameter value
+	};
+
+	// helpers
+	asmjit::a64::Mem get_mem_absolute(asmjit::a64::Assembler &a, const void *ptr, uint32_t size) const;
+	void get_imm_relative(asmjit::a64::Assembler &a, asmjit::a64::Gp const &reg, uint64_t ptr) const;
+	void call_arm_addr(asmjit::a64::Assembler &a, const void *offs) const;
+	void call_ptr(asmjit::a64::Assembler &a, void *const *target) const;
+	void call_handle(asmjit::a64::Assembler &a, uml::code_handle const &handle) const;
+
+	// flags helpers
+	void invert_carry(asmjit::a64::Assembler &a) const;
+	void set_carry_from_reg(asmjit::a64::Assembler &a, asmjit::a64::Gp const &bit) const;
+	void set_flags_from_uml(asmjit::a64::Assembler &a, asmjit::a64::Gp const &flags) const;
+	void get_uml_flags(asmjit::a64::Assembler &a, asmjit::a64::Gp const &dst) const;
+	void set_rounding_mode(asmjit::a64::Assembler &a, asmjit::a64::Gp const &mode) const;
+
+	// code generators
+	void op_handle(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_hash(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_label(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_comment(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_mapvar(asmjit::a64::Assembler &a, const uml::instruction &inst);
+
+	void op_nop(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_debug(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_exit(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_hashjmp(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_jmp(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_exh(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_callh(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_ret(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_callc(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_recover(asmjit::a64::Assembler &a, const uml::instruction &inst);
+
+	void op_setfmod(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_getfmod(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_getexp(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_getflgs(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_save(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_restore(asmjit::a64::Assembler &a, const uml::instruction &inst);
+
+	void op_load(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_loads(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_store(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_read(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_readm(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_write(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_writem(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_carry(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_set(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_mov(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_sext(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_roland(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_rolins(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_add(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_addc(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_sub(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_subc(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_cmp(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_mulu(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_muls(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_divu(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_divs(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_and(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_test(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_or(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_xor(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_lzcnt(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_tzcnt(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_bswap(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	template <uml::opcode_t Opcode> void op_shift(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	template <uml::opcode_t Opcode> void op_rotc(asmjit::a64::Assembler &a, const uml::instruction &inst);
+
+	void op_fload(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_fstore(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_fread(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_fwrite(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_fmov(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_ftoint(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_ffrint(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_ffrflt(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_frnds(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	template <asmjit::a64::Inst::Id Opcode> void op_float_alu(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_fcmp(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	template <asmjit::a64::Inst::Id Opcode> void op_float_alu2(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_frecip(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_frsqrt(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_fcopyi(asmjit::a64::Assembler &a, const uml::instruction &inst);
+	void op_icopyf(asmjit::a64::Assembler &a, const uml::instruction &inst);
+
+	// parameter helpers
+	void mov_reg_param(asmjit::a64::Assembler &a, uint32_t regsize, asmjit::a64::Gp const &reg, be_parameter const &param) const;
+	void mov_param_reg(asmjit::a64::Assembler &a, uint32_t regsize, be_parameter const &param, asmjit::a64::Gp const &reg) const;
+	void mov_float_reg_param(asmjit::a64::Assembler &a, uint32_t regsize, asmjit::a64::Vec const &reg, be_parameter const &param) const;
+	void mov_float_param_reg(asmjit::a64::Assembler &a, uint32_t regsize, be_parameter const &param, asmjit::a64::Vec const &reg) const;
+	asmjit::a64::Gp load_int_operand(asmjit::a64::Assembler &a, uint32_t regsize, be_parameter const &param, asmjit::a64::Gp const &defreg) const;
+	asmjit::a64::Vec load_float_operand(asmjit::a64::Assembler &a, uint32_t regsize, be_parameter const &param, asmjit::a64::Vec const &defreg) const;
+
+	// operation helpers
+	void logical_op(asmjit::a64::Assembler &a, const uml::instruction &inst, asmjit::a64::Inst::Id opcode);
+
+	size_t emit(asmjit::CodeHolder &ch);
+
+	// internal state
+	drc_hash_table          m_hash;                 // hash table state
+	drc_map_variables       m_map;                  // code map
+	FILE *                  m_log_asmjit;           // logging
+
+	uint8_t *               m_baseptr;              // value of the base register
+
+	arm64_entry_point_func  m_entry;                // entry point
+	drccodeptr              m_exit;                 // exit point
+	drccodeptr              m_nocode;               // nocode handler
+
+	// state to live in the near cache
+	struct near_state
+	{
+		void *              debug_cpu_instruction_hook;// debugger callback
+		void *              drcmap_get_value;       // map lookup helper
+
+		uint64_t            fpcr;                   // saved FPCR
+		void *              stacksave;              // saved stack pointer
+		void *              hashstacksave;          // saved stack pointer for hashjmp
+
+		uint8_t             fpmode[4];              // FPCR rounding modes for each UML rounding mode
+		uint8_t             flagsmap[16];           // flags map (host NZCV to UML)
+		uint32_t            flagsunmap[0x20];       // flags unmapper (UML to host NZCV)
+	};
+	near_state &            m_near;
+
+	// globals
+	using opcode_generate_func = void (drcbe_arm64::*)(asmjit::a64::Assembler &, const uml::instruction &);
+	struct opcode_table_entry
+	{
+		uml::opcode_t           opcode;             // opcode in question
+		opcode_generate_func    func;               // function pointer to the work
+	};
+	static const opcode_table_entry s_opcode_table_source[];
+	static opcode_generate_func s_opcode_table[uml::OP_MAX];
+};
+
+} // namespace drc
+
+using drc::drcbe_arm64;
+
+#endif // MAME_CPU_DRCBEARM64_H
@@ -47,6 +47,7 @@ drc_cache::drc_cache(size_t bytes) :
 	m_limit(m_near + m_cache.size()),
 	m_end(m_limit),
 	m_codegen(nullptr),
+	m_exectop(m_base),
 	m_size(m_cache.size()),
 	m_executable(false),
 	m_rwx(false)
@@ -219,8 +220,9 @@ void drc_cache::codegen_init()
 {
 	if (m_executable)
 	{
+		// only the pages codegen_complete made executable need to change back
 		if (!m_rwx)
-			m_cache.set_access(0, m_size, osd::virtual_memory_allocation::READ_WRITE);
+			m_cache.set_access(m_base - m_near, m_exectop - m_base, osd::virtual_memory_allocation::READ_WRITE);
 		m_executable = false;
 	}
 }
@@ -231,7 +233,10 @@ void drc_cache::codegen_complete()
 	if (!m_executable)
 	{
 		if (!m_rwx)
-			m_cache.set_access(m_base - m_near, ALIGN_PTR_UP(m_top, m_cache.page_size()) - m_base, osd::virtual_memory_allocation::READ_EXECUTE);
+		{
+			m_exectop = ALIGN_PTR_UP(m_top, m_cache.page_size());
+			m_cache.set_access(m_base - m_near, m_exectop - m_base, osd::virtual_memory_allocation::READ_EXECUTE);
+		}
 		m_executable = true;
 	}
 }
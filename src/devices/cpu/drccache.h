@@ -61,6 +61,7 @@ public:
 	void *alloc_near(size_t bytes);
 	void *alloc_temporary(size_t bytes);
 	void dealloc(void *memory, size_t bytes);
+	bool advise_huge_pages() { return osd::advise_huge_pages(m_cache.get(), m_cache.size()); }
 
 	// codegen helpers
 	void codegen_init();
@@ -92,6 +93,7 @@ private:
 	drccodeptr          m_limit;            // limit for temporary allocations and code (page-aligned)
 	drccodeptr          m_end;              // first allocated byte in cache
 	drccodeptr          m_codegen;          // start of current generated code block
+	drccodeptr          m_exectop;          // end of pages currently marked executable in W^X mode
 	size_t const        m_size;             // size of the cache in bytes
 	bool                m_executable;       // whether cached code is currently executable
 	bool                m_rwx;              // whether pages can be simultaneously writable and executable
@@ -18,6 +18,8 @@
 #include "emu.h"
 #include "drcfe.h"
 
+#include "hashing.h"
+
 
 namespace {
 
@@ -154,6 +156,32 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 }
 
 
+//-------------------------------------------------
+//  code_hash - compute a hash of the PCs and
+//  opcode bytes in a description list, including
+//  delay slots, for validating cached blocks
+//-------------------------------------------------
+
+u32 drc_frontend::code_hash(opcode_desc const *desclist)
+{
+	util::crc32_creator crc;
+	auto const append = [&crc] (opcode_desc const &desc)
+	{
+		u32 const pc = desc.pc;
+		crc.append(&pc, sizeof(pc));
+		crc.append(&desc.opptr, (std::min<u32>)(desc.length, sizeof(desc.opptr)));
+	};
+
+	for (opcode_desc const *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+	{
+		append(*curdesc);
+		for (opcode_desc const *delaydesc = curdesc->delay.first(); delaydesc != nullptr; delaydesc = delaydesc->next())
+			append(*delaydesc);
+	}
+	return crc.finish();
+}
+
+
 //-------------------------------------------------
 //  describe_one - describe a single instruction,
 //  recursively describing opcodes in delay
@@ -136,6 +136,9 @@ public:
 	// get last opcode of block
 	opcode_desc const *get_last() { return m_desc_live_list.last(); }
 
+	// hash the guest code bytes covered by a description list
+	static u32 code_hash(opcode_desc const *desclist);
+
 protected:
 	// required overrides
 	virtual bool describe(opcode_desc &desc, opcode_desc const *prev) = 0;
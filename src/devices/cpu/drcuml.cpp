@@ -11,7 +11,7 @@
     Future improvements/changes:
 
     * UML optimizer:
-        - constant folding
+        - propagate constants stored to memory operands
 
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
@@ -34,14 +34,20 @@
 #include "emu.h"
 #include "drcuml.h"
 
+#include "debugger.h"
 #include "emuopts.h"
+#include "fileio.h"
+#include "debug/debugcon.h"
 #include "drcbec.h"
 #ifdef NATIVE_DRC
 #include "drcbex86.h"
 #include "drcbex64.h"
+#include "drcbearm64.h"
 #endif
 
+#include <algorithm>
 #include <fstream>
+#include <mutex>
 
 
 
@@ -66,6 +72,11 @@ typedef NATIVE_DRC drcbe_native;
 #endif
 
 
+// UML states with profiling enabled, for the drcprofile debugger command
+static std::list<drcuml_state *> s_profiled_states;
+static std::mutex s_profiled_states_lock;
+
+
 // structure describing back-end validation test
 struct bevalidate_test
 {
@@ -148,7 +159,46 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 	, m_blocklist()
 	, m_handlelist()
 	, m_symlist()
+	, m_block_cache_enabled(device.machine().options().drc_cache())
+	, m_block_cache()
+	, m_block_cache_clock(0)
+	, m_background_queue(nullptr)
+	, m_background_item(nullptr)
+	, m_background_done(false)
+	, m_profiling(device.machine().options().drc_profile())
+	, m_profiles()
 {
+	if (device.machine().options().huge_pages() && cache.advise_huge_pages())
+		osd_printf_verbose("Using huge pages for %s DRC cache\n", device.tag());
+
+	// pick up the blocks compiled on a previous run
+	if (m_block_cache_enabled)
+		block_cache_load();
+
+	// the debugger expects to see every instruction in the recompiled code; compiles are long and
+	// infrequent, so they mustn't be favoured over render and sound work in the shared pool
+	if (device.machine().options().drc_background() && !(device.machine().debug_flags & DEBUG_FLAG_ENABLED))
+		m_background_queue = osd_work_queue_alloc(0);
+
+	// make block profiles available to the debugger, registering the command once per machine
+	if (m_profiling && (device.machine().debug_flags & DEBUG_FLAG_ENABLED))
+	{
+		running_machine &machine(device.machine());
+		std::lock_guard<std::mutex> const lock(s_profiled_states_lock);
+		bool const registered = std::any_of(
+				s_profiled_states.begin(),
+				s_profiled_states.end(),
+				[&machine] (drcuml_state const *state) { return &state->device().machine() == &machine; });
+		s_profiled_states.push_back(this);
+		if (!registered)
+		{
+			machine.debugger().console().register_command(
+					"drcprofile",
+					CMDFLAG_NONE,
+					0, 2,
+					[&machine] (std::vector<std::string_view> const &params) { execute_drcprofile(machine, params); });
+		}
+	}
 }
 
 
@@ -158,6 +208,23 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 
 drcuml_state::~drcuml_state()
 {
+	{
+		std::lock_guard<std::mutex> const lock(s_profiled_states_lock);
+		s_profiled_states.remove(this);
+	}
+
+	// don't leave a worker writing to the cache we're about to free
+	if (m_background_queue)
+	{
+		try
+		{
+			background_wait();
+		}
+		catch (...)
+		{
+		}
+		osd_work_queue_free(m_background_queue);
+	}
 }
 
 
@@ -236,6 +303,280 @@ uml::code_handle *drcuml_state::handle_alloc(char const *name)
 }
 
 
+//-------------------------------------------------
+//  block_cache_record - remember that a block
+//  was compiled on demand for a given mode/PC so
+//  it can be precompiled later, dropping the
+//  least recently compiled blocks when full
+//-------------------------------------------------
+
+void drcuml_state::block_cache_record(u32 mode, offs_t pc, u32 codehash)
+{
+	if (!m_block_cache_enabled)
+		return;
+
+	m_block_cache[std::make_pair(mode, pc)] = block_cache_entry{ codehash, ++m_block_cache_clock };
+	if (m_block_cache.size() <= BLOCK_CACHE_MAX)
+		return;
+
+	// trim back to three quarters at a time so this doesn't happen on every block
+	std::vector<u64> ages;
+	ages.reserve(m_block_cache.size());
+	for (auto const &entry : m_block_cache)
+		ages.push_back(entry.second.lastuse);
+	auto const cutoff = ages.begin() + (m_block_cache.size() - (BLOCK_CACHE_MAX * 3 / 4));
+	std::nth_element(ages.begin(), cutoff, ages.end());
+	for (auto it = m_block_cache.begin(); it != m_block_cache.end(); )
+	{
+		if (it->second.lastuse < *cutoff)
+			it = m_block_cache.erase(it);
+		else
+			++it;
+	}
+}
+
+
+//-------------------------------------------------
+//  block_cache_forget - drop a block whose code
+//  has changed or that no longer compiles
+//-------------------------------------------------
+
+void drcuml_state::block_cache_forget(u32 mode, offs_t pc)
+{
+	m_block_cache.erase(std::make_pair(mode, pc));
+}
+
+
+//-------------------------------------------------
+//  block_cache_entries - return the blocks in
+//  the translation cache, most recently compiled
+//  first
+//-------------------------------------------------
+
+std::vector<drcuml_cached_block> drcuml_state::block_cache_entries() const
+{
+	std::vector<std::pair<u64, drcuml_cached_block> > sorted;
+	sorted.reserve(m_block_cache.size());
+	for (auto const &entry : m_block_cache)
+		sorted.emplace_back(entry.second.lastuse, drcuml_cached_block{ entry.first.first, entry.first.second, entry.second.codehash });
+	std::sort(
+			sorted.begin(),
+			sorted.end(),
+			[] (auto const &a, auto const &b) { return a.first > b.first; });
+
+	std::vector<drcuml_cached_block> result;
+	result.reserve(sorted.size());
+	for (auto const &entry : sorted)
+		result.push_back(entry.second);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  block_cache_filename - return the name of the
+//  translation cache file for this device
+//-------------------------------------------------
+
+std::string drcuml_state::block_cache_filename() const
+{
+	std::string tag(m_device.tag() + 1);
+	std::replace(tag.begin(), tag.end(), ':', '.');
+	return util::string_format("%s/%s.drc", m_device.machine().basename(), tag);
+}
+
+
+//-------------------------------------------------
+//  block_cache_load - read the list of blocks
+//  compiled on a previous run
+//-------------------------------------------------
+
+void drcuml_state::block_cache_load()
+{
+	emu_file file(m_device.machine().options().drc_cache_directory(), OPEN_FLAG_READ);
+	if (file.open(block_cache_filename()))
+		return;
+
+	// each line is mode, PC and code hash in hex, least recently compiled first; anything else is ignored
+	char line[64];
+	while (file.gets(line, sizeof(line)))
+	{
+		unsigned mode, pc, codehash;
+		if (sscanf(line, "%x %x %x", &mode, &pc, &codehash) == 3)
+			block_cache_record(mode, pc, codehash);
+	}
+}
+
+
+//-------------------------------------------------
+//  block_cache_save - write the list of compiled
+//  blocks for the next run
+//-------------------------------------------------
+
+void drcuml_state::block_cache_save()
+{
+	if (!m_block_cache_enabled || m_block_cache.empty())
+		return;
+
+	emu_file file(m_device.machine().options().drc_cache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(block_cache_filename()))
+		return;
+
+	// oldest first, so loading them in order keeps their ages
+	std::vector<drcuml_cached_block> const entries = block_cache_entries();
+	for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+		file.printf("%x %08x %08x\n", it->mode, it->pc, it->codehash);
+}
+
+
+//-------------------------------------------------
+//  background_compile - hand a compilation off
+//  to a worker thread; the caller must not touch
+//  the cache or execute recompiled code until
+//  background_wait() returns
+//-------------------------------------------------
+
+void drcuml_state::background_compile(std::function<void ()> &&compile)
+{
+	assert(background_enabled());
+	assert(!background_busy());
+
+	m_background_func = std::move(compile);
+	m_background_error = nullptr;
+	m_background_done.store(false, std::memory_order_relaxed);
+	m_background_item = osd_work_item_queue(m_background_queue, &drcuml_state::background_work, this, 0);
+
+	// if the item couldn't be queued, just do the work here
+	if (!m_background_item)
+		background_work(this, 0);
+}
+
+
+//-------------------------------------------------
+//  background_wait - wait for any compilation in
+//  flight, rethrowing anything it threw
+//-------------------------------------------------
+
+void drcuml_state::background_wait()
+{
+	if (m_background_item)
+	{
+		while (!osd_work_item_wait(m_background_item, osd_ticks_per_second())) { }
+		osd_work_item_release(m_background_item);
+		m_background_item = nullptr;
+	}
+	m_background_func = nullptr;
+
+	if (m_background_error)
+		std::rethrow_exception(std::exchange(m_background_error, nullptr));
+}
+
+
+//-------------------------------------------------
+//  background_work - worker thread callback
+//-------------------------------------------------
+
+void *drcuml_state::background_work(void *param, int threadid)
+{
+	drcuml_state &drcuml(*reinterpret_cast<drcuml_state *>(param));
+	try
+	{
+		drcuml.m_background_func();
+	}
+	catch (...)
+	{
+		drcuml.m_background_error = std::current_exception();
+	}
+	drcuml.m_background_done.store(true, std::memory_order_release);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  profile_block - return the profile for the
+//  block starting at a given mode/PC, allocating
+//  its entry counter if necessary
+//-------------------------------------------------
+
+drcuml_block_profile *drcuml_state::profile_block(u32 mode, offs_t pc)
+{
+	// blocks may be compiled on a worker while the debugger lists them
+	std::lock_guard<std::mutex> const lock(m_profiles_lock);
+	drcuml_block_profile &profile(m_profiles[std::make_pair(mode, pc)]);
+	if (!profile.counter)
+	{
+		// counters outlive cache flushes, so take them from permanent cache memory
+		profile.counter = reinterpret_cast<u64 *>(m_cache.alloc(sizeof(*profile.counter)));
+		if (!profile.counter)
+			return nullptr;
+		*profile.counter = 0;
+		profile.mode = mode;
+		profile.pc = pc;
+	}
+	return &profile;
+}
+
+
+//-------------------------------------------------
+//  profile_top - return the most frequently
+//  entered blocks
+//-------------------------------------------------
+
+std::vector<drcuml_block_profile> drcuml_state::profile_top(unsigned count) const
+{
+	std::lock_guard<std::mutex> const lock(m_profiles_lock);
+	std::vector<drcuml_block_profile> result;
+	result.reserve(m_profiles.size());
+	for (auto const &entry : m_profiles)
+	{
+		if (entry.second.counter)
+		{
+			result.push_back(entry.second);
+			result.back().entries = *entry.second.counter;
+		}
+	}
+
+	count = (std::min<size_t>)(count, result.size());
+	std::partial_sort(
+			result.begin(),
+			result.begin() + count,
+			result.end(),
+			[] (drcuml_block_profile const &a, drcuml_block_profile const &b) { return a.entries > b.entries; });
+	result.resize(count);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  execute_drcprofile - debugger command to show
+//  the hottest recompiled blocks
+//-------------------------------------------------
+
+void drcuml_state::execute_drcprofile(running_machine &machine, std::vector<std::string_view> const &params)
+{
+	debugger_console &console(machine.debugger().console());
+
+	// optional CPU and number of blocks to show
+	device_t *cpu = nullptr;
+	if (!params.empty() && !console.validate_cpu_parameter(params[0], cpu))
+		return;
+	u64 count = 20;
+	if (params.size() > 1 && !console.validate_number_parameter(params[1], count))
+		return;
+
+	std::lock_guard<std::mutex> const lock(s_profiled_states_lock);
+	for (drcuml_state const *state : s_profiled_states)
+	{
+		if ((&state->device().machine() != &machine) || (cpu && (&state->device() != cpu)))
+			continue;
+
+		console.printf("%s:\n", state->device().tag());
+		console.printf("  Mode  PC              Entries  Host  UML\n");
+		for (drcuml_block_profile const &profile : state->profile_top(unsigned(count)))
+			console.printf("  %4X  %08X  %15u  %4u  %3u\n", profile.mode, profile.pc, profile.entries, profile.hostbytes, profile.instcount);
+	}
+}
+
+
 //-------------------------------------------------
 //  symbol_add - add a symbol to the internal
 //  symbol table
@@ -306,6 +647,7 @@ drcuml_block::drcuml_block(drcuml_state &drcuml, u32 maxinst)
 	, m_maxinst(maxinst * 3/2)
 	, m_inst(m_maxinst)
 	, m_inuse(false)
+	, m_tracestart(0)
 {
 }
 
@@ -328,6 +670,7 @@ void drcuml_block::begin()
 	// set up the block information and return it
 	m_inuse = true;
 	m_nextinst = 0;
+	m_tracestart = g_startup_trace.enabled() ? osd_ticks() : 0;
 }
 
 
@@ -340,6 +683,9 @@ void drcuml_block::end()
 {
 	assert(m_inuse);
 
+	// add entry counters if profiling
+	drcuml_block_profile *const profile(m_drcuml.profiling() ? instrument() : nullptr);
+
 	// optimize the resulting code first
 	optimize();
 
@@ -349,7 +695,14 @@ void drcuml_block::end()
 
 	// generate the code via the back-end
 	m_drcuml.cache().codegen_init();
+	drccodeptr const codestart(m_drcuml.cache().top());
 	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
+	if (profile)
+		profile->hostbytes = m_drcuml.cache().top() - codestart;
+
+	// record compilation time while startup is being traced
+	if (m_tracestart && g_startup_trace.enabled())
+		g_startup_trace.add("drc", util::string_format("compile block for %s", m_drcuml.device().tag()), m_tracestart, osd_ticks());
 
 	// block is no longer in use
 	m_inuse = false;
@@ -387,16 +740,85 @@ uml::instruction &drcuml_block::append()
 }
 
 
+//-------------------------------------------------
+//  instrument - count entries through each hash
+//  point, attributing them all to the profile of
+//  the block's first hash
+//-------------------------------------------------
+
+drcuml_block_profile *drcuml_block::instrument()
+{
+	auto const end(m_inst.begin() + m_nextinst);
+	auto const first(std::find_if(m_inst.begin(), end, [] (uml::instruction const &inst) { return inst.opcode() == uml::OP_HASH; }));
+	if (first == end)
+		return nullptr;
+
+	drcuml_block_profile *const profile(m_drcuml.profile_block(first->param(0).immediate(), first->param(1).immediate()));
+	if (!profile)
+		return nullptr;
+	profile->instcount = std::count_if(m_inst.begin(), end, [] (uml::instruction const &inst) { return inst.opcode() != uml::OP_COMMENT; });
+
+	// insert an increment after each hash, as long as there's room
+	for (int instnum = first - m_inst.begin(); (instnum < m_nextinst) && (m_nextinst < m_maxinst); instnum++)
+	{
+		if (m_inst[instnum].opcode() == uml::OP_HASH)
+		{
+			std::copy_backward(m_inst.begin() + instnum + 1, m_inst.begin() + m_nextinst, m_inst.begin() + m_nextinst + 1);
+			m_nextinst++;
+			m_inst[++instnum].dadd(uml::mem(profile->counter), uml::mem(profile->counter), 1);
+		}
+	}
+	return profile;
+}
+
+
 //-------------------------------------------------
 //  optimize - apply various optimizations to a
 //  block of code
 //-------------------------------------------------
 
 void drcuml_block::optimize()
+{
+	// each pass runs over the whole block; later passes rely on the earlier ones
+	optimize_mapvars();
+	optimize_flags();
+	optimize_constants();
+}
+
+
+//-------------------------------------------------
+//  optimize_mapvars - convert all mapvar
+//  parameters to immediates
+//-------------------------------------------------
+
+void drcuml_block::optimize_mapvars()
 {
 	u32 mapvar[uml::MAPVAR_COUNT] = { 0 };
 
-	// iterate over instructions
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		uml::instruction &inst(m_inst[instnum]);
+
+		// track mapvars
+		if (inst.opcode() == uml::OP_MAPVAR)
+			mapvar[inst.param(0).mapvar() - uml::MAPVAR_M0] = inst.param(1).immediate();
+
+		// convert all mapvar parameters to immediates
+		else if (inst.opcode() != uml::OP_RECOVER)
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				if (inst.param(pnum).is_mapvar())
+					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - uml::MAPVAR_M0]);
+	}
+}
+
+
+//-------------------------------------------------
+//  optimize_flags - only compute the flags that
+//  are consumed before being overwritten
+//-------------------------------------------------
+
+void drcuml_block::optimize_flags()
+{
 	for (int instnum = 0; instnum < m_nextinst; instnum++)
 	{
 		uml::instruction &inst(m_inst[instnum]);
@@ -417,19 +839,68 @@ void drcuml_block::optimize()
 				remainingflags &= ~scan.modified_flags();
 		}
 		inst.set_flags(accumflags);
+	}
+}
 
-		// track mapvars
-		if (inst.opcode() == uml::OP_MAPVAR)
-			mapvar[inst.param(0).mapvar() - uml::MAPVAR_M0] = inst.param(1).immediate();
 
-		// convert all mapvar parameters to immediates
-		else if (inst.opcode() != uml::OP_RECOVER)
-			for (int pnum = 0; pnum < inst.numparams(); pnum++)
-				if (inst.param(pnum).is_mapvar())
-					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - uml::MAPVAR_M0]);
+//-------------------------------------------------
+//  optimize_constants - track integer registers
+//  holding known values through straight-line
+//  code, substitute them as immediates and
+//  simplify the results
+//-------------------------------------------------
+
+void drcuml_block::optimize_constants()
+{
+	u64 value[uml::REG_I_COUNT];
+	u8 known[uml::REG_I_COUNT] = { 0 };     // number of low bytes of value that are valid
+
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		uml::instruction &inst(m_inst[instnum]);
+
+		// forget everything at anything that can be reached from elsewhere or can change registers behind our back
+		switch (inst.opcode())
+		{
+		case uml::OP_HANDLE:
+		case uml::OP_HASH:
+		case uml::OP_LABEL:
+		case uml::OP_DEBUG:
+		case uml::OP_CALLH:
+		case uml::OP_EXH:
+		case uml::OP_CALLC:
+		case uml::OP_RESTORE:
+			std::fill(std::begin(known), std::end(known), 0);
+			break;
+
+		default:
+			break;
+		}
+
+		// substitute known values for registers that are only read
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			uml::parameter const &param(inst.param(pnum));
+			if (param.is_int_register() && known[param.ireg() - uml::REG_I0])
+				inst.substitute_immediate(pnum, value[param.ireg() - uml::REG_I0], known[param.ireg() - uml::REG_I0]);
+		}
 
 		// now that flags are correct, simplify the instruction
 		inst.simplify();
+
+		// anything written is unknown, unless it's an unconditional move of an immediate
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			uml::parameter const &param(inst.param(pnum));
+			if (param.is_int_register() && inst.writes_param(pnum))
+				known[param.ireg() - uml::REG_I0] = 0;
+		}
+		if (inst.opcode() == uml::OP_MOV && inst.condition() == uml::COND_ALWAYS && inst.param(0).is_int_register() && inst.param(1).is_immediate())
+		{
+			int const regnum = inst.param(0).ireg() - uml::REG_I0;
+			value[regnum] = inst.param(1).immediate();
+			known[regnum] = inst.size();
+		}
 	}
 }
 
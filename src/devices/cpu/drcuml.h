@@ -15,9 +15,15 @@
 #include "drccache.h"
 #include "uml.h"
 
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 
@@ -72,6 +78,27 @@ struct drcuml_machine_state
 };
 
 
+// a block remembered by the persistent translation cache
+struct drcuml_cached_block
+{
+	u32                     mode;                   // mode passed to HASH
+	offs_t                  pc;                     // PC passed to HASH
+	u32                     codehash;               // hash of the guest code bytes
+};
+
+
+// execution profile of a recompiled block
+struct drcuml_block_profile
+{
+	u32                     mode;                   // mode of the first HASH in the block
+	offs_t                  pc;                     // PC of the first HASH in the block
+	u64 *                   counter;                // entry counter (in the cache)
+	u64                     entries;                // number of times any HASH in the block was entered
+	u32                     hostbytes;              // size of the generated host code
+	u32                     instcount;              // number of UML instructions
+};
+
+
 // hints and information about the back-end
 struct drcbe_info
 {
@@ -113,7 +140,11 @@ public:
 private:
 	// internal helpers
 	void optimize();
+	void optimize_mapvars();
+	void optimize_flags();
+	void optimize_constants();
 	void disassemble();
+	drcuml_block_profile *instrument();
 	char const *get_comment_text(uml::instruction const &inst, std::string &comment);
 
 	// internal state
@@ -122,6 +153,7 @@ private:
 	u32                             m_maxinst;  // maximum number of instructions
 	std::vector<uml::instruction>   m_inst;     // pointer to the instruction list
 	bool                            m_inuse;    // this block is in use
+	osd_ticks_t                     m_tracestart; // when generation began, for startup tracing
 };
 
 
@@ -181,6 +213,25 @@ public:
 	// handle management
 	uml::code_handle *handle_alloc(char const *name);
 
+	// persistent translation cache
+	bool block_cache_enabled() const { return m_block_cache_enabled; }
+	void block_cache_record(u32 mode, offs_t pc, u32 codehash);
+	void block_cache_forget(u32 mode, offs_t pc);
+	std::vector<drcuml_cached_block> block_cache_entries() const;
+	void block_cache_save();
+
+	// background compilation
+	bool background_enabled() const { return m_background_queue != nullptr; }
+	bool background_busy() const { return m_background_item != nullptr; }
+	bool background_done() const { return m_background_done.load(std::memory_order_acquire); }
+	void background_compile(std::function<void ()> &&compile);
+	void background_wait();
+
+	// block profiling
+	bool profiling() const { return m_profiling; }
+	drcuml_block_profile *profile_block(u32 mode, offs_t pc);
+	std::vector<drcuml_block_profile> profile_top(unsigned count) const;
+
 	// symbol management
 	void symbol_add(void *base, u32 length, char const *name);
 	char const *symbol_find(void *base, u32 *offset = nullptr);
@@ -220,6 +271,22 @@ private:
 		std::string m_name;     // name of the symbol
 	};
 
+	// a block in the persistent translation cache
+	struct block_cache_entry
+	{
+		u32                 codehash;           // hash of the guest code bytes
+		u64                 lastuse;            // when it was last compiled on demand
+	};
+
+	// most blocks remembered; the least recently compiled are dropped beyond this
+	static constexpr size_t BLOCK_CACHE_MAX = 8192;
+
+	// internal helpers
+	std::string block_cache_filename() const;
+	void block_cache_load();
+	static void *background_work(void *param, int threadid);
+	static void execute_drcprofile(running_machine &machine, std::vector<std::string_view> const &params);
+
 	// internal state
 	device_t &                              m_device;           // CPU device we are associated with
 	drc_cache &                             m_cache;            // pointer to the codegen cache
@@ -228,6 +295,17 @@ private:
 	std::list<drcuml_block>                 m_blocklist;        // list of active blocks
 	std::list<uml::code_handle>             m_handlelist;       // list of active handles
 	std::list<symbol>                       m_symlist;          // list of symbols
+	bool const                              m_block_cache_enabled; // persistent translation cache enabled
+	std::map<std::pair<u32, offs_t>, block_cache_entry> m_block_cache; // code hash for each mode/PC compiled
+	u64                                     m_block_cache_clock; // counts blocks recorded, for aging
+	osd_work_queue *                        m_background_queue; // work queue for background compilation
+	osd_work_item *                         m_background_item;  // compilation currently in flight
+	std::function<void ()>                  m_background_func;  // compilation to run on the worker
+	std::exception_ptr                      m_background_error; // exception thrown by the worker
+	std::atomic<bool>                       m_background_done;  // set by the worker when finished
+	bool const                              m_profiling;        // block profiling enabled
+	std::map<std::pair<u32, offs_t>, drcuml_block_profile> m_profiles; // profile for each block, by first mode/PC
+	mutable std::mutex                      m_profiles_lock;    // protects the profiles from background compiles
 };
 
 
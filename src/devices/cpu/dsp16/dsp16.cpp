@@ -951,7 +951,7 @@ template <bool Debugger, bool Caching> inline void dsp16_device_base::execute_so
 					m_core->dau_y = u32(u64(a));
 					m_core->op_dau_ad(op) = d;
 					fetch_target = nullptr;
-					m_rom_data = m_spaces[AS_PROGRAM]->read_word(m_core->xaau_pt);
+					m_rom_data = Debugger ? m_spaces[AS_PROGRAM]->read_word(m_core->xaau_pt) : m_pcache.read_word(m_core->xaau_pt);
 					m_phase = phase::OP2;
 				}
 				break;
@@ -972,7 +972,7 @@ template <bool Debugger, bool Caching> inline void dsp16_device_base::execute_so
 				m_core->dau_temp = s16(m_core->dau_y >> 16);
 				m_core->dau_set_y(yaau_read<Debugger>(op));
 				fetch_target = nullptr;
-				m_rom_data = m_spaces[AS_PROGRAM]->read_word(m_core->xaau_pt);
+				m_rom_data = Debugger ? m_spaces[AS_PROGRAM]->read_word(m_core->xaau_pt) : m_pcache.read_word(m_core->xaau_pt);
 				m_phase = phase::OP2;
 				break;
 
@@ -983,7 +983,7 @@ template <bool Debugger, bool Caching> inline void dsp16_device_base::execute_so
 				m_core->op_dau_ad(op) = m_core->dau_f1(op);
 				m_core->dau_set_y(yaau_read<Debugger>(op));
 				fetch_target = nullptr;
-				m_rom_data = m_spaces[AS_PROGRAM]->read_word(m_core->xaau_pt);
+				m_rom_data = Debugger ? m_spaces[AS_PROGRAM]->read_word(m_core->xaau_pt) : m_pcache.read_word(m_core->xaau_pt);
 				m_phase = phase::OP2;
 				break;
 
@@ -21,6 +21,7 @@
 #include "emu.h"
 #include "i386.h"
 #include "i386priv.h"
+#include "i386fe.h"
 #include "x87priv.h"
 #include "cycles.h"
 #include "i386ops.h"
@@ -28,6 +29,10 @@
 #include "debug/debugcpu.h"
 #include "debug/express.h"
 
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
 #define LOG_MSR             (1U << 1)
 #define LOG_INVALID_OPCODE  (1U << 2)
 #define LOG_LIMIT_CHECK     (1U << 3)
@@ -70,13 +75,32 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 	, device_vtlb_interface(mconfig, *this, AS_PROGRAM)
 	, m_program_config("program", ENDIANNESS_LITTLE, program_data_width, program_addr_width, 0, 32, 12)
 	, m_io_config("io", ENDIANNESS_LITTLE, io_data_width, 16, 0)
+	, m_x87_host(true)
 	, m_smiact(*this)
 	, m_ferr_handler(*this)
+	, m_drccache()
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_drc(nullptr)
+	, m_enable_drc(false)
+	, m_cache_dirty(true)
+	, m_drc_cr0(0)
+	, m_drc_cr3(0)
+	, m_drc_cr4(0)
+	, m_drc_a20_mask(0)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
+	, m_redispatch(nullptr)
 {
 	// 32 unified
 	set_vtlb_dynamic_entries(32);
 }
 
+i386_device::~i386_device()
+{
+}
+
 i386sx_device::i386sx_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock)
 	: i386_device(mconfig, I386SX, tag, owner, clock, 16, 24, 16)
 {
@@ -2046,7 +2070,9 @@ void i386_device::i386_common_init()
 	m_ferr_handler(0);
 
 	set_icountptr(m_cycles);
-	m_notifier = m_program->add_change_notifier([this] (read_or_write mode) { dri_changed(); });
+	m_notifier = m_program->add_change_notifier([this] (read_or_write mode) { dri_changed(); m_cache_dirty = true; });
+
+	drc_init();
 }
 
 void i386_device::device_start()
@@ -2491,6 +2517,7 @@ void i386_device::zero_state()
 	memset(m_opcode_addrs, 0, sizeof(m_opcode_addrs));
 	m_opcode_addrs_index = 0;
 	m_dri_changed_active = false;
+	m_cache_dirty = true;
 }
 
 void i386_device::device_reset()
@@ -2771,6 +2798,14 @@ void i386_device::i386_set_a20_line(int state)
 }
 
 void i386_device::execute_run()
+{
+	if (m_enable_drc)
+		execute_run_drc();
+	else
+		execute_run_interpreter();
+}
+
+void i386_device::execute_run_interpreter()
 {
 	int cycles = m_cycles;
 	m_base_cycles = cycles;
@@ -2784,85 +2819,88 @@ void i386_device::execute_run()
 	}
 
 	while( m_cycles > 0 )
-	{
-		i386_check_irq_line();
+		execute_one();
+	m_tsc += (cycles - m_cycles);
+}
 
-		// The LE and GE bits of DR7 aren't currently implemented because they could potentially require cycle-accurate emulation.
-		if((m_dr[7] & 0xff) != 0) // If all of the breakpoints are disabled, skip checking for instruction breakpoint hitting entirely.
-		for(int i = 0; i < 4; i++)
+void i386_device::execute_one()
+{
+	i386_check_irq_line();
+
+	// The LE and GE bits of DR7 aren't currently implemented because they could potentially require cycle-accurate emulation.
+	if((m_dr[7] & 0xff) != 0) // If all of the breakpoints are disabled, skip checking for instruction breakpoint hitting entirely.
+	for(int i = 0; i < 4; i++)
+	{
+		bool dri_enabled = (m_dr[7] & (1 << ((i << 1) + 1))) || (m_dr[7] & (1 << (i << 1))); // Check both local AND global enable bits for this breakpoint.
+		if(dri_enabled && !m_RF)
 		{
-			bool dri_enabled = (m_dr[7] & (1 << ((i << 1) + 1))) || (m_dr[7] & (1 << (i << 1))); // Check both local AND global enable bits for this breakpoint.
-			if(dri_enabled && !m_RF)
+			int breakpoint_type = (m_dr[7] >> (i << 2)) & 3;
+			int breakpoint_length = (m_dr[7] >> ((i << 2) + 2)) & 3;
+			if(breakpoint_type == 0)
 			{
-				int breakpoint_type = (m_dr[7] >> (i << 2)) & 3;
-				int breakpoint_length = (m_dr[7] >> ((i << 2) + 2)) & 3;
-				if(breakpoint_type == 0)
+				uint32_t phys_addr = 0;
+				uint32_t error;
+				phys_addr = (m_cr[0] & CR0_PG) ? translate_address(m_CPL, TR_FETCH, &m_dr[i], &error) : m_dr[i];
+				if(breakpoint_length != 0) // Not one byte in length? logerror it, I have no idea how this works on real processors.
 				{
-					uint32_t phys_addr = 0;
-					uint32_t error;
-					phys_addr = (m_cr[0] & CR0_PG) ? translate_address(m_CPL, TR_FETCH, &m_dr[i], &error) : m_dr[i];
-					if(breakpoint_length != 0) // Not one byte in length? logerror it, I have no idea how this works on real processors.
-					{
-						LOGMASKED(LOG_INVALID_OPCODE, "i386: Breakpoint length not 1 byte on an instruction breakpoint\n");
-					}
-					if(m_pc == phys_addr)
-					{
-						// The processor never automatically clears bits in DR6. It only sets them.
-						m_dr[6] |= 1 << i;
-						i386_trap(1,0,0);
-						break;
-					}
+					LOGMASKED(LOG_INVALID_OPCODE, "i386: Breakpoint length not 1 byte on an instruction breakpoint\n");
+				}
+				if(m_pc == phys_addr)
+				{
+					// The processor never automatically clears bits in DR6. It only sets them.
+					m_dr[6] |= 1 << i;
+					i386_trap(1,0,0);
+					break;
 				}
 			}
 		}
+	}
 
-		m_operand_size = m_sreg[CS].d;
-		m_xmm_operand_size = 0;
-		m_address_size = m_sreg[CS].d;
-		m_operand_prefix = 0;
-		m_address_prefix = 0;
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
 
-		m_ext = 1;
-		int old_tf = m_TF;
+	m_ext = 1;
+	int old_tf = m_TF;
 
-		m_segment_prefix = 0;
-		m_prev_eip = m_eip;
+	m_segment_prefix = 0;
+	m_prev_eip = m_eip;
 
-		debugger_instruction_hook(m_pc);
+	debugger_instruction_hook(m_pc);
 
-		if(m_delayed_interrupt_enable != 0)
-		{
-			m_IF = 1;
-			m_delayed_interrupt_enable = 0;
-		}
+	if(m_delayed_interrupt_enable != 0)
+	{
+		m_IF = 1;
+		m_delayed_interrupt_enable = 0;
+	}
 #ifdef DEBUG_MISSING_OPCODE
-		m_opcode_bytes_length = 0;
-		m_opcode_pc = m_pc;
-		m_opcode_addrs[m_opcode_addrs_index] = m_opcode_pc;
-		m_opcode_addrs_index = (m_opcode_addrs_index + 1) & 15;
+	m_opcode_bytes_length = 0;
+	m_opcode_pc = m_pc;
+	m_opcode_addrs[m_opcode_addrs_index] = m_opcode_pc;
+	m_opcode_addrs_index = (m_opcode_addrs_index + 1) & 15;
 #endif
-		try
-		{
-			i386_decode_opcode();
-			if(m_TF && old_tf)
-			{
-				m_prev_eip = m_eip;
-				m_ext = 1;
-				m_dr[6] |= (1 << 14); //Set BS bit of DR6.
-				i386_trap(1,0,0);
-			}
-			if(m_lock && (m_opcode != 0xf0))
-				m_lock = false;
-		}
-		catch(uint64_t e)
+	try
+	{
+		i386_decode_opcode();
+		if(m_TF && old_tf)
 		{
+			m_prev_eip = m_eip;
 			m_ext = 1;
-			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+			m_dr[6] |= (1 << 14); //Set BS bit of DR6.
+			i386_trap(1,0,0);
 		}
-		if(m_RF && m_auto_clear_RF) m_RF = 0;
-		if(!m_auto_clear_RF) m_auto_clear_RF = true;
+		if(m_lock && (m_opcode != 0xf0))
+			m_lock = false;
 	}
-	m_tsc += (cycles - m_cycles);
+	catch(uint64_t e)
+	{
+		m_ext = 1;
+		i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+	}
+	if(m_RF && m_auto_clear_RF) m_RF = 0;
+	if(!m_auto_clear_RF) m_auto_clear_RF = true;
 }
 
 /*************************************************************************/
@@ -13,6 +13,8 @@
 #endif
 
 #include "divtlb.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
 
 #include "i386dasm.h"
 
@@ -25,15 +27,21 @@
 
 #define X86_NUM_CPUS        4
 
+class i386_frontend;
+
 class i386_device : public cpu_device, public device_vtlb_interface, public i386_disassembler::config
 {
+	friend class i386_frontend;
+
 public:
 	// construction/destruction
 	i386_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
+	virtual ~i386_device() override;
 
 	// configuration helpers
 	auto smiact() { return m_smiact.bind(); }
 	auto ferr() { return m_ferr_handler.bind(); }
+	void set_host_fpu(bool enable) { m_x87_host = enable; }
 
 	uint64_t debug_segbase(int params, const uint64_t *param);
 	uint64_t debug_seglimit(int params, const uint64_t *param);
@@ -41,6 +49,9 @@ public:
 	uint64_t debug_virttophys(int params, const uint64_t *param);
 	uint64_t debug_cacheflush(int params, const uint64_t *param);
 
+	// recompiler callbacks
+	void ccfunc_execute_one();
+
 protected:
 	i386_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock, int program_data_width, int program_addr_width, int io_data_width);
 
@@ -369,6 +380,7 @@ protected:
 	uint16_t m_x87_cs;
 	uint32_t m_x87_inst_ptr;
 	uint16_t m_x87_opcode;
+	bool m_x87_host;
 
 	i386_modrm_func m_opcode_table_x87_d8[256];
 	i386_modrm_func m_opcode_table_x87_d9[256];
@@ -1561,7 +1573,76 @@ protected:
 	void build_opcode_table(uint32_t features);
 	void zero_state();
 	void i386_set_a20_line(int state);
+	void execute_one();
+
+	// internal recompiler state, allocated near the code cache
+	struct internal_i386_drc_state
+	{
+		I386_GPR    reg;                    // shadow copy of the general registers
+		uint32_t    cf, of, sf, zf, pf, af; // shadow copies of the arithmetic flags
+		uint32_t    pc;                     // linear PC
+		int32_t     icount;
+		uint32_t    mode;                   // hash mode (current privilege level)
+		uint32_t    exitcode;               // exit code requested by a helper
+		uint32_t    arg0;                   // expected PC after a helper
+		uint32_t    arg1;                   // nonzero if a helper needs a redispatch
+	};
+
+	// internal compiler state
+	struct compiler_state
+	{
+		compiler_state &operator=(compiler_state const &) = delete;
+
+		uint32_t    cycles;                 // accumulated cycles
+		uint32_t    mode;                   // mode this block is compiled for
+		uml::code_label labelnum;           // index for local labels
+	};
 
+	std::unique_ptr<drc_cache> m_drccache;
+	std::unique_ptr<drcuml_state> m_drcuml;
+	std::unique_ptr<i386_frontend> m_drcfe;
+	internal_i386_drc_state *m_drc;
+	bool m_enable_drc;
+	bool m_cache_dirty;
+
+	// translation state the compiled code was generated against
+	uint32_t m_drc_cr0;
+	uint32_t m_drc_cr3;
+	uint32_t m_drc_cr4;
+	uint32_t m_drc_a20_mask;
+
+	// recompiler subroutines
+	uml::code_handle *m_entry;
+	uml::code_handle *m_nocode;
+	uml::code_handle *m_out_of_cycles;
+	uml::code_handle *m_redispatch;
+
+	void drc_init();
+	void execute_run_interpreter();
+	void execute_run_drc();
+	bool drc_can_execute() const;
+	bool drc_translation_changed() const;
+	bool drc_translate_code(offs_t pc, offs_t &physical);
+	void drc_load_state();
+	void drc_store_state();
+	void code_flush_cache();
+	void code_compile_block(uint32_t mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_redispatch();
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception);
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_native(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cycles);
+	void generate_interpret(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_two_byte(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_alu(drcuml_block &block, int aluop, uml::parameter dst, uml::parameter src);
+	void generate_incdec(drcuml_block &block, bool dec, uml::parameter dst);
+	void generate_szp_flags(drcuml_block &block);
+	void generate_lea(drcuml_block &block, const opcode_desc *desc);
+	void generate_jcc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cond, int taken_cycles, int nobranch_cycles);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
 };
 
 
@@ -0,0 +1,1080 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    i386drc.cpp
+
+    Universal machine language-based i386 emulator.
+
+****************************************************************************
+
+    The recompiler only runs 32-bit protected mode code segments outside
+    of virtual-8086 mode, single-stepping and system management mode;
+    anything else stays on the interpreter.  Register-to-register integer
+    operations and near branches are lowered to UML, and every other
+    instruction calls back into the interpreter to execute it once.
+
+    Segment bases and page translations are resolved when a block is
+    compiled rather than on every fetch.  Compiled code is keyed by the
+    linear PC and the current privilege level, and the whole cache is
+    thrown away whenever CR0, CR3, CR4 or the A20 gate change or INVLPG
+    is executed.  Natively executed instructions are checked against the
+    memory they were decoded from, so self-modifying code is caught
+    before it runs.
+
+    Future improvements/changes:
+
+    * Lower memory operands with flat DS/SS segments straight to UML
+      reads and writes instead of calling the interpreter
+
+    * Track which flags are live so dead flag computations can be
+      dropped
+
+***************************************************************************/
+
+#include "emu.h"
+#include "i386.h"
+#include "i386priv.h"
+#include "i386fe.h"
+
+#include "cpu/drcumlsh.h"
+
+#include "emuopts.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the recompiler's code cache */
+#define CACHE_SIZE                      (16 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         128
+#define COMPILE_FORWARDS_BYTES          512
+#define COMPILE_MAX_SEQUENCE            64
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_RESET_CACHE             3
+#define EXECUTE_INTERPRET               4
+
+/* ALU operation numbers, matching bits 3-5 of the opcode */
+#define ALU_ADD                         0
+#define ALU_OR                          1
+#define ALU_ADC                         2
+#define ALU_SBB                         3
+#define ALU_AND                         4
+#define ALU_SUB                         5
+#define ALU_XOR                         6
+#define ALU_CMP                         7
+#define ALU_TEST                        8
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define IREG(x)                         mem(&m_drc->reg.d[x])
+
+#define IMM32(ptr)                      uint32_t((ptr)[0] | ((ptr)[1] << 8) | ((ptr)[2] << 16) | ((ptr)[3] << 24))
+
+/* map variables */
+#define MAPVAR_PC                       M0
+#define MAPVAR_CYCLES                   M1
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+static inline void alloc_handle(drcuml_state &drcuml, uml::code_handle *&handleptr, const char *name)
+{
+	if (!handleptr)
+		handleptr = drcuml.handle_alloc(name);
+}
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler if it is
+    allowed for this device
+-------------------------------------------------*/
+
+void i386_device::drc_init()
+{
+	/* the recompiler is opt-in until it has been validated more widely; natively executed instructions don't call the debugger hook */
+	m_enable_drc = allow_drc() && machine().options().drc_i386() && !(machine().debug_flags & DEBUG_FLAG_ENABLED);
+	if (!m_enable_drc)
+		return;
+
+	/* the shadow state must be reachable from generated code */
+	m_drccache = std::make_unique<drc_cache>(CACHE_SIZE + sizeof(internal_i386_drc_state));
+	m_drc = (internal_i386_drc_state *)m_drccache->alloc_near(sizeof(internal_i386_drc_state));
+	memset(m_drc, 0, sizeof(internal_i386_drc_state));
+
+	/* initialize the UML generator; one hash mode per privilege level */
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 4, 32, 0);
+
+	/* add symbols for our stuff */
+	static const char *const regnames[8] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_drcuml->symbol_add(&m_drc->reg.d[regnum], sizeof(m_drc->reg.d[regnum]), regnames[regnum]);
+	m_drcuml->symbol_add(&m_drc->cf, sizeof(m_drc->cf), "cf");
+	m_drcuml->symbol_add(&m_drc->of, sizeof(m_drc->of), "of");
+	m_drcuml->symbol_add(&m_drc->sf, sizeof(m_drc->sf), "sf");
+	m_drcuml->symbol_add(&m_drc->zf, sizeof(m_drc->zf), "zf");
+	m_drcuml->symbol_add(&m_drc->pf, sizeof(m_drc->pf), "pf");
+	m_drcuml->symbol_add(&m_drc->af, sizeof(m_drc->af), "af");
+	m_drcuml->symbol_add(&m_drc->pc, sizeof(m_drc->pc), "pc");
+	m_drcuml->symbol_add(&m_drc->icount, sizeof(m_drc->icount), "icount");
+	m_drcuml->symbol_add(&m_drc->mode, sizeof(m_drc->mode), "mode");
+	m_drcuml->symbol_add(&m_drc->exitcode, sizeof(m_drc->exitcode), "exitcode");
+	m_drcuml->symbol_add(&m_drc->arg0, sizeof(m_drc->arg0), "arg0");
+	m_drcuml->symbol_add(&m_drc->arg1, sizeof(m_drc->arg1), "arg1");
+
+	/* initialize the front-end helper */
+	m_drcfe = std::make_unique<i386_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = true;
+}
+
+
+/*-------------------------------------------------
+    drc_can_execute - return true if the current
+    CPU state is one the recompiler handles
+-------------------------------------------------*/
+
+bool i386_device::drc_can_execute() const
+{
+	// pending interrupts and delayed IF updates are left to the interpreter
+	if (m_delayed_interrupt_enable || (m_irq_state && m_IF) || (m_smi && !m_smm))
+		return false;
+
+	return (m_cr[0] & CR0_PE) && m_sreg[CS].d && !m_VM && !m_TF && !m_smm && !m_halted && !(m_dr[7] & 0xff);
+}
+
+
+/*-------------------------------------------------
+    drc_translation_changed - return true if the
+    address translation no longer matches what
+    the cache was compiled against
+-------------------------------------------------*/
+
+bool i386_device::drc_translation_changed() const
+{
+	return ((m_cr[0] ^ m_drc_cr0) & (CR0_PE | CR0_PG | CR0_WP)) || m_cr[3] != m_drc_cr3 || m_cr[4] != m_drc_cr4 || m_a20_mask != m_drc_a20_mask;
+}
+
+
+/*-------------------------------------------------
+    drc_translate_code - translate a linear code
+    address, returning false unless it is backed
+    by RAM or ROM
+-------------------------------------------------*/
+
+bool i386_device::drc_translate_code(offs_t pc, offs_t &physical)
+{
+	uint32_t address = pc, error;
+	if (!translate_address(m_CPL, TR_FETCH, &address, &error))
+		return false;
+	physical = address & m_a20_mask;
+	return m_program->get_read_ptr(physical & ~3) != nullptr;
+}
+
+
+/*-------------------------------------------------
+    drc_load_state - copy the interpreter state
+    into the recompiler's shadow state
+-------------------------------------------------*/
+
+void i386_device::drc_load_state()
+{
+	m_drc->reg = m_reg;
+	m_drc->cf = m_CF;
+	m_drc->of = m_OF;
+	m_drc->sf = m_SF;
+	m_drc->zf = m_ZF;
+	m_drc->pf = m_PF;
+	m_drc->af = m_AF;
+	m_drc->pc = m_pc;
+	m_drc->icount = m_cycles;
+	m_drc->mode = m_CPL;
+	m_drc->exitcode = 0;
+}
+
+
+/*-------------------------------------------------
+    drc_store_state - copy the shadow state back
+    to the interpreter
+-------------------------------------------------*/
+
+void i386_device::drc_store_state()
+{
+	m_reg = m_drc->reg;
+	m_CF = m_drc->cf;
+	m_OF = m_drc->of;
+	m_SF = m_drc->sf;
+	m_ZF = m_drc->zf;
+	m_PF = m_drc->pf;
+	m_AF = m_drc->af;
+	m_pc = m_drc->pc;
+	m_eip = m_pc - m_sreg[CS].base;
+	m_cycles = m_drc->icount;
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - execute the CPU using the
+    recompiler wherever possible
+-------------------------------------------------*/
+
+void i386_device::execute_run_drc()
+{
+	int cycles = m_cycles;
+	m_base_cycles = cycles;
+	CHANGE_PC(m_eip);
+
+	if (m_halted)
+	{
+		m_tsc += cycles;
+		m_cycles = 0;
+		return;
+	}
+
+	while (m_cycles > 0)
+	{
+		/* step the interpreter through anything we don't handle */
+		if (!drc_can_execute())
+		{
+			execute_one();
+			continue;
+		}
+
+		/* reset the cache if dirty */
+		if (m_cache_dirty || drc_translation_changed())
+			code_flush_cache();
+
+		/* run as much as we can */
+		drc_load_state();
+		int execute_result = m_drcuml->execute(*m_entry);
+		drc_store_state();
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+			code_compile_block(m_drc->mode, m_pc);
+		else if (execute_result == EXECUTE_RESET_CACHE)
+			m_cache_dirty = true;
+	}
+	m_tsc += (cycles - m_cycles);
+}
+
+
+/***************************************************************************
+    C FUNCTION CALLBACKS
+***************************************************************************/
+
+void i386_device::ccfunc_execute_one()
+{
+	const uint32_t mode = m_drc->mode;
+
+	drc_store_state();
+	execute_one();
+	drc_load_state();
+
+	/* bail out if the instruction left us somewhere the cache can't follow */
+	if (!drc_can_execute())
+		m_drc->exitcode = EXECUTE_INTERPRET;
+	else if (m_cache_dirty || drc_translation_changed())
+		m_drc->exitcode = EXECUTE_RESET_CACHE;
+
+	/* anything but falling through to the next instruction needs a redispatch */
+	m_drc->arg1 = m_drc->exitcode != 0 || m_drc->pc != m_drc->arg0 || m_drc->mode != mode;
+}
+
+static void cfunc_execute_one(void *param)
+{
+	((i386_device *)param)->ccfunc_execute_one();
+}
+
+
+/***************************************************************************
+    CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void i386_device::code_flush_cache()
+{
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_redispatch();
+	}
+
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate static i386 code\n");
+	}
+
+	/* remember what the new cache contents will be compiled against */
+	m_drc_cr0 = m_cr[0];
+	m_drc_cr3 = m_cr[3];
+	m_drc_cr4 = m_cr[4];
+	m_drc_a20_mask = m_a20_mask;
+	m_cache_dirty = false;
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void i386_device::code_compile_block(uint32_t mode, offs_t pc)
+{
+	compiler_state compiler = { 0, mode, 1 };
+	const opcode_desc *seqhead, *seqlast;
+	bool override = false;
+
+	auto profile = g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+
+	/* if we get an error back, flush the cache and try again */
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			drcuml_block &block(m_drcuml->begin_block(16384));
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				uint32_t nextpc;
+
+				/* add a code log entry */
+				if (m_drcuml->logging())
+					block.append_comment("-------------------------");                     // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !m_drcuml->hash_exists(mode, seqhead->pc))
+				{
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					generate_sequence_instruction(block, compiler, curdesc);
+				}
+
+				/* a native unconditional branch has already left the sequence */
+				if ((seqlast->flags & OPFLAG_IS_UNCONDITIONAL_BRANCH) && !(seqlast->flags & OPFLAG_INVALID_OPCODE))
+					continue;
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, compiler, nextpc, true);                     // <subtract cycles>
+
+				/* if the next sequence doesn't follow on directly, jump through the hash table */
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+				{
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+				}
+			}
+
+			/* end the sequence */
+			block.end();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void i386_device::static_generate_entry_point()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	/* forward references */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+
+	alloc_handle(*m_drcuml, m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current mode and PC */
+	UML_HASHJMP(block, mem(&m_drc->mode), mem(&m_drc->pc), *m_nocode);              // hashjmp <mode>,<pc>,nocode
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void i386_device::static_generate_nocode_handler()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_drc->pc), I0);                                            // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void i386_device::static_generate_out_of_cycles()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(*m_drcuml, m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_drc->pc), I0);                                            // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_redispatch - generate the
+    handler taken when an interpreted instruction
+    didn't fall through to the next one
+-------------------------------------------------*/
+
+void i386_device::static_generate_redispatch()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	/* forward references */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+
+	alloc_handle(*m_drcuml, m_redispatch, "redispatch");
+	UML_HANDLE(block, *m_redispatch);                                               // handle  redispatch
+
+	/* leave if the helper asked us to, or if it ran us out of cycles */
+	UML_MOV(block, I0, mem(&m_drc->exitcode));                                      // mov     i0,[exitcode]
+	UML_TEST(block, I0, ~0);                                                        // test    i0,~0
+	UML_EXITc(block, COND_NZ, I0);                                                  // exit    i0,nz
+	UML_CMP(block, mem(&m_drc->icount), 0);                                         // cmp     [icount],0
+	UML_EXITc(block, COND_LE, EXECUTE_OUT_OF_CYCLES);                               // exit    EXECUTE_OUT_OF_CYCLES,le
+
+	/* otherwise carry on wherever the instruction took us */
+	UML_HASHJMP(block, mem(&m_drc->mode), mem(&m_drc->pc), *m_nocode);              // hashjmp <mode>,<pc>,nocode
+
+	block.end();
+}
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void i386_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception)
+{
+	/* account for cycles */
+	if (compiler.cycles > 0)
+	{
+		UML_SUB(block, mem(&m_drc->icount), mem(&m_drc->icount), MAPVAR_CYCLES);    // sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+	}
+
+	/* interpreted instructions count their own cycles, so always check */
+	else if (allow_exception)
+		UML_CMP(block, mem(&m_drc->icount), 0);                                     // cmp     icount,0
+
+	if (allow_exception)
+		UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                          // exh     out_of_cycles,nextpc,le
+	compiler.cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void i386_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging())
+		block.append_comment("%08X: %d bytes", desc->pc, desc->length);            // comment
+
+	/* set the PC map variable */
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                         // mapvar  PC,desc->pc
+
+	/* lower what we can, and interpret the rest */
+	if ((desc->flags & OPFLAG_INVALID_OPCODE) || !generate_opcode(block, compiler, desc))
+		generate_interpret(block, compiler, desc);
+}
+
+
+/*-------------------------------------------------
+    generate_native - generate the preamble for a
+    natively compiled instruction: verify the
+    code bytes and account for its cycles
+-------------------------------------------------*/
+
+void i386_device::generate_native(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cycles)
+{
+	/* compare each dword the instruction was decoded from */
+	const uint32_t *last = nullptr;
+	for (int byte = 0; byte < desc->length; byte++)
+	{
+		offs_t physical;
+		if (!drc_translate_code(desc->pc + byte, physical))
+			fatalerror("i386: code at %08X vanished during compilation\n", desc->pc + byte);
+
+		uint32_t *const base = (uint32_t *)m_program->get_read_ptr(physical & ~3);
+		if (base == last)
+			continue;
+		last = base;
+
+		UML_LOAD(block, I0, base, 0, SIZE_DWORD, SCALE_x4);                         // load    i0,base,0,dword
+		UML_CMP(block, I0, *base);                                                  // cmp     i0,*base
+		UML_EXHc(block, COND_NE, *m_nocode, desc->pc);                              // exne    nocode,desc->pc
+	}
+
+	/* accumulate total cycles, unless the instruction does it itself */
+	if (cycles >= 0)
+	{
+		compiler.cycles += m_cycle_table_pm[cycles];
+		UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                         // mapvar  CYCLES,compiler.cycles
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_interpret - generate a call to the
+    interpreter for a single instruction
+-------------------------------------------------*/
+
+void i386_device::generate_interpret(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	/* the interpreter needs an up to date cycle count */
+	generate_update_cycles(block, compiler, desc->pc, false);                      // <subtract cycles>
+
+	UML_MOV(block, mem(&m_drc->pc), desc->pc);                                      // mov     [pc],desc->pc
+	UML_MOV(block, mem(&m_drc->arg0), desc->pc + desc->length);                     // mov     [arg0],desc->pc + desc->length
+	UML_CALLC(block, cfunc_execute_one, this);                                      // callc   cfunc_execute_one,this
+
+	/* INVLPG and friends can change translations without touching a control register */
+	if (desc->userflags & I386_DRC_FLUSH_AFTER)
+	{
+		UML_EXIT(block, EXECUTE_RESET_CACHE);                                       // exit    EXECUTE_RESET_CACHE
+		return;
+	}
+
+	UML_TEST(block, mem(&m_drc->arg1), ~0);                                         // test    [arg1],~0
+	UML_EXHc(block, COND_NZ, *m_redispatch, 0);                                     // exh     redispatch,0,nz
+}
+
+
+/*-------------------------------------------------
+    generate_szp_flags - set SF, ZF and PF from
+    the result in I2
+-------------------------------------------------*/
+
+void i386_device::generate_szp_flags(drcuml_block &block)
+{
+	UML_SHR(block, mem(&m_drc->sf), I2, 31);                                        // shr     [sf],i2,31
+	UML_AND(block, I3, I2, 0xff);                                                   // and     i3,i2,0xff
+	UML_LOAD(block, mem(&m_drc->pf), i386_parity_table, I3, SIZE_DWORD, SCALE_x4);  // load    [pf],parity,i3,dword
+	UML_CMP(block, I2, 0);                                                          // cmp     i2,0
+	UML_SETc(block, COND_Z, mem(&m_drc->zf));                                       // set     [zf],z
+}
+
+
+/*-------------------------------------------------
+    generate_alu - generate a 32-bit ALU operation
+    along with its flags
+-------------------------------------------------*/
+
+void i386_device::generate_alu(drcuml_block &block, int aluop, uml::parameter dst, uml::parameter src)
+{
+	UML_MOV(block, I0, dst);                                                        // mov     i0,dst
+	UML_MOV(block, I1, src);                                                        // mov     i1,src
+	switch (aluop)
+	{
+		case ALU_ADD:
+			UML_ADD(block, I2, I0, I1);                                             // add     i2,i0,i1
+			break;
+
+		case ALU_SUB:
+		case ALU_CMP:
+			UML_SUB(block, I2, I0, I1);                                             // sub     i2,i0,i1
+			break;
+
+		case ALU_OR:
+			UML_OR(block, I2, I0, I1);                                              // or      i2,i0,i1
+			break;
+
+		case ALU_AND:
+		case ALU_TEST:
+			UML_AND(block, I2, I0, I1);                                             // and     i2,i0,i1
+			break;
+
+		case ALU_XOR:
+			UML_XOR(block, I2, I0, I1);                                             // xor     i2,i0,i1
+			break;
+	}
+
+	if (aluop == ALU_ADD || aluop == ALU_SUB || aluop == ALU_CMP)
+	{
+		/* UML's carry is the x86 borrow for subtraction, so CF and OF carry over directly */
+		UML_GETFLGS(block, I3, FLAG_C | FLAG_V);                                    // getflgs i3,CV
+		UML_AND(block, mem(&m_drc->cf), I3, FLAG_C);                                // and     [cf],i3,C
+		UML_SHR(block, mem(&m_drc->of), I3, 1);                                     // shr     [of],i3,1
+		UML_XOR(block, I3, I0, I1);                                                 // xor     i3,i0,i1
+		UML_XOR(block, I3, I3, I2);                                                 // xor     i3,i3,i2
+		UML_SHR(block, I3, I3, 4);                                                  // shr     i3,i3,4
+		UML_AND(block, mem(&m_drc->af), I3, 1);                                     // and     [af],i3,1
+	}
+	else
+	{
+		/* logical operations clear CF and OF and leave AF alone */
+		UML_MOV(block, mem(&m_drc->cf), 0);                                         // mov     [cf],0
+		UML_MOV(block, mem(&m_drc->of), 0);                                         // mov     [of],0
+	}
+	generate_szp_flags(block);
+
+	if (aluop != ALU_CMP && aluop != ALU_TEST)
+		UML_MOV(block, dst, I2);                                                    // mov     dst,i2
+}
+
+
+/*-------------------------------------------------
+    generate_incdec - generate INC or DEC, which
+    leave CF alone
+-------------------------------------------------*/
+
+void i386_device::generate_incdec(drcuml_block &block, bool dec, uml::parameter dst)
+{
+	UML_MOV(block, I0, dst);                                                        // mov     i0,dst
+	if (dec)
+		UML_SUB(block, I2, I0, 1);                                                  // sub     i2,i0,1
+	else
+		UML_ADD(block, I2, I0, 1);                                                  // add     i2,i0,1
+	UML_GETFLGS(block, I3, FLAG_V);                                                 // getflgs i3,V
+	UML_SHR(block, mem(&m_drc->of), I3, 1);                                         // shr     [of],i3,1
+	UML_XOR(block, I3, I0, I2);                                                     // xor     i3,i0,i2
+	UML_SHR(block, I3, I3, 4);                                                      // shr     i3,i3,4
+	UML_AND(block, mem(&m_drc->af), I3, 1);                                         // and     [af],i3,1
+	generate_szp_flags(block);
+	UML_MOV(block, dst, I2);                                                        // mov     dst,i2
+}
+
+
+/*-------------------------------------------------
+    generate_lea - generate a 32-bit effective
+    address calculation into I0
+-------------------------------------------------*/
+
+void i386_device::generate_lea(drcuml_block &block, const opcode_desc *desc)
+{
+	const uint8_t *const op = &desc->opptr.b[1];
+	const int mod = op[0] >> 6;
+	const int rm = op[0] & 7;
+	const uint8_t *next = &op[1];
+	int base = rm;
+	int index = -1;
+	int scale = 0;
+	uint32_t disp = 0;
+
+	if (rm == 4)
+	{
+		const uint8_t sib = *next++;
+		scale = sib >> 6;
+		index = ((sib >> 3) & 7) != 4 ? ((sib >> 3) & 7) : -1;
+		base = sib & 7;
+		if (mod == 0 && base == 5)
+		{
+			base = -1;
+			disp = IMM32(next);
+		}
+	}
+	else if (mod == 0 && rm == 5)
+	{
+		base = -1;
+		disp = IMM32(next);
+	}
+
+	if (mod == 1)
+		disp = int8_t(next[0]);
+	else if (mod == 2)
+		disp = IMM32(next);
+
+	if (index >= 0)
+	{
+		UML_SHL(block, I0, IREG(index), scale);                                    // shl     i0,<index>,scale
+		if (base >= 0)
+			UML_ADD(block, I0, I0, IREG(base));                                    // add     i0,i0,<base>
+		if (disp != 0)
+			UML_ADD(block, I0, I0, disp);                                           // add     i0,i0,disp
+	}
+	else if (base >= 0)
+	{
+		if (disp != 0)
+			UML_ADD(block, I0, IREG(base), disp);                                  // add     i0,<base>,disp
+		else
+			UML_MOV(block, I0, IREG(base));                                        // mov     i0,<base>
+	}
+	else
+		UML_MOV(block, I0, disp);                                                   // mov     i0,disp
+}
+
+
+/*-------------------------------------------------
+    generate_jcc - generate a conditional near
+    branch on condition code cond
+-------------------------------------------------*/
+
+void i386_device::generate_jcc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cond, int taken_cycles, int nobranch_cycles)
+{
+	const uml::code_label skip = compiler.labelnum++;
+
+	/* evaluate the base condition into I0; odd conditions are its inverse */
+	switch (cond >> 1)
+	{
+		case 0: UML_MOV(block, I0, mem(&m_drc->of)); break;                         // mov     i0,[of]
+		case 1: UML_MOV(block, I0, mem(&m_drc->cf)); break;                         // mov     i0,[cf]
+		case 2: UML_MOV(block, I0, mem(&m_drc->zf)); break;                         // mov     i0,[zf]
+		case 3: UML_OR(block, I0, mem(&m_drc->cf), mem(&m_drc->zf)); break;         // or      i0,[cf],[zf]
+		case 4: UML_MOV(block, I0, mem(&m_drc->sf)); break;                         // mov     i0,[sf]
+		case 5: UML_MOV(block, I0, mem(&m_drc->pf)); break;                         // mov     i0,[pf]
+		case 6: UML_XOR(block, I0, mem(&m_drc->sf), mem(&m_drc->of)); break;        // xor     i0,[sf],[of]
+		case 7:
+			UML_XOR(block, I0, mem(&m_drc->sf), mem(&m_drc->of));                   // xor     i0,[sf],[of]
+			UML_OR(block, I0, I0, mem(&m_drc->zf));                                 // or      i0,i0,[zf]
+			break;
+	}
+	UML_TEST(block, I0, ~0);                                                        // test    i0,~0
+	UML_JMPc(block, (cond & 1) ? COND_NZ : COND_Z, skip);                           // jmp     skip,<not taken>
+
+	/* the taken path accounts for its own cycles */
+	compiler_state compiler_temp(compiler);
+	compiler_temp.cycles += m_cycle_table_pm[taken_cycles];
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler_temp.cycles);                        // mapvar  CYCLES,compiler_temp.cycles
+	generate_branch(block, compiler_temp, desc);
+
+	UML_LABEL(block, skip);                                                     // skip:
+	compiler.labelnum = compiler_temp.labelnum;
+	compiler.cycles += m_cycle_table_pm[nobranch_cycles];
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                             // mapvar  CYCLES,compiler.cycles
+}
+
+
+/*-------------------------------------------------
+    generate_branch - generate a jump to a fixed
+    branch target
+-------------------------------------------------*/
+
+void i386_device::generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	generate_update_cycles(block, compiler, desc->targetpc, true);                 // <subtract cycles>
+	if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+		UML_JMP(block, desc->targetpc | 0x80000000);                                // jmp     desc->targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, compiler.mode, desc->targetpc, *m_nocode);               // hashjmp <mode>,desc->targetpc,nocode
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode, returning false to fall back to the
+    interpreter
+-------------------------------------------------*/
+
+bool i386_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	const uint8_t *const op = desc->opptr.b;
+	const uint8_t modrm = op[1];
+	const int reg = (modrm >> 3) & 7;
+	const int rm = modrm & 7;
+
+	/* any prefix byte lands in the default case */
+	switch (op[0])
+	{
+		case 0x0f:
+			return generate_two_byte(block, compiler, desc);
+
+		case 0x01: case 0x09: case 0x21: case 0x29: case 0x31: case 0x39:  // ALU r/m32,r32
+			if (modrm < 0xc0)
+				return false;
+			generate_native(block, compiler, desc, (op[0] == 0x39) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG);
+			generate_alu(block, op[0] >> 3, IREG(rm), IREG(reg));
+			return true;
+
+		case 0x03: case 0x0b: case 0x23: case 0x2b: case 0x33: case 0x3b:  // ALU r32,r/m32
+			if (modrm < 0xc0)
+				return false;
+			generate_native(block, compiler, desc, (op[0] == 0x3b) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG);
+			generate_alu(block, op[0] >> 3, IREG(reg), IREG(rm));
+			return true;
+
+		case 0x05: case 0x0d: case 0x25: case 0x2d: case 0x35: case 0x3d:  // ALU EAX,imm32
+			generate_native(block, compiler, desc, (op[0] == 0x3d) ? CYCLES_CMP_IMM_ACC : CYCLES_ALU_IMM_ACC);
+			generate_alu(block, op[0] >> 3, IREG(EAX), IMM32(&op[1]));
+			return true;
+
+		case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:    // INC r32
+			generate_native(block, compiler, desc, CYCLES_INC_REG);
+			generate_incdec(block, false, IREG(op[0] & 7));
+			return true;
+
+		case 0x48: case 0x49: case 0x4a: case 0x4b: case 0x4c: case 0x4d: case 0x4e: case 0x4f:    // DEC r32
+			generate_native(block, compiler, desc, CYCLES_DEC_REG);
+			generate_incdec(block, true, IREG(op[0] & 7));
+			return true;
+
+		case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:    // Jcc rel8
+		case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+			generate_native(block, compiler, desc, -1);
+			generate_jcc(block, compiler, desc, op[0] & 0x0f, CYCLES_JCC_DISP8, CYCLES_JCC_DISP8_NOBRANCH);
+			return true;
+
+		case 0x81: case 0x83:                                               // ALU r/m32,imm
+			if (modrm < 0xc0 || reg == ALU_ADC || reg == ALU_SBB)
+				return false;
+			generate_native(block, compiler, desc, (reg == ALU_CMP) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG);
+			generate_alu(block, reg, IREG(rm), (op[0] == 0x81) ? IMM32(&op[2]) : uint32_t(int32_t(int8_t(op[2]))));
+			return true;
+
+		case 0x85:                                                          // TEST r/m32,r32
+			if (modrm < 0xc0)
+				return false;
+			generate_native(block, compiler, desc, CYCLES_TEST_REG_REG);
+			generate_alu(block, ALU_TEST, IREG(rm), IREG(reg));
+			return true;
+
+		case 0x87:                                                          // XCHG r/m32,r32
+			if (modrm < 0xc0)
+				return false;
+			generate_native(block, compiler, desc, CYCLES_XCHG_REG_REG);
+			UML_MOV(block, I0, IREG(rm));                                          // mov     i0,<rm>
+			UML_MOV(block, IREG(rm), IREG(reg));                                  // mov     <rm>,<reg>
+			UML_MOV(block, IREG(reg), I0);                                         // mov     <reg>,i0
+			return true;
+
+		case 0x89:                                                          // MOV r/m32,r32
+			if (modrm < 0xc0)
+				return false;
+			generate_native(block, compiler, desc, CYCLES_MOV_REG_REG);
+			UML_MOV(block, IREG(rm), IREG(reg));                                  // mov     <rm>,<reg>
+			return true;
+
+		case 0x8b:                                                          // MOV r32,r/m32
+			if (modrm < 0xc0)
+				return false;
+			generate_native(block, compiler, desc, CYCLES_MOV_REG_REG);
+			UML_MOV(block, IREG(reg), IREG(rm));                                  // mov     <reg>,<rm>
+			return true;
+
+		case 0x8d:                                                          // LEA r32,m
+			if (modrm >= 0xc0)
+				return false;
+			generate_native(block, compiler, desc, CYCLES_LEA);
+			generate_lea(block, desc);
+			UML_MOV(block, IREG(reg), I0);                                         // mov     <reg>,i0
+			return true;
+
+		case 0x90:                                                          // NOP
+			generate_native(block, compiler, desc, CYCLES_NOP);
+			return true;
+
+		case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: case 0x96: case 0x97:    // XCHG EAX,r32
+			generate_native(block, compiler, desc, CYCLES_XCHG_REG_REG);
+			UML_MOV(block, I0, IREG(EAX));                                         // mov     i0,<eax>
+			UML_MOV(block, IREG(EAX), IREG(op[0] & 7));                           // mov     <eax>,<reg>
+			UML_MOV(block, IREG(op[0] & 7), I0);                                   // mov     <reg>,i0
+			return true;
+
+		case 0xa9:                                                          // TEST EAX,imm32
+			generate_native(block, compiler, desc, CYCLES_TEST_IMM_ACC);
+			generate_alu(block, ALU_TEST, IREG(EAX), IMM32(&op[1]));
+			return true;
+
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:    // MOV r32,imm32
+			generate_native(block, compiler, desc, CYCLES_MOV_IMM_REG);
+			UML_MOV(block, IREG(op[0] & 7), IMM32(&op[1]));                        // mov     <reg>,imm
+			return true;
+
+		case 0xe9:                                                          // JMP rel32
+			generate_native(block, compiler, desc, CYCLES_JMP);
+			generate_branch(block, compiler, desc);
+			return true;
+
+		case 0xeb:                                                          // JMP rel8
+			generate_native(block, compiler, desc, CYCLES_JMP_SHORT);
+			generate_branch(block, compiler, desc);
+			return true;
+
+		case 0xf7:
+			if (modrm < 0xc0)
+				return false;
+			if (reg == 0)                                                   // TEST r/m32,imm32
+			{
+				generate_native(block, compiler, desc, CYCLES_TEST_IMM_REG);
+				generate_alu(block, ALU_TEST, IREG(rm), IMM32(&op[2]));
+				UML_MOV(block, mem(&m_drc->af), 0);                                 // mov     [af],0
+				return true;
+			}
+			if (reg == 2)                                                   // NOT r/m32
+			{
+				generate_native(block, compiler, desc, CYCLES_NOT_REG);
+				UML_XOR(block, IREG(rm), IREG(rm), ~0);                           // xor     <rm>,<rm>,~0
+				return true;
+			}
+			return false;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_two_byte - generate code for a 0F
+    prefixed opcode
+-------------------------------------------------*/
+
+bool i386_device::generate_two_byte(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	const uint8_t *const op = desc->opptr.b;
+	const uint8_t modrm = op[2];
+	const int reg = (modrm >> 3) & 7;
+	const int rm = modrm & 7;
+
+	switch (op[1])
+	{
+		case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:    // Jcc rel32
+		case 0x88: case 0x89: case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+			generate_native(block, compiler, desc, -1);
+			generate_jcc(block, compiler, desc, op[1] & 0x0f, CYCLES_JCC_FULL_DISP, CYCLES_JCC_FULL_DISP_NOBRANCH);
+			return true;
+
+		case 0xb6: case 0xbe:                                               // MOVZX/MOVSX r32,r8
+			if (modrm < 0xc0)
+				return false;
+			generate_native(block, compiler, desc, (op[1] == 0xb6) ? CYCLES_MOVZX_REG_REG : CYCLES_MOVSX_REG_REG);
+			if (rm < 4)
+				UML_AND(block, I0, IREG(rm), 0xff);                                // and     i0,<rm>,0xff
+			else
+			{
+				UML_SHR(block, I0, IREG(rm & 3), 8);                               // shr     i0,<rm & 3>,8
+				UML_AND(block, I0, I0, 0xff);                                       // and     i0,i0,0xff
+			}
+			if (op[1] == 0xbe)
+				UML_SEXT(block, I0, I0, SIZE_BYTE);                                 // sext    i0,i0,byte
+			UML_MOV(block, IREG(reg), I0);                                         // mov     <reg>,i0
+			return true;
+
+		case 0xb7: case 0xbf:                                               // MOVZX/MOVSX r32,r16
+			if (modrm < 0xc0)
+				return false;
+			generate_native(block, compiler, desc, (op[1] == 0xb7) ? CYCLES_MOVZX_REG_REG : CYCLES_MOVSX_REG_REG);
+			UML_AND(block, I0, IREG(rm), 0xffff);                                  // and     i0,<rm>,0xffff
+			if (op[1] == 0xbf)
+				UML_SEXT(block, I0, I0, SIZE_WORD);                                 // sext    i0,i0,word
+			UML_MOV(block, IREG(reg), I0);                                         // mov     <reg>,i0
+			return true;
+	}
+
+	return false;
+}
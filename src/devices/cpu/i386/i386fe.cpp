@@ -0,0 +1,381 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    i386fe.cpp
+
+    Front-end for the i386 recompiler
+
+    The front-end only needs to know how long each instruction is and
+    where control flow may leave the straight-line path; everything the
+    back-end doesn't lower to UML itself is handed to the interpreter,
+    which decodes the instruction again, so a mis-sized instruction costs
+    a redispatch rather than correctness.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "i386fe.h"
+
+
+//**************************************************************************
+//  I386 FRONTEND
+//**************************************************************************
+
+//-------------------------------------------------
+//  i386_frontend - constructor
+//-------------------------------------------------
+
+i386_frontend::i386_frontend(i386_device &cpu, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
+	: drc_frontend(cpu, window_start, window_end, max_sequence)
+	, m_cpu(cpu)
+{
+}
+
+
+//-------------------------------------------------
+//  fetch - fetch the next byte of an instruction,
+//  returning false if it isn't in RAM or ROM
+//-------------------------------------------------
+
+bool i386_frontend::fetch(opcode_desc &desc, uint8_t &value)
+{
+	// architecturally no instruction is longer than 15 bytes
+	if (desc.length >= 15)
+		return false;
+
+	offs_t physical;
+	if (!m_cpu.drc_translate_code(desc.pc + desc.length, physical))
+		return false;
+	if (desc.length == 0)
+		desc.physpc = physical;
+
+	value = desc.opptr.b[desc.length++] = m_cpu.m_program->read_byte(physical);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  skip_bytes - consume immediate or displacement
+//  bytes
+//-------------------------------------------------
+
+bool i386_frontend::skip_bytes(opcode_desc &desc, int count)
+{
+	uint8_t dummy;
+	while (count-- > 0)
+		if (!fetch(desc, dummy))
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  skip_modrm - consume a ModR/M byte along with
+//  any SIB byte and displacement
+//-------------------------------------------------
+
+bool i386_frontend::skip_modrm(opcode_desc &desc, bool address16)
+{
+	uint8_t modrm;
+	if (!fetch(desc, modrm))
+		return false;
+
+	const int mod = modrm >> 6;
+	const int rm = modrm & 7;
+	if (mod == 3)
+		return true;
+
+	if (address16)
+	{
+		if (mod == 0 && rm == 6)
+			return skip_bytes(desc, 2);
+		return skip_bytes(desc, mod);
+	}
+
+	if (rm == 4)
+	{
+		uint8_t sib;
+		if (!fetch(desc, sib))
+			return false;
+		if (mod == 0 && (sib & 7) == 5)
+			return skip_bytes(desc, 4);
+	}
+	else if (mod == 0 && rm == 5)
+		return skip_bytes(desc, 4);
+
+	return skip_bytes(desc, (mod == 1) ? 1 : (mod == 2) ? 4 : 0);
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool i386_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	bool prefixed = false;
+	bool operand16 = false;
+	bool address16 = false;
+	uint8_t op;
+
+	// the recompiler only runs 32-bit code segments, so that is the default size
+	while (true)
+	{
+		if (!fetch(desc, op))
+			goto fail;
+
+		if (op == 0x66)
+			operand16 = true;
+		else if (op == 0x67)
+			address16 = true;
+		else if (op != 0x26 && op != 0x2e && op != 0x36 && op != 0x3e && op != 0x64 && op != 0x65 && op != 0xf0 && op != 0xf2 && op != 0xf3)
+			break;
+		prefixed = true;
+	}
+
+	{
+		const int immz = operand16 ? 2 : 4;
+		bool modrm = false;
+		int imm = 0;
+
+		if (op == 0x0f)
+		{
+			if (!describe_two_byte(desc, prefixed, operand16, address16))
+				goto fail;
+			return true;
+		}
+		else if (op < 0x40)
+		{
+			switch (op & 7)
+			{
+				case 0: case 1: case 2: case 3:
+					modrm = true;
+					break;
+
+				case 4:
+					imm = 1;
+					break;
+
+				case 5:
+					imm = immz;
+					break;
+
+				case 7:
+					// POP ES/SS/DS reload a segment register
+					if (op == 0x07 || op == 0x17 || op == 0x1f)
+						desc.flags |= OPFLAG_END_SEQUENCE;
+					break;
+			}
+		}
+		else
+		{
+			switch (op)
+			{
+				case 0x62: case 0x63:                       // BOUND, ARPL
+				case 0x84: case 0x85: case 0x86: case 0x87: case 0x88: case 0x89: case 0x8a: case 0x8b:
+				case 0x8c: case 0x8d: case 0x8f:
+				case 0xc4: case 0xc5:                       // LES, LDS
+				case 0xd0: case 0xd1: case 0xd2: case 0xd3:
+				case 0xd8: case 0xd9: case 0xda: case 0xdb: case 0xdc: case 0xdd: case 0xde: case 0xdf:
+				case 0xfe:
+					modrm = true;
+					break;
+
+				case 0x69: case 0x81: case 0xc7:
+					modrm = true;
+					imm = immz;
+					break;
+
+				case 0x6b: case 0x80: case 0x82: case 0x83: case 0xc0: case 0xc1: case 0xc6:
+					modrm = true;
+					imm = 1;
+					break;
+
+				case 0x68: case 0xa9:
+				case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+					imm = immz;
+					break;
+
+				case 0x6a: case 0xa8: case 0xd4: case 0xd5:
+				case 0xb0: case 0xb1: case 0xb2: case 0xb3: case 0xb4: case 0xb5: case 0xb6: case 0xb7:
+				case 0xe4: case 0xe5: case 0xe6: case 0xe7:
+					imm = 1;
+					break;
+
+				case 0xa0: case 0xa1: case 0xa2: case 0xa3:   // MOV with a memory offset
+					imm = address16 ? 2 : 4;
+					break;
+
+				case 0xc8:                                  // ENTER
+					imm = 3;
+					break;
+
+				case 0x8e:                                  // MOV Sreg,r/m
+					modrm = true;
+					desc.flags |= OPFLAG_END_SEQUENCE;
+					break;
+
+				case 0x9d:                                  // POPF
+				case 0xc3: case 0xcb: case 0xcc: case 0xce: case 0xcf:
+				case 0xf1: case 0xf4: case 0xfb:
+					desc.flags |= OPFLAG_END_SEQUENCE;
+					break;
+
+				case 0xc2: case 0xca:                       // RET imm16
+					imm = 2;
+					desc.flags |= OPFLAG_END_SEQUENCE;
+					break;
+
+				case 0xcd: case 0xe0: case 0xe1: case 0xe2: case 0xe3:
+					imm = 1;
+					desc.flags |= OPFLAG_END_SEQUENCE;
+					break;
+
+				case 0xe8:                                  // CALL rel
+					imm = immz;
+					desc.flags |= OPFLAG_END_SEQUENCE;
+					break;
+
+				case 0x9a: case 0xea:                       // far CALL/JMP ptr16:32
+					imm = immz + 2;
+					desc.flags |= OPFLAG_END_SEQUENCE;
+					break;
+
+				case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:
+				case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+				case 0xeb:
+				case 0xe9:
+					if (!skip_bytes(desc, (op == 0xe9) ? immz : 1))
+						goto fail;
+					if (prefixed)
+						desc.flags |= OPFLAG_END_SEQUENCE;
+					else
+					{
+						// unprefixed near branches are handled natively
+						const int32_t disp = (op == 0xe9) ? int32_t(desc.opptr.b[1] | (desc.opptr.b[2] << 8) | (desc.opptr.b[3] << 16) | (desc.opptr.b[4] << 24)) : int8_t(desc.opptr.b[1]);
+						desc.targetpc = desc.pc + desc.length + disp;
+						if (op < 0x80)
+							desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+						else
+							desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+					}
+					return true;
+
+				case 0xf6: case 0xf7:
+				case 0xff:
+				{
+					const int offset = desc.length;
+					if (!skip_modrm(desc, address16))
+						goto fail;
+					const int reg = (desc.opptr.b[offset] >> 3) & 7;
+					if (op == 0xff)
+					{
+						// indirect CALL/JMP, near or far
+						if (reg >= 2 && reg <= 5)
+							desc.flags |= OPFLAG_END_SEQUENCE;
+					}
+					else if (reg < 2 && !skip_bytes(desc, (op == 0xf6) ? 1 : immz))     // TEST r/m,imm
+						goto fail;
+					return true;
+				}
+			}
+		}
+
+		if (modrm && !skip_modrm(desc, address16))
+			goto fail;
+		if (!skip_bytes(desc, imm))
+			goto fail;
+		return true;
+	}
+
+fail:
+	// leave undecodable or unbacked code to the interpreter one byte at a time
+	desc.length = 1;
+	desc.flags |= OPFLAG_END_SEQUENCE;
+	return false;
+}
+
+
+//-------------------------------------------------
+//  describe_two_byte - build a description of a
+//  0F-prefixed instruction
+//-------------------------------------------------
+
+bool i386_frontend::describe_two_byte(opcode_desc &desc, bool prefixed, bool operand16, bool address16)
+{
+	uint8_t op;
+	if (!fetch(desc, op))
+		return false;
+
+	bool modrm = true;
+	int imm = 0;
+	switch (op)
+	{
+		case 0x00: case 0x22: case 0x23:                // LLDT/LTR, MOV CRn/DRn
+		case 0xb2:                                      // LSS
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x01:                                      // LGDT/LIDT/LMSW/INVLPG
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			desc.userflags |= I386_DRC_FLUSH_AFTER;
+			break;
+
+		case 0x05: case 0x07: case 0x0b: case 0x30: case 0x34: case 0x35:
+		case 0xa1: case 0xa9: case 0xaa:                // SYSCALL/SYSRET, UD2, WRMSR, SYSENTER/SYSEXIT, POP FS/GS, RSM
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			modrm = false;
+			break;
+
+		case 0x06: case 0x08: case 0x09: case 0x31: case 0x32: case 0x33: case 0x77:
+		case 0xa0: case 0xa2: case 0xa8:
+		case 0xc8: case 0xc9: case 0xca: case 0xcb: case 0xcc: case 0xcd: case 0xce: case 0xcf:
+			modrm = false;
+			break;
+
+		case 0x0f:                                      // 3DNow! has a trailing opcode byte
+		case 0x70: case 0x71: case 0x72: case 0x73:
+		case 0xa4: case 0xac: case 0xba:
+		case 0xc2: case 0xc4: case 0xc5: case 0xc6:
+			imm = 1;
+			break;
+
+		case 0x38: case 0x3a:                           // three-byte opcodes
+		{
+			uint8_t op3;
+			if (!fetch(desc, op3))
+				return false;
+			if (op == 0x3a)
+				imm = 1;
+			break;
+		}
+
+		case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:
+		case 0x88: case 0x89: case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+			if (!skip_bytes(desc, operand16 ? 2 : 4))
+				return false;
+			if (prefixed)
+				desc.flags |= OPFLAG_END_SEQUENCE;
+			else
+			{
+				const int32_t disp = int32_t(desc.opptr.b[2] | (desc.opptr.b[3] << 8) | (desc.opptr.b[4] << 16) | (desc.opptr.b[5] << 24));
+				desc.targetpc = desc.pc + desc.length + disp;
+				desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			}
+			return true;
+
+		case 0x04: case 0x0a: case 0x0c: case 0x0e:
+		case 0x24: case 0x25: case 0x26: case 0x27: case 0x36: case 0x37: case 0x39:
+		case 0x3b: case 0x3c: case 0x3d: case 0x3e: case 0x3f: case 0xa6: case 0xa7:
+			// undefined; the interpreter raises the fault
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			modrm = false;
+			break;
+	}
+
+	if (modrm && !skip_modrm(desc, address16))
+		return false;
+	return skip_bytes(desc, imm);
+}
@@ -0,0 +1,53 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    i386fe.h
+
+    Front-end for the i386 recompiler
+
+***************************************************************************/
+#ifndef MAME_CPU_I386_I386FE_H
+#define MAME_CPU_I386_I386FE_H
+
+#pragma once
+
+#include "i386.h"
+#include "cpu/drcfe.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// opcode_desc userflags
+#define I386_DRC_FLUSH_AFTER            0x00000001      // may invalidate translations behind our back
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class i386_frontend : public drc_frontend
+{
+public:
+	// construction/destruction
+	i386_frontend(i386_device &cpu, uint32_t window_start, uint32_t window_end, uint32_t max_sequence);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	// internal helpers
+	bool fetch(opcode_desc &desc, uint8_t &value);
+	bool skip_modrm(opcode_desc &desc, bool address16);
+	bool skip_bytes(opcode_desc &desc, int count);
+	bool describe_two_byte(opcode_desc &desc, bool prefixed, bool operand16, bool address16);
+
+	// internal state
+	i386_device &m_cpu;
+};
+
+
+#endif // MAME_CPU_I386_I386FE_H
@@ -240,6 +240,92 @@ void i386_device::x87_reset()
 	m_ferr_handler(0);
 }
 
+/*************************************
+ *
+ * Host arithmetic
+ *
+ *************************************/
+
+/*
+    In round-to-nearest, the host's IEEE single and double arithmetic
+    gives the same results as SoftFloat whenever the operands and result
+    are normal numbers, and the only exception SoftFloat can raise is
+    inexact.  That's found from the rounding error, which can be
+    recovered exactly: by the two-sum method for addition, and with a
+    fused multiply-add for multiplication and division, as long as
+    nothing is so small that the rounding error itself would underflow.
+    Zeroes, denormals, infinities, NaNs, and operands and results within
+    a mantissa's width of the bottom of the exponent range are left to
+    SoftFloat.  Hosts that
+    evaluate in extended precision would round twice, so they always use
+    SoftFloat.
+*/
+
+enum class x87_host_op { ADD, SUB, MUL, DIV };
+
+template <typename T> struct x87_host_format;
+template <> struct x87_host_format<float32> { typedef float type; static constexpr int EXP_SHIFT = 23; static constexpr unsigned EXP_MAX = 0xff; };
+template <> struct x87_host_format<float64> { typedef double type; static constexpr int EXP_SHIFT = 52; static constexpr unsigned EXP_MAX = 0x7ff; };
+
+template <typename T>
+static inline bool x87_host_range(T value)
+{
+	typedef x87_host_format<T> format;
+	unsigned const exp = (value >> format::EXP_SHIFT) & format::EXP_MAX;
+	return (exp > (format::EXP_SHIFT + 1)) && (exp != format::EXP_MAX);
+}
+
+template <x87_host_op Op, typename T>
+static bool x87_host_arith(T a, T b, T &result)
+{
+	typedef x87_host_format<T> format;
+	typedef typename format::type host;
+
+	if (FLT_EVAL_METHOD != 0 || float_rounding_mode != float_round_nearest_even)
+		return false;
+
+	if (!x87_host_range(a) || !x87_host_range(b))
+		return false;
+
+	host x, y, r;
+	std::memcpy(&x, &a, sizeof(x));
+	std::memcpy(&y, &b, sizeof(y));
+	bool inexact = false;
+	switch (Op)
+	{
+		case x87_host_op::SUB:
+			y = -y;
+			[[fallthrough]];
+		case x87_host_op::ADD:
+		{
+			r = x + y;
+			host const yr = r - x;
+			host const xr = r - yr;
+			inexact = ((x - xr) + (y - yr)) != 0;
+			break;
+		}
+		case x87_host_op::MUL:
+			r = x * y;
+			inexact = std::fma(x, y, -r) != 0;
+			break;
+		case x87_host_op::DIV:
+			r = x / y;
+			inexact = std::fma(r, y, -x) != 0;
+			break;
+	}
+
+	T bits;
+	std::memcpy(&bits, &r, sizeof(bits));
+	if (!x87_host_range(bits))
+		return false;
+
+	if (inexact)
+		float_exception_flags |= float_flag_inexact;
+	result = bits;
+	return true;
+}
+
+
 /*************************************
  *
  * Core arithmetic
@@ -256,14 +342,20 @@ floatx80 i386_device::x87_add(floatx80 a, floatx80 b)
 		{
 			float32 a32 = floatx80_to_float32(a);
 			float32 b32 = floatx80_to_float32(b);
-			result = float32_to_floatx80(float32_add(a32, b32));
+			float32 r32;
+			if (!m_x87_host || !x87_host_arith<x87_host_op::ADD>(a32, b32, r32))
+				r32 = float32_add(a32, b32);
+			result = float32_to_floatx80(r32);
 			break;
 		}
 		case X87_CW_PC_DOUBLE:
 		{
 			float64 a64 = floatx80_to_float64(a);
 			float64 b64 = floatx80_to_float64(b);
-			result = float64_to_floatx80(float64_add(a64, b64));
+			float64 r64;
+			if (!m_x87_host || !x87_host_arith<x87_host_op::ADD>(a64, b64, r64))
+				r64 = float64_add(a64, b64);
+			result = float64_to_floatx80(r64);
 			break;
 		}
 		case X87_CW_PC_EXTEND:
@@ -286,14 +378,20 @@ floatx80 i386_device::x87_sub(floatx80 a, floatx80 b)
 		{
 			float32 a32 = floatx80_to_float32(a);
 			float32 b32 = floatx80_to_float32(b);
-			result = float32_to_floatx80(float32_sub(a32, b32));
+			float32 r32;
+			if (!m_x87_host || !x87_host_arith<x87_host_op::SUB>(a32, b32, r32))
+				r32 = float32_sub(a32, b32);
+			result = float32_to_floatx80(r32);
 			break;
 		}
 		case X87_CW_PC_DOUBLE:
 		{
 			float64 a64 = floatx80_to_float64(a);
 			float64 b64 = floatx80_to_float64(b);
-			result = float64_to_floatx80(float64_sub(a64, b64));
+			float64 r64;
+			if (!m_x87_host || !x87_host_arith<x87_host_op::SUB>(a64, b64, r64))
+				r64 = float64_sub(a64, b64);
+			result = float64_to_floatx80(r64);
 			break;
 		}
 		case X87_CW_PC_EXTEND:
@@ -316,14 +414,20 @@ floatx80 i386_device::x87_mul(floatx80 a, floatx80 b)
 		{
 			float32 a32 = floatx80_to_float32(a);
 			float32 b32 = floatx80_to_float32(b);
-			val = float32_to_floatx80(float32_mul(a32, b32));
+			float32 r32;
+			if (!m_x87_host || !x87_host_arith<x87_host_op::MUL>(a32, b32, r32))
+				r32 = float32_mul(a32, b32);
+			val = float32_to_floatx80(r32);
 			break;
 		}
 		case X87_CW_PC_DOUBLE:
 		{
 			float64 a64 = floatx80_to_float64(a);
 			float64 b64 = floatx80_to_float64(b);
-			val = float64_to_floatx80(float64_mul(a64, b64));
+			float64 r64;
+			if (!m_x87_host || !x87_host_arith<x87_host_op::MUL>(a64, b64, r64))
+				r64 = float64_mul(a64, b64);
+			val = float64_to_floatx80(r64);
 			break;
 		}
 		case X87_CW_PC_EXTEND:
@@ -347,14 +451,20 @@ floatx80 i386_device::x87_div(floatx80 a, floatx80 b)
 		{
 			float32 a32 = floatx80_to_float32(a);
 			float32 b32 = floatx80_to_float32(b);
-			val = float32_to_floatx80(float32_div(a32, b32));
+			float32 r32;
+			if (!m_x87_host || !x87_host_arith<x87_host_op::DIV>(a32, b32, r32))
+				r32 = float32_div(a32, b32);
+			val = float32_to_floatx80(r32);
 			break;
 		}
 		case X87_CW_PC_DOUBLE:
 		{
 			float64 a64 = floatx80_to_float64(a);
 			float64 b64 = floatx80_to_float64(b);
-			val = float64_to_floatx80(float64_div(a64, b64));
+			float64 r64;
+			if (!m_x87_host || !x87_host_arith<x87_host_op::DIV>(a64, b64, r64))
+				r64 = float64_div(a64, b64);
+			val = float64_to_floatx80(r64);
 			break;
 		}
 		case X87_CW_PC_EXTEND:
@@ -31,14 +31,17 @@ m6502_device::m6502_device(const machine_config &mconfig, device_type type, cons
 	program_config("program", ENDIANNESS_LITTLE, 8, 16),
 	sprogram_config("decrypted_opcodes", ENDIANNESS_LITTLE, 8, 16),
 	mintf(nullptr),
-	uses_custom_memory_interface(false)
+	uses_custom_memory_interface(false),
+	direct_fetch(false)
 {
 }
 
 void m6502_device::device_start()
 {
-	if(!uses_custom_memory_interface)
+	if(!uses_custom_memory_interface) {
 		mintf = space(AS_PROGRAM).addr_width() > 14 ? std::make_unique<mi_default>() : std::make_unique<mi_default14>();
+		direct_fetch = true;
+	}
 
 	init();
 }
@@ -450,7 +453,7 @@ void m6502_device::state_import(const device_state_entry &entry)
 		PC = NPC;
 		irq_taken = false;
 		prefetch_start();
-		IR = mintf->read_sync(PC);
+		IR = read_sync(PC);
 		prefetch_end();
 		PPC = NPC;
 		inst_state = IR | inst_state_base;
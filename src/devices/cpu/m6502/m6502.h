@@ -48,6 +48,7 @@ public:
 
 	void set_custom_memory_interface(std::unique_ptr<memory_interface> interface) {
 		mintf = std::move(interface);
+		direct_fetch = false;
 	}
 
 	bool get_sync() const { return sync; }
@@ -138,13 +139,15 @@ protected:
 	bool nmi_state, irq_state, apu_irq_state, v_state;
 	bool nmi_pending, irq_taken, sync, inhibit_interrupts;
 	bool uses_custom_memory_interface;
+	bool direct_fetch;                /* fetches can skip the memory interface and hit its caches */
 
 	uint8_t read(uint16_t adr) { return mintf->read(adr); }
 	uint8_t read_9(uint16_t adr) { return mintf->read_9(adr); }
 	void write(uint16_t adr, uint8_t val) { mintf->write(adr, val); }
 	void write_9(uint16_t adr, uint8_t val) { mintf->write_9(adr, val); }
-	uint8_t read_arg(uint16_t adr) { return mintf->read_arg(adr); }
-	uint8_t read_pc() { return mintf->read_arg(PC); }
+	uint8_t read_sync(uint16_t adr) { return direct_fetch ? mintf->csprogram.read_byte(adr) : mintf->read_sync(adr); }
+	uint8_t read_arg(uint16_t adr) { return direct_fetch ? mintf->cprogram.read_byte(adr) : mintf->read_arg(adr); }
+	uint8_t read_pc() { return read_arg(PC); }
 	void prefetch_start();
 	void prefetch_end();
 	void prefetch_end_noirq();
@@ -33,11 +33,11 @@ def load_opcodes(fname):
             # append instruction to last opcode
             if line == '\tprefetch();':
                 opcodes[-1][1].append("\tprefetch_start();")
-                opcodes[-1][1].append("\tIR = mintf->read_sync(PC);")
+                opcodes[-1][1].append("\tIR = read_sync(PC);")
                 opcodes[-1][1].append("\tprefetch_end();")
             elif line == '\tprefetch_noirq();':
                 opcodes[-1][1].append("\tprefetch_start();")
-                opcodes[-1][1].append("\tIR = mintf->read_sync(PC);")
+                opcodes[-1][1].append("\tIR = read_sync(PC);")
                 opcodes[-1][1].append("\tprefetch_end_noirq();")
             else:
                 opcodes[-1][1].append(line)
@@ -107,6 +107,11 @@ void m68000_device::execute_run()
 	} else
 		m_count_before_instruction_step = 0;
 
+	// The handlers write through this, so the compiler can't keep these
+	// in registers across instructions unless they're copied here first
+	const handler *const handlers_f = m_handlers_f;
+	const bool debug = machine().debug_flags & DEBUG_FLAG_ENABLED;
+
 	for(;;) {
 		if(m_icount > 0 && m_inst_substate)
 			(this->*(m_handlers_p[m_inst_state]))();
@@ -116,10 +121,10 @@ void m68000_device::execute_run()
 				m_ipc = m_pc - 2;
 				m_irdi = m_ird;
 
-				if(machine().debug_flags & DEBUG_FLAG_ENABLED)
+				if(debug)
 					debugger_instruction_hook(m_ipc);
 			}
-			(this->*(m_handlers_f[m_inst_state]))();
+			(this->*(handlers_f[m_inst_state]))();
 		}
 
 		if(m_post_run)
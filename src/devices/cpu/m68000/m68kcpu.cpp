@@ -27,6 +27,7 @@ static const char copyright_notice[] =
 #include "emu.h"
 #include "m68kmusashi.h"
 #include "m68kdasm.h"
+#include "m68kfe.h"
 
 // Generated data
 
@@ -890,6 +891,15 @@ void m68000_musashi_device::execute_run()
 		/* Main loop.  Keep going until we run out of clock cycles */
 		while (m_icount > 0)
 		{
+			/* Run compiled code for as long as the recompiler can handle the state */
+			if (m_enable_drc && drc_can_execute())
+			{
+				execute_run_drc();
+				if (m_address_error)
+					goto check_address_error;
+				continue;
+			}
+
 			/* Set tracing accodring to T1. (T0 is done inside instruction) */
 			m68ki_trace_t1(); /* auto-disable (see m68kcpu.h) */
 
@@ -1104,6 +1114,7 @@ void m68000_musashi_device::init_cpu_common(void)
 	set_icountptr(m_icount);
 	m_icount = 0;
 
+	drc_init();
 }
 
 void m68000_musashi_device::device_reset()
@@ -2294,6 +2305,10 @@ m68000_musashi_device::m68000_musashi_device(const machine_config &mconfig, cons
 	clear_all();
 }
 
+m68000_musashi_device::~m68000_musashi_device()
+{
+}
+
 void m68000_musashi_device::clear_all()
 {
 	m_cpu_type= 0;
@@ -2411,6 +2426,14 @@ void m68000_musashi_device::clear_all()
 	}
 
 	m_internal = nullptr;
+
+	m_drc = nullptr;
+	m_enable_drc = false;
+	m_cache_dirty = true;
+	m_entry = nullptr;
+	m_nocode = nullptr;
+	m_out_of_cycles = nullptr;
+	m_redispatch = nullptr;
 }
 
 void m68000_musashi_device::device_start()
@@ -990,16 +990,22 @@ inline void m68ki_jump_vector(u32 vector)
 inline void m68ki_branch_8(u32 offset)
 {
 	m_pc += MAKE_INT_8(offset);
+	if (MAKE_INT_8(offset) < 0)
+		idle_branch_hook(m_pc);
 }
 
 inline void m68ki_branch_16(u32 offset)
 {
 	m_pc += MAKE_INT_16(offset);
+	if (MAKE_INT_16(offset) < 0)
+		idle_branch_hook(m_pc);
 }
 
 inline void m68ki_branch_32(u32 offset)
 {
 	m_pc += offset;
+	if (MAKE_INT_32(offset) < 0)
+		idle_branch_hook(m_pc);
 }
 
 
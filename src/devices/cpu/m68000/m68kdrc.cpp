@@ -0,0 +1,1055 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    m68kdrc.cpp
+
+    Universal machine language-based Musashi 680x0 emulator.
+
+****************************************************************************
+
+    The recompiler runs the 68010 and 68020/030/040 family cores while
+    no MMU is translating addresses, tracing is off and the CPU isn't
+    stopped; anything else stays on the interpreter.  ColdFire keeps to
+    the interpreter entirely.  The plain 68000 and 68008 are the
+    microcoded m68000_device, which models each bus cycle and isn't
+    recompiled.
+
+    Register-to-register integer operations, LEA and relative branches
+    are lowered to UML, keeping the flags in the interpreter's own
+    representation and charging the interpreter's cycle counts.  Every
+    other instruction calls back into the interpreter to execute it once.
+    Address errors are caught in that callback and handed to the
+    interpreter's main loop, so they never unwind through generated code.
+
+    Compiled code is keyed by PC and supervisor state.  Natively executed
+    instructions are checked against the memory they were decoded from,
+    so self-modifying code is caught before it runs, and the cache is
+    thrown away whenever the opcode address space is remapped.
+
+    Future improvements/changes:
+
+    * Lower (An), (An)+, -(An) and (d16,An) operands on RAM straight to
+      UML reads and writes instead of calling the interpreter
+
+    * Track which flags are live so dead flag computations can be
+      dropped
+
+***************************************************************************/
+
+#include "emu.h"
+#include "m68kmusashi.h"
+#include "m68kfe.h"
+
+#include "cpu/drcumlsh.h"
+
+#include "emuopts.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the recompiler's code cache */
+#define CACHE_SIZE                      (16 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         128
+#define COMPILE_FORWARDS_BYTES          512
+#define COMPILE_MAX_SEQUENCE            64
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_RESET_CACHE             3
+#define EXECUTE_INTERPRET               4
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define DREG(x)                         mem(&m_drc->dar[x])
+#define AREG(x)                         mem(&m_drc->dar[8 + (x)])
+
+/* map variables */
+#define MAPVAR_PC                       M0
+#define MAPVAR_CYCLES                   M1
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+static inline void alloc_handle(drcuml_state &drcuml, uml::code_handle *&handleptr, const char *name)
+{
+	if (!handleptr)
+		handleptr = drcuml.handle_alloc(name);
+}
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler if it is
+    allowed for this device
+-------------------------------------------------*/
+
+void m68000_musashi_device::drc_init()
+{
+	/* the recompiler is opt-in until it has been validated more widely; natively executed instructions don't call the debugger hook */
+	m_enable_drc = allow_drc() && machine().options().drc_m68k() && !(machine().debug_flags & DEBUG_FLAG_ENABLED);
+	if (!m_enable_drc)
+		return;
+
+	/* the shadow state must be reachable from generated code */
+	m_drccache = std::make_unique<drc_cache>(CACHE_SIZE + sizeof(internal_m68k_drc_state));
+	m_drc = (internal_m68k_drc_state *)m_drccache->alloc_near(sizeof(internal_m68k_drc_state));
+	memset(m_drc, 0, sizeof(internal_m68k_drc_state));
+
+	/* initialize the UML generator; one hash mode each for user and supervisor state */
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 2, 32, 0);
+
+	/* add symbols for our stuff */
+	for (int regnum = 0; regnum < 8; regnum++)
+	{
+		m_drcuml->symbol_add(&m_drc->dar[regnum], sizeof(m_drc->dar[regnum]), util::string_format("d%d", regnum).c_str());
+		m_drcuml->symbol_add(&m_drc->dar[8 + regnum], sizeof(m_drc->dar[8 + regnum]), util::string_format("a%d", regnum).c_str());
+	}
+	m_drcuml->symbol_add(&m_drc->x_flag, sizeof(m_drc->x_flag), "x_flag");
+	m_drcuml->symbol_add(&m_drc->n_flag, sizeof(m_drc->n_flag), "n_flag");
+	m_drcuml->symbol_add(&m_drc->not_z_flag, sizeof(m_drc->not_z_flag), "not_z_flag");
+	m_drcuml->symbol_add(&m_drc->v_flag, sizeof(m_drc->v_flag), "v_flag");
+	m_drcuml->symbol_add(&m_drc->c_flag, sizeof(m_drc->c_flag), "c_flag");
+	m_drcuml->symbol_add(&m_drc->pc, sizeof(m_drc->pc), "pc");
+	m_drcuml->symbol_add(&m_drc->icount, sizeof(m_drc->icount), "icount");
+	m_drcuml->symbol_add(&m_drc->mode, sizeof(m_drc->mode), "mode");
+	m_drcuml->symbol_add(&m_drc->exitcode, sizeof(m_drc->exitcode), "exitcode");
+	m_drcuml->symbol_add(&m_drc->arg0, sizeof(m_drc->arg0), "arg0");
+	m_drcuml->symbol_add(&m_drc->arg1, sizeof(m_drc->arg1), "arg1");
+
+	/* initialize the front-end helper */
+	m_drcfe = std::make_unique<m68k_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	/* compiled code is only valid for the memory map it was compiled against */
+	m_notifier = m_oprogram->add_change_notifier([this] (read_or_write mode) { m_cache_dirty = true; });
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = true;
+}
+
+
+/*-------------------------------------------------
+    drc_can_execute - return true if the current
+    CPU state is one the recompiler handles
+-------------------------------------------------*/
+
+bool m68000_musashi_device::drc_can_execute() const
+{
+	// an odd PC raises an address error on the next fetch
+	if (m_stopped || m_address_error || BIT(m_pc, 0))
+		return false;
+
+	return !m_t1_flag && !m_t0_flag && !m_instruction_restart && !m_pmmu_enabled && !m_hmmu_enabled && !m_emmu_enabled && !CPU_TYPE_IS_COLDFIRE();
+}
+
+
+/*-------------------------------------------------
+    drc_code_backed - return true if an opcode
+    address is backed by RAM or ROM
+-------------------------------------------------*/
+
+bool m68000_musashi_device::drc_code_backed(offs_t pc) const
+{
+	return m_oprogram->get_read_ptr(pc & ~3) != nullptr;
+}
+
+
+/*-------------------------------------------------
+    drc_load_state - copy the interpreter state
+    into the recompiler's shadow state
+-------------------------------------------------*/
+
+void m68000_musashi_device::drc_load_state()
+{
+	std::copy(std::begin(m_dar), std::end(m_dar), std::begin(m_drc->dar));
+	m_drc->x_flag = m_x_flag;
+	m_drc->n_flag = m_n_flag;
+	m_drc->not_z_flag = m_not_z_flag;
+	m_drc->v_flag = m_v_flag;
+	m_drc->c_flag = m_c_flag;
+	m_drc->pc = m_pc;
+	m_drc->icount = m_icount;
+	m_drc->mode = m_s_flag ? 1 : 0;
+	m_drc->exitcode = 0;
+}
+
+
+/*-------------------------------------------------
+    drc_store_state - copy the shadow state back
+    to the interpreter
+-------------------------------------------------*/
+
+void m68000_musashi_device::drc_store_state()
+{
+	std::copy(std::begin(m_drc->dar), std::end(m_drc->dar), std::begin(m_dar));
+	m_x_flag = m_drc->x_flag;
+	m_n_flag = m_drc->n_flag;
+	m_not_z_flag = m_drc->not_z_flag;
+	m_v_flag = m_drc->v_flag;
+	m_c_flag = m_drc->c_flag;
+	m_pc = m_drc->pc;
+	m_icount = m_drc->icount;
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - run compiled code until
+    out of cycles or until the state is one only
+    the interpreter handles
+-------------------------------------------------*/
+
+void m68000_musashi_device::execute_run_drc()
+{
+	while (m_icount > 0 && drc_can_execute())
+	{
+		/* reset the cache if dirty */
+		if (m_cache_dirty)
+			code_flush_cache();
+
+		/* run as much as we can */
+		drc_load_state();
+		int execute_result = m_drcuml->execute(*m_entry);
+		drc_store_state();
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+			code_compile_block(m_drc->mode, m_pc);
+		else if (execute_result == EXECUTE_RESET_CACHE)
+			m_cache_dirty = true;
+	}
+	m_ppc = m_pc;
+}
+
+
+/***************************************************************************
+    C FUNCTION CALLBACKS
+***************************************************************************/
+
+void m68000_musashi_device::ccfunc_execute_one()
+{
+	const u32 mode = m_drc->mode;
+
+	drc_store_state();
+	m_ppc = m_pc;
+	try
+	{
+		m_run_mode = RUN_MODE_NORMAL;
+		m_ir = m68ki_read_imm_16();
+		(this->*m68k_handler_table[m_state_table[m_ir]])();
+		m_icount -= m_cyc_instruction[m_ir];
+	}
+	catch (int error)
+	{
+		/* exceptions can't unwind through generated code; the main loop takes the address error */
+		if (error != 10)
+			throw;
+		m_address_error = 1;
+	}
+	drc_load_state();
+
+	/* bail out if the instruction left us somewhere the cache can't follow */
+	if (!drc_can_execute())
+		m_drc->exitcode = EXECUTE_INTERPRET;
+	else if (m_cache_dirty)
+		m_drc->exitcode = EXECUTE_RESET_CACHE;
+
+	/* anything but falling through to the next instruction needs a redispatch */
+	m_drc->arg1 = m_drc->exitcode != 0 || m_drc->pc != m_drc->arg0 || m_drc->mode != mode;
+}
+
+static void cfunc_execute_one(void *param)
+{
+	((m68000_musashi_device *)param)->ccfunc_execute_one();
+}
+
+
+/***************************************************************************
+    CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void m68000_musashi_device::code_flush_cache()
+{
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_redispatch();
+	}
+
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate static 68k code\n");
+	}
+
+	m_cache_dirty = false;
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void m68000_musashi_device::code_compile_block(u32 mode, offs_t pc)
+{
+	compiler_state compiler = { 0, mode, 1 };
+	const opcode_desc *seqhead, *seqlast;
+	bool override = false;
+
+	auto profile = g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+
+	/* if we get an error back, flush the cache and try again */
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			drcuml_block &block(m_drcuml->begin_block(16384));
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				u32 nextpc;
+
+				/* add a code log entry */
+				if (m_drcuml->logging())
+					block.append_comment("-------------------------");                     // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !m_drcuml->hash_exists(mode, seqhead->pc))
+				{
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					generate_sequence_instruction(block, compiler, curdesc);
+				}
+
+				/* a native unconditional branch has already left the sequence */
+				if ((seqlast->flags & OPFLAG_IS_UNCONDITIONAL_BRANCH) && !(seqlast->flags & OPFLAG_INVALID_OPCODE))
+					continue;
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, compiler, nextpc, true);                     // <subtract cycles>
+
+				/* if the next sequence doesn't follow on directly, jump through the hash table */
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+				{
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+				}
+			}
+
+			/* end the sequence */
+			block.end();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void m68000_musashi_device::static_generate_entry_point()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	/* forward references */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+
+	alloc_handle(*m_drcuml, m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current mode and PC */
+	UML_HASHJMP(block, mem(&m_drc->mode), mem(&m_drc->pc), *m_nocode);              // hashjmp <mode>,<pc>,nocode
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void m68000_musashi_device::static_generate_nocode_handler()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_drc->pc), I0);                                            // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void m68000_musashi_device::static_generate_out_of_cycles()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(*m_drcuml, m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_drc->pc), I0);                                            // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_redispatch - generate the
+    handler taken when an interpreted instruction
+    didn't fall through to the next one
+-------------------------------------------------*/
+
+void m68000_musashi_device::static_generate_redispatch()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	/* forward references */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+
+	alloc_handle(*m_drcuml, m_redispatch, "redispatch");
+	UML_HANDLE(block, *m_redispatch);                                               // handle  redispatch
+
+	/* leave if the helper asked us to, or if it ran us out of cycles */
+	UML_MOV(block, I0, mem(&m_drc->exitcode));                                      // mov     i0,[exitcode]
+	UML_TEST(block, I0, ~0);                                                        // test    i0,~0
+	UML_EXITc(block, COND_NZ, I0);                                                  // exit    i0,nz
+	UML_CMP(block, mem(&m_drc->icount), 0);                                         // cmp     [icount],0
+	UML_EXITc(block, uml::COND_LE, EXECUTE_OUT_OF_CYCLES);                          // exit    EXECUTE_OUT_OF_CYCLES,le
+
+	/* otherwise carry on wherever the instruction took us */
+	UML_HASHJMP(block, mem(&m_drc->mode), mem(&m_drc->pc), *m_nocode);              // hashjmp <mode>,<pc>,nocode
+
+	block.end();
+}
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception)
+{
+	/* account for cycles */
+	if (compiler.cycles > 0)
+	{
+		UML_SUB(block, mem(&m_drc->icount), mem(&m_drc->icount), MAPVAR_CYCLES);    // sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+	}
+
+	/* interpreted instructions count their own cycles, so always check */
+	else if (allow_exception)
+		UML_CMP(block, mem(&m_drc->icount), 0);                                     // cmp     icount,0
+
+	if (allow_exception)
+		UML_EXHc(block, uml::COND_LE, *m_out_of_cycles, param);                     // exh     out_of_cycles,nextpc,le
+	compiler.cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging())
+		block.append_comment("%08X: %d bytes", desc->pc, desc->length);            // comment
+
+	/* set the PC map variable */
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                         // mapvar  PC,desc->pc
+
+	/* lower what we can, and interpret the rest */
+	if ((desc->flags & OPFLAG_INVALID_OPCODE) || !generate_opcode(block, compiler, desc))
+		generate_interpret(block, compiler, desc);
+}
+
+
+/*-------------------------------------------------
+    generate_native - generate the preamble for a
+    natively compiled instruction: verify the
+    code words and account for its cycles
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_native(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cycles)
+{
+	/* compare each dword the instruction was decoded from */
+	const u32 *last = nullptr;
+	for (int offset = 0; offset < desc->length; offset += 2)
+	{
+		u32 *const base = (u32 *)m_oprogram->get_read_ptr((desc->pc + offset) & ~3);
+		if (!base)
+			fatalerror("m68k: code at %08X vanished during compilation\n", desc->pc + offset);
+		if (base == last)
+			continue;
+		last = base;
+
+		UML_LOAD(block, I0, base, 0, SIZE_DWORD, SCALE_x4);                         // load    i0,base,0,dword
+		UML_CMP(block, I0, *base);                                                  // cmp     i0,*base
+		UML_EXHc(block, uml::COND_NE, *m_nocode, desc->pc);                         // exne    nocode,desc->pc
+	}
+
+	/* accumulate total cycles, unless the instruction does it itself */
+	if (cycles >= 0)
+	{
+		compiler.cycles += cycles;
+		UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                         // mapvar  CYCLES,compiler.cycles
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_interpret - generate a call to the
+    interpreter for a single instruction
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_interpret(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	/* the interpreter needs an up to date cycle count */
+	generate_update_cycles(block, compiler, desc->pc, false);                      // <subtract cycles>
+
+	UML_MOV(block, mem(&m_drc->pc), desc->pc);                                      // mov     [pc],desc->pc
+	UML_MOV(block, mem(&m_drc->arg0), desc->pc + desc->length);                     // mov     [arg0],desc->pc + desc->length
+	UML_CALLC(block, cfunc_execute_one, this);                                      // callc   cfunc_execute_one,this
+	UML_TEST(block, mem(&m_drc->arg1), ~0);                                         // test    [arg1],~0
+	UML_EXHc(block, COND_NZ, *m_redispatch, 0);                                     // exh     redispatch,0,nz
+}
+
+
+/*-------------------------------------------------
+    generate_logic_flags - set the flags for a
+    move or logical operation from the result in
+    I2, leaving X alone
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_logic_flags(drcuml_block &block)
+{
+	UML_SHR(block, mem(&m_drc->n_flag), I2, 24);                                    // shr     [n_flag],i2,24
+	UML_MOV(block, mem(&m_drc->not_z_flag), I2);                                    // mov     [not_z_flag],i2
+	UML_MOV(block, mem(&m_drc->v_flag), 0);                                         // mov     [v_flag],0
+	UML_MOV(block, mem(&m_drc->c_flag), 0);                                         // mov     [c_flag],0
+}
+
+
+/*-------------------------------------------------
+    generate_arith_flags - set the flags for a
+    32-bit addition or subtraction of source I0
+    and destination I1 giving I2
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_arith_flags(drcuml_block &block, bool sub, bool extend)
+{
+	/* VFLAG_ADD_32/CFLAG_ADD_32 and their SUB forms differ only in which operands are swapped */
+	const uml::parameter y = sub ? I2 : I1;
+	const uml::parameter z = sub ? I1 : I2;
+
+	UML_SHR(block, mem(&m_drc->n_flag), I2, 24);                                    // shr     [n_flag],i2,24
+	UML_MOV(block, mem(&m_drc->not_z_flag), I2);                                    // mov     [not_z_flag],i2
+
+	UML_XOR(block, I3, I0, z);                                                      // xor     i3,i0,z
+	UML_XOR(block, I4, y, z);                                                       // xor     i4,y,z
+	UML_AND(block, I3, I3, I4);                                                     // and     i3,i3,i4
+	UML_SHR(block, mem(&m_drc->v_flag), I3, 24);                                    // shr     [v_flag],i3,24
+
+	UML_OR(block, I3, I0, y);                                                       // or      i3,i0,y
+	UML_XOR(block, I4, z, ~0);                                                      // xor     i4,z,~0
+	UML_AND(block, I3, I3, I4);                                                     // and     i3,i3,i4
+	UML_AND(block, I4, I0, y);                                                      // and     i4,i0,y
+	UML_OR(block, I3, I3, I4);                                                      // or      i3,i3,i4
+	UML_SHR(block, I3, I3, 23);                                                     // shr     i3,i3,23
+	UML_MOV(block, mem(&m_drc->c_flag), I3);                                        // mov     [c_flag],i3
+	if (extend)
+		UML_MOV(block, mem(&m_drc->x_flag), I3);                                    // mov     [x_flag],i3
+}
+
+
+/*-------------------------------------------------
+    generate_condition - evaluate one of the
+    conditions HI to LE, returning the UML
+    condition under which it holds
+-------------------------------------------------*/
+
+uml::condition_t m68000_musashi_device::generate_condition(drcuml_block &block, int cond)
+{
+	/* evaluate the odd condition of each pair (LS, CS, EQ, VS, MI, LT, LE) into I0 */
+	switch (cond >> 1)
+	{
+		case 1:
+			UML_AND(block, I0, mem(&m_drc->c_flag), CFLAG_SET);                     // and     i0,[c_flag],CFLAG_SET
+			UML_CMP(block, mem(&m_drc->not_z_flag), 0);                             // cmp     [not_z_flag],0
+			UML_SETc(block, COND_Z, I1);                                            // set     i1,z
+			UML_OR(block, I0, I0, I1);                                              // or      i0,i0,i1
+			break;
+
+		case 2:
+			UML_AND(block, I0, mem(&m_drc->c_flag), CFLAG_SET);                     // and     i0,[c_flag],CFLAG_SET
+			break;
+
+		case 3:
+			UML_CMP(block, mem(&m_drc->not_z_flag), 0);                             // cmp     [not_z_flag],0
+			UML_SETc(block, COND_Z, I0);                                            // set     i0,z
+			break;
+
+		case 4:
+			UML_AND(block, I0, mem(&m_drc->v_flag), VFLAG_SET);                     // and     i0,[v_flag],VFLAG_SET
+			break;
+
+		case 5:
+			UML_AND(block, I0, mem(&m_drc->n_flag), NFLAG_SET);                     // and     i0,[n_flag],NFLAG_SET
+			break;
+
+		case 6:
+			UML_XOR(block, I0, mem(&m_drc->n_flag), mem(&m_drc->v_flag));           // xor     i0,[n_flag],[v_flag]
+			UML_AND(block, I0, I0, NFLAG_SET);                                      // and     i0,i0,NFLAG_SET
+			break;
+
+		case 7:
+			UML_XOR(block, I0, mem(&m_drc->n_flag), mem(&m_drc->v_flag));           // xor     i0,[n_flag],[v_flag]
+			UML_AND(block, I0, I0, NFLAG_SET);                                      // and     i0,i0,NFLAG_SET
+			UML_CMP(block, mem(&m_drc->not_z_flag), 0);                             // cmp     [not_z_flag],0
+			UML_SETc(block, COND_Z, I1);                                            // set     i1,z
+			UML_OR(block, I0, I0, I1);                                              // or      i0,i0,i1
+			break;
+	}
+	UML_TEST(block, I0, ~0);                                                        // test    i0,~0
+
+	/* even conditions are the inverse of the odd ones */
+	return (cond & 1) ? COND_NZ : COND_Z;
+}
+
+
+/*-------------------------------------------------
+    generate_bcc - generate BRA or Bcc with an
+    8- or 16-bit displacement
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_bcc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cond, int notake_cycles)
+{
+	const int cycles = m_cyc_instruction[desc->opptr.w[0]];
+
+	generate_native(block, compiler, desc, -1);
+	if (cond == 0)
+	{
+		compiler.cycles += cycles;
+		UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                         // mapvar  CYCLES,compiler.cycles
+		generate_branch(block, compiler, desc);
+		return;
+	}
+
+	const uml::code_label skip = compiler.labelnum++;
+	UML_JMPc(block, generate_condition(block, cond ^ 1), skip);                     // jmp     skip,<not taken>
+
+	/* the taken path accounts for its own cycles */
+	compiler_state compiler_temp(compiler);
+	compiler_temp.cycles += cycles;
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler_temp.cycles);                        // mapvar  CYCLES,compiler_temp.cycles
+	generate_branch(block, compiler_temp, desc);
+
+	UML_LABEL(block, skip);                                                         // skip:
+	compiler.labelnum = compiler_temp.labelnum;
+	compiler.cycles += cycles + notake_cycles;
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                             // mapvar  CYCLES,compiler.cycles
+}
+
+
+/*-------------------------------------------------
+    generate_dbcc - generate DBcc
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_dbcc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cond)
+{
+	const int cycles = m_cyc_instruction[desc->opptr.w[0]];
+	const int reg = desc->opptr.w[0] & 7;
+	const uml::code_label done = compiler.labelnum++;
+	const uml::code_label expired = compiler.labelnum++;
+
+	generate_native(block, compiler, desc, -1);
+
+	/* the loop ends without touching the counter if the condition holds */
+	if (cond != 1)
+		UML_JMPc(block, generate_condition(block, cond), done);                     // jmp     done,<cond>
+
+	/* otherwise count down the low word of the register */
+	UML_SUB(block, I0, DREG(reg), 1);                                               // sub     i0,<reg>,1
+	UML_AND(block, I0, I0, 0xffff);                                                 // and     i0,i0,0xffff
+	UML_AND(block, I1, DREG(reg), 0xffff0000);                                      // and     i1,<reg>,0xffff0000
+	UML_OR(block, DREG(reg), I1, I0);                                               // or      <reg>,i1,i0
+	UML_CMP(block, I0, 0xffff);                                                     // cmp     i0,0xffff
+	UML_JMPc(block, COND_E, expired);                                               // jmp     expired,e
+
+	/* the taken path accounts for its own cycles */
+	compiler_state compiler_temp(compiler);
+	compiler_temp.cycles += cycles + s32(m_cyc_dbcc_f_noexp);
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler_temp.cycles);                        // mapvar  CYCLES,compiler_temp.cycles
+	generate_branch(block, compiler_temp, desc);
+
+	/* an expired counter costs extra over the condition holding */
+	UML_LABEL(block, expired);                                                      // expired:
+	compiler.labelnum = compiler_temp.labelnum;
+	if (m_cyc_dbcc_f_exp != 0)
+		UML_SUB(block, mem(&m_drc->icount), mem(&m_drc->icount), m_cyc_dbcc_f_exp);    // sub     [icount],[icount],dbcc_f_exp
+
+	UML_LABEL(block, done);                                                         // done:
+	compiler.cycles += cycles;
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                             // mapvar  CYCLES,compiler.cycles
+}
+
+
+/*-------------------------------------------------
+    generate_branch - generate a jump to a fixed
+    branch target
+-------------------------------------------------*/
+
+void m68000_musashi_device::generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	generate_update_cycles(block, compiler, desc->targetpc, true);                 // <subtract cycles>
+	if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+		UML_JMP(block, desc->targetpc | 0x80000000);                                // jmp     desc->targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, compiler.mode, desc->targetpc, *m_nocode);               // hashjmp <mode>,desc->targetpc,nocode
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode, returning false to fall back to the
+    interpreter
+-------------------------------------------------*/
+
+bool m68000_musashi_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	using m = m68000_musashi_device;
+
+	static const opcode_handler_ptr bcc_b[16] = {
+			&m::x6000_bra_b_071234fc, nullptr,                  &m::x6200_bhi_b_071234fc, &m::x6300_bls_b_071234fc,
+			&m::x6400_bcc_b_071234fc, &m::x6500_bcs_b_071234fc, &m::x6600_bne_b_071234fc, &m::x6700_beq_b_071234fc,
+			&m::x6800_bvc_b_071234fc, &m::x6900_bvs_b_071234fc, &m::x6a00_bpl_b_071234fc, &m::x6b00_bmi_b_071234fc,
+			&m::x6c00_bge_b_071234fc, &m::x6d00_blt_b_071234fc, &m::x6e00_bgt_b_071234fc, &m::x6f00_ble_b_071234fc };
+	static const opcode_handler_ptr bcc_w[16] = {
+			&m::x6000_bra_w_071234fc, nullptr,                  &m::x6200_bhi_w_071234fc, &m::x6300_bls_w_071234fc,
+			&m::x6400_bcc_w_071234fc, &m::x6500_bcs_w_071234fc, &m::x6600_bne_w_071234fc, &m::x6700_beq_w_071234fc,
+			&m::x6800_bvc_w_071234fc, &m::x6900_bvs_w_071234fc, &m::x6a00_bpl_w_071234fc, &m::x6b00_bmi_w_071234fc,
+			&m::x6c00_bge_w_071234fc, &m::x6d00_blt_w_071234fc, &m::x6e00_bgt_w_071234fc, &m::x6f00_ble_w_071234fc };
+	static const opcode_handler_ptr dbcc[16] = {
+			&m::x50c8_dbt_w_071234fc, &m::x51c8_dbf_w_071234fc, &m::x52c8_dbhi_w_071234fc, &m::x53c8_dbls_w_071234fc,
+			&m::x54c8_dbcc_w_071234fc, &m::x55c8_dbcs_w_071234fc, &m::x56c8_dbne_w_071234fc, &m::x57c8_dbeq_w_071234fc,
+			&m::x58c8_dbvc_w_071234fc, &m::x59c8_dbvs_w_071234fc, &m::x5ac8_dbpl_w_071234fc, &m::x5bc8_dbmi_w_071234fc,
+			&m::x5cc8_dbge_w_071234fc, &m::x5dc8_dblt_w_071234fc, &m::x5ec8_dbgt_w_071234fc, &m::x5fc8_dble_w_071234fc };
+
+	const u16 op = desc->opptr.w[0];
+	const int rx = (op >> 9) & 7;
+	const int ry = op & 7;
+	const int cond = (op >> 8) & 0xf;
+	const int cycles = m_cyc_instruction[op];
+
+	/* only lower opcodes this CPU type decodes to the handler being replicated */
+	const opcode_handler_ptr handler = m68k_handler_table[m_state_table[op]];
+
+	/* relative branches are only lowered when the front-end worked out their target */
+	if (handler == bcc_b[cond] || handler == bcc_w[cond])
+	{
+		if (!(desc->flags & OPFLAG_IS_BRANCH))
+			return false;
+		generate_bcc(block, compiler, desc, cond, s32((handler == bcc_b[cond]) ? m_cyc_bcc_notake_b : m_cyc_bcc_notake_w));
+		return true;
+	}
+	if (handler == dbcc[cond])
+	{
+		if (cond == 0)
+		{
+			generate_native(block, compiler, desc, cycles);
+			return true;
+		}
+		if (!(desc->flags & OPFLAG_IS_BRANCH))
+			return false;
+		generate_dbcc(block, compiler, desc, cond);
+		return true;
+	}
+
+	if (handler == &m::x7000_moveq_l_071234fc)                      // MOVEQ #imm,Dx
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, I2, u32(s32(s8(op & 0xff))));                                // mov     i2,imm
+		UML_MOV(block, DREG(rx), I2);                                               // mov     <dx>,i2
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::x2000_move_l_071234fc || handler == &m::x2008_move_l_071234fc)  // MOVE.L Dy/Ay,Dx
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, I2, mem(&m_drc->dar[op & 0xf]));                             // mov     i2,<ry>
+		UML_MOV(block, DREG(rx), I2);                                               // mov     <dx>,i2
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::x2040_movea_l_071234fc || handler == &m::x2048_movea_l_071234fc)    // MOVEA.L Dy/Ay,Ax
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, AREG(rx), mem(&m_drc->dar[op & 0xf]));                      // mov     <ax>,<ry>
+		return true;
+	}
+	if (handler == &m::xd080_add_l_071234fc || handler == &m::xd088_add_l_071234fc ||    // ADD.L Dy/Ay,Dx
+		handler == &m::x9080_sub_l_071234fc || handler == &m::x9088_sub_l_071234fc ||    // SUB.L Dy/Ay,Dx
+		handler == &m::xb080_cmp_l_071234fc || handler == &m::xb088_cmp_l_071234fc)      // CMP.L Dy/Ay,Dx
+	{
+		const bool add = (op >> 12) == 0xd;
+		const bool cmp = (op >> 12) == 0xb;
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, I0, mem(&m_drc->dar[op & 0xf]));                             // mov     i0,<ry>
+		UML_MOV(block, I1, DREG(rx));                                               // mov     i1,<dx>
+		if (add)
+			UML_ADD(block, I2, I1, I0);                                             // add     i2,i1,i0
+		else
+			UML_SUB(block, I2, I1, I0);                                             // sub     i2,i1,i0
+		generate_arith_flags(block, !add, !cmp);
+		if (!cmp)
+			UML_MOV(block, DREG(rx), I2);                                           // mov     <dx>,i2
+		return true;
+	}
+	if (handler == &m::x5080_addq_l_071234fc || handler == &m::x5180_subq_l_071234fc)    // ADDQ/SUBQ.L #q,Dy
+	{
+		const bool add = !BIT(op, 8);
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, I0, ((rx - 1) & 7) + 1);                                     // mov     i0,q
+		UML_MOV(block, I1, DREG(ry));                                               // mov     i1,<dy>
+		if (add)
+			UML_ADD(block, I2, I1, I0);                                             // add     i2,i1,i0
+		else
+			UML_SUB(block, I2, I1, I0);                                             // sub     i2,i1,i0
+		generate_arith_flags(block, !add, true);
+		UML_MOV(block, DREG(ry), I2);                                               // mov     <dy>,i2
+		return true;
+	}
+	if (handler == &m::x5088_addq_l_071234fc || handler == &m::x5188_subq_l_071234fc)    // ADDQ/SUBQ.L #q,Ay
+	{
+		generate_native(block, compiler, desc, cycles);
+		if (!BIT(op, 8))
+			UML_ADD(block, AREG(ry), AREG(ry), ((rx - 1) & 7) + 1);                 // add     <ay>,<ay>,q
+		else
+			UML_SUB(block, AREG(ry), AREG(ry), ((rx - 1) & 7) + 1);                 // sub     <ay>,<ay>,q
+		return true;
+	}
+	if (handler == &m::xc080_and_l_071234fc || handler == &m::x8080_or_l_071234fc)      // AND/OR.L Dy,Dx
+	{
+		generate_native(block, compiler, desc, cycles);
+		if ((op >> 12) == 0xc)
+			UML_AND(block, I2, DREG(rx), DREG(ry));                                 // and     i2,<dx>,<dy>
+		else
+			UML_OR(block, I2, DREG(rx), DREG(ry));                                  // or      i2,<dx>,<dy>
+		UML_MOV(block, DREG(rx), I2);                                               // mov     <dx>,i2
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::xb180_eor_l_071234fc)                        // EOR.L Dx,Dy
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_XOR(block, I2, DREG(ry), DREG(rx));                                     // xor     i2,<dy>,<dx>
+		UML_MOV(block, DREG(ry), I2);                                               // mov     <dy>,i2
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::x4a80_tst_l_071234fc)                        // TST.L Dy
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, I2, DREG(ry));                                               // mov     i2,<dy>
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::x4280_clr_l_071234fc)                        // CLR.L Dy
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, I2, 0);                                                      // mov     i2,0
+		UML_MOV(block, DREG(ry), I2);                                               // mov     <dy>,i2
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::x4680_not_l_071234fc)                        // NOT.L Dy
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_XOR(block, I2, DREG(ry), ~0);                                           // xor     i2,<dy>,~0
+		UML_MOV(block, DREG(ry), I2);                                               // mov     <dy>,i2
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::x4840_swap_l_071234fc)                       // SWAP Dy
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_ROL(block, I2, DREG(ry), 16);                                           // rol     i2,<dy>,16
+		UML_MOV(block, DREG(ry), I2);                                               // mov     <dy>,i2
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::x4880_ext_w_071234fc)                        // EXT.W Dy
+	{
+		/* N comes from the whole register shifted as a word, so it isn't a plain logic flag */
+		generate_native(block, compiler, desc, cycles);
+		UML_SEXT(block, I0, DREG(ry), SIZE_BYTE);                                   // sext    i0,<dy>,byte
+		UML_AND(block, I0, I0, 0xffff);                                             // and     i0,i0,0xffff
+		UML_AND(block, I1, DREG(ry), 0xffff0000);                                   // and     i1,<dy>,0xffff0000
+		UML_OR(block, I2, I1, I0);                                                  // or      i2,i1,i0
+		UML_MOV(block, DREG(ry), I2);                                               // mov     <dy>,i2
+		UML_SHR(block, mem(&m_drc->n_flag), I2, 8);                                 // shr     [n_flag],i2,8
+		UML_MOV(block, mem(&m_drc->not_z_flag), I0);                                // mov     [not_z_flag],i0
+		UML_MOV(block, mem(&m_drc->v_flag), 0);                                     // mov     [v_flag],0
+		UML_MOV(block, mem(&m_drc->c_flag), 0);                                     // mov     [c_flag],0
+		return true;
+	}
+	if (handler == &m::x48c0_ext_l_071234fc)                        // EXT.L Dy
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_SEXT(block, I2, DREG(ry), SIZE_WORD);                                   // sext    i2,<dy>,word
+		UML_MOV(block, DREG(ry), I2);                                               // mov     <dy>,i2
+		generate_logic_flags(block);
+		return true;
+	}
+	if (handler == &m::xc140_exg_l_071234fc || handler == &m::xc148_exg_l_071234fc || handler == &m::xc188_exg_l_071234fc)  // EXG
+	{
+		const int regx = rx + ((op & 0x00f8) == 0x0048 ? 8 : 0);
+		const int regy = ry + ((op & 0x00f8) != 0x0040 ? 8 : 0);
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, I0, mem(&m_drc->dar[regx]));                                 // mov     i0,<rx>
+		UML_MOV(block, mem(&m_drc->dar[regx]), mem(&m_drc->dar[regy]));             // mov     <rx>,<ry>
+		UML_MOV(block, mem(&m_drc->dar[regy]), I0);                                 // mov     <ry>,i0
+		return true;
+	}
+	if (handler == &m::x41d0_lea_l_ai_071234fc)                     // LEA (Ay),Ax
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, AREG(rx), AREG(ry));                                         // mov     <ax>,<ay>
+		return true;
+	}
+	if (handler == &m::x41e8_lea_l_di_071234fc)                     // LEA (d16,Ay),Ax
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_ADD(block, AREG(rx), AREG(ry), u32(s32(s16(desc->opptr.w[1]))));       // add     <ax>,<ay>,d16
+		return true;
+	}
+	if (handler == &m::x41f8_lea_l_aw_071234fc)                     // LEA (xxx).W,Ax
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, AREG(rx), u32(s32(s16(desc->opptr.w[1]))));                  // mov     <ax>,abs16
+		return true;
+	}
+	if (handler == &m::x41f9_lea_l_al_071234fc)                     // LEA (xxx).L,Ax
+	{
+		generate_native(block, compiler, desc, cycles);
+		UML_MOV(block, AREG(rx), (u32(desc->opptr.w[1]) << 16) | desc->opptr.w[2]); // mov     <ax>,abs32
+		return true;
+	}
+	if (handler == &m::x4e71_nop_071234fc)                          // NOP
+	{
+		generate_native(block, compiler, desc, cycles);
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,405 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    m68kfe.cpp
+
+    Front-end for the Musashi 680x0 recompiler
+
+    As with the i386 front-end, this only needs to know how long each
+    instruction is and where control flow may leave the straight-line
+    path.  Instructions the back-end doesn't lower to UML are handed to
+    the interpreter, which decodes them again, so a mis-sized instruction
+    costs a redispatch rather than correctness.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "m68kfe.h"
+
+
+//**************************************************************************
+//  68K FRONTEND
+//**************************************************************************
+
+//-------------------------------------------------
+//  m68k_frontend - constructor
+//-------------------------------------------------
+
+m68k_frontend::m68k_frontend(m68000_musashi_device &cpu, u32 window_start, u32 window_end, u32 max_sequence)
+	: drc_frontend(cpu, window_start, window_end, max_sequence)
+	, m_cpu(cpu)
+{
+}
+
+
+//-------------------------------------------------
+//  fetch - fetch the next word of an instruction,
+//  returning false if it isn't in RAM or ROM
+//-------------------------------------------------
+
+bool m68k_frontend::fetch(opcode_desc &desc, u16 &value)
+{
+	// architecturally no instruction is longer than 11 words
+	if (desc.length >= 22)
+		return false;
+
+	const offs_t pc = desc.pc + desc.length;
+	if (!m_cpu.drc_code_backed(pc))
+		return false;
+
+	// only the first few words are kept; the back-end never needs more
+	value = m_cpu.m_oprogram->read_word(pc);
+	if (desc.length < sizeof(desc.opptr.w))
+		desc.opptr.w[desc.length / 2] = value;
+	desc.length += 2;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  skip_words - consume extension words
+//-------------------------------------------------
+
+bool m68k_frontend::skip_words(opcode_desc &desc, int count)
+{
+	u16 dummy;
+	while (count-- > 0)
+		if (!fetch(desc, dummy))
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  skip_index - consume a brief or full format
+//  index extension
+//-------------------------------------------------
+
+bool m68k_frontend::skip_index(opcode_desc &desc)
+{
+	u16 ext;
+	if (!fetch(desc, ext))
+		return false;
+
+	// the 68010 ignores the full format bit
+	if (!BIT(ext, 8) || !m_cpu.CPU_TYPE_IS_EC020_PLUS())
+		return true;
+
+	// base and outer displacements are null, word or long
+	const int bd = (ext >> 4) & 3;
+	const int od = ext & 3;
+	return skip_words(desc, (bd >= 2) ? (bd - 1) : 0) && skip_words(desc, (od >= 2) ? (od - 1) : 0);
+}
+
+
+//-------------------------------------------------
+//  skip_ea - consume the extension words for an
+//  effective address
+//-------------------------------------------------
+
+bool m68k_frontend::skip_ea(opcode_desc &desc, int mode, int reg, int size)
+{
+	switch (mode)
+	{
+		case 0: case 1: case 2: case 3: case 4:
+			return true;
+
+		case 5:                                         // (d16,An)
+			return skip_words(desc, 1);
+
+		case 6:                                         // (d8,An,Xn)
+			return skip_index(desc);
+
+		case 7:
+			switch (reg)
+			{
+				case 0: case 2:                         // (xxx).W, (d16,PC)
+					return skip_words(desc, 1);
+
+				case 1:                                 // (xxx).L
+					return skip_words(desc, 2);
+
+				case 3:                                 // (d8,PC,Xn)
+					return skip_index(desc);
+
+				case 4:                                 // #imm
+					return skip_words(desc, (size == SIZE_L) ? 2 : 1);
+			}
+			break;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  describe_branch - fill in a relative branch
+//-------------------------------------------------
+
+void m68k_frontend::describe_branch(opcode_desc &desc, s32 disp, bool conditional)
+{
+	const offs_t target = desc.pc + 2 + disp;
+
+	// odd targets raise an address error, and taking a backward branch has to reach the idle loop detector
+	if (BIT(target, 0) || (target <= desc.pc && m_cpu.idle_detector()))
+	{
+		if (!conditional)
+			desc.flags |= OPFLAG_END_SEQUENCE;
+		return;
+	}
+
+	// only branches marked here are handled natively
+	desc.targetpc = target;
+	if (conditional)
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+	else
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool m68k_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	u16 op;
+	bool result = !BIT(desc.pc, 0) && fetch(desc, op);
+	if (result)
+	{
+		const int mode = (op >> 3) & 7;
+		const int reg = op & 7;
+		const int size = (op >> 6) & 3;
+
+		switch (op >> 12)
+		{
+			case 0x0:
+				if (BIT(op, 8))
+				{
+					// MOVEP, or a bit operation with the bit number in a register
+					result = (mode == 1) ? skip_words(desc, 1) : skip_ea(desc, mode, reg, SIZE_B);
+				}
+				else if (((op >> 9) & 7) == 4)
+				{
+					// bit operation with an immediate bit number
+					result = skip_words(desc, 1) && skip_ea(desc, mode, reg, SIZE_B);
+				}
+				else if (size == 3 || ((op >> 9) & 7) == 7)
+				{
+					// CMP2/CHK2, CALLM/RTM, CAS and MOVES are left to the interpreter
+					result = false;
+				}
+				else if (mode == 7 && reg == 4)
+				{
+					// ORI/ANDI/EORI to CCR or SR only have the immediate word
+					result = skip_words(desc, 1);
+				}
+				else
+					result = skip_words(desc, (size == SIZE_L) ? 2 : 1) && skip_ea(desc, mode, reg, size);
+				break;
+
+			case 0x1: case 0x2: case 0x3:                   // MOVE, MOVEA
+			{
+				static const int move_size[4] = { SIZE_B, SIZE_B, SIZE_L, SIZE_W };
+				result = skip_ea(desc, mode, reg, move_size[op >> 12]) && skip_ea(desc, (op >> 6) & 7, (op >> 9) & 7, move_size[op >> 12]);
+				break;
+			}
+
+			case 0x4:
+				result = describe_misc(desc, op);
+				break;
+
+			case 0x5:
+				if (size != 3)                              // ADDQ, SUBQ
+					result = skip_ea(desc, mode, reg, size);
+				else if (mode == 1)                         // DBcc
+				{
+					result = skip_words(desc, 1);
+					if (result && ((op >> 8) & 0xf) != 0)
+						describe_branch(desc, s16(desc.opptr.w[1]), true);
+				}
+				else if (mode == 7 && reg >= 2 && reg <= 4) // TRAPcc
+					result = skip_words(desc, (reg == 4) ? 0 : (reg - 1));
+				else                                        // Scc
+					result = skip_ea(desc, mode, reg, SIZE_B);
+				break;
+
+			case 0x6:                                       // BRA, BSR, Bcc
+			{
+				const int cond = (op >> 8) & 0xf;
+				const u8 disp = op & 0xff;
+				if (disp == 0xff && m_cpu.CPU_TYPE_IS_EC020_PLUS())
+				{
+					result = skip_words(desc, 2);
+					if (cond < 2)
+						desc.flags |= OPFLAG_END_SEQUENCE;
+				}
+				else if (cond == 1)
+				{
+					result = skip_words(desc, disp ? 0 : 1);
+					desc.flags |= OPFLAG_END_SEQUENCE;
+				}
+				else
+				{
+					result = skip_words(desc, disp ? 0 : 1);
+					if (result)
+						describe_branch(desc, disp ? s32(s8(disp)) : s32(s16(desc.opptr.w[1])), cond != 0);
+				}
+				break;
+			}
+
+			case 0x7:                                       // MOVEQ
+				result = !BIT(op, 8);
+				break;
+
+			case 0x8:
+				if (size == 3)                              // DIVU, DIVS
+					result = skip_ea(desc, mode, reg, SIZE_W);
+				else if ((op & 0x01f0) == 0x0100)           // SBCD
+					result = true;
+				else if ((op & 0x01f0) == 0x0140 || (op & 0x01f0) == 0x0180)  // PACK, UNPK
+					result = skip_words(desc, 1);
+				else                                        // OR
+					result = skip_ea(desc, mode, reg, size);
+				break;
+
+			case 0x9: case 0xd:
+				if (size == 3)                              // SUBA, ADDA
+					result = skip_ea(desc, mode, reg, BIT(op, 8) ? SIZE_L : SIZE_W);
+				else if ((op & 0x0130) == 0x0100)           // SUBX, ADDX
+					result = true;
+				else                                        // SUB, ADD
+					result = skip_ea(desc, mode, reg, size);
+				break;
+
+			case 0xb:
+				if (size == 3)                              // CMPA
+					result = skip_ea(desc, mode, reg, BIT(op, 8) ? SIZE_L : SIZE_W);
+				else if (BIT(op, 8) && mode == 1)           // CMPM
+					result = true;
+				else                                        // EOR, CMP
+					result = skip_ea(desc, mode, reg, size);
+				break;
+
+			case 0xc:
+				if (size == 3)                              // MULU, MULS
+					result = skip_ea(desc, mode, reg, SIZE_W);
+				else if ((op & 0x01f0) == 0x0100 || (op & 0x01f8) == 0x0140 || (op & 0x01f8) == 0x0148 || (op & 0x01f8) == 0x0188)   // ABCD, EXG
+					result = true;
+				else                                        // AND
+					result = skip_ea(desc, mode, reg, size);
+				break;
+
+			case 0xe:
+				if (size != 3)                              // shifts and rotates of a register
+					result = true;
+				else if (BIT(op, 11))                       // bit field operations
+					result = skip_words(desc, 1) && skip_ea(desc, mode, reg, SIZE_L);
+				else                                        // shifts and rotates of memory
+					result = skip_ea(desc, mode, reg, SIZE_W);
+				break;
+
+			default:
+				// line A and line F trap, or are coprocessor instructions
+				result = false;
+				break;
+		}
+	}
+
+	if (!result)
+	{
+		// leave undecodable or unbacked code to the interpreter one instruction at a time
+		desc.length = 2;
+		desc.flags |= OPFLAG_END_SEQUENCE;
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  describe_misc - build a description of a line
+//  4 instruction
+//-------------------------------------------------
+
+bool m68k_frontend::describe_misc(opcode_desc &desc, u16 op)
+{
+	const int mode = (op >> 3) & 7;
+	const int reg = op & 7;
+	const int size = (op >> 6) & 3;
+
+	// LEA and CHK use the register field
+	if ((op & 0x01c0) == 0x01c0 && mode != 0)
+		return skip_ea(desc, mode, reg, SIZE_L);
+	if ((op & 0x0140) == 0x0100)
+		return skip_ea(desc, mode, reg, BIT(op, 7) ? SIZE_W : SIZE_L);
+
+	switch ((op >> 8) & 0xf)
+	{
+		case 0x0: case 0x2: case 0x4: case 0x6:
+			// NEGX, CLR, NEG, NOT, or a move to or from CCR or SR
+			return skip_ea(desc, mode, reg, (size == 3) ? SIZE_W : size);
+
+		case 0x8:
+			if (size == 0)                                  // LINK.L, NBCD
+				return (mode == 1) ? skip_words(desc, 2) : skip_ea(desc, mode, reg, SIZE_B);
+			if (size == 1)                                  // SWAP, BKPT, PEA
+				return (mode < 2) || skip_ea(desc, mode, reg, SIZE_L);
+			if (mode == 0)                                  // EXT
+				return true;
+			return skip_words(desc, 1) && skip_ea(desc, mode, reg, SIZE_W);    // MOVEM to memory
+
+		case 0x9:                                           // EXTB
+			return op == (0x49c0 | reg);
+
+		case 0xa:
+			if (op == 0x4afc)                               // ILLEGAL
+				return false;
+			return skip_ea(desc, mode, reg, (size == 3) ? SIZE_B : size);      // TST, TAS
+
+		case 0xc:
+			if (size < 2)                                   // MULL, DIVL
+				return skip_words(desc, 1) && skip_ea(desc, mode, reg, SIZE_L);
+			return skip_words(desc, 1) && skip_ea(desc, mode, reg, SIZE_W);    // MOVEM to registers
+
+		case 0xe:
+			if (size == 2 || size == 3)                     // JSR, JMP
+			{
+				desc.flags |= OPFLAG_END_SEQUENCE;
+				return skip_ea(desc, mode, reg, SIZE_L);
+			}
+			switch (op & 0x00f8)
+			{
+				case 0x40: case 0x48:                       // TRAP
+					desc.flags |= OPFLAG_END_SEQUENCE;
+					return true;
+
+				case 0x50:                                  // LINK.W
+					return skip_words(desc, 1);
+
+				case 0x58: case 0x60: case 0x68:            // UNLK, MOVE USP
+					return true;
+
+				case 0x70: case 0x78:
+					switch (op)
+					{
+						case 0x4e70: case 0x4e71: case 0x4e76:  // RESET, NOP, TRAPV
+							return true;
+
+						case 0x4e72: case 0x4e74:           // STOP, RTD
+							desc.flags |= OPFLAG_END_SEQUENCE;
+							return skip_words(desc, 1);
+
+						case 0x4e73: case 0x4e75: case 0x4e77:  // RTE, RTS, RTR
+							desc.flags |= OPFLAG_END_SEQUENCE;
+							return true;
+
+						case 0x4e7a: case 0x4e7b:           // MOVEC
+							return skip_words(desc, 1);
+					}
+					break;
+			}
+			break;
+	}
+	return false;
+}
@@ -0,0 +1,55 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    m68kfe.h
+
+    Front-end for the Musashi 680x0 recompiler
+
+***************************************************************************/
+#ifndef MAME_CPU_M68000_M68KFE_H
+#define MAME_CPU_M68000_M68KFE_H
+
+#pragma once
+
+#include "m68kmusashi.h"
+#include "cpu/drcfe.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class m68k_frontend : public drc_frontend
+{
+public:
+	// construction/destruction
+	m68k_frontend(m68000_musashi_device &cpu, u32 window_start, u32 window_end, u32 max_sequence);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	// operand sizes, as encoded in most instructions
+	enum
+	{
+		SIZE_B = 0,
+		SIZE_W,
+		SIZE_L
+	};
+
+	// internal helpers
+	bool fetch(opcode_desc &desc, u16 &value);
+	bool skip_words(opcode_desc &desc, int count);
+	bool skip_index(opcode_desc &desc);
+	bool skip_ea(opcode_desc &desc, int mode, int reg, int size);
+	bool describe_misc(opcode_desc &desc, u16 op);
+	void describe_branch(opcode_desc &desc, s32 disp, bool conditional);
+
+	// internal state
+	m68000_musashi_device &m_cpu;
+};
+
+
+#endif // MAME_CPU_M68000_M68KFE_H
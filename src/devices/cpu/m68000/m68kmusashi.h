@@ -7,6 +7,9 @@
 
 #include "m68kcommon.h"
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 // SoftFloat 2 lacks an include guard
 #ifndef softfloat2_h
 #define softfloat2_h 1
@@ -64,11 +67,16 @@ constexpr int M68K_HMMU_DISABLE   = 0;   /* no translation */
 constexpr int M68K_HMMU_ENABLE_II = 1;   /* Mac II style fixed translation */
 constexpr int M68K_HMMU_ENABLE_LC = 2;   /* Mac LC style fixed translation */
 
+class m68k_frontend;
+
 class m68000_musashi_device : public m68000_base_device
 {
+	friend class m68k_frontend;
+
 public:
 	// construction/destruction
 	m68000_musashi_device(const machine_config &mconfig, const char *tag, device_t *owner, u32 clock);
+	virtual ~m68000_musashi_device();
 
 	virtual bool supervisor_mode() const noexcept override;
 
@@ -325,6 +333,71 @@ protected:
 	// device_memory_interface overrides
 	virtual bool memory_translate(int space, int intention, offs_t &address, address_space *&target_space) override;
 
+	// internal recompiler state, allocated near the code cache
+	struct internal_m68k_drc_state
+	{
+		u32         dar[16];                // shadow copy of the data and address registers
+		u32         x_flag, n_flag, not_z_flag, v_flag, c_flag; // shadow copies of the flags, as the interpreter holds them
+		u32         pc;
+		s32         icount;
+		u32         mode;                   // hash mode (supervisor state)
+		u32         exitcode;               // exit code requested by a helper
+		u32         arg0;                   // expected PC after a helper
+		u32         arg1;                   // nonzero if a helper needs a redispatch
+	};
+
+	// internal compiler state
+	struct compiler_state
+	{
+		compiler_state &operator=(compiler_state const &) = delete;
+
+		u32         cycles;                 // accumulated cycles
+		u32         mode;                   // mode this block is compiled for
+		uml::code_label labelnum;           // index for local labels
+	};
+
+	std::unique_ptr<drc_cache> m_drccache;
+	std::unique_ptr<drcuml_state> m_drcuml;
+	std::unique_ptr<m68k_frontend> m_drcfe;
+	internal_m68k_drc_state *m_drc;
+	bool m_enable_drc;
+	bool m_cache_dirty;
+	util::notifier_subscription m_notifier;
+
+	// recompiler subroutines
+	uml::code_handle *m_entry;
+	uml::code_handle *m_nocode;
+	uml::code_handle *m_out_of_cycles;
+	uml::code_handle *m_redispatch;
+
+	void drc_init();
+	void execute_run_drc();
+	bool drc_can_execute() const;
+	bool drc_code_backed(offs_t pc) const;
+	void drc_load_state();
+	void drc_store_state();
+	void code_flush_cache();
+	void code_compile_block(u32 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_redispatch();
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception);
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_native(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cycles);
+	void generate_interpret(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_logic_flags(drcuml_block &block);
+	void generate_arith_flags(drcuml_block &block, bool sub, bool extend);
+	uml::condition_t generate_condition(drcuml_block &block, int cond);
+	void generate_bcc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cond, int notake_cycles);
+	void generate_dbcc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, int cond);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+
+public:
+	void ccfunc_execute_one();
+
+protected:
 #include "m68kcpu.h"
 #include "m68kops.h"
 #include "m68kmmu.h"
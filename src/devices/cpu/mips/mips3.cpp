@@ -176,6 +176,8 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_drcfe(nullptr)
 	, m_drcoptions(0)
 	, m_drc_cache_dirty(0)
+	, m_compile_snapshot(false)
+	, m_compile_mode(0)
 	, m_entry(nullptr)
 	, m_nocode(nullptr)
 	, m_out_of_cycles(nullptr)
@@ -208,7 +210,8 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	memset(m_fastram, 0, sizeof(m_fastram));
 	memset(m_hotspot, 0, sizeof(m_hotspot));
 
-	// configure the virtual TLB
+	// configure the virtual TLB; plain RAM pages skip the memory system entirely
+	set_vtlb_host_pointers(true);
 	if (m_flavor == MIPS3_TYPE_TX4925)
 		set_vtlb_fixed_entries(2 * m_tlbentries + 3);
 	else
@@ -1195,6 +1198,11 @@ inline bool mips3_device::RBYTE(offs_t address, uint32_t *result)
 	if (tlbval & READ_ALLOWED)
 	{
 		const uint32_t tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (uint8_t *const host = vtlb_host_table()[address >> 12])
+		{
+			*result = host[(address & 0xfff) ^ m_byte_xor];
+			return true;
+		}
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -1228,6 +1236,11 @@ inline bool mips3_device::RHALF(offs_t address, uint32_t *result)
 	if (tlbval & READ_ALLOWED)
 	{
 		const uint32_t tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (uint8_t *const host = vtlb_host_table()[address >> 12])
+		{
+			*result = reinterpret_cast<uint16_t const *>(host)[((address & 0xfff) ^ m_word_xor) >> 1];
+			return true;
+		}
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -1261,6 +1274,11 @@ inline bool mips3_device::RWORD(offs_t address, uint32_t *result, bool insn)
 	if (tlbval & READ_ALLOWED)
 	{
 		const uint32_t tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (uint8_t *const host = vtlb_host_table()[address >> 12])
+		{
+			*result = reinterpret_cast<uint32_t const *>(host)[((address & 0xfff) ^ m_dword_xor) >> 2];
+			return true;
+		}
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -1363,6 +1381,11 @@ inline void mips3_device::WBYTE(offs_t address, uint8_t data)
 	if (tlbval & WRITE_ALLOWED)
 	{
 		const uint32_t tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (uint8_t *const host = vtlb_host_table()[address >> 12])
+		{
+			host[(address & 0xfff) ^ m_byte_xor] = data;
+			return;
+		}
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (m_fastram[ramnum].readonly == true || tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -1397,6 +1420,11 @@ inline void mips3_device::WHALF(offs_t address, uint16_t data)
 	if (tlbval & WRITE_ALLOWED)
 	{
 		const uint32_t tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (uint8_t *const host = vtlb_host_table()[address >> 12])
+		{
+			reinterpret_cast<uint16_t *>(host)[((address & 0xfff) ^ m_word_xor) >> 1] = data;
+			return;
+		}
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (m_fastram[ramnum].readonly == true || tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -1431,6 +1459,11 @@ inline void mips3_device::WWORD(offs_t address, uint32_t data)
 	if (tlbval & WRITE_ALLOWED)
 	{
 		const uint32_t tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (uint8_t *const host = vtlb_host_table()[address >> 12])
+		{
+			reinterpret_cast<uint32_t *>(host)[((address & 0xfff) ^ m_dword_xor) >> 2] = data;
+			return;
+		}
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (m_fastram[ramnum].readonly == true || tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -5326,8 +5359,14 @@ void mips3_device::execute_run()
 			/* run as much as we can */
 			execute_result = m_drcuml->execute(*m_entry);
 
-			/* if we need to recompile, do it */
-			if (execute_result == EXECUTE_MISSING_CODE)
+			/* if we need to recompile, do it, in the background if we can */
+			if (execute_result == EXECUTE_MISSING_CODE && m_drcuml->background_enabled())
+			{
+				code_compile_block_background(m_core->mode, m_core->pc);
+				if (m_core->icount <= 0)
+					break;
+			}
+			else if (execute_result == EXECUTE_MISSING_CODE)
 			{
 				code_compile_block(m_core->mode, m_core->pc);
 			}
@@ -5345,6 +5384,18 @@ void mips3_device::execute_run()
 		return;
 	}
 
+	execute_run_interpreter(false);
+}
+
+
+/*-------------------------------------------------
+    execute_run_interpreter - run the interpreter
+    until out of cycles or, if requested, until a
+    background compilation has completed
+-------------------------------------------------*/
+
+void mips3_device::execute_run_interpreter(bool until_compiled)
+{
 	/* count cycles and interrupt cycles */
 	m_core->icount -= m_interrupt_cycles;
 	m_interrupt_cycles = 0;
@@ -5573,7 +5624,7 @@ void mips3_device::execute_run()
 			elf_loaded = true;
 		}
 #endif
-	} while (m_core->icount > 0 || m_nextpc != ~0);
+	} while ((m_core->icount > 0 && !(until_compiled && m_drcuml->background_done())) || m_nextpc != ~0);
 
 	m_core->icount -= m_interrupt_cycles;
 	m_interrupt_cycles = 0;
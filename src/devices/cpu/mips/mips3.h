@@ -20,6 +20,9 @@ MIPS III/IV emulator.
 #include "cpu/drcuml.h"
 #include "ps2vu.h"
 
+#include <unordered_map>
+#include <unordered_set>
+
 DECLARE_DEVICE_TYPE(R4000BE, r4000be_device)
 DECLARE_DEVICE_TYPE(R4000LE, r4000le_device)
 DECLARE_DEVICE_TYPE(R4400BE, r4400be_device)
@@ -322,6 +325,7 @@ protected:
 	virtual uint32_t execute_max_cycles() const noexcept override { return 40; }
 	virtual uint32_t execute_input_lines() const noexcept override { return 6; }
 	virtual void execute_run() override;
+	void execute_run_interpreter(bool until_compiled);
 	virtual void execute_set_input(int inputnum, int state) override;
 
 	// device_memory_interface overrides
@@ -482,6 +486,13 @@ protected:
 												/* internal stuff */
 	uint8_t         m_drc_cache_dirty;          /* true if we need to flush the cache */
 
+												/* state captured for a block generated on a worker */
+	bool            m_compile_snapshot;         /* true if generating from the snapshot */
+	uint8_t         m_compile_mode;             /* mode of the block being generated */
+	std::unordered_map<offs_t, const void *> m_snapshot_readptr;    /* code pointer for each physical PC */
+	std::unordered_set<offs_t> m_snapshot_writable;                 /* physical PCs in writable memory */
+	std::unordered_map<offs_t, vtlb_entry> m_snapshot_tlb;          /* TLB entry for each page */
+
 												/* tables */
 	uint8_t         m_fpmode[4];                /* FPU mode table */
 
@@ -603,6 +614,12 @@ private:
 	void save_fast_iregs(drcuml_block &block);
 	void code_flush_cache();
 	void code_compile_block(uint8_t mode, offs_t pc);
+	void code_compile_block_background(uint8_t mode, offs_t pc);
+	void code_generate_block(uint8_t mode, offs_t pc, const opcode_desc *desclist, const opcode_desc *codelast);
+	void code_take_snapshot(uint8_t mode, const opcode_desc *desclist, const opcode_desc *codelast);
+	const void *code_read_ptr(offs_t physpc) const;
+	bool code_is_writable(offs_t physpc) const;
+	vtlb_entry code_tlb_entry(offs_t pc) const;
 public:
 	void func_get_cycles();
 	void func_printf_exception();
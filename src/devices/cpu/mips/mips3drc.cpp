@@ -42,8 +42,8 @@
     MACROS
 ***************************************************************************/
 
-#define IS_FR0      ((m_core->mode & 1) == 0)
-#define IS_FR1      ((m_core->mode & 1) != 0)
+#define IS_FR0      ((m_compile_mode & 1) == 0)
+#define IS_FR1      ((m_compile_mode & 1) != 0)
 
 #define R32(reg)                m_regmaplo[reg]
 #define LO32                    R32(REG_LO)
@@ -287,6 +287,120 @@ void mips3_device::code_flush_cache()
 }
 
 
+/*-------------------------------------------------
+    code_compile_block_background - compile a
+    block on a worker thread while the interpreter
+    keeps running the code
+-------------------------------------------------*/
+
+void mips3_device::code_compile_block_background(uint8_t mode, offs_t pc)
+{
+	/* describe the code and capture what generation reads from memory and the TLB while we own them */
+	const opcode_desc *const desclist = m_drcfe->describe_code(pc);
+	const opcode_desc *const codelast = m_drcfe->get_last();
+	if (m_drcuml->logging() || m_drcuml->logging_native())
+		log_opcode_desc(desclist, 0);
+	code_take_snapshot(mode, desclist, codelast);
+
+	/* the worker only sees the description and the snapshot; the interpreter owns everything else */
+	m_compile_snapshot = true;
+	m_drcuml->background_compile([this, mode, pc, desclist, codelast] () { code_generate_block(mode, pc, desclist, codelast); });
+	execute_run_interpreter(true);
+	try
+	{
+		m_drcuml->background_wait();
+	}
+	catch (...)
+	{
+		m_compile_snapshot = false;
+		throw;
+	}
+	m_compile_snapshot = false;
+
+	/* the interpreter doesn't track the mode, so rebuild it from SR as generate_update_mode does */
+	const uint32_t sr = m_core->cpr[0][COP0_Status];
+	m_core->mode = ((sr & (SR_EXL | SR_ERL)) ? 0 : ((sr >> 2) & 0x06)) | ((sr >> 26) & 0x01);
+}
+
+
+/*-------------------------------------------------
+    code_take_snapshot - record the code pointers,
+    writability and TLB entries that generating a
+    block needs, so it can run on a worker
+-------------------------------------------------*/
+
+void mips3_device::code_take_snapshot(uint8_t mode, const opcode_desc *desclist, const opcode_desc *codelast)
+{
+	const vtlb_entry *tlbtable = vtlb_table();
+	auto const capture = [this, tlbtable] (const opcode_desc &desc)
+	{
+		m_snapshot_readptr.emplace(desc.physpc, m_prptr(desc.physpc));
+		if (m_program->get_write_ptr(desc.physpc) != nullptr)
+			m_snapshot_writable.insert(desc.physpc);
+		m_snapshot_tlb.emplace(desc.pc >> 12, tlbtable[desc.pc >> 12]);
+	};
+
+	m_compile_mode = mode;
+	m_snapshot_readptr.clear();
+	m_snapshot_writable.clear();
+	m_snapshot_tlb.clear();
+	for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+	{
+		capture(*curdesc);
+		for (const opcode_desc *delaydesc = curdesc->delay.first(); delaydesc != nullptr; delaydesc = delaydesc->next())
+			capture(*delaydesc);
+	}
+	if (codelast)
+	{
+		capture(*codelast);
+		if (codelast->delay.first())
+			capture(*codelast->delay.first());
+	}
+}
+
+
+/*-------------------------------------------------
+    code_read_ptr - get a pointer to the code at a
+    physical PC, from the snapshot if generating
+    on a worker
+-------------------------------------------------*/
+
+const void *mips3_device::code_read_ptr(offs_t physpc) const
+{
+	if (!m_compile_snapshot)
+		return m_prptr(physpc);
+	auto const found = m_snapshot_readptr.find(physpc);
+	return (found != m_snapshot_readptr.end()) ? found->second : nullptr;
+}
+
+
+/*-------------------------------------------------
+    code_is_writable - check whether the code at a
+    physical PC can be modified
+-------------------------------------------------*/
+
+bool mips3_device::code_is_writable(offs_t physpc) const
+{
+	if (!m_compile_snapshot)
+		return m_program->get_write_ptr(physpc) != nullptr;
+	return m_snapshot_writable.find(physpc) != m_snapshot_writable.end();
+}
+
+
+/*-------------------------------------------------
+    code_tlb_entry - get the TLB entry for the
+    page holding a PC
+-------------------------------------------------*/
+
+mips3_device::vtlb_entry mips3_device::code_tlb_entry(offs_t pc) const
+{
+	if (!m_compile_snapshot)
+		return vtlb_table()[pc >> 12];
+	auto const found = m_snapshot_tlb.find(pc >> 12);
+	return (found != m_snapshot_tlb.end()) ? found->second : 0;
+}
+
+
 /*-------------------------------------------------
     code_compile_block - compile a block of the
     given mode at the specified pc
@@ -294,21 +408,32 @@ void mips3_device::code_flush_cache()
 
 void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 {
-	compiler_state compiler = { 0 };
-	const opcode_desc *seqhead, *seqlast;
-	const opcode_desc *codelast;
-	const opcode_desc *desclist;
-	bool override = false;
-
 	auto profile = g_profiler.start(PROFILER_DRC_COMPILE);
 
 	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	const opcode_desc *const desclist = m_drcfe->describe_code(pc);
 	/* get last instruction of the code (potentially used in generate_checksum) */
-	codelast = m_drcfe->get_last();
+	const opcode_desc *const codelast = m_drcfe->get_last();
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(desclist, 0);
 
+	m_compile_mode = mode;
+	code_generate_block(mode, pc, desclist, codelast);
+}
+
+
+/*-------------------------------------------------
+    code_generate_block - generate code for a
+    described block; this can run on a worker, so
+    it mustn't read memory or the TLB directly
+-------------------------------------------------*/
+
+void mips3_device::code_generate_block(uint8_t mode, offs_t pc, const opcode_desc *desclist, const opcode_desc *codelast)
+{
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	bool override = false;
+
 	/* if we get an error back, flush the cache and try again */
 	bool succeeded = false;
 	while (!succeeded)
@@ -351,12 +476,12 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 				else
 				{
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
-					UML_HASHJMP(block, m_core->mode, seqhead->pc, *m_nocode);               // hashjmp <mode>,seqhead->pc,nocode
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
 					continue;
 				}
 
 				/* validate this code block if we're not pointing into ROM */
-				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
+				if (code_is_writable(seqhead->physpc))
 					generate_checksum_block(block, compiler, seqhead, seqlast, codelast);
 
 				/* label this instruction, if it may be jumped to locally */
@@ -389,7 +514,7 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 				}
 				else if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
 				{
-					UML_HASHJMP(block, m_core->mode, nextpc, *m_nocode);                    // hashjmp <mode>,nextpc,nocode
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
 				}
 			}
 
@@ -1187,7 +1312,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 		if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP))
 		{
 			uint32_t sum = seqhead->opptr.l[0];
-			const void *base = m_prptr(seqhead->physpc);
+			const void *base = code_read_ptr(seqhead->physpc);
 			uint32_t low_bits = (seqhead->physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
 			UML_LOAD(block, I0, base, low_bits, SIZE_DWORD, SCALE_x1);         // load    i0,base,0,dword
 
@@ -1196,7 +1321,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 				&& seqhead->physpc != seqhead->delay.first()->physpc)
 			{
 				uint32_t low_bits = (seqhead->delay.first()->physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
-				base = m_prptr(seqhead->delay.first()->physpc);
+				base = code_read_ptr(seqhead->delay.first()->physpc);
 				assert(base != nullptr);
 				UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1);                 // load    i1,base,dword
 				UML_ADD(block, I0, I0, I1);                     // add     i0,i0,i1
@@ -1216,14 +1341,14 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 		for (curdesc = seqhead->next(); curdesc != seqlast->next(); curdesc = curdesc->next())
 			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
 			{
-				const void *base = m_prptr(seqhead->physpc);
+				const void *base = code_read_ptr(seqhead->physpc);
 				UML_LOAD(block, I0, base, m_dword_xor, SIZE_DWORD, SCALE_x1);     // load    i0,base,0,dword
 				UML_CMP(block, I0, curdesc->opptr.l[0]);                    // cmp     i0,opptr[0]
 				UML_EXHc(block, COND_NE, *m_nocode, epc(seqhead));   // exne    nocode,seqhead->pc
 			}
 #else
 		uint32_t sum = 0;
-		const void *base = m_prptr(seqhead->physpc);
+		const void *base = code_read_ptr(seqhead->physpc);
 		const uint32_t data_bits_mask = (m_data_bits == 64 ? 4 : 0);
 		const uint32_t last_physpc = codelast->physpc;
 		uint32_t low_bits = (seqhead->physpc & data_bits_mask) ^ m_dword_xor;
@@ -1231,7 +1356,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 		sum += seqhead->opptr.l[0];
 		if ((m_drcoptions & MIPS3DRC_EXTRA_INSTR_CHECK) && !(codelast->flags & OPFLAG_VIRTUAL_NOOP) && last_physpc != seqhead->physpc)
 		{
-			base = m_prptr(last_physpc);
+			base = code_read_ptr(last_physpc);
 			assert(base != nullptr);
 			low_bits = (last_physpc & data_bits_mask) ^ m_dword_xor;
 			UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1);     // load    i1,base,dword
@@ -1244,7 +1369,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 			{
 				if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
 				{
-					base = m_prptr(curdesc->physpc);
+					base = code_read_ptr(curdesc->physpc);
 					assert(base != nullptr);
 					low_bits = (curdesc->physpc & data_bits_mask) ^ m_dword_xor;
 					UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1);     // load    i1,base,dword
@@ -1255,7 +1380,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 						&& !(curdesc->delay.first()->flags & OPFLAG_VIRTUAL_NOOP)
 						&& (curdesc == seqlast || (curdesc->next() != nullptr && curdesc->next()->physpc != curdesc->delay.first()->physpc)))
 					{
-						base = m_prptr(curdesc->delay.first()->physpc);
+						base = code_read_ptr(curdesc->delay.first()->physpc);
 						assert(base != nullptr);
 						low_bits = (curdesc->delay.first()->physpc & data_bits_mask) ^ m_dword_xor;
 						UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1); // load    i1,base,dword
@@ -1274,7 +1399,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 					// Skip the last if it was already included above
 					if (curdesc->physpc != last_physpc)
 					{
-						base = m_prptr(curdesc->physpc);
+						base = code_read_ptr(curdesc->physpc);
 						assert(base != nullptr);
 						low_bits = (curdesc->physpc & data_bits_mask) ^ m_dword_xor;
 						UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1);     // load    i1,base,dword
@@ -1286,7 +1411,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 						&& !(curdesc->delay.first()->flags & OPFLAG_VIRTUAL_NOOP)
 						&& (curdesc == seqlast || (curdesc->next() != nullptr && curdesc->next()->physpc != curdesc->delay.first()->physpc)))
 					{
-						base = m_prptr(curdesc->delay.first()->physpc);
+						base = code_read_ptr(curdesc->delay.first()->physpc);
 						assert(base != nullptr);
 						low_bits = (curdesc->delay.first()->physpc & data_bits_mask) ^ m_dword_xor;
 						UML_LOAD(block, I1, base, low_bits, SIZE_DWORD, SCALE_x1); // load    i1,base,dword
@@ -1307,7 +1432,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 			// Check the last instruction
 			if (!(codelast->flags & OPFLAG_VIRTUAL_NOOP) && last_physpc != seqhead->physpc)
 			{
-				base = m_prptr(last_physpc);
+				base = code_read_ptr(last_physpc);
 				assert(base != nullptr);
 				low_bits = (last_physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
 				UML_LOAD(block, I0, base, low_bits, SIZE_DWORD, SCALE_x1);     // load    i1,base,dword
@@ -1327,7 +1452,7 @@ void mips3_device::generate_checksum_block(drcuml_block &block, compiler_state &
 				if (codelast->delay.first() != nullptr && !(codelast->delay.first()->flags & OPFLAG_VIRTUAL_NOOP)
 					&& last_physpc != seqhead->physpc)
 				{
-					base = m_prptr(codelast->delay.first()->physpc);
+					base = code_read_ptr(codelast->delay.first()->physpc);
 					assert(base != nullptr);
 					low_bits = (codelast->delay.first()->physpc & (m_data_bits == 64 ? 4 : 0)) ^ m_dword_xor;
 					UML_LOAD(block, I0, base, low_bits, SIZE_DWORD, SCALE_x1); // load    i1,base,dword
@@ -1424,9 +1549,10 @@ void mips3_device::generate_sequence_instruction(drcuml_block &block, compiler_s
 	if ((desc->flags & OPFLAG_VALIDATE_TLB) && (desc->pc < 0x80000000 || desc->pc >= 0xc0000000))
 	{
 		const vtlb_entry *tlbtable = vtlb_table();
+		const vtlb_entry tlbentry = code_tlb_entry(desc->pc);
 
 		/* if we currently have a valid TLB read entry, we just verify */
-		if (tlbtable[desc->pc >> 12] & FETCH_ALLOWED)
+		if (tlbentry & FETCH_ALLOWED)
 		{
 			if (PRINTF_MMU)
 			{
@@ -1436,7 +1562,7 @@ void mips3_device::generate_sequence_instruction(drcuml_block &block, compiler_s
 				UML_CALLC(block, cfunc_printf_debug, this);                        // callc   printf_debug
 			}
 			UML_LOAD(block, I0, &tlbtable[desc->pc >> 12], 0, SIZE_DWORD, SCALE_x4);        // load i0,tlbtable[desc->pc >> 12],0,dword
-			UML_CMP(block, I0, tlbtable[desc->pc >> 12]);                   // cmp     i0,*tlbentry
+			UML_CMP(block, I0, tlbentry);                                   // cmp     i0,*tlbentry
 			UML_EXHc(block, COND_NE, *m_tlb_mismatch, 0);            // exh     tlb_mismatch,0,NE
 		}
 
@@ -1510,13 +1636,13 @@ void mips3_device::generate_delay_slot_and_branch(drcuml_block &block, compiler_
 		}
 		else
 		{
-			UML_HASHJMP(block, m_core->mode, desc->targetpc, *m_nocode);            // hashjmp <mode>,desc->targetpc,nocode
+			UML_HASHJMP(block, m_compile_mode, desc->targetpc, *m_nocode);            // hashjmp <mode>,desc->targetpc,nocode
 		}
 	}
 	else
 	{
 		generate_update_cycles(block, compiler_temp, uml::mem(&m_core->jmpdest), true); // <subtract cycles>
-		UML_HASHJMP(block, m_core->mode, mem(&m_core->jmpdest), *m_nocode);         // hashjmp <mode>,<rsreg>,nocode
+		UML_HASHJMP(block, m_compile_mode, mem(&m_core->jmpdest), *m_nocode);         // hashjmp <mode>,<rsreg>,nocode
 	}
 
 	/* update the label */
@@ -1676,7 +1802,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x20:  /* LB - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read8[m_core->mode >> 1]);  // callh   read8
+			UML_CALLH(block, *m_read8[m_compile_mode >> 1]);  // callh   read8
 			if (RTREG != 0)
 				UML_DSEXT(block, R64(RTREG), I0, SIZE_BYTE);                        // dsext   <rtreg>,i0,byte
 			if (!in_delay_slot)
@@ -1685,7 +1811,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x21:  /* LH - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read16[m_core->mode >> 1]); // callh   read16
+			UML_CALLH(block, *m_read16[m_compile_mode >> 1]); // callh   read16
 			if (RTREG != 0)
 				UML_DSEXT(block, R64(RTREG), I0, SIZE_WORD);                        // dsext   <rtreg>,i0,word
 			if (!in_delay_slot)
@@ -1694,7 +1820,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x23:  /* LW - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read32[m_core->mode >> 1]); // callh   read32
+			UML_CALLH(block, *m_read32[m_compile_mode >> 1]); // callh   read32
 			if (RTREG != 0)
 				UML_DSEXT(block, R64(RTREG), I0, SIZE_DWORD);                       // dsext   <rtreg>,i0
 			if (!in_delay_slot)
@@ -1704,7 +1830,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x30:  /* LL - MIPS II */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_MOV(block, mem(&m_core->cpr[0][COP0_LLAddr]), I0);          // mov     [LLAddr],i0
-			UML_CALLH(block, *m_read32[m_core->mode >> 1]);                 // callh   read32
+			UML_CALLH(block, *m_read32[m_compile_mode >> 1]);                 // callh   read32
 			if (RTREG != 0)
 				UML_DSEXT(block, R64(RTREG), I0, SIZE_DWORD);               // dsext   <rtreg>,i0
 			UML_MOV(block, mem(&m_core->llbit), 1);                         // mov     [llbit],1
@@ -1716,7 +1842,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x24:  /* LBU - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read8[m_core->mode >> 1]);  // callh   read8
+			UML_CALLH(block, *m_read8[m_compile_mode >> 1]);  // callh   read8
 			if (RTREG != 0)
 				UML_DAND(block, R64(RTREG), I0, 0xff);                  // dand    <rtreg>,i0,0xff
 			if (!in_delay_slot)
@@ -1725,7 +1851,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x25:  /* LHU - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read16[m_core->mode >> 1]); // callh   read16
+			UML_CALLH(block, *m_read16[m_compile_mode >> 1]); // callh   read16
 			if (RTREG != 0)
 				UML_DAND(block, R64(RTREG), I0, 0xffff);                    // dand    <rtreg>,i0,0xffff
 			if (!in_delay_slot)
@@ -1734,7 +1860,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x27:  /* LWU - MIPS III */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read32[m_core->mode >> 1]); // callh   read32
+			UML_CALLH(block, *m_read32[m_compile_mode >> 1]); // callh   read32
 			if (RTREG != 0)
 				UML_DAND(block, R64(RTREG), I0, 0xffffffff);                // dand    <rtreg>,i0,0xffffffff
 			if (!in_delay_slot)
@@ -1743,7 +1869,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x37:  /* LD - MIPS III */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read64[m_core->mode >> 1]); // callh   read64
+			UML_CALLH(block, *m_read64[m_compile_mode >> 1]); // callh   read64
 			if (RTREG != 0)
 				UML_DMOV(block, R64(RTREG), I0);                                // dmov    <rtreg>,i0
 			if (!in_delay_slot)
@@ -1753,7 +1879,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x34:  /* LLD - MIPS III */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_MOV(block, mem(&m_core->cpr[0][COP0_LLAddr]), I0);          // mov     [LLAddr],i0
-			UML_CALLH(block, *m_read64[m_core->mode >> 1]);                 // callh   read64
+			UML_CALLH(block, *m_read64[m_compile_mode >> 1]);                 // callh   read64
 			if (RTREG != 0)
 				UML_DMOV(block, R64(RTREG), I0);                            // dmov    <rtreg>,i0
 			UML_MOV(block, mem(&m_core->llbit), 1);                         // mov     [llbit],1
@@ -1770,7 +1896,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			if (!m_bigendian)
 				UML_XOR(block, I1, I1, 0x18);                       // xor     i1,i1,0x18
 			UML_SHR(block, I2, ~0, I1);                             // shr     i2,~0,i1
-			UML_CALLH(block, *m_read32mask[m_core->mode >> 1]);
+			UML_CALLH(block, *m_read32mask[m_compile_mode >> 1]);
 																					// callh   read32mask
 			if (RTREG != 0)
 			{
@@ -1790,7 +1916,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			if (m_bigendian)
 				UML_XOR(block, I1, I1, 0x18);                       // xor     i1,i1,0x18
 			UML_SHL(block, I2, ~0, I1);                             // shl     i2,~0,i1
-			UML_CALLH(block, *m_read32mask[m_core->mode >> 1]);
+			UML_CALLH(block, *m_read32mask[m_compile_mode >> 1]);
 																					// callh   read32mask
 			if (RTREG != 0)
 			{
@@ -1811,7 +1937,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			if (!m_bigendian)
 				UML_XOR(block, I1, I1, 0x38);                       // xor     i1,i1,0x38
 			UML_DSHR(block, I2, (uint64_t)~0, I1);                        // dshr    i2,~0,i1
-			UML_CALLH(block, *m_read64mask[m_core->mode >> 1]);
+			UML_CALLH(block, *m_read64mask[m_compile_mode >> 1]);
 																					// callh   read64mask
 			if (RTREG != 0)
 			{
@@ -1829,7 +1955,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			if (m_bigendian)
 				UML_XOR(block, I1, I1, 0x38);                   // xor     i1,i1,0x38
 			UML_DSHL(block, I2, (uint64_t)~0, I1);                // dshl    i2,~0,i1
-			UML_CALLH(block, *m_read64mask[m_core->mode >> 1]); // callh   read64mask
+			UML_CALLH(block, *m_read64mask[m_compile_mode >> 1]); // callh   read64mask
 			if (RTREG != 0)
 			{
 				UML_DSHR(block, I2, (uint64_t)~0, I1);            // dshr    i2,~0,i1
@@ -1843,7 +1969,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x31:  /* LWC1 - MIPS I */
 			check_cop1_access(block);
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read32[m_core->mode >> 1]); // callh   read32
+			UML_CALLH(block, *m_read32[m_compile_mode >> 1]); // callh   read32
 			UML_MOV(block, FPR32(RTREG), I0);           // mov     <cpr1_rt>,i0
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -1852,7 +1978,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x35:  /* LDC1 - MIPS III */
 			check_cop1_access(block);
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read64[m_core->mode >> 1]); // callh   read64
+			UML_CALLH(block, *m_read64[m_compile_mode >> 1]); // callh   read64
 			UML_DMOV(block, FPR64(RTREG), I0);              // dmov    <cpr1_rt>,i0
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -1860,7 +1986,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x32:  /* LWC2 - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read32[m_core->mode >> 1]); // callh   read32
+			UML_CALLH(block, *m_read32[m_compile_mode >> 1]); // callh   read32
 			UML_DAND(block, CPR264(RTREG), I0, 0xffffffff);             // dand    <cpr2_rt>,i0,0xffffffff
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -1868,7 +1994,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 
 		case 0x36:  /* LDC2 - MIPS II */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
-			UML_CALLH(block, *m_read64[m_core->mode >> 1]); // callh   read64
+			UML_CALLH(block, *m_read64[m_compile_mode >> 1]); // callh   read64
 			UML_DMOV(block, CPR264(RTREG), I0);                             // dmov    <cpr2_rt>,i0
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -1880,7 +2006,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x28:  /* SB - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_MOV(block, I1, R32(RTREG));                                 // mov     i1,<rtreg>
-			UML_CALLH(block, *m_write8[m_core->mode >> 1]); // callh   write8
+			UML_CALLH(block, *m_write8[m_compile_mode >> 1]); // callh   write8
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -1888,7 +2014,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x29:  /* SH - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_MOV(block, I1, R32(RTREG));                                 // mov     i1,<rtreg>
-			UML_CALLH(block, *m_write16[m_core->mode >> 1]);    // callh   write16
+			UML_CALLH(block, *m_write16[m_compile_mode >> 1]);    // callh   write16
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -1896,7 +2022,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x2b:  /* SW - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_MOV(block, I1, R32(RTREG));                                 // mov     i1,<rtreg>
-			UML_CALLH(block, *m_write32[m_core->mode >> 1]);    // callh   write32
+			UML_CALLH(block, *m_write32[m_compile_mode >> 1]);    // callh   write32
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -1909,7 +2035,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_CMP(block, mem(&m_core->cpr[0][COP0_LLAddr]), I0);          // cmp [LLADDR], RSREG + SIMMVAL
 			UML_JMPc(block, COND_NE, skip);                                 // jne      skip
-			UML_CALLH(block, *m_write32[m_core->mode >> 1]);                // callh   write32
+			UML_CALLH(block, *m_write32[m_compile_mode >> 1]);                // callh   write32
 			UML_MOV(block, R32(RTREG), 1);                                  // mov     <rtreg>, 0
 			UML_LABEL(block, skip);                                         // skip:
 			if (!in_delay_slot)
@@ -1919,7 +2045,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x3f:  /* SD - MIPS III */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_DMOV(block, I1, R64(RTREG));                                // dmov    i1,<rtreg>
-			UML_CALLH(block, *m_write64[m_core->mode >> 1]);    // callh   write64
+			UML_CALLH(block, *m_write64[m_compile_mode >> 1]);    // callh   write64
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -1932,7 +2058,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                            // add     i0,<rsreg>,SIMMVAL
 			UML_CMP(block, mem(&m_core->cpr[0][COP0_LLAddr]), I0);              // cmp [LLADDR], RSREG + SIMMVAL
 			UML_JMPc(block, COND_NE, skip);                                     // jne      skip
-			UML_CALLH(block, *m_write64[m_core->mode >> 1]);                    // callh   write64
+			UML_CALLH(block, *m_write64[m_compile_mode >> 1]);                    // callh   write64
 			UML_DMOV(block, R64(RTREG), 1);                                     // dmov   <rtreg>,1
 			UML_LABEL(block, skip);                                             // skip:
 			if (!in_delay_slot)
@@ -1948,7 +2074,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 				UML_XOR(block, I3, I3, 0x18);                       // xor     i3,i3,0x18
 			UML_SHR(block, I2, ~0, I3);                             // shr     i2,~0,i3
 			UML_SHR(block, I1, I1, I3);                             // shr     i1,i1,i3
-			UML_CALLH(block, *m_write32mask[m_core->mode >> 1]);
+			UML_CALLH(block, *m_write32mask[m_compile_mode >> 1]);
 																					// callh   write32mask
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -1963,7 +2089,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 				UML_XOR(block, I3, I3, 0x18);                       // xor     i3,i3,0x18
 			UML_SHL(block, I2, ~0, I3);                             // shl     i2,~0,i3
 			UML_SHL(block, I1, I1, I3);                             // shl     i1,i1,i3
-			UML_CALLH(block, *m_write32mask[m_core->mode >> 1]);
+			UML_CALLH(block, *m_write32mask[m_compile_mode >> 1]);
 																					// callh   write32mask
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -1978,7 +2104,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 				UML_XOR(block, I3, I3, 0x38);                   // xor     i3,i3,0x38
 			UML_DSHR(block, I2, (uint64_t)~0, I3);                // dshr    i2,~0,i3
 			UML_DSHR(block, I1, I1, I3);                        // dshr    i1,i1,i3
-			UML_CALLH(block, *m_write64mask[m_core->mode >> 1]);// callh   write64mask
+			UML_CALLH(block, *m_write64mask[m_compile_mode >> 1]);// callh   write64mask
 
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -1993,7 +2119,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 				UML_XOR(block, I3, I3, 0x38);                   // xor     i3,i3,0x38
 			UML_DSHL(block, I2, (uint64_t)~0, I3);                // dshl    i2,~0,i3
 			UML_DSHL(block, I1, I1, I3);                        // dshl    i1,i1,i3
-			UML_CALLH(block, *m_write64mask[m_core->mode >> 1]);// callh   write64mask
+			UML_CALLH(block, *m_write64mask[m_compile_mode >> 1]);// callh   write64mask
 
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -2003,7 +2129,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			check_cop1_access(block);
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);            // add     i0,<rsreg>,SIMMVAL
 			UML_MOV(block, I1, FPR32(RTREG));                   // mov     i1,<cpr1_rt>
-			UML_CALLH(block, *m_write32[m_core->mode >> 1]);    // callh   write32
+			UML_CALLH(block, *m_write32[m_compile_mode >> 1]);    // callh   write32
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -2012,7 +2138,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			check_cop1_access(block);
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);            // add     i0,<rsreg>,SIMMVAL
 			UML_DMOV(block, I1, FPR64(RTREG));                  // dmov    i1,<cpr1_rt>
-			UML_CALLH(block, *m_write64[m_core->mode >> 1]);    // callh   write64
+			UML_CALLH(block, *m_write64[m_compile_mode >> 1]);    // callh   write64
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -2020,7 +2146,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x3a:  /* SWC2 - MIPS I */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_MOV(block, I1, CPR232(RTREG));                                  // mov     i1,<cpr2_rt>
-			UML_CALLH(block, *m_write32[m_core->mode >> 1]);    // callh   write32
+			UML_CALLH(block, *m_write32[m_compile_mode >> 1]);    // callh   write32
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -2028,7 +2154,7 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 		case 0x3e:  /* SDC2 - MIPS II */
 			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                        // add     i0,<rsreg>,SIMMVAL
 			UML_DMOV(block, I1, CPR264(RTREG));                             // dmov    i1,<cpr2_rt>
-			UML_CALLH(block, *m_write64[m_core->mode >> 1]);    // callh   write64
+			UML_CALLH(block, *m_write64[m_compile_mode >> 1]);    // callh   write64
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -2743,7 +2869,7 @@ void mips3_device::generate_badcop(drcuml_block &block, const int cop)
 
 void mips3_device::check_cop0_access(drcuml_block &block)
 {
-	if ((m_core->mode >> 1) != MODE_KERNEL)
+	if ((m_compile_mode >> 1) != MODE_KERNEL)
 	{
 		generate_badcop(block, 0);
 	}
@@ -2760,7 +2886,7 @@ bool mips3_device::generate_cop0(drcuml_block &block, compiler_state &compiler,
 	int skip;
 
 	/* generate an exception if COP0 is disabled unless we are in kernel mode */
-	if ((m_core->mode >> 1) != MODE_KERNEL)
+	if ((m_compile_mode >> 1) != MODE_KERNEL)
 	{
 		UML_TEST(block, CPR032(COP0_Status), SR_COP0);                          // test    [Status],SR_COP0
 		UML_EXHc(block, COND_Z, *m_exception[EXCEPTION_BADCOP], 0);             // exh     cop,0,Z
@@ -3421,7 +3547,7 @@ bool mips3_device::generate_cop1x(drcuml_block &block, compiler_state &compiler,
 	{
 		case 0x00:      /* LWXC1 - MIPS IV */
 			UML_ADD(block, I0, R32(RSREG), R32(RTREG));         // add     i0,<rsreg>,<rtreg>
-			UML_CALLH(block, *m_read32[m_core->mode >> 1]);     // callh   read32
+			UML_CALLH(block, *m_read32[m_compile_mode >> 1]);     // callh   read32
 			UML_MOV(block, FPR32(FDREG), I0);                   // mov     <cpr1_fd>,i0
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -3429,7 +3555,7 @@ bool mips3_device::generate_cop1x(drcuml_block &block, compiler_state &compiler,
 
 		case 0x01:      /* LDXC1 - MIPS IV */
 			UML_ADD(block, I0, R32(RSREG), R32(RTREG));         // add     i0,<rsreg>,<rtreg>
-			UML_CALLH(block, *m_read64[m_core->mode >> 1]);     // callh   read64
+			UML_CALLH(block, *m_read64[m_compile_mode >> 1]);     // callh   read64
 			UML_DMOV(block, FPR64(FDREG), I0);                  // dmov    <cpr1_fd>,i0
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
@@ -3438,7 +3564,7 @@ bool mips3_device::generate_cop1x(drcuml_block &block, compiler_state &compiler,
 		case 0x08:      /* SWXC1 - MIPS IV */
 			UML_ADD(block, I0, R32(RSREG), R32(RTREG));         // add     i0,<rsreg>,<rtreg>
 			UML_MOV(block, I1, FPR32(FSREG));                   // mov     i1,<cpr1_fs>
-			UML_CALLH(block, *m_write32[m_core->mode >> 1]);    // callh   write32
+			UML_CALLH(block, *m_write32[m_compile_mode >> 1]);    // callh   write32
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
@@ -3446,7 +3572,7 @@ bool mips3_device::generate_cop1x(drcuml_block &block, compiler_state &compiler,
 		case 0x09:      /* SDXC1 - MIPS IV */
 			UML_ADD(block, I0, R32(RSREG), R32(RTREG));         // add     i0,<rsreg>,<rtreg>
 			UML_DMOV(block, I1, FPR64(FSREG));                  // dmov    i1,<cpr1_fs>
-			UML_CALLH(block, *m_write64[m_core->mode >> 1]);    // callh   write64
+			UML_CALLH(block, *m_write64[m_compile_mode >> 1]);    // callh   write64
 			if (!in_delay_slot)
 				generate_update_cycles(block, compiler, desc->pc + 4, true);
 			return true;
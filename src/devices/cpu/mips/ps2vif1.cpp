@@ -17,6 +17,13 @@
 
 #include "video/ps2gif.h"
 
+#define LOG_REGS    (1U << 1)
+#define LOG_FIFO    (1U << 2)
+#define LOG_CMD     (1U << 3)
+
+#define VERBOSE     (0)
+#include "logmacro.h"
+
 DEFINE_DEVICE_TYPE(SONYPS2_VIF1, ps2_vif1_device, "ps2vif1", "PlayStation 2 VIF1")
 
 /*static*/ const size_t ps2_vif1_device::BUFFER_SIZE = 0x40;
@@ -138,95 +145,95 @@ uint32_t ps2_vif1_device::regs_r(offs_t offset)
 	{
 		case 0x00/4:
 			ret = m_status;
-			logerror("%s: Read: VIF1_STAT (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_STAT (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x10/4:
 			ret = m_control;
-			logerror("%s: Read: VIF1_FBRST (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_FBRST (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x20/4:
 			ret = m_err;
-			logerror("%s: Read: VIF1_ERR (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_ERR (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x30/4:
 			ret = m_mark;
-			logerror("%s: Read: VIF1_MARK (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_MARK (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x40/4:
 			ret = m_cycle;
-			logerror("%s: Read: VIF1_CYCLE (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_CYCLE (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x50/4:
 			ret = m_mode;
-			logerror("%s: Read: VIF1_MODE (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_MODE (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x60/4:
 			ret = m_num;
-			logerror("%s: Read: VIF1_NUM (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_NUM (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x70/4:
 			ret = m_mask;
-			logerror("%s: Read: VIF1_MASK (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_MASK (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x80/4:
 			ret = m_code;
-			logerror("%s: Read: VIF1_CODE (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_CODE (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x90/4:
 			ret = m_itops;
-			logerror("%s: Read: VIF1_ITOPS (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_ITOPS (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0xa0/4:
 			ret = m_base;
-			logerror("%s: Read: VIF1_BASE (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_BASE (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0xb0/4:
 			ret = m_offset;
-			logerror("%s: Read: VIF1_OFST (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_OFST (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0xc0/4:
 			ret = m_tops;
-			logerror("%s: Read: VIF1_TOPS (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_TOPS (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0xd0/4:
 			ret = m_itop;
-			logerror("%s: Read: VIF1_ITOP (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_ITOP (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0xe0/4:
 			ret = m_top;
-			logerror("%s: Read: VIF1_TOP (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_TOP (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x100/4:
 			ret = m_row_fill[0];
-			logerror("%s: Read: VIF1_R0 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_R0 (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x110/4:
 			ret = m_row_fill[1];
-			logerror("%s: Read: VIF1_R1 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_R1 (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x120/4:
 			ret = m_row_fill[2];
-			logerror("%s: Read: VIF1_R2 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_R2 (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x130/4:
 			ret = m_row_fill[3];
-			logerror("%s: Read: VIF1_R3 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_R3 (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x140/4:
 			ret = m_col_fill[0];
-			logerror("%s: Read: VIF1_C0 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_C0 (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x150/4:
 			ret = m_col_fill[1];
-			logerror("%s: Read: VIF1_C1 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_C1 (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x160/4:
 			ret = m_col_fill[2];
-			logerror("%s: Read: VIF1_C2 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_C2 (%08x)\n", machine().describe_context(), ret);
 			break;
 		case 0x170/4:
 			ret = m_col_fill[3];
-			logerror("%s: Read: VIF1_C3 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: VIF1_C3 (%08x)\n", machine().describe_context(), ret);
 			break;
 		default:
 			logerror("%s: Read: Unknown (%08x)\n", machine().describe_context(), 0x10003c00 + (offset << 2));
@@ -245,11 +252,11 @@ uint64_t ps2_vif1_device::mmio_r(offs_t offset)
 	uint64_t ret = 0ULL;
 	if (offset)
 	{
-		logerror("%s: mmio_r [127..64]: (%08x%08x)\n", machine().describe_context(), (uint32_t)(ret >> 32), (uint32_t)ret);
+		LOGMASKED(LOG_REGS, "%s: mmio_r [127..64]: (%08x%08x)\n", machine().describe_context(), (uint32_t)(ret >> 32), (uint32_t)ret);
 	}
 	else
 	{
-		logerror("%s: mmio_r [63..0]: (%08x%08x)\n", machine().describe_context(), (uint32_t)(ret >> 32), (uint32_t)ret);
+		LOGMASKED(LOG_REGS, "%s: mmio_r [63..0]: (%08x%08x)\n", machine().describe_context(), (uint32_t)(ret >> 32), (uint32_t)ret);
 	}
 	return ret;
 }
@@ -258,13 +265,13 @@ void ps2_vif1_device::mmio_w(offs_t offset, uint64_t data)
 {
 	if (offset)
 	{
-		logerror("%s: mmio_w [127..64]: %08x%08x\n", machine().describe_context(), (uint32_t)(data >> 32), (uint32_t)data);
+		LOGMASKED(LOG_REGS, "%s: mmio_w [127..64]: %08x%08x\n", machine().describe_context(), (uint32_t)(data >> 32), (uint32_t)data);
 		fifo_push((uint32_t)data);
 		fifo_push((uint32_t)(data >> 32));
 	}
 	else
 	{
-		logerror("%s: mmio_w [63..0]: %08x%08x\n", machine().describe_context(), (uint32_t)(data >> 32), (uint32_t)data);
+		LOGMASKED(LOG_REGS, "%s: mmio_w [63..0]: %08x%08x\n", machine().describe_context(), (uint32_t)(data >> 32), (uint32_t)data);
 		fifo_push((uint32_t)data);
 		fifo_push((uint32_t)(data >> 32));
 	}
@@ -282,7 +289,7 @@ void ps2_vif1_device::dma_write(const uint64_t hi, const uint64_t lo)
 
 void ps2_vif1_device::tag_write(uint32_t *data)
 {
-	logerror("%s: tag_write: %08x%08x\n", machine().describe_context(), data[2], data[3]);
+	LOGMASKED(LOG_FIFO, "%s: tag_write: %08x%08x\n", machine().describe_context(), data[2], data[3]);
 	fifo_push(data[2]);
 	fifo_push(data[3]);
 }
@@ -299,7 +306,7 @@ void ps2_vif1_device::fifo_push(uint32_t data)
 
 	m_status &= ~0x1f000000;
 	m_status |= ((m_end - m_curr) >> 2) << 24;
-	logerror("%s: Pushing %08x onto FIFO, depth is now %d, status is now %08x\n", machine().describe_context(), data, m_end - m_curr, m_status);
+	LOGMASKED(LOG_FIFO, "%s: Pushing %08x onto FIFO, depth is now %d, status is now %08x\n", machine().describe_context(), data, m_end - m_curr, m_status);
 }
 
 uint32_t ps2_vif1_device::fifo_pop()
@@ -320,7 +327,7 @@ uint32_t ps2_vif1_device::fifo_pop()
 
 	m_status &= ~0x1f000000;
 	m_status |= ((m_end - m_curr) >> 2) << 24;
-	logerror("%s: Popping %08x from FIFO, depth is now %d, status is now %08x\n", machine().describe_context(), ret, m_end - m_curr, m_status);
+	LOGMASKED(LOG_FIFO, "%s: Popping %08x from FIFO, depth is now %d, status is now %08x\n", machine().describe_context(), ret, m_end - m_curr, m_status);
 
 	return ret;
 }
@@ -341,7 +348,7 @@ void ps2_vif1_device::execute_run()
 				if (fifo_depth())
 				{
 					m_code = fifo_pop();
-					logerror("%s: New VIFcode: %08x\n", machine().describe_context(), m_code);
+					LOGMASKED(LOG_CMD, "%s: New VIFcode: %08x\n", machine().describe_context(), m_code);
 				}
 				else
 				{
@@ -382,17 +389,17 @@ void ps2_vif1_device::transfer_vifcode_data()
 	{
 		case 0x20: /* STMASK */
 			m_mask = fifo_pop();
-			logerror("%s: STMASK: %08x\n", machine().describe_context(), m_mask);
+			LOGMASKED(LOG_CMD, "%s: STMASK: %08x\n", machine().describe_context(), m_mask);
 			m_data_needed = 0;
 			break;
 		case 0x30: /* STROW */
 			m_row_fill[m_data_index] = fifo_pop();
-			logerror("%s: STMASK: %08x\n", machine().describe_context(), m_row_fill[m_data_index]);
+			LOGMASKED(LOG_CMD, "%s: STMASK: %08x\n", machine().describe_context(), m_row_fill[m_data_index]);
 			m_data_needed--;
 			break;
 		case 0x31: /* STCOL */
 			m_col_fill[m_data_index] = fifo_pop();
-			logerror("%s: STMASK: %08x\n", machine().describe_context(), m_col_fill[m_data_index]);
+			LOGMASKED(LOG_CMD, "%s: STMASK: %08x\n", machine().describe_context(), m_col_fill[m_data_index]);
 			m_data_needed--;
 			break;
 		case 0x4a: /* MPG */
@@ -401,7 +408,7 @@ void ps2_vif1_device::transfer_vifcode_data()
 		default:
 			if ((m_command & 0x60) == 0x60)
 			{
-				logerror("%s: Unpack: %02x\n", machine().describe_context(), m_command);
+				LOGMASKED(LOG_CMD, "%s: Unpack: %02x\n", machine().describe_context(), m_command);
 				transfer_unpack();
 			}
 			else
@@ -427,7 +434,7 @@ void ps2_vif1_device::transfer_vifcode_data()
 	else if (fifo_depth() > 0)
 	{
 		m_code = fifo_pop();
-		logerror("%s: New VIFcode: %08x\n", machine().describe_context(), m_code);
+		LOGMASKED(LOG_CMD, "%s: New VIFcode: %08x\n", machine().describe_context(), m_code);
 		m_status |= STAT_MODE_DECODE;
 		m_icount--;
 	}
@@ -480,7 +487,7 @@ void ps2_vif1_device::transfer_mpg()
 	m_mpg_count--;
 
 	m_vu1->write_micro_mem(m_mpg_addr, m_mpg_insn);
-	logerror("%s: MPG, VU insn: %08x = %08x%08x, %d remaining\n", machine().describe_context(), m_mpg_addr, (uint32_t)(m_mpg_insn >> 32), (uint32_t)m_mpg_insn, m_mpg_count);
+	LOGMASKED(LOG_FIFO, "%s: MPG, VU insn: %08x = %08x%08x, %d remaining\n", machine().describe_context(), m_mpg_addr, (uint32_t)(m_mpg_insn >> 32), (uint32_t)m_mpg_insn, m_mpg_count);
 
 	m_mpg_addr += 8;
 	m_data_needed = m_mpg_count ? 2 : 0;
@@ -495,38 +502,38 @@ void ps2_vif1_device::decode_vifcode()
 	switch (m_command)
 	{
 		case 0x00: /* NOP */
-			logerror("%s: NOP\n", machine().describe_context());
+			LOGMASKED(LOG_CMD, "%s: NOP\n", machine().describe_context());
 			break;
 		case 0x01: /* STCYCL */
 			m_cycle = (uint16_t)m_code;
-			logerror("%s: STCYCL: %04x\n", machine().describe_context(), (uint16_t)m_cycle);
+			LOGMASKED(LOG_CMD, "%s: STCYCL: %04x\n", machine().describe_context(), (uint16_t)m_cycle);
 			break;
 		case 0x02: /* OFFSET */
 			m_offset = m_code & 0x3ff;
-			logerror("%s: OFFSET: %03x\n", machine().describe_context(), m_offset);
+			LOGMASKED(LOG_CMD, "%s: OFFSET: %03x\n", machine().describe_context(), m_offset);
 			break;
 		case 0x03: /* BASE */
 			m_base = m_code & 0x3ff;
-			logerror("%s: BASE: %03x\n", machine().describe_context(), m_base);
+			LOGMASKED(LOG_CMD, "%s: BASE: %03x\n", machine().describe_context(), m_base);
 			break;
 		case 0x04: /* ITOP */
 			m_itops = m_code & 0x3ff;
-			logerror("%s: ITOP: %03x\n", machine().describe_context(), m_itops);
+			LOGMASKED(LOG_CMD, "%s: ITOP: %03x\n", machine().describe_context(), m_itops);
 			break;
 		case 0x05: /* STMOD */
 			m_mode = m_code & 3;
-			logerror("%s: MODE: %03x\n", machine().describe_context(), m_mode);
+			LOGMASKED(LOG_CMD, "%s: MODE: %03x\n", machine().describe_context(), m_mode);
 			break;
 		case 0x06: /* MSKPATH3 */
 			m_gs->interface()->set_path3_mask(BIT(m_code, 15));
-			logerror("%s: MSKPATH3: %d\n", machine().describe_context(), BIT(m_code, 15));
+			LOGMASKED(LOG_CMD, "%s: MSKPATH3: %d\n", machine().describe_context(), BIT(m_code, 15));
 			break;
 		case 0x07: /* Oh hi, MARK */
 			m_mark = (uint16_t)m_code;
-			logerror("%s: MARK: %04x\n", machine().describe_context(), (uint16_t)m_mark);
+			LOGMASKED(LOG_CMD, "%s: MARK: %04x\n", machine().describe_context(), (uint16_t)m_mark);
 			break;
 		case 0x14: /* MSCAL */
-			logerror("%s: MSCAL %04x\n", machine().describe_context(), (uint16_t)m_code);
+			LOGMASKED(LOG_CMD, "%s: MSCAL %04x\n", machine().describe_context(), (uint16_t)m_code);
 			if (m_vu1->running())
 			{
 				m_icount--;
@@ -540,17 +547,17 @@ void ps2_vif1_device::decode_vifcode()
 		case 0x20: /* STMASK */
 			m_data_needed = 1;
 			m_data_index = 0;
-			logerror("%s: STMASK\n", machine().describe_context());
+			LOGMASKED(LOG_CMD, "%s: STMASK\n", machine().describe_context());
 			break;
 		case 0x30: /* STROW */
 			m_data_needed = 4;
 			m_data_index = 0;
-			logerror("%s: STROW\n", machine().describe_context());
+			LOGMASKED(LOG_CMD, "%s: STROW\n", machine().describe_context());
 			break;
 		case 0x31: /* STCOL */
 			m_data_needed = 4;
 			m_data_index = 0;
-			logerror("%s: STCOL\n", machine().describe_context());
+			LOGMASKED(LOG_CMD, "%s: STCOL\n", machine().describe_context());
 			break;
 		case 0x4a: /* MPG */
 			m_data_needed = 2 + (m_alignment & 1);
@@ -559,7 +566,7 @@ void ps2_vif1_device::decode_vifcode()
 			if (!m_mpg_count)
 				m_mpg_count = 0x100;
 			m_mpg_addr = m_code & 0xffff;
-			logerror("%s: MPG\n", machine().describe_context());
+			LOGMASKED(LOG_CMD, "%s: MPG\n", machine().describe_context());
 			break;
 		default:
 			if ((m_command & 0x60) == 0x60)
@@ -569,7 +576,7 @@ void ps2_vif1_device::decode_vifcode()
 				m_unpack_add_tops = BIT(m_code, 15);
 				m_unpack_format = (uint8_t)(m_command & 0xf);
 				m_data_needed = FORMAT_SIZE[m_unpack_format];
-				logerror("%s: UNPACK (%08x), count %d\n", machine().describe_context(), m_code, m_unpack_count);
+				LOGMASKED(LOG_CMD, "%s: UNPACK (%08x), count %d\n", machine().describe_context(), m_code, m_unpack_count);
 			}
 			else
 			{ /* unknown */
@@ -243,6 +243,7 @@ public:
 	void ppccom_execute_mfspr();
 	void ppccom_execute_mftb();
 	void ppccom_execute_mtspr();
+	void ppccom_execute_mtsr();
 	void ppccom_tlb_flush();
 	void ppccom_execute_mfdcr();
 	void ppccom_execute_mtdcr();
@@ -655,7 +656,8 @@ protected:
 	uint32_t compute_crf_mask(uint8_t crm);
 	uint32_t compute_spr(uint32_t spr);
 	void code_flush_cache();
-	void code_compile_block(uint8_t mode, offs_t pc);
+	void code_compile_block(uint8_t mode, offs_t pc, bool remember);
+	void code_compile_cached_blocks();
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
@@ -1148,6 +1148,8 @@ void ppc_device::state_string_export(const device_state_entry &entry, std::strin
 
 void ppc_device::device_stop()
 {
+	/* save the list of compiled blocks for the next run */
+	m_drcuml->block_cache_save();
 }
 
 
@@ -1538,6 +1540,24 @@ void ppc_device::ppccom_execute_tlbia()
 }
 
 
+/*-------------------------------------------------
+    ppccom_execute_mtsr - execute an MTSR or
+    MTSRIN instruction
+-------------------------------------------------*/
+
+void ppc_device::ppccom_execute_mtsr()
+{
+	int segnum = m_core->param0 & 15;
+	uint32_t oldval = m_core->sr[segnum];
+
+	m_core->sr[segnum] = m_core->param1;
+
+	/* the TLB is tagged by segment register, so keep the outgoing translations
+	   around for when the segment comes back; PTE changes require TLBIE/TLBIA */
+	vtlb_switch_region(segnum << 28, 0x10000000, oldval, m_core->param1);
+}
+
+
 /*-------------------------------------------------
     ppccom_execute_tlbl - execute a TLBLD/TLBLI
     instruction
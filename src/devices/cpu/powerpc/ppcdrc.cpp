@@ -228,7 +228,10 @@ void ppc_device::execute_run()
 
 	/* reset the cache if dirty */
 	if (m_cache_dirty)
+	{
 		code_flush_cache();
+		code_compile_cached_blocks();
+	}
 	m_cache_dirty = false;
 
 	/* execute */
@@ -239,7 +242,7 @@ void ppc_device::execute_run()
 
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
-			code_compile_block(m_core->mode, m_core->pc);
+			code_compile_block(m_core->mode, m_core->pc, true);
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
 		else if (execute_result == EXECUTE_RESET_CACHE)
@@ -374,7 +377,7 @@ void ppc_device::code_flush_cache()
     given mode at the specified pc
 -------------------------------------------------*/
 
-void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
+void ppc_device::code_compile_block(uint8_t mode, offs_t pc, bool remember)
 {
 	compiler_state compiler = { 0 };
 	const opcode_desc *seqhead, *seqlast;
@@ -473,6 +476,40 @@ void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
 			code_flush_cache();
 		}
 	}
+
+	/* remember blocks compiled on demand for the next flush or run */
+	if (remember)
+		m_drcuml->block_cache_record(mode, pc, drc_frontend::code_hash(desclist));
+}
+
+
+/*-------------------------------------------------
+    code_compile_cached_blocks - precompile the
+    blocks remembered from a previous run whose
+    code is unchanged
+-------------------------------------------------*/
+
+void ppc_device::code_compile_cached_blocks()
+{
+	if (!m_drcuml->block_cache_enabled())
+		return;
+
+	for (const drcuml_cached_block &cached : m_drcuml->block_cache_entries())
+	{
+		/* skip anything already covered, and forget anything whose code has changed */
+		if (m_drcuml->hash_exists(cached.mode, cached.pc))
+			continue;
+		if (drc_frontend::code_hash(m_drcfe->describe_code(cached.pc)) != cached.codehash)
+		{
+			m_drcuml->block_cache_forget(cached.mode, cached.pc);
+			continue;
+		}
+
+		/* precompiling doesn't count as use, so blocks that stop running age out */
+		code_compile_block(cached.mode, cached.pc, false);
+		if (!m_drcuml->hash_exists(cached.mode, cached.pc))
+			m_drcuml->block_cache_forget(cached.mode, cached.pc);
+	}
 }
 
 
@@ -632,10 +669,10 @@ static void cfunc_ppccom_execute_mtspr(void *param)
 	ppc->ppccom_execute_mtspr();
 }
 
-static void cfunc_ppccom_tlb_flush(void *param)
+static void cfunc_ppccom_execute_mtsr(void *param)
 {
 	ppc_device *ppc = (ppc_device *)param;
-	ppc->ppccom_tlb_flush();
+	ppc->ppccom_execute_mtsr();
 }
 
 static void cfunc_ppccom_execute_mfdcr(void *param)
@@ -3407,14 +3444,15 @@ bool ppc_device::generate_instruction_1f(drcuml_block &block, compiler_state *co
 		}
 
 		case 0x0d2: /* MTSR */
-			UML_MOV(block, SR32(G_SR(op)), R32(G_RS(op)));                                  // mov     sr[G_SR],rs
-			UML_CALLC(block, (c_function)cfunc_ppccom_tlb_flush, this);                                        // callc   ppccom_tlb_flush,ppc
+			UML_MOV(block, mem(&m_core->param0), G_SR(op));                                 // mov     [param0],G_SR
+			UML_MOV(block, mem(&m_core->param1), R32(G_RS(op)));                           // mov     [param1],rs
+			UML_CALLC(block, (c_function)cfunc_ppccom_execute_mtsr, this);                                     // callc   ppccom_execute_mtsr,ppc
 			return true;
 
 		case 0x0f2: /* MTSRIN */
-			UML_SHR(block, I0, R32(G_RB(op)), 28);                              // shr     i0,G_RB,28
-			UML_STORE(block, &m_core->sr[0], I0, R32(G_RS(op)), SIZE_DWORD, SCALE_x4); // store   sr,i0,rs,dword
-			UML_CALLC(block, (c_function)cfunc_ppccom_tlb_flush, this);                            // callc   ppccom_tlb_flush,ppc
+			UML_SHR(block, mem(&m_core->param0), R32(G_RB(op)), 28);            // shr     [param0],G_RB,28
+			UML_MOV(block, mem(&m_core->param1), R32(G_RS(op)));                           // mov     [param1],rs
+			UML_CALLC(block, (c_function)cfunc_ppccom_execute_mtsr, this);                         // callc   ppccom_execute_mtsr,ppc
 			return true;
 
 		case 0x200: /* MCRXR */
@@ -11,9 +11,12 @@
 
 #include "rspdefs.h"
 #include "rspdiv.h"
+#include "rspfe.h"
 
 #include "rsp_dasm.h"
 
+#include "emuopts.h"
+
 DEFINE_DEVICE_TYPE(RSP, rsp_device, "rsp", "Nintendo & SGI Reality Signal Processor RSP")
 
 
@@ -33,12 +36,12 @@ DEFINE_DEVICE_TYPE(RSP, rsp_device, "rsp", "Nintendo & SGI Reality Signal Proces
 #define UIMM16      ((uint16_t)(op))
 #define UIMM26      (op & 0x03ffffff)
 
-#define JUMP_ABS(addr)          { m_nextpc = (addr) << 2; }
-#define JUMP_ABS_L(addr,l)      { m_nextpc = (addr) << 2; m_r[l] = m_pc + 4; }
-#define JUMP_REL(offset)        { m_nextpc = m_pc + ((offset) << 2); }
-#define JUMP_REL_L(offset,l)    { m_nextpc = m_pc + ((offset) << 2); m_r[l] = m_pc + 4; }
-#define JUMP_PC(addr)           { m_nextpc = addr; }
-#define JUMP_PC_L(addr,l)       { m_nextpc = addr; m_r[l] = m_pc + 4; }
+#define JUMP_ABS(addr)          { m_core->nextpc = (addr) << 2; }
+#define JUMP_ABS_L(addr,l)      { m_core->nextpc = (addr) << 2; m_core->r[l] = m_core->pc + 4; }
+#define JUMP_REL(offset)        { m_core->nextpc = m_core->pc + ((offset) << 2); }
+#define JUMP_REL_L(offset,l)    { m_core->nextpc = m_core->pc + ((offset) << 2); m_core->r[l] = m_core->pc + 4; }
+#define JUMP_PC(addr)           { m_core->nextpc = addr; }
+#define JUMP_PC_L(addr,l)       { m_core->nextpc = addr; m_core->r[l] = m_core->pc + 4; }
 
 #define ROPCODE(pc)             m_icache.read_dword(pc & 0xfff)
 
@@ -113,11 +116,8 @@ rsp_device::rsp_device(const machine_config &mconfig, const char *tag, device_t
 	: cpu_device(mconfig, RSP, tag, owner, clock)
 	, m_imem_config("imem", ENDIANNESS_BIG, 32, 12)
 	, m_dmem_config("dmem", ENDIANNESS_BIG, 32, 12)
+	, m_core(nullptr)
 	, m_exec_output(nullptr)
-	, m_sr(0)
-	, m_step_count(0)
-	, m_ppc(0)
-	, m_nextpc(0xffff)
 	, m_debugger_temp(0)
 	, m_pc_temp(0)
 	, m_ppc_temp(0)
@@ -127,6 +127,17 @@ rsp_device::rsp_device(const machine_config &mconfig, const char *tag, device_t
 	, m_sp_reg_r_func(*this, 0)
 	, m_sp_reg_w_func(*this)
 	, m_sp_set_status_func(*this)
+	, m_drccache()
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_drcoptions(0)
+	, m_cache_dirty(true)
+	, m_enable_drc(false)
+	, m_imem_base(nullptr)
+	, m_dmem_base(nullptr)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
 {
 }
 
@@ -213,8 +224,8 @@ void rsp_device::unimplemented_opcode(uint32_t op)
 	{
 		std::ostringstream string;
 		rsp_disassembler rspd;
-		rspd.dasm_one(string, m_ppc, op);
-		osd_printf_debug("%08X: %s\n", m_ppc, string.str());
+		rspd.dasm_one(string, m_core->ppc, op);
+		osd_printf_debug("%08X: %s\n", m_core->ppc, string.str());
 	}
 
 #if SAVE_DISASM
@@ -247,7 +258,7 @@ void rsp_device::unimplemented_opcode(uint32_t op)
 	}
 #endif
 
-	fatalerror("RSP: unknown opcode %02X (%08X) at %08X\n", op >> 26, op, m_ppc);
+	fatalerror("RSP: unknown opcode %02X (%08X) at %08X\n", op >> 26, op, m_core->ppc);
 }
 
 /*****************************************************************************/
@@ -262,8 +273,52 @@ void rsp_device::device_start()
 	space(AS_DATA).cache(m_dcache);
 	space(AS_DATA).specific(m_dmem);
 
+	/* the recompiler is opt-in; it validates IMEM and accesses DMEM directly, so both must be backed by RAM */
+	m_imem_base = (uint32_t *)space(AS_PROGRAM).get_read_ptr(0);
+	m_dmem_base = (uint8_t *)space(AS_DATA).get_write_ptr(0);
+	m_enable_drc = allow_drc() && machine().options().drc_rsp() && m_imem_base != nullptr && m_dmem_base != nullptr;
+
+	/* recompiled code addresses the core state in the near cache; the interpreter doesn't need a cache at all */
+	if (m_enable_drc)
+	{
+		m_drccache = std::make_unique<drc_cache>(CACHE_SIZE + sizeof(internal_rsp_state));
+		m_core = (internal_rsp_state *)m_drccache->alloc_near(sizeof(internal_rsp_state));
+	}
+	else
+	{
+		m_core_storage = std::make_unique<internal_rsp_state>();
+		m_core = m_core_storage.get();
+	}
+	memset(m_core, 0, sizeof(internal_rsp_state));
+
+	if (m_enable_drc)
+	{
+		/* initialize the UML generator */
+		m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 1, 12, 2);
+
+		/* add symbols for our stuff */
+		m_drcuml->symbol_add(&m_core->pc, sizeof(m_core->pc), "pc");
+		m_drcuml->symbol_add(&m_core->icount, sizeof(m_core->icount), "icount");
+		for (int regnum = 0; regnum < 32; regnum++)
+		{
+			char buf[10];
+			snprintf(buf, 10, "r%d", regnum);
+			m_drcuml->symbol_add(&m_core->r[regnum], sizeof(m_core->r[regnum]), buf);
+		}
+		m_drcuml->symbol_add(&m_core->sr, sizeof(m_core->sr), "sr");
+		m_drcuml->symbol_add(&m_core->arg0, sizeof(m_core->arg0), "arg0");
+		m_drcuml->symbol_add(&m_core->arg1, sizeof(m_core->arg1), "arg1");
+		m_drcuml->symbol_add(&m_core->jmpdest, sizeof(m_core->jmpdest), "jmpdest");
+
+		/* initialize the front-end helper */
+		m_drcfe = std::make_unique<rsp_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+
+		/* mark the cache dirty so it is updated on next execute */
+		m_cache_dirty = true;
+	}
+
 	for (int regIdx = 0; regIdx < 32; regIdx++)
-		m_r[regIdx] = 0;
+		m_core->r[regIdx] = 0;
 
 	for(auto & elem : m_v)
 	{
@@ -289,47 +344,47 @@ void rsp_device::device_start()
 		elem.q = 0;
 	}
 
-	m_pc = 0;
-	m_nextpc = 0xffff;
-	m_sr = RSP_STATUS_HALT;
-	m_step_count = 0;
-
-	state_add( RSP_PC,      "PC", m_pc).callimport().callexport().formatstr("%08X");
-	state_add( RSP_R0,      "R0", m_r[0]).formatstr("%08X");
-	state_add( RSP_R1,      "R1", m_r[1]).formatstr("%08X");
-	state_add( RSP_R2,      "R2", m_r[2]).formatstr("%08X");
-	state_add( RSP_R3,      "R3", m_r[3]).formatstr("%08X");
-	state_add( RSP_R4,      "R4", m_r[4]).formatstr("%08X");
-	state_add( RSP_R5,      "R5", m_r[5]).formatstr("%08X");
-	state_add( RSP_R6,      "R6", m_r[6]).formatstr("%08X");
-	state_add( RSP_R7,      "R7", m_r[7]).formatstr("%08X");
-	state_add( RSP_R8,      "R8", m_r[8]).formatstr("%08X");
-	state_add( RSP_R9,      "R9", m_r[9]).formatstr("%08X");
-	state_add( RSP_R10,     "R10", m_r[10]).formatstr("%08X");
-	state_add( RSP_R11,     "R11", m_r[11]).formatstr("%08X");
-	state_add( RSP_R12,     "R12", m_r[12]).formatstr("%08X");
-	state_add( RSP_R13,     "R13", m_r[13]).formatstr("%08X");
-	state_add( RSP_R14,     "R14", m_r[14]).formatstr("%08X");
-	state_add( RSP_R15,     "R15", m_r[15]).formatstr("%08X");
-	state_add( RSP_R16,     "R16", m_r[16]).formatstr("%08X");
-	state_add( RSP_R17,     "R17", m_r[17]).formatstr("%08X");
-	state_add( RSP_R18,     "R18", m_r[18]).formatstr("%08X");
-	state_add( RSP_R19,     "R19", m_r[19]).formatstr("%08X");
-	state_add( RSP_R20,     "R20", m_r[20]).formatstr("%08X");
-	state_add( RSP_R21,     "R21", m_r[21]).formatstr("%08X");
-	state_add( RSP_R22,     "R22", m_r[22]).formatstr("%08X");
-	state_add( RSP_R23,     "R23", m_r[23]).formatstr("%08X");
-	state_add( RSP_R24,     "R24", m_r[24]).formatstr("%08X");
-	state_add( RSP_R25,     "R25", m_r[25]).formatstr("%08X");
-	state_add( RSP_R26,     "R26", m_r[26]).formatstr("%08X");
-	state_add( RSP_R27,     "R27", m_r[27]).formatstr("%08X");
-	state_add( RSP_R28,     "R28", m_r[28]).formatstr("%08X");
-	state_add( RSP_R29,     "R29", m_r[29]).formatstr("%08X");
-	state_add( RSP_R30,     "R30", m_r[30]).formatstr("%08X");
-	state_add( RSP_R31,     "R31", m_r[31]).formatstr("%08X");
-	state_add( RSP_SR,      "SR",  m_sr).formatstr("%08X");
-	state_add( RSP_NEXTPC,  "NPC", m_nextpc).callimport().callexport().formatstr("%04X");
-	state_add( RSP_STEPCNT, "STEP",  m_step_count).formatstr("%08X");
+	m_core->pc = 0;
+	m_core->nextpc = 0xffff;
+	m_core->sr = RSP_STATUS_HALT;
+	m_core->step_count = 0;
+
+	state_add( RSP_PC,      "PC", m_core->pc).callimport().callexport().formatstr("%08X");
+	state_add( RSP_R0,      "R0", m_core->r[0]).formatstr("%08X");
+	state_add( RSP_R1,      "R1", m_core->r[1]).formatstr("%08X");
+	state_add( RSP_R2,      "R2", m_core->r[2]).formatstr("%08X");
+	state_add( RSP_R3,      "R3", m_core->r[3]).formatstr("%08X");
+	state_add( RSP_R4,      "R4", m_core->r[4]).formatstr("%08X");
+	state_add( RSP_R5,      "R5", m_core->r[5]).formatstr("%08X");
+	state_add( RSP_R6,      "R6", m_core->r[6]).formatstr("%08X");
+	state_add( RSP_R7,      "R7", m_core->r[7]).formatstr("%08X");
+	state_add( RSP_R8,      "R8", m_core->r[8]).formatstr("%08X");
+	state_add( RSP_R9,      "R9", m_core->r[9]).formatstr("%08X");
+	state_add( RSP_R10,     "R10", m_core->r[10]).formatstr("%08X");
+	state_add( RSP_R11,     "R11", m_core->r[11]).formatstr("%08X");
+	state_add( RSP_R12,     "R12", m_core->r[12]).formatstr("%08X");
+	state_add( RSP_R13,     "R13", m_core->r[13]).formatstr("%08X");
+	state_add( RSP_R14,     "R14", m_core->r[14]).formatstr("%08X");
+	state_add( RSP_R15,     "R15", m_core->r[15]).formatstr("%08X");
+	state_add( RSP_R16,     "R16", m_core->r[16]).formatstr("%08X");
+	state_add( RSP_R17,     "R17", m_core->r[17]).formatstr("%08X");
+	state_add( RSP_R18,     "R18", m_core->r[18]).formatstr("%08X");
+	state_add( RSP_R19,     "R19", m_core->r[19]).formatstr("%08X");
+	state_add( RSP_R20,     "R20", m_core->r[20]).formatstr("%08X");
+	state_add( RSP_R21,     "R21", m_core->r[21]).formatstr("%08X");
+	state_add( RSP_R22,     "R22", m_core->r[22]).formatstr("%08X");
+	state_add( RSP_R23,     "R23", m_core->r[23]).formatstr("%08X");
+	state_add( RSP_R24,     "R24", m_core->r[24]).formatstr("%08X");
+	state_add( RSP_R25,     "R25", m_core->r[25]).formatstr("%08X");
+	state_add( RSP_R26,     "R26", m_core->r[26]).formatstr("%08X");
+	state_add( RSP_R27,     "R27", m_core->r[27]).formatstr("%08X");
+	state_add( RSP_R28,     "R28", m_core->r[28]).formatstr("%08X");
+	state_add( RSP_R29,     "R29", m_core->r[29]).formatstr("%08X");
+	state_add( RSP_R30,     "R30", m_core->r[30]).formatstr("%08X");
+	state_add( RSP_R31,     "R31", m_core->r[31]).formatstr("%08X");
+	state_add( RSP_SR,      "SR",  m_core->sr).formatstr("%08X");
+	state_add( RSP_NEXTPC,  "NPC", m_core->nextpc).callimport().callexport().formatstr("%04X");
+	state_add( RSP_STEPCNT, "STEP",  m_core->step_count).formatstr("%08X");
 
 	state_add( RSP_V0,      "V0",  m_debugger_temp).formatstr("%39s");
 	state_add( RSP_V1,      "V1",  m_debugger_temp).formatstr("%39s");
@@ -364,11 +419,11 @@ void rsp_device::device_start()
 	state_add( RSP_V30,     "V30", m_debugger_temp).formatstr("%39s");
 	state_add( RSP_V31,     "V31", m_debugger_temp).formatstr("%39s");
 
-	state_add( STATE_GENPC, "GENPC", m_pc).noshow();
-	state_add( STATE_GENPCBASE, "CURPC", m_pc).noshow();
-	state_add( STATE_GENFLAGS, "GENFLAGS", m_r[31]).formatstr("%1s").noshow();
+	state_add( STATE_GENPC, "GENPC", m_core->pc).noshow();
+	state_add( STATE_GENPCBASE, "CURPC", m_core->pc).noshow();
+	state_add( STATE_GENFLAGS, "GENFLAGS", m_core->r[31]).formatstr("%1s").noshow();
 
-	set_icountptr(m_icount);
+	set_icountptr(m_core->icount);
 }
 
 void rsp_device::state_import(const device_state_entry &entry)
@@ -377,15 +432,15 @@ void rsp_device::state_import(const device_state_entry &entry)
 	{
 		case STATE_GENPC:
 		case RSP_PC:
-			m_pc = (uint16_t)m_pc_temp;
+			m_core->pc = (uint16_t)m_pc_temp;
 			break;
 
 		case STATE_GENPCBASE:
-			m_ppc = (uint16_t)m_ppc_temp;
+			m_core->ppc = (uint16_t)m_ppc_temp;
 			break;
 
 		case RSP_NEXTPC:
-			m_nextpc = (uint16_t)m_nextpc_temp;
+			m_core->nextpc = (uint16_t)m_nextpc_temp;
 			break;
 	}
 }
@@ -397,15 +452,15 @@ void rsp_device::state_export(const device_state_entry &entry)
 	{
 		case STATE_GENPC:
 		case RSP_PC:
-			m_pc_temp = m_pc;
+			m_pc_temp = m_core->pc;
 			break;
 
 		case STATE_GENPCBASE:
-			m_ppc_temp = m_ppc;
+			m_ppc_temp = m_core->ppc;
 			break;
 
 		case RSP_NEXTPC:
-			m_nextpc_temp = m_nextpc;
+			m_nextpc_temp = m_core->nextpc;
 			break;
 	}
 }
@@ -523,7 +578,7 @@ void rsp_device::device_stop()
 
 void rsp_device::device_reset()
 {
-	m_nextpc = 0xffff;
+	m_core->nextpc = 0xffff;
 }
 
 uint16_t rsp_device::SATURATE_ACCUM(int accum, int slice, uint16_t negative, uint16_t positive)
@@ -2147,7 +2202,7 @@ void rsp_device::handle_cop2(uint32_t op)
 			int el = (op >> 7) & 0xf;
 			uint16_t b1 = VREG_B(RDREG, (el+0) & 0xf);
 			uint16_t b2 = VREG_B(RDREG, (el+1) & 0xf);
-			if (RTREG) m_r[RTREG] = (int32_t)(int16_t)((b1 << 8) | (b2));
+			if (RTREG) m_core->r[RTREG] = (int32_t)(int16_t)((b1 << 8) | (b2));
 			break;
 		}
 
@@ -2163,16 +2218,16 @@ void rsp_device::handle_cop2(uint32_t op)
 				switch (RDREG)
 				{
 					case 0:
-						m_r[RTREG] = (m_vzero << 8) | m_vcarry;
-						if (m_r[RTREG] & 0x8000) m_r[RTREG] |= 0xffff0000;
+						m_core->r[RTREG] = (m_vzero << 8) | m_vcarry;
+						if (m_core->r[RTREG] & 0x8000) m_core->r[RTREG] |= 0xffff0000;
 						break;
 					case 1:
-						m_r[RTREG] = (m_vclip2 << 8) | m_vcompare;
-						if (m_r[RTREG] & 0x8000) m_r[RTREG] |= 0xffff0000;
+						m_core->r[RTREG] = (m_vclip2 << 8) | m_vcompare;
+						if (m_core->r[RTREG] & 0x8000) m_core->r[RTREG] |= 0xffff0000;
 						break;
 					case 2:
 						// Anciliary clipping flags
-						m_r[RTREG] = m_vclip1;
+						m_core->r[RTREG] = m_vclip1;
 						break;
 				}
 			}
@@ -2187,8 +2242,8 @@ void rsp_device::handle_cop2(uint32_t op)
 			// ---------------------------------------------------
 
 			int el = (op >> 7) & 0xf;
-			W_VREG_B(RDREG, (el+0) & 0xf, (m_r[RTREG] >> 8) & 0xff);
-			W_VREG_B(RDREG, (el+1) & 0xf, (m_r[RTREG] >> 0) & 0xff);
+			W_VREG_B(RDREG, (el+0) & 0xf, (m_core->r[RTREG] >> 8) & 0xff);
+			W_VREG_B(RDREG, (el+1) & 0xf, (m_core->r[RTREG] >> 0) & 0xff);
 			break;
 		}
 
@@ -2202,17 +2257,17 @@ void rsp_device::handle_cop2(uint32_t op)
 			switch (RDREG)
 			{
 				case 0:
-					m_vcarry = (uint8_t)m_r[RTREG];
-					m_vzero = (uint8_t)(m_r[RTREG] >> 8);
+					m_vcarry = (uint8_t)m_core->r[RTREG];
+					m_vzero = (uint8_t)(m_core->r[RTREG] >> 8);
 					break;
 
 				case 1:
-					m_vcompare = (uint8_t)m_r[RTREG];
-					m_vclip2 = (uint8_t)(m_r[RTREG] >> 8);
+					m_vcompare = (uint8_t)m_core->r[RTREG];
+					m_vclip2 = (uint8_t)(m_core->r[RTREG] >> 8);
 					break;
 
 				case 2:
-					m_vclip1 = (uint8_t)m_r[RTREG];
+					m_vclip1 = (uint8_t)m_core->r[RTREG];
 					break;
 			}
 			break;
@@ -2247,7 +2302,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Load 1 byte to vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + offset : offset;
+			uint32_t ea = (base) ? m_core->r[base] + offset : offset;
 			VREG_B(dest, index) = read_dmem_byte(ea);
 			break;
 		}
@@ -2261,7 +2316,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads 2 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 2) : (offset * 2);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 2) : (offset * 2);
 
 			for (int i = index; i < index + 2; i++)
 			{
@@ -2280,7 +2335,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads 4 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 4) : (offset * 4);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 4) : (offset * 4);
 
 			for (int i = index; i < index + 4; i++)
 			{
@@ -2299,7 +2354,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads 8 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = index; i < index + 8; i++)
 			{
@@ -2318,7 +2373,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads up to 16 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			int end = index + (16 - (ea & 0xf));
 			if (end > 16) end = 16;
@@ -2340,7 +2395,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Stores up to 16 bytes starting from right side until 16-byte boundary
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			index = 16 - ((ea & 0xf) - index);
 			ea &= ~0xf;
@@ -2362,7 +2417,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads a byte as the upper 8 bits of each element
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = 0; i < 8; i++)
 			{
@@ -2380,7 +2435,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads a byte as the bits 14-7 of each element
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = 0; i < 8; i++)
 			{
@@ -2398,7 +2453,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads a byte as the bits 14-7 of each element, with 2-byte stride
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			for (int i = 0; i < 8; i++)
 			{
@@ -2416,7 +2471,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads a byte as the bits 14-7 of upper or lower quad, with 4-byte stride
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			// NOTE: Not sure what happens if 16-byte boundary is crossed
 
@@ -2447,7 +2502,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			// Hardware testing has proven that the vector index is ignored when executing LWV.
 			// By contrast, SWV will function as intended when provided an index.
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			for (int i = 0; i < 16; i++)
 			{
@@ -2475,7 +2530,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 
 			if (index & 1)  fatalerror("RSP: LTV: index = %d\n", index);
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 			ea = ((ea + 8) & ~0xf) + (index & 1);
 
 			for (int32_t i = vs; i < ve; i++)
@@ -2520,7 +2575,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores 1 byte from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + offset : offset;
+			uint32_t ea = (base) ? m_core->r[base] + offset : offset;
 			write_dmem_byte(ea, VREG_B(dest, index));
 			break;
 		}
@@ -2534,7 +2589,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores 2 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 2) : (offset * 2);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 2) : (offset * 2);
 
 			for (int i = index; i < index + 2; i++)
 			{
@@ -2553,7 +2608,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores 4 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 4) : (offset * 4);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 4) : (offset * 4);
 
 			for (int i = index; i < index + 4; i++)
 			{
@@ -2572,7 +2627,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores 8 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = index; i < index + 8; i++)
 			{
@@ -2591,7 +2646,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores up to 16 bytes starting from vector byte index until 16-byte boundary
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 			int end = index + (16 - (ea & 0xf));
 
 			for (int i = index; i < end; i++)
@@ -2611,7 +2666,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores up to 16 bytes starting from right side until 16-byte boundary
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			int end = index + (ea & 0xf);
 			int o = (16 - (ea & 0xf)) & 0xf;
@@ -2634,7 +2689,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores upper 8 bits of each element
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = index; i < index + 8; i++)
 			{
@@ -2660,7 +2715,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores bits 14-7 of each element
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = index; i < index + 8; i++)
 			{
@@ -2686,7 +2741,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores bits 14-7 of each element, with 2-byte stride
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			for (int i = 0; i < 8; i++)
 			{
@@ -2710,7 +2765,7 @@ void rsp_device::handle_swc2(uint32_t op)
 
 			// FIXME: only works for index 0 and index 8
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			int eaoffset = ea & 0xf;
 			ea &= ~0xf;
@@ -2735,7 +2790,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			// Stores the full 128-bit vector starting from vector byte index and wrapping to index 0
 			// after byte index 15
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			int eaoffset = ea & 0xf;
 			ea &= ~0xf;
@@ -2764,7 +2819,7 @@ void rsp_device::handle_swc2(uint32_t op)
 
 			int32_t element = 8 - (index >> 1);
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_core->r[base] + (offset * 16) : (offset * 16);
 
 			int32_t eaoffset = (ea & 0xf) + (element * 2);
 			ea &= ~0xf;
@@ -2838,29 +2893,38 @@ void rsp_device::update_vector_op_deduction()
 
 void rsp_device::execute_run()
 {
-	if (m_sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
+	/* the recompiler doesn't track delay slots across timeslices or count single steps */
+	if (m_enable_drc && m_core->nextpc == 0xffff && !(m_core->sr & RSP_STATUS_SSTEP))
+		execute_run_drc();
+	else
+		execute_run_interpreter();
+}
+
+void rsp_device::execute_run_interpreter()
+{
+	if (m_core->sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
 	{
 		m_ideduct = 0;
 		m_scalar_busy = false;
 		m_vector_busy = false;
 		m_paired_busy = false;
-		m_icount = std::min(m_icount, 0);
+		m_core->icount = std::min(m_core->icount, 0);
 	}
 
-	while (m_icount > 0)
+	while (m_core->icount > 0)
 	{
-		m_ppc = m_pc;
-		debugger_instruction_hook(m_pc);
+		m_core->ppc = m_core->pc;
+		debugger_instruction_hook(m_core->pc);
 
-		uint32_t op = ROPCODE(m_pc);
-		if (m_nextpc != 0xffff)
+		uint32_t op = ROPCODE(m_core->pc);
+		if (m_core->nextpc != 0xffff)
 		{
-			m_pc = m_nextpc;
-			m_nextpc = 0xffff;
+			m_core->pc = m_core->nextpc;
+			m_core->nextpc = 0xffff;
 		}
 		else
 		{
-			m_pc += 4;
+			m_core->pc += 4;
 		}
 
 		switch (op >> 26)
@@ -2870,14 +2934,14 @@ void rsp_device::execute_run()
 				update_scalar_op_deduction();
 				switch (op & 0x3f)
 				{
-					case 0x00:  /* SLL */       if (RDREG) m_r[RDREG] = m_r[RTREG] << SHIFT; break;
-					case 0x02:  /* SRL */       if (RDREG) m_r[RDREG] = m_r[RTREG] >> SHIFT; break;
-					case 0x03:  /* SRA */       if (RDREG) m_r[RDREG] = (int32_t)m_r[RTREG] >> SHIFT; break;
-					case 0x04:  /* SLLV */      if (RDREG) m_r[RDREG] = m_r[RTREG] << (m_r[RSREG] & 0x1f); break;
-					case 0x06:  /* SRLV */      if (RDREG) m_r[RDREG] = m_r[RTREG] >> (m_r[RSREG] & 0x1f); break;
-					case 0x07:  /* SRAV */      if (RDREG) m_r[RDREG] = (int32_t)m_r[RTREG] >> (m_r[RSREG] & 0x1f); break;
-					case 0x08:  /* JR */        JUMP_PC(m_r[RSREG]); break;
-					case 0x09:  /* JALR */      JUMP_PC_L(m_r[RSREG], RDREG); break;
+					case 0x00:  /* SLL */       if (RDREG) m_core->r[RDREG] = m_core->r[RTREG] << SHIFT; break;
+					case 0x02:  /* SRL */       if (RDREG) m_core->r[RDREG] = m_core->r[RTREG] >> SHIFT; break;
+					case 0x03:  /* SRA */       if (RDREG) m_core->r[RDREG] = (int32_t)m_core->r[RTREG] >> SHIFT; break;
+					case 0x04:  /* SLLV */      if (RDREG) m_core->r[RDREG] = m_core->r[RTREG] << (m_core->r[RSREG] & 0x1f); break;
+					case 0x06:  /* SRLV */      if (RDREG) m_core->r[RDREG] = m_core->r[RTREG] >> (m_core->r[RSREG] & 0x1f); break;
+					case 0x07:  /* SRAV */      if (RDREG) m_core->r[RDREG] = (int32_t)m_core->r[RTREG] >> (m_core->r[RSREG] & 0x1f); break;
+					case 0x08:  /* JR */        JUMP_PC(m_core->r[RSREG]); break;
+					case 0x09:  /* JALR */      JUMP_PC_L(m_core->r[RSREG], RDREG); break;
 					case 0x0d:  /* BREAK */
 					{
 						m_ideduct = 1;
@@ -2885,19 +2949,19 @@ void rsp_device::execute_run()
 						m_vector_busy = false;
 						m_paired_busy = false;
 						m_sp_set_status_func(0, 0x3, 0xffffffff);
-						m_icount = std::min(m_icount, 1);
+						m_core->icount = std::min(m_core->icount, 1);
 						break;
 					}
-					case 0x20:  /* ADD */       if (RDREG) m_r[RDREG] = (int32_t)(m_r[RSREG] + m_r[RTREG]); break;
-					case 0x21:  /* ADDU */      if (RDREG) m_r[RDREG] = (int32_t)(m_r[RSREG] + m_r[RTREG]); break;
-					case 0x22:  /* SUB */       if (RDREG) m_r[RDREG] = (int32_t)(m_r[RSREG] - m_r[RTREG]); break;
-					case 0x23:  /* SUBU */      if (RDREG) m_r[RDREG] = (int32_t)(m_r[RSREG] - m_r[RTREG]); break;
-					case 0x24:  /* AND */       if (RDREG) m_r[RDREG] = m_r[RSREG] & m_r[RTREG]; break;
-					case 0x25:  /* OR */        if (RDREG) m_r[RDREG] = m_r[RSREG] | m_r[RTREG]; break;
-					case 0x26:  /* XOR */       if (RDREG) m_r[RDREG] = m_r[RSREG] ^ m_r[RTREG]; break;
-					case 0x27:  /* NOR */       if (RDREG) m_r[RDREG] = ~(m_r[RSREG] | m_r[RTREG]); break;
-					case 0x2a:  /* SLT */       if (RDREG) m_r[RDREG] = (int32_t)m_r[RSREG] < (int32_t)m_r[RTREG]; break;
-					case 0x2b:  /* SLTU */      if (RDREG) m_r[RDREG] = m_r[RSREG] < m_r[RTREG]; break;
+					case 0x20:  /* ADD */       if (RDREG) m_core->r[RDREG] = (int32_t)(m_core->r[RSREG] + m_core->r[RTREG]); break;
+					case 0x21:  /* ADDU */      if (RDREG) m_core->r[RDREG] = (int32_t)(m_core->r[RSREG] + m_core->r[RTREG]); break;
+					case 0x22:  /* SUB */       if (RDREG) m_core->r[RDREG] = (int32_t)(m_core->r[RSREG] - m_core->r[RTREG]); break;
+					case 0x23:  /* SUBU */      if (RDREG) m_core->r[RDREG] = (int32_t)(m_core->r[RSREG] - m_core->r[RTREG]); break;
+					case 0x24:  /* AND */       if (RDREG) m_core->r[RDREG] = m_core->r[RSREG] & m_core->r[RTREG]; break;
+					case 0x25:  /* OR */        if (RDREG) m_core->r[RDREG] = m_core->r[RSREG] | m_core->r[RTREG]; break;
+					case 0x26:  /* XOR */       if (RDREG) m_core->r[RDREG] = m_core->r[RSREG] ^ m_core->r[RTREG]; break;
+					case 0x27:  /* NOR */       if (RDREG) m_core->r[RDREG] = ~(m_core->r[RSREG] | m_core->r[RTREG]); break;
+					case 0x2a:  /* SLT */       if (RDREG) m_core->r[RDREG] = (int32_t)m_core->r[RSREG] < (int32_t)m_core->r[RTREG]; break;
+					case 0x2b:  /* SLTU */      if (RDREG) m_core->r[RDREG] = m_core->r[RSREG] < m_core->r[RTREG]; break;
 					default:    unimplemented_opcode(op); break;
 				}
 				break;
@@ -2908,10 +2972,10 @@ void rsp_device::execute_run()
 				update_scalar_op_deduction();
 				switch (RTREG)
 				{
-					case 0x00:  /* BLTZ */      if ((int32_t)m_r[RSREG] < 0) JUMP_REL(SIMM16); break;
-					case 0x01:  /* BGEZ */      if ((int32_t)m_r[RSREG] >= 0) JUMP_REL(SIMM16); break;
-					case 0x10:  /* BLTZAL */    if ((int32_t)m_r[RSREG] < 0) JUMP_REL_L(SIMM16, 31); break;
-					case 0x11:  /* BGEZAL */    if ((int32_t)m_r[RSREG] >= 0) JUMP_REL_L(SIMM16, 31); break;
+					case 0x00:  /* BLTZ */      if ((int32_t)m_core->r[RSREG] < 0) JUMP_REL(SIMM16); break;
+					case 0x01:  /* BGEZ */      if ((int32_t)m_core->r[RSREG] >= 0) JUMP_REL(SIMM16); break;
+					case 0x10:  /* BLTZAL */    if ((int32_t)m_core->r[RSREG] < 0) JUMP_REL_L(SIMM16, 31); break;
+					case 0x11:  /* BGEZAL */    if ((int32_t)m_core->r[RSREG] >= 0) JUMP_REL_L(SIMM16, 31); break;
 					default:    unimplemented_opcode(op); break;
 				}
 				break;
@@ -2919,26 +2983,26 @@ void rsp_device::execute_run()
 
 			case 0x02:  /* J */         update_scalar_op_deduction(); JUMP_ABS(UIMM26); break;
 			case 0x03:  /* JAL */       update_scalar_op_deduction(); JUMP_ABS_L(UIMM26, 31); break;
-			case 0x04:  /* BEQ */       update_scalar_op_deduction(); if (m_r[RSREG] == m_r[RTREG]) JUMP_REL(SIMM16); break;
-			case 0x05:  /* BNE */       update_scalar_op_deduction(); if (m_r[RSREG] != m_r[RTREG]) JUMP_REL(SIMM16); break;
-			case 0x06:  /* BLEZ */      update_scalar_op_deduction(); if ((int32_t)m_r[RSREG] <= 0) JUMP_REL(SIMM16); break;
-			case 0x07:  /* BGTZ */      update_scalar_op_deduction(); if ((int32_t)m_r[RSREG] > 0) JUMP_REL(SIMM16); break;
-			case 0x08:  /* ADDI */      update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)m_r[RSREG] + SIMM16; break;
-			case 0x09:  /* ADDIU */     update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)m_r[RSREG] + SIMM16; break;
-			case 0x0a:  /* SLTI */      update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)m_r[RSREG] < (int32_t)SIMM16; break;
-			case 0x0b:  /* SLTIU */     update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = m_r[RSREG] < UIMM16; break;
-			case 0x0c:  /* ANDI */      update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = m_r[RSREG] & UIMM16; break;
-			case 0x0d:  /* ORI */       update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = m_r[RSREG] | UIMM16; break;
-			case 0x0e:  /* XORI */      update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = m_r[RSREG] ^ UIMM16; break;
-			case 0x0f:  /* LUI */       update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = UIMM16 << 16; break;
+			case 0x04:  /* BEQ */       update_scalar_op_deduction(); if (m_core->r[RSREG] == m_core->r[RTREG]) JUMP_REL(SIMM16); break;
+			case 0x05:  /* BNE */       update_scalar_op_deduction(); if (m_core->r[RSREG] != m_core->r[RTREG]) JUMP_REL(SIMM16); break;
+			case 0x06:  /* BLEZ */      update_scalar_op_deduction(); if ((int32_t)m_core->r[RSREG] <= 0) JUMP_REL(SIMM16); break;
+			case 0x07:  /* BGTZ */      update_scalar_op_deduction(); if ((int32_t)m_core->r[RSREG] > 0) JUMP_REL(SIMM16); break;
+			case 0x08:  /* ADDI */      update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = (int32_t)m_core->r[RSREG] + SIMM16; break;
+			case 0x09:  /* ADDIU */     update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = (int32_t)m_core->r[RSREG] + SIMM16; break;
+			case 0x0a:  /* SLTI */      update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = (int32_t)m_core->r[RSREG] < (int32_t)SIMM16; break;
+			case 0x0b:  /* SLTIU */     update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = m_core->r[RSREG] < UIMM16; break;
+			case 0x0c:  /* ANDI */      update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = m_core->r[RSREG] & UIMM16; break;
+			case 0x0d:  /* ORI */       update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = m_core->r[RSREG] | UIMM16; break;
+			case 0x0e:  /* XORI */      update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = m_core->r[RSREG] ^ UIMM16; break;
+			case 0x0f:  /* LUI */       update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = UIMM16 << 16; break;
 
 			case 0x10:  /* COP0 */
 			{
 				update_scalar_op_deduction();
 				switch ((op >> 21) & 0x1f)
 				{
-					case 0x00:  /* MFC0 */      if (RTREG) m_r[RTREG] = get_cop0_reg(RDREG); break;
-					case 0x04:  /* MTC0 */      set_cop0_reg(RDREG, m_r[RTREG]); break;
+					case 0x00:  /* MFC0 */      if (RTREG) m_core->r[RTREG] = get_cop0_reg(RDREG); break;
+					case 0x04:  /* MTC0 */      set_cop0_reg(RDREG, m_core->r[RTREG]); break;
 					default:    unimplemented_opcode(op); break;
 				}
 				break;
@@ -2951,14 +3015,14 @@ void rsp_device::execute_run()
 				break;
 			}
 
-			case 0x20:  /* LB */        update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)(int8_t)read_dmem_byte(m_r[RSREG] + SIMM16); break;
-			case 0x21:  /* LH */        update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)(int16_t)read_dmem_word(m_r[RSREG] + SIMM16); break;
-			case 0x23:  /* LW */        update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = read_dmem_dword(m_r[RSREG] + SIMM16); break;
-			case 0x24:  /* LBU */       update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = read_dmem_byte(m_r[RSREG] + SIMM16); break;
-			case 0x25:  /* LHU */       update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = read_dmem_word(m_r[RSREG] + SIMM16); break;
-			case 0x28:  /* SB */        update_scalar_op_deduction(); write_dmem_byte(m_r[RSREG] + SIMM16, m_r[RTREG]); break;
-			case 0x29:  /* SH */        update_scalar_op_deduction(); write_dmem_word(m_r[RSREG] + SIMM16, m_r[RTREG]); break;
-			case 0x2b:  /* SW */        update_scalar_op_deduction(); write_dmem_dword(m_r[RSREG] + SIMM16, m_r[RTREG]); break;
+			case 0x20:  /* LB */        update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = (int32_t)(int8_t)read_dmem_byte(m_core->r[RSREG] + SIMM16); break;
+			case 0x21:  /* LH */        update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = (int32_t)(int16_t)read_dmem_word(m_core->r[RSREG] + SIMM16); break;
+			case 0x23:  /* LW */        update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = read_dmem_dword(m_core->r[RSREG] + SIMM16); break;
+			case 0x24:  /* LBU */       update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = read_dmem_byte(m_core->r[RSREG] + SIMM16); break;
+			case 0x25:  /* LHU */       update_scalar_op_deduction(); if (RTREG) m_core->r[RTREG] = read_dmem_word(m_core->r[RSREG] + SIMM16); break;
+			case 0x28:  /* SB */        update_scalar_op_deduction(); write_dmem_byte(m_core->r[RSREG] + SIMM16, m_core->r[RTREG]); break;
+			case 0x29:  /* SH */        update_scalar_op_deduction(); write_dmem_word(m_core->r[RSREG] + SIMM16, m_core->r[RTREG]); break;
+			case 0x2b:  /* SW */        update_scalar_op_deduction(); write_dmem_dword(m_core->r[RSREG] + SIMM16, m_core->r[RTREG]); break;
 			case 0x32:  /* LWC2 */      update_scalar_op_deduction(); handle_lwc2(op); break;
 			case 0x3a:  /* SWC2 */      update_scalar_op_deduction(); handle_swc2(op); break;
 
@@ -2976,9 +3040,9 @@ void rsp_device::execute_run()
 
 			rsp_disassembler rspd;
 			std::ostringstream string;
-			rspd.dasm_one(string, m_ppc, op);
+			rspd.dasm_one(string, m_core->ppc, op);
 
-			fprintf(m_exec_output, "%08X: %s", m_ppc, string.str().c_str());
+			fprintf(m_exec_output, "%08X: %s", m_core->ppc, string.str().c_str());
 
 			int l = string.str().size();
 			if (l < 36)
@@ -2993,11 +3057,11 @@ void rsp_device::execute_run()
 
 			for (int i = 0; i < 32; i++)
 			{
-				if (m_r[i] != prev_regs[i])
+				if (m_core->r[i] != prev_regs[i])
 				{
-					fprintf(m_exec_output, "R%d: %08X ", i, m_r[i]);
+					fprintf(m_exec_output, "R%d: %08X ", i, m_core->r[i]);
 				}
-				prev_regs[i] = m_r[i];
+				prev_regs[i] = m_core->r[i];
 			}
 
 			for (int i = 0; i < 32; i++)
@@ -3015,28 +3079,28 @@ void rsp_device::execute_run()
 
 		}
 
-		//m_icount -= m_ideduct;
-		--m_icount;
+		//m_core->icount -= m_ideduct;
+		--m_core->icount;
 
-		if (m_sr & RSP_STATUS_SSTEP)
+		if (m_core->sr & RSP_STATUS_SSTEP)
 		{
-			if (m_step_count)
+			if (m_core->step_count)
 			{
-				m_step_count--;
+				m_core->step_count--;
 			}
 			else
 			{
-				m_sr |= RSP_STATUS_BROKE;
+				m_core->sr |= RSP_STATUS_BROKE;
 			}
 		}
 
-		if (m_sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
+		if (m_core->sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
 		{
 			m_ideduct = 0;
 			m_scalar_busy = false;
 			m_vector_busy = false;
 			m_paired_busy = false;
-			m_icount = std::min(m_icount, 0);
+			m_core->icount = std::min(m_core->icount, 0);
 		}
 	}
 }
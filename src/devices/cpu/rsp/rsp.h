@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 /***************************************************************************
     REGISTER ENUMERATION
 ***************************************************************************/
@@ -78,8 +81,12 @@ enum
 #define RSP_STATUS_SIGNAL6       0x2000
 #define RSP_STATUS_SIGNAL7       0x4000
 
+class rsp_frontend;
+
 class rsp_device : public cpu_device
 {
+	friend class rsp_frontend;
+
 	class cop2;
 
 public:
@@ -93,6 +100,18 @@ public:
 	auto sp_reg_w() { return m_sp_reg_w_func.bind(); }
 	auto status_set() { return m_sp_set_status_func.bind(); }
 
+	void ccfunc_read_dmem_word();
+	void ccfunc_read_dmem_dword();
+	void ccfunc_write_dmem_word();
+	void ccfunc_write_dmem_dword();
+	void ccfunc_get_cop0_reg();
+	void ccfunc_set_cop0_reg();
+	void ccfunc_break();
+	void ccfunc_handle_cop2();
+	void ccfunc_handle_lwc2();
+	void ccfunc_handle_swc2();
+	void ccfunc_unimplemented();
+
 protected:
 	// device-level overrides
 	virtual void device_start() override;
@@ -123,9 +142,25 @@ private:
 	address_space_config m_imem_config;
 	address_space_config m_dmem_config;
 
-	uint16_t m_pc;
-	uint32_t m_r[35];
-	int m_icount;
+	/* scalar state, shared with the recompiler and so allocated in the near cache */
+	struct internal_rsp_state
+	{
+		uint32_t pc;
+		uint32_t r[35];
+		int icount;
+		uint32_t sr;
+		uint32_t step_count;
+		uint32_t ppc;
+		uint32_t nextpc;
+
+		/* parameters for subroutines */
+		uint32_t arg0;
+		uint32_t arg1;
+		uint32_t jmpdest;
+	};
+
+	internal_rsp_state *m_core;
+
 	int m_ideduct;
 	bool m_scalar_busy;
 	bool m_vector_busy;
@@ -136,12 +171,6 @@ private:
 
 	FILE *m_exec_output;
 
-	uint32_t m_sr;
-	uint32_t m_step_count;
-
-	uint16_t m_ppc;
-	uint16_t m_nextpc;
-
 protected:
 	memory_access<12, 2, 0, ENDIANNESS_BIG>::cache m_icache;
 	memory_access<12, 2, 0, ENDIANNESS_BIG>::specific m_imem;
@@ -209,6 +238,53 @@ private:
 
 	uint32_t          m_div_in;
 	uint32_t          m_div_out;
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		compiler_state &operator=(compiler_state const &) = delete;
+
+		uint32_t cycles;                    /* accumulated cycles */
+		uml::code_label labelnum;           /* index for local labels */
+	};
+
+	/* core state */
+	std::unique_ptr<drc_cache> m_drccache;
+	std::unique_ptr<internal_rsp_state> m_core_storage;   /* core state when not recompiling */
+	std::unique_ptr<drcuml_state> m_drcuml;
+	std::unique_ptr<rsp_frontend> m_drcfe;
+	uint32_t m_drcoptions;
+	bool m_cache_dirty;
+	bool m_enable_drc;
+
+	/* direct pointers to IMEM (for validation) and DMEM (for scalar loads and stores) */
+	uint32_t *m_imem_base;
+	uint8_t *m_dmem_base;
+
+	/* subroutines */
+	uml::code_handle *m_entry;
+	uml::code_handle *m_nocode;
+	uml::code_handle *m_out_of_cycles;
+
+	void execute_run_interpreter();
+	void execute_run_drc();
+	void code_flush_cache();
+	void code_compile_block(offs_t pc);
+
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception);
+	void generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_delay_slot_and_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint8_t linkreg);
+	void generate_dmem_read(drcuml_block &block, compiler_state &compiler, uml::operand_size size, bool sign);
+	void generate_dmem_write(drcuml_block &block, compiler_state &compiler, uml::operand_size size);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_special(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_regimm(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void log_add_disasm_comment(drcuml_block &block, uint32_t pc, uint32_t op);
 };
 
 DECLARE_DEVICE_TYPE(RSP, rsp_device)
@@ -3,6 +3,16 @@
 #ifndef MAME_CPU_RSP_RSPDEFS_H
 #define MAME_CPU_RSP_RSPDEFS_H
 
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* recompiler exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_RESET_CACHE             3
+
 /***************************************************************************
     HELPER MACROS
 ***************************************************************************/
@@ -0,0 +1,1073 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    rspdrc.cpp
+
+    Universal machine language-based Nintendo/SGI RSP emulator.
+
+****************************************************************************
+
+    Future improvements/changes:
+
+    * Lower the simpler vector operations (VAND/VOR/VXOR, VMRG, VSAR)
+      to inline UML rather than calling out to the interpreter helpers
+
+***************************************************************************/
+
+#include "emu.h"
+#include "rsp.h"
+
+#include "rspdefs.h"
+#include "rspfe.h"
+#include "rsp_dasm.h"
+
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)                m_core->r[reg]
+
+/* map variables */
+#define MAPVAR_PC               M0
+#define MAPVAR_CYCLES           M1
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+static inline void alloc_handle(drcuml_state &drcuml, uml::code_handle *&handleptr, const char *name)
+{
+	if (!handleptr)
+		handleptr = drcuml.handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    ireg - return a parameter for a scalar
+    register, treating r0 as a constant zero
+-------------------------------------------------*/
+
+static inline uml::parameter ireg(uint32_t *regs, int reg)
+{
+	if (reg == 0)
+		return uml::parameter(0);
+	return uml::mem(&regs[reg]);
+}
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    execute_run_drc - execute the RSP through the
+    recompiler until out of cycles
+-------------------------------------------------*/
+
+void rsp_device::execute_run_drc()
+{
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+	m_cache_dirty = false;
+
+	/* a halted or broken RSP burns the rest of its timeslice */
+	if (m_core->sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
+	{
+		m_core->icount = std::min(m_core->icount, 0);
+		return;
+	}
+
+	/* the hash table only covers the 4k of IMEM */
+	m_core->pc &= 0xffc;
+
+	/* execute */
+	int execute_result;
+	do
+	{
+		/* run as much as we can */
+		execute_result = m_drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+			code_compile_block(m_core->pc);
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+			fatalerror("Attempted to execute unmapped code at PC=%03X\n", m_core->pc);
+		else if (execute_result == EXECUTE_RESET_CACHE)
+			code_flush_cache();
+
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
+/***************************************************************************
+    C FUNCTION CALLBACKS
+***************************************************************************/
+
+void rsp_device::ccfunc_read_dmem_word()
+{
+	m_core->arg1 = read_dmem_word(m_core->arg0);
+}
+
+static void cfunc_read_dmem_word(void *param)
+{
+	((rsp_device *)param)->ccfunc_read_dmem_word();
+}
+
+void rsp_device::ccfunc_read_dmem_dword()
+{
+	m_core->arg1 = read_dmem_dword(m_core->arg0);
+}
+
+static void cfunc_read_dmem_dword(void *param)
+{
+	((rsp_device *)param)->ccfunc_read_dmem_dword();
+}
+
+void rsp_device::ccfunc_write_dmem_word()
+{
+	write_dmem_word(m_core->arg0, m_core->arg1);
+}
+
+static void cfunc_write_dmem_word(void *param)
+{
+	((rsp_device *)param)->ccfunc_write_dmem_word();
+}
+
+void rsp_device::ccfunc_write_dmem_dword()
+{
+	write_dmem_dword(m_core->arg0, m_core->arg1);
+}
+
+static void cfunc_write_dmem_dword(void *param)
+{
+	((rsp_device *)param)->ccfunc_write_dmem_dword();
+}
+
+void rsp_device::ccfunc_get_cop0_reg()
+{
+	m_core->arg1 = get_cop0_reg(m_core->arg0);
+}
+
+static void cfunc_get_cop0_reg(void *param)
+{
+	((rsp_device *)param)->ccfunc_get_cop0_reg();
+}
+
+void rsp_device::ccfunc_set_cop0_reg()
+{
+	set_cop0_reg(m_core->arg0, m_core->arg1);
+
+	/* SP_STATUS writes can halt us; the sequence ends here, so make it exit */
+	if (m_core->sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
+		m_core->icount = std::min(m_core->icount, 0);
+}
+
+static void cfunc_set_cop0_reg(void *param)
+{
+	((rsp_device *)param)->ccfunc_set_cop0_reg();
+}
+
+void rsp_device::ccfunc_break()
+{
+	m_ideduct = 1;
+	m_scalar_busy = false;
+	m_vector_busy = false;
+	m_paired_busy = false;
+	m_sp_set_status_func(0, 0x3, 0xffffffff);
+	m_core->icount = std::min(m_core->icount, 0);
+}
+
+static void cfunc_break(void *param)
+{
+	((rsp_device *)param)->ccfunc_break();
+}
+
+void rsp_device::ccfunc_handle_cop2()
+{
+	handle_cop2(m_core->arg0);
+}
+
+static void cfunc_handle_cop2(void *param)
+{
+	((rsp_device *)param)->ccfunc_handle_cop2();
+}
+
+void rsp_device::ccfunc_handle_lwc2()
+{
+	handle_lwc2(m_core->arg0);
+}
+
+static void cfunc_handle_lwc2(void *param)
+{
+	((rsp_device *)param)->ccfunc_handle_lwc2();
+}
+
+void rsp_device::ccfunc_handle_swc2()
+{
+	handle_swc2(m_core->arg0);
+}
+
+static void cfunc_handle_swc2(void *param)
+{
+	((rsp_device *)param)->ccfunc_handle_swc2();
+}
+
+void rsp_device::ccfunc_unimplemented()
+{
+	unimplemented_opcode(m_core->arg0);
+}
+
+static void cfunc_unimplemented(void *param)
+{
+	((rsp_device *)param)->ccfunc_unimplemented();
+}
+
+
+/***************************************************************************
+    CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void rsp_device::code_flush_cache()
+{
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+	}
+
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate static RSP code\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void rsp_device::code_compile_block(offs_t pc)
+{
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	bool override = false;
+
+	auto profile = g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+
+	/* if we get an error back, flush the cache and try again */
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			drcuml_block &block(m_drcuml->begin_block(4096));
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				uint32_t nextpc;
+
+				/* add a code log entry */
+				if (m_drcuml->logging())
+					block.append_comment("-------------------------");                     // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* sequences past the end of IMEM are reached through the wrapped PC instead */
+				if (seqhead->pc > 0xffc)
+					continue;
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !m_drcuml->hash_exists(0, seqhead->pc))
+				{
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,pc
+				}
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				/* IMEM is refilled by DMA behind our back, so always validate */
+				generate_checksum_block(block, compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					generate_sequence_instruction(block, compiler, curdesc);
+				}
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = (seqlast->pc + (seqlast->skipslots + 1) * 4) & 0xffc;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, compiler, nextpc, true);                     // <subtract cycles>
+
+				/* if the next sequence doesn't follow on directly, jump through the hash table */
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+				{
+					UML_HASHJMP(block, 0, nextpc, *m_nocode);                               // hashjmp 0,nextpc,nocode
+				}
+			}
+
+			/* end the sequence */
+			block.end();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void rsp_device::static_generate_entry_point()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	/* forward references */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+
+	alloc_handle(*m_drcuml, m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current PC */
+	UML_HASHJMP(block, 0, mem(&m_core->pc), *m_nocode);                             // hashjmp 0,<pc>,nocode
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void rsp_device::static_generate_nocode_handler()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                           // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void rsp_device::static_generate_out_of_cycles()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(*m_drcuml, m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                           // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block.end();
+}
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void rsp_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception)
+{
+	/* account for cycles */
+	if (compiler.cycles > 0)
+	{
+		UML_SUB(block, mem(&m_core->icount), mem(&m_core->icount), MAPVAR_CYCLES);    // sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+		if (allow_exception)
+			UML_EXHc(block, COND_S, *m_out_of_cycles, param);                       // exh     out_of_cycles,nextpc
+	}
+	compiler.cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void rsp_device::generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	if (m_drcuml->logging())
+		block.append_comment("[Validation for %03X]", seqhead->pc);                // comment
+
+	/* sum up every opcode in the sequence, including delay slots that fall outside it */
+	uint32_t sum = seqhead->opptr.l[0];
+	UML_LOAD(block, I0, m_imem_base, (seqhead->pc & 0xfff) >> 2, SIZE_DWORD, SCALE_x4);   // load    i0,imem,pc,dword
+	for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+	{
+		if (curdesc != seqhead)
+		{
+			UML_LOAD(block, I1, m_imem_base, (curdesc->pc & 0xfff) >> 2, SIZE_DWORD, SCALE_x4);   // load    i1,imem,pc,dword
+			UML_ADD(block, I0, I0, I1);                                             // add     i0,i0,i1
+			sum += curdesc->opptr.l[0];
+		}
+
+		const opcode_desc *const delaydesc = curdesc->delay.first();
+		if (delaydesc != nullptr && (curdesc == seqlast || curdesc->next()->pc != delaydesc->pc))
+		{
+			UML_LOAD(block, I1, m_imem_base, (delaydesc->pc & 0xfff) >> 2, SIZE_DWORD, SCALE_x4); // load    i1,imem,pc,dword
+			UML_ADD(block, I0, I0, I1);                                             // add     i0,i0,i1
+			sum += delaydesc->opptr.l[0];
+		}
+	}
+	UML_CMP(block, I0, sum);                                                        // cmp     i0,sum
+	UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                               // exne    nocode,seqhead->pc
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void rsp_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc->pc, desc->opptr.l[0]);
+
+	/* set the PC map variable */
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                         // mapvar  PC,desc->pc
+
+	/* accumulate total cycles */
+	compiler.cycles += desc->cycles;
+
+	/* update the icount map variable */
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                             // mapvar  CYCLES,compiler.cycles
+
+	/* if we are debugging, call the debugger */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_MOV(block, mem(&m_core->pc), desc->pc);                                 // mov     [pc],desc->pc
+		UML_DEBUG(block, desc->pc);                                                 // debug   desc->pc
+	}
+
+	/* unless this is a virtual no-op, it's a regular instruction */
+	if (!(desc->flags & OPFLAG_VIRTUAL_NOOP))
+	{
+		/* compile the instruction */
+		if ((desc->flags & OPFLAG_INVALID_OPCODE) || !generate_opcode(block, compiler, desc))
+		{
+			UML_MOV(block, mem(&m_core->ppc), desc->pc);                            // mov     [ppc],desc->pc
+			UML_MOV(block, mem(&m_core->arg0), desc->opptr.l[0]);                   // mov     [arg0],desc->opptr.l
+			UML_CALLC(block, cfunc_unimplemented, this);                            // callc   cfunc_unimplemented
+		}
+	}
+}
+
+
+/*------------------------------------------------------------------
+    generate_delay_slot_and_branch
+------------------------------------------------------------------*/
+
+void rsp_device::generate_delay_slot_and_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint8_t linkreg)
+{
+	compiler_state compiler_temp(compiler);
+	uint32_t op = desc->opptr.l[0];
+
+	/* fetch the target register if dynamic, in case it is modified by the delay slot */
+	if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+	{
+		UML_AND(block, mem(&m_core->jmpdest), ireg(m_core->r, RSREG), 0xffc);     // and     [jmpdest],<rsreg>,0xffc
+	}
+
+	/* set the link if needed -- before the delay slot */
+	if (linkreg != 0)
+	{
+		UML_MOV(block, mem(&R32(linkreg)), (desc->pc + 8) & 0xfff);                 // mov     <linkreg>,desc->pc + 8
+	}
+
+	/* compile the delay slot using temporary compiler state */
+	assert(desc->delay.first() != nullptr);
+	generate_sequence_instruction(block, compiler_temp, desc->delay.first());       // <next instruction>
+
+	/* update the cycles and jump through the hash table to the target */
+	if (desc->targetpc != BRANCH_TARGET_DYNAMIC)
+	{
+		generate_update_cycles(block, compiler_temp, desc->targetpc, true);         // <subtract cycles>
+		if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+		{
+			UML_JMP(block, desc->targetpc | 0x80000000);                            // jmp     desc->targetpc | 0x80000000
+		}
+		else
+		{
+			UML_HASHJMP(block, 0, desc->targetpc, *m_nocode);                       // hashjmp 0,desc->targetpc,nocode
+		}
+	}
+	else
+	{
+		generate_update_cycles(block, compiler_temp, mem(&m_core->jmpdest), true); // <subtract cycles>
+		UML_HASHJMP(block, 0, mem(&m_core->jmpdest), *m_nocode);                    // hashjmp 0,<jmpdest>,nocode
+	}
+
+	/* update the label */
+	compiler.labelnum = compiler_temp.labelnum;
+
+	/* reset the mapvar to the current cycles and account for skipped slots */
+	compiler.cycles += desc->skipslots;
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                             // mapvar  CYCLES,compiler.cycles
+}
+
+
+/*-------------------------------------------------
+    generate_dmem_read - generate a DMEM load of
+    the address in I0, returning the result in I0
+-------------------------------------------------*/
+
+void rsp_device::generate_dmem_read(drcuml_block &block, compiler_state &compiler, uml::operand_size size, bool sign)
+{
+	if (size == SIZE_BYTE)
+	{
+		UML_AND(block, I0, I0, 0xfff);                                              // and     i0,i0,0xfff
+		UML_XOR(block, I0, I0, BYTE4_XOR_BE(0));                                    // xor     i0,i0,BYTE4_XOR_BE(0)
+		UML_LOAD(block, I0, m_dmem_base, I0, SIZE_BYTE, SCALE_x1);                  // load    i0,dmem,i0,byte
+		if (sign)
+			UML_SEXT(block, I0, I0, SIZE_BYTE);                                     // sext    i0,i0,byte
+		return;
+	}
+
+	/* aligned accesses go straight to DMEM; unaligned ones are rare enough to hand off */
+	const uml::code_label unaligned = compiler.labelnum++;
+	const uml::code_label done = compiler.labelnum++;
+	if (size == SIZE_WORD)
+	{
+		UML_TEST(block, I0, 1);                                                     // test    i0,1
+		UML_JMPc(block, COND_NZ, unaligned);                                        // jnz     unaligned
+		UML_AND(block, I0, I0, 0xffe);                                              // and     i0,i0,0xffe
+		UML_XOR(block, I0, I0, WORD_XOR_BE(0));                                     // xor     i0,i0,WORD_XOR_BE(0)
+		UML_LOAD(block, I0, m_dmem_base, I0, SIZE_WORD, SCALE_x1);                  // load    i0,dmem,i0,word
+		UML_JMP(block, done);                                                       // jmp     done
+		UML_LABEL(block, unaligned);                                            // unaligned:
+		UML_MOV(block, mem(&m_core->arg0), I0);                                     // mov     [arg0],i0
+		UML_CALLC(block, cfunc_read_dmem_word, this);                               // callc   read_dmem_word
+		UML_MOV(block, I0, mem(&m_core->arg1));                                     // mov     i0,[arg1]
+		UML_LABEL(block, done);                                                 // done:
+		if (sign)
+			UML_SEXT(block, I0, I0, SIZE_WORD);                                     // sext    i0,i0,word
+	}
+	else
+	{
+		UML_TEST(block, I0, 3);                                                     // test    i0,3
+		UML_JMPc(block, COND_NZ, unaligned);                                        // jnz     unaligned
+		UML_AND(block, I0, I0, 0xffc);                                              // and     i0,i0,0xffc
+		UML_LOAD(block, I0, m_dmem_base, I0, SIZE_DWORD, SCALE_x1);                 // load    i0,dmem,i0,dword
+		UML_JMP(block, done);                                                       // jmp     done
+		UML_LABEL(block, unaligned);                                            // unaligned:
+		UML_MOV(block, mem(&m_core->arg0), I0);                                     // mov     [arg0],i0
+		UML_CALLC(block, cfunc_read_dmem_dword, this);                              // callc   read_dmem_dword
+		UML_MOV(block, I0, mem(&m_core->arg1));                                     // mov     i0,[arg1]
+		UML_LABEL(block, done);                                                 // done:
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_dmem_write - generate a DMEM store of
+    I1 to the address in I0
+-------------------------------------------------*/
+
+void rsp_device::generate_dmem_write(drcuml_block &block, compiler_state &compiler, uml::operand_size size)
+{
+	if (size == SIZE_BYTE)
+	{
+		UML_AND(block, I0, I0, 0xfff);                                              // and     i0,i0,0xfff
+		UML_XOR(block, I0, I0, BYTE4_XOR_BE(0));                                    // xor     i0,i0,BYTE4_XOR_BE(0)
+		UML_STORE(block, m_dmem_base, I0, I1, SIZE_BYTE, SCALE_x1);                 // store   dmem,i0,i1,byte
+		return;
+	}
+
+	/* aligned accesses go straight to DMEM; unaligned ones are rare enough to hand off */
+	const uml::code_label unaligned = compiler.labelnum++;
+	const uml::code_label done = compiler.labelnum++;
+	UML_TEST(block, I0, (size == SIZE_WORD) ? 1 : 3);                               // test    i0,align
+	UML_JMPc(block, COND_NZ, unaligned);                                            // jnz     unaligned
+	if (size == SIZE_WORD)
+	{
+		UML_AND(block, I0, I0, 0xffe);                                              // and     i0,i0,0xffe
+		UML_XOR(block, I0, I0, WORD_XOR_BE(0));                                     // xor     i0,i0,WORD_XOR_BE(0)
+		UML_STORE(block, m_dmem_base, I0, I1, SIZE_WORD, SCALE_x1);                 // store   dmem,i0,i1,word
+	}
+	else
+	{
+		UML_AND(block, I0, I0, 0xffc);                                              // and     i0,i0,0xffc
+		UML_STORE(block, m_dmem_base, I0, I1, SIZE_DWORD, SCALE_x1);                // store   dmem,i0,i1,dword
+	}
+	UML_JMP(block, done);                                                           // jmp     done
+	UML_LABEL(block, unaligned);                                                // unaligned:
+	UML_MOV(block, mem(&m_core->arg0), I0);                                         // mov     [arg0],i0
+	UML_MOV(block, mem(&m_core->arg1), I1);                                         // mov     [arg1],i1
+	if (size == SIZE_WORD)
+		UML_CALLC(block, cfunc_write_dmem_word, this);                              // callc   write_dmem_word
+	else
+		UML_CALLC(block, cfunc_write_dmem_dword, this);                             // callc   write_dmem_dword
+	UML_LABEL(block, done);                                                     // done:
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode
+-------------------------------------------------*/
+
+bool rsp_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t op = desc->opptr.l[0];
+	uint8_t opswitch = op >> 26;
+	uml::code_label skip;
+
+	switch (opswitch)
+	{
+		/* ----- sub-groups ----- */
+
+		case 0x00:  /* SPECIAL */
+			return generate_special(block, compiler, desc);
+
+		case 0x01:  /* REGIMM */
+			return generate_regimm(block, compiler, desc);
+
+		/* ----- jumps and branches ----- */
+
+		case 0x02:  /* J */
+			generate_delay_slot_and_branch(block, compiler, desc, 0);                // <next instruction + hashjmp>
+			return true;
+
+		case 0x03:  /* JAL */
+			generate_delay_slot_and_branch(block, compiler, desc, 31);               // <next instruction + hashjmp>
+			return true;
+
+		case 0x04:  /* BEQ */
+			UML_CMP(block, ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));         // cmp     <rsreg>,<rtreg>
+			UML_JMPc(block, COND_NE, skip = compiler.labelnum++);                   // jmp     skip,NE
+			generate_delay_slot_and_branch(block, compiler, desc, 0);                // <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+
+		case 0x05:  /* BNE */
+			UML_CMP(block, ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));         // cmp     <rsreg>,<rtreg>
+			UML_JMPc(block, COND_E, skip = compiler.labelnum++);                    // jmp     skip,E
+			generate_delay_slot_and_branch(block, compiler, desc, 0);                // <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+
+		case 0x06:  /* BLEZ */
+			UML_CMP(block, ireg(m_core->r, RSREG), 0);                              // cmp     <rsreg>,0
+			UML_JMPc(block, COND_G, skip = compiler.labelnum++);                    // jmp     skip,G
+			generate_delay_slot_and_branch(block, compiler, desc, 0);                // <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+
+		case 0x07:  /* BGTZ */
+			UML_CMP(block, ireg(m_core->r, RSREG), 0);                              // cmp     <rsreg>,0
+			UML_JMPc(block, COND_LE, skip = compiler.labelnum++);                   // jmp     skip,LE
+			generate_delay_slot_and_branch(block, compiler, desc, 0);                // <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+
+		/* ----- immediate arithmetic ----- */
+
+		case 0x08:  /* ADDI */
+		case 0x09:  /* ADDIU */
+			if (RTREG != 0)
+				UML_ADD(block, mem(&R32(RTREG)), ireg(m_core->r, RSREG), SIMMVAL);  // add     <rtreg>,<rsreg>,SIMMVAL
+			return true;
+
+		case 0x0a:  /* SLTI */
+			if (RTREG != 0)
+			{
+				UML_CMP(block, ireg(m_core->r, RSREG), SIMMVAL);                    // cmp     <rsreg>,SIMMVAL
+				UML_SETc(block, COND_L, mem(&R32(RTREG)));                          // set     <rtreg>,l
+			}
+			return true;
+
+		case 0x0b:  /* SLTIU */
+			if (RTREG != 0)
+			{
+				UML_CMP(block, ireg(m_core->r, RSREG), UIMMVAL);                    // cmp     <rsreg>,UIMMVAL
+				UML_SETc(block, COND_B, mem(&R32(RTREG)));                          // set     <rtreg>,b
+			}
+			return true;
+
+		case 0x0c:  /* ANDI */
+			if (RTREG != 0)
+				UML_AND(block, mem(&R32(RTREG)), ireg(m_core->r, RSREG), UIMMVAL);  // and     <rtreg>,<rsreg>,UIMMVAL
+			return true;
+
+		case 0x0d:  /* ORI */
+			if (RTREG != 0)
+				UML_OR(block, mem(&R32(RTREG)), ireg(m_core->r, RSREG), UIMMVAL);   // or      <rtreg>,<rsreg>,UIMMVAL
+			return true;
+
+		case 0x0e:  /* XORI */
+			if (RTREG != 0)
+				UML_XOR(block, mem(&R32(RTREG)), ireg(m_core->r, RSREG), UIMMVAL);  // xor     <rtreg>,<rsreg>,UIMMVAL
+			return true;
+
+		case 0x0f:  /* LUI */
+			if (RTREG != 0)
+				UML_MOV(block, mem(&R32(RTREG)), UIMMVAL << 16);                    // mov     <rtreg>,UIMMVAL << 16
+			return true;
+
+		/* ----- coprocessors ----- */
+
+		case 0x10:  /* COP0 */
+			switch (RSREG)
+			{
+				case 0x00:  /* MFC0 */
+					if (RTREG != 0)
+					{
+						UML_MOV(block, mem(&m_core->arg0), RDREG);                  // mov     [arg0],<rdreg>
+						UML_CALLC(block, cfunc_get_cop0_reg, this);                 // callc   get_cop0_reg
+						UML_MOV(block, mem(&R32(RTREG)), mem(&m_core->arg1));       // mov     <rtreg>,[arg1]
+					}
+					return true;
+
+				case 0x04:  /* MTC0 */
+					UML_MOV(block, mem(&m_core->arg0), RDREG);                      // mov     [arg0],<rdreg>
+					UML_MOV(block, mem(&m_core->arg1), ireg(m_core->r, RTREG));     // mov     [arg1],<rtreg>
+					UML_CALLC(block, cfunc_set_cop0_reg, this);                     // callc   set_cop0_reg
+					return true;
+			}
+			return false;
+
+		case 0x12:  /* COP2 */
+			UML_MOV(block, mem(&m_core->arg0), op);                                 // mov     [arg0],op
+			UML_CALLC(block, cfunc_handle_cop2, this);                              // callc   handle_cop2
+			return true;
+
+		/* ----- memory load operations ----- */
+
+		case 0x20:  /* LB */
+		case 0x24:  /* LBU */
+			UML_ADD(block, I0, ireg(m_core->r, RSREG), SIMMVAL);                    // add     i0,<rsreg>,SIMMVAL
+			generate_dmem_read(block, compiler, SIZE_BYTE, opswitch == 0x20);       // <load byte>
+			if (RTREG != 0)
+				UML_MOV(block, mem(&R32(RTREG)), I0);                               // mov     <rtreg>,i0
+			return true;
+
+		case 0x21:  /* LH */
+		case 0x25:  /* LHU */
+			UML_ADD(block, I0, ireg(m_core->r, RSREG), SIMMVAL);                    // add     i0,<rsreg>,SIMMVAL
+			generate_dmem_read(block, compiler, SIZE_WORD, opswitch == 0x21);       // <load word>
+			if (RTREG != 0)
+				UML_MOV(block, mem(&R32(RTREG)), I0);                               // mov     <rtreg>,i0
+			return true;
+
+		case 0x23:  /* LW */
+			UML_ADD(block, I0, ireg(m_core->r, RSREG), SIMMVAL);                    // add     i0,<rsreg>,SIMMVAL
+			generate_dmem_read(block, compiler, SIZE_DWORD, false);                 // <load dword>
+			if (RTREG != 0)
+				UML_MOV(block, mem(&R32(RTREG)), I0);                               // mov     <rtreg>,i0
+			return true;
+
+		case 0x32:  /* LWC2 */
+			UML_MOV(block, mem(&m_core->arg0), op);                                 // mov     [arg0],op
+			UML_CALLC(block, cfunc_handle_lwc2, this);                              // callc   handle_lwc2
+			return true;
+
+		/* ----- memory store operations ----- */
+
+		case 0x28:  /* SB */
+			UML_ADD(block, I0, ireg(m_core->r, RSREG), SIMMVAL);                    // add     i0,<rsreg>,SIMMVAL
+			UML_MOV(block, I1, ireg(m_core->r, RTREG));                             // mov     i1,<rtreg>
+			generate_dmem_write(block, compiler, SIZE_BYTE);                        // <store byte>
+			return true;
+
+		case 0x29:  /* SH */
+			UML_ADD(block, I0, ireg(m_core->r, RSREG), SIMMVAL);                    // add     i0,<rsreg>,SIMMVAL
+			UML_MOV(block, I1, ireg(m_core->r, RTREG));                             // mov     i1,<rtreg>
+			generate_dmem_write(block, compiler, SIZE_WORD);                        // <store word>
+			return true;
+
+		case 0x2b:  /* SW */
+			UML_ADD(block, I0, ireg(m_core->r, RSREG), SIMMVAL);                    // add     i0,<rsreg>,SIMMVAL
+			UML_MOV(block, I1, ireg(m_core->r, RTREG));                             // mov     i1,<rtreg>
+			generate_dmem_write(block, compiler, SIZE_DWORD);                       // <store dword>
+			return true;
+
+		case 0x3a:  /* SWC2 */
+			UML_MOV(block, mem(&m_core->arg0), op);                                 // mov     [arg0],op
+			UML_CALLC(block, cfunc_handle_swc2, this);                              // callc   handle_swc2
+			return true;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_special - compile opcodes in the
+    'SPECIAL' group
+-------------------------------------------------*/
+
+bool rsp_device::generate_special(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t op = desc->opptr.l[0];
+	uint8_t opswitch = op & 63;
+
+	switch (opswitch)
+	{
+		/* ----- shift instructions ----- */
+
+		case 0x00:  /* SLL */
+			if (RDREG != 0)
+				UML_SHL(block, mem(&R32(RDREG)), ireg(m_core->r, RTREG), SHIFT);    // shl     <rdreg>,<rtreg>,<shift>
+			return true;
+
+		case 0x02:  /* SRL */
+			if (RDREG != 0)
+				UML_SHR(block, mem(&R32(RDREG)), ireg(m_core->r, RTREG), SHIFT);    // shr     <rdreg>,<rtreg>,<shift>
+			return true;
+
+		case 0x03:  /* SRA */
+			if (RDREG != 0)
+				UML_SAR(block, mem(&R32(RDREG)), ireg(m_core->r, RTREG), SHIFT);    // sar     <rdreg>,<rtreg>,<shift>
+			return true;
+
+		case 0x04:  /* SLLV */
+			if (RDREG != 0)
+			{
+				UML_AND(block, I0, ireg(m_core->r, RSREG), 0x1f);                   // and     i0,<rsreg>,0x1f
+				UML_SHL(block, mem(&R32(RDREG)), ireg(m_core->r, RTREG), I0);       // shl     <rdreg>,<rtreg>,i0
+			}
+			return true;
+
+		case 0x06:  /* SRLV */
+			if (RDREG != 0)
+			{
+				UML_AND(block, I0, ireg(m_core->r, RSREG), 0x1f);                   // and     i0,<rsreg>,0x1f
+				UML_SHR(block, mem(&R32(RDREG)), ireg(m_core->r, RTREG), I0);       // shr     <rdreg>,<rtreg>,i0
+			}
+			return true;
+
+		case 0x07:  /* SRAV */
+			if (RDREG != 0)
+			{
+				UML_AND(block, I0, ireg(m_core->r, RSREG), 0x1f);                   // and     i0,<rsreg>,0x1f
+				UML_SAR(block, mem(&R32(RDREG)), ireg(m_core->r, RTREG), I0);       // sar     <rdreg>,<rtreg>,i0
+			}
+			return true;
+
+		/* ----- basic arithmetic ----- */
+
+		case 0x20:  /* ADD */
+		case 0x21:  /* ADDU */
+			if (RDREG != 0)
+				UML_ADD(block, mem(&R32(RDREG)), ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));   // add     <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		case 0x22:  /* SUB */
+		case 0x23:  /* SUBU */
+			if (RDREG != 0)
+				UML_SUB(block, mem(&R32(RDREG)), ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));   // sub     <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		/* ----- basic logical ops ----- */
+
+		case 0x24:  /* AND */
+			if (RDREG != 0)
+				UML_AND(block, mem(&R32(RDREG)), ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));   // and     <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		case 0x25:  /* OR */
+			if (RDREG != 0)
+				UML_OR(block, mem(&R32(RDREG)), ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));    // or      <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		case 0x26:  /* XOR */
+			if (RDREG != 0)
+				UML_XOR(block, mem(&R32(RDREG)), ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));   // xor     <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		case 0x27:  /* NOR */
+			if (RDREG != 0)
+			{
+				UML_OR(block, I0, ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));  // or      i0,<rsreg>,<rtreg>
+				UML_XOR(block, mem(&R32(RDREG)), I0, ~uint32_t(0));                 // xor     <rdreg>,i0,~0
+			}
+			return true;
+
+		/* ----- basic comparisons ----- */
+
+		case 0x2a:  /* SLT */
+			if (RDREG != 0)
+			{
+				UML_CMP(block, ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));     // cmp     <rsreg>,<rtreg>
+				UML_SETc(block, COND_L, mem(&R32(RDREG)));                          // set     <rdreg>,l
+			}
+			return true;
+
+		case 0x2b:  /* SLTU */
+			if (RDREG != 0)
+			{
+				UML_CMP(block, ireg(m_core->r, RSREG), ireg(m_core->r, RTREG));     // cmp     <rsreg>,<rtreg>
+				UML_SETc(block, COND_B, mem(&R32(RDREG)));                          // set     <rdreg>,b
+			}
+			return true;
+
+		/* ----- jumps and branches ----- */
+
+		case 0x08:  /* JR */
+			generate_delay_slot_and_branch(block, compiler, desc, 0);                // <next instruction + hashjmp>
+			return true;
+
+		case 0x09:  /* JALR */
+			generate_delay_slot_and_branch(block, compiler, desc, RDREG);            // <next instruction + hashjmp>
+			return true;
+
+		/* ----- system calls ----- */
+
+		case 0x0d:  /* BREAK */
+			UML_CALLC(block, cfunc_break, this);                                    // callc   break
+			return true;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_regimm - compile opcodes in the
+    'REGIMM' group
+-------------------------------------------------*/
+
+bool rsp_device::generate_regimm(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t op = desc->opptr.l[0];
+	uint8_t opswitch = RTREG;
+	uml::code_label skip;
+
+	switch (opswitch)
+	{
+		case 0x00:  /* BLTZ */
+		case 0x10:  /* BLTZAL */
+			UML_CMP(block, ireg(m_core->r, RSREG), 0);                              // cmp     <rsreg>,0
+			UML_JMPc(block, COND_GE, skip = compiler.labelnum++);                   // jmp     skip,GE
+			generate_delay_slot_and_branch(block, compiler, desc, (opswitch & 0x10) ? 31 : 0);
+																					// <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+
+		case 0x01:  /* BGEZ */
+		case 0x11:  /* BGEZAL */
+			UML_CMP(block, ireg(m_core->r, RSREG), 0);                              // cmp     <rsreg>,0
+			UML_JMPc(block, COND_L, skip = compiler.labelnum++);                    // jmp     skip,L
+			generate_delay_slot_and_branch(block, compiler, desc, (opswitch & 0x10) ? 31 : 0);
+																					// <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+	}
+
+	return false;
+}
+
+
+/***************************************************************************
+    CODE LOGGING HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an RSP instruction
+-------------------------------------------------*/
+
+void rsp_device::log_add_disasm_comment(drcuml_block &block, uint32_t pc, uint32_t op)
+{
+	if (m_drcuml->logging())
+	{
+		rsp_disassembler rspd;
+		std::ostringstream stream;
+		rspd.dasm_one(stream, pc, op);
+		const std::string stream_string = stream.str();
+		block.append_comment("%03X: %s", pc, stream_string.c_str());                // comment
+	}
+}
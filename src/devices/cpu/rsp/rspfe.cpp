@@ -0,0 +1,276 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    rspfe.cpp
+
+    Front-end for RSP recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "rspfe.h"
+
+#include "rspdefs.h"
+
+
+//**************************************************************************
+//  RSP FRONTEND
+//**************************************************************************
+
+//-------------------------------------------------
+//  rsp_frontend - constructor
+//-------------------------------------------------
+
+rsp_frontend::rsp_frontend(rsp_device &rsp, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
+	: drc_frontend(rsp, window_start, window_end, max_sequence)
+	, m_rsp(rsp)
+{
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool rsp_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	// IMEM is 4k and wraps; the recompiler never hashes PCs beyond it
+	uint32_t op = desc.opptr.l[0] = m_rsp.m_icache.read_dword(desc.pc & 0xfff);
+
+	// all instructions are 4 bytes and default to a single cycle each
+	desc.length = 4;
+	desc.cycles = 1;
+
+	// parse the instruction
+	switch (op >> 26)
+	{
+		case 0x00:  // SPECIAL
+			return describe_special(op, desc);
+
+		case 0x01:  // REGIMM
+			return describe_regimm(op, desc);
+
+		case 0x10:  // COP0
+			return describe_cop0(op, desc);
+
+		case 0x12:  // COP2
+			return describe_cop2(op, desc);
+
+		case 0x02:  // J
+			desc.targetpc = (LIMMVAL << 2) & 0xffc;
+			desc.delayslots = 1;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0x03:  // JAL
+			desc.regout[0] |= REGFLAG_R(31);
+			desc.targetpc = (LIMMVAL << 2) & 0xffc;
+			desc.delayslots = 1;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0x04:  // BEQ
+		case 0x05:  // BNE
+			desc.regin[0] |= REGFLAG_R(RSREG) | REGFLAG_R(RTREG);
+			desc.targetpc = (desc.pc + 4 + (SIMMVAL << 2)) & 0xffc;
+			desc.delayslots = 1;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+
+		case 0x06:  // BLEZ
+		case 0x07:  // BGTZ
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.targetpc = (desc.pc + 4 + (SIMMVAL << 2)) & 0xffc;
+			desc.delayslots = 1;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+
+		case 0x08:  // ADDI
+		case 0x09:  // ADDIU
+		case 0x0a:  // SLTI
+		case 0x0b:  // SLTIU
+		case 0x0c:  // ANDI
+		case 0x0d:  // ORI
+		case 0x0e:  // XORI
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.regout[0] |= REGFLAG_R(RTREG);
+			return true;
+
+		case 0x0f:  // LUI
+			desc.regout[0] |= REGFLAG_R(RTREG);
+			return true;
+
+		case 0x20:  // LB
+		case 0x21:  // LH
+		case 0x23:  // LW
+		case 0x24:  // LBU
+		case 0x25:  // LHU
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.regout[0] |= REGFLAG_R(RTREG);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case 0x28:  // SB
+		case 0x29:  // SH
+		case 0x2b:  // SW
+			desc.regin[0] |= REGFLAG_R(RSREG) | REGFLAG_R(RTREG);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case 0x32:  // LWC2
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case 0x3a:  // SWC2
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+	}
+
+	return false;
+}
+
+
+//-------------------------------------------------
+//  describe_special - build a description of a
+//  SPECIAL instruction
+//-------------------------------------------------
+
+bool rsp_frontend::describe_special(uint32_t op, opcode_desc &desc)
+{
+	switch (op & 0x3f)
+	{
+		case 0x00:  // SLL
+		case 0x02:  // SRL
+		case 0x03:  // SRA
+			desc.regin[0] |= REGFLAG_R(RTREG);
+			desc.regout[0] |= REGFLAG_R(RDREG);
+			return true;
+
+		case 0x04:  // SLLV
+		case 0x06:  // SRLV
+		case 0x07:  // SRAV
+		case 0x20:  // ADD
+		case 0x21:  // ADDU
+		case 0x22:  // SUB
+		case 0x23:  // SUBU
+		case 0x24:  // AND
+		case 0x25:  // OR
+		case 0x26:  // XOR
+		case 0x27:  // NOR
+		case 0x2a:  // SLT
+		case 0x2b:  // SLTU
+			desc.regin[0] |= REGFLAG_R(RSREG) | REGFLAG_R(RTREG);
+			desc.regout[0] |= REGFLAG_R(RDREG);
+			return true;
+
+		case 0x08:  // JR
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0x09:  // JALR
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.regout[0] |= REGFLAG_R(RDREG);
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0x0d:  // BREAK
+			// halts the RSP, so always return to the scheduler afterwards
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			return true;
+	}
+
+	return false;
+}
+
+
+//-------------------------------------------------
+//  describe_regimm - build a description of a
+//  REGIMM instruction
+//-------------------------------------------------
+
+bool rsp_frontend::describe_regimm(uint32_t op, opcode_desc &desc)
+{
+	switch (RTREG)
+	{
+		case 0x00:  // BLTZ
+		case 0x01:  // BGEZ
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.targetpc = (desc.pc + 4 + (SIMMVAL << 2)) & 0xffc;
+			desc.delayslots = 1;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+
+		case 0x10:  // BLTZAL
+		case 0x11:  // BGEZAL
+			desc.regin[0] |= REGFLAG_R(RSREG);
+			desc.regout[0] |= REGFLAG_R(31);
+			desc.targetpc = (desc.pc + 4 + (SIMMVAL << 2)) & 0xffc;
+			desc.delayslots = 1;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+	}
+
+	return false;
+}
+
+
+//-------------------------------------------------
+//  describe_cop0 - build a description of a
+//  COP0 instruction
+//-------------------------------------------------
+
+bool rsp_frontend::describe_cop0(uint32_t op, opcode_desc &desc)
+{
+	switch (RSREG)
+	{
+		case 0x00:  // MFC0
+			desc.regout[0] |= REGFLAG_R(RTREG);
+			return true;
+
+		case 0x04:  // MTC0
+			// writes to SP_STATUS can halt or break the RSP
+			desc.regin[0] |= REGFLAG_R(RTREG);
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			return true;
+	}
+
+	return false;
+}
+
+
+//-------------------------------------------------
+//  describe_cop2 - build a description of a
+//  COP2 instruction
+//-------------------------------------------------
+
+bool rsp_frontend::describe_cop2(uint32_t op, opcode_desc &desc)
+{
+	switch (RSREG)
+	{
+		case 0x00:  // MFC2
+		case 0x02:  // CFC2
+			desc.regout[0] |= REGFLAG_R(RTREG);
+			return true;
+
+		case 0x04:  // MTC2
+		case 0x06:  // CTC2
+			desc.regin[0] |= REGFLAG_R(RTREG);
+			return true;
+
+		case 0x10: case 0x11: case 0x12: case 0x13: case 0x14: case 0x15: case 0x16: case 0x17:
+		case 0x18: case 0x19: case 0x1a: case 0x1b: case 0x1c: case 0x1d: case 0x1e: case 0x1f:
+			// vector operations only touch COP2 state
+			return true;
+	}
+
+	return false;
+}
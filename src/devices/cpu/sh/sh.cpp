@@ -2281,6 +2281,7 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 
 	/* get a description of this sequence */
 	desclist = get_desclist(pc);
+	compiler.desclist = desclist;
 
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(desclist, 0);
@@ -2573,6 +2574,170 @@ void sh_common_execution::generate_delay_slot(drcuml_block &block, compiler_stat
 	compiler.labelnum = compiler_temp.labelnum;
 }
 
+/*------------------------------------------------------------------
+    is_idle_loop - determine whether a branch back to target
+    closes a loop that only polls memory, so every iteration does
+    the same thing until another device changes what it reads;
+    returns the register-addressed loads, whose addresses are only
+    known at run time
+------------------------------------------------------------------*/
+
+bool sh_common_execution::is_idle_loop(const compiler_state &compiler, const opcode_desc *branch, offs_t target, idle_load *loads, int &loadcount) const
+{
+	// loads, moves, tests and compares only; the front-end's memory flags aren't reliable enough to go by
+	auto const polls = [] (uint16_t opcode)
+	{
+		switch (opcode >> 12)
+		{
+		case  0: return (opcode == 0x0009) || ((opcode & 0x000f) >= 0x000c && (opcode & 0x000f) <= 0x000e); // NOP, MOVxL0
+		case  2: return (opcode & 0x000f) >= 0x0008 && (opcode & 0x000f) <= 0x000b;                          // TST, AND, XOR, OR
+		case  3: return (opcode & 0x000f) == 0x0000 || (opcode & 0x000f) == 0x0002 || (opcode & 0x000f) == 0x0003
+					|| (opcode & 0x000f) == 0x0006 || (opcode & 0x000f) == 0x0007;                          // CMP/xx
+		case  4: return (opcode & 0x00ff) == 0x0011 || (opcode & 0x00ff) == 0x0015;                          // CMP/PZ, CMP/PL
+		case  5: return true;                                                                                // MOVLL4
+		case  6: return (opcode & 0x000f) <= 0x0003 || (opcode & 0x000f) >= 0x000c;                          // MOVxL, MOV, EXTx
+		case  8: return (opcode & 0x0f00) == 0x0400 || (opcode & 0x0f00) == 0x0500 || (opcode & 0x0f00) == 0x0800; // MOVxL4, CMP/EQ #imm
+		case  9: return true;                                                                                // MOVWI
+		case 12: return (opcode & 0x0f00) >= 0x0400 && (opcode & 0x0f00) <= 0x0c00 && (opcode & 0x0f00) != 0x0700; // MOVxLG, TST/AND/XOR/OR #imm, TST.B
+		case 13: return true;                                                                                // MOVLI
+		case 14: return true;                                                                                // MOVI
+		}
+		return false;
+	};
+
+	// work out where a load reads from; PC-relative loads are checked here, the rest at run time
+	auto const load_address = [this, branch] (const opcode_desc *desc, idle_load &load, bool &ok)
+	{
+		uint16_t const opcode = desc->opptr.w[0];
+		load = idle_load{ int8_t((opcode >> 4) & 15), false, 0, 0 };
+		switch (opcode >> 12)
+		{
+		case  0: if (opcode == 0x0009) return false;
+				load.indexed = true; load.size = 1 << ((opcode & 0x000f) - 0x000c); return true;         // MOVxL0
+		case  5: load.disp = (opcode & 0x000f) * 4; load.size = 4; return true;                        // MOVLL4
+		case  6: if ((opcode & 0x000f) > 0x0002) return false;
+				load.size = 1 << (opcode & 0x000f); return true;                                        // MOVxL
+		case  8: if ((opcode & 0x0f00) == 0x0800) return false;
+				load.size = ((opcode & 0x0f00) == 0x0400) ? 1 : 2;
+				load.disp = (opcode & 0x000f) * load.size; return true;                                 // MOVxL4
+		case 12: load.base = -1;
+				if ((opcode & 0x0f00) == 0x0c00) { load.indexed = true; load.size = 1; return true; }  // TST.B #imm,@(R0,GBR)
+				if ((opcode & 0x0f00) > 0x0600) return false;
+				load.size = 1 << (((opcode & 0x0f00) >> 8) - 4);
+				load.disp = (opcode & 0x00ff) * load.size; return true;                                 // MOVxLG
+		case  9:
+		case 13:
+			// only a real load with SH2DRC_STRICT_PCREL, and then it has to come straight from fast RAM
+			if (m_drcoptions & SH2DRC_STRICT_PCREL)
+			{
+				int const size = ((opcode >> 12) == 9) ? 2 : 4;
+				offs_t const address = (size == 2) ? ((desc->pc + 2) + ((opcode & 0xff) * 2) + 2) : (((desc->pc + 4) & ~3) + ((opcode & 0xff) * 4));
+				ok = ok && (desc != branch->delay.first()) && fastram_read_pointer(address, size);
+			}
+			return false;
+		}
+		return false;
+	};
+
+	if (!(m_drcoptions & SH2DRC_SKIP_IDLE) || (machine().debug_flags & DEBUG_FLAG_ENABLED) || target > branch->pc || (branch->pc - target) > (MAX_IDLE_LOOP * 2))
+		return false;
+
+	// gather the loop body; it must be straight-line code in this block
+	const opcode_desc *body[MAX_IDLE_LOOP + 2];
+	int count = 0;
+	const opcode_desc *desc = compiler.desclist;
+	while (desc && desc->pc != target)
+		desc = desc->next();
+	for ( ; desc && desc != branch; desc = desc->next())
+	{
+		if (desc->pc != target + count * 2 || (desc->flags & OPFLAG_VIRTUAL_NOOP) || !polls(desc->opptr.w[0]))
+			return false;
+		body[count++] = desc;
+	}
+	if (!desc)
+		return false;
+	body[count++] = branch;
+	if (branch->delay.first())
+	{
+		if (!polls(branch->delay.first()->opptr.w[0]))
+			return false;
+		body[count++] = branch->delay.first();
+	}
+
+	// each iteration must start afresh: nothing the loop writes may be read before the loop writes it
+	uint32_t loopout[2] = { 0, 0 };
+	for (int i = 0; i < count; i++)
+	{
+		loopout[0] |= body[i]->regout[0];
+		loopout[1] |= body[i]->regout[1];
+	}
+	uint32_t written[2] = { 0, 0 };
+	for (int i = 0; i < count; i++)
+	{
+		// the branch reads T; the tests and compares only replace it, so their reads of SR don't carry anything over
+		uint32_t const regin1 = (body[i] == branch) ? REGFLAG_SR : (body[i]->regin[1] & ~REGFLAG_SR);
+		if ((body[i]->regin[0] & loopout[0] & ~written[0]) || (regin1 & loopout[1] & ~written[1]))
+			return false;
+		written[0] |= body[i]->regout[0];
+		written[1] |= body[i]->regout[1];
+	}
+
+	// every load must come from memory nobody else changes mid-timeslice; its address registers must hold still
+	bool ok = true;
+	loadcount = 0;
+	for (int i = 0; i < count; i++)
+	{
+		idle_load load;
+		if (load_address(body[i], load, ok))
+		{
+			uint32_t const addrregs = ((load.base >= 0) ? (1 << load.base) : 0) | (load.indexed ? 1 : 0);
+			if (addrregs & loopout[0])
+				return false;
+			loads[loadcount++] = load;
+		}
+	}
+	return ok;
+}
+
+/*------------------------------------------------------------------
+    generate_fastram_check - jump to miss unless the access at the
+    address in I0 lies in fast RAM; cores without a fast RAM lookup
+    never idle
+------------------------------------------------------------------*/
+
+void sh_common_execution::generate_fastram_check(drcuml_block &block, compiler_state &compiler, int size, uml::code_label miss)
+{
+	UML_JMP(block, miss);                       // jmp miss
+}
+
+/*------------------------------------------------------------------
+    generate_idle_check - on the taken path of a branch back to
+    target, end the timeslice if the loop it closes is idle
+------------------------------------------------------------------*/
+
+void sh_common_execution::generate_idle_check(drcuml_block &block, compiler_state &compiler, const opcode_desc *branch, offs_t target)
+{
+	idle_load loads[MAX_IDLE_LOOP + 2];
+	int loadcount;
+	if (!is_idle_loop(compiler, branch, target, loads, loadcount))
+		return;
+
+	// the loop only idles while everything it polls is fast RAM
+	uml::code_label const busy = compiler.labelnum++;
+	for (int i = 0; i < loadcount; i++)
+	{
+		if (loads[i].base < 0)
+			UML_ADD(block, I0, mem(&m_sh2_state->gbr), loads[i].disp);         // add r0, gbr, disp
+		else
+			UML_ADD(block, I0, R32(loads[i].base), loads[i].disp);              // add r0, Rm, disp
+		if (loads[i].indexed)
+			UML_ADD(block, I0, I0, R32(0));                                     // add r0, r0, R0
+		generate_fastram_check(block, compiler, loads[i].size, busy);
+	}
+	UML_MOV(block, mem(&m_sh2_state->icount), 0);      // mov icount, #0 (idle loop)
+	UML_LABEL(block, busy);                            // busy:
+}
+
 void sh_common_execution::func_unimplemented()
 {
 	// set up an invalid opcode exception
@@ -2749,7 +2914,12 @@ bool sh_common_execution::generate_opcode(drcuml_block &block, compiler_state &c
 			else
 				scratch = (ovrpc + 2) + ((opcode & 0xff) * 2) + 2;
 
-			if (m_drcoptions & SH2DRC_STRICT_PCREL)
+			if ((m_drcoptions & SH2DRC_STRICT_PCREL) && fastram_read_pointer(scratch, 2))
+			{
+				UML_LOAD(block, I0, fastram_read_pointer(scratch, 2), 0, SIZE_WORD, SCALE_x1); // load r0, fastram
+				UML_SEXT(block, R32(REG_N), I0, SIZE_WORD);            // sext Rn, r0, WORD
+			}
+			else if (m_drcoptions & SH2DRC_STRICT_PCREL)
 			{
 				UML_MOV(block, I0, scratch);            // mov r0, scratch
 				SETEA(0);                       // set ea for debug
@@ -2803,7 +2973,12 @@ bool sh_common_execution::generate_opcode(drcuml_block &block, compiler_state &c
 				scratch = ((ovrpc + 4) & ~3) + ((opcode & 0xff) * 4);
 			}
 
-			if (m_drcoptions & SH2DRC_STRICT_PCREL)
+			if ((m_drcoptions & SH2DRC_STRICT_PCREL) && fastram_read_pointer(scratch, 4))
+			{
+				UML_LOAD(block, I0, fastram_read_pointer(scratch, 4), 0, SIZE_DWORD, SCALE_x1); // load r0, fastram
+				UML_MOV(block, R32(REG_N), I0);            // mov Rn, r0
+			}
+			else if (m_drcoptions & SH2DRC_STRICT_PCREL)
 			{
 				UML_MOV(block, I0, scratch);            // mov r0, scratch
 				UML_CALLH(block, *m_read32);             // read32(r0, r1)
@@ -3312,29 +3487,35 @@ bool sh_common_execution::generate_group_8(drcuml_block &block, compiler_state &
 		return true;
 
 	case  9: // BT(opcode & 0xff);
+		templabel = compiler.labelnum++;         // save our label
 		UML_TEST(block, mem(&m_sh2_state->sr), SH_T);      // test m_sh2_state->sr, T
-		UML_JMPc(block, COND_Z, compiler.labelnum);    // jz compiler.labelnum
+		UML_JMPc(block, COND_Z, templabel);    // jz templabel
 
 		disp = util::sext(opcode, 8);
 		m_sh2_state->ea = (desc->pc + 2) + disp * 2 + 2;    // m_sh2_state->ea = destination
 
+		generate_idle_check(block, compiler, desc, m_sh2_state->ea);
+
 		generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
 		UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
 
-		UML_LABEL(block, compiler.labelnum++);         // labelnum:
+		UML_LABEL(block, templabel);            // labelnum:
 		return true;
 
 	case 11: // BF(opcode & 0xff);
+		templabel = compiler.labelnum++;         // save our label
 		UML_TEST(block, mem(&m_sh2_state->sr), SH_T);      // test m_sh2_state->sr, T
-		UML_JMPc(block, COND_NZ, compiler.labelnum);   // jnz compiler.labelnum
+		UML_JMPc(block, COND_NZ, templabel);   // jnz templabel
 
 		disp = util::sext(opcode, 8);
 		m_sh2_state->ea = (desc->pc + 2) + disp * 2 + 2;        // m_sh2_state->ea = destination
 
+		generate_idle_check(block, compiler, desc, m_sh2_state->ea);
+
 		generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
 		UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
 
-		UML_LABEL(block, compiler.labelnum++);         // labelnum:
+		UML_LABEL(block, templabel);            // labelnum:
 		return true;
 
 	case 13: // BTS(opcode & 0xff);
@@ -3350,6 +3531,8 @@ bool sh_common_execution::generate_group_8(drcuml_block &block, compiler_state &
 			compiler.labelnum++;               // make sure the delay slot doesn't use it
 			generate_delay_slot(block, compiler, desc, m_sh2_state->ea-2);
 
+			generate_idle_check(block, compiler, desc, m_sh2_state->ea);
+
 			generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
 			UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
 
@@ -3371,6 +3554,8 @@ bool sh_common_execution::generate_group_8(drcuml_block &block, compiler_state &
 			compiler.labelnum++;               // make sure the delay slot doesn't use it
 			generate_delay_slot(block, compiler, desc, m_sh2_state->ea-2); // delay slot only if the branch is taken
 
+			generate_idle_check(block, compiler, desc, m_sh2_state->ea);
+
 			generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
 			UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
 
@@ -34,6 +34,7 @@
 #define SH2DRC_STRICT_VERIFY    0x0001          /* verify all instructions */
 #define SH2DRC_FLUSH_PC         0x0002          /* flush the PC value before each memory access */
 #define SH2DRC_STRICT_PCREL     0x0004          /* do actual loads on MOVLI/MOVWI instead of collapsing to immediates */
+#define SH2DRC_SKIP_IDLE        0x0008          /* end the timeslice in short loops that only poll memory */
 
 #define SH2DRC_COMPATIBLE_OPTIONS   (SH2DRC_STRICT_VERIFY | SH2DRC_FLUSH_PC | SH2DRC_STRICT_PCREL)
 #define SH2DRC_FASTEST_OPTIONS  (0)
@@ -419,6 +420,19 @@ public:
 		uint32_t          cycles;                     /* accumulated cycles */
 		uint8_t           checkints;                  /* need to check interrupts before next instruction */
 		uml::code_label  labelnum;                   /* index for local labels */
+		const opcode_desc *desclist;                /* descriptions for the block being compiled */
+	};
+
+	/* longest loop body considered for idle detection, in instructions */
+	static constexpr int MAX_IDLE_LOOP = 8;
+
+	/* a load in an idle loop whose address is only known at run time */
+	struct idle_load
+	{
+		int8_t            base;                       /* register holding the base address, or -1 for GBR */
+		bool              indexed;                    /* true if R0 is added to the base */
+		uint32_t          disp;                       /* displacement added to the base */
+		uint8_t           size;                       /* access size in bytes */
 	};
 
 	virtual void sh2_exception(const char *message, int irqline) { fatalerror("sh2_exception in base classs\n"); }
@@ -469,6 +483,10 @@ public:
 	void log_opcode_desc(const opcode_desc *desclist, int indent);
 	void log_add_disasm_comment(drcuml_block &block, uint32_t pc, uint32_t op);
 	void generate_delay_slot(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t ovrpc);
+	bool is_idle_loop(const compiler_state &compiler, const opcode_desc *branch, offs_t target, idle_load *loads, int &loadcount) const;
+	void generate_idle_check(drcuml_block &block, compiler_state &compiler, const opcode_desc *branch, offs_t target);
+	virtual const void *fastram_read_pointer(offs_t address, int size) const { return nullptr; }
+	virtual void generate_fastram_check(drcuml_block &block, compiler_state &compiler, int size, uml::code_label miss);
 	void generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
 	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t ovrpc);
 	void static_generate_nocode_handler();
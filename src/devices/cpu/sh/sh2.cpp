@@ -660,6 +660,78 @@ void sh2_device::generate_update_cycles(drcuml_block &block, compiler_state &com
 	compiler.cycles = 0;
 }
 
+/*------------------------------------------------------------------
+    fastram_read_pointer - find where a constant address lives in
+    fast RAM, so reads from it can be compiled as direct loads
+------------------------------------------------------------------*/
+
+const void *sh2_device::fastram_read_pointer(offs_t address, int size) const
+{
+	// the debugger needs to see every access
+	if (machine().debug_flags & DEBUG_FLAG_ENABLED)
+		return nullptr;
+
+	// mask the address the same way the memory accessors do
+	if (!(address & 0x80000000) && address < 0x40000000)
+		address &= m_am;
+
+	for (auto & elem : m_fastram)
+	{
+		if (elem.base != nullptr && address >= elem.start && (address + size - 1) <= elem.end)
+		{
+			if (size == 1)
+				address ^= BYTE4_XOR_BE(0);
+			else if (size == 2)
+				address ^= WORD_XOR_BE(0);
+			return (const uint8_t *)elem.base + (address - elem.start);
+		}
+	}
+	return nullptr;
+}
+
+
+/*------------------------------------------------------------------
+    generate_fastram_check - jump to miss unless the access of the
+    given size at the address in I0 lies entirely in fast RAM;
+    trashes I0
+------------------------------------------------------------------*/
+
+void sh2_device::generate_fastram_check(drcuml_block &block, compiler_state &compiler, int size, uml::code_label miss)
+{
+	// the debugger needs to see every access
+	if (machine().debug_flags & DEBUG_FLAG_ENABLED)
+	{
+		UML_JMP(block, miss);                   // jmp miss
+		return;
+	}
+
+	// mask the address the same way the memory accessors do
+	uml::code_label const masked = compiler.labelnum++;
+	uml::code_label const found = compiler.labelnum++;
+	UML_TEST(block, I0, 0x80000000);        // test r0, #0x80000000
+	UML_JMPc(block, COND_NZ, masked);       // if high bit is set, don't mask
+	UML_CMP(block, I0, 0x40000000);         // cmp #0x40000000, r0
+	UML_JMPc(block, COND_AE, masked);       // bae masked
+	UML_AND(block, I0, I0, m_am);           // and r0, r0, #AM (0xc7ffffff)
+	UML_LABEL(block, masked);               // masked:
+
+	for (auto & elem : m_fastram)
+	{
+		if (elem.base != nullptr && elem.end >= elem.start + size - 1)
+		{
+			uml::code_label const skip = compiler.labelnum++;
+			UML_CMP(block, I0, elem.start);                 // cmp     i0,start
+			UML_JMPc(block, COND_B, skip);                  // jb      skip
+			UML_CMP(block, I0, elem.end - (size - 1));      // cmp     i0,end - (size - 1)
+			UML_JMPc(block, COND_BE, found);                // jbe     found
+			UML_LABEL(block, skip);                         // skip:
+		}
+	}
+	UML_JMP(block, miss);                       // jmp miss
+	UML_LABEL(block, found);                    // found:
+}
+
+
 /*------------------------------------------------------------------
     static_generate_memory_accessor
 ------------------------------------------------------------------*/
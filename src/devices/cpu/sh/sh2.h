@@ -91,6 +91,8 @@ private:
 	virtual void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception) override;
 	virtual void static_generate_entry_point() override;
 	virtual void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle *&handleptr) override;
+	virtual const void *fastram_read_pointer(offs_t address, int size) const override;
+	virtual void generate_fastram_check(drcuml_block &block, compiler_state &compiler, int size, uml::code_label miss) override;
 
 	address_space_config m_program_config, m_decrypted_program_config;
 
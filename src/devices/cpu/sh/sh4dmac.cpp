@@ -125,6 +125,14 @@ int sh34_base_device::sh4_dma_transfer(int channel, int timermode, uint32_t chcr
 	case 8: // 64 bit
 		src &= ~7;
 		dst &= ~7;
+		if (incs == 1 && incd == 1 && (dst <= src || dst >= src + count * 8))
+		{
+			// plain forward copy, let the memory system move it in bulk
+			m_program->copy_block(dst, *m_program, src, count);
+			src += count * 8;
+			dst += count * 8;
+			count = 0;
+		}
 		for (;count > 0; count --)
 		{
 			if (incs == 2)
@@ -159,6 +167,13 @@ int sh34_base_device::sh4_dma_transfer(int channel, int timermode, uint32_t chcr
 	case 32:
 		src &= ~31;
 		dst &= ~31;
+		if (incs == 1 && incd == 1 && (dst <= src || dst >= src + count * 32))
+		{
+			m_program->copy_block(dst, *m_program, src, count * 4);
+			src += count * 32;
+			dst += count * 32;
+			count = 0;
+		}
 		for (;count > 0; count --)
 		{
 			if (incs == 2)
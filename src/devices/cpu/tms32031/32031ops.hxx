@@ -97,6 +97,34 @@ inline void tms3203x_device::execute_one()
 }
 
 
+// a single-instruction repeat (RPTS, or RPTB with RS == RE) holds one
+// opcode, so fetch it once and dispatch it until the count runs out
+void tms3203x_device::execute_repeat_single()
+{
+	uint32_t const op = ROPCODE(m_pc);
+	uint32_t const end = m_pc + 1;
+	for (;;)
+	{
+		m_pc = end;
+		burn_cycle(1);
+#if (TMS_3203X_LOG_OPCODE_USAGE)
+		m_hits[op >> 21]++;
+#endif
+		(this->*s_tms32031ops[op >> 21])(op);
+
+		// anything unusual is left to the regular end-of-block handling
+		if (m_pc != end || !(IREG(TMR_ST) & RMFLAG) || m_icount <= 0)
+			return;
+		if ((int32_t)--IREG(TMR_RC) < 0)
+		{
+			// let the main loop see the final count and end the repeat
+			IREG(TMR_RC)++;
+			return;
+		}
+	}
+}
+
+
 void tms3203x_device::update_special(int dreg)
 {
 	if (dreg == TMR_BK)
@@ -1863,6 +1863,20 @@ void FUNCTION_NAME(tms340x0_device::fill)(int dst_is_linear)
 		m_gfxcycles += 2;
 		m_st |= STBIT_P;
 
+		/* without a source or transparency every full word is the same, so build it once */
+		uint16_t fillword = 0;
+		if (!PIXEL_OP_REQUIRES_SOURCE && !TRANSPARENCY)
+		{
+			uint16_t dstmask = PIXEL_MASK;
+			for (x = 0; x < PIXELS_PER_WORD; x++)
+			{
+				uint16_t pixel = COLOR1() & dstmask;
+				PIXEL_OP(fillword, dstmask, pixel);
+				fillword = (fillword & ~dstmask) | pixel;
+				dstmask = dstmask << BITS_PER_PIXEL;
+			}
+		}
+
 		/* loop over rows */
 		for (y = 0; y < dy; y++)
 		{
@@ -1902,11 +1916,15 @@ void FUNCTION_NAME(tms340x0_device::fill)(int dst_is_linear)
 			/* loop over full words */
 			for (words = 0; words < full_words; words++)
 			{
-				/* fetch the destination word (if necessary) */
-				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
-					dstword = (this->*word_read)(dwordaddr << 4);
-				else
-					dstword = 0;
+				/* write the prebuilt word if we have one */
+				if (!PIXEL_OP_REQUIRES_SOURCE && !TRANSPARENCY)
+				{
+					(this->*word_write)(dwordaddr++ << 4, fillword);
+					continue;
+				}
+
+				/* fetch the destination word */
+				dstword = (this->*word_read)(dwordaddr << 4);
 				dstmask = PIXEL_MASK;
 
 				/* loop over partials */
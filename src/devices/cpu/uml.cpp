@@ -804,6 +804,51 @@ u8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  writes_param - return true if the given
+//  parameter is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::writes_param(int pnum) const
+{
+	assert(pnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[pnum].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  substitute_immediate - replace a parameter
+//  that is only read with an immediate holding
+//  its value, provided the opcode accepts an
+//  immediate there and at least as many bytes of
+//  the value are known
+//-------------------------------------------------
+
+bool uml::instruction::substitute_immediate(int pnum, u64 value, u8 valuesize)
+{
+	assert(pnum < m_numparams);
+	opcode_info::parameter_info const &pinfo = s_opcode_info_table[m_opcode].param[pnum];
+	if (pinfo.output != PIO_IN || !(pinfo.typemask & PTYPES_IMM))
+		return false;
+
+	// only handle parameters whose size doesn't depend on another parameter
+	u8 paramsize;
+	if (pinfo.size == PSIZE_OP)
+		paramsize = m_size;
+	else if (pinfo.size == PSIZE_4)
+		paramsize = 4;
+	else if (pinfo.size == PSIZE_8)
+		paramsize = 8;
+	else
+		return false;
+	if (paramsize > valuesize)
+		return false;
+
+	m_param[pnum] = (paramsize == 4) ? u64(u32(value)) : value;
+	return true;
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
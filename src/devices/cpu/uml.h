@@ -411,6 +411,8 @@ namespace uml
 		u8 input_flags() const;
 		u8 output_flags() const;
 		u8 modified_flags() const;
+		bool writes_param(int pnum) const;
+		bool substitute_immediate(int pnum, u64 value, u8 valuesize);
 		void simplify();
 
 		// compile-time opcodes
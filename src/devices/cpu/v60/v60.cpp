@@ -121,9 +121,26 @@ std::unique_ptr<util::disasm_interface> v60_device::create_disassembler()
 
 
 // memory accessors
-#define OpRead8(a)   m_pr8(a)
-#define OpRead16(a)  m_pr16(a)
-#define OpRead32(a)  m_pr32(a)
+#define OpRead8(a)   opcode_read8(a)
+#define OpRead16(a)  opcode_read16(a)
+#define OpRead32(a)  opcode_read32(a)
+
+// the bus width never changes after start, so the branch predicts
+// perfectly and lets the cache fast path inline into the decoders
+inline u8 v60_device::opcode_read8(offs_t address)
+{
+	return m_opcode16 ? m_cache16.read_byte(address) : m_cache32.read_byte(address);
+}
+
+inline u16 v60_device::opcode_read16(offs_t address)
+{
+	return m_opcode16 ? m_cache16.read_word_unaligned(address) : m_cache32.read_word_unaligned(address);
+}
+
+inline u32 v60_device::opcode_read32(offs_t address)
+{
+	return m_opcode16 ? m_cache16.read_dword_unaligned(address) : m_cache32.read_dword_unaligned(address);
+}
 
 
 // macros stolen from MAME for flags calc
@@ -408,20 +425,11 @@ void v60_device::device_start()
 	m_moddim = 0;
 
 	m_program = &space(AS_PROGRAM);
-	if (m_program->data_width() == 16)
-	{
+	m_opcode16 = m_program->data_width() == 16;
+	if (m_opcode16)
 		m_program->cache(m_cache16);
-		m_pr8  = [this](offs_t address) -> u8  { return m_cache16.read_byte(address); };
-		m_pr16 = [this](offs_t address) -> u16 { return m_cache16.read_word_unaligned(address); };
-		m_pr32 = [this](offs_t address) -> u32 { return m_cache16.read_dword_unaligned(address); };
-	}
 	else
-	{
 		m_program->cache(m_cache32);
-		m_pr8  = [this](offs_t address) -> u8  { return m_cache32.read_byte(address); };
-		m_pr16 = [this](offs_t address) -> u16 { return m_cache32.read_word_unaligned(address); };
-		m_pr32 = [this](offs_t address) -> u32 { return m_cache32.read_dword_unaligned(address); };
-	}
 
 	m_io = &space(AS_IO);
 
@@ -166,9 +166,7 @@ private:
 	memory_access<32, 1, 0, ENDIANNESS_LITTLE>::cache m_cache16;
 	memory_access<32, 2, 0, ENDIANNESS_LITTLE>::cache m_cache32;
 
-	std::function<u8  (offs_t)> m_pr8;
-	std::function<u16 (offs_t)> m_pr16;
-	std::function<u32 (offs_t)> m_pr32;
+	bool                m_opcode16;
 	address_space *m_io;
 	uint32_t              m_PPC;
 	int                 m_icount;
@@ -775,6 +773,9 @@ private:
 	uint32_t op5D();
 	uint32_t op59();
 	[[noreturn]] uint32_t opUNHANDLED();
+	u8 opcode_read8(offs_t address);
+	u16 opcode_read16(offs_t address);
+	u32 opcode_read32(offs_t address);
 	void v60_do_irq(int vector);
 	void v60_try_irq();
 
@@ -95,6 +95,7 @@ void cassette_image_device::update()
 		case CASSETTE_PLAY:
 			if (m_cassette)
 			{
+				machine().video().report_loading_activity();
 				m_cassette->get_sample(m_channel, new_position, 0.0, &m_value);
 				// See if reached end of tape
 				double length = get_length();
@@ -33,7 +33,13 @@ cdrom_image_device::cdrom_image_device(const machine_config &mconfig, device_typ
 	  m_cdrom_handle(nullptr),
 	  m_dvdrom_handle(nullptr),
 	  m_extension_list(nullptr),
-	  m_interface(nullptr)
+	  m_interface(nullptr),
+	  m_read_ahead_queue(nullptr),
+	  m_read_ahead_item(nullptr),
+	  m_read_ahead_ready(false),
+	  m_read_ahead_lba(0),
+	  m_read_ahead_count(0),
+	  m_read_ahead_valid(0)
 {
 }
 
@@ -43,6 +49,9 @@ cdrom_image_device::cdrom_image_device(const machine_config &mconfig, device_typ
 
 cdrom_image_device::~cdrom_image_device()
 {
+	read_ahead_cancel();
+	if (m_read_ahead_queue)
+		osd_work_queue_free(m_read_ahead_queue);
 }
 
 //-------------------------------------------------
@@ -64,6 +73,9 @@ void cdrom_image_device::device_config_complete()
 
 void cdrom_image_device::device_start()
 {
+	// without a queue, reads ahead are simply ignored
+	m_read_ahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
 	if (has_preset_images())
 		setup_current_preset_image();
 	else
@@ -75,6 +87,7 @@ void cdrom_image_device::device_start()
 
 void cdrom_image_device::setup_current_preset_image()
 {
+	read_ahead_cancel();
 	m_cdrom_handle.reset();
 	m_dvdrom_handle.reset();
 
@@ -89,6 +102,7 @@ void cdrom_image_device::setup_current_preset_image()
 
 void cdrom_image_device::device_stop()
 {
+	read_ahead_cancel();
 	m_cdrom_handle.reset();
 	m_dvdrom_handle.reset();
 	if (m_self_chd.opened())
@@ -106,6 +120,7 @@ std::pair<std::error_condition, std::string> cdrom_image_device::call_load()
 	std::error_condition err;
 	chd_file *chd = nullptr;
 
+	read_ahead_cancel();
 	m_cdrom_handle.reset();
 	m_dvdrom_handle.reset();
 
@@ -171,6 +186,7 @@ error:
 void cdrom_image_device::call_unload()
 {
 	assert(m_cdrom_handle || m_dvdrom_handle);
+	read_ahead_cancel();
 	m_cdrom_handle.reset();
 	m_dvdrom_handle.reset();
 	if (m_self_chd.opened())
@@ -200,6 +216,18 @@ uint32_t cdrom_image_device::get_track_start(uint32_t track) const
 
 bool cdrom_image_device::read_data(uint32_t lbasector, void *buffer, uint32_t datatype, bool phys)
 {
+	// collect audio sectors that have been read ahead
+	read_ahead_wait();
+	if (m_read_ahead_ready && !phys && (datatype == cdrom_file::CD_TRACK_AUDIO) && (lbasector - m_read_ahead_lba) < m_read_ahead_valid)
+	{
+		memcpy(buffer, &m_read_ahead_buffer[(lbasector - m_read_ahead_lba) * cdrom_file::MAX_SECTOR_DATA], cdrom_file::MAX_SECTOR_DATA);
+		return true;
+	}
+
+	// audio plays at its own pace, only data reads count as loading
+	if (datatype != cdrom_file::CD_TRACK_AUDIO)
+		machine().video().report_loading_activity();
+
 	if (m_cdrom_handle)
 		return m_cdrom_handle->read_data(lbasector, buffer, datatype, phys);
 	if (m_dvdrom_handle)
@@ -209,11 +237,78 @@ bool cdrom_image_device::read_data(uint32_t lbasector, void *buffer, uint32_t da
 
 bool cdrom_image_device::read_subcode(uint32_t lbasector, void *buffer, bool phys)
 {
+	read_ahead_wait();
 	if (m_cdrom_handle)
 		return m_cdrom_handle->read_subcode(lbasector, buffer, phys);
 	return 0;
 }
 
+
+//-------------------------------------------------
+//  read_audio_ahead - start reading audio sectors
+//  that are about to be played on a worker
+//  thread, so decoding them overlaps with
+//  emulation
+//-------------------------------------------------
+
+void cdrom_image_device::read_audio_ahead(uint32_t lbasector, uint32_t count)
+{
+	if (!m_cdrom_handle || !m_read_ahead_queue || !count)
+		return;
+
+	// nothing to do if they're on their way already
+	if ((m_read_ahead_item || m_read_ahead_ready) && (lbasector == m_read_ahead_lba) && (count == m_read_ahead_count))
+		return;
+
+	read_ahead_cancel();
+	m_read_ahead_lba = lbasector;
+	m_read_ahead_count = count;
+	m_read_ahead_valid = 0;
+	m_read_ahead_buffer.resize(count * cdrom_file::MAX_SECTOR_DATA);
+	m_read_ahead_item = osd_work_item_queue(m_read_ahead_queue, read_ahead_callback, this, 0);
+}
+
+void *cdrom_image_device::read_ahead_callback(void *param, int threadid)
+{
+	cdrom_image_device &image = *reinterpret_cast<cdrom_image_device *>(param);
+
+	// stop at the first sector that can't be read, it'll be retried when it's asked for
+	uint32_t valid = 0;
+	while ((valid < image.m_read_ahead_count) && image.m_cdrom_handle->read_data(image.m_read_ahead_lba + valid, &image.m_read_ahead_buffer[valid * cdrom_file::MAX_SECTOR_DATA], cdrom_file::CD_TRACK_AUDIO))
+		valid++;
+	image.m_read_ahead_valid = valid;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  read_ahead_wait - wait for the read in flight,
+//  if any, to finish
+//-------------------------------------------------
+
+void cdrom_image_device::read_ahead_wait()
+{
+	if (m_read_ahead_item)
+	{
+		while (!osd_work_item_wait(m_read_ahead_item, osd_ticks_per_second() * 10)) { }
+		osd_work_item_release(m_read_ahead_item);
+		m_read_ahead_item = nullptr;
+		m_read_ahead_ready = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  read_ahead_cancel - wait for the read in
+//  flight, if any, and discard what's been read
+//-------------------------------------------------
+
+void cdrom_image_device::read_ahead_cancel()
+{
+	read_ahead_wait();
+	m_read_ahead_ready = false;
+}
+
 int cdrom_image_device::get_adr_control(int track) const
 {
 	if (m_cdrom_handle)
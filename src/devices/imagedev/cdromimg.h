@@ -22,6 +22,7 @@
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 // device type definition
 DECLARE_DEVICE_TYPE(CDROM,  cdrom_image_device)
@@ -63,6 +64,7 @@ public:
 	uint32_t get_track_start(uint32_t track) const;
 	bool read_data(uint32_t lbasector, void *buffer, uint32_t datatype, bool phys=false);
 	bool read_subcode(uint32_t lbasector, void *buffer, bool phys=false);
+	void read_audio_ahead(uint32_t lbasector, uint32_t count);
 	int get_adr_control(int track) const;
 	const cdrom_file::toc &get_toc() const;
 	int get_track_type(int track) const;
@@ -84,6 +86,10 @@ protected:
 
 	void setup_current_preset_image();
 
+	static void *read_ahead_callback(void *param, int threadid);
+	void read_ahead_wait();
+	void read_ahead_cancel();
+
 	bool        m_gd_compat;
 	bool        m_dvd_compat;
 	chd_file    m_self_chd;
@@ -91,6 +97,15 @@ protected:
 	std::unique_ptr<dvdrom_file> m_dvdrom_handle;
 	const char  *m_extension_list;
 	const char  *m_interface;
+
+	// audio sectors decoded ahead of playback
+	osd_work_queue *            m_read_ahead_queue;
+	osd_work_item *             m_read_ahead_item;      // read in flight
+	bool                        m_read_ahead_ready;     // finished read not yet discarded
+	uint32_t                    m_read_ahead_lba;       // first sector being read ahead
+	uint32_t                    m_read_ahead_count;     // sectors requested
+	uint32_t                    m_read_ahead_valid;     // sectors read successfully
+	std::vector<uint8_t>        m_read_ahead_buffer;    // their data
 };
 
 class gdrom_image_device : public cdrom_image_device
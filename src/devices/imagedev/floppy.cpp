@@ -47,6 +47,22 @@
 
 #define FLOPSND_TAG "floppysound"
 
+namespace {
+
+// images up to this size are read once and identified from memory
+constexpr u64 MAX_MEMORY_IMAGE = 64 * 1024 * 1024;
+
+// every registered format's identify() reads the image, which is slow from network storage
+std::shared_ptr<util::random_read> memory_image(util::random_read &io)
+{
+	u64 size;
+	if(io.length(size) || size > MAX_MEMORY_IMAGE)
+		return nullptr;
+	return floppy_image_format_t::copy_image(io);
+}
+
+} // anonymous namespace
+
 // device type definition
 DEFINE_DEVICE_TYPE(FLOPPY_CONNECTOR, floppy_connector, "floppy_connector", "Floppy drive connector abstraction")
 
@@ -545,11 +561,13 @@ std::pair<std::error_condition, const floppy_image_format_t *> floppy_image_devi
 	auto io = util::random_read_fill(std::move(fd), 0xff);
 	if(!io)
 		return{ std::errc::not_enough_memory, nullptr };
+	std::shared_ptr<util::random_read> const copy = memory_image(*io);
+	util::random_read &src = copy ? *copy : *io;
 
 	int best = 0;
 	const floppy_image_format_t *best_format = nullptr;
 	for(const floppy_image_format_t *format : m_fif_list) {
-		int score = format->identify(*io, m_form_factor, m_variants);
+		int score = format->identify(src, m_form_factor, m_variants);
 		if(score > best) {
 			best = score;
 			best_format = format;
@@ -591,11 +609,13 @@ std::pair<std::error_condition, std::string> floppy_image_device::call_load()
 	auto io = util::random_read_fill(image_core_file(), 0xff);
 	if(!io)
 		return std::make_pair(std::errc::not_enough_memory, std::string());
+	std::shared_ptr<util::random_read> const copy = memory_image(*io);
+	util::random_read &src = copy ? *copy : *io;
 
 	int best = 0;
 	const floppy_image_format_t *best_format = nullptr;
 	for (const floppy_image_format_t *format : m_fif_list) {
-		int score = format->identify(*io, m_form_factor, m_variants);
+		int score = format->identify(src, m_form_factor, m_variants);
 		if(score && format->extension_matches(filename()))
 			score |= floppy_image_format_t::FIFID_EXT;
 		if(score > best) {
@@ -608,7 +628,7 @@ std::pair<std::error_condition, std::string> floppy_image_device::call_load()
 		return std::make_pair(image_error::INVALIDIMAGE, "Unable to identify image file format");
 
 	m_image = std::make_unique<floppy_image>(m_tracks, m_sides, m_form_factor);
-	if (!best_format->load(*io, m_form_factor, m_variants, *m_image)) {
+	if (!best_format->load(src, m_form_factor, m_variants, *m_image)) {
 		m_image.reset();
 		return std::make_pair(image_error::INVALIDIMAGE, "Incompatible image file format or corrupted data");
 	}
@@ -924,6 +944,9 @@ TIMER_CALLBACK_MEMBER(floppy_image_device::index_resync)
 
 	if(new_idx != m_idx) {
 		m_idx = new_idx;
+		// a motor that's only switched on to access the disk means it's in use
+		if(m_idx && !m_mon && !m_motor_always_on && m_image)
+			machine().video().report_loading_activity();
 		if(m_idx && m_ready) {
 			m_ready_counter--;
 			if(!m_ready_counter) {
@@ -1005,6 +1028,7 @@ void floppy_image_device::stp_w(int state)
 				// We plan for 5 zones with possibly specific sounds
 				if (m_make_sound) m_sound_out->step(m_cyl*5/m_tracks);
 				track_changed();
+				machine().video().report_loading_activity();
 			}
 			/* Update disk detection if applicable */
 			if (exists() && !m_dskchg_writable)
@@ -1061,6 +1085,7 @@ void floppy_image_device::seek_phase_w(int _phases)
 	if(next_pos != cur_pos) {
 		if (TRACE_STEP) logerror("track %d.%d\n", m_cyl, m_subcyl);
 		if (m_make_sound) m_sound_out->step(m_subcyl);
+		machine().video().report_loading_activity();
 	}
 
 	/* Update disk detection if applicable */
@@ -67,6 +67,11 @@ harddisk_image_device::harddisk_image_device(const machine_config &mconfig, devi
 	: harddisk_image_base_device(mconfig, type, tag, owner, clock)
 	, m_chd(nullptr)
 	, m_hard_disk_handle()
+	, m_read_ahead_queue(nullptr)
+	, m_read_ahead_item(nullptr)
+	, m_read_ahead_ready(false)
+	, m_read_ahead_lba(0)
+	, m_read_ahead_result(false)
 	, m_device_image_load(*this)
 	, m_device_image_unload(*this)
 	, m_interface(nullptr)
@@ -79,6 +84,9 @@ harddisk_image_device::harddisk_image_device(const machine_config &mconfig, devi
 
 harddisk_image_device::~harddisk_image_device()
 {
+	read_ahead_cancel();
+	if (m_read_ahead_queue)
+		osd_work_queue_free(m_read_ahead_queue);
 }
 
 //-------------------------------------------------
@@ -108,6 +116,9 @@ void harddisk_image_device::device_start()
 
 	m_chd = nullptr;
 
+	// without a queue, reads ahead are simply ignored
+	m_read_ahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
 	if (has_preset_images())
 		setup_current_preset_image();
 	else
@@ -116,6 +127,7 @@ void harddisk_image_device::device_start()
 
 void harddisk_image_device::device_stop()
 {
+	read_ahead_cancel();
 	m_hard_disk_handle.reset();
 }
 
@@ -146,6 +158,8 @@ std::pair<std::error_condition, std::string> harddisk_image_device::call_create(
 
 	const uint32_t totalsectors = cylinders * heads * sectors;
 
+	read_ahead_cancel();
+
 	// create the CHD file
 	chd_codec_type compression[4] = { CHD_CODEC_NONE };
 	util::core_file::ptr proxy;
@@ -167,8 +181,13 @@ std::pair<std::error_condition, std::string> harddisk_image_device::call_create(
 
 void harddisk_image_device::setup_current_preset_image()
 {
+	read_ahead_cancel();
 	chd_file *chd = current_preset_image_chd();
 	m_hard_disk_handle.reset(new hard_disk_file(chd));
+
+	// without a diff file, changes are kept in memory
+	if (machine().options().disk_overlay())
+		m_hard_disk_handle->enable_overlay();
 }
 
 void harddisk_image_device::call_unload()
@@ -177,6 +196,7 @@ void harddisk_image_device::call_unload()
 	if (!m_device_image_unload.isnull())
 		m_device_image_unload(*this);
 
+	read_ahead_cancel();
 	m_hard_disk_handle.reset();
 
 	if (m_chd)
@@ -240,14 +260,17 @@ std::error_condition harddisk_image_device::internal_load_hd()
 
 	std::error_condition err;
 	m_chd = nullptr;
+	bool overlay = false;
 	uint8_t header[64];
 
+	read_ahead_cancel();
 	m_hard_disk_handle.reset();
 
 	// open the CHD file
 	if (loaded_through_softlist())
 	{
 		m_chd = machine().rom_load().get_disk_handle(device().subtag("harddriv").c_str());
+		overlay = machine().options().disk_overlay();
 	}
 	else
 	{
@@ -274,10 +297,18 @@ std::error_condition harddisk_image_device::internal_load_hd()
 
 				if (!err)
 				{
-					err = open_disk_diff(device().machine().options(), basename_noext(), m_origchd, m_diffchd);
-					if (!err)
+					if (device().machine().options().disk_overlay())
+					{
+						m_chd = &m_origchd;
+						overlay = true;
+					}
+					else
 					{
-						m_chd = &m_diffchd;
+						err = open_disk_diff(device().machine().options(), basename_noext(), m_origchd, m_diffchd);
+						if (!err)
+						{
+							m_chd = &m_diffchd;
+						}
 					}
 				}
 			}
@@ -291,7 +322,12 @@ std::error_condition harddisk_image_device::internal_load_hd()
 		{
 			m_hard_disk_handle.reset(new hard_disk_file(m_chd));
 			if (m_hard_disk_handle)
+			{
+				// a CHD we can't write keeps its changes in memory
+				if (overlay)
+					m_hard_disk_handle->enable_overlay();
 				return std::error_condition();
+			}
 		}
 		catch (...)
 		{
@@ -355,32 +391,104 @@ const hard_disk_file::info &harddisk_image_device::get_info() const
 
 bool harddisk_image_device::read(uint32_t lbasector, void *buffer)
 {
+	// collect the sector if it's been read ahead
+	read_ahead_wait();
+	if (m_read_ahead_ready && (lbasector == m_read_ahead_lba))
+	{
+		m_read_ahead_ready = false;
+		if (m_read_ahead_result)
+			memcpy(buffer, &m_read_ahead_buffer[0], m_read_ahead_buffer.size());
+		return m_read_ahead_result;
+	}
 	return m_hard_disk_handle->read(lbasector, buffer);
 }
 
 bool harddisk_image_device::write(uint32_t lbasector, const void *buffer)
 {
+	read_ahead_cancel();
 	return m_hard_disk_handle->write(lbasector, buffer);
 }
 
 
+//-------------------------------------------------
+//  read_ahead - start reading a sector that's
+//  about to be asked for on a worker thread, so
+//  the host I/O overlaps with emulation
+//-------------------------------------------------
+
+void harddisk_image_device::read_ahead(uint32_t lbasector)
+{
+	if (!m_hard_disk_handle || !m_read_ahead_queue)
+		return;
+
+	// nothing to do if it's on its way already
+	if ((m_read_ahead_item || m_read_ahead_ready) && (lbasector == m_read_ahead_lba))
+		return;
+
+	read_ahead_cancel();
+	m_read_ahead_lba = lbasector;
+	m_read_ahead_buffer.resize(m_hard_disk_handle->get_info().sectorbytes);
+	m_read_ahead_item = osd_work_item_queue(m_read_ahead_queue, read_ahead_callback, this, 0);
+}
+
+void *harddisk_image_device::read_ahead_callback(void *param, int threadid)
+{
+	harddisk_image_device &image = *reinterpret_cast<harddisk_image_device *>(param);
+	image.m_read_ahead_result = image.m_hard_disk_handle->read(image.m_read_ahead_lba, &image.m_read_ahead_buffer[0]);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  read_ahead_wait - wait for the read in flight,
+//  if any, to finish
+//-------------------------------------------------
+
+void harddisk_image_device::read_ahead_wait() const
+{
+	if (m_read_ahead_item)
+	{
+		while (!osd_work_item_wait(m_read_ahead_item, osd_ticks_per_second() * 10)) { }
+		osd_work_item_release(m_read_ahead_item);
+		m_read_ahead_item = nullptr;
+		m_read_ahead_ready = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  read_ahead_cancel - wait for the read in
+//  flight, if any, and discard what's been read
+//-------------------------------------------------
+
+void harddisk_image_device::read_ahead_cancel() const
+{
+	read_ahead_wait();
+	m_read_ahead_ready = false;
+}
+
+
 bool harddisk_image_device::set_block_size(uint32_t blocksize)
 {
+	read_ahead_cancel();
 	return m_hard_disk_handle->set_block_size(blocksize);
 }
 
 std::error_condition harddisk_image_device::get_inquiry_data(std::vector<uint8_t> &data) const
 {
+	read_ahead_wait();
 	return m_hard_disk_handle->get_inquiry_data(data);
 }
 
 std::error_condition harddisk_image_device::get_cis_data(std::vector<uint8_t> &data) const
 {
+	read_ahead_wait();
 	return m_hard_disk_handle->get_cis_data(data);
 }
 
 std::error_condition harddisk_image_device::get_disk_key_data(std::vector<uint8_t> &data) const
 {
+	read_ahead_wait();
 	return m_hard_disk_handle->get_disk_key_data(data);
 }
 
@@ -20,6 +20,7 @@
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 
 /***************************************************************************
@@ -77,6 +78,7 @@ public:
 	const hard_disk_file::info &get_info() const;
 	bool read(uint32_t lbasector, void *buffer);
 	bool write(uint32_t lbasector, const void *buffer);
+	void read_ahead(uint32_t lbasector);
 
 	bool set_block_size(uint32_t blocksize);
 
@@ -98,11 +100,27 @@ protected:
 	void setup_current_preset_image();
 	std::error_condition internal_load_hd();
 
+	// read-ahead on a worker thread
+	static void *read_ahead_callback(void *param, int threadid);
+	void read_ahead_wait() const;
+	void read_ahead_cancel() const;
+
 	chd_file        *m_chd;
 	chd_file        m_origchd;              // handle to the original CHD
 	chd_file        m_diffchd;              // handle to the diff CHD
 	std::unique_ptr<hard_disk_file> m_hard_disk_handle;
 
+	// A sector read ahead is read on a worker thread while emulation carries
+	// on, and handed over by the read() that asks for it.  The worker is the
+	// only user of the disk while a read is in flight, so everything else
+	// that touches the disk waits for it first.
+	osd_work_queue *                m_read_ahead_queue;
+	mutable osd_work_item *         m_read_ahead_item;      // read in flight
+	mutable bool                    m_read_ahead_ready;     // finished read not yet collected
+	uint32_t                        m_read_ahead_lba;       // sector being read ahead
+	bool                            m_read_ahead_result;    // whether it was read successfully
+	std::vector<uint8_t>            m_read_ahead_buffer;    // its data
+
 	load_delegate   m_device_image_load;
 	unload_delegate m_device_image_unload;
 	const char *    m_interface;
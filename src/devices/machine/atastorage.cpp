@@ -463,8 +463,14 @@ void ata_mass_storage_device_base::finished_read()
 		/* advance the pointers, unless this is the last sector */
 		/* Gauntlet: Dark Legacy checks to make sure we stop on the last sector */
 		if (m_sector_count != 1)
+		{
 			next_sector();
 
+			/* start fetching the next sector while the host takes this one */
+			if (m_command != IDE_COMMAND_READ_BUFFER)
+				read_sector_ahead(lba_address());
+		}
+
 		/* signal an interrupt, IDE_COMMAND_READ_MULTIPLE sets the interrupt at the start the block */
 		if (--m_sectors_until_int == 0 || (m_sector_count == 1 && m_command != IDE_COMMAND_READ_MULTIPLE))
 		{
@@ -517,7 +523,9 @@ void ata_mass_storage_device_base::read_first_sector()
 		}
 		else
 		{
+			/* the disk is read while the seek is timed */
 			start_busy(seek_time(), PARAM_COMMAND);
+			read_sector_ahead(lba_address());
 		}
 	}
 }
@@ -88,6 +88,9 @@ laserdisc_device::laserdisc_device(const machine_config &mconfig, device_type ty
 	, m_readresult()
 	, m_chdtracks(0)
 	, m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO))
+	, m_readfield(nullptr)
+	, m_lasttrack(0)
+	, m_trackdelta{ 0, 0 }
 	, m_audiosquelch(0)
 	, m_videosquelch(0)
 	, m_fieldnum(0)
@@ -321,8 +324,8 @@ void laserdisc_device::device_start()
 void laserdisc_device::device_stop()
 {
 	// make sure all async operations have completed
-	if (m_disc != nullptr)
-		osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 10);
+	for (field_data &field : m_field)
+		wait_field(field);
 
 	// free any textures and palettes
 	if (m_videotex != nullptr)
@@ -383,8 +386,12 @@ TIMER_CALLBACK_MEMBER(laserdisc_device::fetch_vbi_data)
 	// flush any audio before we read more
 	m_stream->update();
 
-	// start reading the track data for the next round
+	// note how far we moved since this field number was last read, to predict the next fields
 	m_fieldnum ^= 1;
+	m_trackdelta[m_fieldnum] = m_curtrack - m_lasttrack;
+	m_lasttrack = m_curtrack;
+
+	// start reading the track data for the next round
 	read_track_data();
 }
 
@@ -820,6 +827,16 @@ void laserdisc_device::init_video()
 		frame.m_visbitmap.set_palette(m_videopalette);
 	}
 
+	// allocate the fields decoded on the work queue, which are single fields
+	for (field_data &field : m_field)
+	{
+		field.m_owner = this;
+		field.m_bitmap.allocate(m_width, m_height);
+		field.m_samples = 0;
+		field.m_hunknum = -1;
+		field.m_item = nullptr;
+	}
+
 	// allocate an empty frame of the same size
 	m_emptyframe.allocate(m_width, m_height * 2);
 	m_emptyframe.set_palette(m_videopalette);
@@ -870,6 +887,11 @@ void laserdisc_device::init_audio()
 	m_audiobufsize = m_audiomaxsamples * 4;
 	m_audiobuffer[0].resize(m_audiobufsize);
 	m_audiobuffer[1].resize(m_audiobufsize);
+	for (field_data &field : m_field)
+	{
+		field.m_audio[0].resize(m_audiomaxsamples);
+		field.m_audio[1].resize(m_audiomaxsamples);
+	}
 }
 
 
@@ -980,13 +1002,18 @@ laserdisc_device::frame_data &laserdisc_device::current_frame()
 //  a particular video track
 //-------------------------------------------------
 
-void laserdisc_device::read_track_data()
+uint32_t laserdisc_device::hunk_for_track(int32_t track, uint8_t fieldnum) const
 {
-	// compute the chdhunk number we are going to read
-	int32_t chdtrack = m_curtrack - 1 - VIRTUAL_LEAD_IN_TRACKS;
+	int32_t chdtrack = track - 1 - VIRTUAL_LEAD_IN_TRACKS;
 	chdtrack = (std::max<int32_t>)(chdtrack, 0);
 	chdtrack = (std::min<uint32_t>)(chdtrack, m_chdtracks - 1);
-	uint32_t readhunk = chdtrack * 2 + m_fieldnum;
+	return chdtrack * 2 + fieldnum;
+}
+
+void laserdisc_device::read_track_data()
+{
+	// compute the chdhunk number we are going to read
+	uint32_t readhunk = hunk_for_track(m_curtrack, m_fieldnum);
 
 	// cheat and look up the metadata we are about to retrieve
 	vbi_metadata vbidata = { 0 };
@@ -1036,9 +1063,6 @@ void laserdisc_device::read_track_data()
 		m_avhuff_config.audio[1] = &m_audiobuffer[1][0];
 	}
 
-	// override if we're not decoding
-	m_avhuff_config.maxsamples = m_audiomaxsamples;
-	m_avhuff_config.actsamples = &m_audiocursamples;
 	m_audiocursamples = 0;
 
 	// set the VBI data for the new field from our precomputed data
@@ -1055,17 +1079,83 @@ void laserdisc_device::read_track_data()
 		m_metadata[m_fieldnum].line17 = m_metadata[m_fieldnum].line18 = m_metadata[m_fieldnum].line1718 = VBI_CODE_LEADIN;
 	}
 
-	// configure the codec and then read
+	// queue the read, then guess where the player will be for the next fields assuming
+	// it keeps moving as it has been, and decode those behind it
 	m_readresult = std::errc::no_such_file_or_directory;
+	m_readfield = nullptr;
 	if (m_disc && !m_videosquelch)
 	{
-		m_readresult = m_disc->codec_configure(CHD_CODEC_AVHUFF, AVHUFF_CODEC_DECOMPRESS_CONFIG, &m_avhuff_config);
-		if (!m_readresult)
+		uint32_t wanted[LOOKAHEAD_FIELDS + 1];
+		int32_t track = m_curtrack;
+		uint8_t fieldnum = m_fieldnum;
+		wanted[0] = readhunk;
+		for (int ahead = 1; ahead <= LOOKAHEAD_FIELDS; ahead++)
 		{
-			m_queued_hunknum = readhunk;
-			m_readresult = chd_file::error::OPERATION_PENDING;
-			osd_work_item_queue(m_work_queue, read_async_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+			fieldnum ^= 1;
+			track = std::clamp<int32_t>(track + m_trackdelta[fieldnum], 1, m_maxtrack - 1);
+			wanted[ahead] = hunk_for_track(track, fieldnum);
 		}
+
+		m_readfield = &queue_field(readhunk, wanted, std::size(wanted));
+		m_readresult = chd_file::error::OPERATION_PENDING;
+		for (int ahead = 1; ahead <= LOOKAHEAD_FIELDS; ahead++)
+			queue_field(wanted[ahead], wanted, std::size(wanted));
+	}
+}
+
+
+//-------------------------------------------------
+//  queue_field - find the field decoded or being
+//  decoded from a hunk, or start decoding it into
+//  a field no longer wanted
+//-------------------------------------------------
+
+laserdisc_device::field_data &laserdisc_device::queue_field(uint32_t hunknum, const uint32_t *wanted, int numwanted)
+{
+	for (field_data &field : m_field)
+		if (field.m_hunknum == int32_t(hunknum))
+		{
+			// don't hand back a failed decode, try it again
+			if (field.m_item || !field.m_result)
+				return field;
+			field.m_hunknum = -1;
+		}
+
+	// there's always one, since the pool has room for every field wanted
+	field_data *target = nullptr;
+	for (field_data &field : m_field)
+		if (std::find(wanted, wanted + numwanted, uint32_t(field.m_hunknum)) == wanted + numwanted)
+		{
+			target = &field;
+			break;
+		}
+	assert(target != nullptr);
+
+	wait_field(*target);
+	target->m_hunknum = hunknum;
+	target->m_samples = 0;
+	target->m_result = chd_file::error::OPERATION_PENDING;
+	target->m_item = osd_work_item_queue(m_work_queue, read_async_static, target, 0);
+
+	// without a work item, decode it now
+	if (!target->m_item)
+		read_async_static(target, 0);
+	return *target;
+}
+
+
+//-------------------------------------------------
+//  wait_field - wait for a field's decode to
+//  finish, if it's in flight
+//-------------------------------------------------
+
+void laserdisc_device::wait_field(field_data &field)
+{
+	if (field.m_item)
+	{
+		while (!osd_work_item_wait(field.m_item, osd_ticks_per_second() * 10)) { }
+		osd_work_item_release(field.m_item);
+		field.m_item = nullptr;
 	}
 }
 
@@ -1077,8 +1167,18 @@ void laserdisc_device::read_track_data()
 
 void *laserdisc_device::read_async_static(void *param, int threadid)
 {
-	laserdisc_device &ld = *reinterpret_cast<laserdisc_device *>(param);
-	ld.m_readresult = ld.m_disc->read_hunk(ld.m_queued_hunknum, nullptr);
+	// fields decode one at a time on the queue, so the codec can be pointed at each in turn
+	field_data &field = *reinterpret_cast<field_data *>(param);
+	chd_file &disc = *field.m_owner->m_disc;
+	avhuff_decoder::config config;
+	config.video = &field.m_bitmap;
+	config.maxsamples = field.m_audio[0].size();
+	config.actsamples = &field.m_samples;
+	config.audio[0] = &field.m_audio[0][0];
+	config.audio[1] = &field.m_audio[1][0];
+	field.m_result = disc.codec_configure(CHD_CODEC_AVHUFF, AVHUFF_CODEC_DECOMPRESS_CONFIG, &config);
+	if (!field.m_result)
+		field.m_result = disc.read_hunk(field.m_hunknum, nullptr);
 	return nullptr;
 }
 
@@ -1090,9 +1190,21 @@ void *laserdisc_device::read_async_static(void *param, int threadid)
 
 void laserdisc_device::process_track_data()
 {
-	// wait for the async operation to complete
+	// wait for the field to be decoded and copy it out
 	if (m_readresult == chd_file::error::OPERATION_PENDING)
-		osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 10);
+	{
+		field_data &field = *m_readfield;
+		wait_field(field);
+		m_readresult = field.m_result;
+		if (!m_readresult)
+		{
+			for (int y = 0; y < m_avhuff_video.height(); y++)
+				memcpy(&m_avhuff_video.pix(y), &field.m_bitmap.pix(y), m_avhuff_video.width() * 2);
+			m_audiocursamples = std::min(field.m_samples, m_audiomaxsamples);
+			for (int chnum = 0; chnum < 2; chnum++)
+				memcpy(m_avhuff_config.audio[chnum], &field.m_audio[chnum][0], m_audiocursamples * 2);
+		}
+	}
 	assert(m_readresult != chd_file::error::OPERATION_PENDING);
 
 	// remove the video if we had an error
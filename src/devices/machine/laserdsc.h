@@ -247,6 +247,20 @@ private:
 		int32_t             m_lastfield;            // last absolute field number
 	};
 
+	// a field decoded on the work queue, possibly ahead of when it's needed
+	struct field_data
+	{
+		laserdisc_device *  m_owner;                // owning device
+		bitmap_yuy16        m_bitmap;               // decoded video
+		std::vector<int16_t> m_audio[2];            // decoded audio
+		uint32_t            m_samples;              // number of audio samples decoded
+		int32_t             m_hunknum;              // hunk decoded, or -1 if none
+		osd_work_item *     m_item;                 // decode in flight
+		std::error_condition m_result;              // result of the decode
+	};
+
+	static constexpr int LOOKAHEAD_FIELDS = 2;      // fields decoded ahead of the current one
+
 	// internal helpers
 	void init_disc();
 	void init_video();
@@ -256,7 +270,10 @@ private:
 	void update_slider_pos();
 	void vblank_state_changed(screen_device &screen, bool vblank_state);
 	frame_data &current_frame();
+	uint32_t hunk_for_track(int32_t track, uint8_t fieldnum) const;
 	void read_track_data();
+	field_data &queue_field(uint32_t hunknum, const uint32_t *wanted, int numwanted);
+	void wait_field(field_data &field);
 	static void *read_async_static(void *param, int threadid);
 	void process_track_data();
 	void config_load(config_type cfg_type, config_level cfg_level, util::xml::data_node const *parentnode);
@@ -281,12 +298,15 @@ private:
 	int                 m_samplerate;           // audio samplerate
 	std::error_condition m_readresult;          // result of the most recent read
 	uint32_t            m_chdtracks;            // number of tracks in the CHD
-	bitmap_yuy16        m_avhuff_video;         // decompresed frame buffer
-	avhuff_decoder::config m_avhuff_config;     // decompression configuration
+	bitmap_yuy16        m_avhuff_video;         // field of the current frame being read
+	avhuff_decoder::config m_avhuff_config;     // where the field read is copied
 
 	// async operations
 	osd_work_queue *    m_work_queue;           // work queue
-	uint32_t            m_queued_hunknum;       // queued hunk
+	field_data          m_field[LOOKAHEAD_FIELDS + 1]; // pool of decoded fields
+	field_data *        m_readfield;            // field read for the current vsync
+	int32_t             m_lasttrack;            // track read at the previous vsync
+	int32_t             m_trackdelta[2];        // tracks moved before the last read of each field number
 
 	// core states
 	uint8_t             m_audiosquelch;         // audio squelch state: bit 0 = audio 1, bit 1 = audio 2
@@ -16,16 +16,23 @@
 #include "netlist/nl_parser.h"
 #include "netlist/nl_interface.h"
 
+#include "netlist/solver/nld_solver.h"
+
 #include "netlist/plib/pdynlib.h"
 #include "netlist/plib/pstonum.h"
+#include "netlist/plib/putil.h"
 
 #include "debugger.h"
 #include "romload.h"
 #include "emuopts.h"
+#include "fileio.h"
 
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 
 #define LOG_DEV_CALLS   (1U << 1)
@@ -886,6 +893,8 @@ netlist_mame_device::netlist_mame_device(const machine_config &mconfig, device_t
 netlist_mame_device::~netlist_mame_device()
 {
 	LOGDEVCALLS("~netlist_mame_device\n");
+	if (m_solver_compile.joinable())
+		m_solver_compile.join();
 }
 
 void netlist_mame_device::device_config_complete()
@@ -1041,6 +1050,8 @@ void netlist_mame_device::device_start_common()
 	common_dev_start(m_netlist.get());
 	m_netlist->setup().prepare_to_run();
 
+	if (machine().options().netlist_cache())
+		load_solver_cache();
 
 	m_device_reset_called = false;
 
@@ -1056,6 +1067,73 @@ void netlist_mame_device::device_start_common()
 }
 
 
+//-------------------------------------------------
+//  load_solver_cache - if some matrix solvers have
+//  no static solver, load a compiled library for
+//  them from the cache, or generate the code and
+//  compile it in the background for the next run
+//-------------------------------------------------
+
+void netlist_mame_device::load_solver_cache()
+{
+	netlist::devices::nld_solver *const solver = m_netlist->exec().solver();
+	if (!solver || !solver->load_static_solvers())
+		return;
+
+	// key the cache on the generated code for the whole netlist and the compiler used
+	std::string const compiler = machine().options().netlist_compiler();
+	std::string code = "// " + compiler + "\n\n";
+	code += "#include \"plib/pdynlib.h\"\n\n";
+	for (auto &e : solver->create_solver_code(netlist::solver::CXX_EXTERNAL_C))
+		code += putf8string(e.second);
+	std::string const key = util::string_format("nl_%016x", plib::hash<u64>(code.c_str(), code.size()));
+#if defined(_WIN32)
+	std::string const libname = key + ".dll";
+#else
+	std::string const libname = key + ".so";
+#endif
+
+	// use the compiled library if an earlier run built it
+	emu_file libfile(machine().options().netlist_cache_directory(), OPEN_FLAG_READ);
+	if (!libfile.open(libname))
+	{
+		std::string const libpath = libfile.fullpath();
+		libfile.close();
+		m_netlist->set_static_solver_lib(std::make_unique<plib::dynamic_library>(pstring(libpath)));
+		std::size_t const missing = solver->load_static_solvers();
+		osd_printf_verbose("%s: loaded netlist solver library %s, %d solvers still without static code\n", tag(), libpath, missing);
+		return;
+	}
+
+	// otherwise write out the code and build it in the background
+	emu_file srcfile(machine().options().netlist_cache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (srcfile.open(key + ".cpp"))
+		return;
+	srcfile.write(code.data(), code.size());
+	std::string const srcpath = srcfile.fullpath();
+	srcfile.close();
+
+	// build to a temporary name so an interrupted compile never leaves a partial library
+	std::string const libpath = srcpath.substr(0, srcpath.length() - 4) + libname.substr(key.length());
+	std::string const tmppath = libpath + ".tmp";
+	std::string command = compiler;
+	path_iterator includes(machine().options().netlist_include_path());
+	for (std::string include; includes.next(include); )
+		command += util::string_format(" -I\"%s\"", include);
+	command += util::string_format(" -o \"%s\" \"%s\"", tmppath, srcpath);
+	osd_printf_verbose("%s: compiling netlist solver library: %s\n", tag(), command);
+
+	// device_stop waits for this, so the compiler never outlives the machine
+	m_solver_compile = std::thread([command, tmppath, libpath] ()
+	{
+		if (std::system(command.c_str()) == 0)
+			std::rename(tmppath.c_str(), libpath.c_str());
+		else
+			std::remove(tmppath.c_str());
+	});
+}
+
+
 void netlist_mame_device::device_start()
 {
 	LOGDEVCALLS("device_start entry\n");
@@ -1089,6 +1167,8 @@ void netlist_mame_device::device_stop()
 	if (m_netlist)
 		netlist().exec().stop();
 	log_csv().close();
+	if (m_solver_compile.joinable())
+		m_solver_compile.join();
 }
 
 void netlist_mame_device::device_post_load()
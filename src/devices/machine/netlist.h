@@ -13,6 +13,7 @@
 
 #include <functional>
 #include <deque>
+#include <thread>
 
 #include "../../lib/netlist/nltypes.h"
 
@@ -149,8 +150,10 @@ protected:
 private:
 
 	void common_dev_start(netlist::netlist_state_t *lnetlist) const;
+	void load_solver_cache();
 
 	std::unique_ptr<netlist_mame_t> m_netlist;
+	std::thread m_solver_compile;
 
 	func_type m_setup_func;
 	bool m_device_reset_called;
@@ -180,12 +180,16 @@ void pci_device::address_base_w(offs_t offset, uint32_t data)
 	}
 
 	int bid = bank_reg_infos[offset].bank;
+	uint64_t const old = decoded_address(bid);
 	if(bank_reg_infos[offset].hi)
 		bank_infos[bid].adr = (bank_infos[bid].adr & 0xffffffff) | (uint64_t(data) << 32);
 	else {
 		bank_infos[bid].adr = (bank_infos[bid].adr & 0xffffffff00000000U) | data;
 	}
-	remap_cb();
+
+	// firmware sizes banks with decoding turned off, which changes nothing until it's turned back on
+	if(decoded_address(bid) != old)
+		remap_cb();
 }
 
 uint16_t pci_device::vendor_r()
@@ -267,6 +271,7 @@ uint32_t pci_device::expansion_base_r()
 
 void pci_device::expansion_base_w(offs_t offset, uint32_t data, uint32_t mem_mask)
 {
+	uint32_t const old = expansion_rom_base;
 	COMBINE_DATA(&expansion_rom_base);
 	if(!expansion_rom_size)
 		expansion_rom_base = 0;
@@ -274,7 +279,8 @@ void pci_device::expansion_base_w(offs_t offset, uint32_t data, uint32_t mem_mas
 		// Trick to get an address resolution at expansion_rom_size with minimal granularity of 0x800, plus bit 1 set to keep the on/off information
 		expansion_rom_base &= 0xfffff801 & (1-expansion_rom_size);
 	}
-	remap_cb();
+	if((expansion_rom_base != old) && ((expansion_rom_base | old) & 1))
+		remap_cb();
 }
 
 // if non-zero a CAPability PoinTeR marks an offset in PCI config space where a standard extension is located
@@ -455,6 +461,17 @@ void pci_device::set_map_flags(int id, int flags)
 	remap_cb();
 }
 
+// where map_device would put a bank, or ~0 if it wouldn't
+uint64_t pci_device::decoded_address(int id) const
+{
+	const bank_info &bi = bank_infos[id];
+	if(uint32_t(bi.adr) >= 0xfffffffc || !bi.size || (bi.flags & M_DISABLED))
+		return ~uint64_t(0);
+	if(~command & ((bi.flags & M_IO) ? 1 : 2))
+		return ~uint64_t(0);
+	return bi.adr & ~uint64_t(bi.size - 1);
+}
+
 agp_device::agp_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock)
 	: pci_device(mconfig, type, tag, owner, clock)
 {
@@ -913,6 +930,7 @@ void pci_host_device::device_start()
 
 	memory_window_start = memory_window_end = memory_offset = 0;
 	io_window_start = io_window_end = io_offset = 0;
+	remap_pending = false;
 
 	reset_all_mappings();
 
@@ -936,6 +954,16 @@ void pci_host_device::interface_post_reset()
 
 void pci_host_device::regenerate_mapping()
 {
+	// during a reset or a config access, one remap at the end covers everything
+	if(m_pci_root->remaps_deferred()) {
+		if(!remap_pending) {
+			remap_pending = true;
+			m_pci_root->remap_later(remap_cb);
+		}
+		return;
+	}
+	remap_pending = false;
+
 	logerror("Regenerating mapping\n");
 	memory_space->unmap_readwrite(memory_window_start, memory_window_end);
 	io_space->unmap_readwrite(io_window_start, io_window_end);
@@ -1007,11 +1035,14 @@ uint32_t pci_host_device::root_config_read(uint8_t bus, uint8_t device, uint16_t
 
 void pci_host_device::root_config_write(uint8_t bus, uint8_t device, uint16_t reg, uint32_t data, uint32_t mem_mask)
 {
+	// a write covering several registers remaps once
+	m_pci_root->defer_remaps();
 	if(bus == 0x00)
 		do_config_write(bus, device, reg, data, mem_mask);
 
 	else
 		propagate_config_write(bus, device, reg, data, mem_mask);
+	m_pci_root->end_deferred_remaps();
 }
 
 
@@ -1019,7 +1050,8 @@ pci_root_device::pci_root_device(const machine_config &mconfig, const char *tag,
 	: device_t(mconfig, PCI_ROOT, tag, owner, clock),
 	  m_pin_mapper(*this),
 	  m_irq_handler(*this),
-	  m_pci_busmaster_space(nullptr)
+	  m_pci_busmaster_space(nullptr),
+	  m_remap_defer(0)
 {
 }
 
@@ -1029,6 +1061,25 @@ void pci_root_device::device_start()
 
 void pci_root_device::device_reset()
 {
+	// devices on the bus remap as they reset
+	defer_remaps();
+}
+
+void pci_root_device::device_reset_after_children()
+{
+	end_deferred_remaps();
+}
+
+void pci_root_device::end_deferred_remaps()
+{
+	assert(m_remap_defer > 0);
+	if(--m_remap_defer)
+		return;
+
+	std::vector<pci_device::mapper_cb> pending;
+	pending.swap(m_pending_remaps);
+	for(auto &cb : pending)
+		cb();
 }
 
 void pci_root_device::irq_pin_w(int pin, int state)
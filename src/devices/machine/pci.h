@@ -134,6 +134,8 @@ protected:
 	void set_map_size(int id, uint64_t size);
 	void set_map_flags(int id, int flags);
 
+	uint64_t decoded_address(int id) const;
+
 	inline address_space *get_pci_busmaster_space() const;
 };
 
@@ -275,6 +277,7 @@ protected:
 
 private:
 	address_space *memory_space, *io_space;
+	bool remap_pending;
 };
 
 using pci_pin_mapper = device_delegate<int (int)>;
@@ -294,14 +297,23 @@ public:
 
 	void set_pci_busmaster_space(address_space *space) { m_pci_busmaster_space = space; }
 
+	// remaps requested while deferred are done once, when the outermost deferral ends
+	void defer_remaps() { m_remap_defer++; }
+	void end_deferred_remaps();
+	bool remaps_deferred() const { return m_remap_defer != 0; }
+	void remap_later(pci_device::mapper_cb cb) { m_pending_remaps.push_back(cb); }
+
 protected:
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_reset_after_children() override;
 
 private:
 	pci_pin_mapper m_pin_mapper;
 	pci_irq_handler m_irq_handler;
 	address_space *m_pci_busmaster_space;
+	int m_remap_defer;
+	std::vector<pci_device::mapper_cb> m_pending_remaps;
 };
 
 address_space *pci_device::get_pci_busmaster_space() const
@@ -56,6 +56,43 @@ void AICADSP::init()
 	memset(this,0,sizeof(*this));
 	RBL = (8 * 1024); // Initial RBL is 0
 	Stopped = true;
+	Dirty = true;
+}
+
+void AICADSP::decode()
+{
+	// the microprogram rarely changes, so split the fields out once rather than every sample
+	for (int step = 0; step < 128; ++step)
+	{
+		const u16 *IPtr = MPRO + step * 8;
+		decoded_step &d = Decoded[step];
+
+		d.TRA   = (IPtr[0] >>  9) & 0x7F;
+		d.TWT   = (IPtr[0] >>  8) & 0x01;
+		d.TWA   = (IPtr[0] >>  1) & 0x7F;
+		d.XSEL  = (IPtr[2] >> 15) & 0x01;
+		d.YSEL  = (IPtr[2] >> 13) & 0x03;
+		d.IRA   = (IPtr[2] >>  7) & 0x3F;
+		d.IWT   = (IPtr[2] >>  6) & 0x01;
+		d.IWA   = (IPtr[2] >>  1) & 0x1F;
+		d.TABLE = (IPtr[4] >> 15) & 0x01;
+		d.MWT   = (IPtr[4] >> 14) & 0x01;
+		d.MRD   = (IPtr[4] >> 13) & 0x01;
+		d.EWT   = (IPtr[4] >> 12) & 0x01;
+		d.EWA   = (IPtr[4] >>  8) & 0x0F;
+		d.ADRL  = (IPtr[4] >>  7) & 0x01;
+		d.FRCL  = (IPtr[4] >>  6) & 0x01;
+		d.SHIFT = (IPtr[4] >>  4) & 0x03;
+		d.YRL   = (IPtr[4] >>  3) & 0x01;
+		d.NEGB  = (IPtr[4] >>  2) & 0x01;
+		d.ZERO  = (IPtr[4] >>  1) & 0x01;
+		d.BSEL  = (IPtr[4] >>  0) & 0x01;
+		d.NOFL  = (IPtr[6] >> 15) & 1;
+		d.MASA  = (IPtr[6] >>  9) & 0x1f;
+		d.ADREB = (IPtr[6] >>  8) & 0x1;
+		d.NXADR = (IPtr[6] >>  7) & 0x1;
+	}
+	Dirty = false;
 }
 
 void AICADSP::step()
@@ -68,6 +105,8 @@ void AICADSP::step()
 
 	if (Stopped)
 		return;
+	if (Dirty)
+		decode();
 
 	std::fill(std::begin(EFREG), std::end(EFREG), 0);
 #if 0
@@ -78,40 +117,32 @@ void AICADSP::step()
 #endif
 	for (int step = 0; step < /*128*/LastStep; ++step)
 	{
-		u16 *IPtr=MPRO+step*8;
-
-//      if (IPtr[0]==0 && IPtr[1]==0 && IPtr[2]==0 && IPtr[3]==0)
-//          break;
-
-		const u32 TRA   = (IPtr[0] >>  9) & 0x7F;
-		const u32 TWT   = (IPtr[0] >>  8) & 0x01;
-		const u32 TWA   = (IPtr[0] >>  1) & 0x7F;
-
-		const u32 XSEL  = (IPtr[2] >> 15) & 0x01;
-		const u32 YSEL  = (IPtr[2] >> 13) & 0x03;
-		const u32 IRA   = (IPtr[2] >>  7) & 0x3F;
-		const u32 IWT   = (IPtr[2] >>  6) & 0x01;
-		const u32 IWA   = (IPtr[2] >>  1) & 0x1F;
-
-		const u32 TABLE = (IPtr[4] >> 15) & 0x01;
-		const u32 MWT   = (IPtr[4] >> 14) & 0x01;
-		const u32 MRD   = (IPtr[4] >> 13) & 0x01;
-		const u32 EWT   = (IPtr[4] >> 12) & 0x01;
-		const u32 EWA   = (IPtr[4] >>  8) & 0x0F;
-		const u32 ADRL  = (IPtr[4] >>  7) & 0x01;
-		const u32 FRCL  = (IPtr[4] >>  6) & 0x01;
-		const u32 SHIFT = (IPtr[4] >>  4) & 0x03;
-		const u32 YRL   = (IPtr[4] >>  3) & 0x01;
-		const u32 NEGB  = (IPtr[4] >>  2) & 0x01;
-		const u32 ZERO  = (IPtr[4] >>  1) & 0x01;
-		const u32 BSEL  = (IPtr[4] >>  0) & 0x01;
-
-		const u32 NOFL  = (IPtr[6] >> 15) & 1;        //????
+		const decoded_step &d = Decoded[step];
+		const u32 TRA   = d.TRA;
+		const u32 TWT   = d.TWT;
+		const u32 TWA   = d.TWA;
+		const u32 XSEL  = d.XSEL;
+		const u32 YSEL  = d.YSEL;
+		const u32 IRA   = d.IRA;
+		const u32 IWT   = d.IWT;
+		const u32 IWA   = d.IWA;
+		const u32 TABLE = d.TABLE;
+		const u32 MWT   = d.MWT;
+		const u32 MRD   = d.MRD;
+		const u32 EWT   = d.EWT;
+		const u32 EWA   = d.EWA;
+		const u32 ADRL  = d.ADRL;
+		const u32 FRCL  = d.FRCL;
+		const u32 SHIFT = d.SHIFT;
+		const u32 YRL   = d.YRL;
+		const u32 NEGB  = d.NEGB;
+		const u32 ZERO  = d.ZERO;
+		const u32 BSEL  = d.BSEL;
+		const u32 NOFL  = d.NOFL;
 		const u32 COEF  = step;
-
-		const u32 MASA  = (IPtr[6] >>  9) & 0x1f;  //???
-		const u32 ADREB = (IPtr[6] >>  8) & 0x1;
-		const u32 NXADR = (IPtr[6] >>  7) & 0x1;
+		const u32 MASA  = d.MASA;
+		const u32 ADREB = d.ADREB;
+		const u32 NXADR = d.NXADR;
 
 		//operations are done at 24 bit precision
 #if 0
@@ -12,6 +12,7 @@ struct AICADSP
 	void setsample(s32 sample, u8 SEL, s32 MXL);
 	void step();
 	void start();
+	void decode();
 
 //Config
 	memory_access<23, 1, 0, ENDIANNESS_LITTLE>::cache cache;
@@ -37,6 +38,16 @@ struct AICADSP
 
 	bool Stopped;
 	int LastStep;
+
+//microprogram with the fields split out, rebuilt when MPRO changes
+	struct decoded_step
+	{
+		u8 TRA, TWT, TWA, XSEL, YSEL, IRA, IWT, IWA;
+		u8 TABLE, MWT, MRD, EWT, EWA, ADRL, FRCL, SHIFT, YRL, NEGB, ZERO, BSEL;
+		u8 NOFL, MASA, ADREB, NXADR;
+	};
+	decoded_step Decoded[128];
+	bool Dirty;
 };
 
 #endif // MAME_SOUND_AICADSP_H
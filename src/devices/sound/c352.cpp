@@ -125,59 +125,63 @@ void c352_device::ramp_volume(c352_voice_t &v, int ch, u8 val)
 
 void c352_device::sound_stream_update(sound_stream &stream, std::vector<read_stream_view> const &inputs, std::vector<write_stream_view> &outputs)
 {
-	auto &buffer_fl = outputs[0];
-	auto &buffer_fr = outputs[1];
-	auto &buffer_rl = outputs[2];
-	auto &buffer_rr = outputs[3];
+	// generate into local blocks, then convert each output in one pass
+	constexpr int MAX_SAMPLES = 256;
+	s32 block[4][MAX_SAMPLES];
+	int const numsamples = outputs[0].samples();
 
-	for (int i = 0; i < buffer_fl.samples(); i++)
+	for (int base = 0; base < numsamples; base += MAX_SAMPLES)
 	{
-		int out[4] = { 0, 0, 0, 0 };
-
-		for (int j = 0; j < 32; j++)
+		int const cursamples = std::min(numsamples - base, MAX_SAMPLES);
+		for (int i = 0; i < cursamples; i++)
 		{
-			c352_voice_t &v = m_c352_v[j];
-			s16 s = 0;
+			int out[4] = { 0, 0, 0, 0 };
 
-			if (v.flags & C352_FLG_BUSY)
+			for (int j = 0; j < 32; j++)
 			{
-				s32 next_counter = v.counter + v.freq;
+				c352_voice_t &v = m_c352_v[j];
+				s16 s = 0;
 
-				if (next_counter & 0x10000)
+				if (v.flags & C352_FLG_BUSY)
 				{
-					fetch_sample(v);
-				}
+					s32 next_counter = v.counter + v.freq;
 
-				if ((next_counter ^ v.counter) & 0x18000)
-				{
-					ramp_volume(v, 0, v.vol_f >> 8);
-					ramp_volume(v, 1, v.vol_f & 0xff);
-					ramp_volume(v, 2, v.vol_r >> 8);
-					ramp_volume(v, 3, v.vol_r & 0xff);
-				}
+					if (next_counter & 0x10000)
+					{
+						fetch_sample(v);
+					}
+
+					if ((next_counter ^ v.counter) & 0x18000)
+					{
+						ramp_volume(v, 0, v.vol_f >> 8);
+						ramp_volume(v, 1, v.vol_f & 0xff);
+						ramp_volume(v, 2, v.vol_r >> 8);
+						ramp_volume(v, 3, v.vol_r & 0xff);
+					}
 
-				v.counter = next_counter & 0xffff;
+					v.counter = next_counter & 0xffff;
 
-				s = v.sample;
+					s = v.sample;
 
-				// Interpolate samples
-				if ((v.flags & C352_FLG_FILTER) == 0)
-					s = v.last_sample + (v.counter * (v.sample - v.last_sample) >> 16);
-			}
+					// Interpolate samples
+					if ((v.flags & C352_FLG_FILTER) == 0)
+						s = v.last_sample + (v.counter * (v.sample - v.last_sample) >> 16);
+				}
 
-			// Left
-			out[0] += (((v.flags & C352_FLG_PHASEFL) ? -s : s) * v.curr_vol[0]) >> 8;
-			out[2] += (((v.flags & C352_FLG_PHASERL) ? -s : s) * v.curr_vol[2]) >> 8;
+				// Left
+				out[0] += (((v.flags & C352_FLG_PHASEFL) ? -s : s) * v.curr_vol[0]) >> 8;
+				out[2] += (((v.flags & C352_FLG_PHASERL) ? -s : s) * v.curr_vol[2]) >> 8;
 
-			// Right
-			out[1] += (((v.flags & C352_FLG_PHASEFR) ? -s : s) * v.curr_vol[1]) >> 8;
-			out[3] += (((v.flags & C352_FLG_PHASEFR) ? -s : s) * v.curr_vol[3]) >> 8;
-		}
+				// Right
+				out[1] += (((v.flags & C352_FLG_PHASEFR) ? -s : s) * v.curr_vol[1]) >> 8;
+				out[3] += (((v.flags & C352_FLG_PHASEFR) ? -s : s) * v.curr_vol[3]) >> 8;
+			}
 
-		buffer_fl.put_int(i, s16(out[0] >> 3), 32768);
-		buffer_fr.put_int(i, s16(out[1] >> 3), 32768);
-		buffer_rl.put_int(i, s16(out[2] >> 3), 32768);
-		buffer_rr.put_int(i, s16(out[3] >> 3), 32768);
+			for (int ch = 0; ch < 4; ch++)
+				block[ch][i] = s16(out[ch] >> 3);
+		}
+		for (int ch = 0; ch < 4; ch++)
+			outputs[ch].put_int_block(base, cursamples, block[ch], 32768);
 	}
 }
 
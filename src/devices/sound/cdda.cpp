@@ -67,6 +67,9 @@ void cdda_device::start_audio(uint32_t startlba, uint32_t numblocks)
 	m_audio_lba = startlba;
 	m_audio_length = numblocks;
 	m_audio_samples = 0;
+
+	// start decoding the first sectors while the track seeks
+	m_disc->read_audio_ahead(m_audio_lba, std::min<uint32_t>(m_audio_length, MAX_SECTORS));
 }
 
 
@@ -211,6 +214,9 @@ void cdda_device::get_audio_data(write_stream_view &bufL, write_stream_view &buf
 			m_audio_samples = (cdrom_file::MAX_SECTOR_DATA*sectors)/4;
 			m_audio_length -= sectors;
 
+			/* decode the next sectors while these play */
+			m_disc->read_audio_ahead(m_audio_lba, std::min<uint32_t>(m_audio_length, MAX_SECTORS));
+
 			/* reset feedout ptr */
 			m_audio_bptr = 0;
 		}
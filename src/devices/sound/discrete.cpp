@@ -123,6 +123,7 @@ public:
 	}
 
 	void check(discrete_task &dest_task);
+	void compile();
 	void prepare_for_queue(int samples);
 
 	static void *task_callback(void *param, int threadid);
@@ -133,7 +134,16 @@ public:
 	int task_group = 0;
 
 private:
-	void step_nodes();
+	// a node's step in the compiled program
+	struct step_op
+	{
+		void (*func)(discrete_step_interface &);
+		discrete_step_interface *node;
+	};
+
+	static void step_virtual(discrete_step_interface &node) { node.step(); }
+
+	void step_nodes(int samples);
 	bool process();
 
 	bool lock_threadid(int32_t threadid)
@@ -150,6 +160,9 @@ private:
 	/* list of source nodes */
 	std::vector<input_buffer> source_list;      /* discrete_source_node */
 
+	/* step list with the step functions resolved */
+	std::vector<step_op>        m_program;
+
 	std::vector<output_buffer>  m_buffers;
 	discrete_device &           m_device;
 
@@ -185,36 +198,40 @@ private:
  *
  *************************************/
 
-inline void discrete_task::step_nodes()
+inline void discrete_task::step_nodes(int samples)
 {
-	for (input_buffer &sn : source_list)
-		sn.buffer = *sn.ptr++;
-
-	if (EXPECTED(!m_device.profiling()))
+	bool const profiling = m_device.profiling();
+	for ( ; samples > 0; samples--)
 	{
-		// Now step the nodes
-		for (discrete_step_interface *entry : step_list)
-			entry->step();
-	}
-	else
-	{
-		osd_ticks_t last = get_profile_ticks();
+		for (input_buffer &sn : source_list)
+			sn.buffer = *sn.ptr++;
 
-		for (discrete_step_interface *node : step_list)
+		if (EXPECTED(!profiling))
 		{
-			node->run_time -= last;
-			node->step();
-			last = get_profile_ticks();
-			node->run_time += last;
+			// Now step the nodes
+			for (const step_op &op : m_program)
+				op.func(*op.node);
 		}
-	}
+		else
+		{
+			osd_ticks_t last = get_profile_ticks();
 
-	// buffer the outputs
-	for (output_buffer &outbuf : m_buffers)
-		*outbuf.ptr.load(std::memory_order_relaxed) = *outbuf.source;
-	std::atomic_thread_fence(std::memory_order_release);
-	for (output_buffer &outbuf : m_buffers)
-		outbuf.ptr.store(outbuf.ptr.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			for (discrete_step_interface *node : step_list)
+			{
+				node->run_time -= last;
+				node->step();
+				last = get_profile_ticks();
+				node->run_time += last;
+			}
+		}
+
+		// buffer the outputs
+		for (output_buffer &outbuf : m_buffers)
+			*outbuf.ptr.load(std::memory_order_relaxed) = *outbuf.source;
+		std::atomic_thread_fence(std::memory_order_release);
+		for (output_buffer &outbuf : m_buffers)
+			outbuf.ptr.store(outbuf.ptr.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
 }
 
 void *discrete_task::task_callback(void *param, int threadid)
@@ -255,12 +272,7 @@ inline bool discrete_task::process()
 	m_samples -= samples;
 	if (m_samples < 0)
 		throw emu_fatalerror("discrete_task::process: m_samples got negative");
-	while (samples > 0)
-	{
-		// step
-		step_nodes();
-		samples--;
-	}
+	step_nodes(samples);
 	if (m_samples == 0)
 	{
 		// return and keep the task locked so it is not picked up by other worker threads
@@ -269,6 +281,15 @@ inline bool discrete_task::process()
 	return true;
 }
 
+void discrete_task::compile()
+{
+	/* resolve the step functions once so stepping doesn't go through each node's vtable */
+	m_program.clear();
+	m_program.reserve(step_list.size());
+	for (discrete_step_interface *node : step_list)
+		m_program.push_back(step_op{ node->step_func ? node->step_func : &step_virtual, node });
+}
+
 void discrete_task::prepare_for_queue(int samples)
 {
 	m_threadid.store(-1, std::memory_order_relaxed); // unlock the thread
@@ -914,6 +935,7 @@ void discrete_device::device_start()
 			if (task->task_group > dest_task->task_group)
 				dest_task->check(*task);
 		}
+		task->compile();
 	}
 }
 
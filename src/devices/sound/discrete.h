@@ -8,6 +8,7 @@
 #include "machine/rescap.h"
 
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 
@@ -4149,6 +4150,7 @@ public:
 	virtual void step() = 0;
 	osd_ticks_t         run_time;
 	discrete_base_node *    self;
+	void (*step_func)(discrete_step_interface &) = nullptr;   /* non-virtual step, set by the node factory */
 };
 
 class discrete_input_interface
@@ -4409,11 +4411,17 @@ class discrete_node_factory
 public:
 	static std::unique_ptr<discrete_base_node> create(discrete_device &pdev, const discrete_block &block)
 	{
-		std::unique_ptr<discrete_base_node> r = std::make_unique<C>();
+		std::unique_ptr<C> r = std::make_unique<C>();
+		discrete_base_node &node = *r;
 
-		r->init(&pdev, &block);
+		node.init(&pdev, &block);
+		if constexpr (std::is_base_of_v<discrete_step_interface, C>)
+			r->step_func = &step;
 		return r;
 	}
+
+private:
+	static void step(discrete_step_interface &node) { static_cast<C &>(node).C::step(); }
 };
 
 /*************************************
@@ -1011,8 +1011,13 @@ inline void es550x_device::generate_irq(es550x_voice *voice, int v)
 
 void es5506_device::generate_samples(std::vector<write_stream_view> &outputs)
 {
+	// samples are gathered into a local block and written out a block at a time
+	constexpr int MAX_SAMPLES = 256;
+	s32 block[MAX_SAMPLES][12];
+	int const numsamples = outputs[0].samples();
+
 	// loop while we still have samples to generate
-	for (int sampindex = 0; sampindex < outputs[0].samples(); sampindex++)
+	for (int sampindex = 0; sampindex < numsamples; sampindex++)
 	{
 		// loop over voices
 		s32 cursample[12] = { 0 };
@@ -1038,15 +1043,25 @@ void es5506_device::generate_samples(std::vector<write_stream_view> &outputs)
 			generate_irq(voice, v);
 		}
 
-		for (int c = 0; c < outputs.size(); c++)
-			outputs[c].put_int(sampindex, cursample[c], 32768);
+		int const blockindex = sampindex % MAX_SAMPLES;
+		std::copy_n(cursample, std::size(cursample), block[blockindex]);
+
+		// flush each full block, plus whatever is left at the end
+		if (blockindex == MAX_SAMPLES - 1 || sampindex == numsamples - 1)
+			for (int c = 0; c < outputs.size(); c++)
+				outputs[c].put_int_block(sampindex - blockindex, blockindex + 1, &block[0][c], 32768, std::size(cursample));
 	}
 }
 
 void es5505_device::generate_samples(std::vector<write_stream_view> &outputs)
 {
+	// samples are gathered into a local block and written out a block at a time
+	constexpr int MAX_SAMPLES = 256;
+	s32 block[MAX_SAMPLES][12];
+	int const numsamples = outputs[0].samples();
+
 	// loop while we still have samples to generate
-	for (int sampindex = 0; sampindex < outputs[0].samples(); sampindex++)
+	for (int sampindex = 0; sampindex < numsamples; sampindex++)
 	{
 		// loop over voices
 		s32 cursample[12] = { 0 };
@@ -1076,8 +1091,13 @@ void es5505_device::generate_samples(std::vector<write_stream_view> &outputs)
 			generate_irq(voice, v);
 		}
 
-		for (int c = 0; c < outputs.size(); c++)
-			outputs[c].put_int(sampindex, cursample[c], 32768);
+		int const blockindex = sampindex % MAX_SAMPLES;
+		std::copy_n(cursample, std::size(cursample), block[blockindex]);
+
+		// flush each full block, plus whatever is left at the end
+		if (blockindex == MAX_SAMPLES - 1 || sampindex == numsamples - 1)
+			for (int c = 0; c < outputs.size(); c++)
+				outputs[c].put_int_block(sampindex - blockindex, blockindex + 1, &block[0][c], 32768, std::size(cursample));
 	}
 }
 
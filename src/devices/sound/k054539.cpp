@@ -122,7 +122,12 @@ void k054539_device::sound_stream_update(sound_stream &stream, std::vector<read_
 		return;
 	}
 
-	for(int sample = 0; sample != outputs[0].samples(); sample++) {
+	// samples are gathered into a local block and written out a block at a time
+	constexpr int MAX_SAMPLES = 256;
+	s32 block[MAX_SAMPLES][2];
+	int const numsamples = outputs[0].samples();
+
+	for(int sample = 0; sample != numsamples; sample++) {
 		double lval, rval;
 		if(!(flags & DISABLE_REVERB))
 			lval = rval = rbase[reverb_pos];
@@ -300,8 +305,13 @@ void k054539_device::sound_stream_update(sound_stream &stream, std::vector<read_
 				}
 			}
 		reverb_pos = (reverb_pos + 1) & 0x1fff;
-		outputs[0].put_int(sample, lval, 32768);
-		outputs[1].put_int(sample, rval, 32768);
+		int const blockindex = sample % MAX_SAMPLES;
+		block[blockindex][0] = s32(lval);
+		block[blockindex][1] = s32(rval);
+		if(blockindex == MAX_SAMPLES - 1 || sample == numsamples - 1) {
+			outputs[0].put_int_block(sample - blockindex, blockindex + 1, &block[0][0], 32768, 2);
+			outputs[1].put_int_block(sample - blockindex, blockindex + 1, &block[0][1], 32768, 2);
+		}
 	}
 }
 
@@ -602,26 +602,33 @@ bool samples_device::load_samples()
 	// pre-size the array
 	m_sample.resize(iter.count());
 
-	// load the samples
+	struct load_job
+	{
+		std::unique_ptr<emu_file> file;
+		sample_t *sample;
+	};
+
+	// open the samples
+	std::vector<load_job> jobs;
 	int index = 0;
 	for (const char *samplename = iter.first(); samplename; index++, samplename = iter.next())
 	{
 		// attempt to open as FLAC first
-		emu_file file(machine().options().sample_path(), OPEN_FLAG_READ);
-		std::error_condition filerr = file.open(util::string_format("%s" PATH_SEPARATOR "%s.flac", basename, samplename));
+		auto file = std::make_unique<emu_file>(machine().options().sample_path(), OPEN_FLAG_READ);
+		std::error_condition filerr = file->open(util::string_format("%s" PATH_SEPARATOR "%s.flac", basename, samplename));
 		if (filerr && altbasename)
-			filerr = file.open(util::string_format("%s" PATH_SEPARATOR "%s.flac", altbasename, samplename));
+			filerr = file->open(util::string_format("%s" PATH_SEPARATOR "%s.flac", altbasename, samplename));
 
 		// if not, try as WAV
 		if (filerr)
-			filerr = file.open(util::string_format("%s" PATH_SEPARATOR "%s.wav", basename, samplename));
+			filerr = file->open(util::string_format("%s" PATH_SEPARATOR "%s.wav", basename, samplename));
 		if (filerr && altbasename)
-			filerr = file.open(util::string_format("%s" PATH_SEPARATOR "%s.wav", altbasename, samplename));
+			filerr = file->open(util::string_format("%s" PATH_SEPARATOR "%s.wav", altbasename, samplename));
 
-		// if opened, read it
+		// if opened, read it below
 		if (!filerr)
 		{
-			read_sample(file, m_sample[index]);
+			jobs.push_back(load_job{ std::move(file), &m_sample[index] });
 		}
 		else
 		{
@@ -629,5 +636,29 @@ bool samples_device::load_samples()
 			ok = false;
 		}
 	}
+	if (jobs.empty())
+		return ok;
+
+	// each sample decodes from its own file into its own buffer, so FLAC sets decode in parallel
+	auto const load_job_callback =
+		[] (void *param, int threadid) -> void *
+		{
+			load_job &job = *reinterpret_cast<load_job *>(param);
+			read_sample(*job.file, *job.sample);
+			return nullptr;
+		};
+
+	osd_work_queue *const queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (queue && osd_work_item_queue_multiple(queue, load_job_callback, jobs.size(), &jobs[0], sizeof(jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE))
+	{
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+	}
+	else
+	{
+		for (load_job &job : jobs)
+			load_job_callback(&job, 0);
+	}
+	if (queue)
+		osd_work_queue_free(queue);
 	return ok;
 }
@@ -32,10 +32,21 @@ struct SCSPDSP
 	bool Stopped;
 	int LastStep;
 
+//microprogram with the fields split out, rebuilt when MPRO changes
+	struct decoded_step
+	{
+		u8 TRA, TWT, TWA, XSEL, YSEL, IRA, IWT, IWA;
+		u8 TABLE, MWT, MRD, EWT, EWA, ADRL, FRCL, SHIFT, YRL, NEGB, ZERO, BSEL;
+		u8 NOFL, COEF, MASA, ADREB, NXADR;
+	};
+	decoded_step Decoded[128];
+	bool Dirty;
+
 	void Init();
 	void SetSample(s32 sample, s32 SEL, s32 MXL);
 	void Step();
 	void Start();
+	void Decode();
 };
 
 #endif // MAME_SOUND_SCSPDSP_H
@@ -263,6 +263,10 @@ protected:
 		int const outcount = std::min(outputs.size(), std::size(output[0].data));
 		int const numsamples = outputs[0].samples();
 
+		// each output is written straight out of the interleaved frames
+		static_assert(sizeof(output[0]) == sizeof(output[0].data), "output_data must be a plain array of samples");
+		int const stride = std::size(output[0].data);
+
 		// generate the FM/ADPCM stream
 		for (int sampindex = 0; sampindex < numsamples; sampindex += MAX_SAMPLES)
 		{
@@ -271,8 +275,7 @@ protected:
 			for (int outnum = 0; outnum < outcount; outnum++)
 			{
 				int eff_outnum = (outnum + output_shift) % OUTPUTS;
-				for (int index = 0; index < cursamples; index++)
-					outputs[eff_outnum].put_int(sampindex + index, output[index].data[outnum], 32768);
+				outputs[eff_outnum].put_int_block(sampindex, cursamples, &output[0].data[outnum], 32768, stride);
 			}
 		}
 	}
@@ -383,6 +383,25 @@ private:
 		return primitive;
 	}
 
+	// chain a unit behind the still-pending previous unit in its bucket
+	bool chain_to_previous(u32 unitnum)
+	{
+		work_unit &unit = m_unit.byindex(unitnum);
+		if (unit.previtem == 0xffffffff)
+			return false;
+
+		// a zero count_next means the previous unit has finished and won't look for a successor
+		work_unit &prevunit = m_unit.byindex(unit.previtem);
+		uint32_t orig_count_next = prevunit.count_next;
+		while (orig_count_next != 0 && !prevunit.count_next.compare_exchange_weak(orig_count_next, orig_count_next | (unitnum << 8), std::memory_order_release, std::memory_order_relaxed)) { }
+
+#if KEEP_POLY_STATISTICS
+		if (orig_count_next != 0)
+			m_chained++;
+#endif
+		return orig_count_next != 0;
+	}
+
 	// enqueue work items in contiguous chunks
 	void queue_items(u32 start)
 	{
@@ -390,13 +409,20 @@ private:
 		if (m_queue == nullptr)
 			return;
 
-		// enqueue the items in contiguous chunks
+		// enqueue the items in contiguous chunks; units that land on a band that is still
+		// busy are chained directly so that the thread owning the band picks them up, rather
+		// than being dispatched to a worker that would only find the conflict and give up
 		while (start < m_unit.count())
 		{
 			u32 chunk;
 			work_unit *base = m_unit.contiguous(start, m_unit.count() - start, chunk);
-			osd_work_item_queue_multiple(m_queue, work_item_callback, chunk, base, m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
-			start += chunk;
+			u32 run = 0;
+			bool chained = false;
+			while (run < chunk && !(chained = chain_to_previous(start + run)))
+				run++;
+			if (run != 0)
+				osd_work_item_queue_multiple(m_queue, work_item_callback, run, base, m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+			start += run + (chained ? 1 : 0);
 		}
 	}
 
@@ -423,6 +449,7 @@ private:
 #if KEEP_POLY_STATISTICS
 	uint32_t m_conflicts[WORK_MAX_THREADS] = { 0 }; // number of conflicts found, per thread
 	uint32_t m_resolved[WORK_MAX_THREADS] = { 0 };  // number of conflicts resolved, per thread
+	uint32_t m_chained = 0;                         // number of units chained at queue time
 #endif
 #if TRACK_POLY_WAITS
 	static std::string friendly_number(u64 number);
@@ -534,7 +561,7 @@ poly_manager<BaseType, ObjectType, MaxParams, Flags>::~poly_manager()
 	else
 		osd_printf_info("Total pixels   = %d\n", uint32_t(m_pixels));
 
-	osd_printf_info("Conflicts:   %d resolved, %d total\n", resolved, conflicts);
+	osd_printf_info("Conflicts:   %d resolved, %d total, %d chained when queued\n", resolved, conflicts, m_chained);
 	osd_printf_info("Units:       %5d used, %5d allocated, %4d bytes each, %7d total\n", m_unit.max(), m_unit.allocated(), int(m_unit.itemsize()), int(m_unit.allocated() * m_unit.itemsize()));
 	osd_printf_info("Primitives:  %5d used, %5d allocated, %4d bytes each, %7d total\n", m_primitive.max(), m_primitive.allocated(), int(m_primitive.itemsize()), int(m_primitive.allocated() * m_primitive.itemsize()));
 	osd_printf_info("Object data: %5d used, %5d allocated, %4d bytes each, %7d total\n", m_object.max(), m_object.allocated(), int(m_object.itemsize()), int(m_object.allocated() * m_object.itemsize()));
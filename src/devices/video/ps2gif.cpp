@@ -12,6 +12,11 @@
 #include "emu.h"
 #include "ps2gif.h"
 
+#define LOG_REGS    (1U << 1)
+
+#define VERBOSE     (0)
+#include "logmacro.h"
+
 DEFINE_DEVICE_TYPE(SONYPS2_GIF, ps2_gif_device, "ps2gif", "Playstation 2 GIF")
 
 ps2_gif_device::ps2_gif_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock)
@@ -103,57 +108,57 @@ uint32_t ps2_gif_device::read(offs_t offset)
 			if (BIT(m_ctrl, 3))
 			{
 				ret = m_ctrl;
-				logerror("%s: Read: GIF_CTRL (%08x)\n", machine().describe_context(), ret);
+				LOGMASKED(LOG_REGS, "%s: Read: GIF_CTRL (%08x)\n", machine().describe_context(), ret);
 			}
 			else
 			{
-				logerror("%s: Read: GIF_CTRL (00000000) (read-only; actual value %08x)\n", machine().describe_context(), m_ctrl);
+				LOGMASKED(LOG_REGS, "%s: Read: GIF_CTRL (00000000) (read-only; actual value %08x)\n", machine().describe_context(), m_ctrl);
 			}
 			break;
 
 		case 0x10/4: // GIF_MODE
 			ret = m_mode;
-			logerror("%s: Read: GIF_MODE (00000000) (read-only; actual value %08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_MODE (00000000) (read-only; actual value %08x)\n", machine().describe_context(), ret);
 			break;
 
 		case 0x20/4: // GIF_STAT
 			ret = m_stat;
-			logerror("%s: Read: GIF_STAT (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_STAT (%08x)\n", machine().describe_context(), ret);
 			break;
 
 		case 0x40/4: // GIF_TAG0
 			ret = m_last_tag.word(0);
-			logerror("%s: Read: GIF_TAG0 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_TAG0 (%08x)\n", machine().describe_context(), ret);
 			break;
 
 		case 0x50/4: // GIF_TAG1
 			ret = m_last_tag.word(1);
-			logerror("%s: Read: GIF_TAG1 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_TAG1 (%08x)\n", machine().describe_context(), ret);
 			break;
 
 		case 0x60/4: // GIF_TAG2
 			ret = m_last_tag.word(2);
-			logerror("%s: Read: GIF_TAG2 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_TAG2 (%08x)\n", machine().describe_context(), ret);
 			break;
 
 		case 0x70/4: // GIF_TAG3
 			ret = m_last_tag.word(0);
-			logerror("%s: Read: GIF_TAG3 (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_TAG3 (%08x)\n", machine().describe_context(), ret);
 			break;
 
 		case 0x80/4: // GIF_CNT
 			ret = m_cnt;
-			logerror("%s: Read: GIF_CNT (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_CNT (%08x)\n", machine().describe_context(), ret);
 			break;
 
 		case 0x90/4: // GIF_P3CNT
 			ret = m_p3cnt;
-			logerror("%s: Read: GIF_P3CNT (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_P3CNT (%08x)\n", machine().describe_context(), ret);
 			break;
 
 		case 0xa0/4: // GIF_P3TAG
 			ret = m_p3tag;
-			logerror("%s: Read: GIF_P3TAG (%08x)\n", machine().describe_context(), ret);
+			LOGMASKED(LOG_REGS, "%s: Read: GIF_P3TAG (%08x)\n", machine().describe_context(), ret);
 			break;
 
 		default:
@@ -173,44 +178,44 @@ void ps2_gif_device::write(offs_t offset, uint32_t data)
 			{
 				gif_reset();
 			}
-			logerror("%s: Write: GIF_CTRL = %08x: STOP=%d, RESET=%d\n", machine().describe_context(), data, BIT(data, 3), BIT(data, 0));
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_CTRL = %08x: STOP=%d, RESET=%d\n", machine().describe_context(), data, BIT(data, 3), BIT(data, 0));
 			break;
 
 		case 0x10/4: // GIF_MODE
 			m_mode = data;
-			logerror("%s: Write: GIF_MODE = %08x: IMT=%s, MASK=%s\n", machine().describe_context(), data, BIT(data, 2) ? "Intermittent" : "Continuous", BIT(data, 0) ? "Yes" : "No");
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_MODE = %08x: IMT=%s, MASK=%s\n", machine().describe_context(), data, BIT(data, 2) ? "Intermittent" : "Continuous", BIT(data, 0) ? "Yes" : "No");
 			break;
 
 		case 0x20/4: // GIF_STAT
-			logerror("%s: Write: GIF_STAT = %08x (ignored)\n", machine().describe_context(), data);
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_STAT = %08x (ignored)\n", machine().describe_context(), data);
 			break;
 
 		case 0x40/4: // GIF_TAG0
-			logerror("%s: Write: GIF_TAG0 = %08x (ignored)\n", machine().describe_context(), data);
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_TAG0 = %08x (ignored)\n", machine().describe_context(), data);
 			break;
 
 		case 0x50/4: // GIF_TAG1
-			logerror("%s: Write: GIF_TAG1 = %08x (ignored)\n", machine().describe_context(), data);
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_TAG1 = %08x (ignored)\n", machine().describe_context(), data);
 			break;
 
 		case 0x60/4: // GIF_TAG2
-			logerror("%s: Write: GIF_TAG2 = %08x (ignored)\n", machine().describe_context(), data);
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_TAG2 = %08x (ignored)\n", machine().describe_context(), data);
 			break;
 
 		case 0x70/4: // GIF_TAG3
-			logerror("%s: Write: GIF_TAG3 = %08x (ignored)\n", machine().describe_context(), data);
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_TAG3 = %08x (ignored)\n", machine().describe_context(), data);
 			break;
 
 		case 0x80/4: // GIF_CNT
-			logerror("%s: Write: GIF_CNT = %08x (ignored)\n", machine().describe_context(), data);
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_CNT = %08x (ignored)\n", machine().describe_context(), data);
 			break;
 
 		case 0x90/4: // GIF_P3CNT
-			logerror("%s: Write: GIF_P3CNT = %08x (ignored)\n", machine().describe_context(), data);
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_P3CNT = %08x (ignored)\n", machine().describe_context(), data);
 			break;
 
 		case 0xa0/4: // GIF_P3TAG
-			logerror("%s: Write: GIF_P3TAG = %08x (ignored)\n", machine().describe_context(), data);
+			LOGMASKED(LOG_REGS, "%s: Write: GIF_P3TAG = %08x (ignored)\n", machine().describe_context(), data);
 			break;
 
 		default:
@@ -971,8 +971,6 @@ void psxgpu_device::decode_tpage( uint32_t tpage )
 	} \
 	TRANSPARENCYSETUP
 
-#define FLATPOLYGONUPDATE
-#define FLATRECTANGEUPDATE
 #define GOURAUDPOLYGONUPDATE \
 	n_r.d += n_dr; \
 	n_g.d += n_dg; \
@@ -1015,6 +1013,55 @@ void psxgpu_device::decode_tpage( uint32_t tpage )
 		break; \
 	}
 
+/* flat shaded spans have a constant source colour, so look it up once per span */
+#define SOLIDFILLFLAT \
+	if( n_distance > ( (int32_t)n_drawarea_x2 - drawx ) + 1 ) \
+	{ \
+		n_distance = ( n_drawarea_x2 - drawx ) + 1; \
+	} \
+	uint16_t *p_vram = p_p_vram[ drawy ] + drawx; \
+	\
+	switch( n_cmd & 0x02 ) \
+	{ \
+	case 0x00: \
+		/* transparency off */ \
+		{ \
+			const uint16_t n_pixel = \
+				p_n_redshade[ MID_LEVEL | n_r.w.h ] | \
+				p_n_greenshade[ MID_LEVEL | n_g.w.h ] | \
+				p_n_blueshade[ MID_LEVEL | n_b.w.h ]; \
+			if( !m_check_stp ) \
+			{ \
+				std::fill_n( p_vram, std::max<int32_t>( n_distance, 0 ), m_draw_stp ? ( n_pixel | 0x8000 ) : n_pixel ); \
+				break; \
+			} \
+			while( n_distance > 0 ) \
+			{ \
+				WRITE_PIXEL( n_pixel ) \
+				p_vram++; \
+				n_distance--; \
+			} \
+		} \
+		break; \
+	case 0x02: \
+		/* transparency on */ \
+		{ \
+			const uint16_t n_fr = p_n_f[ MID_LEVEL | n_r.w.h ]; \
+			const uint16_t n_fg = p_n_f[ MID_LEVEL | n_g.w.h ]; \
+			const uint16_t n_fb = p_n_f[ MID_LEVEL | n_b.w.h ]; \
+			while( n_distance > 0 ) \
+			{ \
+				WRITE_PIXEL( \
+					p_n_redtrans[ n_fr | p_n_redb[ *( p_vram ) ] ] | \
+					p_n_greentrans[ n_fg | p_n_greenb[ *( p_vram ) ] ] | \
+					p_n_bluetrans[ n_fb | p_n_blueb[ *( p_vram ) ] ] ) \
+				p_vram++; \
+				n_distance--; \
+			} \
+		} \
+		break; \
+	}
+
 #define FLATTEXTUREDPOLYGONUPDATE \
 	n_u.d += n_du; \
 	n_v.d += n_dv;
@@ -1515,7 +1562,7 @@ void psxgpu_device::FlatPolygon( int n_points )
 				drawx = n_drawarea_x1;
 			}
 
-			SOLIDFILL( FLATPOLYGONUPDATE )
+			SOLIDFILLFLAT
 		}
 
 		n_cx1.d += n_dx1;
@@ -2341,7 +2388,7 @@ void psxgpu_device::FlatRectangle()
 				drawx = n_drawarea_x1;
 			}
 
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			SOLIDFILLFLAT
 		}
 
 		n_y++;
@@ -2390,7 +2437,7 @@ void psxgpu_device::FlatRectangle8x8()
 				drawx = n_drawarea_x1;
 			}
 
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			SOLIDFILLFLAT
 		}
 
 		n_y++;
@@ -2439,7 +2486,7 @@ void psxgpu_device::FlatRectangle16x16()
 				drawx = n_drawarea_x1;
 			}
 
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			SOLIDFILLFLAT
 		}
 
 		n_y++;
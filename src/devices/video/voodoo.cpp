@@ -318,7 +318,11 @@ tmu_state::tmu_state() :
 	m_basemask(0xfffff),
 	m_baseshift(3),
 	m_regdirty(true),
-	m_texel_lookup(nullptr)
+	m_texel_lookup(nullptr),
+	m_texel_cache_enabled(false),
+	m_texel_cache_clock(0),
+	m_texel_cache_texture(nullptr),
+	m_texel_cache_current(nullptr)
 {
 }
 
@@ -360,6 +364,9 @@ void tmu_state::post_load()
 {
 	m_regdirty = true;
 	m_palette_dirty[0] = m_palette_dirty[1] = m_palette_dirty[2] = m_palette_dirty[3] = true;
+
+	// texture RAM was replaced wholesale
+	invalidate_texels(m_ram, m_mask + 1);
 }
 
 
@@ -457,6 +464,91 @@ inline rasterizer_texture &tmu_state::prepare_texture(voodoo_renderer &renderer)
 }
 
 
+//-------------------------------------------------
+//  attach_texel_cache - point a texture about to
+//  be rendered at a pre-decoded copy of its
+//  texels, decoding them if needed; only formats
+//  with fixed lookup tables are cached, since
+//  palette and NCC lookups can change underneath
+//-------------------------------------------------
+
+void tmu_state::attach_texel_cache(voodoo_renderer &renderer, rasterizer_texture &texture)
+{
+	// fast path: same texture as last time and nothing has been written
+	if (&texture == m_texel_cache_texture && m_texel_cache_current && m_texel_cache_current->valid && texture.decoded())
+	{
+		m_texel_cache_current->lastuse = ++m_texel_cache_clock;
+		return;
+	}
+
+	u32 const format = m_reg.texture_mode().format();
+	if (!m_texel_cache_enabled || m_texel_lookup[format] == nullptr)
+		return;
+	u32 start, end;
+	if (!texture.decoded_range(format, start, end))
+		return;
+
+	// look for a matching entry, remembering the least recently used one
+	auto const key = texture.decoded_key(format);
+	texel_cache_entry *entry = nullptr;
+	texel_cache_entry *victim = &m_texel_cache[0];
+	for (auto &cur : m_texel_cache)
+	{
+		if (cur.used && cur.key == key)
+		{
+			entry = &cur;
+			break;
+		}
+		if (!cur.used || (victim->used && cur.lastuse < victim->lastuse))
+			victim = &cur;
+	}
+
+	if (!entry)
+	{
+		// queued polygons may still be reading the victim's texels, so hand
+		// them to the renderer to free once it next goes idle
+		entry = victim;
+		if (entry->used)
+			renderer.retire_texels(std::move(entry->texels));
+		entry->key = key;
+		entry->start = start;
+		entry->end = end;
+		entry->used = true;
+		entry->valid = false;
+		entry->texels = std::vector<rgb_t>(texture.decoded_size());
+	}
+
+	// (re)decode if needed; a stale entry can only be referenced by polygons
+	// queued before the texture write, and those have already completed
+	if (!entry->valid)
+	{
+		texture.decode_texels(format, &entry->texels[0], entry->lodbase);
+		entry->valid = true;
+	}
+
+	entry->lastuse = ++m_texel_cache_clock;
+	texture.set_decoded(&entry->texels[0], entry->lodbase);
+	m_texel_cache_texture = &texture;
+	m_texel_cache_current = entry;
+}
+
+
+//-------------------------------------------------
+//  invalidate_texels - mark any decoded textures
+//  covering the given span of texture RAM as
+//  stale; the caller must have waited for the
+//  renderer to go idle
+//-------------------------------------------------
+
+void tmu_state::invalidate_texels(u8 const *dest, u32 length)
+{
+	u32 const offset = dest - m_ram;
+	for (auto &entry : m_texel_cache)
+		if (entry.used && offset < entry.end && offset + length > entry.start)
+			entry.valid = false;
+}
+
+
 
 //**************************************************************************
 //  MEMORY FIFO
@@ -1001,6 +1093,14 @@ void voodoo_1_device::device_start()
 		tmu_config |= 0xc0;
 	}
 
+	// texture RAM is only written through internal_texture_w when it isn't
+	// shared with the frame buffer, so only then can decoded texels be cached
+	if (m_tmumem0_in_mb != 0)
+	{
+		m_tmu[0].enable_texel_cache();
+		m_tmu[1].enable_texel_cache();
+	}
+
 	// create the renderer
 	m_renderer = std::make_unique<voodoo_renderer>(machine(), tmu_config, m_shared->rgb565, m_reg, &m_tmu[0].regs(), BIT(m_chipmask, 2) ? &m_tmu[1].regs() : nullptr);
 
@@ -1922,6 +2022,7 @@ void voodoo_1_device::internal_texture_w(offs_t offset, u32 data)
 
 	// wait for any outstanding work to finish
 	m_renderer->wait("internal_texture_w");
+	m_tmu[tmunum].invalidate_texels(dest, 4);
 
 	// write the four bytes in little-endian order
 	if (bytes_per_texel == 1)
@@ -2966,6 +3067,7 @@ s32 voodoo_1_device::triangle()
 		poly.dt0dy = tmu0regs.dt_dy();
 		poly.dw0dy = tmu0regs.dw_dy();
 		poly.tex0 = &m_tmu[0].prepare_texture(*m_renderer.get());
+		m_tmu[0].attach_texel_cache(*m_renderer.get(), *poly.tex0);
 		if (DEBUG_STATS)
 			m_stats.m_texture_mode[tmu0regs.texture_mode().format()]++;
 	}
@@ -2985,6 +3087,7 @@ s32 voodoo_1_device::triangle()
 		poly.dt1dy = tmu1regs.dt_dy();
 		poly.dw1dy = tmu1regs.dw_dy();
 		poly.tex1 = &m_tmu[1].prepare_texture(*m_renderer.get());
+		m_tmu[1].attach_texel_cache(*m_renderer.get(), *poly.tex1);
 		if (DEBUG_STATS)
 			m_stats.m_texture_mode[tmu1regs.texture_mode().format()]++;
 	}
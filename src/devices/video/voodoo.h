@@ -154,6 +154,7 @@ public:
 
 	// configuration
 	void set_baseaddr_mask_shift(u32 mask, u8 shift) { m_basemask = mask; m_baseshift = shift; }
+	void enable_texel_cache() { m_texel_cache_enabled = true; }
 
 	// state saving
 	void register_save(save_proxy &save);
@@ -172,7 +173,24 @@ public:
 	// prepare a texture for the renderer
 	rasterizer_texture &prepare_texture(voodoo_renderer &renderer);
 
+	// decoded texel cache management
+	void attach_texel_cache(voodoo_renderer &renderer, rasterizer_texture &texture);
+	void invalidate_texels(u8 const *dest, u32 length);
+
 private:
+	// a fully decoded copy of one texture's LOD chain
+	struct texel_cache_entry
+	{
+		rasterizer_texture::decode_key key; // layout and format the texels came from
+		u32 start = 0, end = 0;              // span of texture RAM covered
+		u32 lastuse = 0;                     // clock value of last use, for LRU replacement
+		bool used = false;                   // true if the entry holds a texture
+		bool valid = false;                  // false if texture RAM was written since decoding
+		std::vector<rgb_t> texels;           // decoded texels
+		u32 lodbase[9];                      // start of each LOD within texels
+	};
+	static constexpr int TEXEL_CACHE_SIZE = 16;
+
 	// internal state
 	int m_index;                         // index of ourself
 	u8 *m_ram;                           // pointer to our RAM
@@ -190,6 +208,13 @@ private:
 	// palettes
 	bool m_palette_dirty[4];             // true if palette (0-1) or NCC (2-3) is dirty
 	rgb_t m_palette[2][256];             // 2 versions of the palette
+
+	// decoded texel cache, only used when texture RAM is private to the TMU
+	bool m_texel_cache_enabled;          // true if the cache may be used
+	u32 m_texel_cache_clock;             // incremented on each lookup
+	rasterizer_texture const *m_texel_cache_texture; // last texture attached
+	texel_cache_entry *m_texel_cache_current; // entry attached to that texture
+	std::array<texel_cache_entry, TEXEL_CACHE_SIZE> m_texel_cache;
 };
 
 
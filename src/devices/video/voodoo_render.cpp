@@ -800,6 +800,8 @@ color_equation color_equation::from_texmode(reg_texture_mode const texmode, colo
 
 void rasterizer_texture::recompute(voodoo_regs const &regs, u8 *ram, u32 mask, rgb_t const *lookup, u32 addrmask, u8 addrshift)
 {
+	m_decoded = nullptr;
+	m_decoded_lodbase = nullptr;
 	m_ram = ram;
 	m_mask = mask;
 	m_lookup = lookup;
@@ -884,6 +886,79 @@ void rasterizer_texture::recompute(voodoo_regs const &regs, u8 *ram, u32 mask, r
 }
 
 
+//-------------------------------------------------
+//  decoded_key - return a key that uniquely
+//  identifies the texels this texture decodes to,
+//  given a format with a fixed lookup table
+//-------------------------------------------------
+
+rasterizer_texture::decode_key rasterizer_texture::decoded_key(u32 format) const
+{
+	decode_key result;
+	result[0] = format;
+	result[1] = m_wmask | (m_hmask << 8);
+	std::copy_n(&m_lodoffset[0], 9, &result[2]);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  decoded_size - return the number of texels in
+//  all 9 LODs
+//-------------------------------------------------
+
+u32 rasterizer_texture::decoded_size() const
+{
+	u32 result = 0;
+	for (int lod = 0; lod <= 8; lod++)
+		result += ((m_wmask >> lod) + 1) * ((m_hmask >> lod) + 1);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  decoded_range - compute the span of texture
+//  RAM read when decoding; returns false if any
+//  LOD wraps around the end of RAM
+//-------------------------------------------------
+
+bool rasterizer_texture::decoded_range(u32 format, u32 &start, u32 &end) const
+{
+	u32 const bppscale = format >> 3;
+	start = ~u32(0);
+	end = 0;
+	for (int lod = 0; lod <= 8; lod++)
+	{
+		u32 const bytes = (((m_wmask >> lod) + 1) * ((m_hmask >> lod) + 1)) << bppscale;
+		if (m_lodoffset[lod] + bytes > m_mask + 1)
+			return false;
+		start = std::min(start, m_lodoffset[lod]);
+		end = std::max(end, m_lodoffset[lod] + bytes);
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  decode_texels - decode every texel of every
+//  LOD into the target, recording where each LOD
+//  begins
+//-------------------------------------------------
+
+void rasterizer_texture::decode_texels(u32 format, rgb_t *dest, u32 *lodbase)
+{
+	u32 index = 0;
+	for (int lod = 0; lod <= 8; lod++)
+	{
+		u32 const count = ((m_wmask >> lod) + 1) * ((m_hmask >> lod) + 1);
+		lodbase[lod] = index;
+		for (u32 texel = 0; texel < count; texel++)
+			dest[index + texel] = lookup_single_texel(format, m_lodoffset[lod], texel, 0);
+		index += count;
+	}
+}
+
+
 //-------------------------------------------------
 //  lookup_single_texel - look up the texel at the
 //  given S,T coordinate based on the format and
@@ -948,8 +1023,9 @@ inline rgbaint_t ATTR_FORCE_INLINE rasterizer_texture::fetch_texel(reg_texture_m
 	s32 ilod = lod >> 8;
 	ilod += (~m_lodmask >> ilod) & 1;
 
-	// fetch the texture base
+	// fetch the texture base, and the pre-decoded texels if we have them
 	u32 texbase = m_lodoffset[ilod];
+	rgb_t const *const decoded = m_decoded ? (m_decoded + m_decoded_lodbase[ilod]) : nullptr;
 
 	// compute the maximum s and t values at this LOD
 	s32 smax = m_wmask >> ilod;
@@ -974,7 +1050,7 @@ inline rgbaint_t ATTR_FORCE_INLINE rasterizer_texture::fetch_texel(reg_texture_m
 		t *= smax + 1;
 
 		// fetch texel data
-		result.set(lookup_single_texel(texmode.format(), texbase, s, t));
+		result.set(decoded ? decoded[t + s] : lookup_single_texel(texmode.format(), texbase, s, t));
 	}
 	else
 	{
@@ -1020,10 +1096,21 @@ inline rgbaint_t ATTR_FORCE_INLINE rasterizer_texture::fetch_texel(reg_texture_m
 		t1 *= smax + 1;
 
 		// fetch texel data
-		u32 texel0 = lookup_single_texel(texmode.format(), texbase, s, t);
-		u32 texel1 = lookup_single_texel(texmode.format(), texbase, s1, t);
-		u32 texel2 = lookup_single_texel(texmode.format(), texbase, s, t1);
-		u32 texel3 = lookup_single_texel(texmode.format(), texbase, s1, t1);
+		u32 texel0, texel1, texel2, texel3;
+		if (decoded)
+		{
+			texel0 = decoded[t + s];
+			texel1 = decoded[t + s1];
+			texel2 = decoded[t1 + s];
+			texel3 = decoded[t1 + s1];
+		}
+		else
+		{
+			texel0 = lookup_single_texel(texmode.format(), texbase, s, t);
+			texel1 = lookup_single_texel(texmode.format(), texbase, s1, t);
+			texel2 = lookup_single_texel(texmode.format(), texbase, s, t1);
+			texel3 = lookup_single_texel(texmode.format(), texbase, s1, t1);
+		}
 		result.bilinear_filter_rgbaint(texel0, texel1, texel2, texel3, sfrac, tfrac);
 	}
 	return result;
@@ -1245,6 +1332,7 @@ voodoo_renderer::voodoo_renderer(running_machine &machine, u16 tmu_config, const
 	m_tmu1_reg(tmu1_regs),
 	m_rgb565(rgb565),
 	m_fogdelta_mask(0xff),
+	m_learned_rasterizers(0),
 	m_thread_stats(WORK_MAX_THREADS)
 {
 	// empty the hash table
@@ -1253,6 +1341,7 @@ voodoo_renderer::voodoo_renderer(running_machine &machine, u16 tmu_config, const
 	// register our arrays
 	register_poly_array(m_textures);
 	register_poly_array(m_palettes);
+	register_poly_array(m_retired_texels);
 
 	// add all predefined rasterizers
 	for (static_rasterizer_info const *info = s_predef_raster_table; info->params.generic() != 0xffffffff; info++)
@@ -1261,7 +1350,7 @@ voodoo_renderer::voodoo_renderer(running_machine &machine, u16 tmu_config, const
 	// create entries for the generic rasterizers as well
 	rasterizer_params dummy_params;
 	for (int index = 0; index < std::size(m_generic_rasterizer); index++)
-		m_generic_rasterizer[index] = add_rasterizer(dummy_params, generic_rasterizer(index), true);
+		m_generic_rasterizer[index] = add_rasterizer(dummy_params, generic_rasterizer(index), true, false);
 }
 
 
@@ -1351,11 +1440,16 @@ u32 voodoo_renderer::enqueue_triangle(poly_data &poly, vertex_t const *vert)
 	// determine the index of the generic rasterizer
 	if (info == nullptr)
 	{
-		// add a new one if we're logging usage
-		if (LOG_RASTERIZERS)
-			info = add_rasterizer(poly.raster, generic_rasterizer(poly.raster.generic()), true);
+		// remember this parameter set so repeat lookups hit at the head of
+		// the chain; past the cap, just use the shared generic entry
+		u8 const index = generic_rasterizer_index(poly.raster);
+		if (LOG_RASTERIZERS || m_learned_rasterizers < MAX_LEARNED_RASTERIZERS)
+		{
+			info = add_rasterizer(poly.raster, generic_rasterizer(index), true);
+			m_learned_rasterizers++;
+		}
 		else
-			info = m_generic_rasterizer[poly.raster.generic()];
+			info = m_generic_rasterizer[index];
 	}
 
 	// set the info and render the triangle
@@ -2464,50 +2558,64 @@ void voodoo_renderer::rasterizer_fastfill(s32 y, const voodoo_renderer::extent_t
 }
 
 
+//-------------------------------------------------
+//  generic_rasterizer_entry - return the generic
+//  rasterizer for a given index; the low 4 bits
+//  are the generic texture flags, and the upper
+//  bits pin alpha and fog to "disabled" so the
+//  common case compiles those stages out
+//-------------------------------------------------
+
+template<u32 Index>
+constexpr voodoo_renderer::rasterizer_mfp voodoo_renderer::generic_rasterizer_entry()
+{
+	constexpr u32 generic = Index & 15;
+	constexpr u32 alphamode = (Index & GENERIC_INDEX_NO_ALPHA) ? 0 : reg_alpha_mode::DECODE_LIVE;
+	constexpr u32 fogmode = (Index & GENERIC_INDEX_NO_FOG) ? 0 : reg_fog_mode::DECODE_LIVE;
+	constexpr u32 texmode0 = (generic & rasterizer_params::GENERIC_TEX0) ? reg_texture_mode::DECODE_LIVE : reg_texture_mode::NONE;
+	constexpr u32 texmode1 = (generic & rasterizer_params::GENERIC_TEX1) ? reg_texture_mode::DECODE_LIVE : reg_texture_mode::NONE;
+	return &voodoo_renderer::rasterizer<generic, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, alphamode, fogmode, texmode0, texmode1>;
+}
+
+
+//-------------------------------------------------
+//  generic_rasterizer_table - build the table of
+//  all generic rasterizers
+//-------------------------------------------------
+
+template<std::size_t... Index>
+constexpr std::array<voodoo_renderer::rasterizer_mfp, sizeof...(Index)> voodoo_renderer::generic_rasterizer_table(std::index_sequence<Index...>)
+{
+	return { generic_rasterizer_entry<Index>()... };
+}
+
+
 //-------------------------------------------------
 //  generic_rasterizer - return a pointer to a
-//  generic rasterizer based on a texture enable
-//  mask
+//  generic rasterizer based on a generic index
 //-------------------------------------------------
 
-voodoo_renderer::rasterizer_mfp voodoo_renderer::generic_rasterizer(u8 texmask)
+voodoo_renderer::rasterizer_mfp voodoo_renderer::generic_rasterizer(u8 index)
 {
-	switch (texmask & 15)
-	{
-	default:
-	case 0:
-		return &voodoo_renderer::rasterizer<0, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::NONE, reg_texture_mode::NONE>;
-	case 1:
-		return &voodoo_renderer::rasterizer<1, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE, reg_texture_mode::NONE>;
-	case 2:
-		return &voodoo_renderer::rasterizer<2, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::NONE, reg_texture_mode::DECODE_LIVE>;
-	case 3:
-		return &voodoo_renderer::rasterizer<3, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE>;
-	case 4:
-		return &voodoo_renderer::rasterizer<4, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::NONE, reg_texture_mode::NONE>;
-	case 5:
-		return &voodoo_renderer::rasterizer<5, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE, reg_texture_mode::NONE>;
-	case 6:
-		return &voodoo_renderer::rasterizer<6, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::NONE, reg_texture_mode::DECODE_LIVE>;
-	case 7:
-		return &voodoo_renderer::rasterizer<7, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE>;
-	case 8:
-		return &voodoo_renderer::rasterizer<8, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::NONE, reg_texture_mode::NONE>;
-	case 9:
-		return &voodoo_renderer::rasterizer<9, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE, reg_texture_mode::NONE>;
-	case 10:
-		return &voodoo_renderer::rasterizer<10, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::NONE, reg_texture_mode::DECODE_LIVE>;
-	case 11:
-		return &voodoo_renderer::rasterizer<11, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE>;
-	case 12:
-		return &voodoo_renderer::rasterizer<12, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::NONE, reg_texture_mode::NONE>;
-	case 13:
-		return &voodoo_renderer::rasterizer<13, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE, reg_texture_mode::NONE>;
-	case 14:
-		return &voodoo_renderer::rasterizer<14, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::NONE, reg_texture_mode::DECODE_LIVE>;
-	case 15:
-		return &voodoo_renderer::rasterizer<15, reg_fbz_colorpath::DECODE_LIVE, reg_fbz_mode::DECODE_LIVE, reg_alpha_mode::DECODE_LIVE, reg_fog_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE, reg_texture_mode::DECODE_LIVE>;
-	}
+	static constexpr auto s_generic_table = generic_rasterizer_table(std::make_index_sequence<GENERIC_INDEX_COUNT>());
+	return s_generic_table[index % GENERIC_INDEX_COUNT];
+}
+
+
+//-------------------------------------------------
+//  generic_rasterizer_index - compute the index
+//  of the best generic rasterizer for a set of
+//  parameters
+//-------------------------------------------------
+
+u8 voodoo_renderer::generic_rasterizer_index(rasterizer_params const &params)
+{
+	u8 index = params.generic() & 15;
+	if (params.alphamode().raw() == 0)
+		index |= GENERIC_INDEX_NO_ALPHA;
+	if (params.fogmode().raw() == 0)
+		index |= GENERIC_INDEX_NO_FOG;
+	return index;
 }
 
 
@@ -2516,7 +2624,7 @@ voodoo_renderer::rasterizer_mfp voodoo_renderer::generic_rasterizer(u8 texmask)
 //  hash table
 //-------------------------------------------------
 
-rasterizer_info *voodoo_renderer::add_rasterizer(rasterizer_params const &params, rasterizer_mfp rasterizer, bool is_generic)
+rasterizer_info *voodoo_renderer::add_rasterizer(rasterizer_params const &params, rasterizer_mfp rasterizer, bool is_generic, bool hashed)
 {
 	rasterizer_info &info = m_rasterizer_list.emplace_back();
 
@@ -2532,7 +2640,7 @@ rasterizer_info *voodoo_renderer::add_rasterizer(rasterizer_params const &params
 
 	// hook us into the hash table
 	u32 hash = info.fullhash % RASTER_HASH_SIZE;
-	if (!is_generic || LOG_RASTERIZERS)
+	if (hashed)
 	{
 		info.next = m_raster_hash[hash];
 		m_raster_hash[hash] = &info;
@@ -362,8 +362,23 @@ public:
 		return m_ram + ((m_lodoffset[lod] + ((scale * offs) & ~3)) & m_mask);
 	}
 
+	// decoded texel support: a key identifying the layout, the number of
+	// texels across all LODs, the span of texture RAM they come from, and
+	// a routine to decode them all up front
+	using decode_key = std::array<u32, 11>;
+	decode_key decoded_key(u32 format) const;
+	u32 decoded_size() const;
+	bool decoded_range(u32 format, u32 &start, u32 &end) const;
+	void decode_texels(u32 format, rgb_t *dest, u32 *lodbase);
+
+	// point lookups at a decoded copy (or nullptr to read texture RAM)
+	rgb_t const *decoded() const { return m_decoded; }
+	void set_decoded(rgb_t const *texels, u32 const *lodbase) { m_decoded = texels; m_decoded_lodbase = lodbase; }
+
 private:
 	// internal state
+	rgb_t const *m_decoded;     // pre-decoded texels for all LODs, or nullptr
+	u32 const *m_decoded_lodbase; // index of each LOD within m_decoded
 	rgb_t const *m_lookup;      // currently selected lookup
 	u8 *m_ram;                  // pointer to base of TMU RAM
 	u8 m_wmask;                 // mask for the current texture width
@@ -490,11 +505,33 @@ struct thread_stats_block
 };
 
 
+// ======================> retired_texels
+
+// this class holds decoded texel buffers that queued work may still be
+// reading; it is registered with the poly manager, which resets it (and
+// so frees them) every time it waits for the work to complete
+class retired_texels : public poly_array_base
+{
+public:
+	void add(std::vector<rgb_t> &&texels) { m_buffers.push_back(std::move(texels)); }
+	virtual void reset() override { m_buffers.clear(); }
+
+private:
+	std::vector<std::vector<rgb_t>> m_buffers;
+};
+
+
 // ======================> voodoo_renderer
 
 class voodoo_renderer : public voodoo_poly_manager
 {
 	static constexpr u32 RASTER_HASH_SIZE = 97; // size of the rasterizer hash table
+	static constexpr u32 MAX_LEARNED_RASTERIZERS = 1024; // cap on parameter sets remembered at runtime
+
+	// generic rasterizer index bits, above the 4 generic texture flags
+	static constexpr u32 GENERIC_INDEX_NO_ALPHA = 0x10;
+	static constexpr u32 GENERIC_INDEX_NO_FOG = 0x20;
+	static constexpr u32 GENERIC_INDEX_COUNT = 0x40;
 
 public:
 	using rasterizer_mfp = void (voodoo_renderer::*)(int32_t, const extent_t &, const poly_data &, int);
@@ -516,6 +553,9 @@ public:
 	void set_fogdelta_mask(u8 value) { m_fogdelta_mask = value; }
 	void set_bilinear_mask(u8 value) { m_bilinear_mask = value; }
 
+	// hand over a decoded texel buffer that queued work may still be reading
+	void retire_texels(std::vector<rgb_t> &&texels) { m_retired_texels.add(std::move(texels)); }
+
 	// allocate a new poly_data and fill in the rasterizer_params
 	poly_data &alloc_poly();
 
@@ -588,8 +628,11 @@ private:
 	void rasterizer_fastfill(s32 scanline, const voodoo::voodoo_renderer::extent_t &extent, const voodoo::poly_data &extradata, int threadid);
 
 	// helpers
-	static rasterizer_mfp generic_rasterizer(u8 texmask);
-	voodoo::rasterizer_info *add_rasterizer(voodoo::rasterizer_params const &params, rasterizer_mfp rasterizer, bool is_generic);
+	template<u32 Index> static constexpr rasterizer_mfp generic_rasterizer_entry();
+	template<std::size_t... Index> static constexpr std::array<rasterizer_mfp, sizeof...(Index)> generic_rasterizer_table(std::index_sequence<Index...>);
+	static rasterizer_mfp generic_rasterizer(u8 index);
+	static u8 generic_rasterizer_index(voodoo::rasterizer_params const &params);
+	voodoo::rasterizer_info *add_rasterizer(voodoo::rasterizer_params const &params, rasterizer_mfp rasterizer, bool is_generic, bool hashed = true);
 
 	// internal state
 	u8 m_bilinear_mask;         // mask for bilinear resolution (0xf0 for V1, 0xff for V2)
@@ -606,7 +649,9 @@ private:
 	poly_array<voodoo::rasterizer_texture, 2> m_textures;
 	poly_array<voodoo::rasterizer_palette, 8> m_palettes;
 	voodoo::rasterizer_info *m_raster_hash[RASTER_HASH_SIZE]; // hash table of rasterizers
-	voodoo::rasterizer_info *m_generic_rasterizer[16];
+	voodoo::rasterizer_info *m_generic_rasterizer[GENERIC_INDEX_COUNT];
+	u32 m_learned_rasterizers;  // number of parameter sets added to the hash at runtime
+	voodoo::retired_texels m_retired_texels; // decoded texels to free once idle
 	std::list<voodoo::rasterizer_info> m_rasterizer_list;
 	std::vector<thread_stats_block> m_thread_stats;
 };
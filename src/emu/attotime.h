@@ -375,4 +375,74 @@ inline attotime attotime::from_double(double _time)
 }
 
 
+/**
+ * @class clock_converter
+ *
+ * Converts between attotime and ticks at a fixed frequency, replacing the
+ * divisions with multiplications by reciprocals worked out when the
+ * frequency is set.  Results are identical to attotime::from_ticks and to
+ * dividing the attoseconds by the period.
+ */
+class clock_converter
+{
+public:
+	constexpr clock_converter() noexcept : m_frequency(0), m_period(0), m_frequency_reciprocal(0), m_period_reciprocal(0) { }
+	clock_converter(u32 frequency) noexcept { set_frequency(frequency); }
+
+	void set_frequency(u32 frequency) noexcept
+	{
+		m_frequency = frequency;
+		m_period = frequency ? HZ_TO_ATTOSECONDS(frequency) : 0;
+		m_frequency_reciprocal = frequency ? (~u64(0) / frequency) : 0;
+		m_period_reciprocal = frequency ? (~u64(0) / u64(m_period)) : 0;
+	}
+
+	u32 frequency() const noexcept { return m_frequency; }
+	attoseconds_t period() const noexcept { return m_period; }
+
+	/** Convert a number of ticks to attotime */
+	attotime to_attotime(u64 ticks) const noexcept
+	{
+		if (!m_frequency)
+			return attotime::never;
+		else if (ticks < m_frequency)
+			return attotime(0, ticks * m_period);
+
+		u64 remainder;
+		u64 const secs = divide(ticks, m_frequency, m_frequency_reciprocal, remainder);
+		return attotime(seconds_t(secs), remainder * m_period);
+	}
+
+	/** Convert attotime to a number of whole ticks */
+	u64 to_ticks(const attotime &duration) const noexcept
+	{
+		if (!m_frequency)
+			return 0;
+
+		u64 remainder;
+		return mulu_32x32(duration.seconds(), m_frequency) + divide(u64(duration.attoseconds()), u64(m_period), m_period_reciprocal, remainder);
+	}
+
+private:
+	// the reciprocal is at most one short, so the estimate needs one correction at most
+	static u64 divide(u64 dividend, u64 divisor, u64 reciprocal, u64 &remainder) noexcept
+	{
+		u64 quotient;
+		mulu_64x64(dividend, reciprocal, quotient);
+		remainder = dividend - (quotient * divisor);
+		if (remainder >= divisor)
+		{
+			++quotient;
+			remainder -= divisor;
+		}
+		return quotient;
+	}
+
+	u32             m_frequency;
+	attoseconds_t   m_period;               // attoseconds per tick
+	u64             m_frequency_reciprocal; // floor((2^64 - 1) / frequency)
+	u64             m_period_reciprocal;    // floor((2^64 - 1) / period)
+};
+
+
 #endif // MAME_EMU_ATTOTIME_H
@@ -0,0 +1,305 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    bintrace.cpp
+
+    Compact binary execution traces written on a background thread.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "bintrace.h"
+
+#include "debugbuf.h"
+
+#include "multibyte.h"
+
+#include <zstd.h>
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+namespace {
+
+constexpr u8 VERSION = 1;
+constexpr u8 FLAG_REGISTERS = 0x01;
+constexpr int COMPRESSION_LEVEL = 3;
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  BINARY TRACE WRITER
+//**************************************************************************
+
+//-------------------------------------------------
+//  binary_trace_writer - constructor
+//-------------------------------------------------
+
+binary_trace_writer::binary_trace_writer(device_t &device, std::unique_ptr<std::ostream> &&file, bool registers)
+	: m_device(device)
+	, m_state(nullptr)
+	, m_file(std::move(file))
+	, m_queue_head(0)
+	, m_queue_count(0)
+	, m_exiting(false)
+{
+	// floating point registers and dividers don't fit in a u64 delta
+	if (registers && device.interface(m_state))
+	{
+		for (auto const &entry : m_state->state_entries())
+		{
+			if (entry->visible() && !entry->divider() && !entry->is_float())
+				m_registers.push_back(entry.get());
+		}
+	}
+	m_register_values.resize(m_registers.size(), 0);
+
+	// write the header
+	m_block.reserve(BLOCK_SIZE + 1024);
+	m_block.insert(m_block.end(), { 'M', 'T', 'R', 'C' });
+	put_u8(VERSION);
+	put_u8(registers ? FLAG_REGISTERS : 0);
+	put_string(device.tag());
+	put_string(device.shortname());
+	put_u16(m_registers.size());
+	for (device_state_entry const *entry : m_registers)
+	{
+		put_u16(entry->index());
+		put_string(entry->symbol());
+	}
+
+	m_thread = std::thread([this] () { writer_thread(); });
+}
+
+
+//-------------------------------------------------
+//  ~binary_trace_writer - destructor
+//-------------------------------------------------
+
+binary_trace_writer::~binary_trace_writer()
+{
+	commit(false);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_exiting = true;
+	}
+	m_work_cond.notify_one();
+	m_thread.join();
+}
+
+
+//-------------------------------------------------
+//  instruction - record an instruction about to
+//  be executed
+//-------------------------------------------------
+
+void binary_trace_writer::instruction(offs_t pc)
+{
+	// registers that changed since the last instruction
+	if (!m_registers.empty())
+	{
+		std::size_t const countpos = m_block.size();
+		unsigned count = 0;
+		put_u8(REC_REGISTERS);
+		put_u8(0);
+		for (std::size_t i = 0; (m_registers.size() > i) && (255 > count); ++i)
+		{
+			u64 const value = m_registers[i]->value();
+			if (value != m_register_values[i])
+			{
+				m_register_values[i] = value;
+				put_u16(m_registers[i]->index());
+				put_u64(value);
+				++count;
+			}
+		}
+		if (count)
+			m_block[countpos + 1] = u8(count);
+		else
+			m_block.resize(countpos);
+	}
+
+	// opcode bytes the first time this PC appears in the block
+	if (m_code.insert(pc).second)
+	{
+		debug_disasm_buffer buffer(m_device);
+		u32 const info = buffer.disassemble_info(pc);
+		std::vector<u8> opcodes;
+		buffer.data_get(pc, info & util::disasm_interface::LENGTHMASK, true, opcodes);
+		if (opcodes.size() > 255)
+			opcodes.resize(255);
+		put_u8(REC_CODE);
+		put_u32(pc);
+		put_u8(opcodes.size());
+		m_block.insert(m_block.end(), opcodes.begin(), opcodes.end());
+	}
+
+	put_u8(REC_PC);
+	put_u32(pc);
+
+	if (m_block.size() >= BLOCK_SIZE)
+		commit(false);
+}
+
+
+//-------------------------------------------------
+//  interrupt - record an interrupt being taken
+//-------------------------------------------------
+
+void binary_trace_writer::interrupt(int irqline, offs_t pc)
+{
+	put_u8(REC_INTERRUPT);
+	put_u32(pc);
+	put_u32(u32(irqline));
+}
+
+
+//-------------------------------------------------
+//  text - record text written to the trace
+//-------------------------------------------------
+
+void binary_trace_writer::text(std::string_view text)
+{
+	put_u8(REC_TEXT);
+	put_u32(text.length());
+	m_block.insert(m_block.end(), text.begin(), text.end());
+	if (m_block.size() >= BLOCK_SIZE)
+		commit(false);
+}
+
+
+//-------------------------------------------------
+//  flush - hand over the current block and wait
+//  for the writer thread to write it
+//-------------------------------------------------
+
+void binary_trace_writer::flush()
+{
+	commit(true);
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_space_cond.wait(lock, [this] () { return m_queue_count == 0; });
+}
+
+
+//-------------------------------------------------
+//  put_u16/u32/u64/string - append little-endian
+//  values to the current block
+//-------------------------------------------------
+
+void binary_trace_writer::put_u16(u16 value)
+{
+	m_block.resize(m_block.size() + 2);
+	put_u16le(&m_block[m_block.size() - 2], value);
+}
+
+void binary_trace_writer::put_u32(u32 value)
+{
+	m_block.resize(m_block.size() + 4);
+	put_u32le(&m_block[m_block.size() - 4], value);
+}
+
+void binary_trace_writer::put_u64(u64 value)
+{
+	m_block.resize(m_block.size() + 8);
+	put_u64le(&m_block[m_block.size() - 8], value);
+}
+
+void binary_trace_writer::put_string(std::string_view value)
+{
+	put_u16(value.length());
+	m_block.insert(m_block.end(), value.begin(), value.end());
+}
+
+
+//-------------------------------------------------
+//  commit - hand the current block to the writer
+//  thread, waiting for a free slot if necessary
+//-------------------------------------------------
+
+void binary_trace_writer::commit(bool flush)
+{
+	if (m_block.empty() && !flush)
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_space_cond.wait(lock, [this] () { return m_queue_count < QUEUE_DEPTH; });
+		queued_block &block = m_queue[(m_queue_head + m_queue_count) % QUEUE_DEPTH];
+
+		// swapping keeps the buffers' capacity in circulation
+		block.data.clear();
+		std::swap(block.data, m_block);
+		block.flush = flush;
+		m_queue_count++;
+	}
+	m_work_cond.notify_one();
+
+	// each block carries its own opcode bytes
+	m_code.clear();
+}
+
+
+//-------------------------------------------------
+//  writer_thread - compress and write blocks off
+//  the emulation thread
+//-------------------------------------------------
+
+void binary_trace_writer::writer_thread()
+{
+	ZSTD_CCtx *const cctx = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, COMPRESSION_LEVEL);
+	std::vector<u8> output(ZSTD_CStreamOutSize());
+	bool failed = !cctx;
+
+	// feed input through the compressor until it's consumed, or until the compressor is drained for flushes
+	auto const compress =
+			[this, cctx, &output, &failed] (u8 const *data, std::size_t length, ZSTD_EndDirective mode)
+			{
+				ZSTD_inBuffer input{ data, length, 0 };
+				bool done = failed;
+				while (!done)
+				{
+					ZSTD_outBuffer out{ output.data(), output.size(), 0 };
+					std::size_t const remaining = ZSTD_compressStream2(cctx, &out, &input, mode);
+					if (ZSTD_isError(remaining))
+					{
+						osd_printf_error("Error compressing trace for %s (%s)\n", m_device.tag(), ZSTD_getErrorName(remaining));
+						failed = true;
+						break;
+					}
+					m_file->write(reinterpret_cast<char const *>(output.data()), out.pos);
+					done = (ZSTD_e_continue == mode) ? (input.pos == input.size) : !remaining;
+				}
+			};
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_work_cond.wait(lock, [this] () { return m_queue_count != 0 || m_exiting; });
+		if (m_queue_count == 0)
+			break;
+
+		// compress outside the lock so the emulation thread can keep queueing
+		queued_block &block = m_queue[m_queue_head];
+		lock.unlock();
+		compress(block.data.data(), block.data.size(), block.flush ? ZSTD_e_flush : ZSTD_e_continue);
+		if (block.flush)
+			m_file->flush();
+		lock.lock();
+
+		m_queue_head = (m_queue_head + 1) % QUEUE_DEPTH;
+		m_queue_count--;
+		m_space_cond.notify_all();
+	}
+	lock.unlock();
+
+	// finish the zstd frame
+	compress(nullptr, 0, ZSTD_e_end);
+	m_file->flush();
+	ZSTD_freeCCtx(cctx);
+}
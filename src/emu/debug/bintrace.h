@@ -0,0 +1,117 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    bintrace.h
+
+    Compact binary execution traces written on a background thread.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_DEBUG_BINTRACE_H
+#define MAME_EMU_DEBUG_BINTRACE_H
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> binary_trace_writer
+
+// A binary trace is a zstd stream.  Decompressed, it starts with a header
+// and continues with records, all values little-endian and strings
+// prefixed by a u16 length:
+//
+// header:
+//   "MTRC" version:u8 (1) flags:u8 (bit 0 = registers) cpu:str shortname:str
+//   registers:u16 (index:u16 name:str)*registers
+//
+// records:
+//   01 pc:u32                                  instruction executed
+//   02 pc:u32 length:u8 bytes                  opcode bytes at a PC
+//   03 count:u8 (index:u16 value:u64)*count    registers changed since the last instruction
+//   05 pc:u32 irqline:s32                      interrupt taken
+//   06 length:u32 text                         output from tracelog, tracesym and logerror
+//
+// Opcode bytes precede the first instruction at a PC within each block of
+// records (BLOCK_SIZE bytes), so code that changes is picked up again in
+// the next block.  unidasm -trace turns a trace back into text.
+class binary_trace_writer
+{
+public:
+	binary_trace_writer(device_t &device, std::unique_ptr<std::ostream> &&file, bool registers);
+	~binary_trace_writer();
+
+	// recording
+	void instruction(offs_t pc);
+	void interrupt(int irqline, offs_t pc);
+	void text(std::string_view text);
+
+	// wait for everything recorded so far to reach the file
+	void flush();
+
+private:
+	// records collected before a block is handed to the writer thread
+	static constexpr std::size_t BLOCK_SIZE = 256 * 1024;
+
+	// number of blocks that may be in flight before the emulation thread waits
+	static constexpr int QUEUE_DEPTH = 4;
+
+	// record types
+	enum : u8
+	{
+		REC_PC          = 0x01,
+		REC_CODE        = 0x02,
+		REC_REGISTERS   = 0x03,
+		REC_INTERRUPT   = 0x05,
+		REC_TEXT        = 0x06
+	};
+
+	// a unit of work handed to the writer thread
+	struct queued_block
+	{
+		std::vector<u8>     data;                   // uncompressed records
+		bool                flush = false;          // flush the compressor and file afterwards
+	};
+
+	// internal helpers
+	void put_u8(u8 value) { m_block.push_back(value); }
+	void put_u16(u16 value);
+	void put_u32(u32 value);
+	void put_u64(u64 value);
+	void put_string(std::string_view value);
+	void commit(bool flush);
+	void writer_thread();
+
+	device_t &                  m_device;           // device being traced
+	device_state_interface *    m_state;            // state interface, if recording registers
+	std::vector<device_state_entry const *> m_registers; // registers to record
+	std::vector<u64>            m_register_values;  // register values at the last instruction
+	std::unordered_set<offs_t>  m_code;             // PCs with opcode bytes in this block
+	std::vector<u8>             m_block;            // block being filled on the emulation thread
+
+	// writer thread state
+	std::unique_ptr<std::ostream> m_file;           // output file, only used by the writer thread
+	std::array<queued_block, QUEUE_DEPTH> m_queue;  // ring of pending blocks
+	int                         m_queue_head;       // index of the oldest pending block
+	int                         m_queue_count;      // number of pending blocks
+	bool                        m_exiting;          // set to ask the writer thread to finish
+	std::mutex                  m_mutex;            // protects the ring indices and m_exiting
+	std::condition_variable     m_work_cond;        // signalled when work is queued or on exit
+	std::condition_variable     m_space_cond;       // signalled when a ring slot is freed
+	std::thread                 m_thread;           // writer thread
+};
+
+#endif // MAME_EMU_DEBUG_BINTRACE_H
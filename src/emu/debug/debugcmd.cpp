@@ -17,11 +17,14 @@
 #include "debughlp.h"
 #include "debugvw.h"
 #include "express.h"
+#include "pcsample.h"
 #include "points.h"
 
 #include "debugger.h"
 #include "emuopts.h"
 #include "fileio.h"
+#include "idledet.h"
+#include "memheat.h"
 #include "natkeyboard.h"
 #include "render.h"
 #include "screen.h"
@@ -269,6 +272,11 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 
 	m_console.register_command("rewind",    CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_rewind, this, _1));
 	m_console.register_command("rw",        CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_rewind, this, _1));
+	m_console.register_command("rrecord",   CMDFLAG_NONE, 0, 2, std::bind(&debugger_commands::execute_rrecord, this, _1));
+	m_console.register_command("rstep",     CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_rstep, this, _1));
+	m_console.register_command("rs",        CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_rstep, this, _1));
+	m_console.register_command("rgo",       CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_rgo, this, _1));
+	m_console.register_command("rg",        CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_rgo, this, _1));
 
 	m_console.register_command("save",      CMDFLAG_NONE, 3, 3, std::bind(&debugger_commands::execute_save, this, -1, _1));
 	m_console.register_command("saved",     CMDFLAG_NONE, 3, 3, std::bind(&debugger_commands::execute_save, this, AS_DATA, _1));
@@ -330,6 +338,12 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 	m_console.register_command("traceflush",CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_traceflush, this, _1));
 
 	m_console.register_command("history",   CMDFLAG_NONE, 0, 2, std::bind(&debugger_commands::execute_history, this, _1));
+	m_console.register_command("profile",   CMDFLAG_NONE, 0, MAX_COMMAND_PARAMS, std::bind(&debugger_commands::execute_profile, this, _1));
+	m_console.register_command("profreport", CMDFLAG_NONE, 0, 2, std::bind(&debugger_commands::execute_profreport, this, _1));
+	m_console.register_command("idleloops", CMDFLAG_NONE, 0, 2, std::bind(&debugger_commands::execute_idleloops, this, _1));
+	m_console.register_command("heatmap",   CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_heatmap, this, _1));
+	m_console.register_command("heatreport", CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_heatreport, this, _1));
+	m_console.register_command("heatdump",  CMDFLAG_NONE, 1, 1, std::bind(&debugger_commands::execute_heatdump, this, _1));
 	m_console.register_command("trackpc",   CMDFLAG_NONE, 0, 3, std::bind(&debugger_commands::execute_trackpc, this, _1));
 
 	m_console.register_command("trackmem",  CMDFLAG_NONE, 0, 3, std::bind(&debugger_commands::execute_trackmem, this, _1));
@@ -1967,6 +1981,65 @@ void debugger_commands::execute_rewind(const std::vector<std::string_view> &para
 }
 
 
+/*-------------------------------------------------
+    execute_rrecord - execute the rrecord command
+-------------------------------------------------*/
+
+void debugger_commands::execute_rrecord(const std::vector<std::string_view> &params)
+{
+	device_t *cpu;
+	if (!m_console.validate_cpu_parameter(params.size() > 1 ? params[1] : std::string_view(), cpu))
+		return;
+
+	// no parameters just reports the current state
+	device_debug &debug = *cpu->debug();
+	if (params.empty())
+	{
+		if (debug.reverse_interval())
+			m_console.printf("Recording CPU '%s' every %u instructions: %u snapshots, %u bytes\n", cpu->tag(), debug.reverse_interval(), debug.reverse_snapshot_count(), debug.reverse_snapshot_bytes());
+		else
+			m_console.printf("Reverse execution is not enabled on CPU '%s'\n", cpu->tag());
+		return;
+	}
+
+	u64 interval = 0;
+	using namespace std::literals;
+	if (!util::streqlower(params[0], "off"sv) && !m_console.validate_number_parameter(params[0], interval))
+		return;
+
+	debug.reverse_record(interval);
+	if (interval)
+		m_console.printf("Recording CPU '%s' for reverse execution every %u instructions\n", cpu->tag(), interval);
+	else
+		m_console.printf("Stopped recording CPU '%s' for reverse execution\n", cpu->tag());
+}
+
+
+/*-------------------------------------------------
+    execute_rstep - execute the rstep command
+-------------------------------------------------*/
+
+void debugger_commands::execute_rstep(const std::vector<std::string_view> &params)
+{
+	u64 steps = 1;
+	if (params.size() > 0 && !m_console.validate_number_parameter(params[0], steps))
+		return;
+
+	if (steps)
+		m_console.get_visible_cpu()->debug()->reverse_step(steps);
+}
+
+
+/*-------------------------------------------------
+    execute_rgo - execute the rgo command
+-------------------------------------------------*/
+
+void debugger_commands::execute_rgo(const std::vector<std::string_view> &params)
+{
+	m_console.get_visible_cpu()->debug()->reverse_go();
+}
+
+
 /*-------------------------------------------------
     execute_save - execute the save command
 -------------------------------------------------*/
@@ -3446,6 +3519,8 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 	std::string_view action;
 	bool detect_loops = true;
 	bool logerror = false;
+	bool binary = false;
+	bool registers = false;
 	std::string filename(params[0]);
 
 	// replace macros
@@ -3468,6 +3543,10 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 				detect_loops = false;
 			else if (util::streqlower(flag, "logerror"sv))
 				logerror = true;
+			else if (util::streqlower(flag, "binary"sv))
+				binary = true;
+			else if (util::streqlower(flag, "regs"sv))
+				registers = true;
 			else
 			{
 				m_console.printf("Invalid flag '%s'\n", flag);
@@ -3475,6 +3554,16 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 			}
 		}
 	}
+	if (binary && trace_over)
+	{
+		m_console.printf("Binary traces can't trace over subroutines\n");
+		return;
+	}
+	if (registers && !binary)
+	{
+		m_console.printf("The regs flag requires a binary trace\n");
+		return;
+	}
 	if (params.size() > 3 && !m_console.validate_command_parameter(action = params[3]))
 		return;
 
@@ -3484,6 +3573,8 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 	if (!util::streqlower(filename, "off"sv))
 	{
 		std::ios_base::openmode mode = std::ios_base::out;
+		if (binary)
+			mode |= std::ios_base::binary;
 
 		// opening for append?
 		if ((filename[0] == '>') && (filename[1] == '>'))
@@ -3504,7 +3595,7 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 
 	// do it
 	bool const on(f);
-	cpu->debug()->trace(std::move(f), trace_over, detect_loops, logerror, action);
+	cpu->debug()->trace(std::move(f), trace_over, detect_loops, logerror, action, binary, registers);
 	if (on)
 		m_console.printf("Tracing CPU '%s' to file %s\n", cpu->tag(), filename);
 	else
@@ -3570,6 +3661,322 @@ void debugger_commands::execute_history(const std::vector<std::string_view> &par
 }
 
 
+/*-------------------------------------------------
+    execute_profile - execute the profile command
+-------------------------------------------------*/
+
+void debugger_commands::execute_profile(const std::vector<std::string_view> &params)
+{
+	pc_sampler &sampler = m_machine.debugger().cpu().sampler();
+
+	// no parameters just reports the current state
+	if (params.empty())
+	{
+		if (sampler.running())
+			m_console.printf("Sampling every %u cycles\n", sampler.interval());
+		else
+			m_console.printf("Not sampling\n");
+		return;
+	}
+
+	using namespace std::literals;
+	if (util::streqlower(params[0], "off"sv))
+	{
+		sampler.stop();
+		m_console.printf("Stopped sampling; use profreport to see the results\n");
+		return;
+	}
+
+	u64 cycles;
+	if (!m_console.validate_number_parameter(params[0], cycles))
+		return;
+	if (!cycles)
+	{
+		m_console.printf("Sampling interval must be at least one cycle\n");
+		return;
+	}
+
+	// sample the given CPUs, or all of them
+	std::vector<device_t *> cpus;
+	if (params.size() > 1)
+	{
+		for (int paramnum = 1; paramnum < params.size(); paramnum++)
+		{
+			device_t *cpu;
+			if (!m_console.validate_cpu_parameter(params[paramnum], cpu))
+				return;
+			cpus.push_back(cpu);
+		}
+	}
+	else
+	{
+		for (device_execute_interface &exec : execute_interface_enumerator(m_machine.root_device()))
+			cpus.push_back(&exec.device());
+	}
+
+	sampler.start(cycles, cpus);
+	m_console.printf("Sampling every %u cycles\n", cycles);
+}
+
+
+/*-------------------------------------------------
+    execute_profreport - execute the profreport
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_profreport(const std::vector<std::string_view> &params)
+{
+	// validate parameters
+	device_t *device;
+	if (!m_console.validate_cpu_parameter(!params.empty() ? params[0] : std::string_view(), device))
+		return;
+
+	u64 count = 5;
+	if (params.size() > 1 && !m_console.validate_number_parameter(params[1], count))
+		return;
+
+	pc_sampler const &sampler = m_machine.debugger().cpu().sampler();
+	u64 const total = sampler.total(*device);
+	if (!total)
+	{
+		m_console.printf("No samples for CPU '%s'\n", device->tag());
+		return;
+	}
+
+	debug_disasm_buffer buffer(*device);
+	auto const share = [total] (u64 samples) { return 100.0 * double(samples) / double(total); };
+
+	// functions aren't known, so report runs of nearby sampled instructions
+	auto const ranges = sampler.top_ranges(*device, count);
+	m_console.printf("%u samples for CPU '%s'\n\n", total, device->tag());
+	m_console.printf("   Share  Samples  Range\n");
+	for (pc_sampler::range const &range : ranges)
+		m_console.printf("%7.2f%%  %7u  %s-%s\n", share(range.samples), range.samples, buffer.pc_to_string(range.start), buffer.pc_to_string(range.end));
+
+	m_console.printf("\n   Share  Samples  Instruction\n");
+	std::string instruction;
+	for (auto const &[pc, samples] : sampler.top_instructions(*device, count))
+	{
+		offs_t next_offset, size;
+		u32 info;
+		instruction.clear();
+		buffer.disassemble(pc, instruction, next_offset, size, info);
+		m_console.printf("%7.2f%%  %7u  %s: %s\n", share(samples), samples, buffer.pc_to_string(pc), instruction);
+	}
+
+	// annotate each range with the share of every instruction in it
+	for (pc_sampler::range const &range : ranges)
+	{
+		m_console.printf("\n%s-%s:\n", buffer.pc_to_string(range.start), buffer.pc_to_string(range.end));
+		offs_t pc = range.start;
+		while (true)
+		{
+			offs_t next_offset, size;
+			u32 info;
+			instruction.clear();
+			buffer.disassemble(pc, instruction, next_offset, size, info);
+			u64 const samples = sampler.samples_at(*device, pc);
+			if (samples)
+				m_console.printf("%7.2f%%  %s: %s\n", share(samples), buffer.pc_to_string(pc), instruction);
+			else
+				m_console.printf("          %s: %s\n", buffer.pc_to_string(pc), instruction);
+
+			// stop at the end of the range, or if the disassembler didn't move on
+			if (pc == range.end || next_offset <= pc || next_offset > range.end)
+				break;
+			pc = next_offset;
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    execute_idleloops - execute the idleloops
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_idleloops(const std::vector<std::string_view> &params)
+{
+	// validate parameters
+	device_t *device;
+	if (!m_console.validate_cpu_parameter(!params.empty() ? params[0] : std::string_view(), device))
+		return;
+
+	u64 count = 5;
+	if (params.size() > 1 && !m_console.validate_number_parameter(params[1], count))
+		return;
+
+	device_execute_interface *exec;
+	idle_loop_detector const *const detector = device->interface(exec) ? exec->idle_detector() : nullptr;
+	if (!detector || !detector->reporting())
+	{
+		m_console.printf("No idle loop candidates for CPU '%s' (needs -%s and a core that reports backward branches)\n", device->tag(), OPTION_IDLEREPORT);
+		return;
+	}
+
+	auto const candidates = detector->candidates();
+	if (candidates.empty())
+	{
+		m_console.printf("No idle loop candidates found yet for CPU '%s'\n", device->tag());
+		return;
+	}
+
+	// host time is charged by share of cycles; profiler samples are shown when there are any
+	debug_disasm_buffer buffer(*device);
+	pc_sampler const &sampler = m_machine.debugger().cpu().sampler();
+	u64 const samples = sampler.total(*device);
+	u64 const executed = exec->stat_cycles_executed();
+	double const host = double(exec->stat_host_ticks()) / double(osd_ticks_per_second());
+	m_console.printf("   Share   Host s  Sampled  Range              Polls\n");
+	std::string instruction;
+	for (std::size_t i = 0; (candidates.size() > i) && (count > i); i++)
+	{
+		idle_loop_detector::candidate const &candidate = candidates[i];
+		double const share = executed ? (double(candidate.cycles) / double(executed)) : 0.0;
+
+		u64 sampled = 0;
+		for (offs_t pc = candidate.start; samples; )
+		{
+			offs_t next_offset, size;
+			u32 info;
+			instruction.clear();
+			buffer.disassemble(pc, instruction, next_offset, size, info);
+			sampled += sampler.samples_at(*device, pc);
+			if (pc == candidate.end || next_offset <= pc || next_offset > candidate.end)
+				break;
+			pc = next_offset;
+		}
+
+		std::string polls;
+		for (idle_loop_detector::poll const &poll : candidate.polls)
+			polls += util::string_format(" %s:%X", poll.space->name(), poll.address);
+		if (!candidate.backed)
+			polls += " (device)";
+
+		m_console.printf(
+				"%7.2f%%  %7.3f  %s  %s-%s %s\n",
+				100.0 * share,
+				host * share,
+				samples ? util::string_format("%6.2f%%", 100.0 * double(sampled) / double(samples)) : std::string("      -"),
+				buffer.pc_to_string(candidate.start),
+				buffer.pc_to_string(candidate.end),
+				polls.empty() ? std::string(" -") : polls);
+	}
+}
+
+
+/*-------------------------------------------------
+    execute_heatmap - execute the heatmap command
+-------------------------------------------------*/
+
+void debugger_commands::execute_heatmap(const std::vector<std::string_view> &params)
+{
+	memory_heatmap &heatmap = m_machine.heatmap();
+
+	// no parameters just reports the current state
+	if (params.empty())
+	{
+		if (heatmap.running())
+			m_console.printf("Counting accesses in %u-byte pages\n", 1U << heatmap.page_bits());
+		else
+			m_console.printf("Not counting accesses\n");
+		return;
+	}
+
+	using namespace std::literals;
+	if (util::streqlower(params[0], "off"sv))
+	{
+		heatmap.stop();
+		m_console.printf("Stopped counting; use heatreport or heatdump to see the results\n");
+		return;
+	}
+
+	u64 bits;
+	if (!m_console.validate_number_parameter(params[0], bits))
+		return;
+	if (bits > 16)
+	{
+		m_console.printf("Page size must be between 0 and 16 bits\n");
+		return;
+	}
+
+	heatmap.start(int(bits));
+	if (heatmap.running())
+		m_console.printf("Counting accesses in %u-byte pages\n", 1U << bits);
+	else
+		m_console.printf("Couldn't start counting accesses\n");
+}
+
+
+/*-------------------------------------------------
+    execute_heatreport - execute the heatreport
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_heatreport(const std::vector<std::string_view> &params)
+{
+	u64 count = 10;
+	if (!params.empty() && !m_console.validate_number_parameter(params[0], count))
+		return;
+
+	memory_heatmap const &heatmap = m_machine.heatmap();
+	auto const pages = heatmap.pages();
+	if (pages.empty())
+	{
+		m_console.printf("No accesses counted; use heatmap to start counting\n");
+		return;
+	}
+
+	m_console.printf("        Reads        Writes  Page\n");
+	for (std::size_t i = 0; (pages.size() > i) && (count > i); i++)
+	{
+		memory_heatmap::page const &page = pages[i];
+		int const chars = page.space->logaddrchars();
+		m_console.printf(
+				"%13u %13u  %s:%s %0*X-%0*X by %s\n",
+				page.count.reads,
+				page.count.writes,
+				page.space->device().tag(),
+				page.space->name(),
+				chars, page.start,
+				chars, page.end,
+				page.accessor ? page.accessor->tag() : "(none)");
+	}
+
+	m_console.printf("\n        Reads        Writes  Handler\n");
+	auto const handlers = heatmap.handlers();
+	for (std::size_t i = 0; (handlers.size() > i) && (count > i); i++)
+	{
+		memory_heatmap::handler const &handler = handlers[i];
+		int const chars = handler.space->logaddrchars();
+		m_console.printf(
+				"%13u %13u  %s:%s %0*X-%0*X %s\n",
+				handler.count.reads,
+				handler.count.writes,
+				handler.space->device().tag(),
+				handler.space->name(),
+				chars, handler.start,
+				chars, handler.end,
+				handler.name);
+	}
+}
+
+
+/*-------------------------------------------------
+    execute_heatdump - execute the heatdump
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_heatdump(const std::vector<std::string_view> &params)
+{
+	std::string const filename(params[0]);
+	if (m_machine.heatmap().write_json(filename.c_str()))
+		m_console.printf("Wrote memory heatmap to %s\n", filename);
+	else
+		m_console.printf("Error writing memory heatmap to %s\n", filename);
+}
+
+
 /*-------------------------------------------------
     execute_trackpc - execute the trackpc command
 -------------------------------------------------*/
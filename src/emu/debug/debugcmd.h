@@ -129,6 +129,9 @@ private:
 	void execute_statesave(const std::vector<std::string_view> &params);
 	void execute_stateload(const std::vector<std::string_view> &params);
 	void execute_rewind(const std::vector<std::string_view> &params);
+	void execute_rrecord(const std::vector<std::string_view> &params);
+	void execute_rstep(const std::vector<std::string_view> &params);
+	void execute_rgo(const std::vector<std::string_view> &params);
 	void execute_save(int spacenum, const std::vector<std::string_view> &params);
 	void execute_saveregion(const std::vector<std::string_view> &params);
 	void execute_load(int spacenum, const std::vector<std::string_view> &params);
@@ -145,6 +148,12 @@ private:
 	void execute_trace(const std::vector<std::string_view> &params, bool trace_over);
 	void execute_traceflush(const std::vector<std::string_view> &params);
 	void execute_history(const std::vector<std::string_view> &params);
+	void execute_profile(const std::vector<std::string_view> &params);
+	void execute_profreport(const std::vector<std::string_view> &params);
+	void execute_idleloops(const std::vector<std::string_view> &params);
+	void execute_heatmap(const std::vector<std::string_view> &params);
+	void execute_heatreport(const std::vector<std::string_view> &params);
+	void execute_heatdump(const std::vector<std::string_view> &params);
 	void execute_trackpc(const std::vector<std::string_view> &params);
 	void execute_trackmem(const std::vector<std::string_view> &params);
 	void execute_pcatmem(int spacenum, const std::vector<std::string_view> &params);
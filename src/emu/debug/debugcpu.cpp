@@ -10,7 +10,9 @@
 
 #include "emu.h"
 #include "debugcpu.h"
+#include "bintrace.h"
 #include "debugbuf.h"
+#include "pcsample.h"
 
 #include "express.h"
 #include "points.h"
@@ -41,6 +43,7 @@ debugger_cpu::debugger_cpu(running_machine &machine)
 	, m_livecpu(nullptr)
 	, m_breakcpu(nullptr)
 	, m_symtable(nullptr)
+	, m_sampler(std::make_unique<pc_sampler>())
 	, m_vblank_occurred(false)
 	, m_execution_state(exec_state::STOPPED)
 	, m_stop_when_not_device(nullptr)
@@ -99,6 +102,15 @@ debugger_cpu::debugger_cpu(running_machine &machine)
 }
 
 
+/*-------------------------------------------------
+    destructor
+-------------------------------------------------*/
+
+debugger_cpu::~debugger_cpu()
+{
+}
+
+
 /*-------------------------------------------------
     flush_traces - flushes all traces; this is
     useful if a trace is going on when we
@@ -349,6 +361,10 @@ void debugger_cpu::stop_hook(device_t *device)
 {
 	assert(m_livecpu == device);
 
+	// sample the PC for profiling
+	if (m_sampler->running())
+		m_sampler->update(*device);
+
 	// if we are supposed to be stopped at this point (most likely because of a watchpoint), keep going until this CPU is live again
 	if (m_execution_state == exec_state::STOPPED)
 	{
@@ -442,6 +458,13 @@ device_debug::device_debug(device_t &device)
 	, m_eplist()
 	, m_triggered_breakpoint(nullptr)
 	, m_triggered_watchpoint(nullptr)
+	, m_instructions(0)
+	, m_reverse_interval(0)
+	, m_reverse_target(0)
+	, m_reverse_hit(0)
+	, m_reverse_bpindex(0)
+	, m_reverse_index(0)
+	, m_reverse_bytes(0)
 	, m_trace(nullptr)
 	, m_track_pc_set()
 	, m_track_pc(false)
@@ -802,8 +825,13 @@ void device_debug::instruction_hook(offs_t curpc)
 		m_track_pc_set.insert(dasm_pc_tag(curpc, crc));
 	}
 
-	// are we tracing?
-	if (m_trace != nullptr)
+	// count instructions and capture or replay for reverse execution
+	++m_instructions;
+	if ((m_flags & DEBUG_FLAG_REVERSE_RECORD) != 0)
+		reverse_hook(curpc);
+
+	// are we tracing? (a replay has already been traced)
+	if (m_trace != nullptr && (m_flags & DEBUG_FLAG_REPLAYING) == 0)
 		m_trace->update(curpc);
 
 	// handle single stepping
@@ -864,8 +892,8 @@ void device_debug::instruction_hook(offs_t curpc)
 		}
 	}
 
-	// handle breakpoints
-	if (!debugcpu.is_stopped() && (m_flags & (DEBUG_FLAG_STOP_TIME | DEBUG_FLAG_STOP_PC | DEBUG_FLAG_LIVE_BP)) != 0)
+	// handle breakpoints, which a replay ignores
+	if (!debugcpu.is_stopped() && (m_flags & (DEBUG_FLAG_STOP_TIME | DEBUG_FLAG_STOP_PC | DEBUG_FLAG_LIVE_BP)) != 0 && (m_flags & DEBUG_FLAG_REPLAYING) == 0)
 	{
 		// see if we hit a target time
 		if ((m_flags & DEBUG_FLAG_STOP_TIME) != 0 && machine.time() >= m_stoptime)
@@ -1168,6 +1196,278 @@ void device_debug::go_branch(bool sense, const char *condition)
 }
 
 
+//-------------------------------------------------
+//  reverse_record - start capturing snapshots
+//  every interval instructions, or stop if zero
+//-------------------------------------------------
+
+void device_debug::reverse_record(u64 interval)
+{
+	assert(m_exec != nullptr);
+
+	m_reverse_snapshots.clear();
+	m_reverse_reference.clear();
+	m_reverse_interval = interval;
+	if (interval)
+	{
+		// the first snapshot is taken by the next instruction hook
+		m_flags |= DEBUG_FLAG_REVERSE_RECORD;
+	}
+	else
+	{
+		m_flags &= ~(DEBUG_FLAG_REVERSE_RECORD | DEBUG_FLAG_REPLAYING | DEBUG_FLAG_REVERSE_SEARCH);
+	}
+}
+
+
+//-------------------------------------------------
+//  reverse_step - go back the given number of
+//  instructions by replaying from a snapshot
+//-------------------------------------------------
+
+bool device_debug::reverse_step(u64 numsteps)
+{
+	if (!reverse_ready())
+		return false;
+
+	if (numsteps >= m_instructions || m_reverse_snapshots.front().instructions > m_instructions - numsteps)
+	{
+		m_device.machine().debugger().console().printf("Not enough history to go back %u instructions\n", numsteps);
+		return false;
+	}
+
+	// replay from the newest snapshot at or before the target
+	u64 const target = m_instructions - numsteps;
+	std::size_t index = m_reverse_snapshots.size() - 1;
+	while (m_reverse_snapshots[index].instructions > target)
+		--index;
+	m_reverse_snapshots.erase(m_reverse_snapshots.begin() + index + 1, m_reverse_snapshots.end());
+	m_reverse_reference = m_reverse_snapshots.back().state->chunks();
+
+	reverse_load(index);
+	if (m_instructions != target)
+	{
+		m_reverse_target = target;
+		m_reverse_hit = 0;
+		m_flags |= DEBUG_FLAG_REPLAYING;
+		m_device.machine().debugger().cpu().set_execution_running();
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  reverse_go - go back to the latest breakpoint
+//  hit before the current instruction
+//-------------------------------------------------
+
+bool device_debug::reverse_go()
+{
+	if (!reverse_ready())
+		return false;
+
+	// search forward from the newest snapshot before here, then earlier ones
+	if (m_reverse_snapshots.front().instructions >= m_instructions)
+	{
+		m_device.machine().debugger().console().printf("No history before the current instruction\n");
+		return false;
+	}
+	m_reverse_index = m_reverse_snapshots.size() - 1;
+	while (m_reverse_snapshots[m_reverse_index].instructions >= m_instructions)
+		--m_reverse_index;
+	m_reverse_target = m_instructions;
+	m_reverse_hit = 0;
+	m_flags |= DEBUG_FLAG_REPLAYING | DEBUG_FLAG_REVERSE_SEARCH;
+
+	reverse_load(m_reverse_index);
+	m_device.machine().debugger().cpu().set_execution_running();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  reverse_ready - check that we can go back from
+//  here, printing a message if not
+//-------------------------------------------------
+
+bool device_debug::reverse_ready()
+{
+	debugger_cpu &debugcpu = m_device.machine().debugger().cpu();
+	debugger_console &console = m_device.machine().debugger().console();
+
+	if (!m_reverse_interval)
+	{
+		console.printf("Reverse execution is not enabled on CPU '%s'; use rrecord first\n", m_device.tag());
+		return false;
+	}
+
+	// instruction counts only make sense from within our own instruction hook
+	if (&m_device != debugcpu.live_cpu() || !debugcpu.within_instruction_hook())
+	{
+		console.printf("Reverse execution requires the debugger to be stopped in CPU '%s'\n", m_device.tag());
+		return false;
+	}
+
+	if (m_reverse_snapshots.empty())
+	{
+		console.printf("No snapshots have been captured yet\n");
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  reverse_capture - capture a snapshot before
+//  the current instruction executes
+//-------------------------------------------------
+
+void device_debug::reverse_capture()
+{
+	// unchanged chunks are shared with the previous snapshot
+	auto state = std::make_unique<ram_state>(m_device.machine().save(), true);
+	save_error const err = state->save_delta(m_reverse_reference, true, m_reverse_bytes);
+	if (err != STATERR_NONE)
+	{
+		m_device.machine().debugger().console().printf("Error capturing snapshot for reverse execution; recording stopped\n");
+		reverse_record(0);
+		return;
+	}
+
+	m_reverse_reference = state->chunks();
+	m_reverse_snapshots.push_back(reverse_snapshot{ m_instructions, std::move(state) });
+	if (m_reverse_snapshots.size() > REVERSE_SNAPSHOTS)
+		m_reverse_snapshots.pop_front();
+}
+
+
+//-------------------------------------------------
+//  reverse_load - restore a snapshot, leaving the
+//  CPU about to execute its instruction
+//-------------------------------------------------
+
+void device_debug::reverse_load(std::size_t index)
+{
+	reverse_snapshot &snapshot = m_reverse_snapshots[index];
+	if (snapshot.state->load() != STATERR_NONE)
+		throw emu_fatalerror("Error loading snapshot for reverse execution on CPU '%s'", m_device.tag());
+	m_instructions = snapshot.instructions;
+
+	// the hook for this instruction has already run, so check it here
+	if ((m_flags & DEBUG_FLAG_REVERSE_SEARCH) != 0 && m_instructions < m_reverse_target)
+	{
+		int const bpindex = reverse_breakpoint_hit(m_state->pcbase());
+		if (bpindex)
+		{
+			m_reverse_hit = m_instructions;
+			m_reverse_bpindex = bpindex;
+		}
+	}
+
+	// history from the abandoned future no longer applies
+	m_pc_history_valid = 0;
+	m_device.machine().debug_view().update_all();
+	m_device.machine().debugger().refresh_display();
+}
+
+
+//-------------------------------------------------
+//  reverse_truncate - forget snapshots taken
+//  after the current instruction
+//-------------------------------------------------
+
+void device_debug::reverse_truncate()
+{
+	while (!m_reverse_snapshots.empty() && m_reverse_snapshots.back().instructions > m_instructions)
+		m_reverse_snapshots.pop_back();
+	m_reverse_reference = m_reverse_snapshots.empty() ? ram_state::chunk_list() : m_reverse_snapshots.back().state->chunks();
+}
+
+
+//-------------------------------------------------
+//  reverse_hook - capture snapshots periodically,
+//  or stop a replay when it reaches its target
+//-------------------------------------------------
+
+void device_debug::reverse_hook(offs_t curpc)
+{
+	debugger_cpu &debugcpu = m_device.machine().debugger().cpu();
+
+	if ((m_flags & DEBUG_FLAG_REPLAYING) == 0)
+	{
+		if (m_reverse_snapshots.empty() || m_instructions >= m_reverse_snapshots.back().instructions + m_reverse_interval)
+			reverse_capture();
+		return;
+	}
+
+	if (m_instructions < m_reverse_target)
+	{
+		// when searching, remember the latest breakpoint hit
+		if ((m_flags & DEBUG_FLAG_REVERSE_SEARCH) != 0)
+		{
+			int const bpindex = reverse_breakpoint_hit(curpc);
+			if (bpindex)
+			{
+				m_reverse_hit = m_instructions;
+				m_reverse_bpindex = bpindex;
+			}
+		}
+		return;
+	}
+
+	if ((m_flags & DEBUG_FLAG_REVERSE_SEARCH) != 0)
+	{
+		if (m_reverse_hit)
+		{
+			// replay the interval again, this time stopping at the hit
+			m_flags &= ~DEBUG_FLAG_REVERSE_SEARCH;
+			m_reverse_target = m_reverse_hit;
+			reverse_load(m_reverse_index);
+			if (m_instructions < m_reverse_target)
+				return;
+		}
+		else if (m_reverse_index != 0)
+		{
+			// nothing in this interval, so search the one before it
+			m_reverse_target = m_reverse_snapshots[m_reverse_index].instructions;
+			reverse_load(--m_reverse_index);
+			return;
+		}
+		else
+		{
+			m_flags &= ~DEBUG_FLAG_REVERSE_SEARCH;
+			reverse_load(0);
+			m_device.machine().debugger().console().printf("No earlier breakpoint hit; stopped at the oldest snapshot\n");
+		}
+	}
+
+	if (m_reverse_hit)
+		m_device.machine().debugger().console().printf("Stopped at breakpoint %X\n", m_reverse_bpindex);
+	m_flags &= ~DEBUG_FLAG_REPLAYING;
+	reverse_truncate();
+	debugcpu.set_execution_stopped();
+}
+
+
+//-------------------------------------------------
+//  reverse_breakpoint_hit - return the index of a
+//  breakpoint hit at the given PC without acting
+//  on it, or zero
+//-------------------------------------------------
+
+int device_debug::reverse_breakpoint_hit(offs_t pc)
+{
+	auto bpitp = m_bplist.equal_range(pc);
+	for (auto bpit = bpitp.first; bpit != bpitp.second; ++bpit)
+	{
+		debug_breakpoint &bp = *bpit->second;
+		if (bp.hit(pc))
+			return bp.m_index;
+	}
+	return 0;
+}
+
+
 //-------------------------------------------------
 //  halt_on_next_instruction_impl - halt in the
 //  debugger on the next instruction, internal
@@ -1734,14 +2034,14 @@ u32 device_debug::compute_opcode_crc32(offs_t pc) const
 //  trace - trace execution of a given device
 //-------------------------------------------------
 
-void device_debug::trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action)
+void device_debug::trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action, bool binary, bool registers)
 {
 	// delete any existing tracers
 	m_trace = nullptr;
 
 	// if we have a new file, make a new tracer
 	if (file != nullptr)
-		m_trace = std::make_unique<tracer>(*this, std::move(file), trace_over, detect_loops, logerror, action);
+		m_trace = std::make_unique<tracer>(*this, std::move(file), trace_over, detect_loops, logerror, action, binary, registers);
 }
 
 
@@ -1769,7 +2069,7 @@ void device_debug::compute_debug_flags()
 
 	// if we're tracking history, or we're hooked, or stepping, or stopping at a breakpoint
 	// make sure we call the hook
-	if ((m_flags & (DEBUG_FLAG_HISTORY | DEBUG_FLAG_STEPPING_ANY | DEBUG_FLAG_STOP_PC | DEBUG_FLAG_LIVE_BP)) != 0)
+	if ((m_flags & (DEBUG_FLAG_HISTORY | DEBUG_FLAG_STEPPING_ANY | DEBUG_FLAG_STOP_PC | DEBUG_FLAG_LIVE_BP | DEBUG_FLAG_REVERSE_RECORD)) != 0)
 		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
 
 	// also call if we are tracing
@@ -1953,11 +2253,12 @@ void device_debug::breakpoint_check(offs_t pc)
 //  tracer - constructor
 //-------------------------------------------------
 
-device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action)
+device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action, bool binary, bool registers)
 	: m_debug(debug)
-	, m_file(std::move(file))
+	, m_file(binary ? nullptr : std::move(file))
+	, m_binary(binary ? std::make_unique<binary_trace_writer>(debug.device(), std::move(file), registers) : nullptr)
 	, m_action(action)
-	, m_detect_loops(detect_loops)
+	, m_detect_loops(detect_loops && !binary)
 	, m_logerror(logerror)
 	, m_loops(0)
 	, m_nextdex(0)
@@ -1975,6 +2276,7 @@ device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream>
 device_debug::tracer::~tracer()
 {
 	// make sure we close the file if we can
+	m_binary.reset();
 	m_file.reset();
 }
 
@@ -2019,6 +2321,13 @@ void device_debug::tracer::update(offs_t pc)
 	if (!m_action.empty())
 		m_debug.m_device.machine().debugger().console().execute_command(m_action, false);
 
+	// binary traces leave disassembly for later
+	if (m_binary)
+	{
+		m_binary->instruction(pc);
+		return;
+	}
+
 	debug_disasm_buffer buffer(m_debug.device());
 	std::string instruction;
 	offs_t next_pc, size;
@@ -2061,6 +2370,12 @@ void device_debug::tracer::interrupt_update(int irqline, offs_t pc)
 		m_trace_over_target = pc;
 	}
 
+	if (m_binary)
+	{
+		m_binary->interrupt(irqline, pc);
+		return;
+	}
+
 	// if we just finished looping, indicate as much
 	*m_file << "\n";
 	if (m_detect_loops && m_loops != 0)
@@ -2080,6 +2395,13 @@ void device_debug::tracer::interrupt_update(int irqline, offs_t pc)
 
 void device_debug::tracer::vprintf(util::format_argument_pack<char> const &args)
 {
+	// binary traces keep text as a record
+	if (m_binary)
+	{
+		m_binary->text(util::string_format(args));
+		return;
+	}
+
 	// pass through to the file
 	util::stream_format(*m_file, args);
 	m_file->flush();
@@ -2093,7 +2415,10 @@ void device_debug::tracer::vprintf(util::format_argument_pack<char> const &args)
 
 void device_debug::tracer::flush()
 {
-	m_file->flush();
+	if (m_binary)
+		m_binary->flush();
+	else
+		m_file->flush();
 }
 
 
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <deque>
 #include <set>
 #include <utility>
 
@@ -79,6 +80,15 @@ public:
 	void go_branch(bool sense, const char *condition);
 	void go_next_device();
 
+	// reverse execution
+	void reverse_record(u64 interval);
+	u64 reverse_interval() const { return m_reverse_interval; }
+	std::size_t reverse_snapshot_count() const { return m_reverse_snapshots.size(); }
+	std::size_t reverse_snapshot_bytes() const { return m_reverse_bytes; }
+	u64 instruction_count() const { return m_instructions; }
+	bool reverse_step(u64 numsteps = 1);
+	bool reverse_go();
+
 	template <typename Format, typename... Params>
 	void halt_on_next_instruction(Format &&fmt, Params &&... args)
 	{
@@ -149,7 +159,7 @@ public:
 	void track_mem_data_clear() { m_track_mem_set.clear(); }
 
 	// tracing
-	void trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action);
+	void trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action, bool binary = false, bool registers = false);
 	template <typename Format, typename... Params> void trace_printf(Format &&fmt, Params &&...args)
 	{
 		if (m_trace != nullptr)
@@ -178,6 +188,14 @@ private:
 	void reinstall(address_space &space, read_or_write mode);
 	void write_tracking(address_space &space, offs_t address, u64 data);
 
+	// reverse execution helpers
+	bool reverse_ready();
+	void reverse_capture();
+	void reverse_load(std::size_t index);
+	void reverse_truncate();
+	void reverse_hook(offs_t curpc);
+	int reverse_breakpoint_hit(offs_t pc);
+
 	// basic device information
 	device_t &                 m_device;                // device we are attached to
 	device_execute_interface * m_exec;                  // execute interface, if present
@@ -219,11 +237,29 @@ private:
 	debug_breakpoint *      m_triggered_breakpoint;     // latest breakpoint that was triggered
 	debug_watchpoint *      m_triggered_watchpoint;     // latest watchpoint that was triggered
 
+	// reverse execution
+	struct reverse_snapshot
+	{
+		u64                         instructions;       // instruction count when captured
+		std::unique_ptr<ram_state>  state;              // machine state before that instruction executed
+	};
+	static constexpr std::size_t REVERSE_SNAPSHOTS = 256; // oldest snapshots are discarded beyond this
+
+	u64                     m_instructions;             // instructions seen by the hook
+	u64                     m_reverse_interval;         // instructions between snapshots, 0 when not recording
+	u64                     m_reverse_target;           // instruction count to replay up to
+	u64                     m_reverse_hit;              // latest breakpoint hit while searching, 0 if none
+	int                     m_reverse_bpindex;          // index of that breakpoint
+	std::size_t             m_reverse_index;            // snapshot being searched from
+	std::size_t             m_reverse_bytes;            // memory held by snapshot chunks
+	std::deque<reverse_snapshot> m_reverse_snapshots;   // snapshots, oldest first
+	ram_state::chunk_list   m_reverse_reference;        // chunks of the newest snapshot
+
 	// tracing
 	class tracer
 	{
 	public:
-		tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action);
+		tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action, bool binary, bool registers);
 		~tracer();
 
 		void update(offs_t pc);
@@ -237,6 +273,7 @@ private:
 
 		device_debug &      m_debug;                    // reference to our owner
 		std::unique_ptr<std::ostream> m_file;           // tracing file for this CPU
+		std::unique_ptr<binary_trace_writer> m_binary;  // binary trace writer, replacing the file
 		std::string         m_action;                   // action to perform during a trace
 		offs_t              m_history[TRACE_LOOPS];     // history of recent PCs
 		bool                m_detect_loops;             // whether or not we should detect loops
@@ -332,6 +369,9 @@ private:
 	static constexpr u32 DEBUG_FLAG_STOP_PRIVILEGE  = 0x00020000;       // run until execution level changes
 	static constexpr u32 DEBUG_FLAG_STEPPING_BRANCH_TRUE  = 0x0040000;  // run until true branch
 	static constexpr u32 DEBUG_FLAG_STEPPING_BRANCH_FALSE = 0x0080000;  // run until false branch
+	static constexpr u32 DEBUG_FLAG_REVERSE_RECORD  = 0x00100000;       // capturing snapshots for reverse execution
+	static constexpr u32 DEBUG_FLAG_REPLAYING       = 0x00200000;       // replaying forward from a snapshot
+	static constexpr u32 DEBUG_FLAG_REVERSE_SEARCH  = 0x00400000;       // replaying to find the latest breakpoint hit
 	static constexpr u32 DEBUG_FLAG_CALL_IN_PROGRESS = 0x01000000;      // CPU is in the middle of a subroutine call
 	static constexpr u32 DEBUG_FLAG_TEST_IN_PROGRESS = 0x02000000;      // CPU is performing a conditional test and branch
 
@@ -340,7 +380,8 @@ private:
 	static constexpr u32 DEBUG_FLAG_TRACING_ANY     = DEBUG_FLAG_TRACING | DEBUG_FLAG_TRACING_OVER;
 	static constexpr u32 DEBUG_FLAG_TRANSIENT       = DEBUG_FLAG_STEPPING_ANY | DEBUG_FLAG_STOP_PC |
 			DEBUG_FLAG_STOP_INTERRUPT | DEBUG_FLAG_STOP_EXCEPTION | DEBUG_FLAG_STOP_VBLANK |
-			DEBUG_FLAG_STOP_TIME | DEBUG_FLAG_STOP_PRIVILEGE | DEBUG_FLAG_CALL_IN_PROGRESS | DEBUG_FLAG_TEST_IN_PROGRESS;
+			DEBUG_FLAG_STOP_TIME | DEBUG_FLAG_STOP_PRIVILEGE | DEBUG_FLAG_CALL_IN_PROGRESS | DEBUG_FLAG_TEST_IN_PROGRESS |
+			DEBUG_FLAG_REPLAYING | DEBUG_FLAG_REVERSE_SEARCH;
 };
 
 //**************************************************************************
@@ -353,6 +394,7 @@ public:
 	enum class exec_state { STOPPED, RUNNING };
 
 	debugger_cpu(running_machine &machine);
+	~debugger_cpu();
 
 	/* ----- initialization and cleanup ----- */
 
@@ -373,6 +415,12 @@ public:
 	symbol_table &global_symtable() { return *m_symtable; }
 
 
+	/* ----- profiling ----- */
+
+	/* return the PC sampling profiler */
+	pc_sampler &sampler() { return *m_sampler; }
+
+
 	/* ----- debugger comment helpers ----- */
 
 	// save all comments for a given machine
@@ -422,6 +470,7 @@ private:
 	device_t *  m_breakcpu;
 
 	std::unique_ptr<symbol_table> m_symtable;           // global symbol table
+	std::unique_ptr<pc_sampler> m_sampler;              // PC sampling profiler
 
 	bool        m_within_instruction_hook;
 	bool        m_vblank_occurred;
@@ -70,6 +70,12 @@ const help_item f_static_help_list[] =
 		"  tracelog <format>[,<item>[,...]] -- outputs one or more <item>s to the trace file using <format>\n"
 		"  tracesym <item>[,...]] -- outputs one or more <item>s to the trace file\n"
 		"  history [<CPU>,[<length>]] -- outputs a brief history of visited opcodes\n"
+		"  profile [{<cycles>|OFF}[,<CPU>[,...]]] -- sample CPU program counters every <cycles> cycles\n"
+		"  profreport [<CPU>[,<count>]] -- report the most sampled code\n"
+		"  idleloops [<CPU>[,<count>]] -- report loops found spinning with -idlereport\n"
+		"  heatmap [{<pagebits>|OFF}] -- count memory accesses per page of 2^<pagebits> bytes\n"
+		"  heatreport [<count>] -- report the most accessed pages and handlers\n"
+		"  heatdump <filename> -- write the memory access counts to a JSON file\n"
 		"  trackpc [<bool>,[<CPU>,[<bool>]]] -- visually track visited opcodes [boolean to turn on and off, for CPU, clear]\n"
 		"  trackmem [<bool>,[<CPU>,[<bool>]]] -- record which PC writes to each memory address [boolean to turn on and off, for CPU, clear]\n"
 		"  pcatmem <address>[:<space>] -- query which PC wrote to a given memory address\n"
@@ -143,6 +149,9 @@ const help_item f_static_help_list[] =
 		"  gt[ime] <milliseconds> -- resumes execution until the given delay has elapsed\n"
 		"  gv[blank] -- resumes execution, setting temp breakpoint on the next VBLANK (F8)\n"
 		"  n[ext] -- executes until the next CPU switch (F6)\n"
+		"  rrecord [<interval>|OFF[,<CPU>]] -- captures snapshots every <interval> instructions for reverse execution\n"
+		"  rs[tep] [<count>=1] -- steps backwards <count> instructions by replaying from a snapshot\n"
+		"  rg[o] -- goes backwards to the latest breakpoint hit by replaying from snapshots\n"
 		"  focus <CPU> -- focuses debugger only on <CPU>\n"
 		"  ignore [<CPU>[,<CPU>[,...]]] -- stops debugging on <CPU>\n"
 		"  observe [<CPU>[,<CPU>[,...]]] -- resumes debugging on <CPU>\n"
@@ -447,6 +456,123 @@ const help_item f_static_help_list[] =
 		"history audiocpu,1\n"
 		"  Displays the most recently visited PC addresses for the CPU ':audiocpu'.\n"
 	},
+	{
+		"profile",
+		"\n"
+		"  profile [{<cycles>|OFF}[,<CPU>[,...]]]\n"
+		"\n"
+		"The profile command starts a statistical profiler that samples the program counter of each "
+		"given CPU, or of all CPUs if none are given, every <cycles> emulated cycles of that CPU.  "
+		"Samples are taken as each CPU finishes running for a timeslice, so profiling works without "
+		"breakpoints or other debugger hooks slowing emulation down, and with the debugger window "
+		"left running.  A CPU that crosses several sampling intervals in one timeslice has all of "
+		"those samples counted at the PC where it stopped.  Starting the profiler discards earlier "
+		"samples.  OFF stops sampling and keeps the results for profreport; with no parameters, the "
+		"command reports whether sampling is in progress.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"profile 1000\n"
+		"  Sample every CPU once every 1000 cycles.\n"
+		"\n"
+		"profile 500,maincpu\n"
+		"  Sample only the CPU :maincpu, once every 500 cycles.\n"
+		"\n"
+		"profile off\n"
+		"  Stop sampling.\n"
+	},
+	{
+		"profreport",
+		"\n"
+		"  profreport [<CPU>[,<count>]]\n"
+		"\n"
+		"The profreport command reports the code where the profiler took the most samples for <CPU>, "
+		"or the currently visible CPU if none is given.  As functions aren't known, sampled "
+		"instructions no more than 16 bytes apart are grouped into ranges that stand in for them.  "
+		"The report lists the <count> most sampled ranges and instructions, 5 by default, with their "
+		"share of all samples, followed by a disassembly of each listed range showing the share of "
+		"every instruction in it.  Reports can be requested while sampling continues.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"profreport\n"
+		"  Report the five most sampled ranges and instructions for the current CPU.\n"
+		"\n"
+		"profreport audiocpu,10\n"
+		"  Report the ten most sampled ranges and instructions for the CPU :audiocpu.\n"
+	},
+	{
+		"idleloops",
+		"\n"
+		"  idleloops [<CPU>[,<count>]]\n"
+		"\n"
+		"The idleloops command lists the <count> loops, 5 by default, that <CPU> (or the currently "
+		"visible CPU) has spent the most cycles spinning in.  It needs the system to have been started "
+		"with -idlereport and a CPU core that reports backward branches.  A loop is listed if an "
+		"iteration of it wrote nothing and left every register as it found it; loops that poll a "
+		"device rather than memory are marked (device).  Each loop is shown with its share of the "
+		"CPU's cycles, the host time that share represents, its share of profiler samples if the "
+		"profile command has been used, and the addresses it reads other than its own code.  These "
+		"are the places where a driver spin loop hint would save the most time.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"idleloops\n"
+		"  List the five loops the current CPU spent the most time spinning in.\n"
+		"\n"
+		"idleloops maincpu,20\n"
+		"  List twenty loops for the CPU :maincpu.\n"
+	},
+	{
+		"heatmap",
+		"\n"
+		"  heatmap [{<pagebits>|OFF}]\n"
+		"\n"
+		"The heatmap command counts reads and writes to every address space, in pages of 2^<pagebits> "
+		"bytes, separately for each device that was executing when the access was made.  Counting "
+		"goes through memory taps, so it slows emulation down.  Starting discards earlier counts.  OFF "
+		"stops counting and keeps the results for heatreport and heatdump; with no parameters, the "
+		"command reports whether counting is in progress.  -memheatmap counts from startup and writes the results at exit.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"heatmap 8\n"
+		"  Count accesses in 256-byte pages.\n"
+		"\n"
+		"heatmap 0\n"
+		"  Count accesses to every byte, which charges handlers exactly.\n"
+		"\n"
+		"heatmap off\n"
+		"  Stop counting.\n"
+	},
+	{
+		"heatreport",
+		"\n"
+		"  heatreport [<count>]\n"
+		"\n"
+		"The heatreport command lists the <count> most accessed pages, 10 by default, and the <count> "
+		"most accessed memory handlers.  Each page's accesses are charged to the handler mapped at the "
+		"page's first address, so handlers smaller than a page are only counted exactly with smaller "
+		"pages.  Reports can be requested while counting continues.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"heatreport 20\n"
+		"  List the twenty most accessed pages and handlers.\n"
+	},
+	{
+		"heatdump",
+		"\n"
+		"  heatdump <filename>\n"
+		"\n"
+		"The heatdump command writes every page and handler counted by heatmap to <filename> as JSON, "
+		"in the same form -memheatmap writes at exit.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"heatdump heat.json\n"
+		"  Write the counts to heat.json.\n"
+	},
 	{
 		"trackpc",
 		"\n"
@@ -1004,6 +1130,67 @@ const help_item f_static_help_list[] =
 		"gni 2\n"
 		"  Resume execution, stopping at two instructions past the current one.\n"
 	},
+	{
+		"rrecord",
+		"\n"
+		"  rrecord [<interval>|OFF[,<CPU>]]\n"
+		"\n"
+		"The rrecord command enables reverse execution on <CPU>, or the currently visible CPU if none "
+		"is given, by capturing an in-memory snapshot of the machine every <interval> instructions "
+		"that CPU executes.  Snapshots only store the parts of the state that changed since the "
+		"previous one, and the oldest are discarded after 256.  The rstep and rgo commands go back "
+		"by loading the nearest earlier snapshot and replaying forward from it, so a smaller "
+		"<interval> makes going back faster at the cost of slower forward execution.  OFF stops "
+		"recording and discards the snapshots; with no parameters, the command reports how many "
+		"snapshots are held.\n"
+		"\n"
+		"Replaying arrives at the same place only if emulation is deterministic, so changing memory "
+		"or registers, or input changing during a replay, can make the result differ from what "
+		"originally happened.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"rrecord 10000\n"
+		"  Capture a snapshot every 10000 instructions on the currently visible CPU.\n"
+		"\n"
+		"rrecord off,audiocpu\n"
+		"  Stop recording the CPU :audiocpu.\n"
+	},
+	{
+		"rstep",
+		"\n"
+		"  rs[tep] [<count>=1]\n"
+		"\n"
+		"The rstep command steps the currently visible CPU backwards by <count> instructions.  It "
+		"loads the nearest snapshot captured at or before the target instruction and replays "
+		"forward from it, ignoring breakpoints along the way.  Reverse execution must first be "
+		"enabled with rrecord, and the debugger must be stopped in the CPU.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"rs\n"
+		"  Steps back one instruction on the current CPU.\n"
+		"\n"
+		"rstep 100\n"
+		"  Steps back one hundred instructions on the current CPU.\n"
+	},
+	{
+		"rgo",
+		"\n"
+		"  rg[o]\n"
+		"\n"
+		"The rgo command runs the currently visible CPU backwards until the most recent instruction "
+		"before the current one where a breakpoint would have stopped it.  It replays forward from "
+		"each snapshot in turn, newest first, noting breakpoint hits without running their actions, "
+		"then replays once more to the last hit found.  If no breakpoint was hit since the oldest "
+		"snapshot, it stops at that snapshot.  Watchpoints and registerpoints are not considered.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"bpset 1234,{a0 == 0}\n"
+		"rgo\n"
+		"  Go back to the last time the instruction at 1234 ran with A0 equal to zero.\n"
+	},
 	{
 		"gex",
 		"\n"
@@ -1179,11 +1366,16 @@ const help_item f_static_help_list[] =
 		"parameter.  If the **<filename>** begins with two right angle brackets (>>), it is treated "
 		"as a directive to open the file for appending rather than overwriting.\n"
 		"\n"
-		"The optional third parameter is a flags field.  The supported flags are 'noloop' and "
-		"'logerror'.  Multiple flags must be separated by | (pipe) characters.  By default, loops "
-		"are detected and condensed to a single line.  If the 'noloop' flag is specified, loops "
-		"will not be detected and every instruction will be logged as executed.  If the 'logerror' "
-		"flag is specified, error log output will be included in the trace log.\n"
+		"The optional third parameter is a flags field.  The supported flags are 'noloop', "
+		"'logerror', 'binary' and 'regs'.  Multiple flags must be separated by | (pipe) characters.  "
+		"By default, loops are detected and condensed to a single line.  If the 'noloop' flag is "
+		"specified, loops will not be detected and every instruction will be logged as executed.  If "
+		"the 'logerror' flag is specified, error log output will be included in the trace log.\n"
+		"\n"
+		"The 'binary' flag writes a compact compressed trace instead of text, recording every "
+		"instruction without disassembling it, which is much faster for long traces.  Adding the "
+		"'regs' flag also records registers that change.  Use 'unidasm <file> -arch <architecture> "
+		"-trace' to turn a binary trace into text.\n"
 		"\n"
 		"The optional <action> parameter is a debugger command to execute before each trace message "
 		"is logged.  Generally, this will include a 'tracelog' or 'tracesym' command to include "
@@ -1211,6 +1403,9 @@ const help_item f_static_help_list[] =
 		"  Begin tracing the execution of CPU #0, logging output (along with logerror output) to "
 		"starswep.tr, with loop detection disabled.\n"
 		"\n"
+		"trace galaga.trc,maincpu,binary|regs\n"
+		"  Begin a binary trace of the CPU ':maincpu', including register changes, in galaga.trc.\n"
+		"\n"
 		"trace >>pigskin.tr\n"
 		"  Begin tracing execution of the currently visible CPU, appending log output to "
 		"pigskin.tr.\n"
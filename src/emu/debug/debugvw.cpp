@@ -81,6 +81,7 @@ debug_view::debug_view(running_machine &machine, debug_view_type type, debug_vie
 		m_update_level(0),
 		m_update_pending(true),
 		m_osd_update_pending(true),
+		m_view_changed(true),
 		m_viewdata(m_visible.y * m_visible.x),
 		m_machine(machine)
 {
@@ -108,15 +109,17 @@ void debug_view::end_update()
 	{
 		while (m_update_pending)
 		{
-			// no longer pending, but flag for the OSD
+			// no longer pending
 			m_update_pending = false;
-			m_osd_update_pending = true;
 
 			// resize the viewdata if needed
 			m_viewdata.resize(m_visible.x * m_visible.y);
 
-			// update the view
+			// update the view, flagging for the OSD unless nothing changed
+			m_view_changed = true;
 			view_update();
+			if (m_view_changed)
+				m_osd_update_pending = true;
 		}
 	}
 
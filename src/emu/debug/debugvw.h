@@ -217,6 +217,7 @@ protected:
 	u8                      m_update_level;     // update level; updates when this hits 0
 	bool                    m_update_pending;   // true if there is a pending update
 	bool                    m_osd_update_pending; // true if there is a pending update
+	bool                    m_view_changed;     // cleared by view_update when the view data didn't change
 	std::vector<debug_view_char> m_viewdata;  // current array of view data
 
 private:
@@ -49,7 +49,8 @@ debug_view_disasm::debug_view_disasm(running_machine &machine, debug_view_osd_up
 		m_backwards_steps(3),
 		m_dasm_width(DEFAULT_DASM_WIDTH),
 		m_previous_pc(1),
-		m_expression(machine)
+		m_expression(machine),
+		m_use_cache(false)
 {
 	// fail if no available sources
 	enumerate_sources();
@@ -122,6 +123,7 @@ void debug_view_disasm::view_notify(debug_view_notification type)
 		const debug_view_disasm_source &source = downcast<const debug_view_disasm_source &>(*m_source);
 		m_expression.set_context(&source.device()->debug()->symtable());
 		m_expression.set_default_base(source.space().is_octal() ? 8 : 16);
+		m_cache.clear();
 	}
 }
 
@@ -230,7 +232,7 @@ void debug_view_disasm::generate_from_address(debug_disasm_buffer &buffer, offs_
 		offs_t size;
 		offs_t next_address;
 		u32 info;
-		buffer.disassemble(address, dasm, next_address, size, info);
+		disassemble(buffer, address, dasm, next_address, size, info);
 		m_dasm.emplace_back(address, size, dasm);
 		address = next_address;
 	}
@@ -266,7 +268,7 @@ bool debug_view_disasm::generate_with_pc(debug_disasm_buffer &buffer, offs_t pc)
 			offs_t size;
 			offs_t next_address;
 			u32 info;
-			buffer.disassemble(address, dasm, next_address, size, info);
+			disassemble(buffer, address, dasm, next_address, size, info);
 			m_dasm.emplace_back(address, size, dasm);
 			if(intf.pc_real_to_linear(address) > intf.pc_real_to_linear(next_address))
 				return false;
@@ -279,7 +281,7 @@ bool debug_view_disasm::generate_with_pc(debug_disasm_buffer &buffer, offs_t pc)
 			offs_t size;
 			offs_t next_address;
 			u32 info;
-			buffer.disassemble(address, dasm, next_address, size, info);
+			disassemble(buffer, address, dasm, next_address, size, info);
 			m_dasm.emplace_back(address, size, dasm);
 			if(address > next_address)
 				return false;
@@ -298,7 +300,7 @@ bool debug_view_disasm::generate_with_pc(debug_disasm_buffer &buffer, offs_t pc)
 		offs_t size;
 		offs_t next_address;
 		u32 info;
-		buffer.disassemble(address, dasm, next_address, size, info);
+		disassemble(buffer, address, dasm, next_address, size, info);
 		m_dasm.emplace_back(address, size, dasm);
 		address = next_address;
 	}
@@ -352,6 +354,44 @@ void debug_view_disasm::generate_dasm(debug_disasm_buffer &buffer, offs_t pc)
 	generate_from_address(buffer, pc);
 }
 
+//-------------------------------------------------
+//  disassemble - disassemble an instruction, or
+//  reuse the disassembly from an earlier update
+//  if the bytes are unchanged
+//-------------------------------------------------
+
+void debug_view_disasm::disassemble(debug_disasm_buffer &buffer, offs_t pc, std::string &dasm, offs_t &next_pc, offs_t &size, u32 &info)
+{
+	// checking the bytes catches writes and bank switches from anywhere, unlike write taps
+	auto found = m_use_cache ? m_cache.find(pc) : m_cache.end();
+	if(found != m_cache.end()) {
+		cached_dasm &cached = found->second;
+		std::vector<u8> opcodes, params;
+		buffer.data_get(pc, cached.m_size, true, opcodes);
+		buffer.data_get(pc, cached.m_size, false, params);
+		if(opcodes == cached.m_opcodes && params == cached.m_params) {
+			dasm = cached.m_dasm;
+			next_pc = cached.m_next_pc;
+			size = cached.m_size;
+			info = cached.m_info;
+			return;
+		}
+	}
+
+	buffer.disassemble(pc, dasm, next_pc, size, info);
+	if(m_use_cache) {
+		if(m_cache.size() >= DASM_CACHE_SIZE)
+			m_cache.clear();
+		cached_dasm &cached = m_cache[pc];
+		buffer.data_get(pc, size, true, cached.m_opcodes);
+		buffer.data_get(pc, size, false, cached.m_params);
+		cached.m_dasm = dasm;
+		cached.m_next_pc = next_pc;
+		cached.m_size = size;
+		cached.m_info = info;
+	}
+}
+
 void debug_view_disasm::complete_information(const debug_view_disasm_source &source, debug_disasm_buffer &buffer, offs_t pc)
 {
 	for(auto &dasm : m_dasm) {
@@ -383,6 +423,12 @@ void debug_view_disasm::view_update()
 	debug_disasm_buffer buffer(*source.device());
 	offs_t pc = source.pcbase();
 
+	// only reuse disassembly while running: updates are frequent then, and
+	// disassemblers that depend on CPU modes are brought up to date on stopping
+	m_use_cache = !machine().debugger().cpu().is_stopped();
+	if(!m_use_cache)
+		m_cache.clear();
+
 	generate_dasm(buffer, pc);
 
 	complete_information(source, buffer, pc);
@@ -18,6 +18,9 @@
 
 #include "vecstream.h"
 
+#include <unordered_map>
+#include <vector>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -111,12 +114,24 @@ private:
 		dasm_line(offs_t address, offs_t size, std::string dasm) : m_address(address), m_size(size), m_dasm(dasm), m_is_pc(false), m_is_bp(false), m_is_visited(false) {}
 	};
 
+	// A disassembled instruction kept while the machine runs, along with the
+	// bytes it was disassembled from so it can be checked cheaply.
+	struct cached_dasm {
+		std::vector<u8> m_opcodes;              // opcode bytes
+		std::vector<u8> m_params;               // parameter bytes
+		std::string m_dasm;                     // disassembly
+		offs_t m_next_pc;                       // address of the next instruction
+		offs_t m_size;                          // size of the instruction
+		u32 m_info;                             // disassembler flags
+	};
+
 	// internal helpers
 	void generate_from_address(debug_disasm_buffer &buffer, offs_t address);
 	bool generate_with_pc(debug_disasm_buffer &buffer, offs_t pc);
 	int address_position(offs_t pc) const;
 	void generate_dasm(debug_disasm_buffer &buffer, offs_t pc);
 	void complete_information(const debug_view_disasm_source &source, debug_disasm_buffer &buffer, offs_t pc);
+	void disassemble(debug_disasm_buffer &buffer, offs_t pc, std::string &dasm, offs_t &next_pc, offs_t &size, u32 &info);
 
 	void enumerate_sources();
 	void print(int row, std::string text, int start, int end, u8 attrib);
@@ -129,11 +144,14 @@ private:
 	offs_t                 m_previous_pc;          // previous pc, to detect whether it changed
 	debug_view_expression  m_expression;           // expression-related information
 	std::vector<dasm_line> m_dasm;                 // disassembled instructions
+	std::unordered_map<offs_t, cached_dasm> m_cache; // instructions disassembled while running
+	bool                   m_use_cache;            // whether to use the cache for this update
 
 	// constants
 	static constexpr int DEFAULT_DASM_LINES = 1000;
 	static constexpr int DEFAULT_DASM_WIDTH = 50;
 	static constexpr int DASM_MAX_BYTES = 16;
+	static constexpr size_t DASM_CACHE_SIZE = 16384;
 };
 
 #endif // MAME_EMU_DEBUG_DVDISASM_H
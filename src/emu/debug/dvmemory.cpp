@@ -133,7 +133,9 @@ debug_view_memory::debug_view_memory(running_machine &machine, debug_view_osd_up
 		m_address_radix(16),
 		m_maxaddr(0),
 		m_bytes_per_row(16),
-		m_byte_offset(0)
+		m_byte_offset(0),
+		m_row_left(0),
+		m_row_width(0)
 {
 	// hack: define some sane init values
 	// that don't hurt the initial computation of top_left
@@ -421,9 +423,22 @@ void debug_view_memory::view_update()
 {
 	const debug_view_memory_source &source = downcast<const debug_view_memory_source &>(*m_source);
 
-	// if we need to recompute, do it now
+	// if we need to recompute, do it now, and regenerate every row
 	if (needs_recompute())
+	{
 		recompute();
+		m_row_states.clear();
+	}
+
+	// scrolling sideways or resizing moves everything
+	bool const regenerate = (m_row_states.size() != m_visible.y) || (m_row_left != m_topleft.x) || (m_row_width != m_visible.x);
+	if (regenerate)
+	{
+		m_row_states.assign(m_visible.y, row_state());
+		m_row_left = m_topleft.x;
+		m_row_width = m_visible.x;
+	}
+	bool changed = regenerate;
 
 	// loop over visible rows
 	for (u32 row = 0; row < m_visible.y; row++)
@@ -433,6 +448,22 @@ void debug_view_memory::view_update()
 		debug_view_char *destrow = destmin - m_topleft.x;
 		u32 effrow = m_topleft.y + row;
 
+		// leave the row alone if its data, address and cursor are the same as last time
+		row_state state;
+		state.valid = effrow < m_total.y;
+		if (state.valid)
+		{
+			offs_t addrbyte = m_byte_offset + effrow * m_bytes_per_row;
+			state.address = (source.m_space != nullptr) ? source.m_space->byte_to_address(addrbyte) : addrbyte;
+			state.hash = row_hash(state.address);
+		}
+		if (m_cursor_visible && effrow == m_cursor.y)
+			state.cursor = m_cursor.x;
+		if (!regenerate && state == m_row_states[row])
+			continue;
+		m_row_states[row] = state;
+		changed = true;
+
 		// reset the line of data; section 1 is normal, others are ancillary, cursor is selected
 		u32 effcol = m_topleft.x;
 		for (debug_view_char *dest = destmin; dest != destmax; dest++, effcol++)
@@ -448,13 +479,56 @@ void debug_view_memory::view_update()
 		}
 
 		// if this visible row is valid, add it to the buffer
-		if (effrow < m_total.y)
+		if (state.valid)
+			generate_row(destmin, destmax, destrow, state.address);
+	}
+
+	// spare the OSD a redraw if nothing changed
+	if (!changed)
+		m_view_changed = false;
+}
+
+
+//-------------------------------------------------
+//  row_hash - hash the data shown on a row, read
+//  the same way generate_row reads it
+//-------------------------------------------------
+
+u64 debug_view_memory::row_hash(offs_t address)
+{
+	// FNV-1a over the chunk values and whether they're mapped
+	u64 hash = 0xcbf29ce484222325U;
+	auto const add = [&hash] (u64 value)
+	{
+		hash ^= value;
+		hash *= 0x100000001b3U;
+	};
+
+	for (int chunknum = 0; chunknum < m_chunks_per_row; chunknum++)
+	{
+		bool ismapped;
+		if (m_shift_bits != 0)
 		{
-			offs_t addrbyte = m_byte_offset + effrow * m_bytes_per_row;
-			offs_t address = (source.m_space != nullptr) ? source.m_space->byte_to_address(addrbyte) : addrbyte;
-			generate_row(destmin, destmax, destrow, address);
+			u64 chunkdata;
+			ismapped = read_chunk(address, chunknum, chunkdata);
+			add(chunkdata);
+		}
+		else if (m_data_format != data_format::FLOAT_80BIT)
+		{
+			u64 chunkdata = 0;
+			ismapped = read(m_bytes_per_chunk, address + chunknum * m_steps_per_chunk, chunkdata);
+			add(chunkdata);
+		}
+		else
+		{
+			extFloat80_t chunkdata80 = { 0, 0 };
+			ismapped = read(m_bytes_per_chunk, address + chunknum * m_steps_per_chunk, chunkdata80);
+			add(chunkdata80.signif);
+			add(chunkdata80.signExp);
 		}
+		add(ismapped ? 1 : 0);
 	}
+	return hash;
 }
 
 
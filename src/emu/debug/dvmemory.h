@@ -131,6 +131,7 @@ private:
 	bool read(u8 size, offs_t offs, extFloat80_t &data);
 	bool read_chunk(offs_t address, int chunknum, u64 &chunkdata);
 	void generate_row(debug_view_char *destmin, debug_view_char *destmax, debug_view_char *destrow, offs_t address);
+	u64 row_hash(offs_t address);
 
 	// internal state
 	debug_view_expression m_expression;         // expression describing the start address
@@ -157,6 +158,20 @@ private:
 	};
 	section             m_section[3];           // (derived) 3 sections to manage
 
+	// what each visible row was last generated from, so unchanged rows can be skipped
+	struct row_state
+	{
+		bool operator==(const row_state &that) const { return (hash == that.hash) && (address == that.address) && (cursor == that.cursor) && (valid == that.valid); }
+
+		u64             hash = 0;               // hash of the data read for the row
+		offs_t          address = 0;            // address of the row
+		s32             cursor = -1;            // column of the cursor, if it's on the row
+		bool            valid = false;          // row is within the view's total size
+	};
+	std::vector<row_state> m_row_states;        // state of each visible row
+	s32                 m_row_left;             // left column when the rows were generated
+	s32                 m_row_width;            // visible width when the rows were generated
+
 	struct memory_view_pos
 	{
 		u8           m_bytes;                // bytes per entry
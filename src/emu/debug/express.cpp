@@ -33,6 +33,8 @@
 #include "express.h"
 
 #include "corestr.h"
+
+#include <algorithm>
 #include <cctype>
 
 
@@ -101,6 +103,16 @@ enum
 	TVL_EXECUTEFUNC
 };
 
+// compiled_op.opcode values that aren't operators
+enum
+{
+	CVL_NUMBER = 0x80,
+	CVL_SYMBOL,
+	CVL_CALL,
+	CVL_ADDRESS,            // memory assignment target: leave the address on the stack
+	CVL_PLACEHOLDER         // symbol assignment target: push a placeholder
+};
+
 
 
 //**************************************************************************
@@ -781,6 +793,52 @@ u64 symbol_table::read_memory_region(const char *rgntag, offs_t address, int siz
 }
 
 
+//-------------------------------------------------
+//  physical_space - find the address space and
+//  physical address a write to a program, data,
+//  I/O or opcode space would currently go to
+//-------------------------------------------------
+
+address_space *symbol_table::physical_space(const char *name, expression_space spacenum, offs_t &address)
+{
+	device_memory_interface *memory = m_memintf;
+
+	bool logical = true;
+	switch (spacenum)
+	{
+	case EXPSPACE_PROGRAM_PHYSICAL:
+	case EXPSPACE_DATA_PHYSICAL:
+	case EXPSPACE_IO_PHYSICAL:
+	case EXPSPACE_OPCODE_PHYSICAL:
+		spacenum = expression_space(spacenum - (EXPSPACE_PROGRAM_PHYSICAL - EXPSPACE_PROGRAM_LOGICAL));
+		logical = false;
+		[[fallthrough]];
+	case EXPSPACE_PROGRAM_LOGICAL:
+	case EXPSPACE_DATA_LOGICAL:
+	case EXPSPACE_IO_LOGICAL:
+	case EXPSPACE_OPCODE_LOGICAL:
+		{
+			int space = AS_PROGRAM + (spacenum - EXPSPACE_PROGRAM_LOGICAL);
+			expression_get_space(name, space, memory);
+			if (!memory)
+				return nullptr;
+
+			address_space *tspace = &memory->space(space);
+			if (logical)
+			{
+				address &= tspace->logaddrmask();
+				if (!memory->translate(space, device_memory_interface::TR_WRITE, address, tspace))
+					return nullptr;
+			}
+			return tspace;
+		}
+
+	default:
+		return nullptr;
+	}
+}
+
+
 //-------------------------------------------------
 //  set_memory_value - write 1,2,4 or 8 bytes at
 //  the given offset in the given address space
@@ -1054,12 +1112,17 @@ void parsed_expression::parse(std::string_view expression)
 	m_original_string.assign(expression);
 	m_tokenlist.clear();
 	m_stringlist.clear();
+	m_compiled.clear();
 
 	// first parse the tokens into the token array in order
 	parse_string_into_tokens();
 
 	// convert the infix order to postfix order
 	infix_to_postfix();
+
+	// expressions that only read values or make plain assignments can skip the token stack
+	if (!compile())
+		m_compiled.clear();
 }
 
 
@@ -1072,6 +1135,7 @@ void parsed_expression::copy(const parsed_expression &src)
 	m_symtable = src.m_symtable;
 	m_default_base = src.m_default_base;
 	m_original_string.assign(src.m_original_string);
+	m_compiled.clear();
 	if (!m_original_string.empty())
 		parse_string_into_tokens();
 }
@@ -2146,6 +2210,268 @@ u64 parsed_expression::execute_tokens()
 
 
 
+//-------------------------------------------------
+//  compile - convert a postfix sequence of
+//  tokens into steps operating on a plain stack
+//  of values; returns false for expressions that
+//  use compound assignments or increments, use
+//  strings, read memory with side effects, or
+//  would fail, which are left to execute_tokens
+//-------------------------------------------------
+
+bool parsed_expression::compile()
+{
+	// track the offset of each value execution would leave on the stack, with function symbols
+	// marked, along with the step that pushed symbols and memory values that can be assigned to
+	struct stack_entry { symbol_entry *function; int offset; int lval = -1; bool readable = true; };
+	std::vector<stack_entry> stack;
+	auto const pop_value =
+			[&stack] (int &offset) -> bool
+			{
+				if (stack.empty() || stack.back().function || !stack.back().readable)
+					return false;
+				offset = stack.back().offset;
+				stack.pop_back();
+				return true;
+			};
+
+	for (parse_token &token : m_tokenlist)
+	{
+		compiled_op op{ 0, 0, 0, false, token.offset(), 0, nullptr, nullptr };
+		int offset1, offset2;
+		if (token.is_number())
+		{
+			op.opcode = CVL_NUMBER;
+			op.value = token.value();
+			stack.push_back(stack_entry{ nullptr, token.offset() });
+		}
+		else if (token.is_symbol())
+		{
+			// function symbols only mark where the parameters start
+			stack.push_back(stack_entry{ token.symbol().is_function() ? &token.symbol() : nullptr, token.offset(), token.symbol().is_lval() ? int(m_compiled.size()) : -1 });
+			if (token.symbol().is_function())
+				continue;
+			op.opcode = CVL_SYMBOL;
+			op.symbol = &token.symbol();
+		}
+		else if (!token.is_operator())
+		{
+			return false;
+		}
+		else
+		{
+			op.opcode = token.optype();
+			switch (token.optype())
+			{
+				case TVL_COMPLEMENT:
+				case TVL_NOT:
+				case TVL_UPLUS:
+				case TVL_UMINUS:
+					if (!pop_value(offset1))
+						return false;
+					stack.push_back(stack_entry{ nullptr, offset1 });
+					break;
+
+				case TVL_MULTIPLY:
+				case TVL_DIVIDE:
+				case TVL_MODULO:
+				case TVL_ADD:
+				case TVL_SUBTRACT:
+				case TVL_LSHIFT:
+				case TVL_RSHIFT:
+				case TVL_LESS:
+				case TVL_LESSOREQUAL:
+				case TVL_GREATER:
+				case TVL_GREATEROREQUAL:
+				case TVL_EQUAL:
+				case TVL_NOTEQUAL:
+				case TVL_BAND:
+				case TVL_BXOR:
+				case TVL_BOR:
+				case TVL_LAND:
+				case TVL_LOR:
+					if (!pop_value(offset2) || !pop_value(offset1))
+						return false;
+					op.offset = offset2;
+					stack.push_back(stack_entry{ nullptr, std::min(offset1, offset2) });
+					break;
+
+				case TVL_COMMA:
+					if (token.is_function_separator())
+						continue;
+					if (!pop_value(offset2) || !pop_value(offset1))
+						return false;
+					stack.push_back(stack_entry{ nullptr, offset2 });
+					break;
+
+				case TVL_MEMORYAT:
+					// reads that may have side effects keep the interpreter's ordering, but can be assigned to
+					if (!pop_value(offset1))
+						return false;
+					op.space = token.memory_space();
+					op.size = 1 << token.memory_size();
+					op.disable_se = token.memory_side_effects();
+					op.source = token.memory_source();
+					stack.push_back(stack_entry{ nullptr, offset1, int(m_compiled.size()), token.memory_side_effects() });
+					break;
+
+				case TVL_ASSIGN:
+					{
+						// turn the step that read the target into one that leaves something to assign to
+						if (!pop_value(offset2) || stack.empty() || (0 > stack.back().lval))
+							return false;
+						compiled_op &target = m_compiled[stack.back().lval];
+						stack.pop_back();
+						op.space = target.space;
+						op.size = target.size;
+						op.disable_se = target.disable_se;
+						op.source = target.source;
+						op.symbol = target.symbol;
+						target.opcode = (CVL_SYMBOL == target.opcode) ? CVL_PLACEHOLDER : CVL_ADDRESS;
+						stack.push_back(stack_entry{ nullptr, offset2 });
+					}
+					break;
+
+				case TVL_EXECUTEFUNC:
+					{
+						// parameters are whatever was pushed since the function symbol
+						auto const function = std::find_if(stack.rbegin(), stack.rend(), [] (stack_entry const &entry) { return entry.function; });
+						if (stack.rend() == function)
+							return false;
+						int const paramcount = function - stack.rbegin();
+						function_symbol_entry *const entry = downcast<function_symbol_entry *>(function->function);
+						if ((paramcount >= MAX_FUNCTION_PARAMS) || (paramcount < entry->minparams()) || (paramcount > entry->maxparams()))
+							return false;
+						op.opcode = CVL_CALL;
+						op.value = paramcount;
+						op.symbol = entry;
+						stack.resize(stack.size() - paramcount - 1);
+						stack.push_back(stack_entry{ nullptr, token.offset() });
+					}
+					break;
+
+				default:
+					return false;
+			}
+		}
+
+		if (stack.size() > MAX_COMPILED_DEPTH)
+			return false;
+		m_compiled.push_back(op);
+	}
+
+	// a valid expression leaves exactly one value
+	return (stack.size() == 1) && !stack.back().function && stack.back().readable;
+}
+
+
+//-------------------------------------------------
+//  memory_store_target - if the expression does
+//  nothing but store a value computed from
+//  numbers and symbols to a constant memory
+//  address, describe where it stores
+//-------------------------------------------------
+
+bool parsed_expression::memory_store_target(const char *&name, expression_space &space, u32 &address, int &size) const
+{
+	if ((m_compiled.size() < 4) || (CVL_NUMBER != m_compiled[0].opcode) || (CVL_ADDRESS != m_compiled[1].opcode))
+		return false;
+	compiled_op const &store = m_compiled.back();
+	if ((TVL_ASSIGN != store.opcode) || store.symbol)
+		return false;
+	for (auto op = m_compiled.begin() + 2; (m_compiled.end() - 1) != op; ++op)
+	{
+		if ((TVL_MEMORYAT == op->opcode) || (TVL_ASSIGN == op->opcode) || (CVL_ADDRESS == op->opcode) || (CVL_PLACEHOLDER == op->opcode) || (CVL_CALL == op->opcode))
+			return false;
+	}
+
+	name = store.source;
+	space = expression_space(store.space);
+	address = u32(m_compiled[0].value);
+	size = store.size;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  execute_compiled - execute a compiled
+//  expression
+//-------------------------------------------------
+
+u64 parsed_expression::execute_compiled()
+{
+	u64 stack[MAX_COMPILED_DEPTH];
+	u64 *sp = stack;
+	for (compiled_op const &op : m_compiled)
+	{
+		switch (op.opcode)
+		{
+			case CVL_NUMBER:            *sp++ = op.value;                   break;
+			case CVL_SYMBOL:            *sp++ = op.symbol->value();         break;
+			case CVL_ADDRESS:                                               break;
+			case CVL_PLACEHOLDER:       *sp++ = 0;                          break;
+
+			case TVL_COMPLEMENT:        sp[-1] = !sp[-1];                   break;
+			case TVL_NOT:               sp[-1] = ~sp[-1];                   break;
+			case TVL_UPLUS:                                                 break;
+			case TVL_UMINUS:            sp[-1] = -sp[-1];                   break;
+
+			case TVL_MULTIPLY:          --sp; sp[-1] = sp[-1] * sp[0];      break;
+			case TVL_ADD:               --sp; sp[-1] = sp[-1] + sp[0];      break;
+			case TVL_SUBTRACT:          --sp; sp[-1] = sp[-1] - sp[0];      break;
+			case TVL_LSHIFT:            --sp; sp[-1] = sp[-1] << sp[0];     break;
+			case TVL_RSHIFT:            --sp; sp[-1] = sp[-1] >> sp[0];     break;
+			case TVL_LESS:              --sp; sp[-1] = sp[-1] < sp[0];      break;
+			case TVL_LESSOREQUAL:       --sp; sp[-1] = sp[-1] <= sp[0];     break;
+			case TVL_GREATER:           --sp; sp[-1] = sp[-1] > sp[0];      break;
+			case TVL_GREATEROREQUAL:    --sp; sp[-1] = sp[-1] >= sp[0];     break;
+			case TVL_EQUAL:             --sp; sp[-1] = sp[-1] == sp[0];     break;
+			case TVL_NOTEQUAL:          --sp; sp[-1] = sp[-1] != sp[0];     break;
+			case TVL_BAND:              --sp; sp[-1] = sp[-1] & sp[0];      break;
+			case TVL_BXOR:              --sp; sp[-1] = sp[-1] ^ sp[0];      break;
+			case TVL_BOR:               --sp; sp[-1] = sp[-1] | sp[0];      break;
+			case TVL_LAND:              --sp; sp[-1] = sp[-1] && sp[0];     break;
+			case TVL_LOR:               --sp; sp[-1] = sp[-1] || sp[0];     break;
+			case TVL_COMMA:             --sp; sp[-1] = sp[0];               break;
+
+			case TVL_DIVIDE:
+				if (sp[-1] == 0)
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, op.offset);
+				--sp;
+				sp[-1] = sp[-1] / sp[0];
+				break;
+
+			case TVL_MODULO:
+				if (sp[-1] == 0)
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, op.offset);
+				--sp;
+				sp[-1] = sp[-1] % sp[0];
+				break;
+
+			case TVL_MEMORYAT:
+				sp[-1] = m_symtable.get().memory_value(op.source, expression_space(op.space), u32(sp[-1]), op.size, op.disable_se);
+				break;
+
+			case TVL_ASSIGN:
+				if (op.symbol)
+					op.symbol->set_value(sp[-1]);
+				else
+					m_symtable.get().set_memory_value(op.source, expression_space(op.space), u32(sp[-2]), op.size, sp[-1], op.disable_se);
+				--sp;
+				sp[-1] = sp[0];
+				break;
+
+			case CVL_CALL:
+				sp -= op.value;
+				*sp = downcast<function_symbol_entry *>(op.symbol)->execute(int(op.value), sp);
+				++sp;
+				break;
+		}
+	}
+	return stack[0];
+}
+
+
 //**************************************************************************
 //  PARSE TOKEN
 //**************************************************************************
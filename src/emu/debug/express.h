@@ -20,6 +20,7 @@
 #include <list>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 
 
@@ -200,6 +201,7 @@ public:
 	void set_memory_value(const char *name, expression_space space, u32 offset, int size, u64 value, bool disable_se);
 	u64 read_memory(address_space &space, offs_t address, int size, bool apply_translation);
 	void write_memory(address_space &space, offs_t address, u64 data, int size, bool apply_translation);
+	address_space *physical_space(const char *name, expression_space space, offs_t &address);
 
 private:
 	// memory helpers
@@ -247,7 +249,10 @@ public:
 
 	// execution
 	void parse(std::string_view string);
-	u64 execute() { return execute_tokens(); }
+	u64 execute() { return m_compiled.empty() ? execute_tokens() : execute_compiled(); }
+
+	// inspection of compiled expressions
+	bool memory_store_target(const char *&name, expression_space &space, u32 &address, int &size) const;
 
 private:
 	// a single token
@@ -309,6 +314,7 @@ private:
 		expression_space memory_space() const { assert(m_type == OPERATOR || m_type == MEMORY); return expression_space((m_flags & TIN_MEMORY_SPACE_MASK) >> TIN_MEMORY_SPACE_SHIFT); }
 		int memory_size() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_MEMORY_SIZE_MASK) >> TIN_MEMORY_SIZE_SHIFT; }
 		bool memory_side_effects() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_SIDE_EFFECT_MASK) >> TIN_SIDE_EFFECT_SHIFT; }
+		const char *memory_source() const { assert(m_type == OPERATOR || m_type == MEMORY); return m_string; }
 
 		// setters
 		parse_token &set_offset(int offset) { m_offset = offset; return *this; }
@@ -342,6 +348,19 @@ private:
 		symbol_entry *          m_symbol;           // symbol pointer
 	};
 
+	// a step of an expression compiled for faster execution
+	struct compiled_op
+	{
+		u8                      opcode;             // operator, or value to push
+		u8                      space;              // memory space for memory reads
+		u8                      size;               // size in bytes for memory reads
+		bool                    disable_se;         // disable side effects for memory reads
+		int                     offset;             // offset within the string for errors
+		u64                     value;              // number, or parameter count for functions
+		symbol_entry *          symbol;             // symbol or function
+		const char *            source;             // source name for memory reads
+	};
+
 	// internal helpers
 	void copy(const parsed_expression &src);
 	void print_tokens();
@@ -363,9 +382,12 @@ private:
 	void pop_token_rval(parse_token &token);
 	u64 execute_tokens();
 	void execute_function(parse_token &token);
+	bool compile();
+	u64 execute_compiled();
 
 	// constants
 	static const int MAX_FUNCTION_PARAMS = 16;
+	static const int MAX_COMPILED_DEPTH = 32;
 
 	// internal state
 	std::reference_wrapper<symbol_table> m_symtable;    // symbol table
@@ -374,6 +396,7 @@ private:
 	std::list<parse_token> m_tokenlist;                 // token list
 	std::list<std::string> m_stringlist;                // string list
 	std::deque<parse_token> m_token_stack;              // token stack (used during execution)
+	std::vector<compiled_op> m_compiled;                // compiled form, if the expression is simple enough
 };
 
 #endif // MAME_EMU_DEBUG_EXPRESS_H
@@ -0,0 +1,202 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    pcsample.cpp
+
+    Statistical profiling by sampling CPU program counters.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "pcsample.h"
+
+#include <algorithm>
+
+
+
+//**************************************************************************
+//  PC SAMPLER
+//**************************************************************************
+
+//-------------------------------------------------
+//  pc_sampler - constructor
+//-------------------------------------------------
+
+pc_sampler::pc_sampler()
+	: m_interval(0)
+	, m_running(false)
+{
+}
+
+
+//-------------------------------------------------
+//  start - discard previous samples and start
+//  sampling the given CPUs every so many cycles
+//-------------------------------------------------
+
+void pc_sampler::start(u64 cycles, std::vector<device_t *> const &cpus)
+{
+	assert(cycles != 0);
+
+	m_cpus.clear();
+	for (device_t *cpu : cpus)
+	{
+		device_state_interface *state;
+		device_execute_interface *exec;
+		if (!cpu->interface(state) || !cpu->interface(exec))
+			continue;
+
+		cpu_samples &entry = m_cpus.emplace_back();
+		entry.device = cpu;
+		entry.state = state;
+		entry.exec = exec;
+		entry.next = exec->total_cycles() + cycles;
+		entry.total = 0;
+	}
+
+	m_interval = cycles;
+	m_running = true;
+}
+
+
+//-------------------------------------------------
+//  update - sample a CPU that has just finished
+//  a timeslice if it's due
+//-------------------------------------------------
+
+void pc_sampler::update(device_t &cpu)
+{
+	cpu_samples *const entry = find(cpu);
+	if (!entry)
+		return;
+
+	u64 const cycles = entry->exec->total_cycles();
+	if (cycles < entry->next)
+	{
+		// start over if loading a state went back in time
+		if ((entry->next - cycles) > m_interval)
+			entry->next = cycles + m_interval;
+		return;
+	}
+
+	// count every interval boundary crossed since the last sample
+	u64 const samples = ((cycles - entry->next) / m_interval) + 1;
+	entry->counts[entry->state->pcbase()] += samples;
+	entry->total += samples;
+	entry->next += samples * m_interval;
+}
+
+
+//-------------------------------------------------
+//  total - return the number of samples taken
+//  for a CPU
+//-------------------------------------------------
+
+u64 pc_sampler::total(device_t &cpu) const
+{
+	cpu_samples const *const entry = find(cpu);
+	return entry ? entry->total : 0;
+}
+
+
+//-------------------------------------------------
+//  samples_at - return the number of samples
+//  taken at a particular PC
+//-------------------------------------------------
+
+u64 pc_sampler::samples_at(device_t &cpu, offs_t pc) const
+{
+	cpu_samples const *const entry = find(cpu);
+	if (!entry)
+		return 0;
+	auto const found = entry->counts.find(pc);
+	return (entry->counts.end() != found) ? found->second : 0;
+}
+
+
+//-------------------------------------------------
+//  top_instructions - return the most sampled
+//  PCs, most samples first
+//-------------------------------------------------
+
+std::vector<std::pair<offs_t, u64> > pc_sampler::top_instructions(device_t &cpu, std::size_t count) const
+{
+	std::vector<std::pair<offs_t, u64> > result;
+	cpu_samples const *const entry = find(cpu);
+	if (entry)
+	{
+		result.assign(entry->counts.begin(), entry->counts.end());
+		count = std::min(count, result.size());
+		std::partial_sort(
+				result.begin(),
+				result.begin() + count,
+				result.end(),
+				[] (auto const &a, auto const &b) { return (a.second > b.second) || ((a.second == b.second) && (a.first < b.first)); });
+		result.resize(count);
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  top_ranges - group sampled PCs into runs of
+//  nearby instructions and return the most
+//  sampled runs, most samples first
+//-------------------------------------------------
+
+std::vector<pc_sampler::range> pc_sampler::top_ranges(device_t &cpu, std::size_t count) const
+{
+	std::vector<range> result;
+	cpu_samples const *const entry = find(cpu);
+	if (!entry)
+		return result;
+
+	// without symbols, a function is approximated by sampled code with no large gaps
+	std::vector<std::pair<offs_t, u64> > sorted(entry->counts.begin(), entry->counts.end());
+	std::sort(sorted.begin(), sorted.end());
+	for (auto const &[pc, samples] : sorted)
+	{
+		if (result.empty() || ((pc - result.back().end) > RANGE_GAP))
+			result.emplace_back(range{ pc, pc, samples });
+		else
+		{
+			result.back().end = pc;
+			result.back().samples += samples;
+		}
+	}
+
+	count = std::min(count, result.size());
+	std::partial_sort(
+			result.begin(),
+			result.begin() + count,
+			result.end(),
+			[] (range const &a, range const &b) { return (a.samples > b.samples) || ((a.samples == b.samples) && (a.start < b.start)); });
+	result.resize(count);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  find - find the samples for a CPU
+//-------------------------------------------------
+
+pc_sampler::cpu_samples *pc_sampler::find(device_t &cpu)
+{
+	for (cpu_samples &entry : m_cpus)
+	{
+		if (entry.device == &cpu)
+			return &entry;
+	}
+	return nullptr;
+}
+
+pc_sampler::cpu_samples const *pc_sampler::find(device_t &cpu) const
+{
+	for (cpu_samples const &entry : m_cpus)
+	{
+		if (entry.device == &cpu)
+			return &entry;
+	}
+	return nullptr;
+}
@@ -0,0 +1,84 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    pcsample.h
+
+    Statistical profiling by sampling CPU program counters.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_DEBUG_PCSAMPLE_H
+#define MAME_EMU_DEBUG_PCSAMPLE_H
+
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> pc_sampler
+
+// Samples are taken as each CPU finishes a timeslice rather than by the
+// instruction hook, so profiling doesn't slow emulation down to debugger
+// speed.  A CPU is sampled once for every sampling interval boundary its
+// cycle count crossed during the timeslice.  Timeslices end wherever a
+// CPU's cycle budget runs out, so over many samples this approximates
+// sampling at exact cycle intervals; intervals shorter than a timeslice
+// just give fewer distinct samples.
+class pc_sampler
+{
+public:
+	// a run of sampled instructions, standing in for a function
+	struct range
+	{
+		offs_t  start;                                  // first sampled PC
+		offs_t  end;                                    // last sampled PC
+		u64     samples;                                // samples anywhere in the range
+	};
+
+	pc_sampler();
+
+	// control
+	void start(u64 cycles, std::vector<device_t *> const &cpus);
+	void stop() { m_running = false; }
+	bool running() const { return m_running; }
+	u64 interval() const { return m_interval; }
+
+	// called by the debugger at the end of each timeslice
+	void update(device_t &cpu);
+
+	// results
+	u64 total(device_t &cpu) const;
+	u64 samples_at(device_t &cpu, offs_t pc) const;
+	std::vector<std::pair<offs_t, u64> > top_instructions(device_t &cpu, std::size_t count) const;
+	std::vector<range> top_ranges(device_t &cpu, std::size_t count) const;
+
+private:
+	// sampled PCs no further apart than this are considered part of the same function
+	static constexpr offs_t RANGE_GAP = 16;
+
+	struct cpu_samples
+	{
+		device_t *                          device;     // CPU being sampled
+		device_state_interface *            state;      // its state interface, for the PC
+		device_execute_interface *          exec;       // its execute interface, for the cycle count
+		u64                                 next;       // cycle count at the next sample
+		u64                                 total;      // samples taken
+		std::unordered_map<offs_t, u64>     counts;     // samples at each PC
+	};
+
+	cpu_samples *find(device_t &cpu);
+	cpu_samples const *find(device_t &cpu) const;
+
+	std::vector<cpu_samples>    m_cpus;                 // CPUs being sampled
+	u64                         m_interval;             // cycles between samples
+	bool                        m_running;              // sampling in progress
+};
+
+#endif // MAME_EMU_DEBUG_PCSAMPLE_H
@@ -184,9 +184,12 @@ debug_watchpoint::debug_watchpoint(
 
 debug_watchpoint::~debug_watchpoint()
 {
+	const bool frozen = m_space.frozen();
 	m_notifier.reset();
 	m_phr.remove();
 	m_phw.remove();
+	if (frozen)
+		m_space.freeze();
 }
 
 void debug_watchpoint::setEnabled(bool value)
@@ -198,10 +201,13 @@ void debug_watchpoint::setEnabled(bool value)
 			install(read_or_write::READWRITE);
 		else
 		{
+			const bool frozen = m_space.frozen();
 			m_installing = true;
 			m_phr.remove();
 			m_phw.remove();
 			m_installing = false;
+			if (frozen)
+				m_space.freeze();
 		}
 	}
 }
@@ -210,6 +216,10 @@ void debug_watchpoint::install(read_or_write mode)
 {
 	if (m_installing)
 		return;
+
+	// installing the taps thaws the space; rebuild its direct tables
+	// afterwards so only the pages holding the watched range lose them
+	const bool frozen = m_space.frozen();
 	m_installing = true;
 	if (u32(mode) & u32(read_or_write::READ))
 		m_phr.remove();
@@ -307,6 +317,8 @@ void debug_watchpoint::install(read_or_write mode)
 		break;
 	}
 	m_installing = false;
+	if (frozen)
+		m_space.freeze();
 }
 
 void debug_watchpoint::triggered(read_or_write type, offs_t address, u64 data, u64 mem_mask)
@@ -865,6 +865,13 @@ template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 Result devcb_read<Result, DefaultMask>::operator()(offs_t offset, std::make_unsigned_t<Result> mem_mask)
 {
 	assert(m_creators.empty() && !m_functions.empty());
+
+	// each chain is already fused into one callable, so the usual cases need no loop
+	if (m_unset)
+		return m_default;
+	if (m_functions.size() == 1)
+		return m_functions.front()(offset, mem_mask);
+
 	typename std::vector<func_t>::const_iterator it(m_functions.begin());
 	std::make_unsigned_t<Result> result((*it)(offset, mem_mask));
 	while (m_functions.end() != ++it)
@@ -2249,6 +2256,16 @@ template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::operator()(offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask)
 {
 	assert(m_creators.empty() && !m_functions.empty());
+
+	// each chain is already fused into one callable, so the usual cases need no loop
+	if (m_unset)
+		return;
+	if (m_functions.size() == 1)
+	{
+		m_functions.front()(offset, data, mem_mask);
+		return;
+	}
+
 	typename std::vector<func_t>::const_iterator it(m_functions.begin());
 	(*it)(offset, data, mem_mask);
 	while (m_functions.end() != ++it)
@@ -91,7 +91,7 @@ device_t::device_t(const machine_config &mconfig, device_type type, const char *
 	, m_unscaled_clock(clock)
 	, m_clock(clock)
 	, m_clock_scale(1.0)
-	, m_attoseconds_per_clock((clock == 0) ? 0 : HZ_TO_ATTOSECONDS(clock))
+	, m_clock_converter(clock)
 
 	, m_machine_config(mconfig)
 	, m_input_defaults(nullptr)
@@ -369,7 +369,7 @@ void device_t::set_unscaled_clock(u32 clock, bool sync_on_new_clock_domain)
 
 	m_unscaled_clock = clock;
 	m_clock = m_unscaled_clock * m_clock_scale;
-	m_attoseconds_per_clock = (m_clock == 0) ? 0 : HZ_TO_ATTOSECONDS(m_clock);
+	m_clock_converter.set_frequency(m_clock);
 
 	// recalculate all derived clocks
 	for (device_t &child : subdevices())
@@ -394,7 +394,7 @@ void device_t::set_clock_scale(double clockscale)
 
 	m_clock_scale = clockscale;
 	m_clock = m_unscaled_clock * m_clock_scale;
-	m_attoseconds_per_clock = (m_clock == 0) ? 0 : HZ_TO_ATTOSECONDS(m_clock);
+	m_clock_converter.set_frequency(m_clock);
 
 	// recalculate all derived clocks
 	for (device_t &child : subdevices())
@@ -428,16 +428,7 @@ void device_t::calculate_derived_clock()
 
 attotime device_t::clocks_to_attotime(u64 numclocks) const noexcept
 {
-	if (m_clock == 0)
-		return attotime::never;
-	else if (numclocks < m_clock)
-		return attotime(0, numclocks * m_attoseconds_per_clock);
-	else
-	{
-		u32 remainder;
-		u32 quotient = divu_64x32_rem(numclocks, m_clock, remainder);
-		return attotime(quotient, u64(remainder) * u64(m_attoseconds_per_clock));
-	}
+	return m_clock_converter.to_attotime(numclocks);
 }
 
 
@@ -448,10 +439,7 @@ attotime device_t::clocks_to_attotime(u64 numclocks) const noexcept
 
 u64 device_t::attotime_to_clocks(const attotime &duration) const noexcept
 {
-	if (m_clock == 0)
-		return 0;
-	else
-		return mulu_32x32(duration.seconds(), m_clock) + u64(duration.attoseconds()) / u64(m_attoseconds_per_clock);
+	return m_clock_converter.to_ticks(duration);
 }
 
 
@@ -650,7 +638,7 @@ void device_t::post_load()
 	if (m_clock != scaled_clock)
 	{
 		m_clock = scaled_clock;
-		m_attoseconds_per_clock = (scaled_clock == 0) ? 0 : HZ_TO_ATTOSECONDS(scaled_clock);
+		m_clock_converter.set_frequency(scaled_clock);
 
 		// recalculate all derived clocks
 		for (device_t &child : subdevices())
@@ -854,6 +842,11 @@ device_t *device_t::subdevice_slow(std::string_view tag) const
 	assert(fulltag[0] == ':');
 	assert(fulltag.find("::") == std::string::npos);
 
+	// a complete configuration has every device indexed by its full tag
+	machine_config const &config = mconfig();
+	if (config.tag_index_ready())
+		return config.indexed_device(fulltag);
+
 	// walk the device list to the final path
 	device_t *curdevice = &mconfig().root_device();
 	std::string_view part(std::string_view(fulltag).substr(1));
@@ -10,6 +10,8 @@
 
 #include "emu.h"
 #include "debugger.h"
+#include "emuopts.h"
+#include "idledet.h"
 #include "screen.h"
 
 
@@ -68,6 +70,13 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 	, m_divshift(0)
 	, m_cycles_per_second(0)
 	, m_attoseconds_per_cycle(0)
+	, m_cycle_converter()
+	, m_stat_timeslices(0)
+	, m_stat_cycles_requested(0)
+	, m_stat_cycles_executed(0)
+	, m_stat_cycles_overshoot(0)
+	, m_stat_aborts(0)
+	, m_stat_host_ticks(0)
 	, m_spin_end_timer(nullptr)
 {
 	memset(&m_localtime, 0, sizeof(m_localtime));
@@ -99,6 +108,9 @@ void device_execute_interface::abort_timeslice() noexcept
 	if (!executing())
 		return;
 
+	if (m_scheduler->m_stats_enabled)
+		m_stat_aborts++;
+
 	// swallow the remaining cycles
 	if (m_icountptr != nullptr)
 	{
@@ -382,7 +394,10 @@ void device_execute_interface::interface_pre_start()
 	// fill in the initial states
 	int const index = device_enumerator(device().machine().root_device()).indexof(*this);
 	m_suspend = SUSPEND_REASON_RESET;
-	m_profiler = profile_type(index + PROFILER_DEVICE_FIRST);
+	if ((PROFILER_DEVICE_MAX - PROFILER_DEVICE_FIRST) > index)
+		m_profiler = profile_type(index + PROFILER_DEVICE_FIRST);
+	else
+		m_profiler = g_profiler.register_scope(device().tag());
 	m_inttrigger = index + TRIGGER_INT;
 
 	// allocate a timed-interrupt timer if we need it
@@ -426,6 +441,13 @@ void device_execute_interface::interface_post_start()
 	// fill in the input states and IRQ callback information
 	for (int line = 0; line < std::size(m_input); line++)
 		m_input[line].start(*this, line);
+
+	// idle loops are only skipped when nobody's watching; reporting them skips nothing
+	device_state_interface *state;
+	device_memory_interface *memory;
+	bool const report = device().machine().options().idle_report();
+	if ((report || (device().machine().options().idle_detect() && !debugger_enabled())) && device().interface(state) && device().interface(memory))
+		m_idle_detector = std::make_unique<idle_loop_detector>(*this, *state, *memory, report);
 }
 
 
@@ -447,6 +469,17 @@ void device_execute_interface::interface_pre_reset()
 }
 
 
+//-------------------------------------------------
+//  idle_branch - pass a backward branch on to the
+//  idle loop detector
+//-------------------------------------------------
+
+void device_execute_interface::idle_branch(offs_t target)
+{
+	m_idle_detector->branch(target);
+}
+
+
 //-------------------------------------------------
 //  interface_post_reset - work to be done after a
 //  device is reset
@@ -499,6 +532,7 @@ void device_execute_interface::interface_clock_changed(bool sync_on_new_clock_do
 	// recompute cps and spc
 	m_cycles_per_second = clocks_to_cycles(device().clock());
 	m_attoseconds_per_cycle = HZ_TO_ATTOSECONDS(m_cycles_per_second);
+	m_cycle_converter.set_frequency(m_cycles_per_second);
 
 	// resynchronize the localtime to the clock domain when asked to
 	if (sync_on_new_clock_domain)
@@ -186,6 +186,17 @@ public:
 	attotime local_time() const noexcept;
 	u64 total_cycles() const noexcept;
 
+	// scheduler statistics, gathered with -schedstats
+	u64 stat_timeslices() const noexcept { return m_stat_timeslices; }
+	u64 stat_cycles_requested() const noexcept { return m_stat_cycles_requested; }
+	u64 stat_cycles_executed() const noexcept { return m_stat_cycles_executed; }
+	u64 stat_cycles_overshoot() const noexcept { return m_stat_cycles_overshoot; }
+	u64 stat_aborts() const noexcept { return m_stat_aborts; }
+	osd_ticks_t stat_host_ticks() const noexcept { return m_stat_host_ticks; }
+
+	// idle loop detector, if the core supports it and it's enabled
+	idle_loop_detector const *idle_detector() const noexcept { return m_idle_detector.get(); }
+
 	// required operation overrides
 	void run() { execute_run(); }
 
@@ -242,6 +253,9 @@ protected:
 			device().debug()->privilege_hook();
 	}
 
+	// idle loop detection, for cores that report the targets of backward branches they take
+	void idle_branch_hook(offs_t target) { if (m_idle_detector) idle_branch(target); }
+
 private:
 	// internal information about the state of inputs
 	class device_input
@@ -324,6 +338,17 @@ private:
 	u8                      m_divshift;                 // right shift amount to fit the divisor into 32 bits
 	u32                     m_cycles_per_second;        // cycles per second, adjusted for multipliers
 	attoseconds_t           m_attoseconds_per_cycle;    // attoseconds per adjusted clock cycle
+	clock_converter         m_cycle_converter;          // conversions at cycles per second
+
+	// scheduler statistics (only gathered with -schedstats)
+	u64                     m_stat_timeslices;          // timeslices this device was advanced in
+	u64                     m_stat_cycles_requested;    // cycles the scheduler asked for
+	u64                     m_stat_cycles_executed;     // cycles actually accounted
+	u64                     m_stat_cycles_overshoot;    // cycles run past the end of a timeslice
+	u64                     m_stat_aborts;              // abort_timeslice() calls while executing
+	osd_ticks_t             m_stat_host_ticks;          // host time spent executing
+
+	std::unique_ptr<idle_loop_detector> m_idle_detector; // idle loop detection, with -idledetect or -idlereport
 
 	emu_timer *             m_spin_end_timer;           // timer for triggering the end of spin_until_time
 	emu_timer *             m_pulse_end_timers[MAX_INPUT_LINES]; // timer for ending input-line pulses
@@ -332,6 +357,7 @@ private:
 	TIMER_CALLBACK_MEMBER(timed_trigger_callback) { trigger(param); }
 
 	void on_vblank(screen_device &screen, bool vblank_state);
+	void idle_branch(offs_t target);
 
 	TIMER_CALLBACK_MEMBER(trigger_periodic_interrupt);
 	TIMER_CALLBACK_MEMBER(irq_pulse_clear) { set_input_line(int(param), CLEAR_LINE); }
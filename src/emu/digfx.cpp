@@ -95,6 +95,17 @@ void device_gfx_interface::interface_post_start()
 {
 	if (!m_decoded)
 		decode_gfx(m_gfxdecodeinfo);
+
+	// optionally decode everything up front instead of on first use while drawing
+	if (device().machine().options().predecode_gfx())
+	{
+		osd_work_queue *const queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		for (auto &gfx : m_gfx)
+			if (gfx)
+				gfx->decode_all(queue);
+		if (queue)
+			osd_work_queue_free(queue);
+	}
 }
 
 
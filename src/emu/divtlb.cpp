@@ -37,7 +37,11 @@ device_vtlb_interface::device_vtlb_interface(const machine_config &mconfig, devi
 		m_dynindex(0),
 		m_pageshift(0),
 		m_addrwidth(0),
-		m_table_base(nullptr)
+		m_table_base(nullptr),
+		m_stash_sequence(0),
+		m_host_enabled(false),
+		m_host_space(nullptr),
+		m_host_base(nullptr)
 {
 }
 
@@ -98,6 +102,13 @@ void device_vtlb_interface::interface_pre_start()
 	// pointer to first element for quick access
 	m_table_base = &m_table[0];
 
+	// allocate the host pointer table if the space is byte-addressed
+	if (m_host_enabled && spaceconfig->addr_shift() == 0)
+	{
+		m_host.resize(m_table.size(), nullptr);
+		m_host_base = &m_host[0];
+	}
+
 	// allocate the fixed page count array
 	if (m_fixed > 0)
 	{
@@ -119,6 +130,18 @@ void device_vtlb_interface::interface_post_start()
 	device().save_item(NAME(m_refcnt));
 	if (m_fixed > 0)
 		device().save_item(NAME(m_fixedpages));
+
+	// entries set aside for other contexts belong to the timeline that was left behind
+	device().machine().save().register_postload(save_prepost_delegate(FUNC(device_vtlb_interface::stash_clear), this));
+
+	// host pointers go stale whenever the memory map changes, and aren't saved
+	if (m_host_base)
+	{
+		m_host_space = &device().memory().space(m_space);
+		m_host_subscription = m_host_space->add_change_notifier([this] (read_or_write mode) { host_refresh(); });
+		device().machine().save().register_postload(save_prepost_delegate(FUNC(device_vtlb_interface::host_refresh), this));
+		host_refresh();
+	}
 }
 
 
@@ -166,22 +189,8 @@ bool device_vtlb_interface::vtlb_fill(offs_t address, offs_t taddress, int inten
 	// if this is the first successful translation for this address, allocate a new entry
 	if ((entry & FLAGS_MASK) == 0)
 	{
-		int liveindex = m_dynindex;
-
-		m_dynindex = (m_dynindex + 1) % m_dynamic;
-
-		// if an entry already exists at this index, free it
-		if (m_live[liveindex] != 0)
-		{
-			if (m_refcnt[m_live[liveindex] - 1] <= 1)
-				m_table[m_live[liveindex] - 1] = 0;
-			else
-				m_refcnt[m_live[liveindex] - 1]--;
-		}
-
-
-		// claim this new entry
-		m_live[liveindex] = tableindex + 1;
+		// claim the next dynamic entry
+		dynamic_claim(tableindex);
 
 		// form a new blank entry
 		entry = (taddress >> m_pageshift) << m_pageshift;
@@ -204,12 +213,43 @@ bool device_vtlb_interface::vtlb_fill(offs_t address, offs_t taddress, int inten
 	}
 
 	// add the intention to the list of valid intentions and store
+	bool const newentry = !(m_table[tableindex] & FLAG_VALID);
 	entry |= 1 << intention;
 	m_table[tableindex] = entry;
+	if (newentry)
+		host_update(tableindex, 1);
 	return true;
 }
 
 
+//-------------------------------------------------
+//  dynamic_claim - take the next dynamic entry
+//  for a table index, releasing whatever it held
+//-------------------------------------------------
+
+void device_vtlb_interface::dynamic_claim(offs_t tableindex)
+{
+	int liveindex = m_dynindex;
+
+	m_dynindex = (m_dynindex + 1) % m_dynamic;
+
+	// if an entry already exists at this index, free it
+	if (m_live[liveindex] != 0)
+	{
+		if (m_refcnt[m_live[liveindex] - 1] <= 1)
+		{
+			m_table[m_live[liveindex] - 1] = 0;
+			host_clear(m_live[liveindex] - 1, 1);
+		}
+		else
+			m_refcnt[m_live[liveindex] - 1]--;
+	}
+
+	// claim this new entry
+	m_live[liveindex] = tableindex + 1;
+}
+
+
 //-------------------------------------------------
 //  vtlb_load - load a fixed VTLB entry
 //-------------------------------------------------
@@ -237,6 +277,7 @@ void device_vtlb_interface::vtlb_load(int entrynum, int numpages, offs_t address
 			for (pagenum = 0; pagenum < pagecount; pagenum++) {
 				m_table[oldtableindex + pagenum] = 0;
 			}
+			host_clear(oldtableindex, pagecount);
 		}
 	}
 
@@ -249,6 +290,7 @@ void device_vtlb_interface::vtlb_load(int entrynum, int numpages, offs_t address
 	m_fixedpages[entrynum] = numpages;
 	for (pagenum = 0; pagenum < numpages; pagenum++)
 		m_table[tableindex + pagenum] = value + (pagenum << m_pageshift);
+	host_update(tableindex, numpages);
 }
 
 //-------------------------------------------------
@@ -276,7 +318,10 @@ void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry v
 	{
 		// if an entry already exists at this index, free it
 		if (m_live[liveindex] != 0)
+		{
 			m_table[m_live[liveindex] - 1] = 0;
+			host_clear(m_live[liveindex] - 1, 1);
+		}
 
 		// claim this new entry
 		m_live[liveindex] = index + 1;
@@ -289,6 +334,7 @@ void device_vtlb_interface::vtlb_dynload(u32 index, offs_t address, vtlb_entry v
 	osd_printf_debug("success (%08X), new entry\n", address);
 #endif
 	m_table[index] = entry;
+	host_update(index, 1);
 }
 
 //**************************************************************************
@@ -312,8 +358,12 @@ void device_vtlb_interface::vtlb_flush_dynamic()
 		{
 			offs_t tableindex = m_live[liveindex] - 1;
 			m_table[tableindex] = 0;
+			host_clear(tableindex, 1);
 			m_live[liveindex] = 0;
 		}
+
+	// anything set aside for other contexts goes too
+	m_stashed.clear();
 }
 
 
@@ -332,6 +382,173 @@ void device_vtlb_interface::vtlb_flush_address(offs_t address)
 
 	// free the entry in the table; for speed, we leave the entry in the live array
 	m_table[tableindex] = 0;
+	host_clear(tableindex, 1);
+
+	// and forget it in any other context
+	for (stashed_region &stash : m_stashed)
+	{
+		if ((tableindex - stash.first) < stash.pages)
+		{
+			auto const found = std::find_if(
+					stash.entries.begin(),
+					stash.entries.end(),
+					[tableindex] (std::pair<offs_t, vtlb_entry> const &stashed) { return stashed.first == tableindex; });
+			if (found != stash.entries.end())
+				stash.entries.erase(found);
+		}
+	}
+}
+
+
+
+//**************************************************************************
+//  CONTEXTS
+//**************************************************************************
+
+//-------------------------------------------------
+//  vtlb_switch_region - switch a region of the
+//  address space to a different context, keeping
+//  the dynamic entries for the one it leaves in
+//  case it comes back
+//
+//  Tags are up to the core, but a tag must stand
+//  for the same translations of the region for as
+//  long as it's in use: anything that changes them
+//  has to flush the affected addresses or the
+//  whole dynamic TLB.
+//-------------------------------------------------
+
+void device_vtlb_interface::vtlb_switch_region(offs_t start, offs_t size, u32 oldtag, u32 newtag)
+{
+	offs_t const first = start >> m_pageshift;
+	offs_t const pages = size >> m_pageshift;
+
+	if (oldtag == newtag || m_dynamic == 0)
+		return;
+
+	auto const find =
+			[this, first, pages] (u32 tag)
+			{
+				return std::find_if(
+						m_stashed.begin(),
+						m_stashed.end(),
+						[first, pages, tag] (stashed_region const &stash) { return (stash.first == first) && (stash.pages == pages) && (stash.tag == tag); });
+			};
+
+	// set aside the old context's entries, replacing the oldest set if need be
+	auto stash = find(oldtag);
+	if (stash == m_stashed.end())
+	{
+		if (m_stashed.size() < MAX_STASHED)
+			stash = m_stashed.emplace(m_stashed.end());
+		else
+			stash = std::min_element(
+					m_stashed.begin(),
+					m_stashed.end(),
+					[] (stashed_region const &a, stashed_region const &b) { return a.sequence < b.sequence; });
+		stash->first = first;
+		stash->pages = pages;
+		stash->tag = oldtag;
+	}
+	stash->sequence = m_stash_sequence++;
+	stash->entries.clear();
+	for (int liveindex = 0; liveindex < m_dynamic; liveindex++)
+	{
+		offs_t const tableindex = m_live[liveindex] - 1;
+		if (m_live[liveindex] != 0 && (tableindex - first) < pages)
+		{
+			vtlb_entry const entry = m_table[tableindex];
+			if ((entry & (FLAG_VALID | FLAG_FIXED)) == FLAG_VALID)
+				stash->entries.emplace_back(tableindex, entry);
+			m_table[tableindex] = 0;
+			host_clear(tableindex, 1);
+			m_live[liveindex] = 0;
+		}
+	}
+
+	// bring back the new context's entries if they're still around
+	auto const restore = find(newtag);
+	if (restore != m_stashed.end())
+	{
+		std::size_t const count = std::min<std::size_t>(restore->entries.size(), m_dynamic);
+		for (std::size_t index = 0; index < count; index++)
+		{
+			offs_t const tableindex = restore->entries[index].first;
+			if (!(m_table[tableindex] & FLAG_VALID))
+			{
+				dynamic_claim(tableindex);
+				m_table[tableindex] = restore->entries[index].second;
+				host_update(tableindex, 1);
+			}
+		}
+		m_stashed.erase(restore);
+	}
+}
+
+
+
+//**************************************************************************
+//  HOST POINTERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  host_update - look up host pointers for pages
+//  whose entries have just been loaded
+//-------------------------------------------------
+
+void device_vtlb_interface::host_update(offs_t tableindex, int numpages)
+{
+	if (!m_host_base || !m_host_space)
+		return;
+
+	offs_t const pagesize = offs_t(1) << m_pageshift;
+	offs_t const lastunit = pagesize - (m_host_space->data_width() / 8);
+	for (int pagenum = 0; pagenum < numpages; pagenum++)
+	{
+		vtlb_entry const entry = m_table[tableindex + pagenum];
+		u8 *host = nullptr;
+		if (entry & FLAG_VALID)
+		{
+			// the whole page must be the same writable memory, end to end
+			offs_t const first = entry & ~(pagesize - 1);
+			u8 *const base = reinterpret_cast<u8 *>(m_host_space->get_read_ptr(first));
+			if (base &&
+					(base == m_host_space->get_write_ptr(first)) &&
+					((base + lastunit) == m_host_space->get_read_ptr(first + lastunit)) &&
+					((base + lastunit) == m_host_space->get_write_ptr(first + lastunit)))
+				host = base;
+		}
+		m_host[tableindex + pagenum] = host;
+	}
+}
+
+
+//-------------------------------------------------
+//  host_clear - forget host pointers for pages
+//  whose entries have been released
+//-------------------------------------------------
+
+void device_vtlb_interface::host_clear(offs_t tableindex, int numpages)
+{
+	if (m_host_base)
+		std::fill_n(&m_host[tableindex], numpages, nullptr);
+}
+
+
+//-------------------------------------------------
+//  host_refresh - look up host pointers for all
+//  live entries again after the memory map has
+//  changed or state has been loaded
+//-------------------------------------------------
+
+void device_vtlb_interface::host_refresh()
+{
+	for (int liveindex = 0; liveindex < m_dynamic; liveindex++)
+		if (m_live[liveindex] != 0)
+			host_update(m_live[liveindex] - 1, 1);
+	for (int entrynum = 0; entrynum < m_fixed; entrynum++)
+		if (m_live[m_dynamic + entrynum] != 0)
+			host_update(m_live[m_dynamic + entrynum] - 1, m_fixedpages[entrynum]);
 }
 
 
@@ -49,6 +49,7 @@ public:
 	// configuration helpers
 	void set_vtlb_dynamic_entries(int entries) { m_dynamic = entries; }
 	void set_vtlb_fixed_entries(int entries) { m_fixed = entries; }
+	void set_vtlb_host_pointers(bool enable) { m_host_enabled = enable; }
 
 	// filling
 	bool vtlb_fill(offs_t address, offs_t taddress, int intention);
@@ -59,8 +60,12 @@ public:
 	void vtlb_flush_dynamic();
 	void vtlb_flush_address(offs_t address);
 
+	// contexts
+	void vtlb_switch_region(offs_t start, offs_t size, u32 oldtag, u32 newtag);
+
 	// accessors
 	const vtlb_entry *vtlb_table() const;
+	u8 *const *vtlb_host_table() const { return m_host_base; }
 
 protected:
 	// interface-level overrides
@@ -70,6 +75,28 @@ protected:
 	virtual void interface_pre_reset() override;
 
 private:
+	// most regions whose translations are kept while they're switched out
+	static constexpr std::size_t MAX_STASHED = 16;
+
+	// dynamic entries set aside when their region switched to another context
+	struct stashed_region
+	{
+		offs_t              first;              // table index of the start of the region
+		offs_t              pages;              // size of the region in pages
+		u32                 tag;                // context the entries belong to
+		u64                 sequence;           // when they were set aside, for replacement
+		std::vector<std::pair<offs_t, vtlb_entry> > entries; // table indices and entries
+	};
+
+	// internal helpers
+	void dynamic_claim(offs_t tableindex);
+	void stash_clear() { m_stashed.clear(); }
+
+	// host pointer maintenance
+	void host_update(offs_t tableindex, int numpages);
+	void host_clear(offs_t tableindex, int numpages);
+	void host_refresh();
+
 	// private state
 	int    m_space;            // address space
 	int                 m_dynamic;          // number of dynamic entries
@@ -82,6 +109,19 @@ private:
 	std::vector<vtlb_entry> m_table;        // table of entries by address
 	std::vector<offs_t> m_refcnt;           // table of entry reference counts by address
 	vtlb_entry          *m_table_base;      // pointer to m_table[0]
+	std::vector<stashed_region> m_stashed;  // regions' entries for other contexts
+	u64                 m_stash_sequence;   // sequence number for the next stash
+
+	// Optional host pointers, parallel to m_table: for a valid page backed
+	// by RAM in the translated space, a pointer to the page's memory, laid
+	// out as get_read_ptr() returns it, so units of the space's data width
+	// are in host order.  Null for anything else, including ROM and pages
+	// with taps installed.  The core still checks permissions in the entry.
+	bool                m_host_enabled;     // host pointers requested
+	address_space       *m_host_space;      // space physical addresses refer to
+	std::vector<u8 *>   m_host;             // table of host pointers by address
+	u8                  **m_host_base;      // pointer to m_host[0], or null if disabled
+	util::notifier_subscription m_host_subscription; // memory map change notification
 };
 
 
@@ -339,6 +339,55 @@ void gfx_element::decode(u32 code)
 }
 
 
+//-------------------------------------------------
+//  decode_all - decode every dirty element now
+//  rather than on first use, spreading the work
+//  over the queue if one is given
+//-------------------------------------------------
+
+void gfx_element::decode_all(osd_work_queue *queue)
+{
+	// nothing to decode until the source has been set
+	if (!m_srcdata)
+		return;
+
+	struct decode_chunk
+	{
+		gfx_element *gfx;
+		u32 start, end;
+	};
+
+	// each element decodes into its own slice of the data, so chunks can run concurrently
+	constexpr u32 CHUNK_ELEMENTS = 256;
+	u32 const count = std::min<u32>(elements(), m_dirty.size());
+	std::vector<decode_chunk> chunks;
+	for (u32 start = 0; start < count; start += CHUNK_ELEMENTS)
+		chunks.push_back(decode_chunk{ this, start, std::min(start + CHUNK_ELEMENTS, count) });
+	if (chunks.empty())
+		return;
+
+	auto const decode_chunk_callback =
+		[] (void *param, int threadid) -> void *
+		{
+			decode_chunk const &chunk = *reinterpret_cast<decode_chunk const *>(param);
+			for (u32 code = chunk.start; code < chunk.end; code++)
+				if (chunk.gfx->m_dirty[code])
+					chunk.gfx->decode(code);
+			return nullptr;
+		};
+
+	if (queue && osd_work_item_queue_multiple(queue, decode_chunk_callback, chunks.size(), &chunks[0], sizeof(chunks[0]), WORK_ITEM_FLAG_AUTO_RELEASE))
+	{
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+	}
+	else
+	{
+		for (decode_chunk &chunk : chunks)
+			decode_chunk_callback(&chunk, 0);
+	}
+}
+
+
 
 /***************************************************************************
     DRAWGFX IMPLEMENTATIONS
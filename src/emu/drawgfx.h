@@ -186,6 +186,7 @@ public:
 	// operations
 	void mark_dirty(u32 code) { if (code < elements()) { m_dirty[code] = 1; m_dirtyseq++; } }
 	void mark_all_dirty() { memset(&m_dirty[0], 1, elements()); }
+	void decode_all(osd_work_queue *queue);
 
 	const u8 *get_data(u32 code)
 	{
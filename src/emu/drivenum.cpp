@@ -16,8 +16,69 @@
 #include "unicode.h"
 
 #include <algorithm>
+#include <numeric>
+#include <vector>
 
 #include <cctype>
+#include <cstring>
+
+
+namespace {
+
+//**************************************************************************
+//  CLONE INDEX
+//**************************************************************************
+
+// parent/clone relationships resolved once by index, so that looking up
+// the parent of a system or enumerating its clones doesn't need a
+// string search over the whole driver list every time
+class clone_index
+{
+public:
+	static clone_index const &instance()
+	{
+		// built on first use; static initialisation is thread-safe
+		static clone_index const s_index;
+		return s_index;
+	}
+
+	int parent(std::size_t index) const { return m_parent[index]; }
+	std::pair<int const *, int const *> clones(std::size_t index) const
+	{
+		int const *const base = m_clones.data();
+		return std::make_pair(base + m_offset[index], base + m_offset[index + 1]);
+	}
+
+private:
+	clone_index()
+		: m_parent(driver_list::total())
+		, m_offset(driver_list::total() + 1, 0)
+	{
+		// resolve parents and count the clones of each
+		for (std::size_t index = 0; index < m_parent.size(); index++)
+		{
+			m_parent[index] = driver_list::find(driver_list::driver(index).parent);
+			if (m_parent[index] >= 0)
+				m_offset[m_parent[index] + 1]++;
+		}
+		std::partial_sum(m_offset.begin(), m_offset.end(), m_offset.begin());
+
+		// bucket the clones - they end up sorted by index within each parent
+		std::vector<std::size_t> next(m_offset.begin(), m_offset.end() - 1);
+		m_clones.resize(m_offset.back());
+		for (std::size_t index = 0; index < m_parent.size(); index++)
+		{
+			if (m_parent[index] >= 0)
+				m_clones[next[m_parent[index]]++] = index;
+		}
+	}
+
+	std::vector<int>            m_parent;
+	std::vector<std::size_t>    m_offset;
+	std::vector<int>            m_clones;
+};
+
+} // anonymous namespace
 
 
 
@@ -53,6 +114,30 @@ int driver_list::find(const char *name)
 }
 
 
+//-------------------------------------------------
+//  clone - get the index of the parent of a
+//  system, or -1 if it isn't a clone
+//-------------------------------------------------
+
+int driver_list::clone(std::size_t index)
+{
+	assert(index < total());
+	return clone_index::instance().parent(index);
+}
+
+
+//-------------------------------------------------
+//  clones - get the range of indices of the
+//  clones of a system, in driver list order
+//-------------------------------------------------
+
+std::pair<int const *, int const *> driver_list::clones(std::size_t index)
+{
+	assert(index < total());
+	return clone_index::instance().clones(index);
+}
+
+
 //-------------------------------------------------
 //  matches - true if we match, taking into
 //  account wildcards in the wildstring
@@ -69,6 +154,36 @@ bool driver_list::matches(const char *wildstring, const char *string)
 }
 
 
+//-------------------------------------------------
+//  prefix_range - get the range of indices of
+//  drivers that can possibly match the given
+//  wildstring, based on its literal prefix
+//-------------------------------------------------
+
+std::pair<std::size_t, std::size_t> driver_list::prefix_range(const char *wildstring)
+{
+	// without a literal prefix anything can match
+	std::size_t const length = wildstring ? std::strcspn(wildstring, "*?") : 0;
+	if (!length)
+		return std::make_pair(std::size_t(0), s_driver_count);
+
+	// names sharing the prefix are contiguous in the sorted list
+	std::string_view const prefix(wildstring, length);
+	game_driver const *const *const begin = s_drivers_sorted;
+	game_driver const *const *const end = begin + s_driver_count;
+	game_driver const *const *const first = std::lower_bound(
+			begin,
+			end,
+			prefix,
+			[] (game_driver const *driver, std::string_view name) { return core_stricmp(driver->name, name) < 0; });
+	game_driver const *const *const last = std::partition_point(
+			first,
+			end,
+			[&prefix] (game_driver const *driver) { return !core_strnicmp(driver->name, prefix.data(), prefix.length()); });
+	return std::make_pair(std::size_t(first - begin), std::size_t(last - begin));
+}
+
+
 
 //**************************************************************************
 //  DRIVER ENUMERATOR
@@ -141,8 +256,9 @@ std::size_t driver_enumerator::filter(const char *filterstring)
 	// reset the count
 	exclude_all();
 
-	// match name against each driver in the list
-	for (std::size_t index = 0; index < s_driver_count; index++)
+	// match name against each driver that shares the literal prefix
+	auto const [first, last] = prefix_range(filterstring);
+	for (std::size_t index = first; index < last; index++)
 		if (matches(filterstring, s_drivers_sorted[index]->name))
 			include(index);
 
@@ -160,10 +276,10 @@ std::size_t driver_enumerator::filter(const game_driver &driver)
 	// reset the count
 	exclude_all();
 
-	// match name against each driver in the list
-	for (std::size_t index = 0; index < s_driver_count; index++)
-		if (s_drivers_sorted[index] == &driver)
-			include(index);
+	// look up the driver by name
+	int const index = find(driver);
+	if ((index >= 0) && (s_drivers_sorted[index] == &driver))
+		include(index);
 
 	return m_filtered_count;
 }
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cassert>
 #include <memory>
+#include <utility>
 
 
 //**************************************************************************
@@ -48,9 +49,10 @@ public:
 
 	// any item by index
 	static const game_driver &driver(std::size_t index) { assert(index < total()); return *s_drivers_sorted[index]; }
-	static int clone(std::size_t index) { return find(driver(index).parent); }
-	static int non_bios_clone(std::size_t index) { int const result = find(driver(index).parent); return ((result >= 0) && !(driver(result).flags & MACHINE_IS_BIOS_ROOT)) ? result : -1; }
+	static int clone(std::size_t index);
+	static int non_bios_clone(std::size_t index) { int const result = clone(index); return ((result >= 0) && !(driver(result).flags & MACHINE_IS_BIOS_ROOT)) ? result : -1; }
 	static int compatible_with(std::size_t index) { return find(driver(index).compatible_with); }
+	static std::pair<int const *, int const *> clones(std::size_t index);
 
 	// any item by driver
 	static int clone(const game_driver &driver) { int const index = find(driver); assert(index >= 0); return clone(index); }
@@ -65,6 +67,9 @@ public:
 	static bool matches(const char *wildstring, const char *string);
 
 protected:
+	// internal helpers
+	static std::pair<std::size_t, std::size_t> prefix_range(const char *wildstring);
+
 	static std::size_t const            s_driver_count;
 	static game_driver const * const    s_drivers_sorted[];
 };
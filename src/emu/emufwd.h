@@ -67,6 +67,9 @@ class debugger_commands;
 // declared in debug/debugcon.h
 class debugger_console;
 
+// declared in debug/bintrace.h
+class binary_trace_writer;
+
 // declared in debug/debugcpu.h
 class debugger_cpu;
 class device_debug;
@@ -79,6 +82,9 @@ class debug_view_manager;
 class parsed_expression;
 class symbol_table;
 
+// declared in debug/pcsample.h
+class pc_sampler;
+
 // declared in debug/points.h
 class debug_breakpoint;
 class debug_watchpoint;
@@ -144,6 +150,8 @@ class emu_options;
 
 // declared in fileio.h
 class emu_file;
+class file_hash_cache;
+class path_listing_cache;
 
 // declared in http.h
 class http_manager;
@@ -159,6 +167,9 @@ class input_class;
 class input_device;
 class input_device_item;
 
+// declared in idledet.h
+class idle_loop_detector;
+
 // declared in image.h
 class image_manager;
 
@@ -183,15 +194,24 @@ class machine_config;
 // declared in main.h
 class machine_manager;
 
+// declared in memheat.h
+class memory_heatmap;
+
 // declared in natkeyboard.h
 class natural_keyboard;
 
+// declared in netplay.h
+class netplay_manager;
+
 // declared in network.h
 class network_manager;
 
 // declared in output.h
 class output_manager;
 
+// declared in remotectl.h
+class remote_control;
+
 // declared in render.h
 class render_container;
 class render_manager;
@@ -238,6 +258,9 @@ class sound_stream;
 // declared in speaker.h
 class speaker_device;
 
+// declared in statehash.h
+class state_hasher;
+
 // declared in tilemap.h
 class tilemap_device;
 class tilemap_manager;
@@ -14,6 +14,9 @@
 #include "emuopts.h"
 #include "debug/debugcpu.h"
 
+#include "osdfile.h"
+#include "modules/lib/osdlib.h"
+
 #include "emumem_mud.h"
 #include "emumem_hea.h"
 #include "emumem_hem.h"
@@ -43,6 +46,81 @@ template <typename Format, typename... Params> static void VPRINTF(Format &&, Pa
 
 #define VALIDATE_REFCOUNTS 0
 
+
+//**************************************************************************
+//  HANDLER ENTRY POOL
+//**************************************************************************
+
+namespace {
+
+// Every install, and every view entry that gets populated, creates and
+// destroys handler entries by the dozen.  Freed entries are kept on a
+// free list per 16-byte size class, up to 512 bytes, for the next
+// allocation of that size.  The lists are per thread, so no locking is
+// needed; blocks freed on another thread simply join that thread's lists.
+class handler_entry_pool
+{
+public:
+	static constexpr std::size_t GRANULE = 16;
+	static constexpr std::size_t CLASSES = 33;
+
+	~handler_entry_pool()
+	{
+		for (void *&head : m_free)
+		{
+			while (head)
+			{
+				void *const next = *reinterpret_cast<void **>(head);
+				::operator delete(head);
+				head = next;
+			}
+		}
+	}
+
+	void *allocate(std::size_t size)
+	{
+		std::size_t const cls = (size + GRANULE - 1) / GRANULE;
+		if (cls >= CLASSES)
+			return ::operator new(size);
+
+		void *const block = m_free[cls];
+		if (!block)
+			return ::operator new(cls * GRANULE);
+		m_free[cls] = *reinterpret_cast<void **>(block);
+		return block;
+	}
+
+	void release(void *ptr, std::size_t size)
+	{
+		std::size_t const cls = (size + GRANULE - 1) / GRANULE;
+		if (cls >= CLASSES)
+		{
+			::operator delete(ptr);
+			return;
+		}
+		*reinterpret_cast<void **>(ptr) = m_free[cls];
+		m_free[cls] = ptr;
+	}
+
+private:
+	void *m_free[CLASSES] = { };
+};
+
+thread_local handler_entry_pool s_handler_entry_pool;
+
+} // anonymous namespace
+
+void *handler_entry::operator new(std::size_t size)
+{
+	return s_handler_entry_pool.allocate(size);
+}
+
+void handler_entry::operator delete(void *ptr, std::size_t size)
+{
+	s_handler_entry_pool.release(ptr, size);
+}
+
+
 offs_t handler_entry::dispatch_entry(offs_t address) const
 {
 	fatalerror("dispatch_entry called on non-dispatching class\n");
@@ -147,6 +225,11 @@ template<int Width, int AddrShift> void *handler_entry_read<Width, AddrShift>::g
 	return nullptr;
 }
 
+template<int Width, int AddrShift> const emu::detail::handler_entry_size_t<Width> *handler_entry_read<Width, AddrShift>::get_direct_range(offs_t start, offs_t end) const
+{
+	return nullptr;
+}
+
 template<int Width, int AddrShift> handler_entry_read<Width, AddrShift> *handler_entry_read<Width, AddrShift>::dup()
 {
 	ref();
@@ -209,6 +292,11 @@ template<int Width, int AddrShift> void *handler_entry_write<Width, AddrShift>::
 	return nullptr;
 }
 
+template<int Width, int AddrShift> emu::detail::handler_entry_size_t<Width> *handler_entry_write<Width, AddrShift>::get_direct_range(offs_t start, offs_t end) const
+{
+	return nullptr;
+}
+
 template<int Width, int AddrShift> handler_entry_write<Width, AddrShift> *handler_entry_write<Width, AddrShift>::dup()
 {
 	ref();
@@ -310,6 +398,8 @@ void memory_manager::initialize()
 void *memory_manager::allocate_memory(device_t &dev, int spacenum, std::string name, u8 width, size_t bytes)
 {
 	void *const ptr = m_datablocks.emplace_back(malloc(bytes)).get();
+	if (machine().options().huge_pages() && osd::advise_huge_pages(ptr, bytes))
+		osd_printf_verbose("Using huge pages for %s:%s (%u bytes)\n", dev.tag(), name, bytes);
 	memset(ptr, 0, bytes);
 	machine().save().save_memory(&dev, "memory", dev.tag(), spacenum, name.c_str(), ptr, width/8, u32(bytes) / (width/8));
 	return ptr;
@@ -331,6 +421,16 @@ memory_region *memory_manager::region_alloc(std::string name, u32 length, u8 wid
 	return m_regionlist.emplace(name, std::make_unique<memory_region>(machine(), name, length, width, endian)).first->second.get();
 }
 
+memory_region *memory_manager::region_alloc(std::string name, std::unique_ptr<osd_file_mapping> &&mapping, u8 width, endianness_t endian)
+{
+	// make sure we don't have a region of the same name; also find the end of the list
+	if (m_regionlist.find(name) != m_regionlist.end())
+		fatalerror("region_alloc called with duplicate region name \"%s\"\n", name);
+
+	// wrap the mapping in a region
+	return m_regionlist.emplace(name, std::make_unique<memory_region>(machine(), name, std::move(mapping), width, endian)).first->second.get();
+}
+
 
 //-------------------------------------------------
 //  region_find - find a region by name
@@ -1070,6 +1170,23 @@ memory_region::memory_region(running_machine &machine, std::string name, u32 len
 	: m_machine(machine),
 		m_name(std::move(name)),
 		m_buffer(length),
+		m_mapping(),
+		m_base(length ? &m_buffer[0] : nullptr),
+		m_length(length),
+		m_endianness(endian),
+		m_bitwidth(width * 8),
+		m_bytewidth(width)
+{
+	assert(width == 1 || width == 2 || width == 4 || width == 8);
+}
+
+memory_region::memory_region(running_machine &machine, std::string name, std::unique_ptr<osd_file_mapping> &&mapping, u8 width, endianness_t endian)
+	: m_machine(machine),
+		m_name(std::move(name)),
+		m_buffer(),
+		m_mapping(std::move(mapping)),
+		m_base(reinterpret_cast<u8 *>(m_mapping->data())),
+		m_length(u32(m_mapping->size())),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
@@ -1077,6 +1194,10 @@ memory_region::memory_region(running_machine &machine, std::string name, u32 len
 	assert(width == 1 || width == 2 || width == 4 || width == 8);
 }
 
+memory_region::~memory_region()
+{
+}
+
 std::string memory_share::compare(u8 width, size_t bytes, endianness_t endianness) const
 {
 	if (width != m_bitwidth)
@@ -1089,3 +1210,92 @@ std::string memory_share::compare(u8 width, size_t bytes, endianness_t endiannes
 								   m_endianness == ENDIANNESS_LITTLE ? "little" : "big");
 	return "";
 }
+
+
+//**************************************************************************
+//  MEMORY READ VIEWS
+//**************************************************************************
+
+//-------------------------------------------------
+//  memory_read_view - constructor
+//-------------------------------------------------
+
+memory_read_view::memory_read_view()
+	: m_space(nullptr),
+	  m_addrstart(0),
+	  m_addrend(0),
+	  m_base(nullptr),
+	  m_generation(0)
+{
+}
+
+memory_read_view::~memory_read_view()
+{
+	m_tracker.remove();
+}
+
+
+//-------------------------------------------------
+//  set - attach the view to a range of a space,
+//  optionally tracking writes into it
+//-------------------------------------------------
+
+void memory_read_view::set(address_space &space, offs_t addrstart, offs_t addrend, bool track_writes)
+{
+	m_tracker.remove();
+	m_space = &space;
+	m_addrstart = addrstart & ~offs_t(space.alignment() - 1);
+	m_addrend = addrend;
+	m_subscription = space.add_change_notifier([this] (read_or_write mode) { if (u32(mode) & u32(read_or_write::READ)) refresh(); });
+	refresh();
+
+	if (track_writes)
+	{
+		switch (space.data_width())
+		{
+		case  8: install_tracker<u8>(); break;
+		case 16: install_tracker<u16>(); break;
+		case 32: install_tracker<u32>(); break;
+		case 64: install_tracker<u64>(); break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  install_tracker - bump the generation on
+//  writes into the range
+//-------------------------------------------------
+
+template <typename T> void memory_read_view::install_tracker()
+{
+	// taps run before the write reaches memory, so when the range is RAM the
+	// tap stores the data itself before bumping the generation; otherwise a
+	// reader could pick up the new generation together with the old contents
+	const bool ram = base() && (m_space->get_write_ptr(m_addrstart) == base());
+	m_tracker = m_space->install_write_tap(
+			m_addrstart, m_addrend, "read view",
+			[this, ram] (offs_t offset, T &data, T mem_mask)
+			{
+				T *const base = const_cast<T *>(ptr<T>());
+				if (ram && base)
+				{
+					T &dest = base[m_space->address_to_byte(offset - m_addrstart) / sizeof(T)];
+					dest = (dest & ~mem_mask) | (data & mem_mask);
+				}
+				touch();
+			},
+			&m_tracker);
+}
+
+
+//-------------------------------------------------
+//  refresh - look up the backing memory again
+//  after a map change
+//-------------------------------------------------
+
+void memory_read_view::refresh()
+{
+	m_base.store(m_space->get_read_range(m_addrstart, m_addrend), std::memory_order_release);
+	touch();
+}
@@ -19,6 +19,7 @@
 
 #include "notifier.h"
 
+#include <atomic>
 #include <optional>
 #include <set>
 #include <type_traits>
@@ -56,6 +57,7 @@ enum class read_or_write
 //  FORWARD DECLARATIONS
 //**************************************************************************
 
+class osd_file_mapping;
 class handler_entry;
 template<int Width, int AddrShift> class handler_entry_read_passthrough;
 template<int Width, int AddrShift> class handler_entry_write_passthrough;
@@ -617,6 +619,10 @@ public:
 	handler_entry(address_space *space, u32 flags) { m_space = space; m_refcount = 1; m_flags = flags; }
 	virtual ~handler_entry() {}
 
+	// entries are recycled through per-size free lists
+	static void *operator new(std::size_t size);
+	static void operator delete(void *ptr, std::size_t size);
+
 	inline void ref(int count = 1) const { m_refcount += count; }
 	inline void unref(int count = 1) const { m_refcount -= count; if(!m_refcount) delete this; }
 	inline u32 flags() const { return m_flags; }
@@ -688,6 +694,7 @@ public:
 	virtual std::pair<uX, u16> read_flags(offs_t offset, uX mem_mask) const = 0;
 	virtual u16 lookup_flags(offs_t offset, uX mem_mask) const = 0;
 	virtual void *get_ptr(offs_t offset) const;
+	virtual const uX *get_direct_range(offs_t start, offs_t end) const;
 	virtual void lookup(offs_t address, offs_t &start, offs_t &end, handler_entry_read<Width, AddrShift> *&handler) const;
 
 	inline void populate(offs_t start, offs_t end, offs_t mirror, handler_entry_read<Width, AddrShift> *handler) {
@@ -763,6 +770,7 @@ public:
 	virtual u16 write_flags(offs_t offset, uX data, uX mem_mask) const = 0;
 	virtual u16 lookup_flags(offs_t offset, uX mem_mask) const = 0;
 	virtual void *get_ptr(offs_t offset) const;
+	virtual uX *get_direct_range(offs_t start, offs_t end) const;
 	virtual void lookup(offs_t address, offs_t &start, offs_t &end, handler_entry_write<Width, AddrShift> *&handler) const;
 
 	inline void populate(offs_t start, offs_t end, offs_t mirror, handler_entry_write<Width, AddrShift> *handler) {
@@ -1681,6 +1689,49 @@ template<int Level, int Width, int AddrShift> u16 dispatch_lookup_write_flags(of
 
 
 
+// ======================> Flat dispatching
+
+// When a space is frozen, each top-level dispatch slot that is plain memory
+// has a direct pointer to its first native word; everything else falls back
+// to the handlers.  flat is nullptr while the space is thawed.
+
+template<int Level, int Width, int AddrShift> emu::detail::handler_entry_size_t<Width> dispatch_read_flat(offs_t offset, emu::detail::handler_entry_size_t<Width> mem_mask, const emu::detail::handler_entry_size_t<Width> *const *flat, const handler_entry_read<Width, AddrShift> *const *dispatch)
+{
+	static constexpr u32 LowBits  = emu::detail::handler_entry_dispatch_level_to_lowbits(Level, Width, AddrShift);
+	if constexpr (Level < 2 && Width + AddrShift >= 0)
+	{
+		if (flat)
+		{
+			const emu::detail::handler_entry_size_t<Width> *const block = flat[offset >> LowBits];
+			if (block)
+				return block[(offset & make_bitmask<offs_t>(LowBits)) >> (Width + AddrShift)];
+		}
+	}
+	return dispatch[offset >> LowBits]->read(offset, mem_mask);
+}
+
+
+template<int Level, int Width, int AddrShift> void dispatch_write_flat(offs_t offset, emu::detail::handler_entry_size_t<Width> data, emu::detail::handler_entry_size_t<Width> mem_mask, emu::detail::handler_entry_size_t<Width> *const *flat, const handler_entry_write<Width, AddrShift> *const *dispatch)
+{
+	static constexpr u32 LowBits  = emu::detail::handler_entry_dispatch_level_to_lowbits(Level, Width, AddrShift);
+	if constexpr (Level < 2 && Width + AddrShift >= 0)
+	{
+		if (flat)
+		{
+			emu::detail::handler_entry_size_t<Width> *const block = flat[offset >> LowBits];
+			if (block)
+			{
+				emu::detail::handler_entry_size_t<Width> &dest = block[(offset & make_bitmask<offs_t>(LowBits)) >> (Width + AddrShift)];
+				dest = (dest & ~mem_mask) | (data & mem_mask);
+				return;
+			}
+		}
+	}
+	dispatch[offset >> LowBits]->write(offset, data, mem_mask);
+}
+
+
+
 template<int Level, int Width, int AddrShift> emu::detail::handler_entry_size_t<Width> dispatch_read_interruptible(offs_t mask, offs_t offset, emu::detail::handler_entry_size_t<Width> mem_mask, const handler_entry_read<Width, AddrShift> *const *dispatch)
 {
 	static constexpr u32 LowBits  = emu::detail::handler_entry_dispatch_level_to_lowbits(Level, Width, AddrShift);
@@ -1715,7 +1766,9 @@ public:
 		: m_space(nullptr),
 		  m_addrmask(0),
 		  m_dispatch_read(nullptr),
-		  m_dispatch_write(nullptr)
+		  m_dispatch_write(nullptr),
+		  m_flat_read(nullptr),
+		  m_flat_write(nullptr)
 	{
 	}
 
@@ -1831,12 +1884,16 @@ private:
 	const handler_entry_read<Width, AddrShift> *const *m_dispatch_read;
 	const handler_entry_write<Width, AddrShift> *const *m_dispatch_write;
 
+	// these point at the space's flat tables, so they follow freeze/thaw
+	const NativeType *const *const *m_flat_read;
+	NativeType *const *const *m_flat_write;
+
 	NativeType read_native(offs_t address, NativeType mask = ~NativeType(0)) {
-		return dispatch_read<Level, Width, AddrShift>(offs_t(-1), address & m_addrmask, mask, m_dispatch_read);
+		return dispatch_read_flat<Level, Width, AddrShift>(address & m_addrmask, mask, *m_flat_read, m_dispatch_read);
 	}
 
 	void write_native(offs_t address, NativeType data, NativeType mask = ~NativeType(0)) {
-		dispatch_write<Level, Width, AddrShift>(offs_t(-1), address & m_addrmask, data, mask, m_dispatch_write);
+		dispatch_write_flat<Level, Width, AddrShift>(address & m_addrmask, data, mask, *m_flat_write, m_dispatch_write);
 	}
 
 	std::pair<NativeType, u16> read_native_flags(offs_t address, NativeType mask = ~NativeType(0)) {
@@ -1855,7 +1912,7 @@ private:
 		return dispatch_lookup_write_flags<Level, Width, AddrShift>(offs_t(-1), address & m_addrmask, mask, m_dispatch_write);
 	}
 
-	void set(address_space *space, std::pair<const void *, const void *> rw);
+	void set(address_space *space, std::pair<const void *, const void *> rw, std::pair<const void *, const void *> flat);
 };
 
 
@@ -2047,6 +2104,48 @@ template<int HighBits, int Width, int AddrShift, endianness_t Endian> struct mem
 
 
 
+// ======================> memory_read_view
+
+// A read-only window onto a range of plain memory in an address space that
+// other threads (e.g. renderer work items) may sample without locks.  It is
+// configured and refreshed on the emulation thread; base() is nullptr when
+// the range is not backed by a single block of memory.  The generation is
+// bumped whenever the mapping changes and, when write tracking is enabled,
+// after every write into the range, so readers can detect stale derived
+// data by comparing generations before and after use.
+class memory_read_view
+{
+public:
+	memory_read_view();
+	~memory_read_view();
+
+	void set(address_space &space, offs_t addrstart, offs_t addrend, bool track_writes = false);
+
+	// emulation thread: note that the contents changed behind the space's back
+	void touch() { m_generation.fetch_add(1, std::memory_order_release); }
+
+	// safe from any thread
+	u32 generation() const { return m_generation.load(std::memory_order_acquire); }
+	const void *base() const { return m_base.load(std::memory_order_acquire); }
+	template <typename T> const T *ptr() const { return reinterpret_cast<const T *>(base()); }
+	offs_t addrstart() const { return m_addrstart; }
+	offs_t addrend() const { return m_addrend; }
+
+private:
+	template <typename T> void install_tracker();
+	void refresh();
+
+	address_space *             m_space;
+	offs_t                      m_addrstart;
+	offs_t                      m_addrend;
+	std::atomic<const void *>   m_base;
+	std::atomic<u32>            m_generation;
+	util::notifier_subscription m_subscription;
+	memory_passthrough_handler  m_tracker;
+};
+
+
+
 // ======================> address_space_config
 
 // describes an address space and provides basic functions to map addresses to bytes
@@ -2374,13 +2473,21 @@ public:
 			fatalerror("Requesting spefific() with endianness %s while the config says %s\n",
 					   util::endian_to_string_view(Endian), util::endian_to_string_view(m_config.endianness()));
 
-		v.set(this, get_specific_info());
+		v.set(this, get_specific_info(), get_flat_info());
 	}
 
 	util::notifier_subscription add_change_notifier(delegate<void (read_or_write)> &&n);
 	template <typename T> util::notifier_subscription add_change_notifier(T &&n) { return add_change_notifier(delegate<void (read_or_write)>(std::forward<T>(n))); }
 
+	// static maps can be frozen to give plain memory a direct path that
+	// skips the handlers; any map change or view switch thaws the space
+	bool frozen() const { return m_frozen; }
+	virtual void freeze() = 0;
+	virtual void thaw() = 0;
+
 	void invalidate_caches(read_or_write mode) {
+		if(m_frozen)
+			thaw();
 		if(u32(mode) & ~m_in_notification) {
 			u32 old = m_in_notification;
 			m_in_notification |= u32(mode);
@@ -2409,6 +2516,7 @@ public:
 	virtual void accessors(data_accessors &accessors) const = 0;
 	virtual void *get_read_ptr(offs_t address) const = 0;
 	virtual void *get_write_ptr(offs_t address) const = 0;
+	virtual const void *get_read_range(offs_t addrstart, offs_t addrend) const = 0;
 
 	// read accessors
 	virtual u8 read_byte(offs_t address) = 0;
@@ -2440,6 +2548,14 @@ public:
 	virtual void write_qword_unaligned(offs_t address, u64 data) = 0;
 	virtual void write_qword_unaligned(offs_t address, u64 data, u64 mask) = 0;
 
+	// block accessors: count native-width units starting at a native-aligned
+	// address, in host order; runs backed by plain memory are copied directly
+	// and everything else goes through the handlers one unit at a time
+	virtual void read_block(offs_t address, void *buffer, u32 count) = 0;
+	virtual void write_block(offs_t address, const void *buffer, u32 count) = 0;
+	virtual void fill_block(offs_t address, u64 data, u32 count) = 0;
+	void copy_block(offs_t dstaddress, address_space &src, offs_t srcaddress, u32 count);
+
 	// setup
 	void prepare_map();
 	void prepare_device_map(address_map &map);
@@ -2457,6 +2573,7 @@ protected:
 	// internal helpers
 	virtual std::pair<void *, void *> get_cache_info() = 0;
 	virtual std::pair<const void *, const void *> get_specific_info() = 0;
+	virtual std::pair<const void *, const void *> get_flat_info() = 0;
 
 	void prepare_map_generic(address_map &map, bool allow_alloc);
 
@@ -2478,6 +2595,7 @@ protected:
 
 	util::notifier<read_or_write> m_notifiers;  // notifier list for address map change
 	u32                     m_in_notification;  // notification(s) currently being done
+	bool                    m_frozen;           // flat direct-memory tables are live
 
 	// passthrough handler used for wait states
 	std::shared_ptr<emu::detail::memory_passthrough_handler_impl> m_default_mpl;
@@ -2566,12 +2684,14 @@ class memory_region
 public:
 	// construction/destruction
 	memory_region(running_machine &machine, std::string name, u32 length, u8 width, endianness_t endian);
+	memory_region(running_machine &machine, std::string name, std::unique_ptr<osd_file_mapping> &&mapping, u8 width, endianness_t endian);
+	~memory_region();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
-	u8 *base() { return (m_buffer.size() > 0) ? &m_buffer[0] : nullptr; }
-	u8 *end() { return base() + m_buffer.size(); }
-	u32 bytes() const { return m_buffer.size(); }
+	u8 *base() { return m_base; }
+	u8 *end() { return m_base + m_length; }
+	u32 bytes() const { return m_length; }
 	const std::string &name() const { return m_name; }
 
 	// flag expansion
@@ -2580,7 +2700,7 @@ public:
 	u8 bytewidth() const { return m_bytewidth; }
 
 	// data access
-	u8 &as_u8(offs_t offset = 0) { return m_buffer[offset]; }
+	u8 &as_u8(offs_t offset = 0) { return m_base[offset]; }
 	u16 &as_u16(offs_t offset = 0) { return reinterpret_cast<u16 *>(base())[offset]; }
 	u32 &as_u32(offs_t offset = 0) { return reinterpret_cast<u32 *>(base())[offset]; }
 	u64 &as_u64(offs_t offset = 0) { return reinterpret_cast<u64 *>(base())[offset]; }
@@ -2590,6 +2710,9 @@ private:
 	running_machine &       m_machine;
 	std::string             m_name;
 	std::vector<u8>         m_buffer;
+	std::unique_ptr<osd_file_mapping> m_mapping;    // copy-on-write file mapping used instead of m_buffer
+	u8 *                    m_base;
+	u32                     m_length;
 	endianness_t            m_endianness;
 	u8                      m_bitwidth;
 	u8                      m_bytewidth;
@@ -2711,6 +2834,7 @@ public:
 
 	// regions
 	memory_region *region_alloc(std::string name, u32 length, u8 width, endianness_t endian);
+	memory_region *region_alloc(std::string name, std::unique_ptr<osd_file_mapping> &&mapping, u8 width, endianness_t endian);
 	memory_region *region_find(std::string name);
 	void region_free(std::string name);
 
@@ -2793,12 +2917,14 @@ inline void emu::detail::memory_passthrough_handler_impl::remove()
 
 template<int Level, int Width, int AddrShift, endianness_t Endian>
 void emu::detail::memory_access_specific<Level, Width, AddrShift, Endian>::
-set(address_space *space, std::pair<const void *, const void *> rw)
+set(address_space *space, std::pair<const void *, const void *> rw, std::pair<const void *, const void *> flat)
 {
 	m_space = space;
 	m_addrmask = space->addrmask();
 	m_dispatch_read  = (const handler_entry_read <Width, AddrShift> *const *)(rw.first);
 	m_dispatch_write = (const handler_entry_write<Width, AddrShift> *const *)(rw.second);
+	m_flat_read  = (const NativeType *const *const *)(flat.first);
+	m_flat_write = (NativeType *const *const *)(flat.second);
 }
 
 
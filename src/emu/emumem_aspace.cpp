@@ -10,6 +10,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include <algorithm>
 #include <list>
 #include <map>
 #include "emuopts.h"
@@ -78,6 +79,12 @@ public:
 	const handler_entry_read<Width, AddrShift> *const *m_dispatch_read;
 	const handler_entry_write<Width, AddrShift> *const *m_dispatch_write;
 
+	// flat direct-memory tables, live only while frozen
+	std::vector<const uX *> m_flat_read_table;
+	std::vector<uX *> m_flat_write_table;
+	const uX *const *m_flat_read;
+	uX *const *m_flat_write;
+
 	std::string get_handler_string(read_or_write readorwrite, offs_t byteaddress) const override;
 	void dump_maps(std::vector<memory_entry> &read_map, std::vector<memory_entry> &write_map) const override;
 
@@ -212,7 +219,9 @@ public:
 
 	// construction/destruction
 	address_space_specific(memory_manager &manager, device_memory_interface &memory, int spacenum, int address_width)
-		: address_space(manager, memory, spacenum)
+		: address_space(manager, memory, spacenum),
+		  m_flat_read(nullptr),
+		  m_flat_write(nullptr)
 	{
 		m_unmap_r = new handler_entry_read_unmapped <Width, AddrShift>(this, 0);
 		m_unmap_w = new handler_entry_write_unmapped<Width, AddrShift>(this, 0);
@@ -280,6 +289,50 @@ public:
 		return rw;
 	}
 
+	std::pair<const void *, const void *> get_flat_info() override {
+		std::pair<const void *, const void *> rw;
+		rw.first  = &m_flat_read;
+		rw.second = &m_flat_write;
+		return rw;
+	}
+
+	virtual void freeze() override {
+		static constexpr u32 LowBits = emu::detail::handler_entry_dispatch_level_to_lowbits(Level, Width, AddrShift);
+
+		// deeper dispatch levels have too many slots for a flat table to pay off
+		if constexpr (Level < 2 && Width + AddrShift >= 0)
+		{
+			const offs_t slots = (m_addrmask >> LowBits) + 1;
+			const offs_t slotmask = make_bitmask<offs_t>(LowBits);
+			bool any_read = false, any_write = false;
+			m_flat_read_table.resize(slots);
+			m_flat_write_table.resize(slots);
+			for (offs_t slot = 0; slot != slots; slot++)
+			{
+				const offs_t start = slot << LowBits;
+				m_flat_read_table[slot] = m_dispatch_read[slot]->get_direct_range(start, start | slotmask);
+				m_flat_write_table[slot] = m_dispatch_write[slot]->get_direct_range(start, start | slotmask);
+				any_read = any_read || m_flat_read_table[slot];
+				any_write = any_write || m_flat_write_table[slot];
+			}
+
+			// don't bother with the extra indirection for spaces with no plain memory
+			if (!any_read)
+				std::vector<const uX *>().swap(m_flat_read_table);
+			if (!any_write)
+				std::vector<uX *>().swap(m_flat_write_table);
+			m_flat_read = any_read ? m_flat_read_table.data() : nullptr;
+			m_flat_write = any_write ? m_flat_write_table.data() : nullptr;
+			m_frozen = any_read || any_write;
+		}
+	}
+
+	virtual void thaw() override {
+		m_flat_read = nullptr;
+		m_flat_write = nullptr;
+		m_frozen = false;
+	}
+
 	void delayed_ref(handler_entry *e) {
 		e->ref();
 		m_delayed_unrefs.insert(e);
@@ -341,28 +394,37 @@ public:
 		return m_root_write->get_ptr(address);
 	}
 
+	// return a pointer to the memory behind a range, or nullptr if it isn't one block of memory
+	virtual const void *get_read_range(offs_t addrstart, offs_t addrend) const override
+	{
+		offs_t start, end;
+		handler_entry_read<Width, AddrShift> *handler;
+		m_root_read->lookup(addrstart, start, end, handler);
+		return (addrend <= end) ? handler->get_direct_range(addrstart, addrend) : nullptr;
+	}
+
 	// native read
 	NativeType read_native(offs_t offset, NativeType mask)
 	{
-		return dispatch_read<Level, Width, AddrShift>(offs_t(-1), offset & m_addrmask, mask, m_dispatch_read);
+		return dispatch_read_flat<Level, Width, AddrShift>(offset & m_addrmask, mask, m_flat_read, m_dispatch_read);
 	}
 
 	// mask-less native read
 	NativeType read_native(offs_t offset)
 	{
-		return dispatch_read<Level, Width, AddrShift>(offs_t(-1), offset & m_addrmask, uX(0xffffffffffffffffU), m_dispatch_read);
+		return dispatch_read_flat<Level, Width, AddrShift>(offset & m_addrmask, uX(0xffffffffffffffffU), m_flat_read, m_dispatch_read);
 	}
 
 	// native write
 	void write_native(offs_t offset, NativeType data, NativeType mask)
 	{
-		dispatch_write<Level, Width, AddrShift>(offs_t(-1), offset & m_addrmask, data, mask, m_dispatch_write);
+		dispatch_write_flat<Level, Width, AddrShift>(offset & m_addrmask, data, mask, m_flat_write, m_dispatch_write);
 	}
 
 	// mask-less native write
 	void write_native(offs_t offset, NativeType data)
 	{
-		dispatch_write<Level, Width, AddrShift>(offs_t(-1), offset & m_addrmask, data, uX(0xffffffffffffffffU), m_dispatch_write);
+		dispatch_write_flat<Level, Width, AddrShift>(offset & m_addrmask, data, uX(0xffffffffffffffffU), m_flat_write, m_dispatch_write);
 	}
 
 	auto rop()   { return [this](offs_t offset, NativeType mask) -> NativeType { return read_native(offset, mask); }; }
@@ -397,6 +459,76 @@ public:
 	void write_qword_unaligned(offs_t address, u64 data) override { memory_write_generic<Width, AddrShift, Endian, 3, false>(wop(), address, data, 0xffffffffffffffffU); }
 	void write_qword_unaligned(offs_t address, u64 data, u64 mask) override { memory_write_generic<Width, AddrShift, Endian, 3, false>(wop(), address, data, mask); }
 
+	// native units from address up to and including end, capped at count
+	static u32 block_run(offs_t address, offs_t end, u32 count) { return u32(std::min<u64>((u64(end - address) + 1) / NATIVE_STEP, count)); }
+
+	void read_block(offs_t address, void *buffer, u32 count) override
+	{
+		uX *dest = static_cast<uX *>(buffer);
+		address &= ~NATIVE_MASK;
+		while (count)
+		{
+			address &= m_addrmask;
+			offs_t start, end;
+			handler_entry_read<Width, AddrShift> *handler;
+			m_root_read->lookup(address, start, end, handler);
+			const u32 run = block_run(address, end, count);
+			const uX *const src = handler->get_direct_range(address, address + (run - 1) * NATIVE_STEP + NATIVE_MASK);
+			if (src)
+				std::copy_n(src, run, dest);
+			else
+				for (u32 i = 0; i != run; i++)
+					dest[i] = read_native(address + i * NATIVE_STEP);
+			dest += run;
+			count -= run;
+			address += run * NATIVE_STEP;
+		}
+	}
+
+	void write_block(offs_t address, const void *buffer, u32 count) override
+	{
+		const uX *src = static_cast<const uX *>(buffer);
+		address &= ~NATIVE_MASK;
+		while (count)
+		{
+			address &= m_addrmask;
+			offs_t start, end;
+			handler_entry_write<Width, AddrShift> *handler;
+			m_root_write->lookup(address, start, end, handler);
+			const u32 run = block_run(address, end, count);
+			uX *const dest = handler->get_direct_range(address, address + (run - 1) * NATIVE_STEP + NATIVE_MASK);
+			if (dest)
+				std::copy_n(src, run, dest);
+			else
+				for (u32 i = 0; i != run; i++)
+					write_native(address + i * NATIVE_STEP, src[i]);
+			src += run;
+			count -= run;
+			address += run * NATIVE_STEP;
+		}
+	}
+
+	void fill_block(offs_t address, u64 data, u32 count) override
+	{
+		address &= ~NATIVE_MASK;
+		while (count)
+		{
+			address &= m_addrmask;
+			offs_t start, end;
+			handler_entry_write<Width, AddrShift> *handler;
+			m_root_write->lookup(address, start, end, handler);
+			const u32 run = block_run(address, end, count);
+			uX *const dest = handler->get_direct_range(address, address + (run - 1) * NATIVE_STEP + NATIVE_MASK);
+			if (dest)
+				std::fill_n(dest, run, uX(data));
+			else
+				for (u32 i = 0; i != run; i++)
+					write_native(address + i * NATIVE_STEP, uX(data));
+			count -= run;
+			address += run * NATIVE_STEP;
+		}
+	}
+
 
 	// static access to these functions
 	static u8 read_byte_static(this_type &space, offs_t address) { return Width == 0 ? space.read_native(address & ~NATIVE_MASK) : memory_read_generic<Width, AddrShift, Endian, 0, true>([&space](offs_t offset, NativeType mask) -> NativeType { return space.read_native(offset, mask); }, address, 0xff); }
@@ -614,6 +746,7 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_log_unmap(true),
 		m_name(memory.space_config(spacenum)->name()),
 		m_in_notification(0),
+		m_frozen(false),
 		m_default_mpl(make_mph(nullptr))
 {
 }
@@ -800,6 +933,31 @@ void address_space::populate_from_map(address_map *map)
 		validate_reference_counts();
 }
 
+
+//-------------------------------------------------
+//  copy_block - copy count native units from
+//  another space of the same data width
+//-------------------------------------------------
+
+void address_space::copy_block(offs_t dstaddress, address_space &src, offs_t srcaddress, u32 count)
+{
+	if (src.data_width() != data_width())
+		fatalerror("copy_block: %s space is %d bits wide but %s space is %d bits wide\n", src.name(), src.data_width(), name(), data_width());
+
+	// bounce through a small buffer so both sides keep their direct paths
+	u64 buffer[256];
+	const u32 chunk = sizeof(buffer) * 8 / data_width();
+	while (count)
+	{
+		const u32 run = std::min(count, chunk);
+		src.read_block(srcaddress, buffer, run);
+		write_block(dstaddress, buffer, run);
+		srcaddress += run * src.alignment();
+		dstaddress += run * alignment();
+		count -= run;
+	}
+}
+
 //-------------------------------------------------
 //  get_handler_string - return a string
 //  describing the handler at a particular offset
@@ -30,6 +30,17 @@ template<int Width, int AddrShift> void *handler_entry_read_memory<Width, AddrSh
 	return m_base + (((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
 }
 
+template<int Width, int AddrShift> const emu::detail::handler_entry_size_t<Width> *handler_entry_read_memory<Width, AddrShift>::get_direct_range(offs_t start, offs_t end) const
+{
+	// the whole range must map linearly onto the backing store, i.e. every
+	// address bit that changes across it must survive the mirror mask
+	const offs_t changed = (start - this->m_address_base) ^ (end - this->m_address_base);
+	const offs_t span = changed ? make_bitmask<offs_t>(32 - count_leading_zeros_32(changed)) : 0;
+	if ((this->m_address_mask & span) != span)
+		return nullptr;
+	return m_base + (((start - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
+}
+
 template<int Width, int AddrShift> std::string handler_entry_read_memory<Width, AddrShift>::name() const
 {
 	return util::string_format("memory@%x", this->m_address_base);
@@ -81,6 +92,15 @@ template<int Width, int AddrShift> void *handler_entry_write_memory<Width, AddrS
 	return m_base + (((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
 }
 
+template<int Width, int AddrShift> emu::detail::handler_entry_size_t<Width> *handler_entry_write_memory<Width, AddrShift>::get_direct_range(offs_t start, offs_t end) const
+{
+	const offs_t changed = (start - this->m_address_base) ^ (end - this->m_address_base);
+	const offs_t span = changed ? make_bitmask<offs_t>(32 - count_leading_zeros_32(changed)) : 0;
+	if ((this->m_address_mask & span) != span)
+		return nullptr;
+	return m_base + (((start - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
+}
+
 template<int Width, int AddrShift> std::string handler_entry_write_memory<Width, AddrShift>::name() const
 {
 	return util::string_format("memory@%x", this->m_address_base);
@@ -510,6 +510,10 @@ void memory_view::register_state()
 
 void memory_view::disable()
 {
+	// nothing changes, so there's nothing to invalidate
+	if(m_cur_id == -1)
+		return;
+
 	m_cur_slot = -1;
 	m_cur_id = -1;
 	m_handler_read->select_a(-1);
@@ -521,6 +525,10 @@ void memory_view::disable()
 
 void memory_view::select(int slot)
 {
+	// drivers often rewrite a bank register with the value it already holds
+	if(m_cur_id != -1 && slot == m_cur_slot)
+		return;
+
 	auto i = m_entry_mapping.find(slot);
 	if (i == m_entry_mapping.end())
 		fatalerror("memory_view %s: select of unknown slot %d", m_name, slot);
@@ -64,6 +64,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DIFF_DIRECTORY,                             "diff",      core_options::option_type::PATH,       "directory to save hard drive image difference files" },
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  core_options::option_type::PATH,       "directory to save debugger comments" },
 	{ OPTION_SHARE_DIRECTORY,                            "share",     core_options::option_type::PATH,       "directory to share with emulated machines" },
+	{ OPTION_DRC_CACHE_DIRECTORY,                        "drccache",  core_options::option_type::PATH,       "directory to save DRC translation cache lists" },
+	{ OPTION_NETLIST_CACHE_DIRECTORY,                    "nlcache",   core_options::option_type::PATH,       "directory to save compiled netlist solver libraries" },
 
 	// state/playback options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
@@ -71,6 +73,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_AUTOSAVE,                                   "0",         core_options::option_type::BOOLEAN,    "automatically restore state on start and save on exit for supported systems" },
 	{ OPTION_REWIND,                                     "0",         core_options::option_type::BOOLEAN,    "enable rewind savestates" },
 	{ OPTION_REWIND_CAPACITY "(1-2048)",                 "100",       core_options::option_type::INTEGER,    "rewind buffer size in megabytes" },
+	{ OPTION_REWIND_DELTA,                               "0",         core_options::option_type::BOOLEAN,    "store only the parts of each rewind state that changed since the previous one" },
+	{ OPTION_REWIND_COMPRESS,                            "0",         core_options::option_type::BOOLEAN,    "run-length compress changed parts of delta rewind states" },
+	{ OPTION_ASYNC_SAVE,                                 "0",         core_options::option_type::BOOLEAN,    "compress and write save states on a background thread" },
 	{ OPTION_PLAYBACK ";pb",                             nullptr,     core_options::option_type::STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,     core_options::option_type::STRING,     "record an input file" },
 	{ OPTION_EXIT_AFTER_PLAYBACK,                        "0",         core_options::option_type::BOOLEAN,    "close the program at the end of playback" },
@@ -78,10 +83,16 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_MNGWRITE,                                   nullptr,     core_options::option_type::PATH,       "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   nullptr,     core_options::option_type::PATH,       "optional filename to write an AVI movie of the current session" },
 	{ OPTION_WAVWRITE,                                   nullptr,     core_options::option_type::PATH,       "optional filename to write a WAV file of the current session" },
+	{ OPTION_SHMEXPORT,                                  nullptr,     core_options::option_type::STRING,     "optional name of a shared memory ring to publish frames and sound to" },
+	{ OPTION_SHMEXPORTSLOTS "(2-64)",                    "4",         core_options::option_type::INTEGER,    "number of frames and sound buffers kept in the shared memory ring" },
+	{ OPTION_SHMEXPORTMEM,                               nullptr,     core_options::option_type::STRING,     "program memory to publish with each exported frame, as <device>,<start>,<length> in hexadecimal" },
+	{ OPTION_SHMSTEP,                                    "0",         core_options::option_type::BOOLEAN,    "wait after each exported frame until another process asks for the next one" },
 	{ OPTION_SNAPNAME,                                   "%g/%i",     core_options::option_type::STRING,     "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ OPTION_SNAPSIZE,                                   "auto",      core_options::option_type::STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ OPTION_SNAPVIEW,                                   "auto",      core_options::option_type::STRING,     "snapshot/movie view - 'auto' for default, or 'native' for per-screen pixel-aspect views" },
 	{ OPTION_SNAPBILINEAR,                               "1",         core_options::option_type::BOOLEAN,    "specify if the snapshot/movie should have bilinear filtering applied" },
+	{ OPTION_SNAPASYNC,                                  "0",         core_options::option_type::BOOLEAN,    "encode snapshot PNGs on worker threads instead of the emulation thread" },
+	{ OPTION_SNAPCOMPRESSION,                            "-1",        core_options::option_type::INTEGER,    "snapshot PNG compression level (0-9; -1 for the zlib default, 1 for fast bulk capture)" },
 	{ OPTION_STATENAME,                                  "%g",        core_options::option_type::STRING,     "override of the default state subfolder naming; %g == gamename" },
 	{ OPTION_BURNIN,                                     "0",         core_options::option_type::BOOLEAN,    "create burn-in snapshots for each screen" },
 
@@ -95,6 +106,15 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       core_options::option_type::FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         core_options::option_type::BOOLEAN,    "automatically adjust emulation speed to keep the emulated refresh rate slower than the host screen" },
 	{ OPTION_LOWLATENCY ";lolat",                        "0",         core_options::option_type::BOOLEAN,    "draws new frame before throttling to reduce input latency" },
+	{ OPTION_IDLEDETECT,                                 "1",         core_options::option_type::BOOLEAN,    "skip the rest of a timeslice when a CPU that supports it spins in a loop that only reads memory" },
+	{ OPTION_PARALLEL_SOUND,                             "0",         core_options::option_type::BOOLEAN,    "generate sound from independent parallel-safe sound devices concurrently on worker threads" },
+	{ OPTION_RUNAHEAD "(0-8)",                           "0",         core_options::option_type::INTEGER,    "number of frames to emulate ahead of the displayed frame to hide input latency" },
+	{ OPTION_LATEINPUT "(0-100)",                        "0",         core_options::option_type::INTEGER,    "poll host input again when a port is read this many milliseconds after the last poll (0 = once per frame)" },
+	{ OPTION_HEADLESS,                                   "0",         core_options::option_type::BOOLEAN,    "run without video, sound, input, throttling or user interface, for unattended batch runs" },
+	{ OPTION_SNAPFRAMES,                                 "",          core_options::option_type::STRING,     "comma-separated list of frame numbers at which to save snapshots of the active screens" },
+	{ OPTION_PREDECODE_GFX,                              "0",         core_options::option_type::BOOLEAN,    "decode all tile and sprite graphics on worker threads at startup instead of on first use" },
+	{ OPTION_HUGEPAGES,                                  "0",         core_options::option_type::BOOLEAN,    "ask the host to back large emulated RAM and DRC caches with huge pages" },
+	{ OPTION_LOADINGFASTFORWARD ";lff",                  "0",         core_options::option_type::BOOLEAN,    "fast-forward with sound muted while a tape, floppy or CD drive is busy loading" },
 
 	// render options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE RENDER OPTIONS" },
@@ -146,6 +166,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_VOLUME ";vol",                              "0",         core_options::option_type::INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
 	{ OPTION_COMPRESSOR,                                 "1",         core_options::option_type::BOOLEAN,    "enable compressor for sound" },
 	{ OPTION_SPEAKER_REPORT "(0-4)",                     "0",         core_options::option_type::INTEGER,    "print report of speaker ouput maxima (0=none, or 1-4 for more detail)" },
+	{ OPTION_AUDIO_RATE_CONTROL,                         "0",         core_options::option_type::BOOLEAN,    "adjust the sound output rate by up to 0.5% to hold the OSD buffer level (for use with -syncrefresh)" },
 
 	// input options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE INPUT OPTIONS" },
@@ -164,6 +185,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_JOYSTICK_SATURATION ";joy_saturation;jsat(0.00-1)",  "0.85", core_options::option_type::FLOAT,  "end of axis saturation range for joystick where change is ignored (0.0 center, 1.0 end)" },
 	{ OPTION_JOYSTICK_THRESHOLD ";joy_threshold;jthresh(0.00-1)", "0.3",  core_options::option_type::FLOAT,  "threshold for joystick to be considered active as a switch (0.0 center, 1.0 end)" },
 	{ OPTION_NATURAL_KEYBOARD ";nat",                    "0",         core_options::option_type::BOOLEAN,    "specifies whether to use a natural keyboard or not" },
+	{ OPTION_FAST_PASTE,                                 "0",         core_options::option_type::BOOLEAN,    "post pasted keys as soon as the emulated keyboard scan has read the previous one" },
 	{ OPTION_JOYSTICK_CONTRADICTORY ";joy_contradictory","0",         core_options::option_type::BOOLEAN,    "enable contradictory direction digital joystick input at the same time" },
 	{ OPTION_COIN_IMPULSE,                               "0",         core_options::option_type::INTEGER,    "set coin impulse time (n<0 disable impulse, n==0 obey driver, 0<n set time n)" },
 
@@ -187,6 +209,19 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UPDATEINPAUSE,                              "0",         core_options::option_type::BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,     core_options::option_type::PATH,       "script for debugger" },
 	{ OPTION_DEBUGLOG,                                   "0",         core_options::option_type::BOOLEAN,    "write debug console output to debug.log" },
+	{ OPTION_SCHEDSTATS,                                 "0",         core_options::option_type::BOOLEAN,    "gather scheduler timeslice and per-device cycle statistics and report them at exit" },
+	{ OPTION_IDLEREPORT,                                 "0",         core_options::option_type::BOOLEAN,    "look for idle loops without skipping them and report the likeliest spin loop hints at exit; combine with -str, -video none and -nothrottle for a headless scan" },
+	{ OPTION_MEMHEATMAP,                                 nullptr,     core_options::option_type::PATH,       "count memory accesses per page, handler and executing device, and write them to the specified JSON file at exit" },
+	{ OPTION_STARTUPPROFILE,                             nullptr,     core_options::option_type::PATH,       "write a Chrome trace event JSON file timing startup phases up to the first frame" },
+	{ OPTION_PROFILETRACE,                               nullptr,     core_options::option_type::PATH,       "record a timeline of profiler scopes, timeslices and work queue items, and write it as a Chrome trace event JSON file on exit" },
+	{ OPTION_PROFILESAMPLE "(0-1000000)",                "0",         core_options::option_type::INTEGER,    "sample the profiler scope at this interval in microseconds rather than timing every transition (0 = time every transition)" },
+	{ OPTION_BENCHREPORT,                                nullptr,     core_options::option_type::PATH,       "write emulation speed, profiler breakdown and peak memory use to a JSON file on exit" },
+	{ OPTION_BENCHINTERVAL,                              "0",         core_options::option_type::FLOAT,      "emulated seconds between timing and profiler samples in the benchmark report (0 = don't sample)" },
+	{ OPTION_BENCHBASELINE,                              nullptr,     core_options::option_type::PATH,       "compare timing samples against a previous benchmark report and fail if they are slower" },
+	{ OPTION_BENCHTHRESHOLD "(0-1000)",                  "10",        core_options::option_type::FLOAT,      "percentage by which real time may exceed the baseline before failing" },
+	{ OPTION_STATEHASH "(0-1000000)",                    "0",         core_options::option_type::INTEGER,    "hash every save state entry each time this many frames have been emulated (0 = don't hash)" },
+	{ OPTION_STATEHASHLOG,                               nullptr,     core_options::option_type::PATH,       "write the state hashes to a log file" },
+	{ OPTION_STATEHASHCOMPARE,                           nullptr,     core_options::option_type::PATH,       "compare the state hashes against a log from a previous run and report the first entries that differ" },
 
 	// comm options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE COMM OPTIONS" },
@@ -196,14 +231,41 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_COMM_REMOTE_PORT,                           "15112",     core_options::option_type::STRING,     "remote port to connect to" },
 	{ OPTION_COMM_FRAME_SYNC,                            "0",         core_options::option_type::BOOLEAN,    "sync frames" },
 
+	// netplay options
+	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE NETPLAY OPTIONS" },
+	{ OPTION_NETPLAY_LOCAL_PORT,                         "15113",     core_options::option_type::STRING,     "local UDP port to exchange inputs on" },
+	{ OPTION_NETPLAY_REMOTE_HOST,                        "",          core_options::option_type::STRING,     "address of the other instance to play with (empty = netplay disabled)" },
+	{ OPTION_NETPLAY_REMOTE_PORT,                        "15113",     core_options::option_type::STRING,     "UDP port of the other instance" },
+	{ OPTION_NETPLAY_PLAYER "(1-2)",                     "1",         core_options::option_type::INTEGER,    "side controlled by this instance (1 = player 1 and system inputs, 2 = player 2)" },
+	{ OPTION_NETPLAY_DELAY "(0-8)",                      "1",         core_options::option_type::INTEGER,    "frames to delay local inputs by, reducing rollbacks" },
+
 	// misc options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE MISC OPTIONS" },
 	{ OPTION_DRC,                                        "1",         core_options::option_type::BOOLEAN,    "enable DRC CPU core if available" },
 	{ OPTION_DRC_USE_C,                                  "0",         core_options::option_type::BOOLEAN,    "force DRC to use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         core_options::option_type::BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         core_options::option_type::BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_CACHE,                                  "0",         core_options::option_type::BOOLEAN,    "remember compiled DRC blocks and precompile them on the next run" },
+	{ OPTION_DRC_BACKGROUND,                             "0",         core_options::option_type::BOOLEAN,    "compile DRC blocks on a worker thread, interpreting meanwhile where supported" },
+	{ OPTION_DRC_PROFILE,                                "0",         core_options::option_type::BOOLEAN,    "count entries to each DRC block for the drcprofile debugger command" },
+	{ OPTION_DRC_RSP,                                    "0",         core_options::option_type::BOOLEAN,    "use the experimental RSP recompiler when DRC is enabled" },
+	{ OPTION_DRC_I386,                                   "0",         core_options::option_type::BOOLEAN,    "use the experimental i386 family recompiler when DRC is enabled" },
+	{ OPTION_DRC_M68K,                                   "0",         core_options::option_type::BOOLEAN,    "use the experimental 68010/68020 family recompiler when DRC is enabled" },
+	{ OPTION_NETLIST_CACHE,                              "0",         core_options::option_type::BOOLEAN,    "compile netlist solvers missing from the static set in the background and load them on later runs" },
+	{ OPTION_NETLIST_COMPILER,                           "c++ -O2 -shared -fPIC", core_options::option_type::STRING, "compiler command used to build netlist solver libraries" },
+	{ OPTION_NETLIST_INCLUDE_PATH,                       "src/lib/netlist", core_options::option_type::PATH, "path to the netlist library headers used to build netlist solver libraries" },
+	{ OPTION_HASH_CACHE,                                 "1",         core_options::option_type::BOOLEAN,    "remember ROM checksums in the cfg directory so unchanged files aren't hashed again" },
+	{ OPTION_PATH_CACHE,                                 "1",         core_options::option_type::BOOLEAN,    "remember the contents of media path directories so files missing from them aren't looked for again" },
+	{ OPTION_ARCHIVE_INDEX,                              "1",         core_options::option_type::BOOLEAN,    "remember ZIP archive directories in the cfg directory so unchanged archives aren't read again" },
+	{ OPTION_MAP_ROMS,                                   "0",         core_options::option_type::BOOLEAN,    "map large uncompressed ROM files into memory copy-on-write instead of reading them" },
+	{ OPTION_ROM_CACHE,                                  "",          core_options::option_type::PATH,       "directory (ideally on tmpfs) of loaded ROM regions keyed by content, mapped copy-on-write so instances share them" },
+	{ OPTION_DISK_OVERLAY,                               "0",         core_options::option_type::BOOLEAN,    "keep changes to read-only hard disk images in memory instead of writing difference files" },
+	{ OPTION_SYSTEM_CACHE,                               "1",         core_options::option_type::BOOLEAN,    "remember system device trees in the cfg directory so listing them doesn't need the devices built again" },
+	{ OPTION_SOFTLIST_INDEX,                             "1",         core_options::option_type::BOOLEAN,    "remember parsed software lists in the cfg directory so unchanged lists aren't parsed again" },
+	{ OPTION_BATCH,                                      nullptr,     core_options::option_type::PATH,       "run each system listed in the specified file in turn, sharing startup work between them" },
 	{ OPTION_BIOS,                                       nullptr,     core_options::option_type::STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         core_options::option_type::BOOLEAN,    "enable cheat subsystem" },
+	{ OPTION_CHEAT_TAPS,                                 "0",         core_options::option_type::BOOLEAN,    "re-apply cheats that only store to fixed addresses when the system writes there rather than every frame" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         core_options::option_type::BOOLEAN,    "skip displaying the system information screen at startup" },
 	{ OPTION_UI_FONT,                                    "default",   core_options::option_type::STRING,     "specify a font to use" },
 	{ OPTION_UI,                                         "cabinet",   core_options::option_type::STRING,     "type of UI (simple|cabinet)" },
@@ -805,7 +867,7 @@ std::string emu_options::get_default_card_software(device_slot_interface &slot)
 			util::hash_collection hashes = image->calculate_hash_on_file(file);
 
 			return hashfile_extrainfo(
-					hash_path(),
+					*this,
 					image->device().mconfig().gamedrv(),
 					hashes,
 					extrainfo);
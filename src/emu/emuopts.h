@@ -48,22 +48,33 @@
 #define OPTION_DIFF_DIRECTORY       "diff_directory"
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
 #define OPTION_SHARE_DIRECTORY      "share_directory"
+#define OPTION_DRC_CACHE_DIRECTORY  "drc_cache_directory"
+#define OPTION_NETLIST_CACHE_DIRECTORY "netlist_cache_directory"
 
 // core state/playback options
 #define OPTION_STATE                "state"
 #define OPTION_AUTOSAVE             "autosave"
 #define OPTION_REWIND               "rewind"
 #define OPTION_REWIND_CAPACITY      "rewind_capacity"
+#define OPTION_REWIND_DELTA         "rewind_delta"
+#define OPTION_REWIND_COMPRESS      "rewind_compress"
+#define OPTION_ASYNC_SAVE           "async_save"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
 #define OPTION_WAVWRITE             "wavwrite"
+#define OPTION_SHMEXPORT            "shmexport"
+#define OPTION_SHMEXPORTSLOTS       "shmexportslots"
+#define OPTION_SHMEXPORTMEM         "shmexportmem"
+#define OPTION_SHMSTEP              "shmstep"
 #define OPTION_SNAPNAME             "snapname"
 #define OPTION_SNAPSIZE             "snapsize"
 #define OPTION_SNAPVIEW             "snapview"
 #define OPTION_SNAPBILINEAR         "snapbilinear"
+#define OPTION_SNAPASYNC            "snapasync"
+#define OPTION_SNAPCOMPRESSION      "snapcompression"
 #define OPTION_STATENAME            "statename"
 #define OPTION_BURNIN               "burnin"
 
@@ -76,6 +87,15 @@
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
 #define OPTION_LOWLATENCY           "lowlatency"
+#define OPTION_IDLEDETECT           "idledetect"
+#define OPTION_PARALLEL_SOUND       "parallel_sound"
+#define OPTION_RUNAHEAD             "runahead"
+#define OPTION_LATEINPUT            "lateinput"
+#define OPTION_HEADLESS             "headless"
+#define OPTION_SNAPFRAMES           "snapframes"
+#define OPTION_PREDECODE_GFX        "predecode_gfx"
+#define OPTION_HUGEPAGES            "hugepages"
+#define OPTION_LOADINGFASTFORWARD   "loadingfastforward"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -121,6 +141,7 @@
 #define OPTION_VOLUME               "volume"
 #define OPTION_COMPRESSOR           "compressor"
 #define OPTION_SPEAKER_REPORT       "speaker_report"
+#define OPTION_AUDIO_RATE_CONTROL   "audio_rate_control"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -138,6 +159,7 @@
 #define OPTION_JOYSTICK_SATURATION  "joystick_saturation"
 #define OPTION_JOYSTICK_THRESHOLD   "joystick_threshold"
 #define OPTION_NATURAL_KEYBOARD     "natural"
+#define OPTION_FAST_PASTE           "fastpaste"
 #define OPTION_JOYSTICK_CONTRADICTORY   "joystick_contradictory"
 #define OPTION_COIN_IMPULSE         "coin_impulse"
 
@@ -159,14 +181,46 @@
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
 #define OPTION_DEBUGLOG             "debuglog"
+#define OPTION_SCHEDSTATS           "schedstats"
+#define OPTION_IDLEREPORT           "idlereport"
+#define OPTION_MEMHEATMAP           "memheatmap"
+#define OPTION_STARTUPPROFILE       "startupprofile"
+#define OPTION_PROFILETRACE         "profiletrace"
+#define OPTION_PROFILESAMPLE        "profilesample"
+#define OPTION_BENCHREPORT          "benchreport"
+#define OPTION_BENCHINTERVAL        "benchinterval"
+#define OPTION_BENCHBASELINE        "benchbaseline"
+#define OPTION_BENCHTHRESHOLD       "benchthreshold"
+#define OPTION_STATEHASH            "statehash"
+#define OPTION_STATEHASHLOG         "statehashlog"
+#define OPTION_STATEHASHCOMPARE     "statehashcompare"
 
 // core misc options
 #define OPTION_DRC                  "drc"
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_CACHE            "drc_cache"
+#define OPTION_DRC_BACKGROUND       "drc_background"
+#define OPTION_DRC_PROFILE          "drc_profile"
+#define OPTION_DRC_RSP              "drc_rsp"
+#define OPTION_DRC_I386             "drc_i386"
+#define OPTION_DRC_M68K             "drc_m68k"
+#define OPTION_NETLIST_CACHE        "netlist_cache"
+#define OPTION_NETLIST_COMPILER     "netlist_compiler"
+#define OPTION_NETLIST_INCLUDE_PATH "netlist_include_path"
+#define OPTION_HASH_CACHE           "hash_cache"
+#define OPTION_PATH_CACHE           "path_cache"
+#define OPTION_ARCHIVE_INDEX        "archive_index"
+#define OPTION_MAP_ROMS             "map_roms"
+#define OPTION_ROM_CACHE            "rom_cache"
+#define OPTION_DISK_OVERLAY         "disk_overlay"
+#define OPTION_SYSTEM_CACHE         "system_cache"
+#define OPTION_SOFTLIST_INDEX       "softlist_index"
+#define OPTION_BATCH                "batch"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
+#define OPTION_CHEAT_TAPS           "cheat_taps"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
 #define OPTION_UI_FONT              "uifont"
 #define OPTION_UI                   "ui"
@@ -180,6 +234,13 @@
 #define OPTION_COMM_REMOTE_PORT     "comm_remoteport"
 #define OPTION_COMM_FRAME_SYNC      "comm_framesync"
 
+// core netplay options
+#define OPTION_NETPLAY_LOCAL_PORT   "netplay_localport"
+#define OPTION_NETPLAY_REMOTE_HOST  "netplay_remotehost"
+#define OPTION_NETPLAY_REMOTE_PORT  "netplay_remoteport"
+#define OPTION_NETPLAY_PLAYER       "netplay_player"
+#define OPTION_NETPLAY_DELAY        "netplay_delay"
+
 #define OPTION_CONFIRM_QUIT         "confirm_quit"
 #define OPTION_UI_MOUSE             "ui_mouse"
 
@@ -334,22 +395,33 @@ public:
 	const char *diff_directory() const { return value(OPTION_DIFF_DIRECTORY); }
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
 	const char *share_directory() const { return value(OPTION_SHARE_DIRECTORY); }
+	const char *drc_cache_directory() const { return value(OPTION_DRC_CACHE_DIRECTORY); }
+	const char *netlist_cache_directory() const { return value(OPTION_NETLIST_CACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
 	int rewind() const { return bool_value(OPTION_REWIND); }
 	int rewind_capacity() const { return int_value(OPTION_REWIND_CAPACITY); }
+	bool rewind_delta() const { return bool_value(OPTION_REWIND_DELTA); }
+	bool rewind_compress() const { return bool_value(OPTION_REWIND_COMPRESS); }
+	bool async_save() const { return bool_value(OPTION_ASYNC_SAVE); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
 	const char *wav_write() const { return value(OPTION_WAVWRITE); }
+	const char *shm_export() const { return value(OPTION_SHMEXPORT); }
+	int shm_export_slots() const { return int_value(OPTION_SHMEXPORTSLOTS); }
+	const char *shm_export_mem() const { return value(OPTION_SHMEXPORTMEM); }
+	bool shm_step() const { return bool_value(OPTION_SHMSTEP); }
 	const char *snap_name() const { return value(OPTION_SNAPNAME); }
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
 	const char *snap_view() const { return value(OPTION_SNAPVIEW); }
 	bool snap_bilinear() const { return bool_value(OPTION_SNAPBILINEAR); }
+	bool snap_async() const { return bool_value(OPTION_SNAPASYNC); }
+	int snap_compression() const { return int_value(OPTION_SNAPCOMPRESSION); }
 	const char *state_name() const { return value(OPTION_STATENAME); }
 	bool burnin() const { return bool_value(OPTION_BURNIN); }
 
@@ -362,6 +434,15 @@ public:
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
 	bool low_latency() const { return bool_value(OPTION_LOWLATENCY); }
+	bool idle_detect() const { return bool_value(OPTION_IDLEDETECT); }
+	bool parallel_sound() const { return bool_value(OPTION_PARALLEL_SOUND); }
+	int runahead() const { return int_value(OPTION_RUNAHEAD); }
+	int late_input() const { return int_value(OPTION_LATEINPUT); }
+	bool headless() const { return bool_value(OPTION_HEADLESS); }
+	bool predecode_gfx() const { return bool_value(OPTION_PREDECODE_GFX); }
+	bool huge_pages() const { return bool_value(OPTION_HUGEPAGES); }
+	bool loading_fastforward() const { return bool_value(OPTION_LOADINGFASTFORWARD); }
+	const char *snap_frames() const { return value(OPTION_SNAPFRAMES); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -407,6 +488,7 @@ public:
 	int volume() const { return int_value(OPTION_VOLUME); }
 	bool compressor() const { return bool_value(OPTION_COMPRESSOR); }
 	int speaker_report() const { return int_value(OPTION_SPEAKER_REPORT); }
+	bool audio_rate_control() const { return bool_value(OPTION_AUDIO_RATE_CONTROL); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -432,6 +514,7 @@ public:
 	bool ui_active() const { return bool_value(OPTION_UI_ACTIVE); }
 	bool offscreen_reload() const { return bool_value(OPTION_OFFSCREEN_RELOAD); }
 	bool natural_keyboard() const { return bool_value(OPTION_NATURAL_KEYBOARD); }
+	bool fast_paste() const { return bool_value(OPTION_FAST_PASTE); }
 	bool joystick_contradictory() const { return m_joystick_contradictory; }
 	int coin_impulse() const { return m_coin_impulse; }
 
@@ -443,14 +526,46 @@ public:
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
 	bool debuglog() const { return bool_value(OPTION_DEBUGLOG); }
+	bool sched_stats() const { return bool_value(OPTION_SCHEDSTATS); }
+	bool idle_report() const { return bool_value(OPTION_IDLEREPORT); }
+	const char *memory_heatmap() const { return value(OPTION_MEMHEATMAP); }
+	const char *startup_profile() const { return value(OPTION_STARTUPPROFILE); }
+	const char *profile_trace() const { return value(OPTION_PROFILETRACE); }
+	int profile_sample() const { return int_value(OPTION_PROFILESAMPLE); }
+	const char *bench_report() const { return value(OPTION_BENCHREPORT); }
+	float bench_interval() const { return float_value(OPTION_BENCHINTERVAL); }
+	const char *bench_baseline() const { return value(OPTION_BENCHBASELINE); }
+	float bench_threshold() const { return float_value(OPTION_BENCHTHRESHOLD); }
+	int state_hash() const { return int_value(OPTION_STATEHASH); }
+	const char *state_hash_log() const { return value(OPTION_STATEHASHLOG); }
+	const char *state_hash_compare() const { return value(OPTION_STATEHASHCOMPARE); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_cache() const { return bool_value(OPTION_DRC_CACHE); }
+	bool drc_background() const { return bool_value(OPTION_DRC_BACKGROUND); }
+	bool drc_profile() const { return bool_value(OPTION_DRC_PROFILE); }
+	bool drc_rsp() const { return bool_value(OPTION_DRC_RSP); }
+	bool drc_i386() const { return bool_value(OPTION_DRC_I386); }
+	bool drc_m68k() const { return bool_value(OPTION_DRC_M68K); }
+	bool netlist_cache() const { return bool_value(OPTION_NETLIST_CACHE); }
+	const char *netlist_compiler() const { return value(OPTION_NETLIST_COMPILER); }
+	const char *netlist_include_path() const { return value(OPTION_NETLIST_INCLUDE_PATH); }
+	bool hash_cache() const { return bool_value(OPTION_HASH_CACHE); }
+	bool path_cache() const { return bool_value(OPTION_PATH_CACHE); }
+	bool archive_index() const { return bool_value(OPTION_ARCHIVE_INDEX); }
+	bool map_roms() const { return bool_value(OPTION_MAP_ROMS); }
+	const char *rom_cache() const { return value(OPTION_ROM_CACHE); }
+	bool disk_overlay() const { return bool_value(OPTION_DISK_OVERLAY); }
+	bool system_cache() const { return bool_value(OPTION_SYSTEM_CACHE); }
+	bool softlist_index() const { return bool_value(OPTION_SOFTLIST_INDEX); }
+	const char *batch() const { return value(OPTION_BATCH); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
+	bool cheat_taps() const { return bool_value(OPTION_CHEAT_TAPS); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
 	const char *ui_font() const { return value(OPTION_UI_FONT); }
 	ui_option ui() const { return m_ui; }
@@ -464,6 +579,13 @@ public:
 	const char *comm_remoteport() const { return value(OPTION_COMM_REMOTE_PORT); }
 	bool comm_framesync() const { return bool_value(OPTION_COMM_FRAME_SYNC); }
 
+	// core netplay options
+	const char *netplay_localport() const { return value(OPTION_NETPLAY_LOCAL_PORT); }
+	const char *netplay_remotehost() const { return value(OPTION_NETPLAY_REMOTE_HOST); }
+	const char *netplay_remoteport() const { return value(OPTION_NETPLAY_REMOTE_PORT); }
+	int netplay_player() const { return int_value(OPTION_NETPLAY_PLAYER); }
+	int netplay_delay() const { return int_value(OPTION_NETPLAY_DELAY); }
+
 
 	bool confirm_quit() const { return bool_value(OPTION_CONFIRM_QUIT); }
 	bool ui_mouse() const { return bool_value(OPTION_UI_MOUSE); }
@@ -14,6 +14,9 @@
 #include "util/path.h"
 #include "util/unzip.h"
 
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
 #include <tuple>
 
 //#define VERBOSE 1
@@ -41,6 +44,45 @@ template emu_file::emu_file(const std::vector<std::string> &, u32);
 const u32 OPEN_FLAG_HAS_CRC  = 0x10000;
 
 
+namespace {
+
+char const HASH_CACHE_FILENAME[] = "hashcache.txt";
+
+
+//-------------------------------------------------
+//  missing_hash_types - list the requested hash
+//  types a collection doesn't have yet
+//-------------------------------------------------
+
+std::string missing_hash_types(util::hash_collection const &hashes, std::string_view types)
+{
+	std::string const already_have = hashes.hash_types();
+	std::string needed;
+	for (char scan : types)
+		if (already_have.find_first_of(scan) == std::string::npos)
+			needed.push_back(scan);
+	return needed;
+}
+
+
+//-------------------------------------------------
+//  merge_hashes - add the hashes from one
+//  collection that another is missing
+//-------------------------------------------------
+
+void merge_hashes(util::hash_collection &dest, util::hash_collection const &source)
+{
+	u32 crc;
+	util::sha1_t sha1;
+	if (!dest.crc(crc) && source.crc(crc))
+		dest.add_crc(crc);
+	if (!dest.sha1(sha1) && source.sha1(sha1))
+		dest.add_sha1(sha1);
+}
+
+} // anonymous namespace
+
+
 
 //**************************************************************************
 //  PATH ITERATOR
@@ -181,6 +223,281 @@ const osd::directory::entry *file_enumerator::next(const char *subdir)
 
 
 
+//**************************************************************************
+//  FILE HASH CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  get - get the shared cache for a directory;
+//  caches live until exit so that short-lived
+//  users such as auditors don't reload them
+//-------------------------------------------------
+
+file_hash_cache &file_hash_cache::get(std::string_view directory)
+{
+	static std::mutex s_mutex;
+	static std::map<std::string, std::unique_ptr<file_hash_cache>, std::less<> > s_caches;
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	auto found(s_caches.find(directory));
+	if (s_caches.end() == found)
+		found = s_caches.emplace(std::string(directory), std::unique_ptr<file_hash_cache>(new file_hash_cache(directory))).first;
+	return *found->second;
+}
+
+
+//-------------------------------------------------
+//  file_hash_cache - constructor, loading the
+//  cache file
+//-------------------------------------------------
+
+file_hash_cache::file_hash_cache(std::string_view directory)
+	: m_directory(directory)
+	, m_rewrite(false)
+{
+	emu_file file(m_directory, OPEN_FLAG_READ);
+	if (file.open(HASH_CACHE_FILENAME))
+		return;
+
+	// each line is size, modification time and hashes separated by spaces, then the path and archive entry separated by a tab
+	std::string data(file.size(), '\0');
+	data.resize(file.read(data.data(), data.size()));
+	std::size_t lines = 0;
+	for (std::string_view remaining(data); !remaining.empty(); )
+	{
+		std::string_view line(remaining.substr(0, remaining.find('\n')));
+		remaining.remove_prefix(std::min(line.length() + 1, remaining.length()));
+		if (!line.empty() && (line.back() == '\r'))
+			line.remove_suffix(1);
+
+		unsigned long long size;
+		long long mtime;
+		int hashstart = -1, hashend = -1;
+		std::string const text(line);
+		if ((sscanf(text.c_str(), "%llu %lld %n%*s%n", &size, &mtime, &hashstart, &hashend) < 2) || (hashend < 0))
+			continue;
+		std::string_view const name(line.substr(std::min<std::size_t>(hashend + 1, line.length())));
+		std::string_view::size_type const tab(name.find('\t'));
+		if (std::string_view::npos == tab)
+			continue;
+
+		m_entries[make_key(name.substr(0, tab), name.substr(tab + 1))] = cache_entry{ size, mtime, std::string(line.substr(hashstart, hashend - hashstart)) };
+		lines++;
+	}
+
+	// superseded lines accumulate since new entries are appended
+	m_rewrite = lines > (m_entries.size() * 2);
+}
+
+
+//-------------------------------------------------
+//  make_key - build the map key for a path and
+//  archive entry
+//-------------------------------------------------
+
+std::string file_hash_cache::make_key(std::string_view path, std::string_view entry)
+{
+	std::string result;
+	result.reserve(path.length() + 1 + entry.length());
+	result.append(path).append(1, '\t').append(entry);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  find - get the hashes recorded for a file if
+//  it hasn't changed since
+//-------------------------------------------------
+
+bool file_hash_cache::find(std::string_view path, std::string_view entry, u64 size, s64 mtime, util::hash_collection &hashes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto const found(m_entries.find(make_key(path, entry)));
+	if ((m_entries.end() == found) || (found->second.size != size) || (found->second.mtime != mtime))
+		return false;
+	return hashes.from_internal_string(found->second.hashes);
+}
+
+
+//-------------------------------------------------
+//  add - record the hashes of a file, keeping
+//  any other types already known for it
+//-------------------------------------------------
+
+void file_hash_cache::add(std::string_view path, std::string_view entry, u64 size, s64 mtime, util::hash_collection const &hashes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::string key(make_key(path, entry));
+	auto found(m_entries.find(key));
+	util::hash_collection merged(hashes);
+	if ((m_entries.end() != found) && (found->second.size == size) && (found->second.mtime == mtime))
+		merge_hashes(merged, util::hash_collection(found->second.hashes));
+
+	std::string text(merged.internal_string());
+	if ((m_entries.end() != found) && (found->second.size == size) && (found->second.mtime == mtime) && (found->second.hashes == text))
+		return;
+	m_entries[key] = cache_entry{ size, mtime, std::move(text) };
+	m_added.emplace_back(std::move(key));
+}
+
+
+//-------------------------------------------------
+//  flush - append new entries to the cache file,
+//  or rewrite it if it has grown too stale
+//-------------------------------------------------
+
+void file_hash_cache::flush()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_added.empty() && !m_rewrite)
+		return;
+
+	// append to the existing file if we can, otherwise write everything out
+	emu_file file(m_directory, OPEN_FLAG_READ | OPEN_FLAG_WRITE);
+	bool const append(!m_rewrite && !file.open(HASH_CACHE_FILENAME) && !file.seek(0, SEEK_END));
+	if (!append)
+	{
+		file.close();
+		file.set_openflags(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file.open(HASH_CACHE_FILENAME))
+			return;
+	}
+
+	auto const write_entry =
+			[&file] (std::string const &key, cache_entry const &entry)
+			{
+				file.printf("%u %d %s %s\n", entry.size, entry.mtime, entry.hashes, key);
+			};
+	if (append)
+	{
+		for (std::string const &key : m_added)
+		{
+			auto const found(m_entries.find(key));
+			if (m_entries.end() != found)
+				write_entry(found->first, found->second);
+		}
+	}
+	else
+	{
+		for (auto const &entry : m_entries)
+			write_entry(entry.first, entry.second);
+	}
+	m_added.clear();
+	m_rewrite = false;
+}
+
+
+
+//**************************************************************************
+//  PATH LISTING CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  get - get the process-wide cache
+//-------------------------------------------------
+
+path_listing_cache &path_listing_cache::get()
+{
+	static path_listing_cache s_cache;
+	return s_cache;
+}
+
+
+//-------------------------------------------------
+//  revalidate - have listings checked against
+//  their directories again before they're used
+//-------------------------------------------------
+
+void path_listing_cache::revalidate()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_generation++;
+}
+
+
+//-------------------------------------------------
+//  fold - fold a name to lowercase, so hosts with
+//  case-insensitive filesystems never get a false
+//  negative
+//-------------------------------------------------
+
+std::string path_listing_cache::fold(std::string_view name)
+{
+	std::string result(name);
+	for (char &c : result)
+		c = std::tolower(u8(c));
+	return result;
+}
+
+
+//-------------------------------------------------
+//  read_listing - list a directory
+//-------------------------------------------------
+
+void path_listing_cache::read_listing(std::string const &directory, listing &result)
+{
+	result.names.clear();
+	result.exists = false;
+
+	std::unique_ptr<osd::directory::entry> const entry(osd_stat(directory));
+	if (!entry || (entry->type != osd::directory::entry::entry_type::DIR))
+		return;
+	osd::directory::ptr const dir(osd::directory::open(directory));
+	if (!dir)
+		return;
+
+	result.exists = true;
+	result.mtime = entry->last_modified;
+	for (osd::directory::entry const *item = dir->read(); item; item = dir->read())
+		result.names.emplace(fold(item->name));
+}
+
+
+//-------------------------------------------------
+//  may_exist - see whether the directory listing
+//  rules a path out, listing the directory or
+//  checking the listing is current as necessary
+//-------------------------------------------------
+
+bool path_listing_cache::may_exist(std::string_view path)
+{
+	auto const dirsepiter(std::find_if(path.rbegin(), path.rend(), util::is_directory_separator));
+	std::string_view::size_type const leafstart(std::distance(dirsepiter, path.rend()));
+	std::string_view const leaf(path.substr(leafstart));
+	if (leaf.empty() || (leaf == ".") || (leaf == ".."))
+		return true;
+
+	// keep the separator for a root directory ("/" or "C:\")
+	std::string directory;
+	if (!leafstart)
+		directory = ".";
+	else if ((leafstart == 1) || ((leafstart == 3) && (path[1] == ':')))
+		directory = std::string(path.substr(0, leafstart));
+	else
+		directory = std::string(path.substr(0, leafstart - 1));
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto found(m_listings.find(directory));
+	if (m_listings.end() == found)
+	{
+		found = m_listings.emplace(directory, listing()).first;
+		read_listing(directory, found->second);
+	}
+	else if (found->second.generation != m_generation)
+	{
+		// adding or removing a file changes the modification time of its directory
+		std::unique_ptr<osd::directory::entry> const entry(osd_stat(directory));
+		bool const exists(entry && (entry->type == osd::directory::entry::entry_type::DIR));
+		if ((exists != found->second.exists) || (exists && (entry->last_modified != found->second.mtime)))
+			read_listing(directory, found->second);
+	}
+	found->second.generation = m_generation;
+
+	return found->second.exists && (found->second.names.find(fold(leaf)) != found->second.names.end());
+}
+
+
+
 //**************************************************************************
 //  EMU FILE
 //**************************************************************************
@@ -215,6 +532,8 @@ emu_file::emu_file(u32 openflags, empty_t)
 	, m_ziplength(0)
 	, m_remove_on_close(false)
 	, m_restrict_to_mediapath(0)
+	, m_hash_cache(nullptr)
+	, m_path_cache(nullptr)
 {
 	// sanity check the open flags
 	if ((m_openflags & OPEN_FLAG_HAS_CRC) && (m_openflags & OPEN_FLAG_WRITE))
@@ -255,19 +574,29 @@ emu_file::operator util::core_file &()
 
 util::hash_collection &emu_file::hashes(std::string_view types)
 {
-	// determine the hashes we already have
-	std::string already_have = m_hashes.hash_types();
-
 	// determine which hashes we need
-	std::string needed;
-	for (char scan : types)
-		if (already_have.find_first_of(scan) == std::string::npos)
-			needed.push_back(scan);
+	std::string needed = missing_hash_types(m_hashes, types);
 
 	// if we need nothing, skip it
 	if (needed.empty())
 		return m_hashes;
 
+	// see if they were computed on an earlier run
+	u64 cachesize;
+	s64 cachetime;
+	bool const cacheable = m_hash_cache && hash_cache_stat(cachesize, cachetime);
+	if (cacheable)
+	{
+		util::hash_collection cached;
+		if (m_hash_cache->find(m_hash_path, m_hash_entry, cachesize, cachetime, cached))
+		{
+			merge_hashes(m_hashes, cached);
+			needed = missing_hash_types(m_hashes, types);
+			if (needed.empty())
+				return m_hashes;
+		}
+	}
+
 	// load the ZIP file if needed
 	if (compressed_file_ready())
 		return m_hashes;
@@ -278,6 +607,8 @@ util::hash_collection &emu_file::hashes(std::string_view types)
 	if (!m_zipdata.empty())
 	{
 		m_hashes.compute(&m_zipdata[0], m_zipdata.size(), needed.c_str());
+		if (cacheable)
+			m_hash_cache->add(m_hash_path, m_hash_entry, cachesize, cachetime, m_hashes);
 		return m_hashes;
 	}
 
@@ -287,12 +618,34 @@ util::hash_collection &emu_file::hashes(std::string_view types)
 
 	// hash the data
 	std::size_t actual;
-	(void)m_hashes.compute(*m_file, 0U, length, actual, needed.c_str()); // FIXME: need better interface to report errors
+	std::error_condition const err = m_hashes.compute(*m_file, 0U, length, actual, needed.c_str()); // FIXME: need better interface to report errors
+	if (cacheable && !err && (actual == length))
+		m_hash_cache->add(m_hash_path, m_hash_entry, cachesize, cachetime, m_hashes);
 
 	return m_hashes;
 }
 
 
+//-------------------------------------------------
+//  hash_cache_stat - get the size and
+//  modification time the hash cache is keyed on
+//-------------------------------------------------
+
+bool emu_file::hash_cache_stat(u64 &size, s64 &mtime) const
+{
+	if (m_hash_path.empty())
+		return false;
+
+	std::unique_ptr<osd::directory::entry> const entry(osd_stat(m_hash_path));
+	if (!entry)
+		return false;
+
+	size = entry->size;
+	mtime = entry->last_modified.time_since_epoch().count();
+	return true;
+}
+
+
 //-------------------------------------------------
 //  open - open a file by searching paths
 //-------------------------------------------------
@@ -379,12 +732,20 @@ std::error_condition emu_file::open_next()
 		}
 		m_fullpath.append(m_filename);
 
-		// attempt to open the file directly
+		// attempt to open the file directly, unless the directory listing says it isn't there
 		LOG("emu_file: attempting to open '%s' directly\n", m_fullpath);
-		filerr = util::core_file::open(m_fullpath, m_openflags, m_file);
+		bool const readonly((m_openflags & (OPEN_FLAG_READ | OPEN_FLAG_WRITE)) == OPEN_FLAG_READ);
+		if (m_path_cache && readonly && !m_path_cache->may_exist(m_fullpath))
+			filerr = std::errc::no_such_file_or_directory;
+		else
+			filerr = util::core_file::open(m_fullpath, m_openflags, m_file);
+
+		// only files opened read-only can have their checksums cached
+		if (!filerr && readonly)
+			m_hash_path = m_fullpath;
 
 		// if we're opening for read-only we have other options
-		if (filerr && ((m_openflags & (OPEN_FLAG_READ | OPEN_FLAG_WRITE)) == OPEN_FLAG_READ))
+		if (filerr && readonly)
 		{
 			LOG("emu_file: attempting to open '%s' from archives\n", m_fullpath);
 			filerr = attempt_zipped();
@@ -430,6 +791,8 @@ void emu_file::close()
 	// reset our hashes and path as well
 	m_hashes.reset();
 	m_fullpath.clear();
+	m_hash_path.clear();
+	m_hash_entry.clear();
 }
 
 
@@ -745,7 +1108,11 @@ std::error_condition emu_file::attempt_zipped()
 
 			// attempt to open the archive file
 			util::archive_file::ptr zip;
-			std::error_condition ziperr = open_funcs[i](m_fullpath, zip);
+			std::error_condition ziperr;
+			if (m_path_cache && !m_path_cache->may_exist(m_fullpath))
+				ziperr = std::errc::no_such_file_or_directory;
+			else
+				ziperr = open_funcs[i](m_fullpath, zip);
 
 			// chop the archive suffix back off the filename before continuing
 			m_fullpath = m_fullpath.substr(0, dirsep);
@@ -782,6 +1149,8 @@ std::error_condition emu_file::attempt_zipped()
 				// build a hash with just the CRC
 				m_hashes.reset();
 				m_hashes.add_crc(m_zipfile->current_crc());
+				m_hash_path = m_fullpath + suffixes[i];
+				m_hash_entry = m_zipfile->current_name();
 				m_fullpath = savepath;
 				return (m_openflags & OPEN_FLAG_NO_PRELOAD) ? std::error_condition() : load_zipped_file();
 			}
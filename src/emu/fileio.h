@@ -16,10 +16,15 @@
 #include "corefile.h"
 #include "hash.h"
 
+#include <chrono>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -119,6 +124,88 @@ private:
 
 
 
+// ======================> file_hash_cache
+
+// persistent record of file checksums, keyed by path and archive entry and
+// invalidated by a change in size or modification time
+class file_hash_cache
+{
+public:
+	// get the cache kept in the given directory, loading it on first use
+	static file_hash_cache &get(std::string_view directory);
+
+	file_hash_cache(file_hash_cache const &) = delete;
+	file_hash_cache &operator=(file_hash_cache const &) = delete;
+
+	// lookup and update; safe to call from any thread
+	bool find(std::string_view path, std::string_view entry, u64 size, s64 mtime, util::hash_collection &hashes);
+	void add(std::string_view path, std::string_view entry, u64 size, s64 mtime, util::hash_collection const &hashes);
+
+	// write out anything added since the last flush
+	void flush();
+
+private:
+	struct cache_entry
+	{
+		u64                     size;           // size of the file or archive
+		s64                     mtime;          // modification time of the file or archive
+		std::string             hashes;         // checksums in internal string format
+	};
+
+	file_hash_cache(std::string_view directory);
+
+	static std::string make_key(std::string_view path, std::string_view entry);
+
+	std::mutex                  m_mutex;        // guards everything below
+	std::string                 m_directory;    // where the cache file lives
+	std::map<std::string, cache_entry, std::less<> > m_entries; // entries keyed by path and archive entry
+	std::vector<std::string>    m_added;        // keys added or changed since the last flush
+	bool                        m_rewrite;      // does the file have enough stale lines to be rewritten?
+};
+
+
+
+// ======================> path_listing_cache
+
+// directory listings remembered so that opening a file doesn't have to probe
+// every directory and archive on every search path; listings are checked
+// against their directory's modification time once per generation
+class path_listing_cache
+{
+public:
+	// get the process-wide cache
+	static path_listing_cache &get();
+
+	path_listing_cache(path_listing_cache const &) = delete;
+	path_listing_cache &operator=(path_listing_cache const &) = delete;
+
+	// start a new generation, e.g. before loading or auditing a system
+	void revalidate();
+
+	// returns false only if the path certainly doesn't exist; safe to call from any thread
+	bool may_exist(std::string_view path);
+
+private:
+	struct listing
+	{
+		bool                    exists = false; // was the directory there?
+		std::chrono::system_clock::time_point mtime; // modification time when listed
+		unsigned                generation = 0; // generation it was last checked in
+		std::unordered_set<std::string> names;  // entries, folded to lowercase
+	};
+
+	path_listing_cache() : m_generation(1) { }
+
+	static std::string fold(std::string_view name);
+	static void read_listing(std::string const &directory, listing &result);
+
+	std::mutex                  m_mutex;        // guards everything below
+	unsigned                    m_generation;   // current generation
+	std::map<std::string, listing, std::less<> > m_listings; // listings keyed by directory
+};
+
+
+
 // ======================> emu_file
 
 class emu_file
@@ -146,6 +233,7 @@ public:
 	// getters
 	operator util::core_file &();
 	bool is_open() const { return bool(m_file); }
+	bool is_archived() const { return bool(m_zipfile) || !m_zipdata.empty(); }
 	const char *filename() const { return m_filename.c_str(); }
 	const char *fullpath() const { return m_fullpath.c_str(); }
 	u32 openflags() const { return m_openflags; }
@@ -155,6 +243,8 @@ public:
 	void remove_on_close() { m_remove_on_close = true; }
 	void set_openflags(u32 openflags) { assert(!m_file); m_openflags = openflags; }
 	void set_restrict_to_mediapath(int rtmp) { m_restrict_to_mediapath = rtmp; }
+	void set_hash_cache(file_hash_cache *cache) { m_hash_cache = cache; }
+	void set_path_cache(path_listing_cache *cache) { m_path_cache = cache; }
 
 	// open/close
 	std::error_condition open(std::string &&name);
@@ -216,6 +306,7 @@ private:
 	// internal helpers
 	std::error_condition attempt_zipped();
 	std::error_condition load_zipped_file();
+	bool hash_cache_stat(u64 &size, s64 &mtime) const;
 
 	// internal state
 	std::string             m_filename;             // original filename provided
@@ -234,6 +325,11 @@ private:
 
 	bool                    m_remove_on_close;      // flag: remove the file when closing
 	int                     m_restrict_to_mediapath; // flag: restrict to paths inside the media-path
+
+	file_hash_cache *       m_hash_cache;           // checksums remembered from earlier runs
+	std::string             m_hash_path;            // file or archive the checksums are cached against
+	std::string             m_hash_entry;           // archive entry name, or empty for plain files
+	path_listing_cache *    m_path_cache;           // directory listings to rule out missing files
 };
 
 
@@ -16,54 +16,239 @@
 #include "fileio.h"
 
 #include "hash.h"
+#include "multibyte.h"
+#include "path.h"
 
 #include <pugixml.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace {
 
 /*-------------------------------------------------
-    hashfile_lookup
+    hashfile_index - extra info from a hash file,
+    indexed by CRC so lookups don't search the
+    whole document
 -------------------------------------------------*/
 
-static bool read_hash_config(const char *hash_path, const util::hash_collection &hashes, const char *sysname, std::string &result)
+class hashfile_index
 {
-	/* open a file */
-	emu_file file(hash_path, OPEN_FLAG_READ);
+public:
+	// get the index for a system's hash file, or nullptr if it doesn't have one
+	static std::shared_ptr<hashfile_index const> get(emu_options const &options, const char *sysname);
+
+	// find extra info, preferring an entry that matches the SHA1 as well as the CRC
+	bool find(const util::hash_collection &hashes, std::string &result) const;
+
+private:
+	struct entry
+	{
+		std::string     sha1;
+		std::string     extrainfo;
+	};
+
+	static constexpr u8 MAGIC[8] = { 'M', 'H', 'S', 'I', 'I', 'D', 'X', 1 };
+
+	bool parse(const char *path);
+	bool load(std::string_view filename, std::string_view source, u64 size, s64 mtime);
+	void save(std::string_view filename, std::string_view source, u64 size, s64 mtime) const;
+
+	std::unordered_map<std::string, std::vector<entry> > m_entries; // keyed by CRC, in document order
+};
+
+
+std::shared_ptr<hashfile_index const> hashfile_index::get(emu_options const &options, const char *sysname)
+{
+	struct cached_index
+	{
+		u64                                     size;
+		s64                                     mtime;
+		std::shared_ptr<hashfile_index const>   index;
+	};
+	static std::mutex s_mutex;
+	static std::map<std::string, cached_index, std::less<> > s_indexes;
+
+	/* find the hash file */
+	emu_file file(options.hash_path(), OPEN_FLAG_READ);
 	if (file.open(std::string(sysname) + ".hsi"))
-		return false;
+		return nullptr;
+	std::string const path(file.fullpath());
+	std::unique_ptr<osd::directory::entry> const source(osd_stat(path));
+	if (!source)
+		return nullptr;
+	s64 const mtime = source->last_modified.time_since_epoch().count();
 
-	pugi::xml_document doc;
+	/* reuse the index if the file hasn't changed */
+	std::lock_guard<std::mutex> lock(s_mutex);
+	auto const found(s_indexes.find(path));
+	if ((s_indexes.end() != found) && (found->second.size == source->size) && (found->second.mtime == mtime))
+		return found->second.index;
 
-	pugi::xml_parse_result res = doc.load_file(file.fullpath());
-	if (res)
+	/* otherwise try the copy kept next to the software list indexes before parsing */
+	std::string indexname;
+	if (options.softlist_index() && path_iterator(options.cfg_directory()).next(indexname))
+		util::path_append(indexname, "softlist", std::string(sysname) + ".hsi.bin");
+	else
+		indexname.clear();
+	auto index(std::make_shared<hashfile_index>());
+	if (indexname.empty() || !index->load(indexname, path, source->size, mtime))
 	{
-		// Do search by CRC32 and SHA1
-		std::string query = "/hashfile/hash[";
-		auto crc = hashes.internal_string().substr(1,8);
-		auto sha1 = hashes.internal_string().substr(10, 40);
-		query += "@crc32='" + crc + "' and @sha1='" + sha1 + "']/extrainfo";
-		pugi::xpath_node_set tools = doc.select_nodes(query.c_str());
-		for (pugi::xpath_node_set::const_iterator it = tools.begin(); it != tools.end(); ++it)
+		index->m_entries.clear();
+		if (!index->parse(path.c_str()))
+			return nullptr;
+		if (!indexname.empty())
+			index->save(indexname, path, source->size, mtime);
+	}
+
+	return s_indexes.insert_or_assign(path, cached_index{ source->size, mtime, std::move(index) }).first->second.index;
+}
+
+
+bool hashfile_index::find(const util::hash_collection &hashes, std::string &result) const
+{
+	std::string const internal(hashes.internal_string());
+	auto const found(m_entries.find(internal.substr(1, 8)));
+	if (m_entries.end() == found)
+		return false;
+
+	// Do search by CRC32 and SHA1
+	std::string const sha1(internal.substr(10, 40));
+	for (entry const &candidate : found->second)
+	{
+		if (candidate.sha1 == sha1)
 		{
-			result = it->node().first_child().value();
+			result = candidate.extrainfo;
 			return true;
 		}
+	}
 
-		// Try search by CRC32 only
-		query = "/hashfile/hash[";
-		query += "@crc32='" + crc + "']/extrainfo";
-		tools = doc.select_nodes(query.c_str());
-		for (pugi::xpath_node_set::const_iterator it = tools.begin(); it != tools.end(); ++it)
+	// Try search by CRC32 only
+	result = found->second.front().extrainfo;
+	return true;
+}
+
+
+bool hashfile_index::parse(const char *path)
+{
+	pugi::xml_document doc;
+	if (!doc.load_file(path))
+		return false;
+
+	for (pugi::xml_node const hash : doc.child("hashfile").children("hash"))
+	{
+		pugi::xml_node const extrainfo(hash.child("extrainfo"));
+		if (extrainfo)
+			m_entries[hash.attribute("crc32").value()].emplace_back(entry{ hash.attribute("sha1").value(), extrainfo.first_child().value() });
+	}
+	return true;
+}
+
+
+bool hashfile_index::load(std::string_view filename, std::string_view source, u64 size, s64 mtime)
+{
+	std::vector<u8> data;
+	if (util::core_file::load(filename, data))
+		return false;
+
+	u8 const *ptr = data.data();
+	u8 const *const end = ptr + data.size();
+	bool valid = true;
+	auto const read_u32 =
+			[&ptr, end, &valid] () -> u32
+			{
+				if (!valid || ((end - ptr) < 4))
+				{
+					valid = false;
+					return 0;
+				}
+				ptr += 4;
+				return get_u32le(ptr - 4);
+			};
+	auto const read_string =
+			[&ptr, end, &valid, &read_u32] () -> std::string_view
+			{
+				u32 const length = read_u32();
+				if (!valid || (u32(end - ptr) < length))
+				{
+					valid = false;
+					return std::string_view();
+				}
+				ptr += length;
+				return std::string_view(reinterpret_cast<const char *>(ptr - length), length);
+			};
+
+	/* anything made from an older copy of the hash file is ignored */
+	if ((std::size_t(end - ptr) < sizeof(MAGIC)) || !std::equal(std::begin(MAGIC), std::end(MAGIC), ptr))
+		return false;
+	ptr += sizeof(MAGIC);
+	if ((read_string() != source) || !valid || ((end - ptr) < 16))
+		return false;
+	if ((get_u64le(ptr) != size) || (s64(get_u64le(ptr + 8)) != mtime))
+		return false;
+	ptr += 16;
+
+	for (u32 count = read_u32(); valid && count; --count)
+	{
+		std::string_view const crc = read_string();
+		std::string_view const sha1 = read_string();
+		std::string_view const extrainfo = read_string();
+		if (valid)
+			m_entries[std::string(crc)].emplace_back(entry{ std::string(sha1), std::string(extrainfo) });
+	}
+	return valid && (end == ptr);
+}
+
+
+void hashfile_index::save(std::string_view filename, std::string_view source, u64 size, s64 mtime) const
+{
+	std::vector<u8> buffer(std::begin(MAGIC), std::end(MAGIC));
+	auto const write_u32 =
+			[&buffer] (u32 value)
+			{
+				buffer.resize(buffer.size() + 4);
+				put_u32le(&buffer[buffer.size() - 4], value);
+			};
+	auto const write_string =
+			[&buffer, &write_u32] (std::string_view value)
+			{
+				write_u32(value.length());
+				buffer.insert(buffer.end(), value.begin(), value.end());
+			};
+
+	write_string(source);
+	buffer.resize(buffer.size() + 16);
+	put_u64le(&buffer[buffer.size() - 16], size);
+	put_u64le(&buffer[buffer.size() - 8], u64(mtime));
+	std::size_t const countpos = buffer.size();
+	write_u32(0);
+	u32 count = 0;
+	for (auto const &crc : m_entries)
+	{
+		for (entry const &candidate : crc.second)
 		{
-			result = it->node().first_child().value();
-			return true;
+			write_string(crc.first);
+			write_string(candidate.sha1);
+			write_string(candidate.extrainfo);
+			++count;
 		}
-
 	}
-	return false;
+	put_u32le(&buffer[countpos], count);
+
+	util::core_file::ptr file;
+	if (!util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file))
+		util::write(*file, buffer.data(), buffer.size());
 }
 
+} // anonymous namespace
+
 
-bool hashfile_extrainfo(const char *hash_path, const game_driver &driver, const util::hash_collection &hashes, std::string &result)
+bool hashfile_extrainfo(emu_options const &options, const game_driver &driver, const util::hash_collection &hashes, std::string &result)
 {
 	/* now read the hash file */
 	int drv = driver_list::find(driver);
@@ -71,7 +256,8 @@ bool hashfile_extrainfo(const char *hash_path, const game_driver &driver, const
 	bool hashfound;
 	do
 	{
-		hashfound = read_hash_config(hash_path, hashes, driver_list::driver(open).name, result);
+		std::shared_ptr<hashfile_index const> const index(hashfile_index::get(options, driver_list::driver(open).name));
+		hashfound = index && index->find(hashes, result);
 		// first check if there are compatible systems
 		compat = driver_list::compatible_with(open);
 		// if so, try to open its hashfile
@@ -94,7 +280,7 @@ bool hashfile_extrainfo(const char *hash_path, const game_driver &driver, const
 bool hashfile_extrainfo(device_image_interface &image, std::string &result)
 {
 	return hashfile_extrainfo(
-		image.device().mconfig().options().hash_path(),
+		image.device().mconfig().options(),
 		image.device().mconfig().gamedrv(),
 		image.hash(),
 		result);
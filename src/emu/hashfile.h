@@ -15,6 +15,6 @@
 
 
 bool hashfile_extrainfo(device_image_interface &image, std::string &result);
-bool hashfile_extrainfo(const char *hash_path, const game_driver &driver, const util::hash_collection &hashes, std::string &result);
+bool hashfile_extrainfo(emu_options const &options, const game_driver &driver, const util::hash_collection &hashes, std::string &result);
 
 #endif // MAME_EMU_HASHFILE_H
@@ -578,3 +578,10 @@ void http_manager::remove_endpoint(const std::string &path) {
 
 	m_endpoints.erase(path);
 }
+
+bool http_manager::post(std::function<void ()> &&work) {
+	if (!m_active) return false;
+
+	asio::post(*m_io_context, std::move(work));
+	return true;
+}
@@ -156,6 +156,9 @@ public:
 	/** Removes the websocket endpoint at the specified path. */
 	void remove_endpoint(const std::string &path);
 
+	/** Runs work on the server thread, so it can be done without holding up emulation; returns false if the server isn't running. */
+	bool post(std::function<void ()> &&work);
+
 	bool is_active() {
 		return m_active;
 	}
@@ -0,0 +1,330 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    idledet.cpp
+
+    Detection of CPU loops that spin without doing anything.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "idledet.h"
+
+#include <algorithm>
+
+
+//**************************************************************************
+//  IDLE LOOP DETECTOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  idle_loop_detector - constructor
+//-------------------------------------------------
+
+idle_loop_detector::idle_loop_detector(device_execute_interface &exec, device_state_interface &state, device_memory_interface &memory, bool report)
+	: m_exec(exec)
+	, m_state(state)
+	, m_memory(memory)
+	, m_report(report)
+	, m_phase(phase::COUNTING)
+	, m_target(0)
+	, m_count(0)
+	, m_spinning(nullptr)
+	, m_last_cycles(0)
+	, m_wrote(false)
+	, m_unbacked(false)
+	, m_taps(memory.max_space_count())
+{
+	// floating point registers don't fit in a u64 compare
+	for (auto const &entry : state.state_entries())
+	{
+		if (!entry->divider() && !entry->is_float())
+			m_registers.push_back(entry.get());
+	}
+	m_before.resize(m_registers.size());
+	m_after.resize(m_registers.size());
+	m_reads.reserve(MAX_READS);
+}
+
+
+//-------------------------------------------------
+//  ~idle_loop_detector - destructor
+//-------------------------------------------------
+
+idle_loop_detector::~idle_loop_detector()
+{
+	// any taps still installed go away with the address spaces
+}
+
+
+//-------------------------------------------------
+//  branch - note a backward branch, and skip the
+//  rest of the timeslice if it closes an idle
+//  loop
+//-------------------------------------------------
+
+void idle_loop_detector::branch(offs_t target)
+{
+	// in report mode, charge the cycles since the last branch to the loop being gone round
+	if (m_report)
+	{
+		u64 const now = m_exec.total_cycles();
+		if (m_spinning && (target == m_target))
+		{
+			m_spinning->cycles += now - m_last_cycles;
+			m_last_cycles = now;
+			return;
+		}
+		m_last_cycles = now;
+		m_spinning = nullptr;
+	}
+
+	// a different branch starts the count again
+	if (target != m_target)
+	{
+		if (m_phase == phase::WATCHING)
+			stop_watching();
+		m_target = target;
+		m_count = 0;
+		return;
+	}
+
+	if (m_phase == phase::COUNTING)
+	{
+		if (++m_count < CANDIDATE_THRESHOLD)
+			return;
+		m_count = 0;
+
+		// loops that keep failing aren't worth the taps
+		auto const failures = m_failures.find(target);
+		if (failures != m_failures.end() && failures->second >= MAX_FAILURES)
+			return;
+
+		// a known idle loop only needs checking against what it saw last time
+		snapshot(m_before);
+		auto const known = m_idle.find(target);
+		if (m_report && known != m_idle.end() && known->second.registers == m_before)
+		{
+			m_spinning = &known->second;
+			return;
+		}
+		if (!m_report && known != m_idle.end() && known->second.registers == m_before && unchanged(known->second))
+		{
+			idle();
+			return;
+		}
+
+		// otherwise watch the next iteration
+		start_watching();
+		return;
+	}
+
+	// the watched iteration is over
+	stop_watching();
+	snapshot(m_after);
+	if (!m_wrote && (m_report || !m_unbacked) && m_reads.size() <= MAX_READS && m_after == m_before)
+	{
+		if (m_idle.find(target) == m_idle.end())
+			osd_printf_verbose("%s: idle loop at %X\n", m_exec.device().tag(), target);
+		idle_loop &loop = m_idle[target];
+		loop.registers = m_after;
+		loop.reads = m_reads;
+		loop.end = m_state.pcbase();
+		loop.backed = !m_unbacked;
+		m_failures.erase(target);
+		if (m_report)
+			m_spinning = &loop;
+		else
+			idle();
+	}
+	else
+	{
+		// an interrupt may have got in the way, so allow a few attempts
+		m_failures[target]++;
+	}
+}
+
+
+//-------------------------------------------------
+//  candidates - list the loops found in report
+//  mode, most cycles first
+//-------------------------------------------------
+
+std::vector<idle_loop_detector::candidate> idle_loop_detector::candidates() const
+{
+	std::vector<candidate> result;
+	for (auto const &[target, loop] : m_idle)
+	{
+		if (!loop.cycles)
+			continue;
+
+		candidate &entry = result.emplace_back();
+		entry.start = target;
+		entry.end = std::max(loop.end, target);
+		entry.cycles = loop.cycles;
+		entry.backed = loop.backed;
+
+		// leave out the loop's own opcode fetches
+		for (read_record const &record : loop.reads)
+		{
+			address_space &space = *record.space;
+			if (space.spacenum() == AS_OPCODES)
+				continue;
+			if (space.spacenum() == AS_PROGRAM)
+			{
+				offs_t const byte = space.address_to_byte(record.address);
+				if (byte >= space.address_to_byte(entry.start) && byte <= (space.address_to_byte(entry.end) + FETCH_SLACK))
+					continue;
+			}
+
+			bool const seen = std::any_of(
+					entry.polls.begin(),
+					entry.polls.end(),
+					[&record] (poll const &p) { return (p.space == record.space) && (p.address == record.address); });
+			if (!seen)
+				entry.polls.push_back(poll{ record.space, record.address });
+		}
+	}
+
+	std::sort(
+			result.begin(),
+			result.end(),
+			[] (candidate const &a, candidate const &b) { return a.cycles > b.cycles; });
+	return result;
+}
+
+
+//-------------------------------------------------
+//  snapshot - collect the current register values
+//-------------------------------------------------
+
+void idle_loop_detector::snapshot(std::vector<u64> &values) const
+{
+	for (std::size_t i = 0; i < m_registers.size(); i++)
+		values[i] = m_registers[i]->value();
+}
+
+
+//-------------------------------------------------
+//  start_watching - install taps to record what
+//  the next iteration reads and writes
+//-------------------------------------------------
+
+void idle_loop_detector::start_watching()
+{
+	m_reads.clear();
+	m_wrote = false;
+	m_unbacked = false;
+	for (int spacenum = 0; spacenum < m_memory.max_space_count(); spacenum++)
+	{
+		if (!m_memory.has_space(spacenum))
+			continue;
+
+		// installing the taps thaws the space; keep it frozen if it was
+		address_space &space = m_memory.space(spacenum);
+		bool const frozen = space.frozen();
+		switch (space.data_width())
+		{
+		case  8: install_taps<u8>(space, m_taps[spacenum]); break;
+		case 16: install_taps<u16>(space, m_taps[spacenum]); break;
+		case 32: install_taps<u32>(space, m_taps[spacenum]); break;
+		case 64: install_taps<u64>(space, m_taps[spacenum]); break;
+		}
+		if (frozen)
+			space.freeze();
+	}
+	m_phase = phase::WATCHING;
+}
+
+
+//-------------------------------------------------
+//  stop_watching - remove the taps
+//-------------------------------------------------
+
+void idle_loop_detector::stop_watching()
+{
+	for (int spacenum = 0; spacenum < m_memory.max_space_count(); spacenum++)
+	{
+		if (!m_memory.has_space(spacenum))
+			continue;
+
+		address_space &space = m_memory.space(spacenum);
+		bool const frozen = space.frozen();
+		m_taps[spacenum].remove();
+		if (frozen)
+			space.freeze();
+	}
+	m_phase = phase::COUNTING;
+}
+
+
+//-------------------------------------------------
+//  install_taps - install read and write taps
+//  over a whole address space
+//-------------------------------------------------
+
+template <typename T>
+void idle_loop_detector::install_taps(address_space &space, memory_passthrough_handler &handler)
+{
+	handler = space.install_readwrite_tap(
+			0, space.addrmask(), "idle_loop_detector",
+			[this, &space] (offs_t offset, T &data, T mem_mask) { read(space, offset, data, mem_mask); },
+			[this] (offs_t offset, T &data, T mem_mask) { m_wrote = true; },
+			&handler);
+}
+
+
+//-------------------------------------------------
+//  read - record a read made by the watched
+//  iteration
+//-------------------------------------------------
+
+void idle_loop_detector::read(address_space &space, offs_t address, u64 data, u64 mem_mask)
+{
+	// the debugger and other observers don't count
+	if (m_exec.device().machine().side_effects_disabled())
+		return;
+
+	// anything but plain memory may change by itself
+	if (!space.get_read_ptr(address))
+		m_unbacked = true;
+	if (m_reads.size() <= MAX_READS)
+		m_reads.push_back(read_record{ &space, address, mem_mask, data });
+}
+
+
+//-------------------------------------------------
+//  unchanged - check whether memory still holds
+//  what a known idle loop read
+//-------------------------------------------------
+
+bool idle_loop_detector::unchanged(idle_loop const &loop) const
+{
+	auto dis = m_exec.device().machine().disable_side_effects();
+	for (read_record const &record : loop.reads)
+	{
+		u64 data;
+		switch (record.space->data_width())
+		{
+		case  8: data = record.space->read_byte(record.address); break;
+		case 16: data = record.space->read_word(record.address, u16(record.mem_mask)); break;
+		case 32: data = record.space->read_dword(record.address, u32(record.mem_mask)); break;
+		default: data = record.space->read_qword(record.address, record.mem_mask); break;
+		}
+		if ((data & record.mem_mask) != (record.data & record.mem_mask))
+			return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  idle - skip the rest of the timeslice
+//-------------------------------------------------
+
+void idle_loop_detector::idle()
+{
+	// the cycles count as executed; the loop would have spent them all the same
+	m_exec.eat_cycles(m_exec.cycles_remaining());
+}
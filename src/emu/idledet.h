@@ -0,0 +1,146 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    idledet.h
+
+    Detection of CPU loops that spin without doing anything.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef MAME_EMU_IDLEDET_H
+#define MAME_EMU_IDLEDET_H
+
+#include <unordered_map>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> idle_loop_detector
+
+// Cores opt in by calling idle_branch_hook() with the target of each
+// backward branch they take.  When the same branch keeps being taken,
+// one more iteration is watched through read and write taps on the
+// CPU's address spaces.  If that iteration wrote nothing, read only
+// memory-backed addresses, and left every register as it found it, each
+// later iteration will do exactly the same thing until another device
+// runs.  Nothing else runs until this CPU's timeslice ends, so the rest
+// of the timeslice is eaten as though the loop had run through it.
+//
+// A loop that passes is remembered along with its registers and the
+// values it read.  When it's reached again with the same registers and
+// memory still holding the same values, it's skipped without watching
+// it again.  A loop that fails a few times, which an interrupt landing in
+// the watched iteration can cause, is never watched again.
+//
+// In report mode nothing is skipped.  Loops that would pass (or that only
+// fail because they poll a device rather than memory) are kept as
+// candidates for per-driver spin loop hints, with the cycles spent
+// going round them.
+class idle_loop_detector
+{
+public:
+	// a place a candidate loop reads that isn't its own code
+	struct poll
+	{
+		address_space * space;
+		offs_t          address;
+	};
+
+	// a loop worth a spin loop hint
+	struct candidate
+	{
+		offs_t              start;                  // branch target
+		offs_t              end;                    // branch instruction
+		u64                 cycles;                 // cycles spent going round it
+		bool                backed;                 // reads only memory, so could be skipped
+		std::vector<poll>   polls;                  // data it reads each iteration
+	};
+
+	idle_loop_detector(device_execute_interface &exec, device_state_interface &state, device_memory_interface &memory, bool report);
+	~idle_loop_detector();
+
+	// called by the execute interface for each backward branch taken
+	void branch(offs_t target);
+
+	// report mode results, most cycles first
+	bool reporting() const { return m_report; }
+	std::vector<candidate> candidates() const;
+
+private:
+	// times a branch must be taken in a row before it's looked at
+	static constexpr u32 CANDIDATE_THRESHOLD = 16;
+
+	// reads an idle loop may make, including opcode fetches that go through the taps
+	static constexpr std::size_t MAX_READS = 64;
+
+	// times a loop may fail before it's given up on
+	static constexpr u8 MAX_FAILURES = 3;
+
+	// opcode fetches for the branch itself may run this many bytes past its address
+	static constexpr offs_t FETCH_SLACK = 16;
+
+	enum class phase { COUNTING, WATCHING };
+
+	// a read made by a watched iteration
+	struct read_record
+	{
+		address_space * space;
+		offs_t          address;
+		u64             mem_mask;
+		u64             data;
+	};
+
+	// a loop found to be idle
+	struct idle_loop
+	{
+		std::vector<u64>            registers;          // registers at the branch
+		std::vector<read_record>    reads;              // reads made by each iteration
+		offs_t                      end = 0;            // branch instruction, for reports
+		u64                         cycles = 0;         // cycles spent in it, in report mode
+		bool                        backed = true;      // all reads were plain memory
+	};
+
+	void snapshot(std::vector<u64> &values) const;
+	void start_watching();
+	void stop_watching();
+	template <typename T> void install_taps(address_space &space, memory_passthrough_handler &handler);
+	void read(address_space &space, offs_t address, u64 data, u64 mem_mask);
+	bool unchanged(idle_loop const &loop) const;
+	void idle();
+
+	device_execute_interface &      m_exec;             // CPU being watched
+	device_state_interface &        m_state;            // its registers
+	device_memory_interface &       m_memory;           // its address spaces
+	bool const                      m_report;           // gather candidates rather than skip
+	std::vector<device_state_entry const *> m_registers; // registers compared between iterations
+
+	phase                           m_phase;            // what we're doing with the current branch
+	offs_t                          m_target;           // target of the branch being counted
+	u32                             m_count;            // times it's been taken in a row
+	std::vector<u64>                m_before;           // registers at the start of the watched iteration
+	std::vector<u64>                m_after;            // registers at the end of it
+	idle_loop *                     m_spinning;         // loop being gone round, in report mode
+	u64                             m_last_cycles;      // cycle count at the last branch, in report mode
+
+	// watched iteration results
+	std::vector<read_record>        m_reads;            // reads made
+	bool                            m_wrote;            // something was written
+	bool                            m_unbacked;         // something read wasn't plain memory
+	std::vector<memory_passthrough_handler> m_taps;     // taps on each address space
+
+	// what's been learned about each branch target
+	std::unordered_map<offs_t, idle_loop> m_idle;       // loops found to be idle
+	std::unordered_map<offs_t, u8>  m_failures;         // failed attempts at other loops
+};
+
+#endif // MAME_EMU_IDLEDET_H
@@ -16,6 +16,7 @@
 #include "inputdev.h"
 #include "main.h"
 #include "natkeyboard.h"
+#include "netplay.h"
 #include "profiler.h"
 
 #include "ui/uimain.h"
@@ -1316,6 +1317,29 @@ void ioport_field::frame_update(ioport_value &result)
 }
 
 
+//-------------------------------------------------
+//  late_update - resample a digital field from
+//  the latest host input between frames
+//-------------------------------------------------
+
+void ioport_field::late_update(ioport_value &result)
+{
+	// only plain momentary switches can be resampled; anything that keeps per-frame
+	// state (analog, impulse, toggle, joystick restrictions, coin lockout) stays put
+	if (!enabled() || m_live->analog != nullptr || m_live->lockout || m_live->toggle || m_live->joystick != nullptr || m_impulse != 0)
+		return;
+	if (m_type >= IPT_COIN1 && m_type <= IPT_COIN12)
+		return;
+	if (machine().ui().is_menu_active())
+		return;
+
+	if (m_digital_value || machine().input().seq_pressed(seq()))
+		result |= m_mask;
+	else
+		result &= ~m_mask;
+}
+
+
 //-------------------------------------------------
 //  crosshair_read - compute the crosshair
 //  position
@@ -1514,7 +1538,9 @@ ioport_port::ioport_port(device_t &owner, const char *tag)
 		m_device(owner),
 		m_tag(tag),
 		m_modcount(0),
-		m_active(0)
+		m_active(0),
+		m_poll_serial(0),
+		m_read_count(0)
 {
 }
 
@@ -1574,6 +1600,14 @@ ioport_value ioport_port::read()
 	if (!manager().safe_to_read())
 		throw emu_fatalerror("Input ports cannot be read at init time!");
 
+	m_read_count++;
+
+	// pick up any host input that arrived since the digital state was sampled
+	ioport_manager &ioport = manager();
+	ioport.check_late_poll();
+	if (ioport.poll_serial() != m_poll_serial)
+		late_update();
+
 	// start with the digital state
 	ioport_value result = m_live->digital;
 
@@ -1614,6 +1648,7 @@ void ioport_port::frame_update()
 {
 	// start with 0 values for the digital bits
 	m_live->digital = 0;
+	m_poll_serial = manager().poll_serial();
 
 	// now loop back and modify based on the inputs
 	for (ioport_field &field : m_fieldlist)
@@ -1621,6 +1656,20 @@ void ioport_port::frame_update()
 }
 
 
+//-------------------------------------------------
+//  late_update - resample the digital state after
+//  a host input poll between frames
+//-------------------------------------------------
+
+void ioport_port::late_update()
+{
+	m_poll_serial = manager().poll_serial();
+
+	for (ioport_field &field : m_fieldlist)
+		field.late_update(m_live->digital);
+}
+
+
 //-------------------------------------------------
 //  collapse_fields - remove any fields that are
 //  wholly overlapped by other fields
@@ -1774,6 +1823,9 @@ ioport_manager::ioport_manager(running_machine &machine)
 	, m_safe_to_read(false)
 	, m_last_frame_time(attotime::zero)
 	, m_last_delta_nsec(0)
+	, m_late_poll_ticks(0)
+	, m_last_poll_ticks(0)
+	, m_poll_serial(0)
 	, m_playback_accumulated_speed(0)
 	, m_playback_accumulated_frames(0)
 	, m_deselected_card_config()
@@ -1798,6 +1850,11 @@ time_t ioport_manager::initialize()
 	// initialize the default port info from the OSD
 	init_port_types();
 
+	// host input older than this gets polled again when a port is read; netplay
+	// needs inputs to only change at frame boundaries where they're exchanged
+	if (!*machine().options().netplay_remotehost())
+		m_late_poll_ticks = osd_ticks_per_second() * std::clamp(machine().options().late_input(), 0, 100) / 1000;
+
 	// if we have a token list, proceed
 	device_enumerator iter(machine().root_device());
 	for (device_t &device : iter)
@@ -2167,6 +2224,10 @@ void ioport_manager::frame_update()
 	m_last_delta_nsec = (curtime - m_last_frame_time).as_attoseconds() / ATTOSECONDS_PER_NANOSECOND;
 	m_last_frame_time = curtime;
 
+	// the OSD polled host input just before this callback
+	m_last_poll_ticks = osd_ticks();
+	m_poll_serial++;
+
 	// update the digital joysticks
 	for (digital_joystick &joystick : m_joystick_list)
 		joystick.frame_update();
@@ -2179,6 +2240,9 @@ void ioport_manager::frame_update()
 		port.second->update_defvalue(false);
 
 	// loop over all input ports
+	netplay_manager *const netplay = machine().netplay();
+	if (netplay)
+		netplay->begin_frame();
 	for (auto &port : m_portlist)
 	{
 		port.second->frame_update();
@@ -2187,12 +2251,39 @@ void ioport_manager::frame_update()
 		playback_port(*port.second.get());
 		record_port(*port.second.get());
 
+		// mix in the other netplay side's inputs
+		if (netplay)
+			netplay->update_port(*port.second.get());
+
 		// call device line write handlers
 		ioport_value newvalue = port.second->read();
 		for (dynamic_field &dynfield : port.second->live().writelist)
 			if (dynfield.field().type() != IPT_OUTPUT)
 				dynfield.write(newvalue);
 	}
+	if (netplay)
+		netplay->end_frame();
+}
+
+
+//-------------------------------------------------
+//  late_poll - poll host input again if it has
+//  gone stale since the last frame
+//-------------------------------------------------
+
+void ioport_manager::late_poll()
+{
+	// recordings and playback have to see exactly one sample per frame
+	if (m_record_stream || m_playback_stream || machine().paused())
+		return;
+
+	osd_ticks_t const now = osd_ticks();
+	if (now - m_last_poll_ticks < m_late_poll_ticks)
+		return;
+
+	machine().osd().input_update(false);
+	m_last_poll_ticks = now;
+	m_poll_serial++;
 }
 
 
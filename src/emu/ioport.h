@@ -646,6 +646,7 @@ public:
 	float crosshair_read() const;
 	void init_live_state(analog_field *analog);
 	void frame_update(ioport_value &result);
+	void late_update(ioport_value &result);
 	void reduce_mask(ioport_value bits_to_remove) { m_mask &= ~bits_to_remove; }
 
 	// user-controllable settings for a field
@@ -772,6 +773,7 @@ public:
 	int modcount() const { return m_modcount; }
 	ioport_value active() const { return m_active; }
 	ioport_port_live &live() const { assert(m_live != nullptr); return *m_live; }
+	u32 read_count() const { return m_read_count; }
 
 	// read/write to the port
 	ioport_value read();
@@ -781,6 +783,7 @@ public:
 	ioport_field *field(ioport_value mask) const;
 	void collapse_fields(std::string &errorbuf);
 	void frame_update();
+	void late_update();
 	void init_live_state();
 	void update_defvalue(bool flush_defaults);
 
@@ -795,6 +798,8 @@ private:
 	int                         m_modcount;     // modification count
 	ioport_value                m_active;       // mask of active bits in the port
 	std::unique_ptr<ioport_port_live> m_live;      // live state of port (nullptr if not live)
+	u32                         m_poll_serial;  // host input poll the digital state was last sampled from
+	u32                         m_read_count;   // number of times the port has been read
 };
 
 
@@ -941,6 +946,10 @@ public:
 	running_machine &machine() const noexcept { return m_machine; }
 	const ioport_list &ports() const noexcept { return m_portlist; }
 	bool safe_to_read() const noexcept { return m_safe_to_read; }
+	u32 poll_serial() const noexcept { return m_poll_serial; }
+
+	// late input polling
+	void check_late_poll() { if (m_late_poll_ticks != 0) late_poll(); }
 
 	// type helpers
 	const std::vector<input_type_entry> &types() const noexcept { return m_typelist; }
@@ -966,6 +975,7 @@ private:
 
 	void frame_update_callback();
 	void frame_update();
+	void late_poll();
 
 	ioport_port *port(const std::string &tag) const { auto search = m_portlist.find(tag); if (search != m_portlist.end()) return search->second.get(); else return nullptr; }
 	void exit();
@@ -1012,6 +1022,11 @@ private:
 	attotime                m_last_frame_time;      // time of the last frame callback
 	attoseconds_t           m_last_delta_nsec;      // nanoseconds that passed since the previous callback
 
+	// late input polling
+	osd_ticks_t             m_late_poll_ticks;      // minimum age of host input before a port read polls again (0 = disabled)
+	osd_ticks_t             m_last_poll_ticks;      // osd_ticks of the last host input poll
+	u32                     m_poll_serial;          // incremented on every host input poll
+
 	// playback/record information
 	std::unique_ptr<emu_file> m_record_file;        // recording file (nullptr if not recording)
 	std::unique_ptr<emu_file> m_playback_file;      // playback file (nullptr if not recording)
@@ -19,12 +19,18 @@
 #include "emuopts.h"
 #include "fileio.h"
 #include "http.h"
+#include "idledet.h"
 #include "image.h"
 #include "main.h"
+#include "memheat.h"
 #include "natkeyboard.h"
+#include "netplay.h"
 #include "network.h"
+#include "remotectl.h"
 #include "render.h"
 #include "romload.h"
+#include "screen.h"
+#include "statehash.h"
 #include "tilemap.h"
 #include "uiinput.h"
 
@@ -35,10 +41,12 @@
 
 #include "osdepend.h"
 
+#include <rapidjson/document.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 
 #include <ctime>
+#include <map>
 
 #if defined(__EMSCRIPTEN__)
 #include <emscripten.h>
@@ -73,6 +81,11 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 	, m_rand_seed(0x9d14abd7)
 	, m_basename(_config.gamedrv().name)
 	, m_sample_rate(_config.options().sample_rate())
+	, m_bench_interval(attotime::zero)
+	, m_bench_next(attotime::zero)
+	, m_bench_ticks(0)
+	, m_bench_frames(0)
+	, m_bench_regressed(false)
 	, m_saveload_schedule(saveload_schedule::NONE)
 	, m_saveload_schedule_time(attotime::zero)
 	, m_saveload_searchpath(nullptr)
@@ -147,16 +160,64 @@ void running_machine::start()
 	// allocate a soft_reset timer
 	m_soft_reset_timer = m_scheduler.timer_alloc(timer_expired_delegate(FUNC(running_machine::soft_reset), this));
 
+	// gather scheduler statistics if requested; they can also be turned on from Lua later, so the report is always registered
+	add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&device_scheduler::report_stats, &m_scheduler));
+	if (options().sched_stats())
+		m_scheduler.set_stats_enabled(true);
+
+	// idle loop reports charge host time to loops by their share of each CPU's cycles
+	if (options().idle_report())
+	{
+		m_scheduler.gather_stats();
+		add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&running_machine::write_idle_report, this));
+	}
+
+	// startup tracing ends at the first frame (or on exit if that never comes)
+	if (g_startup_trace.enabled())
+	{
+		add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&startup_trace::finish, &g_startup_trace));
+		add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&startup_trace::finish, &g_startup_trace));
+	}
+
+	// record a runtime timeline if requested
+	if (*options().profile_trace())
+	{
+		g_runtime_trace.enable(true);
+		add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&running_machine::write_profile_trace, this));
+	}
+
+	// the benchmark report includes a profiler breakdown where it's available
+	if (*options().bench_report() || *options().bench_baseline())
+	{
+		g_profiler.enable(true, unsigned(options().profile_sample()));
+		add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&running_machine::write_bench_report, this));
+
+		// sample at fixed emulated intervals so runs of the same input line up
+		if (options().bench_interval() > 0.0f)
+		{
+			m_bench_interval = attotime::from_double(options().bench_interval());
+			m_bench_next = m_bench_interval;
+			m_bench_ticks = osd_ticks();
+			add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&running_machine::bench_sample, this));
+		}
+	}
+
 	// initialize UI input
 	m_ui_input = std::make_unique<ui_input_manager>(*this);
 
 	// init the OSD layer
-	m_manager.osd().init(*this);
+	{
+		auto const trace(g_startup_trace.phase("machine", "initialize OSD"));
+		m_manager.osd().init(*this);
+	}
 
 	// create the video manager and UI manager
-	m_video = std::make_unique<video_manager>(*this);
-	m_ui = manager().create_ui(*this);
-	m_ui->set_startup_text("Initializing...", true);
+	{
+		auto const trace(g_startup_trace.phase("machine", "create video and UI"));
+		m_video = std::make_unique<video_manager>(*this);
+		m_ui = manager().create_ui(*this);
+		m_ui->set_startup_text("Initializing...", true);
+	}
 
 	// initialize the base time (needed for doing record/playback)
 	::time(&m_base_time);
@@ -164,15 +225,21 @@ void running_machine::start()
 	// initialize the input system and input ports for the game
 	// this must be done before memory_init in order to allow specifying
 	// callbacks based on input port tags
-	time_t newbase = m_ioport.initialize();
-	if (newbase != 0)
-		m_base_time = newbase;
+	{
+		auto const trace(g_startup_trace.phase("machine", "initialize I/O ports"));
+		time_t newbase = m_ioport.initialize();
+		if (newbase != 0)
+			m_base_time = newbase;
+	}
 
 	// initialize natural keyboard support after ports have been initialized
 	m_natkeyboard = std::make_unique<natural_keyboard>(*this);
 
 	// initialize the streams engine before the sound devices start
-	m_sound = std::make_unique<sound_manager>(*this);
+	{
+		auto const trace(g_startup_trace.phase("machine", "create sound manager"));
+		m_sound = std::make_unique<sound_manager>(*this);
+	}
 
 	// resolve objects that can be used by memory maps
 	for (device_t &device : device_enumerator(root_device()))
@@ -183,14 +250,23 @@ void running_machine::start()
 	// needs rom bases), and finally initialize CPUs (which needs
 	// complete address spaces).  These operations must proceed in this
 	// order
-	m_rom_load = std::make_unique<rom_load_manager>(*this);
-	m_memory.initialize();
+	{
+		auto const trace(g_startup_trace.phase("rom", "load ROMs"));
+		m_rom_load = std::make_unique<rom_load_manager>(*this);
+	}
+	{
+		auto const trace(g_startup_trace.phase("machine", "initialize memory"));
+		m_memory.initialize();
+	}
 
 	// save the random seed or save states might be broken in drivers that use the rand() method
 	save().save_item(NAME(m_rand_seed));
 
 	// initialize image devices
-	m_image = std::make_unique<image_manager>(*this);
+	{
+		auto const trace(g_startup_trace.phase("machine", "create image manager"));
+		m_image = std::make_unique<image_manager>(*this);
+	}
 	m_tilemap = std::make_unique<tilemap_manager>(*this);
 	m_crosshair = std::make_unique<crosshair_manager>(*this);
 	m_network = std::make_unique<network_manager>(*this);
@@ -212,7 +288,10 @@ void running_machine::start()
 	add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(&running_machine::reset_all_devices, this));
 	add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&running_machine::stop_all_devices, this));
 	save().register_presave(save_prepost_delegate(FUNC(running_machine::presave_all_devices), this));
-	start_all_devices();
+	{
+		auto const trace(g_startup_trace.phase("machine", "start devices"));
+		start_all_devices();
+	}
 	save().register_postload(save_prepost_delegate(FUNC(running_machine::postload_all_devices), this));
 
 	// save outputs created before start time
@@ -232,6 +311,10 @@ void running_machine::start()
 	if (filename[0] != 0 && !m_video->is_recording())
 		m_video->begin_recording(filename, movie_recording::format::AVI);
 
+	// exchange inputs with another instance if requested
+	if (*options().netplay_remotehost())
+		m_netplay = std::make_unique<netplay_manager>(*this);
+
 	// if we're coming in with a savegame request, process it now
 	const char *savegame = options().state();
 	if (savegame[0] != 0)
@@ -282,19 +365,35 @@ int running_machine::run(bool quiet)
 		}
 
 		// then finish setting up our local machine
-		start();
+		{
+			auto const trace(g_startup_trace.phase("machine", "start machine"));
+			start();
+		}
 
 		// load the configuration settings
-		manager().before_load_settings(*this);
-		m_configuration->load_settings();
+		{
+			auto const trace(g_startup_trace.phase("machine", "load settings"));
+			manager().before_load_settings(*this);
+			m_configuration->load_settings();
+		}
 
 		// disallow save state registrations starting here.
 		// Don't do it earlier, config load can create network
 		// devices with timers.
 		m_save.allow_registration(false);
 
+		// hash the state for determinism checks once every entry is known
+		if (options().state_hash())
+			m_state_hasher = std::make_unique<state_hasher>(*this);
+
+		// memory access counting taps every address space, so it waits for the maps too
+		m_heatmap = std::make_unique<memory_heatmap>(*this);
+
 		// load the NVRAM
-		nvram_load();
+		{
+			auto const trace(g_startup_trace.phase("machine", "load NVRAM"));
+			nvram_load();
+		}
 
 		// set the time on RTCs (this may overwrite parts of NVRAM)
 		set_rtc_datetime(system_time(m_base_time));
@@ -307,10 +406,16 @@ int running_machine::run(bool quiet)
 
 		// initialize ui lists
 		// display the startup screens
-		manager().ui_initialize(*this);
+		{
+			auto const trace(g_startup_trace.phase("machine", "initialize UI"));
+			manager().ui_initialize(*this);
+		}
 
 		// perform a soft reset -- this takes us to the running phase
-		soft_reset();
+		{
+			auto const trace(g_startup_trace.phase("machine", "reset"));
+			soft_reset();
+		}
 
 		// handle initial load
 		if (m_saveload_schedule != saveload_schedule::NONE)
@@ -335,10 +440,22 @@ int running_machine::run(bool quiet)
 			else
 				m_video->frame_update();
 
+			// emulate ahead of a committed frame if requested
+			if (m_video->runahead_pending())
+				run_ahead();
+
+			// save the state for netplay and roll back mispredicted frames
+			if (m_netplay && m_netplay->frame_pending())
+				m_netplay->frame_boundary();
+
 			// handle save/load
 			if (m_saveload_schedule != saveload_schedule::NONE)
-				handle_saveload();
+				handle_saveload(true);
+
+			// report background saves once they've been written
+			finish_async_save(false);
 		}
+		finish_async_save(true);
 		m_manager.http()->clear();
 
 		// and out via the exit phase
@@ -391,6 +508,10 @@ int running_machine::run(bool quiet)
 	call_notifiers(MACHINE_NOTIFY_EXIT);
 	util::archive_file::cache_clear();
 
+	// a run that was slower than its baseline fails
+	if ((EMU_ERR_NONE == error) && m_bench_regressed)
+		error = EMU_ERR_PERFORMANCE;
+
 	// close the logfile
 	m_logfile.reset();
 	return error;
@@ -857,7 +978,7 @@ void running_machine::call_notifiers(machine_notification which)
 //  or load
 //-------------------------------------------------
 
-void running_machine::handle_saveload()
+void running_machine::handle_saveload(bool allow_async)
 {
 	// if no name, bail
 	if (!m_saveload_pending_file.empty())
@@ -865,6 +986,9 @@ void running_machine::handle_saveload()
 		const char *const opname = (m_saveload_schedule == saveload_schedule::LOAD) ? "load" : "save";
 		const char *const preposname = (m_saveload_schedule == saveload_schedule::LOAD) ? "from" : "to";
 
+		// let a background save land first, we might be about to read it back
+		finish_async_save(true);
+
 		// if there are anonymous timers, we can't save just yet, and we can't load yet either
 		// because the timers might overwrite data we have loaded
 		if (!m_scheduler.can_save())
@@ -880,46 +1004,28 @@ void running_machine::handle_saveload()
 			u32 const openflags = (m_saveload_schedule == saveload_schedule::LOAD) ? OPEN_FLAG_READ : (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
 
 			// open the file
-			emu_file file(m_saveload_searchpath ? m_saveload_searchpath : "", openflags);
-			auto const filerr = file.open(m_saveload_pending_file);
+			auto file = std::make_unique<emu_file>(m_saveload_searchpath ? m_saveload_searchpath : "", openflags);
+			auto const filerr = file->open(m_saveload_pending_file);
 			if (!filerr)
 			{
-				// read/write the save state
-				save_error saverr = (m_saveload_schedule == saveload_schedule::LOAD) ? m_save.read_file(file) : m_save.write_file(file);
-
-				// handle the result
-				switch (saverr)
+				save_error saverr;
+				if (allow_async && (m_saveload_schedule == saveload_schedule::SAVE) && options().async_save())
 				{
-				case STATERR_INVALID_HEADER:
-					popmessage("Error: Unable to %s state %s %s due to an invalid header. Make sure the save state is correct for this system.", opname, preposname, m_saveload_pending_file);
-					break;
-
-				case STATERR_READ_ERROR:
-					popmessage("Error: Unable to %s state %s %s due to a read error (file is likely corrupt).", opname, preposname, m_saveload_pending_file);
-					break;
-
-				case STATERR_WRITE_ERROR:
-					popmessage("Error: Unable to %s state %s %s due to a write error. Verify there is enough disk space.", opname, preposname, m_saveload_pending_file);
-					break;
-
-				case STATERR_NONE:
-				{
-					const char *const opnamed = (m_saveload_schedule == saveload_schedule::LOAD) ? "Loaded" : "Saved";
-					if (!(m_system.flags & MACHINE_SUPPORTS_SAVE))
-						popmessage("%s state %s %s.\nWarning: Save states are not officially supported for this system.", opnamed, preposname, m_saveload_pending_file);
-					else
-						popmessage("%s state %s %s.", opnamed, preposname, m_saveload_pending_file);
-					break;
+					// only the capture happens here, the result is reported when the write lands
+					saverr = m_save.write_file_async(std::move(file), std::string(m_saveload_pending_file));
+					if (saverr != STATERR_NONE)
+						report_saveload(m_saveload_schedule, saverr, m_saveload_pending_file);
 				}
-
-				default:
-					popmessage("Error: Unknown error during %s state %s %s.", opname, preposname, m_saveload_pending_file);
-					break;
+				else
+				{
+					// read/write the save state
+					saverr = (m_saveload_schedule == saveload_schedule::LOAD) ? m_save.read_file(*file) : m_save.write_file(*file);
+					report_saveload(m_saveload_schedule, saverr, m_saveload_pending_file);
 				}
 
 				// close and perhaps delete the file
-				if (saverr != STATERR_NONE && m_saveload_schedule == saveload_schedule::SAVE)
-					file.remove_on_close();
+				if (file && saverr != STATERR_NONE && m_saveload_schedule == saveload_schedule::SAVE)
+					file->remove_on_close();
 			}
 			else if ((openflags == OPEN_FLAG_READ) && (std::errc::no_such_file_or_directory == filerr))
 			{
@@ -940,6 +1046,96 @@ void running_machine::handle_saveload()
 }
 
 
+//-------------------------------------------------
+//  run_ahead - snapshot the committed timeline,
+//  emulate the speculative frames (the last of
+//  which gets displayed) and roll back
+//-------------------------------------------------
+
+void running_machine::run_ahead()
+{
+	if (!m_runahead_state)
+		m_runahead_state = std::make_unique<ram_state>(m_save);
+	if (m_runahead_state->save() != STATERR_NONE)
+	{
+		m_video->end_runahead();
+		return;
+	}
+
+	// inputs aren't polled during speculative frames, so they play out with
+	// what was just read; anything they output is thrown away
+	m_sound->set_speculative(true);
+	m_video->begin_runahead();
+	while (m_video->runahead_active() && !m_exit_pending && !m_hard_reset_pending)
+		m_scheduler.timeslice();
+
+	m_runahead_state->load();
+	m_video->end_runahead();
+	m_sound->set_speculative(false);
+}
+
+
+//-------------------------------------------------
+//  report_saveload - pop up the outcome of a
+//  save or load
+//-------------------------------------------------
+
+void running_machine::report_saveload(saveload_schedule operation, save_error saverr, std::string_view filename)
+{
+	const char *const opname = (operation == saveload_schedule::LOAD) ? "load" : "save";
+	const char *const preposname = (operation == saveload_schedule::LOAD) ? "from" : "to";
+
+	switch (saverr)
+	{
+	case STATERR_INVALID_HEADER:
+		popmessage("Error: Unable to %s state %s %s due to an invalid header. Make sure the save state is correct for this system.", opname, preposname, filename);
+		break;
+
+	case STATERR_READ_ERROR:
+		popmessage("Error: Unable to %s state %s %s due to a read error (file is likely corrupt).", opname, preposname, filename);
+		break;
+
+	case STATERR_WRITE_ERROR:
+		popmessage("Error: Unable to %s state %s %s due to a write error. Verify there is enough disk space.", opname, preposname, filename);
+		break;
+
+	case STATERR_NONE:
+	{
+		const char *const opnamed = (operation == saveload_schedule::LOAD) ? "Loaded" : "Saved";
+		if (!(m_system.flags & MACHINE_SUPPORTS_SAVE))
+			popmessage("%s state %s %s.\nWarning: Save states are not officially supported for this system.", opnamed, preposname, filename);
+		else
+			popmessage("%s state %s %s.", opnamed, preposname, filename);
+		break;
+	}
+
+	default:
+		popmessage("Error: Unknown error during %s state %s %s.", opname, preposname, filename);
+		break;
+	}
+}
+
+
+//-------------------------------------------------
+//  finish_async_save - report a background save
+//  once it has been written, optionally waiting
+//  for it
+//-------------------------------------------------
+
+void running_machine::finish_async_save(bool wait)
+{
+	if (!m_save.async_pending())
+		return;
+	if (wait)
+		m_save.wait_async();
+
+	save_error saverr;
+	std::string filename;
+	if (m_save.async_complete(saverr, filename))
+		report_saveload(saveload_schedule::SAVE, saverr, filename);
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
@@ -955,6 +1151,13 @@ void running_machine::soft_reset(s32 param)
 	// call all registered reset callbacks
 	call_notifiers(MACHINE_NOTIFY_RESET);
 
+	// any remapping done by reset handlers is in place now, so let spaces
+	// with plain memory build their direct tables; later changes thaw them
+	for (device_memory_interface &memory : memory_interface_enumerator(root_device()))
+		for (int spacenum = 0; spacenum < memory.max_space_count(); spacenum++)
+			if (memory.has_space(spacenum))
+				memory.space(spacenum).freeze();
+
 	// now we're running
 	m_current_phase = machine_phase::RUNNING;
 }
@@ -1010,6 +1213,7 @@ void running_machine::start_all_devices()
 
 					// now start the device
 					osd_printf_verbose("Starting %s '%s'\n", device.name(), device.tag());
+					auto const trace(g_startup_trace.phase("device", "%s '%s'", device.name(), device.tag()));
 					device.start();
 				}
 				catch (device_missing_dependencies const &)
@@ -1041,6 +1245,257 @@ void running_machine::reset_all_devices()
 }
 
 
+//-------------------------------------------------
+//  write_profile_trace - write and stop the
+//  runtime timeline at exit
+//-------------------------------------------------
+
+void running_machine::write_profile_trace()
+{
+	g_runtime_trace.enable(false);
+	g_runtime_trace.write(*this, options().profile_trace());
+}
+
+
+//-------------------------------------------------
+//  write_idle_report - list the loops each CPU
+//  spent the most time spinning in at exit
+//-------------------------------------------------
+
+void running_machine::write_idle_report()
+{
+	static constexpr std::size_t MAX_REPORTED = 10;
+
+	osd_printf_info("Idle loop candidates after %s seconds\n", time().as_string(3));
+	for (device_execute_interface &exec : execute_interface_enumerator(root_device()))
+	{
+		idle_loop_detector const *const detector = exec.idle_detector();
+		if (!detector)
+			continue;
+
+		auto const candidates = detector->candidates();
+		if (candidates.empty())
+		{
+			osd_printf_info("  %s: none found\n", exec.device().tag());
+			continue;
+		}
+
+		u64 const executed = exec.stat_cycles_executed();
+		double const host = double(exec.stat_host_ticks()) / double(osd_ticks_per_second());
+		osd_printf_info("  %s: %.3f host seconds executing\n", exec.device().tag(), host);
+		osd_printf_info("    %-17s %14s %7s %8s  %s\n", "range", "cycles", "share", "host s", "polls");
+		for (std::size_t i = 0; (candidates.size() > i) && (MAX_REPORTED > i); i++)
+		{
+			idle_loop_detector::candidate const &candidate = candidates[i];
+			double const share = executed ? (double(candidate.cycles) / double(executed)) : 0.0;
+			std::string polls;
+			for (idle_loop_detector::poll const &poll : candidate.polls)
+				polls += util::string_format(" %s:%X", poll.space->name(), poll.address);
+			if (!candidate.backed)
+				polls += " (device)";
+			osd_printf_info(
+					"    %08X-%08X %14u %6.2f%% %8.3f %s\n",
+					candidate.start,
+					candidate.end,
+					candidate.cycles,
+					100.0 * share,
+					host * share,
+					polls.empty() ? " -" : polls);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  bench_sample - record real time, frames and
+//  profiler counts each time emulated time
+//  passes a sampling interval
+//-------------------------------------------------
+
+void running_machine::bench_sample()
+{
+	attotime const now(time());
+	if (now < m_bench_next)
+		return;
+
+	// samples are labelled with the interval boundary, not the frame that crossed it
+	osd_ticks_t const ticks(osd_ticks());
+	screen_device *const screen(screen_device_enumerator(root_device()).first());
+	u64 const frames(screen ? screen->frame_number() : 0);
+	m_bench_samples.emplace_back(bench_sample_item{
+			m_bench_next.as_double(),
+			double(ticks - m_bench_ticks) / double(osd_ticks_per_second()),
+			frames - m_bench_frames,
+			g_profiler.counts(*this) });
+	m_bench_ticks = ticks;
+	m_bench_frames = frames;
+	while (m_bench_next <= now)
+		m_bench_next += m_bench_interval;
+}
+
+
+//-------------------------------------------------
+//  write_bench_report - write speed, profiler and
+//  memory figures at exit in a form scripts can
+//  compare between revisions
+//-------------------------------------------------
+
+void running_machine::write_bench_report()
+{
+	// speed is measured once emulation settles, like the average speed message
+	double const emulated(m_video->overall_emulated_time().as_double());
+	double const real(m_video->overall_real_time());
+
+	rapidjson::StringBuffer s;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+	writer.StartObject();
+	writer.Key("system");
+	writer.String(m_basename.c_str());
+	writer.Key("software");
+	writer.String(options().software_name().c_str());
+	writer.Key("build");
+	writer.String(emulator_info::get_build_version());
+	writer.Key("total_emulated_seconds");
+	writer.Double(time().as_double());
+	writer.Key("emulated_seconds");
+	writer.Double(emulated);
+	writer.Key("real_seconds");
+	writer.Double(real);
+	writer.Key("speed");
+	writer.Double((real > 0.0) ? (emulated / real) : 0.0);
+
+	// empty unless built with the profiler
+	writer.Key("profile");
+	writer.StartArray();
+	for (auto const &[name, share] : g_profiler.breakdown(*this))
+	{
+		writer.StartObject();
+		writer.Key("scope");
+		writer.String(name.c_str());
+		writer.Key("share");
+		writer.Double(share);
+		writer.EndObject();
+	}
+	writer.EndArray();
+
+	writer.Key("peak_memory_bytes");
+	writer.Uint64(osd_get_peak_memory_usage());
+
+	// per-interval samples, with the profiler counts turned into shares of the interval
+	writer.Key("samples");
+	writer.StartArray();
+	std::map<std::string, u64> previous;
+	for (bench_sample_item const &sample : m_bench_samples)
+	{
+		writer.StartObject();
+		writer.Key("emulated_seconds");
+		writer.Double(sample.emulated);
+		writer.Key("real_seconds");
+		writer.Double(sample.real);
+		writer.Key("frames");
+		writer.Uint64(sample.frames);
+
+		std::vector<std::pair<std::string const *, u64> > deltas;
+		u64 total = 0;
+		for (auto const &[name, count] : sample.counts)
+		{
+			u64 &last(previous[name]);
+			u64 const delta((count >= last) ? (count - last) : count);
+			last = count;
+			if (delta)
+			{
+				deltas.emplace_back(&name, delta);
+				total += delta;
+			}
+		}
+		writer.Key("profile");
+		writer.StartArray();
+		for (auto const &[name, delta] : deltas)
+		{
+			writer.StartObject();
+			writer.Key("scope");
+			writer.String(name->c_str());
+			writer.Key("share");
+			writer.Double(double(delta) / double(total));
+			writer.EndObject();
+		}
+		writer.EndArray();
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	if (*options().bench_report())
+	{
+		util::core_file::ptr file;
+		std::string_view const text(s.GetString(), s.GetSize());
+		if (util::core_file::open(options().bench_report(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) || util::write(*file, text.data(), text.size()).first)
+			osd_printf_error("Error writing benchmark report %s\n", options().bench_report());
+	}
+
+	if (*options().bench_baseline())
+		compare_bench_baseline(real);
+}
+
+
+//-------------------------------------------------
+//  compare_bench_baseline - check the real time
+//  taken overall and by each sample against a
+//  previous benchmark report
+//-------------------------------------------------
+
+void running_machine::compare_bench_baseline(double real)
+{
+	std::vector<u8> data;
+	rapidjson::Document baseline;
+	if (util::core_file::load(options().bench_baseline(), data))
+	{
+		osd_printf_error("Error reading benchmark baseline %s\n", options().bench_baseline());
+		m_bench_regressed = true;
+		return;
+	}
+	baseline.Parse(reinterpret_cast<char const *>(data.data()), data.size());
+	if (baseline.HasParseError() || !baseline.IsObject())
+	{
+		osd_printf_error("Error parsing benchmark baseline %s\n", options().bench_baseline());
+		m_bench_regressed = true;
+		return;
+	}
+
+	// real time may exceed the baseline by the threshold before failing
+	double const limit(1.0 + (options().bench_threshold() / 100.0));
+	auto const check =
+			[this, limit] (char const *what, double actual, double expected)
+			{
+				if ((expected > 0.0) && (actual > (expected * limit)))
+				{
+					osd_printf_error("Performance regression: %s took %.3f seconds, baseline %.3f seconds (%+.1f%%)\n", what, actual, expected, ((actual / expected) - 1.0) * 100.0);
+					m_bench_regressed = true;
+				}
+			};
+
+	auto const total(baseline.FindMember("real_seconds"));
+	if ((baseline.MemberEnd() != total) && total->value.IsNumber())
+		check("run", real, total->value.GetDouble());
+
+	auto const samples(baseline.FindMember("samples"));
+	if ((baseline.MemberEnd() != samples) && samples->value.IsArray())
+	{
+		auto const &expected(samples->value);
+		if (expected.Size() != m_bench_samples.size())
+			osd_printf_warning("Benchmark baseline has %u samples, this run has %u\n", expected.Size(), unsigned(m_bench_samples.size()));
+		for (rapidjson::SizeType i = 0; (i < expected.Size()) && (i < m_bench_samples.size()); ++i)
+		{
+			if (!expected[i].IsObject())
+				continue;
+			auto const seconds(expected[i].FindMember("real_seconds"));
+			if ((expected[i].MemberEnd() != seconds) && seconds->value.IsNumber())
+				check(string_format("interval ending at %g emulated seconds", m_bench_samples[i].emulated).c_str(), m_bench_samples[i].real, seconds->value.GetDouble());
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  stop_all_devices - stop all the devices in the
 //  hierarchy
@@ -1240,6 +1695,8 @@ void running_machine::export_http_api()
 			response->set_content_type("application/json");
 			response->set_body(s.GetString());
 		});
+
+		m_remote = std::make_unique<remote_control>(*this, *m_manager.http());
 	}
 }
 
@@ -128,6 +128,8 @@ public:
 	sound_manager &sound() const { assert(m_sound != nullptr); return *m_sound; }
 	video_manager &video() const { assert(m_video != nullptr); return *m_video; }
 	network_manager &network() const { assert(m_network != nullptr); return *m_network; }
+	netplay_manager *netplay() const { return m_netplay.get(); }
+	memory_heatmap &heatmap() const { assert(m_heatmap != nullptr); return *m_heatmap; }
 	bookkeeping_manager &bookkeeping() const { assert(m_bookkeeping != nullptr); return *m_bookkeeping; }
 	configuration_manager  &configuration() const { assert(m_configuration != nullptr); return *m_configuration; }
 	output_manager  &output() const { assert(m_output != nullptr); return *m_output; }
@@ -245,7 +247,9 @@ private:
 	template <typename T> struct is_null<T *> { template <typename U> static bool value(U &&x) { return !x; } };
 	void start();
 	void set_saveload_filename(std::string &&filename);
-	void handle_saveload();
+	void handle_saveload(bool allow_async = false);
+	void finish_async_save(bool wait);
+	void run_ahead();
 	void soft_reset(s32 param = 0);
 	std::string nvram_filename(device_t &device) const;
 	void nvram_load();
@@ -260,6 +264,11 @@ private:
 	void start_all_devices();
 	void reset_all_devices();
 	void stop_all_devices();
+	void write_profile_trace();
+	void bench_sample();
+	void write_bench_report();
+	void write_idle_report();
+	void compare_bench_baseline(double real);
 	void presave_all_devices();
 	void postload_all_devices();
 
@@ -277,6 +286,9 @@ private:
 	std::unique_ptr<tilemap_manager> m_tilemap;        // internal data from tilemap.cpp
 	std::unique_ptr<debug_view_manager> m_debug_view;  // internal data from debugvw.cpp
 	std::unique_ptr<network_manager> m_network;        // internal data from network.cpp
+	std::unique_ptr<netplay_manager> m_netplay;        // internal data from netplay.cpp
+	std::unique_ptr<state_hasher> m_state_hasher;      // internal data from statehash.cpp
+	std::unique_ptr<memory_heatmap> m_heatmap;         // internal data from memheat.cpp
 	std::unique_ptr<bookkeeping_manager> m_bookkeeping;// internal data from bookkeeping.cpp
 	std::unique_ptr<configuration_manager> m_configuration; // internal data from config.cpp
 	std::unique_ptr<output_manager> m_output;          // internal data from output.cpp
@@ -285,6 +297,7 @@ private:
 	std::unique_ptr<rom_load_manager> m_rom_load;      // internal data from romload.cpp
 	std::unique_ptr<debugger_manager> m_debugger;      // internal data from debugger.cpp
 	std::unique_ptr<natural_keyboard> m_natkeyboard;   // internal data from natkeyboard.cpp
+	std::unique_ptr<remote_control> m_remote;          // internal data from remotectl.cpp
 
 	// system state
 	machine_phase           m_current_phase;        // current execution phase
@@ -301,6 +314,21 @@ private:
 	std::unique_ptr<emu_file>  m_logfile;           // pointer to the active error.log file
 	std::unique_ptr<emu_file>  m_debuglogfile;      // pointer to the active debug.log file
 
+	// benchmark samples taken at fixed emulated time intervals
+	struct bench_sample_item
+	{
+		double                                      emulated;   // emulated time at the end of the interval
+		double                                      real;       // real seconds taken by the interval
+		u64                                         frames;     // frames completed in the interval
+		std::vector<std::pair<std::string, u64> >   counts;     // profiler counts at the end of the interval
+	};
+	std::vector<bench_sample_item> m_bench_samples;
+	attotime                m_bench_interval;       // emulated time between samples
+	attotime                m_bench_next;           // emulated time of the next sample
+	osd_ticks_t             m_bench_ticks;          // real time of the previous sample
+	u64                     m_bench_frames;         // frames completed at the previous sample
+	bool                    m_bench_regressed;      // did the run exceed the baseline?
+
 	// load/save management
 	enum class saveload_schedule
 	{
@@ -313,6 +341,8 @@ private:
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
 
+	void report_saveload(saveload_schedule operation, save_error saverr, std::string_view filename);
+
 	// notifier callbacks
 	struct notifier_callback_item
 	{
@@ -342,6 +372,7 @@ private:
 	ioport_manager          m_ioport;               // I/O port manager
 	parameters_manager      m_parameters;           // parameters manager
 	device_scheduler        m_scheduler;            // scheduler object
+	std::unique_ptr<ram_state> m_runahead_state;    // committed state while running ahead
 
 	// string formatting buffer
 	mutable util::ovectorstream m_string_buffer;
@@ -32,6 +32,7 @@ constexpr int EMU_ERR_INVALID_CONFIG   = 6;    // some sort of error in configur
 constexpr int EMU_ERR_IDENT_NONROMS    = 7;    // identified all non-ROM files
 constexpr int EMU_ERR_IDENT_PARTIAL    = 8;    // identified some files but not all
 constexpr int EMU_ERR_IDENT_NONE       = 9;    // identified no files
+constexpr int EMU_ERR_PERFORMANCE      = 10;   // slower than the benchmark baseline
 
 
 //**************************************************************************
@@ -46,6 +46,7 @@ machine_config::machine_config(const game_driver &gamedrv, emu_options &options)
 	, m_current_device(nullptr)
 	, m_maximum_quantums([] (char const *a, char const *b) { return 0 > std::strcmp(a, b); })
 	, m_perfect_quantum_device(nullptr, "")
+	, m_tag_index_ready(false)
 {
 	// add the root device
 	device_add("root", gamedrv.type, 0);
@@ -107,6 +108,10 @@ machine_config::machine_config(const game_driver &gamedrv, emu_options &options)
 	for (device_t &device : device_enumerator(root_device()))
 		if (!device.configured())
 			device.config_complete();
+
+	// from here on, lookups that aren't for a direct child go straight to the index
+	index_devices(root_device());
+	m_tag_index_ready = true;
 }
 
 
@@ -237,6 +242,8 @@ device_t *machine_config::device_remove(const char *tag)
 
 		// remove references to the old device
 		remove_references(*device);
+		if (m_tag_index_ready)
+			unindex_devices(*device);
 
 		// let the device's owner do the work
 		owner->subdevices().remove(*device);
@@ -314,6 +321,8 @@ device_t &machine_config::add_device(std::unique_ptr<device_t> &&device, device_
 		// allocate the new device and append it to the owner's list
 		device_t &result(owner->subdevices().append(std::move(device)));
 		result.add_machine_configuration(*this);
+		if (m_tag_index_ready)
+			index_devices(result);
 		return result;
 	}
 	else
@@ -335,14 +344,43 @@ device_t &machine_config::add_device(std::unique_ptr<device_t> &&device, device_
 device_t &machine_config::replace_device(std::unique_ptr<device_t> &&device, device_t &owner, device_t *existing)
 {
 	current_device_stack const context(*this);
+	if (existing && m_tag_index_ready)
+		unindex_devices(*existing);
 	device_t &result(existing
 			? owner.subdevices().replace_and_remove(std::move(device), *existing)
 			: owner.subdevices().append(std::move(device)));
 	result.add_machine_configuration(*this);
+	if (m_tag_index_ready)
+		index_devices(result);
 	return result;
 }
 
 
+//-------------------------------------------------
+//  index_devices - add a device and everything
+//  under it to the tag index
+//-------------------------------------------------
+
+void machine_config::index_devices(device_t &device)
+{
+	for (device_t &dev : device_enumerator(device))
+		m_tag_index.emplace(dev.tag(), &dev);
+}
+
+
+//-------------------------------------------------
+//  unindex_devices - drop a device about to be
+//  removed and everything under it from the tag
+//  index
+//-------------------------------------------------
+
+void machine_config::unindex_devices(device_t &device)
+{
+	for (device_t &dev : device_enumerator(device))
+		m_tag_index.erase(dev.tag());
+}
+
+
 //-------------------------------------------------
 //  remove_references - globally remove references
 //  to a device about to be removed from the tree
@@ -14,9 +14,11 @@
 #include <cassert>
 #include <map>
 #include <memory>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
 #include <utility>
 
 
@@ -114,6 +116,14 @@ public:
 	attotime maximum_quantum(attotime const &default_quantum) const;
 	device_execute_interface *perfect_quantum_device() const;
 
+	// lookup by absolute tag, available once the configuration is complete
+	bool tag_index_ready() const { return m_tag_index_ready; }
+	device_t *indexed_device(std::string_view fulltag) const
+	{
+		auto const found = m_tag_index.find(fulltag);
+		return (found != m_tag_index.end()) ? found->second : nullptr;
+	}
+
 	/// \brief Apply visitor to internal layouts
 	///
 	/// Calls the supplied visitor for each device with an internal
@@ -238,6 +248,8 @@ private:
 	device_t &replace_device(std::unique_ptr<device_t> &&device, device_t &owner, device_t *existing);
 	void remove_references(device_t &device);
 	void set_perfect_quantum(device_t &device, std::string tag);
+	void index_devices(device_t &device);
+	void unindex_devices(device_t &device);
 
 	// internal state
 	game_driver const &                 m_gamedrv;
@@ -247,6 +259,8 @@ private:
 	device_t *                          m_current_device;
 	maximum_quantum_map                 m_maximum_quantums;
 	std::pair<device_t *, std::string>  m_perfect_quantum_device;
+	std::unordered_map<std::string_view, device_t *> m_tag_index; // every device by absolute tag, keyed on its own tag string
+	bool                                m_tag_index_ready;
 };
 
 #endif // MAME_EMU_MCONFIG_H
@@ -0,0 +1,346 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    memheat.cpp
+
+    Counting of memory accesses per page and per handler.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "memheat.h"
+
+#include "emuopts.h"
+
+#include "corefile.h"
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <map>
+
+
+//**************************************************************************
+//  MEMORY HEATMAP
+//**************************************************************************
+
+//-------------------------------------------------
+//  memory_heatmap - constructor
+//-------------------------------------------------
+
+memory_heatmap::memory_heatmap(running_machine &machine)
+	: m_machine(machine)
+	, m_running(false)
+	, m_page_bits(DEFAULT_PAGE_BITS)
+	, m_accessors(1, nullptr)
+	, m_last_accessor(nullptr)
+	, m_last_index(0)
+{
+	if (*machine.options().memory_heatmap())
+	{
+		start(DEFAULT_PAGE_BITS);
+		machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&memory_heatmap::exit, this));
+	}
+}
+
+
+//-------------------------------------------------
+//  ~memory_heatmap - destructor
+//-------------------------------------------------
+
+memory_heatmap::~memory_heatmap()
+{
+	// any taps still installed go away with the address spaces
+}
+
+
+//-------------------------------------------------
+//  start - discard previous counts and tap every
+//  address space
+//-------------------------------------------------
+
+void memory_heatmap::start(int page_bits)
+{
+	stop();
+	m_spaces.clear();
+	m_accessors.assign(1, nullptr);
+	m_last_accessor = nullptr;
+	m_last_index = 0;
+	m_page_bits = page_bits;
+
+	// the taps keep pointers to their slots, so the list mustn't grow once they're installed
+	std::vector<address_space *> spaces;
+	for (device_memory_interface &memory : memory_interface_enumerator(machine().root_device()))
+	{
+		for (int spacenum = 0; spacenum < memory.max_space_count(); spacenum++)
+		{
+			if (memory.has_space(spacenum))
+				spaces.push_back(&memory.space(spacenum));
+		}
+	}
+	m_spaces.resize(spaces.size());
+	for (std::size_t i = 0; spaces.size() > i; i++)
+	{
+		space_counts &target = m_spaces[i];
+		target.space = spaces[i];
+
+		// installing the taps thaws the space; keep it frozen if it was
+		bool const frozen = target.space->frozen();
+		switch (target.space->data_width())
+		{
+		case  8: install_taps<u8>(target); break;
+		case 16: install_taps<u16>(target); break;
+		case 32: install_taps<u32>(target); break;
+		case 64: install_taps<u64>(target); break;
+		}
+		if (frozen)
+			target.space->freeze();
+	}
+	m_running = true;
+}
+
+
+//-------------------------------------------------
+//  stop - remove the taps, keeping the counts
+//-------------------------------------------------
+
+void memory_heatmap::stop()
+{
+	if (!m_running)
+		return;
+
+	for (space_counts &target : m_spaces)
+	{
+		bool const frozen = target.space->frozen();
+		target.tap.remove();
+		if (frozen)
+			target.space->freeze();
+	}
+	m_running = false;
+}
+
+
+//-------------------------------------------------
+//  install_taps - count reads and writes over a
+//  whole address space
+//-------------------------------------------------
+
+template <typename T>
+void memory_heatmap::install_taps(space_counts &target)
+{
+	target.tap = target.space->install_readwrite_tap(
+			0, target.space->addrmask(), "memory_heatmap",
+			[this, &target] (offs_t offset, T &data, T mem_mask)
+			{
+				// the debugger and other observers don't count
+				if (!machine().side_effects_disabled())
+					find(target, offset).reads++;
+			},
+			[this, &target] (offs_t offset, T &data, T mem_mask)
+			{
+				if (!machine().side_effects_disabled())
+					find(target, offset).writes++;
+			},
+			&target.tap);
+}
+
+
+//-------------------------------------------------
+//  find - get the counts for the page holding an
+//  address as seen by the executing device
+//-------------------------------------------------
+
+memory_heatmap::counts &memory_heatmap::find(space_counts &target, offs_t address)
+{
+	device_execute_interface *const exec = machine().scheduler().currently_executing();
+	device_t *const accessor = exec ? &exec->device() : nullptr;
+	if (accessor != m_last_accessor)
+	{
+		auto found = std::find(m_accessors.begin(), m_accessors.end(), accessor);
+		if (found == m_accessors.end())
+			found = m_accessors.insert(m_accessors.end(), accessor);
+		m_last_accessor = accessor;
+		m_last_index = u64(found - m_accessors.begin()) << 32;
+	}
+	return target.pages[m_last_index | (target.space->address_to_byte(address) >> m_page_bits)];
+}
+
+
+//-------------------------------------------------
+//  pages - list the pages accessed, most
+//  accessed first
+//-------------------------------------------------
+
+std::vector<memory_heatmap::page> memory_heatmap::pages() const
+{
+	std::vector<page> result;
+	for (space_counts const &source : m_spaces)
+	{
+		address_space &space = *source.space;
+		for (auto const &[key, count] : source.pages)
+		{
+			offs_t const byte = offs_t(key & 0xffffffffU) << m_page_bits;
+			offs_t const end = std::min<offs_t>(space.byte_to_address_end(byte + (offs_t(1) << m_page_bits) - 1), space.addrmask());
+			result.push_back(page{ &space, m_accessors[key >> 32], space.byte_to_address(byte), end, count });
+		}
+	}
+
+	std::sort(
+			result.begin(),
+			result.end(),
+			[] (page const &a, page const &b) { return (a.count.reads + a.count.writes) > (b.count.reads + b.count.writes); });
+	return result;
+}
+
+
+//-------------------------------------------------
+//  handlers - charge each page to the handler
+//  mapped at its first address and list the
+//  handlers accessed, most accessed first
+//-------------------------------------------------
+
+std::vector<memory_heatmap::handler> memory_heatmap::handlers() const
+{
+	std::vector<handler> result;
+	for (space_counts const &source : m_spaces)
+	{
+		address_space &space = *source.space;
+		std::vector<memory_entry> maps[2];
+		space.dump_maps(maps[0], maps[1]);
+
+		// views can map several handlers over the same range; the first one listed gets the count
+		std::map<std::pair<int, handler_entry *>, handler> found;
+		auto const charge =
+				[&space, &maps, &found] (int mode, offs_t address, u64 count)
+				{
+					if (!count)
+						return;
+					std::vector<memory_entry> const &map = maps[mode];
+					auto entry = std::find_if(
+							map.begin(),
+							map.end(),
+							[address] (memory_entry const &e) { return (e.start <= address) && (e.end >= address); });
+					if (entry == map.end())
+						return;
+
+					auto const ins = found.emplace(std::make_pair(mode, entry->entry), handler{ &space, entry->entry->name(), entry->start, entry->end, counts() });
+					if (mode)
+						ins.first->second.count.writes += count;
+					else
+						ins.first->second.count.reads += count;
+				};
+		for (auto const &[key, count] : source.pages)
+		{
+			offs_t const address = space.byte_to_address(offs_t(key & 0xffffffffU) << m_page_bits);
+			charge(0, address, count.reads);
+			charge(1, address, count.writes);
+		}
+
+		for (auto &entry : found)
+			result.push_back(std::move(entry.second));
+	}
+
+	std::sort(
+			result.begin(),
+			result.end(),
+			[] (handler const &a, handler const &b) { return (a.count.reads + a.count.writes) > (b.count.reads + b.count.writes); });
+	return result;
+}
+
+
+//-------------------------------------------------
+//  write_json - write the pages and handlers to
+//  a file
+//-------------------------------------------------
+
+bool memory_heatmap::write_json(const char *filename) const
+{
+	rapidjson::StringBuffer s;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+	auto const write_space =
+			[&writer] (address_space const &space)
+			{
+				writer.Key("device");
+				writer.String(space.device().tag());
+				writer.Key("space");
+				writer.String(space.name());
+			};
+	auto const write_counts =
+			[&writer] (counts const &count)
+			{
+				writer.Key("reads");
+				writer.Uint64(count.reads);
+				writer.Key("writes");
+				writer.Uint64(count.writes);
+			};
+
+	writer.StartObject();
+	writer.Key("system");
+	writer.String(machine().basename().c_str());
+	writer.Key("emulated_seconds");
+	writer.Double(machine().time().as_double());
+	writer.Key("page_bytes");
+	writer.Uint(1U << m_page_bits);
+
+	writer.Key("pages");
+	writer.StartArray();
+	for (page const &p : pages())
+	{
+		writer.StartObject();
+		write_space(*p.space);
+		writer.Key("accessor");
+		if (p.accessor)
+			writer.String(p.accessor->tag());
+		else
+			writer.Null();
+		writer.Key("start");
+		writer.Uint(p.start);
+		writer.Key("end");
+		writer.Uint(p.end);
+		write_counts(p.count);
+		writer.EndObject();
+	}
+	writer.EndArray();
+
+	writer.Key("handlers");
+	writer.StartArray();
+	for (handler const &h : handlers())
+	{
+		writer.StartObject();
+		write_space(*h.space);
+		writer.Key("name");
+		writer.String(h.name.c_str());
+		writer.Key("start");
+		writer.Uint(h.start);
+		writer.Key("end");
+		writer.Uint(h.end);
+		write_counts(h.count);
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	util::core_file::ptr file;
+	std::error_condition const filerr = util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file);
+	if (filerr)
+	{
+		osd_printf_error("Error opening memory heatmap %s (%s)\n", filename, filerr.message());
+		return false;
+	}
+	file->puts(s.GetString());
+	return true;
+}
+
+
+//-------------------------------------------------
+//  exit - write the counts gathered with
+//  -memheatmap
+//-------------------------------------------------
+
+void memory_heatmap::exit()
+{
+	stop();
+	write_json(machine().options().memory_heatmap());
+}
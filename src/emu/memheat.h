@@ -0,0 +1,102 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    memheat.h
+
+    Counting of memory accesses per page and per handler.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_MEMHEAT_H
+#define MAME_EMU_MEMHEAT_H
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// ======================> memory_heatmap
+
+// counts reads and writes to every address space through taps, per page
+// and per device that was executing when the access was made; counts per
+// handler are worked out from the pages when reported, charging each page
+// to the handler mapped at its first address
+class memory_heatmap
+{
+	DISABLE_COPYING(memory_heatmap);
+
+public:
+	// reads and writes to a page, or to a handler
+	struct counts
+	{
+		u64         reads = 0;
+		u64         writes = 0;
+	};
+
+	// a page in an address space, as accessed by one device
+	struct page
+	{
+		address_space * space;
+		device_t *      accessor;                   // device executing at the time, or nullptr
+		offs_t          start;                      // first address in the page
+		offs_t          end;                        // last address in the page
+		counts          count;
+	};
+
+	// a handler, with the accesses to the pages charged to it
+	struct handler
+	{
+		address_space * space;
+		std::string     name;
+		offs_t          start;                      // mapped range
+		offs_t          end;
+		counts          count;
+	};
+
+	static constexpr int DEFAULT_PAGE_BITS = 8;
+
+	// construction/destruction
+	memory_heatmap(running_machine &machine);
+	~memory_heatmap();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	bool running() const { return m_running; }
+	int page_bits() const { return m_page_bits; }
+
+	// control
+	void start(int page_bits);
+	void stop();
+
+	// results, most accessed first
+	std::vector<page> pages() const;
+	std::vector<handler> handlers() const;
+	bool write_json(const char *filename) const;
+
+private:
+	// counts for one address space
+	struct space_counts
+	{
+		address_space *                 space;
+		memory_passthrough_handler      tap;
+		std::unordered_map<u64, counts> pages;      // keyed on page number and accessor index
+	};
+
+	template <typename T> void install_taps(space_counts &target);
+	counts &find(space_counts &target, offs_t address);
+	void exit();
+
+	// internal state
+	running_machine &               m_machine;          // reference to our machine
+	bool                            m_running;          // counting in progress
+	int                             m_page_bits;        // log2 of the bytes per page
+	std::vector<space_counts>       m_spaces;           // counts for every address space
+	std::vector<device_t *>         m_accessors;        // devices seen executing, by index
+	device_t *                      m_last_accessor;    // most recent accessor, to skip the search
+	u64                             m_last_index;       // its index, shifted into the key
+};
+
+#endif // MAME_EMU_MEMHEAT_H
@@ -37,6 +37,13 @@
 const int KEY_BUFFER_SIZE = 4096;
 const char32_t INVALID_CHAR = '?';
 
+// a port read this many times since a key changed is taken to have been scanned
+// (most keyboard handlers debounce over two scans)
+const u32 SCAN_READS = 3;
+
+// how often to look for the keyboard scan catching up when pasting fast
+const attotime FAST_POLL_PERIOD = attotime::from_usec(500);
+
 
 
 //**************************************************************************
@@ -336,6 +343,8 @@ natural_keyboard::natural_keyboard(running_machine &machine)
 	, m_last_cr(false)
 	, m_timer(nullptr)
 	, m_current_rate(attotime::zero)
+	, m_fast_paste(machine.options().fast_paste())
+	, m_step_deadline(attotime::zero)
 	, m_queue_chars()
 	, m_accept_char()
 	, m_charqueue_empty()
@@ -831,9 +840,10 @@ attotime natural_keyboard::choose_delay(char32_t ch)
 	if (m_current_rate != attotime::zero)
 		return m_current_rate;
 
-	// systems with queue_chars can afford a much smaller delay
+	// systems with queue_chars can afford a much smaller delay, and refuse
+	// characters they have no room for
 	if (!m_queue_chars.isnull())
-		return attotime::from_msec(10);
+		return fast_paste() ? FAST_POLL_PERIOD : attotime::from_msec(10);
 
 	// otherwise, default to constant delay with a longer delay on CR
 	return attotime::from_msec((ch == '\r') ? 200 : 50);
@@ -852,6 +862,7 @@ void natural_keyboard::internal_post(char32_t ch)
 		m_timer->adjust(choose_delay(ch));
 		m_fieldnum = 0;
 		m_status_keydown = false;
+		m_scan_watch.clear();
 	}
 
 	// add to the buffer, resizing if necessary
@@ -883,6 +894,17 @@ void natural_keyboard::timer(s32 param)
 	{
 		// the driver does not have a queue_chars handler
 
+		// when pasting fast, hold each step until the keyboard scan has seen it
+		if (!m_scan_watch.empty())
+		{
+			if (!scan_caught_up() && (machine().time() < m_step_deadline))
+			{
+				m_timer->adjust(FAST_POLL_PERIOD);
+				return;
+			}
+			m_scan_watch.clear();
+		}
+
 		// loop through this character's component codes
 		if (!m_fieldnum)
 			m_current_code = find_code(m_buffer[m_bufbegin]);
@@ -897,9 +919,15 @@ void natural_keyboard::timer(s32 param)
 				{
 					// special handling for toggle fields
 					if (!field->live().toggle)
+					{
 						field->set_value(!m_status_keydown);
+						if (fast_paste())
+							watch_scan(*field);
+					}
 					else if (!m_status_keydown)
+					{
 						field->set_value(!field->digital_value());
+					}
 				}
 			}
 			while (code.field[m_fieldnum] && (++m_fieldnum < code.field.size()) && m_status_keydown);
@@ -921,9 +949,57 @@ void natural_keyboard::timer(s32 param)
 		}
 	}
 
-	// need to make sure timerproc is called again if buffer not empty
+	// need to make sure timerproc is called again if buffer not empty; if the
+	// keyboard scan is being watched, the usual delay is only the fallback
 	if (!empty())
-		m_timer->adjust(choose_delay(m_buffer[m_bufbegin]));
+	{
+		attotime const delay = choose_delay(m_buffer[m_bufbegin]);
+		if (!m_scan_watch.empty())
+		{
+			m_step_deadline = machine().time() + delay;
+			m_timer->adjust(FAST_POLL_PERIOD);
+		}
+		else
+		{
+			m_timer->adjust(delay);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  watch_scan - make a key change visible to
+//  port reads now rather than at the next frame,
+//  and remember its port to see when it's read
+//-------------------------------------------------
+
+void natural_keyboard::watch_scan(ioport_field &field)
+{
+	ioport_port &port = field.port();
+	port.late_update();
+	for (auto const &watch : m_scan_watch)
+	{
+		if (watch.first == &port)
+			return;
+	}
+	m_scan_watch.emplace_back(&port, port.read_count());
+}
+
+
+//-------------------------------------------------
+//  scan_caught_up - see whether every port
+//  changed by the last step has been read often
+//  enough for the keyboard scan to notice
+//-------------------------------------------------
+
+bool natural_keyboard::scan_caught_up() const
+{
+	for (auto const &watch : m_scan_watch)
+	{
+		if ((watch.first->read_count() - watch.second) < SCAN_READS)
+			return false;
+	}
+	return true;
 }
 
 
@@ -18,6 +18,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 
@@ -109,6 +110,9 @@ private:
 	bool can_post_directly(char32_t ch);
 	bool can_post_alternate(char32_t ch);
 	attotime choose_delay(char32_t ch);
+	bool fast_paste() const { return m_fast_paste && (m_current_rate == attotime::zero); }
+	void watch_scan(ioport_field &field);
+	bool scan_caught_up() const;
 	void internal_post(char32_t ch);
 	void timer(s32 param);
 	std::string unicode_to_string(char32_t ch) const;
@@ -128,6 +132,9 @@ private:
 	bool                            m_last_cr;          // was the last char a CR?
 	emu_timer *                     m_timer;            // timer for posting characters
 	attotime                        m_current_rate;     // current rate for posting
+	bool                            m_fast_paste;       // post keys as soon as the keyboard scan has seen the last one?
+	attotime                        m_step_deadline;    // when to move on regardless of the keyboard scan
+	std::vector<std::pair<ioport_port *, u32> > m_scan_watch; // ports changed by the last step, and their read counts
 	ioport_queue_chars_delegate     m_queue_chars;      // queue characters callback
 	ioport_accept_char_delegate     m_accept_char;      // accept character callback
 	ioport_charqueue_empty_delegate m_charqueue_empty;  // character queue empty callback
@@ -0,0 +1,513 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    netplay.cpp
+
+    Rollback netplay between two instances over UDP.
+
+    Each side owns part of the machine's digital inputs (side 1 gets
+    player 2's controls, side 0 gets everything else) and sends what it
+    pressed for every frame, resending anything the peer hasn't
+    acknowledged yet.  Frames run with a guess at the peer's inputs when
+    they haven't arrived; a state is saved at every frame boundary, and
+    when a guess turns out wrong the machine is loaded back to the first
+    bad frame and emulated forward again without display or sound.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "netplay.h"
+
+#include "emuopts.h"
+
+#include "asio.h"
+
+#include "multibyte.h"
+
+#include <algorithm>
+#include <locale>
+#include <sstream>
+
+
+namespace {
+
+// packet layout: magic, first frame, first frame of the peer's inputs we
+// still lack, port count, frame count, sender's side, then the inputs
+constexpr u32 PACKET_MAGIC = 0x4c504e4d; // 'MNPL'
+constexpr size_t PACKET_HEADER = 16;
+
+} // anonymous namespace
+
+
+//**************************************************************************
+//  NETPLAY CONTEXT
+//**************************************************************************
+
+class netplay_manager::context
+{
+public:
+	context() : m_socket(m_ioctx) { }
+
+	asio::io_context m_ioctx;
+	asio::ip::udp::socket m_socket;
+	asio::ip::udp::endpoint m_remote;
+};
+
+
+//**************************************************************************
+//  NETPLAY MANAGER
+//**************************************************************************
+
+//-------------------------------------------------
+//  netplay_manager - constructor
+//-------------------------------------------------
+
+netplay_manager::netplay_manager(running_machine &machine)
+	: m_machine(machine)
+	, m_active(false)
+	, m_frame_pending(false)
+	, m_heard(false)
+	, m_side(0)
+	, m_delay(0)
+	, m_last_heard(osd_ticks())
+	, m_port_index(0)
+	, m_frame(-1)
+	, m_confirmed(-1)
+	, m_peer_ack(0)
+	, m_rollback(-1)
+	, m_chunk_bytes(0)
+{
+	std::fill(std::begin(m_state_frame), std::end(m_state_frame), -1);
+
+	auto const &opts = machine.options();
+	m_side = std::clamp(opts.netplay_player(), 1, 2) - 1;
+	m_delay = std::clamp(opts.netplay_delay(), 0, int(MAX_DELAY));
+
+	if (!(machine.system().flags & MACHINE_SUPPORTS_SAVE))
+		osd_printf_warning("Netplay: this system does not officially support save states, rollback may desynchronize.\n");
+
+	// resolve the peer's address
+	std::error_code err;
+	std::istringstream parsestr;
+	parsestr.imbue(std::locale::classic());
+
+	asio::ip::address const connaddr = asio::ip::make_address(opts.netplay_remotehost(), err);
+	if (err)
+	{
+		osd_printf_error("Netplay: invalid remote address %s, disabling netplay.\n", opts.netplay_remotehost());
+		return;
+	}
+
+	parsestr.str(opts.netplay_remoteport());
+	parsestr.seekg(0, std::ios_base::beg);
+	asio::ip::port_type connport;
+	parsestr >> connport;
+	if (!parsestr || !connport)
+	{
+		osd_printf_error("Netplay: invalid remote UDP port %s, disabling netplay.\n", opts.netplay_remoteport());
+		return;
+	}
+
+	parsestr.clear();
+	parsestr.str(opts.netplay_localport());
+	parsestr.seekg(0, std::ios_base::beg);
+	asio::ip::port_type bindport;
+	parsestr >> bindport;
+	if (!parsestr || !bindport)
+	{
+		osd_printf_error("Netplay: invalid local UDP port %s, disabling netplay.\n", opts.netplay_localport());
+		return;
+	}
+
+	// open a non-blocking socket; we only ever poll it at frame boundaries
+	auto ctx = std::make_unique<context>();
+	ctx->m_remote = asio::ip::udp::endpoint(connaddr, connport);
+	ctx->m_socket.open(ctx->m_remote.protocol(), err);
+	if (!err)
+		ctx->m_socket.bind(asio::ip::udp::endpoint(ctx->m_remote.protocol(), bindport), err);
+	if (!err)
+		ctx->m_socket.non_blocking(true, err);
+	if (err)
+	{
+		osd_printf_error("Netplay: error opening/binding socket, disabling netplay (%s).\n", err.message());
+		return;
+	}
+	m_context = std::move(ctx);
+
+	// split the digital inputs between the two sides; analog inputs aren't exchanged
+	for (auto &port : machine.ioport().ports())
+	{
+		ioport_value local = 0, remote = 0;
+		for (ioport_field &field : port.second->fields())
+		{
+			if (field.is_analog())
+				continue;
+			bool const side1 = (field.player() == 1) || (field.type() == IPT_START2) || (field.type() == IPT_COIN2);
+			if (side1 == (m_side == 1))
+				local |= field.mask();
+			else
+				remote |= field.mask();
+		}
+		m_ports.push_back(port.second.get());
+		m_local_mask.push_back(local);
+		m_remote_mask.push_back(remote);
+	}
+	for (unsigned i = 0; i < HISTORY; i++)
+	{
+		m_local[i].value.resize(m_ports.size(), 0);
+		m_remote[i].value.resize(m_ports.size(), 0);
+		m_used[i].value.resize(m_ports.size(), 0);
+	}
+	m_packet.resize(PACKET_HEADER + SEND_WINDOW * m_ports.size() * 4);
+
+	// nothing is pressed during the frames covered by the input delay
+	for (unsigned frame = 0; frame < m_delay; frame++)
+		m_local[slot(frame)].frame = frame;
+
+	m_active = true;
+	osd_printf_info("Netplay: controlling side %d, exchanging inputs with %s port %u\n", m_side + 1, opts.netplay_remotehost(), connport);
+}
+
+
+//-------------------------------------------------
+//  ~netplay_manager - destructor
+//-------------------------------------------------
+
+netplay_manager::~netplay_manager()
+{
+}
+
+
+//-------------------------------------------------
+//  begin_frame - start applying inputs for the
+//  next frame
+//-------------------------------------------------
+
+void netplay_manager::begin_frame()
+{
+	if (!m_active)
+		return;
+
+	m_frame++;
+	m_port_index = 0;
+	receive();
+}
+
+
+//-------------------------------------------------
+//  update_port - record the local player's part
+//  of a port and replace the port's digital state
+//  with what both sides pressed
+//-------------------------------------------------
+
+void netplay_manager::update_port(ioport_port &port)
+{
+	if (!m_active)
+		return;
+
+	unsigned const index = m_port_index++;
+	if ((index >= m_ports.size()) || (m_ports[index] != &port))
+	{
+		disconnect("input ports changed");
+		return;
+	}
+
+	// what's pressed now gets used after the input delay
+	s64 const frame = m_frame + m_delay;
+	frame_inputs &local = m_local[slot(frame)];
+	local.frame = frame;
+	local.value[index] = port.live().digital & m_local_mask[index];
+
+	port.live().digital = port_value(m_frame, index);
+}
+
+
+//-------------------------------------------------
+//  end_frame - send the frame's inputs once all
+//  ports have been updated
+//-------------------------------------------------
+
+void netplay_manager::end_frame()
+{
+	if (!m_active)
+		return;
+
+	send();
+	m_frame_pending = true;
+}
+
+
+//-------------------------------------------------
+//  frame_boundary - wait for the peer if it has
+//  fallen too far behind, roll back any frames
+//  that ran with a wrong guess and save the
+//  state for the frame about to be emulated
+//-------------------------------------------------
+
+void netplay_manager::frame_boundary()
+{
+	m_frame_pending = false;
+	if (!m_active)
+		return;
+
+	// we can't start the next frame if it would leave us unable to roll back
+	// far enough, or if the peer lacks more of our inputs than a packet holds
+	receive();
+	osd_ticks_t const timeout = osd_ticks_per_second() * (m_heard ? 10 : 60);
+	osd_ticks_t resent = osd_ticks();
+	while (m_active && ((m_frame + 1 - m_confirmed > MAX_ROLLBACK) || (m_frame + 1 + m_delay - m_peer_ack >= SEND_WINDOW)))
+	{
+		osd_ticks_t const now = osd_ticks();
+		if ((now - m_last_heard) > timeout)
+		{
+			disconnect(m_heard ? "peer stopped responding" : "peer never responded");
+			return;
+		}
+		if ((now - resent) > (osd_ticks_per_second() / 60))
+		{
+			send();
+			resent = now;
+		}
+		osd_sleep(osd_ticks_per_second() / 1000);
+		receive();
+	}
+	if (!m_active)
+		return;
+
+	if (m_rollback >= 0)
+	{
+		s64 const frame = m_rollback;
+		m_rollback = -1;
+
+		// the current frame hasn't been emulated yet, so it only needs its inputs fixed
+		if (frame < m_frame)
+		{
+			resimulate(frame);
+			return;
+		}
+		apply_frame(m_frame);
+	}
+
+	if (!save_state(m_frame))
+		disconnect("unable to save state");
+}
+
+
+//-------------------------------------------------
+//  port_value - get the digital state of a port
+//  for a frame, guessing the peer's part if it
+//  hasn't arrived
+//-------------------------------------------------
+
+ioport_value netplay_manager::port_value(s64 frame, unsigned index)
+{
+	frame_inputs const &local = m_local[slot(frame)];
+	frame_inputs const &remote = m_remote[slot(frame)];
+	frame_inputs const &last = m_remote[slot(m_confirmed)];
+	frame_inputs &used = m_used[slot(frame)];
+
+	// the best guess is that the peer is still holding what it last sent
+	ioport_value theirs = 0;
+	if (remote.frame == frame)
+		theirs = remote.value[index];
+	else if ((m_confirmed >= 0) && (last.frame == m_confirmed))
+		theirs = last.value[index];
+
+	used.frame = frame;
+	used.value[index] = theirs;
+	return ((local.frame == frame) ? local.value[index] : 0) | theirs;
+}
+
+
+//-------------------------------------------------
+//  apply_frame - set the digital state of every
+//  port for a frame and call line write handlers
+//-------------------------------------------------
+
+void netplay_manager::apply_frame(s64 frame)
+{
+	for (unsigned index = 0; index < m_ports.size(); index++)
+	{
+		ioport_port &port = *m_ports[index];
+		port.live().digital = port_value(frame, index);
+
+		ioport_value const newvalue = port.read();
+		for (dynamic_field &dynfield : port.live().writelist)
+			if (dynfield.field().type() != IPT_OUTPUT)
+				dynfield.write(newvalue);
+	}
+}
+
+
+//-------------------------------------------------
+//  resimulate - load the state for a frame that
+//  ran with a wrong guess and emulate forward to
+//  the current frame again
+//-------------------------------------------------
+
+void netplay_manager::resimulate(s64 frame)
+{
+	unsigned const index = slot(frame);
+	if ((m_state_frame[index] != frame) || (m_states[index]->load() != STATERR_NONE))
+	{
+		disconnect("no state to roll back to");
+		return;
+	}
+
+	// the frames being replaced were already seen and heard
+	video_manager &video = machine().video();
+	machine().sound().set_speculative(true);
+	for (s64 current = frame; ; current++)
+	{
+		apply_frame(current);
+		if (!save_state(current))
+		{
+			disconnect("unable to save state");
+			break;
+		}
+		if (current == m_frame)
+			break;
+
+		video.begin_resimulation();
+		while (video.runahead_active() && !machine().scheduled_event_pending())
+			machine().scheduler().timeslice();
+	}
+	video.end_runahead();
+	machine().sound().set_speculative(false);
+}
+
+
+//-------------------------------------------------
+//  save_state - save the state at the start of
+//  a frame, sharing unchanged chunks with the
+//  previous one
+//-------------------------------------------------
+
+bool netplay_manager::save_state(s64 frame)
+{
+	unsigned const index = slot(frame);
+	std::unique_ptr<ram_state> &state = m_states[index];
+	if (!state)
+		state = std::make_unique<ram_state>(machine().save(), true);
+
+	m_state_frame[index] = -1;
+	if (state->save_delta(m_reference, false, m_chunk_bytes) != STATERR_NONE)
+		return false;
+
+	m_reference = state->chunks();
+	m_state_frame[index] = frame;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  send - send every frame of our inputs the peer
+//  hasn't acknowledged yet
+//-------------------------------------------------
+
+void netplay_manager::send()
+{
+	s64 const top = m_frame + m_delay;
+	s64 const first = std::max<s64>(m_peer_ack, top - SEND_WINDOW + 1);
+	unsigned const count = (top >= first) ? unsigned(top - first + 1) : 0;
+
+	u8 *dest = &m_packet[0];
+	put_u32le(dest + 0, PACKET_MAGIC);
+	put_u32le(dest + 4, u32(first));
+	put_u32le(dest + 8, u32(m_confirmed + 1));
+	put_u16le(dest + 12, u16(m_ports.size()));
+	dest[14] = u8(count);
+	dest[15] = m_side;
+	dest += PACKET_HEADER;
+	for (unsigned i = 0; i < count; i++)
+	{
+		frame_inputs const &local = m_local[slot(first + i)];
+		for (ioport_value value : local.value)
+		{
+			put_u32le(dest, value);
+			dest += 4;
+		}
+	}
+
+	// packets that don't make it get resent with the next frame
+	std::error_code err;
+	m_context->m_socket.send_to(asio::buffer(m_packet.data(), dest - &m_packet[0]), m_context->m_remote, 0, err);
+}
+
+
+//-------------------------------------------------
+//  receive - pick up any inputs that arrived and
+//  note the first frame that ran with a wrong
+//  guess
+//-------------------------------------------------
+
+void netplay_manager::receive()
+{
+	for (;;)
+	{
+		std::error_code err;
+		asio::ip::udp::endpoint sender;
+		size_t const length = m_context->m_socket.receive_from(asio::buffer(m_packet), sender, 0, err);
+		if (err)
+			break;
+
+		u8 const *src = &m_packet[0];
+		if ((sender.address() != m_context->m_remote.address()) || (length < PACKET_HEADER) || (get_u32le(src) != PACKET_MAGIC))
+			continue;
+		if ((get_u16le(src + 12) != m_ports.size()) || (src[15] == m_side))
+		{
+			disconnect((src[15] == m_side) ? "both sides control the same players" : "peer is running a different system");
+			return;
+		}
+
+		s64 const first = get_u32le(src + 4);
+		unsigned const count = src[14];
+		if (length < (PACKET_HEADER + count * m_ports.size() * 4))
+			continue;
+
+		m_heard = true;
+		m_last_heard = osd_ticks();
+		m_peer_ack = std::max<s64>(m_peer_ack, get_u32le(src + 8));
+
+		src += PACKET_HEADER;
+		for (unsigned i = 0; i < count; i++, src += m_ports.size() * 4)
+		{
+			s64 const frame = first + i;
+			frame_inputs &remote = m_remote[slot(frame)];
+			if ((frame <= m_confirmed) || (frame >= (m_confirmed + HISTORY)) || (remote.frame == frame))
+				continue;
+
+			remote.frame = frame;
+			for (unsigned index = 0; index < m_ports.size(); index++)
+				remote.value[index] = get_u32le(src + index * 4) & m_remote_mask[index];
+
+			// frames that already ran need redoing if they guessed wrong
+			frame_inputs const &used = m_used[slot(frame)];
+			if ((frame <= m_frame) && ((used.frame != frame) || (used.value != remote.value)) && ((m_rollback < 0) || (frame < m_rollback)))
+				m_rollback = frame;
+		}
+
+		while (m_remote[slot(m_confirmed + 1)].frame == (m_confirmed + 1))
+			m_confirmed++;
+	}
+}
+
+
+//-------------------------------------------------
+//  disconnect - stop exchanging inputs and carry
+//  on with local inputs only
+//-------------------------------------------------
+
+void netplay_manager::disconnect(const char *reason)
+{
+	osd_printf_error("Netplay: %s, continuing without the peer.\n", reason);
+	machine().popmessage("Netplay disconnected: %s", reason);
+
+	m_active = false;
+	m_frame_pending = false;
+	m_reference.clear();
+	for (auto &state : m_states)
+		state.reset();
+	std::fill(std::begin(m_state_frame), std::end(m_state_frame), -1);
+}
@@ -0,0 +1,102 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    netplay.h
+
+    Rollback netplay between two instances over UDP.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_NETPLAY_H
+#define MAME_EMU_NETPLAY_H
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+
+// ======================> netplay_manager
+
+// exchanges digital inputs with a peer every frame; the peer's inputs are
+// predicted when they haven't arrived yet and the machine is rolled back and
+// emulated forward again from saved states when a prediction turns out wrong
+class netplay_manager
+{
+	DISABLE_COPYING(netplay_manager);
+
+public:
+	// construction/destruction
+	netplay_manager(running_machine &machine);
+	~netplay_manager();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	bool active() const { return m_active; }
+	bool frame_pending() const { return m_frame_pending; }
+
+	// input hooks, called from the input port frame update
+	void begin_frame();
+	void update_port(ioport_port &port);
+	void end_frame();
+
+	// called from the machine loop once the committed frame has been emulated
+	void frame_boundary();
+
+private:
+	class context;
+
+	static constexpr unsigned HISTORY = 32;         // frames of inputs and states kept (power of two)
+	static constexpr unsigned MAX_ROLLBACK = 8;     // frames we may run ahead of the peer's confirmed inputs
+	static constexpr unsigned MAX_DELAY = 8;        // maximum local input delay
+	static constexpr unsigned SEND_WINDOW = 16;     // most frames of input resent in a packet
+
+	// per-frame inputs, one value per port
+	struct frame_inputs
+	{
+		s64                         frame = -1;     // frame these inputs belong to (-1 = none)
+		std::vector<ioport_value>   value;
+	};
+
+	static unsigned slot(s64 frame) { return unsigned(frame) & (HISTORY - 1); }
+
+	ioport_value port_value(s64 frame, unsigned index);
+	void apply_frame(s64 frame);
+	void resimulate(s64 frame);
+	bool save_state(s64 frame);
+	void send();
+	void receive();
+	void disconnect(const char *reason);
+
+	// internal state
+	running_machine &               m_machine;          // reference to our machine
+	std::unique_ptr<context>        m_context;          // socket and peer address
+	bool                            m_active;           // still exchanging inputs?
+	bool                            m_frame_pending;    // frame inputs applied, waiting for the frame to be emulated
+	bool                            m_heard;            // have we ever heard from the peer?
+	u8                              m_side;             // which side of the machine we control (0 or 1)
+	u8                              m_delay;            // local input delay in frames
+	osd_ticks_t                     m_last_heard;       // when the peer's last packet arrived
+	std::vector<u8>                 m_packet;           // packet buffer
+
+	std::vector<ioport_port *>      m_ports;            // ports in exchange order
+	std::vector<ioport_value>       m_local_mask;       // bits we own, per port
+	std::vector<ioport_value>       m_remote_mask;      // bits the peer owns, per port
+	unsigned                        m_port_index;       // next port expected by update_port
+
+	s64                             m_frame;            // frame whose inputs were applied last
+	s64                             m_confirmed;        // last frame up to which all peer inputs arrived
+	s64                             m_peer_ack;         // first frame of our inputs the peer still lacks
+	s64                             m_rollback;         // earliest applied frame with a wrong prediction (-1 = none)
+	frame_inputs                    m_local[HISTORY];   // our inputs, already delayed
+	frame_inputs                    m_remote[HISTORY];  // peer inputs that have arrived
+	frame_inputs                    m_used[HISTORY];    // peer inputs (received or predicted) each frame ran with
+
+	size_t                          m_chunk_bytes;      // memory held by state chunks
+	ram_state::chunk_list           m_reference;        // chunks of the last saved state
+	std::unique_ptr<ram_state>      m_states[HISTORY];  // state at the start of each frame
+	s64                             m_state_frame[HISTORY];
+};
+
+#endif // MAME_EMU_NETPLAY_H
@@ -31,6 +31,7 @@ output_manager::output_item::output_item(
 	, m_name(std::move(name))
 	, m_id(id)
 	, m_value(value)
+	, m_pending(false)
 	, m_notifylist()
 {
 }
@@ -49,6 +50,13 @@ void output_manager::output_item::notify(s32 value)
 	// call the global notifiers next
 	for (auto const &notify : m_manager.m_global_notifylist)
 		notify(m_name.c_str(), value);
+
+	// frame notifiers only hear about each item once, with its latest value
+	if (!m_pending && !m_manager.m_frame_notifylist.empty())
+	{
+		m_pending = true;
+		m_manager.m_changed.push_back(this);
+	}
 }
 
 
@@ -80,6 +88,7 @@ output_manager::output_manager(running_machine &machine)
 	// add callbacks
 	machine.add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(&output_manager::pause, this));
 	machine.add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(&output_manager::resume, this));
+	machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&output_manager::frame_update, this));
 	machine.save().register_presave(save_prepost_delegate(FUNC(output_manager::presave), this));
 	machine.save().register_postload(save_prepost_delegate(FUNC(output_manager::postload), this));
 }
@@ -101,7 +110,7 @@ void output_manager::register_save()
 
 	// sort existing outputs by name and register for save
 	for (auto &item : m_itemtable)
-		m_save_order.emplace_back(item.second);
+		m_save_order.emplace_back(*item.second);
 	std::sort(m_save_order.begin(), m_save_order.end(), [] (auto const &l, auto const &r) { return l.get().name() < r.get().name(); });
 
 	// register the reserved space for saving
@@ -118,9 +127,9 @@ void output_manager::register_save()
 
 output_manager::output_item *output_manager::find_item(std::string_view string)
 {
-	auto item = m_itemtable.find(std::string(string));
+	auto item = m_itemtable.find(string);
 	if (item != m_itemtable.end())
-		return &item->second;
+		return item->second.get();
 
 	return nullptr;
 }
@@ -135,12 +144,11 @@ output_manager::output_item &output_manager::create_new_item(std::string_view ou
 	if (OUTPUT_VERBOSE)
 		osd_printf_verbose("Creating output %s = %d%s\n", outname, value, m_save_data ? " (will not be saved)" : "");
 
-	auto const ins(m_itemtable.emplace(
-			std::piecewise_construct,
-			std::forward_as_tuple(outname),
-			std::forward_as_tuple(*this, std::string(outname), m_uniqueid++, value)));
+	// the key refers to the name held by the item, so lookups don't have to build a string
+	auto item = std::make_unique<output_item>(*this, std::string(outname), m_uniqueid++, value);
+	auto const ins(m_itemtable.emplace(item->name(), std::move(item)));
 	assert(ins.second);
-	return ins.first->second;
+	return *ins.first->second;
 }
 
 output_manager::output_item &output_manager::find_or_create_item(std::string_view outname, s32 value)
@@ -165,6 +173,25 @@ void output_manager::resume()
 }
 
 
+/*-------------------------------------------------
+    frame_update - pass the outputs that changed
+    during the frame to the frame notifiers
+-------------------------------------------------*/
+
+void output_manager::frame_update()
+{
+	if (m_changed.empty())
+		return;
+
+	for (auto const &notify : m_frame_notifylist)
+		notify.first(notify.second);
+
+	for (output_item *item : m_changed)
+		item->set_pending(false);
+	m_changed.clear();
+}
+
+
 /*-------------------------------------------------
     presave - prepare data for save state
 -------------------------------------------------*/
@@ -241,6 +268,18 @@ void output_manager::set_global_notifier(notifier_func callback, void *param)
 }
 
 
+//-------------------------------------------------
+//  set_frame_notifier - sets a notifier callback
+//  called once per frame with the outputs that
+//  changed during it
+//-------------------------------------------------
+
+void output_manager::set_frame_notifier(frame_notifier_func callback, void *param)
+{
+	m_frame_notifylist.emplace_back(callback, param);
+}
+
+
 /*-------------------------------------------------
     output_name_to_id - returns a unique ID for
     a given name
@@ -262,8 +301,8 @@ u32 output_manager::name_to_id(std::string_view outname)
 char const *output_manager::id_to_name(u32 id)
 {
 	for (auto &item : m_itemtable)
-		if (item.second.id() == id)
-			return item.second.name().c_str();
+		if (item.second->id() == id)
+			return item.second->name().c_str();
 
 	// nothing found, return nullptr
 	return nullptr;
@@ -33,6 +33,7 @@ private:
 	template <typename Input, std::make_unsigned_t<Input> DefaultMask> friend class devcb_write;
 
 	typedef void (*notifier_func)(const char *outname, s32 value, void *param);
+	typedef void (*frame_notifier_func)(void *param);
 
 	class output_notify
 	{
@@ -70,6 +71,8 @@ private:
 		s32 get() const { return m_value; }
 		void set(s32 value) { if (m_value != value) { notify(value); } }
 		void notify(s32 value);
+		bool pending() const { return m_pending; }
+		void set_pending(bool pending) { m_pending = pending; }
 
 		void set_notifier(notifier_func callback, void *param) { m_notifylist.emplace_back(callback, param); }
 
@@ -78,6 +81,7 @@ private:
 		std::string const   m_name;         // string name of the item
 		u32 const           m_id;           // unique ID for this item
 		s32                 m_value;        // current value
+		bool                m_pending;      // queued for the frame notifiers?
 		notify_vector       m_notifylist;   // list of notifier callbacks
 	};
 
@@ -85,6 +89,7 @@ private:
 	{
 	public:
 		item_proxy() = default;
+		item_proxy(output_item &item) : m_item(&item) { }
 		void resolve(device_t &device, std::string_view name);
 		operator s32() const { return m_item->get(); }
 		s32 operator=(s32 value) { m_item->set(value); return m_item->get(); }
@@ -96,6 +101,9 @@ private:
 	template <unsigned... N> using item_proxy_array_t = typename item_proxy_array<N...>::type;
 
 public:
+	// handle to an output that has already been looked up by name
+	using output_handle = item_proxy;
+
 	template <typename X, unsigned... N> class output_finder
 	{
 	public:
@@ -171,6 +179,10 @@ public:
 
 	// set the value for a given output
 	void set_value(std::string_view outname, s32 value);
+	void set_handle_value(output_handle &handle, s32 value) { handle = value; }
+
+	// look up (or create) an output once, so it can be set without the name lookup
+	output_handle find_or_create(std::string_view outname) { return output_handle(find_or_create_item(outname, 0)); }
 
 	// return the current value for a given output
 	s32 get_value(std::string_view outname);
@@ -181,11 +193,23 @@ public:
 	// set a notifier globally
 	void set_global_notifier(notifier_func callback, void *param);
 
+	// set a notifier called once per frame when any outputs changed; the
+	// changes are read back with notify_changed
+	void set_frame_notifier(frame_notifier_func callback, void *param);
+
 	// immdediately call a notifier for all outputs
 	template <typename T> void notify_all(T &&notifier) const
 	{
 		for (auto const &item : m_itemtable)
-			notifier(item.second.name().c_str(), item.second.get());
+			notifier(item.second->name().c_str(), item.second->get());
+	}
+
+	// call a notifier for each output that changed during the frame, with
+	// its latest value; only valid from a frame notifier
+	template <typename T> void notify_changed(T &&notifier) const
+	{
+		for (output_item const *item : m_changed)
+			notifier(item->name().c_str(), item->get());
 	}
 
 	// map a name to a unique ID
@@ -204,11 +228,14 @@ private:
 	void resume();
 	void presave() ATTR_COLD;
 	void postload() ATTR_COLD;
+	void frame_update();
 
 	// internal state
 	running_machine &m_machine;                  // reference to our machine
-	std::unordered_map<std::string, output_item> m_itemtable;
+	std::unordered_map<std::string_view, std::unique_ptr<output_item> > m_itemtable; // keyed on the item's own name
 	notify_vector m_global_notifylist;
+	std::vector<std::pair<frame_notifier_func, void *> > m_frame_notifylist;
+	std::vector<output_item *> m_changed;        // items changed since the last frame notification
 	std::vector<std::reference_wrapper<output_item> > m_save_order;
 	std::unique_ptr<s32 []> m_save_data;
 	u32 m_uniqueid;
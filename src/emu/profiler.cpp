@@ -24,6 +24,16 @@
 #include "emu.h"
 #include "profiler.h"
 
+#include "corefile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <locale>
+#include <sstream>
+#include <thread>
+
 
 
 //**************************************************************************
@@ -42,7 +52,9 @@ struct profile_string
 //  GLOBAL VARIABLES
 //**************************************************************************
 
+runtime_trace g_runtime_trace;
 profiler_state g_profiler;
+startup_trace g_startup_trace;
 
 
 
@@ -52,6 +64,109 @@ profiler_state g_profiler;
 
 #define TEXT_UPDATE_TIME        0.5
 
+static const profile_string s_profile_names[] =
+{
+	{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
+	{ PROFILER_MEM_REMAP,        "Memory Remapping" },
+	{ PROFILER_MEMREAD,          "Memory Read" },
+	{ PROFILER_MEMWRITE,         "Memory Write" },
+	{ PROFILER_VIDEO,            "Video Update" },
+	{ PROFILER_DRAWGFX,          "drawgfx" },
+	{ PROFILER_COPYBITMAP,       "copybitmap" },
+	{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
+	{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
+	{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
+	{ PROFILER_BLIT,             "OSD Blitting" },
+	{ PROFILER_SOUND,            "Sound Generation" },
+	{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
+	{ PROFILER_INPUT,            "Input Processing" },
+	{ PROFILER_MOVIE_REC,        "Movie Recording" },
+	{ PROFILER_LOGERROR,         "Error Logging" },
+	{ PROFILER_LUA,              "LUA" },
+	{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
+	{ PROFILER_USER1,            "User 1" },
+	{ PROFILER_USER2,            "User 2" },
+	{ PROFILER_USER3,            "User 3" },
+	{ PROFILER_USER4,            "User 4" },
+	{ PROFILER_USER5,            "User 5" },
+	{ PROFILER_USER6,            "User 6" },
+	{ PROFILER_USER7,            "User 7" },
+	{ PROFILER_USER8,            "User 8" },
+	{ PROFILER_PROFILER,         "Profiler" },
+	{ PROFILER_IDLE,             "Idle" }
+};
+
+
+
+//**************************************************************************
+//  DYNAMIC SCOPES
+//**************************************************************************
+
+namespace {
+
+std::mutex s_scope_mutex;
+std::deque<std::string> s_scope_names; // deque so names never move
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  profiler_register_scope - get a profiler type
+//  for a name
+//-------------------------------------------------
+
+profile_type profiler_register_scope(std::string_view name)
+{
+	std::lock_guard<std::mutex> lock(s_scope_mutex);
+	auto const found(std::find(s_scope_names.begin(), s_scope_names.end(), name));
+	if (s_scope_names.end() != found)
+		return profile_type(PROFILER_DYNAMIC_FIRST + (found - s_scope_names.begin()));
+	if ((PROFILER_DYNAMIC_MAX - PROFILER_DYNAMIC_FIRST) <= s_scope_names.size())
+		return PROFILER_EXTRA;
+	s_scope_names.emplace_back(name);
+	return profile_type(PROFILER_DYNAMIC_FIRST + s_scope_names.size() - 1);
+}
+
+
+//-------------------------------------------------
+//  profiler_scope_name - get the name of a
+//  registered profiler type
+//-------------------------------------------------
+
+char const *profiler_scope_name(int type)
+{
+	if ((PROFILER_DYNAMIC_FIRST > type) || (PROFILER_DYNAMIC_MAX <= type))
+		return nullptr;
+	std::lock_guard<std::mutex> lock(s_scope_mutex);
+	std::size_t const index(type - PROFILER_DYNAMIC_FIRST);
+	return (s_scope_names.size() > index) ? s_scope_names[index].c_str() : nullptr;
+}
+
+
+
+//-------------------------------------------------
+//  profile_type_name - get a display name for a
+//  profiler type
+//-------------------------------------------------
+
+static std::string profile_type_name(device_enumerator &iter, int type)
+{
+	if ((type >= PROFILER_DEVICE_FIRST) && (type <= PROFILER_DEVICE_MAX))
+	{
+		device_t const *const device(iter.byindex(type - PROFILER_DEVICE_FIRST));
+		return device ? device->tag() : "device";
+	}
+	char const *const dynamic(profiler_scope_name(type));
+	if (dynamic)
+		return dynamic;
+	for (auto const &name : s_profile_names)
+	{
+		if (name.type == type)
+			return name.string;
+	}
+	return util::string_format("type %d", type);
+}
+
 
 
 //**************************************************************************
@@ -72,15 +187,82 @@ dummy_profiler_state::dummy_profiler_state()
 //  REAL PROFILER STATE
 //**************************************************************************
 
+//-------------------------------------------------
+//  sampler - samples the innermost profiler
+//  scope at a fixed interval
+//-------------------------------------------------
+
+class real_profiler_state::sampler
+{
+public:
+	sampler(std::atomic<int> const &current, unsigned interval)
+		: m_current(current)
+		, m_interval(interval)
+		, m_exit(false)
+		, m_counts()
+		, m_thread([this] () { run(); })
+	{
+	}
+
+	~sampler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_exit = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+	}
+
+	// add samples taken since the last call to the totals
+	void collect(osd_ticks_t *data) noexcept
+	{
+		for (std::size_t i = 0; std::size(m_counts) > i; ++i)
+			data[i] += m_counts[i].exchange(0, std::memory_order_relaxed);
+	}
+
+private:
+	void run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (!m_condition.wait_for(lock, std::chrono::microseconds(m_interval), [this] () { return m_exit; }))
+		{
+			int const type(m_current.load(std::memory_order_relaxed));
+			if ((0 <= type) && (std::size(m_counts) > unsigned(type)))
+				m_counts[type].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	std::atomic<int> const &    m_current;
+	unsigned const              m_interval;
+	std::mutex                  m_mutex;
+	std::condition_variable     m_condition;
+	bool                        m_exit;
+	std::atomic<u32>            m_counts[PROFILER_TOTAL + 1];
+	std::thread                 m_thread; // last, so everything is set up before it runs
+};
+
+
 //-------------------------------------------------
 //  real_profiler_state - constructor
 //-------------------------------------------------
 
 real_profiler_state::real_profiler_state()
+	: m_sample_interval(0)
+	, m_current(PROFILER_TOTAL)
 {
 	memset(m_filo, 0, sizeof(m_filo));
 	memset(m_data, 0, sizeof(m_data));
-	reset(false);
+	reset(false, 0);
+}
+
+
+//-------------------------------------------------
+//  ~real_profiler_state - destructor
+//-------------------------------------------------
+
+real_profiler_state::~real_profiler_state()
+{
 }
 
 
@@ -89,11 +271,13 @@ real_profiler_state::real_profiler_state()
 //  reset - initializes state
 //-------------------------------------------------
 
-void real_profiler_state::reset(bool enabled) noexcept
+void real_profiler_state::reset(bool enabled, unsigned sample_interval) noexcept
 {
 	// disabling the profiler from the UI happens while PROFILER_EXTRA is active
 	//assert(!m_filoptr || (m_filoptr == m_filo));
 
+	m_sampler.reset();
+	m_sample_interval = 0;
 	m_text_time = attotime::never;
 
 	if (enabled)
@@ -104,6 +288,23 @@ void real_profiler_state::reset(bool enabled) noexcept
 		// set up dummy entry
 		m_filoptr->start = 0;
 		m_filoptr->type = PROFILER_TOTAL;
+		m_current.store(PROFILER_TOTAL, std::memory_order_relaxed);
+
+		// ticks and sample counts don't mix
+		memset(m_data, 0, sizeof(m_data));
+
+		// fall back to timing transitions if the sampler can't be started
+		if (sample_interval)
+		{
+			try
+			{
+				m_sampler = std::make_unique<sampler>(m_current, sample_interval);
+				m_sample_interval = sample_interval;
+			}
+			catch (std::exception const &)
+			{
+			}
+		}
 	}
 	else
 	{
@@ -143,37 +344,9 @@ const char *real_profiler_state::text(running_machine &machine)
 
 void real_profiler_state::update_text(running_machine &machine)
 {
-	static const profile_string names[] =
-	{
-		{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
-		{ PROFILER_MEM_REMAP,        "Memory Remapping" },
-		{ PROFILER_MEMREAD,          "Memory Read" },
-		{ PROFILER_MEMWRITE,         "Memory Write" },
-		{ PROFILER_VIDEO,            "Video Update" },
-		{ PROFILER_DRAWGFX,          "drawgfx" },
-		{ PROFILER_COPYBITMAP,       "copybitmap" },
-		{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
-		{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
-		{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
-		{ PROFILER_BLIT,             "OSD Blitting" },
-		{ PROFILER_SOUND,            "Sound Generation" },
-		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
-		{ PROFILER_INPUT,            "Input Processing" },
-		{ PROFILER_MOVIE_REC,        "Movie Recording" },
-		{ PROFILER_LOGERROR,         "Error Logging" },
-		{ PROFILER_LUA,              "LUA" },
-		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
-		{ PROFILER_USER1,            "User 1" },
-		{ PROFILER_USER2,            "User 2" },
-		{ PROFILER_USER3,            "User 3" },
-		{ PROFILER_USER4,            "User 4" },
-		{ PROFILER_USER5,            "User 5" },
-		{ PROFILER_USER6,            "User 6" },
-		{ PROFILER_USER7,            "User 7" },
-		{ PROFILER_USER8,            "User 8" },
-		{ PROFILER_PROFILER,         "Profiler" },
-		{ PROFILER_IDLE,             "Idle" }
-	};
+	// when sampling, the counts stand in for time
+	if (m_sampler)
+		m_sampler->collect(m_data);
 
 	// compute the total time for all bits, not including profiler or idle
 	u64 computed = 0;
@@ -215,8 +388,10 @@ void real_profiler_state::update_text(running_machine &machine)
 			// and then the text
 			if (curtype >= PROFILER_DEVICE_FIRST && curtype <= PROFILER_DEVICE_MAX)
 				util::stream_format(stream, "'%s'", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag());
+			else if (char const *const name = profiler_scope_name(curtype))
+				stream << name;
 			else
-				for (auto & name : names)
+				for (auto & name : s_profile_names)
 					if (name.type == curtype)
 					{
 						stream << name.string;
@@ -232,3 +407,365 @@ void real_profiler_state::update_text(running_machine &machine)
 	memset(m_data, 0, sizeof(m_data));
 	m_text = stream.str();
 }
+
+
+
+//-------------------------------------------------
+//  counts - get the time or samples counted in
+//  each scope, excluding the profiler and idle
+//-------------------------------------------------
+
+std::vector<std::pair<std::string, u64> > real_profiler_state::counts(running_machine &machine)
+{
+	std::vector<std::pair<std::string, u64> > result;
+	if (m_sampler)
+		m_sampler->collect(m_data);
+
+	device_enumerator iter(machine.root_device());
+	for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype < PROFILER_PROFILER; ++curtype)
+	{
+		if (m_data[curtype])
+			result.emplace_back(profile_type_name(iter, curtype), m_data[curtype]);
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  breakdown - get the share of time spent in
+//  each scope, excluding the profiler and idle
+//-------------------------------------------------
+
+std::vector<std::pair<std::string, double> > real_profiler_state::breakdown(running_machine &machine)
+{
+	std::vector<std::pair<std::string, u64> > const data(counts(machine));
+	u64 total = 0;
+	for (auto const &entry : data)
+		total += entry.second;
+
+	std::vector<std::pair<std::string, double> > result;
+	result.reserve(data.size());
+	for (auto const &[name, count] : data)
+		result.emplace_back(name, double(count) / double(total));
+	return result;
+}
+
+
+
+//**************************************************************************
+//  STARTUP TRACE
+//**************************************************************************
+
+namespace {
+
+//-------------------------------------------------
+//  json_escape - quote a string for a JSON
+//  string literal
+//-------------------------------------------------
+
+std::string json_escape(std::string_view text)
+{
+	std::string result;
+	result.reserve(text.length());
+	for (char const ch : text)
+	{
+		switch (ch)
+		{
+		case '"':   result.append("\\\""); break;
+		case '\\':  result.append("\\\\"); break;
+		case '\n':  result.append("\\n"); break;
+		case '\t':  result.append("\\t"); break;
+		default:
+			if (u8(ch) < 0x20)
+				result.append(util::string_format("\\u%04x", unsigned(u8(ch))));
+			else
+				result.push_back(ch);
+			break;
+		}
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  startup_trace - constructor
+//-------------------------------------------------
+
+startup_trace::startup_trace()
+	: m_enabled(false)
+	, m_origin(0)
+{
+}
+
+
+//-------------------------------------------------
+//  start - begin recording phases
+//-------------------------------------------------
+
+void startup_trace::start(std::string_view filename)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_filename = filename;
+	m_origin = osd_ticks();
+	m_events.clear();
+	m_enabled.store(!m_filename.empty(), std::memory_order_relaxed);
+}
+
+
+//-------------------------------------------------
+//  add - record a completed phase; safe to call
+//  from any thread
+//-------------------------------------------------
+
+void startup_trace::add(char const *category, std::string &&name, osd_ticks_t start, osd_ticks_t end)
+{
+	// number host threads in the order they first record something
+	static std::atomic<unsigned> s_next_thread(0);
+	thread_local unsigned const t_thread = s_next_thread++;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (enabled())
+		m_events.emplace_back(event{ category, std::move(name), start, end, t_thread });
+}
+
+
+//-------------------------------------------------
+//  finish - stop recording and write complete
+//  events in Chrome trace event format
+//-------------------------------------------------
+
+void startup_trace::finish()
+{
+	// cheap check first, since this is called on every frame
+	if (!enabled())
+		return;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!enabled())
+		return;
+	m_enabled.store(false, std::memory_order_relaxed);
+
+	// timestamps and durations are in microseconds from the start of tracing
+	double const scale = 1'000'000.0 / double(osd_ticks_per_second());
+	std::ostringstream out;
+	out.imbue(std::locale::classic());
+	out << "{\"traceEvents\":[\n";
+	for (std::size_t i = 0; m_events.size() > i; ++i)
+	{
+		event const &ev(m_events[i]);
+		util::stream_format(
+				out,
+				"%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+				i ? ",\n" : "",
+				json_escape(ev.name),
+				json_escape(ev.category),
+				double(s64(ev.start - m_origin)) * scale,
+				double(ev.end - ev.start) * scale,
+				ev.thread);
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	m_events.clear();
+
+	util::core_file::ptr file;
+	std::string const text(std::move(out).str());
+	if (util::core_file::open(m_filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) || util::write(*file, text.data(), text.size()).first)
+		osd_printf_error("Error writing startup trace %s\n", m_filename);
+	else
+		osd_printf_verbose("Startup trace written to %s\n", m_filename);
+}
+
+
+
+//**************************************************************************
+//  RUNTIME TRACE
+//**************************************************************************
+
+// one buffer per thread that records events - only the owning thread
+// writes, and the head count is published after each event is complete
+struct runtime_trace::thread_buffer
+{
+	thread_buffer(unsigned number) : id(number), label(nullptr), head(0), events(new event[BUFFER_EVENTS]) { }
+
+	unsigned const              id;
+	std::atomic<char const *>   label;
+	std::atomic<u64>            head;
+	std::unique_ptr<event []>   events;
+};
+
+thread_local runtime_trace::thread_buffer *runtime_trace::s_buffer = nullptr;
+
+
+//-------------------------------------------------
+//  runtime_trace - constructor/destructor
+//-------------------------------------------------
+
+runtime_trace::runtime_trace()
+	: m_enabled(false)
+	, m_origin(0)
+{
+}
+
+runtime_trace::~runtime_trace()
+{
+	if (enabled())
+		osd_work_set_trace_callback(nullptr);
+}
+
+
+//-------------------------------------------------
+//  enable - start or stop recording
+//-------------------------------------------------
+
+void runtime_trace::enable(bool state)
+{
+	if (state == enabled())
+		return;
+
+	if (state)
+	{
+		// buffers are kept, so old events are hidden by time instead
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_origin = osd_ticks();
+		}
+		thread_buffer *const buffer(local_buffer());
+		if (buffer)
+			buffer->label.store("main", std::memory_order_relaxed);
+		osd_work_set_trace_callback(&runtime_trace::work_item_done);
+		m_enabled.store(true, std::memory_order_relaxed);
+	}
+	else
+	{
+		m_enabled.store(false, std::memory_order_relaxed);
+		osd_work_set_trace_callback(nullptr);
+	}
+}
+
+
+//-------------------------------------------------
+//  add - record a completed span in the calling
+//  thread's buffer
+//-------------------------------------------------
+
+void runtime_trace::add(char const *name, int type, osd_ticks_t start, osd_ticks_t end) noexcept
+{
+	thread_buffer *const buffer(local_buffer());
+	if (buffer)
+	{
+		u64 const index(buffer->head.load(std::memory_order_relaxed));
+		buffer->events[index & (BUFFER_EVENTS - 1)] = event{ name, type, start, end };
+		buffer->head.store(index + 1, std::memory_order_release);
+	}
+}
+
+
+//-------------------------------------------------
+//  work_item_done - OSD work queue callback
+//-------------------------------------------------
+
+void runtime_trace::work_item_done(osd_ticks_t start, osd_ticks_t end) noexcept
+{
+	thread_buffer *const buffer(g_runtime_trace.local_buffer());
+	if (buffer)
+	{
+		char const *expected(nullptr);
+		buffer->label.compare_exchange_strong(expected, "work queue", std::memory_order_relaxed);
+	}
+	g_runtime_trace.add("work item", -1, start, end);
+}
+
+
+//-------------------------------------------------
+//  local_buffer - get the calling thread's
+//  buffer, allocating it on first use
+//-------------------------------------------------
+
+runtime_trace::thread_buffer *runtime_trace::local_buffer() noexcept
+{
+	if (!s_buffer)
+	{
+		// this is the only place that locks, and it happens once per thread
+		std::lock_guard<std::mutex> lock(m_mutex);
+		try
+		{
+			m_buffers.emplace_back(std::make_unique<thread_buffer>(m_buffers.size()));
+			s_buffer = m_buffers.back().get();
+		}
+		catch (std::bad_alloc const &)
+		{
+			return nullptr;
+		}
+	}
+	return s_buffer;
+}
+
+
+//-------------------------------------------------
+//  write - write recorded events in Chrome trace
+//  event format
+//-------------------------------------------------
+
+bool runtime_trace::write(running_machine &machine, std::string_view filename)
+{
+	device_enumerator iter(machine.root_device());
+
+	// timestamps and durations are in microseconds from when tracing was enabled
+	double const scale = 1'000'000.0 / double(osd_ticks_per_second());
+	std::ostringstream out;
+	out.imbue(std::locale::classic());
+	out << "{\"traceEvents\":[\n";
+	bool first = true;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::vector<event> events;
+		for (auto const &buffer : m_buffers)
+		{
+			// copy out what the ring holds, then drop anything that may have
+			// been overwritten while copying
+			u64 const head(buffer->head.load(std::memory_order_acquire));
+			u64 begin((head > BUFFER_EVENTS) ? (head - BUFFER_EVENTS) : 0);
+			events.clear();
+			for (u64 i = begin; head > i; ++i)
+				events.emplace_back(buffer->events[i & (BUFFER_EVENTS - 1)]);
+			u64 const after(buffer->head.load(std::memory_order_acquire));
+			u64 const valid((after >= BUFFER_EVENTS) ? (after - BUFFER_EVENTS + 1) : 0);
+			std::size_t const skip((valid > begin) ? std::min<u64>(valid - begin, events.size()) : 0);
+
+			char const *const label(buffer->label.load(std::memory_order_relaxed));
+			util::stream_format(
+					out,
+					"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+					first ? "" : ",\n",
+					buffer->id,
+					label ? label : "thread",
+					buffer->id);
+			first = false;
+
+			for (auto it = events.begin() + skip; events.end() != it; ++it)
+			{
+				if (s64(it->start - m_origin) < 0)
+					continue;
+				util::stream_format(
+						out,
+						",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+						json_escape(it->name ? std::string(it->name) : profile_type_name(iter, it->type)),
+						it->name ? "trace" : (it->type <= PROFILER_DEVICE_MAX) ? "device" : "profiler",
+						double(s64(it->start - m_origin)) * scale,
+						double(it->end - it->start) * scale,
+						buffer->id);
+			}
+		}
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	util::core_file::ptr file;
+	std::string const text(std::move(out).str());
+	if (util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) || util::write(*file, text.data(), text.size()).first)
+	{
+		osd_printf_error("Error writing profile trace %s\n", filename);
+		return false;
+	}
+	osd_printf_verbose("Profile trace written to %s\n", filename);
+	return true;
+}
@@ -33,9 +33,15 @@
 #include "eminline.h" // for get_profile_ticks()
 #include "osdcore.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 
 //**************************************************************************
@@ -76,6 +82,10 @@ enum profile_type
 	PROFILER_USER7,
 	PROFILER_USER8,
 
+	// scopes registered by name at runtime with register_scope
+	PROFILER_DYNAMIC_FIRST,
+	PROFILER_DYNAMIC_MAX = PROFILER_DYNAMIC_FIRST + 256,
+
 	PROFILER_PROFILER,
 	PROFILER_IDLE,
 	PROFILER_TOTAL
@@ -84,11 +94,120 @@ DECLARE_ENUM_INCDEC_OPERATORS(profile_type)
 
 
 
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+// register a named profiler scope - registering the same name again gets
+// the same type, and PROFILER_EXTRA is returned when there are no more
+profile_type profiler_register_scope(std::string_view name);
+
+// get the name of a registered scope, or nullptr if it isn't one
+char const *profiler_scope_name(int type);
+
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
 
 
+// ======================> runtime_trace
+
+// records a timeline of profiler scopes and other interesting spans in
+// per-thread ring buffers, for writing out as Chrome trace events; each
+// thread only ever writes to its own buffer, so recording takes no locks
+class runtime_trace
+{
+public:
+	class scope
+	{
+	private:
+		runtime_trace *m_host;
+		char const *m_name;
+		int m_type;
+		osd_ticks_t m_start;
+
+	public:
+		scope(scope const &) = delete;
+		scope &operator=(scope const &) = delete;
+
+		scope(scope &&that) noexcept : m_host(that.m_host), m_name(that.m_name), m_type(that.m_type), m_start(that.m_start)
+		{
+			that.m_host = nullptr;
+		}
+
+		scope(runtime_trace &host, char const *name, int type) noexcept
+			: m_host(host.enabled() ? &host : nullptr)
+			, m_name(name)
+			, m_type(type)
+			, m_start(m_host ? osd_ticks() : 0)
+		{
+		}
+
+		~scope()
+		{
+			stop();
+		}
+
+		void stop() noexcept
+		{
+			if (m_host)
+			{
+				m_host->add(m_name, m_type, m_start, osd_ticks());
+				m_host = nullptr;
+			}
+		}
+	};
+
+	// construction/destruction
+	runtime_trace();
+	~runtime_trace();
+
+	// getters
+	bool enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+	// enable/disable - enabling discards anything recorded previously
+	void enable(bool state = true);
+
+	// record a span lasting until the returned object is destroyed - names
+	// must outlive the trace, and profile types are named when written
+	[[nodiscard]] scope start(char const *name) noexcept { return scope(*this, name, -1); }
+	[[nodiscard]] scope start(profile_type type) noexcept { return scope(*this, nullptr, type); }
+
+	// record a span that has already completed
+	void add(char const *name, int type, osd_ticks_t start, osd_ticks_t end) noexcept;
+
+	// write what's in the buffers as Chrome trace event JSON
+	bool write(running_machine &machine, std::string_view filename);
+
+private:
+	static constexpr std::size_t BUFFER_EVENTS = 1 << 16;
+
+	struct event
+	{
+		char const *        name;                   // static name, or nullptr to use type
+		int                 type;                   // profile type
+		osd_ticks_t         start;                  // start time
+		osd_ticks_t         end;                    // end time
+	};
+
+	struct thread_buffer;
+
+	static void work_item_done(osd_ticks_t start, osd_ticks_t end) noexcept;
+	thread_buffer *local_buffer() noexcept;
+
+	static thread_local thread_buffer *s_buffer;
+
+	std::atomic<bool>                               m_enabled;
+	std::mutex                                      m_mutex;    // protects buffer list
+	std::vector<std::unique_ptr<thread_buffer> >    m_buffers;
+	osd_ticks_t                                     m_origin;
+};
+
+extern runtime_trace g_runtime_trace;
+
+
 // ======================> real_profiler_state
 
 class real_profiler_state
@@ -99,17 +218,18 @@ public:
 	private:
 		real_profiler_state &m_host;
 		bool m_active;
+		runtime_trace::scope m_trace;
 
 	public:
 		scope(scope const &) = delete;
 		scope &operator=(scope const &) = delete;
 
-		scope(scope &&that) noexcept : m_host(that.m_host), m_active(that.m_active)
+		scope(scope &&that) noexcept : m_host(that.m_host), m_active(that.m_active), m_trace(std::move(that.m_trace))
 		{
 			that.m_active = false;
 		}
 
-		scope(real_profiler_state &host, profile_type type) noexcept : m_host(host), m_active(false)
+		scope(real_profiler_state &host, profile_type type) noexcept : m_host(host), m_active(false), m_trace(g_runtime_trace.start(type))
 		{
 			if (m_host.enabled())
 			{
@@ -130,11 +250,13 @@ public:
 				m_host.real_stop();
 				m_active = false;
 			}
+			m_trace.stop();
 		}
 	};
 
 	// construction/destruction
 	real_profiler_state();
+	~real_profiler_state();
 
 	// getters
 	bool enabled() const noexcept
@@ -143,19 +265,29 @@ public:
 	}
 	const char *text(running_machine &machine);
 
-	// enable/disable
-	void enable(bool state = true) noexcept
+	// enable/disable - with a sample interval in microseconds, a separate
+	// thread samples the current scope rather than timing every transition
+	void enable(bool state = true, unsigned sample_interval = 0) noexcept
 	{
-		if (state != enabled())
+		if ((state != enabled()) || (state && (sample_interval != m_sample_interval)))
 		{
-			reset(state);
+			reset(state, sample_interval);
 		}
 	}
 
 	// start/stop
 	[[nodiscard]] auto start(profile_type type) noexcept { return scope(*this, type); }
+	profile_type register_scope(std::string_view name) { return profiler_register_scope(name); }
+
+	// time or samples counted in each scope since the display was last updated
+	std::vector<std::pair<std::string, u64> > counts(running_machine &machine);
+
+	// share of time for each scope since the display was last updated
+	std::vector<std::pair<std::string, double> > breakdown(running_machine &machine);
 
 private:
+	class sampler;
+
 	// an entry in the FILO
 	struct filo_entry
 	{
@@ -163,7 +295,7 @@ private:
 		osd_ticks_t     start;                      // start time
 	};
 
-	void reset(bool enabled) noexcept;
+	void reset(bool enabled, unsigned sample_interval) noexcept;
 	void update_text(running_machine &machine);
 
 	//-------------------------------------------------
@@ -179,6 +311,15 @@ private:
 			std::abort();
 		}
 
+		// when sampling, just keep track of where we are
+		if (m_sample_interval)
+		{
+			m_filoptr++;
+			m_filoptr->type = type;
+			m_current.store(type, std::memory_order_relaxed);
+			return;
+		}
+
 		// get current tick count
 		osd_ticks_t curticks = get_profile_ticks();
 
@@ -202,6 +343,14 @@ private:
 		if (UNEXPECTED(m_filoptr <= m_filo))
 			return;
 
+		// when sampling, just keep track of where we are
+		if (m_sample_interval)
+		{
+			m_filoptr--;
+			m_current.store(m_filoptr->type, std::memory_order_relaxed);
+			return;
+		}
+
 		// get current tick count
 		osd_ticks_t curticks = get_profile_ticks();
 
@@ -221,6 +370,9 @@ private:
 	attotime            m_text_time;                // profiler text last update
 	filo_entry          m_filo[32];                 // array of FILO entries
 	osd_ticks_t         m_data[PROFILER_TOTAL + 1]; // array of data
+	unsigned            m_sample_interval;          // sampling interval, or zero to time transitions
+	std::atomic<int>    m_current;                  // innermost type for the sampler
+	std::unique_ptr<sampler> m_sampler;             // sampling thread
 };
 
 
@@ -233,14 +385,15 @@ public:
 	{
 	private:
 		dummy_profiler_state &m_host;
+		runtime_trace::scope m_trace;
 
 	public:
 		scope(scope const &) = delete;
 		scope &operator=(scope const &) = delete;
 		scope(scope &&that) noexcept = default;
-		scope(dummy_profiler_state &host, profile_type type) noexcept : m_host(host) { }
+		scope(dummy_profiler_state &host, profile_type type) noexcept : m_host(host), m_trace(g_runtime_trace.start(type)) { }
 		~scope() { m_host.real_stop(); }
-		void stop() noexcept { }
+		void stop() noexcept { m_trace.stop(); }
 	};
 
 	// construction/destruction
@@ -251,10 +404,17 @@ public:
 	const char *text(running_machine &machine) { return ""; }
 
 	// enable/disable
-	void enable(bool state = true) noexcept { }
+	void enable(bool state = true, unsigned sample_interval = 0) noexcept { }
 
 	// start/stop
 	[[nodiscard]] auto start(profile_type type) noexcept { return scope(*this, type); }
+	profile_type register_scope(std::string_view name) { return profiler_register_scope(name); }
+
+	// time or samples counted in each scope since the display was last updated
+	std::vector<std::pair<std::string, u64> > counts(running_machine &machine) { return { }; }
+
+	// share of time for each scope since the display was last updated
+	std::vector<std::pair<std::string, double> > breakdown(running_machine &machine) { return { }; }
 
 private:
 	void real_stop() noexcept { }
@@ -271,11 +431,92 @@ typedef dummy_profiler_state profiler_state;
 
 
 
+// ======================> startup_trace
+
+// records how long startup phases take, for viewing as Chrome trace events;
+// unlike the profiler it's always compiled in and costs a flag test when off
+class startup_trace
+{
+public:
+	class scope
+	{
+	public:
+		scope(scope const &) = delete;
+		scope &operator=(scope const &) = delete;
+
+		template <typename Format, typename... Params>
+		scope(startup_trace &host, char const *category, Format &&fmt, Params &&... args)
+			: m_host(host)
+			, m_category(category)
+			, m_start(0)
+		{
+			if (m_host.enabled())
+			{
+				m_name = util::string_format(std::forward<Format>(fmt), std::forward<Params>(args)...);
+				m_start = osd_ticks();
+			}
+		}
+
+		~scope()
+		{
+			if (m_start)
+				m_host.add(m_category, std::move(m_name), m_start, osd_ticks());
+		}
+
+	private:
+		startup_trace &     m_host;
+		char const *        m_category;
+		std::string         m_name;
+		osd_ticks_t         m_start;
+	};
+
+	// construction/destruction
+	startup_trace();
+
+	// getters
+	bool enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+	// start recording, to be written to the given file when finished
+	void start(std::string_view filename);
+
+	// add a phase that has already completed
+	void add(char const *category, std::string &&name, osd_ticks_t start, osd_ticks_t end);
+
+	// stop recording and write the trace
+	void finish();
+
+	// record a phase lasting until the returned object is destroyed
+	template <typename Format, typename... Params>
+	[[nodiscard]] scope phase(char const *category, Format &&fmt, Params &&... args)
+	{
+		return scope(*this, category, std::forward<Format>(fmt), std::forward<Params>(args)...);
+	}
+
+private:
+	struct event
+	{
+		char const *        category;
+		std::string         name;
+		osd_ticks_t         start;
+		osd_ticks_t         end;
+		unsigned            thread;
+	};
+
+	std::atomic<bool>       m_enabled;
+	std::mutex              m_mutex;
+	std::string             m_filename;
+	osd_ticks_t             m_origin;
+	std::vector<event>      m_events;
+};
+
+
+
 //**************************************************************************
 //  GLOBAL VARIABLES
 //**************************************************************************
 
 extern profiler_state g_profiler;
+extern startup_trace g_startup_trace;
 
 
 #endif // MAME_EMU_PROFILER_H
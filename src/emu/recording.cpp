@@ -17,6 +17,8 @@
 #include "aviio.h"
 #include "png.h"
 
+#include <algorithm>
+
 
 namespace
 {
@@ -28,11 +30,13 @@ namespace
 		{
 		}
 
+		~avi_movie_recording();
+
 		bool initialize(running_machine &machine, std::unique_ptr<emu_file> &&file, int32_t width, int32_t height);
-		virtual bool add_sound_to_recording(const s16 *sound, int numsamples) override;
 
 	protected:
 		virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) override;
+		virtual bool append_sound_samples(const s16 *sound, int numsamples) override;
 
 	private:
 		avi_file::ptr m_avi_file; // handle to the open movie file
@@ -46,10 +50,10 @@ namespace
 		~mng_movie_recording();
 
 		bool initialize(std::unique_ptr<emu_file> &&file, bitmap_t &snap_bitmap);
-		virtual bool add_sound_to_recording(const s16 *sound, int numsamples) override;
 
 	protected:
 		virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) override;
+		virtual bool append_sound_samples(const s16 *sound, int numsamples) override;
 
 	private:
 		std::unique_ptr<emu_file> m_mng_file; // handle to the open movie file
@@ -71,6 +75,10 @@ movie_recording::movie_recording(screen_device *screen)
 	, m_frame_period(attotime::zero)
 	, m_next_frame_time(attotime::zero)
 	, m_frame(0)
+	, m_queue_head(0)
+	, m_queue_count(0)
+	, m_exiting(false)
+	, m_failed(false)
 {
 }
 
@@ -81,30 +89,166 @@ movie_recording::movie_recording(screen_device *screen)
 
 movie_recording::~movie_recording()
 {
+	// derived classes should already have done this
+	stop_encoder();
 }
 
 
 //-------------------------------------------------
-//  movie_recording::append_video_frame
+//  movie_recording::append_video_frame - queue
+//  a copy of the bitmap for the encoder thread,
+//  covering every movie frame up to curtime
 //-------------------------------------------------
 
 bool movie_recording::append_video_frame(bitmap_rgb32 &bitmap, attotime curtime)
 {
+	// count how many movie frames this bitmap covers
+	int repeat = 0;
+	while (next_frame_time() <= curtime)
+	{
+		repeat++;
+		set_next_frame_time(next_frame_time() + frame_period());
+	}
+	if (repeat == 0)
+		return !m_failed;
+
 	// identify the palette
 	bool has_palette = screen() && screen()->has_palette();
 	const rgb_t *palette = has_palette ? screen()->palette().palette()->entry_list_adjusted() : nullptr;
 	int palette_entries = has_palette ? screen()->palette().entries() : 0;
 
-	// keep appending frames until we're at curtime
-	while (next_frame_time() <= curtime)
+	// copy the frame into a free slot; the encoder thread owns it once committed
+	queued_item &item = begin_item();
+	item.is_video = true;
+	item.repeat = repeat;
+	if (item.bitmap.width() != bitmap.width() || item.bitmap.height() != bitmap.height())
+		item.bitmap.allocate(bitmap.width(), bitmap.height());
+	for (int y = 0; y < bitmap.height(); y++)
+		std::copy_n(&bitmap.pix(y), bitmap.width(), &item.bitmap.pix(y));
+	item.palette.assign(palette, palette + palette_entries);
+	commit_item();
+
+	return !m_failed;
+}
+
+
+//-------------------------------------------------
+//  movie_recording::add_sound_to_recording -
+//  queue a block of interleaved stereo samples
+//  for the encoder thread
+//-------------------------------------------------
+
+bool movie_recording::add_sound_to_recording(const s16 *sound, int numsamples)
+{
+	auto profile = g_profiler.start(PROFILER_MOVIE_REC);
+
+	queued_item &item = begin_item();
+	item.is_video = false;
+	item.sound.assign(sound, sound + numsamples * 2);
+	item.numsamples = numsamples;
+	commit_item();
+
+	return !m_failed;
+}
+
+
+//-------------------------------------------------
+//  movie_recording::begin_item - wait for a free
+//  slot in the ring, starting the encoder thread
+//  on first use
+//-------------------------------------------------
+
+movie_recording::queued_item &movie_recording::begin_item()
+{
+	if (!m_thread.joinable())
+		m_thread = std::thread([this] () { encoder_thread(); });
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_space_cond.wait(lock, [this] () { return m_queue_count < QUEUE_DEPTH; });
+	return m_queue[(m_queue_head + m_queue_count) % QUEUE_DEPTH];
+}
+
+
+//-------------------------------------------------
+//  movie_recording::commit_item - hand the item
+//  returned by begin_item to the encoder thread
+//-------------------------------------------------
+
+void movie_recording::commit_item()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queue_count++;
+	}
+	m_work_cond.notify_one();
+}
+
+
+//-------------------------------------------------
+//  movie_recording::stop_encoder - write out any
+//  pending work and stop the encoder thread
+//-------------------------------------------------
+
+void movie_recording::stop_encoder()
+{
+	if (!m_thread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_exiting = true;
+	}
+	m_work_cond.notify_one();
+	m_thread.join();
+}
+
+
+//-------------------------------------------------
+//  movie_recording::encoder_thread - write queued
+//  frames and sound off the emulation thread
+//-------------------------------------------------
+
+void movie_recording::encoder_thread()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;)
+	{
+		m_work_cond.wait(lock, [this] () { return m_queue_count != 0 || m_exiting; });
+		if (m_queue_count == 0)
+			break;
+
+		// the head slot is ours until we release it
+		queued_item &item = m_queue[m_queue_head];
+		lock.unlock();
+		if (!m_failed && !process_item(item))
+			m_failed = true;
+		lock.lock();
+
+		m_queue_head = (m_queue_head + 1) % QUEUE_DEPTH;
+		m_queue_count--;
+		m_space_cond.notify_one();
+	}
+}
+
+
+//-------------------------------------------------
+//  movie_recording::process_item - write a single
+//  queued item to the output
+//-------------------------------------------------
+
+bool movie_recording::process_item(queued_item &item)
+{
+	if (!item.is_video)
+		return append_sound_samples(item.sound.data(), item.numsamples);
+
+	int const palette_entries = item.palette.size();
+	rgb_t const *const palette = palette_entries ? &item.palette[0] : nullptr;
+	for (int i = 0; i < item.repeat; i++)
 	{
 		// append this bitmap as a single frame
-		if (!append_single_video_frame(bitmap, palette, palette_entries))
+		if (!append_single_video_frame(item.bitmap, palette, palette_entries))
 			return false;
 		m_frame++;
-
-		// advance time
-		set_next_frame_time(next_frame_time() + frame_period());
 	}
 	return true;
 }
@@ -166,6 +310,16 @@ const char *movie_recording::format_file_extension(movie_recording::format fmt)
 }
 
 
+//-------------------------------------------------
+//  avi_movie_recording - destructor
+//-------------------------------------------------
+
+avi_movie_recording::~avi_movie_recording()
+{
+	stop_encoder();
+}
+
+
 //-------------------------------------------------
 //  avi_movie_recording::initialize
 //-------------------------------------------------
@@ -217,13 +371,11 @@ bool avi_movie_recording::append_single_video_frame(bitmap_rgb32 &bitmap, const
 
 
 //-------------------------------------------------
-//  avi_movie_recording::append_video_frame
+//  avi_movie_recording::append_sound_samples
 //-------------------------------------------------
 
-bool avi_movie_recording::add_sound_to_recording(const s16 *sound, int numsamples)
+bool avi_movie_recording::append_sound_samples(const s16 *sound, int numsamples)
 {
-	auto profile = g_profiler.start(PROFILER_MOVIE_REC);
-
 	// write the next frame
 	avi_file::error avierr = m_avi_file->append_sound_samples(0, sound + 0, numsamples, 1);
 	if (avierr == avi_file::error::NONE)
@@ -250,6 +402,7 @@ mng_movie_recording::mng_movie_recording(screen_device *screen, std::map<std::st
 
 mng_movie_recording::~mng_movie_recording()
 {
+	stop_encoder();
 	if (m_mng_file)
 		util::mng_capture_stop(*m_mng_file);
 }
@@ -294,10 +447,10 @@ bool mng_movie_recording::append_single_video_frame(bitmap_rgb32 &bitmap, const
 
 
 //-------------------------------------------------
-//  mng_movie_recording::add_sound_to_recording
+//  mng_movie_recording::append_sound_samples
 //-------------------------------------------------
 
-bool mng_movie_recording::add_sound_to_recording(const s16 *sound, int numsamples)
+bool mng_movie_recording::append_sound_samples(const s16 *sound, int numsamples)
 {
 	// not supported; do nothing
 	return true;
@@ -17,7 +17,13 @@
 #ifndef MAME_EMU_RECORDING_H
 #define MAME_EMU_RECORDING_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "attotime.h"
 #include "palette.h"
@@ -54,9 +60,7 @@ public:
 
 	// methods
 	bool append_video_frame(bitmap_rgb32 &bitmap, attotime curtime);
-
-	// virtuals
-	virtual bool add_sound_to_recording(const s16 *sound, int numsamples) = 0;
+	bool add_sound_to_recording(const s16 *sound, int numsamples);
 
 	// statics
 	static movie_recording::ptr create(running_machine &machine, screen_device *screen, format fmt, std::unique_ptr<emu_file> &&file, bitmap_rgb32 &snap_bitmap);
@@ -68,18 +72,54 @@ protected:
 	movie_recording(const movie_recording &) = delete;
 	movie_recording(movie_recording &&) = delete;
 
-	// virtuals
+	// virtuals, called on the encoder thread
 	virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) = 0;
+	virtual bool append_sound_samples(const s16 *sound, int numsamples) = 0;
 
 	// accessors
 	int current_frame() const { return m_frame; }
 	void set_frame_period(attotime time) { m_frame_period = time; }
 
+	// drain queued work and stop the encoder thread; derived classes must
+	// call this from their destructors before releasing their outputs
+	void stop_encoder();
+
 private:
+	// number of frames/sound blocks that may be in flight before the emulation thread waits
+	static constexpr int QUEUE_DEPTH = 8;
+
+	// a unit of work handed to the encoder thread
+	struct queued_item
+	{
+		bool                is_video = false;       // true for a video frame, false for sound
+		int                 repeat = 0;             // number of movie frames this bitmap covers
+		bitmap_rgb32        bitmap;                 // private copy of the frame
+		std::vector<rgb_t>  palette;                // private copy of the palette
+		std::vector<s16>    sound;                  // interleaved stereo samples
+		int                 numsamples = 0;         // number of sample pairs
+	};
+
+	// internal helpers
+	queued_item &begin_item();
+	void commit_item();
+	void encoder_thread();
+	bool process_item(queued_item &item);
+
 	screen_device * m_screen;               // screen associated with this movie (can be nullptr)
 	attotime        m_frame_period;         // duration of movie frame
 	attotime        m_next_frame_time;      // time of next frame
 	int             m_frame;                // current movie frame number
+
+	// encoder thread state
+	std::array<queued_item, QUEUE_DEPTH> m_queue; // ring of pending work
+	int             m_queue_head;           // index of the oldest pending item
+	int             m_queue_count;          // number of pending items
+	bool            m_exiting;              // set to ask the encoder thread to finish
+	std::atomic<bool> m_failed;             // set by the encoder thread on a write error
+	std::mutex      m_mutex;                // protects the ring indices and m_exiting
+	std::condition_variable m_work_cond;    // signalled when work is queued or on exit
+	std::condition_variable m_space_cond;   // signalled when a ring slot is freed
+	std::thread     m_thread;               // encoder thread
 };
 
 
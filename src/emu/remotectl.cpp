@@ -0,0 +1,443 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    remotectl.cpp
+
+    Binary WebSocket protocol for controlling a running machine.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "remotectl.h"
+
+#include "screen.h"
+
+#include "multibyte.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+//**************************************************************************
+//    CONSTANTS
+//**************************************************************************
+
+namespace {
+
+constexpr char const ENDPOINT[] = "/api/remote";
+constexpr int OPCODE_BINARY = 2;
+constexpr int COMPRESSION_LEVEL = 1;
+constexpr u32 MAX_MEMORY_LENGTH = 0x10000;
+
+
+//-------------------------------------------------
+//  message_reader - pull little-endian values
+//  out of a command, noting if it runs short
+//-------------------------------------------------
+
+class message_reader
+{
+public:
+	message_reader(std::string_view data) : m_data(data), m_valid(true) { }
+
+	bool valid() const { return m_valid; }
+
+	u8 u8_value()
+	{
+		if (!check(1))
+			return 0;
+		u8 const result = u8(m_data[0]);
+		m_data.remove_prefix(1);
+		return result;
+	}
+
+	u32 u32_value()
+	{
+		if (!check(4))
+			return 0;
+		u32 const result = get_u32le(reinterpret_cast<u8 const *>(m_data.data()));
+		m_data.remove_prefix(4);
+		return result;
+	}
+
+	std::string string_value()
+	{
+		std::size_t const length = u8_value();
+		if (!check(length))
+			return std::string();
+		std::string result(m_data.substr(0, length));
+		m_data.remove_prefix(length);
+		return result;
+	}
+
+private:
+	bool check(std::size_t length)
+	{
+		if (m_valid && (m_data.length() < length))
+			m_valid = false;
+		return m_valid;
+	}
+
+	std::string_view m_data;
+	bool m_valid;
+};
+
+
+//-------------------------------------------------
+//  append_u16/u32/u64 - add little-endian values
+//  to an outgoing message
+//-------------------------------------------------
+
+void append_u16(std::string &message, u16 value)
+{
+	message.resize(message.size() + 2);
+	put_u16le(reinterpret_cast<u8 *>(&message[message.size() - 2]), value);
+}
+
+void append_u32(std::string &message, u32 value)
+{
+	message.resize(message.size() + 4);
+	put_u32le(reinterpret_cast<u8 *>(&message[message.size() - 4]), value);
+}
+
+void append_u64(std::string &message, u64 value)
+{
+	message.resize(message.size() + 8);
+	put_u64le(reinterpret_cast<u8 *>(&message[message.size() - 8]), value);
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//    SUBSCRIPTIONS
+//**************************************************************************
+
+struct remote_control::subscription
+{
+	u32                 id = 0;
+
+	// memory subscriptions
+	address_space *     space = nullptr;
+	offs_t              start = 0;
+	u32                 length = 0;
+
+	// screen subscriptions
+	screen_device *     screen = nullptr;
+	unsigned            every = 1;
+	unsigned            countdown = 0;
+
+	// the emulation thread fills the capture while the subscription isn't busy
+	std::vector<u8>     captured;
+	s32                 width = 0;
+	s32                 height = 0;
+	std::atomic<bool>   busy = false;
+
+	// what the client last received, only used on the server thread
+	std::vector<u8>     previous;
+	s32                 previous_width = 0;
+	s32                 previous_height = 0;
+};
+
+
+
+//**************************************************************************
+//    REMOTE CONTROL
+//**************************************************************************
+
+//-------------------------------------------------
+//  remote_control - constructor
+//-------------------------------------------------
+
+remote_control::remote_control(running_machine &machine, http_manager &http)
+	: m_machine(machine)
+	, m_http(http)
+	, m_mailbox(std::make_shared<mailbox>())
+	, m_frame(0)
+{
+	// the server may still call these after the machine has gone, so they only see the mailbox
+	mailbox_ptr const box(m_mailbox);
+	m_http.add_endpoint(
+			ENDPOINT,
+			nullptr,
+			[box] (http_manager::websocket_connection_ptr connection, std::string const &payload, int opcode)
+			{
+				std::lock_guard<std::mutex> lock(box->mutex);
+				if (box->open)
+					box->commands.emplace_back(mailbox::command{ std::move(connection), payload, false });
+			},
+			[box] (http_manager::websocket_connection_ptr connection, int status, std::string const &reason)
+			{
+				std::lock_guard<std::mutex> lock(box->mutex);
+				if (box->open)
+					box->commands.emplace_back(mailbox::command{ std::move(connection), std::string(), true });
+			},
+			[box] (http_manager::websocket_connection_ptr connection, std::error_code const &error_code)
+			{
+				std::lock_guard<std::mutex> lock(box->mutex);
+				if (box->open)
+					box->commands.emplace_back(mailbox::command{ std::move(connection), std::string(), true });
+			});
+
+	machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&remote_control::frame, this));
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&remote_control::exit, this));
+}
+
+
+//-------------------------------------------------
+//  ~remote_control - destructor
+//-------------------------------------------------
+
+remote_control::~remote_control()
+{
+	exit();
+}
+
+
+//-------------------------------------------------
+//  exit - stop accepting commands and drop all
+//  subscriptions
+//-------------------------------------------------
+
+void remote_control::exit()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mailbox->mutex);
+		m_mailbox->open = false;
+		m_mailbox->commands.clear();
+	}
+	m_http.remove_endpoint(ENDPOINT);
+	m_clients.clear();
+}
+
+
+//-------------------------------------------------
+//  frame - apply commands that arrived during the
+//  frame and capture subscribed state
+//-------------------------------------------------
+
+void remote_control::frame()
+{
+	++m_frame;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mailbox->mutex);
+		std::swap(m_pending, m_mailbox->commands);
+	}
+	for (mailbox::command const &command : m_pending)
+	{
+		if (command.closed)
+			m_clients.erase(command.connection);
+		else
+			handle_command(command.connection, command.payload);
+	}
+	m_pending.clear();
+
+	for (auto const &[connection, subscriptions] : m_clients)
+	{
+		for (subscription_ptr const &sub : subscriptions)
+			capture(connection, sub);
+	}
+}
+
+
+//-------------------------------------------------
+//  handle_command - act on a command from a
+//  client
+//-------------------------------------------------
+
+void remote_control::handle_command(http_manager::websocket_connection_ptr const &connection, std::string_view payload)
+{
+	message_reader reader(payload);
+	std::vector<subscription_ptr> &subscriptions(m_clients[connection]);
+	switch (reader.u8_value())
+	{
+	case CMD_INPUT:
+		{
+			std::string const tag(reader.string_value());
+			u32 const mask(reader.u32_value());
+			u32 const value(reader.u32_value());
+			auto const port(reader.valid() ? m_machine.ioport().ports().find(tag) : m_machine.ioport().ports().end());
+			ioport_field *const field((m_machine.ioport().ports().end() != port) ? port->second->field(mask) : nullptr);
+			if (field)
+				field->set_value(value);
+		}
+		break;
+
+	case CMD_MEMORY:
+		{
+			auto sub(std::make_shared<subscription>());
+			sub->id = reader.u32_value();
+			std::string const tag(reader.string_value());
+			int const spacenum(reader.u8_value());
+			sub->start = reader.u32_value();
+			sub->length = reader.u32_value();
+			device_t *const device(reader.valid() ? m_machine.root_device().subdevice(tag) : nullptr);
+			device_memory_interface *memory;
+			if ((sub->length <= MAX_MEMORY_LENGTH) && device && device->interface(memory) && memory->has_space(spacenum))
+			{
+				sub->space = &memory->space(spacenum);
+				subscriptions.emplace_back(std::move(sub));
+			}
+		}
+		break;
+
+	case CMD_SCREEN:
+		{
+			auto sub(std::make_shared<subscription>());
+			sub->id = reader.u32_value();
+			std::string const tag(reader.string_value());
+			sub->every = std::max<unsigned>(reader.u8_value(), 1);
+			sub->screen = reader.valid() ? m_machine.root_device().subdevice<screen_device>(tag) : nullptr;
+			if (sub->screen)
+				subscriptions.emplace_back(std::move(sub));
+		}
+		break;
+
+	case CMD_UNSUBSCRIBE:
+		{
+			u32 const id(reader.u32_value());
+			subscriptions.erase(
+					std::remove_if(subscriptions.begin(), subscriptions.end(), [id] (subscription_ptr const &sub) { return sub->id == id; }),
+					subscriptions.end());
+		}
+		break;
+	}
+}
+
+
+//-------------------------------------------------
+//  capture - copy subscribed state and hand it to
+//  the server thread to encode and send
+//-------------------------------------------------
+
+void remote_control::capture(http_manager::websocket_connection_ptr const &connection, subscription_ptr const &sub)
+{
+	// never wait for the server thread to catch up
+	if (sub->busy.load(std::memory_order_acquire))
+		return;
+
+	if (sub->space)
+	{
+		address_space &space(*sub->space);
+		sub->captured.resize(sub->length);
+		u8 *dest = sub->captured.data();
+
+		// directly mapped byte-wide memory can be copied in one go
+		u8 const *const first = ((space.data_width() == 8) && !space.addr_shift() && sub->length) ? reinterpret_cast<u8 const *>(space.get_read_ptr(sub->start)) : nullptr;
+		if (first && (reinterpret_cast<u8 const *>(space.get_read_ptr(sub->start + sub->length - 1)) == (first + sub->length - 1)))
+		{
+			std::memcpy(dest, first, sub->length);
+		}
+		else
+		{
+			auto dis = m_machine.disable_side_effects();
+			for (u32 i = 0; sub->length > i; ++i)
+				*dest++ = space.read_byte(sub->start + i);
+		}
+
+		sub->busy.store(true, std::memory_order_release);
+		if (!m_http.post([connection, sub, frame = m_frame] () { encode_memory(connection, *sub, frame); }))
+			sub->busy.store(false, std::memory_order_release);
+	}
+	else if (sub->screen)
+	{
+		if (sub->countdown)
+		{
+			--sub->countdown;
+			return;
+		}
+		sub->countdown = sub->every - 1;
+
+		rectangle const &visarea(sub->screen->visible_area());
+		sub->width = visarea.width();
+		sub->height = visarea.height();
+		sub->captured.resize(std::size_t(sub->width) * sub->height * sizeof(u32));
+		sub->screen->pixels(reinterpret_cast<u32 *>(sub->captured.data()));
+
+		sub->busy.store(true, std::memory_order_release);
+		if (!m_http.post([connection, sub, frame = sub->screen->frame_number()] () { encode_screen(connection, *sub, frame); }))
+			sub->busy.store(false, std::memory_order_release);
+	}
+}
+
+
+//-------------------------------------------------
+//  encode_memory - send subscribed memory if it
+//  has changed (runs on the server thread)
+//-------------------------------------------------
+
+void remote_control::encode_memory(http_manager::websocket_connection_ptr const &connection, subscription &sub, u64 frame)
+{
+	if (sub.captured != sub.previous)
+	{
+		std::string message(1, char(MSG_MEMORY));
+		append_u32(message, sub.id);
+		append_u64(message, frame);
+		message.append(reinterpret_cast<char const *>(sub.captured.data()), sub.captured.size());
+		connection->send_message(message, OPCODE_BINARY);
+		std::swap(sub.previous, sub.captured);
+	}
+	sub.busy.store(false, std::memory_order_release);
+}
+
+
+//-------------------------------------------------
+//  encode_screen - send the rows of a screen that
+//  have changed since the last frame sent, zstd
+//  compressed (runs on the server thread)
+//-------------------------------------------------
+
+void remote_control::encode_screen(http_manager::websocket_connection_ptr const &connection, subscription &sub, u64 frame)
+{
+	std::size_t const pitch(std::size_t(sub.width) * sizeof(u32));
+	bool const resized((sub.width != sub.previous_width) || (sub.height != sub.previous_height) || (sub.previous.size() != sub.captured.size()));
+
+	// find runs of changed rows, gathering their pixels together
+	std::vector<std::pair<u16, u16> > runs;
+	std::vector<u8> rows;
+	for (s32 y = 0; sub.height > y; ++y)
+	{
+		u8 const *const row(&sub.captured[y * pitch]);
+		if (!resized && !std::memcmp(row, &sub.previous[y * pitch], pitch))
+			continue;
+		if (!runs.empty() && ((runs.back().first + runs.back().second) == y))
+			++runs.back().second;
+		else
+			runs.emplace_back(u16(y), u16(1));
+		rows.insert(rows.end(), row, row + pitch);
+	}
+
+	if (!runs.empty())
+	{
+		std::string message(1, char(MSG_SCREEN));
+		append_u32(message, sub.id);
+		append_u64(message, frame);
+		append_u16(message, u16(sub.width));
+		append_u16(message, u16(sub.height));
+		append_u16(message, u16(runs.size()));
+		for (auto const &[first, count] : runs)
+		{
+			append_u16(message, first);
+			append_u16(message, count);
+		}
+
+		std::size_t const header(message.size());
+		message.resize(header + 4 + ZSTD_compressBound(rows.size()));
+		std::size_t const compressed(ZSTD_compress(&message[header + 4], message.size() - header - 4, rows.data(), rows.size(), COMPRESSION_LEVEL));
+		if (!ZSTD_isError(compressed))
+		{
+			put_u32le(reinterpret_cast<u8 *>(&message[header]), u32(compressed));
+			message.resize(header + 4 + compressed);
+			connection->send_message(message, OPCODE_BINARY);
+			std::swap(sub.previous, sub.captured);
+			sub.previous_width = sub.width;
+			sub.previous_height = sub.height;
+		}
+	}
+	sub.busy.store(false, std::memory_order_release);
+}
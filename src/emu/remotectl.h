@@ -0,0 +1,105 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    remotectl.h
+
+    Binary WebSocket protocol for controlling a running machine.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_EMU_REMOTECTL_H
+#define MAME_EMU_REMOTECTL_H
+
+#include "http.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//**************************************************************************
+//    TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> remote_control
+
+// Messages are binary WebSocket frames starting with a command byte, with
+// all values little-endian and strings prefixed by a u8 length.
+//
+// client to machine:
+//   01 port:str mask:u32 value:u32                         set an input field
+//   02 id:u32 device:str space:u8 start:u32 length:u32    subscribe to memory
+//   03 id:u32 screen:str every:u8                          subscribe to a screen
+//   04 id:u32                                              unsubscribe
+//
+// machine to client:
+//   82 id:u32 frame:u64 data                               memory that changed
+//   83 id:u32 frame:u64 width:u16 height:u16 runs:u16
+//      (first:u16 count:u16)*runs size:u32 zstd-data       rows that changed
+//
+// Captures are taken at the end of each frame; comparing with what was last
+// sent and compressing happen on the HTTP server thread.  A subscription
+// still being encoded skips new captures rather than holding up emulation.
+// Memory subscriptions longer than 64 KiB are ignored.
+class remote_control
+{
+public:
+	remote_control(running_machine &machine, http_manager &http);
+	~remote_control();
+
+private:
+	enum : u8
+	{
+		CMD_INPUT           = 0x01,
+		CMD_MEMORY          = 0x02,
+		CMD_SCREEN          = 0x03,
+		CMD_UNSUBSCRIBE     = 0x04,
+		MSG_MEMORY          = 0x82,
+		MSG_SCREEN          = 0x83
+	};
+
+	struct subscription;
+	using subscription_ptr = std::shared_ptr<subscription>;
+
+	// connections and commands arrive on the server thread, and are
+	// handed over to the emulation thread
+	struct mailbox
+	{
+		struct command
+		{
+			http_manager::websocket_connection_ptr  connection;
+			std::string                             payload;
+			bool                                    closed;
+		};
+
+		std::mutex              mutex;
+		std::vector<command>    commands;
+		bool                    open = true;
+	};
+	using mailbox_ptr = std::shared_ptr<mailbox>;
+
+	void frame();
+	void exit();
+	void handle_command(http_manager::websocket_connection_ptr const &connection, std::string_view payload);
+	void capture(http_manager::websocket_connection_ptr const &connection, subscription_ptr const &sub);
+
+	static void encode_memory(http_manager::websocket_connection_ptr const &connection, subscription &sub, u64 frame);
+	static void encode_screen(http_manager::websocket_connection_ptr const &connection, subscription &sub, u64 frame);
+
+	running_machine &   m_machine;
+	http_manager &      m_http;
+	mailbox_ptr         m_mailbox;
+	std::vector<mailbox::command> m_pending;
+	u64                 m_frame;
+
+	// subscriptions for each open connection, only touched on the emulation thread
+	std::unordered_map<http_manager::websocket_connection_ptr, std::vector<subscription_ptr> > m_clients;
+};
+
+#endif // MAME_EMU_REMOTECTL_H
@@ -51,6 +51,7 @@
 
 #include "ui/uimain.h"
 
+#include "util/hashing.h"
 #include "util/ioprocsfilter.h"
 #include "util/language.h"
 #include "util/path.h"
@@ -66,6 +67,9 @@
 
 #define INTERNAL_FLAG_CHAR      0x00000001
 
+// element geometry not used for this many frames is dropped from the cache
+constexpr u64 ELEMENT_CACHE_MAX_AGE = 256;
+
 enum
 {
 	COMPONENT_TYPE_IMAGE = 0,
@@ -914,6 +918,7 @@ template <typename T> render_target::render_target(render_manager &manager, T &&
 	, m_maxtexheight(65536)
 	, m_transform_container(true)
 	, m_external_artwork(false)
+	, m_element_cache_frame(0)
 {
 	// determine the base layer configuration based on options
 	m_base_layerconfig.set_zoom_to_screen(manager.machine().options().artwork_crop());
@@ -1471,6 +1476,18 @@ render_primitive_list &render_target::get_primitives()
 		add_container_primitives(list, root_xform, ui_xform, m_manager.ui_container(), BLENDMODE_ALPHA);
 	}
 
+	// forget geometry for items that have gone away or left the view
+	if (!(++m_element_cache_frame % ELEMENT_CACHE_MAX_AGE))
+	{
+		for (auto it = m_element_cache.begin(); it != m_element_cache.end(); )
+		{
+			if ((m_element_cache_frame - it->second.lastframe) > ELEMENT_CACHE_MAX_AGE)
+				it = m_element_cache.erase(it);
+			else
+				++it;
+		}
+	}
+
 	// optimize the list before handing it off
 	add_clear_and_optimize_primitive_list(list);
 	list.release_lock();
@@ -1655,6 +1672,7 @@ void render_target::update_layer_config()
 
 void render_target::load_layout_files(const internal_layout *layoutfile, bool singlefile)
 {
+	auto const trace(g_startup_trace.phase("layout", "load layout files"));
 	bool have_artwork = false;
 
 	// if there's an explicit file, load that first
@@ -1669,6 +1687,7 @@ void render_target::load_layout_files(const internal_layout *layoutfile, bool si
 
 void render_target::load_layout_files(util::xml::data_node const &rootnode, bool singlefile)
 {
+	auto const trace(g_startup_trace.phase("layout", "load layout files"));
 	bool have_artwork = false;
 
 	// if there's an explicit file, load that first
@@ -1686,9 +1705,12 @@ void render_target::load_additional_layout_files(const char *basename, bool have
 
 	m_external_artwork = false;
 
+	// targets that ignore art don't need to look for external artwork
+	bool const want_art = !(m_flags & RENDER_CREATE_NO_ART);
+
 	// if override_artwork defined, load that and skip artwork other than default
 	const char *const override_art = m_manager.machine().options().override_artwork();
-	if (override_art && *override_art)
+	if (want_art && override_art && *override_art)
 	{
 		if (load_layout_file(override_art, override_art))
 			m_external_artwork = true;
@@ -1702,13 +1724,16 @@ void render_target::load_additional_layout_files(const char *basename, bool have
 	if (!m_external_artwork)
 	{
 		// try to load a file based on the driver name
-		if (!load_layout_file(basename, system.name))
-			m_external_artwork |= load_layout_file(basename, "default");
-		else
-			m_external_artwork = true;
+		if (want_art)
+		{
+			if (!load_layout_file(basename, system.name))
+				m_external_artwork |= load_layout_file(basename, "default");
+			else
+				m_external_artwork = true;
+		}
 
 		// try to load another file based on the parent driver name
-		int cloneof = driver_list::clone(system);
+		int cloneof = want_art ? driver_list::clone(system) : -1;
 		while (0 <= cloneof)
 		{
 			if (!m_external_artwork || driver_list::driver(cloneof).flags & MACHINE_IS_BIOS_ROOT)
@@ -1735,7 +1760,7 @@ void render_target::load_additional_layout_files(const char *basename, bool have
 		have_artwork |= m_external_artwork;
 
 		// Use fallback artwork if defined and no artwork has been found yet
-		if (!have_artwork)
+		if (want_art && !have_artwork)
 		{
 			const char *const fallback_art = m_manager.machine().options().fallback_artwork();
 			if (fallback_art && *fallback_art)
@@ -2106,6 +2131,26 @@ void render_target::load_additional_layout_files(const char *basename, bool have
 //-------------------------------------------------
 
 bool render_target::load_layout_file(const char *dirname, const internal_layout &layout_data, device_t *device)
+{
+	// other targets may have parsed it already
+	u64 const key((u64(layout_data.compressed_size) << 32) | u32(util::crc32_creator::simple(layout_data.data, layout_data.compressed_size)));
+	std::shared_ptr<util::xml::file const> &rootnode(m_manager.m_layout_xml[key]);
+	if (!rootnode)
+		rootnode = parse_layout_data(layout_data);
+	if (!rootnode)
+		return false;
+
+	// if we didn't get a properly-formatted XML file, record a warning and exit
+	if (!load_layout_file(device ? *device : m_manager.machine().root_device(), *rootnode, m_manager.machine().options().art_path(), dirname))
+	{
+		osd_printf_warning("render_target::load_layout_file: Improperly formatted XML string, ignoring\n");
+		return false;
+	}
+
+	return true;
+}
+
+std::unique_ptr<util::xml::file> render_target::parse_layout_data(const internal_layout &layout_data)
 {
 	// +1 to ensure data is terminated for XML parser
 	std::unique_ptr<u8 []> tempout(new (std::nothrow) u8 [layout_data.decompressed_size + 1]);
@@ -2113,7 +2158,7 @@ bool render_target::load_layout_file(const char *dirname, const internal_layout
 	if (!tempout || !inflater)
 	{
 		osd_printf_error("render_target::load_layout_file: not enough memory to decompress layout\n");
-		return false;
+		return nullptr;
 	}
 
 	size_t decompressed = 0;
@@ -2131,7 +2176,7 @@ bool render_target::load_layout_file(const char *dirname, const internal_layout
 					err.category().name(),
 					err.value(),
 					err.message());
-			return false;
+			return nullptr;
 		}
 		if (!actual && (layout_data.decompressed_size < decompressed))
 		{
@@ -2146,17 +2191,7 @@ bool render_target::load_layout_file(const char *dirname, const internal_layout
 	inflater.reset();
 
 	tempout[decompressed] = 0U;
-	util::xml::file::ptr rootnode(util::xml::file::string_read(reinterpret_cast<char const *>(tempout.get()), nullptr));
-	tempout.reset();
-
-	// if we didn't get a properly-formatted XML file, record a warning and exit
-	if (!load_layout_file(device ? *device : m_manager.machine().root_device(), *rootnode, m_manager.machine().options().art_path(), dirname))
-	{
-		osd_printf_warning("render_target::load_layout_file: Improperly formatted XML string, ignoring\n");
-		return false;
-	}
-
-	return true;
+	return util::xml::file::string_read(reinterpret_cast<char const *>(tempout.get()), nullptr);
 }
 
 bool render_target::load_layout_file(const char *dirname, const char *filename)
@@ -2176,8 +2211,17 @@ bool render_target::load_layout_file(const char *dirname, const char *filename)
 	bool result(false);
 	for (std::error_condition filerr = layoutfile.open(fname); !filerr; filerr = layoutfile.open_next())
 	{
-		// read the file and parse as XML
-		util::xml::file::ptr const rootnode(util::xml::file::read(layoutfile, &parseopt));
+		// read the file, and parse it as XML unless another target already has
+		std::string text(layoutfile.size(), '\0');
+		if (layoutfile.read(text.data(), text.size()) != text.size())
+		{
+			osd_printf_warning("Error reading XML layout file '%s', ignoring\n", filename);
+			continue;
+		}
+		u64 const key((u64(text.size()) << 32) | u32(util::crc32_creator::simple(text.data(), text.size())));
+		std::shared_ptr<util::xml::file const> &rootnode(m_manager.m_layout_xml[key]);
+		if (!rootnode)
+			rootnode = util::xml::file::string_read(text.c_str(), &parseopt);
 		if (rootnode)
 		{
 			// extract directory name from location of layout file
@@ -2520,78 +2564,134 @@ void render_target::add_element_primitives(render_primitive_list &list, const ob
 
 	// get a pointer to the relevant texture
 	render_texture *texture = element.state_texture(state);
-	if (texture)
-	{
-		render_primitive *prim = list.alloc(render_primitive::QUAD);
+	if (!texture)
+		return;
 
-		// configure the basics
+	u32 const flags =
+			PRIMFLAG_TEXORIENT(xform.orientation) |
+			PRIMFLAG_TEXFORMAT(texture->format()) |
+			PRIMFLAG_BLENDMODE(blendmode) |
+			PRIMFLAG_TEXWRAP((item.scroll_wrap_x() || item.scroll_wrap_y()) ? 1 : 0);
+	float const xsize(item.scroll_size_x());
+	float const ysize(item.scroll_size_y());
+	float const xpos(item.scroll_pos_x());
+	float const ypos(item.scroll_pos_y());
+
+	// static artwork lands here with the same inputs every frame, so the
+	// geometry, texture coordinates and clipping only need working out once
+	element_cache &cache(m_element_cache[&item]);
+	cache.lastframe = m_element_cache_frame;
+	bool const hit =
+			(cache.texture == texture) && (cache.flags == flags) && (cache.blendmode == blendmode) &&
+			(cache.xoffs == xform.xoffs) && (cache.yoffs == xform.yoffs) && (cache.xscale == xform.xscale) && (cache.yscale == xform.yscale) &&
+			(cache.orientation == xform.orientation) && (cache.maxtexwidth == m_maxtexwidth) && (cache.maxtexheight == m_maxtexheight) &&
+			(cache.scroll_size_x == xsize) && (cache.scroll_size_y == ysize) && (cache.scroll_pos_x == xpos) && (cache.scroll_pos_y == ypos) &&
+			(cache.target_bounds.x0 == m_bounds.x0) && (cache.target_bounds.y0 == m_bounds.y0) && (cache.target_bounds.x1 == m_bounds.x1) && (cache.target_bounds.y1 == m_bounds.y1);
+	if (hit)
+	{
+		// nothing visible, and no need to scale a texture for it either
+		if (cache.clipped)
+			return;
+
+		render_primitive *prim = list.alloc(render_primitive::QUAD);
 		prim->color = xform.color;
-		prim->flags =
-				PRIMFLAG_TEXORIENT(xform.orientation) |
-				PRIMFLAG_TEXFORMAT(texture->format()) |
-				PRIMFLAG_BLENDMODE(blendmode) |
-				PRIMFLAG_TEXWRAP((item.scroll_wrap_x() || item.scroll_wrap_y()) ? 1 : 0);
-
-		// compute the bounds
-		float const primwidth(render_round_nearest(xform.xscale));
-		float const primheight(render_round_nearest(xform.yscale));
-		prim->bounds.set_wh(render_round_nearest(xform.xoffs), render_round_nearest(xform.yoffs), primwidth, primheight);
-		prim->full_bounds = prim->bounds;
+		prim->flags = flags;
+		prim->bounds = cache.bounds;
+		prim->full_bounds = cache.full_bounds;
+		prim->texcoords = cache.texcoords;
+		texture->get_scaled(cache.texwidth, cache.texheight, prim->texture, list, prim->flags);
+		list.append(*prim);
+		return;
+	}
 
-		// get the scaled texture and append it
-		float const xsize(item.scroll_size_x());
-		float const ysize(item.scroll_size_y());
-		s32 texwidth = render_round_nearest(((xform.orientation & ORIENTATION_SWAP_XY) ? primheight : primwidth) / xsize);
-		s32 texheight = render_round_nearest(((xform.orientation & ORIENTATION_SWAP_XY) ? primwidth : primheight) / ysize);
-		texwidth = (std::min)(texwidth, m_maxtexwidth);
-		texheight = (std::min)(texheight, m_maxtexheight);
-		texture->get_scaled(texwidth, texheight, prim->texture, list, prim->flags);
-
-		// compute the clip rect
-		render_bounds cliprect = prim->bounds & m_bounds;
-
-		// determine UV coordinates and apply clipping
-		float const xwindow((xform.orientation & ORIENTATION_SWAP_XY) ? primheight : primwidth);
-		float const ywindow((xform.orientation & ORIENTATION_SWAP_XY) ? primwidth : primheight);
-		float const xrange(float(texwidth) - (item.scroll_wrap_x() ? 0.0f : xwindow));
-		float const yrange(float(texheight) - (item.scroll_wrap_y() ? 0.0f : ywindow));
-		float const xoffset(render_round_nearest(item.scroll_pos_x() * xrange) / float(texwidth));
-		float const yoffset(render_round_nearest(item.scroll_pos_y() * yrange) / float(texheight));
-		float const xend(xoffset + (xwindow / float(texwidth)));
-		float const yend(yoffset + (ywindow / float(texheight)));
-		switch (xform.orientation)
-		{
-		default:
-		case 0:
-			prim->texcoords = render_quad_texuv{ { xoffset, yoffset }, { xend, yoffset }, { xoffset, yend }, { xend, yend } };
-			break;
-		case ORIENTATION_FLIP_X:
-			prim->texcoords = render_quad_texuv{ { xend, yoffset }, { xoffset, yoffset }, { xend, yend }, { xoffset, yend } };
-			break;
-		case ORIENTATION_FLIP_Y:
-			prim->texcoords = render_quad_texuv{ { xoffset, yend }, { xend, yend }, { xoffset, yoffset }, { xend, yoffset } };
-			break;
-		case ORIENTATION_FLIP_X | ORIENTATION_FLIP_Y:
-			prim->texcoords = render_quad_texuv{ { xend, yend }, { xoffset, yend }, { xend, yoffset }, { xoffset, yoffset } };
-			break;
-		case ORIENTATION_SWAP_XY:
-			prim->texcoords = render_quad_texuv{ { xoffset, yoffset }, { xoffset, yend }, { xend, yoffset }, { xend, yend } };
-			break;
-		case ORIENTATION_SWAP_XY | ORIENTATION_FLIP_X:
-			prim->texcoords = render_quad_texuv{ { xoffset, yend }, { xoffset, yoffset }, { xend, yend }, { xend, yoffset } };
-			break;
-		case ORIENTATION_SWAP_XY | ORIENTATION_FLIP_Y:
-			prim->texcoords = render_quad_texuv{ { xend, yoffset }, { xend, yend }, { xoffset, yoffset }, { xoffset, yend } };
-			break;
-		case ORIENTATION_SWAP_XY | ORIENTATION_FLIP_X | ORIENTATION_FLIP_Y:
-			prim->texcoords = render_quad_texuv{ { xend, yend }, { xend, yoffset }, { xoffset, yend }, { xoffset, yoffset } };
-			break;
-		}
+	render_primitive *prim = list.alloc(render_primitive::QUAD);
 
-		// add to the list or free if we're clipped out
-		bool const clipped = render_clip_quad(prim->bounds, cliprect, &prim->texcoords);
-		list.append_or_return(*prim, clipped);
-	}
+	// configure the basics
+	prim->color = xform.color;
+	prim->flags = flags;
+
+	// compute the bounds
+	float const primwidth(render_round_nearest(xform.xscale));
+	float const primheight(render_round_nearest(xform.yscale));
+	prim->bounds.set_wh(render_round_nearest(xform.xoffs), render_round_nearest(xform.yoffs), primwidth, primheight);
+	prim->full_bounds = prim->bounds;
+
+	// get the scaled texture and append it
+	s32 texwidth = render_round_nearest(((xform.orientation & ORIENTATION_SWAP_XY) ? primheight : primwidth) / xsize);
+	s32 texheight = render_round_nearest(((xform.orientation & ORIENTATION_SWAP_XY) ? primwidth : primheight) / ysize);
+	texwidth = (std::min)(texwidth, m_maxtexwidth);
+	texheight = (std::min)(texheight, m_maxtexheight);
+	texture->get_scaled(texwidth, texheight, prim->texture, list, prim->flags);
+
+	// compute the clip rect
+	render_bounds cliprect = prim->bounds & m_bounds;
+
+	// determine UV coordinates and apply clipping
+	float const xwindow((xform.orientation & ORIENTATION_SWAP_XY) ? primheight : primwidth);
+	float const ywindow((xform.orientation & ORIENTATION_SWAP_XY) ? primwidth : primheight);
+	float const xrange(float(texwidth) - (item.scroll_wrap_x() ? 0.0f : xwindow));
+	float const yrange(float(texheight) - (item.scroll_wrap_y() ? 0.0f : ywindow));
+	float const xoffset(render_round_nearest(xpos * xrange) / float(texwidth));
+	float const yoffset(render_round_nearest(ypos * yrange) / float(texheight));
+	float const xend(xoffset + (xwindow / float(texwidth)));
+	float const yend(yoffset + (ywindow / float(texheight)));
+	switch (xform.orientation)
+	{
+	default:
+	case 0:
+		prim->texcoords = render_quad_texuv{ { xoffset, yoffset }, { xend, yoffset }, { xoffset, yend }, { xend, yend } };
+		break;
+	case ORIENTATION_FLIP_X:
+		prim->texcoords = render_quad_texuv{ { xend, yoffset }, { xoffset, yoffset }, { xend, yend }, { xoffset, yend } };
+		break;
+	case ORIENTATION_FLIP_Y:
+		prim->texcoords = render_quad_texuv{ { xoffset, yend }, { xend, yend }, { xoffset, yoffset }, { xend, yoffset } };
+		break;
+	case ORIENTATION_FLIP_X | ORIENTATION_FLIP_Y:
+		prim->texcoords = render_quad_texuv{ { xend, yend }, { xoffset, yend }, { xend, yoffset }, { xoffset, yoffset } };
+		break;
+	case ORIENTATION_SWAP_XY:
+		prim->texcoords = render_quad_texuv{ { xoffset, yoffset }, { xoffset, yend }, { xend, yoffset }, { xend, yend } };
+		break;
+	case ORIENTATION_SWAP_XY | ORIENTATION_FLIP_X:
+		prim->texcoords = render_quad_texuv{ { xoffset, yend }, { xoffset, yoffset }, { xend, yend }, { xend, yoffset } };
+		break;
+	case ORIENTATION_SWAP_XY | ORIENTATION_FLIP_Y:
+		prim->texcoords = render_quad_texuv{ { xend, yoffset }, { xend, yend }, { xoffset, yoffset }, { xoffset, yend } };
+		break;
+	case ORIENTATION_SWAP_XY | ORIENTATION_FLIP_X | ORIENTATION_FLIP_Y:
+		prim->texcoords = render_quad_texuv{ { xend, yend }, { xend, yoffset }, { xoffset, yend }, { xoffset, yoffset } };
+		break;
+	}
+
+	// apply clipping
+	bool const clipped = render_clip_quad(prim->bounds, cliprect, &prim->texcoords);
+
+	// remember the result for next time
+	cache.texture = texture;
+	cache.xoffs = xform.xoffs;
+	cache.yoffs = xform.yoffs;
+	cache.xscale = xform.xscale;
+	cache.yscale = xform.yscale;
+	cache.orientation = xform.orientation;
+	cache.blendmode = blendmode;
+	cache.scroll_size_x = xsize;
+	cache.scroll_size_y = ysize;
+	cache.scroll_pos_x = xpos;
+	cache.scroll_pos_y = ypos;
+	cache.target_bounds = m_bounds;
+	cache.maxtexwidth = m_maxtexwidth;
+	cache.maxtexheight = m_maxtexheight;
+	cache.flags = flags;
+	cache.bounds = prim->bounds;
+	cache.full_bounds = prim->full_bounds;
+	cache.texcoords = prim->texcoords;
+	cache.texwidth = texwidth;
+	cache.texheight = texheight;
+	cache.clipped = clipped;
+
+	// add to the list or free if we're clipped out
+	list.append_or_return(*prim, clipped);
 }
 
 
@@ -3329,6 +3429,39 @@ void render_manager::resolve_tags()
 {
 	for (render_target &target : m_targetlist)
 		target.resolve_tags();
+
+	// the targets have been created by now, so parsed layouts won't be wanted again
+	m_layout_xml.clear();
+}
+
+
+//-------------------------------------------------
+//  find_layout_image - find an image that's
+//  already been decoded for another element
+//-------------------------------------------------
+
+std::shared_ptr<render_manager::layout_image> render_manager::find_layout_image(std::string const &key)
+{
+	std::lock_guard<std::mutex> lock(m_layout_image_mutex);
+	auto const found(m_layout_images.find(key));
+	if (m_layout_images.end() == found)
+		return nullptr;
+	std::shared_ptr<layout_image> result(found->second.lock());
+	if (!result)
+		m_layout_images.erase(found);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  add_layout_image - remember a decoded image
+//  for as long as some element uses it
+//-------------------------------------------------
+
+void render_manager::add_layout_image(std::string const &key, std::shared_ptr<layout_image> const &image)
+{
+	std::lock_guard<std::mutex> lock(m_layout_image_mutex);
+	m_layout_images[key] = image;
 }
 
 
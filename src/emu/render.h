@@ -52,6 +52,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -62,7 +63,7 @@
 
 
 // render creation flags
-constexpr u8 RENDER_CREATE_NO_ART       = 0x01;         // ignore any views that have art in them
+constexpr u8 RENDER_CREATE_NO_ART       = 0x01;         // ignore any views that have art in them, and skip external artwork
 constexpr u8 RENDER_CREATE_SINGLE_FILE  = 0x02;         // only load views from the file specified
 constexpr u8 RENDER_CREATE_HIDDEN       = 0x04;         // don't make this target visible
 
@@ -565,6 +566,31 @@ private:
 	// private classes declared in render.cpp
 	struct object_transform;
 
+	// geometry computed for an element item, reused while its inputs don't change
+	struct element_cache
+	{
+		// inputs
+		render_texture *    texture;
+		float               xoffs, yoffs, xscale, yscale;
+		int                 orientation;
+		int                 blendmode;
+		float               scroll_size_x, scroll_size_y;
+		float               scroll_pos_x, scroll_pos_y;
+		render_bounds       target_bounds;
+		int                 maxtexwidth, maxtexheight;
+
+		// outputs
+		u32                 flags;
+		render_bounds       bounds;
+		render_bounds       full_bounds;
+		render_quad_texuv   texcoords;
+		s32                 texwidth, texheight;
+		bool                clipped;
+
+		// frame this entry was last used
+		u64                 lastframe;
+	};
+
 	// internal helpers
 	enum constructor_impl_t { CONSTRUCTOR_IMPL };
 	template <typename T> render_target(render_manager &manager, T&& layout, u32 flags, constructor_impl_t);
@@ -574,6 +600,7 @@ private:
 	void load_additional_layout_files(const char *basename, bool have_artwork);
 	bool load_layout_file(const char *dirname, const char *filename);
 	bool load_layout_file(const char *dirname, const internal_layout &layout_data, device_t *device = nullptr);
+	std::unique_ptr<util::xml::file> parse_layout_data(const internal_layout &layout_data);
 	bool load_layout_file(device_t &device, util::xml::data_node const &rootnode, const char *searchpath, const char *dirname);
 	void add_container_primitives(render_primitive_list &list, const object_transform &root_xform, const object_transform &xform, render_container &container, int blendmode);
 	void add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_view_item &item);
@@ -629,6 +656,8 @@ private:
 	bool                    m_transform_container;      // determines whether the screen container is transformed by the core renderer,
 														// otherwise the respective render API will handle the transformation (scale, offset)
 	bool                    m_external_artwork;         // external artwork was loaded (driver file or override)
+	std::unordered_map<layout_view_item const *, element_cache> m_element_cache; // per-item element primitive geometry
+	u64                     m_element_cache_frame;      // primitive lists built, for aging the element cache
 };
 
 
@@ -680,6 +709,15 @@ public:
 	// resolve tag lookups
 	void resolve_tags();
 
+	// layout images decoded once and shared by every element, view and target using them
+	struct layout_image
+	{
+		bitmap_argb32   bitmap;                     // decoded image
+		bool            hasalpha = false;           // whether it has any transparency
+	};
+	std::shared_ptr<layout_image> find_layout_image(std::string const &key);
+	void add_layout_image(std::string const &key, std::shared_ptr<layout_image> const &image);
+
 private:
 	// config callbacks
 	void config_load(config_type cfg_type, config_level cfg_lvl, util::xml::data_node const *parentnode);
@@ -700,6 +738,11 @@ private:
 	// containers for the UI and for screens
 	std::unique_ptr<render_container> m_ui_container;   // UI container
 	std::list<render_container>     m_screen_container_list; // list of containers for the screen
+
+	// layout caches
+	std::unordered_map<u64, std::shared_ptr<util::xml::file const> > m_layout_xml; // parsed layouts by size and CRC, while targets are created
+	std::mutex                      m_layout_image_mutex;
+	std::unordered_map<std::string, std::weak_ptr<layout_image> > m_layout_images; // decoded images by source
 };
 
 #endif  // MAME_EMU_RENDER_H
@@ -11,9 +11,13 @@
 
 #include "emucore.h"
 #include "eminline.h"
+#include "osdcore.h"
 #include "video/rgbutil.h"
 #include "render.h"
 
+#include <algorithm>
+#include <array>
+
 
 template <typename PixelType, int SrcShiftR, int SrcShiftG, int SrcShiftB, int DstShiftR, int DstShiftG, int DstShiftB, bool NoDestRead = false, bool BilinearFilter = false>
 class software_renderer
@@ -421,13 +425,21 @@ private:
 
 
 	//-------------------------------------------------
-	//  draw_line - draw a line or point
+	//  draw_line - draw a line or point, clipped to
+	//  the rows from miny up to but not including
+	//  maxy
 	//-------------------------------------------------
 
-	static void draw_line(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_line(render_primitive const &prim, PixelType *dstdata, s32 width, s32 miny, s32 maxy, u32 pitch)
 	{
-		// internal tables
-		static u32 s_cosine_table[2049];
+		// internal tables, built once in a thread-safe manner since bands may be drawn concurrently
+		static std::array<u32, 2049> const s_cosine_table = []()
+		{
+			std::array<u32, 2049> table;
+			for (int entry = 0; entry <= 2048; entry++)
+				table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			return table;
+		}();
 
 		// compute the start/end coordinates
 		int x1 = int(prim.bounds.x0 * 65536.0f);
@@ -440,11 +452,6 @@ private:
 
 		if (PRIMFLAG_GET_ANTIALIAS(prim.flags))
 		{
-			// build up the cosine table if we haven't yet
-			if (s_cosine_table[0] == 0)
-				for (int entry = 0; entry <= 2048; entry++)
-					s_cosine_table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
-
 			int beam = prim.width * 65536.0f;
 			if (beam < 0x00010000)
 				beam = 0x00010000;
@@ -469,7 +476,7 @@ private:
 					{
 						dx = bwidth;    // init diameter of beam
 						dy = y1 >> 16;
-						if (dy >= 0 && dy < height)
+						if (dy >= miny && dy < maxy)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(0xff & (~y1 >> 8), col));
 						dy++;
 						dx -= 0x10000 - (0xffff & y1); // take off amount plotted
@@ -477,11 +484,11 @@ private:
 						dx >>= 16;                   // adjust to pixel (solid) count
 						while (dx--)                 // plot rest of pixels
 						{
-							if (dy >= 0 && dy < height)
+							if (dy >= miny && dy < maxy)
 								draw_aa_pixel(dstdata, pitch, x1, dy, col);
 							dy++;
 						}
-						if (dy >= 0 && dy < height)
+						if (dy >= miny && dy < maxy)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(a1,col));
 					}
 					if (x1 == xx) break;
@@ -501,7 +508,7 @@ private:
 				x1 -= bwidth >> 1; // start back half the width
 				for (;;)
 				{
-					if (y1 >= 0 && y1 < height)
+					if (y1 >= miny && y1 < maxy)
 					{
 						dy = bwidth;    // calc diameter of beam
 						dx = x1 >> 16;
@@ -544,7 +551,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= miny && y1 < maxy)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (x1 == x2) break;
 					x1 += sx;
@@ -560,7 +567,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= miny && y1 < maxy)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (y1 == y2) break;
 					y1 += sy;
@@ -582,10 +589,12 @@ private:
 	//**************************************************************************
 
 	//-------------------------------------------------
-	//  draw_rect - draw a solid rectangle
+	//  draw_rect - draw a solid rectangle, clipped
+	//  to the rows from miny up to but not including
+	//  maxy
 	//-------------------------------------------------
 
-	static void draw_rect(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_rect(render_primitive const &prim, PixelType *dstdata, s32 width, s32 miny, s32 maxy, u32 pitch)
 	{
 		render_bounds const fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -593,9 +602,9 @@ private:
 
 		// clamp to integers and ensure we fit
 		s32 const startx = std::clamp<s32>(round_nearest(fpos.x0), 0, width);
-		s32 const starty = std::clamp<s32>(round_nearest(fpos.y0), 0, height);
+		s32 const starty = std::clamp<s32>(round_nearest(fpos.y0), miny, maxy);
 		s32 const endx = std::clamp<s32>(round_nearest(fpos.x1), 0, width);
-		s32 const endy = std::clamp<s32>(round_nearest(fpos.y1), 0, height);
+		s32 const endy = std::clamp<s32>(round_nearest(fpos.y1), miny, maxy);
 
 		// bail if nothing left
 		if ((startx > endx) || (starty > endy))
@@ -1733,10 +1742,11 @@ private:
 	//-------------------------------------------------
 	//  setup_and_draw_textured_quad - perform setup
 	//  and then dispatch to a texture-mode-specific
-	//  drawing routine
+	//  drawing routine; rows outside miny up to but
+	//  not including maxy are skipped
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void setup_and_draw_textured_quad(render_primitive const &prim, PixelType *dstdata, s32 width, s32 height, s32 miny, s32 maxy, u32 pitch)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1783,6 +1793,17 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// clip to the band, stepping U/V to the first row we draw
+		if (setup.starty < miny)
+		{
+			s32 const skip = std::min(miny, setup.endy) - setup.starty;
+			setup.startu += skip * setup.dudy;
+			setup.startv += skip * setup.dvdy;
+			setup.starty += skip;
+		}
+		if (setup.endy > maxy)
+			setup.endy = std::max(maxy, setup.starty);
+
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1850,34 +1871,112 @@ private:
 
 
 	//**************************************************************************
-	//  PRIMARY ENTRY POINT
+	//  BAND RENDERING
 	//**************************************************************************
 
+	// large targets are split into horizontal bands of at least this many rows
+	static constexpr s32 BAND_MIN_HEIGHT = 32;
+	static constexpr int MAX_BANDS = 16;
+
+	struct band_data
+	{
+		render_primitive_list const *primlist;
+		PixelType *dstdata;
+		s32 width, height;
+		s32 miny, maxy;
+		u32 pitch;
+	};
+
 	//-------------------------------------------------
-	//  draw_primitives - draw a series of primitives
-	//  using a software rasterizer
+	//  draw_band - draw the whole primitive list,
+	//  touching only the rows from miny up to but not
+	//  including maxy
 	//-------------------------------------------------
 
-public:
-	static void draw_primitives(render_primitive_list const &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	static void draw_band(render_primitive_list const &primlist, PixelType *dstdata, s32 width, s32 height, s32 miny, s32 maxy, u32 pitch)
 	{
 		// loop over the list and render each element
 		for (render_primitive const *prim = primlist.first(); prim != nullptr; prim = prim->next())
 			switch (prim->type)
 			{
 				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<PixelType *>(dstdata), width, height, pitch);
+					draw_line(*prim, dstdata, width, miny, maxy, pitch);
 					break;
 
 				case render_primitive::QUAD:
+					// skip quads that don't reach this band
+					if ((round_nearest(prim->bounds.y1) <= miny) || (round_nearest(prim->bounds.y0) >= maxy))
+						break;
 					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<PixelType *>(dstdata), width, height, pitch);
+						draw_rect(*prim, dstdata, width, miny, maxy, pitch);
 					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<PixelType *>(dstdata), width, height, pitch);
+						setup_and_draw_textured_quad(*prim, dstdata, width, height, miny, maxy, pitch);
 					break;
 
 				default:
 					throw emu_fatalerror("Unexpected render_primitive type");
 			}
 	}
+
+	//-------------------------------------------------
+	//  band_callback - work queue callback for
+	//  drawing a single band
+	//-------------------------------------------------
+
+	static void *band_callback(void *param, int threadid)
+	{
+		band_data const &band = *reinterpret_cast<band_data const *>(param);
+		draw_band(*band.primlist, band.dstdata, band.width, band.height, band.miny, band.maxy, band.pitch);
+		return nullptr;
+	}
+
+
+	//**************************************************************************
+	//  PRIMARY ENTRY POINT
+	//**************************************************************************
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  using a software rasterizer
+	//-------------------------------------------------
+
+public:
+	static void draw_primitives(render_primitive_list const &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	{
+		draw_band(primlist, reinterpret_cast<PixelType *>(dstdata), width, height, 0, height, pitch);
+	}
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives,
+	//  splitting the target into horizontal bands
+	//  that are rasterised in parallel on the given
+	//  work queue; each band walks the list in order
+	//  so blending matches the serial renderer
+	//-------------------------------------------------
+
+	static void draw_primitives(render_primitive_list const &primlist, void *dstdata, u32 width, u32 height, u32 pitch, osd_work_queue *queue)
+	{
+		int const bands = std::min<int>(MAX_BANDS, s32(height) / BAND_MIN_HEIGHT);
+		if (!queue || (bands < 2))
+		{
+			draw_primitives(primlist, dstdata, width, height, pitch);
+			return;
+		}
+
+		// divide the rows as evenly as possible
+		band_data bandlist[MAX_BANDS];
+		for (int band = 0; band < bands; band++)
+		{
+			bandlist[band].primlist = &primlist;
+			bandlist[band].dstdata = reinterpret_cast<PixelType *>(dstdata);
+			bandlist[band].width = width;
+			bandlist[band].height = height;
+			bandlist[band].miny = s32(u64(height) * band / bands);
+			bandlist[band].maxy = s32(u64(height) * (band + 1) / bands);
+			bandlist[band].pitch = pitch;
+		}
+
+		osd_work_item_queue_multiple(queue, &band_callback, bands, bandlist, sizeof(bandlist[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+	}
 };
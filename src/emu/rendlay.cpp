@@ -19,6 +19,7 @@
 #include "rendutil.h"
 #include "video/rgbutil.h"
 
+#include "util/hashing.h"
 #include "util/nanosvg.h"
 #include "util/path.h"
 #include "util/unicode.h"
@@ -1863,6 +1864,76 @@ private:
 	}
 
 	void load_image(running_machine &machine)
+	{
+		// another element, view or target may have decoded the same image already
+		std::string const key(image_key());
+		std::shared_ptr<render_manager::layout_image> shared;
+		if (!key.empty())
+			shared = machine.render().find_layout_image(key);
+		if (!shared)
+		{
+			decode_image();
+
+			// SVG images are rasterised at the size they're drawn, so only bitmaps are shared
+			if (m_bitmap.valid() && !key.empty())
+			{
+				shared = std::make_shared<render_manager::layout_image>();
+				shared->bitmap = std::move(m_bitmap);
+				shared->hasalpha = m_hasalpha;
+				machine.render().add_layout_image(key, shared);
+			}
+		}
+		if (shared)
+		{
+			m_bitmap.wrap(&shared->bitmap.pix(0), shared->bitmap.width(), shared->bitmap.height(), shared->bitmap.rowpixels());
+			m_hasalpha = shared->hasalpha;
+			m_shared = std::move(shared);
+		}
+
+		// if we can't load an image, allocate a dummy one and report an error
+		if (!m_bitmap.valid() && !m_svg)
+		{
+			// draw some stripes in the bitmap
+			m_bitmap.allocate(100, 100);
+			m_bitmap.fill(0);
+			for (int step = 0; step < 100; step += 25)
+				for (int line = 0; line < 100; line++)
+					m_bitmap.pix((step + line) % 100, line % 100) = rgb_t(0xff,0xff,0xff,0xff);
+
+			// log an error
+			if (m_alphafile.empty())
+				osd_printf_warning("Unable to load component image '%s'\n", m_imagefile);
+			else
+				osd_printf_warning("Unable to load component image '%s'/'%s'\n", m_imagefile, m_alphafile);
+		}
+
+		// clear out this stuff in case it's large
+		if (!m_svg)
+			m_rasterizer.reset();
+		m_searchpath.clear();
+		m_dirname.clear();
+		m_imagefile.clear();
+		m_alphafile.clear();
+		m_data.clear();
+	}
+
+	std::string image_key() const
+	{
+		// the same names can find different files depending on where the layout is
+		std::string key;
+		if (!m_imagefile.empty())
+			key = util::string_format("file:%s", m_imagefile);
+		else if (!m_data.empty())
+			key = util::string_format("data:%u:%08x", m_data.size(), uint32_t(util::crc32_creator::simple(m_data.data(), m_data.size())));
+		else
+			return key;
+		key.append(1, '\0').append(m_alphafile);
+		key.append(1, '\0').append(m_searchpath);
+		key.append(1, '\0').append(m_dirname);
+		return key;
+	}
+
+	void decode_image()
 	{
 		// if we have a filename, go with that
 		emu_file file(m_searchpath.empty() ? m_dirname : m_searchpath, OPEN_FLAG_READ);
@@ -1923,32 +1994,6 @@ private:
 				osd_printf_warning("Component alpha channel file '%s' ignored for SVG image '%s'\n", m_alphafile, m_imagefile);
 			}
 		}
-
-		// if we can't load an image, allocate a dummy one and report an error
-		if (!m_bitmap.valid() && !m_svg)
-		{
-			// draw some stripes in the bitmap
-			m_bitmap.allocate(100, 100);
-			m_bitmap.fill(0);
-			for (int step = 0; step < 100; step += 25)
-				for (int line = 0; line < 100; line++)
-					m_bitmap.pix((step + line) % 100, line % 100) = rgb_t(0xff,0xff,0xff,0xff);
-
-			// log an error
-			if (m_alphafile.empty())
-				osd_printf_warning("Unable to load component image '%s'\n", m_imagefile);
-			else
-				osd_printf_warning("Unable to load component image '%s'/'%s'\n", m_imagefile, m_alphafile);
-		}
-
-		// clear out this stuff in case it's large
-		if (!m_svg)
-			m_rasterizer.reset();
-		m_searchpath.clear();
-		m_dirname.clear();
-		m_imagefile.clear();
-		m_alphafile.clear();
-		m_data.clear();
 	}
 
 	void load_image_data()
@@ -2114,6 +2159,7 @@ private:
 	std::shared_ptr<NSVGrasterizer> m_rasterizer;       // SVG rasteriser
 	bitmap_argb32                   m_bitmap;           // source bitmap for images
 	bool                            m_hasalpha = false; // is there any alpha component present?
+	std::shared_ptr<render_manager::layout_image> m_shared; // decoded image shared with other elements
 
 	// cold state
 	std::string                     m_searchpath;       // asset search path (for lazy loading)
@@ -20,10 +20,12 @@
 #include "ui/uimain.h"
 
 #include "corestr.h"
+#include "hashing.h"
 #include "path.h"
 
 #include <algorithm>
 #include <cstdarg>
+#include <cstdio>
 #include <set>
 
 
@@ -179,6 +181,8 @@ std::error_condition do_open_disk(
 			{
 				imgfile.reset(new emu_file(options.media_path(), paths, OPEN_FLAG_READ));
 				imgfile->set_restrict_to_mediapath(1);
+				if (options.path_cache())
+					imgfile->set_path_cache(&path_listing_cache::get());
 				std::error_condition const filerr(imgfile->open(filename, OPEN_FLAG_READ));
 				if (!filerr)
 					break;
@@ -525,6 +529,9 @@ void rom_load_manager::fill_random(u8 *base, u32 length)
 
 void rom_load_manager::handle_missing_file(const rom_entry *romp, const std::vector<std::string> &tried_file_names, std::error_condition chderr)
 {
+	// keep messages in load order
+	retire_verifies(0);
+
 	std::string tried;
 	if (!tried_file_names.empty())
 	{
@@ -630,6 +637,88 @@ void rom_load_manager::verify_length_and_hash(emu_file *file, std::string_view n
 }
 
 
+/*-------------------------------------------------
+    queue_verify - hand a file that has been
+    read off to the work queue to be hashed;
+    the file is verified by retire_verifies
+-------------------------------------------------*/
+
+void rom_load_manager::queue_verify(std::unique_ptr<emu_file> &&file, const rom_entry &romp, u32 explength)
+{
+	auto job = std::make_unique<pending_verify>();
+	job->m_file = std::move(file);
+	job->m_name = romp.name();
+	job->m_explength = explength;
+	job->m_hashes.from_internal_string(romp.hashdata());
+	job->m_done = false;
+
+	if (!m_verify_queue)
+		m_verify_queue.reset(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI));
+	m_pending_verifies.emplace_back(std::move(job));
+	if (!m_verify_queue || !osd_work_item_queue(m_verify_queue.get(), verify_hash_callback, m_pending_verifies.back().get(), WORK_ITEM_FLAG_AUTO_RELEASE))
+	{
+		// no worker available, do it here
+		verify_hash_callback(m_pending_verifies.back().get(), 0);
+	}
+
+	// don't hold on to too many files
+	retire_verifies(MAX_PENDING_VERIFIES);
+}
+
+
+/*-------------------------------------------------
+    retire_verifies - verify hashed files in the
+    order they were loaded, waiting until no more
+    than the given number are outstanding
+-------------------------------------------------*/
+
+void rom_load_manager::retire_verifies(std::size_t limit)
+{
+	while (!m_pending_verifies.empty())
+	{
+		pending_verify &job(*m_pending_verifies.front());
+		if (!job.m_done.load(std::memory_order_acquire))
+		{
+			if (m_pending_verifies.size() <= limit)
+				break;
+			osd_work_queue_wait(m_verify_queue.get(), osd_ticks_per_second() / 100);
+			continue;
+		}
+
+		LOG("Verifying %s length (%X) and checksums\n", job.m_name.c_str(), job.m_explength);
+		verify_length_and_hash(job.m_file.get(), job.m_name, job.m_explength, job.m_hashes);
+		m_pending_verifies.pop_front();
+	}
+}
+
+
+/*-------------------------------------------------
+    finish_verifies - verify all outstanding
+    files and save any new checksums
+-------------------------------------------------*/
+
+void rom_load_manager::finish_verifies()
+{
+	retire_verifies(0);
+	if (m_hash_cache)
+		m_hash_cache->flush();
+}
+
+
+/*-------------------------------------------------
+    verify_hash_callback - compute the checksums
+    of a file (worker thread)
+-------------------------------------------------*/
+
+void *rom_load_manager::verify_hash_callback(void *param, int threadid)
+{
+	pending_verify &job(*reinterpret_cast<pending_verify *>(param));
+	job.m_file->hashes(job.m_hashes.hash_types());
+	job.m_done.store(true, std::memory_order_release);
+	return nullptr;
+}
+
+
 /*-------------------------------------------------
     display_loading_rom_message - display
     messages about ROM loading to the user
@@ -655,6 +744,9 @@ void rom_load_manager::display_loading_rom_message(const char *name, bool from_l
 
 void rom_load_manager::display_rom_load_results(bool from_list)
 {
+	// make sure every file has been checked
+	finish_verifies();
+
 	// final status display
 	display_loading_rom_message(nullptr, from_list);
 
@@ -769,6 +861,8 @@ std::unique_ptr<emu_file> rom_load_manager::open_rom_file(
 	// attempt to open the file
 	std::unique_ptr<emu_file> result(new emu_file(machine().options().media_path(), paths, OPEN_FLAG_READ));
 	result->set_restrict_to_mediapath(1);
+	result->set_hash_cache(m_hash_cache);
+	result->set_path_cache(m_path_cache);
 	if (has_crc)
 		filerr = result->open(name, crc);
 	else
@@ -1034,8 +1128,10 @@ void rom_load_manager::process_rom_entries(
 		{
 			// handle files
 			bool const irrelevantbios = (ROM_GETBIOSFLAGS(romp) != 0) && (ROM_GETBIOSFLAGS(romp) != bios);
-			rom_entry const *baserom = romp;
+			rom_entry const *const baserom = romp;
+			bool firstpass = true;
 			int explength = 0;
+			u32 verifylength = 0;
 
 			// open the file if it is a non-BIOS or matches the current BIOS
 			LOG("Opening ROM file: %s\n", ROM_GETNAME(romp));
@@ -1070,27 +1166,23 @@ void rom_load_manager::process_rom_entries(
 				}
 				while (ROMENTRY_ISCONTINUE(romp) || ROMENTRY_ISIGNORE(romp));
 
-				// if this was the first use of this file, verify the length and CRC
-				if (baserom)
-				{
-					LOG("Verifying length (%X) and checksums\n", explength);
-					verify_length_and_hash(file.get(), baserom->name(), explength, util::hash_collection(baserom->hashdata()));
-					LOG("Verify finished\n");
-				}
+				// the first use of this file determines the length to verify
+				if (firstpass)
+					verifylength = explength;
 
-				// re-seek to the start and clear the baserom so we don't reverify
+				// re-seek to the start for reloads
 				if (file)
 					file->seek(0, SEEK_SET);
-				baserom = nullptr;
+				firstpass = false;
 				explength = 0;
 			}
 			while (ROMENTRY_ISRELOAD(romp));
 
-			// close the file
+			// hash the file on a worker thread; it gets closed once it's verified
 			if (file)
 			{
-				LOG("Closing ROM file\n");
-				file.reset();
+				LOG("Queueing checksums of ROM file, length %X\n", verifylength);
+				queue_verify(std::move(file), *baserom, verifylength);
 			}
 		}
 		else
@@ -1101,6 +1193,215 @@ void rom_load_manager::process_rom_entries(
 }
 
 
+/*-------------------------------------------------
+    map_rom_region - map a region holding a single
+    uncompressed ROM straight from its file
+-------------------------------------------------*/
+
+memory_region *rom_load_manager::map_rom_region(
+		const std::vector<std::string> &searchpath,
+		const std::string &regiontag,
+		const rom_entry *region,
+		u8 width,
+		endianness_t endianness)
+{
+	// small regions aren't worth it, and post-processing would touch every page
+	u32 const regionlength = ROMREGION_GETLENGTH(region);
+	if ((regionlength < MIN_MAPPED_REGION) || ROMREGION_ISINVERTED(region) || ((width > 1) && (endianness != ENDIANNESS_NATIVE)))
+		return nullptr;
+
+	// the region must be exactly one ROM loaded verbatim
+	rom_entry const *const romp = region + 1;
+	if (!ROMENTRY_ISFILE(romp) || !ROMENTRY_ISREGIONEND(romp + 1))
+		return nullptr;
+	if ((ROM_GETOFFSET(romp) != 0) || (ROM_GETLENGTH(romp) != regionlength) || ROM_GETBIOSFLAGS(romp) || ROM_INHERITSFLAGS(romp))
+		return nullptr;
+	if ((ROM_GETBITWIDTH(romp) != 8) || (ROM_GETGROUPSIZE(romp) != 1) || ROM_GETSKIPCOUNT(romp) || ROM_ISREVERSED(romp))
+		return nullptr;
+	util::hash_collection const hashes(romp->hashdata());
+	if (hashes.flag(util::hash_collection::FLAG_NO_DUMP))
+		return nullptr;
+
+	// only a loose file of the right size can be mapped; don't decompress anything finding out
+	u32 crc = 0;
+	bool const has_crc = hashes.crc(crc);
+	std::unique_ptr<emu_file> file(new emu_file(machine().options().media_path(), searchpath, OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD));
+	file->set_restrict_to_mediapath(1);
+	file->set_hash_cache(m_hash_cache);
+	file->set_path_cache(m_path_cache);
+	std::error_condition const filerr = has_crc ? file->open(ROM_GETNAME(romp), crc) : file->open(ROM_GETNAME(romp));
+	if (filerr || file->is_archived() || (file->size() != regionlength))
+		return nullptr;
+
+	osd_file_mapping::ptr mapping;
+	std::error_condition const maperr = osd_file_mapping::open(file->fullpath(), regionlength, mapping);
+	if (maperr)
+	{
+		LOG("Failed to map ROM file %s (%s)\n", file->fullpath(), maperr.message().c_str());
+		return nullptr;
+	}
+
+	// account for it as if it had been read
+	display_loading_rom_message(ROM_GETNAME(romp), false);
+	m_romsloaded++;
+	m_romsloadedsize += regionlength;
+
+	memory_region *const memregion = machine().memory().region_alloc(regiontag, std::move(mapping), width, endianness);
+	LOG("Mapped %X bytes @ %p from %s\n", memregion->bytes(), memregion->base(), file->fullpath());
+
+	LOG("Queueing checksums of ROM file, length %X\n", regionlength);
+	queue_verify(std::move(file), *romp, regionlength);
+	return memregion;
+}
+
+
+/*-------------------------------------------------
+    region_cache_key - identify the contents of a
+    region once loaded and post-processed, or
+    return an empty string if it can't be cached
+-------------------------------------------------*/
+
+std::string rom_load_manager::region_cache_key(
+		const device_t &device,
+		const rom_entry *region,
+		u8 width,
+		endianness_t endianness) const
+{
+	if (ROMREGION_GETLENGTH(region) < MIN_MAPPED_REGION)
+		return std::string();
+
+	// the layout and the dumps' hashes determine the contents; the loader itself might change between builds
+	util::sha1_creator creator;
+	auto const append_string =
+			[&creator] (std::string const &s)
+			{
+				u32 const length = s.length();
+				creator.append(&length, sizeof(length));
+				creator.append(s.data(), length);
+			};
+	auto const append_entry =
+			[&creator, &append_string] (rom_entry const &entry)
+			{
+				u32 const values[3] = { entry.get_offset(), entry.get_length(), entry.get_flags() };
+				creator.append(values, sizeof(values));
+				append_string(entry.name());
+				append_string(entry.hashdata());
+			};
+	append_string(emulator_info::get_build_version());
+	append_entry(*region);
+	u32 const layout[3] = { width, u32(endianness), u32(device.system_bios()) };
+	creator.append(layout, sizeof(layout));
+	for (rom_entry const *romp = region + 1; !ROMENTRY_ISREGIONEND(romp); romp++)
+	{
+		// copies depend on another region, and only known good dumps can be trusted to match
+		if (ROMENTRY_ISCOPY(romp))
+			return std::string();
+		if (ROMENTRY_ISFILE(romp))
+		{
+			util::hash_collection const hashes(romp->hashdata());
+			util::sha1_t sha1;
+			if (hashes.flag(util::hash_collection::FLAG_NO_DUMP) || !hashes.sha1(sha1))
+				return std::string();
+		}
+		append_entry(*romp);
+	}
+	return creator.finish().as_string();
+}
+
+
+/*-------------------------------------------------
+    map_cached_region - map a region loaded by an
+    earlier run from the region cache
+-------------------------------------------------*/
+
+memory_region *rom_load_manager::map_cached_region(
+		const std::string &key,
+		const device_t &device,
+		const std::string &regiontag,
+		const rom_entry *region,
+		u8 width,
+		endianness_t endianness)
+{
+	u32 const regionlength = ROMREGION_GETLENGTH(region);
+	std::string const path = util::path_concat(m_region_cache, key);
+	std::unique_ptr<osd::directory::entry> const entry = osd_stat(path);
+	if (!entry || (entry->type != osd::directory::entry::entry_type::FILE) || (entry->size != regionlength))
+		return nullptr;
+
+	osd_file_mapping::ptr mapping;
+	std::error_condition const maperr = osd_file_mapping::open(path, regionlength, mapping);
+	if (maperr)
+	{
+		LOG("Failed to map cached region %s (%s)\n", path.c_str(), maperr.message().c_str());
+		return nullptr;
+	}
+
+	// account for the ROMs as if they had been read
+	for (rom_entry const *romp = rom_first_file(region); romp; romp = rom_next_file(romp))
+	{
+		if ((ROM_GETBIOSFLAGS(romp) == 0) || (ROM_GETBIOSFLAGS(romp) == device.system_bios()))
+		{
+			display_loading_rom_message(ROM_GETNAME(romp), false);
+			m_romsloaded++;
+			m_romsloadedsize += rom_file_size(romp);
+		}
+	}
+
+	memory_region *const memregion = machine().memory().region_alloc(regiontag, std::move(mapping), width, endianness);
+	LOG("Mapped %X bytes @ %p from cached region %s\n", memregion->bytes(), memregion->base(), path.c_str());
+	m_cached_regions.insert(memregion);
+	return memregion;
+}
+
+
+/*-------------------------------------------------
+    store_cached_regions - write the regions that
+    weren't in the cache once they've been loaded
+    and verified
+-------------------------------------------------*/
+
+void rom_load_manager::store_cached_regions()
+{
+	// anything missing or suspect doesn't go in
+	if (m_warnings || m_knownbad || m_errors)
+	{
+		m_regions_to_cache.clear();
+		return;
+	}
+
+	for (auto const &[memregion, key] : m_regions_to_cache)
+	{
+		// another instance may have got there first
+		std::string const path = util::path_concat(m_region_cache, key);
+		if (osd_stat(path))
+			continue;
+
+		// write under a name of our own and rename it so others never map a partial file
+		std::string const tempname = util::string_format("%s.%d.tmp", key, osd_getpid());
+		emu_file file(m_region_cache, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		std::error_condition const filerr = file.open(tempname);
+		if (filerr)
+		{
+			LOG("Failed to create cached region %s (%s)\n", tempname.c_str(), filerr.message().c_str());
+			continue;
+		}
+		std::string const temppath = file.fullpath();
+		bool const written = file.write(memregion->base(), memregion->bytes()) == memregion->bytes();
+		file.close();
+		if (!written || std::rename(temppath.c_str(), path.c_str()))
+		{
+			LOG("Failed to store cached region %s\n", path.c_str());
+			std::remove(temppath.c_str());
+		}
+		else
+		{
+			LOG("Stored %X bytes from %s as cached region %s\n", memregion->bytes(), memregion->name().c_str(), path.c_str());
+		}
+	}
+	m_regions_to_cache.clear();
+}
+
+
 /*-------------------------------------------------
     open_disk_diff - open a DISK diff file
 -------------------------------------------------*/
@@ -1170,6 +1471,9 @@ void rom_load_manager::process_disk_entries(
 				[&regiontag] (std::unique_ptr<open_chd> &chd) { return chd->region() == regiontag; }),
 			m_chd_list.end());
 
+	// keep messages in load order
+	retire_verifies(0);
+
 	// loop until we hit the end of this region
 	for ( ; !ROMENTRY_ISREGIONEND(romp); romp++)
 	{
@@ -1216,8 +1520,8 @@ void rom_load_manager::process_disk_entries(
 				m_knownbad++;
 			}
 
-			// if not read-only, open or create the diff file
-			if (!DISK_ISREADONLY(romp))
+			// if not read-only, open or create the diff file, unless changes are kept in memory
+			if (!DISK_ISREADONLY(romp) && !machine().options().disk_overlay())
 			{
 				err = open_disk_diff(machine().options(), romp, chd->orig_chd(), chd->diff_chd());
 				if (err)
@@ -1486,6 +1790,7 @@ void rom_load_manager::process_region_list()
 			// the first entry must be a region
 			assert(ROMENTRY_ISREGION(region));
 
+			auto const trace(g_startup_trace.phase(ROMREGION_ISDISKDATA(region) ? "chd" : "rom", "%s", regiontag));
 			if (ROMREGION_ISROMDATA(region))
 			{
 				// if this is a device region, override with the device width and endianness
@@ -1493,9 +1798,28 @@ void rom_load_manager::process_region_list()
 				endianness_t endianness = ROMREGION_ISBIGENDIAN(region) ? ENDIANNESS_BIG : ENDIANNESS_LITTLE;
 				normalize_flags_for_device(regiontag, width, endianness);
 
+				if (searchpath.empty())
+					searchpath = device.searchpath();
+				assert(!searchpath.empty());
+
+				// a large region holding a single uncompressed ROM can be mapped from the file
+				if (machine().options().map_roms() && map_rom_region(searchpath, regiontag, region, width, endianness))
+					continue;
+
+				// so can one loaded by an earlier run, shared with any other instances using it
+				std::string cachekey;
+				if (!m_region_cache.empty())
+				{
+					cachekey = region_cache_key(device, region, width, endianness);
+					if (!cachekey.empty() && map_cached_region(cachekey, device, regiontag, region, width, endianness))
+						continue;
+				}
+
 				// remember the base and length
 				memory_region *const memregion = machine().memory().region_alloc(regiontag, regionlength, width, endianness);
 				LOG("Allocated %X bytes @ %p\n", memregion->bytes(), memregion->base());
+				if (!cachekey.empty())
+					m_regions_to_cache.emplace_back(memregion, std::move(cachekey));
 
 				if (ROMREGION_ISERASE(region)) // clear the region if it's requested
 					memset(memregion->base(), ROMREGION_GETERASEVAL(region), memregion->bytes());
@@ -1507,9 +1831,6 @@ void rom_load_manager::process_region_list()
 #endif
 
 				// now process the entries in the region
-				if (searchpath.empty())
-					searchpath = device.searchpath();
-				assert(!searchpath.empty());
 				process_rom_entries(searchpath, device.system_bios(), *memregion, region, region + 1, false);
 			}
 			else if (ROMREGION_ISDISKDATA(region))
@@ -1531,10 +1852,16 @@ void rom_load_manager::process_region_list()
 		}
 	}
 
-	// now go back and post-process all the regions
+	// now go back and post-process all the regions, except those mapped from the cache already done
 	for (device_t &device : deviter)
+	{
 		for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
-			region_post_process(device.memregion(region->name()), ROMREGION_ISINVERTED(region));
+		{
+			memory_region *const memregion = device.memregion(region->name());
+			if (m_cached_regions.find(memregion) == m_cached_regions.end())
+				region_post_process(memregion, ROMREGION_ISINVERTED(region));
+		}
+	}
 
 	// and finally register all per-game parameters
 	for (device_t &device : deviter)
@@ -1565,7 +1892,14 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 	, m_chd_list()
 	, m_errorstring()
 	, m_softwarningstring()
+	, m_hash_cache(machine.options().hash_cache() ? &file_hash_cache::get(machine.options().cfg_directory()) : nullptr)
+	, m_path_cache(machine.options().path_cache() ? &path_listing_cache::get() : nullptr)
+	, m_region_cache(machine.options().rom_cache())
 {
+	// files may have been added or removed since the listings were last used
+	if (m_path_cache)
+		m_path_cache->revalidate();
+
 	// figure out which BIOS we are using
 	std::map<std::string_view, std::string> card_bios;
 	for (device_t &device : device_enumerator(machine.config().root_device()))
@@ -1610,6 +1944,9 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 
 	// display the results and exit
 	display_rom_load_results(false);
+
+	// share the regions that loaded cleanly with later runs
+	store_cached_regions();
 }
 
 
@@ -14,10 +14,14 @@
 #pragma once
 
 #include "chd.h"
+#include "hash.h"
 
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <set>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -443,6 +447,10 @@ private:
 	void handle_missing_file(const rom_entry *romp, const std::vector<std::string> &tried_file_names, std::error_condition chderr);
 	void dump_wrong_and_correct_checksums(const util::hash_collection &hashes, const util::hash_collection &acthashes);
 	void verify_length_and_hash(emu_file *file, std::string_view name, u32 explength, const util::hash_collection &hashes);
+	void queue_verify(std::unique_ptr<emu_file> &&file, const rom_entry &romp, u32 explength);
+	void retire_verifies(std::size_t limit);
+	void finish_verifies();
+	static void *verify_hash_callback(void *param, int threadid);
 	void display_loading_rom_message(const char *name, bool from_list);
 	void display_rom_load_results(bool from_list);
 	void region_post_process(memory_region *region, bool invert);
@@ -469,6 +477,12 @@ private:
 			const rom_entry *parent_region,
 			const rom_entry *romp,
 			bool from_list);
+	memory_region *map_rom_region(
+			const std::vector<std::string> &searchpath,
+			const std::string &regiontag,
+			const rom_entry *region,
+			u8 width,
+			endianness_t endianness);
 	std::error_condition open_disk_diff(
 			emu_options &options,
 			const rom_entry *romp,
@@ -480,9 +494,30 @@ private:
 			const rom_entry *romp,
 			std::function<const rom_entry * ()> next_parent,
 			const chd_file::open_parent_func &open_parent);
+	std::string region_cache_key(const device_t &device, const rom_entry *region, u8 width, endianness_t endianness) const;
+	memory_region *map_cached_region(const std::string &key, const device_t &device, const std::string &regiontag, const rom_entry *region, u8 width, endianness_t endianness);
+	void store_cached_regions();
 	void normalize_flags_for_device(std::string_view rgntag, u8 &width, endianness_t &endian);
 	void process_region_list();
 
+	// a ROM file being hashed on the work queue; results are checked in load order
+	struct pending_verify
+	{
+		std::unique_ptr<emu_file>   m_file;             // file to hash
+		std::string                 m_name;             // ROM name for messages
+		u32                         m_explength;        // expected length
+		util::hash_collection       m_hashes;           // expected checksums
+		std::atomic<bool>           m_done;             // set by the worker when hashing is finished
+	};
+
+	struct work_queue_deleter { void operator()(osd_work_queue *queue) const { osd_work_queue_free(queue); } };
+
+	// maximum number of files held open waiting for their checksums
+	static constexpr std::size_t MAX_PENDING_VERIFIES = 8;
+
+	// smallest region worth mapping from its file rather than reading
+	static constexpr u32 MIN_MAPPED_REGION = 0x100000;
+
 	// internal state
 	running_machine &   m_machine;            // reference to our machine
 
@@ -499,6 +534,17 @@ private:
 
 	std::string         m_errorstring;        // error string
 	std::string         m_softwarningstring;  // software warning string
+
+	file_hash_cache *   m_hash_cache;         // checksums remembered from earlier runs
+	path_listing_cache * m_path_cache;        // media path directory listings
+
+	std::string         m_region_cache;       // directory of loaded regions keyed by content, or empty
+	std::vector<std::pair<memory_region *, std::string> > m_regions_to_cache;  // regions loaded here, to store once verified
+	std::set<const memory_region *> m_cached_regions;    // regions mapped from the cache, already post-processed
+
+	// the queue is declared last so that it waits for the workers before the jobs go away
+	std::deque<std::unique_ptr<pending_verify>> m_pending_verifies;   // files being hashed
+	std::unique_ptr<osd_work_queue, work_queue_deleter> m_verify_queue;   // queue for hashing ROM files
 };
 
 
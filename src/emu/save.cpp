@@ -24,12 +24,17 @@
 
 #include "emu.h"
 #include "emuopts.h"
+#include "fileio.h"
 
 #include "main.h"
 
 #include "util/ioprocs.h"
 #include "util/ioprocsfilter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -64,13 +69,36 @@ enum
 //  save_manager - constructor
 //-------------------------------------------------
 
+//-------------------------------------------------
+//  async_save - state captured for writing on
+//  a worker thread
+//-------------------------------------------------
+
+struct save_manager::async_save
+{
+	std::unique_ptr<emu_file> m_file;                 // destination, owned by the worker until done
+	std::vector<u8>           m_data;                 // header and uncompressed state
+	std::string               m_name;                 // name for reporting
+	std::atomic<bool>         m_done;                 // set by the worker when finished
+	save_error                m_result;               // outcome, valid once done
+};
+
+
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine)
 	, m_reg_allowed(true)
+	, m_async_queue(nullptr)
 {
 	m_rewind = std::make_unique<rewinder>(*this);
 }
 
+save_manager::~save_manager()
+{
+	wait_async();
+	if (m_async_queue)
+		osd_work_queue_free(m_async_queue);
+}
+
 
 //-------------------------------------------------
 //  allow_registration - allow/disallow
@@ -284,15 +312,143 @@ save_error save_manager::write_file(util::core_file &file)
 }
 
 
+//-------------------------------------------------
+//  write_file_async - snapshot the state into
+//  memory and hand compressing and writing it
+//  to a worker thread
+//-------------------------------------------------
+
+save_error save_manager::write_file_async(std::unique_ptr<emu_file> &&file, std::string &&name)
+{
+	// only one in flight at a time; the caller should have collected the
+	// previous result already, otherwise it's dropped here
+	wait_async();
+	if (m_async)
+	{
+		save_error result;
+		std::string previous;
+		async_complete(result, previous);
+	}
+
+	auto job = std::make_unique<async_save>();
+	job->m_data.reserve(ram_state::get_size(*this));
+	const save_error err = do_write(
+			[] (size_t total_size) { return true; },
+			[&job] (const void *data, size_t size)
+			{
+				const u8 *const src = reinterpret_cast<const u8 *>(data);
+				job->m_data.insert(job->m_data.end(), src, src + size);
+				return true;
+			},
+			[] () { return true; },
+			[] () { return true; });
+	if (err != STATERR_NONE)
+		return err;
+
+	job->m_file = std::move(file);
+	job->m_name = std::move(name);
+	job->m_done = false;
+	job->m_result = STATERR_NONE;
+
+	if (!m_async_queue)
+		m_async_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	m_async = std::move(job);
+	if (!m_async_queue || !osd_work_item_queue(m_async_queue, async_write_callback, m_async.get(), WORK_ITEM_FLAG_AUTO_RELEASE))
+	{
+		// no worker available, do it here
+		async_write_callback(m_async.get(), 0);
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  async_write_callback - compress and write a
+//  captured state (worker thread)
+//-------------------------------------------------
+
+void *save_manager::async_write_callback(void *param, int threadid)
+{
+	async_save &job = *reinterpret_cast<async_save *>(param);
+	util::core_file &file = *job.m_file;
+	job.m_result = STATERR_WRITE_ERROR;
+
+	// header goes out uncompressed, the rest through zlib as in write_file
+	util::core_file::ptr proxy;
+	if (!file.seek(0, SEEK_SET) && !util::core_file::open_proxy(file, proxy) && proxy)
+	{
+		auto const [headerr, headwritten] = write(*proxy, job.m_data.data(), HEADER_SIZE);
+		proxy.reset();
+		if (!headerr)
+		{
+			util::write_stream::ptr writer = util::zlib_write(file, 6, 16384);
+			if (writer)
+			{
+				auto const [filerr, written] = write(*writer, job.m_data.data() + HEADER_SIZE, job.m_data.size() - HEADER_SIZE);
+				if (!filerr && !writer->finalize())
+					job.m_result = STATERR_NONE;
+			}
+		}
+	}
+
+	job.m_done.store(true, std::memory_order_release);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  async_complete - if the asynchronous save has
+//  finished, retrieve its result and close the
+//  file
+//-------------------------------------------------
+
+bool save_manager::async_complete(save_error &result, std::string &name)
+{
+	if (!m_async || !m_async->m_done.load(std::memory_order_acquire))
+		return false;
+
+	result = m_async->m_result;
+	name = std::move(m_async->m_name);
+	if (result != STATERR_NONE)
+		m_async->m_file->remove_on_close();
+	m_async.reset();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  wait_async - block until any asynchronous save
+//  has finished
+//-------------------------------------------------
+
+void save_manager::wait_async()
+{
+	if (!m_async)
+		return;
+	if (m_async_queue)
+		while (!osd_work_queue_wait(m_async_queue, osd_ticks_per_second() * 10)) { }
+	while (!m_async->m_done.load(std::memory_order_acquire))
+		std::this_thread::yield();
+}
+
+
 //-------------------------------------------------
 //  read_file - read the data from a file
 //-------------------------------------------------
 
 save_error save_manager::read_file(util::core_file &file)
 {
+	// entries are inflated straight into their final location, so there's no
+	// intermediate copy of the state; large states get a bigger input buffer
+	// to cut down on round trips to slow storage
 	util::read_stream::ptr reader;
+	std::size_t buffer_size = 16384;
 	return do_read(
-			[] (size_t total_size) { return true; },
+			[&buffer_size] (size_t total_size)
+			{
+				buffer_size = std::clamp<size_t>(total_size / 64, 16384, 1 << 20);
+				return true;
+			},
 			[&reader] (void *data, size_t size)
 			{
 				auto const [filerr, actual] = read(*reader, data, size);
@@ -307,9 +463,9 @@ save_error save_manager::read_file(util::core_file &file)
 				reader = std::move(proxy);
 				return !filerr && reader;
 			},
-			[&file, &reader] ()
+			[&file, &reader, &buffer_size] ()
 			{
-				reader = util::zlib_read(file, 16384);
+				reader = util::zlib_read(file, buffer_size);
 				return bool(reader);
 			});
 }
@@ -581,17 +737,158 @@ save_manager::state_callback::state_callback(save_prepost_delegate callback)
 }
 
 
+//-------------------------------------------------
+//  ram_state::chunk - a piece of a serialised
+//  state, optionally run-length compressed
+//-------------------------------------------------
+
+class ram_state::chunk
+{
+public:
+	static constexpr size_t SIZE = 4096;
+
+	chunk(const u8 *data, size_t length, bool compress, size_t &total);
+	~chunk() { m_total -= m_data.size(); }
+
+	bool matches(const u8 *data, size_t length) const;
+	void expand(u8 *dest) const;
+	size_t length() const { return m_length; }
+
+private:
+	// encoding: a control byte below 0x80 is followed by control+1 literal
+	// bytes, otherwise the next byte is repeated control-0x7d times
+	static constexpr unsigned MIN_RUN = 3;
+	static constexpr unsigned MAX_RUN = 0xff - 0x7d;
+	static constexpr unsigned MAX_LITERAL = 0x80;
+
+	std::vector<u8> m_data;
+	size_t          m_length;
+	bool            m_compressed;
+	size_t &        m_total;
+};
+
+
+ram_state::chunk::chunk(const u8 *data, size_t length, bool compress, size_t &total)
+	: m_length(length)
+	, m_compressed(false)
+	, m_total(total)
+{
+	if (compress)
+	{
+		m_data.reserve(length);
+		size_t pos = 0, literal = 0;
+		auto flush_literal = [&] ()
+		{
+			while (literal != pos)
+			{
+				const size_t count = std::min<size_t>(pos - literal, MAX_LITERAL);
+				m_data.push_back(u8(count - 1));
+				m_data.insert(m_data.end(), data + literal, data + literal + count);
+				literal += count;
+			}
+		};
+		while ((pos < length) && (m_data.size() < length))
+		{
+			size_t run = 1;
+			while ((pos + run < length) && (run < MAX_RUN) && (data[pos + run] == data[pos]))
+				run++;
+			if (run >= MIN_RUN)
+			{
+				flush_literal();
+				m_data.push_back(u8(run + 0x7d));
+				m_data.push_back(data[pos]);
+				pos += run;
+				literal = pos;
+			}
+			else
+			{
+				pos += run;
+			}
+		}
+		flush_literal();
+
+		// only keep it if it actually got smaller
+		m_compressed = m_data.size() < length;
+		if (m_compressed)
+			m_data.shrink_to_fit();
+		else
+			m_data.clear();
+	}
+	if (!m_compressed)
+		m_data.assign(data, data + length);
+	m_total += m_data.size();
+}
+
+
+bool ram_state::chunk::matches(const u8 *data, size_t length) const
+{
+	if (length != m_length)
+		return false;
+	if (!m_compressed)
+		return !memcmp(m_data.data(), data, length);
+
+	// compare while decoding rather than expanding to a buffer
+	for (size_t src = 0, dst = 0; src < m_data.size(); )
+	{
+		const u8 control = m_data[src++];
+		if (control < 0x80)
+		{
+			if (memcmp(&m_data[src], data + dst, control + 1))
+				return false;
+			src += control + 1;
+			dst += control + 1;
+		}
+		else
+		{
+			const u8 value = m_data[src++];
+			for (const size_t end = dst + control - 0x7d; dst != end; dst++)
+				if (data[dst] != value)
+					return false;
+		}
+	}
+	return true;
+}
+
+
+void ram_state::chunk::expand(u8 *dest) const
+{
+	if (!m_compressed)
+	{
+		memcpy(dest, m_data.data(), m_length);
+		return;
+	}
+
+	for (size_t src = 0; src < m_data.size(); )
+	{
+		const u8 control = m_data[src++];
+		if (control < 0x80)
+		{
+			memcpy(dest, &m_data[src], control + 1);
+			src += control + 1;
+			dest += control + 1;
+		}
+		else
+		{
+			memset(dest, m_data[src++], control - 0x7d);
+			dest += control - 0x7d;
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  ram_state - constructor
 //-------------------------------------------------
 
-ram_state::ram_state(save_manager &save)
+ram_state::ram_state(save_manager &save, bool delta)
 	: m_save(save)
 	, m_data()
 	, m_valid(false)
 	, m_time(m_save.machine().time())
 {
-	m_data.reserve(get_size(save));
+	// delta states keep their data in shared chunks, don't reserve a full copy
+	if (!delta)
+		m_data.reserve(get_size(save));
 	m_data.clear();
 	m_data.rdbuf()->clear();
 	m_data.seekp(0);
@@ -639,6 +936,66 @@ save_error ram_state::save()
 }
 
 
+//-------------------------------------------------
+//  save_delta - write the current machine state
+//  as chunks, sharing every chunk that matches
+//  the reference state
+//-------------------------------------------------
+
+save_error ram_state::save_delta(const chunk_list &reference, bool compress, size_t &total)
+{
+	// initialize
+	m_valid = false;
+
+	chunk_list chunks;
+	chunks.reserve(reference.size());
+	std::vector<u8> staging;
+	staging.reserve(chunk::SIZE);
+	auto const flush =
+			[&] ()
+			{
+				const size_t index = chunks.size();
+				if ((index < reference.size()) && reference[index]->matches(staging.data(), staging.size()))
+					chunks.emplace_back(reference[index]);
+				else
+					chunks.emplace_back(std::make_shared<const chunk>(staging.data(), staging.size(), compress, total));
+				staging.clear();
+			};
+
+	// the layout of the serialised state never changes, so chunk N always
+	// covers the same entries and unchanged chunks line up with the reference
+	const save_error err = m_save.do_write(
+			[] (size_t total_size) { return true; },
+			[&] (const void *data, size_t size)
+			{
+				const u8 *src = reinterpret_cast<const u8 *>(data);
+				while (size)
+				{
+					const size_t count = std::min(size, chunk::SIZE - staging.size());
+					staging.insert(staging.end(), src, src + count);
+					src += count;
+					size -= count;
+					if (staging.size() == chunk::SIZE)
+						flush();
+				}
+				return true;
+			},
+			[] () { return true; },
+			[] () { return true; });
+	if (err != STATERR_NONE)
+		return err;
+	if (!staging.empty())
+		flush();
+
+	// final confirmation
+	m_chunks = std::move(chunks);
+	m_valid = true;
+	m_time = m_save.machine().time();
+
+	return STATERR_NONE;
+}
+
+
 //-------------------------------------------------
 //  load - restore the machine state from the
 //  stream
@@ -646,11 +1003,43 @@ save_error ram_state::save()
 
 save_error ram_state::load()
 {
-	// initialize
-	m_data.seekg(0);
+	if (m_chunks.empty())
+	{
+		// initialize
+		m_data.seekg(0);
 
-	// get the save manager to load state
-	return m_save.read_stream(m_data);
+		// get the save manager to load state
+		return m_save.read_stream(m_data);
+	}
+
+	// delta state: expand the chunks in order as the save manager asks for data
+	u8 staging[chunk::SIZE];
+	size_t index = 0, pos = 0, avail = 0;
+	return m_save.do_read(
+			[] (size_t total_size) { return true; },
+			[&] (void *data, size_t size)
+			{
+				u8 *dest = reinterpret_cast<u8 *>(data);
+				while (size)
+				{
+					if (pos == avail)
+					{
+						if (index == m_chunks.size())
+							return false;
+						m_chunks[index]->expand(staging);
+						avail = m_chunks[index++]->length();
+						pos = 0;
+					}
+					const size_t count = std::min(size, avail - pos);
+					memcpy(dest, &staging[pos], count);
+					dest += count;
+					pos += count;
+					size -= count;
+				}
+				return true;
+			},
+			[] () { return true; },
+			[] () { return true; });
 }
 
 
@@ -666,6 +1055,9 @@ rewinder::rewinder(save_manager &save)
 	, m_first_invalid_index(REWIND_INDEX_NONE)
 	, m_first_time_warning(true)
 	, m_first_time_note(true)
+	, m_delta(save.machine().options().rewind_delta())
+	, m_compress(save.machine().options().rewind_compress())
+	, m_chunk_bytes(0)
 {
 }
 
@@ -735,11 +1127,13 @@ bool rewinder::capture()
 		return false;
 	}
 
+	ram_state *captured;
 	if (current_index_is_last())
 	{
 		// we need to create a new state
-		std::unique_ptr<ram_state> state = std::make_unique<ram_state>(m_save);
-		const save_error error = state->save();
+		std::unique_ptr<ram_state> state = std::make_unique<ram_state>(m_save, m_delta);
+		captured = state.get();
+		const save_error error = m_delta ? state->save_delta(m_reference, m_compress, m_chunk_bytes) : state->save();
 
 		// validate the state
 		if (error == STATERR_NONE)
@@ -759,7 +1153,8 @@ bool rewinder::capture()
 
 		// update the existing state
 		ram_state *state = m_state_list.at(m_current_index).get();
-		const save_error error = state->save();
+		captured = state;
+		const save_error error = m_delta ? state->save_delta(m_reference, m_compress, m_chunk_bytes) : state->save();
 
 		// validate the state
 		if (error != STATERR_NONE)
@@ -770,6 +1165,10 @@ bool rewinder::capture()
 		}
 	}
 
+	// later captures share whatever this one has in common with them
+	if (m_delta)
+		m_reference = captured->chunks();
+
 	// make sure we will fit in
 	if (!check_size())
 		// the list keeps growing
@@ -818,11 +1217,14 @@ bool rewinder::step()
 	// try to load and report the result
 	const save_error error = state->load();
 	report_error(error, rewind_operation::LOAD);
+	if (error != save_error::STATERR_NONE)
+		return false;
 
-	if (error == save_error::STATERR_NONE)
-		return true;
+	// only a state that actually loaded can serve as the next delta base
+	if (m_delta)
+		m_reference = state->chunks();
 
-	return false;
+	return true;
 }
 
 
@@ -837,9 +1239,9 @@ bool rewinder::check_size()
 	if (!m_enabled)
 		return false;
 
-	// state sizes in bytes
+	// state sizes in bytes; a delta state can be as large as a full one
 	const size_t singlesize = ram_state::get_size(m_save);
-	size_t totalsize = m_state_list.size() * singlesize;
+	size_t totalsize = total_size();
 
 	// convert our limit from megabytes
 	const size_t capsize = m_capacity * 1024 * 1024;
@@ -847,15 +1249,29 @@ bool rewinder::check_size()
 	// safety check that shouldn't be allowed to trigger
 	if (totalsize > capsize)
 	{
-		// states to remove
-		const u32 count = (totalsize - capsize) / singlesize;
+		if (!m_delta)
+		{
+			// states to remove
+			const u32 count = (totalsize - capsize) / singlesize;
 
-		// drop everything that's beyond capacity
-		m_state_list.erase(m_state_list.begin(), m_state_list.begin() + count);
+			// drop everything that's beyond capacity
+			m_state_list.erase(m_state_list.begin(), m_state_list.begin() + count);
+		}
+		else
+		{
+			// chunks are shared, so drop the oldest states until enough is freed
+			s32 count = 0;
+			while ((total_size() > capsize) && (count < m_current_index))
+				m_state_list[count++].reset();
+			m_state_list.erase(m_state_list.begin(), m_state_list.begin() + count);
+			m_current_index -= count;
+			if (m_first_invalid_index > REWIND_INDEX_NONE)
+				m_first_invalid_index = std::max<s32>(m_first_invalid_index - count, REWIND_INDEX_FIRST);
+		}
 	}
 
 	// update before new check
-	totalsize = m_state_list.size() * singlesize;
+	totalsize = total_size();
 
 	// check if capacity will be hit by the newly captured state
 	if (totalsize + singlesize >= capsize)
@@ -868,6 +1284,7 @@ bool rewinder::check_size()
 		// we can now get the first state and invalidate it
 		std::unique_ptr<ram_state> first(std::move(m_state_list.front()));
 		first->m_valid = false;
+		first->release();
 
 		// move it to the end for future use
 		m_state_list.push_back(std::move(first));
@@ -888,6 +1305,17 @@ bool rewinder::check_size()
 }
 
 
+//-------------------------------------------------
+//  total_size - memory currently held by the
+//  rewind states
+//-------------------------------------------------
+
+size_t rewinder::total_size() const
+{
+	return m_delta ? m_chunk_bytes : (m_state_list.size() * ram_state::get_size(m_save));
+}
+
+
 //-------------------------------------------------
 //  report_error - report rewind results
 //-------------------------------------------------
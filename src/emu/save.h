@@ -153,6 +153,7 @@ public:
 
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -303,6 +304,12 @@ public:
 	save_error write_file(util::core_file &file);
 	save_error read_file(util::core_file &file);
 
+	// capture the state now and compress/write it on a worker thread
+	save_error write_file_async(std::unique_ptr<emu_file> &&file, std::string &&name);
+	bool async_pending() const { return bool(m_async); }
+	bool async_complete(save_error &result, std::string &name);
+	void wait_async();
+
 	save_error write_stream(std::ostream &str);
 	save_error read_stream(std::istream &str);
 
@@ -328,6 +335,7 @@ private:
 	u32 signature() const;
 	void dump_registry() const;
 	static save_error validate_header(const u8 *header, const char *gamename, u32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
+	static void *async_write_callback(void *param, int threadid);
 
 	// internal state
 	running_machine &         m_machine;              // reference to our machine
@@ -338,21 +346,35 @@ private:
 	std::vector<std::unique_ptr<ram_state>>      m_ramstate_list;    // list of ram states
 	std::vector<std::unique_ptr<state_callback>> m_presave_list;     // list of pre-save functions
 	std::vector<std::unique_ptr<state_callback>> m_postload_list;    // list of post-load functions
+
+	struct async_save;
+	std::unique_ptr<async_save> m_async;          // asynchronous save in flight
+	osd_work_queue *          m_async_queue;          // queue for asynchronous saves
 };
 
 class ram_state
 {
+public:
+	// fixed-size piece of a serialised state, shared between delta states
+	class chunk;
+	using chunk_list = std::vector<std::shared_ptr<const chunk> >;
+
+private:
 	save_manager &     m_save;                        // reference to save_manager
 	util::vectorstream m_data;                        // save data buffer
+	chunk_list         m_chunks;                      // delta mode: serialised state split into chunks
 
 public:
 	bool               m_valid;                       // can we load this state?
 	attotime           m_time;                        // machine timestamp
 
-	ram_state(save_manager &save);
+	ram_state(save_manager &save, bool delta = false);
 	static size_t get_size(save_manager &save);
 	save_error save();
+	save_error save_delta(const chunk_list &reference, bool compress, size_t &total);
 	save_error load();
+	const chunk_list &chunks() const { return m_chunks; }
+	void release() { m_chunks.clear(); }
 };
 
 class rewinder
@@ -364,6 +386,10 @@ class rewinder
 	s32            m_first_invalid_index;             // all states before this one are guarateed to be valid
 	bool           m_first_time_warning;              // keep track of warnings we report
 	bool           m_first_time_note;                 // keep track of notes
+	bool           m_delta;                           // store only the chunks that changed since the last capture
+	bool           m_compress;                        // run-length compress changed chunks
+	size_t         m_chunk_bytes;                     // delta mode: memory held by all live chunks
+	ram_state::chunk_list m_reference;                // delta mode: chunks of the last captured/loaded state
 	std::vector<std::unique_ptr<ram_state>> m_state_list; // rewinder's own ram states
 
 	// load/save management
@@ -380,6 +406,7 @@ class rewinder
 	};
 
 	bool check_size();
+	size_t total_size() const;
 	bool current_index_is_last() { return m_current_index == m_state_list.size() - 1; }
 	void report_error(save_error type, rewind_operation operation);
 
@@ -10,6 +10,9 @@
 
 #include "emu.h"
 #include "debugger.h"
+#include "screen.h"
+
+#include <algorithm>
 
 //**************************************************************************
 //  DEBUGGING
@@ -48,6 +51,8 @@ inline emu_timer::emu_timer() noexcept :
 	m_scheduler(nullptr),
 	m_next(nullptr),
 	m_prev(nullptr),
+	m_heap_index(-1),
+	m_sequence(0),
 	m_param(0),
 	m_enabled(false),
 	m_temporary(false),
@@ -83,6 +88,7 @@ inline emu_timer &emu_timer::init(
 	m_scheduler = &machine.scheduler();
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_index = -1;
 	m_callback = std::move(callback);
 	m_param = param;
 	m_temporary = temporary;
@@ -96,9 +102,9 @@ inline emu_timer &emu_timer::init(
 	if (!m_temporary)
 		register_save(machine.save());
 
-	// insert into the list
+	// insert into the heap
 	m_scheduler->timer_list_insert(*this);
-	if (this == m_scheduler->first_timer())
+	if (m_heap_index == 0)
 		m_scheduler->abort_timeslice();
 
 	return *this;
@@ -204,7 +210,7 @@ void emu_timer::register_save(save_manager &manager)
 	// determine our instance number - timers are indexed based on the callback function name
 	int index = 0;
 	std::string name = m_callback.name() ? m_callback.name() : "unnamed";
-	for (const emu_timer *curtimer = m_scheduler->first_timer(); curtimer; curtimer = curtimer->m_next)
+	for (const emu_timer *curtimer : m_scheduler->m_timer_heap)
 	{
 		if (!curtimer->m_temporary)
 		{
@@ -283,21 +289,28 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_executing_device(nullptr),
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
-	m_timer_list(nullptr),
+	m_timer_sequence(0),
 	m_inactive_timers(nullptr),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
-	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
+	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000),
+	m_stats_enabled(false),
+	m_stats_report(false),
+	m_stat_timeslices(0),
+	m_stat_synchronizes(0),
+	m_stat_boosts(0),
+	m_stat_boosted_time(attotime::zero)
 {
-	// append a single never-expiring timer so there is always one in the list
+	// add a single never-expiring timer so there is always one in the heap
 	// need to subvert it because it would naturally be inserted in the inactive list
-	m_timer_list = &timer_list_remove(m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), attotime::never, 0, true));
+	emu_timer &sentinel = timer_list_remove(m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), attotime::never, 0, true));
+	sentinel.m_heap_index = 0;
+	m_timer_heap.push_back(&sentinel);
 
-	assert(m_timer_list);
-	assert(!m_timer_list->m_prev);
-	assert(!m_timer_list->m_next);
+	assert(!sentinel.m_prev);
+	assert(!sentinel.m_next);
 	assert(!m_inactive_timers);
 
 	// register global states
@@ -316,8 +329,12 @@ device_scheduler::~device_scheduler()
 	// remove all timers
 	while (m_inactive_timers)
 		m_timer_allocator.reclaim(timer_list_remove(*m_inactive_timers));
-	while (m_timer_list)
-		m_timer_allocator.reclaim(timer_list_remove(*m_timer_list));
+	for (emu_timer *timer : m_timer_heap)
+	{
+		timer->m_heap_index = -1;
+		m_timer_allocator.reclaim(*timer);
+	}
+	m_timer_heap.clear();
 }
 
 
@@ -333,7 +350,8 @@ attotime device_scheduler::time() const noexcept
 
 	// if we're executing as a particular CPU, use its local time as a base
 	// otherwise, return the global base time
-	return (m_executing_device != nullptr) ? m_executing_device->local_time() : m_basetime;
+	device_execute_interface *const exec = currently_executing();
+	return (exec != nullptr) ? exec->local_time() : m_basetime;
 }
 
 
@@ -345,7 +363,7 @@ attotime device_scheduler::time() const noexcept
 bool device_scheduler::can_save() const
 {
 	// if any live temporary timers exit, fail
-	for (emu_timer *timer = m_timer_list; timer; timer = timer->m_next)
+	for (emu_timer *timer : m_timer_heap)
 	{
 		if (timer->m_temporary && !timer->expire().is_never())
 		{
@@ -402,14 +420,16 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < first_timer()->m_expire)
 	{
+		auto trace = g_runtime_trace.start("timeslice");
+
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (first_timer()->m_expire < target)
+			target = first_timer()->m_expire;
 
 		LOG("------------------\n");
 		LOG("cpu_timeslice: target = %s\n", target.as_string(PRECISION));
@@ -439,7 +459,8 @@ void device_scheduler::timeslice()
 				else if (delta >= exec->m_attoseconds_per_cycle)
 				{
 					// compute how many cycles we want to execute
-					int ran = exec->m_cycles_running = divu_64x32(u64(delta) >> exec->m_divshift, exec->m_divisor);
+					int const requested = exec->m_cycles_running = divu_64x32(u64(delta) >> exec->m_divshift, exec->m_divisor);
+					int ran = requested;
 					LOG("  cpu '%s': %d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running);
 
 					// if we're not suspended, actually execute
@@ -452,6 +473,7 @@ void device_scheduler::timeslice()
 						exec->m_cycles_stolen = 0;
 						m_executing_device = exec;
 						*exec->m_icountptr = exec->m_cycles_running;
+						osd_ticks_t const start = m_stats_enabled ? osd_ticks() : 0;
 						if (!call_debugger)
 							exec->run();
 						else
@@ -460,6 +482,8 @@ void device_scheduler::timeslice()
 							exec->run();
 							exec->debugger_stop_cpu_hook();
 						}
+						if (m_stats_enabled)
+							exec->m_stat_host_ticks += osd_ticks() - start;
 
 						// adjust for any cycles we took back
 						assert(ran >= *exec->m_icountptr);
@@ -468,34 +492,21 @@ void device_scheduler::timeslice()
 						ran -= exec->m_cycles_stolen;
 					}
 
-					// account for these cycles
-					exec->m_totalcycles += ran;
-
-					// update the local time for this CPU
-					attotime deltatime;
-					if (ran < exec->m_cycles_per_second)
-						deltatime = attotime(0, exec->m_attoseconds_per_cycle * ran);
-					else
-					{
-						u32 remainder;
-						s32 secs = divu_64x32_rem(ran, exec->m_cycles_per_second, remainder);
-						deltatime = attotime(secs, u64(remainder) * exec->m_attoseconds_per_cycle);
-					}
-					assert(deltatime >= attotime::zero);
-					exec->m_localtime += deltatime;
-					LOG("         %d ran, %d total, time = %s\n", ran, s32(exec->m_totalcycles), exec->m_localtime.as_string(PRECISION));
-
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
-					{
-						target = std::max(exec->m_localtime, m_basetime);
-						LOG("         (new target)\n");
-					}
+					// account for these cycles and update the local time for this CPU
+					account_cycles(*exec, requested, ran, target);
 				}
 			}
 		}
 		m_executing_device = nullptr;
 
+		// the base quantum never expires, so anything else at the head is a boost
+		if (m_stats_enabled)
+		{
+			m_stat_timeslices++;
+			if (!m_quantum_list.first()->m_expire.is_never())
+				m_stat_boosted_time += target - m_basetime;
+		}
+
 		// update the base time
 		m_basetime = target;
 	}
@@ -512,8 +523,9 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice() noexcept
 {
-	if (m_executing_device != nullptr)
-		m_executing_device->abort_timeslice();
+	device_execute_interface *const exec = currently_executing();
+	if (exec != nullptr)
+		exec->abort_timeslice();
 }
 
 
@@ -554,6 +566,9 @@ void device_scheduler::add_quantum(const attotime &quantum, const attotime &dura
 	attotime expire = curtime + duration;
 	const attoseconds_t quantum_attos = quantum.attoseconds();
 
+	if (m_stats_enabled && !duration.is_never())
+		m_stat_boosts++;
+
 	// figure out where to insert ourselves, expiring any quanta that are out-of-date
 	quantum_slot *insert_after = nullptr;
 	quantum_slot *next;
@@ -632,6 +647,9 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 void device_scheduler::synchronize(timer_expired_delegate callback, s32 param)
 {
+	if (m_stats_enabled)
+		m_stat_synchronizes++;
+
 	m_timer_allocator.alloc()->init(
 			machine(),
 			std::move(callback),
@@ -694,30 +712,39 @@ void device_scheduler::postload()
 		timer_list_remove(timer).m_next = private_list;
 		private_list = &timer;
 	}
-	while (m_timer_list->m_next)
+	emu_timer *sentinel = nullptr;
+	while (!m_timer_heap.empty())
 	{
-		emu_timer &timer = *m_timer_list;
+		// taking from the back of the heap never needs reordering
+		emu_timer &timer = timer_list_remove(*m_timer_heap.back());
 
 		if (timer.m_temporary)
 		{
-			assert(!timer.expire().is_never());
+			if (timer.m_expire.is_never())
+			{
+				// our special never-expiring timer is put back on its own
+				assert(!sentinel);
+				sentinel = &timer;
+				continue;
+			}
 
-			// temporary timers go away entirely (except our special never-expiring one)
+			// temporary timers go away entirely
 			timer.m_callback.reset();
-			m_timer_allocator.reclaim(timer_list_remove(timer));
+			m_timer_allocator.reclaim(timer);
 		}
 		else
 		{
 			// permanent ones get added to our private list
-			timer_list_remove(timer).m_next = private_list;
+			timer.m_next = private_list;
 			private_list = &timer;
 		}
 	}
 
 	// special dummy timer
-	assert(!m_timer_list->m_enabled);
-	assert(m_timer_list->m_temporary);
-	assert(m_timer_list->m_expire.is_never());
+	assert(sentinel);
+	assert(!sentinel->m_enabled);
+	sentinel->m_heap_index = 0;
+	m_timer_heap.push_back(sentinel);
 
 	// now re-insert them; this effectively re-sorts them by time
 	while (private_list)
@@ -835,44 +862,126 @@ void device_scheduler::rebuild_execute_list()
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  account_cycles - add the cycles a device ran
+//  to its totals, advance its local time, and
+//  pull the timeslice target back if it stopped
+//  short
 //-------------------------------------------------
 
-inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+inline void device_scheduler::account_cycles(device_execute_interface &exec, int requested, int ran, attotime &target)
 {
-	// disabled timers never expire
-	if (!timer.m_expire.is_never() && timer.m_enabled)
+	if (m_stats_enabled)
 	{
-		// loop over the timer list
-		emu_timer *prevtimer = nullptr;
-		for (emu_timer *curtimer = m_timer_list; curtimer; prevtimer = curtimer, curtimer = curtimer->m_next)
-		{
-			// if the current list entry expires after us, we should be inserted before it
-			if (curtimer->m_expire > timer.m_expire)
-			{
-				// link the new guy in before the current list entry
-				timer.m_prev = prevtimer;
-				timer.m_next = curtimer;
+		exec.m_stat_timeslices++;
+		exec.m_stat_cycles_requested += requested;
+		exec.m_stat_cycles_executed += ran;
+		if ((exec.m_suspend == 0) && ((ran + exec.m_cycles_stolen) > requested))
+			exec.m_stat_cycles_overshoot += ran + exec.m_cycles_stolen - requested;
+	}
 
-				if (prevtimer)
-					prevtimer->m_next = &timer;
-				else
-					m_timer_list = &timer;
+	// account for these cycles
+	exec.m_totalcycles += ran;
 
-				curtimer->m_prev = &timer;
-				return timer;
-			}
+	// update the local time for this CPU
+	attotime const deltatime = exec.m_cycle_converter.to_attotime(ran);
+	assert(deltatime >= attotime::zero);
+	exec.m_localtime += deltatime;
+	LOG("         %d ran, %d total, time = %s\n", ran, s32(exec.m_totalcycles), exec.m_localtime.as_string(PRECISION));
+
+	// if the new local CPU time is less than our target, move the target up, but not before the base
+	if (exec.m_localtime < target)
+	{
+		target = std::max(exec.m_localtime, m_basetime);
+		LOG("         (new target)\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  timer_heap_less - heap ordering; equal expiry
+//  times fire in the order they were inserted
+//-------------------------------------------------
+
+static inline bool timer_heap_less(const attotime &aexpire, u64 aseq, const attotime &bexpire, u64 bseq) noexcept
+{
+	return (aexpire < bexpire) || ((aexpire == bexpire) && (aseq < bseq));
+}
+
+
+//-------------------------------------------------
+//  timer_heap_up - move a timer towards the root
+//  of the heap until its parent is earlier
+//-------------------------------------------------
+
+inline void device_scheduler::timer_heap_up(s32 index) noexcept
+{
+	emu_timer *const timer = m_timer_heap[index];
+	while (index > 0)
+	{
+		s32 const parent = (index - 1) >> 1;
+		emu_timer *const ptimer = m_timer_heap[parent];
+		if (!timer_heap_less(timer->m_expire, timer->m_sequence, ptimer->m_expire, ptimer->m_sequence))
+			break;
+		m_timer_heap[index] = ptimer;
+		ptimer->m_heap_index = index;
+		index = parent;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_down - move a timer away from the
+//  root of the heap until its children are later
+//-------------------------------------------------
+
+inline void device_scheduler::timer_heap_down(s32 index) noexcept
+{
+	s32 const count = s32(m_timer_heap.size());
+	emu_timer *const timer = m_timer_heap[index];
+	while (true)
+	{
+		s32 child = (index << 1) + 1;
+		if (child >= count)
+			break;
+		if ((child + 1) < count)
+		{
+			emu_timer const *const left = m_timer_heap[child];
+			emu_timer const *const right = m_timer_heap[child + 1];
+			if (timer_heap_less(right->m_expire, right->m_sequence, left->m_expire, left->m_sequence))
+				child++;
 		}
+		emu_timer *const ctimer = m_timer_heap[child];
+		if (!timer_heap_less(ctimer->m_expire, ctimer->m_sequence, timer->m_expire, timer->m_sequence))
+			break;
+		m_timer_heap[index] = ctimer;
+		ctimer->m_heap_index = index;
+		index = child;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
 
-		// need to insert after the last one
-		if (prevtimer)
-			prevtimer->m_next = &timer;
-		else
-			m_timer_list = &timer;
 
-		timer.m_prev = prevtimer;
+//-------------------------------------------------
+//  timer_list_insert - insert a new timer into
+//  the active heap or the inactive list
+//-------------------------------------------------
+
+inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+{
+	assert(timer.m_heap_index < 0);
+
+	// disabled timers never expire
+	if (!timer.m_expire.is_never() && timer.m_enabled)
+	{
+		// a fresh sequence number places us after any timer with the same expiry
+		timer.m_sequence = m_timer_sequence++;
 		timer.m_next = nullptr;
+		timer.m_prev = nullptr;
+		m_timer_heap.push_back(&timer);
+		timer_heap_up(s32(m_timer_heap.size() - 1));
 	}
 	else
 	{
@@ -891,19 +1000,34 @@ inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  active heap or the inactive list
 //-------------------------------------------------
 
 inline emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
-	// remove it from the list
-	if (timer.m_prev)
+	if (timer.m_heap_index >= 0)
 	{
-		timer.m_prev->m_next = timer.m_next;
+		// fill the hole with the last entry and restore the heap order around it
+		s32 const index = timer.m_heap_index;
+		emu_timer *const last = m_timer_heap.back();
+		m_timer_heap.pop_back();
+		timer.m_heap_index = -1;
+		if (last != &timer)
+		{
+			m_timer_heap[index] = last;
+			last->m_heap_index = index;
+			if ((index > 0) && timer_heap_less(last->m_expire, last->m_sequence, m_timer_heap[(index - 1) >> 1]->m_expire, m_timer_heap[(index - 1) >> 1]->m_sequence))
+				timer_heap_up(index);
+			else
+				timer_heap_down(index);
+		}
+		return timer;
 	}
-	else if (&timer == m_timer_list)
+
+	// remove it from the inactive list
+	if (timer.m_prev)
 	{
-		m_timer_list = timer.m_next;
+		timer.m_prev->m_next = timer.m_next;
 	}
 	else
 	{
@@ -924,13 +1048,13 @@ inline emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 
 inline void device_scheduler::execute_timers()
 {
-	LOG("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION));
+	LOG("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), first_timer()->m_expire.as_string(PRECISION));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (first_timer()->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *first_timer();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -982,9 +1106,77 @@ void device_scheduler::dump_timers() const
 {
 	machine().logerror("=============================================\n");
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = m_timer_list; timer; timer = timer->m_next)
+	std::vector<emu_timer *> active(m_timer_heap);
+	std::sort(
+			active.begin(),
+			active.end(),
+			[] (emu_timer const *a, emu_timer const *b)
+			{
+				return (a->m_expire < b->m_expire) || ((a->m_expire == b->m_expire) && (a->m_sequence < b->m_sequence));
+			});
+	for (emu_timer *timer : active)
 		timer->dump();
 	for (emu_timer *timer = m_inactive_timers; timer; timer = timer->m_next)
 		timer->dump();
 	machine().logerror("=============================================\n");
 }
+
+
+//-------------------------------------------------
+//  reset_stats - clear the scheduler statistics
+//-------------------------------------------------
+
+void device_scheduler::reset_stats()
+{
+	m_stat_timeslices = 0;
+	m_stat_synchronizes = 0;
+	m_stat_boosts = 0;
+	m_stat_boosted_time = attotime::zero;
+	for (device_execute_interface &exec : execute_interface_enumerator(machine().root_device()))
+	{
+		exec.m_stat_timeslices = 0;
+		exec.m_stat_cycles_requested = 0;
+		exec.m_stat_cycles_executed = 0;
+		exec.m_stat_cycles_overshoot = 0;
+		exec.m_stat_aborts = 0;
+		exec.m_stat_host_ticks = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  report_stats - print the scheduler statistics
+//  if they were enabled with -schedstats or
+//  from Lua
+//-------------------------------------------------
+
+void device_scheduler::report_stats()
+{
+	if (!m_stats_report)
+		return;
+
+	// frames come from the first screen, if there is one
+	screen_device *const screen = screen_device_enumerator(machine().root_device()).first();
+	u64 const frames = screen ? screen->frame_number() : 0;
+
+	osd_printf_info("Scheduler statistics after %s seconds\n", m_basetime.as_string(3));
+	if (frames)
+		osd_printf_info("  timeslices:     %u (%.1f per frame)\n", m_stat_timeslices, double(m_stat_timeslices) / double(frames));
+	else
+		osd_printf_info("  timeslices:     %u\n", m_stat_timeslices);
+	osd_printf_info("  synchronize:    %u\n", m_stat_synchronizes);
+	osd_printf_info("  quantum boosts: %u (%s seconds boosted)\n", m_stat_boosts, m_stat_boosted_time.as_string(6));
+	osd_printf_info("  %-24s %10s %14s %14s %10s %10s %10s\n", "device", "timeslices", "requested", "executed", "overshoot", "aborts", "host s");
+	for (device_execute_interface &exec : execute_interface_enumerator(machine().root_device()))
+	{
+		osd_printf_info(
+				"  %-24s %10u %14u %14u %10u %10u %10.3f\n",
+				exec.device().tag(),
+				exec.stat_timeslices(),
+				exec.stat_cycles_requested(),
+				exec.stat_cycles_executed(),
+				exec.stat_cycles_overshoot(),
+				exec.stat_aborts(),
+				double(exec.stat_host_ticks()) / double(osd_ticks_per_second()));
+	}
+}
@@ -17,6 +17,8 @@
 #ifndef MAME_EMU_SCHEDULE_H
 #define MAME_EMU_SCHEDULE_H
 
+#include <vector>
+
 
 //**************************************************************************
 //  MACROS
@@ -76,8 +78,10 @@ private:
 
 	// internal state
 	device_scheduler *  m_scheduler;    // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the inactive list
+	emu_timer *         m_prev;         // previous timer in the inactive list
+	s32                 m_heap_index;   // position in the active timer heap, or -1 if not in it
+	u64                 m_sequence;     // insertion order, breaks ties between equal expiry times
 	timer_expired_delegate m_callback;  // callback function
 	s32                 m_param;        // integer parameter
 	bool                m_enabled;      // is the timer enabled?
@@ -107,7 +111,7 @@ public:
 	// getters
 	running_machine &machine() const noexcept { return m_machine; }
 	attotime time() const noexcept;
-	emu_timer *first_timer() const noexcept { return m_timer_list; }
+	emu_timer *first_timer() const noexcept { return m_timer_heap.front(); }
 	device_execute_interface *currently_executing() const noexcept { return m_executing_device; }
 	bool can_save() const;
 
@@ -128,6 +132,17 @@ public:
 	// debugging
 	void dump_timers() const;
 
+	// statistics, gathered when -schedstats is enabled
+	bool stats_enabled() const noexcept { return m_stats_enabled; }
+	void set_stats_enabled(bool enabled) noexcept { m_stats_enabled = enabled; m_stats_report = m_stats_report || enabled; }
+	void gather_stats() noexcept { m_stats_enabled = true; }
+	void reset_stats();
+	void report_stats();
+	u64 stat_timeslices() const noexcept { return m_stat_timeslices; }
+	u64 stat_synchronizes() const noexcept { return m_stat_synchronizes; }
+	u64 stat_boosts() const noexcept { return m_stat_boosts; }
+	attotime stat_boosted_time() const noexcept { return m_stat_boosted_time; }
+
 	// for emergencies only!
 	void eat_all_cycles();
 
@@ -141,10 +156,13 @@ private:
 	void compute_perfect_interleave();
 	void rebuild_execute_list();
 	void apply_suspend_changes();
+	void account_cycles(device_execute_interface &exec, int requested, int ran, attotime &target);
 
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	void timer_heap_up(s32 index) noexcept;
+	void timer_heap_down(s32 index) noexcept;
 	void execute_timers();
 
 	// internal state
@@ -153,8 +171,10 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// active timers are kept in a binary min-heap ordered on (expire, sequence);
+	// a never-expiring sentinel guarantees it is never empty
+	std::vector<emu_timer *>    m_timer_heap;               // heap of active timers
+	u64                         m_timer_sequence;           // next insertion sequence number
 	emu_timer *                 m_inactive_timers;          // head of the inactive timer list
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
@@ -180,6 +200,14 @@ private:
 	simple_list<quantum_slot>   m_quantum_list;             // list of active quanta
 	fixed_allocator<quantum_slot> m_quantum_allocator;      // allocator for quanta
 	attoseconds_t               m_quantum_minimum;          // duration of minimum quantum
+
+	// statistics
+	bool                        m_stats_enabled;            // gather statistics?
+	bool                        m_stats_report;             // print them at exit?
+	u64                         m_stat_timeslices;          // timeslice iterations
+	u64                         m_stat_synchronizes;        // synchronize() calls
+	u64                         m_stat_boosts;              // add_quantum()/perfect_quantum() boosts requested
+	attotime                    m_stat_boosted_time;        // emulated time spent under a boosted quantum
 };
 
 
@@ -16,11 +16,13 @@
 #include "main.h"
 #include "render.h"
 #include "rendutil.h"
+#include "tilemap.h"
 
 #include "nanosvg.h"
 #include "png.h"
 
 #include <set>
+#include <thread>
 
 
 //**************************************************************************
@@ -32,6 +34,15 @@
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// minimum number of scanlines worth handing to a worker in a banded update
+constexpr int BAND_MIN_HEIGHT = 16;
+
+
+
 //**************************************************************************
 //  GLOBAL VARIABLES
 //**************************************************************************
@@ -81,6 +92,9 @@ private:
 	int m_sx, m_sy;
 	double m_scale;
 	std::vector<u32> m_background;
+	std::vector<u32> m_composed;
+	bool m_dirty;
+	std::vector<int> m_to_draw;
 
 	std::vector<cached_bitmap> m_cache;
 
@@ -91,7 +105,7 @@ private:
 	void compute_diff_image(const std::vector<u32> &rend, const bbox &bb, cached_bitmap &dest) const;
 	void compute_dual_diff_image(const std::vector<u32> &rend, const bbox &bb, const cached_bitmap &src1, const cached_bitmap &src2, cached_bitmap &dest) const;
 	void rebuild_cache();
-	void blit(bitmap_rgb32 &bitmap, const cached_bitmap &src) const;
+	void blit(std::vector<u32> &dest, const cached_bitmap &src) const;
 };
 
 screen_device::svg_renderer::svg_renderer(memory_region *region)
@@ -121,6 +135,7 @@ screen_device::svg_renderer::svg_renderer(memory_region *region)
 
 	m_sx = m_sy = 0;
 	m_scale = 1.0;
+	m_dirty = true;
 
 	osd_printf_verbose("Parsed SVG '%s', aspect ratio %f\n", region->name(), (m_image->height == 0.0f) ? 0 : m_image->width / m_image->height);
 }
@@ -169,17 +184,15 @@ void screen_device::svg_renderer::render_state(std::vector<u32> &dest, const std
 	}
 }
 
-void screen_device::svg_renderer::blit(bitmap_rgb32 &bitmap, const cached_bitmap &src) const
+void screen_device::svg_renderer::blit(std::vector<u32> &dest, const cached_bitmap &src) const
 {
 	if(src.sy) {
 		const u32 *s = &src.image[0];
-		for(int y=0; y<src.sy; y++) {
-			u32 *d = &bitmap.pix(y + src.y, src.x);
-			for(int x=0; x<src.sx; x++, d++) {
-				const u32 c = *s++;
-				if(c)
-					*d = c;
-			}
+		for(int y=0; y<src.sy; y++, s += src.sx) {
+			// Branch-free so the compiler can vectorise it
+			u32 *d = &dest[(y + src.y) * m_sx + src.x];
+			for(int x=0; x<src.sx; x++)
+				d[x] = s[x] ? s[x] : d[x];
 		}
 	}
 }
@@ -197,25 +210,31 @@ int screen_device::svg_renderer::render(screen_device &screen, bitmap_rgb32 &bit
 		m_scale = sx > sy ? sy : sx;
 		m_background.resize(m_sx * m_sy);
 		rebuild_cache();
+		m_dirty = true;
 	}
 
-	for(unsigned int y = 0; y < m_sy; y++)
-		memcpy(bitmap.raw_pixptr(y, 0), &m_background[y * m_sx], m_sx * 4);
-
-	std::list<int> to_draw;
-	for(int key = 0; key != m_key_count; key++)
-		if(m_key_state[key])
-			to_draw.push_back(key);
-	while(!to_draw.empty()) {
-		int key = to_draw.front();
-		to_draw.pop_front();
-		blit(bitmap, m_cache[key]);
-		for(auto p : m_cache[key].pairs) {
-			if(m_key_state[p.key])
-				to_draw.push_back(p.cache_entry);
+	// Only composite when an output has changed, most frames show
+	// the same elements as the previous one
+	if(m_dirty) {
+		m_dirty = false;
+		m_composed = m_background;
+		m_to_draw.clear();
+		for(int key = 0; key != m_key_count; key++)
+			if(m_key_state[key])
+				m_to_draw.push_back(key);
+		for(unsigned int i = 0; i != m_to_draw.size(); i++) {
+			int key = m_to_draw[i];
+			blit(m_composed, m_cache[key]);
+			for(auto p : m_cache[key].pairs) {
+				if(m_key_state[p.key])
+					m_to_draw.push_back(p.cache_entry);
+			}
 		}
 	}
 
+	for(unsigned int y = 0; y < m_sy; y++)
+		memcpy(bitmap.raw_pixptr(y, 0), &m_composed[y * m_sx], m_sx * 4);
+
 	return 0;
 }
 
@@ -229,7 +248,10 @@ void screen_device::svg_renderer::output_change(const char *outname, s32 value)
 	auto l = m_key_ids.find(outname);
 	if (l == m_key_ids.end())
 		return;
-	m_key_state[l->second] = value;
+	if (m_key_state[l->second] != bool(value)) {
+		m_key_state[l->second] = value;
+		m_dirty = true;
+	}
 }
 
 void screen_device::svg_renderer::compute_initial_bboxes(std::vector<bbox> &bboxes)
@@ -571,6 +593,8 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 	, m_scanline_timer(nullptr)
 	, m_frame_number(0)
 	, m_partial_updates_this_frame(0)
+	, m_band_queue(nullptr)
+	, m_band_count(std::clamp<int>(std::thread::hardware_concurrency(), 2, 8))
 {
 	m_unique_id = m_id_counter;
 	m_id_counter++;
@@ -585,6 +609,8 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 screen_device::~screen_device()
 {
 	destroy_scan_bitmaps();
+	if (m_band_queue)
+		osd_work_queue_free(m_band_queue);
 }
 
 
@@ -1206,7 +1232,11 @@ bool screen_device::update_partial(int scanline)
 		}
 		else
 		{
-			if (m_type != SCREEN_TYPE_SVG)
+			if ((m_type != SCREEN_TYPE_SVG) && (m_video_attributes & VIDEO_PARALLEL_BANDS) && (clip.height() >= BAND_MIN_HEIGHT * 2) && !g_profiler.enabled())
+			{
+				flags = update_bands(clip);
+			}
+			else if (m_type != SCREEN_TYPE_SVG)
 			{
 				screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
 				switch (curbitmap.format())
@@ -1235,6 +1265,64 @@ bool screen_device::update_partial(int scanline)
 }
 
 
+//-------------------------------------------------
+//  update_bands - split an update into
+//  horizontal bands and draw them concurrently
+//-------------------------------------------------
+
+u32 screen_device::update_bands(const rectangle &clip)
+{
+	if (!m_band_queue)
+		m_band_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
+	// bring every tilemap up to date here, so the bands only ever read the
+	// pixmaps rather than racing to refresh the same dirty tiles
+	machine().tilemap().update_all_dirty();
+
+	// divide the rows as evenly as possible
+	int const bands = std::clamp(clip.height() / BAND_MIN_HEIGHT, 1, m_band_count);
+	m_bands.resize(bands);
+	int top = clip.top();
+	for (int band = 0; band < bands; band++)
+	{
+		int const bottom = clip.top() + (clip.height() * (band + 1)) / bands - 1;
+		m_bands[band].screen = this;
+		m_bands[band].clip.set(clip.left(), clip.right(), top, bottom);
+		m_bands[band].flags = 0;
+		top = bottom + 1;
+	}
+
+	osd_work_item_queue_multiple(m_band_queue, &screen_device::band_update_callback, bands, &m_bands[0], sizeof(m_bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(m_band_queue, osd_ticks_per_second())) { }
+
+	// the frame is only unchanged if every band says so
+	u32 flags = ~u32(0);
+	for (band_update const &band : m_bands)
+		flags &= band.flags;
+	return flags;
+}
+
+
+//-------------------------------------------------
+//  band_update_callback - draw one band of a
+//  banded update on a worker thread
+//-------------------------------------------------
+
+void *screen_device::band_update_callback(void *param, int threadid)
+{
+	band_update &band = *reinterpret_cast<band_update *>(param);
+	screen_device &screen = *band.screen;
+	screen_bitmap &curbitmap = screen.m_bitmap[screen.m_curbitmap];
+	switch (curbitmap.format())
+	{
+		default:
+		case BITMAP_FORMAT_IND16:   band.flags = screen.m_screen_update_ind16(screen, curbitmap.as_ind16(), band.clip);   break;
+		case BITMAP_FORMAT_RGB32:   band.flags = screen.m_screen_update_rgb32(screen, curbitmap.as_rgb32(), band.clip);   break;
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  update_now - perform an update from the last
 //  beam position up to the current beam position
@@ -60,6 +60,11 @@ constexpr u32 UPDATE_HAS_NOT_CHANGED = 0x0001;   // the video has not changed
  @def VIDEO_VARIABLE_WIDTH
  causes the screen to construct its final bitmap from a composite upscale of individual scanline bitmaps
 
+ @def VIDEO_PARALLEL_BANDS
+ splits large partial updates into horizontal bands drawn concurrently on worker threads; only for
+ screen update callbacks that touch nothing outside the cliprect they're given and don't mark tiles
+ dirty (tilemaps are brought up to date once before the bands start); ignored while profiling
+
  @}
  */
 
@@ -70,6 +75,7 @@ constexpr u32 VIDEO_SELF_RENDER             = 0x0008;
 constexpr u32 VIDEO_ALWAYS_UPDATE           = 0x0080;
 constexpr u32 VIDEO_UPDATE_SCANLINE         = 0x0100;
 constexpr u32 VIDEO_VARIABLE_WIDTH          = 0x0200;
+constexpr u32 VIDEO_PARALLEL_BANDS          = 0x0400;
 
 
 //**************************************************************************
@@ -447,6 +453,8 @@ private:
 	void create_composited_bitmap();
 	void destroy_scan_bitmaps();
 	void allocate_scan_bitmaps();
+	u32 update_bands(const rectangle &clip);
+	static void *band_update_callback(void *param, int threadid);
 
 	// inline configuration data
 	screen_type_enum    m_type;                     // type of screen
@@ -506,6 +514,17 @@ private:
 	u64                 m_frame_number;             // the current frame number
 	u32                 m_partial_updates_this_frame;// partial update counter this frame
 
+	// banded updates
+	struct band_update
+	{
+		screen_device *     screen;                     // screen being updated
+		rectangle           clip;                       // rows this band covers
+		u32                 flags;                      // result of the update callback
+	};
+	osd_work_queue *    m_band_queue;               // worker queue for VIDEO_PARALLEL_BANDS
+	std::vector<band_update> m_bands;               // band descriptors for the current update
+	int                 m_band_count;               // maximum number of bands to split into
+
 	bool                m_is_primary_screen;
 
 	// VBLANK callbacks
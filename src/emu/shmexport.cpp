@@ -0,0 +1,344 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    shmexport.cpp
+
+    Publishing frames and sound to other processes through shared memory.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "shmexport.h"
+
+#include "screen.h"
+
+#include "corestr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+namespace {
+
+constexpr u32 MAGIC = 0x534d414d; // 'MAMS'
+constexpr u32 VERSION = 2;
+constexpr u32 CHANNELS = 2;
+constexpr u32 SOUND_SLOTS_PER_SECOND = 10;
+constexpr u32 FLAG_STEPPING = 0x00000001;
+constexpr unsigned STEP_SPINS = 1000; // yield this many times before sleeping between checks
+constexpr int STEP_TIMEOUT = 10; // seconds to wait for a step before giving up on the controller
+
+// readers in other processes must see the same atomics we do
+static_assert(std::atomic<u32>::is_always_lock_free, "shared memory export needs lock-free 32-bit atomics");
+static_assert(std::atomic<u64>::is_always_lock_free, "shared memory export needs lock-free 64-bit atomics");
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  SHARED LAYOUT
+//**************************************************************************
+
+struct shared_memory_export::header
+{
+	u32                 magic;
+	u32                 version;
+	u32                 frame_slots;
+	u32                 frame_size;
+	u32                 sound_slots;
+	u32                 sound_size;
+	u32                 sample_rate;
+	u32                 channels;
+	std::atomic<u64>    frames;
+	std::atomic<u64>    sounds;
+	std::atomic<u64>    steps;
+	u32                 memory_size;
+	std::atomic<u32>    flags;
+};
+
+struct shared_memory_export::frame_slot
+{
+	std::atomic<u32>    sequence;
+	u32                 width;
+	u32                 height;
+	u32                 reserved;
+	u64                 frame;
+	u64                 time;
+};
+
+struct shared_memory_export::sound_slot
+{
+	std::atomic<u32>    sequence;
+	u32                 samples;
+	u64                 position;
+	u64                 reserved[2];
+};
+
+
+namespace {
+
+//-------------------------------------------------
+//  begin_write/end_write - bracket updates to a
+//  slot so readers can tell they raced a write
+//-------------------------------------------------
+
+inline void begin_write(std::atomic<u32> &sequence)
+{
+	sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+inline void end_write(std::atomic<u32> &sequence)
+{
+	sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  SHARED MEMORY EXPORT
+//**************************************************************************
+
+//-------------------------------------------------
+//  create - create the shared memory and lay it
+//  out for the first screen
+//-------------------------------------------------
+
+shared_memory_export::ptr shared_memory_export::create(running_machine &machine, std::string const &name, unsigned slots, std::string_view memory, bool step)
+{
+	static_assert(sizeof(header) == 64);
+	static_assert(sizeof(frame_slot) == 32);
+	static_assert(sizeof(sound_slot) == 32);
+
+	// memory to publish is given as <device>,<start>,<length>
+	std::string tag;
+	offs_t start(0);
+	u32 length(0);
+	if (!memory.empty())
+	{
+		std::string_view::size_type const first(memory.find(','));
+		std::string_view::size_type const second((std::string_view::npos != first) ? memory.find(',', first + 1) : std::string_view::npos);
+		if (std::string_view::npos != second)
+		{
+			tag = strtrimspace(memory.substr(0, first));
+			std::string const startstr(strtrimspace(memory.substr(first + 1, second - first - 1)));
+			std::string const lengthstr(strtrimspace(memory.substr(second + 1)));
+			char *startend, *lengthend;
+			start = offs_t(std::strtoul(startstr.c_str(), &startend, 16));
+			length = u32(std::strtoul(lengthstr.c_str(), &lengthend, 16));
+			if (*startend || *lengthend || startstr.empty() || lengthstr.empty())
+				tag.clear();
+		}
+		if (tag.empty() || !length)
+		{
+			osd_printf_error("Invalid memory %s for shared memory export; expected <device>,<start>,<length>\n", memory);
+			return nullptr;
+		}
+	}
+
+	// frame slots are sized for the screen's whole bitmap, which the visible area fits in
+	screen_device *const screen(screen_device_enumerator(machine.root_device()).first());
+	u32 const frame_size((screen ? (u32(screen->width()) * u32(screen->height()) * 4) : 0) + length);
+	u32 const sound_size((machine.sample_rate() + SOUND_SLOTS_PER_SECOND - 1) / SOUND_SLOTS_PER_SECOND * CHANNELS * sizeof(s16));
+	std::size_t const size(sizeof(header) + ((sizeof(frame_slot) + frame_size) * slots) + ((sizeof(sound_slot) + sound_size) * slots));
+
+	osd_shared_memory::ptr shared;
+	std::error_condition const err(osd_shared_memory::create(name, size, shared));
+	if (err)
+	{
+		osd_printf_error("Error creating shared memory %s for export (%s:%d %s)\n", name, err.category().name(), err.value(), err.message());
+		return nullptr;
+	}
+
+	osd_printf_verbose("Exporting frames and sound to shared memory %s (%u bytes)\n", name, size);
+	return ptr(new shared_memory_export(machine, screen, std::move(shared), slots, frame_size, sound_size, std::move(tag), start, length, step));
+}
+
+
+//-------------------------------------------------
+//  shared_memory_export - constructor
+//-------------------------------------------------
+
+shared_memory_export::shared_memory_export(running_machine &machine, screen_device *screen, osd_shared_memory::ptr &&memory, unsigned slots, u32 frame_size, u32 sound_size, std::string &&tag, offs_t start, u32 length, bool step)
+	: m_machine(machine)
+	, m_screen(screen)
+	, m_memory(std::move(memory))
+	, m_slots(slots)
+	, m_frame_size(frame_size)
+	, m_sound_size(sound_size)
+	, m_frames(0)
+	, m_sounds(0)
+	, m_sample_position(0)
+	, m_memory_tag(std::move(tag))
+	, m_memory_space(nullptr)
+	, m_memory_start(start)
+	, m_memory_length(length)
+	, m_step(step)
+	, m_warned(false)
+{
+	// the memory starts zeroed, so only the header needs filling in
+	header &head(get_header());
+	head.frame_slots = slots;
+	head.frame_size = frame_size;
+	head.sound_slots = slots;
+	head.sound_size = sound_size;
+	head.sample_rate = machine.sample_rate();
+	head.channels = CHANNELS;
+	head.memory_size = length;
+	head.flags = step ? FLAG_STEPPING : 0;
+	head.version = VERSION;
+	std::atomic_thread_fence(std::memory_order_release);
+	head.magic = MAGIC;
+}
+
+
+//-------------------------------------------------
+//  ~shared_memory_export - destructor
+//-------------------------------------------------
+
+shared_memory_export::~shared_memory_export()
+{
+}
+
+
+//-------------------------------------------------
+//  get_frame_slot/get_sound_slot - find a slot
+//  in the rings
+//-------------------------------------------------
+
+shared_memory_export::frame_slot &shared_memory_export::get_frame_slot(u64 index)
+{
+	u8 *const base(reinterpret_cast<u8 *>(m_memory->data()) + sizeof(header));
+	return *reinterpret_cast<frame_slot *>(base + ((sizeof(frame_slot) + m_frame_size) * (index % m_slots)));
+}
+
+shared_memory_export::sound_slot &shared_memory_export::get_sound_slot(u64 index)
+{
+	u8 *const base(reinterpret_cast<u8 *>(m_memory->data()) + sizeof(header) + ((sizeof(frame_slot) + m_frame_size) * m_slots));
+	return *reinterpret_cast<sound_slot *>(base + ((sizeof(sound_slot) + m_sound_size) * (index % m_slots)));
+}
+
+
+//-------------------------------------------------
+//  add_frame - publish the visible area of the
+//  screen and any memory, then wait for the next
+//  step if stepping
+//-------------------------------------------------
+
+void shared_memory_export::add_frame(attotime const &curtime)
+{
+	// find the memory the first time through, as address spaces don't exist when we're created
+	if (m_memory_length && !m_memory_space)
+	{
+		device_t *const device(m_machine.root_device().subdevice(m_memory_tag));
+		device_memory_interface *memory;
+		if (!device || !device->interface(memory) || !memory->has_space(AS_PROGRAM))
+			throw emu_fatalerror("Device %s has no program memory to export", m_memory_tag);
+		m_memory_space = &memory->space(AS_PROGRAM);
+	}
+
+	u32 width(0), height(0);
+	if (m_screen)
+	{
+		rectangle const &visarea(m_screen->visible_area());
+		width = visarea.width();
+		height = visarea.height();
+	}
+	if ((width * height * 4) > (m_frame_size - m_memory_length))
+	{
+		if (!m_warned)
+			osd_printf_warning("Screen %s has grown beyond its configured size; not exporting frames that don't fit\n", m_screen->tag());
+		m_warned = true;
+		return;
+	}
+
+	// the screen converts straight into the shared slot, so readers needn't make another copy
+	frame_slot &slot(get_frame_slot(m_frames));
+	u8 *const data(reinterpret_cast<u8 *>(&slot + 1));
+	begin_write(slot.sequence);
+	slot.width = width;
+	slot.height = height;
+	slot.frame = m_screen ? m_screen->frame_number() : m_frames;
+	slot.time = u64(curtime.seconds()) * 1'000'000'000 + u64(curtime.attoseconds() / ATTOSECONDS_PER_NANOSECOND);
+	if (m_screen)
+		m_screen->pixels(reinterpret_cast<u32 *>(data));
+	if (m_memory_space)
+	{
+		auto dis = m_machine.disable_side_effects();
+		u8 *dest(data + m_frame_size - m_memory_length);
+		for (u32 i = 0; m_memory_length > i; ++i)
+			*dest++ = m_memory_space->read_byte(m_memory_start + i);
+	}
+	end_write(slot.sequence);
+
+	header &head(get_header());
+	head.frames.store(++m_frames, std::memory_order_release);
+
+	// hold emulation until the controller asks for another frame
+	if (m_step)
+	{
+		auto const deadline(std::chrono::steady_clock::now() + std::chrono::seconds(STEP_TIMEOUT));
+		for (unsigned spins = 0; head.steps.load(std::memory_order_acquire) < m_frames; ++spins)
+		{
+			// don't hold up an exit or reset
+			if (m_machine.scheduled_event_pending())
+				break;
+
+			if (STEP_SPINS > spins)
+			{
+				std::this_thread::yield();
+			}
+			else if (std::chrono::steady_clock::now() < deadline)
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			}
+			else
+			{
+				// the controller has gone away, so run freely from now on
+				osd_printf_warning("No step requested for shared memory export in %d seconds; leaving lockstep\n", STEP_TIMEOUT);
+				head.flags.fetch_and(~FLAG_STEPPING, std::memory_order_release);
+				m_step = false;
+				break;
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  add_sound - publish mixed stereo samples,
+//  split across as many slots as needed
+//-------------------------------------------------
+
+void shared_memory_export::add_sound(s16 const *sound, int numsamples)
+{
+	u32 const capacity(m_sound_size / (CHANNELS * sizeof(s16)));
+	while (0 < numsamples)
+	{
+		u32 const count(std::min<u32>(numsamples, capacity));
+
+		sound_slot &slot(get_sound_slot(m_sounds));
+		begin_write(slot.sequence);
+		slot.samples = count;
+		slot.position = m_sample_position;
+		std::memcpy(reinterpret_cast<u8 *>(&slot + 1), sound, count * CHANNELS * sizeof(s16));
+		end_write(slot.sequence);
+
+		get_header().sounds.store(++m_sounds, std::memory_order_release);
+		m_sample_position += count;
+		sound += count * CHANNELS;
+		numsamples -= count;
+	}
+}
@@ -0,0 +1,111 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    shmexport.h
+
+    Publishing frames and sound to other processes through shared memory.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef MAME_EMU_SHMEXPORT_H
+#define MAME_EMU_SHMEXPORT_H
+
+#include "osdfile.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> shared_memory_export
+
+// The shared memory starts with a 64-byte header, followed by the frame
+// slots and then the sound slots.  All values are in host byte order.
+//
+// header:
+//   0  u32  magic ('MAMS')         4  u32  version (2)
+//   8  u32  frame slots           12  u32  frame slot size
+//  16  u32  sound slots           20  u32  sound slot size
+//  24  u32  sample rate           28  u32  channels (2)
+//  32  u64  frames published      40  u64  sound buffers published
+//  48  u64  steps allowed         56  u32  memory bytes per frame
+//  60  u32  flags (bit 0 = stepping)
+//
+// frame slot (32-byte header, xRGB pixels with width * 4 bytes per row,
+// then memory bytes from -shmexportmem at the end of the slot):
+//   0  u32  sequence               4  u32  width
+//   8  u32  height                12  u32  reserved
+//  16  u64  frame number          24  u64  emulated time in nanoseconds
+//
+// sound slot (32-byte header followed by interleaved s16 samples):
+//   0  u32  sequence               4  u32  sample frames
+//   8  u64  first sample frame    16  u64  reserved
+//  24  u64  reserved
+//
+// The newest frame is in slot (frames published - 1) % frame slots, and
+// likewise for sound.  Slot sequences are odd while the slot is being
+// written: readers copy a slot and then check that its sequence was even
+// and unchanged, retrying (or skipping to a newer slot) otherwise.  Slot
+// sizes give the room for data after each slot header, with memory bytes
+// at the end of the frame slot's room.
+//
+// When stepping, emulation waits after publishing each frame until steps
+// allowed is at least frames published, so a controller steps any number
+// of instances in lockstep by writing frames published to steps allowed
+// in each one and waiting for their next frames.  Writing all ones to
+// steps allowed lets emulation run freely.  If no step comes for ten
+// seconds, emulation stops waiting for good and clears the stepping flag.
+class shared_memory_export
+{
+public:
+	typedef std::unique_ptr<shared_memory_export> ptr;
+
+	~shared_memory_export();
+
+	// create an export for the first screen; returns null after printing an error on failure
+	static ptr create(running_machine &machine, std::string const &name, unsigned slots, std::string_view memory, bool step);
+
+	// publishing
+	void add_frame(attotime const &curtime);
+	void add_sound(s16 const *sound, int numsamples);
+
+private:
+	struct header;
+	struct frame_slot;
+	struct sound_slot;
+
+	shared_memory_export(running_machine &machine, screen_device *screen, osd_shared_memory::ptr &&memory, unsigned slots, u32 frame_size, u32 sound_size, std::string &&tag, offs_t start, u32 length, bool step);
+
+	header &get_header() { return *reinterpret_cast<header *>(m_memory->data()); }
+	frame_slot &get_frame_slot(u64 index);
+	sound_slot &get_sound_slot(u64 index);
+
+	running_machine &       m_machine;
+	screen_device *const    m_screen;           // screen to publish, or null
+	osd_shared_memory::ptr  m_memory;           // the shared memory
+	unsigned const          m_slots;            // number of slots in each ring
+	u32 const               m_frame_size;       // pixel bytes per frame slot
+	u32 const               m_sound_size;       // sample bytes per sound slot
+	u64                     m_frames;           // number of frames published
+	u64                     m_sounds;           // number of sound buffers published
+	u64                     m_sample_position;  // sample frames published so far
+	std::string const       m_memory_tag;       // device whose program space is published
+	address_space *         m_memory_space;     // resolved once the devices have started
+	offs_t const            m_memory_start;     // first address published
+	u32 const               m_memory_length;    // number of bytes published with each frame
+	bool                    m_step;             // wait for the next step after each frame
+	bool                    m_warned;           // warned about frames that don't fit
+};
+
+#endif // MAME_EMU_SHMEXPORT_H
@@ -11,13 +11,18 @@
 #include "emu.h"
 #include "softlist.h"
 
+#include "main.h"
+
 #include "hash.h"
+#include "multibyte.h"
 
 #include "expat.h"
 
 #include <array>
 #include <cstring>
+#include <iterator>
 #include <regex>
+#include <unordered_map>
 
 
 
@@ -919,6 +924,315 @@ void parse_software_list(
 }
 
 
+
+//**************************************************************************
+//  COMPILED SOFTWARE LIST INDEX
+//**************************************************************************
+
+//  The index holds a pool of unique strings followed by the software
+//  records, which refer to strings by their position in the pool.  Feature
+//  names, interfaces and publishers repeat a lot, so the pool keeps the file
+//  small, and loading it needs no XML parsing or validation.
+
+namespace detail {
+
+class softlist_index
+{
+public:
+	static void write(
+			std::vector<u8> &records,
+			std::vector<std::string_view> &strings,
+			std::string_view listname,
+			std::string_view description,
+			std::string_view errors,
+			const std::list<software_info> &infolist);
+	static bool read(
+			u8 const *ptr,
+			u8 const *end,
+			std::vector<std::string_view> const &strings,
+			std::string &listname,
+			std::string &description,
+			std::string &errors,
+			std::list<software_info> &infolist);
+
+	static constexpr u8 MAGIC[8] = { 'M', 'S', 'W', 'L', 'I', 'D', 'X', 1 };
+};
+
+
+//-------------------------------------------------
+//  write - add the records for a software list,
+//  pooling the strings they refer to
+//-------------------------------------------------
+
+void softlist_index::write(
+		std::vector<u8> &records,
+		std::vector<std::string_view> &strings,
+		std::string_view listname,
+		std::string_view description,
+		std::string_view errors,
+		const std::list<software_info> &infolist)
+{
+	std::unordered_map<std::string_view, u32> pool;
+	auto const write_u32 =
+			[&records] (u32 value)
+			{
+				records.resize(records.size() + 4);
+				put_u32le(&records[records.size() - 4], value);
+			};
+	auto const write_string =
+			[&pool, &strings, &write_u32] (std::string_view value)
+			{
+				auto const found(pool.emplace(value, u32(strings.size())));
+				if (found.second)
+					strings.emplace_back(value);
+				write_u32(found.first->second);
+			};
+	auto const write_items =
+			[&write_u32, &write_string] (auto const &items)
+			{
+				write_u32(items.size());
+				for (software_info_item const &item : items)
+				{
+					write_string(item.name());
+					write_string(item.value());
+				}
+			};
+
+	write_string(listname);
+	write_string(description);
+	write_string(errors);
+	write_u32(infolist.size());
+	for (software_info const &info : infolist)
+	{
+		write_string(info.m_shortname);
+		write_string(info.m_longname);
+		write_string(info.m_parentname);
+		write_string(info.m_year);
+		write_string(info.m_publisher);
+		write_u32(u32(info.m_supported));
+		write_items(info.m_info);
+		write_items(info.m_shared_features);
+		write_u32(info.m_partdata.size());
+		for (software_part const &part : info.m_partdata)
+		{
+			write_string(part.m_name);
+			write_string(part.m_interface);
+			write_items(part.m_features);
+			write_u32(part.m_romdata.size());
+			for (rom_entry const &rom : part.m_romdata)
+			{
+				write_string(rom.name());
+				write_string(rom.hashdata());
+				write_u32(rom.get_offset());
+				write_u32(rom.get_length());
+				write_u32(rom.get_flags());
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  read - rebuild a software list from its
+//  records
+//-------------------------------------------------
+
+bool softlist_index::read(
+		u8 const *ptr,
+		u8 const *end,
+		std::vector<std::string_view> const &strings,
+		std::string &listname,
+		std::string &description,
+		std::string &errors,
+		std::list<software_info> &infolist)
+{
+	bool valid = true;
+	auto const read_u32 =
+			[&ptr, end, &valid] () -> u32
+			{
+				if (!valid || ((end - ptr) < 4))
+				{
+					valid = false;
+					return 0;
+				}
+				ptr += 4;
+				return get_u32le(ptr - 4);
+			};
+	auto const read_string =
+			[&strings, &valid, &read_u32] () -> std::string
+			{
+				u32 const index = read_u32();
+				if (!valid || (strings.size() <= index))
+				{
+					valid = false;
+					return std::string();
+				}
+				return std::string(strings[index]);
+			};
+	auto const read_items =
+			[&valid, &read_u32, &read_string] (auto &items)
+			{
+				for (u32 count = read_u32(); valid && count; --count)
+				{
+					std::string name = read_string();
+					std::string value = read_string();
+					items.insert(items.end(), software_info_item(std::move(name), std::move(value)));
+				}
+			};
+
+	listname = read_string();
+	description = read_string();
+	errors = read_string();
+	for (u32 count = read_u32(); valid && count; --count)
+	{
+		std::string name = read_string();
+		std::string longname = read_string();
+		std::string parent = read_string();
+		software_info &info(infolist.emplace_back(std::move(name), std::move(parent), std::string_view()));
+		info.m_longname = std::move(longname);
+		info.m_year = read_string();
+		info.m_publisher = read_string();
+		info.m_supported = software_support(read_u32());
+		read_items(info.m_info);
+		read_items(info.m_shared_features);
+		for (u32 parts = read_u32(); valid && parts; --parts)
+		{
+			std::string partname = read_string();
+			std::string interface = read_string();
+			software_part &part(info.m_partdata.emplace_back(info, std::move(partname), std::move(interface)));
+			read_items(part.m_features);
+			for (u32 roms = read_u32(); valid && roms; --roms)
+			{
+				std::string romname = read_string();
+				std::string hashdata = read_string();
+				u32 const offset = read_u32();
+				u32 const length = read_u32();
+				u32 const flags = read_u32();
+				part.m_romdata.emplace_back(std::move(romname), std::move(hashdata), offset, length, flags);
+			}
+		}
+	}
+
+	return valid && (end == ptr);
+}
+
+} // namespace detail
+
+
+bool save_software_list_index(
+		std::string_view indexname,
+		std::string_view source,
+		u64 size,
+		s64 mtime,
+		std::string_view listname,
+		std::string_view description,
+		std::string_view errors,
+		const std::list<software_info> &infolist)
+{
+	std::vector<u8> records;
+	std::vector<std::string_view> strings;
+	detail::softlist_index::write(records, strings, listname, description, errors, infolist);
+
+	// the header identifies the build and the source the list was parsed from
+	std::vector<u8> header(std::begin(detail::softlist_index::MAGIC), std::end(detail::softlist_index::MAGIC));
+	auto const write_u32 =
+			[&header] (u32 value)
+			{
+				header.resize(header.size() + 4);
+				put_u32le(&header[header.size() - 4], value);
+			};
+	auto const write_string =
+			[&header, &write_u32] (std::string_view value)
+			{
+				write_u32(value.length());
+				header.insert(header.end(), value.begin(), value.end());
+			};
+	write_string(emulator_info::get_build_version());
+	write_string(source);
+	header.resize(header.size() + 16);
+	put_u64le(&header[header.size() - 16], size);
+	put_u64le(&header[header.size() - 8], u64(mtime));
+	write_u32(strings.size());
+	for (std::string_view const &string : strings)
+		write_string(string);
+
+	util::core_file::ptr file;
+	if (util::core_file::open(indexname, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file))
+		return false;
+	auto const [headerr, headeractual] = util::write(*file, header.data(), header.size());
+	if (headerr)
+		return false;
+	auto const [recorderr, recordactual] = util::write(*file, records.data(), records.size());
+	return !recorderr;
+}
+
+
+bool load_software_list_index(
+		std::string_view indexname,
+		std::string_view source,
+		u64 size,
+		s64 mtime,
+		std::string &listname,
+		std::string &description,
+		std::string &errors,
+		std::list<software_info> &infolist)
+{
+	std::vector<u8> data;
+	if (util::core_file::load(indexname, data))
+		return false;
+
+	u8 const *ptr = data.data();
+	u8 const *const end = ptr + data.size();
+	bool valid = true;
+	auto const read_u32 =
+			[&ptr, end, &valid] () -> u32
+			{
+				if (!valid || ((end - ptr) < 4))
+				{
+					valid = false;
+					return 0;
+				}
+				ptr += 4;
+				return get_u32le(ptr - 4);
+			};
+	auto const read_string =
+			[&ptr, end, &valid, &read_u32] () -> std::string_view
+			{
+				u32 const length = read_u32();
+				if (!valid || (u32(end - ptr) < length))
+				{
+					valid = false;
+					return std::string_view();
+				}
+				ptr += length;
+				return std::string_view(reinterpret_cast<char const *>(ptr - length), length);
+			};
+
+	// anything from a different build or an older copy of the source is ignored
+	if ((std::size_t(end - ptr) < sizeof(detail::softlist_index::MAGIC)) || !std::equal(std::begin(detail::softlist_index::MAGIC), std::end(detail::softlist_index::MAGIC), ptr))
+		return false;
+	ptr += sizeof(detail::softlist_index::MAGIC);
+	if ((read_string() != emulator_info::get_build_version()) || (read_string() != source) || !valid || ((end - ptr) < 16))
+		return false;
+	if ((get_u64le(ptr) != size) || (s64(get_u64le(ptr + 8)) != mtime))
+		return false;
+	ptr += 16;
+
+	std::vector<std::string_view> strings(read_u32());
+	for (std::string_view &string : strings)
+		string = read_string();
+	if (!valid)
+		return false;
+
+	// don't leave a partial list behind if the records are damaged
+	std::list<software_info> loaded;
+	if (!detail::softlist_index::read(ptr, end, strings, listname, description, errors, loaded))
+		return false;
+	infolist = std::move(loaded);
+	return true;
+}
+
+
 //-------------------------------------------------
 //  software_name_parse - helper that splits a
 //  software identifier (software_list:software:part)
@@ -28,7 +28,7 @@
 //  FORWARD DECLARATIONS
 //**************************************************************************
 
-namespace detail { class softlist_parser; }
+namespace detail { class softlist_parser; class softlist_index; }
 
 
 //**************************************************************************
@@ -84,6 +84,7 @@ private:
 class software_part
 {
 	friend class detail::softlist_parser;
+	friend class detail::softlist_index;
 
 public:
 	// construction/destruction
@@ -118,6 +119,7 @@ private:
 class software_info
 {
 	friend class detail::softlist_parser;
+	friend class detail::softlist_index;
 
 public:
 	// construction/destruction
@@ -168,6 +170,28 @@ void parse_software_list(
 		std::list<software_info> &infolist,
 		std::ostream &errors);
 
+// saves a parsed software list in compiled form, tagged with the size and modification time of its source
+bool save_software_list_index(
+		std::string_view indexname,
+		std::string_view source,
+		u64 size,
+		s64 mtime,
+		std::string_view listname,
+		std::string_view description,
+		std::string_view errors,
+		const std::list<software_info> &infolist);
+
+// loads a compiled software list, failing if it doesn't match the source size and modification time
+bool load_software_list_index(
+		std::string_view indexname,
+		std::string_view source,
+		u64 size,
+		s64 mtime,
+		std::string &listname,
+		std::string &description,
+		std::string &errors,
+		std::list<software_info> &infolist);
+
 // parses a software identifier (e.g. - 'apple2e:agentusa:flop1') into its constituent parts (returns false if cannot parse)
 bool software_name_parse(std::string_view identifier, std::string *list_name = nullptr, std::string *software_name = nullptr, std::string *part_name = nullptr);
 
@@ -18,6 +18,7 @@
 #include "validity.h"
 
 #include "corestr.h"
+#include "path.h"
 #include "unicode.h"
 
 #include <cctype>
@@ -288,16 +289,37 @@ void software_list_device::parse()
 	m_errors.clear();
 
 	// attempt to open the file
-	emu_file file(mconfig().options().hash_path(), OPEN_FLAG_READ);
+	emu_options const &options(mconfig().options());
+	emu_file file(options.hash_path(), OPEN_FLAG_READ);
 	const std::error_condition filerr = file.open(m_list_name + ".xml");
 	m_filename = file.filename();
 	if (!filerr)
 	{
-		// parse if no error
-		std::ostringstream errs;
-		parse_software_list(file, m_filename, m_shortname, m_description, m_infolist, errs);
-		file.close();
-		m_errors = errs.str();
+		// a compiled index in the cfg directory saves parsing an unchanged list again
+		std::string const fullpath(file.fullpath());
+		std::string indexname;
+		std::unique_ptr<osd::directory::entry> source;
+		if (options.softlist_index() && !file.is_archived() && path_iterator(options.cfg_directory()).next(indexname))
+		{
+			source = osd_stat(fullpath);
+			util::path_append(indexname, "softlist", m_list_name + ".bin");
+		}
+		s64 const mtime = source ? source->last_modified.time_since_epoch().count() : 0;
+		if (source && load_software_list_index(indexname, fullpath, source->size, mtime, m_shortname, m_description, m_errors, m_infolist))
+		{
+			osd_printf_verbose("%s: Loaded software list %s from index\n", tag(), m_filename);
+			file.close();
+		}
+		else
+		{
+			// parse if no error
+			std::ostringstream errs;
+			parse_software_list(file, m_filename, m_shortname, m_description, m_infolist, errs);
+			file.close();
+			m_errors = errs.str();
+			if (source)
+				save_software_list_index(indexname, fullpath, source->size, mtime, m_shortname, m_description, m_errors, m_infolist);
+		}
 	}
 	else if (std::errc::no_such_file_or_directory == filerr)
 	{
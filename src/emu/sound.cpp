@@ -556,6 +556,7 @@ sound_stream::sound_stream(device_t &device, u32 inputs, u32 outputs, u32 output
 	m_output_adaptive(sample_rate == SAMPLE_RATE_OUTPUT_ADAPTIVE),
 	m_synchronous((flags & STREAM_SYNCHRONOUS) != 0),
 	m_resampling_disabled((flags & STREAM_DISABLE_INPUT_RESAMPLING) != 0),
+	m_parallel_safe((flags & STREAM_PARALLEL_SAFE) != 0),
 	m_sync_timer(nullptr),
 	m_last_update_end_time(attotime::zero),
 	m_input(inputs),
@@ -1000,11 +1001,18 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 	stream_buffer::sample_t srcpos = stream_buffer::sample_t(double(delta.attoseconds()) / double(rebased.sample_period_attoseconds()));
 	sound_assert(srcpos <= 1.0f);
 
+	// pull the input into a linear array up front rather than wrapping and
+	// applying gain on every fetch
+	if (m_input.size() < rebased.samples())
+		m_input.resize(rebased.samples());
+	rebased.get_block(0, rebased.samples(), m_input.data());
+	stream_buffer::sample_t const *src = m_input.data();
+
 	// input is undersampled: point sample except where our sample period covers a boundary
 	s32 srcindex = 0;
 	if (step < 1.0)
 	{
-		stream_buffer::sample_t cursample = rebased.get(srcindex++);
+		stream_buffer::sample_t cursample = src[srcindex++];
 		for ( ; dstindex < numsamples; dstindex++)
 		{
 			// if still within the current sample, just replicate
@@ -1018,7 +1026,7 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 				srcpos -= 1.0;
 				sound_assert(srcpos <= step + 1e-5);
 				stream_buffer::sample_t prevsample = cursample;
-				cursample = rebased.get(srcindex++);
+				cursample = src[srcindex++];
 				output.put(dstindex, stepinv * (prevsample * (step - srcpos) + srcpos * cursample));
 			}
 		}
@@ -1028,7 +1036,7 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 	// input is oversampled: sum the energy
 	else
 	{
-		float cursample = rebased.get(srcindex++);
+		float cursample = src[srcindex++];
 		for ( ; dstindex < numsamples; dstindex++)
 		{
 			// compute the partial first sample and advance
@@ -1039,12 +1047,12 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 			stream_buffer::sample_t remaining = step - scale;
 			while (remaining >= 1.0)
 			{
-				sample += rebased.get(srcindex++);
+				sample += src[srcindex++];
 				remaining -= 1.0;
 			}
 
 			// add in the final partial sample
-			cursample = rebased.get(srcindex++);
+			cursample = src[srcindex++];
 			sample += cursample * remaining;
 			output.put(dstindex, sample * stepinv);
 
@@ -1068,6 +1076,7 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 sound_manager::sound_manager(running_machine &machine) :
 	m_machine(machine),
 	m_update_timer(nullptr),
+	m_speculative(false),
 	m_update_number(0),
 	m_last_update(attotime::zero),
 	m_finalmix_leftover(0),
@@ -1078,12 +1087,15 @@ sound_manager::sound_manager(running_machine &machine) :
 	m_compressor_scale(1.0),
 	m_compressor_counter(0),
 	m_compressor_enabled(machine.options().compressor()),
+	m_rate_control(machine.options().audio_rate_control()),
+	m_rate_integral(0.0),
 	m_muted(0),
 	m_nosound_mode(machine.osd().no_sound()),
 	m_attenuation(0),
 	m_unique_id(0),
 	m_wavfile(),
-	m_first_reset(true)
+	m_first_reset(true),
+	m_parallel_queue(nullptr)
 {
 	// count the mixers
 #if VERBOSE
@@ -1119,6 +1131,8 @@ sound_manager::sound_manager(running_machine &machine) :
 
 sound_manager::~sound_manager()
 {
+	if (m_parallel_queue != nullptr)
+		osd_work_queue_free(m_parallel_queue);
 }
 
 
@@ -1258,6 +1272,82 @@ void sound_manager::recursive_remove_stream_from_orphan_list(sound_stream *which
 }
 
 
+//-------------------------------------------------
+//  build_parallel_groups - collect the source
+//  streams that opted in to parallel updates,
+//  one group per device
+//-------------------------------------------------
+
+void sound_manager::build_parallel_groups()
+{
+	for (auto &stream : m_stream_list)
+	{
+		// only sources feeding a speaker qualify; they don't pull anything while updating,
+		// while anything with inputs is left for the mixers to pull in order
+		sound_stream &source = *stream;
+		if (!source.parallel_safe() || source.synchronous() || m_orphan_stream_list.count(&source))
+			continue;
+
+		bool has_input = false;
+		for (int inputnum = 0; inputnum < source.input_count(); inputnum++)
+			has_input = has_input || source.input(inputnum).valid();
+		if (has_input)
+			continue;
+
+		// streams on the same device share its state, so they stay on one thread
+		auto group = std::find_if(m_parallel_groups.begin(), m_parallel_groups.end(),
+				[&source] (parallel_group const &g) { return &g.streams.front()->device() == &source.device(); });
+		if (group == m_parallel_groups.end())
+			m_parallel_groups.emplace_back().streams.push_back(&source);
+		else
+			group->streams.push_back(&source);
+	}
+
+	// there's no point going through the work queue for a single group
+	if (m_parallel_groups.size() < 2)
+	{
+		m_parallel_groups.clear();
+		return;
+	}
+
+	m_parallel_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (m_parallel_queue == nullptr)
+		m_parallel_groups.clear();
+	else
+		osd_printf_verbose("Updating %d sound devices in parallel\n", int(m_parallel_groups.size()));
+}
+
+
+//-------------------------------------------------
+//  update_parallel_groups - bring all parallel
+//  source streams up to the current time
+//-------------------------------------------------
+
+void sound_manager::update_parallel_groups()
+{
+	// the profiler keeps a single stack, so it can't be used from workers
+	if (m_parallel_groups.empty() || g_profiler.enabled())
+		return;
+
+	osd_work_item_queue_multiple(m_parallel_queue, parallel_group_update, m_parallel_groups.size(), &m_parallel_groups[0], sizeof(m_parallel_groups[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(m_parallel_queue, osd_ticks_per_second())) { }
+}
+
+
+//-------------------------------------------------
+//  parallel_group_update - work item callback to
+//  update one device's source streams
+//-------------------------------------------------
+
+void *sound_manager::parallel_group_update(void *param, int threadid)
+{
+	parallel_group &group = *reinterpret_cast<parallel_group *>(param);
+	for (sound_stream *stream : group.streams)
+		stream->update();
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  apply_sample_rate_changes - recursively
 //  update sample rates throughout the system
@@ -1314,6 +1404,10 @@ void sound_manager::reset()
 			m_speakers.emplace_back(speaker);
 		}
 
+		// find the source streams that can be updated in parallel
+		if (machine().options().parallel_sound())
+			build_parallel_groups();
+
 #if (SOUND_DEBUG)
 		// dump the sound graph when we start up
 		for (speaker_device &speaker : speaker_device_enumerator(machine().root_device()))
@@ -1529,6 +1623,9 @@ void sound_manager::update(s32 param)
 	std::fill_n(&m_leftmix[0], m_samples_this_update, 0);
 	std::fill_n(&m_rightmix[0], m_samples_this_update, 0);
 
+	// generate independent sources concurrently; the mixers then pull them in as usual
+	update_parallel_groups();
+
 	// force all the speaker streams to generate the proper number of samples
 	for (speaker_device &speaker : m_speakers)
 		speaker.mix(&m_leftmix[0], &m_rightmix[0], m_last_update, endtime, m_samples_this_update, (m_muted & MUTE_REASON_SYSTEM));
@@ -1536,19 +1633,7 @@ void sound_manager::update(s32 param)
 	// determine the maximum in this section
 	stream_buffer::sample_t curmax = 0;
 	for (int sampindex = 0; sampindex < m_samples_this_update; sampindex++)
-	{
-		auto sample = m_leftmix[sampindex];
-		if (sample < 0)
-			sample = -sample;
-		if (sample > curmax)
-			curmax = sample;
-
-		sample = m_rightmix[sampindex];
-		if (sample < 0)
-			sample = -sample;
-		if (sample > curmax)
-			curmax = sample;
-	}
+		curmax = std::max(curmax, std::max(std::fabs(m_leftmix[sampindex]), std::fabs(m_rightmix[sampindex])));
 
 	// pull in current compressor scale factor before modifying
 	stream_buffer::sample_t lscale = m_compressor_scale;
@@ -1583,10 +1668,40 @@ void sound_manager::update(s32 param)
 
 	// now downmix the final result
 	u32 finalmix_step = machine().video().speed_factor();
+
+	// with rate control, nudge the step by up to 0.5% to hold the OSD buffer
+	// at its target; this lets video present at the host refresh rate while
+	// the audio output absorbs the small difference in speed
+	if (m_rate_control && !m_speculative && !m_nosound_mode)
+	{
+		float const fill = machine().osd().sound_buffer_fill();
+		if (fill >= 0.0f)
+		{
+			double const error = std::clamp(fill - 1.0, -1.0, 1.0);
+			m_rate_integral = std::clamp(m_rate_integral + error * (RATE_CONTROL_RANGE / 64.0), -RATE_CONTROL_RANGE, RATE_CONTROL_RANGE);
+			double const ratio = 1.0 + std::clamp(error * RATE_CONTROL_RANGE + m_rate_integral, -RATE_CONTROL_RANGE, RATE_CONTROL_RANGE);
+			finalmix_step = u32(std::lround(finalmix_step * ratio));
+		}
+	}
 	u32 finalmix_offset = 0;
 	s16 *finalmix = &m_finalmix[0];
-	int sample;
-	for (sample = m_finalmix_leftover; sample < m_samples_this_update * 1000; sample += finalmix_step)
+	int sample = m_finalmix_leftover;
+
+	// at normal speed with a settled compressor every sample gets the same
+	// treatment, so use a straight scale/clamp/interleave loop
+	if (finalmix_step == 1000 && (sample % 1000) == 0 && lscale == m_compressor_scale && rscale == m_compressor_scale)
+	{
+		stream_buffer::sample_t const scale = m_compressor_enabled ? m_compressor_scale : 1.0f;
+		int const first = sample / 1000;
+		for (int sampindex = first; sampindex < m_samples_this_update; sampindex++)
+		{
+			finalmix[finalmix_offset++] = s16(std::clamp(m_leftmix[sampindex] * scale, -1.0f, 1.0f) * 32767.0f);
+			finalmix[finalmix_offset++] = s16(std::clamp(m_rightmix[sampindex] * scale, -1.0f, 1.0f) * 32767.0f);
+		}
+		sample = std::max<int>(sample, m_samples_this_update * 1000);
+	}
+
+	for ( ; sample < m_samples_this_update * 1000; sample += finalmix_step)
 	{
 		int sampindex = sample / 1000;
 
@@ -1624,8 +1739,8 @@ void sound_manager::update(s32 param)
 	}
 	m_finalmix_leftover = sample - m_samples_this_update * 1000;
 
-	// play the result
-	if (finalmix_offset > 0)
+	// play the result, unless it's from a run-ahead timeline that will be discarded
+	if (finalmix_offset > 0 && !m_speculative)
 	{
 		if (!m_nosound_mode)
 			machine().osd().update_audio_stream(finalmix, finalmix_offset / 2);
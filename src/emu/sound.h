@@ -168,6 +168,19 @@ private:
 		m_buffer[index] = data;
 	}
 
+	// return a pointer to the raw data at the given index; the caller must
+	// not run past the end of the buffer
+	sample_t const *data(s32 index) const
+	{
+		sound_assert(u32(index) < size());
+		return &m_buffer[index];
+	}
+	sample_t *data(s32 index)
+	{
+		sound_assert(u32(index) < size());
+		return &m_buffer[index];
+	}
+
 	// simple helpers to step indexes
 	u32 next_index(u32 index) { index++; return (index == size()) ? 0 : index; }
 	u32 prev_index(u32 index) { return (index == 0) ? (size() - 1) : (index - 1); }
@@ -328,6 +341,26 @@ public:
 		return m_buffer->get(index);
 	}
 
+	// fetch a run of gain-scaled samples into a linear array; this splits
+	// at most once at the buffer wraparound, so the loops can be vectorised
+	void get_block(s32 start, s32 count, sample_t *dest) const
+	{
+		sound_assert(start >= 0 && u32(start + count) <= samples());
+		s32 index = m_start + start;
+		if (index >= m_buffer->size())
+			index -= m_buffer->size();
+		while (count > 0)
+		{
+			s32 chunk = std::min<s32>(count, m_buffer->size() - index);
+			sample_t const *src = m_buffer->data(index);
+			for (s32 sampindex = 0; sampindex < chunk; sampindex++)
+				dest[sampindex] = src[sampindex] * m_gain;
+			dest += chunk;
+			count -= chunk;
+			index = 0;
+		}
+	}
+
 protected:
 	// normalize start/end
 	void normalize_start_end()
@@ -397,6 +430,27 @@ public:
 		put_int(index, std::clamp(sample, -maxclamp, maxclamp), maxclamp);
 	}
 
+	// write a run of integer samples with the given maximum, taking every
+	// 'stride'th value from src; this splits at most once at the buffer
+	// wraparound, so devices can generate into a local array and let the
+	// conversion loop vectorise
+	void put_int_block(s32 start, s32 count, s32 const *src, s32 max, s32 stride = 1)
+	{
+		sound_assert(start >= 0 && u32(start + count) <= samples());
+		sample_t const scale = 1.0f / sample_t(max);
+		u32 index = index_to_buffer_index(start);
+		while (count > 0)
+		{
+			s32 chunk = std::min<s32>(count, m_buffer->size() - index);
+			sample_t *dest = m_buffer->data(index);
+			for (s32 sampindex = 0; sampindex < chunk; sampindex++)
+				dest[sampindex] = sample_t(src[sampindex * stride]) * scale;
+			src += chunk * stride;
+			count -= chunk;
+			index = 0;
+		}
+	}
+
 	// safely add a sample to the buffer
 	void add(s32 start, sample_t sample)
 	{
@@ -596,7 +650,11 @@ enum sound_stream_flags : u32
 
 	// specify that input streams should not be resampled; stream update handler
 	// must be able to accommodate multiple strams of differing input rates
-	STREAM_DISABLE_INPUT_RESAMPLING = 0x02
+	STREAM_DISABLE_INPUT_RESAMPLING = 0x02,
+
+	// specify that the update handler only touches state belonging to its own
+	// device, so it may run on a worker thread alongside other such streams
+	STREAM_PARALLEL_SAFE = 0x04
 };
 
 
@@ -622,6 +680,7 @@ public:
 	bool output_adaptive() const { return m_output_adaptive; }
 	bool synchronous() const { return m_synchronous; }
 	bool resampling_disabled() const { return m_resampling_disabled; }
+	bool parallel_safe() const { return m_parallel_safe; }
 
 	// input and output getters
 	u32 input_count() const { return m_input.size(); }
@@ -694,6 +753,7 @@ private:
 	bool m_output_adaptive;                        // adaptive stream that runs at the sample rate of its output
 	bool m_synchronous;                            // synchronous stream that runs at the rate of its input
 	bool m_resampling_disabled;                    // is resampling of input streams disabled?
+	bool m_parallel_safe;                          // may the callback run concurrently with other streams?
 	emu_timer *m_sync_timer;                       // update timer for synchronous streams
 
 	attotime m_last_update_end_time;               // last end_time() in update
@@ -728,6 +788,7 @@ public:
 private:
 	// internal state
 	u32 m_max_latency;
+	std::vector<stream_buffer::sample_t> m_input;  // linear copy of the input samples
 };
 
 
@@ -750,10 +811,14 @@ class sound_manager
 	static constexpr u8 MUTE_REASON_UI = 0x02;
 	static constexpr u8 MUTE_REASON_DEBUGGER = 0x04;
 	static constexpr u8 MUTE_REASON_SYSTEM = 0x08;
+	static constexpr u8 MUTE_REASON_FASTFORWARD = 0x10;
 
 	// stream updates
 	static const attotime STREAMS_UPDATE_ATTOTIME;
 
+	// maximum output rate adjustment for -audio_rate_control
+	static constexpr double RATE_CONTROL_RANGE = 0.005;
+
 public:
 	static constexpr int STREAMS_UPDATE_FREQUENCY = 50;
 
@@ -787,9 +852,11 @@ public:
 	bool ui_mute() const { return bool(m_muted & MUTE_REASON_UI); }
 	bool debugger_mute() const { return bool(m_muted & MUTE_REASON_DEBUGGER); }
 	bool system_mute() const { return bool(m_muted & MUTE_REASON_SYSTEM); }
+	bool fastforward_mute() const { return bool(m_muted & MUTE_REASON_FASTFORWARD); }
 	void ui_mute(bool turn_off) { mute(turn_off, MUTE_REASON_UI); }
 	void debugger_mute(bool turn_off) { mute(turn_off, MUTE_REASON_DEBUGGER); }
 	void system_mute(bool turn_off) { mute(turn_off, MUTE_REASON_SYSTEM); }
+	void fastforward_mute(bool turn_off) { mute(turn_off, MUTE_REASON_FASTFORWARD); }
 
 	// return information about the given mixer input, by index
 	bool indexed_mixer_input(int index, mixer_input &info) const;
@@ -797,6 +864,9 @@ public:
 	// fill the given buffer with 16-bit stereo audio samples
 	void samples(s16 *buffer);
 
+	// discard output while emulating frames that will be rolled back
+	void set_speculative(bool speculative) { m_speculative = speculative; }
+
 private:
 	// set/reset the mute state for the given reason
 	void mute(bool mute, u8 reason);
@@ -804,6 +874,11 @@ private:
 	// helper to remove items from the orphan list
 	void recursive_remove_stream_from_orphan_list(sound_stream *stream);
 
+	// bring independent source streams up to date on worker threads
+	void build_parallel_groups();
+	void update_parallel_groups();
+	static void *parallel_group_update(void *param, int threadid);
+
 	// apply pending sample rate changes
 	void apply_sample_rate_changes();
 
@@ -827,6 +902,7 @@ private:
 	// internal state
 	running_machine &m_machine;           // reference to the running machine
 	emu_timer *m_update_timer;            // timer that runs the update function
+	bool m_speculative;                   // output is from a timeline that will be rolled back
 	std::vector<std::reference_wrapper<speaker_device> > m_speakers;
 
 	u32 m_update_number;                  // current update index; used for sample rate updates
@@ -841,6 +917,9 @@ private:
 	int m_compressor_counter;             // compressor update counter for backoff
 	bool m_compressor_enabled;            // enable compressor (it will still be calculated for detecting overdrive)
 
+	bool m_rate_control;                  // adjust the output rate to hold the OSD buffer level
+	double m_rate_integral;               // integral term of the output rate control loop
+
 	u8 m_muted;                           // bitmask of muting reasons
 	bool m_nosound_mode;                  // true if we're in "nosound" mode
 	int m_attenuation;                    // current attentuation level (at the OSD)
@@ -851,6 +930,14 @@ private:
 	std::vector<std::unique_ptr<sound_stream>> m_stream_list; // list of streams
 	std::map<sound_stream *, u8> m_orphan_stream_list; // list of orphaned streams
 	bool m_first_reset;                   // is this our first reset?
+
+	// parallel source stream updates
+	struct parallel_group
+	{
+		std::vector<sound_stream *> streams;    // source streams belonging to one device
+	};
+	osd_work_queue *m_parallel_queue;     // work queue for parallel updates (nullptr if disabled)
+	std::vector<parallel_group> m_parallel_groups; // groups that can be updated concurrently
 };
 
 
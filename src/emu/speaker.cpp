@@ -119,28 +119,33 @@ void speaker_device::mix(stream_buffer::sample_t *leftmix, stream_buffer::sample
 	// mix if sound is enabled
 	if (!suppress)
 	{
-		// if the speaker is hard panned to the left, send only to the left
-		if (m_pan == -1.0f)
-			for (int sample = 0; sample < expected_samples; sample++)
-				leftmix[sample] += view.get(sample);
-
-		// if the speaker is hard panned to the right, send only to the right
-		else if (m_pan == 1.0f)
-			for (int sample = 0; sample < expected_samples; sample++)
-				rightmix[sample] += view.get(sample);
-
-		// otherwise, send to both
-		else
-		{
-			const float leftpan = (m_pan <= 0.0f) ? 1.0f : 1.0f - m_pan;
-			const float rightpan = (m_pan >= 0.0f) ? 1.0f : 1.0f + m_pan;
+		const float leftpan = (m_pan <= 0.0f) ? 1.0f : 1.0f - m_pan;
+		const float rightpan = (m_pan >= 0.0f) ? 1.0f : 1.0f + m_pan;
 
-			for (int sample = 0; sample < expected_samples; sample++)
-			{
-				stream_buffer::sample_t cursample = view.get(sample);
-				leftmix[sample] += cursample * leftpan;
-				rightmix[sample] += cursample * rightpan;
-			}
+		// work through the view in linear blocks so the inner loops vectorise
+		stream_buffer::sample_t block[256];
+		for (int base = 0; base < expected_samples; base += std::size(block))
+		{
+			int const count = std::min<int>(expected_samples - base, std::size(block));
+			view.get_block(base, count, block);
+
+			// if the speaker is hard panned to the left, send only to the left
+			if (m_pan == -1.0f)
+				for (int sample = 0; sample < count; sample++)
+					leftmix[base + sample] += block[sample];
+
+			// if the speaker is hard panned to the right, send only to the right
+			else if (m_pan == 1.0f)
+				for (int sample = 0; sample < count; sample++)
+					rightmix[base + sample] += block[sample];
+
+			// otherwise, send to both
+			else
+				for (int sample = 0; sample < count; sample++)
+				{
+					leftmix[base + sample] += block[sample] * leftpan;
+					rightmix[base + sample] += block[sample] * rightpan;
+				}
 		}
 	}
 }
@@ -0,0 +1,266 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    statehash.cpp
+
+    Per-frame hashing of the machine state for finding where two runs
+    stop being deterministic.
+
+    The log starts with a "statehash <system> <entries>" line.  Each
+    checkpoint is a "frame <n> <total>" line followed by "<index> <hash>"
+    lines for the entries that changed since the previous checkpoint.
+    Entries are hashed in host byte order, so logs only compare between
+    hosts of the same endianness.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "statehash.h"
+
+#include "emuopts.h"
+
+#include "hashing.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+//**************************************************************************
+//  STATE HASHER
+//**************************************************************************
+
+//-------------------------------------------------
+//  state_hasher - constructor
+//-------------------------------------------------
+
+state_hasher::state_hasher(running_machine &machine)
+	: m_machine(machine)
+	, m_interval(std::max(machine.options().state_hash(), 1))
+	, m_frame(0)
+	, m_last_match(0)
+	, m_total(0)
+	, m_expected_total(0)
+	, m_expected_frame(0)
+{
+	auto const &opts = machine.options();
+	unsigned const count = machine.save().registration_count();
+	m_hashes.resize(count, 0);
+
+	if (*opts.state_hash_log())
+	{
+		std::error_condition const filerr = util::core_file::open(opts.state_hash_log(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, m_log);
+		if (filerr)
+			osd_printf_error("Error opening state hash log %s (%s)\n", opts.state_hash_log(), filerr.message());
+		else
+			m_log->printf("statehash %s %u\n", machine.system().name, count);
+	}
+
+	if (*opts.state_hash_compare())
+	{
+		std::error_condition const filerr = util::core_file::open(opts.state_hash_compare(), OPEN_FLAG_READ, m_reference);
+		if (filerr)
+		{
+			osd_printf_error("Error opening state hash reference %s (%s)\n", opts.state_hash_compare(), filerr.message());
+		}
+		else
+		{
+			// the reference is only useful if it hashed the same list of entries
+			char line[256];
+			char system[64];
+			unsigned entries;
+			if (!m_reference->gets(line, sizeof(line)) || (std::sscanf(line, "statehash %63s %u", system, &entries) != 2))
+			{
+				osd_printf_error("%s is not a state hash log\n", opts.state_hash_compare());
+				m_reference.reset();
+			}
+			else if (strcmp(system, machine.system().name) || (entries != count))
+			{
+				osd_printf_error("State hash reference %s was logged for %s with %u entries, not %s with %u\n", opts.state_hash_compare(), system, entries, machine.system().name, count);
+				m_reference.reset();
+			}
+			m_expected.resize(count, 0);
+		}
+	}
+
+	machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&state_hasher::frame_update, this));
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&state_hasher::exit, this));
+}
+
+
+//-------------------------------------------------
+//  ~state_hasher - destructor
+//-------------------------------------------------
+
+state_hasher::~state_hasher()
+{
+}
+
+
+//-------------------------------------------------
+//  frame_update - hash the state at every
+//  checkpoint, log it and check it against the
+//  reference
+//-------------------------------------------------
+
+void state_hasher::frame_update()
+{
+	// frames pumped through while paused don't count
+	if (machine().paused())
+		return;
+	if ((++m_frame % m_interval) != 0)
+		return;
+	if (!m_log && !m_reference)
+		return;
+
+	compute();
+
+	if (m_log)
+	{
+		m_log->printf("frame %u %08x\n", m_frame, m_total);
+		for (unsigned index = 0; index < m_hashes.size(); index++)
+		{
+			if (m_logged.empty() || (m_logged[index] != m_hashes[index]))
+				m_log->printf("%u %08x\n", index, m_hashes[index]);
+		}
+		m_logged = m_hashes;
+	}
+
+	if (m_reference)
+	{
+		if (!read_reference())
+		{
+			osd_printf_info("State hash reference ended at frame %u, matched up to there\n", m_last_match);
+			m_reference.reset();
+		}
+		else if (m_expected_frame != m_frame)
+		{
+			osd_printf_error("State hash reference has a checkpoint at frame %u rather than %u, was it logged with a different -%s?\n", m_expected_frame, m_frame, OPTION_STATEHASH);
+			m_reference.reset();
+		}
+		else if ((m_expected_total != m_total) || (m_expected != m_hashes))
+		{
+			report_mismatch();
+			m_reference.reset();
+		}
+		else
+		{
+			m_last_match = m_frame;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  exit - close the files
+//-------------------------------------------------
+
+void state_hasher::exit()
+{
+	m_log.reset();
+	m_reference.reset();
+}
+
+
+//-------------------------------------------------
+//  compute - hash every save state entry the way
+//  it would be written to a state
+//-------------------------------------------------
+
+void state_hasher::compute()
+{
+	save_manager &save = machine().save();
+	save.dispatch_presave();
+
+	for (unsigned index = 0; index < m_hashes.size(); index++)
+	{
+		void *base;
+		u32 valsize, valcount, blockcount, stride;
+		save.indexed_item(index, base, valsize, valcount, blockcount, stride);
+
+		util::crc32_creator crc;
+		u8 const *data = reinterpret_cast<u8 const *>(base);
+		for (u32 b = 0; blockcount > b; ++b, data += stride)
+			crc.append(data, valsize * valcount);
+		m_hashes[index] = crc.finish();
+	}
+	m_total = util::crc32_creator::simple(m_hashes.data(), m_hashes.size() * sizeof(m_hashes[0]));
+}
+
+
+//-------------------------------------------------
+//  read_reference - read the next checkpoint
+//  from the reference log
+//-------------------------------------------------
+
+bool state_hasher::read_reference()
+{
+	char line[256];
+
+	// the checkpoint's first line was read while looking for the end of the last one
+	if (m_pending.empty())
+	{
+		if (!m_reference->gets(line, sizeof(line)))
+			return false;
+		m_pending = line;
+	}
+
+	unsigned long long frame;
+	unsigned total;
+	if (std::sscanf(m_pending.c_str(), "frame %llu %x", &frame, &total) != 2)
+		return false;
+	m_pending.clear();
+	m_expected_frame = frame;
+	m_expected_total = total;
+
+	// entries not listed haven't changed since the previous checkpoint
+	while (m_reference->gets(line, sizeof(line)))
+	{
+		if (!strncmp(line, "frame ", 6))
+		{
+			m_pending = line;
+			break;
+		}
+
+		unsigned index, hash;
+		if ((std::sscanf(line, "%u %x", &index, &hash) == 2) && (index < m_expected.size()))
+			m_expected[index] = hash;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  report_mismatch - list the entries that
+//  differ from the reference
+//-------------------------------------------------
+
+void state_hasher::report_mismatch()
+{
+	static constexpr unsigned MAX_REPORTED = 16;
+
+	osd_printf_error("State diverged from reference between frames %u and %u\n", m_last_match, m_frame);
+
+	// entries are sorted by module and tag, so devices stay together
+	unsigned differing = 0;
+	for (unsigned index = 0; index < m_hashes.size(); index++)
+	{
+		if (m_hashes[index] == m_expected[index])
+			continue;
+
+		if (differing++ < MAX_REPORTED)
+		{
+			void *base;
+			u32 valsize, valcount, blockcount, stride;
+			char const *const name = machine().save().indexed_item(index, base, valsize, valcount, blockcount, stride);
+			osd_printf_error("  %s\n", name);
+		}
+	}
+	if (differing > MAX_REPORTED)
+		osd_printf_error("  ...and %u more entries\n", differing - MAX_REPORTED);
+	if (m_interval > 1)
+		osd_printf_error("Run both with -%s 1 to find the first frame that differs\n", OPTION_STATEHASH);
+
+	machine().popmessage("State diverged from reference at frame %u", m_frame);
+}
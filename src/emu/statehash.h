@@ -0,0 +1,63 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    statehash.h
+
+    Per-frame hashing of the machine state for finding where two runs
+    stop being deterministic.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_STATEHASH_H
+#define MAME_EMU_STATEHASH_H
+
+#pragma once
+
+#include "corefile.h"
+
+#include <string>
+#include <vector>
+
+
+// ======================> state_hasher
+
+// every N committed frames, hashes each registered save state entry and the
+// list of entry hashes; the hashes can be logged, and compared against the
+// log of an earlier run to name the entries that diverged first
+class state_hasher
+{
+	DISABLE_COPYING(state_hasher);
+
+public:
+	// construction/destruction
+	state_hasher(running_machine &machine);
+	~state_hasher();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+
+private:
+	void frame_update();
+	void exit();
+	void compute();
+	bool read_reference();
+	void report_mismatch();
+
+	// internal state
+	running_machine &       m_machine;          // reference to our machine
+	u32                     m_interval;         // frames between hashes
+	u64                     m_frame;            // committed frames so far
+	u64                     m_last_match;       // last frame the reference agreed with
+	util::core_file::ptr    m_log;              // log being written
+	util::core_file::ptr    m_reference;        // log of an earlier run being compared against
+	std::string             m_pending;          // line read ahead from the reference
+	std::vector<u32>        m_hashes;           // hash of each entry at the last checkpoint
+	std::vector<u32>        m_logged;           // hashes as of the last line written to the log
+	std::vector<u32>        m_expected;         // hashes from the reference at the same checkpoint
+	u32                     m_total;            // hash of all entry hashes
+	u32                     m_expected_total;   // same from the reference
+	u64                     m_expected_frame;   // frame of the reference checkpoint
+};
+
+#endif // MAME_EMU_STATEHASH_H
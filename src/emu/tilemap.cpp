@@ -14,6 +14,15 @@
 #include "screen.h"
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// batched tile updates at least this big are spread across worker threads
+constexpr u32 PARALLEL_TILE_THRESHOLD = 256;
+constexpr u32 PARALLEL_TILE_CHUNK = 64;
+
+
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
@@ -754,6 +763,7 @@ inline void tilemap_t::realize_all_dirty_tiles()
 	{
 		memset(&m_tileflags[0], TILE_FLAG_DIRTY, m_tileflags.size());
 		m_all_tiles_dirty = false;
+		m_all_tiles_clean = false;
 		m_gfx_used = 0;
 	}
 }
@@ -777,18 +787,71 @@ void tilemap_t::pixmap_update()
 	// flush the dirty state to all tiles as appropriate
 	realize_all_dirty_tiles();
 
-	// iterate over rows and columns
-	logical_index logindex = 0;
-	for (u32 row = 0; row < m_rows; row++)
-		for (u32 col = 0; col < m_cols; col++, logindex++)
-			if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
-				tile_update(logindex, col, row);
+	// update every dirty tile in the map
+	tiles_update(0, m_cols, 0, m_rows);
 
 	// mark it all clean
 	m_all_tiles_clean = true;
 }
 
 
+//-------------------------------------------------
+//  tiles_update - update the dirty tiles in a
+//  range of columns and rows as one batch
+//-------------------------------------------------
+
+void tilemap_t::tiles_update(u32 mincol, u32 maxcol, u32 minrow, u32 maxrow)
+{
+	auto profile = g_profiler.start(PROFILER_TILEMAP_UPDATE);
+
+	// fetch the info for every dirty tile first; the callbacks touch driver
+	// state, so this part always happens in order on this thread
+	m_pending.clear();
+	for (u32 row = minrow; row < maxrow; row++)
+	{
+		logical_index logindex = row * m_cols + mincol;
+		for (u32 col = mincol; col < maxcol; col++, logindex++)
+			if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
+				tile_prepare(m_pending.emplace_back(), logindex, col, row);
+	}
+
+	// each tile only writes its own part of the pixmap, so big batches (a
+	// tilemap rewritten wholesale every frame) can be spread across threads
+	u32 const count = m_pending.size();
+	if (count >= PARALLEL_TILE_THRESHOLD)
+	{
+		osd_work_queue *const queue = m_manager->work_queue();
+		if (queue)
+		{
+			m_chunks.clear();
+			for (u32 start = 0; start < count; start += PARALLEL_TILE_CHUNK)
+				m_chunks.push_back(render_chunk{ this, start, (std::min)(count - start, PARALLEL_TILE_CHUNK) });
+			osd_work_item_queue_multiple(queue, &tilemap_t::render_chunk_callback, m_chunks.size(), &m_chunks[0], sizeof(m_chunks[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+			return;
+		}
+	}
+
+	for (pending_tile const &tile : m_pending)
+		tile_render(tile);
+}
+
+
+//-------------------------------------------------
+//  render_chunk_callback - render a run of
+//  pending tiles on a worker thread
+//-------------------------------------------------
+
+void *tilemap_t::render_chunk_callback(void *param, int threadid)
+{
+	render_chunk const &chunk = *reinterpret_cast<render_chunk const *>(param);
+	pending_tile const *const tiles = &chunk.tilemap->m_pending[chunk.start];
+	for (u32 index = 0; index < chunk.count; index++)
+		chunk.tilemap->tile_render(tiles[index]);
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  tile_update - update a single dirty tile
 //-------------------------------------------------
@@ -797,22 +860,35 @@ void tilemap_t::tile_update(logical_index logindex, u32 col, u32 row)
 {
 	auto profile = g_profiler.start(PROFILER_TILEMAP_UPDATE);
 
+	pending_tile tile;
+	tile_prepare(tile, logindex, col, row);
+	tile_render(tile);
+}
+
+
+//-------------------------------------------------
+//  tile_prepare - fetch the info for a dirty
+//  tile and work out where it gets drawn
+//-------------------------------------------------
+
+void tilemap_t::tile_prepare(pending_tile &tile, logical_index logindex, u32 col, u32 row)
+{
 	// call the get info callback for the associated memory index
 	tilemap_memory_index memindex = m_logical_to_memory[logindex];
 	m_tile_get_info(*this, m_tileinfo, memindex);
 
 	// apply the global tilemap flip to the returned flip flags
-	u32 flags = m_tileinfo.flags ^ (m_attributes & 0x03);
-
-	// draw the tile, using either direct or transparent
-	u32 x0 = m_tilewidth * col;
-	u32 y0 = m_tileheight * row;
-	m_tileflags[logindex] = tile_draw(m_tileinfo.pen_data, x0, y0,
-		m_tileinfo.palette_base, m_tileinfo.category, m_tileinfo.group, flags, m_tileinfo.pen_mask);
-
-	// if mask data is specified, apply it
-	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && m_tileinfo.mask_data != nullptr)
-		m_tileflags[logindex] = tile_apply_bitmask(m_tileinfo.mask_data, x0, y0, m_tileinfo.category, flags);
+	tile.flags = m_tileinfo.flags ^ (m_attributes & 0x03);
+
+	tile.pen_data = m_tileinfo.pen_data;
+	tile.mask_data = ((tile.flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0) ? m_tileinfo.mask_data : nullptr;
+	tile.palette_base = m_tileinfo.palette_base;
+	tile.x0 = m_tilewidth * col;
+	tile.y0 = m_tileheight * row;
+	tile.logindex = logindex;
+	tile.category = m_tileinfo.category;
+	tile.group = m_tileinfo.group;
+	tile.pen_mask = m_tileinfo.pen_mask;
 
 	// track which gfx have been used for this tilemap
 	if (m_tileinfo.gfxnum != 0xff && (m_gfx_used & (1 << m_tileinfo.gfxnum)) == 0)
@@ -823,6 +899,23 @@ void tilemap_t::tile_update(logical_index logindex, u32 col, u32 row)
 }
 
 
+//-------------------------------------------------
+//  tile_render - draw a prepared tile into the
+//  pixmap and flagsmap
+//-------------------------------------------------
+
+void tilemap_t::tile_render(const pending_tile &tile)
+{
+	// draw the tile, using either direct or transparent
+	m_tileflags[tile.logindex] = tile_draw(tile.pen_data, tile.x0, tile.y0,
+		tile.palette_base, tile.category, tile.group, tile.flags, tile.pen_mask);
+
+	// if mask data is specified, apply it
+	if (tile.mask_data != nullptr)
+		m_tileflags[tile.logindex] = tile_apply_bitmask(tile.mask_data, tile.x0, tile.y0, tile.category, tile.flags);
+}
+
+
 //-------------------------------------------------
 //  tile_draw - draw a single tile to the
 //  tilemap's internal pixmap, using the pen as
@@ -843,16 +936,24 @@ u8 tilemap_t::tile_draw(const u8 *pendata, u32 x0, u32 y0, u32 palette_base, u8
 		dy0 = -1;
 	}
 
-	// if we're horizontally flipped, point to the rightmost column and work backwards
-	int dx0 = 1;
+	// iterate over rows; the column direction is fixed per tile, so pick a
+	// loop with a constant stride that the compiler can unroll and vectorise
+	const u8 *penmap = m_pen_to_flags + group * MAX_PEN_TO_FLAGS;
 	if (flags & TILE_FLIPX)
-	{
-		x0 += m_tilewidth - 1;
-		dx0 = -1;
-	}
+		return tile_draw_rows<-1>(pendata, x0 + m_tilewidth - 1, y0, dy0, palette_base, category, penmap, pen_mask);
+	else
+		return tile_draw_rows<1>(pendata, x0, y0, dy0, palette_base, category, penmap, pen_mask);
+}
 
-	// iterate over rows
-	const u8 *penmap = m_pen_to_flags + group * MAX_PEN_TO_FLAGS;
+
+//-------------------------------------------------
+//  tile_draw_rows - inner loop of tile_draw for
+//  one horizontal direction
+//-------------------------------------------------
+
+template <int DX>
+inline u8 tilemap_t::tile_draw_rows(const u8 *pendata, u32 x0, u32 y0, int dy0, u32 palette_base, u8 category, const u8 *penmap, u8 pen_mask)
+{
 	u8 andmask = ~0, ormask = 0;
 	for (u16 ty = 0; ty < m_tileheight; ty++)
 	{
@@ -863,17 +964,16 @@ u8 tilemap_t::tile_draw(const u8 *pendata, u32 x0, u32 y0, u32 palette_base, u8
 		y0 += dy0;
 
 		// 8bpp data
-		int xoffs = 0;
-		for (u16 tx = 0; tx < m_tilewidth; tx++)
+		for (int tx = 0; tx < m_tilewidth; tx++)
 		{
-			u8 pen = (*pendata++) & pen_mask;
+			u8 pen = pendata[tx] & pen_mask;
 			u8 map = penmap[pen];
-			pixptr[xoffs] = palette_base + pen;
-			flagsptr[xoffs] = map | category;
+			pixptr[tx * DX] = palette_base + pen;
+			flagsptr[tx * DX] = map | category;
 			andmask &= map;
 			ormask |= map;
-			xoffs += dx0;
 		}
+		pendata += m_tilewidth;
 	}
 	return andmask ^ ormask;
 }
@@ -1210,6 +1310,10 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 	int mincol = x1 / m_tilewidth;
 	int maxcol = (x2 + m_tilewidth - 1) / m_tilewidth;
 
+	// bring the covered tiles up to date in one batch before blitting
+	if (!m_all_tiles_clean)
+		tiles_update(mincol, maxcol, y1 / m_tileheight, (y2 + m_tileheight - 1) / m_tileheight);
+
 	// set up row counter
 	int y = y1;
 	int nexty = m_tileheight * (y1 / m_tileheight) + m_tileheight;
@@ -1343,15 +1447,40 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 do {                                                                        \
 	if (sizeof(*dest) == 2)                                                 \
 		*dest = (INPUT_VAL) + (priority >> 16);                             \
-	else if (sizeof(*dest) == 4 && alpha >= 0xff)                           \
+	else if (!Blend)                                                        \
 		*dest = clut[INPUT_VAL];                                            \
-	else if (sizeof(*dest) == 4)                                            \
+	else                                                                    \
 		*dest = alpha_blend_r32(*dest, clut[INPUT_VAL], alpha);             \
 } while (0)
 
 template<class _BitmapClass>
 void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit,
 		u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound)
+{
+	// pick a loop specialised for the priority and blending modes once per
+	// call rather than testing them for every pixel
+	bool const prio = blit.tilemap_priority_code != 0xff00;
+	bool const blend = (sizeof(typename _BitmapClass::pixel_t) == 4) && (blit.alpha < 0xff);
+	if (prio && blend)
+		draw_roz_core_specific<true, true>(screen, destbitmap, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+	else if (prio)
+		draw_roz_core_specific<true, false>(screen, destbitmap, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+	else if (blend)
+		draw_roz_core_specific<false, true>(screen, destbitmap, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+	else
+		draw_roz_core_specific<false, false>(screen, destbitmap, blit, startx, starty, incxx, incxy, incyx, incyy, wraparound);
+}
+
+
+//-------------------------------------------------
+//  draw_roz_core_specific - rotate/zoom inner
+//  loops for one combination of priority and
+//  blending
+//-------------------------------------------------
+
+template<bool Priority, bool Blend, class _BitmapClass>
+void tilemap_t::draw_roz_core_specific(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit,
+		u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound)
 {
 	// pre-cache all the inner loop values
 	const rgb_t *clut = m_palette->palette()->entry_list_adjusted() + (blit.tilemap_priority_code >> 16);
@@ -1401,7 +1530,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 				u32 cy = starty >> 16;
 
 				// get source and priority pointers
-				u8 *pri = (priority != 0xff00) ? &priority_bitmap.pix(sy, sx) : nullptr;
+				u8 *pri = Priority ? &priority_bitmap.pix(sy, sx) : nullptr;
 				const u16 *src = &m_pixmap.pix(cy);
 				const u8 *maskptr = &m_flagsmap.pix(cy);
 				typename _BitmapClass::pixel_t *dest = &destbitmap.pix(sy, sx);
@@ -1413,7 +1542,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 					if ((maskptr[cx >> 16] & mask) == value)
 					{
 						ROZ_PLOT_PIXEL(src[cx >> 16]);
-						if (priority != 0xff00)
+						if (Priority)
 							*pri = (*pri & (priority >> 8)) | priority;
 					}
 
@@ -1421,7 +1550,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 					cx += incxx;
 					x++;
 					++dest;
-					if (priority != 0xff00)
+					if (Priority)
 						pri++;
 				}
 			}
@@ -1445,7 +1574,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 
 			// get dest and priority pointers
 			typename _BitmapClass::pixel_t *dest = &destbitmap.pix(sy, sx);
-			u8 *pri = (priority != 0xff00) ? &priority_bitmap.pix(sy, sx) : nullptr;
+			u8 *pri = Priority ? &priority_bitmap.pix(sy, sx) : nullptr;
 
 			// loop over columns
 			while (x <= ex)
@@ -1454,7 +1583,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 				if ((m_flagsmap.pix((cy >> 16) & ymask, (cx >> 16) & xmask) & mask) == value)
 				{
 					ROZ_PLOT_PIXEL(m_pixmap.pix((cy >> 16) & ymask, (cx >> 16) & xmask));
-					if (priority != 0xff00)
+					if (Priority)
 						*pri = (*pri & (priority >> 8)) | priority;
 				}
 
@@ -1463,7 +1592,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 				cy += incxy;
 				x++;
 				++dest;
-				if (priority != 0xff00)
+				if (Priority)
 					pri++;
 			}
 
@@ -1487,7 +1616,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 
 			// get dest and priority pointers
 			typename _BitmapClass::pixel_t *dest = &destbitmap.pix(sy, sx);
-			u8 *pri = (priority != 0xff00) ? &priority_bitmap.pix(sy, sx) : nullptr;
+			u8 *pri = Priority ? &priority_bitmap.pix(sy, sx) : nullptr;
 
 			// loop over columns
 			while (x <= ex)
@@ -1497,7 +1626,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 					if ((m_flagsmap.pix(cy >> 16, cx >> 16) & mask) == value)
 					{
 						ROZ_PLOT_PIXEL(m_pixmap.pix(cy >> 16, cx >> 16));
-						if (priority != 0xff00)
+						if (Priority)
 							*pri = (*pri & (priority >> 8)) | priority;
 					}
 
@@ -1506,7 +1635,7 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 				cy += incxy;
 				x++;
 				++dest;
-				if (priority != 0xff00)
+				if (Priority)
 					pri++;
 			}
 
@@ -1585,7 +1714,8 @@ void tilemap_t::get_info_debug(u32 col, u32 row, u8 &gfxnum, u32 &code, u32 &col
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
+		m_instance(0),
+		m_work_queue(nullptr)
 {
 }
 
@@ -1609,6 +1739,23 @@ tilemap_manager::~tilemap_manager()
 				break;
 			}
 	}
+
+	if (m_work_queue)
+		osd_work_queue_free(m_work_queue);
+}
+
+
+//-------------------------------------------------
+//  work_queue - return the queue used to render
+//  large batches of tiles, creating it on first
+//  use
+//-------------------------------------------------
+
+osd_work_queue *tilemap_manager::work_queue()
+{
+	if (!m_work_queue)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	return m_work_queue;
 }
 
 
@@ -1655,6 +1802,18 @@ void tilemap_manager::mark_all_dirty()
 }
 
 
+//-------------------------------------------------
+//  update_all_dirty - refresh the dirty tiles of
+//  all tilemaps
+//-------------------------------------------------
+
+void tilemap_manager::update_all_dirty()
+{
+	for (tilemap_t &tmap : m_tilemap_list)
+		tmap.pixmap_update();
+}
+
+
 
 //**************************************************************************
 //  TILEMAP DEVICE
@@ -526,6 +526,29 @@ private:
 		u8                  alpha;
 	};
 
+	// a dirty tile whose info has been fetched, waiting to be rendered
+	struct pending_tile
+	{
+		const u8 *          pen_data;
+		const u8 *          mask_data;
+		u32                 palette_base;
+		u32                 x0;
+		u32                 y0;
+		logical_index       logindex;
+		u8                  category;
+		u8                  group;
+		u8                  flags;
+		u8                  pen_mask;
+	};
+
+	// a run of pending tiles handed to a worker
+	struct render_chunk
+	{
+		tilemap_t *         tilemap;
+		u32                 start;
+		u32                 count;
+	};
+
 	// inline helpers
 	s32 effective_rowscroll(int index, u32 screen_width);
 	s32 effective_colscroll(int index, u32 screen_height);
@@ -549,14 +572,20 @@ private:
 
 	// internal drawing
 	void pixmap_update();
+	void tiles_update(u32 mincol, u32 maxcol, u32 minrow, u32 maxrow);
 	void tile_update(logical_index logindex, u32 col, u32 row);
+	void tile_prepare(pending_tile &tile, logical_index logindex, u32 col, u32 row);
+	void tile_render(const pending_tile &tile);
+	static void *render_chunk_callback(void *param, int threadid);
 	u8 tile_draw(const u8 *pendata, u32 x0, u32 y0, u32 palette_base, u8 category, u8 group, u8 flags, u8 pen_mask);
+	template <int DX> u8 tile_draw_rows(const u8 *pendata, u32 x0, u32 y0, int dy0, u32 palette_base, u8 category, const u8 *penmap, u8 pen_mask);
 	u8 tile_apply_bitmask(const u8 *maskdata, u32 x0, u32 y0, u8 category, u8 flags);
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, u32 flags, u8 priority, u8 priority_mask);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
+	template<bool Priority, bool Blend, class _BitmapClass> void draw_roz_core_specific(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
 
 	// managers and devices
 	tilemap_manager *           m_manager;              // reference to the owning manager
@@ -581,6 +610,8 @@ private:
 	// callback to interpret video RAM for the tilemap
 	tilemap_get_info_delegate   m_tile_get_info;        // callback to get information about a tile
 	tile_data                   m_tileinfo;             // structure to hold the data for a tile
+	std::vector<pending_tile>   m_pending;              // dirty tiles gathered for a batched update
+	std::vector<render_chunk>   m_chunks;               // work items for a parallel batched update
 
 	// global tilemap states
 	bool                        m_enable;               // true if we are enabled
@@ -641,6 +672,7 @@ public:
 	// global operations on all tilemaps
 	void mark_all_dirty();
 	void set_flip_all(u32 attributes);
+	void update_all_dirty();
 
 private:
 	// tilemap creation
@@ -650,10 +682,14 @@ private:
 	// allocate an instance index
 	int alloc_instance() { return ++m_instance; }
 
+	// shared queue for large tile updates
+	osd_work_queue *work_queue();
+
 	// internal state
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	osd_work_queue *        m_work_queue;
 };
 
 
@@ -21,7 +21,9 @@
 #include "path.h"
 #include "unicode.h"
 
+#include <atomic>
 #include <cctype>
+#include <exception>
 #include <type_traits>
 #include <typeinfo>
 
@@ -1763,6 +1765,19 @@ inline int validity_checker::get_defstr_index(const char *string, bool suppress_
 
 
 
+//-------------------------------------------------
+//  already_checked - generic registry of
+//  already-checked stuff, shared with workers
+//-------------------------------------------------
+
+bool validity_checker::already_checked(const char *string)
+{
+	validity_checker &owner(m_owner ? *m_owner : *this);
+	std::lock_guard<std::mutex> lock(owner.m_shared_mutex);
+	return !owner.m_already_checked.insert(string).second;
+}
+
+
 //-------------------------------------------------
 //  validate_tag - ensure that the given tag
 //  meets the general requirements
@@ -1832,6 +1847,7 @@ validity_checker::validity_checker(emu_options &options, bool quick)
 	, m_current_ioport(nullptr)
 	, m_checking_card(false)
 	, m_quick(quick)
+	, m_owner(nullptr)
 {
 	// pre-populate the defstr map with all the default strings
 	for (int strnum = 1; strnum < INPUT_STRING_COUNT; strnum++)
@@ -1842,6 +1858,21 @@ validity_checker::validity_checker(emu_options &options, bool quick)
 	}
 }
 
+validity_checker::validity_checker(validity_checker &owner)
+	: m_drivlist(owner.m_drivlist.options())
+	, m_errors(0)
+	, m_warnings(0)
+	, m_print_verbose(owner.m_print_verbose)
+	, m_current_driver(nullptr)
+	, m_current_device(nullptr)
+	, m_current_ioport(nullptr)
+	, m_checking_card(false)
+	, m_quick(owner.m_quick)
+	, m_owner(&owner)
+{
+	// the defstr map is left empty to match the owner's state after validate_begin
+}
+
 //-------------------------------------------------
 //  validity_checker - destructor
 //-------------------------------------------------
@@ -1914,16 +1945,33 @@ bool validity_checker::check_all_matching(const char *string)
 		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "\n");
 	}
 
-	// then iterate over all drivers and check them
+	// then collect the matching drivers
+	std::vector<game_driver const *> drivers;
 	m_drivlist.reset();
-	bool validated_any = false;
 	while (m_drivlist.next())
 	{
 		if (driver_list::matches(string, m_drivlist.driver().name))
-		{
-			validate_one(m_drivlist.driver());
-			validated_any = true;
-		}
+			drivers.emplace_back(&m_drivlist.driver());
+	}
+	bool const validated_any = !drivers.empty();
+
+	// record the first driver with each name and description up front, so
+	// duplicates are reported the same way whatever order they're checked in
+	for (game_driver const *driver : drivers)
+	{
+		m_names_map.emplace(driver->name, driver);
+		m_descriptions_map.emplace(driver->type.fullname(), driver);
+	}
+
+	// verbose output is used to find drivers that crash, so keep it sequential
+	if ((1U < drivers.size()) && !m_print_verbose)
+	{
+		validate_parallel(drivers);
+	}
+	else
+	{
+		for (game_driver const *driver : drivers)
+			validate_one(*driver);
 	}
 
 	// validate devices
@@ -2044,6 +2092,136 @@ void validity_checker::validate_one(const game_driver &driver)
 }
 
 
+//-------------------------------------------------
+//  validate_parallel - validate drivers on the
+//  work queue, reporting them in driver order
+//-------------------------------------------------
+
+struct validity_checker::driver_job
+{
+	validity_checker *owner = nullptr;
+	game_driver const *driver = nullptr;
+	captured_output output;
+	int errors = 0;
+	int warnings = 0;
+	std::exception_ptr error;
+	std::atomic<bool> done = false;
+};
+
+thread_local validity_checker *validity_checker::s_worker = nullptr;
+
+void validity_checker::validate_parallel(std::vector<game_driver const *> const &drivers)
+{
+	std::vector<driver_job> jobs(drivers.size());
+	for (std::size_t i = 0; drivers.size() > i; ++i)
+	{
+		jobs[i].owner = this;
+		jobs[i].driver = drivers[i];
+	}
+
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (queue && !osd_work_item_queue_multiple(queue, &validate_job, jobs.size(), jobs.data(), sizeof(jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE))
+	{
+		osd_work_queue_free(queue);
+		queue = nullptr;
+	}
+
+	// retire drivers in order so the output matches a sequential run
+	for (driver_job &job : jobs)
+	{
+		if (!queue)
+			validate_job(&job, 0);
+		else
+			while (!job.done.load(std::memory_order_acquire))
+				osd_work_queue_wait(queue, osd_ticks_per_second() / 100);
+
+		if (job.error)
+		{
+			if (queue)
+				osd_work_queue_free(queue);
+			m_idle_workers.clear();
+			std::rethrow_exception(job.error);
+		}
+
+		for (auto const &[channel, text] : job.output)
+			chain_output(channel, util::make_format_argument_pack("%s", text));
+		captured_output().swap(job.output);
+		m_errors += job.errors;
+		m_warnings += job.warnings;
+	}
+
+	if (queue)
+		osd_work_queue_free(queue);
+	m_idle_workers.clear();
+}
+
+
+//-------------------------------------------------
+//  validate_job - work queue callback validating
+//  one driver with a worker checker
+//-------------------------------------------------
+
+void *validity_checker::validate_job(void *param, int threadid)
+{
+	driver_job &job(*reinterpret_cast<driver_job *>(param));
+	try
+	{
+		// messages are routed to the worker while it's active on this thread
+		std::unique_ptr<validity_checker> worker(job.owner->acquire_worker());
+		s_worker = worker.get();
+		worker->validate_one(*job.driver);
+		s_worker = nullptr;
+
+		job.output = std::move(worker->m_captured);
+		job.errors = worker->m_errors;
+		job.warnings = worker->m_warnings;
+		worker->m_captured.clear();
+		worker->m_errors = 0;
+		worker->m_warnings = 0;
+		job.owner->release_worker(std::move(worker));
+	}
+	catch (...)
+	{
+		s_worker = nullptr;
+		job.error = std::current_exception();
+	}
+	job.done.store(true, std::memory_order_release);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  acquire_worker - get an idle worker checker,
+//  creating one if necessary
+//-------------------------------------------------
+
+std::unique_ptr<validity_checker> validity_checker::acquire_worker()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_shared_mutex);
+		if (!m_idle_workers.empty())
+		{
+			std::unique_ptr<validity_checker> result(std::move(m_idle_workers.back()));
+			m_idle_workers.pop_back();
+			return result;
+		}
+	}
+	return std::unique_ptr<validity_checker>(new validity_checker(*this));
+}
+
+
+//-------------------------------------------------
+//  release_worker - return a worker checker to
+//  the idle pool
+//-------------------------------------------------
+
+void validity_checker::release_worker(std::unique_ptr<validity_checker> &&worker)
+{
+	std::lock_guard<std::mutex> lock(m_shared_mutex);
+	m_idle_workers.emplace_back(std::move(worker));
+}
+
+
 //-------------------------------------------------
 //  validate_driver - validate basic driver
 //  information
@@ -2051,17 +2229,31 @@ void validity_checker::validate_one(const game_driver &driver)
 
 void validity_checker::validate_driver(device_t &root)
 {
+	// workers only read the owner's maps, which are populated before they start
+	game_driver_map &names_map(m_owner ? m_owner->m_names_map : m_names_map);
+	game_driver_map &descriptions_map(m_owner ? m_owner->m_descriptions_map : m_descriptions_map);
+
 	// check for duplicate names
-	if (!m_names_map.insert(std::make_pair(m_current_driver->name, m_current_driver)).second)
+	auto const name(names_map.find(m_current_driver->name));
+	if (names_map.end() == name)
+	{
+		names_map.emplace(m_current_driver->name, m_current_driver);
+	}
+	else if (name->second != m_current_driver)
 	{
-		const game_driver *match = m_names_map.find(m_current_driver->name)->second;
+		const game_driver *match = name->second;
 		osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()), match->name);
 	}
 
 	// check for duplicate descriptions
-	if (!m_descriptions_map.insert(std::make_pair(m_current_driver->type.fullname(), m_current_driver)).second)
+	auto const description(descriptions_map.find(m_current_driver->type.fullname()));
+	if (descriptions_map.end() == description)
+	{
+		descriptions_map.emplace(m_current_driver->type.fullname(), m_current_driver);
+	}
+	else if (description->second != m_current_driver)
 	{
-		const game_driver *match = m_descriptions_map.find(m_current_driver->type.fullname())->second;
+		const game_driver *match = description->second;
 		osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()), match->name);
 	}
 
@@ -2665,8 +2857,13 @@ void validity_checker::validate_devices(machine_config &config)
 					continue;
 
 				// if we need to save time, instantiate and validate each slot card type at most once
-				if (m_quick && !m_slotcard_set.insert(option.second->devtype().shortname()).second)
-					continue;
+				if (m_quick)
+				{
+					validity_checker &owner(m_owner ? *m_owner : *this);
+					std::lock_guard<std::mutex> lock(owner.m_shared_mutex);
+					if (!owner.m_slotcard_set.insert(option.second->devtype().shortname()).second)
+						continue;
+				}
 
 				m_checking_card = true;
 				device_t *card;
@@ -2895,6 +3092,13 @@ void validity_checker::build_output_prefix(std::ostream &str) const
 
 void validity_checker::output_callback(osd_output_channel channel, const util::format_argument_pack<char> &args)
 {
+	// messages raised while a worker is validating on this thread belong to it
+	if (s_worker && (s_worker != this))
+	{
+		s_worker->output_callback(channel, args);
+		return;
+	}
+
 	std::ostringstream output;
 	switch (channel)
 	{
@@ -2935,7 +3139,11 @@ void validity_checker::output_callback(osd_output_channel channel, const util::f
 		break;
 
 	default:
-		chain_output(channel, args);
+		// workers keep everything until their driver is retired
+		if (m_owner)
+			m_captured.emplace_back(channel, util::string_format(args));
+		else
+			chain_output(channel, args);
 		break;
 	}
 }
@@ -2949,8 +3157,11 @@ void validity_checker::output_callback(osd_output_channel channel, const util::f
 template <typename Format, typename... Params>
 void validity_checker::output_via_delegate(osd_output_channel channel, Format &&fmt, Params &&...args)
 {
-	// call through to the delegate with the proper parameters
-	chain_output(channel, util::make_format_argument_pack(std::forward<Format>(fmt), std::forward<Params>(args)...));
+	// workers keep the output until their driver is retired, otherwise call through to the delegate
+	if (m_owner)
+		m_captured.emplace_back(channel, util::string_format(std::forward<Format>(fmt), std::forward<Params>(args)...));
+	else
+		chain_output(channel, util::make_format_argument_pack(std::forward<Format>(fmt), std::forward<Params>(args)...));
 }
 
 //-------------------------------------------------
@@ -16,6 +16,12 @@
 #include "drivenum.h"
 #include "emuopts.h"
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -47,7 +53,7 @@ public:
 	bool ioport_missing(const char *tag) { return !m_checking_card && (m_ioport_set.find(tag) == m_ioport_set.end()); }
 
 	// generic registry of already-checked stuff
-	bool already_checked(const char *string) { return !m_already_checked.insert(string).second; }
+	bool already_checked(const char *string);
 
 protected:
 	// osd_output interface
@@ -58,6 +64,16 @@ private:
 	using game_driver_map = std::unordered_map<std::string, game_driver const *>;
 	using int_map = std::unordered_map<std::string, uintptr_t>;
 	using string_set = std::unordered_set<std::string>;
+	using captured_output = std::vector<std::pair<osd_output_channel, std::string> >;
+
+	// one driver validated on the work queue
+	struct driver_job;
+
+	// worker checkers used for parallel validation
+	validity_checker(validity_checker &owner);
+	std::unique_ptr<validity_checker> acquire_worker();
+	void release_worker(std::unique_ptr<validity_checker> &&worker);
+	static void *validate_job(void *param, int threadid);
 
 	// internal helpers
 	int get_defstr_index(const char *string, bool suppress_error = false);
@@ -66,6 +82,7 @@ private:
 	void validate_begin();
 	void validate_end();
 	void validate_one(const game_driver &driver);
+	void validate_parallel(std::vector<game_driver const *> const &drivers);
 
 	// internal sub-checks
 	void validate_driver(device_t &root);
@@ -112,6 +129,13 @@ private:
 	string_set              m_slotcard_set;
 	bool                    m_checking_card;
 	bool const              m_quick;
+
+	// parallel validation - workers share the owner's registries
+	validity_checker *const m_owner;
+	captured_output         m_captured;
+	std::mutex              m_shared_mutex;
+	std::vector<std::unique_ptr<validity_checker> > m_idle_workers;
+	static thread_local validity_checker *s_worker; // worker checker active on this host thread
 };
 
 #endif // MAME_EMU_VALIDITY_H
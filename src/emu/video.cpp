@@ -29,6 +29,9 @@
 
 #include "rendersw.hxx"
 
+#include <algorithm>
+#include <thread>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -95,10 +98,22 @@ video_manager::video_manager(running_machine &machine)
 	, m_throttled(true)
 	, m_throttle_rate(1.0f)
 	, m_fastforward(false)
+	, m_loading_fastforward(machine.options().loading_fastforward() && !machine.options().headless())
+	, m_loading(false)
+	, m_loading_until(attotime::zero)
 	, m_seconds_to_run(machine.options().seconds_to_run())
 	, m_auto_frameskip(machine.options().auto_frameskip())
 	, m_speed(original_speed_setting())
 	, m_low_latency(machine.options().low_latency())
+	, m_headless(machine.options().headless())
+	, m_frame_number(0)
+	, m_snap_frame_next(0)
+	, m_runahead(0)
+	, m_runahead_frames(0)
+	, m_runahead_pending(false)
+	, m_in_runahead(false)
+	, m_runahead_skipping(false)
+	, m_resimulating(false)
 	, m_empty_skip_count(0)
 	, m_frameskip_max(m_auto_frameskip ? machine.options().frameskip() : 0)
 	, m_frameskip_level(m_auto_frameskip ? 0 : machine.options().frameskip())
@@ -106,15 +121,46 @@ video_manager::video_manager(running_machine &machine)
 	, m_frameskip_adjust(0)
 	, m_skipping_this_frame(false)
 	, m_average_oversleep(0)
+	, m_frame_end_ticks(0)
+	, m_frame_time_hist{ { 0 } }
+	, m_frame_time_total{ 0, 0 }
 	, m_snap_target(nullptr)
 	, m_snap_native(true)
 	, m_snap_width(0)
 	, m_snap_height(0)
+	, m_snap_queue(nullptr)
+	, m_snap_png_queue(nullptr)
+	, m_snap_pending(0)
+	, m_snap_failures(0)
 {
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&video_manager::exit, this));
 	machine.save().register_postload(save_prepost_delegate(FUNC(video_manager::postload), this));
 
+	// run-ahead rewinds every frame, so it can't coexist with input logs, netplay rollback or the debugger
+	// headless runs never show anything, so running ahead would only waste time
+	if (!m_headless && !*machine.options().playback() && !*machine.options().record() && !*machine.options().netplay_remotehost() && !(machine.debug_flags & DEBUG_FLAG_ENABLED))
+		m_runahead = std::clamp(machine.options().runahead(), 0, 8);
+
+	// collect the frames to take snapshots at
+	for (std::string_view frames = machine.options().snap_frames(); !frames.empty(); )
+	{
+		std::string_view::size_type const comma = frames.find(',');
+		std::string const entry(strtrimspace(frames.substr(0, comma)));
+		frames = (std::string_view::npos == comma) ? std::string_view() : frames.substr(comma + 1);
+		if (entry.empty())
+			continue;
+
+		char *end;
+		unsigned long long const frame = std::strtoull(entry.c_str(), &end, 10);
+		if (*end)
+			osd_printf_warning("Ignoring invalid snapshot frame %s\n", entry);
+		else
+			m_snap_frames.emplace_back(frame);
+	}
+	std::sort(m_snap_frames.begin(), m_snap_frames.end());
+	m_snap_frames.erase(std::unique(m_snap_frames.begin(), m_snap_frames.end()), m_snap_frames.end());
+
 	// extract initial execution state from global configuration settings
 	update_refresh_speed();
 
@@ -171,6 +217,10 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// publish frames and sound to other processes if requested
+	if (*machine.options().shm_export())
+		m_shm_export = shared_memory_export::create(machine, machine.options().shm_export(), machine.options().shm_export_slots(), machine.options().shm_export_mem(), machine.options().shm_step());
+
 	// if no screens, create a periodic timer to drive updates
 	if (no_screens)
 	{
@@ -212,19 +262,44 @@ void video_manager::set_frameskip(int frameskip)
 
 void video_manager::frame_update(bool from_debugger)
 {
+	// speculative run-ahead frames only get shown if they're the last one
+	if (m_runahead_frames && !from_debugger)
+	{
+		if (!--m_runahead_frames && !m_resimulating)
+		{
+			finish_screen_updates();
+			auto profile = g_profiler.start(PROFILER_BLIT);
+			machine().osd().update(false);
+		}
+
+		// only the frame that gets shown needs drawing
+		m_skipping_this_frame = m_resimulating || (m_runahead_frames > 1);
+		return;
+	}
+
 	// only render sound and video if we're in the running phase
 	machine_phase const phase = machine().phase();
 	bool skipped_it = m_skipping_this_frame;
+
+	// when running ahead, this frame is only committed, a later speculative one is displayed
+	bool const runahead = m_runahead && !from_debugger && (phase == machine_phase::RUNNING) && !machine().paused() && !is_recording() && !m_shm_export && machine().scheduler().can_save();
 	bool const update_screens = (phase == machine_phase::RUNNING) && (!machine().paused() || machine().options().update_in_pause());
 	bool anything_changed = update_screens && finish_screen_updates();
 
 	// update inputs and draw the user interface
-	machine().osd().input_update(true);
-	anything_changed = emulator_info::draw_user_interface(machine()) || anything_changed;
+	if (!m_headless)
+	{
+		machine().osd().input_update(true);
+		anything_changed = emulator_info::draw_user_interface(machine()) || anything_changed;
+	}
 
 	// let plugins draw over the UI
 	anything_changed = emulator_info::frame_hook() || anything_changed;
 
+	// fast-forward for as long as an image device keeps reporting that it's loading
+	if (m_loading_fastforward && !from_debugger)
+		update_loading();
+
 	// if none of the screens changed and we haven't skipped too many frames in a row,
 	// mark this frame as skipped to prevent throttling; this helps for games that
 	// don't update their screen at the monitor refresh rate
@@ -235,24 +310,41 @@ void video_manager::frame_update(bool from_debugger)
 
 	// if we're throttling, synchronize before rendering
 	attotime current_time = machine().time();
-	if (!from_debugger && phase > machine_phase::INIT && !m_low_latency && effective_throttle())
+	bool const throttling = !from_debugger && phase > machine_phase::INIT && effective_throttle();
+	osd_ticks_t const emulation_ticks = osd_ticks() - m_frame_end_ticks;
+	if (throttling && !m_low_latency)
 		update_throttle(current_time);
 
-	// ask the OSD to update
+	// ask the OSD to update, timing it as a segment of its own
+	osd_ticks_t update_ticks = 0;
+	if (!m_headless)
 	{
 		auto profile = g_profiler.start(PROFILER_BLIT);
-		machine().osd().update(!from_debugger && skipped_it);
+		osd_ticks_t const update_start = osd_ticks();
+		machine().osd().update(!from_debugger && (skipped_it || runahead));
+		update_ticks = osd_ticks() - update_start;
 	}
 
+	// the frame's cost is the emulation since the last throttle plus this update
+	if (throttling)
+		record_frame_time(current_time, m_skipping_this_frame, emulation_ticks + update_ticks);
+
 	// we synchronize after rendering instead of before, if low latency mode is enabled
-	if (!from_debugger && phase > machine_phase::INIT && m_low_latency && effective_throttle())
+	if (throttling && m_low_latency)
 		update_throttle(current_time);
+	if (throttling)
+		m_frame_end_ticks = osd_ticks();
 
-	machine().osd().input_update(false);
+	if (!m_headless)
+		machine().osd().input_update(false);
 	emulator_info::periodic_check();
 
 	if (!from_debugger)
 	{
+		// take any snapshots requested for this frame
+		if (update_screens)
+			check_snap_frames();
+
 		// perform tasks for this frame
 		machine().call_notifiers(MACHINE_NOTIFY_FRAME);
 
@@ -265,6 +357,8 @@ void video_manager::frame_update(bool from_debugger)
 			recompute_speed(current_time);
 	}
 
+	m_runahead_pending = runahead;
+
 	// call the end-of-frame callback
 	if (phase == machine_phase::RUNNING)
 	{
@@ -293,6 +387,8 @@ std::string video_manager::speed_text()
 		str << "paused";
 
 	// if we're fast forwarding, just display Fast-forward
+	else if (m_loading && !m_fastforward)
+		str << "load ";
 	else if (m_fastforward)
 		str << "fast ";
 
@@ -319,6 +415,57 @@ std::string video_manager::speed_text()
 }
 
 
+//-------------------------------------------------
+//  begin_runahead - start emulating the
+//  speculative frames after a committed one
+//-------------------------------------------------
+
+void video_manager::begin_runahead()
+{
+	m_runahead_pending = false;
+	m_runahead_frames = m_runahead;
+	m_in_runahead = true;
+
+	// intermediate frames are never displayed, so don't draw them
+	m_runahead_skipping = m_skipping_this_frame;
+	m_skipping_this_frame = m_runahead_frames > 1;
+}
+
+
+//-------------------------------------------------
+//  begin_resimulation - start emulating one frame
+//  again after a netplay rollback; it has been
+//  displayed already, so it isn't drawn or shown
+//-------------------------------------------------
+
+void video_manager::begin_resimulation()
+{
+	if (!m_in_runahead)
+		m_runahead_skipping = m_skipping_this_frame;
+	m_runahead_pending = false;
+	m_runahead_frames = 1;
+	m_in_runahead = true;
+	m_resimulating = true;
+	m_skipping_this_frame = true;
+}
+
+
+//-------------------------------------------------
+//  end_runahead - stop running ahead and put back
+//  the committed frameskip state
+//-------------------------------------------------
+
+void video_manager::end_runahead()
+{
+	if (m_in_runahead)
+		m_skipping_this_frame = m_runahead_skipping;
+	m_runahead_pending = false;
+	m_runahead_frames = 0;
+	m_in_runahead = false;
+	m_resimulating = false;
+}
+
+
 //-------------------------------------------------
 //  save_snapshot - save a snapshot to the given
 //  file handle
@@ -342,12 +489,123 @@ void video_manager::save_snapshot(screen_device *screen, util::core_file &file)
 	// now do the actual work
 	const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
 	int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-	std::error_condition const error = util::png_write_bitmap(file, &pnginfo, m_snap_bitmap, entries, palette);
+	std::error_condition const error = util::png_write_bitmap(file, &pnginfo, m_snap_bitmap, entries, palette, machine().options().snap_compression());
 	if (error)
 		osd_printf_error("Error generating PNG for snapshot (%s:%d %s)\n", error.category().name(), error.value(), error.message());
 }
 
 
+//-------------------------------------------------
+//  save_snapshot - save a snapshot to the given
+//  file, taking ownership of it; with snapasync
+//  enabled the PNG is encoded on a worker thread
+//  and the file is closed once it's written
+//-------------------------------------------------
+
+void video_manager::save_snapshot(screen_device *screen, std::unique_ptr<emu_file> &&file)
+{
+	if (!machine().options().snap_async())
+	{
+		save_snapshot(screen, *file);
+		return;
+	}
+
+	// validate
+	assert(!m_snap_native || screen != nullptr);
+
+	// create the bitmap to pass in
+	create_snapshot_bitmap(screen);
+
+	// bound the amount of memory tied up in pending snapshots
+	if (m_snap_pending >= SNAP_MAX_PENDING)
+		wait_for_snapshots();
+
+	// grab a job from the pool, or make a new one
+	std::unique_ptr<snapshot_job> job;
+	{
+		std::lock_guard<std::mutex> lock(m_snap_jobs_mutex);
+		if (!m_snap_jobs.empty())
+		{
+			job = std::move(m_snap_jobs.back());
+			m_snap_jobs.pop_back();
+		}
+	}
+	if (!job)
+		job = std::make_unique<snapshot_job>();
+
+	// copy everything the worker needs, reusing the pooled bitmap where possible
+	job->owner = this;
+	job->file = std::move(file);
+	if (job->bitmap.width() != m_snap_bitmap.width() || job->bitmap.height() != m_snap_bitmap.height())
+		job->bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+	for (int y = 0; y < m_snap_bitmap.height(); y++)
+		std::copy_n(&m_snap_bitmap.pix(y), m_snap_bitmap.width(), &job->bitmap.pix(y));
+	if (screen != nullptr && screen->has_palette())
+	{
+		rgb_t const *const palette = screen->palette().palette()->entry_list_adjusted();
+		job->palette.assign(palette, palette + screen->palette().entries());
+	}
+	else
+	{
+		job->palette.clear();
+	}
+	job->software = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+	job->system = std::string(machine().system().manufacturer).append(" ").append(machine().system().type.fullname());
+	job->compression = machine().options().snap_compression();
+
+	// hand it off
+	if (!m_snap_png_queue)
+		m_snap_png_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	m_snap_pending++;
+	osd_work_item_queue(m_snap_png_queue, &video_manager::snapshot_encode_callback, job.release(), WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  snapshot_encode_callback - encode and write
+//  a queued snapshot, then return its buffers to
+//  the pool
+//-------------------------------------------------
+
+void *video_manager::snapshot_encode_callback(void *param, int threadid)
+{
+	std::unique_ptr<snapshot_job> job(reinterpret_cast<snapshot_job *>(param));
+	video_manager &owner = *job->owner;
+
+	util::png_info pnginfo;
+	pnginfo.add_text("Software", job->software);
+	pnginfo.add_text("System", job->system);
+	int const entries = job->palette.size();
+	std::error_condition const error = util::png_write_bitmap(*job->file, &pnginfo, job->bitmap, entries, entries ? &job->palette[0] : nullptr, job->compression);
+	if (error)
+		owner.m_snap_failures++;
+	job->file.reset();
+
+	{
+		std::lock_guard<std::mutex> lock(owner.m_snap_jobs_mutex);
+		owner.m_snap_jobs.push_back(std::move(job));
+	}
+	owner.m_snap_pending--;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  wait_for_snapshots - wait for any snapshots
+//  being encoded to finish and report failures
+//-------------------------------------------------
+
+void video_manager::wait_for_snapshots()
+{
+	if (m_snap_png_queue)
+		while (!osd_work_queue_wait(m_snap_png_queue, osd_ticks_per_second())) { }
+
+	int const failures = m_snap_failures.exchange(0);
+	if (failures)
+		osd_printf_error("Error generating PNG for %d snapshot(s)\n", failures);
+}
+
+
 //-------------------------------------------------
 //  save_active_screen_snapshots - save a
 //  snapshot of all active screens
@@ -361,19 +619,35 @@ void video_manager::save_active_screen_snapshots()
 		for (screen_device &screen : screen_device_enumerator(machine().root_device()))
 			if (machine().render().is_live(screen))
 			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				std::error_condition const filerr = open_next(file, "png");
+				auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+				std::error_condition const filerr = open_next(*file, "png");
 				if (!filerr)
-					save_snapshot(&screen, file);
+					save_snapshot(&screen, std::move(file));
 			}
 	}
 	else
 	{
 		// otherwise, just write a single snapshot
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		std::error_condition const filerr = open_next(file, "png");
+		auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		std::error_condition const filerr = open_next(*file, "png");
 		if (!filerr)
-			save_snapshot(nullptr, file);
+			save_snapshot(nullptr, std::move(file));
+	}
+}
+
+
+//-------------------------------------------------
+//  check_snap_frames - count a completed frame
+//  and save snapshots if it was requested
+//-------------------------------------------------
+
+void video_manager::check_snap_frames()
+{
+	u64 const frame = m_frame_number++;
+	if ((m_snap_frames.size() > m_snap_frame_next) && (m_snap_frames[m_snap_frame_next] == frame))
+	{
+		++m_snap_frame_next;
+		save_active_screen_snapshots();
 	}
 }
 
@@ -486,6 +760,8 @@ void video_manager::add_sound_to_recording(const s16 *sound, int numsamples)
 {
 	for (auto &recording : m_movie_recordings)
 		recording->add_sound_to_recording(sound, numsamples);
+	if (m_shm_export)
+		m_shm_export->add_sound(sound, numsamples);
 }
 
 
@@ -497,16 +773,28 @@ void video_manager::exit()
 {
 	// stop recording any movie
 	m_movie_recordings.clear();
+	m_shm_export.reset();
 
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
+	wait_for_snapshots();
+	if (m_snap_png_queue)
+	{
+		osd_work_queue_free(m_snap_png_queue);
+		m_snap_png_queue = nullptr;
+	}
+	m_snap_jobs.clear();
+	if (m_snap_queue)
+	{
+		osd_work_queue_free(m_snap_queue);
+		m_snap_queue = nullptr;
+	}
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (!emulator_info::standalone() && m_overall_emutime.seconds() >= 1)
 	{
-		osd_ticks_t tps = osd_ticks_per_second();
-		double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
+		double final_real_time = overall_real_time();
 		double final_emu_time = m_overall_emutime.as_double();
 		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds());
 	}
@@ -536,9 +824,42 @@ void video_manager::postload()
 	for (const auto &x : m_movie_recordings)
 		x->set_next_frame_time(emutime);
 
-	// reset speed measurements
-	m_speed_last_realtime = osd_ticks();
-	m_speed_last_emutime = emutime;
+	// reset speed measurements, unless this is just run-ahead rolling back
+	if (!m_in_runahead)
+	{
+		m_speed_last_realtime = osd_ticks();
+		m_speed_last_emutime = emutime;
+		m_loading_until = attotime::zero;
+	}
+}
+
+
+//-------------------------------------------------
+//  report_loading_activity - note that an image
+//  device is busy loading
+//-------------------------------------------------
+
+void video_manager::report_loading_activity()
+{
+	// long enough to bridge a floppy seek or the gap between tape blocks
+	if (m_loading_fastforward)
+		m_loading_until = machine().time() + attotime::from_msec(1000);
+}
+
+
+//-------------------------------------------------
+//  update_loading - start or stop fast-forwarding
+//  as loading activity comes and goes
+//-------------------------------------------------
+
+void video_manager::update_loading()
+{
+	bool const loading = !machine().paused() && (machine().time() < m_loading_until);
+	if (loading != m_loading)
+	{
+		m_loading = loading;
+		machine().sound().fastforward_mute(loading);
+	}
 }
 
 
@@ -551,7 +872,7 @@ void video_manager::postload()
 inline bool video_manager::effective_autoframeskip() const
 {
 	// if we're fast forwarding or paused, autoframeskip is disabled
-	if (m_fastforward || machine().paused())
+	if (fastforward() || machine().paused())
 		return false;
 
 	// otherwise, it's up to the user
@@ -568,7 +889,7 @@ inline bool video_manager::effective_autoframeskip() const
 int video_manager::effective_frameskip() const
 {
 	// if we're fast forwarding, use the maximum frameskip
-	if (m_fastforward)
+	if (fastforward())
 		return FRAMESKIP_LEVELS - 1;
 
 	// otherwise, it's up to the user
@@ -589,7 +910,7 @@ inline bool video_manager::effective_throttle() const
 		return true;
 
 	// if we're fast forwarding, we don't throttle
-	if (m_fastforward)
+	if (fastforward())
 		return false;
 
 	// otherwise, it's up to the user
@@ -818,10 +1139,13 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 		else
 			delta = 0;
 
-		// see if we can sleep
+		// see if we can sleep; if we're only waiting out the expected oversleep, at
+		// least give up the rest of our time slice rather than spinning flat out
 		bool const slept = allowed_to_sleep && delta;
 		if (slept)
 			osd_sleep(delta);
+		else if (allowed_to_sleep)
+			std::this_thread::yield();
 
 		// read the new value
 		osd_ticks_t const new_ticks = osd_ticks();
@@ -829,17 +1153,16 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 		// keep some metrics on the sleeping patterns of the OSD layer
 		if (slept)
 		{
-			// if we overslept, keep an average of the amount
+			// keep an average of the amount we overslept; accurate sleeps count as
+			// zero so the estimate (and the time spent spinning) can shrink again
 			osd_ticks_t const actual_ticks = new_ticks - current_ticks;
-			if (actual_ticks > delta)
-			{
-				// take 99% of the previous average plus 1% of the new value
-				osd_ticks_t const oversleep_milliticks = 1000 * (actual_ticks - delta);
-				m_average_oversleep = (m_average_oversleep * 99 + oversleep_milliticks) / 100;
+			osd_ticks_t const oversleep_milliticks = (actual_ticks > delta) ? (1000 * (actual_ticks - delta)) : 0;
 
-				if (LOG_THROTTLE)
-					machine().logerror("Slept for %d ticks, got %d ticks, avgover = %d\n", (int)delta, (int)actual_ticks, (int)m_average_oversleep);
-			}
+			// take 99% of the previous average plus 1% of the new value
+			m_average_oversleep = (m_average_oversleep * 99 + oversleep_milliticks) / 100;
+
+			if (LOG_THROTTLE && (actual_ticks > delta))
+				machine().logerror("Slept for %d ticks, got %d ticks, avgover = %d\n", (int)delta, (int)actual_ticks, (int)m_average_oversleep);
 		}
 		current_ticks = new_ticks;
 	}
@@ -858,36 +1181,44 @@ void video_manager::update_frameskip()
 	// if we're throttling and autoframeskip is on, adjust
 	if (effective_throttle() && effective_autoframeskip() && m_frameskip_counter == 0)
 	{
-		// calibrate the "adjusted speed" based on the target
-		double adjusted_speed_percent = m_speed_percent / double(m_throttle_rate);
+		// predict the cost of a drawn and a skipped frame from the slow end of
+		// their recent histories, as a fraction of the frame period
+		double const drawn = frame_time_percentile(false, 90);
+		double const skipped = frame_time_percentile(true, 90);
+		int const max_level = m_frameskip_max ? m_frameskip_max : MAX_FRAMESKIP;
+
+		// find the fewest skipped frames out of FRAMESKIP_LEVELS that keeps the average within budget
+		int target_level = 0;
+		if (drawn > 1.0)
+		{
+			if (skipped >= 1.0)
+				target_level = max_level;
+			else
+				target_level = std::min<int>(std::ceil(double(FRAMESKIP_LEVELS) * (drawn - 1.0) / (drawn - std::max(skipped, 0.0))), max_level);
+		}
 
-		double speed = m_speed * 0.001;
-		if (adjusted_speed_percent >= 0.995 * speed)
+		if (target_level > m_frameskip_level)
 		{
-			// if we're too fast, attempt to decrease the frameskip
-			// but only after 3 consecutive frames where we are too fast
+			// a missed deadline is visible, so skip more straight away
+			if (LOG_THROTTLE)
+				machine().logerror("Frameskip %d -> %d (drawn %.2f, skipped %.2f)\n", m_frameskip_level, target_level, drawn, skipped);
+			m_frameskip_level = target_level;
+			m_frameskip_adjust = 0;
+		}
+		else if (target_level < m_frameskip_level)
+		{
+			// but only draw more after 3 consecutive periods where we would have been fast enough
 			if (++m_frameskip_adjust >= 3)
 			{
+				if (LOG_THROTTLE)
+					machine().logerror("Frameskip %d -> %d (drawn %.2f, skipped %.2f)\n", m_frameskip_level, m_frameskip_level - 1, drawn, skipped);
 				m_frameskip_adjust = 0;
-				if (m_frameskip_level > 0)
-					m_frameskip_level--;
+				m_frameskip_level--;
 			}
 		}
 		else
 		{
-			// if we're too slow, attempt to increase the frameskip
-			if (adjusted_speed_percent < 0.80 *  speed) // if below 80% speed, be more aggressive
-				m_frameskip_adjust -= (0.90 * speed - m_speed_percent) / 0.05;
-			else if (m_frameskip_level < 8) // if we're close, only force it up to frameskip 8
-				m_frameskip_adjust--;
-
-			// perform the adjustment
-			while (m_frameskip_adjust <= -2)
-			{
-				m_frameskip_adjust += 2;
-				if (m_frameskip_level < (m_frameskip_max ? m_frameskip_max : MAX_FRAMESKIP))
-					m_frameskip_level++;
-			}
+			m_frameskip_adjust = 0;
 		}
 	}
 
@@ -897,6 +1228,67 @@ void video_manager::update_frameskip()
 }
 
 
+//-------------------------------------------------
+//  record_frame_time - add the time spent on the
+//  frame about to be throttled to the histogram
+//  for drawn or skipped frames
+//-------------------------------------------------
+
+void video_manager::record_frame_time(const attotime &emutime, bool skipped, osd_ticks_t busy_ticks)
+{
+	attotime const frame_period = emutime - m_frame_end_emutime;
+	m_frame_end_emutime = emutime;
+
+	// ignore the first frame and anything that isn't a sensible frame period
+	if (m_frame_end_ticks == 0 || machine().paused() || frame_period.seconds() != 0 || frame_period.attoseconds() <= 0)
+		return;
+
+	// the budget is the real time the frame period should take at the target speed
+	double const budget_ticks = frame_period.as_double() * double(osd_ticks_per_second()) / (m_speed * 0.001 * m_throttle_rate);
+	double const busy = double(busy_ticks) / budget_ticks;
+	int const bucket = std::clamp<int>(int(busy * (FRAME_TIME_BUCKETS / 2)), 0, FRAME_TIME_BUCKETS - 1);
+
+	// age the history by halving it once it gets large enough
+	u32 (&hist)[FRAME_TIME_BUCKETS] = m_frame_time_hist[skipped ? 1 : 0];
+	u32 &total = m_frame_time_total[skipped ? 1 : 0];
+	hist[bucket] += 16;
+	total += 16;
+	if (total >= 1024)
+	{
+		total = 0;
+		for (u32 &count : hist)
+			total += (count /= 2);
+	}
+}
+
+
+//-------------------------------------------------
+//  frame_time_percentile - return the busy time
+//  under which the given percentage of recent
+//  frames fell, as a fraction of the frame period
+//-------------------------------------------------
+
+double video_manager::frame_time_percentile(bool skipped, u32 percent) const
+{
+	u32 const (&hist)[FRAME_TIME_BUCKETS] = m_frame_time_hist[skipped ? 1 : 0];
+	u32 const total = m_frame_time_total[skipped ? 1 : 0];
+
+	// no history yet
+	if (total == 0)
+		return 0.0;
+
+	u32 const threshold = (total * percent + 99) / 100;
+	u32 sum = 0;
+	for (int bucket = 0; bucket < FRAME_TIME_BUCKETS; bucket++)
+	{
+		sum += hist[bucket];
+		if (sum >= threshold)
+			return double(bucket + 1) / double(FRAME_TIME_BUCKETS / 2);
+	}
+	return double(FRAME_TIME_BUCKETS) / double(FRAME_TIME_BUCKETS / 2);
+}
+
+
 //-------------------------------------------------
 //  update_refresh_speed - update the m_speed
 //  based on the maximum refresh rate supported
@@ -968,7 +1360,7 @@ void video_manager::recompute_speed(const attotime &emutime)
 		m_speed_last_emutime = emutime;
 
 		// if we're throttled, this time period counts for overall speed; otherwise, we reset the counter
-		if (!m_fastforward)
+		if (!fastforward())
 			m_overall_valid_counter++;
 		else
 			m_overall_valid_counter = 0;
@@ -1042,13 +1434,15 @@ void video_manager::create_snapshot_bitmap(screen_device *screen)
 	if (width != m_snap_bitmap.width() || height != m_snap_bitmap.height())
 		m_snap_bitmap.resize(width, height);
 
-	// render the screen there
+	// render the screen there, splitting the work into bands across worker threads
+	if (!m_snap_queue)
+		m_snap_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
 	if (machine().options().snap_bilinear())
-		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue);
 	else
-		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue);
 	primlist.release_lock();
 }
 
@@ -1229,13 +1623,16 @@ std::error_condition video_manager::open_next(emu_file &file, const char *extens
 void video_manager::record_frame()
 {
 	// ignore if nothing to do
-	if (!is_recording())
+	if (!is_recording() && !m_shm_export)
 		return;
 
 	// start the profiler and get the current time
 	auto profile = g_profiler.start(PROFILER_MOVIE_REC);
 	attotime curtime = machine().time();
 
+	if (m_shm_export)
+		m_shm_export->add_frame(curtime);
+
 	bool error = false;
 	for (auto &recording : m_movie_recordings)
 	{
@@ -18,8 +18,12 @@
 #define MAME_EMU_VIDEO_H
 
 #include "recording.h"
+#include "shmexport.h"
 
+#include <atomic>
+#include <mutex>
 #include <system_error>
+#include <vector>
 
 
 //**************************************************************************
@@ -52,7 +56,7 @@ public:
 	int frameskip() const { return m_auto_frameskip ? -1 : m_frameskip_level; }
 	bool throttled() const { return m_throttled; }
 	float throttle_rate() const { return m_throttle_rate; }
-	bool fastforward() const { return m_fastforward; }
+	bool fastforward() const { return m_fastforward || m_loading; }
 
 	// setters
 	void set_frameskip(int frameskip);
@@ -61,6 +65,10 @@ public:
 	void set_fastforward(bool ffwd) { m_fastforward = ffwd; }
 	void set_output_changed() { m_output_changed = true; }
 
+	// called by image devices while they're loading (tape playing, floppy motor
+	// running or head stepping, CD reading) to fast-forward through it
+	void report_loading_activity();
+
 	// misc
 	void toggle_record_movie(movie_recording::format format);
 	std::error_condition open_next(emu_file &file, const char *extension, uint32_t index = 0);
@@ -70,15 +78,25 @@ public:
 	// render a frame
 	void frame_update(bool from_debugger = false);
 
+	// run-ahead: after a committed frame, emulate ahead and show the last speculative frame
+	bool runahead_pending() const { return m_runahead_pending; }
+	bool runahead_active() const { return m_runahead_frames != 0; }
+	void begin_runahead();
+	void end_runahead();
+	void begin_resimulation();
+
 	// current speed helpers
 	std::string speed_text();
 	double speed_percent() const { return m_speed_percent; }
+	attotime overall_emulated_time() const { return m_overall_emutime; }
+	double overall_real_time() const { return double(m_overall_real_seconds) + (double(m_overall_real_ticks) / double(osd_ticks_per_second())); }
 	int effective_frameskip() const;
 
 	// snapshots
 	bool snap_native() const { return m_snap_native; }
 	render_target &snapshot_target() { return *m_snap_target; }
 	void save_snapshot(screen_device *screen, util::core_file &file);
+	void save_snapshot(screen_device *screen, std::unique_ptr<emu_file> &&file);
 	void save_active_screen_snapshots();
 
 	// movies
@@ -103,12 +121,18 @@ private:
 	void update_throttle(attotime emutime);
 	osd_ticks_t throttle_until_ticks(osd_ticks_t target_ticks);
 	void update_frameskip();
+	void update_loading();
+	void record_frame_time(const attotime &emutime, bool skipped, osd_ticks_t busy_ticks);
+	double frame_time_percentile(bool skipped, u32 percent) const;
 	void update_refresh_speed();
 	void recompute_speed(const attotime &emutime);
 
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
+	void wait_for_snapshots();
+	static void *snapshot_encode_callback(void *param, int threadid);
 	void record_frame();
+	void check_snap_frames();
 
 	// movies
 	void begin_recording_screen(const std::string &filename, uint32_t index, screen_device *screen, movie_recording::format format);
@@ -141,10 +165,27 @@ private:
 	bool                m_throttled;                // flag: true if we're currently throttled
 	float               m_throttle_rate;            // target rate for throttling
 	bool                m_fastforward;              // flag: true if we're currently fast-forwarding
+	bool                m_loading_fastforward;      // flag: true if loading activity fast-forwards
+	bool                m_loading;                  // flag: true if fast-forwarding through loading
+	attotime            m_loading_until;            // emulated time loading activity was last reported for
 	u32                 m_seconds_to_run;           // number of seconds to run before quitting
 	bool                m_auto_frameskip;           // flag: true if we're automatically frameskipping
 	u32                 m_speed;                    // overall speed (*1000)
 	bool                m_low_latency;              // flag: true if we are throttling after blitting
+	bool                m_headless;                 // flag: true if we skip input polling, UI and OSD updates
+
+	// frame-triggered snapshots
+	u64                 m_frame_number;             // number of frames completed while running
+	std::vector<u64>    m_snap_frames;              // frames to snapshot, sorted
+	std::size_t         m_snap_frame_next;          // index of the next frame to snapshot
+
+	// run-ahead
+	u8                  m_runahead;                 // number of frames to emulate ahead
+	u8                  m_runahead_frames;          // speculative frames still to emulate
+	bool                m_runahead_pending;         // committed frame wants a run-ahead pass
+	bool                m_in_runahead;              // between begin_runahead and end_runahead
+	bool                m_runahead_skipping;        // committed frameskip state to restore after running ahead
+	bool                m_resimulating;             // re-emulating a frame that was already displayed
 
 	// frameskipping
 	u8                  m_empty_skip_count;         // number of empty frames we have skipped
@@ -155,15 +196,42 @@ private:
 	bool                m_skipping_this_frame;      // flag: true if we are skipping the current frame
 	osd_ticks_t         m_average_oversleep;        // average number of ticks the OSD oversleeps
 
+	// per-frame timing for autoframeskip
+	static constexpr int FRAME_TIME_BUCKETS = 32;   // histogram covers up to two frame periods
+	osd_ticks_t         m_frame_end_ticks;          // osd_ticks when the last frame was throttled
+	attotime            m_frame_end_emutime;        // emulated time when the last frame was throttled
+	u32                 m_frame_time_hist[2][FRAME_TIME_BUCKETS]; // decaying histograms of busy time per frame (drawn, skipped)
+	u32                 m_frame_time_total[2];      // sum of each histogram
+
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	s32                 m_snap_width;               // width of snapshots (0 == auto)
 	s32                 m_snap_height;              // height of snapshots (0 == auto)
+	osd_work_queue *    m_snap_queue;               // work queue for banded snapshot rendering
+
+	// asynchronous snapshot encoding
+	struct snapshot_job
+	{
+		video_manager *             owner;          // manager to return the job to
+		std::unique_ptr<emu_file>   file;           // destination, closed once written
+		bitmap_rgb32                bitmap;         // private copy of the snapshot
+		std::vector<rgb_t>          palette;        // private copy of the palette
+		std::string                 software;       // "Software" text entry
+		std::string                 system;         // "System" text entry
+		int                         compression;    // zlib compression level
+	};
+	static constexpr int SNAP_MAX_PENDING = 8;      // snapshots in flight before we wait
+	osd_work_queue *    m_snap_png_queue;           // work queue for PNG encoding
+	std::mutex          m_snap_jobs_mutex;          // protects m_snap_jobs
+	std::vector<std::unique_ptr<snapshot_job> > m_snap_jobs; // pool of idle jobs and their buffers
+	std::atomic<int>    m_snap_pending;             // number of snapshots being encoded
+	std::atomic<int>    m_snap_failures;            // number of snapshots that failed to encode
 
 	// movie recordings
 	std::vector<movie_recording::ptr> m_movie_recordings;
+	shared_memory_export::ptr m_shm_export;         // frames and sound published to other processes
 
 	static const bool   s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
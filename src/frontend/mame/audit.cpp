@@ -203,7 +203,24 @@ public:
 media_auditor::media_auditor(const driver_enumerator &enumerator)
 	: m_enumerator(enumerator)
 	, m_validation(AUDIT_VALIDATE_FULL)
+	, m_hash_cache(enumerator.options().hash_cache() ? &file_hash_cache::get(enumerator.options().cfg_directory()) : nullptr)
+	, m_path_cache(enumerator.options().path_cache() ? &path_listing_cache::get() : nullptr)
 {
+	// files may have been added or removed since the listings were last used
+	if (m_path_cache)
+		m_path_cache->revalidate();
+}
+
+
+//-------------------------------------------------
+//  ~media_auditor - destructor
+//-------------------------------------------------
+
+media_auditor::~media_auditor()
+{
+	// save checksums computed along the way
+	if (m_hash_cache)
+		m_hash_cache->flush();
 }
 
 
@@ -624,6 +641,8 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const std::vector<std:
 	// find the file and checksum it, getting the file length along the way
 	emu_file file(m_enumerator.options().media_path(), searchpath, OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD);
 	file.set_restrict_to_mediapath(1);
+	file.set_hash_cache(m_hash_cache);
+	file.set_path_cache(m_path_cache);
 
 	// open the file if we can
 	std::error_condition filerr;
@@ -35,6 +35,8 @@
 
 // forward declarations
 class driver_enumerator;
+class file_hash_cache;
+class path_listing_cache;
 class software_list_device;
 
 
@@ -149,6 +151,7 @@ public:
 
 	// construction/destruction
 	media_auditor(const driver_enumerator &enumerator);
+	~media_auditor();
 
 	// getters
 	const record_list &records() const { return m_record_list; }
@@ -171,6 +174,8 @@ private:
 	record_list                 m_record_list;
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
+	file_hash_cache *           m_hash_cache;
+	path_listing_cache *        m_path_cache;
 };
 
 
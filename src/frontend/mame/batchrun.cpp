@@ -0,0 +1,76 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    batchrun.cpp
+
+    Batch job lists for running many systems in one process.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "batchrun.h"
+
+#include "corefile.h"
+#include "corestr.h"
+
+#include <cctype>
+#include <cstdlib>
+
+
+//-------------------------------------------------
+//  load_batch_jobs - read a batch file, adding
+//  a job for each line
+//-------------------------------------------------
+
+bool load_batch_jobs(std::string_view filename, std::vector<batch_job> &jobs, std::ostream &errors)
+{
+	std::vector<u8> data;
+	if (util::core_file::load(filename, data))
+		return false;
+
+	std::string_view text(reinterpret_cast<char const *>(data.data()), data.size());
+	unsigned line = 0;
+	while (!text.empty())
+	{
+		// split off the next line
+		std::string_view::size_type const eol = text.find('\n');
+		std::string_view current = strtrimspace(text.substr(0, eol));
+		text = (std::string_view::npos == eol) ? std::string_view() : text.substr(eol + 1);
+		++line;
+		if (current.empty() || (current[0] == '#'))
+			continue;
+
+		// break it into arguments, allowing double quotes around spaces
+		std::vector<std::string> arguments;
+		while (!current.empty())
+		{
+			std::string argument;
+			bool quoted = false;
+			std::string_view::size_type pos = 0;
+			for ( ; (pos < current.length()) && (quoted || !std::isspace(u8(current[pos]))); ++pos)
+			{
+				if (current[pos] == '"')
+					quoted = !quoted;
+				else
+					argument.push_back(current[pos]);
+			}
+			arguments.emplace_back(std::move(argument));
+			current = strtrimspace(current.substr(pos));
+		}
+
+		// the system comes first, optionally followed by the number of frames to run
+		batch_job &job(jobs.emplace_back(batch_job{ line, std::move(arguments[0]), 0, { } }));
+		auto argument = arguments.begin() + 1;
+		if ((arguments.end() != argument) && !argument->empty() && std::isdigit(u8((*argument)[0])))
+		{
+			char *end;
+			job.stop_frame = std::strtoull(argument->c_str(), &end, 10);
+			if (*end)
+				util::stream_format(errors, "%s:%u: invalid stop frame %s\n", filename, line, *argument);
+			++argument;
+		}
+		job.arguments.insert(job.arguments.end(), std::make_move_iterator(argument), std::make_move_iterator(arguments.end()));
+	}
+	return true;
+}
@@ -0,0 +1,40 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    batchrun.h
+
+    Batch job lists for running many systems in one process.
+
+***************************************************************************/
+#ifndef MAME_FRONTEND_BATCHRUN_H
+#define MAME_FRONTEND_BATCHRUN_H
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// batch_job is a single line of a batch file: a system, the number of
+// frames to run it for, and any options to apply on top of the command line
+struct batch_job
+{
+	unsigned                    line;           // line number in the batch file
+	std::string                 system;         // short name of the system to run
+	u64                         stop_frame;     // frames to run before exiting (0 = run until the system exits)
+	std::vector<std::string>    arguments;      // extra command line arguments
+};
+
+
+// batch file lines look like
+//
+//     <system> [<stopframe>] [<option> ...]
+//
+// blank lines and lines starting with '#' are ignored, and arguments may be
+// enclosed in double quotes; returns false if the file can't be read
+bool load_batch_jobs(std::string_view filename, std::vector<batch_job> &jobs, std::ostream &errors);
+
+#endif // MAME_FRONTEND_BATCHRUN_H
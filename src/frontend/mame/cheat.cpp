@@ -348,6 +348,23 @@ cheat_script::cheat_script(
 }
 
 
+//-------------------------------------------------
+//  plain_actions - collect the expressions if
+//  every entry is an unconditional action
+//-------------------------------------------------
+
+bool cheat_script::plain_actions(std::vector<parsed_expression const *> &actions) const
+{
+	for (auto const &entry : m_entrylist)
+	{
+		if (!entry->is_plain_action())
+			return false;
+		actions.push_back(&entry->expression());
+	}
+	return !actions.empty();
+}
+
+
 //-------------------------------------------------
 //  execute - execute ourself
 //-------------------------------------------------
@@ -687,6 +704,10 @@ cheat_entry::cheat_entry(cheat_manager &manager, symbol_table &globaltable, std:
 	, m_state(SCRIPT_STATE_OFF)
 	, m_numtemp(DEFAULT_TEMP_VARIABLES)
 	, m_argindex(0)
+	, m_taps_tried(false)
+	, m_written(true)
+	, m_applying(false)
+	, m_refresh(0)
 {
 	// pull the variable count out ahead of things
 	int const tempcount(cheatnode.get_attribute_int("tempvariables", DEFAULT_TEMP_VARIABLES));
@@ -756,6 +777,7 @@ cheat_entry::cheat_entry(cheat_manager &manager, symbol_table &globaltable, std:
 
 cheat_entry::~cheat_entry()
 {
+	remove_taps();
 }
 
 
@@ -887,6 +909,7 @@ bool cheat_entry::select_previous_state()
 			changed = m_parameter->set_prev_state();
 			if (changed)
 			{
+				m_written = true;
 				set_state(SCRIPT_STATE_RUN);
 				if (!is_oneshot_parameter())
 					execute_change_script();
@@ -929,6 +952,8 @@ bool cheat_entry::select_next_state()
 		{
 			// otherwise, switch to the next state
 			changed = m_parameter->set_next_state();
+			if (changed)
+				m_written = true;
 		}
 
 		// if we changed, signal a state change
@@ -1003,6 +1028,11 @@ bool cheat_entry::set_state(script_state newstate)
 	if (m_state == newstate)
 		return false;
 
+	// taps only stand in for running the run script every frame
+	if (m_state == SCRIPT_STATE_RUN)
+		remove_taps();
+	m_written = true;
+
 	// change to the state and run the appropriate script
 	m_state = newstate;
 	if (newstate == SCRIPT_STATE_OFF)
@@ -1014,6 +1044,120 @@ bool cheat_entry::set_state(script_state newstate)
 }
 
 
+//-------------------------------------------------
+//  frame_update - run the run script, or only
+//  when the taps saw its stores overwritten
+//-------------------------------------------------
+
+void cheat_entry::frame_update()
+{
+	if ((m_state != SCRIPT_STATE_RUN) || !has_run_script())
+		return;
+
+	if (!m_taps_tried && m_manager.machine().options().cheat_taps())
+		install_taps();
+
+	if (m_taps.empty())
+	{
+		execute_run_script();
+	}
+	else if (!m_manager.enabled())
+	{
+		// apply the stores as soon as cheats are turned back on
+		m_written = true;
+	}
+	else if (m_written || !--m_refresh)
+	{
+		m_written = false;
+		m_refresh = REFRESH_FRAMES;
+		m_applying = true;
+		execute_run_script();
+		m_applying = false;
+	}
+}
+
+
+//-------------------------------------------------
+//  install_taps - if every run script action
+//  stores to a fixed address, watch for writes
+//  there instead of storing every frame
+//-------------------------------------------------
+
+void cheat_entry::install_taps()
+{
+	m_taps_tried = true;
+
+	std::vector<parsed_expression const *> actions;
+	if (!m_run_script->plain_actions(actions))
+		return;
+
+	// resolve every store first so the cheat is either tapped throughout or polled
+	struct tap_range { address_space *space; offs_t start, end; };
+	std::vector<tap_range> ranges;
+	for (parsed_expression const *action : actions)
+	{
+		char const *name;
+		expression_space spacenum;
+		u32 address;
+		int size;
+		if (!action->memory_store_target(name, spacenum, address, size))
+			return;
+
+		offs_t start = address;
+		address_space *const space = action->symbols().physical_space(name, spacenum, start);
+		if (!space)
+			return;
+		ranges.push_back(tap_range{ space, start, space->byte_to_address_end(space->address_to_byte(start) + size - 1) });
+	}
+
+	// the handlers keep pointers to their slots, so the vector mustn't grow after this
+	m_taps.resize(ranges.size());
+	auto tap = m_taps.begin();
+	for (tap_range const &range : ranges)
+	{
+		std::string const name = string_format("cheat %s", m_description);
+		switch (range.space->data_width())
+		{
+		case 8:
+			*tap = range.space->install_write_tap(range.start, range.end, name,
+					[this] (offs_t offset, u8 &data, u8 mem_mask) { if (!m_applying) m_written = true; },
+					&*tap);
+			break;
+		case 16:
+			*tap = range.space->install_write_tap(range.start, range.end, name,
+					[this] (offs_t offset, u16 &data, u16 mem_mask) { if (!m_applying) m_written = true; },
+					&*tap);
+			break;
+		case 32:
+			*tap = range.space->install_write_tap(range.start, range.end, name,
+					[this] (offs_t offset, u32 &data, u32 mem_mask) { if (!m_applying) m_written = true; },
+					&*tap);
+			break;
+		case 64:
+			*tap = range.space->install_write_tap(range.start, range.end, name,
+					[this] (offs_t offset, u64 &data, u64 mem_mask) { if (!m_applying) m_written = true; },
+					&*tap);
+			break;
+		}
+		++tap;
+	}
+	m_written = true;
+}
+
+
+//-------------------------------------------------
+//  remove_taps - go back to storing every frame
+//-------------------------------------------------
+
+void cheat_entry::remove_taps()
+{
+	for (memory_passthrough_handler &tap : m_taps)
+		tap.remove();
+	m_taps.clear();
+	m_taps_tried = false;
+}
+
+
 //-------------------------------------------------
 //  script_for_state - get a reference to the
 //  given script pointer
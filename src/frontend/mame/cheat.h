@@ -157,6 +157,7 @@ public:
 
 	// getters
 	script_state state() const { return m_state; }
+	bool plain_actions(std::vector<parsed_expression const *> &actions) const;
 
 	// actions
 	void execute(cheat_manager &manager, uint64_t &argindex);
@@ -175,6 +176,10 @@ private:
 				util::xml::data_node const &entrynode,
 				bool isaction);
 
+		// getters
+		bool is_plain_action() const { return m_condition.is_empty() && m_format.empty() && !m_expression.is_empty(); }
+		parsed_expression const &expression() const { return m_expression; }
+
 		// actions
 		void execute(cheat_manager &manager, uint64_t &argindex);
 		void save(util::core_file &cheatfile) const;
@@ -273,12 +278,14 @@ public:
 	void menu_text(std::string &description, std::string &state, uint32_t &flags);
 
 	// per-frame update
-	void frame_update() { if (m_state == SCRIPT_STATE_RUN) execute_run_script(); }
+	void frame_update();
 
 private:
 	// internal helpers
 	bool set_state(script_state newstate);
 	std::unique_ptr<cheat_script> &script_for_state(script_state state);
+	void install_taps();
+	void remove_taps();
 
 	// internal state
 	cheat_manager &                     m_manager;          // reference to our manager
@@ -293,9 +300,15 @@ private:
 	script_state                        m_state;            // current cheat state
 	uint32_t                            m_numtemp;          // number of temporary variables
 	uint64_t                            m_argindex;         // argument index variable
+	std::vector<memory_passthrough_handler> m_taps;         // write taps on the run script's stores
+	bool                                m_taps_tried;       // have taps been attempted since entering the run state?
+	bool                                m_written;          // stores may have been overwritten since last applied
+	bool                                m_applying;         // running the run script ourselves
+	uint32_t                            m_refresh;          // frames until the stores are applied regardless
 
 	// constants
 	static constexpr int DEFAULT_TEMP_VARIABLES = 10;
+	static constexpr uint32_t REFRESH_FRAMES = 30;      // catches writes the taps can't see (DMA, direct pointers, state loads)
 };
 
 
@@ -21,6 +21,7 @@
 #include "mameopts.h"
 #include "media_ident.h"
 #include "pluginopts.h"
+#include "sysmeta.h"
 
 #include "emuopts.h"
 #include "fileio.h"
@@ -38,6 +39,9 @@
 #include "osdepend.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <new>
 #include <set>
 #include <tuple>
@@ -82,6 +86,8 @@
 
 // command options
 #define CLIOPTION_DTD                   "dtd"
+#define CLIOPTION_XMLCACHE              "xmlcache"
+#define CLIOPTION_XMLSOURCEPATH         "xmlsourcepath"
 
 
 namespace {
@@ -128,11 +134,35 @@ const options_entry cli_option_entries[] =
 
 	{ nullptr,                              nullptr,   core_options::option_type::HEADER,     "FRONTEND COMMAND OPTIONS" },
 	{ CLIOPTION_DTD,                        "1",       core_options::option_type::BOOLEAN,    "include DTD in XML output" },
+	{ CLIOPTION_XMLCACHE,                   "",        core_options::option_type::PATH,       "file to keep -listxml machine entries in, so only those whose source files changed are regenerated" },
+	{ CLIOPTION_XMLSOURCEPATH,              ".",       core_options::option_type::PATH,       "directory containing the src tree that -xmlcache checks for changes" },
 	{ nullptr }
 };
 
 
-void print_summary(
+void set_archive_index(emu_options const &options)
+{
+	// keep the index alongside the other cached state in the first cfg directory
+	std::string directory;
+	if (options.archive_index() && path_iterator(options.cfg_directory()).next(directory))
+		util::archive_file::set_directory_index(util::path_concat(directory, "archidx.bin"));
+	else
+		util::archive_file::set_directory_index(std::string_view());
+}
+
+
+void set_system_cache(emu_options const &options)
+{
+	// the metadata store is still shared in memory when it isn't kept in a file
+	std::string directory;
+	if (options.system_cache() && path_iterator(options.cfg_directory()).next(directory))
+		system_metadata_store::instance().set_filename(util::path_concat(directory, "sysmeta.bin"));
+	else
+		system_metadata_store::instance().set_filename(std::string_view());
+}
+
+
+void summarize_set(
 		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
 		const char *type, const char *name, const char *parent,
 		unsigned &correct, unsigned &incorrect, unsigned &notfound,
@@ -146,38 +176,34 @@ void print_summary(
 	else if (record_none_needed || (summary != media_auditor::NONE_NEEDED))
 	{
 		// output the summary of the audit
-		buffer.clear();
-		buffer.seekp(0);
 		auditor.summarize(name, &buffer);
-		buffer.put('\0');
-		osd_printf_info("%s", &buffer.vec()[0]);
 
 		// output the name of the driver and its parent
-		osd_printf_info("%sset %s ", type, name);
+		util::stream_format(buffer, "%sset %s ", type, name);
 		if (parent)
-			osd_printf_info("[%s] ", parent);
+			util::stream_format(buffer, "[%s] ", parent);
 
 		// switch off of the result
 		switch (summary)
 		{
 		case media_auditor::INCORRECT:
-			osd_printf_info("is bad\n");
+			buffer << "is bad\n";
 			++incorrect;
 			return;
 
 		case media_auditor::CORRECT:
-			osd_printf_info("is good\n");
+			buffer << "is good\n";
 			++correct;
 			return;
 
 		case media_auditor::BEST_AVAILABLE:
 		case media_auditor::NONE_NEEDED:
-			osd_printf_info("is best available\n");
+			buffer << "is best available\n";
 			++correct;
 			return;
 
 		case media_auditor::NOTFOUND:
-			osd_printf_info("not found\n");
+			buffer << "not found\n";
 			return;
 		}
 		assert(false);
@@ -185,6 +211,120 @@ void print_summary(
 	}
 }
 
+
+void print_summary(
+		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
+		const char *type, const char *name, const char *parent,
+		unsigned &correct, unsigned &incorrect, unsigned &notfound,
+		util::ovectorstream &buffer)
+{
+	buffer.clear();
+	buffer.seekp(0);
+	summarize_set(auditor, summary, record_none_needed, type, name, parent, correct, incorrect, notfound, buffer);
+	buffer.put('\0');
+	osd_printf_info("%s", &buffer.vec()[0]);
+}
+
+
+// one system audited on the work queue; the report is kept so it can be
+// printed in driver order once all earlier systems have been retired
+struct audit_job
+{
+	using audit_func = std::function<media_auditor::summary (media_auditor &)>;
+
+	emu_options *options = nullptr;
+	audit_func const *audit = nullptr;
+	std::size_t driver = 0;
+	bool record_none_needed = false;
+	char const *type = nullptr;
+	std::string report;
+	unsigned correct = 0;
+	unsigned incorrect = 0;
+	unsigned notfound = 0;
+	std::exception_ptr error;
+	std::atomic<bool> done = false;
+};
+
+
+void *audit_job_callback(void *param, int threadid)
+{
+	audit_job &job(*reinterpret_cast<audit_job *>(param));
+	try
+	{
+		// driver_enumerator and media_auditor aren't thread-safe, so each job gets its own
+		driver_enumerator drivlist(*job.options);
+		drivlist.set_current(job.driver);
+		media_auditor auditor(drivlist);
+		media_auditor::summary const summary = (*job.audit)(auditor);
+
+		util::ovectorstream buffer;
+		auto const clone_of = drivlist.clone();
+		summarize_set(
+				auditor, summary, job.record_none_needed,
+				job.type, drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
+				job.correct, job.incorrect, job.notfound,
+				buffer);
+		job.report.assign(buffer.vec().data(), buffer.tellp());
+	}
+	catch (...)
+	{
+		job.error = std::current_exception();
+	}
+	job.done.store(true, std::memory_order_release);
+	return nullptr;
+}
+
+
+void audit_systems(
+		emu_options &options, std::vector<std::size_t> const &drivers,
+		audit_job::audit_func const &audit, bool record_none_needed, const char *type,
+		unsigned &correct, unsigned &incorrect, unsigned &notfound)
+{
+	std::vector<audit_job> jobs(drivers.size());
+	for (std::size_t i = 0; drivers.size() > i; ++i)
+	{
+		jobs[i].options = &options;
+		jobs[i].audit = &audit;
+		jobs[i].driver = drivers[i];
+		jobs[i].record_none_needed = record_none_needed;
+		jobs[i].type = type;
+	}
+
+	// audit on the work queue if there's more than one system, otherwise inline
+	osd_work_queue *queue = (1U < jobs.size()) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	if (queue && !osd_work_item_queue_multiple(queue, &audit_job_callback, jobs.size(), jobs.data(), sizeof(jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE))
+	{
+		osd_work_queue_free(queue);
+		queue = nullptr;
+	}
+
+	// print the reports in driver order so the output matches a sequential run
+	for (audit_job &job : jobs)
+	{
+		if (!queue)
+			audit_job_callback(&job, 0);
+		else
+			while (!job.done.load(std::memory_order_acquire))
+				osd_work_queue_wait(queue, osd_ticks_per_second() / 100);
+
+		if (job.error)
+		{
+			if (queue)
+				osd_work_queue_free(queue);
+			std::rethrow_exception(job.error);
+		}
+
+		osd_printf_info("%s", job.report);
+		std::string().swap(job.report);
+		correct += job.correct;
+		incorrect += job.incorrect;
+		notfound += job.notfound;
+	}
+
+	if (queue)
+		osd_work_queue_free(queue);
+}
+
 } // anonymous namespace
 
 
@@ -257,13 +397,22 @@ void cli_frontend::start_execution(mame_machine_manager *manager, const std::vec
 		mame_options::parse_standard_inis(m_options, option_errors);
 		m_osd.set_verbose(m_options.verbose());
 	}
+	set_archive_index(m_options);
+	set_system_cache(m_options);
+
+	// start recording startup phases before anything worth timing happens
+	if (*m_options.startup_profile())
+		g_startup_trace.start(m_options.startup_profile());
 
 	// otherwise, check for a valid system
 	load_translation(m_options);
 
 	manager->start_http_server();
 
-	manager->start_luaengine();
+	{
+		auto const trace(g_startup_trace.phase("plugins", "start Lua engine"));
+		manager->start_luaengine();
+	}
 
 	if (option_errors.tellp() > 0)
 		osd_printf_error("Error in command line:\n%s\n", strtrimspace(option_errors.str()));
@@ -351,6 +500,7 @@ int cli_frontend::execute(std::vector<std::string> &args)
 	}
 
 	util::archive_file::cache_clear();
+	system_metadata_store::instance().flush();
 	delete manager;
 
 	return m_result;
@@ -366,6 +516,8 @@ void cli_frontend::listxml(const std::vector<std::string> &args)
 {
 	// create the XML and print it to stdout
 	info_xml_creator creator(m_options, m_options.bool_value(CLIOPTION_DTD));
+	if (*m_options.value(CLIOPTION_XMLCACHE))
+		creator.set_cache(m_options.value(CLIOPTION_XMLCACHE), m_options.value(CLIOPTION_XMLSOURCEPATH));
 	creator.output(std::cout, args);
 }
 
@@ -430,14 +582,16 @@ void cli_frontend::listclones(const std::vector<std::string> &args)
 	driver_enumerator drivlist(m_options, gamename);
 	int const original_count = drivlist.count();
 
-	// iterate through the remaining ones to see if their parent matches
-	while (drivlist.next_excluded())
+	// add the clones of each matching non-bios parent
+	std::vector<std::size_t> parents;
+	parents.reserve(original_count);
+	while (drivlist.next())
+		if (!(drivlist.driver().flags & machine_flags::IS_BIOS_ROOT))
+			parents.emplace_back(drivlist.current());
+	for (std::size_t parent : parents)
 	{
-		// if we have a non-bios clone and it matches, keep it
-		int const clone_of = drivlist.clone();
-		if ((clone_of >= 0) && !(drivlist.driver(clone_of).flags & machine_flags::IS_BIOS_ROOT))
-			if (drivlist.matches(gamename, drivlist.driver(clone_of).name))
-				drivlist.include();
+		auto const [first, last] = drivlist.clones(parent);
+		std::for_each(first, last, [&drivlist] (int clone) { drivlist.include(clone); });
 	}
 
 	// return an error if none found
@@ -766,16 +920,16 @@ void cli_frontend::listdevices(const std::vector<std::string> &args)
 		first = false;
 		printf("Driver %s (%s):\n", drivlist.driver().name, drivlist.driver().type.fullname());
 
-		// build a list of devices
-		std::vector<device_t *> device_list;
-		for (device_t &device : device_enumerator(drivlist.config()->root_device()))
+		// build a list of devices from the system's metadata
+		std::vector<system_metadata::device_entry const *> device_list;
+		for (system_metadata::device_entry const &device : system_metadata_store::instance().get(drivlist.driver()).devices())
 			device_list.push_back(&device);
 
 		// sort them by tag
-		std::sort(device_list.begin(), device_list.end(), [](device_t *dev1, device_t *dev2) {
+		std::sort(device_list.begin(), device_list.end(), [](system_metadata::device_entry const *dev1, system_metadata::device_entry const *dev2) {
 			// end of string < ':' < '0'
-			const char *tag1 = dev1->tag();
-			const char *tag2 = dev2->tag();
+			const char *tag1 = dev1->tag.c_str();
+			const char *tag2 = dev2->tag.c_str();
 			while (*tag1 == *tag2 && *tag1 != '\0' && *tag2 != '\0')
 			{
 				tag1++;
@@ -788,7 +942,7 @@ void cli_frontend::listdevices(const std::vector<std::string> &args)
 		for (auto device : device_list)
 		{
 			// extract the tag, stripping the leading colon
-			const char *tag = device->tag();
+			const char *tag = device->tag.c_str();
 			if (*tag == ':')
 				tag++;
 
@@ -808,10 +962,10 @@ void cli_frontend::listdevices(const std::vector<std::string> &args)
 						depth++;
 					}
 			}
-			printf("   %*s%-*s %s", depth * 2, "", 30 - depth * 2, tag, device->name());
+			printf("   %*s%-*s %s", depth * 2, "", 30 - depth * 2, tag, device->name.c_str());
 
 			// add more information
-			uint32_t clock = device->clock();
+			uint32_t clock = device->clock;
 			if (clock >= 1000000000)
 				printf(" @ %d.%02d GHz\n", clock / 1000000000, (clock / 10000000) % 100);
 			else if (clock >= 1000000)
@@ -850,39 +1004,20 @@ void cli_frontend::listslots(const std::vector<std::string> &args)
 	{
 		// iterate over slots
 		bool first = true;
-		for (const device_slot_interface &slot : slot_interface_enumerator(drivlist.config()->root_device()))
+		for (system_metadata::slot_entry const &slot : system_metadata_store::instance().get(drivlist.driver()).slots())
 		{
-			if (slot.fixed())
-				continue;
-
-			// build a list of user-selectable options
-			std::vector<device_slot_interface::slot_option const *> option_list;
-			for (auto &option : slot.option_list())
-				if (option.second->selectable())
-					option_list.push_back(option.second.get());
-
-			// sort them by name
-			std::sort(
-					option_list.begin(),
-					option_list.end(),
-					[] (device_slot_interface::slot_option const *opt1, device_slot_interface::slot_option const *opt2)
-					{
-						return strcmp(opt1->name(), opt2->name()) < 0;
-					});
-
-
 			// output the line, up to the list of extensions
-			printf("%-16s %-16s ", first ? drivlist.driver().name : "", slot.device().tag()+1);
+			printf("%-16s %-16s ", first ? drivlist.driver().name : "", slot.tag.c_str() + 1);
 
 			bool first_option = true;
 
 			// get the options and print them
-			for (device_slot_interface::slot_option const *opt : option_list)
+			for (system_metadata::slot_option_entry const &opt : slot.options)
 			{
 				if (first_option)
-					printf("%-16s %s\n", opt->name(), opt->devtype().fullname());
+					printf("%-16s %s\n", opt.name.c_str(), opt.device_name.c_str());
 				else
-					printf("%-34s%-16s %s\n", "", opt->name(), opt->devtype().fullname());
+					printf("%-34s%-16s %s\n", "", opt.name.c_str(), opt.device_name.c_str());
 
 				first_option = false;
 			}
@@ -993,21 +1128,12 @@ void cli_frontend::verifyroms(const std::vector<std::string> &args)
 
 	// iterate over drivers
 	driver_enumerator drivlist(m_options);
-	media_auditor auditor(drivlist);
-	util::ovectorstream summary_string;
+	std::vector<std::size_t> drivers;
 	while (drivlist.next())
 	{
 		if (included(drivlist.driver().name))
 		{
-			// audit the ROMs in this set
-			media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
-
-			auto const clone_of = drivlist.clone();
-			print_summary(
-					auditor, summary, true,
-					"rom", drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
-					correct, incorrect, notfound,
-					summary_string);
+			drivers.emplace_back(drivlist.current());
 
 			// if it wasn't a wildcard, there can only be one
 			if (!iswild)
@@ -1015,6 +1141,16 @@ void cli_frontend::verifyroms(const std::vector<std::string> &args)
 		}
 	}
 
+	// audit the ROMs in these sets
+	audit_systems(
+			m_options, drivers,
+			[] (media_auditor &auditor) { return auditor.audit_media(AUDIT_VALIDATE_FAST); },
+			true, "rom",
+			correct, incorrect, notfound);
+
+	media_auditor auditor(drivlist);
+	util::ovectorstream summary_string;
+
 	if (iswild || !matchcount)
 	{
 		machine_config config(GAME_NAME(___empty), m_options);
@@ -1091,23 +1227,20 @@ void cli_frontend::verifysamples(const std::vector<std::string> &args)
 	unsigned matched = 0;
 
 	// iterate over drivers
-	media_auditor auditor(drivlist);
-	util::ovectorstream summary_string;
+	std::vector<std::size_t> drivers;
 	while (drivlist.next())
 	{
 		matched++;
-
-		// audit the samples in this set
-		media_auditor::summary summary = auditor.audit_samples();
-
-		auto const clone_of = drivlist.clone();
-		print_summary(
-				auditor, summary, false,
-				"sample", drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
-				correct, incorrect, notfound,
-				summary_string);
+		drivers.emplace_back(drivlist.current());
 	}
 
+	// audit the samples in these sets
+	audit_systems(
+			m_options, drivers,
+			[] (media_auditor &auditor) { return auditor.audit_samples(); },
+			false, "sample",
+			correct, incorrect, notfound);
+
 	// clear out any cached files
 	util::archive_file::cache_clear();
 
@@ -1550,8 +1683,6 @@ void cli_frontend::version(const std::vector<std::string> &args)
 
 void cli_frontend::romident(const std::vector<std::string> &args)
 {
-	const char *filename = args[0].c_str();
-
 	// create our own copy of options for the purposes of ROM identification
 	// so we are not "polluted" with driver-specific slot/image options
 	emu_options options;
@@ -1559,9 +1690,13 @@ void cli_frontend::romident(const std::vector<std::string> &args)
 
 	media_identifier ident(options);
 
-	// identify the file, then output results
-	osd_printf_info("Identifying %s....\n", filename);
-	ident.identify(filename);
+	// identify the files, then output results - known dumps are only
+	// indexed once however many paths are given
+	for (std::string const &filename : args)
+	{
+		osd_printf_info("Identifying %s....\n", filename);
+		ident.identify(filename.c_str());
+	}
 
 	// return the appropriate error code
 	if (ident.total() == 0)
@@ -1700,7 +1835,7 @@ const cli_frontend::info_command_struct *cli_frontend::find_command(const std::s
 		{ CLICOMMAND_LISTMEDIA,         0,  1, &cli_frontend::listmedia,        "[system name]" },
 		{ CLICOMMAND_LISTSOFTWARE,      0,  1, &cli_frontend::listsoftware,     "[system name]" },
 		{ CLICOMMAND_VERIFYSOFTWARE,    0,  1, &cli_frontend::verifysoftware,   "[system name|*]" },
-		{ CLICOMMAND_ROMIDENT,          1,  1, &cli_frontend::romident,         "(file or directory path)" },
+		{ CLICOMMAND_ROMIDENT,          1, -1, &cli_frontend::romident,         "(file or directory path) ..." },
 		{ CLICOMMAND_GETSOFTLIST,       0,  1, &cli_frontend::getsoftlist,      "[system name|*]" },
 		{ CLICOMMAND_VERIFYSOFTLIST,    0,  1, &cli_frontend::verifysoftlist,   "[system name|*]" },
 		{ CLICOMMAND_VERSION,           0,  0, &cli_frontend::version,          "" }
@@ -1758,6 +1893,8 @@ void cli_frontend::execute_commands(std::string_view exename)
 	mame_options::parse_standard_inis(m_options,option_errors);
 	if (option_errors.tellp() > 0)
 		osd_printf_error("%s\n", option_errors.str());
+	set_archive_index(m_options);
+	set_system_cache(m_options);
 
 	// createconfig?
 	if (m_options.command() == CLICOMMAND_CREATECONFIG)
@@ -27,14 +27,18 @@
 #include "speaker.h"
 
 // lib/util
+#include "corefile.h"
 #include "corestr.h"
+#include "multibyte.h"
+#include "path.h"
 #include "xmlfile.h"
 
 #include <algorithm>
 #include <cctype>
 #include <cstring>
-#include <future>
+#include <exception>
 #include <locale>
+#include <map>
 #include <queue>
 #include <type_traits>
 #include <unordered_set>
@@ -102,6 +106,130 @@ private:
 };
 
 
+// runs tasks on the OSD work queue thread pool, handing results back in the order the tasks were added
+template <typename T>
+class ordered_task_queue
+{
+public:
+	ordered_task_queue()
+		: m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI))
+	{
+	}
+
+	~ordered_task_queue()
+	{
+		while (!m_tasks.empty())
+		{
+			wait(*m_tasks.front());
+			m_tasks.pop();
+		}
+		if (m_queue)
+			osd_work_queue_free(m_queue);
+	}
+
+	// methods
+	void push(std::function<T ()> &&proc)
+	{
+		// run it inline if we couldn't get a work queue
+		auto t(std::make_unique<task>());
+		t->proc = std::move(proc);
+		if (m_queue)
+			t->item = osd_work_item_queue(m_queue, &ordered_task_queue::execute, t.get(), 0);
+		if (!t->item)
+			execute(t.get(), 0);
+		m_tasks.emplace(std::move(t));
+	}
+
+	T pop()
+	{
+		std::unique_ptr<task> const t(std::move(m_tasks.front()));
+		m_tasks.pop();
+		wait(*t);
+		if (t->error)
+			std::rethrow_exception(t->error);
+		return std::move(t->result);
+	}
+
+	// accessors
+	bool empty() const { return m_tasks.empty(); }
+	std::size_t size() const { return m_tasks.size(); }
+
+private:
+	struct task
+	{
+		std::function<T ()> proc;
+		T                   result;
+		std::exception_ptr  error;
+		osd_work_item *     item = nullptr;
+	};
+
+	static void *execute(void *param, int threadid)
+	{
+		task &t(*reinterpret_cast<task *>(param));
+		try
+		{
+			t.result = t.proc();
+		}
+		catch (...)
+		{
+			t.error = std::current_exception();
+		}
+		return nullptr;
+	}
+
+	static void wait(task &t)
+	{
+		if (t.item)
+		{
+			while (!osd_work_item_wait(t.item, osd_ticks_per_second() * 10)) { }
+			osd_work_item_release(t.item);
+			t.item = nullptr;
+		}
+	}
+
+	osd_work_queue *                    m_queue;
+	std::queue<std::unique_ptr<task> >  m_tasks;
+};
+
+
+// remembers the XML for each machine along with the source files it was built from
+class machine_xml_cache
+{
+public:
+	machine_xml_cache(std::string_view filename, std::string_view sourcepath);
+
+	// methods
+	std::string const *find(std::string_view name);
+	void add(std::string_view name, std::vector<char const *> const &sources, std::string &&xml);
+	void save() const;
+
+private:
+	struct source_stamp
+	{
+		std::string path;
+		u64         size;
+		s64         mtime;
+	};
+
+	struct cache_entry
+	{
+		std::vector<source_stamp>   sources;
+		std::string                 xml;
+	};
+
+	static constexpr u8 MAGIC[8] = { 'M', 'X', 'M', 'L', 'C', 'C', 'H', 1 };
+
+	std::string resolve_source(std::string_view source) const;
+	std::optional<std::pair<u64, s64> > const &stat_source(std::string const &path);
+
+	std::string const                                                   m_filename;
+	std::string const                                                   m_source_path;
+	std::map<std::string, cache_entry, std::less<> >                    m_entries;
+	std::map<std::string, std::optional<std::pair<u64, s64> >, std::less<> > m_stamps;
+	bool                                                                m_dirty;
+};
+
+
 using device_type_set = std::set<std::add_pointer_t<device_type>, device_type_compare>;
 using device_type_vector = std::vector<std::add_pointer_t<device_type> >;
 
@@ -109,7 +237,7 @@ using device_type_vector = std::vector<std::add_pointer_t<device_type> >;
 void output_header(std::ostream &out, bool dtd);
 void output_footer(std::ostream &out);
 
-void output_one(std::ostream &out, driver_enumerator &drivlist, const game_driver &driver, device_type_set *devtypes);
+void output_one(std::ostream &out, driver_enumerator &drivlist, const game_driver &driver, device_type_set *devtypes, std::vector<char const *> *sources);
 void output_sampleof(std::ostream &out, device_t &device);
 void output_bios(std::ostream &out, device_t const &device);
 void output_rom(std::ostream &out, machine_config &config, driver_list const *drivlist, const game_driver *driver, device_t &device);
@@ -460,21 +588,18 @@ void info_xml_creator::output(std::ostream &out, const std::vector<std::string>
 
 void info_xml_creator::output(std::ostream &out, const std::function<bool(const char *shortname, bool &done)> &filter, bool include_devices)
 {
-	struct prepared_info
+	struct prepared_machine
 	{
-		prepared_info() = default;
-		prepared_info(const prepared_info &) = delete;
-		prepared_info(prepared_info &&) = default;
-#if defined(_CPPLIB_VER) && defined(_MSVC_STL_VERSION)
-		// MSVCPRT currently requires default-constructible std::future promise types to be assignable
-		// remove this workaround when that's fixed
-		prepared_info &operator=(const prepared_info &) = default;
-#else
-		prepared_info &operator=(const prepared_info &) = delete;
-#endif
+		char const *                m_name = nullptr;
+		std::string                 m_xml_snippet;
+		std::vector<char const *>   m_sources;
+		bool                        m_cached = false;
+	};
 
-		std::string     m_xml_snippet;
-		device_type_set m_dev_set;
+	struct prepared_info
+	{
+		std::vector<prepared_machine>   m_machines;
+		device_type_set                 m_dev_set;
 	};
 
 	// prepare a driver enumerator and the queue
@@ -498,65 +623,79 @@ void info_xml_creator::output(std::ostream &out, const std::function<bool(const
 	if (include_devices && filter)
 		devset.emplace();
 
-	// prepare a queue of tasks - this is a FIFO queue because of the
-	// need to be deterministic
-	std::queue<std::future<prepared_info> > tasks;
+	// cached machines don't record the devices they reference, so they can't be used when tracking them
+	std::optional<machine_xml_cache> cache;
+	if (!m_cache_file.empty())
+		cache.emplace(m_cache_file, m_source_path);
+	bool const use_cache = cache && !devset;
 
-	// while we want to be deterministic, asynchronous task scheduling is not; so we want to
-	// track the amount of active tasks so that we can keep on spawning tasks even if we're
-	// waiting on the task in the front of the queue
-	std::atomic<unsigned int> active_task_count = 0;
-	unsigned int const maximum_active_task_count = std::thread::hardware_concurrency() + 10;
-	unsigned int const maximum_outstanding_task_count = maximum_active_task_count + 20;
+	// prepare a queue of tasks - results are retired in the order they were added because of the
+	// need to be deterministic, while the thread pool keeps working on the tasks behind the oldest
+	ordered_task_queue<prepared_info> tasks;
+	unsigned int const maximum_outstanding_task_count = std::thread::hardware_concurrency() + 30;
 
 	// loop until we're done enumerating drivers, and until there are no outstanding tasks
 	while (!filtered_drivlist.done() || !tasks.empty())
 	{
-		// loop until there are as many outstanding tasks as possible (we want to separately cap outstanding
-		// tasks and active tasks)
-		while (!filtered_drivlist.done()
-				&& (active_task_count < maximum_active_task_count)
-				&& (tasks.size() < maximum_outstanding_task_count))
+		// loop until there are as many outstanding tasks as possible
+		while (!filtered_drivlist.done() && (tasks.size() < maximum_outstanding_task_count))
 		{
 			// we want to launch a task; grab a packet of drivers to process
 			std::vector<std::reference_wrapper<const game_driver> > drivers = filtered_drivlist.next(20);
 			if (drivers.empty())
 				break;
 
+			// pick up anything that hasn't changed since it was cached
+			std::vector<prepared_machine> machines(drivers.size());
+			for (std::size_t i = 0; drivers.size() > i; ++i)
+			{
+				machines[i].m_name = drivers[i].get().name;
+				std::string const *const cached = use_cache ? cache->find(machines[i].m_name) : nullptr;
+				if (cached)
+				{
+					machines[i].m_xml_snippet = *cached;
+					machines[i].m_cached = true;
+				}
+			}
+
 			// do the dirty work asynchronously
-			auto task_proc = [&drivlist, drivers = std::move(drivers), include_devices, &active_task_count]
+			tasks.push(
+					[&drivlist, drivers = std::move(drivers), machines = std::move(machines), include_devices, use_cache] () mutable
 					{
 						prepared_info result;
-						std::ostringstream stream;
-						stream.imbue(std::locale::classic());
-
-						// output each of the drivers
-						for (const game_driver &driver : drivers)
-							output_one(stream, drivlist, driver, include_devices ? &result.m_dev_set : nullptr);
 
-						// capture the XML snippet
-						result.m_xml_snippet = std::move(stream).str();
+						// output each of the drivers that wasn't cached
+						for (std::size_t i = 0; drivers.size() > i; ++i)
+						{
+							if (!machines[i].m_cached)
+							{
+								std::ostringstream stream;
+								stream.imbue(std::locale::classic());
+								output_one(stream, drivlist, drivers[i], include_devices ? &result.m_dev_set : nullptr, use_cache ? &machines[i].m_sources : nullptr);
+								machines[i].m_xml_snippet = std::move(stream).str();
+							}
+						}
 
-						// we're done with the task; decrement the counter and return
-						active_task_count--;
+						// capture the XML snippets
+						result.m_machines = std::move(machines);
 						return result;
-					};
-
-			// add this task to the queue
-			active_task_count++;
-			tasks.emplace(std::async(std::launch::async, std::move(task_proc)));
+					});
 		}
 
 		// we've put as many outstanding tasks out as we can; are there any tasks outstanding?
 		if (!tasks.empty())
 		{
 			// wait for the oldest task to complete and get the info, in the spirit of determinism
-			prepared_info pi = tasks.front().get();
-			tasks.pop();
+			prepared_info pi = tasks.pop();
 
-			// emit whatever XML we accumulated in the task
+			// emit whatever XML we accumulated in the task, and remember any new machines
 			output_header_if_necessary(out);
-			out << pi.m_xml_snippet;
+			for (prepared_machine &machine : pi.m_machines)
+			{
+				out << machine.m_xml_snippet;
+				if (use_cache && !machine.m_cached)
+					cache->add(machine.m_name, machine.m_sources, std::move(machine.m_xml_snippet));
+			}
 
 			// merge devices into devset, if appropriate
 			if (devset)
@@ -567,6 +706,10 @@ void info_xml_creator::output(std::ostream &out, const std::function<bool(const
 		}
 	}
 
+	// write back anything that was regenerated
+	if (use_cache)
+		cache->save();
+
 	// iterate through the device types if not everything matches a driver
 	if (devset && !devfilter.done())
 	{
@@ -637,6 +780,209 @@ std::vector<std::reference_wrapper<const game_driver> > filtered_driver_enumerat
 }
 
 
+//-------------------------------------------------
+//  machine_xml_cache - constructor, loading the
+//  cache file
+//-------------------------------------------------
+
+machine_xml_cache::machine_xml_cache(std::string_view filename, std::string_view sourcepath)
+	: m_filename(filename)
+	, m_source_path(sourcepath)
+	, m_dirty(false)
+{
+	std::vector<uint8_t> data;
+	if (util::core_file::load(m_filename, data))
+		return;
+
+	// helpers for pulling apart the file - any inconsistency throws everything away
+	u8 const *ptr = data.data();
+	u8 const *const end = ptr + data.size();
+	bool valid = (data.size() >= sizeof(MAGIC)) && std::equal(std::begin(MAGIC), std::end(MAGIC), ptr);
+	ptr += valid ? sizeof(MAGIC) : 0;
+	auto const read_u64 =
+			[&ptr, end, &valid] () -> u64
+			{
+				if (!valid || ((end - ptr) < 8))
+				{
+					valid = false;
+					return 0;
+				}
+				ptr += 8;
+				return get_u64le(ptr - 8);
+			};
+	auto const read_string =
+			[&ptr, end, &valid, &read_u64] () -> std::string_view
+			{
+				u64 const length = read_u64();
+				if (!valid || (u64(end - ptr) < length))
+				{
+					valid = false;
+					return std::string_view();
+				}
+				ptr += length;
+				return std::string_view(reinterpret_cast<char const *>(ptr - length), length);
+			};
+
+	// entries from a different version are never reused
+	if (read_string() != emulator_info::get_bare_build_version())
+		return;
+
+	// each entry is the machine name, its source files with their sizes and modification times, and the XML
+	while (valid && (end != ptr))
+	{
+		std::string_view const name = read_string();
+		cache_entry entry;
+		for (u64 count = read_u64(); valid && count; --count)
+		{
+			std::string_view const path = read_string();
+			u64 const size = read_u64();
+			s64 const mtime = s64(read_u64());
+			entry.sources.emplace_back(source_stamp{ std::string(path), size, mtime });
+		}
+		entry.xml = read_string();
+		if (valid)
+			m_entries.insert_or_assign(std::string(name), std::move(entry));
+	}
+	if (!valid)
+		m_entries.clear();
+}
+
+
+//-------------------------------------------------
+//  find - get the XML for a machine if none of
+//  its source files have changed
+//-------------------------------------------------
+
+std::string const *machine_xml_cache::find(std::string_view name)
+{
+	auto const found = m_entries.find(name);
+	if (m_entries.end() == found)
+		return nullptr;
+
+	for (source_stamp const &source : found->second.sources)
+	{
+		auto const &stamp = stat_source(source.path);
+		if (!stamp || (stamp->first != source.size) || (stamp->second != source.mtime))
+			return nullptr;
+	}
+	return &found->second.xml;
+}
+
+
+//-------------------------------------------------
+//  add - remember the XML for a machine and the
+//  source files it was built from
+//-------------------------------------------------
+
+void machine_xml_cache::add(std::string_view name, std::vector<char const *> const &sources, std::string &&xml)
+{
+	cache_entry entry;
+	for (char const *source : sources)
+	{
+		// skip duplicates
+		std::string path = resolve_source(source);
+		if (std::find_if(entry.sources.begin(), entry.sources.end(), [&path] (source_stamp const &s) { return s.path == path; }) != entry.sources.end())
+			continue;
+
+		// if a source file can't be found, the machine can't be checked next time
+		auto const &stamp = stat_source(path);
+		if (!stamp)
+		{
+			m_dirty = m_entries.erase(std::string(name)) || m_dirty;
+			return;
+		}
+		entry.sources.emplace_back(source_stamp{ std::move(path), stamp->first, stamp->second });
+	}
+	entry.xml = std::move(xml);
+	m_entries.insert_or_assign(std::string(name), std::move(entry));
+	m_dirty = true;
+}
+
+
+//-------------------------------------------------
+//  save - write the cache file back out if
+//  anything changed
+//-------------------------------------------------
+
+void machine_xml_cache::save() const
+{
+	if (!m_dirty)
+		return;
+
+	std::vector<u8> data(std::begin(MAGIC), std::end(MAGIC));
+	auto const write_u64 =
+			[&data] (u64 value)
+			{
+				data.resize(data.size() + 8);
+				put_u64le(&data[data.size() - 8], value);
+			};
+	auto const write_string =
+			[&data, &write_u64] (std::string_view value)
+			{
+				write_u64(value.length());
+				data.insert(data.end(), value.begin(), value.end());
+			};
+
+	write_string(emulator_info::get_bare_build_version());
+	for (auto const &entry : m_entries)
+	{
+		write_string(entry.first);
+		write_u64(entry.second.sources.size());
+		for (source_stamp const &source : entry.second.sources)
+		{
+			write_string(source.path);
+			write_u64(source.size);
+			write_u64(u64(source.mtime));
+		}
+		write_string(entry.second.xml);
+	}
+
+	util::core_file::ptr file;
+	if (!util::core_file::open(m_filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file))
+		util::write(*file, data.data(), data.size());
+}
+
+
+//-------------------------------------------------
+//  resolve_source - find a source file relative
+//  to the configured source path
+//-------------------------------------------------
+
+std::string machine_xml_cache::resolve_source(std::string_view source) const
+{
+	using namespace std::literals;
+
+	// recorded source paths are relative to wherever the build ran - take them from the src directory on
+	if (auto prefix(source.rfind("/src/"sv)); std::string_view::npos != prefix)
+		source.remove_prefix(prefix + 1);
+	else if (auto prefix(source.rfind("\\src\\"sv)); std::string_view::npos != prefix)
+		source.remove_prefix(prefix + 1);
+
+	return m_source_path.empty() ? std::string(source) : util::path_concat(m_source_path, source);
+}
+
+
+//-------------------------------------------------
+//  stat_source - get the size and modification
+//  time of a source file, remembering it for
+//  other machines built from the same file
+//-------------------------------------------------
+
+std::optional<std::pair<u64, s64> > const &machine_xml_cache::stat_source(std::string const &path)
+{
+	auto found = m_stamps.find(path);
+	if (m_stamps.end() == found)
+	{
+		std::unique_ptr<osd::directory::entry> const entry(osd_stat(path));
+		std::optional<std::pair<u64, s64> > stamp;
+		if (entry && (osd::directory::entry::entry_type::FILE == entry->type))
+			stamp.emplace(entry->size, entry->last_modified.time_since_epoch().count());
+		found = m_stamps.emplace(path, stamp).first;
+	}
+	return found->second;
+}
+
+
 //-------------------------------------------------
 //  output_header - print the XML DTD and open
 //  the root element
@@ -687,7 +1033,7 @@ void output_footer(std::ostream &out)
 //  for one particular machine driver
 //-------------------------------------------------
 
-void output_one(std::ostream &out, driver_enumerator &drivlist, const game_driver &driver, device_type_set *devtypes)
+void output_one(std::ostream &out, driver_enumerator &drivlist, const game_driver &driver, device_type_set *devtypes, std::vector<char const *> *sources)
 {
 	using util::xml::normalize_string;
 
@@ -707,6 +1053,8 @@ void output_one(std::ostream &out, driver_enumerator &drivlist, const game_drive
 
 		if (devtypes && device.owner())
 			devtypes->insert(&device.type());
+		if (sources)
+			sources->emplace_back(device.type().source());
 	}
 
 	// renumber player numbers for controller ports
@@ -878,19 +1226,15 @@ void output_devices(std::ostream &out, emu_options &lookup_options, device_type_
 	auto const action = [&lookup_options, &out] (auto &types, auto deref)
 			{
 				// machinery for making output order deterministic and capping outstanding tasks
-				std::queue<std::future<std::string> > tasks;
-				std::atomic<unsigned int> active_task_count = 0;
-				unsigned int const maximum_active_task_count = std::thread::hardware_concurrency() + 10;
-				unsigned int const maximum_outstanding_task_count = maximum_active_task_count + 20;
+				ordered_task_queue<std::string> tasks;
+				unsigned int const maximum_outstanding_task_count = std::thread::hardware_concurrency() + 30;
 
 				// loop until we're done enumerating devices and there are no outstanding tasks
 				auto it = std::begin(types);
 				while ((std::end(types) != it) || !tasks.empty())
 				{
 					// look until there are as many outstanding tasks as possible
-					while ((std::end(types) != it)
-							&& (active_task_count < maximum_active_task_count)
-							&& (tasks.size() < maximum_outstanding_task_count))
+					while ((std::end(types) != it) && (tasks.size() < maximum_outstanding_task_count))
 					{
 						device_type_vector batch;
 						batch.reserve(10);
@@ -900,7 +1244,8 @@ void output_devices(std::ostream &out, emu_options &lookup_options, device_type_
 							break;
 
 						// do the dirty work asynchronously
-						auto task_proc = [&active_task_count, &lookup_options, batch = std::move(batch)]
+						tasks.push(
+								[&lookup_options, batch = std::move(batch)]
 								{
 									// use a single machine configuration and stream for a batch of devices
 									machine_config config(GAME_NAME(___empty), lookup_options);
@@ -926,22 +1271,15 @@ void output_devices(std::ostream &out, emu_options &lookup_options, device_type_
 										config.device_remove("_tmp");
 									}
 
-									// we're done with the task; decrement the counter and return
-									active_task_count--;
 									return std::move(stream).str();
-								};
-
-						// add this task to the queue
-						active_task_count++;
-						tasks.emplace(std::async(std::launch::async, std::move(task_proc)));
+								});
 					}
 
 					// we've put as many outstanding tasks out as we can; are there any tasks outstanding?
 					if (!tasks.empty())
 					{
 						// wait for the oldest task to complete and get the info, in the spirit of determinism
-						std::string snippet = tasks.front().get();
-						tasks.pop();
+						std::string snippet = tasks.pop();
 
 						// emit whatever XML we accumulated in the task
 						out << snippet;
@@ -36,6 +36,9 @@ public:
 	void output(std::ostream &out, const std::vector<std::string> &patterns);
 	void output(std::ostream &out, const std::function<bool(const char *shortname, bool &done)> &filter = { }, bool include_devices = true);
 
+	// reuse machines from a cache file when their source files are unchanged
+	void set_cache(std::string_view filename, std::string_view sourcepath) { m_cache_file = filename; m_source_path = sourcepath; }
+
 	static char const *feature_name(device_t::feature_type feature);
 	static std::string format_sourcefile(std::string_view path);
 
@@ -43,6 +46,8 @@ private:
 	// internal state
 	emu_options     m_lookup_options;
 	bool            m_dtd;
+	std::string     m_cache_file;
+	std::string     m_source_path;
 };
 
 #endif // MAME_FRONTEND_MAME_INFOXML_H
@@ -477,6 +477,7 @@ lua_engine::lua_engine()
 	: m_lua_state(nullptr)
 	, m_machine(nullptr)
 	, m_timer(nullptr)
+	, m_frame_number(0)
 {
 	m_lua_state = luaL_newstate();  // create state
 	m_sol_state = std::make_unique<sol::state_view>(m_lua_state); // create sol view
@@ -651,8 +652,12 @@ void lua_engine::on_machine_stop()
 	for (auto const &waiting : m_waiting_tasks)
 		expired.emplace_back(waiting.second);
 	m_waiting_tasks.clear();
+	for (auto const &waiting : m_frame_count_tasks)
+		expired.emplace_back(waiting.second);
+	m_frame_count_tasks.clear();
 	resume_tasks(m_lua_state, expired, false);
 	expired.clear();
+	cancel_memory_waits();
 
 	m_notifiers->on_stop();
 	execute_function("LUA_ON_STOP");
@@ -679,6 +684,16 @@ void lua_engine::on_machine_frame()
 {
 	std::vector<int> tasks = std::move(m_frame_tasks);
 	m_frame_tasks.clear();
+
+	// tasks waiting for a number of frames are kept in order of the frame they want
+	++m_frame_number;
+	auto const pos = std::find_if(
+			m_frame_count_tasks.begin(),
+			m_frame_count_tasks.end(),
+			[this] (auto const &x) { return m_frame_number < x.first; });
+	for (auto it = m_frame_count_tasks.begin(); pos != it; ++it)
+		tasks.emplace_back(it->second);
+	m_frame_count_tasks.erase(m_frame_count_tasks.begin(), pos);
 	resume_tasks(m_lua_state, tasks, true); // TODO: doesn't need to return anything
 
 	m_notifiers->on_frame();
@@ -807,6 +822,10 @@ void lua_engine::initialize()
  * emu.register_before_load_settings(callback) - register callback to be run before settings are loaded
  * emu.show_menu(menu_name) - show menu by name and pause the machine
  *
+ * emu.wait(duration) - suspend the calling coroutine for an emulated time
+ * emu.wait_frames(count) - suspend the calling coroutine for a number of frames
+ * emu.wait_memory(space, address, value, [mask], [width]) - suspend the calling coroutine until memory holds a value
+ *
  * emu.device_enumerator(dev) - get device enumerator starting at arbitrary point in tree
  * emu.screen_enumerator(dev) - get screen device enumerator starting at arbitrary point in tree
  * emu.image_enumerator(dev) - get image interface enumerator starting at arbitrary point in tree
@@ -869,6 +888,23 @@ void lua_engine::initialize()
 				m_frame_tasks.emplace_back(luaL_ref(s, LUA_REGISTRYINDEX));
 				return sol::variadic_results(args.begin(), args.end());
 			});
+	emu["wait_frames"] = sol::yielding(
+			[this] (sol::this_state s, u64 frames, sol::variadic_args args)
+			{
+				int const ret = lua_pushthread(s);
+				if (ret == 1)
+					luaL_error(s, "cannot wait from outside coroutine");
+				int const ref = luaL_ref(s, LUA_REGISTRYINDEX);
+
+				u64 const target = m_frame_number + std::max<u64>(frames, 1);
+				auto const pos = std::upper_bound(
+						m_frame_count_tasks.begin(),
+						m_frame_count_tasks.end(),
+						target,
+						[] (auto const &a, auto const &b) { return a < b.first; });
+				m_frame_count_tasks.emplace(pos, target, ref);
+				return sol::variadic_results(args.begin(), args.end());
+			});
 	emu.set_function("add_machine_reset_notifier", make_notifier_adder(m_notifiers->on_reset, "machine reset"));
 	emu.set_function("add_machine_stop_notifier", make_notifier_adder(m_notifiers->on_stop, "machine stop"));
 	emu.set_function("add_machine_pause_notifier", make_notifier_adder(m_notifiers->on_pause, "machine pause"));
@@ -885,6 +921,18 @@ void lua_engine::initialize()
 			static_cast<char const *(*)(char const *)>(&lang_translate),
 			static_cast<char const *(*)(char const *, char const *)>(&lang_translate));
 	emu.set_function("subst_env", &osd_subst_env);
+	emu.set_function("profile",
+			[] (sol::this_state s, char const *name, sol::protected_function func, sol::variadic_args args)
+			{
+				auto profile = g_profiler.start(g_profiler.register_scope(name));
+				sol::protected_function_result result = func(sol::as_args(args));
+				if (!result.valid())
+				{
+					sol::error err = result;
+					luaL_error(s, "%s", err.what());
+				}
+				return result;
+			});
 
 	// TODO: stuff below here needs to be rationalised
 	emu["app_name"] = &emulator_info::get_appname_lower;
@@ -1430,6 +1478,7 @@ void lua_engine::initialize()
 					m.popmessage();
 			});
 	machine_type.set_function("logerror", [] (running_machine &m, char const *str) { m.logerror("[luaengine] %s\n", str); });
+	machine_type.set_function("write_profile_trace", [] (running_machine &m, char const *filename) { return g_runtime_trace.write(m, filename); });
 	machine_type["time"] = sol::property(&running_machine::time);
 	machine_type["system"] = sol::property(&running_machine::system);
 	machine_type["parameters"] = sol::property(&running_machine::parameters);
@@ -1442,6 +1491,7 @@ void lua_engine::initialize()
 	machine_type["natkeyboard"] = sol::property(&running_machine::natkeyboard);
 	machine_type["uiinput"] = sol::property(&running_machine::ui_input);
 	machine_type["render"] = sol::property(&running_machine::render);
+	machine_type["scheduler"] = sol::property(&running_machine::scheduler);
 	machine_type["debugger"] = sol::property(
 			[] (running_machine &m, sol::this_state s) -> sol::object
 			{
@@ -1455,6 +1505,9 @@ void lua_engine::initialize()
 	machine_type["paused"] = sol::property(&running_machine::paused);
 	machine_type["exit_pending"] = sol::property(&running_machine::exit_pending);
 	machine_type["hard_reset_pending"] = sol::property(&running_machine::hard_reset_pending);
+	machine_type["profile_tracing"] = sol::property(
+			[] (running_machine &m) { return g_runtime_trace.enabled(); },
+			[] (running_machine &m, bool enable) { g_runtime_trace.enable(enable); });
 	machine_type["devices"] = sol::property([] (running_machine &m) { return devenum<device_enumerator>(m.root_device()); });
 	machine_type["palettes"] = sol::property([] (running_machine &m) { return devenum<palette_interface_enumerator>(m.root_device()); });
 	machine_type["screens"] = sol::property([] (running_machine &m) { return devenum<screen_device_enumerator>(m.root_device()); });
@@ -1463,6 +1516,32 @@ void lua_engine::initialize()
 	machine_type["slots"] = sol::property([](running_machine &m) { return devenum<slot_interface_enumerator>(m.root_device()); });
 
 
+	auto scheduler_type = sol().registry().new_usertype<device_scheduler>("scheduler", sol::no_constructor);
+	scheduler_type.set_function("reset_stats", &device_scheduler::reset_stats);
+	scheduler_type["time"] = sol::property(&device_scheduler::time);
+	scheduler_type["stats_enabled"] = sol::property(&device_scheduler::stats_enabled, &device_scheduler::set_stats_enabled);
+	scheduler_type["timeslices"] = sol::property(&device_scheduler::stat_timeslices);
+	scheduler_type["synchronizes"] = sol::property(&device_scheduler::stat_synchronizes);
+	scheduler_type["quantum_boosts"] = sol::property(&device_scheduler::stat_boosts);
+	scheduler_type["boosted_time"] = sol::property(&device_scheduler::stat_boosted_time);
+	scheduler_type["device_stats"] = sol::property(
+			[this] (device_scheduler &sched)
+			{
+				sol::table table = sol().create_table();
+				for (device_execute_interface &exec : execute_interface_enumerator(sched.machine().root_device()))
+				{
+					sol::table entry = sol().create_table();
+					entry["timeslices"] = exec.stat_timeslices();
+					entry["cycles_requested"] = exec.stat_cycles_requested();
+					entry["cycles_executed"] = exec.stat_cycles_executed();
+					entry["cycles_overshoot"] = exec.stat_cycles_overshoot();
+					entry["aborts"] = exec.stat_aborts();
+					table[exec.device().tag()] = entry;
+				}
+				return table;
+			});
+
+
 	auto game_driver_type = sol().registry().new_usertype<game_driver>("game_driver", sol::no_constructor);
 	game_driver_type["name"] = sol::property([] (game_driver const &driver) { return &driver.name[0]; });
 	game_driver_type["description"] = sol::property([] (game_driver const &driver) { return &driver.type.fullname()[0]; });
@@ -1767,17 +1846,17 @@ void lua_engine::initialize()
 				}
 
 				// open the file
-				emu_file file(is_absolute_path ? "" : machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+				auto file = std::make_unique<emu_file>(is_absolute_path ? "" : machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
 				std::error_condition filerr;
 				if (!snapstr.empty())
-					filerr = file.open(snapstr);
+					filerr = file->open(snapstr);
 				else
-					filerr = machine().video().open_next(file, "png");
+					filerr = machine().video().open_next(*file, "png");
 				if (filerr)
 					return sol::make_object(sol(), filerr);
 
-				// and save the snapshot
-				machine().video().save_snapshot(&sdev, file);
+				// and save the snapshot (possibly encoded in the background)
+				machine().video().save_snapshot(&sdev, std::move(file));
 				return sol::lua_nil;
 			});
 	screen_dev_type.set_function("pixel", &screen_device::pixel);
@@ -2182,6 +2261,8 @@ void lua_engine::close()
 	m_menu.clear();
 	m_update_tasks.clear();
 	m_frame_tasks.clear();
+	m_frame_count_tasks.clear();
+	m_memory_waits.clear();
 	m_sol_state.reset();
 	if (m_lua_state)
 	{
@@ -2208,6 +2289,38 @@ void lua_engine::resume(s32 param)
 	resume_tasks(m_lua_state, expired, true);
 }
 
+void lua_engine::check_memory_waits(s32 param)
+{
+	// collect everything first - resumed tasks may start waiting again
+	std::vector<int> satisfied;
+	for (auto it = m_memory_waits.begin(); m_memory_waits.end() != it; )
+	{
+		memory_wait &wait(**it);
+		if (wait.triggered())
+		{
+			wait.clear_triggered();
+			if (wait.satisfied())
+			{
+				satisfied.emplace_back(wait.task());
+				it = m_memory_waits.erase(it);
+				continue;
+			}
+		}
+		++it;
+	}
+	resume_tasks(m_lua_state, satisfied, true);
+}
+
+void lua_engine::cancel_memory_waits()
+{
+	std::vector<int> cancelled;
+	cancelled.reserve(m_memory_waits.size());
+	for (auto const &wait : m_memory_waits)
+		cancelled.emplace_back(wait->task());
+	m_memory_waits.clear();
+	resume_tasks(m_lua_state, cancelled, false);
+}
+
 //-------------------------------------------------
 //  load_script - load script from file path
 //-------------------------------------------------
@@ -159,6 +159,7 @@ private:
 	class palette_wrapper;
 	template <typename T> class bitmap_helper;
 	class tap_helper;
+	class memory_wait;
 	class addr_space_change_notif;
 	class symbol_table_wrapper;
 	class expression_wrapper;
@@ -179,6 +180,9 @@ private:
 	std::vector<std::pair<attotime, int> > m_waiting_tasks;
 	std::vector<int> m_update_tasks;
 	std::vector<int> m_frame_tasks;
+	std::vector<std::pair<u64, int> > m_frame_count_tasks;
+	std::vector<std::unique_ptr<memory_wait> > m_memory_waits;
+	u64 m_frame_number;
 
 	template <typename... T>
 	auto make_notifier_adder(util::notifier<T...> &notifier, const char *desc);
@@ -197,6 +201,8 @@ private:
 	void on_machine_postload();
 
 	void resume(s32 param);
+	void check_memory_waits(s32 param);
+	void cancel_memory_waits();
 	void register_function(sol::function func, const char *id);
 	template <typename T> size_t enumerate_functions(const char *id, T &&callback);
 	bool execute_function(const char *id);
@@ -547,6 +547,39 @@ struct lua_engine::addr_space
 };
 
 
+// a coroutine waiting for a value in memory - a write tap notices writes
+// to the location, and the condition is checked when the scheduler next
+// gets control rather than running Lua for every write
+class lua_engine::memory_wait
+{
+public:
+	memory_wait(memory_wait const &) = delete;
+	memory_wait(memory_wait &&) = delete;
+
+	memory_wait(lua_engine &host, address_space &space, offs_t address, unsigned width, u64 value, u64 mask, int task);
+	~memory_wait();
+
+	int task() const noexcept { return m_task; }
+	bool triggered() const noexcept { return m_triggered; }
+	void clear_triggered() noexcept { m_triggered = false; }
+	void trigger();
+	bool satisfied();
+
+private:
+	template <typename T> void install(offs_t end);
+
+	lua_engine &m_host;
+	address_space &m_space;
+	memory_passthrough_handler m_handler;
+	offs_t const m_address;
+	unsigned const m_width;
+	u64 const m_value;
+	u64 const m_mask;
+	int const m_task;
+	bool m_triggered;
+};
+
+
 template <typename T, size_t Size>
 class lua_engine::enum_parser
 {
@@ -120,6 +120,57 @@ void share_write(memory_share &share, offs_t address, T val)
 	}
 }
 
+//-------------------------------------------------
+//  memory_buffer - reusable byte buffer that bulk
+//  reads fill in place, so scripts can read the
+//  same memory every frame without allocating
+//  -> buf = emu.membuffer(0x800)
+//  -> manager:machine().devices[":maincpu"].spaces["program"]:read_range_into(buf, 0xC000, 0xC7FF)
+//-------------------------------------------------
+
+class memory_buffer
+{
+public:
+	memory_buffer(std::size_t size) : m_data(size, 0) { }
+
+	std::size_t size() const { return m_data.size(); }
+	void resize(std::size_t size) { m_data.resize(size, 0); }
+
+	// make room for length bytes at offset, growing if necessary
+	u8 *prepare(std::size_t offset, std::size_t length)
+	{
+		if (m_data.size() < (offset + length))
+			m_data.resize(offset + length, 0);
+		return &m_data[offset];
+	}
+
+	// little-endian readers for <sign>,<size>
+	template <typename T>
+	T read(sol::this_state s, std::size_t offset) const
+	{
+		if ((offset + sizeof(T)) > m_data.size())
+		{
+			luaL_error(s, "Offset out of range");
+			return 0;
+		}
+		std::make_unsigned_t<T> result = 0;
+		for (std::size_t i = sizeof(T); i-- > 0; )
+			result = (result << 8) | m_data[offset + i];
+		return T(result);
+	}
+
+	// copy part of the buffer to a string
+	std::string_view view(std::size_t offset, std::size_t length) const
+	{
+		if (offset >= m_data.size())
+			return std::string_view();
+		return std::string_view(reinterpret_cast<char const *>(&m_data[offset]), std::min(length, m_data.size() - offset));
+	}
+
+private:
+	std::vector<u8> m_data;
+};
+
 } // anonymous namespace
 
 
@@ -472,6 +523,83 @@ void lua_engine::addr_space::log_mem_write(offs_t address, T val)
 	}
 }
 
+//-------------------------------------------------
+//  memory_wait - watch a location for a value
+//-------------------------------------------------
+
+lua_engine::memory_wait::memory_wait(lua_engine &host, address_space &space, offs_t address, unsigned width, u64 value, u64 mask, int task)
+	: m_host(host)
+	, m_space(space)
+	, m_handler()
+	, m_address(address)
+	, m_width(width)
+	, m_value(value & mask)
+	, m_mask(mask)
+	, m_task(task)
+	, m_triggered(false)
+{
+	offs_t const end = address + std::max<offs_t>(space.byte_to_address(width / 8), 1) - 1;
+	switch (space.data_width())
+	{
+	case  8: install<u8>(end);  break;
+	case 16: install<u16>(end); break;
+	case 32: install<u32>(end); break;
+	case 64: install<u64>(end); break;
+	}
+
+	// the value may already be there
+	trigger();
+}
+
+lua_engine::memory_wait::~memory_wait()
+{
+	m_handler.remove();
+}
+
+template <typename T>
+void lua_engine::memory_wait::install(offs_t end)
+{
+	m_handler = m_space.install_write_tap(
+			m_address,
+			end,
+			"lua_wait",
+			[this] (offs_t offset, T &data, T mem_mask) { trigger(); },
+			&m_handler);
+}
+
+void lua_engine::memory_wait::trigger()
+{
+	// the write hasn't happened yet, so check once the scheduler has control again
+	if (!m_triggered)
+	{
+		m_triggered = true;
+		m_host.machine().scheduler().synchronize(timer_expired_delegate(FUNC(lua_engine::check_memory_waits), &m_host));
+	}
+}
+
+bool lua_engine::memory_wait::satisfied()
+{
+	auto dis = m_host.machine().disable_side_effects();
+	u64 value = 0;
+	switch (m_width)
+	{
+	case 8:
+		value = m_space.read_byte(m_address);
+		break;
+	case 16:
+		value = WORD_ALIGNED(m_address) ? m_space.read_word(m_address) : m_space.read_word_unaligned(m_address);
+		break;
+	case 32:
+		value = DWORD_ALIGNED(m_address) ? m_space.read_dword(m_address) : m_space.read_dword_unaligned(m_address);
+		break;
+	case 64:
+		value = QWORD_ALIGNED(m_address) ? m_space.read_qword(m_address) : m_space.read_qword_unaligned(m_address);
+		break;
+	}
+	return (value & m_mask) == m_value;
+}
+
+
 //-------------------------------------------------
 //  mem_direct_read - templated direct memory readers for <sign>,<size>
 //  -> manager:machine().devices[":maincpu"].spaces["program"]:read_direct_i8(0xC000)
@@ -532,6 +660,36 @@ void lua_engine::addr_space::direct_mem_write(offs_t address, T val)
 void lua_engine::initialize_memory(sol::table &emu)
 {
 
+	emu["wait_memory"] = sol::yielding(
+			[this] (sol::this_state s, addr_space &sp, offs_t address, u64 value, sol::object opt_mask, sol::object opt_width)
+			{
+				unsigned const width = opt_width.is<unsigned>() ? opt_width.as<unsigned>() : 8;
+				if ((width != 8) && (width != 16) && (width != 32) && (width != 64))
+					luaL_error(s, "Invalid width. Must be 8/16/32/64");
+				u64 const mask = opt_mask.is<u64>() ? opt_mask.as<u64>() : make_bitmask<u64>(width);
+
+				int const ret = lua_pushthread(s);
+				if (ret == 1)
+					luaL_error(s, "cannot wait from outside coroutine");
+				int const ref = luaL_ref(s, LUA_REGISTRYINDEX);
+				m_memory_waits.emplace_back(std::make_unique<memory_wait>(*this, sp.space, address, width, value, mask, ref));
+			});
+
+
+	auto membuffer_type = emu.new_usertype<memory_buffer>(
+			"membuffer",
+			sol::call_constructor, sol::constructors<memory_buffer(std::size_t)>());
+	membuffer_type.set_function("resize", &memory_buffer::resize);
+	membuffer_type.set_function("read_i8", &memory_buffer::read<s8>);
+	membuffer_type.set_function("read_u8", &memory_buffer::read<u8>);
+	membuffer_type.set_function("read_i16", &memory_buffer::read<s16>);
+	membuffer_type.set_function("read_u16", &memory_buffer::read<u16>);
+	membuffer_type.set_function("read_i32", &memory_buffer::read<s32>);
+	membuffer_type.set_function("read_u32", &memory_buffer::read<u32>);
+	membuffer_type.set_function("read", &memory_buffer::view);
+	membuffer_type["size"] = sol::property(&memory_buffer::size);
+
+
 	auto addr_space_type = sol().registry().new_usertype<addr_space>("addr_space", sol::no_constructor);
 	addr_space_type.set_function(sol::meta_function::to_string,
 			[] (addr_space const &sp)
@@ -647,6 +805,39 @@ void lua_engine::initialize_memory(sol::table &emu)
 				luaL_pushresultsize(&buff, byte_count);
 				return sol::make_reference(s, sol::stack_reference(s, -1));
 			});
+	addr_space_type.set_function("read_range_into",
+			[] (addr_space &sp, sol::this_state s, memory_buffer &buf, u64 first, u64 last, sol::object opt_dest) -> std::size_t
+			{
+				offs_t const space_size = sp.space.addrmask();
+				if ((first > space_size) || (last > space_size) || (last < first))
+				{
+					luaL_error(s, "Invalid offset");
+					return 0;
+				}
+
+				std::size_t const length = last - first + 1;
+				u8 *dest = buf.prepare(opt_dest.is<std::size_t>() ? opt_dest.as<std::size_t>() : 0, length);
+
+				// copy directly mapped memory in blocks, and read anything else a byte at a time
+				bool const direct = (sp.space.data_width() == 8) && !sp.space.addr_shift();
+				for (u64 addr = first; addr <= last; )
+				{
+					u64 const end = std::min<u64>(last, addr | 0xff);
+					u8 const *const start = direct ? reinterpret_cast<u8 const *>(sp.space.get_read_ptr(addr)) : nullptr;
+					if (start && (reinterpret_cast<u8 const *>(sp.space.get_read_ptr(end)) == (start + (end - addr))))
+					{
+						std::memcpy(dest, start, end - addr + 1);
+						dest += end - addr + 1;
+					}
+					else
+					{
+						for (u64 i = addr; i <= end; ++i)
+							*dest++ = sp.mem_read<u8>(i);
+					}
+					addr = end + 1;
+				}
+				return length;
+			});
 	addr_space_type.set_function("add_change_notifier",
 			[this] (addr_space &sp, sol::protected_function &&cb)
 			{
@@ -751,6 +942,17 @@ void lua_engine::initialize_memory(sol::table &emu)
 				buf.push();
 				return sol::make_reference(s, sol::stack_reference(s, -1));
 			});
+	region_type.set_function(
+			"read_into",
+			[] (memory_region &region, memory_buffer &buf, offs_t offset, offs_t length, sol::object opt_dest) -> offs_t
+			{
+				const offs_t limit = std::min<offs_t>(region.bytes(), offset + length);
+				const offs_t copyable = (limit > offset) ? (limit - offset) : 0;
+				u8 *const dest = buf.prepare(opt_dest.is<std::size_t>() ? opt_dest.as<std::size_t>() : 0, copyable);
+				if (copyable)
+					std::memcpy(dest, &region.as_u8(offset), copyable);
+				return copyable;
+			});
 	region_type.set_function("read_i8", &region_read<s8>);
 	region_type.set_function("read_u8", &region_read<u8>);
 	region_type.set_function("read_i16", &region_read<s16>);
@@ -776,6 +978,17 @@ void lua_engine::initialize_memory(sol::table &emu)
 
 
 	auto share_type = sol().registry().new_usertype<memory_share>("share", sol::no_constructor);
+	share_type.set_function(
+			"read_into",
+			[] (memory_share &share, memory_buffer &buf, offs_t offset, offs_t length, sol::object opt_dest) -> offs_t
+			{
+				const offs_t limit = std::min<offs_t>(share.bytes(), offset + length);
+				const offs_t copyable = (limit > offset) ? (limit - offset) : 0;
+				u8 *const dest = buf.prepare(opt_dest.is<std::size_t>() ? opt_dest.as<std::size_t>() : 0, copyable);
+				if (copyable)
+					std::memcpy(dest, reinterpret_cast<u8 const *>(share.ptr()) + offset, copyable);
+				return copyable;
+			});
 	share_type.set_function("read_i8", &share_read<s8>);
 	share_type.set_function("read_u8", &share_read<u8>);
 	share_type.set_function("read_i16", &share_read<s16>);
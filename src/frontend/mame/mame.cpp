@@ -16,6 +16,7 @@
 #include "ui/simpleselgame.h"
 #include "ui/ui.h"
 
+#include "batchrun.h"
 #include "cheat.h"
 #include "clifront.h"
 #include "emuopts.h"
@@ -31,7 +32,9 @@
 
 #include "osdepend.h"
 
+#include <algorithm>
 #include <ctime>
+#include <tuple>
 
 
 //**************************************************************************
@@ -63,6 +66,8 @@ mame_machine_manager::mame_machine_manager(emu_options &options,osd_interface &o
 	m_lua(std::make_unique<lua_engine>()),
 	m_new_driver_pending(nullptr),
 	m_firstrun(true),
+	m_batch_stop_frame(0),
+	m_batch_frame(0),
 	m_autoboot_timer(nullptr)
 {
 }
@@ -138,6 +143,8 @@ void mame_machine_manager::start_luaengine()
 {
 	if (options().plugins())
 	{
+		auto const trace(g_startup_trace.phase("plugins", "scan plugins"));
+
 		// scan all plugin directories
 		path_iterator iter(options().plugins_path());
 		std::string pluginpath;
@@ -193,9 +200,13 @@ void mame_machine_manager::start_luaengine()
 		p->m_start = true;
 	}
 
-	m_lua->initialize();
+	{
+		auto const trace(g_startup_trace.phase("plugins", "initialize Lua engine"));
+		m_lua->initialize();
+	}
 
 	{
+		auto const trace(g_startup_trace.phase("plugins", "run boot.lua"));
 		emu_file file(options().plugins_path(), OPEN_FLAG_READ);
 		std::error_condition const filerr = file.open("boot.lua");
 		if (!filerr)
@@ -234,6 +245,10 @@ void mame_machine_manager::start_luaengine()
 
 int mame_machine_manager::execute()
 {
+	// a batch file replaces the system on the command line
+	if (*m_options.batch())
+		return execute_batch(m_options.batch());
+
 	bool started_empty = false;
 
 	bool firstgame = true;
@@ -257,36 +272,10 @@ int mame_machine_manager::execute()
 
 		firstgame = false;
 
-		// parse any INI files as the first thing
-		if (m_options.read_config())
-		{
-			// but first, revert out any potential game-specific INI settings from previous runs via the internal UI
-			m_options.revert(OPTION_PRIORITY_INI);
-
-			std::ostringstream errors;
-			mame_options::parse_standard_inis(m_options, errors, system);
-		}
-
-		// otherwise, perform validity checks before anything else
-		bool is_empty = (system == &GAME_NAME(___empty));
-		if (!is_empty)
-		{
-			validity_checker valid(m_options, true);
-			valid.set_verbose(false);
-			valid.check_shared_source(*system);
-		}
-
-		// create the machine configuration
-		machine_config config(*system, m_options);
-
-		// create the machine structure and driver
-		running_machine machine(config, *this);
-
-		set_machine(&machine);
-
 		// run the machine
-		error = machine.run(is_empty);
-		m_firstrun = false;
+		bool const is_empty = (system == &GAME_NAME(___empty));
+		bool machine_exit_pending;
+		error = run_system(*system, machine_exit_pending);
 
 		// check the state of the machine
 		if (m_new_driver_pending)
@@ -297,23 +286,172 @@ int mame_machine_manager::execute()
 		}
 		else
 		{
-			if (machine.exit_pending())
+			if (machine_exit_pending)
 			{
 				m_options.set_system_name("");
 				m_options.set_value(OPTION_BIOS, "", OPTION_PRIORITY_CMDLINE);
 			}
 		}
 
-		if (machine.exit_pending() && (!started_empty || is_empty))
+		if (machine_exit_pending && (!started_empty || is_empty))
 			exit_pending = true;
-
-		// machine will go away when we exit scope
-		set_machine(nullptr);
 	}
 	// return an error
 	return error;
 }
 
+
+//-------------------------------------------------
+//  run_system - create and run a machine for the
+//  specified system until it exits
+//-------------------------------------------------
+
+int mame_machine_manager::run_system(const game_driver &system, bool &exit_pending)
+{
+	// parse any INI files as the first thing
+	if (m_options.read_config())
+	{
+		// but first, revert out any potential game-specific INI settings from previous runs via the internal UI
+		m_options.revert(OPTION_PRIORITY_INI);
+
+		std::ostringstream errors;
+		mame_options::parse_standard_inis(m_options, errors, &system);
+	}
+
+	// otherwise, perform validity checks before anything else
+	bool const is_empty = (&system == &GAME_NAME(___empty));
+	if (!is_empty)
+	{
+		auto const trace(g_startup_trace.phase("validity", "validate %s", system.name));
+		validity_checker valid(m_options, true);
+		valid.set_verbose(false);
+		valid.check_shared_source(system);
+	}
+
+	// create the machine configuration
+	osd_ticks_t const configstart(osd_ticks());
+	machine_config config(system, m_options);
+	if (g_startup_trace.enabled())
+		g_startup_trace.add("config", "construct machine configuration", configstart, osd_ticks());
+
+	// create the machine structure and driver
+	running_machine machine(config, *this);
+
+	set_machine(&machine);
+
+	// count frames if we're asked to stop after a number of them
+	if (m_batch_stop_frame)
+	{
+		m_batch_frame = 0;
+		machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&mame_machine_manager::batch_frame, this));
+	}
+
+	// run the machine
+	int const error = machine.run(is_empty);
+	m_firstrun = false;
+	exit_pending = machine.exit_pending();
+
+	// machine will go away when we exit scope
+	set_machine(nullptr);
+	return error;
+}
+
+
+//-------------------------------------------------
+//  execute_batch - run each job in a batch file
+//  in turn, sharing the driver list, Lua engine,
+//  plugins and caches between them
+//-------------------------------------------------
+
+int mame_machine_manager::execute_batch(std::string_view filename)
+{
+	std::vector<batch_job> jobs;
+	std::ostringstream errors;
+	if (!load_batch_jobs(filename, jobs, errors))
+		throw emu_fatalerror(EMU_ERR_INVALID_CONFIG, "Unable to read batch file %s", filename);
+	if (errors.tellp() > 0)
+		osd_printf_error("%s", errors.str());
+
+	// every job starts from the options as they were on the command line
+	std::vector<std::tuple<std::string, std::string, int> > baseline;
+	for (core_options::entry::shared_ptr const &entry : m_options.entries())
+	{
+		if ((entry->type() != core_options::option_type::HEADER) && (entry->type() != core_options::option_type::COMMAND))
+			baseline.emplace_back(entry->name(), entry->value_unsubstituted() ? entry->value_unsubstituted() : "", entry->priority());
+	}
+
+	int worst = EMU_ERR_NONE;
+	std::vector<std::pair<batch_job const *, int> > results;
+	for (batch_job const &job : jobs)
+	{
+		// restore the command line options and apply the job's own
+		m_options.set_system_name("");
+		for (auto const &[name, value, priority] : baseline)
+		{
+			core_options::entry::shared_ptr const entry(m_options.get_entry(name));
+			if (entry)
+				entry->set_value(std::string(value), priority, true);
+		}
+
+		int error = EMU_ERR_NONE;
+		game_driver const *system = nullptr;
+		try
+		{
+			std::vector<std::string> args{ "batch", job.system };
+			args.insert(args.end(), job.arguments.begin(), job.arguments.end());
+			m_options.parse_command_line(args, OPTION_PRIORITY_CMDLINE);
+			system = mame_options::system(m_options);
+			if (!system)
+			{
+				osd_printf_error("%s:%u: unknown system '%s'\n", filename, job.line, job.system);
+				error = EMU_ERR_NO_SUCH_SYSTEM;
+			}
+		}
+		catch (options_warning_exception &ex)
+		{
+			osd_printf_error("%s:%u: %s", filename, job.line, ex.message());
+			system = mame_options::system(m_options);
+		}
+		catch (options_exception &ex)
+		{
+			osd_printf_error("%s:%u: %s", filename, job.line, ex.message());
+			error = EMU_ERR_INVALID_CONFIG;
+		}
+
+		// run the job; requests to switch systems just end it
+		if (system)
+		{
+			m_new_driver_pending = nullptr;
+			m_firstrun = true;
+			m_batch_stop_frame = job.stop_frame;
+			bool exit_pending;
+			error = run_system(*system, exit_pending);
+			m_batch_stop_frame = 0;
+		}
+
+		results.emplace_back(&job, error);
+		worst = std::max(worst, error);
+	}
+
+	// summarise what happened
+	for (auto const &[job, error] : results)
+		osd_printf_info("%s:%u: %s %s (%d)\n", filename, job->line, job->system, (EMU_ERR_NONE == error) ? "ok" : "failed", error);
+
+	return worst;
+}
+
+
+//-------------------------------------------------
+//  batch_frame - stop a batch job once it has run
+//  for the requested number of frames
+//-------------------------------------------------
+
+void mame_machine_manager::batch_frame()
+{
+	if (++m_batch_frame == m_batch_stop_frame)
+		machine()->schedule_exit();
+}
+
 TIMER_CALLBACK_MEMBER(mame_machine_manager::autoboot_callback)
 {
 	if (*options().autoboot_script())
@@ -79,11 +79,17 @@ private:
 	mame_machine_manager &operator=(mame_machine_manager const &) = delete;
 	mame_machine_manager &operator=(mame_machine_manager &&) = delete;
 
+	int run_system(const game_driver &system, bool &exit_pending);
+	int execute_batch(std::string_view filename);
+	void batch_frame();
+
 	std::unique_ptr<plugin_options>    m_plugins;           // pointer to plugin options
 	std::unique_ptr<lua_engine>        m_lua;
 
 	const game_driver *     m_new_driver_pending;           // pointer to the next pending driver
 	bool                    m_firstrun;
+	u64                     m_batch_stop_frame;             // frames to run the current batch job for
+	u64                     m_batch_frame;                  // frames run by the current batch job
 
 	emu_timer *                        m_autoboot_timer;    // auto-boot timer
 	std::unique_ptr<sol::load_result>  m_autoboot_script;   // auto-boot script
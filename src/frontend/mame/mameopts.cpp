@@ -26,9 +26,27 @@
 #include "zippath.h"
 
 #include <cctype>
+#include <map>
+#include <mutex>
 #include <stack>
 
 
+namespace {
+
+// INIs already read, by full path; the UI parses the same set for every system it previews
+struct cached_ini
+{
+	std::uint64_t                                       size;
+	std::chrono::system_clock::time_point               modified;
+	std::shared_ptr<core_options::parsed_ini const>     ini;
+};
+
+std::mutex s_ini_cache_mutex;
+std::map<std::string, cached_ini, std::less<> > s_ini_cache;
+
+} // anonymous namespace
+
+
 //-------------------------------------------------
 //  parse_standard_inis - parse the standard set
 //  of INI files
@@ -36,6 +54,10 @@
 
 void mame_options::parse_standard_inis(emu_options &options, std::ostream &error_stream, const game_driver *driver)
 {
+	// most of the INIs looked for don't exist; pick up files added since the last time
+	if (options.path_cache())
+		path_listing_cache::get().revalidate();
+
 	// parse the INI file defined by the platform (e.g., "mame.ini")
 	// we do this twice so that the first file can change the INI path
 	parse_one_ini(options, emulator_info::get_configname(), OPTION_PRIORITY_MAME_INI);
@@ -121,16 +143,37 @@ void mame_options::parse_one_ini(emu_options &options, const char *basename, int
 
 	// open the file; if we fail, that's ok
 	emu_file file(options.ini_path(), OPEN_FLAG_READ);
+	if (options.path_cache())
+		file.set_path_cache(&path_listing_cache::get());
 	osd_printf_verbose("Attempting load of %s.ini\n", basename);
 	std::error_condition const filerr = file.open(std::string(basename) + ".ini");
 	if (filerr)
 		return;
 
-	// parse the file
-	osd_printf_verbose("Parsing %s.ini\n", basename);
+	// reuse the names and values from last time if the file hasn't changed
+	std::shared_ptr<core_options::parsed_ini const> ini;
+	std::unique_ptr<osd::directory::entry> const stat(osd_stat(file.fullpath()));
+	{
+		std::lock_guard<std::mutex> lock(s_ini_cache_mutex);
+		auto const found = s_ini_cache.find(file.fullpath());
+		if (stat && (found != s_ini_cache.end()) && (found->second.size == stat->size) && (found->second.modified == stat->last_modified))
+			ini = found->second.ini;
+	}
+	if (!ini)
+	{
+		osd_printf_verbose("Parsing %s.ini\n", basename);
+		ini = std::make_shared<core_options::parsed_ini const>((util::core_file &)file);
+		if (stat)
+		{
+			std::lock_guard<std::mutex> lock(s_ini_cache_mutex);
+			s_ini_cache.insert_or_assign(file.fullpath(), cached_ini{ stat->size, stat->last_modified, ini });
+		}
+	}
+
+	// apply it
 	try
 	{
-		options.parse_ini_file((util::core_file&)file, priority, priority < OPTION_PRIORITY_DRIVER_INI, false);
+		options.apply_ini(*ini, priority, priority < OPTION_PRIORITY_DRIVER_INI, false);
 	}
 	catch (options_exception &ex)
 	{
@@ -17,44 +17,56 @@
 #include "path.h"
 #include "unzip.h"
 
+#include <algorithm>
+#include <atomic>
+
 
 //**************************************************************************
 //  MEDIA IDENTIFIER
 //**************************************************************************
 
-void media_identifier::file_info::match(
-		device_t const &device,
-		romload::file const &rom,
-		util::hash_collection const &hashes)
+namespace {
+
+// a raw file hashed on the work queue; results are retired in collection order
+struct digest_job
 {
-	if (hashes == m_hashes)
-	{
-		m_matches.emplace_back(
-				device.shortname(),
-				device.name(),
-				rom.get_name(),
-				hashes.flag(util::hash_collection::FLAG_BAD_DUMP),
-				device.owner());
-	}
+	std::string path;
+	std::uint64_t length = 0;
+	util::hash_collection hashes;
+	char const *failure = nullptr;
+	std::error_condition err;
+	std::atomic<bool> done = false;
+};
+
+
+char const *digest_raw(char const *path, std::uint64_t &length, util::hash_collection &hashes, std::error_condition &err)
+{
+	// load the file and process if it opens and has a valid length
+	util::core_file::ptr file;
+	err = util::core_file::open(path, OPEN_FLAG_READ, file);
+	if (err || !file)
+		return "error opening file";
+	err = file->length(length);
+	if (err)
+		return "error getting file length";
+	std::size_t actual;
+	err = hashes.compute(*file, 0U, length, actual, util::hash_collection::HASH_TYPES_CRC_SHA1);
+	if (err)
+		return "error reading file";
+	return nullptr;
 }
 
-void media_identifier::file_info::match(
-		std::string const &list,
-		software_info const &software,
-		rom_entry const &rom,
-		util::hash_collection const &hashes)
+
+void *digest_job_callback(void *param, int threadid)
 {
-	if (hashes == m_hashes)
-	{
-		m_matches.emplace_back(
-				util::string_format("%s:%s", list, software.shortname()),
-				std::string(software.longname()),
-				std::string(rom.name()),
-				hashes.flag(util::hash_collection::FLAG_BAD_DUMP),
-				false);
-	}
+	digest_job &job(*reinterpret_cast<digest_job *>(param));
+	job.failure = digest_raw(job.path.c_str(), job.length, job.hashes, job.err);
+	job.done.store(true, std::memory_order_release);
+	return nullptr;
 }
 
+} // anonymous namespace
+
 
 //-------------------------------------------------
 //  media_identifier - constructor
@@ -65,6 +77,7 @@ media_identifier::media_identifier(emu_options &options)
 	, m_total(0)
 	, m_matches(0)
 	, m_nonroms(0)
+	, m_indexed(false)
 {
 }
 
@@ -77,7 +90,9 @@ media_identifier::media_identifier(emu_options &options)
 void media_identifier::identify(const char *filename)
 {
 	std::vector<file_info> info;
-	collect_files(info, filename);
+	std::vector<std::size_t> deferred;
+	collect_files(info, filename, &deferred);
+	digest_deferred(info, deferred);
 	match_hashes(info);
 	print_results(info);
 }
@@ -118,7 +133,7 @@ void media_identifier::identify_data(const char *name, const uint8_t *data, std:
 //  identification
 //-------------------------------------------------
 
-void media_identifier::collect_files(std::vector<file_info> &info, char const *path)
+void media_identifier::collect_files(std::vector<file_info> &info, char const *path, std::vector<std::size_t> *deferred)
 {
 	// first try to open as a directory
 	osd::directory::ptr const directory = osd::directory::open(path);
@@ -130,7 +145,7 @@ void media_identifier::collect_files(std::vector<file_info> &info, char const *p
 			if (entry->type == osd::directory::entry::entry_type::FILE)
 			{
 				std::string const curfile = std::string(path).append(PATH_SEPARATOR).append(entry->name);
-				collect_files(info, curfile.c_str());
+				collect_files(info, curfile.c_str(), deferred);
 			}
 		}
 	}
@@ -192,7 +207,7 @@ void media_identifier::collect_files(std::vector<file_info> &info, char const *p
 	else
 	{
 		// otherwise, identify as a raw file
-		digest_file(info, path);
+		digest_file(info, path, deferred);
 	}
 }
 
@@ -202,7 +217,7 @@ void media_identifier::collect_files(std::vector<file_info> &info, char const *p
 //  file
 //-------------------------------------------------
 
-void media_identifier::digest_file(std::vector<file_info> &info, char const *path)
+void media_identifier::digest_file(std::vector<file_info> &info, char const *path, std::vector<std::size_t> *deferred)
 {
 	// CHD files need to be parsed and their hashes extracted from the header
 	if (core_filename_ends_with(path, ".chd"))
@@ -259,27 +274,21 @@ void media_identifier::digest_file(std::vector<file_info> &info, char const *pat
 			}
 		}
 
-		// load the file and process if it opens and has a valid length
-		util::core_file::ptr file;
-		std::error_condition err = util::core_file::open(path, OPEN_FLAG_READ, file);
-		if (err || !file)
+		// hashing raw files can be deferred so they're processed in parallel
+		if (deferred)
 		{
-			osd_printf_error("%s: error opening file (%s)\n", path, err ? err.message() : std::string("could not allocate pointer"));
+			deferred->emplace_back(info.size());
+			info.emplace_back(path, 0U, util::hash_collection(), file_flavour::RAW);
 			return;
 		}
+
 		std::uint64_t length;
-		err = file->length(length);
-		if (err)
-		{
-			osd_printf_error("%s: error getting file length (%s)\n", path, err.message());
-			return;
-		}
 		util::hash_collection hashes;
-		std::size_t actual;
-		err = hashes.compute(*file, 0U, length, actual, util::hash_collection::HASH_TYPES_CRC_SHA1);
-		if (err)
+		std::error_condition err;
+		char const *const failure = digest_raw(path, length, hashes, err);
+		if (failure)
 		{
-			osd_printf_error("%s: error reading file (%s)\n", path, err.message());
+			osd_printf_error("%s: %s (%s)\n", path, failure, err ? err.message() : std::string("could not allocate pointer"));
 			return;
 		}
 		info.emplace_back(path, length, std::move(hashes), file_flavour::RAW);
@@ -326,17 +335,94 @@ void media_identifier::digest_data(std::vector<file_info> &info, char const *nam
 
 
 //-------------------------------------------------
-//  match_hashes - find known dumps that mach
-//  collected hashes
+//  digest_deferred - hash raw files on the work
+//  queue while known dumps are indexed
 //-------------------------------------------------
 
-void media_identifier::match_hashes(std::vector<file_info> &info)
+void media_identifier::digest_deferred(std::vector<file_info> &info, std::vector<std::size_t> const &deferred)
 {
-	if (info.empty())
+	std::vector<digest_job> jobs(deferred.size());
+	for (std::size_t i = 0; deferred.size() > i; ++i)
+		jobs[i].path = info[deferred[i]].name();
+
+	osd_work_queue *queue = (1U < jobs.size()) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	if (queue && !osd_work_item_queue_multiple(queue, &digest_job_callback, jobs.size(), jobs.data(), sizeof(jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE))
+	{
+		osd_work_queue_free(queue);
+		queue = nullptr;
+	}
+
+	// the index doesn't depend on the files, so build it while they're read
+	if (!jobs.empty())
+		index_dumps();
+
+	// retire in collection order, dropping files that couldn't be read
+	std::vector<bool> failed(info.size(), false);
+	for (std::size_t i = 0; jobs.size() > i; ++i)
+	{
+		digest_job &job(jobs[i]);
+		if (!queue)
+			digest_job_callback(&job, 0);
+		else
+			while (!job.done.load(std::memory_order_acquire))
+				osd_work_queue_wait(queue, osd_ticks_per_second() / 100);
+
+		if (job.failure)
+		{
+			osd_printf_error("%s: %s (%s)\n", job.path, job.failure, job.err ? job.err.message() : std::string("could not allocate pointer"));
+			failed[deferred[i]] = true;
+		}
+		else
+		{
+			info[deferred[i]].set_digest(job.length, job.hashes);
+			m_total++;
+		}
+	}
+
+	if (queue)
+		osd_work_queue_free(queue);
+
+	std::size_t kept = 0;
+	for (std::size_t i = 0; info.size() > i; ++i)
+	{
+		if (!failed[i])
+		{
+			if (kept != i)
+				info[kept] = std::move(info[i]);
+			++kept;
+		}
+	}
+	info.erase(info.begin() + kept, info.end());
+}
+
+
+//-------------------------------------------------
+//  index_dumps - collect known dumps from every
+//  system, device and software list, keyed by
+//  CRC and SHA1
+//-------------------------------------------------
+
+void media_identifier::index_dumps()
+{
+	if (m_indexed)
 		return;
 
-	auto match_device =
-			[&info, listnames = std::unordered_set<std::string>()] (device_t &device) mutable
+	auto const add_dump =
+			[this] (util::hash_collection const &hashes, match_data &&match)
+			{
+				std::size_t const index = m_dumps.size();
+				m_dumps.emplace_back(known_dump{ hashes, std::move(match) });
+
+				u32 crc;
+				util::sha1_t sha1;
+				if (hashes.crc(crc))
+					m_dump_crcs.emplace(crc, index);
+				if (hashes.sha1(sha1))
+					m_dump_sha1s.emplace(std::string(reinterpret_cast<char const *>(sha1.m_raw), sizeof(sha1.m_raw)), index);
+			};
+
+	auto index_device =
+			[&add_dump, listnames = std::unordered_set<std::string>()] (device_t &device) mutable
 			{
 				// iterate over regions and files within the region
 				for (romload::region const &region : romload::entries(device.rom_region()).get_regions())
@@ -346,8 +432,14 @@ void media_identifier::match_hashes(std::vector<file_info> &info)
 						util::hash_collection const romhashes(rom.get_hashdata());
 						if (!romhashes.flag(util::hash_collection::FLAG_NO_DUMP))
 						{
-							for (file_info &file : info)
-								file.match(device, rom, romhashes);
+							add_dump(
+									romhashes,
+									match_data(
+										device.shortname(),
+										device.name(),
+										rom.get_name(),
+										romhashes.flag(util::hash_collection::FLAG_BAD_DUMP),
+										device.owner()));
 						}
 					}
 				}
@@ -369,8 +461,14 @@ void media_identifier::match_hashes(std::vector<file_info> &info)
 									util::hash_collection romhashes(rom->hashdata());
 									if (!romhashes.flag(util::hash_collection::FLAG_NO_DUMP))
 									{
-										for (file_info &file : info)
-											file.match(swlistdev.list_name(), swinfo, *rom, romhashes);
+										add_dump(
+												romhashes,
+												match_data(
+													util::string_format("%s:%s", swlistdev.list_name(), swinfo.shortname()),
+													std::string(swinfo.longname()),
+													std::string(rom->name()),
+													romhashes.flag(util::hash_collection::FLAG_BAD_DUMP),
+													false));
 									}
 								}
 							}
@@ -382,16 +480,63 @@ void media_identifier::match_hashes(std::vector<file_info> &info)
 	// iterate over drivers
 	m_drivlist.reset();
 	while (m_drivlist.next())
-		match_device(m_drivlist.config()->root_device());
+		index_device(m_drivlist.config()->root_device());
 
 	// iterator over registered device types
 	machine_config config(GAME_NAME(___empty), m_drivlist.options());
 	machine_config::token const tok(config.begin_configuration(config.root_device()));
 	for (device_type type : registered_device_types)
 	{
-		match_device(*config.device_add("_tmp", type, 0));
+		index_device(*config.device_add("_tmp", type, 0));
 		config.device_remove("_tmp");
 	}
+
+	m_indexed = true;
+}
+
+
+//-------------------------------------------------
+//  match_hashes - find known dumps that mach
+//  collected hashes
+//-------------------------------------------------
+
+void media_identifier::match_hashes(std::vector<file_info> &info)
+{
+	if (info.empty())
+		return;
+
+	index_dumps();
+
+	std::vector<std::size_t> candidates;
+	for (file_info &file : info)
+	{
+		// anything that matches must share at least one hash type
+		candidates.clear();
+		u32 crc;
+		util::sha1_t sha1;
+		if (file.hashes().crc(crc))
+		{
+			auto const range(m_dump_crcs.equal_range(crc));
+			for (auto it = range.first; range.second != it; ++it)
+				candidates.emplace_back(it->second);
+		}
+		if (file.hashes().sha1(sha1))
+		{
+			auto const range(m_dump_sha1s.equal_range(std::string(reinterpret_cast<char const *>(sha1.m_raw), sizeof(sha1.m_raw))));
+			for (auto it = range.first; range.second != it; ++it)
+				candidates.emplace_back(it->second);
+		}
+
+		// report matches in the order the dumps were found, once each
+		std::sort(candidates.begin(), candidates.end());
+		candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+		for (std::size_t candidate : candidates)
+		{
+			known_dump const &dump(m_dumps[candidate]);
+			if (dump.hashes == file.hashes())
+				file.add_match(dump.match);
+		}
+	}
 }
 
 
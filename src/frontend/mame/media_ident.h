@@ -13,6 +13,8 @@
 #include "drivenum.h"
 #include "romload.h"
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -105,8 +107,8 @@ private:
 		file_flavour flavour() const { return m_flavour; }
 		std::vector<match_data> const &matches() const { return m_matches; }
 
-		void match(device_t const &device, romload::file const &rom, util::hash_collection const &hashes);
-		void match(std::string const &list, software_info const &software, rom_entry const &rom, util::hash_collection const &hashes);
+		void set_digest(std::uint64_t length, util::hash_collection const &hashes) { m_length = length; m_hashes = hashes; }
+		void add_match(match_data const &match) { m_matches.emplace_back(match); }
 
 	private:
 		std::string             m_name;
@@ -116,9 +118,17 @@ private:
 		std::vector<match_data> m_matches;
 	};
 
-	void collect_files(std::vector<file_info> &info, char const *path);
-	void digest_file(std::vector<file_info> &info, char const *path);
+	struct known_dump
+	{
+		util::hash_collection   hashes;
+		match_data              match;
+	};
+
+	void collect_files(std::vector<file_info> &info, char const *path, std::vector<std::size_t> *deferred);
+	void digest_file(std::vector<file_info> &info, char const *path, std::vector<std::size_t> *deferred = nullptr);
 	void digest_data(std::vector<file_info> &info, char const *name, void const *data, std::uint64_t length);
+	void digest_deferred(std::vector<file_info> &info, std::vector<std::size_t> const &deferred);
+	void index_dumps();
 	void match_hashes(std::vector<file_info> &info);
 	void print_results(std::vector<file_info> const &info);
 
@@ -126,6 +136,13 @@ private:
 	unsigned                m_total;
 	unsigned                m_matches;
 	unsigned                m_nonroms;
+
+	// known dumps from every system, device and software list, built once
+	// and kept so identifying more files only needs lookups
+	bool                                                m_indexed;
+	std::vector<known_dump>                             m_dumps;
+	std::unordered_multimap<std::uint32_t, std::size_t> m_dump_crcs;
+	std::unordered_multimap<std::string, std::size_t>   m_dump_sha1s;
 };
 
 
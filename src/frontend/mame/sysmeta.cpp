@@ -0,0 +1,398 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    sysmeta.cpp
+
+    Cached system device tree metadata.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "sysmeta.h"
+
+#include "emuopts.h"
+#include "main.h"
+#include "romload.h"
+#include "speaker.h"
+
+#include "corefile.h"
+#include "multibyte.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+
+//**************************************************************************
+//  SYSTEM METADATA
+//**************************************************************************
+
+//-------------------------------------------------
+//  system_metadata - constructors
+//-------------------------------------------------
+
+system_metadata::system_metadata()
+	: m_flags(::machine_flags::type(0))
+	, m_unemulated_features(device_t::feature::NONE)
+	, m_imperfect_features(device_t::feature::NONE)
+	, m_has_bioses(false)
+	, m_has_dips(false)
+	, m_has_configs(false)
+	, m_has_keyboard(false)
+	, m_has_test_switch(false)
+	, m_has_analog(false)
+{
+}
+
+system_metadata::system_metadata(machine_config const &config, ioport_list const *ports)
+	: m_flags(config.gamedrv().flags)
+	, m_unemulated_features(config.gamedrv().type.unemulated_features())
+	, m_imperfect_features(config.gamedrv().type.imperfect_features())
+	, m_has_bioses(false)
+	, m_has_dips(false)
+	, m_has_configs(false)
+	, m_has_keyboard(false)
+	, m_has_test_switch(false)
+	, m_has_analog(false)
+{
+	ioport_list local_ports;
+	std::string sink;
+	for (device_t &device : device_enumerator(config.root_device()))
+	{
+		// the "no sound hardware" warning doesn't make sense when you plug in a sound card
+		if (dynamic_cast<speaker_device *>(&device))
+			m_flags &= ~::machine_flags::NO_SOUND_HW;
+
+		// build overall emulation status
+		m_unemulated_features |= device.type().unemulated_features();
+		m_imperfect_features |= device.type().imperfect_features();
+
+		// look for BIOS options
+		device_t const *const parent(device.owner());
+		device_slot_interface const *const slot(dynamic_cast<device_slot_interface const *>(parent));
+		if (!parent || (slot && (slot->get_card_device() == &device)))
+		{
+			for (tiny_rom_entry const *rom = device.rom_region(); !m_has_bioses && rom && !ROMENTRY_ISEND(rom); ++rom)
+			{
+				if (ROMENTRY_ISSYSTEM_BIOS(rom))
+					m_has_bioses = true;
+			}
+		}
+
+		// if we don't have ports passed in, build here
+		if (!ports)
+			local_ports.append(device, sink);
+
+		// record the device
+		m_devices.emplace_back(device_entry{ device.tag(), device.name(), device.clock() });
+
+		// record user-selectable slot options sorted by name
+		device_slot_interface const *const slotintf(dynamic_cast<device_slot_interface const *>(&device));
+		if (slotintf && !slotintf->fixed())
+		{
+			slot_entry &entry(m_slots.emplace_back(slot_entry{ device.tag(), { } }));
+			for (auto const &option : slotintf->option_list())
+			{
+				if (option.second->selectable())
+					entry.options.emplace_back(slot_option_entry{ option.second->name(), option.second->devtype().fullname() });
+			}
+			std::sort(
+					entry.options.begin(),
+					entry.options.end(),
+					[] (slot_option_entry const &a, slot_option_entry const &b) { return a.name < b.name; });
+		}
+	}
+
+	// unemulated trumps imperfect when aggregating (always be pessimistic)
+	m_imperfect_features &= ~m_unemulated_features;
+
+	// scan the input port array to see what options we need to enable
+	for (ioport_list::value_type const &port : (ports ? *ports : local_ports))
+	{
+		for (ioport_field const &field : port.second->fields())
+		{
+			switch (field.type())
+			{
+			case IPT_DIPSWITCH: m_has_dips = true;          break;
+			case IPT_CONFIG:    m_has_configs = true;       break;
+			case IPT_KEYBOARD:  m_has_keyboard = true;      break;
+			case IPT_SERVICE:   m_has_test_switch = true;   break;
+			default: break;
+			}
+			if (field.is_analog())
+				m_has_analog = true;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  write - append the metadata to a buffer
+//-------------------------------------------------
+
+void system_metadata::write(std::vector<u8> &buffer) const
+{
+	auto const write_u32 =
+			[&buffer] (u32 value)
+			{
+				buffer.resize(buffer.size() + 4);
+				put_u32le(&buffer[buffer.size() - 4], value);
+			};
+	auto const write_string =
+			[&buffer, &write_u32] (std::string_view value)
+			{
+				write_u32(value.length());
+				buffer.insert(buffer.end(), value.begin(), value.end());
+			};
+
+	write_u32(m_flags);
+	write_u32(m_unemulated_features);
+	write_u32(m_imperfect_features);
+	buffer.push_back(
+			(m_has_bioses ? 0x01 : 0x00) |
+			(m_has_dips ? 0x02 : 0x00) |
+			(m_has_configs ? 0x04 : 0x00) |
+			(m_has_keyboard ? 0x08 : 0x00) |
+			(m_has_test_switch ? 0x10 : 0x00) |
+			(m_has_analog ? 0x20 : 0x00));
+
+	write_u32(m_devices.size());
+	for (device_entry const &device : m_devices)
+	{
+		write_string(device.tag);
+		write_string(device.name);
+		write_u32(device.clock);
+	}
+
+	write_u32(m_slots.size());
+	for (slot_entry const &slot : m_slots)
+	{
+		write_string(slot.tag);
+		write_u32(slot.options.size());
+		for (slot_option_entry const &option : slot.options)
+		{
+			write_string(option.name);
+			write_string(option.device_name);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  read - read metadata written by write,
+//  advancing the pointer past it
+//-------------------------------------------------
+
+bool system_metadata::read(u8 const *&ptr, u8 const *end)
+{
+	bool valid = true;
+	auto const read_u32 =
+			[&ptr, end, &valid] () -> u32
+			{
+				if (!valid || ((end - ptr) < 4))
+				{
+					valid = false;
+					return 0;
+				}
+				ptr += 4;
+				return get_u32le(ptr - 4);
+			};
+	auto const read_string =
+			[&ptr, end, &valid, &read_u32] () -> std::string
+			{
+				u32 const length = read_u32();
+				if (!valid || (u32(end - ptr) < length))
+				{
+					valid = false;
+					return std::string();
+				}
+				ptr += length;
+				return std::string(reinterpret_cast<char const *>(ptr - length), length);
+			};
+
+	m_flags = ::machine_flags::type(read_u32());
+	m_unemulated_features = device_t::feature_type(read_u32());
+	m_imperfect_features = device_t::feature_type(read_u32());
+	if (!valid || (end == ptr))
+		return false;
+	u8 const has = *ptr++;
+	m_has_bioses = bool(has & 0x01);
+	m_has_dips = bool(has & 0x02);
+	m_has_configs = bool(has & 0x04);
+	m_has_keyboard = bool(has & 0x08);
+	m_has_test_switch = bool(has & 0x10);
+	m_has_analog = bool(has & 0x20);
+
+	m_devices.clear();
+	for (u32 count = read_u32(); valid && count; --count)
+	{
+		std::string tag = read_string();
+		std::string name = read_string();
+		u32 const clock = read_u32();
+		m_devices.emplace_back(device_entry{ std::move(tag), std::move(name), clock });
+	}
+
+	m_slots.clear();
+	for (u32 count = read_u32(); valid && count; --count)
+	{
+		slot_entry &slot(m_slots.emplace_back(slot_entry{ read_string(), { } }));
+		for (u32 options = read_u32(); valid && options; --options)
+		{
+			std::string name = read_string();
+			std::string device_name = read_string();
+			slot.options.emplace_back(slot_option_entry{ std::move(name), std::move(device_name) });
+		}
+	}
+
+	return valid;
+}
+
+
+
+//**************************************************************************
+//  SYSTEM METADATA STORE
+//**************************************************************************
+
+//-------------------------------------------------
+//  instance - get the process-wide store
+//-------------------------------------------------
+
+system_metadata_store &system_metadata_store::instance()
+{
+	static system_metadata_store s_instance;
+	return s_instance;
+}
+
+
+//-------------------------------------------------
+//  system_metadata_store - constructor
+//-------------------------------------------------
+
+system_metadata_store::system_metadata_store()
+	: m_loaded(true)
+	, m_dirty(false)
+{
+}
+
+
+//-------------------------------------------------
+//  set_filename - set the file the store is kept
+//  in, picking up its entries on next use
+//-------------------------------------------------
+
+void system_metadata_store::set_filename(std::string_view filename)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (filename != m_filename)
+	{
+		// entries already handed out stay valid, so they're kept
+		m_filename = filename;
+		m_loaded = m_filename.empty();
+		m_dirty = !m_entries.empty();
+	}
+}
+
+
+//-------------------------------------------------
+//  get - get metadata for a system, building it
+//  from a clean configuration if necessary
+//-------------------------------------------------
+
+system_metadata const &system_metadata_store::get(game_driver const &driver)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_loaded)
+		load();
+
+	auto found(m_entries.find(driver.name));
+	if (m_entries.end() == found)
+	{
+		emu_options clean_options;
+		machine_config const config(driver, clean_options);
+		found = m_entries.emplace(driver.name, std::make_unique<system_metadata const>(config)).first;
+		m_dirty = true;
+	}
+	return *found->second;
+}
+
+
+//-------------------------------------------------
+//  flush - write the store to its file if
+//  anything was added
+//-------------------------------------------------
+
+void system_metadata_store::flush()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_dirty || m_filename.empty())
+		return;
+
+	// pick up anything already in the file before replacing it
+	if (!m_loaded)
+		load();
+
+	std::vector<u8> buffer(std::begin(MAGIC), std::end(MAGIC));
+	std::string_view const version(emulator_info::get_build_version());
+	buffer.resize(buffer.size() + 4);
+	put_u32le(&buffer[buffer.size() - 4], version.length());
+	buffer.insert(buffer.end(), version.begin(), version.end());
+	for (auto const &entry : m_entries)
+	{
+		buffer.resize(buffer.size() + 4);
+		put_u32le(&buffer[buffer.size() - 4], entry.first.length());
+		buffer.insert(buffer.end(), entry.first.begin(), entry.first.end());
+		entry.second->write(buffer);
+	}
+
+	util::core_file::ptr file;
+	if (!util::core_file::open(m_filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file))
+	{
+		auto const [err, actual] = util::write(*file, buffer.data(), buffer.size());
+		if (!err)
+			m_dirty = false;
+	}
+}
+
+
+//-------------------------------------------------
+//  load - add entries from the file that aren't
+//  already present - device trees depend on
+//  the code, so anything from a different build
+//  is ignored
+//-------------------------------------------------
+
+void system_metadata_store::load()
+{
+	m_loaded = true;
+	std::vector<u8> data;
+	if (util::core_file::load(m_filename, data))
+		return;
+
+	u8 const *ptr = data.data();
+	u8 const *const end = ptr + data.size();
+	std::string_view const version(emulator_info::get_build_version());
+	if ((std::size_t(end - ptr) < (sizeof(MAGIC) + 4)) || !std::equal(std::begin(MAGIC), std::end(MAGIC), ptr))
+		return;
+	ptr += sizeof(MAGIC);
+	u32 const versionlen = get_u32le(ptr);
+	ptr += 4;
+	if ((versionlen != version.length()) || (std::size_t(end - ptr) < versionlen) || (std::string_view(reinterpret_cast<char const *>(ptr), versionlen) != version))
+		return;
+	ptr += versionlen;
+
+	while ((end - ptr) >= 4)
+	{
+		u32 const namelen = get_u32le(ptr);
+		ptr += 4;
+		if (std::size_t(end - ptr) < namelen)
+			return;
+		std::string name(reinterpret_cast<char const *>(ptr), namelen);
+		ptr += namelen;
+
+		auto metadata(std::make_unique<system_metadata>());
+		if (!metadata->read(ptr, end))
+			return;
+		m_entries.try_emplace(std::move(name), std::move(metadata));
+	}
+}
@@ -0,0 +1,123 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    sysmeta.h
+
+    Cached system device tree metadata.
+
+***************************************************************************/
+#ifndef MAME_FRONTEND_SYSMETA_H
+#define MAME_FRONTEND_SYSMETA_H
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// system_metadata holds what the frontend needs to know about a system's
+// default configuration without keeping the devices around
+class system_metadata
+{
+public:
+	struct device_entry
+	{
+		std::string tag;
+		std::string name;
+		u32         clock;
+	};
+
+	struct slot_option_entry
+	{
+		std::string name;
+		std::string device_name;
+	};
+
+	struct slot_entry
+	{
+		std::string                     tag;
+		std::vector<slot_option_entry>  options;    // user-selectable options only
+	};
+
+	// construction
+	system_metadata();
+	system_metadata(machine_config const &config, ioport_list const *ports = nullptr);
+
+	// overall emulation status
+	::machine_flags::type machine_flags() const { return m_flags; }
+	device_t::feature_type unemulated_features() const { return m_unemulated_features; }
+	device_t::feature_type imperfect_features() const { return m_imperfect_features; }
+
+	// has... getters
+	bool has_bioses() const { return m_has_bioses; }
+	bool has_dips() const { return m_has_dips; }
+	bool has_configs() const { return m_has_configs; }
+	bool has_keyboard() const { return m_has_keyboard; }
+	bool has_test_switch() const { return m_has_test_switch; }
+	bool has_analog() const { return m_has_analog; }
+
+	// device tree
+	std::vector<device_entry> const &devices() const { return m_devices; }
+	std::vector<slot_entry> const &slots() const { return m_slots; }
+
+	// serialisation
+	void write(std::vector<u8> &buffer) const;
+	bool read(u8 const *&ptr, u8 const *end);
+
+private:
+	// overall feature status
+	::machine_flags::type       m_flags;
+	device_t::feature_type      m_unemulated_features;
+	device_t::feature_type      m_imperfect_features;
+
+	// has...
+	bool                        m_has_bioses;
+	bool                        m_has_dips;
+	bool                        m_has_configs;
+	bool                        m_has_keyboard;
+	bool                        m_has_test_switch;
+	bool                        m_has_analog;
+
+	// device tree in enumeration order
+	std::vector<device_entry>   m_devices;
+	std::vector<slot_entry>     m_slots;
+};
+
+
+// system_metadata_store builds metadata for each system once and keeps it
+// in a file so later sessions don't need to build it again
+class system_metadata_store
+{
+public:
+	// the store is shared by everything in the process
+	static system_metadata_store &instance();
+
+	// setup - an empty filename keeps the store in memory only
+	void set_filename(std::string_view filename);
+
+	// get metadata for a system, building it if necessary
+	system_metadata const &get(game_driver const &driver);
+
+	// write out anything that was built since the store was loaded
+	void flush();
+
+private:
+	static constexpr u8 MAGIC[8] = { 'M', 'S', 'Y', 'S', 'M', 'E', 'T', 1 };
+
+	system_metadata_store();
+
+	void load();
+
+	std::mutex                                                              m_mutex;
+	std::string                                                             m_filename;
+	std::map<std::string, std::unique_ptr<system_metadata const>, std::less<> > m_entries;
+	bool                                                                    m_loaded;
+	bool                                                                    m_dirty;
+};
+
+#endif // MAME_FRONTEND_SYSMETA_H
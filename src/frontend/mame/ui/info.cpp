@@ -207,57 +207,23 @@ void get_system_warnings(std::ostream &buf, running_machine &machine, machine_fl
 //  machine_static_info - constructors
 //-------------------------------------------------
 
-machine_static_info::machine_static_info(const ui_options &options, machine_config const &config)
-	: machine_static_info(options, config, nullptr)
+machine_static_info::machine_static_info(const ui_options &options, system_metadata const &metadata)
+	: m_options(options)
+	, m_flags(metadata.machine_flags())
+	, m_unemulated_features(metadata.unemulated_features())
+	, m_imperfect_features(metadata.imperfect_features())
+	, m_has_bioses(metadata.has_bioses())
+	, m_has_dips(metadata.has_dips())
+	, m_has_configs(metadata.has_configs())
+	, m_has_keyboard(metadata.has_keyboard())
+	, m_has_test_switch(metadata.has_test_switch())
+	, m_has_analog(metadata.has_analog())
 {
 }
 
 machine_static_info::machine_static_info(const ui_options &options, machine_config const &config, ioport_list const &ports)
-	: machine_static_info(options, config, &ports)
-{
-}
-
-machine_static_info::machine_static_info(const ui_options &options, machine_config const &config, ioport_list const *ports)
-	: m_options(options)
-	, m_flags(config.gamedrv().flags)
-	, m_unemulated_features(config.gamedrv().type.unemulated_features())
-	, m_imperfect_features(config.gamedrv().type.imperfect_features())
-	, m_has_bioses(false)
-	, m_has_dips(false)
-	, m_has_configs(false)
-	, m_has_keyboard(false)
-	, m_has_test_switch(false)
-	, m_has_analog(false)
+	: machine_static_info(options, system_metadata(config, &ports))
 {
-	ioport_list local_ports;
-	std::string sink;
-	for (device_t &device : device_enumerator(config.root_device()))
-	{
-		// the "no sound hardware" warning doesn't make sense when you plug in a sound card
-		if (dynamic_cast<speaker_device *>(&device))
-			m_flags &= ~::machine_flags::NO_SOUND_HW;
-
-		// build overall emulation status
-		m_unemulated_features |= device.type().unemulated_features();
-		m_imperfect_features |= device.type().imperfect_features();
-
-		// look for BIOS options
-		device_t const *const parent(device.owner());
-		device_slot_interface const *const slot(dynamic_cast<device_slot_interface const *>(parent));
-		if (!parent || (slot && (slot->get_card_device() == &device)))
-		{
-			for (tiny_rom_entry const *rom = device.rom_region(); !m_has_bioses && rom && !ROMENTRY_ISEND(rom); ++rom)
-			{
-				if (ROMENTRY_ISSYSTEM_BIOS(rom))
-					m_has_bioses = true;
-			}
-		}
-
-		// if we don't have ports passed in, build here
-		if (!ports)
-			local_ports.append(device, sink);
-	}
-
 	// suppress "requires external artwork" warning when external artwork was loaded
 	if (config.root_device().has_running_machine())
 	{
@@ -268,27 +234,6 @@ machine_static_info::machine_static_info(const ui_options &options, machine_conf
 				break;
 			}
 	}
-
-	// unemulated trumps imperfect when aggregating (always be pessimistic)
-	m_imperfect_features &= ~m_unemulated_features;
-
-	// scan the input port array to see what options we need to enable
-	for (ioport_list::value_type const &port : (ports ? *ports : local_ports))
-	{
-		for (ioport_field const &field : port.second->fields())
-		{
-			switch (field.type())
-			{
-			case IPT_DIPSWITCH: m_has_dips = true;          break;
-			case IPT_CONFIG:    m_has_configs = true;       break;
-			case IPT_KEYBOARD:  m_has_keyboard = true;      break;
-			case IPT_SERVICE:   m_has_test_switch = true;   break;
-			default: break;
-			}
-			if (field.is_analog())
-				m_has_analog = true;
-		}
-	}
 }
 
 
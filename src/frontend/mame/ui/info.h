@@ -17,6 +17,8 @@
 
 #include "notifier.h"
 
+#include "sysmeta.h"
+
 #include <string>
 #include <vector>
 
@@ -27,7 +29,7 @@ class machine_static_info
 {
 public:
 	// construction
-	machine_static_info(const ui_options &options, machine_config const &config);
+	machine_static_info(const ui_options &options, system_metadata const &metadata);
 
 	// overall emulation status
 	::machine_flags::type machine_flags() const { return m_flags; }
@@ -54,8 +56,6 @@ protected:
 	machine_static_info(const ui_options &options, machine_config const &config, ioport_list const &ports);
 
 private:
-	machine_static_info(const ui_options &options, machine_config const &config, ioport_list const *ports);
-
 	const ui_options &      m_options;
 
 	// overall feature status
@@ -239,6 +239,7 @@ menu::menu(mame_ui_manager &mui, render_container &container)
 	, m_parent()
 	, m_heading()
 	, m_items()
+	, m_item_widths()
 	, m_rebuilding(false)
 	, m_last_size(0, 0)
 	, m_last_aspect(0.0F)
@@ -298,6 +299,7 @@ void menu::reset(reset_options options)
 
 	// reset the item count back to 0
 	m_items.clear();
+	m_item_widths.clear();
 	m_visible_items = 0;
 	m_selected = 0;
 }
@@ -499,21 +501,34 @@ void menu::draw(uint32_t flags)
 		draw_background();
 
 	// compute the width and height of the full menu
+	// measuring text is slow, so only items that have changed since the last frame are measured
 	float visible_width = 0;
 	float visible_main_menu_height = 0;
-	for (auto const &pitem : m_items)
+	if (m_item_widths.size() != m_items.size())
 	{
-		// compute width of left hand side
-		float total_width = gutter_width() + get_string_width(pitem.text()) + gutter_width();
+		m_item_widths.clear();
+		m_item_widths.resize(m_items.size(), std::make_pair(~0U, 0.0F));
+	}
+	for (int itemnum = 0; itemnum < m_items.size(); itemnum++)
+	{
+		menu_item const &pitem = m_items[itemnum];
+		auto &cached = m_item_widths[itemnum];
+		if (cached.first != pitem.generation())
+		{
+			// compute width of left hand side
+			float total_width = gutter_width() + get_string_width(pitem.text()) + gutter_width();
 
-		// add in width of right hand side
-		if (!pitem.subtext().empty())
-			total_width += 2.0F * gutter_width() + get_string_width(pitem.subtext());
-		else if (pitem.flags() & FLAG_UI_HEADING)
-			total_width += 4.0F * ud_arrow_width();
+			// add in width of right hand side
+			if (!pitem.subtext().empty())
+				total_width += 2.0F * gutter_width() + get_string_width(pitem.subtext());
+			else if (pitem.flags() & FLAG_UI_HEADING)
+				total_width += 4.0F * ud_arrow_width();
+
+			cached = std::make_pair(pitem.generation(), total_width);
+		}
 
 		// track the maximum
-		visible_width = std::max(total_width, visible_width);
+		visible_width = std::max(cached.second, visible_width);
 
 		// track the height as well
 		visible_main_menu_height += line_height();
@@ -843,6 +858,9 @@ void menu::recompute_metrics(uint32_t width, uint32_t height, float aspect)
 
 	m_lr_arrow_width = 0.4F * m_line_height * aspect;
 	m_ud_arrow_width = m_line_height * aspect;
+
+	// item widths need measuring again at the new size
+	m_item_widths.clear();
 }
 
 void menu::custom_render(void *selectedref, float top, float bottom, float x, float y, float x2, float y2)
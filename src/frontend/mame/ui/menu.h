@@ -453,6 +453,7 @@ private:
 
 	std::optional<std::string> m_heading;           // menu heading
 	std::vector<menu_item>  m_items;                // array of items
+	std::vector<std::pair<unsigned, float> > m_item_widths; // generation and width of each item when last measured
 	bool                    m_rebuilding;           // ensure items are only added during rebuild
 
 	std::pair<uint32_t, uint32_t> m_last_size;      // pixel size of UI container when metrics were computed
@@ -12,7 +12,6 @@
 #include "ui/selgame.h"
 
 #include "ui/auditmenu.h"
-#include "ui/icorender.h"
 #include "ui/inifile.h"
 #include "ui/miscmenu.h"
 #include "ui/optsmenu.h"
@@ -877,49 +876,77 @@ void menu_select_game::populate_search()
 	if (m_persistent_data.is_available(system_list::AVAIL_UCS_MANUF_DFLT_DESC))
 		m_searched_fields |= system_list::AVAIL_UCS_MANUF_DFLT_DESC;
 
-	for (std::pair<double, std::reference_wrapper<ui_system_info const> > &info : m_searchlist)
+	// only score systems sharing a trigram with the search, unless that leaves too few to fill the list
+	std::vector<bool> candidates;
+	if (m_persistent_data.is_available(system_list::AVAIL_SEARCH_INDEX))
 	{
-		info.first = 1.0;
-		ui_system_info const &sys(info.second);
+		candidates.resize(driver_list::total(), false);
+		if (m_persistent_data.search_index().find(ucs_search, candidates) < MAX_VISIBLE_SEARCH)
+			candidates.clear();
+	}
 
-		// match shortnames
-		if (m_searched_fields & system_list::AVAIL_UCS_SHORTNAME)
-			info.first = util::edit_distance(ucs_search, sys.ucs_shortname);
+	// score in parallel; each entry is independent of the others
+	parallel_apply(
+			m_searchlist.size(),
+			[this, &ucs_search, &candidates] (std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; end > i; ++i)
+				{
+					if (candidates.empty() || candidates[m_searchlist[i].second.get().index])
+						score_search(m_searchlist[i], ucs_search);
+					else
+						m_searchlist[i].first = 1.0;
+				}
+			});
 
-		// match reading
-		if (info.first && !sys.ucs_reading_description.empty())
-		{
-			info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_reading_description), info.first);
+	// sort according to edit distance
+	std::stable_sort(
+			m_searchlist.begin(),
+			m_searchlist.end(),
+			[] (auto const &lhs, auto const &rhs) { return lhs.first < rhs.first; });
+}
 
-			// match "<manufacturer> <reading>"
-			if (info.first)
-				info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_manufacturer_reading_description), info.first);
-		}
 
-		// match descriptions
-		if (info.first && (m_searched_fields & system_list::AVAIL_UCS_DESCRIPTION))
-			info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_description), info.first);
+//-------------------------------------------------
+//  score a system against the search string
+//-------------------------------------------------
 
-		// match "<manufacturer> <description>"
-		if (info.first && (m_searched_fields & system_list::AVAIL_UCS_MANUF_DESC))
-			info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_manufacturer_description), info.first);
+void menu_select_game::score_search(std::pair<double, std::reference_wrapper<ui_system_info const> > &info, std::u32string const &ucs_search) const
+{
+	info.first = 1.0;
+	ui_system_info const &sys(info.second);
 
-		// match default description
-		if (info.first && (m_searched_fields & system_list::AVAIL_UCS_DFLT_DESC) && !sys.ucs_default_description.empty())
-		{
-			info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_default_description), info.first);
+	// match shortnames
+	if (m_searched_fields & system_list::AVAIL_UCS_SHORTNAME)
+		info.first = util::edit_distance(ucs_search, sys.ucs_shortname);
 
-			// match "<manufacturer> <default description>"
-			if (info.first && (m_searched_fields & system_list::AVAIL_UCS_MANUF_DFLT_DESC))
-				info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_manufacturer_default_description), info.first);
-		}
+	// match reading
+	if (info.first && !sys.ucs_reading_description.empty())
+	{
+		info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_reading_description), info.first);
+
+		// match "<manufacturer> <reading>"
+		if (info.first)
+			info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_manufacturer_reading_description), info.first);
 	}
 
-	// sort according to edit distance
-	std::stable_sort(
-			m_searchlist.begin(),
-			m_searchlist.end(),
-			[] (auto const &lhs, auto const &rhs) { return lhs.first < rhs.first; });
+	// match descriptions
+	if (info.first && (m_searched_fields & system_list::AVAIL_UCS_DESCRIPTION))
+		info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_description), info.first);
+
+	// match "<manufacturer> <description>"
+	if (info.first && (m_searched_fields & system_list::AVAIL_UCS_MANUF_DESC))
+		info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_manufacturer_description), info.first);
+
+	// match default description
+	if (info.first && (m_searched_fields & system_list::AVAIL_UCS_DFLT_DESC) && !sys.ucs_default_description.empty())
+	{
+		info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_default_description), info.first);
+
+		// match "<manufacturer> <default description>"
+		if (info.first && (m_searched_fields & system_list::AVAIL_UCS_MANUF_DFLT_DESC))
+			info.first = (std::min)(util::edit_distance(ucs_search, sys.ucs_manufacturer_default_description), info.first);
+	}
 }
 
 
@@ -940,17 +967,6 @@ render_texture *menu_select_game::get_icon_texture(int linenum, void *selectedre
 		if (m_icon_paths.empty())
 			m_icon_paths = make_icon_paths(nullptr);
 
-		// allocate an entry or allocate a texture on forced redraw
-		if (m_icons.end() == icon)
-		{
-			icon = m_icons.emplace(driver, texture_ptr(machine().render().texture_alloc(), machine().render())).first;
-		}
-		else
-		{
-			assert(!icon->second.texture);
-			icon->second.texture.reset(machine().render().texture_alloc());
-		}
-
 		// set clone status
 		bool cloneof = strcmp(driver->parent, "0");
 		if (cloneof)
@@ -960,17 +976,20 @@ render_texture *menu_select_game::get_icon_texture(int linenum, void *selectedre
 				cloneof = false;
 		}
 
+		// the file is decoded on the work queue - draw without an icon until it's ready
 		bitmap_argb32 tmp;
-		emu_file snapfile(std::string(m_icon_paths), OPEN_FLAG_READ);
-		if (!snapfile.open(std::string(driver->name) + ".ico"))
+		if (!fetch_icon(driver, m_icon_paths, std::string(driver->name) + ".ico", cloneof ? (std::string(driver->parent) + ".ico") : std::string(), tmp))
+			return nullptr;
+
+		// allocate an entry or allocate a texture on forced redraw
+		if (m_icons.end() == icon)
 		{
-			render_load_ico_highest_detail(snapfile, tmp);
-			snapfile.close();
+			icon = m_icons.emplace(driver, texture_ptr(machine().render().texture_alloc(), machine().render())).first;
 		}
-		if (!tmp.valid() && cloneof && !snapfile.open(std::string(driver->parent) + ".ico"))
+		else
 		{
-			render_load_ico_highest_detail(snapfile, tmp);
-			snapfile.close();
+			assert(!icon->second.texture);
+			icon->second.texture.reset(machine().render().texture_alloc());
 		}
 
 		scale_icon(std::move(tmp), icon->second);
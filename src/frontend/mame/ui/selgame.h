@@ -86,6 +86,7 @@ private:
 
 	bool isfavorite() const;
 	void populate_search();
+	void score_search(std::pair<double, std::reference_wrapper<ui_system_info const> > &info, std::u32string const &ucs_search) const;
 	bool load_available_machines();
 	void load_custom_filters();
 
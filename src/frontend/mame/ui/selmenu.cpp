@@ -12,6 +12,7 @@
 #include "ui/selmenu.h"
 
 #include "ui/datmenu.h"
+#include "ui/icorender.h"
 #include "ui/info.h"
 #include "ui/inifile.h"
 
@@ -20,6 +21,7 @@
 #include "infoxml.h"
 #include "mame.h"
 #include "mameopts.h"
+#include "sysmeta.h"
 
 #include "corestr.h"
 #include "drivenum.h"
@@ -520,6 +522,7 @@ menu_select_launch::menu_select_launch(mame_ui_manager &mui, render_container &c
 	, m_panels_status(SHOW_PANELS)
 	, m_right_panel(RP_FIRST)
 	, m_has_icons(false)
+	, m_icon_loader()
 	, m_switch_image(false)
 	, m_image_view(FIRST_VIEW)
 	, m_flags(256)
@@ -591,9 +594,7 @@ menu_select_launch::system_flags const &menu_select_launch::get_system_flags(gam
 		return found->second;
 
 	// aggregate flags
-	emu_options clean_options;
-	machine_config const mconfig(driver, clean_options);
-	return m_flags.emplace(&driver, machine_static_info(ui().options(), mconfig)).first->second;
+	return m_flags.emplace(&driver, machine_static_info(ui().options(), system_metadata_store::instance().get(driver))).first->second;
 }
 
 
@@ -1205,6 +1206,96 @@ std::string menu_select_launch::make_icon_paths(char const *listname) const
 	return result;
 }
 
+menu_select_launch::icon_loader::icon_loader()
+	: m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO))
+{
+}
+
+menu_select_launch::icon_loader::~icon_loader()
+{
+	if (m_queue)
+		osd_work_queue_free(m_queue);
+}
+
+bool menu_select_launch::icon_loader::fetch(void const *key, std::string const &paths, std::string_view name, std::string_view fallback, bitmap_argb32 &result)
+{
+	auto found(m_jobs.find(key));
+	if (m_jobs.end() == found)
+	{
+		// keep the number in flight bounded when scrolling quickly
+		if (m_jobs.size() >= MAX_ICONS_RENDER)
+		{
+			prune();
+			if (m_jobs.size() >= MAX_ICONS_RENDER)
+				return false;
+		}
+
+		auto icon(std::make_unique<job>());
+		icon->paths = paths;
+		icon->names[0] = name;
+		icon->names[1] = fallback;
+		icon->item = m_queue ? osd_work_item_queue(m_queue, &load_callback, icon.get(), 0) : nullptr;
+		if (!icon->item)
+		{
+			// no work queue - do it now
+			load(*icon);
+			result = std::move(icon->bitmap);
+			return true;
+		}
+		m_jobs.emplace(key, std::move(icon));
+		return false;
+	}
+	else if (!osd_work_item_wait(found->second->item, 0))
+	{
+		return false;
+	}
+	else
+	{
+		result = std::move(found->second->bitmap);
+		osd_work_item_release(found->second->item);
+		m_jobs.erase(found);
+		return true;
+	}
+}
+
+void menu_select_launch::icon_loader::load(job &icon)
+{
+	emu_file snapfile(std::string(icon.paths), OPEN_FLAG_READ);
+	for (std::string const &name : icon.names)
+	{
+		if (!name.empty() && !snapfile.open(name))
+		{
+			render_load_ico_highest_detail(snapfile, icon.bitmap);
+			snapfile.close();
+			if (icon.bitmap.valid())
+				return;
+		}
+	}
+}
+
+void *menu_select_launch::icon_loader::load_callback(void *param, int threadid)
+{
+	load(*reinterpret_cast<job *>(param));
+	return nullptr;
+}
+
+void menu_select_launch::icon_loader::prune()
+{
+	// drop icons decoded for items that scrolled away before they were collected
+	for (auto it = m_jobs.begin(); m_jobs.end() != it; )
+	{
+		if (osd_work_item_wait(it->second->item, 0))
+		{
+			osd_work_item_release(it->second->item);
+			it = m_jobs.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
 bool menu_select_launch::scale_icon(bitmap_argb32 &&src, texture_and_bitmap &dst) const
 {
 	assert(dst.texture);
@@ -2135,6 +2226,18 @@ void menu_select_launch::draw(u32 flags)
 		}
 	}
 
+	// start decoding icons for the next page so they're ready when it's scrolled into view
+	if (m_has_icons)
+	{
+		int const prefetch_end = (std::min)(top_line + (2 * n_loop), m_available_items);
+		for (int itemnum = top_line + n_loop; prefetch_end > itemnum; ++itemnum)
+		{
+			menu_item const &pitem = item(itemnum);
+			if (pitem.ref() && (pitem.type() != menu_item_type::SEPARATOR))
+				get_icon_texture(itemnum - top_line, pitem.ref());
+		}
+	}
+
 	for (size_t count = m_available_items; count < item_count(); count++)
 	{
 		const menu_item &pitem = item(count);
@@ -21,6 +21,8 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 
@@ -65,6 +67,33 @@ protected:
 	template <typename Key, typename Compare = std::less<Key> >
 	using texture_lru = util::lru_cache_map<Key, texture_and_bitmap, Compare>;
 
+	// decodes icons on the work queue so scrolling doesn't wait for files
+	class icon_loader
+	{
+	public:
+		icon_loader();
+		~icon_loader();
+
+		// queue decoding the first of the files found, or collect the result once it's done
+		bool fetch(void const *key, std::string const &paths, std::string_view name, std::string_view fallback, bitmap_argb32 &result);
+
+	private:
+		struct job
+		{
+			std::string     paths;
+			std::string     names[2];
+			bitmap_argb32   bitmap;
+			osd_work_item   *item = nullptr;
+		};
+
+		static void load(job &icon);
+		static void *load_callback(void *param, int threadid);
+		void prune();
+
+		osd_work_queue                                          *m_queue;
+		std::unordered_map<void const *, std::unique_ptr<job> > m_jobs;
+	};
+
 	class system_flags
 	{
 	public:
@@ -151,6 +180,10 @@ protected:
 	void check_for_icons(char const *listname);
 	std::string make_icon_paths(char const *listname) const;
 	bool scale_icon(bitmap_argb32 &&src, texture_and_bitmap &dst) const;
+	bool fetch_icon(void const *key, std::string const &paths, std::string_view name, std::string_view fallback, bitmap_argb32 &result)
+	{
+		return m_icon_loader.fetch(key, paths, name, fallback, result);
+	}
 
 	// forcing refresh
 	void set_switch_image() { m_switch_image = true; }
@@ -347,6 +380,7 @@ private:
 	u8                          m_panels_status;
 	u8                          m_right_panel;
 	bool                        m_has_icons;
+	icon_loader                 m_icon_loader;
 	bool                        m_switch_image;
 	u8                          m_image_view;
 	flags_cache                 m_flags;
@@ -12,7 +12,6 @@
 #include "ui/selsoft.h"
 
 #include "ui/ui.h"
-#include "ui/icorender.h"
 #include "ui/inifile.h"
 #include "ui/selector.h"
 
@@ -45,8 +44,9 @@ struct menu_select_software::search_item
 	search_item &operator=(search_item const &) = default;
 	search_item &operator=(search_item &&) = default;
 
-	search_item(ui_software_info const &s)
+	search_item(ui_software_info const &s, u32 i)
 		: software(s)
+		, index(i)
 		, ucs_shortname(ustr_from_utf8(normalize_unicode(s.shortname, unicode_normalization_form::D, true)))
 		, ucs_longname(ustr_from_utf8(normalize_unicode(s.longname, unicode_normalization_form::D, true)))
 		, ucs_alttitles()
@@ -68,6 +68,7 @@ struct menu_select_software::search_item
 	}
 
 	std::reference_wrapper<ui_software_info const> software;
+	u32 index;
 	std::u32string ucs_shortname;
 	std::u32string ucs_longname;
 	std::vector<std::u32string> ucs_alttitles;
@@ -276,8 +277,18 @@ public:
 					for (ui_software_info const &sw : m_swinfo)
 					{
 						if (!sw.startempty)
-							m_searchlist.emplace_back(sw);
+							m_searchlist.emplace_back(sw, u32(m_searchlist.size()));
 					}
+
+					// index trigrams so searches only need to score software that could match
+					for (search_item const &item : m_searchlist)
+					{
+						m_search_index.add(item.index, item.ucs_shortname);
+						m_search_index.add(item.index, item.ucs_longname);
+						for (std::u32string const &alttitle : item.ucs_alttitles)
+							m_search_index.add(item.index, alttitle);
+					}
+					m_search_index.finalise();
 				});
 
 		// build derivative filter data
@@ -337,8 +348,21 @@ public:
 
 		// update search
 		const std::u32string ucs_search(ustr_from_utf8(normalize_unicode(search, unicode_normalization_form::D, true)));
-		for (search_item &entry : m_searchlist)
-			entry.set_penalty(ucs_search);
+		std::vector<bool> candidates(m_searchlist.size(), false);
+		if (m_search_index.find(ucs_search, candidates) < MAX_VISIBLE_SEARCH)
+			candidates.clear();
+		parallel_apply(
+				m_searchlist.size(),
+				[this, &ucs_search, &candidates] (std::size_t begin, std::size_t end)
+				{
+					for (std::size_t i = begin; end > i; ++i)
+					{
+						if (candidates.empty() || candidates[m_searchlist[i].index])
+							m_searchlist[i].set_penalty(ucs_search);
+						else
+							m_searchlist[i].penalty = 1.0;
+					}
+				});
 
 		// sort according to edit distance
 		std::stable_sort(
@@ -363,6 +387,7 @@ private:
 	software_filter::type           m_filter_type;
 	std::vector<ui_software_info>   m_swinfo;
 	std::vector<search_item>        m_searchlist;
+	ngram_index                     m_search_index;     // keyed on search item index
 
 	u8                              m_right_panel;
 	u8                              m_right_image;
@@ -729,6 +754,11 @@ render_texture *menu_select_software::get_icon_texture(int linenum, void *select
 		if (m_icon_paths.end() == paths)
 			paths = m_icon_paths.emplace(swinfo->listname, make_icon_paths(swinfo->listname.c_str())).first;
 
+		// the file is decoded on the work queue - draw without an icon until it's ready
+		bitmap_argb32 tmp;
+		if (!fetch_icon(swinfo, paths->second, swinfo->shortname + ".ico", swinfo->parentname.empty() ? std::string() : (swinfo->parentname + ".ico"), tmp))
+			return nullptr;
+
 		// allocate an entry or allocate a texture on forced redraw
 		if (m_data->icons().end() == icon)
 		{
@@ -740,19 +770,6 @@ render_texture *menu_select_software::get_icon_texture(int linenum, void *select
 			icon->second.texture.reset(machine().render().texture_alloc());
 		}
 
-		bitmap_argb32 tmp;
-		emu_file snapfile(std::string(paths->second), OPEN_FLAG_READ);
-		if (!snapfile.open(std::string(swinfo->shortname) + ".ico"))
-		{
-			render_load_ico_highest_detail(snapfile, tmp);
-			snapfile.close();
-		}
-		if (!tmp.valid() && !swinfo->parentname.empty() && !snapfile.open(std::string(swinfo->parentname) + ".ico"))
-		{
-			render_load_ico_highest_detail(snapfile, tmp);
-			snapfile.close();
-		}
-
 		scale_icon(std::move(tmp), icon->second);
 	}
 
@@ -18,6 +18,7 @@
 #include "ui/utils.h"
 
 #include "infoxml.h"
+#include "sysmeta.h"
 
 #include "audit.h"
 #include "drivenum.h"
@@ -359,8 +360,7 @@ void simple_menu_select_game::custom_render(void *selectedref, float top, float
 		// update cached values if selection changed
 		if (driver != m_cached_driver)
 		{
-			emu_options clean_options;
-			machine_static_info const info(ui().options(), machine_config(*driver, clean_options));
+			machine_static_info const info(ui().options(), system_metadata_store::instance().get(*driver));
 			m_cached_driver = driver;
 			m_cached_flags = info.machine_flags();
 			m_cached_unemulated = info.unemulated_features();
@@ -58,6 +58,7 @@ void system_list::reset_cache()
 	m_systems.clear();
 	m_sorted_list.clear();
 	m_filter_data = machine_filter_data();
+	m_search_index.clear();
 	m_bios_count = 0;
 }
 
@@ -257,6 +258,18 @@ void system_list::do_cache_data(std::string const &datpath, std::string const &t
 		}
 	}
 	notify_available(AVAIL_UCS_MANUF_DFLT_DESC);
+
+	// index trigrams so searches only need to score systems that could match
+	// the "<manufacturer> <description>" forms include the plain descriptions
+	for (ui_system_info const &info : m_sorted_list)
+	{
+		m_search_index.add(info.index, info.ucs_shortname);
+		m_search_index.add(info.index, info.ucs_manufacturer_description);
+		m_search_index.add(info.index, info.ucs_manufacturer_reading_description);
+		m_search_index.add(info.index, info.ucs_manufacturer_default_description);
+	}
+	m_search_index.finalise();
+	notify_available(AVAIL_SEARCH_INDEX);
 }
 
 
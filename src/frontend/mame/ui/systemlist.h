@@ -43,7 +43,8 @@ public:
 		AVAIL_UCS_MANUF_DESC        = 1U << 5,
 		AVAIL_UCS_DFLT_DESC         = 1U << 6,
 		AVAIL_UCS_MANUF_DFLT_DESC   = 1U << 7,
-		AVAIL_FILTER_DATA           = 1U << 8
+		AVAIL_FILTER_DATA           = 1U << 8,
+		AVAIL_SEARCH_INDEX          = 1U << 9
 	};
 
 	using system_vector = std::vector<ui_system_info>;
@@ -91,6 +92,12 @@ public:
 		return m_filter_data;
 	}
 
+	ngram_index const &search_index()
+	{
+		wait_available(AVAIL_SEARCH_INDEX);
+		return m_search_index;
+	}
+
 	static system_list &instance();
 
 private:
@@ -114,6 +121,7 @@ private:
 	system_vector                   m_systems;
 	system_reference_vector         m_sorted_list;
 	machine_filter_data             m_filter_data;
+	ngram_index                     m_search_index;     // keyed on driver index
 	int                             m_bios_count;
 };
 
@@ -1004,7 +1004,7 @@ bool mame_ui_manager::show_fps_counter()
 void mame_ui_manager::set_show_profiler(bool show)
 {
 	m_show_profiler = show;
-	g_profiler.enable(show);
+	g_profiler.enable(show, unsigned(machine().options().profile_sample()));
 }
 
 
@@ -1984,6 +1984,115 @@ software_filter::ptr software_filter::create(util::core_file &file, software_fil
 	return nullptr;
 }
 
+
+namespace {
+
+struct parallel_chunk
+{
+	std::function<void (std::size_t, std::size_t)> const *action;
+	std::size_t begin;
+	std::size_t end;
+};
+
+void *parallel_chunk_callback(void *param, int threadid)
+{
+	parallel_chunk const &chunk(*reinterpret_cast<parallel_chunk const *>(param));
+	(*chunk.action)(chunk.begin, chunk.end);
+	return nullptr;
+}
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  parallel_apply - call an action on ranges of
+//  indices, spread over the work queue when
+//  there are enough of them to be worth it
+//-------------------------------------------------
+
+void parallel_apply(std::size_t count, std::function<void (std::size_t, std::size_t)> const &action)
+{
+	constexpr std::size_t CHUNK = 1024;
+
+	// small jobs are quicker done here
+	osd_work_queue *const queue = (CHUNK < count) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	if (!queue)
+	{
+		action(0, count);
+		return;
+	}
+
+	std::vector<parallel_chunk> chunks;
+	chunks.reserve((count + CHUNK - 1) / CHUNK);
+	for (std::size_t begin = 0; count > begin; begin += CHUNK)
+		chunks.emplace_back(parallel_chunk{ &action, begin, (std::min)(begin + CHUNK, count) });
+	if (!osd_work_item_queue_multiple(queue, &parallel_chunk_callback, chunks.size(), chunks.data(), sizeof(chunks[0]), WORK_ITEM_FLAG_AUTO_RELEASE))
+		action(0, count);
+
+	// freeing the queue waits for everything to finish
+	osd_work_queue_free(queue);
+}
+
+
+//-------------------------------------------------
+//  ngram_index::add - add trigrams from an
+//  item's text
+//-------------------------------------------------
+
+void ngram_index::add(u32 item, std::u32string_view text)
+{
+	for (std::size_t i = 0; text.length() >= (i + LENGTH); ++i)
+	{
+		std::vector<u32> &items(m_items[key(&text[i])]);
+		if (items.empty() || (items.back() != item))
+			items.emplace_back(item);
+	}
+}
+
+
+//-------------------------------------------------
+//  ngram_index::finalise - sort items and drop
+//  duplicates once everything has been added
+//-------------------------------------------------
+
+void ngram_index::finalise()
+{
+	for (auto &entry : m_items)
+	{
+		std::vector<u32> &items(entry.second);
+		std::sort(items.begin(), items.end());
+		items.erase(std::unique(items.begin(), items.end()), items.end());
+		items.shrink_to_fit();
+	}
+}
+
+
+//-------------------------------------------------
+//  ngram_index::find - flag items sharing at
+//  least one trigram with the search
+//-------------------------------------------------
+
+std::size_t ngram_index::find(std::u32string_view search, std::vector<bool> &found) const
+{
+	std::size_t result(0);
+	for (std::size_t i = 0; search.length() >= (i + LENGTH); ++i)
+	{
+		auto const items(m_items.find(key(&search[i])));
+		if (m_items.end() != items)
+		{
+			for (u32 item : items->second)
+			{
+				if ((found.size() > item) && !found[item])
+				{
+					found[item] = true;
+					++result;
+				}
+			}
+		}
+	}
+	return result;
+}
+
 } // namesapce ui
 
 
@@ -415,6 +415,34 @@ std::vector<std::string> tokenize(const std::string &text, char sep);
 
 namespace ui {
 
+// call an action on ranges of indices below count, on the work queue if there are many
+void parallel_apply(std::size_t count, std::function<void (std::size_t, std::size_t)> const &action);
+
+
+// items containing each run of three characters, for narrowing down the
+// items worth scoring against a search; text is expected to be normalised
+// the same way as the search
+class ngram_index
+{
+public:
+	static constexpr std::size_t LENGTH = 3;
+
+	void clear() { m_items.clear(); }
+
+	// add an item's text, adding all the text for one item together
+	void add(u32 item, std::u32string_view text);
+	void finalise();
+
+	// flag items sharing a trigram with the search, returning how many
+	std::size_t find(std::u32string_view search, std::vector<bool> &found) const;
+
+private:
+	static u64 key(char32_t const *text) { return (u64(text[0]) << 42) | (u64(text[1]) << 21) | u64(text[2]); }
+
+	std::unordered_map<u64, std::vector<u32> > m_items;
+};
+
+
 //-------------------------------------------------
 //  input_character - inputs a typed character
 //  into a buffer
@@ -18,6 +18,7 @@
 #include <array>
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 
@@ -39,6 +40,22 @@ floppy_image::~floppy_image()
 {
 }
 
+void floppy_image::set_track_loader(int _tracks, int _heads, track_loader &&_loader)
+{
+	loader = std::move(_loader);
+	for(int track = 0; track < _tracks && track < tracks; track++)
+		for(int head = 0; head < _heads && head < heads; head++)
+			track_array[track*4][head].pending = true;
+}
+
+void floppy_image::load_track(int track, int head) const
+{
+	// generating a track changes nothing visible from outside, so it's allowed on a const image
+	floppy_image &image = const_cast<floppy_image &>(*this);
+	image.track_array[track*4][head].pending = false;
+	loader(image, track, head);
+}
+
 void floppy_image::get_maximal_geometry(int &_tracks, int &_heads) const noexcept
 {
 	_tracks = tracks;
@@ -51,7 +68,7 @@ void floppy_image::get_actual_geometry(int &_tracks, int &_heads) const noexcept
 
 	while(maxt >= 0) {
 		for(int i=0; i<=maxh; i++)
-			if(!track_array[maxt][i].cell_data.empty())
+			if(track_array[maxt][i].pending || !track_array[maxt][i].cell_data.empty())
 				goto track_done;
 		maxt--;
 	}
@@ -59,7 +76,7 @@ void floppy_image::get_actual_geometry(int &_tracks, int &_heads) const noexcept
 	if(maxt >= 0)
 		while(maxh >= 0) {
 			for(int i=0; i<=maxt; i++)
-				if(!track_array[i][maxh].cell_data.empty())
+				if(track_array[i][maxh].pending || !track_array[i][maxh].cell_data.empty())
 					goto head_done;
 			maxh--;
 		}
@@ -76,7 +93,7 @@ int floppy_image::get_resolution() const noexcept
 	int mask = 0;
 	for(int i=0; i<=(tracks-1)*4; i++)
 		for(int j=0; j<heads; j++)
-			if(!track_array[i][j].cell_data.empty())
+			if(track_array[i][j].pending || !track_array[i][j].cell_data.empty())
 				mask |= 1 << (i & 3);
 	if(mask & 0xa)
 		return 2;
@@ -92,6 +109,8 @@ bool floppy_image::track_is_formatted(int track, int head, int subtrack) const n
 		return false;
 	if(int(track_array[idx].size()) <= head)
 		return false;
+	if(track_array[idx][head].pending)
+		return true;
 	const auto &data = track_array[idx][head].cell_data;
 	if(data.empty())
 		return false;
@@ -510,6 +529,20 @@ int floppy_image_format_t::calc_sector_index(int num, int interleave, int skew,
 	return sec;
 }
 
+std::shared_ptr<util::random_read> floppy_image_format_t::copy_image(util::random_read &io)
+{
+	uint64_t size;
+	if(io.length(size) || size > std::numeric_limits<std::size_t>::max())
+		return nullptr;
+
+	std::vector<uint8_t> data(size);
+	auto const [err, actual] = read_at(io, 0, data.data(), size);
+	if(err || actual != size)
+		return nullptr;
+
+	return std::shared_ptr<util::random_read>(util::ram_read_copy(data.data(), size, 0xff));
+}
+
 void floppy_image_format_t::generate_track(const desc_e *desc, int track, int head, const desc_s *sect, int sect_count, int track_size, floppy_image &image)
 {
 	std::vector<uint32_t> buffer;
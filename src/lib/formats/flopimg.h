@@ -15,6 +15,7 @@
 
 #include "utilfwd.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -95,6 +96,15 @@ public:
 	//! @returns true if file matches the extension.
 	bool extension_matches(const char *file_name) const;
 
+	//! Copies an image into memory, so every identify() can read it
+	//! without going back to the file, and track loaders can read it
+	//! after load returns.
+	/*! Reads past the end return 0xff, as they do from the image file.
+	  @param io image to copy
+	  @return the copy, or nullptr on error
+	*/
+	static std::shared_ptr<util::random_read> copy_image(util::random_read &io);
+
 protected:
 	//! Input for convert_to_edge
 	enum {
@@ -569,8 +579,19 @@ public:
 	  @param head head number
 	  @return a pointer to the data buffer for this track and head
 	*/
-	std::vector<uint32_t> &get_buffer(int track, int head, int subtrack = 0) noexcept { assert(track < tracks && head < heads); return track_array[track*4+subtrack][head].cell_data; }
-	const std::vector<uint32_t> &get_buffer(int track, int head, int subtrack = 0) const noexcept { assert(track < tracks && head < heads); return track_array[track*4+subtrack][head].cell_data; }
+	std::vector<uint32_t> &get_buffer(int track, int head, int subtrack = 0) { assert(track < tracks && head < heads); track_info &t = track_array[track*4+subtrack][head]; if(t.pending) load_track(track, head); return t.cell_data; }
+	const std::vector<uint32_t> &get_buffer(int track, int head, int subtrack = 0) const { assert(track < tracks && head < heads); const track_info &t = track_array[track*4+subtrack][head]; if(t.pending) load_track(track, head); return t.cell_data; }
+
+	//! Generates a full track's cell data, usually with generate_track.
+	using track_loader = std::function<void (floppy_image &image, int track, int head)>;
+
+	//! Defers generating tracks until they're first accessed.
+	/*! Tracks not yet generated count as present and formatted.
+	    @param tracks number of tracks the source image holds.
+	    @param heads number of heads the source image holds.
+	    @param loader called with each track the first time it's accessed.
+	*/
+	void set_track_loader(int tracks, int heads, track_loader &&loader);
 
 	//! Sets the write splice position.
 	//! The "track splice" information indicates where to start writing
@@ -614,10 +635,15 @@ private:
 	{
 		std::vector<uint32_t> cell_data;
 		uint32_t write_splice;
+		bool pending;   // cell data still to be generated by the track loader
 
-		track_info() { write_splice = 0; }
+		track_info() { write_splice = 0; pending = false; }
 	};
 
+	track_loader loader;
+
+	void load_track(int track, int head) const;
+
 	// track number multiplied by 4 then head
 	// last array size may be bigger than actual track size
 	std::vector<std::vector<track_info> > track_array;
@@ -184,56 +184,74 @@ floppy_image_format_t::desc_e* upd765_format::get_desc_mfm(const format &f, int
 	return desc;
 }
 
-bool upd765_format::load(util::random_read &io, uint32_t form_factor, const std::vector<uint32_t> &variants, floppy_image &image) const
+bool upd765_format::get_track_desc(const format &f, std::vector<floppy_image_format_t::desc_e> &desc, int &total_size) const
 {
-	int type = find_size(io, form_factor, variants);
-	if(type == -1)
-		return false;
-
-	// format shouldn't exceed image geometry
-	const format &f = formats[type];
-	int img_tracks, img_heads;
-	image.get_maximal_geometry(img_tracks, img_heads);
-	if (f.track_count > img_tracks || f.head_count > img_heads)
-		return false;
-
-	floppy_image_format_t::desc_e *desc;
+	floppy_image_format_t::desc_e *base;
 	int current_size;
 	int end_gap_index;
 
 	switch(f.encoding) {
 	case floppy_image::FM:
-		desc = get_desc_fm(f, current_size, end_gap_index);
+		base = get_desc_fm(f, current_size, end_gap_index);
 		break;
 	case floppy_image::MFM:
 	default:
-		desc = get_desc_mfm(f, current_size, end_gap_index);
+		base = get_desc_mfm(f, current_size, end_gap_index);
 		break;
 	}
 
-	int total_size = 200000000/f.cell_size;
+	total_size = 200000000/f.cell_size;
 	int remaining_size = total_size - current_size;
 	if(remaining_size < 0) {
 		osd_printf_error("upd765_format: Incorrect track layout, max_size=%d, current_size=%d\n", total_size, current_size);
 		return false;
 	}
 
-	// Fixup the end gap
+	// Fixup the end gap in a copy, since the descriptions are shared
+	int count = 0;
+	while(base[count].type != END)
+		count++;
+	desc.assign(base, base + count + 1);
 	desc[end_gap_index].p2 = remaining_size / 16;
 	desc[end_gap_index + 1].p2 = remaining_size & 15;
 	desc[end_gap_index + 1].p1 >>= 16-(remaining_size & 15);
+	return true;
+}
 
-	int track_size = compute_track_size(f);
+bool upd765_format::load(util::random_read &io, uint32_t form_factor, const std::vector<uint32_t> &variants, floppy_image &image) const
+{
+	int type = find_size(io, form_factor, variants);
+	if(type == -1)
+		return false;
 
-	uint8_t sectdata[40*512];
-	desc_s sectors[40];
+	// format shouldn't exceed image geometry
+	const format &f = formats[type];
+	int img_tracks, img_heads;
+	image.get_maximal_geometry(img_tracks, img_heads);
+	if (f.track_count > img_tracks || f.head_count > img_heads)
+		return false;
 
-	for(int track=0; track < f.track_count; track++)
-		for(int head=0; head < f.head_count; head++) {
-			build_sector_description(f, sectdata, sectors, track, head);
-			/*auto const [err, actual] =*/ read_at(io, (track*f.head_count + head)*track_size, sectdata, track_size); // FIXME: check for errors and premature EOF
-			generate_track(desc, track, head, sectors, f.sector_count, total_size, image);
-		}
+	std::vector<floppy_image_format_t::desc_e> desc;
+	int total_size;
+	if(!get_track_desc(f, desc, total_size))
+		return false;
+
+	// tracks are generated from a copy of the image as they're accessed
+	std::shared_ptr<util::random_read> data = copy_image(io);
+	if(!data)
+		return false;
+
+	format const *const fp = &f;
+	image.set_track_loader(f.track_count, f.head_count,
+			[this, fp, desc = std::move(desc), total_size, data] (floppy_image &image, int track, int head) {
+				const format &f = *fp;
+				int const track_size = compute_track_size(f);
+				uint8_t sectdata[40*512];
+				desc_s sectors[40];
+				build_sector_description(f, sectdata, sectors, track, head);
+				/*auto const [err, actual] =*/ read_at(*data, (track*f.head_count + head)*track_size, sectdata, track_size); // FIXME: check for errors and premature EOF
+				generate_track(desc.data(), track, head, sectors, f.sector_count, total_size, image);
+			});
 
 	image.set_form_variant(f.form_factor, f.variant);
 
@@ -49,6 +49,7 @@ protected:
 	floppy_image_format_t::desc_e* get_desc_mfm(const format &f, int &current_size, int &end_gap_index) const;
 	int find_size(util::random_read &io, uint32_t form_factor, const std::vector<uint32_t> &variants) const;
 	int compute_track_size(const format &f) const;
+	bool get_track_desc(const format &f, std::vector<floppy_image_format_t::desc_e> &desc, int &total_size) const;
 	virtual void build_sector_description(const format &d, uint8_t *sectdata, desc_s *sectors, int track, int head) const;
 	void check_compatibility(const floppy_image &image, std::vector<int> &candidates) const;
 	void extract_sectors(const floppy_image &image, const format &f, desc_s *sdesc, int track, int head) const;
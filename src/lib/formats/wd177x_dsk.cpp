@@ -208,6 +208,41 @@ floppy_image_format_t::desc_e* wd177x_format::get_desc_mfm(const format &f, int
 	return desc;
 }
 
+bool wd177x_format::get_track_desc(const format &f, std::vector<floppy_image_format_t::desc_e> &desc, int &total_size) const
+{
+	floppy_image_format_t::desc_e *base;
+	int current_size;
+	int end_gap_index;
+
+	switch (f.encoding)
+	{
+	case floppy_image::FM:
+		base = get_desc_fm(f, current_size, end_gap_index);
+		break;
+	case floppy_image::MFM:
+	default:
+		base = get_desc_mfm(f, current_size, end_gap_index);
+		break;
+	}
+
+	total_size = 200000000/f.cell_size;
+	int remaining_size = total_size - current_size;
+	if(remaining_size < 0) {
+		osd_printf_error("wd177x_format: Incorrect track layout, max_size=%d, current_size=%d\n", total_size, current_size);
+		return false;
+	}
+
+	// Fixup the end gap in a copy, since the descriptions are shared
+	int count = 0;
+	while(base[count].type != END)
+		count++;
+	desc.assign(base, base + count + 1);
+	desc[end_gap_index].p2 = remaining_size / 16;
+	desc[end_gap_index + 1].p2 = remaining_size & 15;
+	desc[end_gap_index + 1].p1 >>= 16-(remaining_size & 15);
+	return true;
+}
+
 bool wd177x_format::load(util::random_read &io, uint32_t form_factor, const std::vector<uint32_t> &variants, floppy_image &image) const
 {
 	int const type = find_size(io, form_factor, variants);
@@ -223,48 +258,41 @@ bool wd177x_format::load(util::random_read &io, uint32_t form_factor, const std:
 		return false;
 	}
 
+	// check every track's layout up front, so errors are still reported on load
 	for(int track=0; track < f.track_count; track++)
 		for(int head=0; head < f.head_count; head++) {
-			uint8_t sectdata[40*512];
-			desc_s sectors[40];
-			floppy_image_format_t::desc_e *desc;
-			int current_size;
-			int end_gap_index;
-			const format &tf = get_track_format(f, head, track);
-
-			switch (tf.encoding)
-			{
-			case floppy_image::FM:
-				desc = get_desc_fm(tf, current_size, end_gap_index);
-				break;
-			case floppy_image::MFM:
-			default:
-				desc = get_desc_mfm(tf, current_size, end_gap_index);
-				break;
-			}
-
-			int total_size = 200000000/tf.cell_size;
-			int remaining_size = total_size - current_size;
-			if(remaining_size < 0) {
-				osd_printf_error("wd177x_format: Incorrect track layout, max_size=%d, current_size=%d\n", total_size, current_size);
+			std::vector<floppy_image_format_t::desc_e> desc;
+			int total_size;
+			if(!get_track_desc(get_track_format(f, head, track), desc, total_size))
 				return false;
-			}
-
-			// Fixup the end gap
-			desc[end_gap_index].p2 = remaining_size / 16;
-			desc[end_gap_index + 1].p2 = remaining_size & 15;
-			desc[end_gap_index + 1].p1 >>= 16-(remaining_size & 15);
+		}
 
-			if (tf.encoding == floppy_image::FM)
-				desc[14].p1 = get_track_dam_fm(tf, head, track);
-			else
-				desc[16].p1 = get_track_dam_mfm(tf, head, track);
+	// tracks are generated from a copy of the image as they're accessed
+	std::shared_ptr<util::random_read> data = copy_image(io);
+	if(!data)
+		return false;
 
-			build_sector_description(tf, sectdata, sectors, track, head);
-			int track_size = compute_track_size(tf);
-			/*auto const [err, actual] =*/ read_at(io, get_image_offset(f, head, track), sectdata, track_size); // FIXME: check for errors and premature EOF
-			generate_track(desc, track, head, sectors, tf.sector_count, total_size, image);
-		}
+	format const *const fp = &f;
+	image.set_track_loader(f.track_count, f.head_count,
+			[this, fp, data] (floppy_image &image, int track, int head) {
+				const format &f = *fp;
+				uint8_t sectdata[40*512];
+				desc_s sectors[40];
+				std::vector<floppy_image_format_t::desc_e> desc;
+				int total_size;
+				const format &tf = get_track_format(f, head, track);
+				get_track_desc(tf, desc, total_size);
+
+				if (tf.encoding == floppy_image::FM)
+					desc[14].p1 = get_track_dam_fm(tf, head, track);
+				else
+					desc[16].p1 = get_track_dam_mfm(tf, head, track);
+
+				build_sector_description(tf, sectdata, sectors, track, head);
+				int track_size = compute_track_size(tf);
+				/*auto const [err, actual] =*/ read_at(*data, get_image_offset(f, head, track), sectdata, track_size); // FIXME: check for errors and premature EOF
+				generate_track(desc.data(), track, head, sectors, tf.sector_count, total_size, image);
+			});
 
 	image.set_form_variant(f.form_factor, f.variant);
 
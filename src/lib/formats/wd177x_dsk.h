@@ -51,6 +51,7 @@ protected:
 	virtual const wd177x_format::format &get_track_format(const format &f, int head, int track) const;
 	virtual floppy_image_format_t::desc_e* get_desc_fm(const format &f, int &current_size, int &end_gap_index) const;
 	virtual floppy_image_format_t::desc_e* get_desc_mfm(const format &f, int &current_size, int &end_gap_index) const;
+	bool get_track_desc(const format &f, std::vector<floppy_image_format_t::desc_e> &desc, int &total_size) const;
 	virtual int find_size(util::random_read &io, uint32_t form_factor, const std::vector<uint32_t> &variants) const;
 	virtual int get_image_offset(const format &f, int head, int track) const;
 	virtual int get_track_dam_fm(const format &f, int head, int track) const;
@@ -74,10 +74,11 @@ namespace netlist::detail
 			[[maybe_unused]] plib::state_manager_t &manager) override
 		{
 			m_size = this->size();
+			const auto *list = this->list_pointer();
 			for (std::size_t i = 0; i < m_size; i++)
 			{
-				m_times[i] = this->list_pointer()[i].exec_time().as_raw();
-				m_net_ids[i] = m_get_id(this->list_pointer()[i].object());
+				m_times[i] = list[i].exec_time().as_raw();
+				m_net_ids[i] = m_get_id(list[i].object());
 			}
 		}
 		void on_post_load(
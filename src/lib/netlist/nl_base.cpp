@@ -276,6 +276,7 @@ namespace netlist
 		ENTRY_EX(config::use_queue_stats::value)
 		ENTRY(NL_USE_COPY_INSTEAD_OF_REFERENCE)
 		ENTRY(NL_USE_FLOAT128)
+		ENTRY(NL_USE_FLOAT_MATRIX)
 		ENTRY_EX(config::use_float_matrix::value)
 		ENTRY_EX(config::use_long_double_matrix::value)
 		ENTRY(NL_DEBUG)
@@ -99,6 +99,15 @@
 	#define NL_USE_FLOAT128 PUSE_FLOAT128
 #endif
 
+/// \brief  Compile matrix solvers using the float type.
+///
+/// Float GCR solvers refine their solution with residuals computed in
+/// nl_fptype, which makes FPTYPE=FLOAT usable for audio filters. Defaults
+/// to \ref NL_USE_ACADEMIC_SOLVERS to keep build times down.
+#ifndef NL_USE_FLOAT_MATRIX
+	#define NL_USE_FLOAT_MATRIX NL_USE_ACADEMIC_SOLVERS
+#endif
+
 // -----------------------------------------------------------------------------
 //  DEBUGGING
 // -----------------------------------------------------------------------------
@@ -205,9 +214,9 @@ namespace netlist
 
 		/// \brief Support float type for matrix calculations.
 		///
-		/// Defaults to NL_USE_ACADEMIC_SOLVERS to provide faster build times
+		/// Defaults to NL_USE_FLOAT_MATRIX to provide faster build times
 		using use_float_matrix = std::integral_constant<
-			bool, NL_USE_ACADEMIC_SOLVERS>;
+			bool, NL_USE_FLOAT_MATRIX>;
 
 		/// \brief Support long double type for matrix calculations.
 		///
@@ -259,11 +268,19 @@ namespace netlist
 		/// linear processing queue. This slows down execution by about 35%
 		/// on a Kaby Lake.
 		///
+		/// Use timed_queue_bucket for a calendar queue where pushes only
+		/// sort against entries in the same 12.8ns bucket. It scales with
+		/// large queues but is about 50% slower on pong and breakout, whose
+		/// queues hold only a handful of entries.
+		///
 		/// The default is the  linear queue.
 
 		// template <class A, class T>
 		// using timed_queue = plib::timed_queue_heap<A, T>;
 
+		// template <typename A, typename T>
+		// using timed_queue = plib::timed_queue_bucket<A, T>;
+
 		template <typename A, typename T>
 		using timed_queue = plib::timed_queue_linear<A, T>;
 	};
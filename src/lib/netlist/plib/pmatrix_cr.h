@@ -338,6 +338,34 @@ namespace plib
 			}
 		}
 
+		// Repeat the elimination steps of gaussian_elimination on a new right
+		// hand side. The elements below the diagonal are left in place by the
+		// elimination, so this solves L y = RHS for the factorisation in A.
+		template <typename V>
+		void gaussian_forward_substitution(V & RHS) const noexcept
+		{
+			const std::size_t iN = base_type::size();
+
+			for (std::size_t i = 0; i < iN - 1; i++)
+			{
+				std::size_t nzbdp = 0;
+				const auto f = reciprocal(base_type::A[base_type::diagonal[i]]);
+
+				const auto *nz = base_type::m_nzbd[i];
+				while (auto j = nz[nzbdp++]) // NOLINT(bugprone-infinite-loop)
+				{
+					std::size_t pj = base_type::row_idx[j];
+
+					while (base_type::col_idx[pj] < i)
+						pj++;
+
+					const typename base_type::value_type f1 = - base_type::A[pj] * f;
+
+					RHS[j] += f1 * RHS[i];
+				}
+			}
+		}
+
 		int get_parallel_level(std::size_t k) const noexcept
 		{
 			for (std::size_t i = 0; i <  m_ge_par.size(); i++)
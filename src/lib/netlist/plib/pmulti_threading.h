@@ -13,9 +13,13 @@
 #include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <functional>
 #include <mutex>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace plib {
 
@@ -84,6 +88,100 @@ namespace plib {
 	};
 
 
+	///
+	/// \brief Fixed size pool of worker threads for fork/join loops
+	///
+	/// for_each distributes the loop indices over the workers and the
+	/// calling thread, and returns once all of them have been processed.
+	/// Only one thread may call for_each at a time.
+	///
+	class pthread_pool
+	{
+	public:
+		explicit pthread_pool(std::size_t threads)
+		{
+			for (std::size_t i = 1; i < threads; i++)
+				m_threads.emplace_back([this]() { worker(); });
+		}
+
+		~pthread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_start_cv.notify_all();
+			for (auto &t : m_threads)
+				t.join();
+		}
+
+		pthread_pool(const pthread_pool &) = delete;
+		pthread_pool &operator=(const pthread_pool &) = delete;
+		pthread_pool(pthread_pool &&) = delete;
+		pthread_pool &operator=(pthread_pool &&) = delete;
+
+		/// \brief number of threads including the calling thread
+		std::size_t size() const noexcept { return m_threads.size() + 1; }
+
+		template <typename T>
+		void for_each(std::size_t count, const T &what)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_job = [&what](std::size_t i) { what(i); };
+				m_count = count;
+				m_next = 0;
+				m_pending = m_threads.size();
+				m_generation++;
+			}
+			m_start_cv.notify_all();
+			work();
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_done_cv.wait(lock, [this]() { return m_pending == 0; });
+			m_job = nullptr;
+		}
+
+	private:
+		void work()
+		{
+			for (std::size_t i = m_next++; i < m_count; i = m_next++)
+				m_job(i);
+		}
+
+		void worker()
+		{
+			std::size_t generation = 0;
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_start_cv.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+					if (m_stop)
+						return;
+					generation = m_generation;
+				}
+				work();
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (--m_pending == 0)
+						m_done_cv.notify_one();
+				}
+			}
+		}
+
+		std::vector<std::thread> m_threads;
+		std::mutex m_mutex;
+		std::condition_variable m_start_cv;
+		std::condition_variable m_done_cv;
+		std::function<void(std::size_t)> m_job;
+		std::size_t m_count = 0;
+		std::atomic<std::size_t> m_next = 0;
+		std::size_t m_pending = 0;
+		std::size_t m_generation = 0;
+		bool m_stop = false;
+	};
+
 } // namespace plib
 
 #endif // PMULTI_THREADING_H_
@@ -352,6 +352,327 @@ namespace plib {
 		pperfcount_t<true> m_prof_remove; // NOLINT
 	};
 
+	///
+	/// \brief Bucketed (calendar) timed queue
+	///
+	/// Entries within a window of `NUM_BUCKETS << BUCKET_BITS` raw time units
+	/// from the window start go into a ring of buckets selected by their
+	/// time, each kept sorted like \ref timed_queue_linear. Entries further
+	/// out wait in a sorted overflow list and move into the ring as the
+	/// window advances. Short, clustered delays therefore only sort against
+	/// the few entries sharing their bucket.
+	///
+	/// The window start only moves forward to the bucket of the last popped
+	/// entry, so pushes relative to the current time never land before it.
+	///
+	/// Entries with equal times pop in the same (last in, first out) order
+	/// as \ref timed_queue_linear.
+	///
+	template <class A, class T>
+	class timed_queue_bucket
+	{
+	public:
+		static constexpr const std::size_t BUCKET_BITS = 7;
+		static constexpr const std::size_t NUM_BUCKETS = 256;
+
+		using time_raw_type = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<T>().exec_time().as_raw())>>;
+
+		explicit timed_queue_bucket(A &arena, const std::size_t list_size)
+		: m_capacity(list_size)
+		, m_overflow(arena)
+		, m_snapshot(arena)
+		, m_never(T::never())
+		{
+			m_buckets.reserve(NUM_BUCKETS);
+			for (std::size_t i = 0; i < NUM_BUCKETS; i++)
+				m_buckets.emplace_back(arena);
+			clear();
+		}
+		~timed_queue_bucket() = default;
+
+		PCOPYASSIGNMOVE(timed_queue_bucket, delete)
+
+		constexpr std::size_t capacity() const noexcept { return m_capacity; }
+		constexpr bool empty() const noexcept { return m_size == 0; }
+
+		template <bool KEEPSTAT, typename... Args>
+		void emplace(Args&&... args) noexcept
+		{
+			push<KEEPSTAT>(T(std::forward<Args>(args)...));
+		}
+
+		template <bool KEEPSTAT>
+		void push(T &&e) noexcept
+		{
+			const time_raw_type t = e.exec_time().as_raw();
+			if (m_size == 0)
+				set_base(align(t));
+			else if (t < m_base)
+				rebase(align(t));
+
+			if (in_window(t))
+			{
+				if (ring_empty() || align(t) < m_cur_time)
+				{
+					m_cur = bucket_index(t);
+					m_cur_time = align(t);
+				}
+				insert_sorted<KEEPSTAT>(m_buckets[bucket_index(t)], std::move(e));
+			}
+			else
+				insert_sorted<KEEPSTAT>(m_overflow, std::move(e));
+			m_size++;
+			if constexpr (KEEPSTAT)
+				m_prof_call.inc();
+		}
+
+		void pop() noexcept
+		{
+			if (!ring_empty())
+			{
+				m_buckets[m_cur].pop_back();
+				m_size--;
+				m_base = m_cur_time;
+			}
+			else
+			{
+				const time_raw_type t = m_overflow.back().exec_time().as_raw();
+				m_overflow.pop_back();
+				m_size--;
+				set_base(align(t));
+			}
+			migrate_overflow();
+			find_cur();
+		}
+
+		const T &top() const noexcept
+		{
+			if (m_size == 0)
+				return m_never;
+			return !ring_empty() ? m_buckets[m_cur].back() : m_overflow.back();
+		}
+
+		bool exists(const typename T::element_type &elem) const noexcept
+		{
+			for (const auto &b : m_buckets)
+				for (const auto &e : b)
+					if (e == elem)
+						return true;
+			for (const auto &e : m_overflow)
+				if (e == elem)
+					return true;
+			return false;
+		}
+
+		/// \brief remove an entry, using its time to find it quickly
+		///
+		/// Like the other queues, only the object is compared. If the
+		/// entry isn't queued at the given time all buckets are searched.
+		///
+		template <bool KEEPSTAT>
+		void remove(const T &elem) noexcept
+		{
+			if constexpr (KEEPSTAT)
+				m_prof_remove.inc();
+			const time_raw_type t = elem.exec_time().as_raw();
+			if (m_size != 0 && t >= m_base)
+			{
+				if (remove_from(in_window(t) ? m_buckets[bucket_index(t)] : m_overflow, elem.object()))
+				{
+					m_size--;
+					find_cur();
+					return;
+				}
+			}
+			remove_any(elem.object());
+		}
+
+		template <bool KEEPSTAT>
+		void remove(const typename T::element_type &elem) noexcept
+		{
+			if constexpr (KEEPSTAT)
+				m_prof_remove.inc();
+			remove_any(elem);
+		}
+
+		void clear() noexcept
+		{
+			for (auto &b : m_buckets)
+				b.clear();
+			m_overflow.clear();
+			set_base(0);
+			m_size = 0;
+		}
+
+		// save state support & mame disassembler
+		//
+		// These return the entries sorted like timed_queue_linear, i.e. with
+		// the next entry last. The snapshot is rebuilt on every call to
+		// list_pointer(), so they are only suitable for infrequent use.
+
+		const T *list_pointer() const
+		{
+			m_snapshot.clear();
+			for (const auto &b : m_buckets)
+				m_snapshot.insert(m_snapshot.end(), b.begin(), b.end());
+			m_snapshot.insert(m_snapshot.end(), m_overflow.begin(), m_overflow.end());
+			std::stable_sort(m_snapshot.begin(), m_snapshot.end(), [](const T &a, const T &b) { return b < a; });
+			return m_snapshot.data();
+		}
+		constexpr std::size_t size() const noexcept { return m_size; }
+		const T & operator[](const std::size_t index) const { return list_pointer()[index]; }
+
+	private:
+		static constexpr time_raw_type align(time_raw_type t) noexcept
+		{
+			return t & ~((time_raw_type(1) << BUCKET_BITS) - 1);
+		}
+		static constexpr std::size_t bucket_index(time_raw_type t) noexcept
+		{
+			return static_cast<std::size_t>(t >> BUCKET_BITS) & (NUM_BUCKETS - 1);
+		}
+		// t must not be before m_base
+		bool in_window(time_raw_type t) const noexcept
+		{
+			using utime = std::make_unsigned_t<time_raw_type>;
+			return static_cast<utime>(t) - static_cast<utime>(m_base) < (utime(NUM_BUCKETS) << BUCKET_BITS);
+		}
+		bool ring_empty() const noexcept { return m_size == m_overflow.size(); }
+
+		void set_base(time_raw_type t) noexcept
+		{
+			m_base = t;
+			m_cur_time = t;
+			m_cur = bucket_index(t);
+		}
+
+		// keep each list sorted with the next entry at the back
+		template <bool KEEPSTAT, typename L>
+		void insert_sorted(L &list, T &&e) noexcept
+		{
+			list.push_back(std::move(e));
+			for (auto i = list.end() - 1; i != list.begin() && *(i - 1) < *i; --i)
+			{
+				std::swap(*(i - 1), *i);
+				if constexpr (KEEPSTAT)
+					m_prof_sort_move.inc();
+			}
+		}
+
+		template <typename L>
+		static bool remove_from(L &list, const typename T::element_type &elem) noexcept
+		{
+			for (auto i = list.end(); i != list.begin(); )
+			{
+				--i;
+				if (*i == elem)
+				{
+					list.erase(i);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void remove_any(const typename T::element_type &elem) noexcept
+		{
+			for (auto &b : m_buckets)
+				if (remove_from(b, elem))
+				{
+					m_size--;
+					find_cur();
+					return;
+				}
+			if (remove_from(m_overflow, elem))
+				m_size--;
+		}
+
+		// move the current bucket forward to the first non-empty one; all
+		// ring entries lie within one turn of the ring from it
+		void find_cur() noexcept
+		{
+			if (ring_empty())
+				return;
+			while (m_buckets[m_cur].empty())
+			{
+				m_cur = (m_cur + 1) & (NUM_BUCKETS - 1);
+				m_cur_time += time_raw_type(1) << BUCKET_BITS;
+			}
+		}
+
+		// pull overflow entries which are now within the window into the ring
+		void migrate_overflow() noexcept
+		{
+			while (!m_overflow.empty() && in_window(m_overflow.back().exec_time().as_raw()))
+			{
+				const time_raw_type t = m_overflow.back().exec_time().as_raw();
+				if (ring_empty() || align(t) < m_cur_time)
+				{
+					m_cur = bucket_index(t);
+					m_cur_time = align(t);
+				}
+				T e = std::move(m_overflow.back());
+				m_overflow.pop_back();
+				// overflow entries come out in time order and ahead of anything
+				// pushed since, so they go behind equal times in the bucket
+				auto &b = m_buckets[bucket_index(t)];
+				b.insert(b.begin(), std::move(e));
+				for (auto i = b.begin(); (i + 1) != b.end() && *i < *(i + 1); ++i)
+					std::swap(*i, *(i + 1));
+			}
+		}
+
+		// move the window back to start at new_base (rarely needed)
+		void rebase(time_raw_type new_base) noexcept
+		{
+			const std::size_t count = m_size;
+			m_snapshot.clear();
+			for (auto &b : m_buckets)
+			{
+				m_snapshot.insert(m_snapshot.end(), b.begin(), b.end());
+				b.clear();
+			}
+			// ring entries are all earlier than overflow entries, so they can
+			// be appended to the overflow list in order
+			std::stable_sort(m_snapshot.begin(), m_snapshot.end(), [](const T &a, const T &b) { return b < a; });
+			set_base(new_base);
+			m_size = m_overflow.size();
+			for (auto &e : m_snapshot)
+			{
+				const time_raw_type t = e.exec_time().as_raw();
+				if (in_window(t))
+				{
+					if (ring_empty() || align(t) < m_cur_time)
+					{
+						m_cur = bucket_index(t);
+						m_cur_time = align(t);
+					}
+					m_buckets[bucket_index(t)].push_back(std::move(e));
+				}
+				else
+					m_overflow.push_back(std::move(e));
+				m_size++;
+			}
+			m_size = count;
+		}
+
+		std::size_t                         m_capacity;
+		std::vector<plib::arena_vector<A, T>> m_buckets;
+		plib::arena_vector<A, T>            m_overflow;
+		mutable plib::arena_vector<A, T>    m_snapshot;
+		T                                   m_never;
+		time_raw_type                       m_base;     // window start
+		std::size_t                         m_cur;      // first non-empty bucket
+		time_raw_type                       m_cur_time; // start of bucket m_cur
+		std::size_t                         m_size;
+
+	public:
+		// profiling
+		pperfcount_t<true> m_prof_sort_move; // NOLINT
+		pperfcount_t<true> m_prof_call; // NOLINT
+		pperfcount_t<true> m_prof_remove; // NOLINT
+	};
+
 } // namespace plib
 
 #endif // PTIMED_QUEUE_H_
@@ -64,6 +64,9 @@ namespace plib
 	template <typename A, typename T>
 	class timed_queue_heap;
 
+	template <typename A, typename T>
+	class timed_queue_bucket;
+
 	namespace detail
 	{
 		class token_store_t;
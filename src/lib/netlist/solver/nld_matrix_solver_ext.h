@@ -270,6 +270,38 @@ namespace netlist::solver
 			}
 		}
 
+		// residual RHS - A * V of the system set up by fill_matrix_and_rhs,
+		// evaluated in fptype directly from the terminal values so that it
+		// does not inherit the rounding of a narrower matrix type
+		template <typename V, typename R>
+		void compute_residual(R &res, const V &v) const
+		{
+			const std::size_t N = size();
+
+			for (std::size_t k = 0; k < N; k++)
+			{
+				const auto &net = m_terms[k];
+				const std::size_t term_count = net.count();
+				const std::size_t rail_start = net.rail_start();
+				const auto &go = m_gonn[k];
+				const auto &gt = m_gtn[k];
+				const auto &Idr = m_Idrn[k];
+				const auto &cnV = m_connected_net_Vn[k];
+
+				auto res_t = std::accumulate(Idr, Idr + term_count, plib::constants<fptype>::zero());
+
+				for (std::size_t i = rail_start; i < term_count; i++)
+					res_t +=  (- go[i]) * *cnV[i];
+
+				res_t -= std::accumulate(gt, gt + term_count, plib::constants<fptype>::zero()) * static_cast<fptype>(v[k]);
+
+				for (std::size_t i = 0; i < rail_start; i++)
+					res_t -= go[i] * static_cast<fptype>(v[static_cast<std::size_t>(net.m_connected_net_idx[i])]);
+
+				res[k] = res_t;
+			}
+		}
+
 	private:
 		// state - variable time_stepping
 		//PALIGNAS_VECTOROPT() `parray` defines alignment already
@@ -37,6 +37,8 @@ namespace netlist::solver
 		: matrix_solver_ext_t<FT, SIZE>(main_solver, name, nets, params, size)
 		, mat(this->m_arena, static_cast<typename mat_type::index_type>(size))
 		, m_proc()
+		, m_residual(size)
+		, m_delta(size)
 		{
 			const std::size_t iN = this->size();
 
@@ -88,10 +90,16 @@ namespace netlist::solver
 			this->state().log().verbose(" Pre elimination occupancy ratio: {1}",
 					static_cast<fptype>(raw_elements) / static_cast<fptype>(iN * iN));
 
-			// FIXME: Move me
-			//
+			load_static_solver();
+		}
+
+		void upstream_solve_non_dynamic() override;
 
-			if (this->state().static_solver_lib().isLoaded())
+		std::pair<pstring, pstring> create_solver_code(static_compile_target target) override;
+
+		bool load_static_solver() override
+		{
+			if (!m_proc.resolved() && this->state().static_solver_lib().isLoaded())
 			{
 				pstring symname = static_compile_name();
 				m_proc.load(this->state().static_solver_lib(), symname);
@@ -104,12 +112,9 @@ namespace netlist::solver
 					this->state().log().warning("External static solver {1} not found ...", symname);
 				}
 			}
+			return m_proc.resolved();
 		}
 
-		void upstream_solve_non_dynamic() override;
-
-		std::pair<pstring, pstring> create_solver_code(static_compile_target target) override;
-
 	private:
 
 		using mat_index_type = typename plib::pmatrix_cr<arena_type, FT, SIZE>::index_type;
@@ -127,8 +132,16 @@ namespace netlist::solver
 
 		pstring static_compile_name();
 
+		void refine();
+
+		// narrower matrix types get their solution refined in fptype
+		static constexpr bool use_refinement = sizeof(FT) < sizeof(fptype);
+		static constexpr std::size_t REFINE_LOOPS = 3;
+
 		mat_type mat;
 		plib::dynamic_library::function<void, FT *, fptype *, fptype *, fptype *, fptype ** > m_proc;
+		plib::parray<fptype, SIZE> m_residual;
+		plib::parray<FT, SIZE> m_delta;
 
 	};
 
@@ -379,6 +392,40 @@ namespace netlist::solver
 			mat.gaussian_elimination(this->m_RHS);
 			// backward substitution
 			mat.gaussian_back_substitution(this->m_new_V, this->m_RHS);
+
+			if constexpr (use_refinement)
+				refine();
+		}
+	}
+
+	// Mixed precision iterative refinement: the residual is evaluated in
+	// fptype and the correction solved with the factorisation already in
+	// mat. This recovers most of the accuracy lost by eliminating in FT.
+	template <typename FT, int SIZE>
+	void matrix_solver_GCR_t<FT, SIZE>::refine()
+	{
+		const std::size_t iN = this->size();
+		const FT reltol(static_cast<FT>(this->m_params.m_reltol));
+		const FT vntol(static_cast<FT>(this->m_params.m_vntol));
+
+		for (std::size_t n = 0; n < REFINE_LOOPS; n++)
+		{
+			this->compute_residual(m_residual, this->m_new_V);
+			for (std::size_t k = 0; k < iN; k++)
+				this->m_RHS[k] = static_cast<FT>(m_residual[k]);
+
+			mat.gaussian_forward_substitution(this->m_RHS);
+			mat.gaussian_back_substitution(m_delta, this->m_RHS);
+
+			bool done = true;
+			for (std::size_t k = 0; k < iN; k++)
+			{
+				this->m_new_V[k] += m_delta[k];
+				if (plib::abs(m_delta[k]) > vntol + reltol * plib::abs(this->m_new_V[k]))
+					done = false;
+			}
+			if (done)
+				break;
 		}
 	}
 
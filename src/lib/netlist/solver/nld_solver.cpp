@@ -75,12 +75,7 @@ namespace netlist::devices
 	NETLIB_HANDLER(solver, fb_step)
 	{
 		const netlist_time_ext now(exec().time());
-		const std::size_t      nthreads = m_params.m_parallel() < 2
-											  ? 1
-											  : std::min(
-											 static_cast<std::size_t>(
-												 m_params.m_parallel()),
-											 plib::omp::get_max_threads());
+		const std::size_t      nthreads = m_pool ? m_pool->size() : 1;
 		const netlist_time_ext sched(
 			now
 			+ (nthreads <= 1 ? netlist_time_ext::zero()
@@ -91,6 +86,9 @@ namespace netlist::devices
 		plib::uninitialised_array<netlist_time,
 								  config::max_solver_queue_size::value>
 					nt; // NOLINT
+		plib::uninitialised_array<std::size_t,
+								  config::max_solver_queue_size::value>
+					large; // NOLINT
 		std::size_t p = 0;
 
 		while (!m_queue.empty())
@@ -104,10 +102,17 @@ namespace netlist::devices
 			m_queue.pop();
 		}
 
-		// FIXME: Disabled for now since parallel processing will decrease
-		// performance
-		//        for tested applications. More testing required here
-		if (true || nthreads < 2)
+		// The solvers due now partition the analog nets between them, so they
+		// can be solved concurrently; update_inputs() touches the logic side
+		// and stays serial.  Thread hand-off costs more than solving small
+		// matrices, so only those above the size threshold go to the pool.
+		std::size_t nlarge = 0;
+		if (!KEEP_STATS && nthreads >= 2)
+			for (std::size_t i = 0; i < p; i++)
+				if (tmp[i]->net_count() >= m_params.m_parallel_min_size())
+					large[nlarge++] = i;
+
+		if (nlarge < 2)
 		{
 			if (!KEEP_STATS)
 			{
@@ -135,10 +140,16 @@ namespace netlist::devices
 		}
 		else
 		{
-			plib::omp::set_num_threads(nthreads);
-			plib::omp::for_static(static_cast<std::size_t>(0), p,
-								  [&tmp, &nt, now](std::size_t i)
-								  { nt[i] = tmp[i]->solve(now, "parallel"); });
+			m_pool->for_each(nlarge,
+				[&tmp, &nt, &large, now](std::size_t i)
+				{ nt[large[i]] = tmp[large[i]]->solve(now, "parallel"); });
+			for (std::size_t i = 0, j = 0; i < p; i++)
+			{
+				if (j < nlarge && large[j] == i)
+					j++;
+				else
+					nt[i] = tmp[i]->solve(now, "no-parallel");
+			}
 			for (std::size_t i = 0; i < p; i++)
 			{
 				if (nt[i] != netlist_time::zero())
@@ -573,6 +584,16 @@ namespace netlist::devices
 			m_mat_params.push_back(std::move(params));
 			m_mat_solvers.push_back(std::move(ms));
 		}
+
+		// PARALLEL is the total number of threads including this one
+		const std::size_t nthreads = std::min(
+			static_cast<std::size_t>(std::max(m_params.m_parallel(), 0)),
+			static_cast<std::size_t>(std::thread::hardware_concurrency()));
+		if (nthreads >= 2 && m_mat_solvers.size() >= 2)
+		{
+			log().verbose("Solving with {1} threads", nthreads);
+			m_pool = std::make_unique<plib::pthread_pool>(nthreads);
+		}
 	}
 
 	solver::static_compile_container NETLIB_NAME(solver)::create_solver_code(
@@ -589,6 +610,18 @@ namespace netlist::devices
 		return mp;
 	}
 
+	std::size_t NETLIB_NAME(solver)::load_static_solvers()
+	{
+		std::size_t missing = 0;
+		for (auto &s : m_mat_solvers)
+		{
+			// only solvers which can be static compiled count as missing
+			if (!s->load_static_solver() && !s->create_solver_code(solver::CXX_EXTERNAL_C).first.empty())
+				missing++;
+		}
+		return missing;
+	}
+
 	std::size_t NETLIB_NAME(solver)::get_solver_id(
 		const solver::matrix_solver_t *net) const
 	{
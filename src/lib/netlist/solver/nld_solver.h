@@ -14,6 +14,7 @@
 #include "core/logic.h"
 #include "core/state_var.h"
 
+#include "../plib/pmulti_threading.h"
 #include "../plib/pstream.h"
 
 #include <map>
@@ -46,6 +47,10 @@ namespace netlist::devices
 		solver::static_compile_container
 		create_solver_code(solver::static_compile_target target);
 
+		// retry loading external static solvers for those matrix solvers
+		// which have none; returns the number still without one
+		std::size_t load_static_solvers();
+
 		NETLIB_RESETI();
 		// NETLIB_UPDATE_PARAMI();
 
@@ -72,6 +77,9 @@ namespace netlist::devices
 		solver::solver_parameters_t m_params;
 		queue_type                  m_queue;
 
+		// workers for solving independent matrices concurrently
+		std::unique_ptr<plib::pthread_pool> m_pool;
+
 		template <typename FT, int SIZE>
 		solver_ptr create_solver(std::size_t size, const pstring &solver_name,
 								 const solver::solver_parameters_t *params,
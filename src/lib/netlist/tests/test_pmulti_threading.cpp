@@ -0,0 +1,40 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+///
+/// \file test_pmulti_threading.cpp
+///
+/// tests for `pthread_pool` class
+///
+
+#include "plib/ptests.h"
+
+#include "plib/pmulti_threading.h"
+
+#include <atomic>
+#include <vector>
+
+PTEST(pthread_pool, for_each_visits_all)
+{
+	plib::pthread_pool pool(4);
+	PEXPECT_EQ(std::size_t(4), pool.size());
+
+	std::vector<int> v(1000, 0);
+	for (int r = 0; r < 100; r++)
+		pool.for_each(v.size(), [&v](std::size_t i) { v[i]++; });
+
+	bool all = true;
+	for (auto &e : v)
+		all = all && (e == 100);
+	PEXPECT_TRUE(all);
+}
+
+PTEST(pthread_pool, for_each_small_counts)
+{
+	plib::pthread_pool pool(4);
+	std::atomic<int> calls(0);
+	pool.for_each(0, [&calls](std::size_t) { calls++; });
+	PEXPECT_EQ(0, calls.load());
+	pool.for_each(1, [&calls](std::size_t) { calls++; });
+	PEXPECT_EQ(1, calls.load());
+}
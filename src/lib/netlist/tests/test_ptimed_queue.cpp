@@ -0,0 +1,94 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+///
+/// \file test_ptimed_queue.cpp
+///
+/// tests for the timed queues
+///
+
+#include "plib/ptests.h"
+
+#include "plib/palloc.h"
+#include "plib/ptime.h"
+#include "plib/ptimed_queue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+namespace {
+
+	using qtime = plib::ptime<std::int64_t, 10'000'000'000LL>;
+	using qentry = plib::queue_entry_t<qtime, const int *>;
+
+	// pops must come out in the same order as from the linear queue,
+	// including the order among equal times
+	template <typename Q>
+	void run_queue(Q &q, std::vector<const int *> &popped, const std::vector<int> &objs, unsigned seed)
+	{
+		std::mt19937 rng(seed);
+		std::vector<std::int64_t> sched(objs.size(), -1);
+		std::int64_t now = 0;
+		for (int step = 0; step < 20000; step++)
+		{
+			auto r = rng() % 16;
+			if (r < 10)
+			{
+				// short TTL-like delays, some long ones and duplicates; the
+				// occasional push before the current time moves the window back
+				std::size_t o = rng() % objs.size();
+				std::int64_t delay = (r < 8) ? (rng() % 4) * 100 : rng() % 1'000'000;
+				if (r == 9 && step % 64 == 0)
+					delay = -std::min<std::int64_t>(now, rng() % 1000);
+				if (sched[o] >= 0)
+					q.template remove<false>(qentry(qtime::from_raw(sched[o]), &objs[o]));
+				sched[o] = now + delay;
+				q.template push<false>(qentry(qtime::from_raw(sched[o]), &objs[o]));
+			}
+			else if (!q.empty())
+			{
+				now = q.top().exec_time().as_raw();
+				popped.push_back(q.top().object());
+				sched[std::size_t(q.top().object() - &objs[0])] = -1;
+				q.pop();
+			}
+		}
+		while (!q.empty())
+		{
+			popped.push_back(q.top().object());
+			q.pop();
+		}
+	}
+
+} // anonymous namespace
+
+PTEST(ptimed_queue, bucket_matches_linear)
+{
+	plib::aligned_arena<> arena;
+	std::vector<int> objs(200);
+	for (unsigned seed = 1; seed <= 4; seed++)
+	{
+		plib::timed_queue_linear<plib::aligned_arena<>, qentry> linear(arena, 512);
+		plib::timed_queue_bucket<plib::aligned_arena<>, qentry> bucket(arena, 512);
+		std::vector<const int *> a, b;
+		run_queue(linear, a, objs, seed);
+		run_queue(bucket, b, objs, seed);
+		PEXPECT_EQ(a.size(), b.size());
+		PEXPECT_TRUE(a == b);
+	}
+}
+
+PTEST(ptimed_queue, bucket_list_pointer_sorted)
+{
+	plib::aligned_arena<> arena;
+	std::vector<int> objs(3);
+	plib::timed_queue_bucket<plib::aligned_arena<>, qentry> q(arena, 16);
+	q.push<false>(qentry(qtime::from_raw(500), &objs[0]));
+	q.push<false>(qentry(qtime::from_raw(100), &objs[1]));
+	q.push<false>(qentry(qtime::from_raw(10'000'000), &objs[2]));
+	PEXPECT_EQ(std::size_t(3), q.size());
+	PEXPECT_TRUE(q[0].object() == &objs[2]);
+	PEXPECT_TRUE(q[2].object() == &objs[1]);
+	PEXPECT_TRUE(q.top().object() == &objs[1]);
+}
@@ -22,6 +22,7 @@
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
@@ -165,7 +166,8 @@ inline void chd_file::file_read(uint64_t offset, void *dest, uint32_t length) co
 	if (!m_file)
 		throw std::error_condition(error::NOT_OPEN);
 
-	// seek and read
+	// seek and read; the read-ahead thread shares the file position
+	std::lock_guard<std::mutex> lock(m_file_mutex);
 	std::error_condition err;
 	err = m_file->seek(offset, SEEK_SET);
 	if (err)
@@ -284,6 +286,11 @@ inline uint8_t chd_file::bits_for_value(uint64_t value)
  */
 
 chd_file::chd_file()
+	: m_cache(DEFAULT_CACHE_HUNKS)
+	, m_cache_hunks(DEFAULT_CACHE_HUNKS)
+	, m_read_ahead_hunks(DEFAULT_READ_AHEAD_HUNKS)
+	, m_read_ahead_queue(nullptr)
+	, m_decompress_queue(nullptr)
 {
 	// reset state
 	close();
@@ -585,6 +592,43 @@ void chd_file::set_parent_sha1(util::sha1_t parent)
 	file_write(m_parentsha1_offset, rawbuf, sizeof(rawbuf));
 }
 
+/**
+ * @fn  void chd_file::set_cache_hunks(uint32_t count)
+ *
+ * @brief   -------------------------------------------------
+ *            set_cache_hunks - set the number of decompressed hunks kept for partial reads and
+ *            writes; resizing drops the current contents
+ *          -------------------------------------------------.
+ *
+ * @param   count   Number of hunks, at least one.
+ */
+
+void chd_file::set_cache_hunks(uint32_t count)
+{
+	read_ahead_wait();
+
+	m_cache_hunks = std::max<uint32_t>(count, 1);
+	std::lock_guard<std::mutex> lock(m_cache_mutex);
+	hunk_cache resized(m_cache_hunks);
+	m_cache.swap(resized);
+}
+
+/**
+ * @fn  void chd_file::set_read_ahead_hunks(uint32_t count)
+ *
+ * @brief   -------------------------------------------------
+ *            set_read_ahead_hunks - set the number of hunks decompressed on a worker thread ahead
+ *            of sequential reads; zero disables read-ahead
+ *          -------------------------------------------------.
+ *
+ * @param   count   Number of hunks.
+ */
+
+void chd_file::set_read_ahead_hunks(uint32_t count)
+{
+	m_read_ahead_hunks = count;
+}
+
 /**
  * @fn  std::error_condition chd_file::create(util::random_read_write::ptr &&file, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, const chd_codec_type (&compression)[4])
  *
@@ -821,7 +865,6 @@ std::error_condition chd_file::open(
 	// open the file
 	m_file = std::move(file);
 	m_parent = std::shared_ptr<chd_file>(std::shared_ptr<chd_file>(), parent);
-	m_cachehunk = ~0;
 	return open_common(writeable, open_parent);
 }
 
@@ -835,6 +878,21 @@ std::error_condition chd_file::open(
 
 void chd_file::close()
 {
+	// stop reading ahead before the file goes away
+	if (m_read_ahead_queue)
+	{
+		osd_work_queue_free(m_read_ahead_queue);
+		m_read_ahead_queue = nullptr;
+	}
+	m_read_ahead_next = 0;
+	m_read_ahead_end = 0;
+	if (m_decompress_queue)
+	{
+		osd_work_queue_free(m_decompress_queue);
+		m_decompress_queue = nullptr;
+	}
+	m_codecs_pool.clear();
+
 	// reset file characteristics
 	m_file.reset();
 	m_allow_reads = false;
@@ -871,7 +929,7 @@ void chd_file::close()
 
 	// reset caching
 	m_cache.clear();
-	m_cachehunk = ~0;
+	m_lasthunk = ~0;
 }
 
 /**
@@ -1022,6 +1080,146 @@ std::error_condition chd_file::read_hunk(uint32_t hunknum, void *buffer)
 	}
 }
 
+/**
+ * @fn  std::error_condition chd_file::read_hunks(uint32_t hunknum, uint32_t count, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunks - read consecutive hunks from the CHD file, decompressing them in
+ *            parallel on the work queue where possible
+ *          -------------------------------------------------.
+ *
+ * @exception   CHDERR_NOT_OPEN             Thrown when a chderr not open error condition occurs.
+ * @exception   CHDERR_HUNK_OUT_OF_RANGE    Thrown when a chderr hunk out of range error
+ *                                          condition occurs.
+ *
+ * @param   hunknum         The first hunk.
+ * @param   count           Number of hunks.
+ * @param [in,out]  buffer  Buffer of count * hunk_bytes() bytes.
+ *
+ * @return  The first error encountered, in hunk order.
+ */
+
+std::error_condition chd_file::read_hunks(uint32_t hunknum, uint32_t count, void *buffer)
+{
+	// wrap this for clean reporting
+	try
+	{
+		// punt if no file
+		if (!m_file)
+			throw std::error_condition(error::NOT_OPEN);
+
+		// return an error if out of range
+		if (hunknum >= m_hunkcount || count > m_hunkcount - hunknum)
+			throw std::error_condition(error::HUNK_OUT_OF_RANGE);
+
+		// hand V5 compressed hunks to the work queue; writes never touch a compressed map
+		auto *dest = reinterpret_cast<uint8_t *>(buffer);
+		std::vector<read_hunks_item> items(count);
+		if (m_version >= 5 && compressed() && count > 1)
+		{
+			if (m_decompress_queue == nullptr)
+				m_decompress_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+			if (m_decompress_queue != nullptr)
+			{
+				for (uint32_t index = 0; index < count; index++)
+				{
+					items[index].m_chd = this;
+					items[index].m_hunknum = hunknum + index;
+					items[index].m_dest = dest + uint64_t(index) * m_hunkbytes;
+					items[index].m_done = false;
+				}
+				osd_work_item_queue_multiple(m_decompress_queue, async_read_hunks_static, count, &items[0], sizeof(items[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+				while (!osd_work_queue_wait(m_decompress_queue, osd_ticks_per_second())) { }
+			}
+		}
+
+		// read anything the workers couldn't handle, and report errors in order
+		for (uint32_t index = 0; index < count; index++)
+		{
+			if (items[index].m_error)
+				return items[index].m_error;
+			if (!items[index].m_done)
+			{
+				std::error_condition err = read_hunk(hunknum + index, dest + uint64_t(index) * m_hunkbytes);
+				if (err)
+					return err;
+			}
+		}
+		return std::error_condition();
+	}
+	catch (std::error_condition const &err)
+	{
+		// just return errors
+		return err;
+	}
+}
+
+/**
+ * @fn  std::error_condition chd_file::map_hunk(uint32_t hunknum, hunk_view &view)
+ *
+ * @brief   -------------------------------------------------
+ *            map_hunk - get a view of a decompressed hunk without copying it; the view shares
+ *            the cached buffer, and hunks that refer to another hunk of this file or the parent
+ *            share that hunk's buffer
+ *          -------------------------------------------------.
+ *
+ * @exception   CHDERR_NOT_OPEN             Thrown when a chderr not open error condition occurs.
+ * @exception   CHDERR_HUNK_OUT_OF_RANGE    Thrown when a chderr hunk out of range error
+ *                                          condition occurs.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [out]     view    Receives the view of the hunk.
+ *
+ * @return  A std::error_condition.
+ */
+
+std::error_condition chd_file::map_hunk(uint32_t hunknum, hunk_view &view)
+{
+	// wrap this for clean reporting
+	try
+	{
+		view.reset();
+
+		// punt if no file
+		if (!m_file)
+			throw std::error_condition(error::NOT_OPEN);
+
+		// return an error if out of range
+		if (hunknum >= m_hunkcount)
+			throw std::error_condition(error::HUNK_OUT_OF_RANGE);
+
+		// already decompressed?
+		view.m_data = cache_find(hunknum);
+		if (view.m_data)
+			return std::error_condition();
+
+		// share the buffer of a hunk that holds the same data
+		uint32_t otherhunk;
+		chd_file *const other = hunk_reference(hunknum, otherhunk);
+		if (other != nullptr)
+		{
+			std::error_condition err = other->map_hunk(otherhunk, view);
+			if (!err)
+				cache_insert(hunknum, view.m_data);
+			return err;
+		}
+
+		// otherwise decompress it into the cache
+		hunk_buffer data(cache_recycle());
+		std::error_condition err = read_hunk(hunknum, data->data());
+		if (err)
+			return err;
+		cache_insert(hunknum, data);
+		view.m_data = std::move(data);
+		return std::error_condition();
+	}
+	catch (std::error_condition const &err)
+	{
+		// just return errors
+		return err;
+	}
+}
+
 /**
  * @fn  std::error_condition chd_file::write_hunk(uint32_t hunknum, const void *buffer)
  *
@@ -1089,16 +1287,15 @@ std::error_condition chd_file::write_hunk(uint32_t hunknum, const void *buffer)
 			// write the map entry back
 			put_u32be(rawmap, rawentry);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
-
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != &m_cache[0])
-				memcpy(&m_cache[0], buffer, m_hunkbytes);
 		}
 		else
 		{
 			// otherwise, just overwrite
 			file_write(uint64_t(rawentry) * uint64_t(m_hunkbytes), buffer, m_hunkbytes);
 		}
+
+		// keep any cached copy of the hunk up to date
+		cache_update(hunknum, buffer);
 		return std::error_condition();
 	}
 	catch (std::error_condition const &err)
@@ -1173,28 +1370,39 @@ std::error_condition chd_file::read_bytes(uint64_t offset, void *buffer, uint32_
 		uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
-		std::error_condition err;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
-			err = read_hunk(curhunk, dest);
+		uint32_t length = endoffs + 1 - startoffs;
 
-		// otherwise, read from the cache
-		else
+		// copy from the cache if the hunk is there
+		std::error_condition err;
+		if (!cache_read(curhunk, startoffs, dest, length))
 		{
-			if (curhunk != m_cachehunk)
+			// if it's a full block, just read directly from disk
+			if (length == m_hunkbytes)
+				err = read_hunk(curhunk, dest);
+
+			// otherwise, map it through the cache
+			else
 			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err)
-					return err;
-				m_cachehunk = curhunk;
+				hunk_view view;
+				err = map_hunk(curhunk, view);
+				if (!err)
+					memcpy(dest, view.data() + startoffs, length);
 			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
 		}
 
 		// handle errors and advance
 		if (err)
 			return err;
-		dest += endoffs + 1 - startoffs;
+		dest += length;
+	}
+
+	// if we moved on sequentially, start decompressing the hunks that follow
+	if (last_hunk != m_lasthunk)
+	{
+		bool sequential = (first_hunk == m_lasthunk) || (first_hunk == m_lasthunk + 1);
+		m_lasthunk = last_hunk;
+		if (sequential)
+			read_ahead(last_hunk + 1);
 	}
 	return std::error_condition();
 }
@@ -1226,29 +1434,32 @@ std::error_condition chd_file::write_bytes(uint64_t offset, const void *buffer,
 		uint32_t startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		uint32_t endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just write directly to disk unless it's the cached hunk
+		uint32_t length = endoffs + 1 - startoffs;
+
+		// if it's a full block, just write directly to disk; write_hunk updates the cache
 		std::error_condition err;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		if (length == m_hunkbytes)
 			err = write_hunk(curhunk, source);
 
-		// otherwise, write from the cache
+		// otherwise, patch the hunk and write it back through the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
+			hunk_buffer data(cache_recycle());
+			if (!cache_read(curhunk, 0, data->data(), m_hunkbytes))
+				err = read_hunk(curhunk, data->data());
+			if (!err)
 			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err)
-					return err;
-				m_cachehunk = curhunk;
+				memcpy(data->data() + startoffs, source, length);
+				err = write_hunk(curhunk, data->data());
 			}
-			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
-			err = write_hunk(curhunk, &m_cache[0]);
+			if (!err)
+				cache_insert(curhunk, data);
 		}
 
 		// handle errors and advance
 		if (err)
 			return err;
-		source += endoffs + 1 - startoffs;
+		source += length;
 	}
 	return std::error_condition();
 }
@@ -2503,9 +2714,8 @@ void chd_file::create_open_common()
 	else
 		file_read(m_mapoffset, &m_rawmap[0], m_rawmap.size());
 
-	// allocate the temporary compressed buffer and a buffer for caching
+	// allocate the temporary compressed buffer; the cache fills on demand
 	m_compressed.resize(m_hunkbytes);
-	m_cache.resize(m_hunkbytes);
 }
 
 /**
@@ -2775,6 +2985,462 @@ int CLIB_DECL chd_file::metadata_hash_compare(const void *elem1, const void *ele
 	return memcmp(elem1, elem2, sizeof(metadata_hash));
 }
 
+/**
+ * @fn  bool chd_file::cache_read(uint32_t hunknum, uint32_t offset, void *dest, uint32_t length)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_read - copy part of a hunk out of the cache, waiting for the read-ahead
+ *            thread if it is about to produce the hunk
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param   offset          The offset within the hunk.
+ * @param [in,out]  dest    The destination.
+ * @param   length          The length.
+ *
+ * @return  true if the hunk was cached.
+ */
+
+bool chd_file::cache_read(uint32_t hunknum, uint32_t offset, void *dest, uint32_t length)
+{
+	std::unique_lock<std::mutex> lock(m_cache_mutex);
+	while (true)
+	{
+		auto const found = m_cache.find(hunknum);
+		if (found != m_cache.end())
+		{
+			memcpy(dest, found->second->data() + offset, length);
+			return true;
+		}
+		if (hunknum < m_read_ahead_next || hunknum >= m_read_ahead_end)
+			return false;
+		m_read_ahead_cond.wait(lock);
+	}
+}
+
+/**
+ * @fn  chd_file::hunk_buffer chd_file::cache_find(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_find - get the cached buffer for a hunk, waiting for the read-ahead thread
+ *            if it is about to produce the hunk
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ *
+ * @return  The buffer, or null if the hunk isn't cached.
+ */
+
+chd_file::hunk_buffer chd_file::cache_find(uint32_t hunknum)
+{
+	std::unique_lock<std::mutex> lock(m_cache_mutex);
+	while (true)
+	{
+		auto const found = m_cache.find(hunknum);
+		if (found != m_cache.end())
+			return found->second;
+		if (hunknum < m_read_ahead_next || hunknum >= m_read_ahead_end)
+			return nullptr;
+		m_read_ahead_cond.wait(lock);
+	}
+}
+
+/**
+ * @fn  chd_file::hunk_buffer chd_file::cache_recycle()
+ *
+ * @brief   -------------------------------------------------
+ *            cache_recycle - return a hunk buffer, taking over the least recently used one if
+ *            the cache is full and nothing else is holding on to it
+ *          -------------------------------------------------.
+ *
+ * @return  A buffer of hunk_bytes() bytes.
+ */
+
+chd_file::hunk_buffer chd_file::cache_recycle()
+{
+	hunk_buffer result;
+	{
+		std::lock_guard<std::mutex> lock(m_cache_mutex);
+		if (m_cache.size() >= m_cache.max_size())
+		{
+			if (m_cache.begin()->second.use_count() == 1)
+				result = std::move(m_cache.begin()->second);
+			m_cache.erase(m_cache.begin());
+		}
+	}
+	if (!result)
+		result = std::make_shared<std::vector<uint8_t> >(m_hunkbytes);
+	return result;
+}
+
+/**
+ * @fn  void chd_file::cache_insert(uint32_t hunknum, const hunk_buffer &data)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_insert - add or replace a hunk in the cache
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param   data            The decompressed hunk.
+ */
+
+void chd_file::cache_insert(uint32_t hunknum, const hunk_buffer &data)
+{
+	std::lock_guard<std::mutex> lock(m_cache_mutex);
+	m_cache[hunknum] = data;
+}
+
+/**
+ * @fn  void chd_file::cache_update(uint32_t hunknum, const void *source)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_update - refresh the cached copy of a hunk that has just been written;
+ *            a buffer that is shared with a view or another hunk is replaced rather than
+ *            modified
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ * @param   source  The new hunk data.
+ */
+
+void chd_file::cache_update(uint32_t hunknum, const void *source)
+{
+	std::lock_guard<std::mutex> lock(m_cache_mutex);
+	auto const found = m_cache.find(hunknum);
+	if (found != m_cache.end() && source != found->second->data())
+	{
+		auto const *const data = reinterpret_cast<const uint8_t *>(source);
+		if (found->second.use_count() == 1)
+			std::copy_n(data, m_hunkbytes, found->second->begin());
+		else
+			found->second = std::make_shared<std::vector<uint8_t> >(data, data + m_hunkbytes);
+	}
+}
+
+/**
+ * @fn  void chd_file::read_ahead(uint32_t hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead - start decompressing hunks from the given one on the read-ahead thread
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The first hunk to decompress.
+ */
+
+void chd_file::read_ahead(uint32_t hunknum)
+{
+	// only read-only V5 compressed files; leave room in the cache for the hunk being consumed
+	uint32_t count = std::min(m_read_ahead_hunks, m_cache_hunks - 1);
+	if (count == 0 || m_allow_writes || m_version < 5 || !compressed() || hunknum >= m_hunkcount)
+		return;
+
+	// don't pile up requests while the thread is still busy
+	if (m_read_ahead_queue != nullptr && osd_work_queue_items(m_read_ahead_queue) != 0)
+		return;
+
+	if (m_read_ahead_queue == nullptr)
+	{
+		m_read_ahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+		if (m_read_ahead_queue == nullptr)
+			return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_cache_mutex);
+		m_read_ahead_next = hunknum;
+		m_read_ahead_end = std::min(hunknum + count, m_hunkcount);
+	}
+	osd_work_item_queue(m_read_ahead_queue, async_read_ahead_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+/**
+ * @fn  void chd_file::read_ahead_wait()
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_wait - wait for the read-ahead thread to go idle
+ *          -------------------------------------------------.
+ */
+
+void chd_file::read_ahead_wait()
+{
+	if (m_read_ahead_queue != nullptr)
+		while (!osd_work_queue_wait(m_read_ahead_queue, osd_ticks_per_second())) { }
+}
+
+/**
+ * @fn  void *chd_file::async_read_ahead_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_read_ahead_static - thread entry point for read-ahead
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the parameter.
+ * @param   threadid        The threadid.
+ *
+ * @return  null if it fails, else a void*.
+ */
+
+void *chd_file::async_read_ahead_static(void *param, int threadid)
+{
+	reinterpret_cast<chd_file *>(param)->async_read_ahead();
+	return nullptr;
+}
+
+/**
+ * @fn  void chd_file::async_read_ahead()
+ *
+ * @brief   -------------------------------------------------
+ *            async_read_ahead - decompress the requested hunks into the cache; anything that
+ *            can't be handled here, or fails, is left for read_hunk to deal with
+ *          -------------------------------------------------.
+ */
+
+void chd_file::async_read_ahead()
+{
+	uint32_t first, end;
+	{
+		std::lock_guard<std::mutex> lock(m_cache_mutex);
+		first = m_read_ahead_next;
+		end = m_read_ahead_end;
+	}
+	std::unique_ptr<hunk_codecs> codecs(codecs_acquire());
+
+	for (uint32_t hunknum = first; hunknum < end; hunknum++)
+	{
+		bool cached;
+		{
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+			cached = m_cache.count(hunknum) != 0;
+		}
+
+		if (!cached)
+		{
+			hunk_buffer data(cache_recycle());
+			bool valid;
+			try
+			{
+				valid = hunk_decompress(*codecs, hunknum, data->data());
+			}
+			catch (std::error_condition const &)
+			{
+				valid = false;
+			}
+			if (valid)
+				cache_insert(hunknum, data);
+		}
+
+		// let a reader waiting on this hunk continue
+		{
+			std::lock_guard<std::mutex> lock(m_cache_mutex);
+			m_read_ahead_next = hunknum + 1;
+		}
+		m_read_ahead_cond.notify_all();
+	}
+	codecs_release(std::move(codecs));
+}
+
+/**
+ * @fn  void *chd_file::async_read_hunks_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_read_hunks_static - decompress one hunk for read_hunks on a worker thread
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the parameter.
+ * @param   threadid        The threadid.
+ *
+ * @return  null if it fails, else a void*.
+ */
+
+void *chd_file::async_read_hunks_static(void *param, int threadid)
+{
+	auto &item = *reinterpret_cast<read_hunks_item *>(param);
+	chd_file &chd = *item.m_chd;
+	std::unique_ptr<hunk_codecs> codecs(chd.codecs_acquire());
+	try
+	{
+		item.m_done = chd.hunk_decompress(*codecs, item.m_hunknum, item.m_dest);
+	}
+	catch (std::error_condition const &err)
+	{
+		item.m_done = true;
+		item.m_error = err;
+	}
+	chd.codecs_release(std::move(codecs));
+	return nullptr;
+}
+
+/**
+ * @fn  std::unique_ptr<chd_file::hunk_codecs> chd_file::codecs_acquire()
+ *
+ * @brief   -------------------------------------------------
+ *            codecs_acquire - take a set of codecs for a worker thread from the pool, creating
+ *            one if none are idle; A/V codecs depend on codec_configure, so they are left out
+ *          -------------------------------------------------.
+ *
+ * @return  The codecs.
+ */
+
+std::unique_ptr<chd_file::hunk_codecs> chd_file::codecs_acquire()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_codecs_mutex);
+		if (!m_codecs_pool.empty())
+		{
+			std::unique_ptr<hunk_codecs> result(std::move(m_codecs_pool.back()));
+			m_codecs_pool.pop_back();
+			return result;
+		}
+	}
+
+	auto result = std::make_unique<hunk_codecs>();
+	for (int decompnum = 0; decompnum < std::size(m_compression); decompnum++)
+		if (m_compression[decompnum] != CHD_CODEC_AVHUFF)
+			result->m_decompressor[decompnum] = chd_codec_list::new_decompressor(m_compression[decompnum], *this);
+	result->m_compressed.resize(m_hunkbytes);
+	return result;
+}
+
+/**
+ * @fn  void chd_file::codecs_release(std::unique_ptr<hunk_codecs> &&codecs)
+ *
+ * @brief   -------------------------------------------------
+ *            codecs_release - return a set of codecs to the pool
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  codecs  The codecs.
+ */
+
+void chd_file::codecs_release(std::unique_ptr<hunk_codecs> &&codecs)
+{
+	std::lock_guard<std::mutex> lock(m_codecs_mutex);
+	m_codecs_pool.emplace_back(std::move(codecs));
+}
+
+/**
+ * @fn  bool chd_file::hunk_decompress(hunk_codecs &codecs, uint32_t hunknum, uint8_t *dest)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_decompress - read and decompress a V5 hunk with the given codecs; safe to call
+ *            from any thread as long as the map isn't being modified
+ *          -------------------------------------------------.
+ *
+ * @exception   CHDERR_DECOMPRESSION_ERROR  Thrown when a chderr decompression error error
+ *                                          condition occurs.
+ *
+ * @param [in,out]  codecs  The codecs.
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  dest    The destination.
+ *
+ * @return  false if the hunk must go through read_hunk instead.
+ */
+
+bool chd_file::hunk_decompress(hunk_codecs &codecs, uint32_t hunknum, uint8_t *dest)
+{
+	const uint8_t *rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+	uint32_t blocklen = get_u24be(&rawmap[1]);
+	uint64_t blockoffs = get_u48be(&rawmap[4]);
+	util::crc16_t blockcrc = get_u16be(&rawmap[10]);
+	switch (rawmap[0])
+	{
+		case COMPRESSION_TYPE_0:
+		case COMPRESSION_TYPE_1:
+		case COMPRESSION_TYPE_2:
+		case COMPRESSION_TYPE_3:
+		{
+			chd_decompressor *decompressor = codecs.m_decompressor[rawmap[0]].get();
+			if (decompressor == nullptr)
+				return false;
+			file_read(blockoffs, &codecs.m_compressed[0], blocklen);
+			decompressor->decompress(&codecs.m_compressed[0], blocklen, dest, m_hunkbytes);
+			if (!decompressor->lossy() && util::crc16_creator::simple(dest, m_hunkbytes) != blockcrc)
+				throw std::error_condition(error::DECOMPRESSION_ERROR);
+			if (decompressor->lossy() && util::crc16_creator::simple(&codecs.m_compressed[0], blocklen) != blockcrc)
+				throw std::error_condition(error::DECOMPRESSION_ERROR);
+			return true;
+		}
+
+		case COMPRESSION_NONE:
+			file_read(blockoffs, dest, m_hunkbytes);
+			if (util::crc16_creator::simple(dest, m_hunkbytes) != blockcrc)
+				throw std::error_condition(error::DECOMPRESSION_ERROR);
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * @fn  chd_file *chd_file::hunk_reference(uint32_t hunknum, uint32_t &otherhunk)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_reference - find the hunk of this file or the parent that a hunk's data is
+ *            taken from as a whole; references that don't line up with a hunk of the same size
+ *            are not reported
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum             The hunknum.
+ * @param [out]     otherhunk   Receives the referenced hunk.
+ *
+ * @return  The file holding the referenced hunk, or null if the hunk holds its own data.
+ */
+
+chd_file *chd_file::hunk_reference(uint32_t hunknum, uint32_t &otherhunk)
+{
+	chd_file *const parent = m_parent_missing ? nullptr : m_parent.get();
+	bool const parent_matches = parent != nullptr && parent->hunk_bytes() == m_hunkbytes;
+	const uint8_t *rawmap;
+	switch (m_version)
+	{
+		// v3/v4 map entries
+		case 3:
+		case 4:
+			rawmap = &m_rawmap[16 * hunknum];
+			switch (rawmap[15] & V34_MAP_ENTRY_FLAG_TYPE_MASK)
+			{
+				case V34_MAP_ENTRY_TYPE_SELF_HUNK:
+					otherhunk = get_u64be(&rawmap[0]);
+					return this;
+
+				case V34_MAP_ENTRY_TYPE_PARENT_HUNK:
+					otherhunk = get_u64be(&rawmap[0]);
+					return parent_matches ? parent : nullptr;
+			}
+			break;
+
+		// v5 map entries
+		case 5:
+			rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+
+			// uncompressed hunks that were never written come from the same hunk of the parent
+			if (!compressed())
+			{
+				otherhunk = hunknum;
+				return (get_u32be(rawmap) == 0 && parent_matches) ? parent : nullptr;
+			}
+
+			switch (rawmap[0])
+			{
+				case COMPRESSION_SELF:
+					otherhunk = get_u48be(&rawmap[4]);
+					return this;
+
+				case COMPRESSION_PARENT:
+					if (parent_matches)
+					{
+						uint64_t const offset = get_u48be(&rawmap[4]) * uint64_t(parent->unit_bytes());
+						otherhunk = offset / m_hunkbytes;
+						if ((offset % m_hunkbytes) == 0)
+							return parent;
+					}
+					break;
+			}
+			break;
+	}
+	return nullptr;
+}
+
 
 
 //**************************************************************************
@@ -2793,6 +3459,7 @@ chd_file_compressor::chd_file_compressor()
 	: m_walking_parent(false),
 		m_total_in(0),
 		m_total_out(0),
+		m_adaptive_codecs(false),
 		m_read_queue(nullptr),
 		m_read_queue_offset(0),
 		m_read_done_offset(0),
@@ -2869,7 +3536,7 @@ void chd_file_compressor::compress_begin()
 	for (auto & elem : m_codecs)
 	{
 		delete elem;
-		elem = new chd_compressor_group(*this, m_compression);
+		elem = new chd_compressor_group(*this, m_compression, m_adaptive_codecs);
 	}
 
 	// reset write state
@@ -15,15 +15,19 @@
 #include "chdcodec.h"
 #include "hashing.h"
 #include "ioprocs.h"
+#include "lrucache.h"
 
 #include "osdcore.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <vector>
 
 
 /***************************************************************************
@@ -296,6 +300,21 @@ public:
 
 	using open_parent_func = std::function<std::unique_ptr<chd_file> (util::sha1_t const &)>;
 
+	// read-only view of a decompressed hunk; the data stays valid for as long as the view is
+	// held, even after the hunk leaves the cache or is rewritten
+	class hunk_view
+	{
+	public:
+		const uint8_t *data() const noexcept { return m_data ? m_data->data() : nullptr; }
+		uint32_t size() const noexcept { return m_data ? uint32_t(m_data->size()) : 0; }
+		explicit operator bool() const noexcept { return bool(m_data); }
+		void reset() noexcept { m_data.reset(); }
+
+	private:
+		friend class chd_file;
+		std::shared_ptr<std::vector<uint8_t> > m_data;
+	};
+
 	// construction/destruction
 	chd_file();
 	virtual ~chd_file();
@@ -322,6 +341,12 @@ public:
 	void set_raw_sha1(util::sha1_t rawdata);
 	void set_parent_sha1(util::sha1_t parent);
 
+	// caching
+	uint32_t cache_hunks() const noexcept { return m_cache_hunks; }
+	uint32_t read_ahead_hunks() const noexcept { return m_read_ahead_hunks; }
+	void set_cache_hunks(uint32_t count);
+	void set_read_ahead_hunks(uint32_t count);
+
 	// file create
 	std::error_condition create(std::string_view filename, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, const chd_codec_type (&compression)[4]);
 	std::error_condition create(util::random_read_write::ptr &&file, uint64_t logicalbytes, uint32_t hunkbytes, uint32_t unitbytes, const chd_codec_type (&compression)[4]);
@@ -337,6 +362,8 @@ public:
 
 	// read/write
 	std::error_condition read_hunk(uint32_t hunknum, void *buffer);
+	std::error_condition read_hunks(uint32_t hunknum, uint32_t count, void *buffer);
+	std::error_condition map_hunk(uint32_t hunknum, hunk_view &view);
 	std::error_condition write_hunk(uint32_t hunknum, const void *buffer);
 	std::error_condition read_units(uint64_t unitnum, void *buffer, uint32_t count = 1);
 	std::error_condition write_units(uint64_t unitnum, const void *buffer, uint32_t count = 1);
@@ -371,6 +398,30 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// caching defaults
+	static constexpr uint32_t DEFAULT_CACHE_HUNKS = 16;
+	static constexpr uint32_t DEFAULT_READ_AHEAD_HUNKS = 4;
+
+	using hunk_buffer = std::shared_ptr<std::vector<uint8_t> >;
+	using hunk_cache = util::lru_cache_map<uint32_t, hunk_buffer>;
+
+	// codecs for decompressing on a worker thread
+	struct hunk_codecs
+	{
+		chd_decompressor::ptr   m_decompressor[4];  // array of decompression codecs
+		std::vector<uint8_t>    m_compressed;       // temporary buffer for compressed data
+	};
+
+	// a hunk handed to the work queue by read_hunks
+	struct read_hunks_item
+	{
+		chd_file *              m_chd;              // file being read
+		uint32_t                m_hunknum;          // hunk to decompress
+		uint8_t *               m_dest;             // where it goes
+		bool                    m_done;             // did the worker handle it?
+		std::error_condition    m_error;            // error reported by the worker
+	};
+
 	// inline helpers
 	util::sha1_t be_read_sha1(const uint8_t *base) const;
 	void be_write_sha1(uint8_t *base, util::sha1_t value);
@@ -397,6 +448,20 @@ private:
 	void metadata_set_previous_next(uint64_t prevoffset, uint64_t nextoffset);
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
+	bool cache_read(uint32_t hunknum, uint32_t offset, void *dest, uint32_t length);
+	hunk_buffer cache_find(uint32_t hunknum);
+	hunk_buffer cache_recycle();
+	void cache_insert(uint32_t hunknum, const hunk_buffer &data);
+	void cache_update(uint32_t hunknum, const void *source);
+	void read_ahead(uint32_t hunknum);
+	void read_ahead_wait();
+	static void *async_read_ahead_static(void *param, int threadid);
+	void async_read_ahead();
+	static void *async_read_hunks_static(void *param, int threadid);
+	std::unique_ptr<hunk_codecs> codecs_acquire();
+	void codecs_release(std::unique_ptr<hunk_codecs> &&codecs);
+	bool hunk_decompress(hunk_codecs &codecs, uint32_t hunknum, uint8_t *dest);
+	chd_file *hunk_reference(uint32_t hunknum, uint32_t &otherhunk);
 
 	// file characteristics
 	util::random_read_write::ptr m_file;        // handle to the open core file
@@ -432,8 +497,23 @@ private:
 	std::vector<uint8_t>    m_compressed;       // temporary buffer for compressed data
 
 	// caching
-	std::vector<uint8_t>    m_cache;            // single-hunk cache for partial reads/writes
-	uint32_t                m_cachehunk;        // which hunk is in the cache?
+	hunk_cache              m_cache;            // most recently used hunks for partial reads/writes
+	uint32_t                m_cache_hunks;      // maximum number of hunks in the cache
+	std::mutex              m_cache_mutex;      // guards the cache against the read-ahead thread
+	mutable std::mutex      m_file_mutex;       // serializes file reads with the read-ahead thread
+
+	// read-ahead
+	uint32_t                m_read_ahead_hunks; // number of hunks to decompress ahead of sequential reads
+	uint32_t                m_lasthunk;         // last hunk touched by read_bytes
+	osd_work_queue *        m_read_ahead_queue; // queue for decompressing ahead, allocated on first use
+	uint32_t                m_read_ahead_next;  // next hunk the read-ahead thread will produce
+	uint32_t                m_read_ahead_end;   // end of the range handed to the read-ahead thread
+	std::condition_variable m_read_ahead_cond;  // signalled as the read-ahead thread advances
+
+	// parallel decompression
+	osd_work_queue *        m_decompress_queue; // queue for read_hunks, allocated on first use
+	std::mutex              m_codecs_mutex;     // guards the pool of worker codecs
+	std::vector<std::unique_ptr<hunk_codecs> > m_codecs_pool; // idle codecs for worker threads
 };
 
 
@@ -448,6 +528,7 @@ public:
 	virtual ~chd_file_compressor();
 
 	// compression management
+	void set_adaptive_codecs(bool adaptive) { m_adaptive_codecs = adaptive; }
 	void compress_begin();
 	std::error_condition compress_continue(double &progress, double &ratio);
 
@@ -554,6 +635,7 @@ private:
 	uint64_t                m_total_in;         // total bytes in
 	uint64_t                m_total_out;        // total bytes out
 	util::sha1_creator      m_compsha1;         // running SHA-1 on raw data
+	bool                    m_adaptive_codecs;  // skip codecs that keep losing?
 
 	// hash lookup maps
 	hashmap                 m_parent_map;       // hash map for parent
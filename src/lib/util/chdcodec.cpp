@@ -697,9 +697,14 @@ const char *chd_codec_list::codec_name(chd_codec_type type)
 //  chd_compressor_group - constructor
 //-------------------------------------------------
 
-chd_compressor_group::chd_compressor_group(chd_file &chd, uint32_t compressor_list[4])
+chd_compressor_group::chd_compressor_group(chd_file &chd, uint32_t compressor_list[4], bool adaptive)
 	: m_hunkbytes(chd.hunk_bytes())
 	, m_compress_test(m_hunkbytes)
+	, m_adaptive(adaptive)
+	, m_window_hunks(0)
+	, m_tried{ 0, 0, 0, 0 }
+	, m_wins{ 0, 0, 0, 0 }
+	, m_skip{ 0, 0, 0, 0 }
 #if CHDCODEC_VERIFY_COMPRESSION
 	, m_decompressed(m_hunkbytes)
 #endif
@@ -744,9 +749,10 @@ int8_t chd_compressor_group::find_best_compressor(const uint8_t *src, uint8_t *c
 	complen = m_hunkbytes;
 	int8_t compression = -1;
 	for (int codecnum = 0; codecnum < std::size(m_compressor); codecnum++)
-		if (m_compressor[codecnum])
+		if (m_compressor[codecnum] && !m_skip[codecnum])
 		{
 			// attempt to compress, swallowing errors
+			m_tried[codecnum]++;
 			try
 			{
 				// if this is the best one, copy the data into the permanent buffer
@@ -790,10 +796,40 @@ printf("   codec%d=%d bytes            \n", codecnum, compbytes);
 	// if the best is none, copy it over
 	if (compression == -1)
 		memcpy(compressed, src, m_hunkbytes);
+	if (m_adaptive)
+		update_adaptive(compression);
 	return compression;
 }
 
 
+//-------------------------------------------------
+//  update_adaptive - count wins and bench the
+//  codecs that lost every hunk of a window
+//-------------------------------------------------
+
+void chd_compressor_group::update_adaptive(int8_t winner)
+{
+	// benched codecs count down to being probed again
+	for (auto &skip : m_skip)
+		if (skip)
+			skip--;
+	if (winner >= 0)
+		m_wins[winner]++;
+	if (++m_window_hunks < ADAPTIVE_WINDOW)
+		return;
+
+	// a codec that came back partway through the window gets the next one too
+	for (int codecnum = 0; codecnum < std::size(m_compressor); codecnum++)
+	{
+		if (m_compressor[codecnum] && !m_wins[codecnum] && (m_tried[codecnum] >= (ADAPTIVE_WINDOW / 2)))
+			m_skip[codecnum] = ADAPTIVE_SKIP;
+		m_tried[codecnum] = 0;
+		m_wins[codecnum] = 0;
+	}
+	m_window_hunks = 0;
+}
+
+
 
 //**************************************************************************
 //  ZLIB ALLOCATOR HELPER
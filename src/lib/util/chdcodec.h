@@ -116,17 +116,29 @@ class chd_compressor_group
 {
 public:
 	// construction/destruction
-	chd_compressor_group(chd_file &file, chd_codec_type compressor_list[4]);
+	chd_compressor_group(chd_file &file, chd_codec_type compressor_list[4], bool adaptive = false);
 	~chd_compressor_group();
 
 	// find the best compressor
 	int8_t find_best_compressor(const uint8_t *src, uint8_t *compressed, uint32_t &complen);
 
 private:
+	// adaptive selection: a codec that is tried on most of a window of hunks
+	// without winning any sits out for a while before being probed again
+	static constexpr uint32_t ADAPTIVE_WINDOW = 64;
+	static constexpr uint32_t ADAPTIVE_SKIP = 1024;
+
+	void update_adaptive(int8_t winner);
+
 	// internal state
 	uint32_t                m_hunkbytes;        // number of bytes in a hunk
 	chd_compressor::ptr     m_compressor[4];    // array of active codecs
 	std::vector<uint8_t>    m_compress_test;    // test buffer for compression
+	bool                    m_adaptive;         // skip codecs that keep losing?
+	uint32_t                m_window_hunks;     // hunks compressed in the current window
+	uint32_t                m_tried[4];         // hunks each codec was tried on in the current window
+	uint32_t                m_wins[4];          // hunks each codec won in the current window
+	uint32_t                m_skip[4];          // hunks each codec still sits out
 #if CHDCODEC_VERIFY_COMPRESSION
 	chd_decompressor::ptr   m_decompressor[4];  // array of active codecs
 	std::vector<uint8_t>    m_decompressed;     // verification buffer
@@ -16,6 +16,8 @@
 #include "osdcore.h"
 
 #include <cstdlib>
+#include <cstring>
+#include <new>
 #include <tuple>
 
 
@@ -29,6 +31,7 @@ hard_disk_file::hard_disk_file(chd_file *_chd)
 	chd = _chd;
 	fhandle = nullptr;
 	fileoffset = 0;
+	overlay_active = false;
 
 	std::string metadata;
 	std::error_condition err;
@@ -61,6 +64,7 @@ hard_disk_file::hard_disk_file(util::random_read_write &corefile, uint32_t skipo
 	hdinfo.heads = 0;
 	hdinfo.sectors = 0;
 	fileoffset = skipoffs;
+	overlay_active = false;
 
 	// attempt to guess geometry in case this is an ATA situation
 	for (uint32_t totalsectors = (length - skipoffs) / hdinfo.sectorbytes; ; totalsectors++)
@@ -111,6 +115,17 @@ bool hard_disk_file::read(uint32_t lbasector, void *buffer)
 {
 	if (chd)
 	{
+		if (overlay_active)
+		{
+			uint64_t const offset = uint64_t(lbasector) * chd->unit_bytes();
+			uint32_t const hunknum = offset / chd->hunk_bytes();
+			if (hunknum < overlay_present.size() && overlay_present[hunknum])
+			{
+				memcpy(buffer, &overlay[hunknum][offset % chd->hunk_bytes()], chd->unit_bytes());
+				return true;
+			}
+		}
+
 		std::error_condition err = chd->read_units(lbasector, buffer);
 		return !err;
 	}
@@ -144,6 +159,29 @@ bool hard_disk_file::write(uint32_t lbasector, const void *buffer)
 {
 	if (chd)
 	{
+		if (overlay_active)
+		{
+			uint64_t const offset = uint64_t(lbasector) * chd->unit_bytes();
+			uint32_t const hunknum = offset / chd->hunk_bytes();
+			if (hunknum >= overlay_present.size())
+				return false;
+
+			// the first write to a hunk copies it out of the CHD
+			std::unique_ptr<uint8_t []> &data = overlay[hunknum];
+			if (!overlay_present[hunknum])
+			{
+				data.reset(new (std::nothrow) uint8_t[chd->hunk_bytes()]);
+				if (!data || chd->read_hunk(hunknum, data.get()))
+				{
+					overlay.erase(hunknum);
+					return false;
+				}
+				overlay_present[hunknum] = true;
+			}
+			memcpy(&data[offset % chd->hunk_bytes()], buffer, chd->unit_bytes());
+			return true;
+		}
+
 		std::error_condition err = chd->write_units(lbasector, buffer);
 		return !err;
 	}
@@ -158,6 +196,35 @@ bool hard_disk_file::write(uint32_t lbasector, const void *buffer)
 }
 
 
+/*-------------------------------------------------
+    enable_overlay - keep writes in memory from
+    now on, leaving the CHD untouched
+-------------------------------------------------*/
+
+/**
+ * @fn  bool enable_overlay()
+ *
+ * @brief   Sends writes to a copy-on-write overlay held in memory.  The first write to
+ *          each hunk copies it out of the CHD; later reads and writes of that hunk use
+ *          the copy.  This lets a read-only or compressed CHD, possibly shared by other
+ *          instances, be written without a differencing file.  Writes are lost when the
+ *          hard disk is closed.
+ *
+ * @return  true on success, false if the hard disk isn't backed by a CHD.
+ */
+
+bool hard_disk_file::enable_overlay()
+{
+	if (!chd)
+		return false;
+
+	overlay_present.assign(chd->hunk_count(), false);
+	overlay.clear();
+	overlay_active = true;
+	return true;
+}
+
+
 /*-------------------------------------------------
     set_block_size - sets the block size
     for a non-CHD-backed hard disk (a bare file).
@@ -16,7 +16,9 @@
 #include "utilfwd.h"
 
 #include <cstdint>
+#include <memory>
 #include <system_error>
+#include <unordered_map>
 #include <vector>
 
 
@@ -44,6 +46,9 @@ public:
 	bool read(uint32_t lbasector, void *buffer);
 	bool write(uint32_t lbasector, const void *buffer);
 
+	bool enable_overlay();
+	bool overlay_enabled() const { return overlay_active; }
+
 	std::error_condition get_inquiry_data(std::vector<uint8_t> &data) const;
 	std::error_condition get_cis_data(std::vector<uint8_t> &data) const;
 	std::error_condition get_disk_key_data(std::vector<uint8_t> &data) const;
@@ -53,6 +58,11 @@ private:
 	util::random_read_write *   fhandle;    // file if not a CHD
 	info                        hdinfo;     // hard disk info
 	uint32_t                    fileoffset; // offset in the file where the HDD image starts.  not valid for CHDs.
+
+	// copy-on-write overlay, keeping writes in memory instead of in the CHD
+	bool                        overlay_active;     // writes go to the overlay
+	std::vector<bool>           overlay_present;    // one bit per hunk, set if the hunk is in the overlay
+	std::unordered_map<uint32_t, std::unique_ptr<uint8_t []> > overlay; // written hunks, keyed by hunk number
 };
 
 #endif // MAME_LIB_UTIL_HARDDISK_H
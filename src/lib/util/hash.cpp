@@ -16,6 +16,8 @@
 
 #include <cassert>
 #include <cctype>
+#include <memory>
+#include <new>
 #include <optional>
 
 
@@ -399,18 +401,21 @@ std::error_condition hash_collection::compute(random_read &stream, uint64_t offs
 	// begin
 	std::unique_ptr<hash_creator> creator = create(types);
 
-	// local buffer of arbitrary size
-	uint8_t buffer[2048];
+	// read in large chunks so big files are streamed sequentially
+	std::size_t const buffer_size = std::min<std::size_t>(length, 1U << 20);
+	std::unique_ptr<uint8_t []> const buffer(new (std::nothrow) uint8_t [buffer_size]);
+	if (buffer_size && !buffer)
+		return std::errc::not_enough_memory;
 
 	// run the hashes
 	actual = 0U;
 	while (length)
 	{
 		// determine the size of the next chunk
-		unsigned const chunk_length = std::min(length, sizeof(buffer));
+		std::size_t const chunk_length = std::min(length, buffer_size);
 
 		// read one chunk
-		auto const [err, bytes_read] = read_at(stream, offset, buffer, chunk_length);
+		auto const [err, bytes_read] = read_at(stream, offset, buffer.get(), chunk_length);
 		if (err)
 			return err;
 		if (!bytes_read) // EOF?
@@ -419,7 +424,7 @@ std::error_condition hash_collection::compute(random_read &stream, uint64_t offs
 		length -= bytes_read;
 
 		// append the chunk
-		creator->append(buffer, bytes_read);
+		creator->append(buffer.get(), bytes_read);
 		actual += bytes_read;
 	}
 
@@ -17,9 +17,29 @@
 #include <zlib.h>
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define HASHING_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#if defined(__ARM_FEATURE_CRC32)
+#define HASHING_ARM_CRC32
+#include <arm_acle.h>
+#endif
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#define HASHING_ARM_SHA1
+#include <arm_neon.h>
+#endif
+#endif
+
 
 namespace util {
 
@@ -103,6 +123,264 @@ inline void sha1_process(std::array<uint32_t, 5> &st, uint32_t *data) noexcept
 		st[i] += d[i];
 }
 
+
+//-------------------------------------------------
+//  hardware CRC-32 and SHA-1 - x86 CPUs with
+//  PCLMULQDQ and SHA extensions are detected at
+//  run time, ARMv8 gets them when the compiler
+//  targets the CRC and crypto extensions
+//-------------------------------------------------
+
+using crc32_func = uint32_t (*)(uint32_t crc, const uint8_t *data, uint32_t length) noexcept;
+using sha1_func = void (*)(std::array<uint32_t, 5> &st, const uint8_t *data, uint32_t blocks) noexcept;
+
+uint32_t crc32_zlib(uint32_t crc, const uint8_t *data, uint32_t length) noexcept
+{
+	return crc32(crc, reinterpret_cast<const Bytef *>(data), length);
+}
+
+#if defined(HASHING_X86)
+
+#if defined(_MSC_VER)
+#define HASHING_TARGET(features)
+#else
+#define HASHING_TARGET(features) __attribute__((target(features)))
+#endif
+
+// folds 64 bytes at a time with carry-less multiplies, then reduces to 32
+// bits (Intel's "Fast CRC Computation Using PCLMULQDQ Instruction")
+HASHING_TARGET("pclmul,sse4.1") uint32_t crc32_pclmul(uint32_t crc, const uint8_t *data, uint32_t length) noexcept
+{
+	if (length < 64U)
+		return crc32_zlib(crc, data, length);
+
+	alignas(16) static const uint64_t k1k2[] = { 0x0154442bd4U, 0x01c6e41596U };
+	alignas(16) static const uint64_t k3k4[] = { 0x01751997d0U, 0x00ccaa009eU };
+	alignas(16) static const uint64_t k5k0[] = { 0x0163cd6124U, 0x0000000000U };
+	alignas(16) static const uint64_t poly[] = { 0x01db710641U, 0x01f7011641U };
+
+	uint32_t const tail = length & 15U;
+	length -= tail;
+
+	__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00));
+	__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10));
+	__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20));
+	__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(~crc));
+	data += 64U;
+	length -= 64U;
+
+	__m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+	while (length >= 64U)
+	{
+		__m128i const x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		__m128i const x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		__m128i const x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		__m128i const x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30)));
+		data += 64U;
+		length -= 64U;
+	}
+
+	// fold the four lanes into one, then any remaining 16-byte blocks
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+	for (__m128i const next : { x2, x3, x4 })
+	{
+		__m128i const x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), next), x5);
+	}
+	while (length >= 16U)
+	{
+		__m128i const x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data))), x5);
+		data += 16U;
+		length -= 16U;
+	}
+
+	// fold 128 bits to 64, then Barrett reduce to 32
+	__m128i const mask = _mm_setr_epi32(~0, 0, ~0, 0);
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x00), x2);
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+	x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x10);
+	x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return crc32_zlib(~uint32_t(_mm_extract_epi32(x1, 1)), data, tail);
+}
+
+// the state is kept as e, d, c, b, a, so b-a load straight into the
+// lane order the SHA instructions use
+#define SHA1_SHANI_ROUNDS(i) \
+		if ((i) >= 4) \
+			msg[(i) & 3] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(msg[(i) & 3], msg[((i) + 1) & 3]), msg[((i) + 2) & 3]), msg[((i) + 3) & 3]); \
+		e = (i) ? _mm_sha1nexte_epu32(prev, msg[(i) & 3]) : _mm_add_epi32(e, msg[0]); \
+		prev = abcd; \
+		abcd = _mm_sha1rnds4_epu32(abcd, e, (i) / 5);
+
+HASHING_TARGET("sha,sse4.1,ssse3") void sha1_shani(std::array<uint32_t, 5> &st, const uint8_t *data, uint32_t blocks) noexcept
+{
+	__m128i const swap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+	__m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&st[1]));
+	__m128i e0 = _mm_set_epi32(st[0], 0, 0, 0);
+
+	for ( ; blocks; blocks--, data += 64)
+	{
+		__m128i const abcd_save = abcd;
+		__m128i msg[4];
+		for (unsigned i = 0U; i < 4U; i++)
+			msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + (i * 16U))), swap);
+
+		__m128i e = e0, prev = abcd;
+		SHA1_SHANI_ROUNDS(0)  SHA1_SHANI_ROUNDS(1)  SHA1_SHANI_ROUNDS(2)  SHA1_SHANI_ROUNDS(3)
+		SHA1_SHANI_ROUNDS(4)  SHA1_SHANI_ROUNDS(5)  SHA1_SHANI_ROUNDS(6)  SHA1_SHANI_ROUNDS(7)
+		SHA1_SHANI_ROUNDS(8)  SHA1_SHANI_ROUNDS(9)  SHA1_SHANI_ROUNDS(10) SHA1_SHANI_ROUNDS(11)
+		SHA1_SHANI_ROUNDS(12) SHA1_SHANI_ROUNDS(13) SHA1_SHANI_ROUNDS(14) SHA1_SHANI_ROUNDS(15)
+		SHA1_SHANI_ROUNDS(16) SHA1_SHANI_ROUNDS(17) SHA1_SHANI_ROUNDS(18) SHA1_SHANI_ROUNDS(19)
+
+		e0 = _mm_sha1nexte_epu32(prev, e0);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(&st[1]), abcd);
+	st[0] = uint32_t(_mm_extract_epi32(e0, 3));
+}
+
+#undef SHA1_SHANI_ROUNDS
+
+void cpuid(uint32_t leaf, uint32_t (&regs)[4]) noexcept
+{
+#if defined(_MSC_VER)
+	int r[4];
+	__cpuidex(r, int(leaf), 0);
+	for (unsigned i = 0U; i < 4U; i++)
+		regs[i] = uint32_t(r[i]);
+#else
+	if (!__get_cpuid_count(leaf, 0, &regs[0], &regs[1], &regs[2], &regs[3]))
+		regs[0] = regs[1] = regs[2] = regs[3] = 0U;
+#endif
+}
+
+#endif // defined(HASHING_X86)
+
+#if defined(HASHING_ARM_CRC32)
+
+uint32_t crc32_armv8(uint32_t crc, const uint8_t *data, uint32_t length) noexcept
+{
+	crc = ~crc;
+	for ( ; length >= 8U; data += 8, length -= 8U)
+	{
+		uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		crc = __crc32d(crc, little_endianize_int64(value));
+	}
+	for ( ; length; data++, length--)
+		crc = __crc32b(crc, *data);
+	return ~crc;
+}
+
+#endif // defined(HASHING_ARM_CRC32)
+
+#if defined(HASHING_ARM_SHA1)
+
+void sha1_armv8(std::array<uint32_t, 5> &st, const uint8_t *data, uint32_t blocks) noexcept
+{
+	static const uint32_t k[4] = { 0x5a827999U, 0x6ed9eba1U, 0x8f1bbcdcU, 0xca62c1d6U };
+	uint32_t const init[4] = { st[4], st[3], st[2], st[1] };
+	uint32x4_t abcd = vld1q_u32(init);
+	uint32_t e0 = st[0];
+
+	for ( ; blocks; blocks--, data += 64)
+	{
+		uint32x4_t const abcd_save = abcd;
+		uint32x4_t msg[4];
+		for (unsigned i = 0U; i < 4U; i++)
+			msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + (i * 16U))));
+
+		uint32_t e = e0;
+		for (unsigned i = 0U; i < 20U; i++)
+		{
+			if (i >= 4U)
+				msg[i & 3] = vsha1su1q_u32(vsha1su0q_u32(msg[i & 3], msg[(i + 1) & 3], msg[(i + 2) & 3]), msg[(i + 3) & 3]);
+			uint32x4_t const wk = vaddq_u32(msg[i & 3], vdupq_n_u32(k[i / 5]));
+			uint32_t const next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+			if (i < 5U)
+				abcd = vsha1cq_u32(abcd, e, wk);
+			else if ((i >= 10U) && (i < 15U))
+				abcd = vsha1mq_u32(abcd, e, wk);
+			else
+				abcd = vsha1pq_u32(abcd, e, wk);
+			e = next;
+		}
+
+		e0 += e;
+		abcd = vaddq_u32(abcd, abcd_save);
+	}
+
+	st[0] = e0;
+	st[1] = vgetq_lane_u32(abcd, 3);
+	st[2] = vgetq_lane_u32(abcd, 2);
+	st[3] = vgetq_lane_u32(abcd, 1);
+	st[4] = vgetq_lane_u32(abcd, 0);
+}
+
+#endif // defined(HASHING_ARM_SHA1)
+
+crc32_func select_crc32() noexcept
+{
+#if defined(HASHING_X86)
+	uint32_t regs[4];
+	cpuid(1U, regs);
+	if ((regs[2] & (1U << 1)) && (regs[2] & (1U << 19)))
+		return &crc32_pclmul;
+#elif defined(HASHING_ARM_CRC32)
+	return &crc32_armv8;
+#endif
+	return &crc32_zlib;
+}
+
+sha1_func select_sha1() noexcept
+{
+#if defined(HASHING_X86)
+	uint32_t regs[4];
+	cpuid(0U, regs);
+	if (regs[0] >= 7U)
+	{
+		cpuid(1U, regs);
+		bool const ssse3_sse41 = (regs[2] & (1U << 9)) && (regs[2] & (1U << 19));
+		cpuid(7U, regs);
+		if (ssse3_sse41 && (regs[1] & (1U << 29)))
+			return &sha1_shani;
+	}
+#elif defined(HASHING_ARM_SHA1)
+	return &sha1_armv8;
+#endif
+	return nullptr;
+}
+
+inline crc32_func crc32_impl() noexcept
+{
+	static crc32_func const func = select_crc32();
+	return func;
+}
+
+inline sha1_func sha1_impl() noexcept
+{
+	static sha1_func const func = select_sha1();
+	return func;
+}
+
 } // anonymous namespace
 
 
@@ -193,6 +471,7 @@ void sha1_creator::append(const void *data, uint32_t length) noexcept
 #else
 	constexpr unsigned swizzle = 0U;
 #endif
+	sha1_func const hardware = sha1_impl();
 	uint32_t residual = (uint32_t(m_cnt) >> 3) & 63U;
 	m_cnt += uint64_t(length) << 3;
 	uint32_t offset = 0U;
@@ -202,13 +481,33 @@ void sha1_creator::append(const void *data, uint32_t length) noexcept
 		{
 			for (offset = 0U; (offset + residual) < 64U; offset++)
 				reinterpret_cast<uint8_t *>(m_buf)[(offset + residual) ^ swizzle] = reinterpret_cast<const uint8_t *>(data)[offset];
-			sha1_process(m_st, m_buf);
+			if (hardware)
+			{
+				uint8_t block[64];
+				for (unsigned i = 0U; i < 64U; i++)
+					block[i] = reinterpret_cast<const uint8_t *>(m_buf)[i ^ swizzle];
+				hardware(m_st, block, 1U);
+			}
+			else
+			{
+				sha1_process(m_st, m_buf);
+			}
+		}
+		if (hardware)
+		{
+			// hardware takes whole blocks straight from the source
+			uint32_t const blocks = (length - offset) >> 6;
+			hardware(m_st, reinterpret_cast<const uint8_t *>(data) + offset, blocks);
+			offset += blocks << 6;
 		}
-		while ((length - offset) >= 64U)
+		else
 		{
-			for (residual = 0U; residual < 64U; residual++, offset++)
-				reinterpret_cast<uint8_t *>(m_buf)[residual ^ swizzle] = reinterpret_cast<const uint8_t *>(data)[offset];
-			sha1_process(m_st, m_buf);
+			while ((length - offset) >= 64U)
+			{
+				for (residual = 0U; residual < 64U; residual++, offset++)
+					reinterpret_cast<uint8_t *>(m_buf)[residual ^ swizzle] = reinterpret_cast<const uint8_t *>(data)[offset];
+				sha1_process(m_st, m_buf);
+			}
 		}
 		residual = 0U;
 	}
@@ -336,7 +635,7 @@ std::string crc32_t::as_string() const
 
 void crc32_creator::append(const void *data, uint32_t length) noexcept
 {
-	m_accum.m_raw = crc32(m_accum, reinterpret_cast<const Bytef *>(data), length);
+	m_accum.m_raw = crc32_impl()(m_accum, reinterpret_cast<const uint8_t *>(data), length);
 }
 
 
@@ -21,6 +21,7 @@
 #include <cctype>
 #include <cstdarg>
 #include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 
@@ -898,10 +899,63 @@ void core_options::parse_command_line(const std::vector<std::string> &args, int
 //-------------------------------------------------
 
 void core_options::parse_ini_file(util::core_file &inifile, int priority, bool ignore_unknown_options, bool always_override)
+{
+	apply_ini(parsed_ini(inifile), priority, ignore_unknown_options, always_override);
+}
+
+
+//-------------------------------------------------
+//  apply_ini - set the entries from an INI file
+//  that has already been read
+//-------------------------------------------------
+
+void core_options::apply_ini(const parsed_ini &ini, int priority, bool ignore_unknown_options, bool always_override)
 {
 	std::ostringstream error_stream;
 	condition_type condition = condition_type::NONE;
 
+	for (parsed_ini::line const &line : ini.m_lines)
+	{
+		// lines without a value are kept whole so they can be reported
+		if (line.name.empty())
+		{
+			condition = std::max(condition, condition_type::WARN);
+			util::stream_format(error_stream, "Warning: invalid line in INI: %s", line.value);
+			continue;
+		}
+
+		// find our entry
+		entry::shared_ptr curentry = get_entry(line.name);
+		if (!curentry)
+		{
+			if (!ignore_unknown_options)
+			{
+				condition = std::max(condition, condition_type::WARN);
+				util::stream_format(error_stream, "Warning: unknown option in INI: %s\n", line.name);
+			}
+			continue;
+		}
+
+		// set the new data
+		do_set_value(*curentry, line.value, priority, error_stream, condition, true);
+	}
+
+	// did we have any errors that may need to be aggregated?
+	throw_options_exception_if_appropriate(condition, error_stream);
+}
+
+
+//-------------------------------------------------
+//  parsed_ini - read an INI file and split it
+//  into option names and values
+//-------------------------------------------------
+
+core_options::parsed_ini::parsed_ini(util::core_file &inifile)
+{
+	// offsets are collected first, as the text moves while it grows
+	struct extent { std::size_t name, namelen, value, valuelen; };
+	std::vector<extent> extents;
+
 	// loop over lines in the file
 	char buffer[4096];
 	while (inifile.gets(buffer, std::size(buffer)) != nullptr)
@@ -922,11 +976,11 @@ void core_options::parse_ini_file(util::core_file &inifile, int priority, bool i
 			if (isspace((uint8_t)*temp))
 				break;
 
-		// if we hit the end early, print a warning and continue
+		// if we hit the end early, keep the line to warn about
 		if (*temp == 0)
 		{
-			condition = std::max(condition, condition_type::WARN);
-			util::stream_format(error_stream, "Warning: invalid line in INI: %s", buffer);
+			extents.push_back(extent{ m_text.size(), 0, m_text.size(), std::strlen(buffer) });
+			m_text.append(buffer);
 			continue;
 		}
 
@@ -945,24 +999,17 @@ void core_options::parse_ini_file(util::core_file &inifile, int priority, bool i
 		}
 		*temp = 0;
 
-		// find our entry
-		entry::shared_ptr curentry = get_entry(optionname);
-		if (!curentry)
-		{
-			if (!ignore_unknown_options)
-			{
-				condition = std::max(condition, condition_type::WARN);
-				util::stream_format(error_stream, "Warning: unknown option in INI: %s\n", optionname);
-			}
-			continue;
-		}
-
-		// set the new data
-		do_set_value(*curentry, trim_spaces_and_quotes(optiondata), priority, error_stream, condition, true);
+		// keep the name and the trimmed value
+		std::string_view const name(optionname);
+		std::string_view const value(trim_spaces_and_quotes(optiondata));
+		extents.push_back(extent{ m_text.size(), name.length(), m_text.size() + name.length(), value.length() });
+		m_text.append(name).append(value);
 	}
 
-	// did we have any errors that may need to be aggregated?
-	throw_options_exception_if_appropriate(condition, error_stream);
+	std::string_view const text(m_text);
+	m_lines.reserve(extents.size());
+	for (extent const &e : extents)
+		m_lines.push_back(line{ text.substr(e.name, e.namelen), text.substr(e.value, e.valuelen) });
 }
 
 
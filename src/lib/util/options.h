@@ -109,6 +109,29 @@ public:
 		MULTIPATH        // semicolon-delimited paths option
 	};
 
+	// an INI file read and split into option names and values once, so it
+	// can be applied to any number of option sets without reading it again
+	class parsed_ini
+	{
+	public:
+		parsed_ini(util::core_file &inifile);
+
+		std::size_t size() const noexcept { return m_lines.size(); }
+
+	private:
+		friend class core_options;
+
+		// a line is a name and value, or a line that has no value when the name is empty
+		struct line
+		{
+			std::string_view    name;
+			std::string_view    value;
+		};
+
+		std::string         m_text;             // names and values, back to back
+		std::vector<line>   m_lines;            // views into m_text, in file order
+	};
+
 	// information about a single entry in the options
 	class entry
 	{
@@ -196,6 +219,7 @@ public:
 	// parsing/input
 	void parse_command_line(const std::vector<std::string> &args, int priority, bool ignore_unknown_options = false);
 	void parse_ini_file(util::core_file &inifile, int priority, bool ignore_unknown_options, bool always_override);
+	void apply_ini(const parsed_ini &ini, int priority, bool ignore_unknown_options, bool always_override);
 	void copy_from(const core_options &that);
 
 	// output
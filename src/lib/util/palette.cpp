@@ -214,6 +214,7 @@ palette_t::palette_t(uint32_t numcolors, uint32_t numgroups)
 		m_adjusted_rgb15(numcolors * numgroups + 2),
 		m_group_bright(numgroups),
 		m_group_contrast(numgroups),
+		m_group_map(numgroups * 256),
 		m_client_list(nullptr)
 {
 	// initialize gamma map
@@ -232,6 +233,7 @@ palette_t::palette_t(uint32_t numcolors, uint32_t numgroups)
 	{
 		m_group_bright[index] = 0.0f;
 		m_group_contrast[index] = 1.0f;
+		update_group_map(index);
 	}
 
 	// initialize the expanded data
@@ -286,8 +288,11 @@ void palette_t::set_brightness(float brightness)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
+	{
+		update_group_map(groupnum);
 		for (int index = 0; index < m_numcolors; index++)
 			update_adjusted_color(groupnum, index);
+	}
 }
 
 
@@ -305,8 +310,11 @@ void palette_t::set_contrast(float contrast)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
+	{
+		update_group_map(groupnum);
 		for (int index = 0; index < m_numcolors; index++)
 			update_adjusted_color(groupnum, index);
+	}
 }
 
 
@@ -333,8 +341,11 @@ void palette_t::set_gamma(float gamma)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
+	{
+		update_group_map(groupnum);
 		for (int index = 0; index < m_numcolors; index++)
 			update_adjusted_color(groupnum, index);
+	}
 }
 
 
@@ -466,6 +477,7 @@ void palette_t::group_set_brightness(uint32_t group, float brightness)
 
 	// set the contrast
 	m_group_bright[group] = brightness;
+	update_group_map(group);
 
 	// update across all colors
 	for (int index = 0; index < m_numcolors; index++)
@@ -488,6 +500,7 @@ void palette_t::group_set_contrast(uint32_t group, float contrast)
 
 	// set the contrast
 	m_group_contrast[group] = contrast;
+	update_group_map(group);
 
 	// update across all colors
 	for (int index = 0; index < m_numcolors; index++)
@@ -548,11 +561,22 @@ void palette_t::normalize_range(uint32_t start, uint32_t end, int lum_min, int l
 
 void palette_t::update_adjusted_color(uint32_t group, uint32_t index)
 {
-	// compute the adjusted value
-	rgb_t adjusted = adjust_palette_entry(m_entry_color[index],
-											m_group_bright[group] + m_brightness,
-											m_group_contrast[group] * m_entry_contrast[index] * m_contrast,
-											m_gamma_map);
+	// compute the adjusted value; entries at unit contrast can use the
+	// group's precomputed channel map
+	rgb_t adjusted;
+	if (m_entry_contrast[index] == 1.0f)
+	{
+		uint8_t const *const map = &m_group_map[group * 256];
+		rgb_t const entry = m_entry_color[index];
+		adjusted = rgb_t(entry.a(), map[entry.r()], map[entry.g()], map[entry.b()]);
+	}
+	else
+	{
+		adjusted = adjust_palette_entry(m_entry_color[index],
+										m_group_bright[group] + m_brightness,
+										m_group_contrast[group] * m_entry_contrast[index] * m_contrast,
+										m_gamma_map);
+	}
 
 	// if not different, ignore
 	uint32_t finalindex = group * m_numcolors + index;
@@ -567,3 +591,24 @@ void palette_t::update_adjusted_color(uint32_t group, uint32_t index)
 	for (palette_client *client = m_client_list; client != nullptr; client = client->next())
 		client->mark_dirty(finalindex);
 }
+
+
+/**
+ * @fn  void palette_t::update_group_map(uint32_t group)
+ *
+ * @brief   -------------------------------------------------
+ *            update_group_map - recompute the channel map used for entries of a group
+ *            at unit contrast
+ *          -------------------------------------------------.
+ *
+ * @param   group   The group.
+ */
+
+void palette_t::update_group_map(uint32_t group)
+{
+	float const brightness = m_group_bright[group] + m_brightness;
+	float const contrast = m_group_contrast[group] * m_contrast;
+	uint8_t *const map = &m_group_map[group * 256];
+	for (int value = 0; value < 256; value++)
+		map[value] = rgb_t::clamp(float(m_gamma_map[value]) * contrast + brightness);
+}
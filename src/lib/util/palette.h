@@ -196,6 +196,7 @@ private:
 	// internal helpers
 	rgb_t adjust_palette_entry(rgb_t entry, float brightness, float contrast, const uint8_t *gamma_map);
 	void update_adjusted_color(uint32_t group, uint32_t index);
+	void update_group_map(uint32_t group);
 
 	// internal state
 	uint32_t           m_refcount;              // reference count on the palette
@@ -214,6 +215,7 @@ private:
 
 	std::vector<float> m_group_bright;          // brightness value for each group
 	std::vector<float> m_group_contrast;        // contrast value for each group
+	std::vector<uint8_t> m_group_map;           // per-group channel map for entries at unit contrast
 
 	palette_client *m_client_list;                // list of clients for this palette
 };
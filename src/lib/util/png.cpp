@@ -970,10 +970,11 @@ static std::error_condition write_chunk(write_stream &fp, const uint8_t *data, u
 
 /*-------------------------------------------------
     write_deflated_chunk - write an in-memory
-    chunk to the given file by deflating it
+    chunk to the given file by deflating it at
+    the given zlib compression level
 -------------------------------------------------*/
 
-static std::error_condition write_deflated_chunk(random_write &fp, uint8_t *data, uint32_t type, uint32_t length) noexcept
+static std::error_condition write_deflated_chunk(random_write &fp, uint8_t *data, uint32_t type, uint32_t length, int level) noexcept
 {
 	std::error_condition err;
 	std::uint64_t lengthpos;
@@ -1001,7 +1002,7 @@ static std::error_condition write_deflated_chunk(random_write &fp, uint8_t *data
 	memset(&stream, 0, sizeof(stream));
 	stream.next_in = data;
 	stream.avail_in = length;
-	zerr = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
+	zerr = deflateInit(&stream, level);
 	if (Z_ERRNO == zerr)
 		return std::error_condition(errno, std::generic_category());
 	else if (Z_MEM_ERROR == zerr)
@@ -1213,7 +1214,7 @@ static std::error_condition convert_bitmap_to_image_rgb(png_info &pnginfo, bitma
     chunks to the given file
 -------------------------------------------------*/
 
-static std::error_condition write_png_stream(random_write &fp, png_info &pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette) noexcept
+static std::error_condition write_png_stream(random_write &fp, png_info &pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette, int compression) noexcept
 {
 	uint8_t tempbuff[16];
 	std::error_condition error;
@@ -1247,7 +1248,7 @@ static std::error_condition write_png_stream(random_write &fp, png_info &pnginfo
 		return error;
 
 	// write a single IDAT chunk
-	error = write_deflated_chunk(fp, pnginfo.image.get(), PNG_CN_IDAT, pnginfo.height * (compute_rowbytes(pnginfo) + 1));
+	error = write_deflated_chunk(fp, pnginfo.image.get(), PNG_CN_IDAT, pnginfo.height * (compute_rowbytes(pnginfo) + 1), compression);
 	if (error)
 		return error;
 
@@ -1294,8 +1295,12 @@ static std::error_condition write_png_stream(random_write &fp, png_info &pnginfo
 }
 
 
-std::error_condition png_write_bitmap(random_write &fp, png_info *info, bitmap_t const &bitmap, int palette_length, const rgb_t *palette) noexcept
+std::error_condition png_write_bitmap(random_write &fp, png_info *info, bitmap_t const &bitmap, int palette_length, const rgb_t *palette, int compression) noexcept
 {
+	// clamp the compression level to what zlib accepts
+	if ((compression < Z_DEFAULT_COMPRESSION) || (compression > Z_BEST_COMPRESSION))
+		compression = Z_DEFAULT_COMPRESSION;
+
 	// use a dummy pnginfo if none passed to us
 	png_info pnginfo;
 	if (!info)
@@ -1307,7 +1312,7 @@ std::error_condition png_write_bitmap(random_write &fp, png_info *info, bitmap_t
 		return err;
 
 	// write the rest of the PNG data
-	return write_png_stream(fp, *info, bitmap, palette_length, palette);
+	return write_png_stream(fp, *info, bitmap, palette_length, palette, compression);
 }
 
 
@@ -1336,7 +1341,7 @@ std::error_condition mng_capture_start(random_write &fp, bitmap_t const &bitmap,
 
 std::error_condition mng_capture_frame(random_write &fp, png_info &info, bitmap_t const &bitmap, int palette_length, rgb_t const *palette) noexcept
 {
-	return write_png_stream(fp, info, bitmap, palette_length, palette);
+	return write_png_stream(fp, info, bitmap, palette_length, palette, Z_DEFAULT_COMPRESSION);
 }
 
 
@@ -104,7 +104,8 @@ private:
 
 std::error_condition png_read_bitmap(read_stream &fp, bitmap_argb32 &bitmap) noexcept;
 
-std::error_condition png_write_bitmap(random_write &fp, png_info *info, bitmap_t const &bitmap, int palette_length, const rgb_t *palette) noexcept;
+// compression is a zlib level from 0 (store) to 9 (best), or -1 for the default
+std::error_condition png_write_bitmap(random_write &fp, png_info *info, bitmap_t const &bitmap, int palette_length, const rgb_t *palette, int compression = -1) noexcept;
 
 std::error_condition mng_capture_start(random_write &fp, bitmap_t const &bitmap, unsigned rate) noexcept;
 std::error_condition mng_capture_frame(random_write &fp, png_info &info, bitmap_t const &bitmap, int palette_length, rgb_t const *palette) noexcept;
@@ -33,6 +33,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <ratio>
 #include <utility>
@@ -121,6 +123,77 @@ private:
 };
 
 
+// decompressed solid blocks shared by all open archives, so extracting many
+// files from one block only decompresses it once
+class m7z_block_cache
+{
+public:
+	using block = std::shared_ptr<Byte const>;
+
+	block find(std::string_view filename, std::uint64_t length, UInt32 folder, std::size_t &size) noexcept
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		for (auto it = m_entries.begin(); m_entries.end() != it; ++it)
+		{
+			if ((it->folder == folder) && (it->length == length) && (it->filename == filename))
+			{
+				m_entries.splice(m_entries.begin(), m_entries, it);
+				size = it->size;
+				return it->data;
+			}
+		}
+		return block();
+	}
+
+	void add(std::string_view filename, std::uint64_t length, UInt32 folder, block const &data, std::size_t size) noexcept
+	{
+		if (size > BUDGET)
+			return;
+
+		std::lock_guard<std::mutex> guard(m_mutex);
+		try
+		{
+			m_entries.emplace_front(entry{ std::string(filename), length, folder, data, size });
+		}
+		catch (...)
+		{
+			return;
+		}
+		m_total += size;
+
+		// drop least recently used blocks until we're back under budget
+		while (m_total > BUDGET)
+		{
+			m_total -= m_entries.back().size;
+			m_entries.pop_back();
+		}
+	}
+
+	void clear() noexcept
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_entries.clear();
+		m_total = 0;
+	}
+
+private:
+	struct entry
+	{
+		std::string     filename;
+		std::uint64_t   length;
+		UInt32          folder;
+		block           data;
+		std::size_t     size;
+	};
+
+	static constexpr std::size_t BUDGET = 256 * 1024 * 1024; // total size of cached blocks
+
+	std::mutex          m_mutex;
+	std::list<entry>    m_entries;  // most recently used first
+	std::size_t         m_total = 0;
+};
+
+
 class m7z_file_impl
 {
 public:
@@ -165,9 +238,12 @@ public:
 	static void cache_clear() noexcept
 	{
 		// clear call cache entries
-		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (auto &cached : s_cache)
-			cached.reset();
+		{
+			std::lock_guard<std::mutex> guard(s_cache_mutex);
+			for (auto &cached : s_cache)
+				cached.reset();
+		}
+		s_block_cache.clear();
 	}
 
 	std::error_condition initialize() noexcept;
@@ -220,10 +296,12 @@ private:
 			bool partialpath) noexcept;
 	void make_utf8_name(int index);
 	void set_curr_modified() noexcept;
+	std::error_condition copy_from_block(void *buffer, std::size_t length) noexcept;
 
 	static constexpr std::size_t            CACHE_SIZE = 8;
 	static std::array<ptr, CACHE_SIZE>      s_cache;
 	static std::mutex                       s_cache_mutex;
+	static m7z_block_cache                  s_block_cache;
 
 	const std::string                       m_filename;             // copy of _7Z filename (for caching)
 
@@ -249,6 +327,8 @@ private:
 	UInt32                                  m_block_index;
 	Byte *                                  m_out_buffer;
 	std::size_t                             m_out_buffer_size;
+	m7z_block_cache::block                  m_block;                // block shared through the block cache
+	std::size_t                             m_block_size;
 	Byte                                    m_look_stream_buf[65'536];
 };
 
@@ -295,6 +375,7 @@ private:
 
 std::array<m7z_file_impl::ptr, m7z_file_impl::CACHE_SIZE> m7z_file_impl::s_cache;
 std::mutex m7z_file_impl::s_cache_mutex;
+m7z_block_cache m7z_file_impl::s_block_cache;
 
 
 
@@ -317,6 +398,8 @@ m7z_file_impl::m7z_file_impl(std::string &&filename) noexcept
 	, m_block_index(0)
 	, m_out_buffer(nullptr)
 	, m_out_buffer_size(0)
+	, m_block()
+	, m_block_size(0)
 {
 	m_alloc_imp.Alloc = &SzAlloc;
 	m_alloc_imp.Free = &SzFree;
@@ -450,6 +533,27 @@ std::error_condition m7z_file_impl::decompress(void *buffer, std::size_t length)
 		return archive_file::error::BUFFER_TOO_SMALL;
 	}
 
+	// archives opened by name share decompressed solid blocks
+	UInt32 const folder(m_db.FileToFolder[m_curr_file_idx]);
+	bool const shared(!m_filename.empty() && (UInt32(-1) != folder));
+	if (shared)
+	{
+		if (!m_block || (m_block_index != folder))
+		{
+			std::size_t size(0);
+			m7z_block_cache::block cached(s_block_cache.find(m_filename, m_archive_stream.length, folder, size));
+			if (cached)
+			{
+				m_block = std::move(cached);
+				m_block_size = size;
+				m_block_index = folder;
+			}
+		}
+		if (m_block && (m_block_index == folder))
+			return copy_from_block(buffer, length);
+		m_block.reset();
+	}
+
 	// make sure the file is open..
 	if (!m_archive_stream.file)
 	{
@@ -486,12 +590,61 @@ std::error_condition m7z_file_impl::decompress(void *buffer, std::size_t length)
 		}
 	}
 
+	// hand the block over to the block cache so other instances can use it
+	if (shared && m_out_buffer)
+	{
+		try
+		{
+			m_block.reset(m_out_buffer, [] (Byte *block) { SzFree(nullptr, block); });
+			m_block_size = m_out_buffer_size;
+			m_out_buffer = nullptr;
+			m_out_buffer_size = 0;
+			s_block_cache.add(m_filename, m_archive_stream.length, folder, m_block, m_block_size);
+			return copy_from_block(buffer, length);
+		}
+		catch (...)
+		{
+			// shared_ptr frees the block if it fails to allocate its control block
+			m_block.reset();
+			m_out_buffer = nullptr;
+			m_out_buffer_size = 0;
+			return std::errc::not_enough_memory;
+		}
+	}
+
 	// copy to destination buffer
 	std::memcpy(buffer, m_out_buffer + offset, (std::min<std::size_t>)(length, out_size_processed));
 	return std::error_condition();
 }
 
 
+/*-------------------------------------------------
+    copy_from_block - extract the current file
+    from the shared decompressed block
+-------------------------------------------------*/
+
+std::error_condition m7z_file_impl::copy_from_block(void *buffer, std::size_t length) noexcept
+{
+	UInt32 const folder(m_db.FileToFolder[m_curr_file_idx]);
+	UInt64 const unpack_pos(m_db.UnpackPositions[m_curr_file_idx]);
+	std::size_t const offset(std::size_t(unpack_pos - m_db.UnpackPositions[m_db.FolderToFile[folder]]));
+	std::size_t const size(std::size_t(m_db.UnpackPositions[m_curr_file_idx + 1] - unpack_pos));
+	if ((offset + size) > m_block_size)
+	{
+		osd_printf_error("un7z: error decompressing %s from %s (%d)\n", m_curr_name, m_filename, int(SZ_ERROR_FAIL));
+		return archive_file::error::DECOMPRESS_ERROR;
+	}
+	if (SzBitWithVals_Check(&m_db.CRCs, m_curr_file_idx) && (CrcCalc(m_block.get() + offset, size) != m_db.CRCs.Vals[m_curr_file_idx]))
+	{
+		osd_printf_error("un7z: error decompressing %s from %s (%d)\n", m_curr_name, m_filename, int(SZ_ERROR_CRC));
+		return archive_file::error::DECOMPRESS_ERROR;
+	}
+
+	std::memcpy(buffer, m_block.get() + offset, (std::min<std::size_t>)(length, size));
+	return std::error_condition();
+}
+
+
 int m7z_file_impl::search(
 		int i,
 		std::uint32_t search_crc,
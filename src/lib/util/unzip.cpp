@@ -26,12 +26,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <chrono>
 #include <cstring>
 #include <cstdlib>
 #include <ctime>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <ratio>
@@ -71,6 +73,8 @@ public:
 };
 
 
+class zip_directory_index;
+
 class zip_file_impl
 {
 public:
@@ -118,6 +122,21 @@ public:
 
 	std::error_condition initialize() noexcept
 	{
+		// an archive that hasn't changed since it was indexed needn't be read at all
+		std::uint64_t indexlength(0);
+		std::int64_t indexmodified(0);
+		bool const indexed(!m_filename.empty() && directory_index_enabled());
+		if (indexed)
+		{
+			if (!stat_archive(indexlength, indexmodified))
+				return std::errc::no_such_file_or_directory;
+			if (find_indexed_directory(indexlength, indexmodified))
+			{
+				osd_printf_verbose("unzip: found %s central directory in index\n", m_filename);
+				return std::error_condition();
+			}
+		}
+
 		// read ecd data
 		auto const ziperr = read_ecd();
 		if (ziperr)
@@ -172,6 +191,8 @@ public:
 		}
 		osd_printf_verbose("unzip: read %s central directory\n", m_filename);
 
+		if (indexed)
+			add_indexed_directory(indexlength, indexmodified);
 		return std::error_condition();
 	}
 
@@ -222,6 +243,8 @@ public:
 	std::error_condition decompress(void *buffer, std::size_t length) noexcept;
 
 private:
+	friend class zip_directory_index;
+
 	zip_file_impl(const zip_file_impl &) = delete;
 	zip_file_impl(zip_file_impl &&) = delete;
 	zip_file_impl &operator=(const zip_file_impl &) = delete;
@@ -281,6 +304,12 @@ private:
 		return std::chrono::system_clock::from_time_t(std::mktime(&datetime));
 	}
 
+	// directory index
+	static bool directory_index_enabled() noexcept;
+	bool stat_archive(std::uint64_t &length, std::int64_t &modified) const noexcept;
+	bool find_indexed_directory(std::uint64_t length, std::int64_t modified) noexcept;
+	void add_indexed_directory(std::uint64_t length, std::int64_t modified) const noexcept;
+
 	// ZIP file parsing
 	std::error_condition read_ecd() noexcept;
 	std::error_condition get_compressed_data_offset(std::uint64_t &offset) noexcept;
@@ -330,7 +359,7 @@ private:
 	};
 
 	static constexpr std::size_t        DECOMPRESS_BUFSIZE = 16384;
-	static constexpr std::size_t        CACHE_SIZE = 8; // number of open files to cache
+	static constexpr std::size_t        CACHE_SIZE = 32; // number of open files to cache (shared by concurrent auditors)
 	static std::array<ptr, CACHE_SIZE>  s_cache;
 	static std::mutex                   s_cache_mutex;
 
@@ -384,6 +413,48 @@ private:
 };
 
 
+// persists ZIP central directories between runs, keyed by archive path and
+// validated against its length and modification time
+class zip_directory_index
+{
+public:
+	static zip_directory_index &instance() noexcept { return s_instance; }
+
+	bool enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+	void set_filename(std::string_view filename) noexcept;
+	bool find(std::string_view path, std::uint64_t length, std::int64_t modified, zip_file_impl::ecd &ecd, std::vector<std::uint8_t> &cd) noexcept;
+	void add(std::string_view path, std::uint64_t length, std::int64_t modified, zip_file_impl::ecd const &ecd, std::vector<std::uint8_t> const &cd) noexcept;
+	void flush() noexcept;
+
+private:
+	struct entry
+	{
+		std::uint64_t               length;
+		std::int64_t                modified;
+		zip_file_impl::ecd          ecd;
+		std::vector<std::uint8_t>   cd;
+	};
+
+	static constexpr char           MAGIC[8] = { 'M', 'Z', 'I', 'P', 'I', 'D', 'X', 1 };
+	static constexpr std::size_t    RECORD_HEADER = 4 + (8 * 2) + (4 * 2) + (8 * 4);
+
+	void load() noexcept;
+	static void append_record(std::vector<std::uint8_t> &buffer, std::string const &path, entry const &ent);
+
+	static zip_directory_index      s_instance;
+
+	std::mutex                      m_mutex;
+	std::atomic<bool>               m_enabled = false;
+	std::string                     m_filename;                 // index file, empty when disabled
+	bool                            m_loaded = false;           // index file has been read
+	std::map<std::string, entry, std::less<> > m_entries;
+	std::vector<std::string>        m_added;                    // entries not yet written out
+	std::size_t                     m_records = 0;              // records in the index file
+	bool                            m_rewrite = false;          // index file needs to be rewritten
+};
+
+
 class reader_base
 {
 protected:
@@ -708,6 +779,8 @@ archive_category_impl const f_archive_category_instance;
 std::array<zip_file_impl::ptr, zip_file_impl::CACHE_SIZE> zip_file_impl::s_cache;
 std::mutex zip_file_impl::s_cache_mutex;
 
+zip_directory_index zip_directory_index::s_instance;
+
 
 
 /*-------------------------------------------------
@@ -750,6 +823,283 @@ void zip_file_impl::close(ptr &&zip) noexcept
 }
 
 
+/***************************************************************************
+    DIRECTORY INDEX
+***************************************************************************/
+
+/*-------------------------------------------------
+    set_filename - select the index file, writing
+    out anything pending for the previous one
+-------------------------------------------------*/
+
+void zip_directory_index::set_filename(std::string_view filename) noexcept
+{
+	if (filename == m_filename)
+		return;
+
+	flush();
+
+	std::lock_guard<std::mutex> guard(m_mutex);
+	try
+	{
+		m_filename = filename;
+	}
+	catch (...)
+	{
+		m_filename.clear();
+	}
+	m_enabled.store(!m_filename.empty(), std::memory_order_relaxed);
+	m_loaded = false;
+	m_entries.clear();
+	m_added.clear();
+	m_records = 0;
+	m_rewrite = false;
+}
+
+
+/*-------------------------------------------------
+    load - read the index file on first use
+-------------------------------------------------*/
+
+void zip_directory_index::load() noexcept
+{
+	if (m_loaded)
+		return;
+	m_loaded = true;
+
+	osd_file::ptr file;
+	std::uint64_t filesize;
+	if (osd_file::open(m_filename, OPEN_FLAG_READ, file, filesize))
+		return;
+
+	try
+	{
+		std::vector<std::uint8_t> buffer;
+		if ((sizeof(MAGIC) > filesize) || (std::numeric_limits<std::uint32_t>::max() < filesize))
+		{
+			m_rewrite = true;
+			return;
+		}
+		buffer.resize(std::size_t(filesize));
+		std::uint32_t actual;
+		if (file->read(&buffer[0], 0, std::uint32_t(filesize), actual) || (actual != filesize) || std::memcmp(&buffer[0], MAGIC, sizeof(MAGIC)))
+		{
+			m_rewrite = true;
+			return;
+		}
+		file.reset();
+
+		// later records supersede earlier ones for the same archive
+		std::size_t offs(sizeof(MAGIC));
+		while ((offs + RECORD_HEADER) <= buffer.size())
+		{
+			std::uint8_t const *const header(&buffer[offs]);
+			std::uint32_t const pathlength(get_u32le(&header[0]));
+			entry ent;
+			ent.length = get_u64le(&header[4]);
+			ent.modified = std::int64_t(get_u64le(&header[12]));
+			ent.ecd.disk_number = get_u32le(&header[20]);
+			ent.ecd.cd_start_disk_number = get_u32le(&header[24]);
+			ent.ecd.cd_disk_entries = get_u64le(&header[28]);
+			ent.ecd.cd_total_entries = get_u64le(&header[36]);
+			ent.ecd.cd_size = get_u64le(&header[44]);
+			ent.ecd.cd_start_disk_offset = get_u64le(&header[52]);
+			if ((buffer.size() - offs - RECORD_HEADER) < (std::uint64_t(pathlength) + ent.ecd.cd_size))
+				break;
+			offs += RECORD_HEADER;
+
+			std::string path(reinterpret_cast<char const *>(&buffer[offs]), pathlength);
+			offs += pathlength;
+			ent.cd.assign(buffer.begin() + offs, buffer.begin() + offs + std::size_t(ent.ecd.cd_size));
+			offs += std::size_t(ent.ecd.cd_size);
+
+			m_entries.insert_or_assign(std::move(path), std::move(ent));
+			++m_records;
+		}
+		if ((offs != buffer.size()) || (m_records > (m_entries.size() * 2)))
+			m_rewrite = true;
+		osd_printf_verbose("unzip: loaded %u archive directories from %s\n", unsigned(m_entries.size()), m_filename);
+	}
+	catch (...)
+	{
+		m_entries.clear();
+		m_records = 0;
+		m_rewrite = true;
+	}
+}
+
+
+/*-------------------------------------------------
+    find - retrieve the directory for an archive
+    if it hasn't changed since it was indexed
+-------------------------------------------------*/
+
+bool zip_directory_index::find(std::string_view path, std::uint64_t length, std::int64_t modified, zip_file_impl::ecd &ecd, std::vector<std::uint8_t> &cd) noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_filename.empty())
+		return false;
+	load();
+
+	auto const found(m_entries.find(path));
+	if ((m_entries.end() == found) || (found->second.length != length) || (found->second.modified != modified))
+		return false;
+
+	try
+	{
+		cd = found->second.cd;
+	}
+	catch (...)
+	{
+		return false;
+	}
+	ecd = found->second.ecd;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    add - remember the directory for an archive
+-------------------------------------------------*/
+
+void zip_directory_index::add(std::string_view path, std::uint64_t length, std::int64_t modified, zip_file_impl::ecd const &ecd, std::vector<std::uint8_t> const &cd) noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_filename.empty())
+		return;
+	load();
+
+	try
+	{
+		auto const [found, inserted] = m_entries.insert_or_assign(std::string(path), entry{ length, modified, ecd, cd });
+		m_added.emplace_back(found->first);
+	}
+	catch (...)
+	{
+		// the index is only a cache, so it's safe to forget entries
+	}
+}
+
+
+/*-------------------------------------------------
+    flush - write new entries to the index file
+-------------------------------------------------*/
+
+void zip_directory_index::append_record(std::vector<std::uint8_t> &buffer, std::string const &path, entry const &ent)
+{
+	std::size_t const offs(buffer.size());
+	buffer.resize(offs + RECORD_HEADER + path.length() + ent.cd.size());
+	std::uint8_t *const header(&buffer[offs]);
+	put_u32le(&header[0], std::uint32_t(path.length()));
+	put_u64le(&header[4], ent.length);
+	put_u64le(&header[12], std::uint64_t(ent.modified));
+	put_u32le(&header[20], ent.ecd.disk_number);
+	put_u32le(&header[24], ent.ecd.cd_start_disk_number);
+	put_u64le(&header[28], ent.ecd.cd_disk_entries);
+	put_u64le(&header[36], ent.ecd.cd_total_entries);
+	put_u64le(&header[44], ent.cd.size());
+	put_u64le(&header[52], ent.ecd.cd_start_disk_offset);
+	std::copy(path.begin(), path.end(), &header[RECORD_HEADER]);
+	std::copy(ent.cd.begin(), ent.cd.end(), &header[RECORD_HEADER + path.length()]);
+}
+
+void zip_directory_index::flush() noexcept
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+	if (m_filename.empty() || (m_added.empty() && !m_rewrite))
+		return;
+
+	try
+	{
+		// append to the existing file if we can, otherwise write everything out
+		osd_file::ptr file;
+		std::uint64_t filesize(0);
+		bool const append(
+				!m_rewrite &&
+				!osd_file::open(m_filename, OPEN_FLAG_READ | OPEN_FLAG_WRITE, file, filesize) &&
+				(sizeof(MAGIC) <= filesize));
+		if (!append)
+		{
+			file.reset();
+			filesize = 0;
+			if (osd_file::open(m_filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file, filesize))
+				return;
+		}
+
+		std::vector<std::uint8_t> buffer;
+		std::size_t records(0);
+		if (append)
+		{
+			for (std::string const &path : m_added)
+			{
+				auto const found(m_entries.find(path));
+				if (m_entries.end() != found)
+				{
+					append_record(buffer, found->first, found->second);
+					++records;
+				}
+			}
+		}
+		else
+		{
+			buffer.assign(std::begin(MAGIC), std::end(MAGIC));
+			for (auto const &ent : m_entries)
+				append_record(buffer, ent.first, ent.second);
+			records = m_entries.size();
+			m_records = 0;
+		}
+
+		// the index is only a cache, so a failed write just loses entries
+		std::uint32_t actual;
+		if ((std::numeric_limits<std::uint32_t>::max() >= buffer.size()) && !file->write(buffer.data(), filesize, std::uint32_t(buffer.size()), actual) && (actual == buffer.size()))
+			m_records += records;
+		m_added.clear();
+		m_rewrite = false;
+	}
+	catch (...)
+	{
+	}
+}
+
+
+/*-------------------------------------------------
+    zip_file_impl directory index helpers
+-------------------------------------------------*/
+
+bool zip_file_impl::directory_index_enabled() noexcept
+{
+	return zip_directory_index::instance().enabled();
+}
+
+bool zip_file_impl::stat_archive(std::uint64_t &length, std::int64_t &modified) const noexcept
+{
+	try
+	{
+		auto const entry(osd_stat(m_filename));
+		if (!entry || (osd::directory::entry::entry_type::FILE != entry->type))
+			return false;
+		length = entry->size;
+		modified = entry->last_modified.time_since_epoch().count();
+		return true;
+	}
+	catch (...)
+	{
+		return false;
+	}
+}
+
+bool zip_file_impl::find_indexed_directory(std::uint64_t length, std::int64_t modified) noexcept
+{
+	return zip_directory_index::instance().find(m_filename, length, modified, m_ecd, m_cd);
+}
+
+void zip_file_impl::add_indexed_directory(std::uint64_t length, std::int64_t modified) const noexcept
+{
+	zip_directory_index::instance().add(m_filename, length, modified, m_ecd, m_cd);
+}
+
+
+
 /***************************************************************************
     CONTAINED FILE ACCESS
 ***************************************************************************/
@@ -1714,6 +2064,18 @@ void archive_file::cache_clear() noexcept
 {
 	zip_file_impl::cache_clear();
 	m7z_file_cache_clear();
+	zip_directory_index::instance().flush();
+}
+
+
+/*-------------------------------------------------
+    set_directory_index - persist ZIP central
+    directories in the given file
+-------------------------------------------------*/
+
+void archive_file::set_directory_index(std::string_view filename) noexcept
+{
+	zip_directory_index::instance().set_filename(filename);
 }
 
 
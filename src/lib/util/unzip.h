@@ -61,9 +61,12 @@ public:
 	// close an archive file (may actually be left open due to caching)
 	virtual ~archive_file();
 
-	// clear out all open files from the cache
+	// clear out all open files from the cache and save the directory index
 	static void cache_clear() noexcept;
 
+	// remember ZIP central directories in a file between runs (empty to disable)
+	static void set_directory_index(std::string_view filename) noexcept;
+
 
 	/* ----- contained file access ----- */
 
@@ -4,23 +4,135 @@
 
 #include "osdcomm.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
+#include <mutex>
 #include <new>
 #include <string>
+#include <thread>
 #include <vector>
 
 
 namespace util {
 
+namespace {
+
+// samples are queued for a writer thread so capturing doesn't wait for the disk
+constexpr std::size_t QUEUE_SAMPLES = 1U << 18;
+constexpr std::size_t BATCH_SAMPLES = 1U << 15;     // wake the writer once this many are waiting
+constexpr auto WRITE_INTERVAL = std::chrono::milliseconds(100);
+
+} // anonymous namespace
+
+
 struct wav_file
 {
 	FILE *file = nullptr;
 	std::vector<std::int16_t> temp;
 	std::uint32_t total_offs = 0U;
 	std::uint32_t data_offs = 0U;
+
+	// single producer (the caller), single consumer (the writer thread)
+	std::unique_ptr<std::int16_t []> queue;
+	std::atomic<std::size_t> queue_head = 0U;       // samples queued in total
+	std::atomic<std::size_t> queue_tail = 0U;       // samples written in total
+	std::atomic<bool> closing = false;
+	std::mutex wake_mutex;
+	std::condition_variable wake;
+	std::thread writer;
 };
 
 
+namespace {
+
+void update_sizes(wav_file &wav)
+{
+	std::uint32_t temp32;
+	std::uint32_t const total = std::ftell(wav.file);
+
+	// update the total file size
+	std::fseek(wav.file, wav.total_offs, SEEK_SET);
+	temp32 = total - (wav.total_offs + 4);
+	temp32 = little_endianize_int32(temp32);
+	std::fwrite(&temp32, 1, 4, wav.file);
+
+	// update the data size
+	std::fseek(wav.file, wav.data_offs, SEEK_SET);
+	temp32 = total - (wav.data_offs + 4);
+	temp32 = little_endianize_int32(temp32);
+	std::fwrite(&temp32, 1, 4, wav.file);
+
+	std::fseek(wav.file, total, SEEK_SET);
+}
+
+
+void write_queued(wav_file &wav)
+{
+	while (true)
+	{
+		// check before looking at the queue so nothing queued before closing is missed
+		bool const closing = wav.closing.load(std::memory_order_acquire);
+		std::size_t tail = wav.queue_tail.load(std::memory_order_relaxed);
+		std::size_t const head = wav.queue_head.load(std::memory_order_acquire);
+		if (head != tail)
+		{
+			// write everything waiting, then keep the header valid so the file is usable if we never get to close it
+			while (head != tail)
+			{
+				std::size_t const count = std::min(head - tail, QUEUE_SAMPLES - (tail % QUEUE_SAMPLES));
+				std::fwrite(&wav.queue[tail % QUEUE_SAMPLES], 2, count, wav.file);
+				tail += count;
+				wav.queue_tail.store(tail, std::memory_order_release);
+			}
+			update_sizes(wav);
+			std::fflush(wav.file);
+		}
+		else if (closing)
+		{
+			return;
+		}
+		else
+		{
+			std::unique_lock<std::mutex> lock(wav.wake_mutex);
+			wav.wake.wait_for(lock, WRITE_INTERVAL);
+		}
+	}
+}
+
+
+void queue_samples(wav_file &wav, std::int16_t const *data, std::size_t samples)
+{
+	while (samples)
+	{
+		std::size_t const head = wav.queue_head.load(std::memory_order_relaxed);
+		std::size_t const tail = wav.queue_tail.load(std::memory_order_acquire);
+		std::size_t const space = QUEUE_SAMPLES - (head - tail);
+		if (!space)
+		{
+			// the disk can't keep up - wait for the writer
+			wav.wake.notify_one();
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::size_t const count = std::min({ samples, space, QUEUE_SAMPLES - (head % QUEUE_SAMPLES) });
+		std::memcpy(&wav.queue[head % QUEUE_SAMPLES], data, count * 2);
+		wav.queue_head.store(head + count, std::memory_order_release);
+		data += count;
+		samples -= count;
+
+		if ((head + count - tail) >= BATCH_SAMPLES)
+			wav.wake.notify_one();
+	}
+}
+
+} // anonymous namespace
+
+
 wav_file_ptr wav_open(std::string_view filename, int sample_rate, int channels)
 {
 	std::uint32_t temp32;
@@ -30,7 +142,9 @@ wav_file_ptr wav_open(std::string_view filename, int sample_rate, int channels)
 	wav_file_ptr wav(new (std::nothrow) wav_file);
 	if (!wav)
 		return nullptr;
-
+	wav->queue.reset(new (std::nothrow) std::int16_t [QUEUE_SAMPLES]);
+	if (!wav->queue)
+		return nullptr;
 	// create the file
 	wav->file = std::fopen(std::string(filename).c_str(), "wb"); // ugly - need to force NUL termination on filename
 	if (!wav->file)
@@ -88,6 +202,9 @@ wav_file_ptr wav_open(std::string_view filename, int sample_rate, int channels)
 	wav->data_offs = std::ftell(wav->file);
 	std::fwrite(&temp32, 1, 4, wav->file);
 
+	// start writing in the background
+	wav->writer = std::thread([&wavref = *wav] () { write_queued(wavref); });
+
 	return wav;
 }
 
@@ -97,23 +214,17 @@ void wav_close(wav_file *wav)
 	if (!wav)
 		return;
 
-	if (wav->file)
+	// let the writer finish what's queued
+	if (wav->writer.joinable())
 	{
-		std::uint32_t temp32;
-		std::uint32_t const total = std::ftell(wav->file);
-
-		// update the total file size
-		std::fseek(wav->file, wav->total_offs, SEEK_SET);
-		temp32 = total - (wav->total_offs + 4);
-		temp32 = little_endianize_int32(temp32);
-		std::fwrite(&temp32, 1, 4, wav->file);
-
-		// update the data size
-		std::fseek(wav->file, wav->data_offs, SEEK_SET);
-		temp32 = total - (wav->data_offs + 4);
-		temp32 = little_endianize_int32(temp32);
-		std::fwrite(&temp32, 1, 4, wav->file);
+		wav->closing.store(true, std::memory_order_release);
+		wav->wake.notify_one();
+		wav->writer.join();
+	}
 
+	if (wav->file)
+	{
+		update_sizes(*wav);
 		std::fclose(wav->file);
 	}
 
@@ -123,9 +234,8 @@ void wav_close(wav_file *wav)
 
 void wav_add_data_16(wav_file &wav, int16_t *data, int samples)
 {
-	// just write and flush the data
-	std::fwrite(data, 2, samples, wav.file);
-	std::fflush(wav.file);
+	// just queue the data
+	queue_samples(wav, data, samples);
 }
 
 
@@ -145,9 +255,8 @@ void wav_add_data_32(wav_file &wav, int32_t *data, int samples, int shift)
 		wav.temp[i] = (val < -32768) ? -32768 : (val > 32767) ? 32767 : val;
 	}
 
-	// write and flush
-	std::fwrite(&wav.temp[0], 2, samples, wav.file);
-	std::fflush(wav.file);
+	// queue it
+	queue_samples(wav, &wav.temp[0], samples);
 }
 
 
@@ -164,9 +273,8 @@ void wav_add_data_16lr(wav_file &wav, int16_t *left, int16_t *right, int samples
 	for (int i = 0; i < samples * 2; i++)
 		wav.temp[i] = (i & 1) ? right[i / 2] : left[i / 2];
 
-	// write and flush
-	std::fwrite(&wav.temp[0], 4, samples, wav.file);
-	std::fflush(wav.file);
+	// queue it
+	queue_samples(wav, &wav.temp[0], samples * 2);
 }
 
 
@@ -187,9 +295,8 @@ void wav_add_data_32lr(wav_file &wav, int32_t *left, int32_t *right, int samples
 		wav.temp[i] = (val < -32768) ? -32768 : (val > 32767) ? 32767 : val;
 	}
 
-	// write and flush
-	std::fwrite(&wav.temp[0], 4, samples, wav.file);
-	std::fflush(wav.file);
+	// queue it
+	queue_samples(wav, &wav.temp[0], samples * 2);
 }
 
 } // namespace util
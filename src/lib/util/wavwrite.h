@@ -27,6 +27,8 @@ struct wav_deleter
 
 using wav_file_ptr = std::unique_ptr<wav_file, wav_deleter>;
 
+// samples are written to disk in batches by a thread per file; the header
+// sizes are updated after each batch, so the file is playable while open
 wav_file_ptr wav_open(std::string_view filename, int sample_rate, int channels);
 
 void wav_add_data_16(wav_file &wavptr, std::int16_t *data, int samples);
@@ -9,6 +9,8 @@
 #include "k053250.h"
 #include "konamigx.h"
 
+#include <algorithm>
+
 
 //#define GX_DEBUG
 #define VERBOSE 0
@@ -484,7 +486,6 @@ void konamigx_state::konamigx_mixer(screen_device &screen, bitmap_rgb32 &bitmap,
 	}
 
 //  i = j = 0xff;
-	int l = 0;
 
 	u32 start_addr = m_type3_spriteram_bank ? 0x800 : 0;
 	u32 end_addr = start_addr + 0x800;
@@ -503,7 +504,6 @@ void konamigx_state::konamigx_mixer(screen_device &screen, bitmap_rgb32 &bitmap,
 
 		int code  = m_gx_spriteram[offs+1];
 		int color = k = m_gx_spriteram[offs+6];
-		l     = m_gx_spriteram[offs+7];
 
 		m_k055673->m_k053247_cb(&code, &color, &pri);
 
@@ -630,21 +630,15 @@ void konamigx_state::konamigx_mixer(screen_device &screen, bitmap_rgb32 &bitmap,
 		}
 	}
 
-	// sort objects in decending order (SLOW)
-	k = nobj;
-	l = nobj - 1;
-
-	for (int j=0; j<l; j++)
-	{
-		int temp1 = objbuf[j];
-		int temp2 = objpool[temp1].order;
-		for (int i=j+1; i<k; i++)
-		{
-			int temp3 = objbuf[i];
-			int temp4 = objpool[temp3].order;
-			if ((uint32_t)temp2 <= (uint32_t)temp4) { temp2 = temp4; objbuf[i] = temp1; objbuf[j] = temp1 = temp3; }
-		}
-	}
+	// sort objects in descending order; ties keep the later object first,
+	// matching the selection sort this replaces
+	std::sort(objbuf, objbuf + nobj,
+			[objpool] (int a, int b)
+			{
+				uint32_t const ordera = objpool[a].order;
+				uint32_t const orderb = objpool[b].order;
+				return (ordera > orderb) || ((ordera == orderb) && (a > b));
+			});
 
 
 	konamigx_mixer_draw(screen,bitmap,cliprect,sub1,sub1flags,sub2,sub2flags,mixerflags,extra_bitmap,rushingheroes_hack,
@@ -1059,7 +1059,7 @@ uint32_t n64_rdp::dz_compress(uint32_t value)
 	return j;
 }
 
-void n64_rdp::get_dither_values(int32_t x, int32_t y, int32_t* cdith, int32_t* adith, const rdp_poly_state& object)
+void n64_rdp::get_dither_values(int32_t x, int32_t y, int32_t* cdith, int32_t* adith, rdp_span_aux* userdata, const rdp_poly_state& object)
 {
 	const int32_t dithindex = ((y & 3) << 2) | (x & 3);
 	switch((object.m_other_modes.rgb_dither_sel << 2) | object.m_other_modes.alpha_dither_sel)
@@ -1073,7 +1073,7 @@ void n64_rdp::get_dither_values(int32_t x, int32_t y, int32_t* cdith, int32_t* a
 		break;
 	case 2:
 		*cdith = s_magic_matrix[dithindex];
-		*adith = machine().rand() & 7;
+		*adith = userdata->rand() & 7;
 		break;
 	case 3:
 		*cdith = s_magic_matrix[dithindex];
@@ -1088,26 +1088,26 @@ void n64_rdp::get_dither_values(int32_t x, int32_t y, int32_t* cdith, int32_t* a
 		break;
 	case 6:
 		*cdith = s_bayer_matrix[dithindex];
-		*adith = machine().rand() & 7;
+		*adith = userdata->rand() & 7;
 		break;
 	case 7:
 		*cdith = s_bayer_matrix[dithindex];
 		*adith = 0;
 		break;
 	case 8:
-		*cdith = machine().rand() & 7;
+		*cdith = userdata->rand() & 7;
 		*adith = s_magic_matrix[dithindex];
 		break;
 	case 9:
-		*cdith = machine().rand() & 7;
+		*cdith = userdata->rand() & 7;
 		*adith = (~s_magic_matrix[dithindex]) & 7;
 		break;
 	case 10:
-		*cdith = machine().rand() & 7;
+		*cdith = userdata->rand() & 7;
 		*adith = (*cdith + 17) & 7;
 		break;
 	case 11:
-		*cdith = machine().rand() & 7;
+		*cdith = userdata->rand() & 7;
 		*adith = 0;
 		break;
 	case 12:
@@ -1120,7 +1120,7 @@ void n64_rdp::get_dither_values(int32_t x, int32_t y, int32_t* cdith, int32_t* a
 		break;
 	case 14:
 		*cdith = 0;
-		*adith = machine().rand() & 7;
+		*adith = userdata->rand() & 7;
 		break;
 	case 15:
 		*adith = *cdith = 0;
@@ -1912,6 +1912,12 @@ void n64_rdp::draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zb
 		return;
 	}
 
+	// Earlier primitives may still be drawing out of the aux buffer, so only recycle it once they are done
+	if (m_aux_buf_ptr + ((((ylfar - ycur) >> 2) + 1) * sizeof(rdp_span_aux)) >= EXTENT_AUX_COUNT)
+	{
+		flush_spans("span aux buffer full");
+	}
+
 	bool new_object = true;
 	rdp_poly_state* object = nullptr;
 	bool valid = false;
@@ -1996,6 +2002,7 @@ void n64_rdp::draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zb
 				userdata->m_prim_lod_fraction = m_prim_lod_fraction;
 				userdata->m_k4 = m_k4;
 				userdata->m_k5 = m_k5;
+				userdata->m_rand_seed = machine().rand();
 
 				// Setup blender data for this scanline
 				set_blender_input(0, 0, &userdata->m_color_inputs.blender1a_rgb[0], &userdata->m_color_inputs.blender1b_a[0], m_other_modes.blend_m1a_0, m_other_modes.blend_m1b_0, userdata);
@@ -2064,10 +2071,20 @@ void n64_rdp::draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zb
 	{
 		render_spans(yh >> 2, yl >> 2, tilenum, flip ? true : false, spans, rect, object);
 	}
-	m_aux_buf_ptr = 0;  // Spans can be reused once render completes
 	//wait("draw_triangle");
 }
 
+void n64_rdp::flush_spans(const char *debug_reason)
+{
+	// Primitives are queued without waiting; the poly manager already orders work on overlapping
+	// scanlines, so only memory the spans read or write outside of their object needs a flush
+	if (m_aux_buf_ptr != 0)
+	{
+		wait(debug_reason);
+		m_aux_buf_ptr = 0;  // Spans can be reused once render completes
+	}
+}
+
 /*****************************************************************************/
 
 ////////////////////////
@@ -2182,7 +2199,7 @@ void n64_rdp::cmd_sync_tile(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_sync_full(uint64_t *cmd_buf)
 {
-	//wait("SyncFull");
+	flush_spans("SyncFull");
 	m_n64_periphs->dp_full_sync();
 }
 
@@ -2207,7 +2224,7 @@ void n64_rdp::cmd_set_convert(uint64_t *cmd_buf)
 {
 	const uint64_t w1 = cmd_buf[0];
 
-	if(!m_pipe_clean) { m_pipe_clean = true; wait("SetConvert"); }
+	if(!m_pipe_clean) { m_pipe_clean = true; flush_spans("SetConvert"); }
 	int32_t k0 = int32_t(w1 >> 45) & 0x1ff;
 	int32_t k1 = int32_t(w1 >> 36) & 0x1ff;
 	int32_t k2 = int32_t(w1 >> 27) & 0x1ff;
@@ -2288,7 +2305,7 @@ void n64_rdp::cmd_set_other_modes(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_load_tlut(uint64_t *cmd_buf)
 {
-	//wait("LoadTLUT");
+	flush_spans("LoadTLUT");
 	n64_tile_t* tile = m_tiles;
 	const uint64_t w1 = cmd_buf[0];
 
@@ -2360,7 +2377,7 @@ void n64_rdp::cmd_set_tile_size(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_load_block(uint64_t *cmd_buf)
 {
-	//wait("LoadBlock");
+	flush_spans("LoadBlock");
 	n64_tile_t* tile = m_tiles;
 	const uint64_t w1 = cmd_buf[0];
 
@@ -2573,7 +2590,7 @@ void n64_rdp::cmd_load_block(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_load_tile(uint64_t *cmd_buf)
 {
-	//wait("LoadTile");
+	flush_spans("LoadTile");
 	n64_tile_t* tile = m_tiles;
 	const uint64_t w1 = cmd_buf[0];
 	const int32_t tilenum = int32_t(w1 >> 24) & 0x7;
@@ -2864,14 +2881,14 @@ void n64_rdp::cmd_set_texture_image(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_set_mask_image(uint64_t *cmd_buf)
 {
-	//wait("SetMaskImage");
+	flush_spans("SetMaskImage");
 	const uint64_t w1 = cmd_buf[0];
 	m_misc_state.m_zb_address = uint32_t(w1) & 0x01ffffff;
 }
 
 void n64_rdp::cmd_set_color_image(uint64_t *cmd_buf)
 {
-	//wait("SetColorImage");
+	flush_spans("SetColorImage");
 	const uint64_t w1 = cmd_buf[0];
 	m_misc_state.m_fb_format  = uint32_t(w1 >> 53) & 0x7;
 	m_misc_state.m_fb_size    = uint32_t(w1 >> 51) & 0x3;
@@ -2984,6 +3001,9 @@ void n64_rdp::process_command_list()
 			case 0x3f:  cmd_set_color_image(curr_cmd_buf); break;
 		}
 	};
+
+	// The CPU and VI may look at RDRAM as soon as we return
+	flush_spans("end of command list");
 }
 
 /*****************************************************************************/
@@ -3143,7 +3163,6 @@ void n64_rdp::render_spans(int32_t start, int32_t end, int32_t tilenum, bool fli
 			render_extents<8>(clip, render_delegate(&n64_rdp::span_draw_fill, this), start, (end - start) + 1, spans + offset);
 			break;
 	}
-	wait("render spans");
 }
 
 void n64_rdp::rgbaz_clip(int32_t sr, int32_t sg, int32_t sb, int32_t sa, int32_t* sz, rdp_span_aux* userdata)
@@ -3571,6 +3590,9 @@ void n64_rdp::span_draw_1cycle(int32_t scanline, const extent_t &extent, const r
 		tc_div_no_perspective(s.w >> 16, t.w >> 16, w.w >> 16, &sss, &sst);
 	}
 
+	// the noise input is only reachable through combiner sub A, so skip the generator when it is not selected
+	const bool uses_noise = userdata->m_color_inputs.combiner_rgbsub_a[1] == &userdata->m_noise_color;
+
 	userdata->m_start_span = true;
 	for (int32_t j = 0; j <= length; j++)
 	{
@@ -3597,8 +3619,11 @@ void n64_rdp::span_draw_1cycle(int32_t scanline, const extent_t &extent, const r
 			userdata->m_texel1_color = userdata->m_texel0_color;
 			userdata->m_texel1_alpha = userdata->m_texel0_alpha;
 
-			const uint8_t noise = machine().rand() << 3; // Not accurate
-			userdata->m_noise_color.set(0, noise, noise, noise);
+			if (uses_noise)
+			{
+				const uint8_t noise = userdata->rand() << 3; // Not accurate
+				userdata->m_noise_color.set(0, noise, noise, noise);
+			}
 
 			rgbaint_t rgbsub_a(*userdata->m_color_inputs.combiner_rgbsub_a[1]);
 			rgbaint_t rgbsub_b(*userdata->m_color_inputs.combiner_rgbsub_b[1]);
@@ -3732,7 +3757,7 @@ void n64_rdp::span_draw_1cycle(int32_t scanline, const extent_t &extent, const r
 						printf("Blend index: %d\n", (userdata->m_blend_enable << 2) | blend_index);
 						int32_t cdith = 0;
 						int32_t adith = 0;
-						get_dither_values(scanline, j, &cdith, &adith, object);
+						get_dither_values(scanline, j, &cdith, &adith, userdata, object);
 						color_t reblended_pixel;
 						((&m_blender)->*(m_blender.blend1[(userdata->m_blend_enable << 2) | blend_index]))(reblended_pixel, cdith, adith, partialreject, sel0, userdata, object/*, true*/);
 
@@ -3746,7 +3771,7 @@ void n64_rdp::span_draw_1cycle(int32_t scanline, const extent_t &extent, const r
 			{
 				int32_t cdith = 0;
 				int32_t adith = 0;
-				get_dither_values(scanline, j, &cdith, &adith, object);
+				get_dither_values(scanline, j, &cdith, &adith, userdata, object);
 
 				color_t blended_pixel;
 				bool rendered = ((&m_blender)->*(m_blender.blend1[(userdata->m_blend_enable << 2) | blend_index]))(blended_pixel, cdith, adith, partialreject, sel0, userdata, object/*, false*/);
@@ -3899,6 +3924,8 @@ void n64_rdp::span_draw_2cycle(int32_t scanline, const extent_t &extent, const r
 		tc_div_no_perspective(s.w >> 16, t.w >> 16, w.w >> 16, &sss, &sst);
 	}
 
+	const bool uses_noise = userdata->m_color_inputs.combiner_rgbsub_a[0] == &userdata->m_noise_color || userdata->m_color_inputs.combiner_rgbsub_a[1] == &userdata->m_noise_color;
+
 	userdata->m_start_span = true;
 	for (int32_t j = 0; j <= length; j++)
 	{
@@ -3938,8 +3965,11 @@ void n64_rdp::span_draw_2cycle(int32_t scanline, const extent_t &extent, const r
 			userdata->m_texel1_alpha.set(t1a, t1a, t1a, t1a);
 			userdata->m_next_texel_alpha.set(tna, tna, tna, tna);
 
-			const uint8_t noise = machine().rand() << 3; // Not accurate
-			userdata->m_noise_color.set(0, noise, noise, noise);
+			if (uses_noise)
+			{
+				const uint8_t noise = userdata->rand() << 3; // Not accurate
+				userdata->m_noise_color.set(0, noise, noise, noise);
+			}
 
 			rgbaint_t rgbsub_a(*userdata->m_color_inputs.combiner_rgbsub_a[0]);
 			rgbaint_t rgbsub_b(*userdata->m_color_inputs.combiner_rgbsub_b[0]);
@@ -4107,7 +4137,7 @@ void n64_rdp::span_draw_2cycle(int32_t scanline, const extent_t &extent, const r
 						printf("Blend index: %d\n", (userdata->m_blend_enable << 2) | blend_index);
 						int32_t cdith = 0;
 						int32_t adith = 0;
-						get_dither_values(scanline, j, &cdith, &adith, object);
+						get_dither_values(scanline, j, &cdith, &adith, userdata, object);
 						color_t reblended_pixel;
 						((&m_blender)->*(m_blender.blend2[(userdata->m_blend_enable << 2) | blend_index]))(reblended_pixel, cdith, adith, partialreject, sel0, sel1, userdata, object/*, true*/);
 
@@ -4119,7 +4149,7 @@ void n64_rdp::span_draw_2cycle(int32_t scanline, const extent_t &extent, const r
 
 			if(z_compare(zbcur, zhbcur, sz, dzpix, userdata, object))
 			{
-				get_dither_values(scanline, j, &cdith, &adith, object);
+				get_dither_values(scanline, j, &cdith, &adith, userdata, object);
 
 				color_t blended_pixel;
 				bool rendered = ((&m_blender)->*(m_blender.blend2[(userdata->m_blend_enable << 2) | blend_index]))(blended_pixel, cdith, adith, partialreject, sel0, sel1, userdata, object/*, false*/);
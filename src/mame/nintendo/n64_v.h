@@ -258,7 +258,9 @@ public:
 
 	void        triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zbuffer);
 
-	void        get_dither_values(int32_t x, int32_t y, int32_t* cdith, int32_t* adith, const rdp_poly_state &object);
+	void        get_dither_values(int32_t x, int32_t y, int32_t* cdith, int32_t* adith, rdp_span_aux* userdata, const rdp_poly_state &object);
+
+	void        flush_spans(const char *debug_reason);
 
 	uint16_t decompress_cvmask_frombyte(uint8_t x);
 	void lookup_cvmask_derivatives(uint32_t mask, uint8_t* offx, uint8_t* offy, rdp_span_aux* userdata);
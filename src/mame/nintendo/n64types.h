@@ -312,6 +312,13 @@ struct rdp_span_aux
 	bool                m_start_span;
 	rgbaint_t           m_clamp_diff[8];
 	combine_modes_t     m_combine;
+	uint32_t              m_rand_seed;           /* per-span noise source, spans may be drawn on any thread */
+
+	uint32_t rand()
+	{
+		m_rand_seed = 1664525 * m_rand_seed + 1013904223;
+		return m_rand_seed ^ (m_rand_seed >> 15);
+	}
 };
 
 struct z_decompress_entry_t
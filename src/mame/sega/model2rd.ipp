@@ -133,8 +133,7 @@ void MODEL2_FUNC_NAME(int32_t scanline, const extent_t& extent, const m2_poly_ex
 	u32  tex_x = object.texx;
 	u32  tex_y = object.texy;
 	u32  tex_x_mask, tex_y_mask;
-	u32  tex_mirr_x = object.texmirrorx;
-	u32  tex_mirr_y = object.texmirrory;
+	u32  tex_x_flip, tex_y_flip;
 	u32 *sheet = object.texsheet;
 	u8  *gamma_value = &state->m_gamma_table[0];
 	float ooz = extent.param[0].start;
@@ -148,6 +147,10 @@ void MODEL2_FUNC_NAME(int32_t scanline, const extent_t& extent, const m2_poly_ex
 	tex_x_mask  = tex_width - 1;
 	tex_y_mask  = tex_height - 1;
 
+	// texture sizes are powers of two, so mirroring (size - 1) - n is just n ^ (size - 1)
+	tex_x_flip  = object.texmirrorx ? tex_x_mask : 0;
+	tex_y_flip  = object.texmirrory ? tex_y_mask : 0;
+
 	colorbase = state->m_palram[(colorbase + 0x1000)] & 0x7fff;
 
 	colortable_r += ((colorbase >>  0) & 0x1f) << 8;
@@ -156,9 +159,6 @@ void MODEL2_FUNC_NAME(int32_t scanline, const extent_t& extent, const m2_poly_ex
 
 	for(x = extent.startx; x < extent.stopx; x++, uoz += duoz, voz += dvoz, ooz += dooz)
 	{
-		float z = recip_approx(ooz) * 256.0f;
-		int32_t u = uoz * z;
-		int32_t v = voz * z;
 		int  tr, tg, tb;
 		u16  t;
 		u8 luma;
@@ -166,17 +166,16 @@ void MODEL2_FUNC_NAME(int32_t scanline, const extent_t& extent, const m2_poly_ex
 		int v2;
 
 #if defined(MODEL2_CHECKER)
+		// skipped pixels don't need the perspective divide
 		if ( ((x^scanline) & 1) == 0 )
 			continue;
 #endif
-		u2 = (u >> 8) & tex_x_mask;
-		v2 = (v >> 8) & tex_y_mask;
-
-		if ( tex_mirr_x )
-			u2 = ( tex_width - 1 ) - u2;
+		float z = recip_approx(ooz) * 256.0f;
+		int32_t u = uoz * z;
+		int32_t v = voz * z;
 
-		if ( tex_mirr_y )
-			v2 = ( tex_height - 1 ) - v2;
+		u2 = ((u >> 8) & tex_x_mask) ^ tex_x_flip;
+		v2 = ((v >> 8) & tex_y_mask) ^ tex_y_flip;
 
 		t = get_texel( tex_x, tex_y, u2, v2, sheet );
 
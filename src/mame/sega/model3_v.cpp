@@ -1206,30 +1206,7 @@ void model3_state::real3d_display_list_end()
 	reset_triangle_buffers();
 	real3d_traverse_display_list();
 
-	for (int i=0; i < 4; i++)
-	{
-		int ticount, tiacount;
-		int ti = m_viewport_tri_index[i];
-		int tia = m_viewport_tri_alpha_index[i];
-		if (i < 3)
-		{
-			ticount = m_viewport_tri_index[i+1] - ti;
-			tiacount = m_viewport_tri_alpha_index[i+1] - tia;
-		}
-		else
-		{
-			ticount = m_tri_buffer_ptr - ti;
-			tiacount = m_tri_alpha_buffer_ptr - tia;
-		}
-
-		if (ticount > 0 || tiacount > 0)
-		{
-			m_renderer->clear_zb();
-			m_renderer->draw_opaque_triangles(&m_tri_buffer[ti], ticount);
-			m_renderer->draw_alpha_triangles(&m_tri_alpha_buffer[tia], tiacount);
-			m_renderer->wait_for_polys();
-		}
-	}
+	m_renderer->wait_for_polys();
 }
 
 void model3_state::real3d_display_list1_dma(uint32_t src, uint32_t dst, int length, int byteswap)
@@ -1973,11 +1950,24 @@ void model3_state::real3d_traverse_display_list()
 
 	m_list_depth = 0;
 
+	/* each priority is handed to the renderer as soon as it has been traversed, */
+	/* so the next one is transformed while the workers rasterise this one */
 	for (int pri = 0; pri < 4; pri++)
 	{
-		m_viewport_tri_index[pri] = m_tri_buffer_ptr;
-		m_viewport_tri_alpha_index[pri] = m_tri_alpha_buffer_ptr;
+		int const ti = m_viewport_tri_index[pri] = m_tri_buffer_ptr;
+		int const tia = m_viewport_tri_alpha_index[pri] = m_tri_alpha_buffer_ptr;
 		draw_viewport(pri, 0x800000);
+
+		int const ticount = m_tri_buffer_ptr - ti;
+		int const tiacount = m_tri_alpha_buffer_ptr - tia;
+		if (ticount > 0 || tiacount > 0)
+		{
+			/* the Z buffer is shared, so the previous priority has to finish first */
+			m_renderer->wait_for_polys();
+			m_renderer->clear_zb();
+			m_renderer->draw_opaque_triangles(&m_tri_buffer[ti], ticount);
+			m_renderer->draw_alpha_triangles(&m_tri_alpha_buffer[tia], tiacount);
+		}
 	}
 }
 
@@ -689,6 +689,79 @@ uint32_t powervr2_device::tex_r_default(texinfo *t, float x, float y)
 	return ((int)x ^ (int)y) & 4 ? 0xffffff00 : 0xff0000ff;
 }
 
+uint32_t powervr2_device::tex_r_cached(texinfo *t, float x, float y)
+{
+	int xt = t->u_func(x, t->sizex);
+	int yt = t->v_func(y, t->sizey);
+	return t->texels[yt * t->sizex + xt];
+}
+
+void powervr2_device::texture_ram_written(uint32_t offset, uint32_t length)
+{
+	if (texture_dirty_pages.empty())
+		return;
+
+	offset &= texture_ram_mask;
+	uint32_t const last = std::min<uint32_t>((offset + length - 1) >> TEXTURE_PAGE_SHIFT, texture_dirty_pages.size() - 1);
+	for (uint32_t page = offset >> TEXTURE_PAGE_SHIFT; page <= last; page++)
+		texture_dirty_pages[page] = 1;
+	texture_dirty = true;
+}
+
+void powervr2_device::flush_texture_cache()
+{
+	// start again rather than letting the cache grow without bound
+	if (texture_cache_texels > TEXTURE_CACHE_LIMIT) {
+		texture_cache.clear();
+		texture_cache_texels = 0;
+	}
+
+	if (texture_dirty || palette_dirty) {
+		for (auto it = texture_cache.begin(); it != texture_cache.end(); ) {
+			decoded_texture const &entry = it->second;
+			bool stale = palette_dirty && entry.palettised;
+			for (uint32_t page = entry.first_page; !stale && (page <= entry.last_page); page++)
+				stale = texture_dirty_pages[page];
+			if (stale) {
+				texture_cache_texels -= entry.texels.size();
+				it = texture_cache.erase(it);
+			} else {
+				++it;
+			}
+		}
+		std::fill(texture_dirty_pages.begin(), texture_dirty_pages.end(), 0);
+		texture_dirty = false;
+		palette_dirty = false;
+	}
+}
+
+uint32_t const *powervr2_device::cached_texture(texinfo &t)
+{
+	texture_key const key(t.address, t.vqbase, t.pf, t.mode, t.sizes, t.stride, t.palbase);
+	decoded_texture &entry = texture_cache[key];
+	if (!entry.texels.empty() && (entry.decode == t.decode))
+		return &entry.texels[0];
+
+	// run every texel through the reader once, wrapping so the co-ordinates map straight to texels
+	texinfo ti = t;
+	ti.u_func = &powervr2_device::uv_wrap;
+	ti.v_func = &powervr2_device::uv_wrap;
+	texture_cache_texels -= entry.texels.size();
+	entry.texels.resize(t.sizex * t.sizey);
+	texture_cache_texels += entry.texels.size();
+	for (int y = 0; y < t.sizey; y++)
+		for (int x = 0; x < t.sizex; x++)
+			entry.texels[y * t.sizex + x] = (this->*(t.decode))(&ti, x, y);
+
+	// all formats are read from between the VQ code book and two bytes per texel after the start
+	uint32_t const last_page = texture_dirty_pages.size() - 1;
+	entry.decode = t.decode;
+	entry.first_page = std::min<uint32_t>(t.vqbase >> TEXTURE_PAGE_SHIFT, last_page);
+	entry.last_page = std::min<uint32_t>((t.address + t.stride * t.sizey * 2 - 1) >> TEXTURE_PAGE_SHIFT, last_page);
+	entry.palettised = (t.pf == 5) || (t.pf == 6);
+	return &entry.texels[0];
+}
+
 void powervr2_device::tex_get_info(texinfo *t)
 {
 	int miptype = 0;
@@ -1602,6 +1675,7 @@ uint32_t powervr2_device::palette_r(offs_t offset)
 void powervr2_device::palette_w(offs_t offset, uint32_t data, uint32_t mem_mask)
 {
 	COMBINE_DATA(palette+offset);
+	palette_dirty = true;
 }
 
 void powervr2_device::update_screen_format()
@@ -2238,6 +2312,7 @@ void powervr2_device::ta_fifo_yuv_w(uint8_t data)
 				*(uint8_t *)((reinterpret_cast<uint8_t *>(dc_texture_ram)) + BYTE8_XOR_LE(dst_addr+1)) = y0;
 				*(uint8_t *)((reinterpret_cast<uint8_t *>(dc_texture_ram)) + BYTE8_XOR_LE(dst_addr+2)) = v;
 				*(uint8_t *)((reinterpret_cast<uint8_t *>(dc_texture_ram)) + BYTE8_XOR_LE(dst_addr+3)) = y1;
+				texture_ram_written(dst_addr, 4);
 			}
 		}
 
@@ -2270,6 +2345,7 @@ void powervr2_device::ta_texture_directpath0_w(offs_t offset, uint64_t data, uin
 	else
 	{
 		COMBINE_DATA(&dc_texture_ram[offset]);
+		texture_ram_written(offset << 3, 8);
 	}
 }
 
@@ -2287,6 +2363,7 @@ void powervr2_device::ta_texture_directpath1_w(offs_t offset, uint64_t data, uin
 	else
 	{
 		COMBINE_DATA(&dc_texture_ram[offset]);
+		texture_ram_written(offset << 3, 8);
 	}
 }
 
@@ -2478,7 +2555,7 @@ inline void powervr2_device::render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int
 }
 
 template <powervr2_device::pix_sample_fn sample_fn, int group_no>
-inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
+inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, const rectangle &cliprect, texinfo *ti,
 									float y0, float y1,
 									float xl, float xr,
 									float ul, float ur,
@@ -2496,16 +2573,18 @@ inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
 	int idx;
 	float dy;
 	int yy0, yy1;
+	float const top = cliprect.min_y;
+	float const bottom = cliprect.max_y + 1;
 
 	// demofist, chocomk (hardlocks with -drc, MT#8088)
 	// TODO: should throw an error?
 	if (std::isnan(y0) || std::isnan(y1))
 		return;
 
-	if(y1 <= 0)
+	if(y1 <= top)
 		return;
-	if(y1 > 480)
-		y1 = 480;
+	if(y1 > bottom)
+		y1 = bottom;
 
 	float bl[4], br[4], offl[4], offr[4];
 	memcpy(bl, bl_in, sizeof(bl));
@@ -2513,23 +2592,24 @@ inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
 	memcpy(offl, offl_in, sizeof(offl));
 	memcpy(offr, offr_in, sizeof(offr));
 
-	if(y0 < 0) {
-		xl += -dxldy*y0;
-		xr += -dxrdy*y0;
-		ul += -duldy*y0;
-		ur += -durdy*y0;
-		vl += -dvldy*y0;
-		vr += -dvrdy*y0;
-		wl += -dwldy*y0;
-		wr += -dwrdy*y0;
+	if(y0 < top) {
+		float const skip = top - y0;
+		xl += dxldy*skip;
+		xr += dxrdy*skip;
+		ul += duldy*skip;
+		ur += durdy*skip;
+		vl += dvldy*skip;
+		vr += dvrdy*skip;
+		wl += dwldy*skip;
+		wr += dwrdy*skip;
 
 		for (idx = 0; idx < 4; idx++) {
-			bl[idx] += -dbldy[idx] * y0;
-			br[idx] += -dbrdy[idx] * y0;
-			offl[idx] += -doldy[idx] * y0;
-			offr[idx] += -dordy[idx] * y0;
+			bl[idx] += dbldy[idx] * skip;
+			br[idx] += dbrdy[idx] * skip;
+			offl[idx] += doldy[idx] * skip;
+			offr[idx] += dordy[idx] * skip;
 		}
-		y0 = 0;
+		y0 = top;
 	}
 
 	yy0 = round(y0);
@@ -2614,13 +2694,13 @@ void powervr2_device::sort_vertices(const vert *v, int *i0, int *i1, int *i2)
 
 
 template <powervr2_device::pix_sample_fn sample_fn, int group_no>
-inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v0, const vert *v1, const vert *v2)
+inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, const rectangle &cliprect, texinfo *ti, const vert *v0, const vert *v1, const vert *v2)
 {
 	float dy01, dy02, dy12;
 
 	float dx01dy, dx02dy, dx12dy, du01dy, du02dy, du12dy, dv01dy, dv02dy, dv12dy, dw01dy, dw02dy, dw12dy;
 
-	if(v0->y >= 480 || v2->y < 0)
+	if(v0->y >= cliprect.max_y + 1 || v2->y < cliprect.min_y)
 		return;
 
 	float db01[4] = {
@@ -2732,15 +2812,15 @@ inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti
 			return;
 
 		if(v1->x > v0->x)
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, v0->b, v1->b, v0->o, v1->o, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy);
+			render_span<sample_fn, group_no>(bitmap, cliprect, ti, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, v0->b, v1->b, v0->o, v1->o, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy);
 		else
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, v1->b, v0->b, v1->o, v0->o, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy);
+			render_span<sample_fn, group_no>(bitmap, cliprect, ti, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, v1->b, v0->b, v1->o, v0->o, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy);
 
 	} else if(!dy12) {
 		if(v2->x > v1->x)
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy);
+			render_span<sample_fn, group_no>(bitmap, cliprect, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy);
 		else
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy);
+			render_span<sample_fn, group_no>(bitmap, cliprect, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy);
 
 	} else {
 			float idk_b[4] = {
@@ -2756,17 +2836,17 @@ inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti
 				v0->o[3] + do02dy[3] * dy01
 			};
 		if(dx01dy < dx02dy) {
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y,
+			render_span<sample_fn, group_no>(bitmap, cliprect, ti, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o,
 						dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy);
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y,
+			render_span<sample_fn, group_no>(bitmap, cliprect, ti, v1->y, v2->y,
 						v1->x, v0->x + dx02dy*dy01, v1->u, v0->u + du02dy*dy01, v1->v, v0->v + dv02dy*dy01, v1->w, v0->w + dw02dy*dy01, v1->b, idk_b, v1->o, idk_o,
 						dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy);
 		} else {
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y,
+			render_span<sample_fn, group_no>(bitmap, cliprect, ti, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o,
 						dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy);
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y,
+			render_span<sample_fn, group_no>(bitmap, cliprect, ti, v1->y, v2->y,
 						v0->x + dx02dy*dy01, v1->x, v0->u + du02dy*dy01, v1->u, v0->v + dv02dy*dy01, v1->v, v0->w + dw02dy*dy01, v1->w, idk_b, v1->b, idk_o, v1->o,
 						dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy);
 		}
@@ -2774,7 +2854,7 @@ inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti
 }
 
 template <int group_no>
-void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v)
+void powervr2_device::render_tri(bitmap_rgb32 &bitmap, const rectangle &cliprect, texinfo *ti, const vert *v)
 {
 	int i0, i1, i2;
 
@@ -2787,16 +2867,16 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 		if (bilinear) {
 			switch (ti->tsinstruction) {
 			case 0:
-				render_tri_sorted<&powervr2_device::sample_textured<0,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<0,true>, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 				break;
 			case 1:
-				render_tri_sorted<&powervr2_device::sample_textured<1,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<1,true>, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 				break;
 			case 2:
-				render_tri_sorted<&powervr2_device::sample_textured<2,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<2,true>, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 				break;
 			case 3:
-				render_tri_sorted<&powervr2_device::sample_textured<3,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<3,true>, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 				break;
 			default:
 				/*
@@ -2804,21 +2884,21 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 				 * AND'd with 3
 				 */
 				logerror("%s - tsinstruction is 0x%08x\n", (unsigned)ti->tsinstruction);
-				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 			}
 		} else {
 			switch (ti->tsinstruction) {
 			case 0:
-				render_tri_sorted<&powervr2_device::sample_textured<0,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<0,false>, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 				break;
 			case 1:
-				render_tri_sorted<&powervr2_device::sample_textured<1,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<1,false>, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 				break;
 			case 2:
-				render_tri_sorted<&powervr2_device::sample_textured<2,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<2,false>, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 				break;
 			case 3:
-				render_tri_sorted<&powervr2_device::sample_textured<3,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<3,false>, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 				break;
 			default:
 				/*
@@ -2826,11 +2906,11 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 				 * AND'd with 3
 				 */
 				logerror("%s - tsinstruction is 0x%08x\n", (unsigned)ti->tsinstruction);
-				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 			}
 		}
 	} else {
-			render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+			render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, cliprect, ti, v+i0, v+i1, v+i2);
 	}
 }
 
@@ -2864,22 +2944,62 @@ void powervr2_device::render_group_to_accumulation_buffer(bitmap_rgb32 &bitmap,c
 		if(ev == -1)
 			continue;
 
-		for(i=sv; i <= ev; i++)
+		for(i=sv; i <= ev-2; i++)
+		{
+			if (!(debug_dip_status&0x2))
+				render_tri<group_no>(bitmap, cliprect, &ts->ti, grab[rs].verts + i);
+
+		}
+	}
+}
+
+// texture co-ordinates are pre-multiplied by w and textures are decoded once, before any bands are rendered
+void powervr2_device::prepare_group(int group_no)
+{
+	int rs=renderselect;
+
+	struct poly_group *grp = grab[rs].groups + group_no;
+
+	int ns=grp->strips_size;
+
+	for (int cs=0;cs < ns;cs++)
+	{
+		strip *ts = &grp->strips[cs];
+		int sv = ts->svert;
+		int ev = ts->evert;
+		if(ev == -1)
+			continue;
+
+		for(int i=sv; i <= ev; i++)
 		{
 			vert *tv = grab[rs].verts + i;
 			tv->u = tv->u * ts->ti.sizex * tv->w;
 			tv->v = tv->v * ts->ti.sizey * tv->w;
 		}
 
-		for(i=sv; i <= ev-2; i++)
-		{
-			if (!(debug_dip_status&0x2))
-				render_tri<group_no>(bitmap, &ts->ti, grab[rs].verts + i);
-
+		// the same strips can be rendered again, so keep the original reader for decoding
+		if (ts->ti.r && (ts->ti.r != &powervr2_device::tex_r_default) && !ts->ti.decode) {
+			ts->ti.decode = ts->ti.r;
+			ts->ti.r = &powervr2_device::tex_r_cached;
 		}
+		if (ts->ti.decode && !texture_dirty_pages.empty())
+			ts->ti.texels = cached_texture(ts->ti);
+		else if (ts->ti.decode)
+			ts->ti.r = ts->ti.decode;
 	}
 }
 
+void *powervr2_device::render_band_callback(void *param, int threadid)
+{
+	render_band &band = *reinterpret_cast<render_band *>(param);
+
+	// TODO: modifier volumes
+	band.device->render_group_to_accumulation_buffer<DISPLAY_LIST_OPAQUE>(*band.bitmap, band.clip);
+	band.device->render_group_to_accumulation_buffer<DISPLAY_LIST_TRANS>(*band.bitmap, band.clip);
+	band.device->render_group_to_accumulation_buffer<DISPLAY_LIST_PUNCH_THROUGH>(*band.bitmap, band.clip);
+	return nullptr;
+}
+
 void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect) {
 	if (renderselect < 0)
 		return;
@@ -2894,10 +3014,26 @@ void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const
 	uint32_t c=space.read_dword(0x05000000+(param_base&0xf00000)+((isp_backgnd_t&0xfffff8)>>1)+(3+3)*4);
 	bitmap.fill(c, cliprect);
 
-	// TODO: modifier volumes
-	render_group_to_accumulation_buffer<DISPLAY_LIST_OPAQUE>(bitmap, cliprect);
-	render_group_to_accumulation_buffer<DISPLAY_LIST_TRANS>(bitmap, cliprect);
-	render_group_to_accumulation_buffer<DISPLAY_LIST_PUNCH_THROUGH>(bitmap, cliprect);
+	flush_texture_cache();
+	prepare_group(DISPLAY_LIST_OPAQUE);
+	prepare_group(DISPLAY_LIST_TRANS);
+	prepare_group(DISPLAY_LIST_PUNCH_THROUGH);
+
+	// each band renders every list in order, so the result matches drawing the whole screen at once
+	render_band bands[RENDER_BANDS];
+	for (int b = 0; b < RENDER_BANDS; b++) {
+		bands[b].device = this;
+		bands[b].bitmap = &bitmap;
+		bands[b].clip.set(0, 639, b * TILE_SIZE, std::min(b * TILE_SIZE + TILE_SIZE, 480) - 1);
+		bands[b].clip &= cliprect;
+	}
+
+	if (render_queue && osd_work_item_queue_multiple(render_queue, render_band_callback, RENDER_BANDS, bands, sizeof(render_band), WORK_ITEM_FLAG_AUTO_RELEASE)) {
+		osd_work_queue_wait(render_queue, osd_ticks_per_second() * 100);
+	} else {
+		for (render_band &band : bands)
+			render_band_callback(&band, 0);
+	}
 
 	grab[renderselect].busy=0;
 }
@@ -3914,6 +4050,19 @@ void powervr2_device::device_start()
 {
 	grab = std::make_unique<receiveddata[]>(NUM_BUFFERS);
 
+	render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
+	// the CPU writes texture memory directly, including through the mirrors some boards have
+	dc_state *state = machine().driver_data<dc_state>();
+	texture_write_tap = state->m_maincpu->space(AS_PROGRAM).install_write_tap(
+			0x04000000, 0x04ffffff, 0x02000000,
+			"texture_ram_w",
+			[this] (offs_t offset, u64 &data, u64 mem_mask)
+			{
+				texture_ram_written(offset, 8);
+			},
+			&texture_write_tap);
+
 	pvr_build_parameterconfig();
 
 	computedilated();
@@ -4086,6 +4235,27 @@ void powervr2_device::device_reset()
 	dc_state *state = machine().driver_data<dc_state>();
 	dc_texture_ram = state->dc_texture_ram.target();
 	dc_framebuffer_ram = state->dc_framebuffer_ram.target();
+
+	texture_ram_mask = state->dc_texture_ram.bytes() - 1;
+	texture_dirty_pages.assign((texture_ram_mask >> TEXTURE_PAGE_SHIFT) + 1, 0);
+	texture_cache.clear();
+	texture_cache_texels = 0;
+	texture_dirty = false;
+	palette_dirty = false;
+}
+
+void powervr2_device::device_post_load()
+{
+	// restored memory didn't go through the write tracking
+	texture_cache.clear();
+	texture_cache_texels = 0;
+}
+
+void powervr2_device::device_stop()
+{
+	if (render_queue)
+		osd_work_queue_free(render_queue);
+	render_queue = nullptr;
 }
 
 /* called by TIMER_ADD_PERIODIC, in driver sections (controlled by SPG, that's a PVR sub-device) */
@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <map>
+#include <tuple>
+#include <vector>
+
+
 class powervr2_device : public device_t,
 						public device_video_interface
 {
@@ -59,6 +64,15 @@ public:
 	//  our implementation is not currently tile based, and thus the accumulation buffer is screen sized
 	std::unique_ptr<bitmap_rgb32> fake_accumulationbuffer_bitmap;
 
+	// rows of tiles only touch their own part of the accumulation and depth buffers, so they're rendered in parallel
+	enum { TILE_SIZE = 32, RENDER_BANDS = (480 + TILE_SIZE - 1) / TILE_SIZE };
+	struct render_band {
+		powervr2_device *device;
+		bitmap_rgb32 *bitmap;
+		rectangle clip;
+	};
+	osd_work_queue *render_queue = nullptr;
+
 	/*
 	 * Per-polygon base and offset colors.  These are scaled by per-vertex
 	 * weights.
@@ -97,7 +111,28 @@ public:
 		int (*u_func)(float uv, int size) = nullptr;
 		int (*v_func)(float uv, int size) = nullptr;
 		int palbase = 0, cd = 0;
+
+		// reader used to fill the decoded texture cache, and the texels it produced for the current render
+		uint32_t (powervr2_device::*decode)(texinfo *t, float x, float y) = nullptr;
+		uint32_t const *texels = nullptr;
+	};
+
+	// textures are decoded once and reused until the texture memory or palette they came from is written
+	enum { TEXTURE_PAGE_SHIFT = 12, TEXTURE_CACHE_LIMIT = 16 * 1024 * 1024 };
+	struct decoded_texture {
+		uint32_t (powervr2_device::*decode)(texinfo *t, float x, float y) = nullptr;
+		uint32_t first_page = 0, last_page = 0;
+		bool palettised = false;
+		std::vector<uint32_t> texels;
 	};
+	typedef std::tuple<uint32_t, uint32_t, int, int, int, int, int> texture_key;
+	std::map<texture_key, decoded_texture> texture_cache;
+	size_t texture_cache_texels = 0;
+	std::vector<uint8_t> texture_dirty_pages;
+	uint32_t texture_ram_mask = 0;
+	bool texture_dirty = false;
+	bool palette_dirty = false;
+	memory_passthrough_handler texture_write_tap;
 
 	struct vert
 	{
@@ -340,6 +375,8 @@ public:
 protected:
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
+	virtual void device_post_load() override;
 	ioport_constructor device_input_ports() const override;
 
 private:
@@ -501,7 +538,11 @@ private:
 	uint32_t tex_r_p8_8888_vq(texinfo *t, float x, float y);
 
 	uint32_t tex_r_default(texinfo *t, float x, float y);
+	uint32_t tex_r_cached(texinfo *t, float x, float y);
 	void tex_get_info(texinfo *t);
+	void texture_ram_written(uint32_t offset, uint32_t length);
+	void flush_texture_cache();
+	uint32_t const *cached_texture(texinfo &t);
 
 	template <pix_sample_fn sample_fn, int group_no>
 		inline void render_hline(bitmap_rgb32 &bitmap, texinfo *ti,
@@ -512,7 +553,7 @@ private:
 									float const offl[4], float const offr[4]);
 
 	template <pix_sample_fn sample_fn, int group_no>
-		inline void render_span(bitmap_rgb32 &bitmap, texinfo *ti,
+		inline void render_span(bitmap_rgb32 &bitmap, const rectangle &cliprect, texinfo *ti,
 								float y0, float y1,
 								float xl, float xr,
 								float ul, float ur,
@@ -528,16 +569,19 @@ private:
 								float const doldy[4], float const dordy[4]);
 
 	template <pix_sample_fn sample_fn, int group_no>
-		inline void render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti,
+		inline void render_tri_sorted(bitmap_rgb32 &bitmap, const rectangle &cliprect, texinfo *ti,
 										const vert *v0,
 										const vert *v1, const vert *v2);
 
 	template <int group_no>
-		void render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v);
+		void render_tri(bitmap_rgb32 &bitmap, const rectangle &cliprect, texinfo *ti, const vert *v);
 
 	template <int group_no>
 		void render_group_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 
+	void prepare_group(int group_no);
+	static void *render_band_callback(void *param, int threadid);
+
 	void sort_vertices(const vert *v, int *i0, int *i1, int *i2);
 	void render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 	void pvr_accumulationbuffer_to_framebuffer(address_space &space, int x, int y);
@@ -260,6 +260,18 @@ protected:
 	int      stv_sprite_priorities_usage_valid = 0;
 	uint8_t    stv_sprite_priorities_in_fb_line[512][8]{};
 
+	enum { SPRITE_BANDS = 8 };
+	struct sprite_band
+	{
+		saturn_state *state;
+		bitmap_rgb32 *bitmap;
+		const rectangle *cliprect;
+		int first_line, last_line;
+		uint8_t pri;
+		uint8_t priorities_used[8];
+	};
+	osd_work_queue *m_sprite_queue = nullptr;
+
 
 	/* VDP2 */
 
@@ -326,6 +338,8 @@ protected:
 	void stv_vdp2_draw_NBG3(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 	void stv_vdp2_draw_RBG0(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 	void draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect, uint8_t pri);
+	void draw_sprite_lines(bitmap_rgb32 &bitmap, const rectangle &cliprect, uint8_t pri, int first_line, int last_line, uint8_t *priorities_used);
+	static void *draw_sprite_band_callback(void *param, int threadid);
 	int true_vcount[263][4];
 
 	void stv_vdp2_state_save_postload( void );
@@ -8442,6 +8442,10 @@ void saturn_state::stv_vdp2_exit ( void )
 {
 	m_vdp2.roz_bitmap[0].reset();
 	m_vdp2.roz_bitmap[1].reset();
+
+	if (m_sprite_queue)
+		osd_work_queue_free(m_sprite_queue);
+	m_sprite_queue = nullptr;
 }
 
 int saturn_state::stv_vdp2_start ( void )
@@ -8452,6 +8456,7 @@ int saturn_state::stv_vdp2_start ( void )
 	m_vdp2_vram = make_unique_clear<uint32_t[]>(0x100000/4 );
 	m_vdp2_cram = make_unique_clear<uint32_t[]>(0x080000/4 );
 	m_vdp2.gfx_decode = std::make_unique<uint8_t[]>(0x100000 );
+	m_sprite_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
 //  m_gfxdecode->gfx(0)->granularity()=4;
 //  m_gfxdecode->gfx(1)->granularity()=4;
@@ -8783,7 +8788,7 @@ int saturn_state::stv_vdp2_apply_window_on_layer(rectangle &cliprect)
 	}
 }
 
-void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect, uint8_t pri)
+void saturn_state::draw_sprite_lines(bitmap_rgb32 &bitmap, const rectangle &cliprect, uint8_t pri, int first_line, int last_line, uint8_t *priorities_used)
 {
 	int x,y,r,g,b;
 	int i;
@@ -8814,9 +8819,6 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 	uint8_t sprite_ccr[8];
 	int sprite_color_mode = STV_VDP2_SPCLMD;
 
-	if ( (stv_sprite_priorities_usage_valid == 1) && (stv_sprite_priorities_used[pri] == 0) )
-		return;
-
 	sprite_priorities[0] = STV_VDP2_S0PRIN;
 	sprite_priorities[1] = STV_VDP2_S1PRIN;
 	sprite_priorities[2] = STV_VDP2_S2PRIN;
@@ -8886,22 +8888,11 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 	else
 		double_x = 0;
 
-	/* window control */
-	stv2_current_tilemap.window_control.logic = STV_VDP2_SPLOG;
-	stv2_current_tilemap.window_control.enabled[0] = STV_VDP2_SPW0E;
-	stv2_current_tilemap.window_control.enabled[1] = STV_VDP2_SPW1E;
-//  stv2_current_tilemap.window_control.? = STV_VDP2_SPSWE;
-	stv2_current_tilemap.window_control.area[0] = STV_VDP2_SPW0A;
-	stv2_current_tilemap.window_control.area[1] = STV_VDP2_SPW1A;
-//  stv2_current_tilemap.window_control.? = STV_VDP2_SPSWA;
-
-//  stv_vdp2_apply_window_on_layer(mycliprect);
-
 	if (interlace_framebuffer == 0 && double_x == 0 )
 	{
 		if ( alpha_enabled == 0 )
 		{
-			for ( y = cliprect.top(); y <= cliprect.bottom(); y++ )
+			for ( y = first_line; y <= last_line; y++ )
 			{
 				if ( stv_sprite_priorities_usage_valid )
 					if (stv_sprite_priorities_in_fb_line[y][pri] == 0)
@@ -8920,7 +8911,7 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 					{
 						if ( sprite_priorities[0] != pri )
 						{
-							stv_sprite_priorities_used[sprite_priorities[0]] = 1;
+							priorities_used[sprite_priorities[0]] = 1;
 							stv_sprite_priorities_in_fb_line[y][sprite_priorities[0]] = 1;
 							continue;
 						};
@@ -8943,7 +8934,7 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 						priority = sprite_priorities[(pix >> sprite_priority_shift) & sprite_priority_mask];
 						if ( priority != pri )
 						{
-							stv_sprite_priorities_used[priority] = 1;
+							priorities_used[priority] = 1;
 							stv_sprite_priorities_in_fb_line[y][priority] = 1;
 							continue;
 						};
@@ -8994,7 +8985,7 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 		}
 		else //alpha_enabled == 1
 		{
-			for ( y = cliprect.top(); y <= cliprect.bottom(); y++ )
+			for ( y = first_line; y <= last_line; y++ )
 			{
 				if ( stv_sprite_priorities_usage_valid )
 					if (stv_sprite_priorities_in_fb_line[y][pri] == 0)
@@ -9013,7 +9004,7 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 					{
 						if ( sprite_priorities[0] != pri )
 						{
-							stv_sprite_priorities_used[sprite_priorities[0]] = 1;
+							priorities_used[sprite_priorities[0]] = 1;
 							stv_sprite_priorities_in_fb_line[y][sprite_priorities[0]] = 1;
 							continue;
 						};
@@ -9040,7 +9031,7 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 						priority = sprite_priorities[(pix >> sprite_priority_shift) & sprite_priority_mask];
 						if ( priority != pri )
 						{
-							stv_sprite_priorities_used[priority] = 1;
+							priorities_used[priority] = 1;
 							stv_sprite_priorities_in_fb_line[y][priority] = 1;
 							continue;
 						};
@@ -9103,7 +9094,7 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 	}
 	else
 	{
-		for ( y = cliprect.top(); y <= cliprect.bottom() / (interlace_framebuffer+1); y++ )
+		for ( y = first_line; y <= last_line; y++ )
 		{
 			if ( stv_sprite_priorities_usage_valid )
 				if (stv_sprite_priorities_in_fb_line[y][pri] == 0)
@@ -9130,7 +9121,7 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 				{
 					if ( sprite_priorities[0] != pri )
 					{
-						stv_sprite_priorities_used[sprite_priorities[0]] = 1;
+						priorities_used[sprite_priorities[0]] = 1;
 						stv_sprite_priorities_in_fb_line[y][sprite_priorities[0]] = 1;
 						continue;
 					};
@@ -9198,7 +9189,7 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 					priority = sprite_priorities[(pix >> sprite_priority_shift) & sprite_priority_mask];
 					if ( priority != pri )
 					{
-						stv_sprite_priorities_used[priority] = 1;
+						priorities_used[priority] = 1;
 						stv_sprite_priorities_in_fb_line[y][priority] = 1;
 						continue;
 					};
@@ -9310,6 +9301,66 @@ void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect,
 			}
 		}
 	}
+}
+
+
+void *saturn_state::draw_sprite_band_callback(void *param, int threadid)
+{
+	sprite_band &band = *reinterpret_cast<sprite_band *>(param);
+	band.state->draw_sprite_lines(*band.bitmap, *band.cliprect, band.pri, band.first_line, band.last_line, band.priorities_used);
+	return nullptr;
+}
+
+void saturn_state::draw_sprites(bitmap_rgb32 &bitmap, const rectangle &cliprect, uint8_t pri)
+{
+	if ( (stv_sprite_priorities_usage_valid == 1) && (stv_sprite_priorities_used[pri] == 0) )
+		return;
+
+	/* window control */
+	stv2_current_tilemap.window_control.logic = STV_VDP2_SPLOG;
+	stv2_current_tilemap.window_control.enabled[0] = STV_VDP2_SPW0E;
+	stv2_current_tilemap.window_control.enabled[1] = STV_VDP2_SPW1E;
+//  stv2_current_tilemap.window_control.? = STV_VDP2_SPSWE;
+	stv2_current_tilemap.window_control.area[0] = STV_VDP2_SPW0A;
+	stv2_current_tilemap.window_control.area[1] = STV_VDP2_SPW1A;
+//  stv2_current_tilemap.window_control.? = STV_VDP2_SPSWA;
+
+//  stv_vdp2_apply_window_on_layer(mycliprect);
+
+	/* an interlaced framebuffer line covers two bitmap lines */
+	int first_line = cliprect.top();
+	int last_line = cliprect.bottom();
+	if ( (STV_VDP2_LSMD == 3) && m_vdp1.framebuffer_double_interlace == 0 )
+		last_line /= 2;
+
+	/* each band of framebuffer lines only touches its own bitmap lines, so they're composited in parallel */
+	sprite_band bands[SPRITE_BANDS];
+	int lines = last_line - first_line + 1;
+	for ( int i = 0; i < SPRITE_BANDS; i++ )
+	{
+		bands[i].state = this;
+		bands[i].bitmap = &bitmap;
+		bands[i].cliprect = &cliprect;
+		bands[i].pri = pri;
+		bands[i].first_line = first_line + (lines * i) / SPRITE_BANDS;
+		bands[i].last_line = first_line + (lines * (i + 1)) / SPRITE_BANDS - 1;
+		memset(bands[i].priorities_used, 0, sizeof(bands[i].priorities_used));
+	}
+
+	if ( m_sprite_queue && osd_work_item_queue_multiple(m_sprite_queue, draw_sprite_band_callback, SPRITE_BANDS, bands, sizeof(sprite_band), WORK_ITEM_FLAG_AUTO_RELEASE) )
+	{
+		osd_work_queue_wait(m_sprite_queue, osd_ticks_per_second() * 10);
+	}
+	else
+	{
+		for ( sprite_band &band : bands )
+			draw_sprite_band_callback(&band, 0);
+	}
+
+	for ( sprite_band const &band : bands )
+		for ( int i = 0; i < 8; i++ )
+			if ( band.priorities_used[i] )
+				stv_sprite_priorities_used[i] = 1;
 
 	stv_sprite_priorities_usage_valid = 1;
 }
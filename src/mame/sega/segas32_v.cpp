@@ -1807,6 +1807,19 @@ void segas32_state::mix_all_layers(int which, int xoffs, bitmap_rgb32 &bitmap, c
 	rgboffs[2][1] = 0;
 	rgboffs[2][2] = 0;
 
+	/* precompute the offset, shadowed and clamped output for each component value */
+	uint32_t rgbclamp[3][2][3][32];
+	for (int offs = 0; offs < 3; offs++)
+		for (int shad = 0; shad < 2; shad++)
+			for (int comp = 0; comp < 3; comp++)
+				for (int val = 0; val < 32; val++)
+				{
+					int level = val + rgboffs[offs][comp];
+					if (shad)
+						level >>= 1;
+					rgbclamp[offs][shad][comp][val] = std::clamp(level, 0, 31) << (16 - 8 * comp + 3);
+				}
+
 	/* determine the sprite grouping parameters first */
 	uint8_t sprgroup_shift, sprgroup_mask, sprgroup_or;
 	switch (m_mixer_control[which][0x4c/2] & 0x0f)
@@ -1999,6 +2012,14 @@ void segas32_state::mix_all_layers(int which, int xoffs, bitmap_rgb32 &bitmap, c
 			/* adjust the first pixel */
 			firstpix = m_paletteram[which][(first->palbase + ((firstpix >> first->mixshift) & 0xfff0) + (firstpix & 0x0f)) & 0x3fff];
 
+			/* with nothing to blend against, the output comes straight from the table */
+			if (first->blendmask == 0)
+			{
+				uint32_t const (&clamp)[3][32] = rgbclamp[first->coloroffs][shadow ? 1 : 0];
+				dest[x] = clamp[0][firstpix & 0x1f] | clamp[1][(firstpix >> 5) & 0x1f] | clamp[2][(firstpix >> 10) & 0x1f];
+				continue;
+			}
+
 			/* compute R, G, B */
 			int const *rgbdelta = &rgboffs[first->coloroffs][0];
 			int r = ((firstpix >>  0) & 0x1f) + rgbdelta[0];
@@ -190,6 +190,12 @@ protected:
 		u32 clip_in[256]{};
 		u32 clip_ex[256]{};
 		u16 pal_add[256]{};
+
+		/* decoded from lineram, kept until it changes */
+		u8 line_enable[256]{};
+		u16 colscroll[256]{};
+		u32 x_offset[256]{};
+		u8 y_zoom[256]{};
 	};
 
 	struct f3_spritealpha_line_inf
@@ -211,6 +217,8 @@ protected:
 	u16 m_control_0[8]{};
 	u16 m_control_1[8]{};
 	bool m_flipscreen = false;
+	bool m_line_ram_dirty = true;
+	bool m_line_ram_flip = false;
 	u8 m_sprite_extra_planes = 0;
 	u8 m_sprite_pen_mask = 0;
 	u16 *m_pf_data[8]{};
@@ -374,7 +382,9 @@ protected:
 	void visible_tile_check(f3_playfield_line_inf *line_t, int line, u32 x_index_fx, u32 y_index, const u16 *pf_data_n);
 	void calculate_clip(int y, u16 pri, u32 &clip_in, u32 &clip_ex, u8 &line_enable);
 	void get_spritealphaclip_info();
+	void decode_line_ram_info(int pos);
 	void get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos, const u16 *pf_data_n);
+	void decode_vram_info();
 	void get_vram_info(tilemap_t *vram_tilemap, tilemap_t *pixel_tilemap, int sx, int sy);
 	void scanline_draw(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 
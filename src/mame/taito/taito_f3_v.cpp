@@ -307,6 +307,8 @@ void taito_f3_state::device_post_load()
 	/* force a reread of the dynamic tiles in the pixel layer */
 	m_gfxdecode->gfx(0)->mark_all_dirty();
 	m_gfxdecode->gfx(1)->mark_all_dirty();
+
+	m_line_ram_dirty = true;
 }
 
 /******************************************************************************/
@@ -723,7 +725,10 @@ void taito_f3_state::lineram_w(offs_t offset, u16 data, u16 mem_mask)
 	}
 #endif
 
+	const u16 old = m_line_ram[offset];
 	COMBINE_DATA(&m_line_ram[offset]);
+	if (m_line_ram[offset] != old)
+		m_line_ram_dirty = true;
 }
 
 void taito_f3_state::palette_24bit_w(offs_t offset, u32 data, u32 mem_mask)
@@ -1642,45 +1647,29 @@ void taito_f3_state::get_spritealphaclip_info()
 	}
 }
 
-/* sx and sy are 16.16 fixed point numbers */
-void taito_f3_state::get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos, const u16 *pf_data_n)
+/* decodes the parts of a playfield's line RAM that don't depend on scroll or tile data */
+void taito_f3_state::decode_line_ram_info(int pos)
 {
 	f3_playfield_line_inf *line_t = &m_pf_line_inf[pos];
 
 	int y_start, y_end, y_inc;
-	int y_index_fx;
 
 	u16 colscroll = 0;
-	u16 _colscroll[256];
 	int x_offset = 0;
-	u32 _x_offset[256];
 	u8 line_zoom_x = 0, line_zoom_y = 0;
-	u8 _y_zoom[256];
 	u16 pri = 0, pal_add = 0;
 
-	sx += ((46 << 16));
-
 	if (m_flipscreen)
 	{
 		y_start = 255;
 		y_end = -1;
 		y_inc = -1;
-
-		 /* Adjust for flipped scroll position */
-		if (m_game_config->extend)
-			sx = -sx + (((188 - 512) & 0xffff) << 16);
-		else
-			sx = -sx + (188 << 16);
-
-		y_index_fx = -sy - (256 << 16); /* Adjust for flipped scroll position */
 	}
 	else
 	{
 		y_start = 0;
 		y_end = 256;
 		y_inc = 1;
-
-		y_index_fx = sy;
 	}
 
 	int y = y_start;
@@ -1755,9 +1744,9 @@ void taito_f3_state::get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos,
 		else
 			line_enable = 1;
 
-		_colscroll[y] = colscroll;
-		_x_offset[y] = (x_offset & 0xffff0000) - (x_offset & 0x0000ffff);
-		_y_zoom[y] = line_zoom_y;
+		line_t->colscroll[y] = colscroll;
+		line_t->x_offset[y] = (x_offset & 0xffff0000) - (x_offset & 0x0000ffff);
+		line_t->y_zoom[y] = line_zoom_y;
 
 		/* Evaluate clipping */
 		if (pri & 0x0f00)
@@ -1773,7 +1762,7 @@ void taito_f3_state::get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos,
 		}
 
 		line_t->x_zoom[y] = 0x10000 - (line_zoom_x << 8);
-		line_t->alpha_mode[y] = line_enable;
+		line_t->line_enable[y] = line_enable;
 		line_t->pri[y] = pri;
 		line_t->pal_add[y] = pal_add;
 
@@ -1781,13 +1770,47 @@ void taito_f3_state::get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos,
 		y += y_inc;
 	}
 	// ignore the first zoom value from ram and use the default
-	_y_zoom[y_start] = 0;
+	line_t->y_zoom[y_start] = 0;
 	line_t->x_zoom[y_start] = 0x10000;
+}
+
+/* sx and sy are 16.16 fixed point numbers */
+void taito_f3_state::get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos, const u16 *pf_data_n)
+{
+	f3_playfield_line_inf *line_t = &m_pf_line_inf[pos];
+
+	int y_start, y_end, y_inc;
+	int y_index_fx;
+
+	sx += ((46 << 16));
+
+	if (m_flipscreen)
+	{
+		y_start = 255;
+		y_end = -1;
+		y_inc = -1;
+
+		 /* Adjust for flipped scroll position */
+		if (m_game_config->extend)
+			sx = -sx + (((188 - 512) & 0xffff) << 16);
+		else
+			sx = -sx + (188 << 16);
+
+		y_index_fx = -sy - (256 << 16); /* Adjust for flipped scroll position */
+	}
+	else
+	{
+		y_start = 0;
+		y_end = 256;
+		y_inc = 1;
+
+		y_index_fx = sy;
+	}
 
 	tilemap_t* tm = tmap;
 	const u16* pfdata = pf_data_n;
 
-	y = y_start;
+	int y = y_start;
 	while (y != y_end)
 	{
 		u32 x_index_fx;
@@ -1800,7 +1823,7 @@ void taito_f3_state::get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos,
 		   there's some seemingly unrelated issue with the timing of y scrolling,
 		   causing the pitch to scroll ahead of crowd areas
 		*/
-		const u16 cs = _colscroll[y];
+		const u16 cs = line_t->colscroll[y];
 		if (cs & 0x200)
 		{
 			if (m_tilemap[4] && m_tilemap[5])
@@ -1827,13 +1850,15 @@ void taito_f3_state::get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos,
 		bitmap_ind16 &srcbitmap = tmap->pixmap();
 		bitmap_ind8 &flagsbitmap = tmap->flagsmap();
 
+		/* start from the decoded line state, tile checks below refine it */
+		line_t->alpha_mode[y] = line_t->line_enable[y];
 		if (line_t->alpha_mode[y] != 0)
 		{
 			u16 *src_s;
 			u8 *tsrc_s;
 
-			x_index_fx = (sx+_x_offset[y]-(10*0x10000) + (10*line_t->x_zoom[y]))&((m_width_mask << 16)|0xffff);
-			y_index = ((y_index_fx >> 16)+_colscroll[y]) & 0x1ff;
+			x_index_fx = (sx+line_t->x_offset[y]-(10*0x10000) + (10*line_t->x_zoom[y]))&((m_width_mask << 16)|0xffff);
+			y_index = ((y_index_fx >> 16)+line_t->colscroll[y]) & 0x1ff;
 
 			/* check tile status */
 			visible_tile_check(line_t, y, x_index_fx, y_index, pf_data_n);
@@ -1852,14 +1877,13 @@ void taito_f3_state::get_line_ram_info(tilemap_t *tmap, int sx, int sy, int pos,
 			line_t->tsrc[y] = &tsrc_s[x_index_fx >> 16];
 		}
 
-		y_index_fx += _y_zoom[y] << 9;
+		y_index_fx += line_t->y_zoom[y] << 9;
 		y += y_inc;
 	}
 }
 
-void taito_f3_state::get_vram_info(tilemap_t *vram_tilemap, tilemap_t *pixel_tilemap, int sx, int sy)
+void taito_f3_state::decode_vram_info()
 {
-	const f3_spritealpha_line_inf *sprite_alpha_line_t = &m_sa_line_inf[0];
 	f3_playfield_line_inf *line_t = &m_pf_line_inf[4];
 
 	int y_start, y_end, y_inc;
@@ -1869,8 +1893,6 @@ void taito_f3_state::get_vram_info(tilemap_t *vram_tilemap, tilemap_t *pixel_til
 
 	u16 pri = 0;
 
-	const u16 vram_width_mask = 0x1ff;
-
 	if (m_flipscreen)
 	{
 		pri_base = 0x73fe;
@@ -1931,6 +1953,29 @@ void taito_f3_state::get_vram_info(tilemap_t *vram_tilemap, tilemap_t *pixel_til
 		pri_base += inc;
 		y += y_inc;
 	}
+}
+
+void taito_f3_state::get_vram_info(tilemap_t *vram_tilemap, tilemap_t *pixel_tilemap, int sx, int sy)
+{
+	const f3_spritealpha_line_inf *sprite_alpha_line_t = &m_sa_line_inf[0];
+	f3_playfield_line_inf *line_t = &m_pf_line_inf[4];
+
+	int y_start, y_end, y_inc;
+
+	const u16 vram_width_mask = 0x1ff;
+
+	if (m_flipscreen)
+	{
+		y_start = 255;
+		y_end = -1;
+		y_inc = -1;
+	}
+	else
+	{
+		y_start = 0;
+		y_end = 256;
+		y_inc = 1;
+	}
 
 	sx &= 0x1ff;
 
@@ -1940,7 +1985,7 @@ void taito_f3_state::get_vram_info(tilemap_t *vram_tilemap, tilemap_t *pixel_til
 	bitmap_ind16 &srcbitmap_vram = vram_tilemap->pixmap();
 	bitmap_ind8 &flagsbitmap_vram = vram_tilemap->flagsmap();
 
-	y = y_start;
+	int y = y_start;
 	while (y != y_end)
 	{
 		if (line_t->alpha_mode[y] != 0)
@@ -2833,8 +2878,18 @@ u32 taito_f3_state::screen_update(screen_device &screen, bitmap_rgb32 &bitmap, c
 	/* Update sprite buffer */
 	draw_sprites(bitmap, cliprect);
 
-	/* Parse sprite, alpha & clipping parts of lineram */
-	get_spritealphaclip_info();
+	/* Parse sprite, alpha & clipping parts of lineram, and the playfield
+	   line state that only depends on lineram, when it has changed */
+	if (m_line_ram_dirty || (m_line_ram_flip != m_flipscreen))
+	{
+		get_spritealphaclip_info();
+		for (int pos = 0; pos < 4; pos++)
+			decode_line_ram_info(pos);
+		decode_vram_info();
+
+		m_line_ram_dirty = false;
+		m_line_ram_flip = m_flipscreen;
+	}
 
 	/* Parse playfield effects */
 	get_line_ram_info(m_tilemap[0], sx_fix[0], sy_fix[0], 0, m_pf_data[0]);
@@ -58,6 +58,9 @@
 #include <fcntl.h>
 #include <climits>
 #include <sys/stat.h>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
 #include <cstdlib>
 #include <unistd.h>
 
@@ -231,6 +234,8 @@ std::error_condition osd_file::open(std::string const &path, std::uint32_t openf
 		return posix_open_ptty(openflags, file, filesize, dst);
 	else if (posix_check_domain_path(path))
 		return posix_open_domain(path, openflags, file, filesize);
+	else if (posix_check_link_path(path))
+		return posix_open_link(path, openflags, file, filesize);
 
 	// select the file open modes
 	int access;
@@ -329,6 +334,137 @@ std::error_condition osd_file::open(std::string const &path, std::uint32_t openf
 }
 
 
+//============================================================
+//  osd_file_mapping::open
+//============================================================
+
+#if !defined(_WIN32)
+namespace {
+
+class posix_file_mapping : public osd_file_mapping
+{
+public:
+	posix_file_mapping(void *data, std::size_t size) noexcept : m_data(data), m_size(size) { }
+	virtual ~posix_file_mapping() override { ::munmap(m_data, m_size); }
+
+	virtual void *data() noexcept override { return m_data; }
+	virtual std::size_t size() const noexcept override { return m_size; }
+
+private:
+	void *const m_data;
+	std::size_t const m_size;
+};
+
+} // anonymous namespace
+#endif
+
+
+std::error_condition osd_file_mapping::open(std::string const &path, std::size_t length, ptr &mapping) noexcept
+{
+#if defined(_WIN32)
+	return std::errc::not_supported;
+#else
+	if (!length)
+		return std::errc::invalid_argument;
+
+	int const fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+	if (fd < 0)
+		return std::error_condition(errno, std::generic_category());
+
+	// the mapping keeps its own reference to the file
+	void *const data(::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0));
+	int const err(errno);
+	::close(fd);
+	if (MAP_FAILED == data)
+		return std::error_condition(err, std::generic_category());
+
+	mapping.reset(new (std::nothrow) posix_file_mapping(data, length));
+	if (!mapping)
+	{
+		::munmap(data, length);
+		return std::errc::not_enough_memory;
+	}
+	return std::error_condition();
+#endif
+}
+
+
+//============================================================
+//  osd_shared_memory::create
+//============================================================
+
+#if !defined(_WIN32)
+namespace {
+
+class posix_shared_memory : public osd_shared_memory
+{
+public:
+	posix_shared_memory(std::string &&name, void *data, std::size_t size) noexcept : m_name(std::move(name)), m_data(data), m_size(size) { }
+	virtual ~posix_shared_memory() override { ::munmap(m_data, m_size); ::shm_unlink(m_name.c_str()); }
+
+	virtual void *data() noexcept override { return m_data; }
+	virtual std::size_t size() const noexcept override { return m_size; }
+
+private:
+	std::string const m_name;
+	void *const m_data;
+	std::size_t const m_size;
+};
+
+} // anonymous namespace
+#endif
+
+
+std::error_condition osd_shared_memory::create(std::string const &name, std::size_t length, ptr &memory) noexcept
+{
+#if defined(_WIN32)
+	return std::errc::not_supported;
+#else
+	if (!length)
+		return std::errc::invalid_argument;
+
+	// portable shared memory object names start with a single slash; include
+	// the user ID so different users' machines don't collide
+	std::string objname;
+	try { objname = "/mame-" + std::to_string(int(::getuid())) + "-" + name; }
+	catch (...) { return std::errc::not_enough_memory; }
+
+	// replace anything left by an earlier process, but never open an object
+	// someone else created under our name
+	::shm_unlink(objname.c_str());
+	int const fd(::shm_open(objname.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600));
+	if (fd < 0)
+		return std::error_condition(errno, std::generic_category());
+	if (::ftruncate(fd, length) < 0)
+	{
+		int const err(errno);
+		::close(fd);
+		::shm_unlink(objname.c_str());
+		return std::error_condition(err, std::generic_category());
+	}
+
+	// the mapping keeps its own reference to the object
+	void *const data(::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+	int const err(errno);
+	::close(fd);
+	if (MAP_FAILED == data)
+	{
+		::shm_unlink(objname.c_str());
+		return std::error_condition(err, std::generic_category());
+	}
+
+	memory.reset(new (std::nothrow) posix_shared_memory(std::move(objname), data, length));
+	if (!memory)
+	{
+		::munmap(data, length);
+		::shm_unlink(objname.c_str());
+		return std::errc::not_enough_memory;
+	}
+	return std::error_condition();
+#endif
+}
+
+
 //============================================================
 //  osd_file::openpty
 //============================================================
@@ -0,0 +1,201 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+//============================================================
+//
+//  posixlink.cpp - shared memory point-to-point links
+//
+//============================================================
+
+#include "posixfile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace {
+
+char const *const posixfile_link_identifier = "link.";
+
+// bytes buffered in each direction
+constexpr std::uint32_t LINK_BUFFER = 65536;
+
+// Each direction is a single producer, single consumer ring.  The counts
+// run freely and are only ever advanced by their owner.
+struct link_ring
+{
+	std::atomic<std::uint32_t>  written;
+	std::atomic<std::uint32_t>  read;
+	std::uint8_t                data[LINK_BUFFER];
+};
+
+// Two ends share the segment.  Each claims a side by storing its process
+// ID, and receives through the ring of the same index.
+struct link_segment
+{
+	std::atomic<std::int32_t>   owner[2];
+	link_ring                   ring[2];
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shared memory links need lock-free atomics");
+static_assert(std::atomic<std::int32_t>::is_always_lock_free, "shared memory links need lock-free atomics");
+
+
+class posix_osd_link : public osd_file
+{
+public:
+	posix_osd_link(posix_osd_link const &) = delete;
+	posix_osd_link(posix_osd_link &&) = delete;
+	posix_osd_link& operator=(posix_osd_link const &) = delete;
+	posix_osd_link& operator=(posix_osd_link &&) = delete;
+
+	posix_osd_link(link_segment *segment, int side) noexcept
+		: m_segment(segment)
+		, m_side(side)
+	{
+		assert(m_segment);
+	}
+
+	virtual ~posix_osd_link()
+	{
+		m_segment->owner[m_side].store(0, std::memory_order_release);
+		::munmap(m_segment, sizeof(link_segment));
+	}
+
+	virtual std::error_condition read(void *buffer, std::uint64_t offset, std::uint32_t count, std::uint32_t &actual) noexcept override
+	{
+		link_ring &ring = m_segment->ring[m_side];
+		std::uint32_t const tail = ring.read.load(std::memory_order_relaxed);
+		std::uint32_t const available = ring.written.load(std::memory_order_acquire) - tail;
+		actual = std::min(count, available);
+		if (!actual)
+			return std::errc::operation_would_block;
+
+		// copy in up to two pieces around the end of the buffer
+		std::uint32_t const start = tail % LINK_BUFFER;
+		std::uint32_t const first = std::min(actual, LINK_BUFFER - start);
+		std::memcpy(buffer, &ring.data[start], first);
+		std::memcpy(reinterpret_cast<std::uint8_t *>(buffer) + first, &ring.data[0], actual - first);
+		ring.read.store(tail + actual, std::memory_order_release);
+		return std::error_condition();
+	}
+
+	virtual std::error_condition write(void const *buffer, std::uint64_t offset, std::uint32_t count, std::uint32_t &actual) noexcept override
+	{
+		link_ring &ring = m_segment->ring[m_side ^ 1];
+		std::uint32_t const head = ring.written.load(std::memory_order_relaxed);
+		std::uint32_t const space = LINK_BUFFER - (head - ring.read.load(std::memory_order_acquire));
+		actual = std::min(count, space);
+		if (!actual)
+			return std::errc::operation_would_block;
+
+		std::uint32_t const start = head % LINK_BUFFER;
+		std::uint32_t const first = std::min(actual, LINK_BUFFER - start);
+		std::memcpy(&ring.data[start], buffer, first);
+		std::memcpy(&ring.data[0], reinterpret_cast<std::uint8_t const *>(buffer) + first, actual - first);
+		ring.written.store(head + actual, std::memory_order_release);
+		return std::error_condition();
+	}
+
+	virtual std::error_condition truncate(std::uint64_t offset) noexcept override
+	{
+		// doesn't make sense on a link
+		return std::errc::bad_file_descriptor;
+	}
+
+	virtual std::error_condition flush() noexcept override
+	{
+		// writes are visible to the other end immediately
+		return std::error_condition();
+	}
+
+private:
+	link_segment    *m_segment;
+	int             m_side;
+};
+
+
+bool claim_side(link_segment &segment, int side) noexcept
+{
+	std::int32_t owner = segment.owner[side].load(std::memory_order_acquire);
+
+	// a side left behind by a process that's gone can be taken over
+	if (owner && ((::kill(owner, 0) == 0) || (errno != ESRCH)))
+		return false;
+	return segment.owner[side].compare_exchange_strong(owner, std::int32_t(::getpid()), std::memory_order_acq_rel);
+}
+
+} // anonymous namespace
+
+
+/*
+    Checks whether the path is a link specification. A valid link
+    specification has the format "link." name, and connects the first two
+    files opened with the same name by processes run by the same user.
+*/
+bool posix_check_link_path(std::string const &path) noexcept
+{
+	return (strncmp(path.c_str(), posixfile_link_identifier, strlen(posixfile_link_identifier)) == 0) &&
+			(path.length() > strlen(posixfile_link_identifier)) &&
+			(path.find('/') == std::string::npos);
+}
+
+
+std::error_condition posix_open_link(std::string const &path, std::uint32_t openflags, osd_file::ptr &file, std::uint64_t &filesize) noexcept
+{
+	char name[256];
+	std::snprintf(name, sizeof(name), "/mame-link-%d-%s", int(::getuid()), &path[strlen(posixfile_link_identifier)]);
+
+	// the segment is zero-filled when first sized, which leaves both sides free and both rings empty
+	int const fd = ::shm_open(name, O_RDWR | O_CREAT, 0600);
+	if (fd < 0)
+		return std::error_condition(errno, std::generic_category());
+	struct stat st;
+	if ((::fstat(fd, &st) < 0) || ((st.st_size < off_t(sizeof(link_segment))) && (::ftruncate(fd, sizeof(link_segment)) < 0)))
+	{
+		std::error_condition sizeerr(errno, std::generic_category());
+		::close(fd);
+		return sizeerr;
+	}
+	void *const mem = ::mmap(nullptr, sizeof(link_segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (mem == MAP_FAILED)
+		return std::error_condition(errno, std::generic_category());
+	link_segment &segment = *reinterpret_cast<link_segment *>(mem);
+
+	int side;
+	if (claim_side(segment, 0))
+		side = 0;
+	else if (claim_side(segment, 1))
+		side = 1;
+	else
+	{
+		::munmap(mem, sizeof(link_segment));
+		return std::errc::device_or_resource_busy;
+	}
+
+	// anything sent before this end was opened is discarded
+	link_ring &ring = segment.ring[side];
+	ring.read.store(ring.written.load(std::memory_order_acquire), std::memory_order_release);
+
+	osd_file::ptr result(new (std::nothrow) posix_osd_link(&segment, side));
+	if (!result)
+	{
+		segment.owner[side].store(0, std::memory_order_release);
+		::munmap(mem, sizeof(link_segment));
+		return std::errc::not_enough_memory;
+	}
+	file = std::move(result);
+	filesize = 0;
+	return std::error_condition();
+}
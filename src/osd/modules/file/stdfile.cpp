@@ -171,6 +171,26 @@ std::error_condition osd_file::open(std::string const &path, std::uint32_t openf
 }
 
 
+//============================================================
+//  osd_file_mapping::open
+//============================================================
+
+std::error_condition osd_file_mapping::open(std::string const &path, std::size_t length, ptr &mapping) noexcept
+{
+	return std::errc::not_supported;
+}
+
+
+//============================================================
+//  osd_shared_memory::create
+//============================================================
+
+std::error_condition osd_shared_memory::create(std::string const &name, std::size_t length, ptr &memory) noexcept
+{
+	return std::errc::not_supported;
+}
+
+
 //============================================================
 //  osd_openpty
 //============================================================
@@ -272,6 +272,129 @@ std::error_condition osd_file::open(std::string const &path, uint32_t openflags,
 
 
 
+//============================================================
+//  osd_file_mapping::open
+//============================================================
+
+namespace {
+
+class win_file_mapping : public osd_file_mapping
+{
+public:
+	win_file_mapping(void *data, std::size_t size) noexcept : m_data(data), m_size(size) { }
+	virtual ~win_file_mapping() override { UnmapViewOfFile(m_data); }
+
+	virtual void *data() noexcept override { return m_data; }
+	virtual std::size_t size() const noexcept override { return m_size; }
+
+private:
+	void *const m_data;
+	std::size_t const m_size;
+};
+
+} // anonymous namespace
+
+
+std::error_condition osd_file_mapping::open(std::string const &path, std::size_t length, ptr &mapping) noexcept
+{
+	if (!length)
+		return std::errc::invalid_argument;
+
+	// convert path to TCHAR
+	osd::text::tstring t_path;
+	try { t_path = osd::text::to_tstring(path); }
+	catch (...) { return std::errc::not_enough_memory; }
+
+	HANDLE const file = CreateFile(t_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
+	if (INVALID_HANDLE_VALUE == file)
+		return win_error_to_error_condition(GetLastError());
+
+	// the view keeps the section and file alive once it's mapped
+	HANDLE const section = CreateFileMapping(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	DWORD err = GetLastError();
+	CloseHandle(file);
+	if (!section)
+		return win_error_to_error_condition(err);
+
+	void *const data = MapViewOfFile(section, FILE_MAP_COPY, 0, 0, length);
+	err = GetLastError();
+	CloseHandle(section);
+	if (!data)
+		return win_error_to_error_condition(err);
+
+	mapping.reset(new (std::nothrow) win_file_mapping(data, length));
+	if (!mapping)
+	{
+		UnmapViewOfFile(data);
+		return std::errc::not_enough_memory;
+	}
+	return std::error_condition();
+}
+
+
+
+//============================================================
+//  osd_shared_memory::create
+//============================================================
+
+namespace {
+
+class win_shared_memory : public osd_shared_memory
+{
+public:
+	win_shared_memory(HANDLE section, void *data, std::size_t size) noexcept : m_section(section), m_data(data), m_size(size) { }
+	virtual ~win_shared_memory() override { UnmapViewOfFile(m_data); CloseHandle(m_section); }
+
+	virtual void *data() noexcept override { return m_data; }
+	virtual std::size_t size() const noexcept override { return m_size; }
+
+private:
+	HANDLE const m_section;
+	void *const m_data;
+	std::size_t const m_size;
+};
+
+} // anonymous namespace
+
+
+std::error_condition osd_shared_memory::create(std::string const &name, std::size_t length, ptr &memory) noexcept
+{
+	if (!length)
+		return std::errc::invalid_argument;
+
+	// convert name to TCHAR
+	osd::text::tstring t_name;
+	try { t_name = osd::text::to_tstring(name); }
+	catch (...) { return std::errc::not_enough_memory; }
+
+	// a pagefile-backed section stays alive as long as any process has a handle to it
+	HANDLE const section = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD(std::uint64_t(length) >> 32), DWORD(length), t_name.c_str());
+	if (!section)
+		return win_error_to_error_condition(GetLastError());
+
+	void *const data = MapViewOfFile(section, FILE_MAP_ALL_ACCESS, 0, 0, length);
+	if (!data)
+	{
+		DWORD const err = GetLastError();
+		CloseHandle(section);
+		return win_error_to_error_condition(err);
+	}
+
+	// an existing section isn't cleared for us
+	std::memset(data, 0, length);
+
+	memory.reset(new (std::nothrow) win_shared_memory(section, data, length));
+	if (!memory)
+	{
+		UnmapViewOfFile(data);
+		CloseHandle(section);
+		return std::errc::not_enough_memory;
+	}
+	return std::error_condition();
+}
+
+
+
 //============================================================
 //  osd_openpty
 //============================================================
@@ -0,0 +1,1213 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+//============================================================
+//
+//  input_evdev.cpp - Linux event device input
+//
+//  Keyboards, mice and joysticks are read directly from
+//  /dev/input/event* without going through SDL or a window
+//  system.  Each module has an input thread that waits on its
+//  devices with epoll and hands complete states over through
+//  a triple buffer per device, so polling never makes a system
+//  call or waits for the input thread.
+//
+//  Devices are found at start.  One that's unplugged is
+//  reconnected when a device with the same identity appears
+//  again under /dev/input.
+//
+//============================================================
+
+#include "input_module.h"
+
+#include "modules/osdmodule.h"
+
+#if defined(__linux__) && !defined(__ANDROID__)
+
+#include "assignmenthelper.h"
+#include "input_common.h"
+
+#include "interface/inputseq.h"
+#include "modules/lib/osdobj_common.h"
+#include "osdsync.h"
+
+// emu
+#include "inpttype.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// these must come after input_common.h: the kernel's KEY_ codes replace the scan codes defined there
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+
+namespace osd {
+
+namespace {
+
+// evdev reports up to four hats as pairs of axes
+constexpr int EVDEV_HATS = 4;
+
+// mice report up to eight buttons from BTN_LEFT to BTN_TASK
+constexpr int EVDEV_MOUSE_BUTTONS = 8;
+
+constexpr std::size_t LONG_BITS = 8 * sizeof(unsigned long);
+
+constexpr std::size_t bit_longs(std::size_t count) { return (count + LONG_BITS - 1) / LONG_BITS; }
+
+template <std::size_t N>
+bool test_bit(unsigned long const (&bits)[N], unsigned bit)
+{
+	return (bits[bit / LONG_BITS] >> (bit % LONG_BITS)) & 1;
+}
+
+template <std::size_t N>
+bool test_bits(unsigned long const (&bits)[N], unsigned first, unsigned last)
+{
+	for (unsigned bit = first; bit <= last; bit++)
+	{
+		if (!test_bit(bits, bit))
+			return false;
+	}
+	return true;
+}
+
+using key_bits = unsigned long [bit_longs(KEY_CNT)];
+using abs_bits = unsigned long [bit_longs(ABS_CNT)];
+using rel_bits = unsigned long [bit_longs(REL_CNT)];
+
+
+// what a device says it can report
+struct evdev_capabilities
+{
+	key_bits keys;
+	abs_bits axes;
+	rel_bits rel;
+};
+
+
+// identity used to recognise a device when it's plugged in again
+std::string evdev_device_id(int fd)
+{
+	char uniq[256] = { 0 };
+	input_id devid;
+	std::memset(&devid, 0, sizeof(devid));
+	::ioctl(fd, EVIOCGID, &devid);
+	if ((0 > ::ioctl(fd, EVIOCGUNIQ(sizeof(uniq) - 1), uniq)) || !uniq[0])
+		::ioctl(fd, EVIOCGPHYS(sizeof(uniq) - 1), uniq);
+
+	char id[320];
+	snprintf(id, sizeof(id), "%04x:%04x:%04x:%s", devid.bustype, devid.vendor, devid.product, uniq);
+	return id;
+}
+
+
+//============================================================
+//  evdev_state_exchange - triple buffer handing states from
+//  the input thread to poll
+//============================================================
+
+template <typename State>
+class evdev_state_exchange
+{
+public:
+	evdev_state_exchange() : m_buffers(), m_latest(1), m_back(0), m_front(2) { }
+
+	// called on the input thread with a complete state
+	void publish(State const &state)
+	{
+		// swap the finished buffer for whichever one poll isn't using
+		m_buffers[m_back] = state;
+		m_back = m_latest.exchange(m_back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+	}
+
+	// called by poll; returns the newest complete state
+	State const &latest()
+	{
+		if (m_latest.load(std::memory_order_relaxed) & FRESH)
+			m_front = m_latest.exchange(m_front, std::memory_order_acq_rel) & ~FRESH;
+		return m_buffers[m_front];
+	}
+
+private:
+	// bit marking a buffer that poll hasn't taken yet
+	static constexpr unsigned FRESH = 4;
+
+	State                   m_buffers[3];
+	std::atomic<unsigned>   m_latest;                   // buffer with the newest state
+	unsigned                m_back;                     // buffer owned by the input thread
+	unsigned                m_front;                    // buffer owned by poll
+};
+
+
+//============================================================
+//  evdev_device - common event device handling
+//============================================================
+
+class evdev_device : public device_info
+{
+public:
+	virtual ~evdev_device()
+	{
+		if (0 <= m_fd)
+			::close(m_fd);
+	}
+
+	int fd() const { return m_fd; }
+
+	// the rest are called on the input thread
+
+	// returns false once the device is gone
+	bool read_events()
+	{
+		input_event events[64];
+		while (true)
+		{
+			ssize_t const bytes = ::read(m_fd, events, sizeof(events));
+			if (bytes < 0)
+				return (errno == EAGAIN) || (errno == EINTR);
+			if (!bytes)
+				return true;
+
+			for (std::size_t i = 0; i < (bytes / sizeof(events[0])); i++)
+			{
+				input_event const &event = events[i];
+				if (event.type == EV_SYN)
+				{
+					// after the kernel drops events, ignore the rest of the report and read the whole state instead
+					if (event.code == SYN_DROPPED)
+					{
+						m_dropped = true;
+					}
+					else if (event.code == SYN_REPORT)
+					{
+						if (m_dropped)
+						{
+							m_dropped = false;
+							resync();
+						}
+						else
+						{
+							report();
+						}
+					}
+				}
+				else if (!m_dropped)
+				{
+					process_event(event);
+				}
+			}
+		}
+	}
+
+	void attach(int fd)
+	{
+		m_fd = fd;
+		m_dropped = false;
+		resync();
+	}
+
+	void detach()
+	{
+		::close(m_fd);
+		m_fd = -1;
+		release();
+	}
+
+protected:
+	evdev_device(std::string &&name, std::string &&id, input_module &module, int fd) :
+		device_info(std::move(name), std::move(id), module),
+		m_fd(fd),
+		m_dropped(false)
+	{
+	}
+
+	// apply an event to the state being built
+	virtual void process_event(input_event const &event) = 0;
+
+	// publish the state being built
+	virtual void report() = 0;
+
+	// read the whole state from the kernel and publish it
+	virtual void resync() = 0;
+
+	// publish a state with nothing held down
+	virtual void release() = 0;
+
+private:
+	int     m_fd;
+	bool    m_dropped;
+};
+
+
+//============================================================
+//  evdev_keyboard_device
+//============================================================
+
+struct evdev_key_entry
+{
+	unsigned        code;
+	input_item_id   mame_key;
+	char const *    name;
+};
+
+#define EVDEV_KEY(code, mame) { KEY_##code, ITEM_ID_##mame, #mame }
+
+evdev_key_entry const evdev_key_table[] =
+{
+	EVDEV_KEY(ESC,          ESC),
+	EVDEV_KEY(1,            1),
+	EVDEV_KEY(2,            2),
+	EVDEV_KEY(3,            3),
+	EVDEV_KEY(4,            4),
+	EVDEV_KEY(5,            5),
+	EVDEV_KEY(6,            6),
+	EVDEV_KEY(7,            7),
+	EVDEV_KEY(8,            8),
+	EVDEV_KEY(9,            9),
+	EVDEV_KEY(0,            0),
+	EVDEV_KEY(MINUS,        MINUS),
+	EVDEV_KEY(EQUAL,        EQUALS),
+	EVDEV_KEY(BACKSPACE,    BACKSPACE),
+	EVDEV_KEY(TAB,          TAB),
+	EVDEV_KEY(Q,            Q),
+	EVDEV_KEY(W,            W),
+	EVDEV_KEY(E,            E),
+	EVDEV_KEY(R,            R),
+	EVDEV_KEY(T,            T),
+	EVDEV_KEY(Y,            Y),
+	EVDEV_KEY(U,            U),
+	EVDEV_KEY(I,            I),
+	EVDEV_KEY(O,            O),
+	EVDEV_KEY(P,            P),
+	EVDEV_KEY(LEFTBRACE,    OPENBRACE),
+	EVDEV_KEY(RIGHTBRACE,   CLOSEBRACE),
+	EVDEV_KEY(ENTER,        ENTER),
+	EVDEV_KEY(LEFTCTRL,     LCONTROL),
+	EVDEV_KEY(A,            A),
+	EVDEV_KEY(S,            S),
+	EVDEV_KEY(D,            D),
+	EVDEV_KEY(F,            F),
+	EVDEV_KEY(G,            G),
+	EVDEV_KEY(H,            H),
+	EVDEV_KEY(J,            J),
+	EVDEV_KEY(K,            K),
+	EVDEV_KEY(L,            L),
+	EVDEV_KEY(SEMICOLON,    COLON),
+	EVDEV_KEY(APOSTROPHE,   QUOTE),
+	EVDEV_KEY(GRAVE,        TILDE),
+	EVDEV_KEY(LEFTSHIFT,    LSHIFT),
+	EVDEV_KEY(BACKSLASH,    BACKSLASH),
+	EVDEV_KEY(Z,            Z),
+	EVDEV_KEY(X,            X),
+	EVDEV_KEY(C,            C),
+	EVDEV_KEY(V,            V),
+	EVDEV_KEY(B,            B),
+	EVDEV_KEY(N,            N),
+	EVDEV_KEY(M,            M),
+	EVDEV_KEY(COMMA,        COMMA),
+	EVDEV_KEY(DOT,          STOP),
+	EVDEV_KEY(SLASH,        SLASH),
+	EVDEV_KEY(RIGHTSHIFT,   RSHIFT),
+	EVDEV_KEY(KPASTERISK,   ASTERISK),
+	EVDEV_KEY(LEFTALT,      LALT),
+	EVDEV_KEY(SPACE,        SPACE),
+	EVDEV_KEY(CAPSLOCK,     CAPSLOCK),
+	EVDEV_KEY(F1,           F1),
+	EVDEV_KEY(F2,           F2),
+	EVDEV_KEY(F3,           F3),
+	EVDEV_KEY(F4,           F4),
+	EVDEV_KEY(F5,           F5),
+	EVDEV_KEY(F6,           F6),
+	EVDEV_KEY(F7,           F7),
+	EVDEV_KEY(F8,           F8),
+	EVDEV_KEY(F9,           F9),
+	EVDEV_KEY(F10,          F10),
+	EVDEV_KEY(NUMLOCK,      NUMLOCK),
+	EVDEV_KEY(SCROLLLOCK,   SCRLOCK),
+	EVDEV_KEY(KP7,          7_PAD),
+	EVDEV_KEY(KP8,          8_PAD),
+	EVDEV_KEY(KP9,          9_PAD),
+	EVDEV_KEY(KPMINUS,      MINUS_PAD),
+	EVDEV_KEY(KP4,          4_PAD),
+	EVDEV_KEY(KP5,          5_PAD),
+	EVDEV_KEY(KP6,          6_PAD),
+	EVDEV_KEY(KPPLUS,       PLUS_PAD),
+	EVDEV_KEY(KP1,          1_PAD),
+	EVDEV_KEY(KP2,          2_PAD),
+	EVDEV_KEY(KP3,          3_PAD),
+	EVDEV_KEY(KP0,          0_PAD),
+	EVDEV_KEY(KPDOT,        DEL_PAD),
+	EVDEV_KEY(102ND,        BACKSLASH2),
+	EVDEV_KEY(F11,          F11),
+	EVDEV_KEY(F12,          F12),
+	EVDEV_KEY(KPENTER,      ENTER_PAD),
+	EVDEV_KEY(RIGHTCTRL,    RCONTROL),
+	EVDEV_KEY(KPSLASH,      SLASH_PAD),
+	EVDEV_KEY(SYSRQ,        PRTSCR),
+	EVDEV_KEY(RIGHTALT,     RALT),
+	EVDEV_KEY(HOME,         HOME),
+	EVDEV_KEY(UP,           UP),
+	EVDEV_KEY(PAGEUP,       PGUP),
+	EVDEV_KEY(LEFT,         LEFT),
+	EVDEV_KEY(RIGHT,        RIGHT),
+	EVDEV_KEY(END,          END),
+	EVDEV_KEY(DOWN,         DOWN),
+	EVDEV_KEY(PAGEDOWN,     PGDN),
+	EVDEV_KEY(INSERT,       INSERT),
+	EVDEV_KEY(DELETE,       DEL),
+	EVDEV_KEY(KPEQUAL,      EQUALS_PAD),
+	EVDEV_KEY(PAUSE,        PAUSE),
+	EVDEV_KEY(KPCOMMA,      COMMA_PAD),
+	EVDEV_KEY(LEFTMETA,     LWIN),
+	EVDEV_KEY(RIGHTMETA,    RWIN),
+	EVDEV_KEY(COMPOSE,      MENU),
+	EVDEV_KEY(CANCEL,       CANCEL),
+	EVDEV_KEY(F13,          F13),
+	EVDEV_KEY(F14,          F14),
+	EVDEV_KEY(F15,          F15),
+	EVDEV_KEY(F16,          F16),
+	EVDEV_KEY(F17,          F17),
+	EVDEV_KEY(F18,          F18),
+	EVDEV_KEY(F19,          F19),
+	EVDEV_KEY(F20,          F20)
+};
+
+#undef EVDEV_KEY
+
+class evdev_keyboard_device : public evdev_device
+{
+public:
+	evdev_keyboard_device(
+			std::string &&name,
+			std::string &&id,
+			input_module &module,
+			int fd,
+			evdev_capabilities const &caps) :
+		evdev_device(std::move(name), std::move(id), module, fd),
+		m_state(),
+		m_pending()
+	{
+		std::fill(std::begin(m_key_index), std::end(m_key_index), -1);
+		for (int key = 0; key < std::size(evdev_key_table); key++)
+		{
+			if (test_bit(caps.keys, evdev_key_table[key].code))
+				m_key_index[evdev_key_table[key].code] = key;
+		}
+
+		resync();
+	}
+
+	virtual void poll(bool relative_reset) override
+	{
+		m_state = m_exchange.latest();
+	}
+
+	virtual void reset() override
+	{
+		m_state = keyboard_state();
+	}
+
+	virtual void configure(input_device &device) override
+	{
+		// only add keys the keyboard has
+		for (int key = 0; key < std::size(evdev_key_table); key++)
+		{
+			if (0 <= m_key_index[evdev_key_table[key].code])
+			{
+				device.add_item(
+						evdev_key_table[key].name,
+						std::string_view(),
+						evdev_key_table[key].mame_key,
+						generic_button_get_state<s32>,
+						&m_state.keys[key]);
+			}
+		}
+	}
+
+protected:
+	virtual void process_event(input_event const &event) override
+	{
+		// autorepeat (value 2) leaves the key down
+		if ((event.type == EV_KEY) && (event.code < KEY_CNT) && (0 <= m_key_index[event.code]))
+			m_pending.keys[m_key_index[event.code]] = event.value ? 0x80 : 0;
+	}
+
+	virtual void report() override
+	{
+		m_exchange.publish(m_pending);
+	}
+
+	virtual void resync() override
+	{
+		key_bits keys = { 0 };
+		if (!::ioctl(fd(), EVIOCGKEY(sizeof(keys)), keys))
+		{
+			for (int key = 0; key < std::size(evdev_key_table); key++)
+				m_pending.keys[key] = test_bit(keys, evdev_key_table[key].code) ? 0x80 : 0;
+		}
+		m_exchange.publish(m_pending);
+	}
+
+	virtual void release() override
+	{
+		m_pending = keyboard_state();
+		m_exchange.publish(m_pending);
+	}
+
+private:
+	struct keyboard_state
+	{
+		s32 keys[std::size(evdev_key_table)];
+	};
+
+	int                                     m_key_index[KEY_CNT];
+
+	keyboard_state                          m_state;    // state seen by the input manager
+	keyboard_state                          m_pending;  // state being built by the input thread
+	evdev_state_exchange<keyboard_state>    m_exchange;
+};
+
+
+//============================================================
+//  evdev_mouse_device
+//============================================================
+
+class evdev_mouse_device : public evdev_device
+{
+public:
+	evdev_mouse_device(
+			std::string &&name,
+			std::string &&id,
+			input_module &module,
+			int fd,
+			evdev_capabilities const &caps) :
+		evdev_device(std::move(name), std::move(id), module, fd),
+		m_buttons(0),
+		m_mouse(),
+		m_pending(),
+		m_last()
+	{
+		while ((m_buttons < EVDEV_MOUSE_BUTTONS) && test_bit(caps.keys, BTN_LEFT + m_buttons))
+			m_buttons++;
+
+		resync();
+	}
+
+	virtual void poll(bool relative_reset) override
+	{
+		mouse_state const &state = m_exchange.latest();
+		std::copy(std::begin(state.buttons), std::end(state.buttons), std::begin(m_mouse.buttons));
+
+		// motion is counted by the input thread; take what's accumulated since the last reset
+		if (relative_reset)
+		{
+			for (int axis = 0; axis < 4; axis++)
+			{
+				m_mouse.axes[axis] = s32(state.counts[axis] - m_last[axis]) * input_device::RELATIVE_PER_PIXEL;
+				m_last[axis] = state.counts[axis];
+			}
+		}
+	}
+
+	virtual void reset() override
+	{
+		// discard motion that hasn't been taken yet as well
+		mouse_state const &state = m_exchange.latest();
+		std::copy(std::begin(state.counts), std::end(state.counts), std::begin(m_last));
+		m_mouse = mouse_axes();
+	}
+
+	virtual void configure(input_device &device) override
+	{
+		// add the axes
+		static char const *const axis_names[4] = { "X", "Y", "Scroll V", "Scroll H" };
+		static input_item_id const axis_ids[4] = { ITEM_ID_XAXIS, ITEM_ID_YAXIS, ITEM_ID_ZAXIS, ITEM_ID_RZAXIS };
+		for (int axis = 0; axis < 4; axis++)
+		{
+			device.add_item(
+					axis_names[axis],
+					std::string_view(),
+					axis_ids[axis],
+					generic_axis_get_state<s32>,
+					&m_mouse.axes[axis]);
+		}
+
+		// add the buttons; the kernel orders them left, right, middle like MAME does
+		for (int button = 0; button < m_buttons; button++)
+		{
+			device.add_item(
+					default_button_name(button),
+					std::string_view(),
+					input_item_id(ITEM_ID_BUTTON1 + button),
+					generic_button_get_state<s32>,
+					&m_mouse.buttons[button]);
+		}
+	}
+
+protected:
+	virtual void process_event(input_event const &event) override
+	{
+		switch (event.type)
+		{
+		case EV_REL:
+			switch (event.code)
+			{
+			case REL_X:         m_pending.counts[0] += event.value; break;
+			case REL_Y:         m_pending.counts[1] += event.value; break;
+			case REL_WHEEL:     m_pending.counts[2] += event.value; break;
+			case REL_HWHEEL:    m_pending.counts[3] += event.value; break;
+			}
+			break;
+
+		case EV_KEY:
+			if ((event.code >= BTN_LEFT) && (event.code < (BTN_LEFT + m_buttons)))
+				m_pending.buttons[event.code - BTN_LEFT] = event.value ? 0x80 : 0;
+			break;
+		}
+	}
+
+	virtual void report() override
+	{
+		m_exchange.publish(m_pending);
+	}
+
+	virtual void resync() override
+	{
+		// motion that was dropped is lost, but the buttons can be read back
+		key_bits keys = { 0 };
+		if (!::ioctl(fd(), EVIOCGKEY(sizeof(keys)), keys))
+		{
+			for (int button = 0; button < m_buttons; button++)
+				m_pending.buttons[button] = test_bit(keys, BTN_LEFT + button) ? 0x80 : 0;
+		}
+		m_exchange.publish(m_pending);
+	}
+
+	virtual void release() override
+	{
+		// leave the motion counts alone so poll doesn't see a jump
+		std::fill(std::begin(m_pending.buttons), std::end(m_pending.buttons), 0);
+		m_exchange.publish(m_pending);
+	}
+
+private:
+	// state handed over by the input thread; motion counts wrap freely
+	struct mouse_state
+	{
+		u32 counts[4];                                  // X, Y, vertical wheel, horizontal wheel
+		s32 buttons[EVDEV_MOUSE_BUTTONS];
+	};
+
+	// state seen by the input manager
+	struct mouse_axes
+	{
+		s32 axes[4];
+		s32 buttons[EVDEV_MOUSE_BUTTONS];
+	};
+
+	int                                 m_buttons;
+
+	mouse_axes                          m_mouse;
+	mouse_state                         m_pending;      // state being built by the input thread
+	evdev_state_exchange<mouse_state>   m_exchange;
+	u32                                 m_last[4];      // motion counts at the last reset
+};
+
+
+//============================================================
+//  evdev_joystick_device
+//============================================================
+
+class evdev_joystick_device : public evdev_device, protected joystick_assignment_helper
+{
+public:
+	evdev_joystick_device(
+			std::string &&name,
+			std::string &&id,
+			input_module &module,
+			int fd,
+			evdev_capabilities const &caps) :
+		evdev_device(std::move(name), std::move(id), module, fd),
+		m_state(),
+		m_pending()
+	{
+		std::fill(std::begin(m_key_index), std::end(m_key_index), -1);
+		std::fill(std::begin(m_abs_index), std::end(m_abs_index), -1);
+
+		// joystick buttons first, then miscellaneous buttons, in code order like other evdev users
+		for (unsigned code = BTN_JOYSTICK; (code < KEY_CNT) && (m_buttons.size() < MAX_BUTTONS); code++)
+			add_button(caps.keys, code);
+		for (unsigned code = BTN_MISC; (code < BTN_MOUSE) && (m_buttons.size() < MAX_BUTTONS); code++)
+			add_button(caps.keys, code);
+
+		// hats
+		for (int hat = 0; hat < EVDEV_HATS; hat++)
+		{
+			if (test_bit(caps.axes, ABS_HAT0X + (2 * hat)) || test_bit(caps.axes, ABS_HAT0Y + (2 * hat)))
+				m_hats.emplace_back(hat);
+		}
+
+		// everything else below the multi-touch axes is an ordinary axis
+		for (unsigned code = ABS_X; (code < ABS_MT_SLOT) && (m_axes.size() < MAX_AXES); code++)
+		{
+			if (((code < ABS_HAT0X) || (code > ABS_HAT3Y)) && test_bit(caps.axes, code))
+			{
+				input_absinfo info;
+				if (!::ioctl(fd, EVIOCGABS(code), &info))
+				{
+					m_abs_index[code] = m_axes.size();
+					m_axes.emplace_back(axis_info{ code, info.minimum, info.maximum });
+				}
+			}
+		}
+
+		resync();
+	}
+
+	virtual void poll(bool relative_reset) override
+	{
+		m_state = m_exchange.latest();
+	}
+
+	virtual void reset() override
+	{
+		m_state = joystick_state();
+	}
+
+	virtual void configure(input_device &device) override
+	{
+		input_device::assignment_vector assignments;
+		char tempname[32];
+
+		// loop over all axes
+		input_item_id axisactual[MAX_AXES];
+		for (int axis = 0; axis < m_axes.size(); axis++)
+		{
+			input_item_id itemid;
+			if (axis < INPUT_MAX_AXIS)
+				itemid = input_item_id(ITEM_ID_XAXIS + axis);
+			else if (axis < (INPUT_MAX_AXIS + INPUT_MAX_ADD_ABSOLUTE))
+				itemid = input_item_id(ITEM_ID_ADD_ABSOLUTE1 + axis - INPUT_MAX_AXIS);
+			else
+				itemid = ITEM_ID_OTHER_AXIS_ABSOLUTE;
+
+			snprintf(tempname, sizeof(tempname), "A%d", axis + 1);
+			axisactual[axis] = device.add_item(
+					tempname,
+					std::string_view(),
+					itemid,
+					generic_axis_get_state<s32>,
+					&m_state.axes[axis]);
+		}
+
+		// loop over all buttons
+		for (int button = 0; button < m_buttons.size(); button++)
+		{
+			input_item_id itemid;
+			if (button < INPUT_MAX_BUTTONS)
+				itemid = input_item_id(ITEM_ID_BUTTON1 + button);
+			else if (button < INPUT_MAX_BUTTONS + INPUT_MAX_ADD_SWITCH)
+				itemid = input_item_id(ITEM_ID_ADD_SWITCH1 + button - INPUT_MAX_BUTTONS);
+			else
+				itemid = ITEM_ID_OTHER_SWITCH;
+
+			input_item_id const actual = device.add_item(
+					default_button_name(button),
+					std::string_view(),
+					itemid,
+					generic_button_get_state<s32>,
+					&m_state.buttons[button]);
+
+			// there are sixteen action button types
+			if (button < 16)
+			{
+				input_seq const seq(make_code(ITEM_CLASS_SWITCH, ITEM_MODIFIER_NONE, actual));
+				assignments.emplace_back(ioport_type(IPT_BUTTON1 + button), SEQ_TYPE_STANDARD, seq);
+
+				// assign the first few buttons to UI actions
+				switch (button)
+				{
+				case 0:
+					assignments.emplace_back(IPT_UI_SELECT, SEQ_TYPE_STANDARD, seq);
+					break;
+				case 1:
+					assignments.emplace_back((3 > m_buttons.size()) ? IPT_UI_CLEAR : IPT_UI_BACK, SEQ_TYPE_STANDARD, seq);
+					break;
+				case 2:
+					assignments.emplace_back(IPT_UI_CLEAR, SEQ_TYPE_STANDARD, seq);
+					break;
+				case 3:
+					assignments.emplace_back(IPT_UI_HELP, SEQ_TYPE_STANDARD, seq);
+					break;
+				}
+			}
+		}
+
+		// loop over all hats
+		static char const *const hatdirs[4] = { "Up", "Down", "Left", "Right" };
+		input_item_id hatactual[MAX_HATS][4];
+		for (int hat = 0; hat < m_hats.size(); hat++)
+		{
+			for (int dir = 0; dir < 4; dir++)
+			{
+				snprintf(tempname, sizeof(tempname), "Hat %d %s", hat + 1, hatdirs[dir]);
+				hatactual[hat][dir] = device.add_item(
+						tempname,
+						std::string_view(),
+						input_item_id((hat < INPUT_MAX_HATS) ? (ITEM_ID_HAT1UP + (4 * hat) + dir) : ITEM_ID_OTHER_SWITCH),
+						generic_button_get_state<s32>,
+						&m_state.hats[hat][dir]);
+			}
+		}
+
+		// set up default assignments for axes and hats
+		add_directional_assignments(
+				assignments,
+				(1 <= m_axes.size()) ? axisactual[0] : ITEM_ID_INVALID, // assume first axis is X
+				(2 <= m_axes.size()) ? axisactual[1] : ITEM_ID_INVALID, // assume second axis is Y
+				(1 <= m_hats.size()) ? hatactual[0][2] : ITEM_ID_INVALID,
+				(1 <= m_hats.size()) ? hatactual[0][3] : ITEM_ID_INVALID,
+				(1 <= m_hats.size()) ? hatactual[0][0] : ITEM_ID_INVALID,
+				(1 <= m_hats.size()) ? hatactual[0][1] : ITEM_ID_INVALID);
+
+		// set default assignments
+		device.set_default_assignments(std::move(assignments));
+	}
+
+protected:
+	virtual void process_event(input_event const &event) override
+	{
+		switch (event.type)
+		{
+		case EV_KEY:
+			if ((event.code < KEY_CNT) && (0 <= m_key_index[event.code]))
+				m_pending.buttons[m_key_index[event.code]] = event.value ? 0x80 : 0;
+			break;
+
+		case EV_ABS:
+			if ((event.code >= ABS_HAT0X) && (event.code <= ABS_HAT3Y))
+			{
+				auto const hat = std::find(m_hats.begin(), m_hats.end(), (event.code - ABS_HAT0X) / 2);
+				if (hat != m_hats.end())
+					set_hat(hat - m_hats.begin(), event.code, event.value);
+			}
+			else if ((event.code < ABS_CNT) && (0 <= m_abs_index[event.code]))
+			{
+				axis_info const &axis = m_axes[m_abs_index[event.code]];
+				m_pending.axes[m_abs_index[event.code]] = normalize_absolute_axis(event.value, axis.minimum, axis.maximum);
+			}
+			break;
+		}
+	}
+
+	virtual void report() override
+	{
+		m_exchange.publish(m_pending);
+	}
+
+	virtual void resync() override
+	{
+		key_bits keys = { 0 };
+		if (!::ioctl(fd(), EVIOCGKEY(sizeof(keys)), keys))
+		{
+			for (int button = 0; button < m_buttons.size(); button++)
+				m_pending.buttons[button] = test_bit(keys, m_buttons[button]) ? 0x80 : 0;
+		}
+
+		for (int axis = 0; axis < m_axes.size(); axis++)
+		{
+			input_absinfo info;
+			if (!::ioctl(fd(), EVIOCGABS(m_axes[axis].code), &info))
+				m_pending.axes[axis] = normalize_absolute_axis(info.value, m_axes[axis].minimum, m_axes[axis].maximum);
+		}
+
+		for (int hat = 0; hat < m_hats.size(); hat++)
+		{
+			for (unsigned code = ABS_HAT0X + (2 * m_hats[hat]); code <= ABS_HAT0Y + (2 * m_hats[hat]); code++)
+			{
+				input_absinfo info;
+				if (!::ioctl(fd(), EVIOCGABS(code), &info))
+					set_hat(hat, code, info.value);
+			}
+		}
+
+		m_exchange.publish(m_pending);
+	}
+
+	virtual void release() override
+	{
+		m_pending = joystick_state();
+		m_exchange.publish(m_pending);
+	}
+
+private:
+	struct joystick_state
+	{
+		s32 axes[MAX_AXES];
+		s32 buttons[MAX_BUTTONS];
+		s32 hats[MAX_HATS][4];                          // up, down, left, right
+	};
+
+	struct axis_info
+	{
+		unsigned code;
+		s32 minimum;
+		s32 maximum;
+	};
+
+	void add_button(key_bits const &keys, unsigned code)
+	{
+		if (test_bit(keys, code))
+		{
+			m_key_index[code] = m_buttons.size();
+			m_buttons.emplace_back(code);
+		}
+	}
+
+	void set_hat(int hat, unsigned code, s32 value)
+	{
+		if ((code - ABS_HAT0X) & 1)
+		{
+			m_pending.hats[hat][0] = (value < 0) ? 0x80 : 0;
+			m_pending.hats[hat][1] = (value > 0) ? 0x80 : 0;
+		}
+		else
+		{
+			m_pending.hats[hat][2] = (value < 0) ? 0x80 : 0;
+			m_pending.hats[hat][3] = (value > 0) ? 0x80 : 0;
+		}
+	}
+
+	std::vector<axis_info>                  m_axes;
+	std::vector<unsigned>                   m_buttons;
+	std::vector<int>                        m_hats;
+	int                                     m_key_index[KEY_CNT];
+	int                                     m_abs_index[ABS_CNT];
+
+	joystick_state                          m_state;    // state seen by the input manager
+	joystick_state                          m_pending;  // state being built by the input thread
+	evdev_state_exchange<joystick_state>    m_exchange;
+};
+
+
+//============================================================
+//  evdev_module - finds devices and runs the input thread
+//============================================================
+
+template <typename Info>
+class evdev_module : public input_module_impl<Info, osd_common_t>
+{
+public:
+	virtual void exit() override
+	{
+		if (m_thread.joinable())
+		{
+			uint64_t const value = 1;
+			if (::write(m_wakeup, &value, sizeof(value)) < 0)
+				osd_printf_error("evdev: failed to stop input thread (%s)\n", std::strerror(errno));
+			m_thread.join();
+		}
+		for (int *fd : { &m_wakeup, &m_inotify, &m_epoll })
+		{
+			if (0 <= *fd)
+				::close(*fd);
+			*fd = -1;
+		}
+
+		input_module_impl<Info, osd_common_t>::exit();
+	}
+
+	virtual void input_init(running_machine &machine) override
+	{
+		input_module_impl<Info, osd_common_t>::input_init(machine);
+
+		// event devices are numbered in the order the kernel found them
+		std::vector<std::string> paths;
+		DIR *const dir = ::opendir("/dev/input");
+		if (dir)
+		{
+			while (dirent const *const entry = ::readdir(dir))
+			{
+				if (!std::strncmp(entry->d_name, "event", 5))
+					paths.emplace_back(entry->d_name);
+			}
+			::closedir(dir);
+		}
+		std::sort(
+				paths.begin(),
+				paths.end(),
+				[] (std::string const &a, std::string const &b) { return std::make_pair(a.length(), a) < std::make_pair(b.length(), b); });
+
+		for (std::string const &path : paths)
+			open_device("/dev/input/" + path);
+
+		if (this->devicelist().empty())
+		{
+			osd_printf_verbose("evdev: no %s devices found\n", m_kind);
+			return;
+		}
+
+		// watch for devices reappearing; udev may only make them readable after creating them
+		m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+		m_wakeup = ::eventfd(0, EFD_CLOEXEC);
+		m_inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if ((0 > m_epoll) || (0 > m_wakeup))
+		{
+			osd_printf_error("evdev: failed to set up input thread (%s)\n", std::strerror(errno));
+			return;
+		}
+		if ((0 > m_inotify) || (0 > ::inotify_add_watch(m_inotify, "/dev/input", IN_CREATE | IN_ATTRIB)))
+			osd_printf_verbose("evdev: can't watch /dev/input, %s devices won't be reconnected (%s)\n", m_kind, std::strerror(errno));
+		else
+			watch(m_inotify, &m_inotify);
+		watch(m_wakeup, nullptr);
+		this->devicelist().for_each_device([this] (Info &device) { watch(device.fd(), &device); });
+
+		m_thread = std::thread([this] () { thread_main(); });
+	}
+
+protected:
+	evdev_module(char const *type, input_device_class deviceclass, char const *kind) :
+		input_module_impl<Info, osd_common_t>(type, "evdev"),
+		m_deviceclass(deviceclass),
+		m_kind(kind),
+		m_epoll(-1),
+		m_wakeup(-1),
+		m_inotify(-1)
+	{
+	}
+
+	virtual bool accept(evdev_capabilities const &caps) const = 0;
+
+private:
+	void watch(int fd, void *ptr)
+	{
+		epoll_event event;
+		std::memset(&event, 0, sizeof(event));
+		event.events = EPOLLIN;
+		event.data.ptr = ptr;
+		if (0 > ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event))
+			osd_printf_error("evdev: failed to watch %s device (%s)\n", m_kind, std::strerror(errno));
+	}
+
+	void open_device(std::string const &path)
+	{
+		int const fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+		if (0 > fd)
+		{
+			osd_printf_verbose("evdev: can't open %s (%s)\n", path, std::strerror(errno));
+			return;
+		}
+
+		evdev_capabilities caps;
+		std::memset(&caps, 0, sizeof(caps));
+		::ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(caps.keys)), caps.keys);
+		::ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(caps.axes)), caps.axes);
+		::ioctl(fd, EVIOCGBIT(EV_REL, sizeof(caps.rel)), caps.rel);
+		if (!accept(caps))
+		{
+			::close(fd);
+			return;
+		}
+
+		char name[256] = { 0 };
+		::ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name);
+		std::string id = evdev_device_id(fd);
+		osd_printf_verbose("evdev: %s %s [ID %s] at %s\n", m_kind, name, id, path);
+		this->template create_device<Info>(m_deviceclass, std::string(name[0] ? name : path.c_str()), std::move(id), fd, caps);
+	}
+
+	// called on the input thread
+	void reconnect(std::string const &path)
+	{
+		int const fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+		if (0 > fd)
+			return;
+
+		std::string const id = evdev_device_id(fd);
+		for (auto const &device : this->devicelist())
+		{
+			if ((0 > device->fd()) && (device->id() == id))
+			{
+				osd_printf_verbose("evdev: %s [ID %s] reconnected\n", device->name(), device->id());
+				device->attach(fd);
+				watch(fd, device.get());
+				return;
+			}
+		}
+		::close(fd);
+	}
+
+	void thread_main()
+	{
+		osd_thread_set_role(osd_thread_role::IO);
+
+		while (true)
+		{
+			epoll_event events[16];
+			int const count = ::epoll_wait(m_epoll, events, std::size(events), -1);
+			if (0 > count)
+			{
+				if (errno == EINTR)
+					continue;
+				osd_printf_error("evdev: %s input thread stopped (%s)\n", m_kind, std::strerror(errno));
+				return;
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				void *const ptr = events[i].data.ptr;
+				if (!ptr)
+				{
+					return;
+				}
+				else if (ptr == &m_inotify)
+				{
+					read_notifications();
+				}
+				else
+				{
+					Info &device = *reinterpret_cast<Info *>(ptr);
+					if ((0 <= device.fd()) && !device.read_events())
+					{
+						osd_printf_verbose("evdev: %s [ID %s] disconnected\n", device.name(), device.id());
+						::epoll_ctl(m_epoll, EPOLL_CTL_DEL, device.fd(), nullptr);
+						device.detach();
+					}
+				}
+			}
+		}
+	}
+
+	void read_notifications()
+	{
+		alignas(inotify_event) char buffer[4096];
+		while (true)
+		{
+			ssize_t const bytes = ::read(m_inotify, buffer, sizeof(buffer));
+			if (0 >= bytes)
+				return;
+
+			for (ssize_t offset = 0; offset < bytes; )
+			{
+				inotify_event const &event = *reinterpret_cast<inotify_event const *>(&buffer[offset]);
+				if (event.len && !std::strncmp(event.name, "event", 5))
+					reconnect(std::string("/dev/input/") + event.name);
+				offset += sizeof(inotify_event) + event.len;
+			}
+		}
+	}
+
+	input_device_class const m_deviceclass;
+	char const *const m_kind;
+
+	std::thread m_thread;
+	int m_epoll;
+	int m_wakeup;
+	int m_inotify;
+};
+
+
+//============================================================
+//  evdev_keyboard_module
+//============================================================
+
+class evdev_keyboard_module : public evdev_module<evdev_keyboard_device>
+{
+public:
+	evdev_keyboard_module() : evdev_module<evdev_keyboard_device>(OSD_KEYBOARDINPUT_PROVIDER, DEVICE_CLASS_KEYBOARD, "keyboard") { }
+
+protected:
+	virtual bool accept(evdev_capabilities const &caps) const override
+	{
+		// anything with the letter keys, including arcade encoders that pretend to be keyboards
+		return test_bits(caps.keys, KEY_Q, KEY_P) && test_bits(caps.keys, KEY_A, KEY_L) && test_bits(caps.keys, KEY_Z, KEY_M);
+	}
+};
+
+
+//============================================================
+//  evdev_mouse_module
+//============================================================
+
+class evdev_mouse_module : public evdev_module<evdev_mouse_device>
+{
+public:
+	evdev_mouse_module() : evdev_module<evdev_mouse_device>(OSD_MOUSEINPUT_PROVIDER, DEVICE_CLASS_MOUSE, "mouse") { }
+
+protected:
+	virtual bool accept(evdev_capabilities const &caps) const override
+	{
+		return test_bit(caps.rel, REL_X) && test_bit(caps.rel, REL_Y) && test_bit(caps.keys, BTN_LEFT);
+	}
+};
+
+
+//============================================================
+//  evdev_joystick_module
+//============================================================
+
+class evdev_joystick_module : public evdev_module<evdev_joystick_device>
+{
+public:
+	evdev_joystick_module() : evdev_module<evdev_joystick_device>(OSD_JOYSTICKINPUT_PROVIDER, DEVICE_CLASS_JOYSTICK, "joystick") { }
+
+protected:
+	virtual bool accept(evdev_capabilities const &caps) const override
+	{
+		// only take devices with joystick or gamepad buttons
+		for (unsigned code = BTN_JOYSTICK; code < BTN_DIGI; code++)
+		{
+			if (test_bit(caps.keys, code))
+				return true;
+		}
+		for (unsigned code = BTN_TRIGGER_HAPPY; code < KEY_CNT; code++)
+		{
+			if (test_bit(caps.keys, code))
+				return true;
+		}
+		return false;
+	}
+};
+
+} // anonymous namespace
+
+} // namespace osd
+
+
+#else // defined(__linux__) && !defined(__ANDROID__)
+
+namespace osd {
+
+namespace {
+
+MODULE_NOT_SUPPORTED(evdev_keyboard_module, OSD_KEYBOARDINPUT_PROVIDER, "evdev")
+MODULE_NOT_SUPPORTED(evdev_mouse_module, OSD_MOUSEINPUT_PROVIDER, "evdev")
+MODULE_NOT_SUPPORTED(evdev_joystick_module, OSD_JOYSTICKINPUT_PROVIDER, "evdev")
+
+} // anonymous namespace
+
+} // namespace osd
+
+#endif // defined(__linux__) && !defined(__ANDROID__)
+
+
+MODULE_DEFINITION(KEYBOARDINPUT_EVDEV, osd::evdev_keyboard_module)
+MODULE_DEFINITION(MOUSEINPUT_EVDEV, osd::evdev_mouse_module)
+MODULE_DEFINITION(JOYSTICKINPUT_EVDEV, osd::evdev_joystick_module)
@@ -81,6 +81,10 @@ namespace osd {
 
 bool invalidate_instruction_cache(void const *start, std::size_t size) noexcept;
 
+// ask for the whole huge pages inside a range to be backed by huge pages;
+// returns false if the host doesn't support it or the range is too small
+bool advise_huge_pages(void *start, std::size_t size) noexcept;
+
 
 class virtual_memory_allocation
 {
@@ -291,6 +291,13 @@ bool invalidate_instruction_cache(void const *start, std::size_t size) noexcept
 }
 
 
+bool advise_huge_pages(void *start, std::size_t size) noexcept
+{
+	// superpages can only be requested when mapping memory, not after the fact
+	return false;
+}
+
+
 void *virtual_memory_allocation::do_alloc(std::initializer_list<std::size_t> blocks, unsigned intent, std::size_t &size, std::size_t &page_size) noexcept
 {
 	long const p(sysconf(_SC_PAGE_SIZE));
@@ -210,6 +210,25 @@ bool invalidate_instruction_cache(void const *start, std::size_t size) noexcept
 }
 
 
+bool advise_huge_pages(void *start, std::size_t size) noexcept
+{
+#if defined(MADV_HUGEPAGE)
+	// transparent huge pages come in 2 MiB units on the hosts that have them
+	constexpr std::uintptr_t huge(2U * 1024U * 1024U);
+	long const p(sysconf(_SC_PAGE_SIZE));
+	if (0 >= p)
+		return false;
+	std::uintptr_t const begin((reinterpret_cast<std::uintptr_t>(start) + p - 1) & ~std::uintptr_t(p - 1));
+	std::uintptr_t const end((reinterpret_cast<std::uintptr_t>(start) + size) & ~std::uintptr_t(p - 1));
+	if ((end <= begin) || ((end - begin) < huge))
+		return false;
+	return !madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+#else
+	return false;
+#endif
+}
+
+
 void *virtual_memory_allocation::do_alloc(std::initializer_list<std::size_t> blocks, unsigned intent, std::size_t &size, std::size_t &page_size) noexcept
 {
 	long const p(sysconf(_SC_PAGE_SIZE));
@@ -330,6 +330,13 @@ bool invalidate_instruction_cache(void const *start, std::size_t size) noexcept
 }
 
 
+bool advise_huge_pages(void *start, std::size_t size) noexcept
+{
+	// large pages need SeLockMemoryPrivilege and must be requested at allocation time
+	return false;
+}
+
+
 void *virtual_memory_allocation::do_alloc(std::initializer_list<std::size_t> blocks, unsigned intent, std::size_t &size, std::size_t &page_size) noexcept
 {
 	SYSTEM_INFO info;
@@ -66,6 +66,8 @@ const options_entry osd_options::s_option_entries[] =
 	{ nullptr,                                   nullptr,          core_options::option_type::HEADER,    "OSD PERFORMANCE OPTIONS" },
 	{ OSDOPTION_NUMPROCESSORS ";np",             OSDOPTVAL_AUTO,   core_options::option_type::STRING,    "number of processors; this overrides the number the system reports" },
 	{ OSDOPTION_BENCH,                           "0",              core_options::option_type::INTEGER,   "benchmark for the given number of emulated seconds; implies -video none -sound none -nothrottle" },
+	{ OSDOPTION_THREAD_AFFINITY,                 OSDOPTVAL_AUTO,   core_options::option_type::STRING,    "processors for emulation, audio, work and io threads, as role=auto|any|performance|node|list separated by semicolons" },
+	{ OSDOPTION_THREAD_PRIORITY,                 "",               core_options::option_type::STRING,    "priorities for emulation, audio, work and io threads, as role=priority separated by semicolons" },
 
 	{ nullptr,                                   nullptr,          core_options::option_type::HEADER,    "OSD VIDEO OPTIONS" },
 	{ OSDOPTION_VIDEO,                           OSDOPTVAL_AUTO,   core_options::option_type::STRING,    "video output method: " },
@@ -74,6 +76,7 @@ const options_entry osd_options::s_option_entries[] =
 	{ OSDOPTION_MAXIMIZE ";max",                 "1",              core_options::option_type::BOOLEAN,   "default to maximized windows" },
 	{ OSDOPTION_WAITVSYNC ";vs",                 "0",              core_options::option_type::BOOLEAN,   "enable waiting for the start of VBLANK before flipping screens (reduces tearing effects)" },
 	{ OSDOPTION_SYNCREFRESH ";srf",              "0",              core_options::option_type::BOOLEAN,   "enable using the start of VBLANK for throttling instead of the game time" },
+	{ OSDOPTION_RENDER_THREAD,                   "0",              core_options::option_type::BOOLEAN,   "draw on a separate thread while emulation continues, one frame behind; OpenGL only" },
 	{ OSD_MONITOR_PROVIDER,                      OSDOPTVAL_AUTO,   core_options::option_type::STRING,    "monitor discovery method: " },
 
 	// per-window options
@@ -289,6 +292,7 @@ void osd_common_t::register_options()
 
 	REGISTER_MODULE(m_mod_man, NETDEV_TAPTUN);
 	REGISTER_MODULE(m_mod_man, NETDEV_PCAP);
+	REGISTER_MODULE(m_mod_man, NETDEV_SHMEM);
 	REGISTER_MODULE(m_mod_man, NETDEV_NONE);
 
 #ifndef NO_USE_MIDI
@@ -300,12 +304,14 @@ void osd_common_t::register_options()
 	REGISTER_MODULE(m_mod_man, KEYBOARDINPUT_RAWINPUT);
 	REGISTER_MODULE(m_mod_man, KEYBOARDINPUT_DINPUT);
 	REGISTER_MODULE(m_mod_man, KEYBOARDINPUT_WIN32);
+	REGISTER_MODULE(m_mod_man, KEYBOARDINPUT_EVDEV);
 	REGISTER_MODULE(m_mod_man, KEYBOARD_NONE);
 
 	REGISTER_MODULE(m_mod_man, MOUSEINPUT_SDL);
 	REGISTER_MODULE(m_mod_man, MOUSEINPUT_RAWINPUT);
 	REGISTER_MODULE(m_mod_man, MOUSEINPUT_DINPUT);
 	REGISTER_MODULE(m_mod_man, MOUSEINPUT_WIN32);
+	REGISTER_MODULE(m_mod_man, MOUSEINPUT_EVDEV);
 	REGISTER_MODULE(m_mod_man, MOUSE_NONE);
 
 	REGISTER_MODULE(m_mod_man, LIGHTGUN_X11);
@@ -318,6 +324,7 @@ void osd_common_t::register_options()
 	REGISTER_MODULE(m_mod_man, JOYSTICKINPUT_WINHYBRID);
 	REGISTER_MODULE(m_mod_man, JOYSTICKINPUT_DINPUT);
 	REGISTER_MODULE(m_mod_man, JOYSTICKINPUT_XINPUT);
+	REGISTER_MODULE(m_mod_man, JOYSTICKINPUT_EVDEV);
 	REGISTER_MODULE(m_mod_man, JOYSTICK_NONE);
 
 	REGISTER_MODULE(m_mod_man, OUTPUT_NONE);
@@ -431,6 +438,21 @@ void osd_common_t::init(running_machine &machine)
 	if (options.verbose())
 		set_verbose(true);
 
+	// headless runs use the "none" modules throughout and never wait for real time
+	if (options.headless())
+	{
+		options.set_value(OPTION_SLEEP, false, OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OPTION_THROTTLE, false, OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OPTION_LATEINPUT, 0, OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OSDOPTION_VIDEO, "none", OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OSDOPTION_SOUND, "none", OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OSD_KEYBOARDINPUT_PROVIDER, "none", OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OSD_MOUSEINPUT_PROVIDER, "none", OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OSD_LIGHTGUNINPUT_PROVIDER, "none", OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OSD_JOYSTICKINPUT_PROVIDER, "none", OPTION_PRIORITY_MAXIMUM);
+		options.set_value(OSD_OUTPUT_PROVIDER, "none", OPTION_PRIORITY_MAXIMUM);
+	}
+
 	// ensure we get called on the way out
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&osd_common_t::osd_exit, this));
 
@@ -522,6 +544,18 @@ void osd_common_t::update_audio_stream(const int16_t *buffer, int samples_this_f
 }
 
 
+//-------------------------------------------------
+//  sound_buffer_fill - return the OSD sound buffer
+//  level relative to its target (1.0 = on target),
+//  or a negative value if the module can't tell
+//-------------------------------------------------
+
+float osd_common_t::sound_buffer_fill()
+{
+	return (m_sound != nullptr) ? m_sound->buffer_fill() : -1.0f;
+}
+
+
 //-------------------------------------------------
 //  set_mastervolume - set the system volume
 //-------------------------------------------------
@@ -610,13 +644,25 @@ bool osd_common_t::execute_command(const char *command)
 
 }
 
-static void output_notifier_callback(const char *outname, int32_t value, void *param)
+static void output_notifier_callback(void *param)
 {
-	static_cast<osd_common_t*>(param)->notify(outname, value);
+	static_cast<osd_common_t*>(param)->notify_changed_outputs();
+}
+
+void osd_common_t::notify_changed_outputs()
+{
+	// hand the module everything that changed this frame in one batch
+	m_output->begin_batch();
+	machine().output().notify_changed([this] (const char *outname, int32_t value) { m_output->notify(outname, value); });
+	m_output->end_batch();
 }
 
 void osd_common_t::init_subsystems()
 {
+	// this is the emulation thread; threads started from here on take on their roles
+	osd_thread_configure_roles(options().thread_affinity(), options().thread_priority());
+	osd_thread_set_role(osd_thread_role::EMULATION);
+
 	// monitors have to be initialized before video init
 	m_monitor_module = &select_module_options<monitor_module>(OSD_MONITOR_PROVIDER);
 
@@ -646,7 +692,7 @@ void osd_common_t::init_subsystems()
 	m_midi = &select_module_options<midi_module>(OSD_MIDI_PROVIDER);
 
 	m_output = &select_module_options<output_module>(OSD_OUTPUT_PROVIDER);
-	machine().output().set_global_notifier(output_notifier_callback, this);
+	machine().output().set_frame_notifier(output_notifier_callback, this);
 
 	input_init();
 }
@@ -50,6 +50,8 @@
 
 #define OSDOPTION_NUMPROCESSORS         "numprocessors"
 #define OSDOPTION_BENCH                 "bench"
+#define OSDOPTION_THREAD_AFFINITY       "thread_affinity"
+#define OSDOPTION_THREAD_PRIORITY       "thread_priority"
 
 #define OSDOPTION_VIDEO                 "video"
 #define OSDOPTION_NUMSCREENS            "numscreens"
@@ -57,6 +59,7 @@
 #define OSDOPTION_MAXIMIZE              "maximize"
 #define OSDOPTION_WAITVSYNC             "waitvsync"
 #define OSDOPTION_SYNCREFRESH           "syncrefresh"
+#define OSDOPTION_RENDER_THREAD         "renderthread"
 
 #define OSDOPTION_SCREEN                "screen"
 #define OSDOPTION_ASPECT                "aspect"
@@ -127,6 +130,8 @@ public:
 	// performance options
 	const char *numprocessors() const { return value(OSDOPTION_NUMPROCESSORS); }
 	int bench() const { return int_value(OSDOPTION_BENCH); }
+	const char *thread_affinity() const { return value(OSDOPTION_THREAD_AFFINITY); }
+	const char *thread_priority() const { return value(OSDOPTION_THREAD_PRIORITY); }
 
 	// video options
 	const char *video() const { return value(OSDOPTION_VIDEO); }
@@ -135,6 +140,7 @@ public:
 	bool maximize() const { return bool_value(OSDOPTION_MAXIMIZE); }
 	bool wait_vsync() const { return bool_value(OSDOPTION_WAITVSYNC); }
 	bool sync_refresh() const { return bool_value(OSDOPTION_SYNCREFRESH); }
+	bool render_thread() const { return bool_value(OSDOPTION_RENDER_THREAD); }
 
 	// per-window options
 	const char *screen() const { return value(OSDOPTION_SCREEN); }
@@ -224,6 +230,7 @@ public:
 	virtual void update_audio_stream(const int16_t *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
 	virtual bool no_sound() override;
+	virtual float sound_buffer_fill() override;
 
 	// input overridables
 	virtual void customize_input_type_list(std::vector<input_type_entry> &typelist) override;
@@ -267,6 +274,7 @@ public:
 	virtual void set_verbose(bool print_verbose) override { m_print_verbose = print_verbose; }
 
 	void notify(const char *outname, int32_t value) const { m_output->notify(outname, value); }
+	void notify_changed_outputs();
 
 	virtual void process_events() = 0;
 	virtual bool has_focus() const = 0;
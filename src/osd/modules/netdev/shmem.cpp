@@ -0,0 +1,258 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/*
+ * shmem.cpp
+ *
+ * Shared memory network hub linking emulated network interfaces in
+ * instances running on the same host, without involving the host's
+ * network stack.
+ *
+ */
+#include "netdev_module.h"
+
+#include "modules/osdmodule.h"
+
+#if defined(USE_NETWORK) && !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include "osdcore.h" // osd_printf_verbose
+#include "osdnet.h"
+
+#include "util/hashing.h" // crc32_creator
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace osd {
+
+namespace {
+
+// Ethernet minimum frame length
+static constexpr int ETHERNET_MIN_FRAME = 64;
+
+// largest frame carried, excluding the frame check sequence
+static constexpr int FRAME_MAX = 1536;
+
+// frames held by the hub; a reader that falls further behind loses the oldest
+static constexpr unsigned SLOTS = 256;
+
+// Every instance maps the same segment.  Senders claim the next sequence
+// number from head and write the frame to its slot; a slot's sequence is
+// zero while it's being written and the frame's sequence plus one after.
+// Each reader keeps its own position, and checks the slot's sequence
+// again after copying the frame out in case it was overwritten meanwhile.
+struct hub_slot
+{
+	std::atomic<uint64_t> seq;
+	uint32_t sender;
+	uint32_t length;
+	uint8_t data[FRAME_MAX];
+};
+
+struct hub
+{
+	std::atomic<uint64_t> head;
+	hub_slot slots[SLOTS];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory hub needs lock-free 64-bit atomics");
+
+class shmem_module : public osd_module, public netdev_module
+{
+public:
+
+	shmem_module() : osd_module(OSD_NETDEV_PROVIDER, "shmem"), netdev_module()
+	{
+	}
+	virtual ~shmem_module() { }
+
+	virtual int init(osd_interface &osd, const osd_options &options) override;
+	virtual void exit() override;
+
+	virtual bool probe() override { return true; }
+};
+
+
+
+class netdev_shmem : public osd_network_device
+{
+public:
+	netdev_shmem(const char *name, class network_handler &ifdev);
+	~netdev_shmem();
+
+	int send(uint8_t *buf, int len) override;
+
+protected:
+	int recv_dev(uint8_t **buf) override;
+
+private:
+	hub *m_hub;
+	uint32_t m_id;
+	uint64_t m_next;
+	uint8_t m_buf[FRAME_MAX + 4];
+};
+
+netdev_shmem::netdev_shmem(const char *name, class network_handler &ifdev)
+	: osd_network_device(ifdev)
+	, m_hub(nullptr)
+	, m_next(0)
+{
+	static std::atomic<uint32_t> count(0);
+	m_id = (uint32_t(getpid()) << 8) | (count++ & 0xff);
+
+	char segment[64];
+	snprintf(segment, sizeof(segment), "/mame-netdev-%d", int(getuid()));
+
+	// the segment is zero-filled when first sized, which is an empty hub
+	int const fd = shm_open(segment, O_RDWR | O_CREAT, 0600);
+	if (fd == -1)
+	{
+		osd_printf_verbose("shmem: shm_open failed %d\n", errno);
+		return;
+	}
+	struct stat st;
+	if (fstat(fd, &st) == -1 || (st.st_size < off_t(sizeof(hub)) && ftruncate(fd, sizeof(hub)) == -1))
+	{
+		osd_printf_verbose("shmem: sizing %s failed %d\n", segment, errno);
+		close(fd);
+		return;
+	}
+	void *const mem = mmap(nullptr, sizeof(hub), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mem == MAP_FAILED)
+	{
+		osd_printf_verbose("shmem: mmap failed %d\n", errno);
+		return;
+	}
+
+	// only frames sent from now on are received
+	m_hub = reinterpret_cast<hub *>(mem);
+	m_next = m_hub->head.load(std::memory_order_acquire);
+	osd_printf_verbose("netdev_shmem: connected to %s\n", segment);
+}
+
+netdev_shmem::~netdev_shmem()
+{
+	if (m_hub)
+		munmap(m_hub, sizeof(hub));
+}
+
+static u32 finalise_frame(u8 buf[], u32 length)
+{
+	// pad to the Ethernet minimum less the FCS, as a real interface would
+	if (length < ETHERNET_MIN_FRAME - 4)
+	{
+		std::fill_n(&buf[length], ETHERNET_MIN_FRAME - length - 4, 0);
+
+		length = ETHERNET_MIN_FRAME - 4;
+	}
+
+	// compute and append the frame check sequence
+	const u32 fcs = util::crc32_creator::simple(buf, length);
+
+	buf[length++] = (fcs >> 0) & 0xff;
+	buf[length++] = (fcs >> 8) & 0xff;
+	buf[length++] = (fcs >> 16) & 0xff;
+	buf[length++] = (fcs >> 24) & 0xff;
+
+	return length;
+}
+
+int netdev_shmem::send(uint8_t *buf, int len)
+{
+	if (!m_hub || len <= 0 || len > FRAME_MAX)
+		return 0;
+
+	uint64_t const seq = m_hub->head.fetch_add(1, std::memory_order_acq_rel);
+	hub_slot &slot = m_hub->slots[seq % SLOTS];
+
+	slot.seq.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.sender = m_id;
+	slot.length = len;
+	memcpy(slot.data, buf, len);
+	slot.seq.store(seq + 1, std::memory_order_release);
+
+	return len;
+}
+
+int netdev_shmem::recv_dev(uint8_t **buf)
+{
+	if (!m_hub)
+		return 0;
+
+	while (true)
+	{
+		uint64_t const head = m_hub->head.load(std::memory_order_acquire);
+		if (m_next >= head)
+			return 0;
+
+		// skip frames that have already been overwritten
+		if ((head - m_next) > SLOTS)
+			m_next = head - SLOTS;
+
+		hub_slot &slot = m_hub->slots[m_next % SLOTS];
+		uint64_t const seq = slot.seq.load(std::memory_order_acquire);
+		if (seq != (m_next + 1))
+		{
+			// zero or an older frame means the sender hasn't finished writing it
+			if (seq <= m_next)
+				return 0;
+			m_next++;
+			continue;
+		}
+
+		uint32_t const sender = slot.sender;
+		uint32_t const length = std::min<uint32_t>(slot.length, FRAME_MAX);
+		memcpy(m_buf, slot.data, length);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		bool const overwritten = slot.seq.load(std::memory_order_relaxed) != seq;
+		m_next++;
+
+		// drop torn frames, our own frames, and unicast frames for other interfaces
+		if (overwritten || (sender == m_id) || (length < 6))
+			continue;
+		if (memcmp(&get_mac()[0], m_buf, 6) && !get_promisc() && !(m_buf[0] & 1))
+			continue;
+
+		*buf = m_buf;
+		return finalise_frame(m_buf, length);
+	}
+}
+
+static CREATE_NETDEV(create_shmem)
+{
+	auto *dev = new netdev_shmem(ifname, ifdev);
+	return dynamic_cast<osd_network_device *>(dev);
+}
+
+int shmem_module::init(osd_interface &osd, const osd_options &options)
+{
+	add_netdev("shmem", "Shared Memory Hub", create_shmem);
+	return 0;
+}
+
+void shmem_module::exit()
+{
+	clear_netdev();
+}
+
+} // anonymous namespace
+
+} // namespace osd
+
+
+#else
+
+namespace osd { namespace { MODULE_NOT_SUPPORTED(shmem_module, OSD_NETDEV_PROVIDER, "shmem") } }
+
+#endif
+
+
+MODULE_DEFINITION(NETDEV_SHMEM, osd::shmem_module)
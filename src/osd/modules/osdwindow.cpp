@@ -47,12 +47,17 @@ osd_window::osd_window(
 				index,
 				(sizeof(int) == sizeof(void *)) ? "I" : "",
 				(sizeof(long) == sizeof(void *)) ? "L" : (sizeof(long long) == sizeof(void *)) ? "LL" : "",
-				sizeof(void *) * 8))
+				sizeof(void *) * 8)),
+	m_render_done(nullptr),
+	m_render_update(0),
+	m_render_pending(false),
+	m_render_exit(false)
 {
 }
 
 osd_window::~osd_window()
 {
+	stop_render_thread();
 }
 
 float osd_window::pixel_aspect() const
@@ -93,8 +98,8 @@ std::shared_ptr<osd_monitor_info> osd_window::monitor_from_rect(const osd_rect *
 
 void osd_window::create_target()
 {
-	// load the layout
-	m_target = m_machine.render().target_alloc();
+	// load the layout - headless runs never show artwork, so don't go looking for it
+	m_target = m_machine.render().target_alloc(nullptr, m_machine.options().headless() ? RENDER_CREATE_NO_ART : 0);
 
 	// set the specific view
 	osd_options &options = downcast<osd_options &>(m_machine.options());
@@ -116,6 +121,68 @@ void osd_window::renderer_create()
 	m_renderer = m_renderprovider.create(*this);
 }
 
+void osd_window::start_render_thread(osd_event &done)
+{
+	osd_options const &options = downcast<osd_options &>(m_machine.options());
+	if (!options.render_thread() || !m_renderer || !m_renderer->can_draw_threaded() || render_threaded())
+		return;
+
+	// this thread created the renderer, and has to let go of it
+	m_renderer->release_thread();
+
+	m_render_done = &done;
+	m_render_pending = false;
+	m_render_exit = false;
+	m_render_thread = std::thread([this] () { render_thread_main(); });
+	osd_printf_verbose("Window %d: drawing on a separate thread\n", m_index);
+}
+
+void osd_window::stop_render_thread()
+{
+	if (!render_threaded())
+		return;
+
+	// a frame already handed over is still drawn
+	{
+		std::lock_guard<std::mutex> lock(m_render_mutex);
+		m_render_exit = true;
+	}
+	m_render_cond.notify_one();
+	m_render_thread.join();
+}
+
+void osd_window::render_async(int update)
+{
+	// the caller waits for the previous frame to be done first, so the
+	// primitive list and the renderer are the render thread's until then
+	{
+		std::lock_guard<std::mutex> lock(m_render_mutex);
+		m_render_update = update;
+		m_render_pending = true;
+	}
+	m_render_cond.notify_one();
+}
+
+void osd_window::render_thread_main()
+{
+	std::unique_lock<std::mutex> lock(m_render_mutex);
+	while (true)
+	{
+		m_render_cond.wait(lock, [this] () { return m_render_pending || m_render_exit; });
+		if (!m_render_pending)
+			break;
+		int const update = m_render_update;
+		m_render_pending = false;
+		lock.unlock();
+
+		m_renderer->draw(update);
+		m_renderer->release_thread();
+		m_render_done->set();
+
+		lock.lock();
+	}
+}
+
 void osd_window::set_starting_view(int index, const char *defview, const char *view)
 {
 	// choose non-auto over auto
@@ -13,10 +13,15 @@
 
 #include "emucore.h"
 #include "osdhelper.h"
+#include "osdsync.h"
 #include "../frontend/mame/ui/menuitem.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 // standard windows headers
@@ -62,7 +67,7 @@ public:
 
 	bool has_renderer() const { return m_renderer != nullptr; }
 	osd_renderer &renderer() const { return *m_renderer; }
-	void renderer_reset() { m_renderer.reset(); } // public because OSD object calls it directly during teardown
+	void renderer_reset() { stop_render_thread(); m_renderer.reset(); } // public because OSD object calls it directly during teardown
 
 	int index() const { return m_index; }
 	int prescale() const { return m_prescale; }
@@ -105,8 +110,16 @@ protected:
 	bool renderer_sdl_needs_opengl() const;
 	void renderer_create();
 
+	// drawing on a thread of its own, so waiting for the display doesn't
+	// hold up emulation; done is signalled after each frame is drawn
+	bool render_threaded() const { return m_render_thread.joinable(); }
+	void start_render_thread(osd_event &done);
+	void stop_render_thread();
+	void render_async(int update);
+
 private:
 	void set_starting_view(int index, const char *defview, const char *view);
+	void render_thread_main();
 
 private:
 	render_target           *m_target;
@@ -125,6 +138,15 @@ private:
 	std::shared_ptr<osd_monitor_info>   m_monitor;
 	std::unique_ptr<osd_renderer>       m_renderer;
 	const std::string                   m_title;
+
+	// render thread
+	std::thread                         m_render_thread;
+	std::mutex                          m_render_mutex;
+	std::condition_variable             m_render_cond;
+	osd_event                           *m_render_done;
+	int                                 m_render_update;
+	bool                                m_render_pending;
+	bool                                m_render_exit;
 };
 
 template <class TWindowHandle>
@@ -161,9 +183,10 @@ public:
 
 	osd_window &window() const { return m_window; }
 
+	// flags may be changed by the window while the render thread draws
 	bool has_flags(const int flag) const { return ((m_flags & flag)) == flag; }
-	void set_flags(int aflag) { m_flags |= aflag; }
-	void clear_flags(int aflag) { m_flags &= ~aflag; }
+	void set_flags(int aflag) { m_flags.fetch_or(aflag); }
+	void clear_flags(int aflag) { m_flags.fetch_and(~aflag); }
 
 	void notify_changed() { set_flags(FI_CHANGED); }
 
@@ -181,6 +204,11 @@ public:
 	virtual void toggle_fsfx() { }
 	virtual bool sliders_dirty() { return m_sliders_dirty; }
 
+	// whether draw() can be called from a thread other than the one that created the renderer
+	virtual bool can_draw_threaded() const { return false; }
+	// called on a thread that's done with the renderer, so another thread can draw
+	virtual void release_thread() { }
+
 protected:
 	virtual void build_slider_list() { }
 
@@ -190,8 +218,8 @@ protected:
 	std::vector<ui::menu_item>   m_sliders;
 
 private:
-	osd_window &m_window;
-	int         m_flags;
+	osd_window          &m_window;
+	std::atomic<int>    m_flags;
 };
 
 
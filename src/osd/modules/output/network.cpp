@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <set>
+#include <string>
 #include <thread>
 
 
@@ -195,7 +196,8 @@ public:
 	output_network() :
 		osd_module(OSD_OUTPUT_PROVIDER, "network"),
 		output_module(),
-		m_machine(nullptr)
+		m_machine(nullptr),
+		m_batching(false)
 	{
 	}
 
@@ -206,6 +208,7 @@ public:
 	virtual int init(osd_interface &osd, const osd_options &options) override
 	{
 		m_machine = &downcast<osd_common_t &>(osd).machine();
+		m_io_context.reset(new asio::io_context);
 		m_working_thread = std::thread([] (output_network* self) { self->process_output(); }, this);
 		return 0;
 	}
@@ -226,13 +229,32 @@ public:
 	virtual void notify(const char *outname, int32_t value) override
 	{
 		auto msg = util::string_format("%s = %d\r", ((outname==nullptr) ? "none" : outname), value);
-		m_server->deliver_to_all(msg);
+		if (m_batching)
+			m_batch.append(msg);
+		else
+			m_server->deliver_to_all(msg);
+	}
+
+	virtual void begin_batch() override
+	{
+		m_batching = true;
+	}
+
+	virtual void end_batch() override
+	{
+		// the clients are serviced on the network thread, so queue the whole
+		// frame's changes there as one message
+		m_batching = false;
+		if (!m_batch.empty())
+		{
+			asio::post(*m_io_context, [this, msg = std::move(m_batch)] () { m_server->deliver_to_all(msg); });
+			m_batch.clear();
+		}
 	}
 
 	// implementation
 	void process_output()
 	{
-		m_io_context.reset(new asio::io_context);
 		m_server.reset(new output_network_server(*m_io_context, 8000, machine()));
 		m_io_context->run();
 	}
@@ -244,6 +266,8 @@ private:
 	std::unique_ptr<asio::io_context> m_io_context;
 	std::unique_ptr<output_network_server> m_server;
 	running_machine *m_machine;
+	bool m_batching;
+	std::string m_batch;
 };
 
 } // anonymous namespace
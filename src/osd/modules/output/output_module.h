@@ -29,6 +29,10 @@ public:
 	virtual ~output_module() = default;
 
 	virtual void notify(const char *outname, int32_t value) = 0;
+
+	// changes made during a frame are notified between these calls
+	virtual void begin_batch() { }
+	virtual void end_batch() { }
 };
 
 #endif // MAME_OSD_OUTPUT_OUTPUT_MODULE_H
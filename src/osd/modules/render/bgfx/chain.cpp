@@ -25,8 +25,11 @@
 #include "target.h"
 #include "vertex.h"
 #include "clear.h"
+#include "inputpair.h"
 #include "modules/osdwindow.h"
 
+#include <algorithm>
+
 bgfx_chain::bgfx_chain(
 		std::string &&name,
 		std::string &&author,
@@ -54,6 +57,8 @@ bgfx_chain::bgfx_chain(
 		m_target_map[target->name()] = target;
 		m_target_names.push_back(target->name());
 	}
+
+	alias_targets();
 }
 
 bgfx_chain::~bgfx_chain()
@@ -70,9 +75,102 @@ bgfx_chain::~bgfx_chain()
 	{
 		delete entry;
 	}
-	for (bgfx_target* target : m_target_list)
+	for (const std::string &target_name : m_target_names)
+	{
+		m_targets.destroy_target(target_name, m_screen_index);
+	}
+}
+
+void bgfx_chain::alias_targets()
+{
+	// A target's contents only need to live from the first pass that writes
+	// it to the last pass that reads it, so targets with the same properties
+	// whose lifetimes don't overlap can share one.  Targets that carry
+	// anything over from the previous frame are left alone: ones read before
+	// they're written, and ones first written by a pass that may be disabled
+	// or that doesn't clear the target before drawing.
+	struct lifetime
+	{
+		int32_t first = -1;
+		int32_t last = -1;
+		bool shareable = true;
+	};
+	std::vector<lifetime> lifetimes(m_target_names.size());
+	const auto find_target = [this] (const std::string &name) -> int32_t
+	{
+		const auto found = std::find(m_target_names.begin(), m_target_names.end(), name);
+		return (found != m_target_names.end()) ? int32_t(found - m_target_names.begin()) : -1;
+	};
+
+	for (int32_t pass = 0; pass < int32_t(m_entries.size()); pass++)
+	{
+		bgfx_chain_entry *const entry = m_entries[pass];
+		for (bgfx_input_pair *input : entry->inputs())
+		{
+			const int32_t index = find_target(input->texture());
+			if (index >= 0)
+			{
+				if (lifetimes[index].first < 0)
+					lifetimes[index].shareable = false;
+				lifetimes[index].last = pass;
+			}
+		}
+
+		const int32_t index = find_target(entry->output());
+		if (index >= 0)
+		{
+			if (lifetimes[index].first < 0)
+			{
+				lifetimes[index].first = pass;
+				if (entry->can_skip() || !entry->clears_output())
+					lifetimes[index].shareable = false;
+			}
+			lifetimes[index].last = std::max(lifetimes[index].last, pass);
+		}
+	}
+
+	std::vector<size_t> order;
+	for (size_t i = 0; i < lifetimes.size(); i++)
 	{
-		m_targets.destroy_target(target->name(), m_screen_index);
+		if (lifetimes[i].shareable && (lifetimes[i].first >= 0))
+			order.push_back(i);
+	}
+	std::sort(
+			order.begin(),
+			order.end(),
+			[&lifetimes] (size_t a, size_t b) { return lifetimes[a].first < lifetimes[b].first; });
+
+	// each pooled target is free again after the last pass that reads what it holds
+	std::vector<std::pair<size_t, int32_t> > pool;
+	for (size_t index : order)
+	{
+		const bgfx_target &target = *m_target_list[index];
+		auto found = std::find_if(
+				pool.begin(),
+				pool.end(),
+				[this, &target, &lifetimes, index] (const std::pair<size_t, int32_t> &pooled)
+				{
+					const bgfx_target &other = *m_target_list[pooled.first];
+					return (pooled.second < lifetimes[index].first)
+							&& (other.format() == target.format())
+							&& (other.style() == target.style())
+							&& (other.double_buffered() == target.double_buffered())
+							&& (other.filter() == target.filter())
+							&& (other.scale() == target.scale())
+							&& (other.width() == target.width())
+							&& (other.height() == target.height());
+				});
+		if (found != pool.end())
+		{
+			osd_printf_verbose("Chain '%s': target '%s' shares memory with '%s'\n", m_name, m_target_names[index], m_target_names[found->first]);
+			m_targets.alias_target(m_target_names[index], m_target_names[found->first], m_screen_index);
+			m_target_list[index] = m_target_list[found->first];
+			found->second = lifetimes[index].last;
+		}
+		else
+		{
+			pool.emplace_back(index, lifetimes[index].last);
+		}
 	}
 }
 
@@ -48,6 +48,8 @@ public:
 	void insert_effect(uint32_t index, bgfx_effect *effect, const bool apply_tint, std::string name, std::string source, chain_manager &chains);
 
 private:
+	void alias_targets();
+
 	std::string                         m_name;
 	std::string                         m_author;
 	bool                                m_transform;
@@ -384,6 +384,11 @@ void bgfx_chain_entry::put_screen_buffer(uint16_t screen_width, uint16_t screen_
 	vertex[5].m_v = v[0];
 }
 
+bool bgfx_chain_entry::clears_output() const
+{
+	return m_clear && (m_clear->flags() & BGFX_CLEAR_COLOR);
+}
+
 bool bgfx_chain_entry::skip()
 {
 	if (m_suppressors.size() == 0)
@@ -44,6 +44,9 @@ public:
 	// Getters
 	std::string name() const { return m_name; }
 	std::vector<bgfx_input_pair*>& inputs() { return m_inputs; }
+	const std::string &output() const { return m_output; }
+	bool can_skip() const { return !m_suppressors.empty(); }
+	bool clears_output() const;
 	bool skip();
 
 private:
@@ -11,9 +11,6 @@
 
 #include "chainmanager.h"
 
-#include <bx/readerwriter.h>
-#include <bx/file.h>
-
 #include "emucore.h"
 #include "render.h"
 #include "../frontend/mame/ui/slider.h"
@@ -28,6 +25,8 @@
 
 #include "chain.h"
 #include "chainreader.h"
+#include "filecache.h"
+#include "shadermanager.h"
 #include "slider.h"
 #include "target.h"
 #include "texture.h"
@@ -43,10 +42,73 @@
 
 #include <algorithm>
 #include <locale>
+#include <set>
 
 
 using namespace rapidjson;
 
+namespace {
+
+// chains and effects are named without the extension
+std::string json_file_path(std::string_view bgfx_path, std::string_view dir, std::string name)
+{
+	if (name.length() < 5 || (name.compare(name.length() - 5, 5, ".json") != 0))
+		name += ".json";
+	return util::path_concat(bgfx_path, dir, name);
+}
+
+struct warm_job
+{
+	std::string bgfx_path;
+	std::string shader_path;
+	std::vector<std::string> chains;
+};
+
+bool parse_cached(const std::string &path, Document &document)
+{
+	const bgfx_file_cache::data_ptr data = bgfx_file_cache::read(path);
+	if (!data)
+		return false;
+	document.Parse<kParseCommentsFlag>(reinterpret_cast<const char *>(data->data()), data->size());
+	return !document.HasParseError() && document.IsObject();
+}
+
+// Reads everything a chain will need into the file cache.  Anything wrong
+// with the files is ignored here and reported when the chain is loaded.
+void *warm_chains_callback(void *param, int threadid)
+{
+	std::unique_ptr<warm_job> const job(reinterpret_cast<warm_job *>(param));
+
+	std::set<std::string> effects;
+	for (const std::string &chain : job->chains)
+	{
+		Document document;
+		if (!parse_cached(json_file_path(job->bgfx_path, "chains", chain), document) || !document.HasMember("passes") || !document["passes"].IsArray())
+			continue;
+		for (const Value &pass : document["passes"].GetArray())
+		{
+			if (pass.IsObject() && pass.HasMember("effect") && pass["effect"].IsString())
+				effects.emplace(pass["effect"].GetString());
+		}
+	}
+
+	for (const std::string &effect : effects)
+	{
+		Document document;
+		if (!parse_cached(json_file_path(job->bgfx_path, "effects", effect), document))
+			continue;
+		for (const char *stage : { "vertex", "fragment", "pixel" })
+		{
+			if (document.HasMember(stage) && document[stage].IsString())
+				bgfx_file_cache::read(job->shader_path + document[stage].GetString() + ".bin");
+		}
+	}
+
+	return nullptr;
+}
+
+} // anonymous namespace
+
 chain_manager::screen_prim::screen_prim(render_primitive *prim)
 {
 	m_prim = prim;
@@ -82,15 +144,19 @@ chain_manager::chain_manager(
 	, m_slider_notifier(slider_notifier)
 	, m_screen_count(0)
 	, m_default_chain_index(-1)
+	, m_warm_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO))
 {
 	m_converters.clear();
 	refresh_available_chains();
 	parse_chain_selections(options.bgfx_screen_chains());
+	warm_chains();
 	init_texture_converters();
 }
 
 chain_manager::~chain_manager()
 {
+	if (m_warm_queue)
+		osd_work_queue_free(m_warm_queue);
 	destroy_chains();
 }
 
@@ -225,33 +291,17 @@ std::unique_ptr<bgfx_chain> chain_manager::load_chain(std::string name, uint32_t
 	{
 		name += ".json";
 	}
-	const std::string path = util::path_concat(m_options.bgfx_path(), "chains", name);
+	const std::string path = json_file_path(m_options.bgfx_path(), "chains", name);
 
-	bx::FileReader reader;
-	if (!bx::open(&reader, path.c_str()))
-	{
-		osd_printf_warning("Unable to open chain file %s, falling back to no post processing\n", path);
-		return nullptr;
-	}
-
-	const int32_t size(bx::getSize(&reader));
-
-	bx::ErrorAssert err;
-	std::unique_ptr<char []> data(new (std::nothrow) char [size + 1]);
+	const bgfx_file_cache::data_ptr data = bgfx_file_cache::read(path);
 	if (!data)
 	{
-		osd_printf_error("Out of memory reading chain file %s\n", path);
-		bx::close(&reader);
+		osd_printf_warning("Unable to open chain file %s, falling back to no post processing\n", path);
 		return nullptr;
 	}
 
-	bx::read(&reader, reinterpret_cast<void*>(data.get()), size, &err);
-	bx::close(&reader);
-	data[size] = 0;
-
 	Document document;
-	document.Parse<kParseCommentsFlag>(data.get());
-	data.reset();
+	document.Parse<kParseCommentsFlag>(reinterpret_cast<const char *>(data->data()), data->size());
 
 	if (document.HasParseError())
 	{
@@ -355,6 +405,38 @@ void chain_manager::load_chains()
 			m_screen_chains[chain] = load_chain(util::path_concat(desc.m_path, desc.m_name), uint32_t(chain)).release();
 		}
 	}
+
+	warm_chains();
+}
+
+void chain_manager::warm_chains()
+{
+	// the selection slider steps through chains one at a time, so the
+	// neighbours of each selected chain are the likeliest to be wanted next
+	if (!m_warm_queue)
+		return;
+	m_warmed.resize(m_available_chains.size(), false);
+
+	auto job = std::make_unique<warm_job>();
+	for (int32_t current : m_current_chain)
+	{
+		for (int32_t index = current - 1; index <= current + 1; index++)
+		{
+			if ((index > int32_t(CHAIN_NONE)) && (index < m_available_chains.size()) && !m_warmed[index])
+			{
+				const chain_desc &desc = m_available_chains[index];
+				job->chains.emplace_back(util::path_concat(desc.m_path, desc.m_name));
+				m_warmed[index] = true;
+			}
+		}
+	}
+	if (job->chains.empty())
+		return;
+
+	job->bgfx_path = m_options.bgfx_path();
+	job->shader_path = shader_manager::make_path_string(m_options, "");
+	if (osd_work_item_queue(m_warm_queue, warm_chains_callback, job.get(), WORK_ITEM_FLAG_AUTO_RELEASE))
+		job.release();
 }
 
 void chain_manager::destroy_chains()
@@ -29,6 +29,7 @@
 
 class running_machine;
 class osd_window;
+struct osd_work_queue;
 struct slider_state;
 class slider_dirty_notifier;
 class render_primitive;
@@ -109,6 +110,7 @@ private:
 	void load_chains();
 	void destroy_chains();
 	void reload_chains();
+	void warm_chains();
 
 	void init_texture_converters();
 
@@ -152,6 +154,8 @@ private:
 	bgfx_effect *               m_adjuster;
 	std::vector<screen_prim>    m_screen_prims;
 	std::vector<uint8_t>        m_palette_temp;
+	osd_work_queue *            m_warm_queue;
+	std::vector<bool>           m_warmed;
 
 	static inline constexpr uint32_t CHAIN_NONE = 0;
 };
@@ -20,6 +20,9 @@ public:
 
 	void bind(int view) const;
 
+	// Getters
+	uint64_t flags() const { return m_flags; }
+
 private:
 	const uint64_t  m_flags;
 	const uint32_t  m_color;
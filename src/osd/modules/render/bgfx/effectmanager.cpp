@@ -13,6 +13,7 @@
 
 #include "effect.h"
 #include "effectreader.h"
+#include "filecache.h"
 #include "shadermanager.h"
 
 #include "path.h"
@@ -23,9 +24,6 @@
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 
-#include <bx/readerwriter.h>
-#include <bx/file.h>
-
 #include <bgfx/bgfx.h>
 
 #include <utility>
@@ -41,29 +39,14 @@ static bool prepare_effect_document(const std::string &name, const osd_options &
 
 	const std::string path = util::path_concat(options.bgfx_path(), "effects", full_name);
 
-	bx::FileReader reader;
-	if (!bx::open(&reader, path.c_str()))
-	{
-		osd_printf_error("Unable to open effect file %s\n", path);
-		return false;
-	}
-
-	const int32_t size = bx::getSize(&reader);
-	std::unique_ptr<char []> data(new (std::nothrow) char [size + 1]);
+	const bgfx_file_cache::data_ptr data = bgfx_file_cache::read(path);
 	if (!data)
 	{
-		osd_printf_error("Out of memory reading effect file %s\n", path);
-		bx::close(&reader);
+		osd_printf_error("Unable to open effect file %s\n", path);
 		return false;
 	}
 
-	bx::ErrorAssert err;
-	bx::read(&reader, reinterpret_cast<void*>(data.get()), size, &err);
-	bx::close(&reader);
-	data[size] = 0;
-
-	document.Parse<rapidjson::kParseCommentsFlag>(data.get());
-	data.reset();
+	document.Parse<rapidjson::kParseCommentsFlag>(reinterpret_cast<const char *>(data->data()), data->size());
 
 	if (document.HasParseError())
 	{
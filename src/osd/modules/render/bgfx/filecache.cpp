@@ -0,0 +1,82 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+//============================================================
+//
+//  filecache.cpp - BGFX asset file cache
+//
+//  Keeps the contents of chain and effect definitions and
+//  compiled shader binaries in memory for the life of the
+//  process, so recreating renderers and switching chains
+//  doesn't go back to the disk.
+//
+//============================================================
+
+#include "filecache.h"
+
+#include "osdfile.h"
+
+#include <bx/file.h>
+#include <bx/readerwriter.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <new>
+
+
+namespace {
+
+struct cache_entry
+{
+	uint64_t size;
+	std::chrono::system_clock::time_point last_modified;
+	bgfx_file_cache::data_ptr data;
+};
+
+std::mutex s_cache_lock;
+std::map<std::string, cache_entry> s_cache;
+
+} // anonymous namespace
+
+
+bgfx_file_cache::data_ptr bgfx_file_cache::read(const std::string &path)
+{
+	// a file that can't be examined can't be read either
+	const std::unique_ptr<osd::directory::entry> entry = osd_stat(path);
+	if (!entry || (entry->type != osd::directory::entry::entry_type::FILE))
+		return nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(s_cache_lock);
+		const auto iter = s_cache.find(path);
+		if ((iter != s_cache.end()) && (iter->second.size == entry->size) && (iter->second.last_modified == entry->last_modified))
+			return iter->second.data;
+	}
+
+	// read outside the lock so other threads aren't held up by the disk
+	bx::FileReader reader;
+	if (!bx::open(&reader, path.c_str()))
+		return nullptr;
+
+	const int64_t size = bx::getSize(&reader);
+	std::shared_ptr<std::vector<uint8_t> > data;
+	try
+	{
+		data = std::make_shared<std::vector<uint8_t> >(size_t(size));
+	}
+	catch (std::bad_alloc const &)
+	{
+		bx::close(&reader);
+		return nullptr;
+	}
+
+	bx::Error err;
+	const int32_t actual = bx::read(&reader, data->data(), int32_t(size), &err);
+	bx::close(&reader);
+	if (actual != size)
+		return nullptr;
+
+	std::lock_guard<std::mutex> lock(s_cache_lock);
+	s_cache[path] = cache_entry{ entry->size, entry->last_modified, data };
+	return data;
+}
@@ -0,0 +1,35 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+//============================================================
+//
+//  filecache.h - BGFX asset file cache
+//
+//  Keeps the contents of chain and effect definitions and
+//  compiled shader binaries in memory for the life of the
+//  process, so recreating renderers and switching chains
+//  doesn't go back to the disk.
+//
+//============================================================
+
+#ifndef MAME_RENDER_BGFX_FILECACHE_H
+#define MAME_RENDER_BGFX_FILECACHE_H
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class bgfx_file_cache
+{
+public:
+	using data_ptr = std::shared_ptr<const std::vector<uint8_t> >;
+
+	// Returns the contents of the file, reading it if it isn't cached or
+	// has changed on disk since it was cached.  Safe to call from any thread.
+	static data_ptr read(const std::string &path);
+};
+
+#endif // MAME_RENDER_BGFX_FILECACHE_H
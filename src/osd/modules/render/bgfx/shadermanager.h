@@ -33,9 +33,9 @@ public:
 	bgfx::ShaderHandle get_or_load_shader(const osd_options &options, const std::string &name);
 	static bgfx::ShaderHandle load_shader(const osd_options &options, const std::string &name);
 	static bool is_shader_present(const osd_options &options, const std::string &name);
+	static std::string make_path_string(const osd_options &options, const std::string &name);
 
 private:
-	static std::string make_path_string(const osd_options &options, const std::string &name);
 	static const bgfx::Memory* load_mem(const std::string &name);
 
 	std::map<std::string, bgfx::ShaderHandle> m_shaders;
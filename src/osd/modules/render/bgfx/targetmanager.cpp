@@ -29,6 +29,8 @@ target_manager::target_manager(texture_manager& textures)
 
 target_manager::~target_manager()
 {
+	for (auto iter = m_aliases.begin(); iter != m_aliases.end(); iter = m_aliases.erase(iter))
+		m_textures.remove_provider(iter->first);
 	for (auto iter = m_targets.begin(); iter != m_targets.end(); iter = m_targets.erase(iter))
 		m_textures.remove_provider(iter->first);
 }
@@ -47,6 +49,7 @@ bgfx_target* target_manager::create_target(
 		uint32_t screen)
 {
 	const std::string full_name = name + std::to_string(screen);
+	m_aliases.erase(full_name);
 
 	auto iter = m_targets.find(full_name);
 	if (iter != m_targets.end())
@@ -62,20 +65,59 @@ bgfx_target* target_manager::create_target(
 		iter = m_targets.emplace(full_name, std::move(target)).first;
 	m_textures.add_provider(full_name, *iter->second);
 
+	// a rebuilt target replaces the one its aliases were pointing at
+	for (const auto &[alias, target_name] : m_aliases)
+	{
+		if (target_name == full_name)
+			m_textures.add_provider(alias, *iter->second);
+	}
+
 	return iter->second.get();
 }
 
 void target_manager::destroy_target(const std::string &name, uint32_t screen)
 {
 	const std::string full_name = (screen < 0) ? name : (name + std::to_string(screen));
+	if (m_aliases.erase(full_name))
+	{
+		m_textures.remove_provider(full_name);
+		return;
+	}
+
 	const auto found = m_targets.find(full_name);
 	if (found != m_targets.end())
 	{
 		m_targets.erase(found);
 		m_textures.remove_provider(full_name);
+		for (auto iter = m_aliases.begin(); iter != m_aliases.end(); )
+		{
+			if (iter->second == full_name)
+			{
+				m_textures.remove_provider(iter->first);
+				iter = m_aliases.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
 	}
 }
 
+void target_manager::alias_target(const std::string &name, const std::string &target_name, uint32_t screen)
+{
+	const std::string full_name = name + std::to_string(screen);
+	const std::string full_target_name = target_name + std::to_string(screen);
+	const auto found = m_targets.find(full_target_name);
+	if (found == m_targets.end())
+		return;
+
+	// the alias replaces any target of its own
+	destroy_target(name, screen);
+	m_aliases[full_name] = full_target_name;
+	m_textures.add_provider(full_name, *found->second);
+}
+
 bgfx_target* target_manager::create_backbuffer(void *handle, uint16_t width, uint16_t height)
 {
 	auto target = std::make_unique<bgfx_target>(handle, width, height);
@@ -85,7 +127,8 @@ bgfx_target* target_manager::create_backbuffer(void *handle, uint16_t width, uin
 bgfx_target* target_manager::target(uint32_t screen, const std::string &name)
 {
 	const std::string full_name = name + std::to_string(screen);
-	const auto found = m_targets.find(full_name);
+	const auto alias = m_aliases.find(full_name);
+	const auto found = m_targets.find((alias != m_aliases.end()) ? alias->second : full_name);
 	if (found != m_targets.end())
 	{
 		return found->second.get();
@@ -37,6 +37,7 @@ public:
 	bgfx_target* create_target(std::string &&name, bgfx::TextureFormat::Enum format, uint16_t width, uint16_t height, uint16_t xprescale, uint16_t yprescale,
 		uint32_t style, bool double_buffer, bool filter, uint16_t scale, uint32_t screen);
 	void destroy_target(const std::string &name, uint32_t screen = -1);
+	void alias_target(const std::string &name, const std::string &target_name, uint32_t screen);
 	bgfx_target* create_backbuffer(void *handle, uint16_t width, uint16_t height);
 
 	bool update_target_sizes(uint32_t screen, uint16_t width, uint16_t height, uint32_t style, uint16_t user_prescale, uint16_t max_prescale_size);
@@ -52,6 +53,7 @@ private:
 	void create_output_if_nonexistent(uint32_t screen, uint16_t user_prescale, uint16_t max_prescale_size);
 
 	std::map<std::string, std::unique_ptr<bgfx_target> > m_targets;
+	std::map<std::string, std::string> m_aliases;
 	texture_manager& m_textures;
 
 	std::vector<osd_dim> m_guest_dims;
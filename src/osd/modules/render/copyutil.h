@@ -13,6 +13,7 @@
 
 #include "palette.h"
 
+#include <algorithm>
 #include <cassert>
 
 
@@ -21,20 +22,37 @@ class copy_util
 public:
 	static inline void copyline_palette16(uint32_t *dst, const uint16_t *src, int width, const rgb_t *palette)
 	{
-		for (int x = 0; x < width; x++)
+		// swap red and blue in place rather than unpacking and repacking all
+		// three channels, and keep the lookups independent of each other
+		int x = 0;
+		for ( ; x + 4 <= width; x += 4, src += 4, dst += 4)
 		{
-			rgb_t srcpixel = palette[*src++];
-			*dst++ = 0xff000000 | (srcpixel.b() << 16) | (srcpixel.g() << 8) | srcpixel.r();
+			uint32_t const val0 = palette[src[0]], val1 = palette[src[1]], val2 = palette[src[2]], val3 = palette[src[3]];
+			dst[0] = 0xff000000 | (val0 & 0x0000ff00) | ((val0 & 0x000000ff) << 16) | ((val0 & 0x00ff0000) >> 16);
+			dst[1] = 0xff000000 | (val1 & 0x0000ff00) | ((val1 & 0x000000ff) << 16) | ((val1 & 0x00ff0000) >> 16);
+			dst[2] = 0xff000000 | (val2 & 0x0000ff00) | ((val2 & 0x000000ff) << 16) | ((val2 & 0x00ff0000) >> 16);
+			dst[3] = 0xff000000 | (val3 & 0x0000ff00) | ((val3 & 0x000000ff) << 16) | ((val3 & 0x00ff0000) >> 16);
+		}
+		for ( ; x < width; x++)
+		{
+			uint32_t const val = palette[*src++];
+			*dst++ = 0xff000000 | (val & 0x0000ff00) | ((val & 0x000000ff) << 16) | ((val & 0x00ff0000) >> 16);
 		}
 	}
 
 	static inline void copyline_palette16_to_bgra(uint32_t *dst, const uint16_t *src, int width, const rgb_t *palette)
 	{
-		for (int x = 0; x < width; x++)
+		// rgb_t is already laid out as BGRA in memory, so this is a plain lookup
+		int x = 0;
+		for ( ; x + 4 <= width; x += 4, src += 4, dst += 4)
 		{
-			rgb_t srcpixel = palette[*src++];
-			*dst++ = 0xff000000 | (srcpixel.r() << 16) | (srcpixel.g() << 8) | srcpixel.b();
+			dst[0] = 0xff000000 | palette[src[0]];
+			dst[1] = 0xff000000 | palette[src[1]];
+			dst[2] = 0xff000000 | palette[src[2]];
+			dst[3] = 0xff000000 | palette[src[3]];
 		}
+		for ( ; x < width; x++)
+			*dst++ = 0xff000000 | palette[*src++];
 	}
 
 	static inline void copyline_rgb32(uint32_t *dst, const uint32_t *src, int width, const rgb_t *palette)
@@ -80,11 +98,9 @@ public:
 		// direct case
 		else
 		{
+			// rgb_t is already BGRA in memory, so only alpha needs forcing
 			for (x = 0; x < width; x++)
-			{
-				rgb_t srcpix = *src++;
-				*dst++ = 0xff000000 | (srcpix.r() << 16) | (srcpix.g() << 8) | srcpix.b();
-			}
+				*dst++ = 0xff000000 | *src++;
 		}
 	}
 
@@ -129,11 +145,8 @@ public:
 		// direct case
 		else
 		{
-			for (x = 0; x < width; x++)
-			{
-				rgb_t srcpix = *src++;
-				*dst++ = (srcpix.a() << 24) | (srcpix.r() << 16) | (srcpix.g() << 8) | srcpix.b();
-			}
+			// rgb_t is already BGRA in memory, so this is a straight copy
+			std::copy_n(src, width, dst);
 		}
 	}
 
@@ -251,7 +251,7 @@ public:
 
 	~d3d_render_target();
 
-	bool init(renderer_d3d9 *d3d, int source_width, int source_height, int target_width, int target_height, int screen_index);
+	bool init(renderer_d3d9 *d3d, int source_width, int source_height, int target_width, int target_height, int screen_index, bool bloom_half, D3DFORMAT bloom_format);
 	int next_index(int index) { return ++index > 1 ? 0 : index; }
 
 	// real target dimension
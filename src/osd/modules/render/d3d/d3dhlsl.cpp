@@ -162,6 +162,8 @@ shaders::shaders() :
 	d3d(nullptr),
 	post_fx_enable(false),
 	oversampling_enable(false),
+	bloom_half_enable(false),
+	bloom_format(D3DFMT_A8R8G8B8),
 	num_screens(0),
 	num_targets(0),
 	curr_target(0),
@@ -448,6 +450,12 @@ bool shaders::init(IDirect3D9 *d3dobj, running_machine *machine, renderer_d3d9 *
 
 	post_fx_enable = winoptions.d3d_hlsl_enable();
 	oversampling_enable = winoptions.d3d_hlsl_oversampling();
+	bloom_half_enable = winoptions.d3d_hlsl_bloom_half();
+
+	// half-size bloom sums fewer, blurrier levels, so keep more precision if the card can filter it
+	bloom_format = D3DFMT_A8R8G8B8;
+	if (bloom_half_enable && SUCCEEDED(d3dobj->CheckDeviceFormat(renderer->get_adapter(), D3DDEVTYPE_HAL, renderer->get_pixel_format(), D3DUSAGE_RENDERTARGET | D3DUSAGE_QUERY_FILTER, D3DRTYPE_TEXTURE, D3DFMT_A16B16G16R16F)))
+		bloom_format = D3DFMT_A16B16G16R16F;
 	snap_width = winoptions.d3d_snap_width();
 	snap_height = winoptions.d3d_snap_height();
 
@@ -1824,7 +1832,7 @@ bool shaders::add_render_target(renderer_d3d9* d3d, render_primitive *prim, int
 
 	auto target = std::make_unique<d3d_render_target>();
 
-	if (!target->init(d3d, source_width, source_height, target_width, target_height, source_screen))
+	if (!target->init(d3d, source_width, source_height, target_width, target_height, source_screen, bloom_half_enable, bloom_format))
 		return false;
 
 	m_render_target_list.push_back(std::move(target));
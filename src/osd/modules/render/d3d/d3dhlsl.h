@@ -390,6 +390,8 @@ private:
 
 	bool                    post_fx_enable;             // overall enable flag
 	bool                    oversampling_enable;        // oversampling enable flag
+	bool                    bloom_half_enable;          // half-size bloom enable flag
+	D3DFORMAT               bloom_format;               // format of bloom targets
 	int                     num_screens;                // number of emulated physical screens
 	int                     num_targets;                // number of emulated screen targets (can be different from above; cf. artwork and Laserdisc games)
 	int                     curr_target;                // current target index for render target operations
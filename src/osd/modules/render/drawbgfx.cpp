@@ -501,8 +501,8 @@ MODULE_DEFINITION(RENDERER_BGFX, osd::video_bgfx)
 //  CONSTANTS
 //============================================================
 
-uint16_t const renderer_bgfx::CACHE_SIZE = 1024;
-uint32_t const renderer_bgfx::PACKABLE_SIZE = 128;
+uint16_t const renderer_bgfx::MIN_CACHE_SIZE = 1024;
+uint16_t const renderer_bgfx::MAX_CACHE_SIZE = 4096;
 uint32_t const renderer_bgfx::WHITE_HASH = 0x87654321;
 char const *const renderer_bgfx::WINDOW_PREFIX = "Window 0, ";
 
@@ -581,6 +581,8 @@ renderer_bgfx::renderer_bgfx(osd_window &window, parent_module &parent)
 	, m_module(parent)
 	, m_framebuffer(nullptr)
 	, m_texture_cache(nullptr)
+	, m_cache_size(MIN_CACHE_SIZE)
+	, m_packable_size(MIN_CACHE_SIZE / 8)
 	, m_dimensions(0, 0)
 	, m_max_view(0)
 	, m_avi_view(nullptr)
@@ -623,6 +625,10 @@ renderer_bgfx::~renderer_bgfx()
 	else if (m_chains)
 		m_chains->save_config(m_module().persistent_settings());
 
+	for (auto &entry : m_screen_textures)
+		bgfx::destroy(entry.second.handle);
+	m_screen_textures.clear();
+
 	bgfx::reset(0, 0, BGFX_RESET_NONE);
 
 	if (m_avi_writer != nullptr && m_avi_writer->recording())
@@ -706,8 +712,13 @@ int renderer_bgfx::create()
 			max_prescale_size);
 	m_sliders_dirty = true;
 
+	// use as big an atlas as the GPU allows (within reason), so that artwork
+	// with many small elements can be drawn from a handful of batches
+	m_cache_size = uint16_t(std::clamp<uint32_t>(m_module().max_texture_size(), MIN_CACHE_SIZE, MAX_CACHE_SIZE));
+	m_packable_size = m_cache_size / 8;
+
 	uint32_t flags = BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP | BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT | BGFX_SAMPLER_MIP_POINT;
-	m_texture_cache = m_textures->create_texture("#cache", bgfx::TextureFormat::BGRA8, CACHE_SIZE, 0, CACHE_SIZE, nullptr, flags);
+	m_texture_cache = m_textures->create_texture("#cache", bgfx::TextureFormat::BGRA8, m_cache_size, 0, m_cache_size, nullptr, flags);
 
 	memset(m_white, 0xff, sizeof(uint32_t) * 16 * 16);
 	m_texinfo.push_back(rectangle_packer::packable_rectangle(WHITE_HASH, PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32), 16, 16, 16, nullptr, m_white));
@@ -781,7 +792,7 @@ bgfx::VertexLayout ScreenVertex::ms_decl;
 void renderer_bgfx::put_packed_quad(render_primitive *prim, uint32_t hash, ScreenVertex* vertices)
 {
 	rectangle_packer::packed_rectangle& rect = m_hash_to_entry[hash];
-	auto size = float(CACHE_SIZE);
+	auto size = float(m_cache_size);
 	float u0 = (float(rect.x()) + 0.5f) / size;
 	float v0 = (float(rect.y()) + 0.5f) / size;
 	float u1 = u0 + (float(rect.width()) - 1.0f) / size;
@@ -941,9 +952,7 @@ void renderer_bgfx::render_textured_quad(render_primitive* prim, bgfx::Transient
 	bgfx::TextureHandle texture = BGFX_INVALID_HANDLE;
 	if (is_screen)
 	{
-		const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgra32(prim->flags & PRIMFLAG_TEXFORMAT_MASK
-			, tex_width, tex_height, prim->texture.rowpixels, prim->texture.palette, prim->texture.base);
-		texture = bgfx::createTexture2D(tex_width, tex_height, false, 1, bgfx::TextureFormat::BGRA8, texture_flags, mem);
+		texture = get_screen_texture(prim, texture_flags);
 	}
 	else
 	{
@@ -967,10 +976,67 @@ void renderer_bgfx::render_textured_quad(render_primitive* prim, bgfx::Transient
 	}
 
 	effects[blend]->submit(m_ortho_view->get_index());
+}
 
-	if (is_screen)
+bgfx::TextureHandle renderer_bgfx::get_screen_texture(render_primitive* prim, uint32_t texture_flags)
+{
+	const uint16_t tex_width(prim->texture.width);
+	const uint16_t tex_height(prim->texture.height);
+
+	// follow the render texture if it was given a new id
+	auto iter = m_screen_textures.find(prim->texture.unique_id);
+	if (iter == m_screen_textures.end() && prim->texture.old_id != ~0ULL)
+	{
+		const auto old = m_screen_textures.find(prim->texture.old_id);
+		if (old != m_screen_textures.end())
+		{
+			iter = m_screen_textures.emplace(prim->texture.unique_id, old->second).first;
+			m_screen_textures.erase(old);
+		}
+	}
+
+	// a texture can only be updated in place if nothing about its shape changed
+	if (iter != m_screen_textures.end() && (iter->second.width != tex_width || iter->second.height != tex_height || iter->second.flags != texture_flags))
+	{
+		bgfx::destroy(iter->second.handle);
+		m_screen_textures.erase(iter);
+		iter = m_screen_textures.end();
+	}
+
+	if (iter == m_screen_textures.end())
 	{
-		bgfx::destroy(texture);
+		// created without initial data so that it stays mutable
+		const bgfx::TextureHandle handle = bgfx::createTexture2D(tex_width, tex_height, false, 1, bgfx::TextureFormat::BGRA8, texture_flags);
+		iter = m_screen_textures.emplace(prim->texture.unique_id, screen_texture{ handle, ~prim->texture.seqid, tex_width, tex_height, texture_flags, true }).first;
+	}
+
+	screen_texture &entry = iter->second;
+	entry.used = true;
+	if (entry.seqid != prim->texture.seqid)
+	{
+		const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgra32(prim->flags & PRIMFLAG_TEXFORMAT_MASK
+			, tex_width, tex_height, prim->texture.rowpixels, prim->texture.palette, prim->texture.base);
+		bgfx::updateTexture2D(entry.handle, 0, 0, 0, 0, tex_width, tex_height, mem);
+		entry.seqid = prim->texture.seqid;
+	}
+	return entry.handle;
+}
+
+void renderer_bgfx::purge_screen_textures()
+{
+	// drop screen textures that weren't drawn this frame
+	for (auto iter = m_screen_textures.begin(); iter != m_screen_textures.end(); )
+	{
+		if (iter->second.used)
+		{
+			iter->second.used = false;
+			++iter;
+		}
+		else
+		{
+			bgfx::destroy(iter->second.handle);
+			iter = m_screen_textures.erase(iter);
+		}
 	}
 }
 
@@ -982,8 +1048,8 @@ void renderer_bgfx::put_polygon(const float* coords, uint32_t num_coords, float
 	float tempNormals[MAX_TEMP_COORDS * 2];
 
 	rectangle_packer::packed_rectangle& rect = m_hash_to_entry[WHITE_HASH];
-	float u0 = float(rect.x()) / float(CACHE_SIZE);
-	float v0 = float(rect.y()) / float(CACHE_SIZE);
+	float u0 = float(rect.x()) / float(m_cache_size);
+	float v0 = float(rect.y()) / float(m_cache_size);
 
 	num_coords = num_coords < MAX_TEMP_COORDS ? num_coords : MAX_TEMP_COORDS;
 
@@ -1295,6 +1361,8 @@ int renderer_bgfx::draw(int update)
 
 	window().m_primlist->release_lock();
 
+	purge_screen_textures();
+
 	// This dummy draw call is here to make sure that view 0 is cleared
 	// if no other draw calls are submitted to view 0.
 	//bgfx::touch(s_current_view > 0 ? s_current_view - 1 : 0);
@@ -1443,7 +1511,7 @@ renderer_bgfx::buffer_status renderer_bgfx::buffer_primitives(bool atlas_valid,
 				else
 				{
 					const uint32_t hash = get_texture_hash(*prim);
-					if (atlas_valid && (*prim)->packable(PACKABLE_SIZE) && hash != 0 && m_hash_to_entry[hash].hash())
+					if (atlas_valid && (*prim)->packable(m_packable_size) && hash != 0 && m_hash_to_entry[hash].hash())
 					{
 						setup_ortho_view();
 						put_packed_quad(*prim, hash, (ScreenVertex*)buffer->data + vertices);
@@ -1517,7 +1585,7 @@ bool renderer_bgfx::update_atlas()
 		m_hash_to_entry.clear();
 
 		std::vector<std::vector<rectangle_packer::packed_rectangle>> packed;
-		if (m_packer.pack(m_texinfo, packed, CACHE_SIZE))
+		if (m_packer.pack(m_texinfo, packed, m_cache_size))
 		{
 			process_atlas_packs(packed);
 		}
@@ -1528,7 +1596,7 @@ bool renderer_bgfx::update_atlas()
 			m_texinfo.clear();
 			m_texinfo.push_back(rectangle_packer::packable_rectangle(WHITE_HASH, PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32), 16, 16, 16, nullptr, m_white));
 
-			m_packer.pack(m_texinfo, packed, CACHE_SIZE);
+			m_packer.pack(m_texinfo, packed, m_cache_size);
 			process_atlas_packs(packed);
 
 			return false;
@@ -1593,7 +1661,7 @@ bool renderer_bgfx::check_for_dirty_atlas()
 	std::map<uint32_t, rectangle_packer::packable_rectangle> acquired_infos;
 	for (render_primitive &prim : *window().m_primlist)
 	{
-		bool pack = prim.packable(PACKABLE_SIZE);
+		bool pack = prim.packable(m_packable_size);
 		if (prim.type == render_primitive::QUAD && prim.texture.base != nullptr && pack)
 		{
 			const uint32_t hash = get_texture_hash(&prim);
@@ -1631,7 +1699,7 @@ void renderer_bgfx::allocate_buffer(render_primitive *prim, uint32_t blend, bgfx
 				break;
 
 			case render_primitive::QUAD:
-				if (!prim->packable(PACKABLE_SIZE))
+				if (!prim->packable(m_packable_size))
 				{
 					if (prim->texture.base == nullptr)
 					{
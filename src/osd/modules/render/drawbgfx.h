@@ -96,6 +96,8 @@ private:
 	buffer_status buffer_primitives(bool atlas_valid, render_primitive** prim, bgfx::TransientVertexBuffer* buffer, int32_t screen, int window_index);
 
 	void render_textured_quad(render_primitive* prim, bgfx::TransientVertexBuffer* buffer, int window_index);
+	bgfx::TextureHandle get_screen_texture(render_primitive* prim, uint32_t texture_flags);
+	void purge_screen_textures();
 	void render_post_screen_quad(int view, render_primitive* prim, bgfx::TransientVertexBuffer* buffer, int32_t screen, int window_index);
 
 	void put_packed_quad(render_primitive *prim, uint32_t hash, ScreenVertex* vertex);
@@ -119,6 +121,8 @@ private:
 
 	bgfx_target *m_framebuffer;
 	bgfx_texture *m_texture_cache;
+	uint16_t m_cache_size;          // width and height of the atlas texture
+	uint32_t m_packable_size;       // largest texture dimension put in the atlas
 
 	// Original display_mode
 	osd_dim m_dimensions;
@@ -131,6 +135,19 @@ private:
 
 	bgfx_effect *m_gui_effect[4];
 	bgfx_effect *m_screen_effect[4];
+
+	// screen textures drawn without a chain, kept and updated in place while the
+	// size matches; re-uploaded only when the render texture's seqid changes
+	struct screen_texture
+	{
+		bgfx::TextureHandle handle;
+		uint32_t seqid;
+		uint16_t width;
+		uint16_t height;
+		uint32_t flags;
+		bool used;
+	};
+	std::map<uint64_t, screen_texture> m_screen_textures;
 	std::vector<uint32_t> m_seen_views;
 
 	std::map<uint32_t, rectangle_packer::packed_rectangle> m_hash_to_entry;
@@ -152,8 +169,8 @@ private:
 	const util::notifier_subscription m_load_sub;
 	const util::notifier_subscription m_save_sub;
 
-	static const uint16_t CACHE_SIZE;
-	static const uint32_t PACKABLE_SIZE;
+	static const uint16_t MIN_CACHE_SIZE;
+	static const uint16_t MAX_CACHE_SIZE;
 	static const uint32_t WHITE_HASH;
 
 	static uint32_t s_current_view;
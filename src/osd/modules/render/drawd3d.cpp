@@ -2570,7 +2570,7 @@ d3d_render_target::~d3d_render_target()
 //  d3d_render_target::init - initializes a render target
 //============================================================
 
-bool d3d_render_target::init(renderer_d3d9 *d3d, int source_width, int source_height, int target_width, int target_height, int screen_index)
+bool d3d_render_target::init(renderer_d3d9 *d3d, int source_width, int source_height, int target_width, int target_height, int screen_index, bool bloom_half, D3DFORMAT bloom_format)
 {
 	HRESULT result;
 
@@ -2611,15 +2611,16 @@ bool d3d_render_target::init(renderer_d3d9 *d3d, int source_width, int source_he
 	float scale_factor = 0.75f;
 	int scale_count = vector_screen ? MAX_BLOOM_COUNT : HALF_BLOOM_COUNT;
 
-	auto bloom_width = (float)source_width;
-	auto bloom_height = (float)source_height;
+	// half-size bloom skips the full-size level, which costs the most to fill and sample
+	auto bloom_width = bloom_half ? (float)source_width * 0.5f : (float)source_width;
+	auto bloom_height = bloom_half ? (float)source_height * 0.5f : (float)source_height;
 	float bloom_size = bloom_width < bloom_height ? bloom_width : bloom_height;
 	for (int bloom_index = 0; bloom_index < scale_count && bloom_size >= 2.0f; bloom_size *= scale_factor)
 	{
 		this->bloom_dims[bloom_index][0] = (int)bloom_width;
 		this->bloom_dims[bloom_index][1] = (int)bloom_height;
 
-		result = d3d->get_device()->CreateTexture((int)bloom_width, (int)bloom_height, 1, D3DUSAGE_RENDERTARGET, D3DFMT_A8R8G8B8, D3DPOOL_DEFAULT, &bloom_texture[bloom_index], nullptr);
+		result = d3d->get_device()->CreateTexture((int)bloom_width, (int)bloom_height, 1, D3DUSAGE_RENDERTARGET, bloom_format, D3DPOOL_DEFAULT, &bloom_texture[bloom_index], nullptr);
 		if (FAILED(result))
 			return false;
 
@@ -313,6 +313,12 @@ public:
 	virtual void save() override { }
 	virtual void record() override { }
 	virtual void toggle_fsfx() override { }
+
+#if !defined(SDLMAME_MACOSX) && !defined(OSD_MAC)
+	// the context is made current at the start of each draw
+	virtual bool can_draw_threaded() const override { return true; }
+#endif
+	virtual void release_thread() override { if (m_gl_context) m_gl_context->release_current(); }
 #endif
 
 private:
@@ -2208,12 +2214,21 @@ static inline void copyline_palette16(uint32_t *dst, const uint16_t *src, int wi
 	assert(xborderpix == 0 || xborderpix == 1);
 	if (xborderpix)
 		*dst++ = 0xff000000 | palette[*src];
-	for (x = 0; x < width; x++)
+	if (xprescale == 1)
+	{
+		// common unscaled case: straight lookup without the inner loop
+		for (x = 0; x < width; x++)
+			*dst++ = 0xff000000 | palette[*src++];
+	}
+	else
 	{
-		int srcpix = *src++;
-		uint32_t dstval = 0xff000000 | palette[srcpix];
-		for (int x2 = 0; x2 < xprescale; x2++)
-			*dst++ = dstval;
+		for (x = 0; x < width; x++)
+		{
+			int srcpix = *src++;
+			uint32_t dstval = 0xff000000 | palette[srcpix];
+			for (int x2 = 0; x2 < xprescale; x2++)
+				*dst++ = dstval;
+		}
 	}
 	if (xborderpix)
 		*dst++ = 0xff000000 | palette[*--src];
@@ -87,6 +87,11 @@ public:
 		(*pfn_wglMakeCurrent)(m_hdc, m_context);
 	}
 
+	virtual void release_current() override
+	{
+		(*pfn_wglMakeCurrent)(nullptr, nullptr);
+	}
+
 	virtual const char *last_error_message() override
 	{
 		if (!m_error.empty())
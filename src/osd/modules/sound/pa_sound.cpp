@@ -21,7 +21,6 @@
 
 #include <algorithm>
 #include <atomic>
-#include <climits>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -54,89 +53,9 @@ public:
 
 	virtual void update_audio_stream(bool is_throttled, const s16 *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual float buffer_fill() override { return m_sample_rate ? m_ab->fill() : -1.0f; }
 
 private:
-	// Lock free SPSC ring buffer
-	template <typename T>
-	struct audio_buffer {
-		T*               buf;
-		int              size;
-		int              reserve;
-		std::atomic<int> playpos, writepos;
-
-		audio_buffer(int size, int reserve) : size(size + reserve), reserve(reserve) {
-			playpos = writepos = 0;
-			buf = new T[this->size];
-		}
-
-		~audio_buffer() { delete[] buf; }
-
-		int count() {
-			int diff = writepos - playpos;
-			return diff < 0 ? size + diff : diff;
-		}
-
-		void increment_writepos(int n) {
-			writepos.store((writepos + n) % size);
-		}
-
-		int write(const T* src, int n, int attenuation) {
-			n = std::min<int>(n, size - reserve - count());
-
-			if (writepos + n > size) {
-				att_memcpy(buf + writepos, src, sizeof(T) * (size - writepos), attenuation);
-				att_memcpy(buf, src + (size - writepos), sizeof(T) * (n - (size - writepos)), attenuation);
-			} else {
-				att_memcpy(buf + writepos, src, sizeof(T) * n, attenuation);
-			}
-
-			increment_writepos(n);
-
-			return n;
-		}
-
-		void increment_playpos(int n) {
-			playpos.store((playpos + n) % size);
-		}
-
-		int read(T* dst, int n) {
-			n = std::min<int>(n, count());
-
-			if (playpos + n > size) {
-				std::memcpy(dst, buf + playpos, sizeof(T) * (size - playpos));
-				std::memcpy(dst + (size - playpos), buf, sizeof(T) * (n - (size - playpos)));
-			} else {
-				std::memcpy(dst, buf + playpos, sizeof(T) * n);
-			}
-
-			increment_playpos(n);
-
-			return n;
-		}
-
-		int clear(int n) {
-			n = std::min<int>(n, size - reserve - count());
-
-			if (writepos + n > size) {
-				std::memset(buf + writepos, 0, sizeof(T) * (size - writepos));
-				std::memset(buf, 0, sizeof(T) * (n - (size - writepos)));
-			} else {
-				std::memset(buf + writepos, 0, sizeof(T) * n);
-			}
-
-			increment_writepos(n);
-
-			return n;
-		}
-
-		void att_memcpy(T* dest, const T* data, int n, int attenuation) {
-			int level = powf(10.0, attenuation / 20.0) * 32768;
-			n /= sizeof(T);
-			while (n--)
-				*dest++ = (*data++ * level) >> 15;
-		}
-	};
-
 	enum
 	{
 		LATENCY_MIN = 0,
@@ -159,20 +78,16 @@ private:
 
 	int                 m_sample_rate;
 	int                 m_audio_latency;
-	int                 m_attenuation;
+	std::atomic<int>    m_attenuation;
 
-	audio_buffer<s16>*  m_ab;
+	ring_buffer*        m_ab;
 
+	std::atomic<bool>   m_started;
 	std::atomic<bool>   m_has_underflowed;
-	std::atomic<bool>   m_has_overflowed;
 	unsigned            m_underflows;
 	unsigned            m_overflows;
 
-	int                 m_skip_threshold; // this many samples in the buffer ~1 second in a row count as an overflow
-	osd_ticks_t         m_osd_ticks;
-	osd_ticks_t         m_skip_threshold_ticks;
-	osd_ticks_t         m_osd_tps;
-	int                 m_buffer_min_ct;
+	int                 m_skip_threshold; // allowed additional buffering, in samples
 
 #if LOG_BUFCNT
 	std::stringstream   m_log;
@@ -196,16 +111,12 @@ int sound_pa::init(osd_interface &osd, osd_options const &options)
 	m_attenuation           = options.volume();
 	m_underflows            = 0;
 	m_overflows             = 0;
-	m_has_overflowed        = false;
+	m_started               = false;
 	m_has_underflowed       = false;
-	m_osd_ticks             = 0;
-	m_skip_threshold_ticks  = 0;
-	m_osd_tps               = osd_ticks_per_second();
-	m_buffer_min_ct         = INT_MAX;
 	m_audio_latency         = std::clamp<int>(options.audio_latency(), LATENCY_MIN, LATENCY_MAX);
 
 	try {
-		m_ab = new audio_buffer<s16>(m_sample_rate, 2);
+		m_ab = new ring_buffer(m_sample_rate, m_sample_rate / 50);
 	} catch (std::bad_alloc&) {
 		osd_printf_error("PortAudio: Unable to allocate audio buffer, sound is disabled\n");
 		goto error;
@@ -288,6 +199,10 @@ int sound_pa::init(osd_interface &osd, osd_options const &options)
 	osd_printf_verbose("PortAudio: Allowed additional buffering latency is %0.2f ms/%d frames\n",
 		(m_skip_threshold / 2.0) / (m_sample_rate / 1000.0), m_skip_threshold / 2);
 
+	// rate control holds the buffer at half the allowed additional latency
+	m_ab->set_target(m_skip_threshold / 4);
+	m_ab->set_rate_control(!options.audio_rate_control());
+
 	err = Pa_StartStream(m_pa_stream);
 
 	if (err != paNoError) goto pa_error;
@@ -342,60 +257,20 @@ PaDeviceIndex sound_pa::list_get_devidx(const char* api_str, const char* device_
 
 int sound_pa::callback(s16* output_buffer, size_t number_of_samples)
 {
-	int buf_ct = m_ab->count();
+	uint32_t const frames = number_of_samples / 2;
+	uint32_t const got = m_ab->read(output_buffer, frames);
 
-	if (buf_ct >= number_of_samples)
+	if (got < frames)
 	{
-		m_ab->read(output_buffer, number_of_samples);
-
-		// keep track of the minimum buffer count, skip samples adaptively to respect the audio_latency setting
-		buf_ct -= number_of_samples;
-
-		if (buf_ct < m_buffer_min_ct)
-			m_buffer_min_ct = buf_ct;
-
-		// if we are below the threshold, reset the counter
-		if (buf_ct < m_skip_threshold)
-			m_skip_threshold_ticks = m_osd_ticks;
-
-		// if we have been above the set threshold for ~1 second, skip forward
-		if (m_osd_ticks - m_skip_threshold_ticks > m_osd_tps)
-		{
-			if (m_audio_latency == 0)
-			{
-				// in very-low-latency mode, always skip forward the whole way
-				// to prevent input from appearing delayed (due to sound cues getting delayed)
-				m_ab->increment_playpos(m_buffer_min_ct);
-				//osd_printf_verbose("PortAudio: skip ahead %d samples\n", m_buffer_min_ct);
-				m_has_overflowed = true;
-			}
-			else
-			{
-				int adjust = m_buffer_min_ct - m_skip_threshold / 2;
-
-				// if adjustment is less than two milliseconds, don't bother
-				if (adjust / 2 > m_sample_rate / 500) {
-					m_ab->increment_playpos(adjust);
-					m_has_overflowed = true;
-				}
-			}
-
-			m_skip_threshold_ticks = m_osd_ticks;
-			m_buffer_min_ct = INT_MAX;
-		}
-	}
-	else
-	{
-		m_ab->read(output_buffer, buf_ct);
-		std::memset(output_buffer + buf_ct, 0, (number_of_samples - buf_ct) * sizeof(s16));
+		std::memset(output_buffer + got * 2, 0, (frames - got) * 2 * sizeof(s16));
 
 		// if update_audio_stream has been called, note the underflow
-		if (m_osd_ticks)
+		if (m_started)
 			m_has_underflowed = true;
-
-		m_skip_threshold_ticks = m_osd_ticks;
 	}
 
+	attenuate(output_buffer, got * 2, m_attenuation);
+
 	return paContinue;
 }
 
@@ -406,27 +281,21 @@ void sound_pa::update_audio_stream(bool is_throttled, const s16 *buffer, int sam
 
 #if LOG_BUFCNT
 	if (m_log.good())
-		m_log << m_ab->count() << std::endl;
+		m_log << m_ab->count() << ' ' << m_ab->ratio() << std::endl;
 #endif
 
 	if (m_has_underflowed)
 	{
 		m_underflows++;
 		// add some silence to prevent immediate underflows
-		m_ab->clear(m_skip_threshold / 4);
+		m_ab->write_silence(m_ab->target() / 2);
 		m_has_underflowed = false;
 	}
 
-	if (m_has_overflowed)
-	{
+	if (m_ab->push(buffer, samples_this_frame))
 		m_overflows++;
-		m_has_overflowed = false;
-	}
-
-	m_ab->write(buffer, samples_this_frame * 2, m_attenuation);
 
-	// for determining buffer overflows, take the sample here instead of in the callback
-	m_osd_ticks = osd_ticks();
+	m_started = true;
 }
 
 void sound_pa::set_mastervolume(int attenuation)
@@ -25,6 +25,7 @@
 #include <pulse/pulseaudio.h>
 
 #include "modules/lib/osdobj_common.h"
+#include "osdsync.h"
 
 using osd::s16;
 using osd::u32;
@@ -262,6 +263,8 @@ void sound_pulse::i_stream_write_request(pa_stream *, size_t size, void *self)
 
 void sound_pulse::mainloop_thread()
 {
+	osd_thread_set_role(osd_thread_role::AUDIO);
+
 	int err = 0;
 	pa_mainloop_run(m_mainloop, &err);
 	if(err)
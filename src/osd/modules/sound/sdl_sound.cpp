@@ -21,6 +21,7 @@
 #include <SDL2/SDL.h>
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <memory>
 
@@ -55,7 +56,6 @@ public:
 		sdl_xfer_samples(SDL_XFER_SAMPLES),
 		stream_in_initialized(0),
 		attenuation(0),
-		buf_locked(0),
 		stream_buffer(nullptr),
 		stream_buffer_size(0),
 		buffer_underflows(0),
@@ -71,30 +71,11 @@ public:
 
 	virtual void update_audio_stream(bool is_throttled, const int16_t *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual float buffer_fill() override { return stream_buffer ? stream_buffer->fill() : -1.0f; }
 
 private:
-	class ring_buffer
-	{
-	public:
-		ring_buffer(size_t size);
-
-		size_t data_size() const { return (tail - head + buffer_size) % buffer_size; }
-		size_t free_size() const { return (head - tail - 1 + buffer_size) % buffer_size; }
-		int append(const void *data, size_t size);
-		int pop(void *data, size_t size);
-
-	private:
-		std::unique_ptr<int8_t []> const buffer;
-		size_t const buffer_size;
-		int head = 0, tail = 0;
-	};
-
 	static void sdl_callback(void *userdata, Uint8 *stream, int len);
 
-	void lock_buffer();
-	void unlock_buffer();
-	void attenuate(int16_t *data, int bytes);
-	void copy_sample_data(bool is_throttled, const int16_t *data, int bytes_to_copy);
 	int sdl_create_buffers();
 	void sdl_destroy_buffers();
 
@@ -103,13 +84,12 @@ private:
 	int stream_in_initialized;
 	int attenuation;
 
-	int              buf_locked;
 	std::unique_ptr<ring_buffer> stream_buffer;
 	uint32_t         stream_buffer_size;
 
 
 	// diagnostics
-	int              buffer_underflows;
+	std::atomic<int> buffer_underflows;
 	int              buffer_overflows;
 	std::unique_ptr<std::ofstream> sound_log;
 };
@@ -122,129 +102,6 @@ private:
 // maximum audio latency
 #define MAX_AUDIO_LATENCY       5
 
-//============================================================
-//  ring_buffer - constructor
-//============================================================
-
-sound_sdl::ring_buffer::ring_buffer(size_t size)
-	: buffer(std::make_unique<int8_t []>(size + 1)), buffer_size(size + 1)
-{
-	// A size+1 bytes buffer is allocated because it can never be full.
-	// Otherwise the case head == tail couldn't be distinguished between a
-	// full buffer and an empty buffer.
-	std::fill_n(buffer.get(), size + 1, 0);
-}
-
-//============================================================
-//  ring_buffer::append
-//============================================================
-
-int sound_sdl::ring_buffer::append(const void *data, size_t size)
-{
-	if (free_size() < size)
-		return -1;
-
-	int8_t const *const data8 = reinterpret_cast<int8_t const *>(data);
-	size_t sz = buffer_size - tail;
-	if (size <= sz)
-		sz = size;
-	else
-		std::copy_n(&data8[sz], size - sz, &buffer[0]);
-
-	std::copy_n(data8, sz, &buffer[tail]);
-	tail = (tail + size) % buffer_size;
-
-	return 0;
-}
-
-//============================================================
-//  ring_buffer::pop
-//============================================================
-
-int sound_sdl::ring_buffer::pop(void *data, size_t size)
-{
-	if (data_size() < size)
-		return -1;
-
-	int8_t *const data8 = reinterpret_cast<int8_t *>(data);
-	size_t sz = buffer_size - head;
-	if (size <= sz)
-		sz = size;
-	else
-	{
-		std::copy_n(&buffer[0], size - sz, &data8[sz]);
-		std::fill_n(&buffer[0], size - sz, 0);
-	}
-
-	std::copy_n(&buffer[head], sz, data8);
-	std::fill_n(&buffer[head], sz, 0);
-	head = (head + size) % buffer_size;
-
-	return 0;
-}
-
-//============================================================
-//  sound_sdl - destructor
-//============================================================
-
-//============================================================
-//  lock_buffer
-//============================================================
-void sound_sdl::lock_buffer()
-{
-	if (!buf_locked)
-		SDL_LockAudio();
-	buf_locked++;
-
-	if (LOG_SOUND)
-		*sound_log << "locking\n";
-}
-
-//============================================================
-//  unlock_buffer
-//============================================================
-void sound_sdl::unlock_buffer()
-{
-	buf_locked--;
-	if (!buf_locked)
-		SDL_UnlockAudio();
-
-	if (LOG_SOUND)
-		*sound_log << "unlocking\n";
-
-}
-
-//============================================================
-//  Apply attenuation
-//============================================================
-
-void sound_sdl::attenuate(int16_t *data, int bytes_to_copy)
-{
-	int level = (int) (pow(10.0, (double) attenuation / 20.0) * 128.0);
-	int count = bytes_to_copy / sizeof(*data);
-	while (count > 0)
-	{
-		*data = (*data * level) >> 7; /* / 128 */
-		data++;
-		count--;
-	}
-}
-
-//============================================================
-//  copy_sample_data
-//============================================================
-
-void sound_sdl::copy_sample_data(bool is_throttled, const int16_t *data, int bytes_to_copy)
-{
-	lock_buffer();
-	int const err = stream_buffer->append(data, bytes_to_copy);
-	unlock_buffer();
-
-	if (LOG_SOUND && err)
-		*sound_log << "Late detection of overflow. This shouldn't happen.\n";
-}
-
-
 //============================================================
 //  update_audio_stream
 //============================================================
@@ -257,34 +114,25 @@ void sound_sdl::update_audio_stream(bool is_throttled, const int16_t *buffer, in
 
 	if (!stream_in_initialized)
 	{
-		// Fill in some zeros to prevent an initial buffer underflow
-		int8_t zero = 0;
-		size_t zsize = stream_buffer->free_size() / 2;
-		while (zsize--)
-			stream_buffer->append(&zero, 1);
+		// fill in some zeros to prevent an initial buffer underflow
+		stream_buffer->write_silence(stream_buffer->target());
 
 		// start playing
 		SDL_PauseAudio(0);
 		stream_in_initialized = 1;
 	}
 
-	size_t bytes_this_frame = samples_this_frame * sizeof(*buffer) * 2;
-	size_t free_size = stream_buffer->free_size();
-	size_t data_size = stream_buffer->data_size();
-
-	if (stream_buffer->free_size() < bytes_this_frame) {
+	uint32_t const data_size = stream_buffer->count();
+	uint32_t const overflow = stream_buffer->push(buffer, samples_this_frame);
+	if (overflow)
+	{
 		if (LOG_SOUND)
-			util::stream_format(*sound_log, "Overflow: DS=%u FS=%u BTF=%u\n", data_size, free_size, bytes_this_frame);
+			util::stream_format(*sound_log, "Overflow: DS=%u FS=%u dropped=%u\n", data_size, stream_buffer->space(), overflow);
 		buffer_overflows++;
-		return;
 	}
 
-	copy_sample_data(is_throttled, buffer, bytes_this_frame);
-
-	size_t nfree_size = stream_buffer->free_size();
-	size_t ndata_size = stream_buffer->data_size();
 	if (LOG_SOUND)
-		util::stream_format(*sound_log, "Appended data: DS=%u(%u) FS=%u(%u) BTF=%u\n", data_size, ndata_size, free_size, nfree_size, bytes_this_frame);
+		util::stream_format(*sound_log, "Appended data: DS=%u(%u) FTF=%d ratio=%f\n", data_size, stream_buffer->count(), samples_this_frame, stream_buffer->ratio());
 }
 
 
@@ -313,28 +161,18 @@ void sound_sdl::set_mastervolume(int _attenuation)
 void sound_sdl::sdl_callback(void *userdata, Uint8 *stream, int len)
 {
 	sound_sdl *thiz = reinterpret_cast<sound_sdl *>(userdata);
-	size_t const free_size = thiz->stream_buffer->free_size();
-	size_t const data_size = thiz->stream_buffer->data_size();
+	int16_t *const samples = reinterpret_cast<int16_t *>(stream);
+	uint32_t const frames = len / (2 * sizeof(int16_t));
 
-	if (data_size < len)
+	// play whatever is there and pad the remainder with silence
+	uint32_t const got = thiz->stream_buffer->read(samples, frames);
+	if (got < frames)
 	{
 		thiz->buffer_underflows++;
-		if (LOG_SOUND)
-			util::stream_format(*thiz->sound_log, "Underflow at sdl_callback: DS=%u FS=%u Len=%d\n", data_size, free_size, len);
-
-		// Maybe read whatever is left in the stream_buffer anyway?
-		memset(stream, 0, len);
-		return;
+		std::fill_n(&samples[got * 2], (frames - got) * 2, 0);
 	}
 
-	int err = thiz->stream_buffer->pop((void *)stream, len);
-	if (LOG_SOUND && err)
-		*thiz->sound_log << "Late detection of underflow. This shouldn't happen.\n";
-
-	thiz->attenuate((int16_t *)stream, len);
-
-	if (LOG_SOUND)
-		util::stream_format(*thiz->sound_log, "callback: xfer DS=%u FS=%u Len=%d\n", data_size, free_size, len);
+	attenuate(samples, got * 2, thiz->attenuation);
 }
 
 
@@ -396,6 +234,7 @@ int sound_sdl::init(osd_interface &osd, const osd_options &options)
 		// create the buffers
 		if (sdl_create_buffers())
 			goto cant_create_buffers;
+		stream_buffer->set_rate_control(!options.audio_rate_control());
 
 		// set the startup volume
 		set_mastervolume(attenuation);
@@ -454,8 +293,10 @@ int sound_sdl::sdl_create_buffers()
 {
 	osd_printf_verbose("sdl_create_buffers: creating stream buffer of %u bytes\n", stream_buffer_size);
 
-	stream_buffer = std::make_unique<ring_buffer>(stream_buffer_size);
-	buf_locked = 0;
+	// aim to keep half the buffer filled, which leaves room for a full
+	// transfer either side of the target
+	uint32_t const frames = stream_buffer_size / (2 * sizeof(int16_t));
+	stream_buffer = std::make_unique<ring_buffer>(frames, std::max<uint32_t>(frames / 2, sdl_xfer_samples));
 	return 0;
 }
 
@@ -9,7 +9,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <memory>
 
 //============================================================
 //  CONSTANTS
@@ -24,6 +28,199 @@ public:
 
 	virtual void update_audio_stream(bool is_throttled, const int16_t *buffer, int samples_this_frame) = 0;
 	virtual void set_mastervolume(int attenuation) = 0;
+
+	// buffer level relative to the target (1.0 = on target), or negative if
+	// the module doesn't know; used by the core's -audio_rate_control
+	virtual float buffer_fill() { return -1.0f; }
+
+protected:
+	// Lock-free single-producer/single-consumer ring of interleaved stereo
+	// 16-bit frames, shared by the OSD sound modules.  The emulation thread
+	// is the only producer (push/write/write_silence) and the host audio
+	// callback is the only consumer (read/discard).
+	//
+	// push() additionally runs a small rate-control loop: it resamples the
+	// incoming frames by a ratio within +/-MAX_RATE_ADJUST of 1.0 chosen to
+	// hold the fill level at the target.  This absorbs the drift between the
+	// emulated and host audio clocks without buffer-sized skips or silence,
+	// which is what lets the target latency be kept small.  The loop can be
+	// disabled when the core is doing rate control from fill() instead.
+	class ring_buffer
+	{
+	public:
+		static constexpr double MAX_RATE_ADJUST = 0.005;
+
+		ring_buffer(uint32_t frames, uint32_t target_frames) :
+			m_capacity(round_up_pow2(std::max<uint32_t>(frames, 16))),
+			m_buffer(std::make_unique<int16_t []>(m_capacity * 2)),
+			m_readpos(0),
+			m_writepos(0),
+			m_target(0),
+			m_rate_control(true),
+			m_average(0.0),
+			m_integral(0.0),
+			m_ratio(1.0),
+			m_frac(0.0),
+			m_prev{ 0, 0 }
+		{
+			std::fill_n(m_buffer.get(), m_capacity * 2, 0);
+			set_target(target_frames);
+		}
+
+		// either side
+		uint32_t capacity() const { return m_capacity; }
+		uint32_t count() const { return m_writepos.load(std::memory_order_acquire) - m_readpos.load(std::memory_order_acquire); }
+		uint32_t space() const { return m_capacity - count(); }
+		uint32_t target() const { return m_target; }
+		double ratio() const { return m_ratio; }
+		float fill() const { return float(count()) / float(m_target); }
+
+		// producer side
+		void set_target(uint32_t frames)
+		{
+			m_target = std::clamp<uint32_t>(frames, 1, m_capacity - 1);
+			m_average = m_target;
+		}
+
+		void set_rate_control(bool enable)
+		{
+			m_rate_control = enable;
+			m_integral = 0.0;
+			m_ratio = 1.0;
+		}
+
+		uint32_t write(const int16_t *data, uint32_t frames)
+		{
+			uint32_t const writepos = m_writepos.load(std::memory_order_relaxed);
+			frames = std::min(frames, m_capacity - (writepos - m_readpos.load(std::memory_order_acquire)));
+			uint32_t const start = writepos & (m_capacity - 1);
+			uint32_t const chunk = std::min(frames, m_capacity - start);
+			std::copy_n(data, chunk * 2, &m_buffer[start * 2]);
+			std::copy_n(data + chunk * 2, (frames - chunk) * 2, &m_buffer[0]);
+			m_writepos.store(writepos + frames, std::memory_order_release);
+			return frames;
+		}
+
+		uint32_t write_silence(uint32_t frames)
+		{
+			uint32_t const writepos = m_writepos.load(std::memory_order_relaxed);
+			frames = std::min(frames, m_capacity - (writepos - m_readpos.load(std::memory_order_acquire)));
+			uint32_t const start = writepos & (m_capacity - 1);
+			uint32_t const chunk = std::min(frames, m_capacity - start);
+			std::fill_n(&m_buffer[start * 2], chunk * 2, 0);
+			std::fill_n(&m_buffer[0], (frames - chunk) * 2, 0);
+			m_writepos.store(writepos + frames, std::memory_order_release);
+			return frames;
+		}
+
+		// resample by the current rate-control ratio and write; returns the
+		// number of frames that did not fit (overflowed)
+		uint32_t push(const int16_t *data, uint32_t frames)
+		{
+			if (frames == 0)
+				return 0;
+
+			// without rate control this is just a write
+			if (!m_rate_control)
+				return frames - write(data, frames);
+
+			// update the ratio from the smoothed fill level; a ratio above 1.0
+			// consumes input faster than it produces output and drains the ring
+			m_average += (double(count()) - m_average) * (1.0 / 16.0);
+
+			// the integral term absorbs the steady clock drift so that the
+			// proportional term is left centred on the target
+			double const error = (m_average - m_target) / m_target;
+			m_integral = std::clamp(m_integral + error * (MAX_RATE_ADJUST / 64.0), -MAX_RATE_ADJUST, MAX_RATE_ADJUST);
+			m_ratio = 1.0 + std::clamp(error * MAX_RATE_ADJUST + m_integral, -MAX_RATE_ADJUST, MAX_RATE_ADJUST);
+
+			// linear interpolation over the input with the last frame of the
+			// previous block at position -1
+			int16_t block[2 * 256];
+			uint32_t blockframes = 0;
+			uint32_t overflow = 0;
+			double pos = m_frac - 1.0;
+			double const last = double(frames - 1);
+			while (pos < last)
+			{
+				int const index = int(std::floor(pos));
+				float const frac = float(pos - index);
+				int16_t const *const a = (index < 0) ? m_prev : &data[index * 2];
+				int16_t const *const b = &data[(index + 1) * 2];
+				block[blockframes * 2 + 0] = int16_t(std::lround(a[0] + (b[0] - a[0]) * frac));
+				block[blockframes * 2 + 1] = int16_t(std::lround(a[1] + (b[1] - a[1]) * frac));
+				if (++blockframes == 256)
+				{
+					overflow += blockframes - write(block, blockframes);
+					blockframes = 0;
+				}
+				pos += m_ratio;
+			}
+			overflow += blockframes - write(block, blockframes);
+
+			m_frac = pos - last;
+			m_prev[0] = data[(frames - 1) * 2 + 0];
+			m_prev[1] = data[(frames - 1) * 2 + 1];
+			return overflow;
+		}
+
+		// consumer side
+		uint32_t read(int16_t *data, uint32_t frames)
+		{
+			uint32_t const readpos = m_readpos.load(std::memory_order_relaxed);
+			frames = std::min(frames, m_writepos.load(std::memory_order_acquire) - readpos);
+			uint32_t const start = readpos & (m_capacity - 1);
+			uint32_t const chunk = std::min(frames, m_capacity - start);
+			std::copy_n(&m_buffer[start * 2], chunk * 2, data);
+			std::copy_n(&m_buffer[0], (frames - chunk) * 2, data + chunk * 2);
+			m_readpos.store(readpos + frames, std::memory_order_release);
+			return frames;
+		}
+
+		uint32_t discard(uint32_t frames)
+		{
+			uint32_t const readpos = m_readpos.load(std::memory_order_relaxed);
+			frames = std::min(frames, m_writepos.load(std::memory_order_acquire) - readpos);
+			m_readpos.store(readpos + frames, std::memory_order_release);
+			return frames;
+		}
+
+	private:
+		static uint32_t round_up_pow2(uint32_t value)
+		{
+			uint32_t result = 1;
+			while (result < value)
+				result <<= 1;
+			return result;
+		}
+
+		uint32_t const m_capacity;
+		std::unique_ptr<int16_t []> const m_buffer;
+		std::atomic<uint32_t> m_readpos;
+		std::atomic<uint32_t> m_writepos;
+
+		// producer-only rate control state
+		uint32_t m_target;
+		bool m_rate_control;
+		double m_average;
+		double m_integral;
+		double m_ratio;
+		double m_frac;
+		int16_t m_prev[2];
+	};
+
+	// scale interleaved samples by an attenuation in dB
+	static void attenuate(int16_t *data, uint32_t samples, int attenuation)
+	{
+		if (attenuation == 0)
+			return;
+		int const level = int(std::pow(10.0, attenuation / 20.0) * 32768.0);
+		while (samples--)
+		{
+			*data = int16_t((*data * level) >> 15);
+			data++;
+		}
+	}
 };
 
 #endif // MAME_OSD_SOUND_SOUND_MODULE_H
@@ -17,6 +17,7 @@
 #include "modules/lib/osdobj_common.h"
 #include "osdcore.h"
 #include "osdepend.h"
+#include "osdsync.h"
 #include "windows/winutil.h"
 
 // stdlib includes
@@ -560,6 +561,8 @@ HRESULT sound_xaudio2::create_voices(const WAVEFORMATEX &format)
 // submits audio events on another thread in a loop
 void sound_xaudio2::process_audio()
 {
+	osd_thread_set_role(osd_thread_role::AUDIO);
+
 	BOOL exiting = FALSE;
 	HANDLE hEvents[] = { m_hEventBufferCompleted, m_hEventDataAvailable, m_hEventExiting };
 	while (!exiting)
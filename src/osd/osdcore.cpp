@@ -12,8 +12,11 @@
 #ifdef _WIN32
 #include <windows.h>
 #include <cstdio>
+#include <psapi.h>
 #include <shellapi.h>
 #include "strconv.h"
+#elif !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
 #endif
 
 static const int MAXSTACK = 10;
@@ -217,3 +220,29 @@ std::vector<std::string> osd_get_command_line(int argc, char *argv[])
 #endif // _WIN32
 	return results;
 }
+
+
+//============================================================
+//  osd_get_peak_memory_usage
+//============================================================
+
+uint64_t osd_get_peak_memory_usage() noexcept
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize;
+#elif defined(__EMSCRIPTEN__)
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage))
+		return 0;
+#if defined(__APPLE__)
+	return uint64_t(usage.ru_maxrss); // bytes on macOS
+#else
+	return uint64_t(usage.ru_maxrss) * 1024; // kilobytes elsewhere
+#endif
+#endif
+}
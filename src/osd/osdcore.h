@@ -174,8 +174,8 @@ typedef void *(*osd_work_callback)(void *param, int threadid);
 
             WORK_QUEUE_FLAG_HIGH_FREQ - indicates that items are expected
                 to be queued at high frequency and acted upon quickly; in
-                general, this implies doing some spin-waiting internally
-                before falling back to OS-specific synchronization
+                general, this implies running them ahead of items from
+                other queues sharing the same threads
 
     Return value:
 
@@ -336,6 +336,33 @@ void *osd_work_item_result(osd_work_item *item);
 void osd_work_item_release(osd_work_item *item);
 
 
+/* osd_work_trace_callback is told when each work item ran, on the thread
+   that ran it */
+typedef void (*osd_work_trace_callback)(osd_ticks_t start, osd_ticks_t end);
+
+
+/*-----------------------------------------------------------------------------
+    osd_work_set_trace_callback: set a function to be called after each work
+        item is processed
+
+    Parameters:
+
+        callback - function to call with the start and end time of each work
+            item, or nullptr to stop tracing
+
+    Return value:
+
+        None.
+
+    Notes:
+
+        The callback is shared by all work queues and may be called from any
+        thread that processes work items, including threads waiting on a
+        queue.
+-----------------------------------------------------------------------------*/
+void osd_work_set_trace_callback(osd_work_trace_callback callback);
+
+
 
 /***************************************************************************
     MISCELLANEOUS INTERFACES
@@ -632,6 +659,9 @@ template <typename Format, typename... Params> void osd_printf_debug(Format &&fm
 // returns command line arguments as an std::vector<std::string> in UTF-8
 std::vector<std::string> osd_get_command_line(int argc, char *argv[]);
 
+// returns the most physical memory the process has used in bytes, or zero if unknown
+uint64_t osd_get_peak_memory_usage() noexcept;
+
 /* discourage the use of printf directly */
 /* sadly, can't do this because of the ATTR_PRINTF under GCC */
 /*
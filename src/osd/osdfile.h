@@ -13,6 +13,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -159,6 +160,85 @@ public:
 };
 
 
+/// \brief Private mapping of a file into memory
+///
+/// Pages are read from the file when they're first touched.  The
+/// mapping is copy-on-write: memory may be modified, but changes are
+/// private to the mapping and never reach the file.
+class osd_file_mapping
+{
+public:
+	/// \brief Smart pointer to a file mapping
+	typedef std::unique_ptr<osd_file_mapping> ptr;
+
+	/// \brief Map the beginning of a file
+	///
+	/// \param [in] path Path to the file to map.
+	/// \param [in] length Number of bytes to map from the start of the
+	///   file.  Must not be zero and must not exceed the file size.
+	/// \param [out] mapping Receives the mapping if the operation
+	///   succeeds.  Not valid if the operation fails.
+	/// \return Result of the operation.  Platforms that can't map files
+	///   return std::errc::not_supported.
+	static std::error_condition open(std::string const &path, std::size_t length, ptr &mapping) noexcept;
+
+	/// \brief Unmap the file
+	virtual ~osd_file_mapping() { }
+
+	/// \brief Get the mapped memory
+	///
+	/// \return Pointer to the first mapped byte.
+	virtual void *data() noexcept = 0;
+
+	/// \brief Get the size of the mapping
+	///
+	/// \return Number of bytes mapped.
+	virtual std::size_t size() const noexcept = 0;
+};
+
+
+/// \brief Named memory shared with other processes
+///
+/// Creates a block of memory that other processes can open by name
+/// while it exists.  The name is removed when the object is destroyed,
+/// although processes that already have it open can continue to use
+/// it.
+class osd_shared_memory
+{
+public:
+	/// \brief Smart pointer to shared memory
+	typedef std::unique_ptr<osd_shared_memory> ptr;
+
+	/// \brief Create shared memory
+	///
+	/// \param [in] name Name other processes use to open the memory.
+	///   Should consist of letters, digits, dots, hyphens and
+	///   underscores.  Any existing memory with the same name is
+	///   replaced.  On POSIX systems the object is named
+	///   /mame-<uid>-<name> and only the current user can open it.
+	/// \param [in] length Size of the memory in bytes.  Must not be
+	///   zero.  The memory is initially filled with zero.
+	/// \param [out] memory Receives the shared memory if the operation
+	///   succeeds.  Not valid if the operation fails.
+	/// \return Result of the operation.  Platforms that can't share
+	///   memory return std::errc::not_supported.
+	static std::error_condition create(std::string const &name, std::size_t length, ptr &memory) noexcept;
+
+	/// \brief Unmap and remove the name
+	virtual ~osd_shared_memory() { }
+
+	/// \brief Get the shared memory
+	///
+	/// \return Pointer to the first byte.
+	virtual void *data() noexcept = 0;
+
+	/// \brief Get the size of the shared memory
+	///
+	/// \return Size in bytes.
+	virtual std::size_t size() const noexcept = 0;
+};
+
+
 /// \brief Describe geometry of physical drive
 ///
 /// If the given path points to a physical drive, return the geometry of
@@ -18,6 +18,8 @@
 #endif
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <thread>
 #include <vector>
 #include <algorithm>
@@ -31,6 +33,18 @@
 #include <pthread.h>
 #endif
 
+#if defined(__linux__) && !defined(SDLMAME_EMSCRIPTEN)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
 //============================================================
 //  DEBUGGING
 //============================================================
@@ -44,7 +58,8 @@
 #define ENV_PROCESSORS               "OSDPROCESSORS"
 #define ENV_WORKQUEUEMAXTHREADS      "OSDWORKQUEUEMAXTHREADS"
 
-#define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
+// most queues that can share the thread pool at once; any more run their items immediately
+#define MAX_POOL_QUEUES         256
 
 //============================================================
 //  MACROS
@@ -52,35 +67,10 @@
 
 #if KEEP_STATISTICS
 #define add_to_stat(v,x)        do { (v) += (x); } while (0)
-#define begin_timing(v)         do { (v) -= get_profile_ticks(); } while (0)
-#define end_timing(v)           do { (v) += get_profile_ticks(); } while (0)
 #else
 #define add_to_stat(v,x)        do { } while (0)
-#define begin_timing(v)         do { } while (0)
-#define end_timing(v)           do { } while (0)
 #endif
 
-template<typename _AtomType, typename _MainType>
-static void spin_while(const volatile _AtomType * volatile atom, const _MainType val, const osd_ticks_t timeout, const int invert = 0)
-{
-	osd_ticks_t stopspin = osd_ticks() + timeout;
-
-	do {
-		int spin = 10000;
-		while (--spin)
-		{
-			if ((*atom != val) ^ invert)
-				return;
-		}
-	} while (((*atom == val) ^ invert) && osd_ticks() < stopspin);
-}
-
-template<typename _AtomType, typename _MainType>
-static void spin_while_not(const volatile _AtomType * volatile atom, const _MainType val, const osd_ticks_t timeout)
-{
-	spin_while<_AtomType, _MainType>(atom, val, timeout, 1);
-}
-
 //============================================================
 //  osd_num_processors
 //============================================================
@@ -98,82 +88,408 @@ int osd_get_num_processors(bool heavy_mt)
 }
 
 //============================================================
-//  TYPE DEFINITIONS
+//  THREAD ROLES
 //============================================================
 
-struct work_thread_info
+struct thread_role_setting
 {
-	work_thread_info(uint32_t aid, osd_work_queue &aqueue)
-		: queue(aqueue)
-		, handle(nullptr)
-		, wakeevent(true, false)  // manual reset, not signalled
-		, id(aid)
-#if KEEP_STATISTICS
-		, itemsdone(0)
-		, actruntime(0)
-		, runtime(0)
-		, spintime(0)
-		, waittime(0)
-#endif
+	enum class placement { AUTO, ANY, PERFORMANCE, NODE, LIST };
+
+	placement               where = placement::AUTO;
+	std::vector<unsigned>   processors;             // for LIST
+	bool                    prioritised = false;    // priority was given
+	int                     priority = 0;
+};
+
+static char const *const s_thread_role_names[int(osd_thread_role::COUNT)] = { "emulation", "audio", "work", "io" };
+
+static std::mutex s_thread_role_lock;
+static thread_role_setting s_thread_roles[int(osd_thread_role::COUNT)];
+
+// processor the emulation thread was on when it took on its role, or -1
+static std::atomic<int> s_emulation_processor(-1);
+
+
+//-------------------------------------------------
+//  parse_processor_list - parse processor numbers
+//  and ranges like "0-3,8", as used by sysfs too
+//-------------------------------------------------
+
+static bool parse_processor_list(std::string text, std::vector<unsigned> &processors)
+{
+	processors.clear();
+	while (!text.empty() && std::isspace(uint8_t(text.back())))
+		text.pop_back();
+
+	char const *pos = text.c_str();
+	while (*pos)
 	{
+		unsigned first, last;
+		int chars;
+		if (sscanf(pos, "%u-%u%n", &first, &last, &chars) != 2)
+		{
+			if (sscanf(pos, "%u%n", &first, &chars) != 1)
+				return false;
+			last = first;
+		}
+		if ((last < first) || (last >= 1024))
+			return false;
+		for (unsigned processor = first; processor <= last; processor++)
+			processors.push_back(processor);
+
+		pos += chars;
+		if (*pos == ',')
+			pos++;
+		else if (*pos)
+			return false;
 	}
+	return !processors.empty();
+}
 
-	osd_work_queue &    queue;          // pointer back to the queue
-	std::thread *       handle;         // handle to the thread
-	osd_event           wakeevent;      // wake event for the thread
-	uint32_t            id;
 
-#if KEEP_STATISTICS
-	int32_t             itemsdone;
-	osd_ticks_t         actruntime;
-	osd_ticks_t         runtime;
-	osd_ticks_t         spintime;
-	osd_ticks_t         waittime;
-#endif
-};
+#if defined(__linux__) && !defined(SDLMAME_EMSCRIPTEN)
 
+static bool read_text_file(char const *path, std::string &text)
+{
+	FILE *const file = std::fopen(path, "r");
+	if (!file)
+		return false;
+	char buffer[4096];
+	size_t const length = std::fread(buffer, 1, sizeof(buffer), file);
+	std::fclose(file);
+	text.assign(buffer, length);
+	return true;
+}
 
-struct osd_work_queue
+static std::vector<unsigned> all_processors()
 {
-	osd_work_queue()
-		: list(nullptr)
-		, tailptr(nullptr)
-		, free(nullptr)
-		, items(0)
-		, livethreads(0)
-		, waiting(0)
-		, exiting(0)
-		, threads(0)
-		, flags(0)
-		, doneevent(true, true)     // manual reset, signalled
-#if KEEP_STATISTICS
-		, itemsqueued(0)
-		, setevents(0)
-		, extraitems(0)
-		, spinloops(0)
-#endif
+	std::string text;
+	std::vector<unsigned> result;
+	if (!read_text_file("/sys/devices/system/cpu/online", text) || !parse_processor_list(text, result))
+		result.clear();
+	return result;
+}
+
+static std::vector<unsigned> performance_processors()
+{
+	std::vector<unsigned> const online = all_processors();
+
+	// heterogeneous ARM systems report a capacity; otherwise go by the fastest clock
+	std::vector<std::pair<unsigned, unsigned long> > capacities;
+	unsigned long best = 0;
+	for (unsigned processor : online)
 	{
+		char path[128];
+		std::string text;
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cpu_capacity", processor);
+		if (!read_text_file(path, text))
+		{
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq", processor);
+			if (!read_text_file(path, text))
+				return std::vector<unsigned>();
+		}
+		unsigned long const capacity = std::strtoul(text.c_str(), nullptr, 10);
+		capacities.emplace_back(processor, capacity);
+		best = std::max(best, capacity);
 	}
 
-	std::mutex          lock;           // lock for protecting the queue
-	std::atomic<osd_work_item *> list;  // list of items in the queue
-	osd_work_item ** volatile tailptr;  // pointer to the tail pointer of work items in the queue
-	std::atomic<osd_work_item *> free;  // free list of work items
-	std::atomic<int32_t>  items;          // items in the queue
-	std::atomic<int32_t>  livethreads;    // number of live threads
-	std::atomic<int32_t>  waiting;        // is someone waiting on the queue to complete?
-	std::atomic<int32_t>  exiting;        // should the threads exit on their next opportunity?
-	uint32_t              threads;        // number of threads in this queue
-	uint32_t              flags;          // creation flags
-	std::vector<work_thread_info *>  thread;         // array of thread information
-	osd_event           doneevent;      // event signalled when work is complete
+	// a few favoured cores may clock a little higher than the rest of the performance cores
+	std::vector<unsigned> result;
+	for (auto const &capacity : capacities)
+	{
+		if (capacity.second >= (best - (best / 10)))
+			result.push_back(capacity.first);
+	}
+	if (result.size() == online.size())
+		result.clear();
+	return result;
+}
+
+static std::vector<unsigned> node_processors(unsigned processor)
+{
+	std::string text;
+	std::vector<unsigned> nodes, result;
+	if (!read_text_file("/sys/devices/system/node/online", text) || !parse_processor_list(text, nodes) || (nodes.size() < 2))
+		return result;
+
+	for (unsigned node : nodes)
+	{
+		char path[128];
+		snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+		if (read_text_file(path, text) && parse_processor_list(text, result) && (std::find(result.begin(), result.end(), processor) != result.end()))
+			return result;
+	}
+	result.clear();
+	return result;
+}
+
+static bool set_thread_affinity(std::vector<unsigned> const &processors)
+{
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (unsigned processor : processors)
+	{
+		if (processor < CPU_SETSIZE)
+			CPU_SET(processor, &set);
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+static bool set_thread_priority(int priority)
+{
+	// threads have their own nice values; raising priority needs privileges
+	return setpriority(PRIO_PROCESS, id_t(syscall(SYS_gettid)), std::clamp(-priority, -20, 19)) == 0;
+}
+
+static int current_processor()
+{
+	return sched_getcpu();
+}
+
+#elif defined(OSD_WINDOWS) || defined(SDLMAME_WIN32)
+
+// only the first processor group is handled, as thread affinity can't span groups
+
+static std::vector<unsigned> mask_processors(DWORD_PTR mask)
+{
+	std::vector<unsigned> result;
+	for (unsigned processor = 0; processor < (8 * sizeof(mask)); processor++)
+	{
+		if ((mask >> processor) & 1)
+			result.push_back(processor);
+	}
+	return result;
+}
+
+static std::vector<unsigned> all_processors()
+{
+	DWORD_PTR process, system;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &process, &system))
+		return std::vector<unsigned>();
+	return mask_processors(process);
+}
+
+static std::vector<unsigned> performance_processors()
+{
+	DWORD length = 0;
+	GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+	std::unique_ptr<uint8_t []> buffer(new (std::nothrow) uint8_t [length]);
+	if (!buffer || !GetLogicalProcessorInformationEx(RelationProcessorCore, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.get()), &length))
+		return std::vector<unsigned>();
+
+	// cores with the highest efficiency class are the fastest
+	DWORD_PTR classes[256] = { 0 };
+	int lowest = 255, highest = 0;
+	for (DWORD offset = 0; offset < length; )
+	{
+		auto const &info = *reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(&buffer[offset]);
+		int const efficiency = info.Processor.EfficiencyClass;
+		if (!info.Processor.GroupMask[0].Group)
+			classes[efficiency] |= info.Processor.GroupMask[0].Mask;
+		lowest = std::min(lowest, efficiency);
+		highest = std::max(highest, efficiency);
+		offset += info.Size;
+	}
+	if (lowest == highest)
+		return std::vector<unsigned>();
+	return mask_processors(classes[highest]);
+}
+
+static std::vector<unsigned> node_processors(unsigned processor)
+{
+	ULONG highest;
+	UCHAR node;
+	ULONGLONG mask;
+	if (!GetNumaHighestNodeNumber(&highest) || !highest || !GetNumaProcessorNode(UCHAR(processor), &node) || !GetNumaNodeProcessorMask(node, &mask))
+		return std::vector<unsigned>();
+	return mask_processors(DWORD_PTR(mask));
+}
+
+static bool set_thread_affinity(std::vector<unsigned> const &processors)
+{
+	DWORD_PTR mask = 0;
+	for (unsigned processor : processors)
+	{
+		if (processor < (8 * sizeof(mask)))
+			mask |= DWORD_PTR(1) << processor;
+	}
+	return mask && SetThreadAffinityMask(GetCurrentThread(), mask);
+}
+
+static bool set_thread_priority(int priority)
+{
+	return SetThreadPriority(GetCurrentThread(), std::clamp(priority, int(THREAD_PRIORITY_LOWEST), int(THREAD_PRIORITY_HIGHEST)));
+}
+
+static int current_processor()
+{
+	return int(GetCurrentProcessorNumber());
+}
+
+#else
+
+// nothing to go on, so roles don't do anything
+
+static std::vector<unsigned> all_processors() { return std::vector<unsigned>(); }
+static std::vector<unsigned> performance_processors() { return std::vector<unsigned>(); }
+static std::vector<unsigned> node_processors(unsigned processor) { return std::vector<unsigned>(); }
+static bool set_thread_affinity(std::vector<unsigned> const &processors) { return false; }
+static bool set_thread_priority(int priority) { return false; }
+static int current_processor() { return -1; }
 
-#if KEEP_STATISTICS
-	std::atomic<int32_t>  itemsqueued;    // total items queued
-	std::atomic<int32_t>  setevents;      // number of times we called SetEvent
-	std::atomic<int32_t>  extraitems;     // how many extra items we got after the first in the queue loop
-	std::atomic<int32_t>  spinloops;      // how many times spinning bought us more items
 #endif
+
+
+//-------------------------------------------------
+//  osd_thread_configure_roles
+//-------------------------------------------------
+
+bool osd_thread_configure_roles(const char *affinity, const char *priority)
+{
+	thread_role_setting roles[int(osd_thread_role::COUNT)];
+	bool ok = true;
+
+	// both are lists of role=value
+	auto const parse = [&roles, &ok] (const char *list, auto &&apply)
+	{
+		std::string const text(list ? list : "");
+		std::string::size_type start = 0;
+		while (start < text.length())
+		{
+			std::string::size_type end = text.find(';', start);
+			if (end == std::string::npos)
+				end = text.length();
+			std::string const entry = text.substr(start, end - start);
+			start = end + 1;
+			if (entry.empty() || (entry == "auto"))
+				continue;
+
+			std::string::size_type const equals = entry.find('=');
+			auto const role = (equals == std::string::npos) ? std::end(s_thread_role_names) : std::find_if(
+					std::begin(s_thread_role_names),
+					std::end(s_thread_role_names),
+					[&entry, equals] (char const *name) { return entry.compare(0, equals, name) == 0; });
+			if ((role == std::end(s_thread_role_names)) || !apply(roles[role - std::begin(s_thread_role_names)], entry.substr(equals + 1)))
+			{
+				osd_printf_warning("Ignoring invalid thread role setting %s\n", entry);
+				ok = false;
+			}
+		}
+	};
+
+	parse(affinity, [] (thread_role_setting &role, std::string const &value)
+	{
+		using placement = thread_role_setting::placement;
+		if (value == "auto")
+			role.where = placement::AUTO;
+		else if (value == "any")
+			role.where = placement::ANY;
+		else if (value == "performance")
+			role.where = placement::PERFORMANCE;
+		else if (value == "node")
+			role.where = placement::NODE;
+		else if (parse_processor_list(value, role.processors))
+			role.where = placement::LIST;
+		else
+			return false;
+		return true;
+	});
+
+	parse(priority, [] (thread_role_setting &role, std::string const &value)
+	{
+		char *end;
+		long const result = std::strtol(value.c_str(), &end, 10);
+		if (value.empty() || *end)
+			return false;
+		role.prioritised = true;
+		role.priority = int(std::clamp(result, -15L, 15L));
+		return true;
+	});
+
+	std::lock_guard<std::mutex> lock(s_thread_role_lock);
+	std::copy(std::begin(roles), std::end(roles), std::begin(s_thread_roles));
+	return ok;
+}
+
+
+//-------------------------------------------------
+//  osd_thread_set_role
+//-------------------------------------------------
+
+void osd_thread_set_role(osd_thread_role role)
+{
+	using placement = thread_role_setting::placement;
+
+	thread_role_setting setting;
+	{
+		std::lock_guard<std::mutex> lock(s_thread_role_lock);
+		setting = s_thread_roles[int(role)];
+	}
+
+	// keep the emulation thread on fast processors, and the threads it
+	// hands work to near its memory
+	placement where = setting.where;
+	if (where == placement::AUTO)
+	{
+		switch (role)
+		{
+		case osd_thread_role::EMULATION:    where = placement::PERFORMANCE; break;
+		case osd_thread_role::WORK:         where = placement::NODE;        break;
+		default:                            where = placement::ANY;         break;
+		}
+	}
+
+	// threads inherit their creator's affinity, so even "any" needs setting
+	std::vector<unsigned> processors;
+	switch (where)
+	{
+	case placement::PERFORMANCE:
+		processors = performance_processors();
+		break;
+	case placement::NODE:
+		if (s_emulation_processor >= 0)
+			processors = node_processors(unsigned(s_emulation_processor.load()));
+		break;
+	case placement::LIST:
+		processors = setting.processors;
+		break;
+	default:
+		break;
+	}
+	if (processors.empty())
+		processors = all_processors();
+
+	char const *const name = s_thread_role_names[int(role)];
+	if (!processors.empty() && !set_thread_affinity(processors))
+		osd_printf_verbose("Couldn't set %s thread processor affinity\n", name);
+	if (setting.prioritised && !set_thread_priority(setting.priority))
+		osd_printf_verbose("Couldn't set %s thread priority to %d\n", name, setting.priority);
+
+	if (role == osd_thread_role::EMULATION)
+		s_emulation_processor = current_processor();
+}
+
+
+//============================================================
+//  TYPE DEFINITIONS
+//============================================================
+
+class work_pool;
+
+// which threads run a queue's items
+enum
+{
+	POOL_COMPUTE = 0,                   // shared by all queues that compute
+	POOL_IO,                            // for queues whose items block on I/O
+	POOL_KINDS
+};
+
+// queues queued at high frequency are waited on by the caller, so they go first
+enum
+{
+	PRIORITY_HIGH = 0,
+	PRIORITY_NORMAL,
+	PRIORITY_LEVELS
 };
 
 
@@ -201,20 +517,126 @@ struct osd_work_item
 	std::atomic<int32_t>  done;           // is the item done?
 };
 
+
+// Queues don't own threads.  Each one is registered with the process-wide
+// pool, whose threads take items from any queue that has them, highest
+// priority first, as long as the queue isn't already running as many
+// items as it's allowed to.  A freed queue stays registered so no thread
+// can be left looking at freed memory, and is reused by the next queue
+// allocated with the same flags.
+struct osd_work_queue
+{
+	osd_work_queue(work_pool &apool, uint32_t aflags, int athreads, int akind)
+		: pool(apool)
+		, list(nullptr)
+		, tailptr(&list)
+		, free(nullptr)
+		, items(0)
+		, pending(0)
+		, active(0)
+		, waiting(0)
+		, flags(aflags)
+		, kind(akind)
+		, priority((aflags & WORK_QUEUE_FLAG_HIGH_FREQ) ? PRIORITY_HIGH : PRIORITY_NORMAL)
+		, limit(athreads ? (athreads + ((aflags & WORK_QUEUE_FLAG_MULTI) ? 1 : 0)) : 0)
+		, inuse(true)
+		, doneevent(true, true)     // manual reset, signalled
+#if KEEP_STATISTICS
+		, itemsqueued(0)
+		, inlineitems(0)
+#endif
+	{
+	}
+
+	work_pool &         pool;           // pool running the items
+	std::mutex          lock;           // lock for protecting the lists
+	osd_work_item *     list;           // list of items waiting to run
+	osd_work_item **    tailptr;        // pointer to the tail pointer of work items in the queue
+	osd_work_item *     free;           // free list of work items
+	std::atomic<int32_t>  items;          // items queued or running
+	std::atomic<int32_t>  pending;        // items waiting for a thread
+	std::atomic<int32_t>  active;         // threads running items, or about to
+	std::atomic<int32_t>  waiting;        // is someone waiting on the queue to complete?
+	uint32_t const      flags;          // creation flags
+	int const           kind;           // pool threads that run the items
+	int const           priority;       // order the pool looks at queues in
+	int32_t const       limit;          // most items run at once, counting a caller that helps; 0 runs them when queued
+	bool                inuse;          // allocated, as opposed to waiting for reuse
+	osd_event           doneevent;      // event signalled when work is complete
+
+#if KEEP_STATISTICS
+	std::atomic<int32_t>  itemsqueued;    // total items queued
+	std::atomic<int32_t>  inlineitems;    // items run by threads that queued or waited for them
+#endif
+};
+
+
+// ======================> work_pool
+
+class work_pool
+{
+public:
+	work_pool();
+	~work_pool();
+
+	osd_work_queue *attach(uint32_t flags);
+	bool detach(osd_work_queue &queue);
+	void wake(int kind, int32_t count);
+
+	// thread ID for a thread helping a queue it doesn't belong to
+	int caller_id() const { return m_computethreads; }
+
+private:
+	// sleeping threads are woken by bumping the generation
+	struct parking
+	{
+		std::mutex              mutex;
+		std::condition_variable cond;
+		std::atomic<int32_t>    sleeping { 0 };
+		std::atomic<uint32_t>   generation { 0 };
+	};
+
+	void start_thread(int kind, int id);
+	void worker(int kind, int id);
+	bool run_any(int kind, int id);
+	bool has_work(int kind) const;
+
+	int                             m_computethreads;   // threads shared by compute queues
+	int                             m_maxthreads;       // OSDWORKQUEUEMAXTHREADS, or -1
+	std::vector<std::thread>        m_threads;          // all the pool's threads
+	int                             m_iothreads;        // threads for I/O queues
+	int                             m_ioqueues;         // I/O queues allocated
+	std::atomic<osd_work_queue *>   m_queues[MAX_POOL_QUEUES]; // queues registered, allocated or not
+	std::atomic<int>                m_queuecount;       // entries used in m_queues
+	int                             m_allocated;        // queues allocated
+	std::atomic<bool>               m_exiting;          // threads should exit
+	parking                         m_parking[POOL_KINDS];
+};
+
 //============================================================
 //  GLOBAL VARIABLES
 //============================================================
 
 int osd_num_processors = 0;
 
+static std::atomic<osd_work_trace_callback> s_work_trace_callback(nullptr);
+
+// the pool exists while any queue does
+static std::mutex s_pool_lock;
+static std::unique_ptr<work_pool> s_pool;
+
+// pool thread ID of the current thread, or -1 for threads the pool doesn't own
+static thread_local int s_pool_thread_id = -1;
+
 //============================================================
 //  FUNCTION PROTOTYPES
 //============================================================
 
 static int effective_num_processors(bool heavy_mt);
-static void *worker_thread_entry(void *param);
-static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
-static bool queue_has_list_items(osd_work_queue *queue);
+static osd_work_item *take_item(osd_work_queue &queue);
+static void run_item(osd_work_item &item, int threadid);
+static bool run_one(osd_work_queue &queue, int threadid);
+static int helper_id(osd_work_queue &queue);
 
 //============================================================
 //  osd_thread_adjust_priority
@@ -244,86 +666,15 @@ int thread_adjust_priority(std::thread *thread, int adjust)
 	return true;
 }
 
-//============================================================
 //  osd_work_queue_alloc
 //============================================================
 
 osd_work_queue *osd_work_queue_alloc(int flags)
 {
-	int threadnum;
-	int numprocs = effective_num_processors(!(flags & WORK_QUEUE_FLAG_HIGH_FREQ));
-	osd_work_queue *queue;
-	int osdthreadnum = 0;
-	int allocthreadnum;
-	const char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
-
-	// allocate a new queue
-	queue = new osd_work_queue();
-
-	// initialize basic queue members
-	queue->tailptr = (osd_work_item **)&queue->list;
-	queue->flags = flags;
-
-	// determine how many threads to create...
-	// on a single-CPU system, create 1 thread for I/O queues, and 0 threads for everything else
-	if (numprocs == 1)
-		threadnum = (flags & WORK_QUEUE_FLAG_IO) ? 1 : 0;
-	// on an n-CPU system, create n-1 threads for multi queues, and 1 thread for everything else
-	else
-		threadnum = (flags & WORK_QUEUE_FLAG_MULTI) ? (numprocs - 1) : 1;
-
-	if (osdworkqueuemaxthreads != nullptr && sscanf(osdworkqueuemaxthreads, "%d", &osdthreadnum) == 1 && threadnum > osdthreadnum)
-		threadnum = osdthreadnum;
-
-#if defined(SDLMAME_EMSCRIPTEN)
-	// threads are not supported at all
-	threadnum = 0;
-#endif
-
-	// clamp to the maximum
-	queue->threads = std::min(threadnum, WORK_MAX_THREADS);
-
-	// allocate memory for thread array (+1 to count the calling thread if WORK_QUEUE_FLAG_MULTI)
-	if (flags & WORK_QUEUE_FLAG_MULTI)
-		allocthreadnum = queue->threads + 1;
-	else
-		allocthreadnum = std::max(queue->threads, 1u);
-
-#if KEEP_STATISTICS
-	printf("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads);
-#endif
-
-	for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
-		queue->thread.push_back(new work_thread_info(threadnum, *queue));
-
-	// iterate over threads
-	for (threadnum = 0; threadnum < queue->threads; threadnum++)
-	{
-		work_thread_info *thread = queue->thread[threadnum];
-
-		// create the thread
-		thread->handle = new std::thread(worker_thread_entry, thread);
-		if (thread->handle == nullptr)
-			goto error;
-
-		// set its priority: I/O threads get high priority because they are assumed to be
-		// blocked most of the time; other threads just match the creator's priority
-		if (flags & WORK_QUEUE_FLAG_IO)
-			thread_adjust_priority(thread->handle, 1);
-		else
-			thread_adjust_priority(thread->handle, 0);
-	}
-
-	// start a timer going for "waittime" on the main thread
-	if (flags & WORK_QUEUE_FLAG_MULTI)
-	{
-		begin_timing(queue->thread[queue->threads]->waittime);
-	}
-	return queue;
-
-error:
-	osd_work_queue_free(queue);
-	return nullptr;
+	std::lock_guard<std::mutex> lock(s_pool_lock);
+	if (!s_pool)
+		s_pool = std::make_unique<work_pool>();
+	return s_pool->attach(flags);
 }
 
 
@@ -344,39 +695,20 @@ int osd_work_queue_items(osd_work_queue *queue)
 
 bool osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 {
-	// if no threads, no waiting
-	if (queue->threads == 0)
-		return true;
-
 	// if no items, we're done
 	if (queue->items == 0)
 		return true;
 
-	// if this is a multi queue, help out rather than doing nothing
-	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+	// help out rather than doing nothing; I/O queues are left to their own
+	// threads, since their items may block
+	if (queue->kind != POOL_IO)
 	{
-		work_thread_info *thread = queue->thread[queue->threads];
-
-		end_timing(thread->waittime);
-
-		// process what we can as a worker thread
-		worker_thread_process(queue, thread);
-
-		// if we're a high frequency queue, spin until done
-		if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->items != 0)
-		{
-			// spin until we're done
-			begin_timing(thread->spintime);
-			spin_while_not<std::atomic<int>,int>(&queue->items, 0, timeout);
-			end_timing(thread->spintime);
-
-			begin_timing(thread->waittime);
-			return (queue->items == 0);
-		}
-		begin_timing(thread->waittime);
+		int const threadid = helper_id(*queue);
+		while (run_one(*queue, threadid)) { }
 	}
 
-	// reset our done event and double-check the items before waiting
+	// reset our done event and double-check the items before waiting for
+	// what the pool's threads are still running
 	queue->doneevent.reset();
 	queue->waiting = true;
 	if (queue->items != 0)
@@ -394,81 +726,35 @@ bool osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 
 void osd_work_queue_free(osd_work_queue *queue)
 {
-	// stop the timer for "waittime" on the main thread
-	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
-	{
-		end_timing(queue->thread[queue->threads]->waittime);
-	}
+	// let everything queued finish
+	while (!osd_work_queue_wait(queue, OSD_EVENT_WAIT_INFINITE)) { }
 
-	// signal all the threads to exit
-	queue->exiting = true;
-	for (int threadnum = 0; threadnum < queue->threads; threadnum++)
-	{
-		work_thread_info *thread = queue->thread[threadnum];
-		thread->wakeevent.set();
-	}
-
-	// wait for all the threads to go away
-	for (int threadnum = 0; threadnum < queue->threads; threadnum++)
-	{
-		work_thread_info *thread = queue->thread[threadnum];
-
-		// block on the thread going away, then close the handle
-		if (thread->handle != nullptr)
-		{
-			thread->handle->join();
-			delete thread->handle;
-		}
-
-	}
+	// threads may still be finishing up with the last items
+	while (queue->active != 0)
+		std::this_thread::yield();
 
 #if KEEP_STATISTICS
-	// output per-thread statistics
-	for (work_thread_info *thread : queue->thread)
-	{
-		osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
-		printf("Thread %d:  items=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
-				thread->id, thread->itemsdone,
-				(double)thread->runtime * 100.0 / (double)total,
-				(double)thread->actruntime * 100.0 / (double)total,
-				(double)thread->spintime * 100.0 / (double)total,
-				(double)thread->waittime * 100.0 / (double)total,
-				(uint32_t) total);
-	}
+	printf("Items queued   = %9d\n", queue->itemsqueued.load());
+	printf("Inline items   = %9d\n", queue->inlineitems.load());
 #endif
 
-	// free the list
-	for (auto & th : queue->thread)
-		delete th;
-	queue->thread.clear();
-
 	// free all items in the free list
-	while (queue->free.load() != nullptr)
-	{
-		auto *item = (osd_work_item *)queue->free;
-		queue->free = item->next;
-		delete item->event;
-		delete item;
-	}
-
-	// free all items in the active list
-	while (queue->list.load() != nullptr)
 	{
-		auto *item = (osd_work_item *)queue->list;
-		queue->list = item->next;
-		delete item->event;
-		delete item;
+		std::lock_guard<std::mutex> lock(queue->lock);
+		while (queue->free != nullptr)
+		{
+			osd_work_item *item = queue->free;
+			queue->free = item->next;
+			delete item->event;
+			delete item;
+		}
 	}
 
-#if KEEP_STATISTICS
-	printf("Items queued   = %9d\n", queue->itemsqueued.load());
-	printf("SetEvent calls = %9d\n", queue->setevents.load());
-	printf("Extra items    = %9d\n", queue->extraitems.load());
-	printf("Spin loops     = %9d\n", queue->spinloops.load());
-#endif
-
-	// free the queue itself
-	delete queue;
+	// the pool goes when the last queue does, unless it's one of the pool's
+	// own threads freeing it
+	std::lock_guard<std::mutex> lock(s_pool_lock);
+	if (queue->pool.detach(*queue) && (s_pool_thread_id < 0))
+		s_pool.reset();
 }
 
 
@@ -490,10 +776,9 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		// first allocate a new work item; try the free list first
 		{
 			std::lock_guard<std::mutex> lock(queue->lock);
-			do
-			{
-				item = (osd_work_item *)queue->free;
-			} while (item != nullptr && !queue->free.compare_exchange_weak(item, item->next, std::memory_order_release, std::memory_order_relaxed));
+			item = queue->free;
+			if (item != nullptr)
+				queue->free = item->next;
 		}
 
 		// if nothing, allocate something new
@@ -524,45 +809,33 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 	}
 
 	// enqueue the whole thing within the critical section
+	queue->items += numitems;
 	{
 		std::lock_guard<std::mutex> lock(queue->lock);
 		*queue->tailptr = itemlist;
 		queue->tailptr = item_tailptr;
+		queue->pending += numitems;
 	}
-
-	// increment the number of items in the queue
-	queue->items += numitems;
 	add_to_stat(queue->itemsqueued, numitems);
 
-	// look for free threads to do the work
-	if (queue->livethreads < queue->threads)
+	// without threads, run the queue now on this thread
+	if (queue->limit == 0)
 	{
-		int threadnum;
-
-		// iterate over all the threads
-		for (threadnum = 0; threadnum < queue->threads; threadnum++)
+		int const threadid = helper_id(*queue);
+		osd_work_item *item;
+		while ((item = take_item(*queue)) != nullptr)
 		{
-			work_thread_info *thread = queue->thread[threadnum];
-
-			// Attempt to wake the thread
-			if (thread->wakeevent.set())
-			{
-				add_to_stat(queue->setevents, 1);
-
-				// for non-shared, the first one we find is good enough
-				if (--numitems == 0)
-					break;
-			}
+			run_item(*item, threadid);
+			add_to_stat(queue->inlineitems, 1);
 		}
 	}
 
-	// if no threads, run the queue now on this thread
-	if (queue->threads == 0)
+	// otherwise wake as many threads as there are items for
+	else
 	{
-		end_timing(queue->thread[0]->waittime);
-		worker_thread_process(queue, queue->thread[0]);
-		begin_timing(queue->thread[0]->waittime);
+		queue->pool.wake(queue->kind, std::min(numitems, queue->limit));
 	}
+
 	// only return the item if it won't get released automatically
 	return (flags & WORK_ITEM_FLAG_AUTO_RELEASE) ? nullptr : lastitem;
 }
@@ -578,24 +851,27 @@ bool osd_work_item_wait(osd_work_item *item, osd_ticks_t timeout)
 	if (item->done)
 		return true;
 
-	// if we don't have an event, create one
-	if (item->event == nullptr)
+	// the item may be stuck behind others, so help its queue along
+	osd_work_queue &queue = item->queue;
+	if (queue.kind != POOL_IO)
 	{
-		std::lock_guard<std::mutex> lock(item->queue.lock);
-		item->event = new osd_event(true, false);     // manual reset, not signalled
+		int const threadid = helper_id(queue);
+		while (!item->done && run_one(queue, threadid)) { }
+		if (item->done)
+			return true;
 	}
-	else
-		item->event->reset();
 
-	// if we don't have an event, we need to spin (shouldn't ever really happen)
-	if (item->event == nullptr)
+	// if we don't have an event, create one
 	{
-		// TODO: do we need to measure the spin time here as well? and how can we do it?
-		spin_while<std::atomic<int>,int>(&item->done, 0, timeout);
+		std::lock_guard<std::mutex> lock(queue.lock);
+		if (item->event == nullptr)
+			item->event = new osd_event(true, false);     // manual reset, not signalled
+		else
+			item->event->reset();
 	}
 
-	// otherwise, block on the event until done
-	else if (!item->done)
+	// block on the event until done
+	if (!item->done)
 		item->event->wait(timeout);
 
 	// return true if the refcount actually hit 0
@@ -619,18 +895,23 @@ void *osd_work_item_result(osd_work_item *item)
 
 void osd_work_item_release(osd_work_item *item)
 {
-	osd_work_item *next;
-
 	// make sure we're done first
 	osd_work_item_wait(item, 100 * osd_ticks_per_second());
 
 	// add us to the free list on our queue
 	std::lock_guard<std::mutex> lock(item->queue.lock);
-	do
-	{
-		next = (osd_work_item *) item->queue.free;
-		item->next = next;
-	} while (!item->queue.free.compare_exchange_weak(next, item, std::memory_order_release, std::memory_order_relaxed));
+	item->next = item->queue.free;
+	item->queue.free = item;
+}
+
+
+//============================================================
+//  osd_work_set_trace_callback
+//============================================================
+
+void osd_work_set_trace_callback(osd_work_trace_callback callback)
+{
+	s_work_trace_callback.store(callback, std::memory_order_relaxed);
 }
 
 
@@ -663,155 +944,345 @@ static int effective_num_processors(bool heavy_mt)
 }
 
 
+//  take_item - remove the next item from a
+//  queue's list
 //============================================================
-//  worker_thread_entry
+
+static osd_work_item *take_item(osd_work_queue &queue)
+{
+	std::lock_guard<std::mutex> lock(queue.lock);
+	osd_work_item *const item = queue.list;
+	if (item != nullptr)
+	{
+		queue.list = item->next;
+		if (queue.list == nullptr)
+			queue.tailptr = &queue.list;
+		--queue.pending;
+	}
+	return item;
+}
+
+
+//============================================================
+//  run_item - call an item's callback and
+//  signal whoever is waiting for it
 //============================================================
 
-static void *worker_thread_entry(void *param)
+static void run_item(osd_work_item &item, int threadid)
 {
-	auto *thread = (work_thread_info *)param;
-	osd_work_queue &queue = thread->queue;
+	osd_work_queue &queue = item.queue;
 
-	// loop until we exit
-	for ( ;; )
-	{
-		// block waiting for work or exit
-		// bail on exit, and only wait if there are no pending items in queue
-		if (queue.exiting)
-			break;
+	// call the callback and stash the result
+	osd_work_trace_callback const trace = s_work_trace_callback.load(std::memory_order_relaxed);
+	osd_ticks_t const tracestart = trace ? osd_ticks() : 0;
+	item.result = (*item.callback)(item.param, threadid);
+	if (trace)
+		trace(tracestart, osd_ticks());
 
-		if (!queue_has_list_items(&queue))
-		{
-			begin_timing(thread->waittime);
-			thread->wakeevent.wait( OSD_EVENT_WAIT_INFINITE);
-			end_timing(thread->waittime);
-		}
+	// decrement the item count after we are done
+	item.done = true;
+	bool const empty = (--queue.items == 0);
 
-		if (queue.exiting)
-			break;
+	// if it's an auto-release item, release it
+	if (item.flags & WORK_ITEM_FLAG_AUTO_RELEASE)
+		osd_work_item_release(&item);
 
-		// indicate that we are live
-		++queue.livethreads;
+	// set the result and signal the event
+	else
+	{
+		std::lock_guard<std::mutex> lock(queue.lock);
+		if (item.event != nullptr)
+			item.event->set();
+	}
 
-		// process work items
-		for ( ;; )
-		{
-			// process as much as we can
-			worker_thread_process(&queue, thread);
+	if (empty && queue.waiting)
+		queue.doneevent.set();
+}
 
-			// if we're a high frequency queue, spin for a while before giving up
-			if (queue.flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue.list.load() == nullptr)
-			{
-				// spin for a while looking for more work
-				begin_timing(thread->spintime);
-				spin_while<std::atomic<osd_work_item *>, osd_work_item *>(&queue.list, (osd_work_item *)nullptr, SPIN_LOOP_TIME);
-				end_timing(thread->spintime);
-			}
 
-			// if nothing more, release the processor
-			if (!queue_has_list_items(&queue))
-				break;
-			add_to_stat(queue.spinloops, 1);
-		}
+//============================================================
+//  run_one - run an item from a queue if it isn't
+//  already running as many as it's allowed
+//============================================================
 
-		// decrement the live thread count
-		thread->wakeevent.reset();
-		--queue.livethreads;
+static bool run_one(osd_work_queue &queue, int threadid)
+{
+	// claim a share of the queue before taking an item
+	int32_t active = queue.active.load(std::memory_order_relaxed);
+	do
+	{
+		if ((active >= queue.limit) || (queue.pending == 0))
+			return false;
 	}
+	while (!queue.active.compare_exchange_weak(active, active + 1, std::memory_order_acquire, std::memory_order_relaxed));
 
-	return nullptr;
+	osd_work_item *const item = take_item(queue);
+	if (item != nullptr)
+		run_item(*item, threadid);
+
+	// a thread that found the queue full may have gone to sleep since
+	--queue.active;
+	if (queue.pending != 0)
+		queue.pool.wake(queue.kind, 1);
+	return item != nullptr;
 }
 
 
 //============================================================
-//  worker_thread_process
+//  helper_id - thread ID for the current thread
+//  running an item from a queue
 //============================================================
 
-static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread)
+static int helper_id(osd_work_queue &queue)
 {
-	int threadid = thread->id;
+	// the pool's own threads keep their IDs, so two threads never share one
+	return (s_pool_thread_id >= 0) ? s_pool_thread_id : queue.pool.caller_id();
+}
 
-	begin_timing(thread->runtime);
 
-	// loop until everything is processed
-	while (true)
+//============================================================
+//  work_pool - constructor
+//============================================================
+
+work_pool::work_pool()
+	: m_computethreads(0)
+	, m_maxthreads(-1)
+	, m_iothreads(0)
+	, m_ioqueues(0)
+	, m_queuecount(0)
+	, m_allocated(0)
+	, m_exiting(false)
+{
+	const char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
+	if (osdworkqueuemaxthreads != nullptr && sscanf(osdworkqueuemaxthreads, "%d", &m_maxthreads) == 1)
+		m_maxthreads = std::max(m_maxthreads, 0);
+	else
+		m_maxthreads = -1;
+
+	for (auto &queue : m_queues)
+		queue.store(nullptr, std::memory_order_relaxed);
+
+#if !defined(SDLMAME_EMSCRIPTEN)
+	// one thread per processor, less the one queueing the work; the
+	// calling thread helps when it waits, and its thread ID comes after
+	// the pool's
+	m_computethreads = std::min(effective_num_processors(true) - 1, WORK_MAX_THREADS - 1);
+	if (m_maxthreads >= 0)
+		m_computethreads = std::min(m_computethreads, m_maxthreads);
+	for (int threadnum = 0; threadnum < m_computethreads; threadnum++)
+		start_thread(POOL_COMPUTE, threadnum);
+#endif
+
+#if KEEP_STATISTICS
+	printf("osdprocs: %d computethreads: %d maxthreads: %d\n", osd_num_processors, m_computethreads, m_maxthreads);
+#endif
+}
+
+
+//============================================================
+//  ~work_pool - destructor
+//============================================================
+
+work_pool::~work_pool()
+{
+	// wake everything up to notice it should exit
+	m_exiting = true;
+	for (parking &park : m_parking)
 	{
-		osd_work_item *item = nullptr;
+		std::lock_guard<std::mutex> lock(park.mutex);
+		park.generation++;
+		park.cond.notify_all();
+	}
+	for (std::thread &thread : m_threads)
+		thread.join();
+
+	int const count = m_queuecount;
+	for (int queuenum = 0; queuenum < count; queuenum++)
+		delete m_queues[queuenum].load(std::memory_order_relaxed);
+}
 
-		bool end_loop = false;
 
-		// use a critical section to synchronize the removal of items
-		{
-			std::lock_guard<std::mutex> lock(queue->lock);
+//============================================================
+//  attach - allocate a queue, reusing one freed
+//  with the same flags if there is one
+//============================================================
 
-			if (queue->list.load() == nullptr)
-			{
-				end_loop = true;
-			}
-			else
-			{
-				// pull the item from the queue
-				item = (osd_work_item *)queue->list;
-				if (item != nullptr)
-				{
-					queue->list = item->next;
-					if (queue->list.load() == nullptr)
-						queue->tailptr = (osd_work_item **)&queue->list;
-				}
-			}
-		}
+osd_work_queue *work_pool::attach(uint32_t flags)
+{
+	int const kind = (flags & WORK_QUEUE_FLAG_IO) ? POOL_IO : POOL_COMPUTE;
+	m_allocated++;
 
-		if (end_loop)
-			break;
+	// I/O queues get a thread each, since their items are assumed to
+	// spend most of their time blocked
+	if (kind == POOL_IO)
+	{
+		m_ioqueues++;
+#if !defined(SDLMAME_EMSCRIPTEN)
+		if ((m_iothreads < m_ioqueues) && (m_maxthreads != 0))
+			start_thread(POOL_IO, m_iothreads++);
+#endif
+	}
 
-		// process non-NULL items
-		if (item != nullptr)
+	int const count = m_queuecount;
+	for (int queuenum = 0; queuenum < count; queuenum++)
+	{
+		osd_work_queue *const queue = m_queues[queuenum].load(std::memory_order_relaxed);
+		if (!queue->inuse && (queue->flags == flags))
 		{
-			// call the callback and stash the result
-			begin_timing(thread->actruntime);
-			item->result = (*item->callback)(item->param, threadid);
-			end_timing(thread->actruntime);
-
-			// decrement the item count after we are done
-			--queue->items;
-			item->done = true;
-			add_to_stat(thread->itemsdone, 1);
-
-			// if it's an auto-release item, release it
-			if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
-				osd_work_item_release(item);
-
-			// set the result and signal the event
-			else
-			{
-				std::lock_guard<std::mutex> lock(queue->lock);
+			queue->inuse = true;
+			return queue;
+		}
+	}
 
-				if (item->event != nullptr)
-				{
-					item->event->set();
-					add_to_stat(item->queue.setevents, 1);
-				}
-			}
+	// on a single-CPU system, run everything but I/O when it's queued;
+	// otherwise multi queues can use every thread sized for how often
+	// they're queued, and everything else one thread at a time
+	int threads;
+	if (kind == POOL_IO)
+		threads = m_iothreads ? 1 : 0;
+	else if (flags & WORK_QUEUE_FLAG_MULTI)
+		threads = std::min(effective_num_processors(!(flags & WORK_QUEUE_FLAG_HIGH_FREQ)) - 1, m_computethreads);
+	else
+		threads = std::min(1, m_computethreads);
+	if (m_maxthreads >= 0)
+		threads = std::min(threads, m_maxthreads);
 
-			// if we removed an item and there's still work to do, bump the stats
-			if (queue_has_list_items(queue))
-				add_to_stat(queue->extraitems, 1);
-		}
+	// with the pool full, a queue can still run its items when they're queued
+	if (count == MAX_POOL_QUEUES)
+		threads = 0;
+
+	osd_work_queue *const queue = new osd_work_queue(*this, flags, std::max(threads, 0), kind);
+	if (count < MAX_POOL_QUEUES)
+	{
+		m_queues[count].store(queue, std::memory_order_relaxed);
+		m_queuecount.store(count + 1, std::memory_order_release);
 	}
+	return queue;
+}
 
-	// we don't need to set the doneevent for multi queues because they spin
-	if (queue->waiting)
+
+//============================================================
+//  detach - free a queue for reuse, returning
+//  true if none are left allocated
+//============================================================
+
+bool work_pool::detach(osd_work_queue &queue)
+{
+	if (queue.kind == POOL_IO)
+		m_ioqueues--;
+
+	// one that didn't fit in the pool can go now
+	int const count = m_queuecount;
+	if (std::find(&m_queues[0], &m_queues[count], &queue) == &m_queues[count])
+		delete &queue;
+	else
+		queue.inuse = false;
+	return --m_allocated == 0;
+}
+
+
+//============================================================
+//  wake - wake sleeping threads to run newly
+//  queued items
+//============================================================
+
+void work_pool::wake(int kind, int32_t count)
+{
+	parking &park = m_parking[kind];
+	if (park.sleeping == 0)
+		return;
+
+	std::lock_guard<std::mutex> lock(park.mutex);
+	park.generation++;
+	if (count > 1)
+		park.cond.notify_all();
+	else
+		park.cond.notify_one();
+}
+
+
+//============================================================
+//  start_thread - add a thread to the pool
+//============================================================
+
+void work_pool::start_thread(int kind, int id)
+{
+	m_threads.emplace_back(&work_pool::worker, this, kind, id);
+
+	// set its priority: I/O threads get high priority because they are assumed to be
+	// blocked most of the time; other threads just match the creator's priority
+	thread_adjust_priority(&m_threads.back(), (kind == POOL_IO) ? 1 : 0);
+}
+
+
+//============================================================
+//  worker - pool thread main loop
+//============================================================
+
+void work_pool::worker(int kind, int id)
+{
+	// I/O threads run one queue's items at a time, so can all use the first ID
+	osd_thread_set_role((kind == POOL_IO) ? osd_thread_role::IO : osd_thread_role::WORK);
+	s_pool_thread_id = (kind == POOL_IO) ? -1 : id;
+	int const threadid = (kind == POOL_IO) ? 0 : id;
+	parking &park = m_parking[kind];
+
+	while (!m_exiting)
 	{
-		queue->doneevent.set();
-		add_to_stat(queue->setevents, 1);
+		if (run_any(kind, threadid))
+			continue;
+
+		// announce we're going to sleep before looking for work one last
+		// time, so anything queued after that wakes us
+		park.sleeping++;
+		uint32_t const generation = park.generation;
+		if (!m_exiting && !has_work(kind))
+		{
+			std::unique_lock<std::mutex> lock(park.mutex);
+			park.cond.wait(lock, [&park, generation] () { return park.generation != generation; });
+		}
+		park.sleeping--;
 	}
+}
+
+
+//============================================================
+//  run_any - run an item from the queue with
+//  the highest priority that has room for
+//  another thread
+//============================================================
 
-	end_timing(thread->runtime);
+bool work_pool::run_any(int kind, int id)
+{
+	// threads start looking in different places so they spread out over
+	// queues of the same priority
+	int const count = m_queuecount.load(std::memory_order_acquire);
+	for (int priority = 0; priority < PRIORITY_LEVELS; priority++)
+	{
+		for (int index = 0; index < count; index++)
+		{
+			osd_work_queue &queue = *m_queues[(index + id) % count].load(std::memory_order_relaxed);
+			if ((queue.kind == kind) && (queue.priority == priority) && run_one(queue, id))
+				return true;
+		}
+	}
+	return false;
 }
 
-bool queue_has_list_items(osd_work_queue *queue)
+
+//============================================================
+//  has_work - check whether any queue has items
+//  waiting for a thread of a given kind
+//============================================================
+
+bool work_pool::has_work(int kind) const
 {
-	std::lock_guard<std::mutex> lock(queue->lock);
-	bool has_list_items = (queue->list.load() != nullptr);
-	return has_list_items;
+	int const count = m_queuecount.load(std::memory_order_acquire);
+	for (int index = 0; index < count; index++)
+	{
+		osd_work_queue const &queue = *m_queues[index].load(std::memory_order_relaxed);
+		if ((queue.kind == kind) && (queue.pending != 0) && (queue.active < queue.limit))
+			return true;
+	}
+	return false;
 }
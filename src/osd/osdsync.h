@@ -17,6 +17,69 @@
 
 #include "osdcore.h"
 
+/***************************************************************************
+    THREAD ROLES
+***************************************************************************/
+
+// threads doing different jobs can be kept on different processors and
+// given different priorities
+enum class osd_thread_role
+{
+	EMULATION,      // runs the emulated machine, and renders and presents its output
+	AUDIO,          // feeds the host sound API
+	WORK,           // runs work queue items
+	IO,             // runs work queue items that block on I/O
+	COUNT
+};
+
+
+/*-----------------------------------------------------------------------------
+    osd_thread_configure_roles: set processor affinity and priority for each
+        thread role
+
+    Parameters:
+
+        affinity - semicolon-separated list of role=placement, where the
+            placement is "auto" for the role's default, "any" for every
+            processor, "performance" for the fastest processors on a
+            system with processors of different types, "node" for the
+            processors in the emulation thread's NUMA node, or a list of
+            processor numbers and ranges such as "0-3,8"
+
+        priority - semicolon-separated list of role=priority, where
+            priorities above zero run ahead of other threads and below
+            zero behind them
+
+    Return value:
+
+        false if anything couldn't be parsed; everything that could be is
+        still used.
+
+    Notes:
+
+        By default, the emulation thread is kept on the performance
+        processors, and work queue threads on the emulation thread's NUMA
+        node.  Roles only take effect for threads that take them on after
+        they're configured.
+-----------------------------------------------------------------------------*/
+bool osd_thread_configure_roles(const char *affinity, const char *priority);
+
+
+/*-----------------------------------------------------------------------------
+    osd_thread_set_role: apply a role's affinity and priority to the
+        calling thread
+
+    Parameters:
+
+        role - what the thread does
+
+    Return value:
+
+        None.
+-----------------------------------------------------------------------------*/
+void osd_thread_set_role(osd_thread_role role);
+
+
 /***************************************************************************
     SYNCHRONIZATION INTERFACES - Events
 ***************************************************************************/
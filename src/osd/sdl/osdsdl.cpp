@@ -263,6 +263,12 @@ void sdl_osd_interface::init(running_machine &machine)
 #if defined(SDLMAME_ANDROID)
 	SDL_SetHint(SDL_HINT_VIDEO_EXTERNAL_CONTEXT, "1");
 #endif
+
+#if defined(SDL_HINT_VIDEO_DOUBLE_BUFFER)
+	// drivers that flip pages directly (KMS/DRM) triple buffer by default, costing a frame of latency
+	if (options().wait_vsync())
+		SDL_SetHint(SDL_HINT_VIDEO_DOUBLE_BUFFER, "1");
+#endif
 	/* Initialize SDL */
 
 	if (SDL_InitSubSystem(SDL_INIT_VIDEO))
@@ -397,6 +397,17 @@ osd_dim sdl_window_info::pick_best_mode()
 	float size_score, best_score = 0.0f;
 	osd_dim ret(0,0);
 
+	// aim for the refresh rate asked for, or failing that the emulated screen's
+	double target_refresh = m_win_config.refresh;
+	if (!target_refresh)
+	{
+		const screen_device *screen = screen_device_enumerator(machine().root_device()).byindex(index());
+		if (screen == nullptr)
+			screen = screen_device_enumerator(machine().root_device()).first();
+		target_refresh = (screen != nullptr) ? ATTOSECONDS_TO_HZ(screen->refresh_attoseconds()) : 60.0;
+	}
+	m_mode_refresh = 0;
+
 	// determine the minimum width/height for the selected target
 	target()->compute_minimum_size(minimum_width, minimum_height);
 
@@ -440,17 +451,28 @@ osd_dim sdl_window_info::pick_best_mode()
 			if (mode.w == m_win_config.width && mode.h == m_win_config.height)
 				size_score = 2.0f;
 
-			// refresh adds some points
-			if (m_win_config.refresh)
-				size_score *= 1.0f / (1.0f + abs(m_win_config.refresh - mode.refresh_rate) / 10.0f);
+			// compute refresh score; modes that don't report a rate get no points
+			float refresh_score = mode.refresh_rate ? (1.0f / (1.0f + std::fabs(mode.refresh_rate - target_refresh))) : 0.0f;
+
+			// if refresh is smaller than we'd like, it only scores up to 0.1
+			if (mode.refresh_rate < target_refresh)
+				refresh_score *= 0.1f;
+
+			// if we're looking for a particular refresh, make sure it matches
+			if (m_win_config.refresh && (mode.refresh_rate == m_win_config.refresh))
+				refresh_score = 2.0f;
+
+			// weight size and refresh equally
+			float const final_score = size_score + refresh_score;
 
-			osd_printf_verbose("%4dx%4d@%2d -> %f\n", (int)mode.w, (int)mode.h, (int) mode.refresh_rate, (double) size_score);
+			osd_printf_verbose("%4dx%4d@%2d -> %f\n", (int)mode.w, (int)mode.h, (int) mode.refresh_rate, (double) final_score);
 
 			// best so far?
-			if (size_score > best_score)
+			if (final_score > best_score)
 			{
-				best_score = size_score;
+				best_score = final_score;
 				ret = osd_dim(mode.w, mode.h);
+				m_mode_refresh = mode.refresh_rate;
 			}
 
 		}
@@ -527,9 +549,19 @@ void sdl_window_info::update()
 			{
 				// otherwise, render with our drawing system
 				if (video_config.perftest)
+				{
 					measure_fps(update);
+				}
+				else if (render_threaded())
+				{
+					// the render thread sets the event when it's done
+					render_async(update);
+					return;
+				}
 				else
+				{
 					renderer().draw(update);
+				}
 			}
 
 			// all done, ready for next
@@ -687,8 +719,8 @@ int sdl_window_info::complete_create()
 		m_original_mode->mode = mode;
 		mode.w = temp.width();
 		mode.h = temp.height();
-		if (m_win_config.refresh)
-			mode.refresh_rate = m_win_config.refresh;
+		if (m_mode_refresh)
+			mode.refresh_rate = m_mode_refresh;
 
 		SDL_SetWindowDisplayMode(platform_window(), &mode);    // Try to set mode
 #ifndef SDLMAME_WIN32
@@ -724,6 +756,8 @@ int sdl_window_info::complete_create()
 	// initialize the drawing backend
 	if (renderer().create())
 		return 1;
+	if (!video_config.perftest)
+		start_render_thread(m_rendered_event);
 
 	// Make sure we have a consistent state
 	SDL_ShowCursor(SDL_DISABLE);
@@ -1038,6 +1072,7 @@ sdl_window_info::sdl_window_info(
 	, m_windowed_dim(0, 0)
 	, m_rendered_event(0, 1)
 	, m_extra_flags(0)
+	, m_mode_refresh(0)
 	, m_mouse_captured(false)
 	, m_mouse_hidden(false)
 {
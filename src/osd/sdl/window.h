@@ -81,6 +81,9 @@ private:
 
 	int                 m_extra_flags;
 
+	// refresh rate of the full screen mode picked, or zero to leave it to SDL
+	int                 m_mode_refresh;
+
 	// returns 0 on success, else 1
 	int complete_create();
 
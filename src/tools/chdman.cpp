@@ -119,6 +119,7 @@ constexpr int MODE_GDI = 2;
 #define OPTION_VERBOSE "verbose"
 #define OPTION_FIX "fix"
 #define OPTION_NUMPROCESSORS "numprocessors"
+#define OPTION_ADAPTIVE "adaptive"
 #define OPTION_SIZE "size"
 #define OPTION_TEMPLATE "template"
 
@@ -172,7 +173,7 @@ struct command_description
 	const char *name;
 	void (*handler)(parameters_map &);
 	const char *description;
-	const char *valid_options[16];
+	const char *valid_options[20];
 };
 
 
@@ -646,6 +647,7 @@ static const option_description s_options[] =
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
 	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_ADAPTIVE,              "ad",   false, ": stop trying codecs that keep losing, probing them again now and then (faster, slightly larger output)" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -685,7 +687,8 @@ static const command_description s_commands[] =
 			OPTION_HUNK_SIZE,
 			OPTION_UNIT_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -706,7 +709,8 @@ static const command_description s_commands[] =
 			OPTION_CHS,
 			OPTION_SIZE,
 			OPTION_SECTOR_SIZE,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -718,7 +722,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_INPUT,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 	{ COMMAND_CREATE_DVD, do_create_dvd, ": create a DVD CHD from the input file",
@@ -733,7 +738,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_HUNKS,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -747,7 +753,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_FRAMES,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -824,7 +831,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_HUNKS,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_ADAPTIVE
 		}
 	},
 
@@ -1433,9 +1441,10 @@ static void create_output_chd(
 //  compress_common - standard compression loop
 //-------------------------------------------------
 
-static void compress_common(chd_file_compressor &chd)
+static void compress_common(chd_file_compressor &chd, const parameters_map &params)
 {
 	// begin compressing
+	chd.set_adaptive_codecs(params.find(OPTION_ADAPTIVE) != params.end());
 	chd.compress_begin();
 
 	// loop until done
@@ -1456,6 +1465,31 @@ static void compress_common(chd_file_compressor &chd)
 }
 
 
+//-------------------------------------------------
+//  read_chd_bytes - read from a CHD, decompressing
+//  whole hunks in parallel
+//-------------------------------------------------
+
+static std::error_condition read_chd_bytes(chd_file &chd, uint64_t offset, uint8_t *dest, uint32_t length)
+{
+	// hand any run of whole hunks to read_hunks
+	uint32_t const hunk_bytes = chd.hunk_bytes();
+	if ((offset % hunk_bytes) == 0 && length >= hunk_bytes)
+	{
+		uint32_t const hunks = length / hunk_bytes;
+		std::error_condition err = chd.read_hunks(offset / hunk_bytes, hunks, dest);
+		if (err)
+			return err;
+		offset += uint64_t(hunks) * hunk_bytes;
+		dest += uint64_t(hunks) * hunk_bytes;
+		length -= hunks * hunk_bytes;
+	}
+
+	// the rest goes through the partial hunk cache
+	return length ? chd.read_bytes(offset, dest, length) : std::error_condition();
+}
+
+
 //-------------------------------------------------
 //  output_track_metadata - output track metadata
 //  to a CUE file
@@ -1785,7 +1819,7 @@ static void do_verify(parameters_map &params)
 
 		// determine how much to read
 		uint32_t bytes_to_read = (std::min<uint64_t>)(buffer.size(), input_chd.logical_bytes() - offset);
-		std::error_condition err = input_chd.read_bytes(offset, &buffer[0], bytes_to_read);
+		std::error_condition err = read_chd_bytes(input_chd, offset, &buffer[0], bytes_to_read);
 		if (err)
 			report_error(1, "Error reading CHD file (%s): %s", *params.find(OPTION_INPUT)->second, err.message());
 
@@ -1904,7 +1938,7 @@ static void do_create_raw(parameters_map &params)
 			chd->clone_all_metadata(output_parent);
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 	}
 	catch (...)
 	{
@@ -2108,7 +2142,7 @@ static void do_create_hd(parameters_map &params)
 
 		// compress it generically
 		if (input_file)
-			compress_common(*chd);
+			compress_common(*chd, params);
 	}
 	catch (...)
 	{
@@ -2188,7 +2222,7 @@ static void do_create_cd(parameters_map &params)
 			report_error(1, "Error adding CD metadata: %s", err.message());
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 	}
 	catch (...)
 	{
@@ -2256,7 +2290,7 @@ static void do_create_dvd(parameters_map &params)
 			report_error(1, "Error adding DVD metadata: %s", err.message());
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 	}
 	catch (...)
 	{
@@ -2360,7 +2394,7 @@ static void do_create_ld(parameters_map &params)
 			report_error(1, "Error adding AV metadata: %s\n", err.message());
 
 		// create the compressor and then run it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 
 		// write the final LD metadata
 		if (info.height == 524/2 || info.height == 624/2)
@@ -2482,7 +2516,7 @@ static void do_copy(parameters_map &params)
 		}
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 	}
 	catch (...)
 	{
@@ -2539,7 +2573,7 @@ static void do_extract_raw(parameters_map &params)
 
 			// determine how much to read
 			uint32_t bytes_to_read = (std::min<uint64_t>)(buffer.size(), input_end - offset);
-			std::error_condition err = input_chd.read_bytes(offset, &buffer[0], bytes_to_read);
+			std::error_condition err = read_chd_bytes(input_chd, offset, &buffer[0], bytes_to_read);
 			if (err)
 				report_error(1, "Error reading CHD file (%s): %s", *params.find(OPTION_INPUT)->second, err.message());
 
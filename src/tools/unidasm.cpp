@@ -217,9 +217,12 @@ using util::BIT;
 #include "eminline.h"
 #include "endianness.h"
 #include "ioprocs.h"
+#include "multibyte.h"
 #include "osdfile.h"
 #include "strformat.h"
 
+#include <zstd.h>
+
 #include <algorithm>
 #include <cctype>
 #include <cstdio>
@@ -228,8 +231,10 @@ using util::BIT;
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -382,6 +387,7 @@ struct options
 	uint32_t                skip;
 	uint32_t                count;
 	bool                    octal;
+	bool                    trace;
 };
 
 static const dasm_table_entry dasm_table[] =
@@ -1207,6 +1213,8 @@ static int parse_options(int argc, char *argv[], options *opts)
 				opts->xchbytes = true;
 			else if(tolower((uint8_t)curarg[1]) == 'o')
 				opts->octal = true;
+			else if(tolower((uint8_t)curarg[1]) == 't')
+				opts->trace = true;
 			else
 				goto usage;
 
@@ -1262,7 +1270,7 @@ static int parse_options(int argc, char *argv[], options *opts)
 usage:
 	printf("Usage: %s <filename> -arch <architecture> [-basepc <pc>] \n", argv[0]);
 	printf("   [-norawbytes] [-xchbytes] [-flipped] [-upper] [-lower]\n");
-	printf("   [-skip <n>] [-count <n>] [-octal]\n");
+	printf("   [-skip <n>] [-count <n>] [-octal] [-trace]\n");
 	printf("\n");
 	printf("Supported architectures:");
 	const int colwidth = 1 + std::strlen(std::max_element(std::begin(dasm_table), std::end(dasm_table), [](const dasm_table_entry &a, const dasm_table_entry &b) { return std::strlen(a.name) < std::strlen(b.name); })->name);
@@ -1643,6 +1651,220 @@ int disasm_file(util::random_read &file, u64 length, options &opts)
 }
 
 
+// binary trace decoder state, fed decompressed data a piece at a time
+class trace_decoder
+{
+public:
+	trace_decoder(const options &opts) : m_opts(opts), m_disasm(opts.dasm->alloc()), m_buffer(m_disasm.get(), opts.dasm) { }
+
+	// decode as many complete records as possible, returning the number of bytes used
+	std::size_t decode(const u8 *data, std::size_t length);
+
+private:
+	// an instruction seen in the trace, disassembled when its bytes are first seen
+	struct instruction
+	{
+		std::vector<u8> opcodes;
+		std::string text;
+	};
+
+	static std::size_t get_string(const u8 *data, std::size_t length, std::string &result);
+	std::size_t decode_header(const u8 *data, std::size_t length);
+	void set_opcodes(offs_t pc, const u8 *data, std::size_t length);
+
+	const options &m_opts;
+	std::unique_ptr<util::disasm_interface> m_disasm;
+	unidasm_data_buffer m_buffer;
+	std::unordered_map<offs_t, instruction> m_code;
+	std::unordered_map<u16, std::string> m_register_names;
+	std::string m_changes;
+};
+
+std::size_t trace_decoder::get_string(const u8 *data, std::size_t length, std::string &result)
+{
+	if(length < 2)
+		return 0;
+	std::size_t const size = get_u16le(data);
+	if(length < 2 + size)
+		return 0;
+	result.assign(reinterpret_cast<const char *>(data + 2), size);
+	return 2 + size;
+}
+
+std::size_t trace_decoder::decode_header(const u8 *data, std::size_t length)
+{
+	// magic, version and flags, device tag and name, then register names
+	std::size_t pos = 6;
+	std::string tag, name;
+	if(length < pos)
+		return 0;
+	if(data[4] != 1)
+		throw std::runtime_error(util::string_format("unsupported trace version %u", data[4]));
+	std::size_t used = get_string(data + pos, length - pos, tag);
+	if(!used)
+		return 0;
+	pos += used;
+	used = get_string(data + pos, length - pos, name);
+	if(!used || (length < pos + used + 2))
+		return 0;
+	pos += used;
+	unsigned const count = get_u16le(data + pos);
+	pos += 2;
+	std::unordered_map<u16, std::string> names;
+	for(unsigned i = 0; i != count; i++) {
+		std::string regname;
+		if(length < pos + 2)
+			return 0;
+		used = get_string(data + pos + 2, length - pos - 2, regname);
+		if(!used)
+			return 0;
+		names.emplace(get_u16le(data + pos), std::move(regname));
+		pos += 2 + used;
+	}
+
+	util::stream_format(std::cout, "; trace of %s (%s)\n", tag, name);
+	m_register_names = std::move(names);
+	return pos;
+}
+
+void trace_decoder::set_opcodes(offs_t pc, const u8 *data, std::size_t length)
+{
+	instruction &insn = m_code[pc];
+	if(!insn.text.empty() && (insn.opcodes.size() == length) && std::equal(insn.opcodes.begin(), insn.opcodes.end(), data))
+		return;
+
+	// disassemble the bytes as if they were a file loaded at the PC
+	insn.opcodes.assign(data, data + length);
+	m_buffer.data.assign(data, data + length);
+	m_buffer.data.resize(length + 8, 0x00);
+	m_buffer.size = length;
+	m_buffer.base_pc = pc;
+	std::ostringstream stream;
+	m_disasm->disassemble(stream, pc, m_buffer, m_buffer);
+	insn.text = stream.str();
+}
+
+std::size_t trace_decoder::decode(const u8 *data, std::size_t length)
+{
+	std::size_t pos = 0;
+	while(pos < length) {
+		const u8 *const rec = data + pos;
+		std::size_t const remaining = length - pos;
+		std::size_t used = 0;
+		switch(rec[0]) {
+		case 'M':
+			// a header, at the start or where another trace was appended
+			if(remaining >= 4 && !std::memcmp(rec, "MTRC", 4))
+				used = decode_header(rec, remaining);
+			else if(remaining >= 4)
+				throw std::runtime_error("invalid trace record");
+			break;
+
+		case 0x01:
+			if(remaining >= 5) {
+				offs_t const pc = get_u32le(rec + 1);
+				auto const found = m_code.find(pc);
+				std::string const &text = (m_code.end() != found) ? found->second.text : std::string("??");
+				if(m_changes.empty())
+					util::stream_format(std::cout, m_opts.octal ? "%o: %s\n" : "%X: %s\n", pc, text);
+				else
+					util::stream_format(std::cout, m_opts.octal ? "%o: %-32s ;%s\n" : "%X: %-32s ;%s\n", pc, text, m_changes);
+				m_changes.clear();
+				used = 5;
+			}
+			break;
+
+		case 0x02:
+			if(remaining >= 6 && remaining >= 6u + rec[5]) {
+				set_opcodes(get_u32le(rec + 1), rec + 6, rec[5]);
+				used = 6 + rec[5];
+			}
+			break;
+
+		case 0x03:
+			if(remaining >= 2 && remaining >= 2u + rec[1] * 10u) {
+				for(unsigned i = 0; i != rec[1]; i++) {
+					u16 const index = get_u16le(rec + 2 + i * 10);
+					auto const name = m_register_names.find(index);
+					m_changes += util::string_format(" %s=%X", (m_register_names.end() != name) ? name->second : util::string_format("#%u", index), get_u64le(rec + 4 + i * 10));
+				}
+				used = 2 + rec[1] * 10;
+			}
+			break;
+
+		case 0x05:
+			if(remaining >= 9) {
+				util::stream_format(std::cout, m_opts.octal ? "\n   (interrupted at %o, IRQ %d)\n\n" : "\n   (interrupted at %X, IRQ %d)\n\n", get_u32le(rec + 1), int32_t(get_u32le(rec + 5)));
+				used = 9;
+			}
+			break;
+
+		case 0x06:
+			if(remaining >= 5 && remaining >= 5 + std::size_t(get_u32le(rec + 1))) {
+				std::cout.write(reinterpret_cast<const char *>(rec + 5), get_u32le(rec + 1));
+				used = 5 + get_u32le(rec + 1);
+			}
+			break;
+
+		default:
+			throw std::runtime_error(util::string_format("invalid trace record type %02X", rec[0]));
+		}
+
+		// stop at an incomplete record and wait for more data
+		if(!used)
+			break;
+		pos += used;
+	}
+	return pos;
+}
+
+int disasm_trace(util::random_read &file, u64 length, options &opts)
+{
+	ZSTD_DCtx *const dctx = ZSTD_createDCtx();
+	if(!dctx) {
+		std::fprintf(stderr, "Error creating decompressor\n");
+		return 1;
+	}
+
+	trace_decoder decoder(opts);
+	std::vector<u8> input(ZSTD_DStreamInSize());
+	std::vector<u8> pending;
+	std::vector<u8> output(ZSTD_DStreamOutSize());
+	u64 offset = 0;
+	int result = 0;
+	try {
+		while(offset < length) {
+			auto const [filerr, actual] = read_at(file, offset, input.data(), std::min<u64>(input.size(), length - offset));
+			if(filerr || !actual) {
+				std::fprintf(stderr, "Error reading from file '%s'\n", opts.filename);
+				result = 1;
+				break;
+			}
+			offset += actual;
+
+			// decompress everything read, decoding complete records as they appear
+			ZSTD_inBuffer in{ input.data(), actual, 0 };
+			while(in.pos < in.size) {
+				ZSTD_outBuffer out{ output.data(), output.size(), 0 };
+				std::size_t const ret = ZSTD_decompressStream(dctx, &out, &in);
+				if(ZSTD_isError(ret))
+					throw std::runtime_error(util::string_format("decompression failed (%s)", ZSTD_getErrorName(ret)));
+				pending.insert(pending.end(), output.data(), output.data() + out.pos);
+				pending.erase(pending.begin(), pending.begin() + decoder.decode(pending.data(), pending.size()));
+			}
+		}
+		if(!result && !pending.empty())
+			std::fprintf(stderr, "Trace ends with an incomplete record\n");
+	} catch(const std::exception &e) {
+		std::fprintf(stderr, "Error decoding trace '%s' (%s)\n", opts.filename, e.what());
+		result = 1;
+	}
+
+	ZSTD_freeDCtx(dctx);
+	return result;
+}
+
+
 int main(int argc, char *argv[])
 {
 	// Parse options first
@@ -1704,7 +1926,7 @@ int main(int argc, char *argv[])
 		}
 	}
 
-	int result = disasm_file(*file, length, opts);
+	int result = opts.trace ? disasm_trace(*file, length, opts) : disasm_file(*file, length, opts);
 
 	file.reset();
 	std::free(data);
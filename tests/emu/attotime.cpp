@@ -9,3 +9,39 @@ TEST_CASE("convert 1 sec to attotime", "[emu]")
    attotime value = attotime::from_seconds(1);
    REQUIRE(value.as_attoseconds() == 1000000000000000000);
 }
+
+TEST_CASE("clock_converter matches dividing by frequency and period", "[emu]")
+{
+	u32 const frequencies[] = { 1, 3, 60, 44'100, 3'579'545, 14'318'181, 33'868'800, 100'000'000, 1'000'000'000, 0xffff'ffffU };
+	for (u32 const frequency : frequencies)
+	{
+		clock_converter const converter(frequency);
+		attoseconds_t const period = HZ_TO_ATTOSECONDS(frequency);
+		REQUIRE(converter.period() == period);
+
+		u64 const ticks[] = { 0, 1, 2, frequency - 1U, frequency, u64(frequency) + 1, u64(frequency) * 7 + 12'345, u64(frequency) * 1'000 - 1, u64(frequency) * 100'000 + 1 };
+		for (u64 const count : ticks)
+		{
+			REQUIRE(converter.to_attotime(count) == attotime::from_ticks(count, frequency));
+
+			// converting back gives the whole ticks in the result
+			attotime const duration = converter.to_attotime(count);
+			u64 const expected = mulu_32x32(duration.seconds(), frequency) + u64(duration.attoseconds()) / u64(period);
+			REQUIRE(converter.to_ticks(duration) == expected);
+		}
+
+		attoseconds_t const attoseconds[] = { 0, 1, period - 1, period, period + 1, ATTOSECONDS_PER_SECOND / 3, ATTOSECONDS_PER_SECOND - 1 };
+		for (attoseconds_t const attos : attoseconds)
+		{
+			attotime const duration(5, attos);
+			REQUIRE(converter.to_ticks(duration) == (u64(frequency) * 5) + (u64(attos) / u64(period)));
+		}
+	}
+}
+
+TEST_CASE("clock_converter with no frequency", "[emu]")
+{
+	clock_converter const converter;
+	REQUIRE(converter.to_attotime(100).is_never());
+	REQUIRE(converter.to_ticks(attotime::from_seconds(1)) == 0);
+}
@@ -0,0 +1,76 @@
+#include "catch.hpp"
+
+#include "hashing.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> test_data(size_t length)
+{
+   std::vector<uint8_t> data(length);
+   uint32_t seed = 1;
+   for (auto &value : data)
+   {
+      seed = seed * 1103515245U + 12345U;
+      value = uint8_t(seed >> 16);
+   }
+   return data;
+}
+
+} // anonymous namespace
+
+TEST_CASE("CRC-32 of known strings", "[util]")
+{
+   REQUIRE(uint32_t(util::crc32_creator::simple("", 0)) == 0x00000000U);
+   REQUIRE(uint32_t(util::crc32_creator::simple("123456789", 9)) == 0xcbf43926U);
+   REQUIRE(uint32_t(util::crc32_creator::simple("The quick brown fox jumps over the lazy dog", 43)) == 0x414fa339U);
+}
+
+TEST_CASE("CRC-32 is the same however the data is split", "[util]")
+{
+   // lengths around the 16 and 64 byte blocks the accelerated versions fold
+   std::vector<uint8_t> const data = test_data(5000);
+   for (size_t length : { 15, 16, 63, 64, 65, 127, 128, 129, 1000, 4999 })
+   {
+      uint32_t const whole = util::crc32_creator::simple(data.data() + 1, length);
+      util::crc32_creator split;
+      split.append(data.data() + 1, 7);
+      split.append(data.data() + 8, length - 7);
+      REQUIRE(uint32_t(split.finish()) == whole);
+   }
+}
+
+TEST_CASE("CRC-32 of a long buffer", "[util]")
+{
+   std::vector<uint8_t> const data(1000000, 'a');
+   REQUIRE(uint32_t(util::crc32_creator::simple(data.data(), data.size())) == 0xdc25bfbcU);
+}
+
+TEST_CASE("SHA-1 of known strings", "[util]")
+{
+   REQUIRE(util::sha1_creator::simple("", 0).as_string() == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+   REQUIRE(util::sha1_creator::simple("abc", 3).as_string() == "a9993e364706816aba3e25717850c26c9cd0d89d");
+   REQUIRE(util::sha1_creator::simple("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56).as_string() == "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+}
+
+TEST_CASE("SHA-1 of a long buffer", "[util]")
+{
+   std::vector<uint8_t> const data(1000000, 'a');
+   REQUIRE(util::sha1_creator::simple(data.data(), data.size()).as_string() == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
+
+TEST_CASE("SHA-1 is the same however the data is split", "[util]")
+{
+   std::vector<uint8_t> const data = test_data(5000);
+   std::string const whole = util::sha1_creator::simple(data.data(), data.size()).as_string();
+   for (uint32_t first : { 1, 55, 63, 64, 65, 200 })
+   {
+      util::sha1_creator split;
+      split.append(data.data(), first);
+      split.append(data.data() + first, 3);
+      split.append(data.data() + first + 3, data.size() - first - 3);
+      REQUIRE(split.finish().as_string() == whole);
+   }
+}